@@ -0,0 +1,81 @@
+#include <eeros/core/AsyncBuffer.hpp>
+#include <eeros/core/RingBuffer.hpp>
+#include <eeros/core/SpscRingBuffer.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <thread>
+
+using namespace eeros;
+
+/*
+ * Buffers between threads, once uncontended on one thread and once with
+ * a producer and a consumer thread.
+ */
+
+static void ringBufferPushPop(benchmark::State& state) {
+  RingBuffer<double> buffer;
+  double v = 1.0;
+  for (auto _ : state) {
+    buffer.push(v);
+    buffer.pop(v);
+    benchmark::DoNotOptimize(v);
+  }
+}
+BENCHMARK(ringBufferPushPop);
+
+static void spscRingBufferPushPop(benchmark::State& state) {
+  SpscRingBuffer<double> buffer;
+  double v = 1.0;
+  for (auto _ : state) {
+    buffer.push(v);
+    buffer.pop(v);
+    benchmark::DoNotOptimize(v);
+  }
+}
+BENCHMARK(spscRingBufferPushPop);
+
+template < typename Buffer >
+static void ringBufferThreads(benchmark::State& state) {
+  Buffer buffer;
+  std::atomic<bool> done{false};
+  std::thread consumer([&]() {
+    double v;
+    while (!done.load(std::memory_order_relaxed)) buffer.pop(v);
+  });
+  for (auto _ : state) {
+    while (!buffer.push(1.0)) { }
+  }
+  done = true;
+  consumer.join();
+}
+BENCHMARK_TEMPLATE(ringBufferThreads, RingBuffer<double>)->UseRealTime();
+BENCHMARK_TEMPLATE(ringBufferThreads, SpscRingBuffer<double>)->UseRealTime();
+
+template < typename T >
+static void asyncBufferWriteRead(benchmark::State& state) {
+  AsyncBuffer<T> buffer;
+  T v{};
+  v = 0.0;
+  for (auto _ : state) {
+    buffer.write(v);
+    v = buffer.read();
+    benchmark::DoNotOptimize(v);
+  }
+}
+BENCHMARK_TEMPLATE(asyncBufferWriteRead, double);
+BENCHMARK_TEMPLATE(asyncBufferWriteRead, math::Matrix<6, 6>);
+
+static void asyncBufferThreads(benchmark::State& state) {
+  AsyncBuffer<math::Matrix<6, 6>> buffer;
+  std::atomic<bool> done{false};
+  std::thread reader([&]() {
+    while (!done.load(std::memory_order_relaxed)) benchmark::DoNotOptimize(buffer.read());
+  });
+  math::Matrix<6, 6> v;
+  v.zero();
+  for (auto _ : state) buffer.write(v);
+  done = true;
+  reader.join();
+}
+BENCHMARK(asyncBufferThreads)->UseRealTime();
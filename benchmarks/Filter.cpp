@@ -0,0 +1,87 @@
+#include <eeros/control/Constant.hpp>
+#include <eeros/control/ZTransferFunction.hpp>
+#include <eeros/control/filter/KalmanFilter.hpp>
+#include <eeros/control/filter/LowPassFilter.hpp>
+#include <eeros/control/filter/MedianFilter.hpp>
+#include <eeros/control/filter/MovingAverageFilter.hpp>
+#include <eeros/control/filter/SosFilter.hpp>
+#include <benchmark/benchmark.h>
+
+using namespace eeros::control;
+using namespace eeros::math;
+
+/*
+ * One run of each filter of control/filter, fed by a constant. 
+ */
+
+static void lowPassFilter(benchmark::State& state) {
+  Constant<> c(1.0);
+  LowPassFilter<> f(0.1);
+  f.getIn().connect(c.getOut());
+  for (auto _ : state) f.run();
+}
+BENCHMARK(lowPassFilter);
+
+static void lowPassFilterVector(benchmark::State& state) {
+  Constant<Vector3> c(Vector3{1.0, 2.0, 3.0});
+  LowPassFilter<Vector3> f(0.1);
+  f.getIn().connect(c.getOut());
+  for (auto _ : state) f.run();
+}
+BENCHMARK(lowPassFilterVector);
+
+template < size_t N >
+static void medianFilter(benchmark::State& state) {
+  Constant<> c(1.0);
+  MedianFilter<N> f;
+  f.getIn().connect(c.getOut());
+  double v = 0;
+  for (auto _ : state) {
+    c.setValue(v += 0.37);  // a changing input keeps the sort busy
+    c.run();
+    f.run();
+  }
+}
+BENCHMARK_TEMPLATE(medianFilter, 5);
+BENCHMARK_TEMPLATE(medianFilter, 25);
+BENCHMARK_TEMPLATE(medianFilter, 101);
+
+template < size_t N >
+static void movingAverageFilter(benchmark::State& state) {
+  double coeffs[N];
+  for (auto& k : coeffs) k = 1.0 / N;
+  Constant<> c(1.0);
+  MovingAverageFilter<N> f(coeffs);
+  f.getIn().connect(c.getOut());
+  for (auto _ : state) f.run();
+}
+BENCHMARK_TEMPLATE(movingAverageFilter, 5);
+BENCHMARK_TEMPLATE(movingAverageFilter, 25);
+BENCHMARK_TEMPLATE(movingAverageFilter, 101);
+
+static void sosFilter(benchmark::State& state) {
+  Constant<> c(1.0);
+  SosFilter<2> f{ZTransferFunction<1>::DT1(0.01, 2.0, 0.1), ZTransferFunction<1>::PID(0.01, 1.0, 0.5, 0.1, 0.05)};
+  f.getIn().connect(c.getOut());
+  for (auto _ : state) f.run();
+}
+BENCHMARK(sosFilter);
+
+using Kalman = KalmanFilter<1, 1, 2, 1>;
+
+static void kalmanFilter(benchmark::State& state, Kalman::Mode mode) {
+  // position and velocity of a mass driven by a force, the position is measured
+  Kalman kf(Matrix<2, 2>{1.0, 0.0, 0.01, 1.0}, Matrix<2, 1>{0.00005, 0.01}, Matrix<1, 2>{1.0, 0.0},
+            Matrix<2, 1>{0.00005, 0.01}, Matrix<1, 1>{0.5}, Matrix<1, 1>{0.01});
+  Constant<> u(0.5), y(0.0);
+  kf.getU(0).connect(u.getOut());
+  kf.getY(0).connect(y.getOut());
+  kf.setMode(mode);
+  for (auto _ : state) {
+    kf.correction();
+    kf.prediction();
+  }
+}
+BENCHMARK_CAPTURE(kalmanFilter, standard, Kalman::Mode::standard);
+BENCHMARK_CAPTURE(kalmanFilter, joseph, Kalman::Mode::joseph);
+BENCHMARK_CAPTURE(kalmanFilter, steadyState, Kalman::Mode::steadyState);
@@ -0,0 +1,51 @@
+#include <eeros/logger/Logger.hpp>
+#include <benchmark/benchmark.h>
+#include <ostream>
+#include <streambuf>
+
+using namespace eeros::logger;
+
+/*
+ * Cost of a log call on the calling thread: a suppressed message, a message
+ * formatted into a stream and a deferred message handed to the async writer.
+ * The messages are written to a stream discarding everything.
+ */
+
+namespace {
+  class NullBuffer : public std::streambuf {
+   protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+  };
+
+  NullBuffer nullBuffer;
+  std::ostream nullStream(&nullBuffer);
+}
+
+static void loggerSuppressed(benchmark::State& state) {
+  Logger::setDefaultStreamLogger(nullStream);
+  Logger log = Logger::getLogger('B');
+  log.show(LogLevel::WARN);
+  int i = 0;
+  for (auto _ : state) log.info() << "value " << i++;
+}
+BENCHMARK(loggerSuppressed);
+
+static void loggerStream(benchmark::State& state) {
+  Logger::setDefaultStreamLogger(nullStream);
+  Logger log = Logger::getLogger('B');
+  log.show(LogLevel::TRACE);
+  int i = 0;
+  for (auto _ : state) log.info() << "value " << i++ << " of " << 1.5;
+}
+BENCHMARK(loggerStream);
+
+static void loggerAsyncDeferred(benchmark::State& state) {
+  Logger::setDefaultAsyncLogger(nullStream);
+  Logger log = Logger::getLogger('B');
+  log.show(LogLevel::TRACE);
+  int i = 0;
+  for (auto _ : state) log.deferred(LogLevel::INFO, "value {} of {}", i++, 1.5);
+  Logger::setDefaultStreamLogger(nullStream);  // stops the writer thread
+}
+BENCHMARK(loggerAsyncDeferred);
@@ -0,0 +1,95 @@
+#include <eeros/math/Matrix.hpp>
+#include <benchmark/benchmark.h>
+
+using namespace eeros::math;
+
+/*
+ * Matrix operations by size, 3x3 being the typical size of a robot kinematics.
+ */
+
+namespace {
+  template < unsigned int N >
+  Matrix<N, N> filled(double start) {
+    Matrix<N, N> m;
+    for (unsigned int i = 0; i < N * N; i++) m[i] = start + 0.01 * i;
+    return m;
+  }
+}
+
+template < unsigned int N >
+static void matrixMultiply(benchmark::State& state) {
+  auto a = filled<N>(1.0), b = filled<N>(2.0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    Matrix<N, N> c = a * b;
+    benchmark::DoNotOptimize(c);
+  }
+}
+BENCHMARK_TEMPLATE(matrixMultiply, 2);
+BENCHMARK_TEMPLATE(matrixMultiply, 3);
+BENCHMARK_TEMPLATE(matrixMultiply, 4);
+BENCHMARK_TEMPLATE(matrixMultiply, 6);
+BENCHMARK_TEMPLATE(matrixMultiply, 8);
+
+template < unsigned int N >
+static void matrixVector(benchmark::State& state) {
+  auto a = filled<N>(1.0);
+  Matrix<N, 1> v;
+  v.fill(0.5);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    Matrix<N, 1> r = a * v;
+    benchmark::DoNotOptimize(r);
+  }
+}
+BENCHMARK_TEMPLATE(matrixVector, 3);
+BENCHMARK_TEMPLATE(matrixVector, 6);
+BENCHMARK_TEMPLATE(matrixVector, 8);
+
+template < unsigned int N >
+static void matrixAdd(benchmark::State& state) {
+  auto a = filled<N>(1.0), b = filled<N>(2.0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    Matrix<N, N> c = a + b;
+    benchmark::DoNotOptimize(c);
+  }
+}
+BENCHMARK_TEMPLATE(matrixAdd, 3);
+BENCHMARK_TEMPLATE(matrixAdd, 8);
+
+template < unsigned int N >
+static void matrixInvert(benchmark::State& state) {
+  auto a = filled<N>(1.0);
+  for (unsigned int i = 0; i < N; i++) a(i, i) += N;  // well conditioned
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    Matrix<N, N> inv = !a;
+    benchmark::DoNotOptimize(inv);
+  }
+}
+BENCHMARK_TEMPLATE(matrixInvert, 2);
+BENCHMARK_TEMPLATE(matrixInvert, 3);
+BENCHMARK_TEMPLATE(matrixInvert, 4);
+
+template < unsigned int N >
+static void matrixTranspose(benchmark::State& state) {
+  auto a = filled<N>(1.0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    Matrix<N, N> t = a.transpose();
+    benchmark::DoNotOptimize(t);
+  }
+}
+BENCHMARK_TEMPLATE(matrixTranspose, 3);
+BENCHMARK_TEMPLATE(matrixTranspose, 8);
+
+static void matrixRotation(benchmark::State& state) {
+  double angle = 0.1;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(angle);
+    auto r = Matrix<3, 3>::createRotZ(angle) * Matrix<3, 3>::createRotY(angle);
+    benchmark::DoNotOptimize(r);
+  }
+}
+BENCHMARK(matrixRotation);
@@ -0,0 +1,70 @@
+#include <eeros/control/PathPlannerConstAcc.hpp>
+#include <eeros/control/PathPlannerConstJerk.hpp>
+#include <eeros/control/PathPlannerCubic.hpp>
+#include <benchmark/benchmark.h>
+
+using namespace eeros::control;
+using namespace eeros::math;
+
+/*
+ * One run of the path planners while they move, and the planning of a move.
+ * A new move is started whenever the previous one has ended.
+ */
+
+static void pathPlannerConstAccRun(benchmark::State& state) {
+  PathPlannerConstAcc<Matrix<3,1>> planner({1,1,1}, {10,10,10}, {10,10,10}, 0.001);
+  Matrix<3,1> start{0, 0, 0}, end{1, 2, -1};
+  planner.move(start, end);
+  for (auto _ : state) {
+    planner.run();
+    if (planner.endReached()) {
+      state.PauseTiming();
+      planner.move(start, end);
+      state.ResumeTiming();
+    }
+  }
+}
+BENCHMARK(pathPlannerConstAccRun);
+
+static void pathPlannerConstAccMove(benchmark::State& state) {
+  PathPlannerConstAcc<Matrix<3,1>> planner({1,1,1}, {10,10,10}, {10,10,10}, 0.001);
+  Matrix<3,1> start{0, 0, 0}, end{1, 2, -1};
+  for (auto _ : state) benchmark::DoNotOptimize(planner.move(start, end));
+}
+BENCHMARK(pathPlannerConstAccMove);
+
+static void pathPlannerConstJerkRun(benchmark::State& state) {
+  PathPlannerConstJerk<Matrix<3,1>> planner({1,1,1}, {10,10,10}, 0.001);
+  Matrix<3,1> start{0, 0, 0}, end{1, 2, -1};
+  planner.move(start, end);
+  for (auto _ : state) {
+    planner.run();
+    if (planner.endReached()) {
+      state.PauseTiming();
+      planner.move(start, end);
+      state.ResumeTiming();
+    }
+  }
+}
+BENCHMARK(pathPlannerConstJerkRun);
+
+static void pathPlannerConstJerkMove(benchmark::State& state) {
+  PathPlannerConstJerk<Matrix<3,1>> planner({1,1,1}, {10,10,10}, 0.001);
+  Matrix<3,1> start{0, 0, 0}, end{1, 2, -1};
+  for (auto _ : state) benchmark::DoNotOptimize(planner.move(start, end));
+}
+BENCHMARK(pathPlannerConstJerkMove);
+
+static void pathPlannerCubicRun(benchmark::State& state) {
+  PathPlannerCubic planner(0.001);
+  planner.move(10, 0, 100);
+  for (auto _ : state) {
+    planner.run();
+    if (planner.endReached()) {
+      state.PauseTiming();
+      planner.move(10, 0, 100);
+      state.ResumeTiming();
+    }
+  }
+}
+BENCHMARK(pathPlannerCubicRun);
@@ -0,0 +1,67 @@
+#include <eeros/control/Signal.hpp>
+#include <eeros/control/Constant.hpp>
+#include <eeros/control/Gain.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <benchmark/benchmark.h>
+
+using namespace eeros::control;
+using namespace eeros::math;
+
+/*
+ * Signal accessors, for a scalar and a 6x6 matrix. The accessors are virtual
+ * unless EEROS_FINAL_SIGNALS is set.
+ */
+
+template < typename T >
+static void signalGetValue(benchmark::State& state) {
+  Signal<T> s;
+  for (auto _ : state) benchmark::DoNotOptimize(s.getValue());
+}
+BENCHMARK_TEMPLATE(signalGetValue, double);
+BENCHMARK_TEMPLATE(signalGetValue, Matrix<6, 6>);
+
+template < typename T >
+static void signalGetValueRef(benchmark::State& state) {
+  Signal<T> s;
+  for (auto _ : state) benchmark::DoNotOptimize(&s.getValueRef());
+}
+BENCHMARK_TEMPLATE(signalGetValueRef, double);
+BENCHMARK_TEMPLATE(signalGetValueRef, Matrix<6, 6>);
+
+template < typename T >
+static void signalSet(benchmark::State& state) {
+  Signal<T> s;
+  T v{};
+  v = 0.0;
+  uint64_t t = 0;
+  for (auto _ : state) {
+    s.set(v, t++);
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK_TEMPLATE(signalSet, double);
+BENCHMARK_TEMPLATE(signalSet, Matrix<6, 6>);
+
+template < typename T >
+static void signalSetValueTimestamp(benchmark::State& state) {
+  Signal<T> s;
+  T v{};
+  v = 0.0;
+  uint64_t t = 0;
+  for (auto _ : state) {
+    s.setValue(v);
+    s.setTimestamp(t++);
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK_TEMPLATE(signalSetValueTimestamp, double);
+BENCHMARK_TEMPLATE(signalSetValueTimestamp, Matrix<6, 6>);
+
+// reading a connected input and writing the output, the work of a simple block
+static void signalThroughGain(benchmark::State& state) {
+  Constant<> c(1.0);
+  Gain<> g(2.0);
+  g.getIn().connect(c.getOut());
+  for (auto _ : state) g.run();
+}
+BENCHMARK(signalThroughGain);
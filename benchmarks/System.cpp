@@ -0,0 +1,25 @@
+#include <eeros/core/System.hpp>
+#include <benchmark/benchmark.h>
+
+using namespace eeros;
+
+/*
+ * Reading the time, with and without a cycle timestamp.
+ */
+
+static void systemGetTimeNs(benchmark::State& state) {
+  for (auto _ : state) benchmark::DoNotOptimize(System::getTimeNs());
+}
+BENCHMARK(systemGetTimeNs);
+
+static void systemGetClockNs(benchmark::State& state) {
+  for (auto _ : state) benchmark::DoNotOptimize(System::getClockNs());
+}
+BENCHMARK(systemGetClockNs);
+
+static void systemGetTimeNsInCycle(benchmark::State& state) {
+  System::beginCycle();
+  for (auto _ : state) benchmark::DoNotOptimize(System::getTimeNs());
+  System::endCycle();
+}
+BENCHMARK(systemGetTimeNsInCycle);
@@ -0,0 +1,65 @@
+#include <eeros/control/TimeDomain.hpp>
+#include <eeros/control/Constant.hpp>
+#include <eeros/control/Gain.hpp>
+#include <eeros/control/Sum.hpp>
+#include <eeros/control/Saturation.hpp>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+using namespace eeros::control;
+
+/*
+ * One run of a synthetic time domain with 100, 500 and 1000 blocks, built from
+ * independent chains of Gain -> Sum -> Saturation, added chain by chain. The
+ * blocks are either allocated one by one or created in the arena of the time
+ * domain, and run in the order added or frozen.
+ */
+
+namespace {
+  struct Chains {
+    Chains(TimeDomain& td, int blocks, bool arena) {
+      if (arena) td.getArena().reserve(blocks * (sizeof(Gain<>) + sizeof(Sum<2>) + sizeof(Saturation<>)) / 3);
+      Constant<>& c = arena ? td.createBlock<Constant<>>(1.0) : *constants.emplace_back(std::make_unique<Constant<>>(1.0));
+      if (!arena) td.addBlock(c);
+      for (int i = 1; i + 3 <= blocks; i += 3) {
+        Gain<>* g;
+        Sum<2>* s;
+        Saturation<>* sat;
+        if (arena) {
+          g = &td.createBlock<Gain<>>(2.0);
+          s = &td.createBlock<Sum<2>>();
+          sat = &td.createBlock<Saturation<>>(-10.0, 10.0);
+        } else {
+          g = gains.emplace_back(std::make_unique<Gain<>>(2.0)).get();
+          s = sums.emplace_back(std::make_unique<Sum<2>>()).get();
+          sat = sats.emplace_back(std::make_unique<Saturation<>>(-10.0, 10.0)).get();
+          td.addBlock(g);
+          td.addBlock(s);
+          td.addBlock(sat);
+        }
+        g->getIn().connect(c.getOut());
+        s->getIn(0).connect(g->getOut());
+        s->getIn(1).connect(c.getOut());
+        sat->getIn().connect(s->getOut());
+      }
+    }
+    std::vector<std::unique_ptr<Constant<>>> constants;
+    std::vector<std::unique_ptr<Gain<>>> gains;
+    std::vector<std::unique_ptr<Sum<2>>> sums;
+    std::vector<std::unique_ptr<Saturation<>>> sats;
+  };
+}
+
+static void timeDomainRun(benchmark::State& state) {
+  TimeDomain td("bench", 0.001, false);
+  Chains chains(td, state.range(0), state.range(1));
+  td.setFrozen(state.range(2));
+  td.run();
+  for (auto _ : state) td.run();
+  state.counters["blocks"] = td.getBlocks().size();
+  state.counters["perBlock"] = benchmark::Counter(td.getBlocks().size(), benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(timeDomainRun)
+    ->ArgNames({"blocks", "arena", "frozen"})
+    ->ArgsProduct({{100, 500, 1000}, {0, 1}, {0, 1}});
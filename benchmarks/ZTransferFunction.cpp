@@ -0,0 +1,25 @@
+#include <eeros/control/Constant.hpp>
+#include <eeros/control/ZTransferFunction.hpp>
+#include <benchmark/benchmark.h>
+
+using namespace eeros::control;
+
+/*
+ * One run of a first and a second order transfer function.
+ */
+
+static void zTransferFunctionPT1(benchmark::State& state) {
+  Constant<> c(1.0);
+  auto tf = ZTransferFunction<1>::PT1(0.001, 1.0, 0.1);
+  tf.getIn().connect(c.getOut());
+  for (auto _ : state) tf.run();
+}
+BENCHMARK(zTransferFunctionPT1);
+
+static void zTransferFunctionPID(benchmark::State& state) {
+  Constant<> c(1.0);
+  auto tf = ZTransferFunction<1>::PID(0.001, 1.0, 0.5, 0.1, 0.05);
+  tf.getIn().connect(c.getOut());
+  for (auto _ : state) tf.run();
+}
+BENCHMARK(zTransferFunctionPID);
@@ -0,0 +1,138 @@
+#include <eeros/hal/Input.hpp>
+#include <eeros/hal/Output.hpp>
+#include <eeros/hal/ScalableInput.hpp>
+#include <eeros/hal/ScalableOutput.hpp>
+#include <eeros/hal/InputRecorder.hpp>
+#include <eeros/core/Fault.hpp>
+#include <map>
+#include <memory>
+
+/*
+ * HAL library which feeds the values recorded with HAL::recordInputs() back in.
+ * The devHandle of a device is the recording file, the inputs are matched by
+ * their signal id. Each get() of an input returns the next recorded value of
+ * the input, the last one once the recording is exhausted. The recorded values
+ * are already scaled, the scale of the configuration is ignored, its unit is
+ * kept. Outputs accept any value and return the last one set.
+ *
+ * Run the executor in TimingMode::lockstep to replay at full speed, or in any
+ * other timing mode to replay in real time.
+ *
+ * To replay, the library of the devices in the configuration is replaced, e.g.
+ *
+ *   "replay": {
+ *     "library": "libreplayeeros.so",
+ *     "devHandle": "run.eerec",
+ *     "subdevice0": { "type": "AnalogIn", "channel0": { "signalId": "enc0" } }
+ *   }
+ */
+
+using namespace eeros;
+using namespace eeros::hal;
+
+namespace {
+
+std::shared_ptr<InputRecording> recording(const std::string& file) {
+  static std::map<std::string, std::shared_ptr<InputRecording>> recordings;
+  auto& r = recordings[file];
+  if (!r) {
+    r = std::make_shared<InputRecording>(file);
+    if (!r->isValid()) throw Fault("could not read recording '" + file + "'");
+  }
+  return r;
+}
+
+class Stream {
+ public:
+  Stream(const std::string& file, const std::string& id) : source(recording(file)), values(source->getValues(id)), next(0) {
+    if (values == nullptr || values->empty()) throw Fault("input '" + id + "' is not recorded in '" + file + "'");
+  }
+
+  double get() {
+    double v = (*values)[next];
+    if (next + 1 < values->size()) next++;
+    return v;
+  }
+
+ private:
+  std::shared_ptr<InputRecording> source;
+  const std::vector<double>* values;
+  size_t next;
+};
+
+class ReplayDigIn : public Input<bool> {
+ public:
+  ReplayDigIn(std::string id, void* libHandle, std::string file) : Input<bool>(id, libHandle), stream(file, id) { }
+  bool get() override { return stream.get() != 0; }
+
+ private:
+  Stream stream;
+};
+
+class ReplayAnalogIn : public ScalableInput<double> {
+ public:
+  ReplayAnalogIn(std::string id, void* libHandle, std::string file, SIUnit unit)
+      : ScalableInput<double>(id, libHandle, 1, 0, 0, 0, unit), stream(file, id) { }
+  double get() override { return stream.get(); }
+
+ private:
+  Stream stream;
+};
+
+class ReplayDigOut : public Output<bool> {
+ public:
+  ReplayDigOut(std::string id, void* libHandle) : Output<bool>(id, libHandle) { }
+  bool get() override { return value; }
+  void set(bool v) override { value = v; }
+
+ private:
+  bool value = false;
+};
+
+class ReplayAnalogOut : public ScalableOutput<double> {
+ public:
+  ReplayAnalogOut(std::string id, void* libHandle, SIUnit unit) : ScalableOutput<double>(id, libHandle, 1, 0, 0, 0, unit) { }
+  double get() override { return value; }
+  void set(double v) override { value = v; }
+
+ private:
+  double value = 0;
+};
+
+}
+
+extern "C" {
+
+Input<bool>* createDigIn(std::string id, void* libHandle, std::string device, uint32_t subDeviceNumber, uint32_t channel, bool inverted, std::string additionalArguments) {
+  return new ReplayDigIn(id, libHandle, device);
+}
+
+Input<bool>* createWatchdog(std::string id, void* libHandle, std::string device, uint32_t subDeviceNumber, uint32_t channel, bool inverted, std::string additionalArguments) {
+  return new ReplayDigIn(id, libHandle, device);
+}
+
+Output<bool>* createDigOut(std::string id, void* libHandle, std::string device, uint32_t subDeviceNumber, uint32_t channel, bool inverted, std::string additionalArguments) {
+  return new ReplayDigOut(id, libHandle);
+}
+
+ScalableInput<double>* createAnalogIn(std::string id, void* libHandle, std::string device, uint32_t subDeviceNumber, uint32_t channel,
+                                      double scale, double offset, double rangeMin, double rangeMax, SIUnit unit, std::string additionalArguments) {
+  return new ReplayAnalogIn(id, libHandle, device, unit);
+}
+
+ScalableInput<double>* createFqd(std::string id, void* libHandle, std::string device, uint32_t subDeviceNumber, uint32_t channel,
+                                 double scale, double offset, double rangeMin, double rangeMax, SIUnit unit, std::string additionalArguments) {
+  return new ReplayAnalogIn(id, libHandle, device, unit);
+}
+
+ScalableOutput<double>* createAnalogOut(std::string id, void* libHandle, std::string device, uint32_t subDeviceNumber, uint32_t channel,
+                                        double scale, double offset, double rangeMin, double rangeMax, SIUnit unit, std::string additionalArguments) {
+  return new ReplayAnalogOut(id, libHandle, unit);
+}
+
+ScalableOutput<double>* createPwm(std::string id, void* libHandle, std::string device, uint32_t subDeviceNumber, uint32_t channel,
+                                  double scale, double offset, double rangeMin, double rangeMax, SIUnit unit, std::string additionalArguments) {
+  return new ReplayAnalogOut(id, libHandle, unit);
+}
+
+}
@@ -0,0 +1,299 @@
+#include <eeros/hal/Input.hpp>
+#include <eeros/hal/Output.hpp>
+#include <eeros/hal/ScalableInput.hpp>
+#include <eeros/hal/ScalableOutput.hpp>
+#include <eeros/core/Fault.hpp>
+#include <eeros/core/System.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <time.h>
+#include <vector>
+
+/*
+ * HAL library simulating a device on a field bus, so that the process image,
+ * batching and the timing of an application can be benchmarked and tested
+ * without hardware. Each output is wired back to the input of the same type and
+ * channel number of the device, analog and logic channels are wired separately.
+ *
+ * Accessing the bus costs time, the calling thread waits (or spins) as long as a
+ * transaction takes. The bus serves one transaction at a time, concurrent threads
+ * wait for each other. A transaction takes
+ *
+ *   transaction + perChannel * channels + sum of the latencies of the channels
+ *
+ * The devHandle holds the name of the device, followed by its model, e.g.
+ * "bus0; transaction=50e-6; perChannel=2e-6; batch=true; spin=false".
+ * - transaction: fixed cost of a transaction in sec
+ * - perChannel: cost of transferring one channel in sec
+ * - batch: with true, all inputs of the device are read in one transaction by
+ *   HAL::updateInputs(), and the changed outputs are written in one transaction
+ *   by HAL::commitOutputs(). With false, each get() and set() is a transaction.
+ * - spin: with true, the thread spins instead of sleeping during a transaction
+ *
+ * The additionalArguments of a channel may add a latency to each of its reads
+ * or writes, e.g. "latency=20e-6".
+ *
+ * The feature functions getInputBusStatistics() and getOutputBusStatistics()
+ * return the number of transactions and the total bus time of the device.
+ */
+
+using namespace eeros;
+using namespace eeros::hal;
+
+namespace {
+
+std::map<std::string, std::string> parseArguments(const std::string& text, std::string* name = nullptr) {
+  std::map<std::string, std::string> args;
+  std::istringstream is(text);
+  std::string item;
+  bool first = true;
+  while (std::getline(is, item, ';')) {
+    auto b = item.find_first_not_of(" \t");
+    auto e = item.find_last_not_of(" \t");
+    item = b == std::string::npos ? "" : item.substr(b, e - b + 1);
+    auto eq = item.find('=');
+    if (first && name != nullptr) *name = item;
+    else if (eq != std::string::npos) args[item.substr(0, eq)] = item.substr(eq + 1);
+    else if (!item.empty()) throw Fault("invalid argument '" + item + "' in '" + text + "'");
+    first = false;
+  }
+  return args;
+}
+
+double number(const std::map<std::string, std::string>& args, const std::string& key, double value) {
+  auto it = args.find(key);
+  return it != args.end() ? std::atof(it->second.c_str()) : value;
+}
+
+class Device;
+
+class Channel {
+ public:
+  Channel(Device& device, bool logic, uint32_t channel, double latency) : device(device), logic(logic), channel(channel), latency(latency) { }
+  Device& device;
+  const bool logic;
+  const uint32_t channel;
+  const double latency;
+};
+
+class InputChannel : public Channel {
+ public:
+  using Channel::Channel;
+  std::atomic<double> latched{0};   // value of the last batch update
+};
+
+class OutputChannel : public Channel {
+ public:
+  using Channel::Channel;
+  double staged = 0;   // value of the last set(), written by the next commit
+  bool changed = false;
+};
+
+class Device : public InputBatch, public OutputBatch {
+ public:
+  Device(const std::map<std::string, std::string>& model)
+      : transaction(number(model, "transaction", 0)), perChannel(number(model, "perChannel", 0)),
+        batch(model.count("batch") > 0 && model.at("batch") == "true"),
+        spin(model.count("spin") > 0 && model.at("spin") == "true") { }
+
+  InputChannel* addInput(bool logic, uint32_t channel, double latency) {
+    std::lock_guard<std::mutex> lock(bus);
+    inputs.push_back(std::make_unique<InputChannel>(*this, logic, channel, latency));
+    return inputs.back().get();
+  }
+
+  OutputChannel* addOutput(bool logic, uint32_t channel, double latency) {
+    std::lock_guard<std::mutex> lock(bus);
+    outputs.push_back(std::make_unique<OutputChannel>(*this, logic, channel, latency));
+    return outputs.back().get();
+  }
+
+  double read(InputChannel& in) {
+    if (batch) return in.latched.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(bus);
+    transfer(1, in.latency);
+    return wire(in);
+  }
+
+  void write(OutputChannel& out, double value) {
+    std::lock_guard<std::mutex> lock(bus);
+    if (batch) {
+      out.changed |= out.staged != value;
+      out.staged = value;
+      return;
+    }
+    transfer(1, out.latency);
+    wire(out) = value;
+  }
+
+  double staged(OutputChannel& out) {
+    std::lock_guard<std::mutex> lock(bus);
+    return batch ? out.staged : wire(out);
+  }
+
+  void update() override {
+    std::lock_guard<std::mutex> lock(bus);
+    double latency = 0;
+    for (auto& in : inputs) latency += in->latency;
+    transfer(inputs.size(), latency);
+    for (auto& in : inputs) in->latched.store(wire(*in), std::memory_order_relaxed);
+  }
+
+  void commit() override {
+    std::lock_guard<std::mutex> lock(bus);
+    int n = 0;
+    double latency = 0;
+    for (auto& out : outputs) {
+      if (!out->changed) continue;
+      n++;
+      latency += out->latency;
+    }
+    if (n == 0) return;   // nothing changed, no transaction
+    transfer(n, latency);
+    for (auto& out : outputs) {
+      if (!out->changed) continue;
+      wire(*out) = out->staged;
+      out->changed = false;
+    }
+  }
+
+  void statistics(uint64_t* count, double* time) {
+    std::lock_guard<std::mutex> lock(bus);
+    if (count != nullptr) *count = transactions;
+    if (time != nullptr) *time = busTime;
+  }
+
+  const double transaction;
+  const double perChannel;
+  const bool batch;
+  const bool spin;
+
+ private:
+  // bus must be locked
+  double& wire(const Channel& c) {
+    return wires[{c.logic, c.channel}];
+  }
+
+  // bus must be locked
+  void transfer(int channels, double latency) {
+    double duration = transaction + perChannel * channels + latency;
+    transactions++;
+    busTime += duration;
+    if (duration <= 0) return;
+    uint64_t end = System::getClockNs() + static_cast<uint64_t>(duration * 1.0e9);
+    if (spin) {
+      while (System::getClockNs() < end);
+    } else {
+      struct timespec ts;
+      ts.tv_sec = static_cast<time_t>(duration);
+      ts.tv_nsec = static_cast<long>((duration - ts.tv_sec) * 1.0e9);
+      while (clock_nanosleep(CLOCK_MONOTONIC, 0, &ts, &ts) != 0);
+    }
+  }
+
+  std::mutex bus;
+  std::vector<std::unique_ptr<InputChannel>> inputs;
+  std::vector<std::unique_ptr<OutputChannel>> outputs;
+  std::map<std::pair<bool, uint32_t>, double> wires;
+  uint64_t transactions = 0;
+  double busTime = 0;
+};
+
+Device& device(const std::string& devHandle) {
+  static std::mutex mtx;
+  static std::map<std::string, std::unique_ptr<Device>> devices;
+  std::lock_guard<std::mutex> lock(mtx);
+  std::string name;
+  auto model = parseArguments(devHandle, &name);
+  auto& d = devices[name];
+  if (!d) d = std::make_unique<Device>(model);
+  return *d;
+}
+
+double latency(const std::string& additionalArguments) {
+  return number(parseArguments(additionalArguments), "latency", 0);
+}
+
+class SimDigIn : public Input<bool> {
+ public:
+  SimDigIn(std::string id, void* libHandle, InputChannel* channel, bool inverted) : Input<bool>(id, libHandle), channel(channel), inverted(inverted) { }
+  bool get() override { return (channel->device.read(*channel) != 0) != inverted; }
+  InputBatch* getBatch() override { return channel->device.batch ? &channel->device : nullptr; }
+  InputChannel* channel;
+
+ private:
+  bool inverted;
+};
+
+class SimDigOut : public Output<bool> {
+ public:
+  SimDigOut(std::string id, void* libHandle, OutputChannel* channel, bool inverted) : Output<bool>(id, libHandle), channel(channel), inverted(inverted) { }
+  bool get() override { return (channel->device.staged(*channel) != 0) != inverted; }
+  void set(bool value) override { channel->device.write(*channel, value != inverted); }
+  OutputBatch* getBatch() override { return channel->device.batch ? &channel->device : nullptr; }
+  OutputChannel* channel;
+
+ private:
+  bool inverted;
+};
+
+class SimAnalogIn : public ScalableInput<double> {
+ public:
+  SimAnalogIn(std::string id, void* libHandle, InputChannel* channel, double scale, double offset, double rangeMin, double rangeMax, SIUnit unit)
+      : ScalableInput<double>(id, libHandle, scale, offset, rangeMin, rangeMax, unit), channel(channel) { }
+  double get() override { return toValue(channel->device.read(*channel)); }
+  InputBatch* getBatch() override { return channel->device.batch ? &channel->device : nullptr; }
+  InputChannel* channel;
+};
+
+class SimAnalogOut : public ScalableOutput<double> {
+ public:
+  SimAnalogOut(std::string id, void* libHandle, OutputChannel* channel, double scale, double offset, double rangeMin, double rangeMax, SIUnit unit)
+      : ScalableOutput<double>(id, libHandle, scale, offset, rangeMin, rangeMax, unit), channel(channel) { }
+  double get() override { return (channel->device.staged(*channel) - offset) / scale; }
+  void set(double value) override { channel->device.write(*channel, toRaw(value)); }
+  OutputBatch* getBatch() override { return channel->device.batch ? &channel->device : nullptr; }
+  OutputChannel* channel;
+};
+
+}
+
+extern "C" {
+
+Input<bool>* createDigIn(std::string id, void* libHandle, std::string device, uint32_t subDeviceNumber, uint32_t channel, bool inverted, std::string additionalArguments) {
+  auto& d = ::device(device);
+  return new SimDigIn(id, libHandle, d.addInput(true, channel, latency(additionalArguments)), inverted);
+}
+
+Output<bool>* createDigOut(std::string id, void* libHandle, std::string device, uint32_t subDeviceNumber, uint32_t channel, bool inverted, std::string additionalArguments) {
+  auto& d = ::device(device);
+  return new SimDigOut(id, libHandle, d.addOutput(true, channel, latency(additionalArguments)), inverted);
+}
+
+ScalableInput<double>* createAnalogIn(std::string id, void* libHandle, std::string device, uint32_t subDeviceNumber, uint32_t channel,
+                                      double scale, double offset, double rangeMin, double rangeMax, SIUnit unit, std::string additionalArguments) {
+  auto& d = ::device(device);
+  return new SimAnalogIn(id, libHandle, d.addInput(false, channel, latency(additionalArguments)), scale, offset, rangeMin, rangeMax, unit);
+}
+
+ScalableOutput<double>* createAnalogOut(std::string id, void* libHandle, std::string device, uint32_t subDeviceNumber, uint32_t channel,
+                                        double scale, double offset, double rangeMin, double rangeMax, SIUnit unit, std::string additionalArguments) {
+  auto& d = ::device(device);
+  return new SimAnalogOut(id, libHandle, d.addOutput(false, channel, latency(additionalArguments)), scale, offset, rangeMin, rangeMax, unit);
+}
+
+void getInputBusStatistics(InputInterface* obj, uint64_t* transactions, double* busTime) {
+  if (auto in = dynamic_cast<SimDigIn*>(obj)) in->channel->device.statistics(transactions, busTime);
+  else if (auto in = dynamic_cast<SimAnalogIn*>(obj)) in->channel->device.statistics(transactions, busTime);
+}
+
+void getOutputBusStatistics(OutputInterface* obj, uint64_t* transactions, double* busTime) {
+  if (auto out = dynamic_cast<SimDigOut*>(obj)) out->channel->device.statistics(transactions, busTime);
+  else if (auto out = dynamic_cast<SimAnalogOut*>(obj)) out->channel->device.statistics(transactions, busTime);
+}
+
+}
@@ -0,0 +1,36 @@
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+
+#include <eeros/core/System.hpp>
+
+/*
+ * Measures the cost of reading the system time with each available clock source.
+ * CLOCK_MONOTONIC is usually served by the vDSO without entering the kernel,
+ * CLOCK_MONOTONIC_RAW is a real syscall on many kernels and the TSC avoids
+ * the clock read completely.
+ */
+
+using namespace eeros;
+
+void measure(const char* name, System::ClockSource source, int runs) {
+  if (!System::setClockSource(source)) {
+    std::cout << name << ":\tnot available" << std::endl;
+    return;
+  }
+  uint64_t start = System::getTimeNs();
+  volatile uint64_t sink = 0;
+  for (int i = 0; i < runs; i++) sink = System::getTimeNs();
+  uint64_t stop = System::getTimeNs();
+  (void)sink;
+  std::cout << name << ":\t" << static_cast<double>(stop - start) / runs << " ns per call, resolution "
+            << System::getClockResolution() * 1e9 << " ns" << std::endl;
+}
+
+int main(int argc, char **argv) {
+  int runs = (argc > 1) ? std::atoi(argv[1]) : 10000000;
+  measure("monotonic", System::ClockSource::monotonic, runs);
+  measure("monotonicRaw", System::ClockSource::monotonicRaw, runs);
+  measure("tsc", System::ClockSource::tsc, runs);
+  return 0;
+}
@@ -0,0 +1,57 @@
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <chrono>
+
+#include <eeros/control/TimeDomain.hpp>
+#include <eeros/control/Constant.hpp>
+#include <eeros/control/Gain.hpp>
+#include <eeros/control/Sum.hpp>
+#include <eeros/control/Saturation.hpp>
+
+/*
+ * Measures the time for one run of a time domain with many small blocks,
+ * once with the blocks in the order they were added and once frozen.
+ * The blocks form 100 independent chains of Gain -> Sum -> Saturation, 
+ * added chain by chain, so that consecutive blocks are of different type.
+ */
+
+using namespace eeros::control;
+using namespace std::chrono;
+
+double measure(TimeDomain& td, int runs) {
+  for (int i = 0; i < 1000; i++) td.run();
+  auto start = steady_clock::now();
+  for (int i = 0; i < runs; i++) td.run();
+  return duration<double, std::nano>(steady_clock::now() - start).count() / runs;
+}
+
+int main(int argc, char **argv) {
+  const int chains = 100, runs = 100000;
+  Constant<> c(1.0);
+  std::vector<std::unique_ptr<Gain<>>> gains;
+  std::vector<std::unique_ptr<Sum<2>>> sums;
+  std::vector<std::unique_ptr<Saturation<>>> sats;
+  TimeDomain td("bench", 0.001, false);
+  td.addBlock(c);
+  for (int i = 0; i < chains; i++) {
+    gains.push_back(std::make_unique<Gain<>>(2.0));
+    sums.push_back(std::make_unique<Sum<2>>());
+    sats.push_back(std::make_unique<Saturation<>>(-10.0, 10.0));
+    gains.back()->getIn().connect(c.getOut());
+    sums.back()->getIn(0).connect(gains.back()->getOut());
+    sums.back()->getIn(1).connect(c.getOut());
+    sats.back()->getIn().connect(sums.back()->getOut());
+    td.addBlock(*gains.back());
+    td.addBlock(*sums.back());
+    td.addBlock(*sats.back());
+  }
+  std::cout << "blocks:\t" << td.getBlocks().size() << std::endl;
+  for (int round = 0; round < 3; round++) {
+    td.setFrozen(false);
+    std::cout << "normal:\t" << measure(td, runs) << " ns per run" << std::endl;
+    td.setFrozen(true);
+    std::cout << "frozen:\t" << measure(td, runs) << " ns per run" << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,85 @@
+#include <iostream>
+#include <mutex>
+#include <vector>
+#include <chrono>
+
+#include <eeros/control/Transition.hpp>
+#include <eeros/control/Constant.hpp>
+
+/*
+ * Measures the cost of bringing samples from a fast to a slow time domain,
+ * once with the mutex protected vector Transition used before and once with
+ * the wait-free ring buffer of Transition. For each ratio, the fast side
+ * runs ratio times and the slow side once per cycle, the time is given
+ * per cycle.
+ */
+
+using namespace eeros;
+using namespace eeros::control;
+using namespace std::chrono;
+
+// fast to slow path of the mutex based transition, kept for comparison
+class LockedTransition {
+ public:
+  void push(const Signal<double>& s) {
+    std::lock_guard<std::mutex> lock(mtx);
+    buf.push_back(s);
+  }
+  void drain(timestamp_t time, Signal<double>& out) {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::size_t i = 0, size = buf.size();
+    if (size == 0) return;
+    while (i < size && time > buf[i].getTimestamp()) i++;
+    if (i > 0) i--;
+    out.set(buf[i].getValue(), buf[i].getTimestamp());
+    buf.clear();
+  }
+ private:
+  std::mutex mtx;
+  std::vector<Signal<double>> buf;
+};
+
+double measureLocked(int ratio, int cycles) {
+  LockedTransition t;
+  Constant<> fast(1.0), slow(0.0);
+  Signal<double> out;
+  auto start = steady_clock::now();
+  for (int k = 0; k < cycles; k++) {
+    for (int i = 0; i < ratio; i++) {
+      fast.getOut().getSignal().set(i, k * ratio + i);
+      t.push(fast.getOut().getSignal());
+    }
+    slow.getOut().getSignal().set(0, k * ratio);
+    t.drain(slow.getOut().getSignal().getTimestamp(), out);
+  }
+  return duration<double, std::nano>(steady_clock::now() - start).count() / cycles;
+}
+
+double measureWaitFree(int ratio, int cycles) {
+  Transition<> t(1.0 / ratio);
+  Constant<> fast(1.0), slow(0.0);
+  t.inBlock.getIn().connect(fast.getOut());
+  t.outBlock.getIn().connect(slow.getOut());
+  auto start = steady_clock::now();
+  for (int k = 0; k < cycles; k++) {
+    for (int i = 0; i < ratio; i++) {
+      fast.getOut().getSignal().set(i, k * ratio + i);
+      t.inBlock.run();
+    }
+    slow.getOut().getSignal().set(0, k * ratio);
+    t.outBlock.run();
+  }
+  return duration<double, std::nano>(steady_clock::now() - start).count() / cycles;
+}
+
+int main(int argc, char **argv) {
+  const int samples = 10000000;
+  for (int ratio : {4, 10, 100}) {
+    int cycles = samples / ratio;
+    measureLocked(ratio, cycles / 10);
+    measureWaitFree(ratio, cycles / 10);
+    std::cout << "1:" << ratio << "\tmutex:\t" << measureLocked(ratio, cycles) << " ns per cycle" << std::endl;
+    std::cout << "1:" << ratio << "\twait-free:\t" << measureWaitFree(ratio, cycles) << " ns per cycle" << std::endl;
+  }
+  return 0;
+}
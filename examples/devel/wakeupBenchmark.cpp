@@ -0,0 +1,65 @@
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+
+#include <eeros/core/Semaphore.hpp>
+#include <eeros/core/FutexSemaphore.hpp>
+
+/*
+ * Measures the latency of a wakeup handoff from one thread to another,
+ * as done by the executor for every harmonic thread in every cycle.
+ * Compares eeros::Semaphore (mutex and condition variable) with 
+ * eeros::FutexSemaphore (futex with spin phase).
+ */
+
+using namespace std::chrono;
+
+template < typename S >
+void measure(const char* name, S& ping, S& pong, int runs) {
+  std::vector<double> latency;
+  latency.reserve(runs);
+  std::atomic<int64_t> postTime{0};
+  std::thread worker([&]() {
+    for (int i = 0; i < runs; i++) {
+      ping.wait();
+      auto now = duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+      latency.push_back(static_cast<double>(now - postTime.load()));
+      pong.post();
+    }
+  });
+  for (int i = 0; i < runs; i++) {
+    std::this_thread::sleep_for(microseconds(100));
+    postTime = duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+    ping.post();
+    pong.wait();
+  }
+  worker.join();
+  std::sort(latency.begin(), latency.end());
+  double sum = 0;
+  for (auto l : latency) sum += l;
+  std::cout << name << ": mean " << sum / runs << " ns, median " << latency[runs / 2] 
+            << " ns, p99 " << latency[runs * 99 / 100] << " ns, max " << latency.back() << " ns" << std::endl;
+}
+
+int main(int argc, char **argv) {
+  int runs = 10000;
+  if (argc > 1) runs = std::max(1, atoi(argv[1]));
+  std::cout << "wakeup handoff latency over " << runs << " runs" << std::endl;
+  {
+    eeros::Semaphore ping, pong;
+    measure("Semaphore          ", ping, pong, runs);
+  }
+  {
+    eeros::FutexSemaphore ping(0, 0), pong(0, 0);
+    measure("FutexSemaphore     ", ping, pong, runs);
+  }
+  {
+    eeros::FutexSemaphore ping(0, 20000), pong(0, 20000);
+    measure("FutexSemaphore spin", ping, pong, runs);
+  }
+  return 0;
+}
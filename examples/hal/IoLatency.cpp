@@ -0,0 +1,241 @@
+#include <eeros/logger/Logger.hpp>
+#include <eeros/logger/StreamLogWriter.hpp>
+#include <eeros/hal/HAL.hpp>
+#include <eeros/core/Executor.hpp>
+#include <eeros/core/Histogram.hpp>
+#include <eeros/core/Statistics.hpp>
+#include <eeros/core/System.hpp>
+#include <eeros/task/Periodic.hpp>
+#include <eeros/control/Block.hpp>
+#include <eeros/control/Blockio.hpp>
+#include <eeros/control/Gain.hpp>
+#include <eeros/control/PeripheralInput.hpp>
+#include <eeros/control/PeripheralOutput.hpp>
+#include <eeros/control/TimeDomain.hpp>
+#include <eeros/safety/SafetyProperties.hpp>
+#include <eeros/safety/SafetySystem.hpp>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <unistd.h>
+
+/*
+ * Measures the latency from a HAL input to a HAL output. An analog output is
+ * wired back to an analog input, with the simulator ("reflect") or on real
+ * hardware. Each cycle a tag is written to the output and the input is decoded,
+ * the time between writing a tag and reading it back is the loopback latency.
+ * Each stage of a cycle is timestamped, which shows where the time is spent:
+ *
+ * - hal update: cycle start until the time domain runs, i.e. reading batched inputs
+ * - input:      PeripheralInput
+ * - control:    control blocks between input and output
+ * - output:     PeripheralOutput, writes non batched outputs immediately
+ * - safety:     SafetySystem, commits batched outputs
+ * - cycle:      cycle start until the end of the safety system
+ * - loopback:   tag handed to the output until it is read back from the input
+ *
+ * IoLatencyConfigSimBus.json runs on the bus simulation (libsimbuseeros), which
+ * adds the cost of bus transactions to the stages.
+ *
+ * Usage: ioLatency -c IoLatencyConfigSim.json [-s sec] [-p period in us]
+ *                  [-i input id] [-o output id] [-f file.csv]
+ */
+
+using namespace eeros;
+using namespace eeros::control;
+using namespace eeros::hal;
+using namespace eeros::safety;
+using namespace eeros::task;
+using namespace eeros::logger;
+
+constexpr int tags = 16;
+
+/*
+ * Distribution of the duration of one stage.
+ */
+struct Stage {
+  Stage(std::string name) : name(name) { }
+
+  void add(int64_t ns) {
+    double sec = ns / 1.0e9;
+    stats.add(sec);
+    histogram.add(sec);
+  }
+
+  std::string name;
+  Statistics stats;
+  Histogram histogram;
+};
+
+/*
+ * Stores the clock when it runs.
+ */
+class Marker : public Block {
+ public:
+  Marker(uint64_t& stamp) : stamp(stamp) { }
+  void run() override { stamp = System::getClockNs(); }
+
+ private:
+  uint64_t& stamp;
+};
+
+/*
+ * Outputs a tag changing each cycle, encoded as voltage -8 V ... 7 V.
+ */
+class TagGenerator : public Blockio<0,1> {
+ public:
+  void run() override {
+    tag = (tag + 1) % tags;
+    out.getSignal().setValue(tag - tags / 2);
+    out.getSignal().setTimestamp(System::getTimeNs());
+  }
+
+  int tag = 0;
+};
+
+/*
+ * Decodes the tag read from the input.
+ */
+class TagDecoder : public Blockio<1,0> {
+ public:
+  void run() override {
+    tag = static_cast<int>(std::lround(in.getSignal().getValue())) + tags / 2;
+  }
+
+  int tag = -1;
+};
+
+class SafetyPropertiesIo : public SafetyProperties {
+ public:
+  SafetyPropertiesIo() : slOn("on") {
+    addLevel(slOn);
+    setEntryLevel(slOn);
+  }
+
+  SafetyLevel slOn;
+};
+
+class Loopback : public Runnable {
+ public:
+  Loopback(double dt, std::string inId, std::string outId, uint64_t cycles)
+      : in(inId), out(outId), gain(1.0), td("loopback", dt, true),
+        ss(sp, dt), cycles(cycles), count(0), lastTag(-1),
+        hal("hal update"), input("input"), control("control"), output("output"),
+        safety("safety"), cycle("cycle"), loopback("loopback"),
+        tdStart(0), inputEnd(0), controlEnd(0), outputEnd(0),
+        markStart(tdStart), markInput(inputEnd), markControl(controlEnd), markOutput(outputEnd) {
+    writeStamp.fill(0);
+    decoder.getIn().connect(in.getOut());
+    gain.getIn().connect(generator.getOut());
+    out.getIn().connect(gain.getOut());
+    td.addBlock(markStart);
+    td.addBlock(in);
+    td.addBlock(markInput);
+    td.addBlock(decoder);
+    td.addBlock(generator);
+    td.addBlock(gain);
+    td.addBlock(markControl);
+    td.addBlock(out);
+    td.addBlock(markOutput);
+  }
+
+  void run() override {
+    uint64_t cycleStart = Executor::instance().getCycleTimestamp();
+    td.run();
+    ss.run();
+    uint64_t safetyEnd = System::getClockNs();
+    if (count > 0) {
+      hal.add(tdStart - cycleStart);
+      input.add(inputEnd - tdStart);
+      control.add(controlEnd - inputEnd);
+      output.add(outputEnd - controlEnd);
+      safety.add(safetyEnd - outputEnd);
+      cycle.add(safetyEnd - cycleStart);
+    }
+    // a tag is counted when it appears for the first time
+    int tag = decoder.tag;
+    if (tag >= 0 && tag < tags && tag != lastTag && writeStamp[tag] != 0) loopback.add(inputEnd - writeStamp[tag]);
+    lastTag = tag;
+    writeStamp[generator.tag] = outputEnd;
+    if (++count >= cycles) Executor::stop();
+  }
+
+  std::vector<Stage*> stages() { return {&hal, &input, &control, &output, &safety, &cycle, &loopback}; }
+
+  PeripheralInput<> in;
+  PeripheralOutput<> out;
+  TagDecoder decoder;
+  TagGenerator generator;
+  Gain<> gain;
+  TimeDomain td;
+  SafetyPropertiesIo sp;
+  SafetySystem ss;
+  uint64_t cycles;
+  uint64_t count;
+  int lastTag;
+  std::array<uint64_t, tags> writeStamp;
+  Stage hal, input, control, output, safety, cycle, loopback;
+
+ private:
+  uint64_t tdStart, inputEnd, controlEnd, outputEnd;
+  Marker markStart, markInput, markControl, markOutput;
+};
+
+int main(int argc, char **argv) {
+  Logger::setDefaultStreamLogger(std::cout);
+  Logger log = Logger::getLogger();
+
+  HAL& hal = HAL::instance();
+  hal.readConfigFromFile(&argc, argv);
+
+  double seconds = 10;
+  double dt = 0.001;
+  std::string inId = "latencyIn";
+  std::string outId = "latencyOut";
+  std::string file;
+  int c;
+  optind = 1;
+  while ((c = getopt(argc, argv, "c:s:p:i:o:f:")) != -1) {
+    switch (c) {
+      case 'c': break;  // read by the HAL
+      case 's': seconds = atof(optarg); break;
+      case 'p': dt = atof(optarg) / 1.0e6; break;
+      case 'i': inId = optarg; break;
+      case 'o': outId = optarg; break;
+      case 'f': file = optarg; break;
+      default:
+        log.error() << "usage: " << argv[0] << " -c config.json [-s sec] [-p period in us] [-i input id] [-o output id] [-f file.csv]";
+        return -1;
+    }
+  }
+
+  log.info() << "I/O latency from '" << outId << "' to '" << inId << "' with period " << dt << " sec for " << seconds << " sec";
+  Loopback loop(dt, inId, outId, static_cast<uint64_t>(seconds / dt));
+  auto& executor = Executor::instance();
+  Periodic per("ioLatency", dt, loop);
+  executor.setMainTask(per);
+  executor.run();
+
+  const double percentiles[] = {0.5, 0.99, 0.999};
+  for (auto s : loop.stages()) {
+    auto h = s->histogram.snapshot();
+    log.info() << std::setw(10) << s->name << ":  min " << s->stats.min << "  mean " << s->stats.mean
+               << "  p50 " << h.percentile(0.5) << "  p99 " << h.percentile(0.99) << "  p99.9 " << h.percentile(0.999)
+               << "  max " << s->stats.max << "  (" << s->stats.count << ")";
+  }
+  if (loop.loopback.stats.count == 0) log.warn() << "no tag was read back, check the wiring of '" << outId << "' to '" << inId << "'";
+
+  if (!file.empty()) {
+    std::ofstream os(file);
+    os << std::setprecision(9) << "stage,count,min,mean,max,p50,p99,p99.9\n";
+    for (auto s : loop.stages()) {
+      auto h = s->histogram.snapshot();
+      os << s->name << ',' << s->stats.count << ',' << s->stats.min << ',' << s->stats.mean << ',' << s->stats.max;
+      for (auto p : percentiles) os << ',' << h.percentile(p);
+      os << '\n';
+    }
+    log.info() << "results written to '" << file << "'";
+  }
+  return 0;
+}
@@ -0,0 +1,48 @@
+#include <eeros/logger/SharedLogRing.hpp>
+#include <eeros/logger/StreamLogWriter.hpp>
+#include <csignal>
+#include <iostream>
+#include <thread>
+
+using namespace eeros::logger;
+
+namespace {
+
+volatile std::sig_atomic_t running = 1;
+
+void signalHandler(int) { running = 0; }
+
+// writes the records like a StreamLogWriter, with the process id in front of the text
+class Printer : public StreamLogWriter {
+ public:
+  Printer(std::ostream& out, std::string logFile) : StreamLogWriter(out, logFile) { }
+
+  void print(const SharedLogRecord& r) {
+    std::ostringstream os;
+    std::chrono::system_clock::time_point time{std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(r.time))};
+    header(os, static_cast<LogLevel>(r.level), r.category, time);
+    os << '[' << r.pid << "] ";
+    os.write(r.text, r.length);
+    footer(os);
+    out << os.str();
+    fileOut << os.str();
+  }
+};
+
+}
+
+// collects the messages of all processes using a SharedLogWriter, e.g. after Logger::setDefaultSharedLogger()
+int main(int argc, char** argv) {
+  std::string logFile = argc > 1 ? argv[1] : "/tmp/eeros";
+  signal(SIGINT, signalHandler);
+  signal(SIGTERM, signalHandler);
+  SharedLogRing ring;
+  Printer printer(std::cout, logFile);
+  while (running) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ring.poll([&](const SharedLogRecord& r) { printer.print(r); });
+  }
+  ring.poll([&](const SharedLogRecord& r) { printer.print(r); }, std::chrono::nanoseconds(0));
+  if (ring.getDropped() > 0) std::cout << ring.getDropped() << " messages dropped" << std::endl;
+  return 0;
+}
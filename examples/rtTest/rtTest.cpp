@@ -1,21 +1,47 @@
 #include <iostream>
+#include <fstream>
+#include <sstream>
 #include <functional>
 #include <unistd.h>
 #include <chrono>
 #include <thread>
+#include <atomic>
 #include <ctime>
+#include <cmath>
+#include <cstring>
 #include <iomanip>
+#include <string>
+#include <vector>
+#include <memory>
+#include <type_traits>
+#include <sched.h>
+#include <sys/utsname.h>
+#include <sys/wait.h>
 
 #include <eeros/logger/Logger.hpp>
 #include <eeros/logger/LogWriter.hpp>
 #include <eeros/logger/StreamLogWriter.hpp>
 #include <eeros/core/Version.hpp>
 #include <eeros/core/Executor.hpp>
+#include <eeros/core/Histogram.hpp>
+#include <eeros/core/Statistics.hpp>
+#include <eeros/core/System.hpp>
 #include <eeros/task/Periodic.hpp>
-#include <eeros/control/TimeDomain.hpp>
 #include <eeros/safety/SafetyProperties.hpp>
 #include <eeros/safety/SafetySystem.hpp>
 
+/*
+ * Latency characterization of a controller PC. For each period of a sweep a
+ * safety system is run as main task of the executor for a number of seconds,
+ * optionally with cpu or memory stress in the background. The wake latency,
+ * the jitter of the period and the run time of each cycle are recorded in
+ * histograms and written as CSV or JSON together with the kernel and host,
+ * so that runs on different kernels and hardware can be compared.
+ *
+ * As the executor accepts a single main task, each period runs in a forked
+ * child process which sends its statistics back through a pipe.
+ */
+
 using namespace eeros;
 using namespace eeros::hal;
 using namespace eeros::safety;
@@ -33,22 +59,302 @@ class SafetyPropertiesTest : public SafetyProperties {
   SafetyLevel slOff;
 };
 
-int seconds = 10;
+enum class Stress { none, cpu, memory };
+
+struct Options {
+  int seconds = 10;
+  std::vector<int> periods = {100, 200, 500, 1000, 2000, 5000, 10000};  // in us
+  Executor::TimingMode mode = Executor::TimingMode::absoluteNanosleep;
+  std::string modeName = "nanosleep";
+  std::vector<int> cpus;
+  Stress stress = Stress::none;
+  std::string stressName = "none";
+  int stressThreads = 0;
+  int stressPriority = 0;
+  std::vector<int> stressCpus;
+  std::size_t stressMemory = 64 << 20;
+  std::string outFile;
+  bool json = false;
+};
+
+/*
+ * Statistics of one period, sent from the child to the parent. All values in sec.
+ */
+struct Result {
+  double period;
+  uint64_t cycles;
+  uint64_t overruns;
+  Statistics wake;
+  Statistics jitter;
+  Statistics run;
+  Histogram::Snapshot wakeHistogram;
+  Histogram::Snapshot jitterHistogram;
+  Histogram::Snapshot runHistogram;
+};
+static_assert(std::is_trivially_copyable_v<Result>, "results are sent through a pipe");
+
+/*
+ * Runs the safety system and records the wake latency of each cycle, i.e. the
+ * delay between the nominal start of the cycle and the start of the executor
+ * loop. The nominal start is derived from the first cycle, which itself counts
+ * as being on time.
+ */
+class Probe : public Runnable {
+ public:
+  Probe(SafetySystem& ss, double period, uint64_t cycles)
+      : ss(ss), periodNs(llround(period * 1.0e9)), cycles(cycles), count(0), first(0) { }
+
+  void run() override {
+    uint64_t start = Executor::instance().getCycleTimestamp();
+    if (count == 0) first = start;
+    double latency = (static_cast<int64_t>(start - first) - static_cast<int64_t>(count * periodNs)) / 1.0e9;
+    wake.add(latency);
+    wakeHistogram.add(latency);
+    ss.run();
+    if (++count >= cycles) Executor::stop();
+  }
+
+  SafetySystem& ss;
+  int64_t periodNs;
+  uint64_t cycles;
+  uint64_t count;
+  uint64_t first;
+  Statistics wake;
+  Histogram wakeHistogram;
+};
+
+/*
+ * Background load. Cpu stress spins on arithmetic, memory stress repeatedly
+ * writes a buffer larger than the caches with cache line stride.
+ */
+class StressThreads {
+ public:
+  StressThreads(const Options& opt) : running(true) {
+    if (opt.stress == Stress::none) return;
+    int n = opt.stressThreads > 0 ? opt.stressThreads : std::thread::hardware_concurrency();
+    for (int i = 0; i < n; i++) {
+      threads.emplace_back([this, &opt]() {
+        if (opt.stressPriority > 0) {
+          struct sched_param param;
+          param.sched_priority = opt.stressPriority;
+          sched_setscheduler(0, SCHED_FIFO, &param);
+        }
+        if (!opt.stressCpus.empty()) Executor::set_affinity(opt.stressCpus);
+        if (opt.stress == Stress::cpu) {
+          volatile double x = 1.0;
+          while (running.load(std::memory_order_relaxed)) {
+            for (int j = 0; j < 1000; j++) x = x * 1.000001 + 0.000001;
+          }
+        } else {
+          std::vector<char> buffer(opt.stressMemory);
+          char v = 0;
+          while (running.load(std::memory_order_relaxed)) {
+            for (std::size_t j = 0; j < buffer.size(); j += 64) buffer[j] = v;
+            v++;
+          }
+        }
+      });
+    }
+  }
+
+  ~StressThreads() {
+    running = false;
+    for (auto& t : threads) t.join();
+  }
+
+ private:
+  std::atomic<bool> running;
+  std::vector<std::thread> threads;
+};
+
+static std::vector<int> parseList(const char* arg) {
+  std::vector<int> list;
+  std::stringstream ss(arg);
+  std::string item;
+  while (std::getline(ss, item, ',')) list.push_back(std::stoi(item));
+  return list;
+}
+
+static bool writeAll(int fd, const void* data, std::size_t size) {
+  auto p = static_cast<const char*>(data);
+  while (size > 0) {
+    ssize_t n = write(fd, p, size);
+    if (n <= 0) return false;
+    p += n;
+    size -= n;
+  }
+  return true;
+}
+
+static bool readAll(int fd, void* data, std::size_t size) {
+  auto p = static_cast<char*>(data);
+  while (size > 0) {
+    ssize_t n = read(fd, p, size);
+    if (n <= 0) return false;
+    p += n;
+    size -= n;
+  }
+  return true;
+}
+
+/*
+ * Runs the executor with one period, called in the child process.
+ */
+static void measure(const Options& opt, double period, Result& result) {
+  SafetyPropertiesTest sp;
+  SafetySystem ss(sp, period);
+  Probe probe(ss, period, static_cast<uint64_t>(opt.seconds / period));
+
+  auto& executor = Executor::instance();
+  task::Periodic per("rtTest", period, probe);
+  executor.setMainTask(per);
+  executor.setTimingMode(opt.mode);
+  if (!opt.cpus.empty()) executor.setAffinity(opt.cpus);
+  {
+    StressThreads stress(opt);
+    executor.run();
+  }
+
+  result.period = period;
+  result.cycles = probe.count;
+  result.overruns = executor.counter.overruns;
+  result.wake = probe.wake;
+  result.jitter = executor.counter.jitter;
+  result.run = executor.counter.run;
+  result.wakeHistogram = probe.wakeHistogram.snapshot();
+  result.jitterHistogram = executor.counter.jitterHistogram.snapshot();
+  result.runHistogram = executor.counter.runHistogram.snapshot();
+}
+
+static const double percentiles[] = {0.5, 0.9, 0.99, 0.999, 0.9999};
+static const char* percentileNames[] = {"p50", "p90", "p99", "p99.9", "p99.99"};
+
+static void writeCsv(std::ostream& os, const std::string& host, const std::string& kernel, const Options& opt, const std::vector<Result>& results) {
+  os << "host,kernel,mode,stress,period,cycles,overruns";
+  for (auto name : {"wake", "jitter", "run"}) {
+    os << ',' << name << "_min," << name << "_mean," << name << "_max";
+    for (auto p : percentileNames) os << ',' << name << '_' << p;
+  }
+  os << '\n';
+  for (auto& r : results) {
+    os << host << ',' << kernel << ',' << opt.modeName << ',' << opt.stressName << ',' << r.period << ',' << r.cycles << ',' << r.overruns;
+    auto stats = [&os](const Statistics& s, const Histogram::Snapshot& h) {
+      os << ',' << s.min << ',' << s.mean << ',' << s.max;
+      for (auto p : percentiles) os << ',' << h.percentile(p);
+    };
+    stats(r.wake, r.wakeHistogram);
+    stats(r.jitter, r.jitterHistogram);
+    stats(r.run, r.runHistogram);
+    os << '\n';
+  }
+}
+
+static void writeJsonHistogram(std::ostream& os, const char* name, const Statistics& s, const Histogram::Snapshot& h) {
+  os << "      \"" << name << "\": {\"min\": " << s.min << ", \"mean\": " << s.mean << ", \"max\": " << s.max;
+  for (int i = 0; i < 5; i++) os << ", \"" << percentileNames[i] << "\": " << h.percentile(percentiles[i]);
+  // non empty buckets as [upper bound in sec, count], negative values first
+  os << ",\n        \"buckets\": [";
+  bool first = true;
+  for (int i = Histogram::bucketCount - 1; i >= 0; i--) {
+    if (h.negative[i] == 0) continue;
+    os << (first ? "" : ", ") << '[' << -(Histogram::bucketUpperBound(i) / 1.0e9) << ", " << h.negative[i] << ']';
+    first = false;
+  }
+  for (int i = 0; i < Histogram::bucketCount; i++) {
+    if (h.positive[i] == 0) continue;
+    os << (first ? "" : ", ") << '[' << Histogram::bucketUpperBound(i) / 1.0e9 << ", " << h.positive[i] << ']';
+    first = false;
+  }
+  os << "]}";
+}
+
+static void writeJson(std::ostream& os, const std::string& host, const std::string& kernel, const Options& opt, const std::vector<Result>& results) {
+  os << "{\n  \"host\": \"" << host << "\",\n  \"kernel\": \"" << kernel << "\",\n";
+  os << "  \"eeros\": \"" << Version::string << "\",\n  \"cpus\": " << std::thread::hardware_concurrency() << ",\n";
+  os << "  \"mode\": \"" << opt.modeName << "\",\n  \"stress\": \"" << opt.stressName << "\",\n";
+  os << "  \"stressThreads\": " << opt.stressThreads << ",\n  \"stressPriority\": " << opt.stressPriority << ",\n";
+  os << "  \"seconds\": " << opt.seconds << ",\n  \"results\": [";
+  for (std::size_t i = 0; i < results.size(); i++) {
+    auto& r = results[i];
+    os << (i == 0 ? "\n" : ",\n") << "    {\"period\": " << r.period << ", \"cycles\": " << r.cycles << ", \"overruns\": " << r.overruns << ",\n";
+    writeJsonHistogram(os, "wake", r.wake, r.wakeHistogram);
+    os << ",\n";
+    writeJsonHistogram(os, "jitter", r.jitter, r.jitterHistogram);
+    os << ",\n";
+    writeJsonHistogram(os, "run", r.run, r.runHistogram);
+    os << "\n    }";
+  }
+  os << "\n  ]\n}\n";
+}
+
+static void usage(const char* name) {
+  std::cerr << "usage: " << name << " [options]\n"
+            << "  -s sec       duration of each period (default 10)\n"
+            << "  -p list      periods in us, comma separated (default 100,200,500,1000,2000,5000,10000)\n"
+            << "  -m mode      timing mode: steady, nanosleep, timerfd, spin (default nanosleep)\n"
+            << "  -a list      cpus of the executor, comma separated\n"
+            << "  -l load      background stress: none, cpu, memory (default none)\n"
+            << "  -n threads   number of stress threads (default number of cpus)\n"
+            << "  -P prio      SCHED_FIFO priority of stress threads, 0 for SCHED_OTHER (default 0)\n"
+            << "  -A list      cpus of the stress threads, comma separated\n"
+            << "  -M MB        buffer size of each memory stress thread (default 64)\n"
+            << "  -o file      write results to file, JSON if it ends with .json, CSV otherwise\n";
+}
 
 int main(int argc, char *argv[]) {
+  Options opt;
   int c;
-  while((c = getopt(argc, argv, "s:")) != -1) {
+  while((c = getopt(argc, argv, "s:p:m:a:l:n:P:A:M:o:h")) != -1) {
     switch (c) {
     case 's':
-      seconds = atoi(optarg);
+      opt.seconds = atoi(optarg);
+      break;
+    case 'p':
+      opt.periods = parseList(optarg);
+      break;
+    case 'm':
+      opt.modeName = optarg;
+      if (opt.modeName == "steady") opt.mode = Executor::TimingMode::steadyClock;
+      else if (opt.modeName == "nanosleep") opt.mode = Executor::TimingMode::absoluteNanosleep;
+      else if (opt.modeName == "timerfd") opt.mode = Executor::TimingMode::timerfd;
+      else if (opt.modeName == "spin") opt.mode = Executor::TimingMode::hybridSpin;
+      else { usage(argv[0]); return -1; }
+      break;
+    case 'a':
+      opt.cpus = parseList(optarg);
+      break;
+    case 'l':
+      opt.stressName = optarg;
+      if (opt.stressName == "none") opt.stress = Stress::none;
+      else if (opt.stressName == "cpu") opt.stress = Stress::cpu;
+      else if (opt.stressName == "memory") opt.stress = Stress::memory;
+      else { usage(argv[0]); return -1; }
+      break;
+    case 'n':
+      opt.stressThreads = atoi(optarg);
+      break;
+    case 'P':
+      opt.stressPriority = atoi(optarg);
       break;
+    case 'A':
+      opt.stressCpus = parseList(optarg);
+      break;
+    case 'M':
+      opt.stressMemory = static_cast<std::size_t>(atoi(optarg)) << 20;
+      break;
+    case 'o':
+      opt.outFile = optarg;
+      opt.json = opt.outFile.size() >= 5 && opt.outFile.compare(opt.outFile.size() - 5, 5, ".json") == 0;
+      break;
+    case 'h':
+      usage(argv[0]);
+      return 0;
     case '?':
-      if (optopt == 's')
-        std::cerr << "Option " << char(optopt) << " requires an argument.\n" << std::endl;
-      else if (isprint (optopt))
-        std::cerr << "Unknown option " << char(optopt) << std::endl;
+      if (isprint (optopt))
+        std::cerr << "Unknown option or missing argument " << char(optopt) << std::endl;
       else
         std::cerr << "Unknown option character " << char(optopt) << std::endl;
+      usage(argv[0]);
       return -1;
       break;
      default:
@@ -56,27 +362,68 @@ int main(int argc, char *argv[]) {
     }
   }
 
-  const double dt = 0.001;
   Logger::setDefaultStreamLogger(std::cout);
   Logger log = Logger::getLogger('M');
 
-  log.trace() << "measure periodic execution";
-  log.trace() << "eeros " << eeros::Version::string;
+  struct utsname un;
+  uname(&un);
+  std::string host = un.nodename;
+  std::string kernel = std::string(un.release) + " " + un.machine;
 
-  // Create and initialize safety system
-  SafetyPropertiesTest sp;
-  SafetySystem ss(sp, dt);
+  log.trace() << "measure periodic execution";
+  log.trace() << "eeros " << eeros::Version::string << ", kernel " << kernel << ", host " << host;
 
-  auto& executor = eeros::Executor::instance();
-  eeros::task::Periodic per("per", dt, ss);
-  executor.setMainTask(per);
-  per.monitors.push_back([&](eeros::PeriodicCounter &c, Logger &log){
-    static int ticks = 0;
-    if (++ticks % 1000 == 0) log.info() << "ss: period max: " << c.period.max << "   period min: " << c.period.min << "   period mean: " << c.period.mean;
-    if (ticks > seconds / dt) executor.stop();
-  });
+  std::vector<Result> results;
+  for (auto us : opt.periods) {
+    double period = us / 1.0e6;
+    log.info() << "period " << us << " us, timing " << opt.modeName << ", stress " << opt.stressName << " for " << opt.seconds << " sec";
+    int fd[2];
+    if (pipe(fd) != 0) {
+      log.error() << "could not create pipe";
+      return -1;
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+      log.error() << "could not fork";
+      return -1;
+    }
+    if (pid == 0) {
+      close(fd[0]);
+      auto result = std::make_unique<Result>();
+      measure(opt, period, *result);
+      bool ok = writeAll(fd[1], result.get(), sizeof(Result));
+      close(fd[1]);
+      _exit(ok ? 0 : 1);
+    }
+    close(fd[1]);
+    auto result = std::make_unique<Result>();
+    bool ok = readAll(fd[0], result.get(), sizeof(Result));
+    close(fd[0]);
+    int status;
+    waitpid(pid, &status, 0);
+    if (!ok || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+      log.error() << "measurement of period " << us << " us failed";
+      continue;
+    }
+    auto& r = *result;
+    log.info() << "  wake   max " << r.wake.max << "  p99.9 " << r.wakeHistogram.percentile(0.999) << "  mean " << r.wake.mean;
+    log.info() << "  jitter max " << r.jitter.max << "  p99.9 " << r.jitterHistogram.percentile(0.999) << "  min " << r.jitter.min;
+    log.info() << "  run    max " << r.run.max << "  p99.9 " << r.runHistogram.percentile(0.999) << "  mean " << r.run.mean;
+    log.info() << "  cycles " << r.cycles << "  overruns " << r.overruns;
+    results.push_back(r);
+  }
 
-  executor.run();
+  if (!opt.outFile.empty()) {
+    std::ofstream os(opt.outFile);
+    if (!os) {
+      log.error() << "could not open '" << opt.outFile << "'";
+      return -1;
+    }
+    os << std::setprecision(9);
+    if (opt.json) writeJson(os, host, kernel, opt, results);
+    else writeCsv(os, host, kernel, opt, results);
+    log.info() << "results written to '" << opt.outFile << "'";
+  }
 
   return 0;
 }
@@ -27,11 +27,8 @@ class Subsystem : public Subio<1,1,Vector2,Vector2> {
     sum.getIn(0).connect(in);
     sum.getIn(1).connect(gain.getOut());
     setOut(sum.getOut());
-  }
-
-  virtual void run()  {
-    gain.run();
-    sum.run();
+    addBlock(gain);
+    addBlock(sum);
   }
  
   Gain<Vector2> gain;
@@ -0,0 +1,90 @@
+#include <eeros/control/Constant.hpp>
+#include <eeros/control/ros2/RosPublisherAnalogSignal.hpp>
+#include <eeros/control/ros2/RosSubscriberAnalogSignal.hpp>
+#include <eeros/control/ros2/RosTools.hpp>
+#include <eeros/logger/Logger.hpp>
+#include <eeros/logger/StreamLogWriter.hpp>
+#include <eeros/math/Matrix.hpp>
+#include "TransportBenchmark.hpp"
+
+/*
+ * Round trip time, drop rate and cpu usage of the ROS2 publisher and subscriber
+ * blocks. Per stream, the control loop publishes on /eerosBenchmark/out<i> and
+ * subscribes to /eerosBenchmark/in<i>. An echo node in the same process, spun
+ * by its own executor, republishes each message it receives. The drops counted
+ * by the transport are the messages the publisher block could not queue.
+ *
+ * Usage: rosBenchmark [-s sec] [-p payloads] [-r rates] [-n streams] [-o file]
+ */
+
+using namespace eeros::control;
+using namespace eeros::logger;
+using namespace eeros::math;
+
+template < int N >
+class RosStream : public Stream {
+  using Payload = Matrix<N, 1, double>;
+  using Msg = eeros_msgs::msg::AnalogSignal;
+
+ public:
+  RosStream(rclcpp::Node::SharedPtr node, rclcpp::Node::SharedPtr echoNode, int index)
+      : publisher(node, "/eerosBenchmark/out" + std::to_string(index)),
+        subscriber(node, "/eerosBenchmark/in" + std::to_string(index)) {
+    payload.zero();
+    source.setValue(payload);
+    publisher.getIn().connect(source.getOut());
+    echoPublisher = echoNode->create_publisher<Msg>("/eerosBenchmark/in" + std::to_string(index), 10);
+    echoSubscriber = echoNode->create_subscription<Msg>("/eerosBenchmark/out" + std::to_string(index), rclcpp::SensorDataQoS(),
+                                                        [this](const Msg& msg) { echoPublisher->publish(msg); });
+  }
+
+  double exchange(double stamp, bool send) override {
+    subscriber.run();
+    if (send) {
+      payload(0) = stamp;
+      source.setValue(payload);
+      source.run();
+      publisher.run();
+    }
+    return subscriber.getOut().getSignal().getValue()(0);
+  }
+
+  uint64_t getLost() override {
+    return publisher.getDropped();
+  }
+
+ private:
+  Constant<Payload> source;
+  RosPublisherAnalogSignal<Payload> publisher;
+  RosSubscriberAnalogSignal<Payload> subscriber;
+  Payload payload;
+  rclcpp::Publisher<Msg>::SharedPtr echoPublisher;
+  rclcpp::Subscription<Msg>::SharedPtr echoSubscriber;
+};
+
+int main(int argc, char **argv) {
+  Logger::setDefaultStreamLogger(std::cout);
+  Options opt;
+  if (!parseOptions(argc, argv, opt)) return -1;
+
+  // rclcpp is initialized in each child, it does not survive a fork
+  return runSweep("ros2", opt, [&](int payload, int rate, int n, Result& result) {
+    RosTools::initRos(argc, argv);
+    auto node = RosTools::initNode("eerosBenchmark");
+    auto echoNode = RosTools::initNode("eerosBenchmarkEcho");
+    if (node == nullptr || echoNode == nullptr) return false;
+    std::vector<std::unique_ptr<Stream>> streams;
+    bool valid = withPayload(payload, [&](auto size) {
+      for (int i = 0; i < n; i++)
+        streams.push_back(std::make_unique<RosStream<decltype(size)::value>>(node, echoNode, i));
+    });
+    if (!valid) return false;
+    rclcpp::executors::SingleThreadedExecutor echoExecutor;
+    echoExecutor.add_node(echoNode);
+    std::thread echo([&]() { echoExecutor.spin(); });
+    runLoop(streams, false, opt, rate, result);
+    echoExecutor.cancel();
+    echo.join();
+    return true;
+  });
+}
@@ -0,0 +1,87 @@
+#include <eeros/control/Constant.hpp>
+#include <eeros/control/SocketData.hpp>
+#include <eeros/logger/Logger.hpp>
+#include <eeros/logger/StreamLogWriter.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <eeros/sockets/SocketServer.hpp>
+#include "TransportBenchmark.hpp"
+
+/*
+ * Round trip time, drop rate and cpu usage of SocketData. The control loop
+ * runs a SocketData client per stream, each one connected to a SocketServer
+ * on the same host which sends back what it receives. Both sides send on
+ * update, so the payload is echoed as soon as it arrives.
+ *
+ * Usage: socketBenchmark [-s sec] [-p payloads] [-r rates] [-n streams] [-t tcp|udp] [-o file]
+ */
+
+using namespace eeros::control;
+using namespace eeros::logger;
+using namespace eeros::math;
+using namespace eeros::sockets;
+
+constexpr uint16_t basePort = 9900;
+
+template < int N >
+class SocketStream : public Stream {
+  using Payload = Matrix<N, 1, double>;
+
+ public:
+  SocketStream(uint16_t port, double period, Protocol protocol, SocketOptions options)
+      : server(port, period, 1.0, 20, 1, protocol, options),
+        data("127.0.0.1", port, period, 1.0, protocol, options) {
+    payload.zero();
+    source.setValue(payload);
+    data.getIn().connect(source.getOut());
+  }
+
+  double exchange(double stamp, bool send) override {
+    if (send) {
+      payload(0) = stamp;
+      source.setValue(payload);
+    }
+    source.run();
+    data.run();
+    return data.getOut().getSignal().getValue()(0);
+  }
+
+  void echo() override {
+    uint64_t seq = server.getSequence();
+    if (seq == echoed) return;
+    echoed = seq;
+    buffer = server.getReceiveBuffer();
+    server.setSendBuffer(buffer);
+  }
+
+  uint64_t getLost() override {
+    return data.getStatistics().lost;
+  }
+
+ private:
+  SocketServer<N, double, N, double> server;
+  Constant<Payload> source;
+  SocketData<Payload, Payload> data;
+  Payload payload;
+  std::array<double, N> buffer;
+  uint64_t echoed = 0;
+};
+
+int main(int argc, char **argv) {
+  Logger::setDefaultStreamLogger(std::cout);
+  Options opt;
+  if (!parseOptions(argc, argv, opt)) return -1;
+  Protocol protocol = opt.protocol == "udp" ? Protocol::udp : Protocol::tcp;
+
+  return runSweep("socket " + opt.protocol, opt, [&](int payload, int rate, int n, Result& result) {
+    SocketOptions options;
+    options.sendOnUpdate = true;
+    std::vector<std::unique_ptr<Stream>> streams;
+    bool valid = withPayload(payload, [&](auto size) {
+      for (int i = 0; i < n; i++)
+        streams.push_back(std::make_unique<SocketStream<decltype(size)::value>>(basePort + i, 1.0 / rate, protocol, options));
+    });
+    if (!valid) return false;
+    runLoop(streams, true, opt, rate, result);
+    return true;
+  });
+}
@@ -0,0 +1,332 @@
+#pragma once
+
+#include <eeros/core/Executor.hpp>
+#include <eeros/core/Histogram.hpp>
+#include <eeros/core/Runnable.hpp>
+#include <eeros/core/Statistics.hpp>
+#include <eeros/core/System.hpp>
+#include <eeros/logger/Logger.hpp>
+#include <eeros/task/Periodic.hpp>
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <ctime>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/*
+ * Common part of the transport benchmarks. A control loop runs as main task
+ * of the executor and exchanges a payload of doubles with an echo on each
+ * stream once per cycle. Element 0 of the payload carries the time it was
+ * sent, the loop takes the round trip time when it sees the echo of it. As
+ * the loop reads once per cycle, the round trip time is the one the control
+ * loop sees, rounded up to whole cycles on slow links.
+ *
+ * A sweep over payload sizes, rates and numbers of streams runs each
+ * configuration in a forked child process, as the executor accepts one main
+ * task per process.
+ */
+
+using namespace eeros;
+
+/*
+ * Payload sizes which can be selected, each one is a separate instantiation.
+ */
+template < typename F >
+bool withPayload(int payload, F f) {
+  switch (payload) {
+    case 1: f(std::integral_constant<int, 1>()); return true;
+    case 4: f(std::integral_constant<int, 4>()); return true;
+    case 16: f(std::integral_constant<int, 16>()); return true;
+    case 64: f(std::integral_constant<int, 64>()); return true;
+    case 256: f(std::integral_constant<int, 256>()); return true;
+    case 1024: f(std::integral_constant<int, 1024>()); return true;
+    case 4096: f(std::integral_constant<int, 4096>()); return true;
+    default: return false;
+  }
+}
+
+struct Options {
+  double seconds = 5;
+  std::vector<int> payloads = {1, 16, 256, 4096};
+  std::vector<int> rates = {100, 1000};
+  std::vector<int> streams = {1, 4};
+  std::string protocol = "tcp";
+  std::string outFile;
+};
+
+/*
+ * Result of one configuration, sent from the child to the parent. Times in sec.
+ */
+struct Result {
+  int payload;
+  int rate;
+  int streams;
+  uint64_t sent;        // payloads sent while measuring
+  uint64_t received;    // echoes seen by the loop
+  uint64_t lost;        // losses counted by the transport itself
+  double cpu;           // cpu time of the loop thread per wall time
+  Statistics rtt;
+  Statistics io;        // time spent in the transport blocks per cycle
+  Histogram::Snapshot rttHistogram;
+  Histogram::Snapshot ioHistogram;
+};
+static_assert(std::is_trivially_copyable_v<Result>, "results are sent through a pipe");
+
+/*
+ * One stream, i.e. the blocks sending and receiving a payload and its echo.
+ */
+class Stream {
+ public:
+  virtual ~Stream() = default;
+
+  /*
+   * Runs the blocks of the stream once.
+   *
+   * @param stamp - time to send in element 0
+   * @param send - false to only receive
+   * @return element 0 of the latest payload received
+   */
+  virtual double exchange(double stamp, bool send) = 0;
+
+  /*
+   * Echoes received payloads, called by the echo thread if the transport needs one.
+   */
+  virtual void echo() { }
+
+  /*
+   * @return losses counted by the transport
+   */
+  virtual uint64_t getLost() { return 0; }
+};
+
+inline uint64_t threadCpuNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/*
+ * The control loop. It waits until all streams have seen an echo, or for at
+ * most warmup cycles, then measures for a number of cycles. The last cycles
+ * only receive, so that the echoes still on their way are not counted as lost.
+ */
+class Loop : public Runnable {
+ public:
+  Loop(std::vector<std::unique_ptr<Stream>>& streams, uint64_t cycles, uint64_t tail, uint64_t warmup)
+      : streams(streams), cycles(cycles), tail(tail), warmup(warmup), last(streams.size(), 0), seen(streams.size(), false) { }
+
+  void run() override {
+    uint64_t start = System::getClockNs();
+    bool send = !measuring || count < cycles;
+    for (std::size_t i = 0; i < streams.size(); i++) {
+      double echoed = streams[i]->exchange(static_cast<double>(start), send);
+      if (!(echoed > 0) || echoed == last[i]) continue;   // nothing received yet
+      last[i] = echoed;
+      seen[i] = true;
+      uint64_t stamp = static_cast<uint64_t>(echoed);
+      if (measuring && stamp >= measureStart) {
+        double sec = (start - stamp) / 1.0e9;
+        rtt.add(sec);
+        rttHistogram.add(sec);
+        received++;
+      }
+    }
+    uint64_t end = System::getClockNs();
+    if (!measuring) {
+      bool all = true;
+      for (auto s : seen) all = all && s;
+      if (all || ++warmupCount >= warmup) {
+        measuring = true;
+        measureStart = end;
+        cpuStart = threadCpuNs();
+      }
+      return;
+    }
+    if (send) sent += streams.size();
+    io.add((end - start) / 1.0e9);
+    ioHistogram.add((end - start) / 1.0e9);
+    if (++count >= cycles + tail) {
+      cpu = (threadCpuNs() - cpuStart) / static_cast<double>(end - measureStart);
+      Executor::stop();
+    }
+  }
+
+  std::vector<std::unique_ptr<Stream>>& streams;
+  uint64_t cycles, tail, warmup;
+  uint64_t count = 0, warmupCount = 0, sent = 0, received = 0;
+  uint64_t measureStart = 0, cpuStart = 0;
+  bool measuring = false;
+  double cpu = 0;
+  std::vector<double> last;
+  std::vector<bool> seen;
+  Statistics rtt, io;
+  Histogram rttHistogram, ioHistogram;
+};
+
+/*
+ * Runs the loop with the given streams in the executor and fills the result.
+ * Streams which need an echo thread get one, it busy polls to add no wake up latency.
+ */
+inline void runLoop(std::vector<std::unique_ptr<Stream>>& streams, bool echoThread, const Options& opt, int rate, Result& result) {
+  double dt = 1.0 / rate;
+  Loop loop(streams, static_cast<uint64_t>(opt.seconds * rate), std::max(rate / 10, 10), 5 * rate);
+  std::atomic<bool> echoing{echoThread};
+  std::thread echo([&]() {
+    while (echoing.load(std::memory_order_relaxed)) {
+      for (auto& s : streams) s->echo();
+    }
+  });
+  auto& executor = Executor::instance();
+  executor.setTimingMode(Executor::TimingMode::absoluteNanosleep);
+  task::Periodic per("loop", dt, loop);
+  executor.setMainTask(per);
+  executor.run();
+  echoing = false;
+  echo.join();
+
+  result.rate = rate;
+  result.streams = streams.size();
+  result.sent = loop.sent;
+  result.received = loop.received;
+  result.lost = 0;
+  for (auto& s : streams) result.lost += s->getLost();
+  result.cpu = loop.cpu;
+  result.rtt = loop.rtt;
+  result.io = loop.io;
+  result.rttHistogram = loop.rttHistogram.snapshot();
+  result.ioHistogram = loop.ioHistogram.snapshot();
+}
+
+inline std::vector<int> parseList(const char* arg) {
+  std::vector<int> list;
+  std::stringstream ss(arg);
+  std::string item;
+  while (std::getline(ss, item, ',')) list.push_back(std::stoi(item));
+  return list;
+}
+
+inline bool parseOptions(int argc, char** argv, Options& opt) {
+  int c;
+  while ((c = getopt(argc, argv, "s:p:r:n:t:o:")) != -1) {
+    switch (c) {
+      case 's': opt.seconds = atof(optarg); break;
+      case 'p': opt.payloads = parseList(optarg); break;
+      case 'r': opt.rates = parseList(optarg); break;
+      case 'n': opt.streams = parseList(optarg); break;
+      case 't': opt.protocol = optarg; break;
+      case 'o': opt.outFile = optarg; break;
+      default:
+        std::cerr << "usage: " << argv[0] << " [options]\n"
+                  << "  -s sec     duration of each configuration (default 5)\n"
+                  << "  -p list    payload sizes in doubles: 1, 4, 16, 64, 256, 1024, 4096 (default 1,16,256,4096)\n"
+                  << "  -r list    rates in Hz (default 100,1000)\n"
+                  << "  -n list    numbers of streams (default 1,4)\n"
+                  << "  -t proto   protocol of the socket benchmark: tcp, udp (default tcp)\n"
+                  << "  -o file    write results to file, JSON if it ends with .json, CSV otherwise\n";
+        return false;
+    }
+  }
+  return true;
+}
+
+inline void writeResults(std::ostream& os, const std::string& transport, const std::vector<Result>& results, bool json) {
+  os << std::setprecision(9);
+  auto dropRate = [](const Result& r) { return r.sent > 0 ? 1.0 - static_cast<double>(r.received) / r.sent : 0.0; };
+  if (!json) {
+    os << "transport,payload,rate,streams,sent,received,drop_rate,lost,cpu,"
+       << "rtt_min,rtt_mean,rtt_p50,rtt_p99,rtt_p99.9,rtt_max,io_mean,io_p99,io_max\n";
+    for (auto& r : results) {
+      os << transport << ',' << r.payload << ',' << r.rate << ',' << r.streams << ',' << r.sent << ',' << r.received << ','
+         << dropRate(r) << ',' << r.lost << ',' << r.cpu << ',' << r.rtt.min << ',' << r.rtt.mean << ','
+         << r.rttHistogram.percentile(0.5) << ',' << r.rttHistogram.percentile(0.99) << ',' << r.rttHistogram.percentile(0.999) << ','
+         << r.rtt.max << ',' << r.io.mean << ',' << r.ioHistogram.percentile(0.99) << ',' << r.io.max << '\n';
+    }
+    return;
+  }
+  os << "{\n  \"transport\": \"" << transport << "\",\n  \"results\": [";
+  for (std::size_t i = 0; i < results.size(); i++) {
+    auto& r = results[i];
+    os << (i == 0 ? "\n" : ",\n") << "    {\"payload\": " << r.payload << ", \"rate\": " << r.rate << ", \"streams\": " << r.streams
+       << ", \"sent\": " << r.sent << ", \"received\": " << r.received << ", \"dropRate\": " << dropRate(r) << ", \"lost\": " << r.lost
+       << ", \"cpu\": " << r.cpu << ",\n     \"rtt\": {\"min\": " << r.rtt.min << ", \"mean\": " << r.rtt.mean
+       << ", \"p50\": " << r.rttHistogram.percentile(0.5) << ", \"p99\": " << r.rttHistogram.percentile(0.99)
+       << ", \"p99.9\": " << r.rttHistogram.percentile(0.999) << ", \"max\": " << r.rtt.max << "},\n     \"io\": {\"mean\": " << r.io.mean
+       << ", \"p99\": " << r.ioHistogram.percentile(0.99) << ", \"max\": " << r.io.max << "}}";
+  }
+  os << "\n  ]\n}\n";
+}
+
+/*
+ * Runs all configurations of the sweep, each in a child process, and writes the results.
+ *
+ * @param measure - sets up the streams of one configuration and calls runLoop(), returns false if it failed
+ */
+inline int runSweep(const std::string& transport, const Options& opt,
+                    std::function<bool(int payload, int rate, int streams, Result& result)> measure) {
+  logger::Logger log = logger::Logger::getLogger('B');
+  std::vector<Result> results;
+  for (auto payload : opt.payloads) {
+    for (auto rate : opt.rates) {
+      for (auto n : opt.streams) {
+        log.info() << transport << ": " << payload << " doubles at " << rate << " Hz on " << n << " streams";
+        int fd[2];
+        if (pipe(fd) != 0) return -1;
+        pid_t pid = fork();
+        if (pid < 0) return -1;
+        if (pid == 0) {
+          close(fd[0]);
+          auto result = std::make_unique<Result>();
+          result->payload = payload;
+          bool ok = measure(payload, rate, n, *result);
+          auto p = reinterpret_cast<const char*>(result.get());
+          std::size_t size = sizeof(Result);
+          while (ok && size > 0) {
+            ssize_t w = write(fd[1], p, size);
+            if (w <= 0) ok = false;
+            else { p += w; size -= w; }
+          }
+          close(fd[1]);
+          _exit(ok ? 0 : 1);
+        }
+        close(fd[1]);
+        auto result = std::make_unique<Result>();
+        auto p = reinterpret_cast<char*>(result.get());
+        std::size_t size = sizeof(Result);
+        while (size > 0) {
+          ssize_t r = read(fd[0], p, size);
+          if (r <= 0) break;
+          p += r;
+          size -= r;
+        }
+        close(fd[0]);
+        int status;
+        waitpid(pid, &status, 0);
+        if (size > 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+          log.error() << "  failed";
+          continue;
+        }
+        auto& r = *result;
+        log.info() << "  rtt p50 " << r.rttHistogram.percentile(0.5) << "  p99 " << r.rttHistogram.percentile(0.99) << "  max " << r.rtt.max
+                   << "  received " << r.received << "/" << r.sent << "  lost " << r.lost << "  cpu " << r.cpu * 100 << " %";
+        results.push_back(r);
+      }
+    }
+  }
+  if (!opt.outFile.empty()) {
+    std::ofstream os(opt.outFile);
+    bool json = opt.outFile.size() >= 5 && opt.outFile.compare(opt.outFile.size() - 5, 5, ".json") == 0;
+    writeResults(os, transport, results, json);
+    log.info() << "results written to '" << opt.outFile << "'";
+  }
+  return 0;
+}
@@ -1,30 +1,43 @@
 #ifndef ORG_EEROS_CORE_CONFIG_HPP_
 #define ORG_EEROS_CORE_CONFIG_HPP_
 
+#include <eeros/config/MappedTable.hpp>
+#include <array>
 #include <cmath>
 #include <functional>
-#include <map>
+#include <memory>
+#include <span>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace eeros {
 namespace config {
 
+/**
+ * Accessor of a property, set() appends the value of the property to a string
+ * and get() assigns the property from its text.
+ */
 struct ConfigPropertyAccessor {
-  std::function<void(std::string, std::string &)> set;
-  std::function<void(std::string, std::string)> get;
+  std::function<void(std::string &)> set;
+  std::function<void(std::string_view)> get;
 };
 
-struct StringCompare {
-  bool operator()(const std::string_view first, const std::string_view second) const {
-    return first.compare(second) < 0;
-  }
+/**
+ * Hash of property names, allows to look up a property by a string_view.
+ */
+struct StringHash {
+  using is_transparent = void;
+  std::size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
 };
 
 /** \brief Configuration.
  *
  * This is the base class for a configuration to be saved to or loaded from disk.
  * A configuration might be useful to keep calibration values or setup data.
+ * Numbers are converted with std::to_chars and std::from_chars, doubles are
+ * written with as many digits as needed to read back the same value.
  */
 class Config {
  public:
@@ -67,11 +80,39 @@ protected:
                    double *start, double *end, double defaultValue = NAN);
   virtual void add(std::string name, std::string &value);
 
+  /**
+   * Adds an array of variable length, e.g. a calibration table. Loading
+   * resizes the vector to the number of values read.
+   */
+  virtual void add(std::string name, std::vector<int> &value);
+  virtual void add(std::string name, std::vector<double> &value);
+
+  /**
+   * Binds a table of a table file, see MappedTable. The value of the property
+   * is the path of the file, the table has the name of the property. Each file
+   * is mapped once and stays mapped as long as the configuration exists.
+   */
+  virtual void add(std::string name, std::span<const int32_t> &value);
+  virtual void add(std::string name, std::span<const double> &value);
+
   template <typename T, std::size_t N>
   void add(std::string name, std::array<T, N> &value);
 
+  /**
+   * Adds a property with its accessor, throws if the name is already used.
+   */
+  void addProperty(std::string name, ConfigPropertyAccessor accessor);
+
+  /**
+   * @param path - path of a table file
+   * @return the table file, mapped on first use
+   */
+  const MappedTable& getTable(std::string_view path);
+
   std::string path;
-  std::map<std::string, ConfigPropertyAccessor, StringCompare> properties;
+  std::unordered_map<std::string, ConfigPropertyAccessor, StringHash, std::equal_to<>> properties;
+  std::vector<std::string> names;  // properties in the order they were added
+  std::unordered_map<std::string, std::unique_ptr<MappedTable>, StringHash, std::equal_to<>> tables;
 };
 
 template <typename T, std::size_t N>
@@ -4,6 +4,7 @@
 #include <eeros/core/Fault.hpp>
 #include <eeros/config/Config.hpp>
 #include <fstream>
+#include <string_view>
 
 namespace eeros {
 namespace config {
@@ -12,6 +13,8 @@ namespace config {
  *
  * This allows for saving a configuration to a file on disk or loading it from there.
  * A configuration might be useful to keep calibration values or setup data.
+ * Each line of the file holds a property as 'name = value', arrays are comma
+ * separated. The file is read and written in one piece.
  */
 class FileConfig : public Config {
  public:
@@ -35,17 +38,17 @@ class FileConfig : public Config {
   virtual bool save(std::string path = "") {
     if (path.empty()) path = this->path;
     if (path.empty()) throw Fault("path is null");
-    std::ofstream file(path);
+    std::ofstream file(path, std::ios::binary);
     if (file.fail()) return false;
-    for (auto p: properties ) {
-      std::ostringstream os;
-      os << p.first << " = ";
-      std::string val;
-      p.second.set(p.first, val);
-      os << val << std::endl;
-      file << os.str();
+    std::string text;
+    for (auto& name : names) {
+      text += name;
+      text += " = ";
+      properties.find(name)->second.set(text);
+      text += '\n';
     }
-    return true;
+    file.write(text.data(), text.size());
+    return !file.fail();
   }
  
   /**
@@ -56,20 +59,39 @@ class FileConfig : public Config {
   virtual bool load(std::string path = "") {
     if (path.empty()) path = this->path;
     if (path.empty()) throw Fault("path is null");
-    std::ifstream file(path);
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
     if (file.fail()) return false;
-    std::string line;
-    while (getline(file, line)) {
-      std::stringstream iss(line);
-      std::string key, val;
-      iss >> key >> val;  
-      getline(iss, val);
-  
+    std::string text(static_cast<std::size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    file.read(text.data(), text.size());
+    if (file.fail()) return false;
+
+    constexpr const char* space = " \t";
+    std::string_view rest(text);
+    while (!rest.empty()) {
+      auto eol = rest.find('\n');
+      std::string_view line = rest.substr(0, eol);
+      rest = (eol == std::string_view::npos) ? std::string_view() : rest.substr(eol + 1);
+
+      // 'key = value', the value starts after the separator token
+      auto b = line.find_first_not_of(space);
+      if (b == std::string_view::npos) continue;
+      auto e = line.find_first_of(space, b);
+      std::string_view key = line.substr(b, e - b);
+      std::string_view val;
+      if (e != std::string_view::npos) {
+        auto s = line.find_first_not_of(space, e);
+        if (s != std::string_view::npos) {
+          auto v = line.find_first_of(space, s);
+          if (v != std::string_view::npos) val = line.substr(v);
+        }
+      }
+
       auto p = properties.find(key);
       if (p == properties.end()) {
         continue; // unknown property
       }
-      p->second.get(p->first, val);
+      p->second.get(val);
     }
     return true;
   }
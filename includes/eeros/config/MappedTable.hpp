@@ -0,0 +1,170 @@
+#ifndef ORG_EEROS_CONFIG_MAPPEDTABLE_HPP_
+#define ORG_EEROS_CONFIG_MAPPEDTABLE_HPP_
+
+#include <eeros/core/Fault.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace eeros {
+namespace config {
+
+/**
+ * A file of named binary tables, e.g. calibration maps, which is mapped read
+ * only into memory. Opening the file costs nothing but the page faults when the
+ * tables are read, and all processes mapping the same file share one copy in
+ * the page cache. A table is an array of int32_t, float or double values with a
+ * shape of up to 4 dimensions, stored in row major order.
+ *
+ * The file starts with a header (magic, byte order, format version, number of
+ * tables), followed by one entry per table (name, type, shape, offset, number
+ * of values) and the values of the tables, each aligned to 64 bytes. Files are
+ * created with MappedTable::Writer.
+ *
+ * @since v1.4.4
+ */
+class MappedTable {
+ public:
+  static constexpr uint32_t version = 1;
+  static constexpr int maxRank = 4;
+  static constexpr std::size_t maxNameLength = 63;
+
+  enum class Type : uint32_t { int32 = 1, float32 = 2, float64 = 3 };
+
+  /**
+   * Maps a table file, throws a Fault if the file can not be read or is not
+   * a table file of this version.
+   *
+   * @param path - path of the file
+   */
+  explicit MappedTable(std::string path);
+  ~MappedTable();
+
+  MappedTable(const MappedTable&) = delete;
+  MappedTable& operator=(const MappedTable&) = delete;
+
+  /**
+   * @return true if the file contains a table with this name
+   */
+  bool has(std::string_view name) const;
+
+  /**
+   * Returns the values of a table, throws a Fault if there is no table with
+   * this name and value type. The values stay valid as long as this object.
+   *
+   * @param name - name of the table
+   * @return values of the table
+   */
+  template <typename T>
+  std::span<const T> get(std::string_view name) const {
+    const Entry& e = find(name, typeOf<T>());
+    return {reinterpret_cast<const T*>(data + e.offset), static_cast<std::size_t>(e.count)};
+  }
+
+  /**
+   * @param name - name of the table
+   * @return size of each dimension of the table
+   */
+  std::vector<uint32_t> getShape(std::string_view name) const;
+
+  /**
+   * @return names of all tables
+   */
+  std::vector<std::string> getNames() const;
+
+  const std::string& getPath() const;
+
+  /**
+   * Collects tables and writes them to a table file.
+   */
+  class Writer {
+   public:
+    /**
+     * Adds a table, throws a Fault if the name is too long or already used,
+     * or if the shape does not match the number of values.
+     *
+     * @param name - name of the table
+     * @param values - values in row major order
+     * @param shape - size of each dimension, a one dimensional table if empty
+     */
+    template <typename T>
+    void add(std::string name, std::span<const T> values, std::vector<uint32_t> shape = {}) {
+      add(name, typeOf<T>(), values.data(), values.size(), sizeof(T), shape);
+    }
+
+    template <typename T>
+    void add(std::string name, const std::vector<T>& values, std::vector<uint32_t> shape = {}) {
+      add(name, std::span<const T>(values), shape);
+    }
+
+    /**
+     * Writes the file. It is written to a temporary file first, which then
+     * replaces the old file, so processes which have mapped the old file
+     * keep reading consistent tables.
+     *
+     * @param path - path of the file
+     * @return true if successful
+     */
+    bool save(std::string path) const;
+
+   private:
+    struct Table {
+      std::string name;
+      Type type;
+      std::vector<uint32_t> shape;
+      std::vector<char> bytes;
+      uint64_t count;
+    };
+
+    void add(std::string& name, Type type, const void* values, std::size_t count, std::size_t size, std::vector<uint32_t>& shape);
+
+    std::vector<Table> tables;
+  };
+
+  struct Header {
+    char magic[8];
+    uint32_t byteOrder;
+    uint32_t version;
+    uint32_t nofTables;
+    uint32_t reserved[11];
+  };
+
+  struct Entry {
+    char name[maxNameLength + 1];
+    Type type;
+    uint32_t rank;
+    uint32_t shape[maxRank];
+    uint64_t offset;
+    uint64_t count;
+    uint32_t reserved[6];
+  };
+
+ private:
+  template <typename T>
+  static constexpr Type typeOf() {
+    if constexpr (std::is_same_v<T, int32_t>) return Type::int32;
+    else if constexpr (std::is_same_v<T, float>) return Type::float32;
+    else {
+      static_assert(std::is_same_v<T, double>, "tables hold int32_t, float or double values");
+      return Type::float64;
+    }
+  }
+
+  const Entry& find(std::string_view name) const;
+  const Entry& find(std::string_view name, Type type) const;
+
+  std::string path;
+  const char* data;
+  std::size_t size;
+  const Entry* entries;
+  uint32_t nofTables;
+};
+
+}
+}
+
+#endif /* ORG_EEROS_CONFIG_MAPPEDTABLE_HPP_ */
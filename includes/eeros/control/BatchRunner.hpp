@@ -0,0 +1,188 @@
+#ifndef ORG_EEROS_CONTROL_BATCHRUNNER_HPP_
+#define ORG_EEROS_CONTROL_BATCHRUNNER_HPP_
+
+#include <eeros/control/Output.hpp>
+#include <eeros/control/TimeDomain.hpp>
+#include <eeros/core/Fault.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace eeros {
+namespace control {
+
+/**
+ * One independent instance of a control graph run by a BatchRunner, e.g. the
+ * graph with one parameter set of a sweep. A derived class holds the blocks and
+ * time domains of the graph, adds the time domains with addTimeDomain() and the
+ * outputs to record with record().
+ *
+ * @since v1.4.4
+ */
+class BatchInstance {
+ public:
+  virtual ~BatchInstance() = default;
+
+  /**
+   * Adds a time domain. Time domains run in the order they are added, their
+   * periods must be multiples of the period of the runner.
+   *
+   * @param timeDomain - time domain of the graph
+   */
+  void addTimeDomain(TimeDomain& timeDomain);
+
+  /**
+   * Adds an output, which is recorded after each recorded step.
+   *
+   * @param output - output of a block
+   * @param name - name of the column, the name of the signal if empty
+   */
+  template < typename T >
+  void record(Output<T>& output, std::string name = "") {
+    using S = math::ValueShape<T>;
+    static_assert(std::is_arithmetic_v<typename S::value_type>, "BatchInstance records arithmetic values or matrices of them");
+    std::string n = name.empty() ? output.getSignal().getName() : name;
+    if (n.empty() || n == "time") throw Fault("recorded output of a batch instance needs a name other than 'time'");
+    columns.push_back(std::make_unique<SignalColumn<T>>(n, output.getSignal()));
+  }
+
+  /**
+   * Ends the run of this instance early, e.g. if it became unstable.
+   *
+   * @return true, if the instance is done
+   */
+  virtual bool done() { return false; }
+
+ private:
+  friend class BatchRunner;
+
+  struct Column {
+    Column(std::string name, unsigned int elements) : name(name), elements(elements) { }
+    virtual ~Column() = default;
+    virtual void sample(std::vector<double>& dst) const = 0;
+    std::string name;
+    unsigned int elements;
+  };
+
+  template < typename T >
+  struct SignalColumn : Column {
+    SignalColumn(std::string name, const Signal<T>& signal) : Column(name, math::ValueShape<T>::size), signal(signal) { }
+    void sample(std::vector<double>& dst) const override {
+      const auto* v = math::ValueShape<T>::data(signal.getValueRef());
+      for (unsigned int i = 0; i < this->elements; i++) dst.push_back(static_cast<double>(v[i]));
+    }
+    const Signal<T>& signal;
+  };
+
+  std::vector<TimeDomain*> timeDomains;
+  std::vector<std::unique_ptr<Column>> columns;
+};
+
+/**
+ * Recorded outputs of one BatchInstance. Each column holds the elements of all
+ * recorded samples one after the other, the column "time" holds the simulated
+ * time in seconds.
+ *
+ * @since v1.4.4
+ */
+class BatchResult {
+ public:
+  /**
+   * @return number of recorded samples
+   */
+  uint64_t getNofSamples() const;
+
+  /**
+   * @param name - name of the column
+   * @return true, if the column exists
+   */
+  bool hasColumn(const std::string& name) const;
+
+  /**
+   * @param name - name of the column
+   * @return elements of all samples of a column
+   */
+  const std::vector<double>& getColumn(const std::string& name) const;
+
+  /**
+   * @param name - name of the column
+   * @param sample - index of the sample
+   * @param element - index of the element within the sample, column major for matrices
+   * @return element of a recorded sample
+   */
+  double get(const std::string& name, uint64_t sample, unsigned int element = 0) const;
+
+ private:
+  friend class BatchRunner;
+
+  struct Data {
+    unsigned int elements;
+    std::vector<double> values;
+  };
+
+  const Data& find(const std::string& name) const;
+
+  uint64_t samples = 0;
+  std::map<std::string, Data> columns;
+};
+
+/**
+ * A batch runner runs many independent instances of a control graph offline,
+ * e.g. for Monte-Carlo tuning. The instances are distributed over worker
+ * threads, each worker creates an instance with the factory, runs it for a number
+ * of steps as fast as possible and records its outputs to memory.
+ *
+ * There is no timing by an executor. Instead, each step is a cycle of the worker
+ * thread (see System::beginCycle(uint64_t)) with the simulated time, so all
+ * blocks using System::getTimeNs() see the nominal period. Each time domain of an
+ * instance runs every period / runner period steps. The instances must not share
+ * blocks or other state without synchronization.
+ *
+ * @since v1.4.4
+ */
+class BatchRunner {
+ public:
+  using Factory = std::function<std::unique_ptr<BatchInstance>(unsigned int k)>;
+
+  /**
+   * Constructs a batch runner.
+   *
+   * @param period - period of a step in seconds
+   * @param threads - number of worker threads, the number of cores if 0
+   */
+  BatchRunner(double period, unsigned int threads = 0);
+
+  /**
+   * Runs all instances and waits for them. If an instance throws, no more
+   * instances are started and the exception is rethrown.
+   *
+   * @param nofInstances - number of instances K
+   * @param steps - maximum number of steps of each instance
+   * @param factory - creates instance k of 0 ... K - 1, called by the worker threads
+   * @param recordEvery - record after every n-th step
+   * @return recorded outputs of each instance
+   */
+  std::vector<BatchResult> run(unsigned int nofInstances, uint64_t steps, Factory factory, unsigned int recordEvery = 1);
+
+  /**
+   * @return number of worker threads
+   */
+  unsigned int getNofThreads() const;
+
+ private:
+  void runInstance(BatchInstance& instance, uint64_t steps, unsigned int recordEvery, BatchResult& result);
+
+  double period;
+  uint64_t periodNs;
+  unsigned int threads;
+};
+
+};
+};
+
+#endif /* ORG_EEROS_CONTROL_BATCHRUNNER_HPP_ */
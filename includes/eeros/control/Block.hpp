@@ -1,8 +1,11 @@
 #ifndef ORG_EEROS_CONTROL_BLOCK_HPP_
 #define ORG_EEROS_CONTROL_BLOCK_HPP_
 
+#include <atomic>
 #include <string>
+#include <vector>
 #include <eeros/core/Runnable.hpp>
+#include <eeros/control/SignalInterface.hpp>
 
 namespace eeros {
 namespace control {
@@ -46,9 +49,123 @@ class Block : public Runnable {
    * @see TimeDomain::enableBlocks()
    */
   virtual void disable() {}
+
+  /**
+   * Returns the blocks whose outputs are connected to the inputs of this block.
+   * Used for ordering the blocks of a timedomain.
+   *
+   * @return blocks connected to the inputs
+   * @see TimeDomain::sortBlocks()
+   */
+  virtual std::vector<Block*> getInputBlocks();
+
+  /**
+   * Returns true, if getInputBlocks() reports all blocks this block depends on.
+   * Blocks with hidden dependencies, e.g. through inner blocks, return false
+   * and are never moved relative to other blocks by a frozen timedomain.
+   *
+   * @return true, if all inputs are known
+   * @see TimeDomain::setFrozen()
+   */
+  virtual bool hasKnownInputs() const;
+
+  /**
+   * Returns true, if the outputs of the block depend on the inputs of the same cycle.
+   * Blocks without direct feedthrough such as a delay break loops in a timedomain.
+   *
+   * @return true, if the block has direct feedthrough
+   * @see TimeDomain::sortBlocks()
+   */
+  virtual bool hasDirectFeedthrough() const;
+
+  /**
+   * Returns true, if all inputs of the block are connected.
+   * Blocks which do not know their inputs return true.
+   *
+   * @return true, if all inputs are connected
+   * @see TimeDomain::validate()
+   */
+  virtual bool areInputsConnected() const;
+
+  /**
+   * Connects the inputs which read a forwarded signal, e.g. the input of a
+   * subsystem, directly to the output the signal comes from.
+   * Blocks which do not know their inputs keep reading through the forwarding.
+   *
+   * @see Output::getSource()
+   * @see TimeDomain::run()
+   */
+  virtual void resolveInputs();
+
+  /**
+   * Returns the signals read by the inputs of this block, only connected inputs
+   * are reported. Blocks which do not know their inputs return none.
+   *
+   * @return input signals
+   * @see TimeDomain::setChangePropagation()
+   */
+  virtual std::vector<const SignalInterface*> getInputSignals();
+
+  /**
+   * Returns true, if the block may currently be skipped by a timedomain in change 
+   * propagation mode as long as none of its input signals were written and 
+   * markChanged() was not called since its last run. Blocks, whose outputs only 
+   * depend on the values of the inputs and on parameters, return true.
+   *
+   * @return true, if the block can be skipped
+   * @see TimeDomain::setChangePropagation()
+   */
+  virtual bool isSkippable() const;
+
+  /**
+   * Returns true, if markChanged() was called since the last call, and clears the mark.
+   *
+   * @return true, if changed
+   */
+  bool takeChanged();
+
+  /**
+   * Marks the block as bound. A timedomain binds a block after having found all 
+   * its inputs connected, a bound block reads its inputs without checking the connection.
+   * Disconnecting an input of the block clears the mark.
+   *
+   * @param bound - true, if all inputs are connected
+   * @see TimeDomain::validate()
+   */
+  void setBound(bool bound);
+
+  /**
+   * Returns true, if the block is bound.
+   *
+   * @return true, if bound
+   */
+  bool isBound() const;
+
+ protected:
+  /**
+   * Reports that a parameter which the outputs depend on was changed, so that 
+   * the block runs in the next cycle even if its inputs did not change.
+   * May be called by any thread.
+   */
+  void markChanged() {
+    changed.store(true, std::memory_order_relaxed);
+  }
+
+  /**
+   * Returns the signal of an input. For a bound block the connection is not checked.
+   *
+   * @param input - input of this block
+   * @return signal
+   */
+  template < typename I >
+  auto& readSignal(I& input) {
+    return bound ? input.getSignalUnchecked() : input.getSignal();
+  }
   
  private:
   std::string name;
+  bool bound = false;
+  std::atomic<bool> changed{true};
 };
 
 };
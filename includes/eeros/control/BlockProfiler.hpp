@@ -0,0 +1,81 @@
+#ifndef ORG_EEROS_CONTROL_BLOCKPROFILER_HPP_
+#define ORG_EEROS_CONTROL_BLOCKPROFILER_HPP_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <eeros/control/Block.hpp>
+#include <eeros/core/Statistics.hpp>
+#include <eeros/core/Histogram.hpp>
+#include <eeros/logger/Logger.hpp>
+
+namespace eeros {
+namespace control {
+
+/**
+ * Records the run time of each block of a timedomain. The memory for all 
+ * blocks is allocated when the blocks are assigned, recording never allocates.
+ * As with the periodic counter, the statistics can be read from another thread 
+ * while the timedomain is running, a histogram snapshot is always consistent.
+ *
+ * @since v1.4.4
+ */
+class BlockProfiler {
+ public:
+  /**
+   * Run time statistics of one block, values are in seconds.
+   */
+  struct Entry {
+    Block* block;
+    std::string name;
+    Statistics run;
+    Histogram histogram;
+  };
+
+  /**
+   * Allocates an entry for each block and clears all statistics.
+   *
+   * @param blocks - blocks in the order they are run
+   */
+  void assign(const std::vector<Block*>& blocks);
+
+  /**
+   * Records the run time of a block.
+   *
+   * @param index - position of the block in the assigned list
+   * @param ns - run time in nanoseconds
+   */
+  void record(std::size_t index, uint64_t ns) {
+    double sec = ns / 1.0e9;
+    Entry& e = entries[index];
+    e.run.add(sec);
+    e.histogram.add(sec);
+  }
+
+  /**
+   * Clears the statistics of all blocks.
+   */
+  void reset();
+
+  /**
+   * Returns the statistics of all blocks in the order they are run.
+   *
+   * @return entries
+   */
+  const std::vector<Entry>& getEntries() const;
+
+  /**
+   * Writes the statistics of all blocks to a logger, one line per block.
+   *
+   * @param log - logger
+   */
+  void log(logger::Logger& log) const;
+
+ private:
+  std::vector<Entry> entries;
+};
+
+}
+}
+
+#endif // ORG_EEROS_CONTROL_BLOCKPROFILER_HPP_
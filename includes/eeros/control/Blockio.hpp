@@ -174,6 +174,82 @@ class Blockio : public Block {
     return out;
   }
 
+  /**
+   * Returns the blocks whose outputs are connected to the inputs of this block.
+   *
+   * @return blocks connected to the inputs
+   */
+  std::vector<Block*> getInputBlocks() override {
+    std::vector<Block*> blocks;
+    auto add = [&blocks](auto& input) {
+      Block* b = input.getConnectedBlock();
+      if (b != nullptr) blocks.push_back(b);
+    };
+    if constexpr (One<N>) {
+      add(in);
+    }
+    else if constexpr (Multiple<N>) {
+      std::apply([&add](auto&... in) { (add(in), ...); }, in);
+    }
+    return blocks;
+  }
+
+  /**
+   * Returns the signals of the connected inputs of this block.
+   *
+   * @return input signals
+   */
+  std::vector<const SignalInterface*> getInputSignals() override {
+    std::vector<const SignalInterface*> signals;
+    auto add = [&signals](auto& input) {
+      if (input.isConnected()) signals.push_back(&input.getSignal());
+    };
+    if constexpr (One<N>) {
+      add(in);
+    }
+    else if constexpr (Multiple<N>) {
+      std::apply([&add](auto&... in) { (add(in), ...); }, in);
+    }
+    return signals;
+  }
+
+  /**
+   * Returns true, if all inputs of the block are connected.
+   *
+   * @return true, if all inputs are connected
+   */
+  bool areInputsConnected() const override {
+    bool connected = true;
+    if constexpr (One<N>) {
+      connected = in.isConnected();
+    }
+    else if constexpr (Multiple<N>) {
+      std::apply([&connected](auto&... in) { ((connected = connected && in.isConnected()), ...); }, in);
+    }
+    return connected;
+  }
+
+  /**
+   * Connects inputs which read a forwarded signal directly to its source.
+   */
+  void resolveInputs() override {
+    if constexpr (One<N>) {
+      in.resolve();
+    }
+    else if constexpr (Multiple<N>) {
+      std::apply([](auto&... in) { (in.resolve(), ...); }, in);
+    }
+  }
+
+  /**
+   * All inputs of the block are reported by getInputBlocks().
+   *
+   * @return true
+   */
+  bool hasKnownInputs() const override {
+    return true;
+  }
+
  private:
   std::function<void()> func;
 
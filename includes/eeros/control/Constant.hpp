@@ -61,6 +61,18 @@ class Constant : public Blockio<0,1,T,T,SIUnit::generateNSizeArray<0>(),MakeUnit
   virtual void setValue(T newValue) {
     std::lock_guard<std::mutex> lock(mtx);
     value = newValue;
+    this->markChanged();
+  }
+
+  /**
+   * A constant only runs when its value was changed, if the timedomain
+   * propagates changes. Its timestamp then tells when it was changed.
+   *
+   * @return true
+   * @see TimeDomain::setChangePropagation()
+   */
+  bool isSkippable() const override {
+    return true;
   }
 
   /**
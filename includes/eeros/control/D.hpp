@@ -37,11 +37,11 @@ class D: public Blockio<1,1,T,T,MakeUnitArray<Uin>::value,MakeUnitArray<Uout>::v
    * its memory. Therefore, the output will be set to zero.
    */
   void run() override {
-    Signal<T> sig = this->in.getSignal(); 
+    const Signal<T>& sig = this->readSignal(this->in); 
     double tin = sig.getTimestamp() / 1000000000.0;
     double tprev = prev.getTimestamp() / 1000000000.0;
-    T valin = sig.getValue();
-    T valprev = prev.getValue();
+    const T& valin = sig.getValueRef();
+    const T& valprev = prev.getValueRef();
       
     if (first) {
       prev = this->in.getSignal();
@@ -55,8 +55,7 @@ class D: public Blockio<1,1,T,T,MakeUnitArray<Uin>::value,MakeUnitArray<Uout>::v
       }
     }
       
-    this->out.getSignal().setValue(valOut);
-    this->out.getSignal().setTimestamp(timeOut);
+    this->out.getSignal().set(valOut, timeOut);
     prev = sig;
   }
 
@@ -0,0 +1,101 @@
+#ifndef ORG_EEROS_CONTROL_DATAAGE_HPP_
+#define ORG_EEROS_CONTROL_DATAAGE_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <eeros/control/Blockio.hpp>
+#include <eeros/core/Histogram.hpp>
+#include <eeros/core/System.hpp>
+
+namespace eeros {
+namespace control {
+
+/**
+ * A data age block measures how old the data of a signal is when it reaches
+ * a certain point of the control system, e.g. the actuator output. The age is
+ * the time of the run minus the timestamp of the signal.
+ *
+ * Blocks propagate the timestamp of their oldest contributing input, sources
+ * stamp their output with the time the data was acquired, e.g. the start of
+ * the EtherCAT cycle or the reception of a datagram. The age therefore covers
+ * the whole chain from the source, including rate transitions and sockets.
+ *
+ * The block is a sink, its input can be connected to any output in parallel
+ * to the blocks using it. The distribution can be read from any thread.
+ *
+ * @tparam T - signal type (double - default type)
+ *
+ * @since v1.4.4
+ */
+template < typename T = double >
+class DataAge : public Blockio<1,0,T> {
+ public:
+  DataAge() { }
+
+  /**
+   * Disabling use of copy constructor because the block should never be copied unintentionally.
+   */
+  DataAge(const DataAge& s) = delete;
+
+  /**
+   * Records the age of the input signal.
+   */
+  virtual void run() {
+    timestamp_t ts = this->in.getSignal().getTimestamp();
+    timestamp_t now = System::getTimeNs();
+    if (ts == 0 || ts > now) return;   // not stamped yet or from another time base
+    if (resetRequested.exchange(false, std::memory_order_acquire)) {
+      histogram.reset();
+      max.store(0, std::memory_order_relaxed);
+    }
+    uint64_t age = now - ts;
+    histogram.add(age * 1.0e-9);
+    last.store(age, std::memory_order_relaxed);
+    if (age > max.load(std::memory_order_relaxed)) max.store(age, std::memory_order_relaxed);
+  }
+
+  /**
+   * Gets the distribution of the age since the last reset.
+   *
+   * @return snapshot of the histogram, values in sec
+   */
+  Histogram::Snapshot getDistribution() const {
+    return histogram.snapshot();
+  }
+
+  /**
+   * Gets the age measured in the last run.
+   *
+   * @return age in sec
+   */
+  double getLastAge() const {
+    return last.load(std::memory_order_relaxed) * 1.0e-9;
+  }
+
+  /**
+   * Gets the maximum age since the last reset.
+   *
+   * @return age in sec
+   */
+  double getMaxAge() const {
+    return max.load(std::memory_order_relaxed) * 1.0e-9;
+  }
+
+  /**
+   * Clears the distribution and the maximum in the next run.
+   */
+  void reset() {
+    resetRequested.store(true, std::memory_order_release);
+  }
+
+ private:
+  Histogram histogram;
+  std::atomic<uint64_t> last{0};
+  std::atomic<uint64_t> max{0};
+  std::atomic<bool> resetRequested{false};
+};
+
+}
+}
+
+#endif // ORG_EEROS_CONTROL_DATAAGE_HPP_
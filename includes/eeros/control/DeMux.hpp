@@ -36,14 +36,27 @@ class DeMux: public Blockio<1,N,C,T,MakeUnitArray<Uin>::value,Uout> {
 
   /**
    * Runs the demultiplexer.
+   * The input is read once, all outputs get its timestamp.
    *
    */
   void run() override {
+    const Signal<C>& sig = this->readSignal(this->in);
+    const C& value = sig.getValueRef();
+    timestamp_t time = sig.getTimestamp();
     for(uint32_t i = 0; i < N; i++) {
-      this->out[i].getSignal().setValue(this->in.getSignal().getValue()(i));
-      this->out[i].getSignal().setTimestamp(this->in.getSignal().getTimestamp());
+      this->out[i].getSignal().set(value(i), time);
     }
   }
+
+  /**
+   * The demultiplexer can be skipped while its input does not change.
+   *
+   * @return true
+   * @see TimeDomain::setChangePropagation()
+   */
+  bool isSkippable() const override {
+    return true;
+  }
       
 };
 
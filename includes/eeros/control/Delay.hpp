@@ -48,6 +48,15 @@ class Delay : public Blockio<1,1,T,T,MakeUnitArray<Uin>::value,MakeUnitArray<Uou
     delete[] timeBuf;
   }
 
+  /**
+   * The output does not depend on the input of the same cycle, so a delay breaks loops.
+   *
+   * @return false
+   */
+  bool hasDirectFeedthrough() const override {
+    return false;
+  }
+
   /**
    * Runs the delay block.   
    */
@@ -0,0 +1,116 @@
+#ifndef ORG_EEROS_CONTROL_ELEMENTPOOL_HPP_
+#define ORG_EEROS_CONTROL_ELEMENTPOOL_HPP_
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <eeros/core/FutexSemaphore.hpp>
+#include <eeros/logger/Logger.hpp>
+
+namespace eeros {
+namespace control {
+
+/**
+ * An element pool splits the element wise work of a block on a large signal,
+ * e.g. a 64x64 matrix, over a set of helper threads, each pinned to its own core.
+ * Blocks which support it take a pool with setElementPool().
+ *
+ * The elements are split into contiguous ranges of equal size, one per thread,
+ * aligned to whole cache lines. The thread running the block takes the first
+ * range and waits until all helpers have finished theirs, so the output is
+ * complete before the next block runs. As each element is computed by the same
+ * code regardless of the split, the result does not depend on the number of threads.
+ * Signals with fewer than twice the grain size elements are not split.
+ *
+ * The helper threads are started with the first split and inherit the scheduling
+ * policy and priority of the thread running the block. A pool must only be used
+ * by blocks of one time domain, as a split must not start before the previous one
+ * has finished.
+ *
+ * @since v1.4.4
+ */
+class ElementPool {
+ public:
+  static constexpr unsigned int defaultGrain = 1024;
+
+  /**
+   * Constructs an element pool.
+   *
+   * @param cpus - cores of the helper threads, one helper per core
+   * @param grain - minimum number of elements per thread
+   */
+  ElementPool(std::vector<int> cpus, unsigned int grain = defaultGrain);
+  ~ElementPool();
+
+  ElementPool(const ElementPool&) = delete;
+
+  /**
+   * Returns the number of threads a split uses at most, including the calling thread.
+   *
+   * @return number of threads
+   */
+  unsigned int getThreads() const;
+
+  /**
+   * Calls f(begin, end) for contiguous ranges which together cover 0 ... n - 1,
+   * in parallel on the helper threads and the calling thread. Returns after all
+   * ranges are done. f must not throw.
+   *
+   * @param n - number of elements
+   * @param f - function processing the elements begin ... end - 1
+   */
+  template < typename F >
+  void forEach(unsigned int n, F&& f) {
+    if (cpus.empty() || n < 2 * grain) {
+      f(0u, n);
+      return;
+    }
+    using P = std::remove_reference_t<F>;
+    split(n, [](void* c, unsigned int begin, unsigned int end) { (*static_cast<P*>(c))(begin, end); },
+          const_cast<void*>(static_cast<const void*>(&f)));
+  }
+
+ private:
+  using Job = void (*)(void*, unsigned int, unsigned int);
+
+  struct Helper {
+    FutexSemaphore wakeup;
+    std::thread thread;
+  };
+
+  void split(unsigned int n, Job job, void* context);
+  void helperLoop(int index);
+  unsigned int boundary(unsigned int part) const;
+
+  std::vector<int> cpus;
+  unsigned int grain;
+  std::vector<std::unique_ptr<Helper>> helpers;
+  Job job = nullptr;
+  void* context = nullptr;
+  unsigned int elements = 0;
+  unsigned int parts = 0;
+  std::atomic<unsigned int> active{0};
+  std::atomic<bool> finished{false};
+  FutexSemaphore done;
+  logger::Logger log;
+};
+
+/**
+ * Runs f(begin, end) over all elements, split over a pool if there is one.
+ *
+ * @param pool - element pool, nullptr to run on the calling thread
+ * @param n - number of elements
+ * @param f - function processing the elements begin ... end - 1
+ */
+template < typename F >
+inline void forEachElement(ElementPool* pool, unsigned int n, F&& f) {
+  if (pool != nullptr) pool->forEach(n, f);
+  else f(0u, n);
+}
+
+}
+}
+
+#endif // ORG_EEROS_CONTROL_ELEMENTPOOL_HPP_
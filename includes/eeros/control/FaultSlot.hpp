@@ -0,0 +1,100 @@
+#ifndef ORG_EEROS_CONTROL_FAULTSLOT_HPP_
+#define ORG_EEROS_CONTROL_FAULTSLOT_HPP_
+
+#include <string>
+
+namespace eeros {
+namespace control {
+
+class Block;
+
+/**
+ * A fault slot takes a fault reported by a block while a timedomain runs, 
+ * e.g. a read from an unconnected input. Reporting only stores the type of the 
+ * fault and the block, so that no exception has to be thrown and unwound on the
+ * realtime thread. The timedomain checks its slot after each block and raises 
+ * its safety event after the pass.
+ *
+ * Outside of a timedomain no slot is active and blocks throw the corresponding
+ * fault as before.
+ *
+ * @since v1.4.4
+ */
+class FaultSlot {
+ public:
+  enum class Type { none, notConnected, nanOutput };
+
+  /**
+   * Makes a slot the active slot of the calling thread for the lifetime of the scope.
+   */
+  class Scope {
+   public:
+    Scope(FaultSlot& slot);
+    ~Scope();
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+   private:
+    FaultSlot* previous;
+  };
+
+  /**
+   * Reports a fault into the active slot of the calling thread. 
+   * Only the first fault is kept until the slot is cleared.
+   *
+   * @param type - type of the fault
+   * @param block - block which reports the fault
+   * @return true, if a slot took the fault, false if the caller has to throw
+   */
+  static bool report(Type type, const Block* block);
+
+  /**
+   * Clears the slot.
+   */
+  void clear() {
+    type = Type::none;
+    block = nullptr;
+  }
+
+  /**
+   * Returns true, if a fault was reported.
+   *
+   * @return true, if set
+   */
+  bool isSet() const {
+    return type != Type::none;
+  }
+
+  /**
+   * Returns the type of the reported fault.
+   *
+   * @return type
+   */
+  Type getType() const {
+    return type;
+  }
+
+  /**
+   * Returns the block which reported the fault.
+   *
+   * @return block
+   */
+  const Block* getBlock() const {
+    return block;
+  }
+
+  /**
+   * Returns the same message as the fault, which would have been thrown.
+   *
+   * @return message
+   */
+  std::string getMessage() const;
+
+ private:
+  Type type = Type::none;
+  const Block* block = nullptr;
+};
+
+}
+}
+
+#endif // ORG_EEROS_CONTROL_FAULTSLOT_HPP_
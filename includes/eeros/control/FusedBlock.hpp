@@ -0,0 +1,130 @@
+#ifndef ORG_EEROS_CONTROL_FUSEDBLOCK_HPP_
+#define ORG_EEROS_CONTROL_FUSEDBLOCK_HPP_
+
+#include <eeros/control/Block.hpp>
+#include <eeros/core/Fault.hpp>
+#include <algorithm>
+#include <ostream>
+#include <tuple>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace eeros {
+namespace control {
+
+/**
+ * Common base of all fused blocks, gives the time domain access to the blocks
+ * which are fused.
+ *
+ * @since v1.4.4
+ */
+class FusedBlockBase : public Block {
+ public:
+  /**
+   * @return fused blocks in the order they are run
+   */
+  const std::vector<Block*>& getMembers() const {
+    return members;
+  }
+
+  /**
+   * The inputs of a fused block are the inputs of its members which are
+   * connected to blocks outside of the chain.
+   *
+   * @return blocks connected to the inputs of the members
+   */
+  std::vector<Block*> getInputBlocks() override {
+    std::vector<Block*> blocks;
+    for (auto m : members) {
+      for (auto b : m->getInputBlocks()) {
+        if (std::find(members.begin(), members.end(), b) == members.end()) blocks.push_back(b);
+      }
+    }
+    return blocks;
+  }
+
+ protected:
+  std::vector<Block*> members;
+};
+
+/**
+ * A fused block runs a linear chain of blocks, e.g. Sum -> Gain -> Saturation,
+ * with a single call. The run() methods of the members are called directly with
+ * their static type instead of over the virtual table, so the compiler inlines
+ * the whole chain into one function.
+ *
+ * The members stay normal blocks, which are added to the time domain, named,
+ * connected and inspected as usual, their outputs are written on each run. The
+ * fused block is registered with TimeDomain::addFusedBlock() and replaces its
+ * members in the run list when the time domain is frozen.
+ * In contrast to StaticTimeDomain, no stages have to be written for the chain.
+ *
+ * Example:
+ * FusedBlock axis(sum, gain, saturation);
+ * timedomain.addFusedBlock(axis);
+ *
+ * @tparam B - types of the members, must be their dynamic types
+ *
+ * @since v1.4.4
+ */
+template < typename... B >
+class FusedBlock : public FusedBlockBase {
+  static_assert(sizeof...(B) >= 2, "a fused block needs at least two blocks");
+
+ public:
+  /**
+   * Constructs a fused block. Each block must read from the block before it,
+   * all connections of the chain must thus be made before.
+   *
+   * @param blocks - blocks in the order they are run
+   */
+  FusedBlock(B&... blocks) : blocks(blocks...) {
+    members = {&blocks...};
+    bool exact = ((typeid(blocks) == typeid(B)) && ...);
+    if (!exact) throw Fault("blocks of a fused block must be given with their own type");
+    for (std::size_t i = 1; i < members.size(); i++) {
+      auto in = members[i]->getInputBlocks();
+      if (std::find(in.begin(), in.end(), members[i - 1]) == in.end()) {
+        throw Fault("block '" + members[i]->getName() + "' does not read from block '" + members[i - 1]->getName() + "', cannot fuse");
+      }
+    }
+  }
+
+  /**
+   * Disabling use of copy constructor because the block should never be copied unintentionally.
+   */
+  FusedBlock(const FusedBlock& s) = delete;
+
+  /**
+   * Runs all members in their order.
+   */
+  void run() override {
+    runMembers(std::index_sequence_for<B...>{});
+  }
+
+ private:
+  template < std::size_t... Is >
+  void runMembers(std::index_sequence<Is...>) {
+    // qualified calls are not dispatched over the virtual table
+    (std::get<Is>(blocks).B::run(), ...);
+  }
+
+  std::tuple<B&...> blocks;
+};
+
+/**
+ * Operator overload (<<) to enable an easy way to print the state of a
+ * fused block instance to an output stream.\n
+ * Does not print a newline control character.
+ */
+template < typename... B >
+std::ostream& operator<<(std::ostream& os, FusedBlock<B...>& b) {
+  os << "Block fused: '" << b.getName() << "' with " << sizeof...(B) << " blocks";
+  return os;
+}
+
+}
+}
+
+#endif // ORG_EEROS_CONTROL_FUSEDBLOCK_HPP_
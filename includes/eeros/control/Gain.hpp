@@ -2,9 +2,12 @@
 #define ORG_EEROS_CONTROL_GAIN_HPP_
 
 #include <eeros/control/Blockio.hpp>
+#include <eeros/control/ElementPool.hpp>
+#include <eeros/core/ParameterSet.hpp>
+#include <eeros/math/Fixed.hpp>
+#include <eeros/math/Matrix.hpp>
 #include <type_traits>
 #include <memory>
-#include <mutex>
 #include <math.h>
 
 
@@ -24,9 +27,18 @@ namespace control {
  * The non-type template argument specifies if the multiplication will be done
  * element wise in case the gain is used with matrices.
  *
- * A gain block is suitable for use with multiple threads. However,
- * enabling/disabling of the gain and the smooth change feature
- * is not synchronized.
+ * Instead of a dense matrix, the gain can be a DiagonalMatrix, a
+ * BlockDiagonalMatrix or a SparseMatrix, see StructuredMatrix.hpp. The
+ * multiplication and the smooth change then only work on the stored elements.
+ * The limits and the gain difference must have the structure of the gain.
+ *
+ * A gain block is suitable for use with multiple threads. The parameters are
+ * published as a whole with a ParameterSet, so the running block never sees
+ * a partly written gain matrix and does not take a lock. However, enabling
+ * and disabling of the gain is not synchronized.
+ *
+ * For large matrix signals with a scalar or an element wise gain, the
+ * multiplication can be split over several cores with setElementPool().
  *
  * @tparam Tout - input and output signal data type (double - default type)
  * @tparam Tgain - gain data type (double - default type)
@@ -56,8 +68,8 @@ class Gain : public Blockio<1,1,Tout,Tout,MakeUnitArray<Uin>::value,MakeUnitArra
    *
    * @param c - initial gain value
    */
-  Gain(Tgain c) : Gain(c, 1.0, -1.0) { // 1.0 and -1.0 are temp values only.
-    resetMinMaxGain<Tgain>(); // set limits to smallest/largest value.
+  Gain(Tgain c) : Gain(c, c, c) { // the limits are temp values only.
+    params.modify([this](Params& p) { resetMinMaxGain<Tgain>(p); }); // set limits to smallest/largest value.
   }
 
   /**
@@ -70,13 +82,7 @@ class Gain : public Blockio<1,1,Tout,Tout,MakeUnitArray<Uin>::value,MakeUnitArra
    * @param maxGain - initial maximum gain value
    * @param minGain - initial minimum gain value
    */
-  Gain(Tgain c, Tgain maxGain, Tgain minGain) {
-    gain = c;
-    this->maxGain = maxGain;
-    this->minGain = minGain;
-    targetGain = gain;
-    gainDiff = 0;
-  }
+  Gain(Tgain c, Tgain maxGain, Tgain minGain) : gain(c), params(initialParams(c, maxGain, minGain)) { }
 
   
   /**
@@ -104,40 +110,44 @@ class Gain : public Blockio<1,1,Tout,Tout,MakeUnitArray<Uin>::value,MakeUnitArra
    * @see disable()
    */
   void run() override {
-    std::lock_guard<std::mutex> lock(mtx);
+    const Params& p = params.acquire();
 
-    if (smoothChange) {
-      if (gain < targetGain) {
-        gain += gainDiff;
-        if (gain > targetGain) { // overshoot case.
-          gain = targetGain;
+    if (p.smoothChange) {
+      if (gain < p.targetGain) {
+        gain += p.gainDiff;
+        if (gain > p.targetGain) { // overshoot case.
+          gain = p.targetGain;
         }
       }
 
-      if (gain > targetGain) {
-        gain -= gainDiff;
-        if (gain < targetGain) {
-          gain = targetGain;
+      if (gain > p.targetGain) {
+        gain -= p.gainDiff;
+        if (gain < p.targetGain) {
+          gain = p.targetGain;
         }
       }
+    } else {
+      gain = p.targetGain;
     }
+    settled = !p.smoothChange;
 
-    if (gain > maxGain) { // if diff will cause gain to be too large.
-      gain = maxGain;
+    if (gain > p.maxGain) { // if diff will cause gain to be too large.
+      gain = p.maxGain;
     }
 
-    if (gain < minGain) {
-      gain = minGain;
+    if (gain < p.minGain) {
+      gain = p.minGain;
     }
 
+    const Signal<Tout>& in = this->readSignal(this->in);
+    Signal<Tout>& out = this->out.getSignal();
     if (enabled) {
-      if (parabolic) this->out.getSignal().setValue(calculateParabolic<Tout,Tgain>(this->in.getSignal().getValue()));
-      else this->out.getSignal().setValue(calculate<Tout>(this->in.getSignal().getValue()));
+      if (p.parabolic) out.set(calculateParabolic<Tout,Tgain>(in.getValueRef(), p.parabolicSwitchPoint), in.getTimestamp());
+      else if (pool != nullptr) out.set(calculateSplit<Tout>(in.getValueRef()), in.getTimestamp());
+      else out.set(calculate<Tout>(in.getValueRef()), in.getTimestamp());
     } else {
-      this->out.getSignal().setValue(this->in.getSignal().getValue());
+      out.set(in.getValueRef(), in.getTimestamp());
     }
-
-    this->out.getSignal().setTimestamp(this->in.getSignal().getTimestamp());
   }
 
   /**
@@ -152,6 +162,7 @@ class Gain : public Blockio<1,1,Tout,Tout,MakeUnitArray<Uin>::value,MakeUnitArra
    */
   void enable() override {
     enabled = true;
+    this->markChanged();
   }
 
   /**
@@ -166,6 +177,7 @@ class Gain : public Blockio<1,1,Tout,Tout,MakeUnitArray<Uin>::value,MakeUnitArra
    */
   void disable() override {
     enabled = false;
+    this->markChanged();
   }
 
   /**
@@ -182,7 +194,8 @@ class Gain : public Blockio<1,1,Tout,Tout,MakeUnitArray<Uin>::value,MakeUnitArra
    * @see disable()
    */
   virtual void enableSmoothChange(bool enable) {
-    smoothChange = enable;
+    this->markChanged();
+    params.modify([enable](Params& p) { p.smoothChange = enable; });
   }
   
   /**
@@ -198,28 +211,23 @@ class Gain : public Blockio<1,1,Tout,Tout,MakeUnitArray<Uin>::value,MakeUnitArra
    * @see setParabolicGainParams()
    */
   virtual void enableParabolicGain(bool enable) {
-    parabolic = enable;
+    this->markChanged();
+    params.modify([enable](Params& p) { p.parabolic = enable; });
   }
 
   /**
-   * Sets the gain value if smooth change is disabled and c is in the band in between minGain and maxGain.
-   *
-   * Sets the target gain value if smooth change is enabled and c is in the band in between minGain and maxGain.
+   * Sets the target gain value if c is in the band in between minGain and maxGain. The gain
+   * follows the target gain at the next run, immediately if smooth change is disabled.
    *
    * Does not change gain or target gain value otherwise.
    *
    * @param c - gain value
    */
   virtual void setGain(Tgain c) {
-    std::lock_guard<std::mutex> lock(mtx);
-
-    if (c <= maxGain && c >= minGain) {
-      if (smoothChange) {
-        targetGain = c;
-      } else {
-        gain = c;
-      }
-    }
+    this->markChanged();
+    params.modify([&c](Params& p) {
+      if (c <= p.maxGain && c >= p.minGain) p.targetGain = c;
+    });
   }
 
   /**
@@ -228,8 +236,8 @@ class Gain : public Blockio<1,1,Tout,Tout,MakeUnitArray<Uin>::value,MakeUnitArra
    * @param maxGain - maximum allowed gain value
    */
   virtual void setMaxGain(Tgain maxGain) {
-    std::lock_guard<std::mutex> lock(mtx);
-    this->maxGain = maxGain;
+    this->markChanged();
+    params.modify([&maxGain](Params& p) { p.maxGain = maxGain; });
   }
 
   /**
@@ -238,8 +246,8 @@ class Gain : public Blockio<1,1,Tout,Tout,MakeUnitArray<Uin>::value,MakeUnitArra
    * @param minGain - minimum allowed gain value
    */
   virtual void setMinGain(Tgain minGain) {
-    std::lock_guard<std::mutex> lock(mtx);
-    this->minGain = minGain;
+    this->markChanged();
+    params.modify([&minGain](Params& p) { p.minGain = minGain; });
   }
 
   /**
@@ -248,8 +256,8 @@ class Gain : public Blockio<1,1,Tout,Tout,MakeUnitArray<Uin>::value,MakeUnitArra
    * @param gainDiff - gain differential
    */
   virtual void setGainDiff(Tgain gainDiff) {
-    std::lock_guard<std::mutex> lock(mtx);
-    this->gainDiff = gainDiff;
+    this->markChanged();
+    params.modify([&gainDiff](Params& p) { p.gainDiff = gainDiff; });
   }
 
   /**
@@ -258,8 +266,29 @@ class Gain : public Blockio<1,1,Tout,Tout,MakeUnitArray<Uin>::value,MakeUnitArra
    * @param parabolicSwitchPoint - input limit
    */
   virtual void setParabolicGainParams(Tout parabolicSwitchPoint) {
-    std::lock_guard<std::mutex> lock(mtx);
-    this->parabolicSwitchPoint = parabolicSwitchPoint;
+    this->markChanged();
+    params.modify([&parabolicSwitchPoint](Params& p) { p.parabolicSwitchPoint = parabolicSwitchPoint; });
+  }
+
+  /**
+   * The gain can be skipped while its input does not change, unless it changes the gain smoothly.
+   *
+   * @return true, if smooth change is disabled
+   * @see TimeDomain::setChangePropagation()
+   */
+  bool isSkippable() const override {
+    return settled;
+  }
+
+  /**
+   * Splits the multiplication of large matrix signals over the threads of an
+   * element pool. Only a scalar gain of the element type of the signal and an
+   * element wise gain are split, the parabolic gain is not.
+   *
+   * @param pool - element pool, nullptr to run on the thread of the time domain only
+   */
+  virtual void setElementPool(ElementPool* pool) {
+    this->pool = pool;
   }
 
   /*
@@ -270,18 +299,35 @@ class Gain : public Blockio<1,1,Tout,Tout,MakeUnitArray<Uin>::value,MakeUnitArra
   friend std::ostream &operator<<(std::ostream &os, Gain<Xout, Xgain> &gain);
 
  protected:
+  /*
+   * Parameters set by the setters, the running block reads them with a single acquire().
+   */
+  struct Params {
+    Tgain maxGain;
+    Tgain minGain;
+    Tgain targetGain;
+    Tgain gainDiff;
+    bool smoothChange{false};
+    bool parabolic{false};
+    Tout parabolicSwitchPoint;
+  };
+
   Tgain gain;
-  Tgain maxGain;
-  Tgain minGain;
-  Tgain targetGain;
-  Tgain gainDiff;
   bool enabled{true};
-  bool smoothChange{false};
-  bool parabolic{false};
-  Tout parabolicSwitchPoint;
-  std::mutex mtx;
+  ParameterSet<Params> params;
+  ElementPool* pool{nullptr};
+  bool settled{false};
 
  private:
+  static Params initialParams(const Tgain& c, const Tgain& maxGain, const Tgain& minGain) {
+    Params p{};
+    p.maxGain = maxGain;
+    p.minGain = minGain;
+    p.targetGain = c;
+    p.gainDiff = 0;
+    return p;
+  }
+
   template<typename R>
   typename std::enable_if<!elementWise, R>::type calculate(R value) {
     return gain * value;
@@ -293,8 +339,27 @@ class Gain : public Blockio<1,1,Tout,Tout,MakeUnitArray<Uin>::value,MakeUnitArra
     return value.multiplyElementWise(gain);
   }
 
+  template<typename R>
+  R calculateSplit(const R& value) {
+    if constexpr (std::is_compound<R>::value && elementWise) {
+      R outVal;
+      pool->forEach(value.size(), [&](unsigned int b, unsigned int e) {
+        math::kernel::elementwise<math::kernel::Mul>(outVal.data() + b, value.data() + b, gain.data() + b, e - b);
+      });
+      return outVal;
+    } else if constexpr (!math::isScalar<R>::value && std::is_same<Tgain, typename math::ValueShape<R>::value_type>::value) {
+      R outVal;
+      pool->forEach(value.size(), [&](unsigned int b, unsigned int e) {
+        math::kernel::elementwise<math::kernel::Mul>(outVal.data() + b, gain, value.data() + b, e - b);
+      });
+      return outVal;
+    } else {
+      return calculate<R>(value);
+    }
+  }
+
   template<typename R, typename S>  // Tout, Tgain
-  typename std::enable_if<std::is_arithmetic<R>::value, R>::type calculateParabolic(R value) {
+  typename std::enable_if<std::is_arithmetic<R>::value, R>::type calculateParabolic(R value, const Tout& parabolicSwitchPoint) {
     Tout outVal;
     if (fabs(value) > parabolicSwitchPoint) {
       if (value >= 0) outVal = gain * sqrt(parabolicSwitchPoint * (2 * value - parabolicSwitchPoint));
@@ -306,7 +371,7 @@ class Gain : public Blockio<1,1,Tout,Tout,MakeUnitArray<Uin>::value,MakeUnitArra
   }
 
   template<typename R, typename S>
-  typename std::enable_if<std::is_compound<R>::value && std::is_arithmetic<S>::value && !elementWise, R>::type calculateParabolic(R value) {
+  typename std::enable_if<std::is_compound<R>::value && std::is_arithmetic<S>::value && !elementWise, R>::type calculateParabolic(R value, const Tout& parabolicSwitchPoint) {
     Tout outVal;
     for (unsigned int i = 0; i < value.size(); i++) {
       if (fabs(value[i]) > parabolicSwitchPoint[i]) {
@@ -320,21 +385,21 @@ class Gain : public Blockio<1,1,Tout,Tout,MakeUnitArray<Uin>::value,MakeUnitArra
   }
 
   template<typename R, typename S>
-  typename std::enable_if<std::is_compound<R>::value && std::is_arithmetic<S>::value && elementWise, R>::type calculateParabolic(R value) {
+  typename std::enable_if<std::is_compound<R>::value && std::is_arithmetic<S>::value && elementWise, R>::type calculateParabolic(R value, const Tout& parabolicSwitchPoint) {
     Tout outVal;
     // a gain block with scalar gain factor must not use elementwise multiplication
     return outVal;
   }
 
   template<typename R, typename S>
-  typename std::enable_if<std::is_compound<R>::value && std::is_compound<S>::value && !elementWise, R>::type calculateParabolic(R value) {
+  typename std::enable_if<std::is_compound<R>::value && std::is_compound<S>::value && !elementWise, R>::type calculateParabolic(R value, const Tout& parabolicSwitchPoint) {
     Tout outVal;
     // multiplication with parabolic gain and gain matrix does not make sense
     return outVal;
   }
 
   template<typename R, typename S>
-  typename std::enable_if<std::is_compound<R>::value && std::is_compound<S>::value && elementWise, R>::type calculateParabolic(R value) {
+  typename std::enable_if<std::is_compound<R>::value && std::is_compound<S>::value && elementWise, R>::type calculateParabolic(R value, const Tout& parabolicSwitchPoint) {
     Tout outVal;
     for (unsigned int i = 0; i < value.size(); i++) {
       if (fabs(value[i]) > parabolicSwitchPoint[i]) {
@@ -348,30 +413,36 @@ class Gain : public Blockio<1,1,Tout,Tout,MakeUnitArray<Uin>::value,MakeUnitArra
   }
 
   template<typename S>
-  typename std::enable_if<std::is_integral<S>::value>::type resetMinMaxGain() {
-    minGain = std::numeric_limits<int32_t>::min();
-    maxGain = std::numeric_limits<int32_t>::max();
+  typename std::enable_if<std::is_integral<S>::value>::type resetMinMaxGain(Params& p) {
+    p.minGain = std::numeric_limits<int32_t>::min();
+    p.maxGain = std::numeric_limits<int32_t>::max();
+  }
+
+  template<typename S>
+  typename std::enable_if<std::is_floating_point<S>::value>::type resetMinMaxGain(Params& p) {
+    p.minGain = std::numeric_limits<double>::lowest();
+    p.maxGain = std::numeric_limits<double>::max();
   }
 
   template<typename S>
-  typename std::enable_if<std::is_floating_point<S>::value>::type resetMinMaxGain() {
-    minGain = std::numeric_limits<double>::lowest();
-    maxGain = std::numeric_limits<double>::max();
+  typename std::enable_if<math::isFixed<S>::value>::type resetMinMaxGain(Params& p) {
+    p.minGain = S::lowest();
+    p.maxGain = S::max();
   }
 
   template<typename S>
   typename std::enable_if<!std::is_arithmetic<S>::value && std::is_integral<typename S::value_type>::value>::type
-  resetMinMaxGain() {
-    minGain.fill(std::numeric_limits<int32_t>::min());
-    maxGain.fill(std::numeric_limits<int32_t>::max());
+  resetMinMaxGain(Params& p) {
+    p.minGain.fill(std::numeric_limits<int32_t>::min());
+    p.maxGain.fill(std::numeric_limits<int32_t>::max());
   }
 
   template<typename S>
   typename std::enable_if<
       !std::is_arithmetic<S>::value && std::is_floating_point<typename S::value_type>::value>::type
-  resetMinMaxGain() {
-    minGain.fill(std::numeric_limits<double>::lowest());
-    maxGain.fill(std::numeric_limits<double>::max());
+  resetMinMaxGain(Params& p) {
+    p.minGain.fill(std::numeric_limits<double>::lowest());
+    p.maxGain.fill(std::numeric_limits<double>::max());
   }
 };
 
@@ -383,10 +454,11 @@ class Gain : public Blockio<1,1,Tout,Tout,MakeUnitArray<Uin>::value,MakeUnitArra
  */
 template<typename Tout, typename Tgain>
 std::ostream &operator<<(std::ostream &os, Gain<Tout, Tgain> &gain) {
+  auto p = gain.params.get();
   os << "Block Gain: '" << gain.getName() << "' is enabled=" << gain.enabled << ", gain=" << gain.gain << ", ";
-  os << "smoothChange=" << gain.smoothChange << ", minGain=" << gain.minGain << ", maxGain=" << gain.maxGain;
-  os << ", targetGain=" << gain.targetGain << ", gainDiff=" << gain.gainDiff;
-  os << ", parabolic=" << gain.parabolic << ", parabolicSwitchPoint=" << gain.parabolicSwitchPoint;
+  os << "smoothChange=" << p.smoothChange << ", minGain=" << p.minGain << ", maxGain=" << p.maxGain;
+  os << ", targetGain=" << p.targetGain << ", gainDiff=" << p.gainDiff;
+  os << ", parabolic=" << p.parabolic << ", parabolicSwitchPoint=" << p.parabolicSwitchPoint;
   return os;
 }
 
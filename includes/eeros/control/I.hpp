@@ -3,6 +3,8 @@
 
 #include <eeros/control/Blockio.hpp>
 #include <eeros/logger/Logger.hpp>
+#include <eeros/math/Fixed.hpp>
+#include <eeros/math/Matrix.hpp>
 #include <eeros/safety/SafetyLevel.hpp>
 #include <eeros/safety/SafetySystem.hpp>
 #include <cmath>
@@ -56,23 +58,30 @@ class I: public Blockio<1,1,T,T,MakeUnitArray<Uin>::value,MakeUnitArray<Uout>::v
     std::lock_guard<std::mutex> lock(mtx);
     if (activeLevel != nullptr)
       enabled =  safetySystem->getCurrentLevel() >= *activeLevel;
-    double tin = this->in.getSignal().getTimestamp() / 1000000000.0;
+    const Signal<T>& in = this->readSignal(this->in);
+    double tin = in.getTimestamp() / 1000000000.0;
     double tprev = this->prev.getTimestamp() / 1000000000.0;
     double dt;
     if (first) {
       dt = 0; 
       first = false;
     } else dt = (tin - tprev);
-    T valin = this->in.getSignal().getValue();
-    T valprev = this->prev.getValue();
+    const T& valin = in.getValueRef();
+    const T& valprev = this->prev.getValueRef();
     T output;
     if (enabled) {
-      T val = valprev + valin * dt;
-      if ((val < upperLimit) && (val > lowerLimit)) output = val; 
-      else output = valprev;
+      if constexpr (math::isScalar<T>::value) {
+        T val = valprev + valin * dt;
+        if ((val < upperLimit) && (val > lowerLimit)) output = val; 
+        else output = valprev;
+      } else {
+        // integrates and checks the limits of all elements in one pass
+        using V = typename T::value_type;
+        if (!math::kernel::integrate(output.data(), valprev.data(), valin.data(), static_cast<V>(dt),
+                                     lowerLimit.data(), upperLimit.data(), output.size())) output = valprev;
+      }
     } else output = valprev;
-    this->out.getSignal().setValue(output);
-    this->out.getSignal().setTimestamp(this->in.getSignal().getTimestamp());
+    this->out.getSignal().set(output, in.getTimestamp());
     this->prev = this->out.getSignal();
   }
 
@@ -170,6 +179,11 @@ class I: public Blockio<1,1,T,T,MakeUnitArray<Uin>::value,MakeUnitArray<Uout>::v
     lowerLimit = std::numeric_limits<S>::lowest();
   }
 
+  template <typename S> typename std::enable_if<math::isFixed<S>::value>::type _clear() {
+    upperLimit = S::max();
+    lowerLimit = S::lowest();
+  }
+
   template <typename S> typename std::enable_if<!std::is_arithmetic<S>::value && std::is_integral<typename S::value_type>::value>::type _clear() {
     upperLimit.fill(std::numeric_limits<typename S::value_type>::max());
     lowerLimit.fill(std::numeric_limits<typename S::value_type>::lowest());
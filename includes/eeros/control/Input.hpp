@@ -3,6 +3,7 @@
 
 #include <eeros/SIUnit.hpp>
 #include <eeros/control/NotConnectedFault.hpp>
+#include <eeros/control/FaultSlot.hpp>
 #include <eeros/control/Signal.hpp>
 #include <eeros/control/Output.hpp>
 #include <eeros/control/Block.hpp>
@@ -67,6 +68,7 @@ class Input {
    */
   virtual void disconnect() {
     connectedOutput = nullptr;
+    if (owner != nullptr) owner->setBound(false);
   }
 
   /**
@@ -80,18 +82,41 @@ class Input {
         
   /**
    * Returns the signal which is carried by the output to which
-   * this input is connected. If the input is not connected an NotConnectedFault
-   * is thrown.
+   * this input is connected. If the input is not connected while a timedomain
+   * runs, the fault is reported to the timedomain and the illegal signal is returned. 
+   * Otherwise a NotConnectedFault is thrown.
    * 
    * @return signal 
    */
   virtual Signal<T>& getSignal() {
     if(isConnected()) return connectedOutput->getSignal();
+    if (FaultSlot::report(FaultSlot::Type::notConnected, owner)) return Signal<T>::getIllegalSignal();
     std::string name;
     if (owner != nullptr) name = owner->getName(); else name = "";
       throw NotConnectedFault("Read from an unconnected input in block '" + name + "'");
   }
          
+  /**
+   * Returns the signal of the connected output without checking the connection.
+   * Must only be called if the input is connected, e.g. by a bound block.
+   * 
+   * @return signal 
+   * @see Block::isBound()
+   */
+  Signal<T>& getSignalUnchecked() {
+    return connectedOutput->getSignal();
+  }
+
+  /**
+   * Connects this input directly to the output its signal comes from, 
+   * if the connected output only forwards the signal of another output.
+   *
+   * @see Output::getSource()
+   */
+  void resolve() {
+    if (connectedOutput != nullptr) connectedOutput = connectedOutput->getSource();
+  }
+
   /**
    * Every input is owned by a block. Sets the owner of this input.
    * 
@@ -101,6 +126,15 @@ class Input {
     owner = block;
   }
 
+  /**
+   * Returns the block which owns the output connected to this input.
+   * 
+   * @return block connected to this input, nullptr if not connected or unknown
+   */
+  virtual Block* getConnectedBlock() const {
+    return (connectedOutput != nullptr) ? connectedOutput->getOwner() : nullptr;
+  }
+
  protected:
   Output<T, Unit>* connectedOutput;
   Block* owner;
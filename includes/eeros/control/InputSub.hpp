@@ -44,6 +44,16 @@ class InputSub : public Input<T>, public Output<T> {
   virtual Signal<T>& getSignal() {
     return Input<T>::getSignal();
   }
+
+  /**
+   * Returns the output this input is connected to, as this input only 
+   * forwards its signal to the internal blocks of the subsystem. 
+   * 
+   * @return source of the signal, this if not connected
+   */
+  virtual Output<T>* getSource() {
+    return this->isConnected() ? this->connectedOutput->getSource() : this;
+  }
             
  };
 
@@ -0,0 +1,72 @@
+#ifndef ORG_EEROS_CONTROL_JERKPROFILE_HPP_
+#define ORG_EEROS_CONTROL_JERKPROFILE_HPP_
+
+namespace eeros {
+namespace control {
+
+/**
+ * Time optimal motion of one axis with limited velocity, acceleration and jerk
+ * from an arbitrary state (position, velocity, acceleration) to a target position
+ * at rest. The profile consists of at most 7 phases of constant jerk: a change of
+ * the velocity to a peak velocity, a phase of constant peak velocity and a change
+ * of the velocity back to 0.
+ *
+ * plan() solves for the peak velocity with a fixed number of bisection steps, so
+ * its execution time is bounded and does not depend on the state. It is meant to
+ * be called in every cycle of a time domain, see \ref PathPlannerOnline.
+ *
+ * The start acceleration must be within the limit, a higher acceleration is
+ * reduced as fast as the jerk allows.
+ *
+ * @since v1.4.4
+ */
+class JerkProfile {
+ public:
+  static constexpr int maxPhases = 7;
+
+  /**
+   * Plans the motion from a state to a target position.
+   *
+   * @param pos - start position
+   * @param vel - start velocity
+   * @param acc - start acceleration
+   * @param target - target position
+   * @param velMax - maximum velocity, > 0
+   * @param accMax - maximum acceleration, > 0
+   * @param jerkMax - maximum jerk, > 0
+   */
+  void plan(double pos, double vel, double acc, double target, double velMax, double accMax, double jerkMax);
+
+  /**
+   * @return time to reach the target in sec
+   */
+  double getDuration() const { return duration; }
+
+  /**
+   * Evaluates the state of the profile at a time after the start.
+   * After the duration the state rests at the target.
+   *
+   * @param t - time since the start in sec
+   * @param pos - position
+   * @param vel - velocity
+   * @param acc - acceleration
+   * @param jerk - jerk
+   */
+  void sample(double t, double& pos, double& vel, double& acc, double& jerk) const;
+
+ private:
+  struct Phase {
+    double jerk;
+    double duration;
+  };
+
+  double pos = 0, vel = 0, acc = 0;
+  Phase phase[maxPhases];
+  int count = 0;
+  double duration = 0;
+};
+
+}
+}
+
+#endif // ORG_EEROS_CONTROL_JERKPROFILE_HPP_
@@ -0,0 +1,121 @@
+#ifndef ORG_EEROS_CONTROL_LUT1D_HPP_
+#define ORG_EEROS_CONTROL_LUT1D_HPP_
+
+#include <eeros/config/MappedTable.hpp>
+#include <eeros/control/Blockio.hpp>
+#include <eeros/control/LutAxis.hpp>
+#include <eeros/core/Fault.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace eeros {
+namespace control {
+
+/**
+ * A one dimensional lookup table, e.g. for a friction or cogging compensation.
+ * The output is linearly interpolated between the values at the grid points,
+ * see LutAxis for the grid and inputs outside of it. If the signal is a matrix,
+ * each element is looked up in the same table, with a separate cached segment.
+ *
+ * The values and grid points can be copied into the block or referenced, e.g.
+ * when they are tables of a MappedTable, which must then outlive the block.
+ *
+ * @tparam T - input and output signal data type, a floating point type or a matrix of it (double - default type)
+ * @tparam Uin - input signal unit type (dimensionless - default type)
+ * @tparam Uout - output signal unit type (dimensionless - default type)
+ *
+ * @since v1.4.4
+ */
+template < typename T = double, SIUnit Uin = SIUnit::create(), SIUnit Uout = SIUnit::create() >
+class Lut1D : public Blockio<1,1,T,T,MakeUnitArray<Uin>::value,MakeUnitArray<Uout>::value> {
+  using V = typename math::ValueShape<T>::value_type;
+  static constexpr unsigned int C = math::ValueShape<T>::size;
+  static_assert(std::is_floating_point_v<V>, "Lut1D needs floating point values or a matrix of them");
+
+ public:
+  /**
+   * Constructs a lookup table on a uniform grid, referencing the values.
+   *
+   * @param x0 - first grid point
+   * @param dx - distance between two grid points
+   * @param values - values at the grid points
+   */
+  Lut1D(double x0, double dx, std::span<const V> values) : axis(x0, dx, values.size()), values(values.data()) { }
+
+  /**
+   * Constructs a lookup table on a uniform grid, copying the values.
+   */
+  Lut1D(double x0, double dx, std::vector<V> values)
+      : valueStorage(std::move(values)), axis(x0, dx, valueStorage.size()), values(valueStorage.data()) { }
+
+  /**
+   * Constructs a lookup table on a given grid, referencing the grid points and values.
+   *
+   * @param x - grid points, strictly increasing
+   * @param values - values at the grid points
+   */
+  Lut1D(std::span<const double> x, std::span<const V> values) : axis(x), values(values.data()) {
+    if (values.size() != x.size()) throw Fault("lookup table needs a value for each grid point");
+  }
+
+  /**
+   * Constructs a lookup table on a given grid, copying the grid points and values.
+   */
+  Lut1D(std::vector<double> x, std::vector<V> values)
+      : gridStorage(std::move(x)), valueStorage(std::move(values)), axis(gridStorage), values(valueStorage.data()) {
+    if (valueStorage.size() != gridStorage.size()) throw Fault("lookup table needs a value for each grid point");
+  }
+
+  /**
+   * Constructs a lookup table from two tables of a table file, referencing them.
+   *
+   * @param table - table file
+   * @param x - name of the table with the grid points
+   * @param values - name of the table with the values
+   */
+  Lut1D(const config::MappedTable& table, std::string_view x, std::string_view values)
+      : Lut1D(table.get<double>(x), table.get<V>(values)) { }
+
+  /**
+   * Disabling use of copy constructor because the block should never be copied unintentionally.
+   */
+  Lut1D(const Lut1D& s) = delete;
+
+  /**
+   * Runs the lookup.
+   */
+  void run() override {
+    const Signal<T>& sig = this->readSignal(this->in);
+    const V* u = math::ValueShape<T>::data(sig.getValueRef());
+    T y;
+    V* r = math::ValueShape<T>::data(y);
+    for (unsigned int c = 0; c < C; c++) {
+      uint32_t& i = segment[c];
+      V f = static_cast<V>(axis.locate(u[c], i));
+      r[c] = values[i] + f * (values[i + 1] - values[i]);
+    }
+    this->out.getSignal().set(y, sig.getTimestamp());
+  }
+
+  /**
+   * @return grid of the table
+   */
+  const LutAxis& getAxis() const {
+    return axis;
+  }
+
+ private:
+  std::vector<double> gridStorage;
+  std::vector<V> valueStorage;
+  LutAxis axis;
+  const V* values;
+  uint32_t segment[C] = {};
+};
+
+}
+}
+
+#endif /* ORG_EEROS_CONTROL_LUT1D_HPP_ */
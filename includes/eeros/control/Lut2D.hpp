@@ -0,0 +1,128 @@
+#ifndef ORG_EEROS_CONTROL_LUT2D_HPP_
+#define ORG_EEROS_CONTROL_LUT2D_HPP_
+
+#include <eeros/config/MappedTable.hpp>
+#include <eeros/control/Blockio.hpp>
+#include <eeros/control/LutAxis.hpp>
+#include <eeros/core/Fault.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace eeros {
+namespace control {
+
+/**
+ * A two dimensional lookup table, e.g. for a thermal compensation grid. Input 0
+ * is looked up on the x axis and input 1 on the y axis, the output is bilinearly
+ * interpolated between the four surrounding grid values. See LutAxis for the
+ * grids and inputs outside of them. If the signals are matrices, each pair of
+ * elements is looked up in the same table.
+ *
+ * The values are stored in row major order, the value at grid point (i, j) is
+ * values[i * ny + j], where ny is the number of grid points of the y axis.
+ * The values and grid points can be copied into the block or referenced, e.g.
+ * when they are tables of a MappedTable, which must then outlive the block.
+ *
+ * @tparam T - input and output signal data type, a floating point type or a matrix of it (double - default type)
+ *
+ * @since v1.4.4
+ */
+template < typename T = double >
+class Lut2D : public Blockio<2,1,T> {
+  using V = typename math::ValueShape<T>::value_type;
+  static constexpr unsigned int C = math::ValueShape<T>::size;
+  static_assert(std::is_floating_point_v<V>, "Lut2D needs floating point values or a matrix of them");
+
+ public:
+  /**
+   * Constructs a lookup table on given grids, referencing the grids and values.
+   *
+   * @param x - axis of input 0
+   * @param y - axis of input 1
+   * @param values - values at the grid points in row major order
+   */
+  Lut2D(LutAxis x, LutAxis y, std::span<const V> values) : xAxis(x), yAxis(y), values(values.data()) {
+    check(values.size());
+  }
+
+  /**
+   * Constructs a lookup table on given grids, copying the values. A grid
+   * constructed from points references them.
+   */
+  Lut2D(LutAxis x, LutAxis y, std::vector<V> values)
+      : valueStorage(std::move(values)), xAxis(x), yAxis(y), values(valueStorage.data()) {
+    check(valueStorage.size());
+  }
+
+  /**
+   * Constructs a lookup table from three tables of a table file, referencing them.
+   *
+   * @param table - table file
+   * @param x - name of the table with the grid points of input 0
+   * @param y - name of the table with the grid points of input 1
+   * @param values - name of the table with the values
+   */
+  Lut2D(const config::MappedTable& table, std::string_view x, std::string_view y, std::string_view values)
+      : Lut2D(LutAxis(table.get<double>(x)), LutAxis(table.get<double>(y)), table.get<V>(values)) { }
+
+  /**
+   * Disabling use of copy constructor because the block should never be copied unintentionally.
+   */
+  Lut2D(const Lut2D& s) = delete;
+
+  /**
+   * Runs the lookup.
+   */
+  void run() override {
+    const Signal<T>& sx = this->readSignal(this->in[0]);
+    const Signal<T>& sy = this->readSignal(this->in[1]);
+    const V* u = math::ValueShape<T>::data(sx.getValueRef());
+    const V* v = math::ValueShape<T>::data(sy.getValueRef());
+    T z;
+    V* r = math::ValueShape<T>::data(z);
+    for (unsigned int c = 0; c < C; c++) {
+      uint32_t& i = xSegment[c];
+      uint32_t& j = ySegment[c];
+      V fx = static_cast<V>(xAxis.locate(u[c], i));
+      V fy = static_cast<V>(yAxis.locate(v[c], j));
+      const V* p = values + i * stride + j;
+      V a = p[0] + fy * (p[1] - p[0]);
+      V b = p[stride] + fy * (p[stride + 1] - p[stride]);
+      r[c] = a + fx * (b - a);
+    }
+    this->out.getSignal().set(z, sx.getTimestamp());
+  }
+
+  /**
+   * @return grid of input 0
+   */
+  const LutAxis& getXAxis() const {
+    return xAxis;
+  }
+
+  /**
+   * @return grid of input 1
+   */
+  const LutAxis& getYAxis() const {
+    return yAxis;
+  }
+
+ private:
+  void check(std::size_t size) {
+    if (size != std::size_t(xAxis.size()) * yAxis.size()) throw Fault("lookup table needs a value for each grid point");
+  }
+
+  std::vector<V> valueStorage;
+  LutAxis xAxis, yAxis;
+  const V* values;
+  const std::size_t stride = yAxis.size();
+  uint32_t xSegment[C] = {}, ySegment[C] = {};
+};
+
+}
+}
+
+#endif /* ORG_EEROS_CONTROL_LUT2D_HPP_ */
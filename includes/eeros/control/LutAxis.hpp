@@ -0,0 +1,106 @@
+#ifndef ORG_EEROS_CONTROL_LUTAXIS_HPP_
+#define ORG_EEROS_CONTROL_LUTAXIS_HPP_
+
+#include <eeros/core/Fault.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+namespace eeros {
+namespace control {
+
+/**
+ * Grid points of one axis of a lookup table, see Lut1D and Lut2D.
+ *
+ * On a uniform grid, the segment of an input is computed with one multiplication.
+ * On a non uniform grid, the segment of the last lookup is checked first, then its
+ * neighbours, and only then the grid is searched. Signals mostly change little
+ * from one run to the next, so a lookup costs a few comparisons. A non uniform
+ * grid with equal spacing is treated as a uniform one.
+ *
+ * Inputs outside of the grid are clamped to its first or last point.
+ *
+ * @since v1.4.4
+ */
+class LutAxis {
+ public:
+  /**
+   * Constructs a uniform grid.
+   *
+   * @param x0 - first grid point
+   * @param dx - distance between two grid points
+   * @param n - number of grid points, at least 2
+   */
+  LutAxis(double x0, double dx, std::size_t n) : x0(x0), invDx(1 / dx), n(n), x(nullptr) {
+    if (n < 2 || n > std::numeric_limits<uint32_t>::max()) throw Fault("lookup table needs at least 2 grid points");
+    if (!(dx > 0) || !std::isfinite(dx)) throw Fault("grid spacing of lookup table must be positive");
+  }
+
+  /**
+   * Constructs a grid of given points. The points are referenced, not copied.
+   *
+   * @param x - grid points, strictly increasing
+   */
+  LutAxis(std::span<const double> x) : LutAxis(0, 1, x.size()) {
+    for (std::size_t i = 1; i < n; i++) {
+      if (!(x[i] > x[i - 1])) throw Fault("grid points of lookup table must be strictly increasing");
+    }
+    double dx = (x[n - 1] - x[0]) / (n - 1);
+    bool uniform = true;
+    for (std::size_t i = 1; i < n && uniform; i++) {
+      uniform = std::abs(x[i] - (x[0] + i * dx)) <= 1e-12 * (x[n - 1] - x[0]);
+    }
+    x0 = x[0];
+    invDx = 1 / dx;
+    if (!uniform) this->x = x.data();
+  }
+
+  /**
+   * @return number of grid points
+   */
+  uint32_t size() const { return n; }
+
+  /**
+   * @return true if the grid is uniform
+   */
+  bool isUniform() const { return x == nullptr; }
+
+  /**
+   * Finds the segment of an input and the position of the input in it.
+   *
+   * @param u - input
+   * @param i - segment i between grid points i and i+1, on input a guess, e.g. the last segment found
+   * @return position in the segment, between 0 and 1, NaN if u is NaN
+   */
+  double locate(double u, uint32_t& i) const {
+    if (std::isnan(u)) return u;
+    if (x == nullptr) {
+      double s = (u - x0) * invDx;
+      if (!(s > 0)) { i = 0; return 0; }
+      if (!(s < n - 1)) { i = n - 2; return 1; }
+      i = static_cast<uint32_t>(s);
+      return s - i;
+    }
+    if (!(u > x[0])) { i = 0; return 0; }
+    if (!(u < x[n - 1])) { i = n - 2; return 1; }
+    if (i > n - 2) i = 0;
+    if (!(x[i] <= u && u < x[i + 1])) {
+      if (i + 2 < n && x[i + 1] <= u && u < x[i + 2]) i++;
+      else if (i > 0 && x[i - 1] <= u && u < x[i]) i--;
+      else i = static_cast<uint32_t>(std::upper_bound(x, x + n, u) - x) - 1;
+    }
+    return (u - x[i]) / (x[i + 1] - x[i]);
+  }
+
+ private:
+  double x0, invDx;
+  uint32_t n;
+  const double* x;  // grid points of a non uniform grid, nullptr if uniform
+};
+
+}
+}
+
+#endif /* ORG_EEROS_CONTROL_LUTAXIS_HPP_ */
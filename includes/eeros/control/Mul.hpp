@@ -1,6 +1,7 @@
 #ifndef ORG_EEROS_CONTROL_MUL_HPP_
 #define ORG_EEROS_CONTROL_MUL_HPP_
 
+#include <algorithm>
 #include <eeros/control/Blockio.hpp>
 #include <eeros/control/Input.hpp>
 
@@ -23,10 +24,11 @@ class Mul : public Blockio<0,1,OutT,OutT,SIUnit::generateNSizeArray<0>(),MakeUni
   Mul() : in1(this), in2(this) { }
 
   virtual void run() {
+    const Signal<In1T>& s1 = this->readSignal(in1);
+    const Signal<In2T>& s2 = this->readSignal(in2);
     OutT prod;
-    prod = in1.getSignal().getValue() * in2.getSignal().getValue();
-    this->out.getSignal().setValue(prod);
-    this->out.getSignal().setTimestamp(in1.getSignal().getTimestamp());
+    prod = s1.getValueRef() * s2.getValueRef();
+    this->out.getSignal().set(prod, std::min(s1.getTimestamp(), s2.getTimestamp()));
   }
 
   virtual Input<In1T, Uin[0]>& getIn1() {
@@ -37,6 +39,39 @@ class Mul : public Blockio<0,1,OutT,OutT,SIUnit::generateNSizeArray<0>(),MakeUni
     return in2;
   }
 
+  std::vector<Block*> getInputBlocks() override {
+    std::vector<Block*> blocks;
+    if (in1.getConnectedBlock() != nullptr) blocks.push_back(in1.getConnectedBlock());
+    if (in2.getConnectedBlock() != nullptr) blocks.push_back(in2.getConnectedBlock());
+    return blocks;
+  }
+
+  bool areInputsConnected() const override {
+    return in1.isConnected() && in2.isConnected();
+  }
+
+  /**
+   * Returns the signals of the connected inputs.
+   *
+   * @return input signals
+   */
+  std::vector<const SignalInterface*> getInputSignals() override {
+    std::vector<const SignalInterface*> signals;
+    if (in1.isConnected()) signals.push_back(&in1.getSignal());
+    if (in2.isConnected()) signals.push_back(&in2.getSignal());
+    return signals;
+  }
+
+  /**
+   * The product can be skipped while its inputs do not change.
+   *
+   * @return true
+   * @see TimeDomain::setChangePropagation()
+   */
+  bool isSkippable() const override {
+    return true;
+  }
+
  protected:
   Input<In1T, Uin[0]> in1;
   Input<In2T, Uin[1]> in2;
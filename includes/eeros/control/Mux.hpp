@@ -1,6 +1,7 @@
 #ifndef ORG_EEROS_CONTROL_MUX_HPP_
 #define ORG_EEROS_CONTROL_MUX_HPP_
 
+#include <algorithm>
 #include <eeros/control/Blockio.hpp>
 #include <eeros/math/Matrix.hpp>
 #include <eeros/control/Input.hpp>
@@ -40,11 +41,23 @@ class Mux: public Blockio<N,1,T,C,Uin,MakeUnitArray<Uout>::value> {
    */
   void run() override {
     C newValue;
+    timestamp_t oldest = this->readSignal(this->in[0]).getTimestamp();
     for (uint32_t i = 0; i < N; i++) {
-      newValue(i) = this->in[i].getSignal().getValue();
+      const auto& s = this->readSignal(this->in[i]);
+      newValue(i) = s.getValueRef();
+      oldest = std::min(oldest, s.getTimestamp());
     }
-    this->out.getSignal().setValue(newValue);
-    this->out.getSignal().setTimestamp(this->in[0].getSignal().getTimestamp());
+    this->out.getSignal().set(newValue, oldest);
+  }
+
+  /**
+   * The multiplexer can be skipped while its inputs do not change.
+   *
+   * @return true
+   * @see TimeDomain::setChangePropagation()
+   */
+  bool isSkippable() const override {
+    return true;
   }
 
 };
@@ -51,6 +51,26 @@ class Output {
     owner = block;
   }
 
+  /**
+   * Returns the output the signal of this output comes from. This is the
+   * output itself, unless it only forwards the signal of another output.
+   *
+   * @return source of the signal
+   * @see InputSub
+   */
+  virtual Output* getSource() {
+    return this;
+  }
+
+  /**
+   * Returns the block which owns this output.
+   * 
+   * @return owner of this output, nullptr if not set
+   */
+  virtual Block* getOwner() const {
+    return owner;
+  }
+
  private:
   Signal<T> signal;
   Block* owner;
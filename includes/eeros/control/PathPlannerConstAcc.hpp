@@ -2,6 +2,7 @@
 #define ORG_EEROS_CONTROL_PATHPLANNERCONSTACC_HPP_
 
 #include <eeros/control/Output.hpp>
+#include <eeros/control/SegmentTrajectory.hpp>
 #include <eeros/control/TrajectoryGenerator.hpp>
 #include <eeros/core/System.hpp>
 #include <cmath>
@@ -44,7 +45,7 @@ class PathPlannerConstAcc : public TrajectoryGenerator<T, 3> {
    * @param dt - sampling time
    */
   PathPlannerConstAcc(T velMax, T acc, T dec, double dt) 
-      : finished(true), velMax(velMax), acc(acc), dec(dec), dt(dt) { 
+      : velMax(velMax), acc(acc), dec(dec), dt(dt), trajectory(dt) { 
     posOut.getSignal().clear();
     velOut.getSignal().clear();
     accOut.getSignal().clear();
@@ -61,69 +62,18 @@ class PathPlannerConstAcc : public TrajectoryGenerator<T, 3> {
    * @return - end of trajectory is reached
    */
   virtual bool endReached() {
-    std::lock_guard<std::mutex> lck(mtx);
-    return finished;
+    return trajectory.completed();
   }
   
   /**
-   * Runs the path planner block. With the precalculated values for the 
-   * acceleration for all sampling points on the trajectory, the resulting velocities
-   * and positions are calculated and written to the appropriate outputs.
+   * Runs the path planner block. The outputs are evaluated from the polynome
+   * coefficients of the current segment, which were precalculated by move(),
+   * with one Horner step for all elements. A new trajectory is taken over at
+   * the boundary of a segment, run() never waits for the thread calling move().
    */
   virtual void run() {
-    std::lock_guard<std::mutex> lck(mtx);
-    std::array<T, 3> y = this->last;
-    t += dt;
-    
-    if (!finished) {
-      for (unsigned int i = 0; i < a1p.size(); i++) {
-        switch (range) {
-          case 1:
-            if (t <= dT1) {
-              y[0][i] = a1p[i] * pow(t, 2) + c1p[i];
-              y[1][i] = b1v[i] * t;
-              y[2][i] = c1a[i];
-            } 
-            if (fabs(t - dT1) < 1e-12 && i == a1p.size() - 1) {
-              range = 2;
-              t = 0;
-            }
-            break;
-          case 2:
-            if (t <= dT2) {
-              y[0][i] = b2p[i] * t + c2p[i];
-              y[1][i] = c2v[i];
-              y[2][i] = c2a[i];
-            }
-            if (dT2 < 1e-12 || (fabs(t - dT2) < 1e-12 && i == a1p.size() - 1)) {
-              range = 3;
-              t = 0;
-            }
-            break;
-          case 3:
-            if (t <= dT3) {
-              y[0][i] = a3p[i] * pow(t, 2) + b3p[i] * t + c3p[i];
-              y[1][i] = b3v[i] * t + c3v[i];
-              y[2][i] = c3a[i];
-            }
-            if (fabs(t - dT3) < 1e-12 && i == a1p.size() - 1) {
-              range = 4;
-              t = 0;
-            }
-            break;
-          case 4:
-            finished = true;
-            y[0][i] = endPos[i];
-            y[1][i] = 0.0;
-            y[2][i] = 0.0;
-            break;
-        }
-        // keep last position value
-        this->last[0][i] = y[0][i];
-        this->last[1][i] = y[1][i];
-        this->last[2][i] = y[2][i];
-      }
-    }
+    trajectory.next(this->last);
+    const std::array<T, 3>& y = this->last;
 
     posOut.getSignal().setValue(y[0]);
     velOut.getSignal().setValue(y[1]);
@@ -152,11 +102,11 @@ class PathPlannerConstAcc : public TrajectoryGenerator<T, 3> {
    * @see run()
    */
   virtual bool move(std::array<T, 3> start, std::array<T, 3> end) {
-    if (!finished) return false;
+    std::lock_guard<std::mutex> lck(trajectory.mutex());
+    if (!trajectory.completed()) return false;
     T calcVelNorm, calcAccNorm, calcDecNorm;
     E velNorm, accNorm, decNorm;
     T distance = end[0] - start[0];
-    endPos = end[0];
     
     T zero; zero = 0;
     if (distance == zero) return false;
@@ -196,28 +146,22 @@ class PathPlannerConstAcc : public TrajectoryGenerator<T, 3> {
     velNorm = 1 / ((dT2 + (dT1 + dT3) / 2));
 //     log.info() << "vel norm = " << velNorm;
     
+    // position polynome of each segment in its local time, the derivatives follow from it
     T vel = velNorm * distance;
-    c1a = vel / dT1;
-    b1v = c1a;
-    a1p = 0.5 * c1a;
-    c1p = start[0];
-     
-    c2a = 0; 
-    c2v = vel;
-    b2p = c2v;
-    c2p = a1p * pow(dT1,2) + c1p;
-    
-    c3a = -vel / dT3;
-    b3v = c3a;  
-    c3v = vel; 
-    a3p = 0.5 * c3a;
-    b3p = c3v;
-    c3p = b2p * dT2 + c2p;
+    T a1 = vel / dT1;
+    T a3 = -vel / dT3;
+    T p0 = start[0];
+    T p2 = a1 / 2 * pow(dT1,2) + p0;
+    T p3 = vel * dT2 + p2;
     
-    std::lock_guard<std::mutex> lck(mtx);
-    finished = false;
-    range = 1;
-    t = 0;  
+    auto& p = trajectory.prepare();
+    trajectory.setSegment(p, dT1, {p0, zero, a1 / 2});
+    trajectory.setSegment(p, dT2, {p2, vel});
+    trajectory.setSegment(p, dT3, {p3, vel, a3 / 2});
+    p.endPos = end[0];
+    trajectory.publish(p);
+    for (auto& e : this->target) e = 0;
+    this->target[0] = end[0];
     return true;
   }
   
@@ -229,9 +173,9 @@ class PathPlannerConstAcc : public TrajectoryGenerator<T, 3> {
    * @param start - array containing start position and its higher derivatives
    */
   virtual void setStart(std::array<T, 3> start) {
-    std::lock_guard<std::mutex> lck(mtx);
-    this->last = start;
-    this->finished = true;
+    std::lock_guard<std::mutex> lck(trajectory.mutex());
+    trajectory.publishHold(start);
+    this->target = start;
   }
   
   /**
@@ -278,18 +222,9 @@ class PathPlannerConstAcc : public TrajectoryGenerator<T, 3> {
   
  private:
   Output<T> posOut, velOut, accOut;
-  bool finished;
-  int range;
   T velMax, acc, dec;
-  double t, dt, dT1, dT2, dT3;
-  // naming of coefficients: a|b|c & 1|2|3 & a|v|p
-  // a|b|c : a for t*t factor, b for linear factor, c for constant
-  // 1|2|3 : one of the three parts on the time axis
-  // a|v|p : result will be a for acc, v for vel, p for position
-  // e.g. a1p -> coeffizient for time intervall 1, used to multiply with t^2 resulting in the position
-  T a1p, c1p, b1v, c1a, b2p, c2p, c2v, c2a, a3p, b3p, c3p, b3v, c3v, c3a; 
-  T endPos;
-  std::mutex mtx;
+  double dt, dT1, dT2, dT3;
+  SegmentTrajectory<T, 3, 3> trajectory;
 };
 
 /**
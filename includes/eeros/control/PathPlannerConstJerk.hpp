@@ -2,6 +2,7 @@
 #define ORG_EEROS_CONTROL_PATHPLANNERCONSTJERK_HPP_
 
 #include <eeros/control/Output.hpp>
+#include <eeros/control/SegmentTrajectory.hpp>
 #include <eeros/control/TrajectoryGenerator.hpp>
 #include <eeros/core/System.hpp>
 #include <cmath>
@@ -45,7 +46,7 @@ class PathPlannerConstJerk : public TrajectoryGenerator<T, 4> {
    * @param dt - sampling time
    */
   PathPlannerConstJerk(T velMax, T jerk, double dt) 
-      : finished(true), velMax(velMax), jerk(jerk), dt(dt) {
+      : velMax(velMax), jerk(jerk), dt(dt), trajectory(dt) {
     posOut.getSignal().clear();
     velOut.getSignal().clear();
     accOut.getSignal().clear();
@@ -63,98 +64,18 @@ class PathPlannerConstJerk : public TrajectoryGenerator<T, 4> {
    * @return - end of trajectory is reached
    */
   virtual bool endReached() {
-    std::lock_guard<std::mutex> lck(mtx);
-    return finished;
+    return trajectory.completed();
   }
   
   /**
-   * Runs the path planner block. With the precalculated values for the 
-   * acceleration for all sampling points on the trajectory, the resulting velocities
-   * and positions are calculated and written to the appropriate outputs.
+   * Runs the path planner block. The outputs are evaluated from the polynome
+   * coefficients of the current segment, which were precalculated by move(),
+   * with one Horner step for all elements. A new trajectory is taken over at
+   * the boundary of a segment, run() never waits for the thread calling move().
    */
   virtual void run() {
-    std::lock_guard<std::mutex> lck(mtx);
-    std::array<T, 4> y = this->last;
-    t += dt;
-    
-    if (!finished) {
-      for (unsigned int i = 0; i < a1p.size(); i++) {
-        switch (range) {
-          case 1:
-            if (t <= dT1) {
-              y[0][i] = a1p[i] * pow(t,3) + d1p[i];
-              y[1][i] = b1v[i] * pow(t,2);
-              y[2][i] = c1a[i] * t;
-              y[3][i] = d1j[i];
-            } 
-            if (fabs(t - dT1) < 1e-12 && i == a1p.size() - 1) {
-              range = 2;
-              t = 0;
-            }
-            break;
-          case 2:
-            if (t <= dT1) {
-              y[0][i] = a2p[i] * pow(t,3) + b2p[i] * pow(t,2) + c2p[i] * t + d2p[i];
-              y[1][i] = b2v[i] * pow(t,2) + c2v[i] * t + d2v[i];
-              y[2][i] = c2a[i] * t + d2a[i];
-              y[3][i] = d2j[i];
-            }
-            if (fabs(t - dT1) < 1e-12 && i == a1p.size() - 1) {
-              range = 3;
-              t = 0;
-            }
-            break;
-          case 3:
-            if (t <= dT2) {
-              y[0][i] = c3p[i] * t + d3p[i];
-              y[1][i] = d3v[i];
-              y[2][i] = 0;
-              y[3][i] = 0;
-            }
-            if (fabs(t - dT2) < 1e-12 && i == a1p.size() - 1) {
-              range = 4;
-              t = 0;
-            }
-            break;
-          case 4:
-            if (t <= dT1) {
-              y[0][i] = a4p[i] * pow(t,3) + c4p[i] * t + d4p[i];
-              y[1][i] = b4v[i] * pow(t,2) + d4v[i];
-              y[2][i] = c4a[i] * t;
-              y[3][i] = d4j[i];
-            } 
-            if (fabs(t - dT1) < 1e-12 && i == a1p.size() - 1) {
-              range = 5;
-              t = 0;
-            }
-            break;
-          case 5:
-            if (t <= dT1) {
-              y[0][i] = a5p[i] * pow(t,3) + b5p[i] * pow(t,2) + c5p[i] * t + d5p[i];
-              y[1][i] = b5v[i] * pow(t,2) + c5v[i] * t + d5v[i];
-              y[2][i] = c5a[i] * t + d5a[i];
-              y[3][i] = d5j[i];
-            }
-            if (fabs(t - dT1) < 1e-12 && i == a1p.size() - 1) {
-              range = 6;
-              t = 0;
-            }
-            break;
-          case 6:
-            finished = true;
-            y[0][i] = endPos[i];
-            y[1][i] = 0.0;
-            y[2][i] = 0.0;
-            y[3][i] = 0.0;
-            break;
-        }
-        // keep last position value
-        this->last[0][i] = y[0][i];
-        this->last[1][i] = y[1][i];
-        this->last[2][i] = y[2][i];
-        this->last[3][i] = y[3][i];
-      }
-    }
+    trajectory.next(this->last);
+    const std::array<T, 4>& y = this->last;
 
     posOut.getSignal().setValue(y[0]);
     velOut.getSignal().setValue(y[1]);
@@ -185,11 +106,11 @@ class PathPlannerConstJerk : public TrajectoryGenerator<T, 4> {
    * @see run()
    */
   virtual bool move(std::array<T, 4> start, std::array<T, 4> end) {
-    if (!finished) return false;
+    std::lock_guard<std::mutex> lck(trajectory.mutex());
+    if (!trajectory.completed()) return false;
     T calcVelNorm, calcJerkNorm;
     E velNorm, jerkNorm;
     T distance = end[0] - start[0];
-    endPos = end[0];
    
     T zero; zero = 0;
     if (distance == zero) return false;
@@ -224,50 +145,25 @@ class PathPlannerConstJerk : public TrajectoryGenerator<T, 4> {
     // recalculate velocity with definitive time interval values
     velNorm = 1 / (dT2 + 4 * dT1 * 0.5);
     
-    d1j = velNorm * distance / pow(dT1,2);
-    c1a = d1j;
-    b1v = d1j / 2;
-    a1p = d1j / 6;
-    d1p = start[0];
-
-    d2j = -d1j;
-    c2a = -d1j;
-    d2a = d1j * dT1;
-    b2v = -d1j / 2;
-    c2v = d1j * dT1;
-    d2v = d1j / 2 * pow(dT1,2);
-    a2p = -d1j / 6;
-    b2p = d1j / 2 * dT1;
-    c2p = d1j / 2 * pow(dT1,2);
-    d2p = d1j / 6 * pow(dT1,3) + d1p;
-
-    d3v = d1j * pow(dT1,2);
-    c3p = d1j * pow(dT1,2);
-    d3p = d1j * pow(dT1,3) + d1p;
-      
-    d4j = -d1j;
-    c4a = -d1j;
-    b4v = -d1j / 2;
-    d4v = d1j * pow(dT1,2);
-    a4p = -d1j / 6;
-    c4p = d1j * pow(dT1,2);
-    d4p = d1j * (pow(dT1,2) * dT2 + pow(dT1,3)) + d1p;
-    
-    d5j = d1j;
-    c5a = d1j;
-    d5a = -d1j * dT1;
-    b5v = d1j / 2;
-    c5v = -d1j * dT1;
-    d5v = d1j / 2 * pow(dT1,2);
-    a5p = d1j / 6;
-    b5p = -d1j / 2 * dT1;
-    c5p = d1j / 2 * pow(dT1,2);
-    d5p = d1j * (pow(dT1,2) * dT2 + 11.0 / 6 * pow(dT1,3)) + d1p;
+    // position polynome of each segment in its local time, the derivatives follow from it
+    T d1j = velNorm * distance / pow(dT1,2);
+    T p0 = start[0];
+    T p2 = p0 + d1j / 6 * pow(dT1,3);
+    T p3 = p0 + d1j * pow(dT1,3);
+    T p4 = p0 + d1j * (pow(dT1,2) * dT2 + pow(dT1,3));
+    T p5 = p0 + d1j * (pow(dT1,2) * dT2 + 11.0 / 6 * pow(dT1,3));
+    T v = d1j * pow(dT1,2);
     
-    std::lock_guard<std::mutex> lck(mtx);
-    finished = false;
-    range = 1;
-    t = 0;  
+    auto& p = trajectory.prepare();
+    trajectory.setSegment(p, dT1, {p0, zero, zero, d1j / 6});
+    trajectory.setSegment(p, dT1, {p2, v / 2, d1j / 2 * dT1, -d1j / 6});
+    trajectory.setSegment(p, dT2, {p3, v});
+    trajectory.setSegment(p, dT1, {p4, v, zero, -d1j / 6});
+    trajectory.setSegment(p, dT1, {p5, v / 2, -d1j / 2 * dT1, d1j / 6});
+    p.endPos = end[0];
+    trajectory.publish(p);
+    for (auto& e : this->target) e = 0;
+    this->target[0] = end[0];
     return true;
   }
   
@@ -279,9 +175,9 @@ class PathPlannerConstJerk : public TrajectoryGenerator<T, 4> {
    * @param start - array containing start position and its higher derivatives
    */
   virtual void setStart(std::array<T, 4> start) {
-    std::lock_guard<std::mutex> lck(mtx);
-    this->last = start;
-    this->finished = true;
+    std::lock_guard<std::mutex> lck(trajectory.mutex());
+    trajectory.publishHold(start);
+    this->target = start;
   }
   
   /**
@@ -328,22 +224,9 @@ class PathPlannerConstJerk : public TrajectoryGenerator<T, 4> {
 
  private:
   Output<T> posOut, velOut, accOut, jerkOut;
-  bool finished;
-  int range;
   T velMax, jerk;
-  double t, dt, dT1, dT2;
-  // naming of coefficients: a|b|c & 1|2|3 & a|v|p
-  // a|b|c|d : a for jerk, b for acc, c for vel, d for position
-  // 1|2|3|4|5 : one of the three parts on the time axis
-  // j|a|v|p : j for jerk, a for acc, v for vel, p for position
-  // e.g. a1p -> coeffizient for time intervall 1, used to multiply with t^2 resulting in the position
-  T a1p, d1p, b1v, c1a, d1j, 
-    a2p, b2p, c2p, d2p, b2v, c2v, d2v, c2a, d2a, d2j, 
-    c3p, d3p, d3v,
-    a4p, c4p, d4p, b4v, d4v, c4a, d4j,
-    a5p, b5p, c5p, d5p, b5v, c5v, d5v, c5a, d5a, d5j; 
-  T endPos;
-  std::mutex mtx;
+  double dt, dT1, dT2;
+  SegmentTrajectory<T, 4, 5> trajectory;
 };
 
 /**
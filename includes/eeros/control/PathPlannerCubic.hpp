@@ -5,15 +5,49 @@
 #include <eeros/control/Output.hpp>
 #include <eeros/math/Matrix.hpp>
 #include <eeros/core/System.hpp>
+#include <eeros/core/Fault.hpp>
 #include <iostream>
 #include <fstream>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #include <mutex>
 #include <atomic>
+#include <vector>
 
 namespace eeros {
 namespace control {
-  
+
+/**
+ * One interval of a cubic trajectory: its duration, the jerk within the interval
+ * and the acceleration, velocity and position at its beginning.
+ *
+ * @since v1.4.4
+ */
+struct PathPlannerCubicSegment {
+  double time, jerk, acc, vel, pos;
+};
+
+/**
+ * Header of a binary trajectory file, see PathPlannerCubic::save(). It is followed
+ * by nofSegments segments (PathPlannerCubicSegment). The total time and the position
+ * of the last segment are precomputed, so the trajectory can be scaled without
+ * reading it first. All values are stored in the byte order of the machine that
+ * wrote the file.
+ *
+ * @since v1.4.4
+ */
+struct PathPlannerCubicHeader {
+  char magic[4];        // "EECS"
+  uint32_t version;     // format version, 1
+  uint64_t nofSegments; // number of segments
+  double totalTime;     // sum of the durations of all segments
+  double lastPos;       // position at the beginning of the last segment
+};
+
 /**
  * This path planner takes precalculated cubic splines from a file and outputs the
  * resulting values for jerk, acceleration, velocity and position onto its outputs.
@@ -23,6 +57,11 @@ namespace control {
  * from the last interval.
  * The trajectory may be scaled in time and jerk in order to achieve a positional change
  * within a given time interval.
+ *
+ * Besides the text format, init() also accepts binary trajectory files written with
+ * save(). Such a file is memory mapped instead of parsed. Its segments are read and
+ * scaled one at a time while the trajectory runs, so a large trajectory starts
+ * immediately and does not have to fit into memory.
  * 
  * @since v1.0
  */
@@ -41,6 +80,13 @@ class PathPlannerCubic: public Block {
     jerkOut.getSignal().clear();
     prevPos = 0; prevVel = 0; prevAcc = 0;
   }
+
+  /**
+   * Destructor unmaps a binary trajectory file.
+   */
+  ~PathPlannerCubic() override {
+    unmap();
+  }
   
   /**
    * Disabling use of copy constructor because the block should never be copied unintentionally.
@@ -48,7 +94,8 @@ class PathPlannerCubic: public Block {
   PathPlannerCubic(const PathPlannerCubic& s) = delete; 
 
   /**
-   * Choose a file which holds a trajectory. 
+   * Choose a file which holds a trajectory. The file is either a text file with
+   * one interval per line or a binary file written with save().
    * 
    * @param filename - name of the trajectory file
    */
@@ -56,6 +103,15 @@ class PathPlannerCubic: public Block {
     std::ifstream file;       
     file.open(filename.c_str());   
     if (!file.is_open()) throw Fault("File for loading trajectory cannot be opened");
+    char magic[4] = {};
+    file.read(magic, sizeof(magic));
+    if (file.gcount() == sizeof(magic) && std::memcmp(magic, "EECS", 4) == 0) {
+      file.close();
+      map(filename);
+      return;
+    }
+    file.clear();
+    file.seekg(0);
     clear();
     while(!file.eof()) {
       std::string tmp_string;
@@ -88,6 +144,31 @@ class PathPlannerCubic: public Block {
       posCoeffRaw.push_back(tmp_double);
     }
   }
+
+  /**
+   * Writes the trajectory chosen with init() to a binary file, which can be
+   * loaded with init() much faster than a text file.
+   *
+   * @param filename - name of the binary trajectory file, an existing file is overwritten
+   */
+  virtual void save(std::string filename) {
+    std::size_t n = mapped ? nofSegments : timeCoeffRaw.size();
+    if (n == 0) throw Fault("Path planner: no trajectory to save");
+    std::ofstream file(filename.c_str(), std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) throw Fault("File for saving trajectory cannot be opened");
+    PathPlannerCubicHeader header{};
+    std::memcpy(header.magic, "EECS", 4);
+    header.version = 1;
+    header.nofSegments = n;
+    header.lastPos = rawSegment(n - 1).pos;
+    for (std::size_t i = 0; i < n; i++) header.totalTime += rawSegment(i).time;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (std::size_t i = 0; i < n; i++) {
+      PathPlannerCubicSegment seg = rawSegment(i);
+      file.write(reinterpret_cast<const char*>(&seg), sizeof(seg));
+    }
+    if (!file) throw Fault("Path planner: writing trajectory file failed");
+  }
   
   /**
    * Runs the path planner block.
@@ -96,26 +177,35 @@ class PathPlannerCubic: public Block {
     double pos, vel, acc, jerk;
     
     std::lock_guard<std::mutex> guard(m);
-    if (!finished && timeCoeff.size() > 0 && index < timeCoeff.size()) {
+    std::size_t size = mapped ? nofSegments : timeCoeff.size();
+    if (!finished && size > 0 && index < size) {
       if (t <= interval + (dt / 2)) {
-        jerk = jerkCoeff[index];
+        jerk = mapped ? current.jerk : jerkCoeff[index];
         acc = prevAcc + jerk * dt;
         vel = prevVel + prevAcc * dt + jerk / 2 * dt * dt;
         pos = prevPos + prevVel * dt + prevAcc / 2 * dt * dt + jerk / 6 * dt * dt * dt;
       } else {
-        if (first) {index = 0; interval = timeCoeff[index]; first = false;}
+        if (first) {index = 0; if (mapped) nextSegment(); interval = (mapped ? current.time : timeCoeff[index]); first = false;}
         else {
           index++;
-          if (index == timeCoeff.size()) {
+          if (index == size) {
             finished = true;
             return;
           }
-          interval += timeCoeff[index];
+          if (mapped) nextSegment();
+          interval += (mapped ? current.time : timeCoeff[index]);
+        }
+        if (mapped) {
+          jerk = current.jerk;
+          acc  = current.acc;
+          vel  = current.vel;
+          pos  = current.pos;
+        } else {
+          jerk = jerkCoeff[index];
+          acc  = accCoeff[index];
+          vel  = velCoeff[index];
+          pos  = posCoeff[index];
         }
-        jerk = jerkCoeff[index];
-        acc  = accCoeff[index];
-        vel  = velCoeff[index];
-        pos  = posCoeff[index];
       }
     } else {
       t = 0;
@@ -159,6 +249,11 @@ class PathPlannerCubic: public Block {
    */
   virtual bool move(double time, double startPos, double deltaPos) {
     if (!finished) return false;
+    if (mapped) {
+      scaleMapped(time, startPos, deltaPos);
+      finished = false;
+      return true;
+    }
     if (timeCoeffRaw.size() <= 0) throw Fault("Path planner: time coeff array empty"); 
     
     scalePath(time, deltaPos); 
@@ -180,6 +275,13 @@ class PathPlannerCubic: public Block {
    */
   virtual bool move(double startPos) {
     if (!finished) return false;
+    if (mapped) {
+      std::lock_guard<std::mutex> guard(m);
+      scaled = false;
+      offset = startPos;
+      finished = false;
+      return true;
+    }
     if (timeCoeffRaw.size() <= 0) throw Fault("Path planner: time coeff array empty"); 
     timeCoeff.resize(timeCoeffRaw.size());
     jerkCoeff.resize(timeCoeffRaw.size());
@@ -241,7 +343,89 @@ class PathPlannerCubic: public Block {
   virtual Output<>& getJerkOut() {return jerkOut;}
   
  private:
+  void map(std::string filename) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) throw Fault("File for loading trajectory cannot be opened");
+    struct stat st;
+    if (::fstat(fd, &st) < 0 || static_cast<std::size_t>(st.st_size) < sizeof(PathPlannerCubicHeader)) {
+      ::close(fd);
+      throw Fault("Trajectory file " + filename + " is too short");
+    }
+    void* p = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) throw Fault("Trajectory file " + filename + " cannot be mapped");
+    auto h = static_cast<const PathPlannerCubicHeader*>(p);
+    std::size_t n = h->nofSegments;
+    std::size_t max = (st.st_size - sizeof(PathPlannerCubicHeader)) / sizeof(PathPlannerCubicSegment);
+    if (h->version != 1 || n == 0 || n > max) {
+      ::munmap(p, st.st_size);
+      throw Fault("Trajectory file " + filename + " is inconsistent");
+    }
+    // the segments are read once from start to end
+    ::madvise(p, st.st_size, MADV_SEQUENTIAL);
+    std::lock_guard<std::mutex> guard(m);
+    clear();
+    mapAddr = p;
+    mapLength = st.st_size;
+    header = h;
+    segments = reinterpret_cast<const PathPlannerCubicSegment*>(h + 1);
+    nofSegments = n;
+    mapped = true;
+  }
+
+  void unmap() {
+    if (mapAddr) ::munmap(mapAddr, mapLength);
+    mapAddr = nullptr;
+    mapLength = 0;
+    header = nullptr;
+    segments = nullptr;
+    nofSegments = 0;
+    mapped = false;
+  }
+
+  // segment as stored in the file or read from the text file
+  PathPlannerCubicSegment rawSegment(std::size_t i) const {
+    if (mapped) return segments[i];
+    return {timeCoeffRaw[i], jerkCoeffRaw[i], accCoeffRaw[i], velCoeffRaw[i], posCoeffRaw[i]};
+  }
+
+  // the scaling parameters of a mapped trajectory, same as scalePath() does for all segments
+  void scaleMapped(double time, double startPos, double deltaPos) {
+    double timeScale = time / header->totalTime;
+    // the durations are rounded to the sampling time, which changes the total time
+    double timeTotalRounded = 0.0;
+    for (std::size_t i = 0; i < nofSegments; i++) timeTotalRounded += round(segments[i].time * timeScale / dt) * dt;
+    double s = timeTotalRounded / header->totalTime;
+    std::lock_guard<std::mutex> guard(m);
+    roundScale = timeScale;
+    jerkScale = deltaPos / header->lastPos / (s * s * s);
+    offset = startPos;
+    scaled = true;
+  }
+
+  // reads segment index of a mapped trajectory into current, called for consecutive segments
+  void nextSegment() {
+    const PathPlannerCubicSegment& r = segments[index];
+    if (!scaled) {
+      current = {r.time, r.jerk, r.acc, r.vel, r.pos + offset};
+      return;
+    }
+    PathPlannerCubicSegment s;
+    s.time = round(r.time * roundScale / dt) * dt;
+    s.jerk = r.jerk * jerkScale;
+    if (index == 0) {
+      s.acc = 0.0; s.vel = 0.0; s.pos = offset;
+    } else {
+      double t = current.time, j = current.jerk;
+      s.acc = current.acc + j * t;
+      s.vel = current.vel + current.acc * t + j * t * t / 2;
+      s.pos = current.pos + current.vel * t + current.acc * t * t / 2 + j * t * t * t / 6;
+    }
+    current = s;
+  }
+
   void clear() {
+    unmap();
     timeCoeffRaw.clear();
     jerkCoeffRaw.clear();
     accCoeffRaw.clear();
@@ -312,6 +496,15 @@ class PathPlannerCubic: public Block {
   double prevJerk, prevAcc, prevVel, prevPos;
   std::vector<double> timeCoeffRaw, jerkCoeffRaw, accCoeffRaw, velCoeffRaw, posCoeffRaw;
   std::vector<double> timeCoeff, jerkCoeff, accCoeff, velCoeff, posCoeff;
+  bool mapped = false;                          // trajectory is a mapped binary file
+  void* mapAddr = nullptr;
+  std::size_t mapLength = 0;
+  const PathPlannerCubicHeader* header = nullptr;
+  const PathPlannerCubicSegment* segments = nullptr;
+  std::size_t nofSegments = 0;
+  bool scaled = false;                          // mapped trajectory is scaled by move()
+  double roundScale = 1.0, jerkScale = 1.0, offset = 0.0;
+  PathPlannerCubicSegment current{};            // mapped segment which is running
   std::mutex m;
 };
 
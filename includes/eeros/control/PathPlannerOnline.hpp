@@ -0,0 +1,273 @@
+#ifndef ORG_EEROS_CONTROL_PATHPLANNERONLINE_HPP_
+#define ORG_EEROS_CONTROL_PATHPLANNERONLINE_HPP_
+
+#include <eeros/control/Input.hpp>
+#include <eeros/control/JerkProfile.hpp>
+#include <eeros/control/Output.hpp>
+#include <eeros/control/TrajectoryGenerator.hpp>
+#include <eeros/core/SeqlockBuffer.hpp>
+#include <eeros/core/System.hpp>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+namespace eeros {
+namespace control {
+
+/**
+ * This path planner replans the trajectory in every run from the current state
+ * (position, velocity and acceleration) to the target position, so the target
+ * may change at any time, e.g. to follow an object tracked by a camera. Each
+ * axis moves time optimally with limited velocity, acceleration and jerk and
+ * comes to rest at the target, see \ref JerkProfile. The axes are not
+ * synchronized, each one reaches the target as fast as it can.
+ *
+ * The target is set with move() or, if connected, read from the target input
+ * in every run. The execution time of run() is bounded, about a few microseconds
+ * per axis.
+ *
+ * @tparam T - output type (must be a composite type),
+ *             a trajectory in 3-dimensional space needs T = Matrix<3,1,double>,
+ *             a trajectory in linear space needs T = Matrix<1,1,double>
+ *
+ * @since v1.4.4
+ */
+template < typename T >
+class PathPlannerOnline : public TrajectoryGenerator<T, 4> {
+ public:
+  /**
+   * Constructs an online path planner. The sampling time must be set to the
+   * time with which the timedomain containing this block will run.
+   *
+   * @param velMax - maximum velocity
+   * @param accMax - maximum acceleration
+   * @param jerkMax - maximum jerk
+   * @param dt - sampling time
+   */
+  PathPlannerOnline(T velMax, T accMax, T jerkMax, double dt)
+      : targetIn(this), velMax(velMax), accMax(accMax), jerkMax(jerkMax), dt(dt) {
+    posOut.getSignal().clear();
+    velOut.getSignal().clear();
+    accOut.getSignal().clear();
+    jerkOut.getSignal().clear();
+    command.write(Command{this->target, this->target[0], 0});
+  }
+
+  /**
+   * Disabling use of copy constructor because the block should never be copied unintentionally.
+   */
+  PathPlannerOnline(const PathPlannerOnline& s) = delete;
+
+  /**
+   * Query if the target position is reached and the axes are at rest.
+   *
+   * @return - end of trajectory is reached
+   */
+  virtual bool endReached() override {
+    return reached;
+  }
+
+  /**
+   * Runs the path planner block. Plans the motion of each axis from the state of
+   * the last run to the target and advances it by one sampling time.
+   */
+  virtual void run() override {
+    Command c{};
+    command.read(c);
+    if (c.startCount != startCount) {
+      this->last = c.start;
+      startCount = c.startCount;
+    }
+    T goal = targetIn.isConnected() ? targetIn.getSignal().getValue() : c.target;
+    std::array<T, 4>& y = this->last;
+    bool done = true;
+    double time = 0;
+    for (unsigned int i = 0; i < goal.size(); i++) {
+      profile.plan(y[0][i], y[1][i], y[2][i], goal[i], velMax[i], accMax[i], jerkMax[i]);
+      if (profile.getDuration() <= dt) {
+        // the axis reaches the target within this step
+        if (y[0][i] != goal[i] || y[1][i] != 0 || y[2][i] != 0) done = false;
+        y[0][i] = goal[i]; y[1][i] = 0; y[2][i] = 0; y[3][i] = 0;
+      } else {
+        double p, v, a, j;
+        profile.sample(dt, p, v, a, j);
+        y[0][i] = p; y[1][i] = v; y[2][i] = a; y[3][i] = j;
+        done = false;
+      }
+      time = std::max(time, profile.getDuration() - dt);
+    }
+    remaining = time;
+    reached = done;
+
+    posOut.getSignal().setValue(y[0]);
+    velOut.getSignal().setValue(y[1]);
+    accOut.getSignal().setValue(y[2]);
+    jerkOut.getSignal().setValue(y[3]);
+
+    timestamp_t now = System::getTimeNs();
+    posOut.getSignal().setTimestamp(now);
+    velOut.getSignal().setTimestamp(now);
+    accOut.getSignal().setTimestamp(now);
+    jerkOut.getSignal().setTimestamp(now);
+  }
+
+  /**
+   * Sets a new target position, the axes leave their current state
+   * towards it in the next run.
+   *
+   * @param end - target position
+   * @return - always true
+   */
+  virtual bool move(T end) override {
+    std::lock_guard<std::mutex> lock(mtx);
+    Command c{};
+    command.read(c);
+    c.target = end;
+    command.write(c);
+    reached = false;
+    this->target[0] = end;
+    return true;
+  }
+
+  /**
+   * Sets a new target position. Only the position is considered,
+   * the axes come to rest at the target.
+   *
+   * @param end - array containing target position and its higher derivatives
+   * @return - always true
+   */
+  virtual bool move(std::array<T, 4> end) override {
+    return move(end[0]);
+  }
+
+  /**
+   * Sets the state of the axes and the target position. Only the position of
+   * the end is considered, the axes come to rest at the target.
+   *
+   * @param start - array containing start position and its higher derivatives
+   * @param end - array containing target position and its higher derivatives
+   * @return - always true
+   */
+  virtual bool move(std::array<T, 4> start, std::array<T, 4> end) override {
+    std::lock_guard<std::mutex> lock(mtx);
+    Command c{};
+    command.read(c);
+    c.start = start;
+    c.target = end[0];
+    c.startCount++;
+    command.write(c);
+    reached = false;
+    this->target[0] = end[0];
+    return true;
+  }
+
+  using TrajectoryGenerator<T, 4>::move;
+  using TrajectoryGenerator<T, 4>::setStart;
+
+  /**
+   * Sets the state of the axes, the target is set to the start position.
+   *
+   * @param start - array containing start position and its higher derivatives
+   */
+  virtual void setStart(std::array<T, 4> start) override {
+    move(start, start);
+  }
+
+  /**
+   * Sets the maximum value for the velocity.
+   *
+   * @param max - maximum velocity
+   */
+  virtual void setMaxVel(T max) {velMax = max;}
+
+  /**
+   * Sets the maximum value for the acceleration.
+   *
+   * @param max - maximum acceleration
+   */
+  virtual void setMaxAcc(T max) {accMax = max;}
+
+  /**
+   * Sets the maximum value for the jerk.
+   *
+   * @param max - maximum jerk
+   */
+  virtual void setMaxJerk(T max) {jerkMax = max;}
+
+  /**
+   * Time the slowest axis needs to reach the target after the last run.
+   *
+   * @return remaining time in sec
+   */
+  virtual double getRemainingTime() {return remaining;}
+
+  /**
+   * Getter function for the target input. If connected, the target is read
+   * from it in every run instead of being set by move().
+   *
+   * @return The target input
+   */
+  virtual Input<T>& getTargetIn() {return targetIn;}
+
+  /**
+   * Getter function for the position output.
+   *
+   * @return The position output
+   */
+  virtual Output<T>& getPosOut() {return posOut;}
+
+  /**
+   * Getter function for the velocity output.
+   *
+   * @return The velocity output
+   */
+  virtual Output<T>& getVelOut() {return velOut;}
+
+  /**
+   * Getter function for the acceleration output.
+   *
+   * @return The acceleration output
+   */
+  virtual Output<T>& getAccOut() {return accOut;}
+
+  /**
+   * Getter function for the jerk output.
+   *
+   * @return The jerk output
+   */
+  virtual Output<T>& getJerkOut() {return jerkOut;}
+
+ private:
+  struct Command {
+    std::array<T, 4> start;
+    T target;
+    uint32_t startCount;
+  };
+
+  Input<T> targetIn;
+  Output<T> posOut, velOut, accOut, jerkOut;
+  T velMax, accMax, jerkMax;
+  double dt;
+  JerkProfile profile;
+  SeqlockBuffer<Command> command;   // written by the threads calling move(), read by run()
+  std::mutex mtx;                   // serializes the writers of command
+  uint32_t startCount = 0;
+  std::atomic<bool> reached{true};
+  std::atomic<double> remaining{0};
+};
+
+/**
+ * Operator overload (<<) to enable an easy way to print the state of a
+ * PathPlannerOnline instance to an output stream.\n
+ * Does not print a newline control character.
+ */
+template < typename T >
+std::ostream& operator<<(std::ostream& os, PathPlannerOnline<T>& pp) {
+  os << "Block path planner online: '" << pp.getName() << "'";
+  return os;
+}
+
+}
+}
+
+#endif // ORG_EEROS_CONTROL_PATHPLANNERONLINE_HPP_
@@ -11,6 +11,8 @@ namespace control {
 /**
  * A peripheral input block reads a signal from an input. This
  * input must be defined by the hardware configuration file.
+ * If the HAL records its inputs, see HAL::recordInputs(), the values read
+ * are recorded as well.
  * 
  * @tparam T - output signal data type, must be bool or double (double - default type)
  * @tparam U - output signal unit type (dimensionless - default type)
@@ -33,6 +35,8 @@ class PeripheralInput : public Blockio<0,1,T,T,SIUnit::generateNSizeArray<0>(),M
     systemInput = dynamic_cast<eeros::hal::Input<T>*>(hal.getInput(id, exclusive));
     if(systemInput == nullptr) throw Fault("Peripheral input '" + id + "' not found!");
     if(systemInput->getUnit() != U) throw Fault("Expected output signal unit type does not match unit type of " + id);
+    auto recorder = hal.getInputRecorder();
+    if(recorder != nullptr) record = recorder->addChannel(id, std::is_same_v<T, bool>);
   }
 
   /**
@@ -44,7 +48,9 @@ class PeripheralInput : public Blockio<0,1,T,T,SIUnit::generateNSizeArray<0>(),M
    * Samples the signal at the input.
    */
   void run() override {
-    this->out.getSignal().setValue(systemInput->get());
+    T value = systemInput->get();
+    if(record != nullptr) record->push(value);
+    this->out.getSignal().setValue(value);
     this->out.getSignal().setTimestamp(systemInput->getTimestamp());
   }
 
@@ -64,6 +70,7 @@ class PeripheralInput : public Blockio<0,1,T,T,SIUnit::generateNSizeArray<0>(),M
  private:
   hal::HAL& hal;
   hal::Input<T>* systemInput;
+  hal::InputRecorder::Channel* record = nullptr;
 };
 
 }
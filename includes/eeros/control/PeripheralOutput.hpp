@@ -7,6 +7,7 @@
 #include <eeros/hal/HAL.hpp>
 #include <eeros/core/Fault.hpp>
 #include <eeros/control/NaNOutputFault.hpp>
+#include <eeros/control/FaultSlot.hpp>
 
 namespace eeros {
 namespace control {
@@ -44,7 +45,8 @@ class PeripheralOutput : public Blockio<1,0,T,T,MakeUnitArray<U>::value> {
   PeripheralOutput(const PeripheralOutput& s) = delete; 
 
   /**
-   * Delivers the signal to the output.
+   * Delivers the signal to the output. A NaN or infinite value is replaced by the
+   * safe level of the output and reported as fault.
    */
   void run() override {
     std::lock_guard<std::mutex> lock(mtx);
@@ -56,7 +58,7 @@ class PeripheralOutput : public Blockio<1,0,T,T,MakeUnitArray<U>::value> {
     }
     systemOutput->set(val);
     systemOutput->setTimestampSignalIn(this->in.getSignal().getTimestamp());
-    if (isSafe) throw NaNOutputFault("NaN written to output '" + 
+    if (isSafe && !FaultSlot::report(FaultSlot::Type::nanOutput, this)) throw NaNOutputFault("NaN written to output '" + 
                                      this->getName() + "', set to safe level if safe level is defined");
   }
   
@@ -0,0 +1,98 @@
+#ifndef ORG_EEROS_CONTROL_PIPELINEREGISTER_HPP_
+#define ORG_EEROS_CONTROL_PIPELINEREGISTER_HPP_
+
+#include <eeros/control/Blockio.hpp>
+#include <ostream>
+
+namespace eeros {
+namespace control {
+
+/**
+ * Interface of a pipeline register, used by the TimeDomainGroup to latch
+ * all registers between two cycles.
+ *
+ * @since v1.4.4
+ */
+class PipelineRegisterBase {
+ public:
+  virtual ~PipelineRegisterBase() { }
+
+  /**
+   * Passes the value stored in the last cycle to the output. Must only be
+   * called while neither side of the register runs.
+   */
+  virtual void latch() = 0;
+};
+
+/**
+ * A pipeline register carries a signal across the boundary of two pipeline stages,
+ * i.e. two time domains of a TimeDomainGroup which run in parallel although one uses
+ * the result of the other. The register is double buffered: its run stores the input
+ * of the producing time domain, while the consuming time domain reads the output,
+ * which holds the value of the previous cycle. The group latches the registers at the
+ * beginning of each cycle, see TimeDomainGroup::addPipelineRegister().
+ *
+ * The consuming stage of cycle n therefore works on the result of the producing stage
+ * of cycle n-1, which adds one period of latency per register passed. The timestamp
+ * is passed on unchanged, so the added latency shows up in the data age.
+ *
+ * Example:
+ * PipelineRegister<Matrix<6,1>> estimate;
+ * estimate.getIn().connect(estimator.getOut());
+ * estimation.addBlock(estimate);
+ * controller.getIn().connect(estimate.getOut());
+ * group.add(estimation);
+ * group.add(control);
+ * group.addPipelineRegister(estimate);
+ *
+ * @tparam T - signal type (double - default type)
+ *
+ * @since v1.4.4
+ */
+template < typename T = double >
+class PipelineRegister : public Blockio<1,1,T>, public PipelineRegisterBase {
+ public:
+  PipelineRegister() { }
+
+  /**
+   * Disabling use of copy constructor because the block should never be copied unintentionally.
+   */
+  PipelineRegister(const PipelineRegister& s) = delete;
+
+  /**
+   * Stores the input, it is passed to the output by the next latch().
+   */
+  void run() override {
+    const Signal<T>& in = this->readSignal(this->in);
+    value = in.getValueRef();
+    timestamp = in.getTimestamp();
+    stored = true;
+  }
+
+  void latch() override {
+    if (!stored) return;
+    this->out.getSignal().set(value, timestamp);
+    stored = false;
+  }
+
+ private:
+  T value;
+  timestamp_t timestamp = 0;
+  bool stored = false;
+};
+
+/**
+ * Operator overload (<<) to enable an easy way to print the state of a
+ * pipeline register instance to an output stream.\n
+ * Does not print a newline control character.
+ */
+template < typename T >
+std::ostream& operator<<(std::ostream& os, PipelineRegister<T>& b) {
+  os << "Block pipeline register: '" << b.getName() << "'";
+  return os;
+}
+
+}
+}
+
+#endif // ORG_EEROS_CONTROL_PIPELINEREGISTER_HPP_
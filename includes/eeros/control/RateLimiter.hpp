@@ -25,6 +25,7 @@ namespace control {
  *
  * If the input is a vector, then it is possible to choose if the algorithm applies elementwise or not.
  * If yes, rRate and fRate must be vectors.
+ * All elements of a vector are limited in one pass without branches, see math::kernel::limitRate().
  * 
  * @tparam Tout - input and output signal data type (double - default type)
  * @tparam Trate - rate data type (double - default type)
@@ -149,28 +150,20 @@ class RateLimiter : public Blockio<1,1,Tout,Tout,MakeUnitArray<Uin>::value,MakeU
   }
 
   template <typename S> 
-  typename std::enable_if<std::is_compound<S>::value && std::is_arithmetic<Trate>::value, S>::type calculateResult(S inValue, double dt) {
-    std::cout << " NOT element wise" << std::endl;
+  typename std::enable_if<std::is_compound<S>::value && std::is_arithmetic<Trate>::value, S>::type calculateResult(const S& inValue, double dt) {
     Tout outVal;
-    for (unsigned int i = 0; i < inValue.size(); i++) {
-      double rate = (inValue[i] - outPrev.getValue()[i])/dt;
-      if (rate > risingRate) outVal[i] = dt * risingRate + outPrev.getValue()[i];
-      else if (rate < fallingRate) outVal[i] = dt * fallingRate + outPrev.getValue()[i];
-      else outVal[i] = inValue[i];
-    }
+    math::kernel::limitRate(outVal.data(), inValue.data(), outPrev.getValueRef().data(),
+                            static_cast<typename S::value_type>(fallingRate), static_cast<typename S::value_type>(risingRate),
+                            static_cast<typename S::value_type>(dt), outVal.size());
     return outVal;
   }
 
   template <typename S> 
-  typename std::enable_if<std::is_compound<S>::value && std::is_compound<Trate>::value, S>::type calculateResult(S inValue, double dt) {
-    std::cout << " element wise" << std::endl;
+  typename std::enable_if<std::is_compound<S>::value && std::is_compound<Trate>::value, S>::type calculateResult(const S& inValue, double dt) {
     Tout outVal;
-    for (unsigned int i = 0; i < inValue.size(); i++) {
-      double rate = (inValue[i] - outPrev.getValue()[i]) / dt;
-      if (rate > risingRate[i]) outVal[i] = dt * risingRate[i] + outPrev.getValue()[i];
-      else if (rate < fallingRate[i]) outVal[i] = dt * fallingRate[i] + outPrev.getValue()[i];
-      else outVal[i] = inValue[i];
-    }
+    math::kernel::limitRate(outVal.data(), inValue.data(), outPrev.getValueRef().data(),
+                            fallingRate.data(), risingRate.data(),
+                            static_cast<typename S::value_type>(dt), outVal.size());
     return outVal;
   }
 
@@ -0,0 +1,304 @@
+#ifndef ORG_EEROS_CONTROL_RATETRANSITION_HPP_
+#define ORG_EEROS_CONTROL_RATETRANSITION_HPP_
+
+#include <eeros/control/Blockio.hpp>
+#include <eeros/core/SpscRingBuffer.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <eeros/math/MatrixKernels.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+
+namespace eeros {
+namespace control {
+
+/**
+ * Sending side of a rate transition, runs in the time domain of the signal.
+ * Each run pushes the input value and its timestamp into a wait-free ring
+ * buffer, which is read by a Decimator or an Interpolator running in another
+ * time domain. If the buffer is full, the sample is dropped and counted.
+ *
+ * The sender is owned by the receiving block, see Decimator::getSender().
+ *
+ * @tparam T - signal type (double - default type)
+ * @tparam N - capacity of the buffer, a power of two
+ *
+ * @since v1.4.4
+ */
+template < typename T = double, int N = 64 >
+class RateTransitionSender : public Blockio<1,0,T> {
+ public:
+  /**
+   * Sample as passed through the buffer.
+   */
+  struct Sample {
+    T value;
+    timestamp_t timestamp;
+  };
+
+  RateTransitionSender() { }
+
+  /**
+   * Disabling use of copy constructor because the block should never be copied unintentionally.
+   */
+  RateTransitionSender(const RateTransitionSender& s) = delete;
+
+  /**
+   * Pushes the input into the buffer.
+   */
+  void run() override {
+    const Signal<T>& in = this->readSignal(this->in);
+    if (!buffer.push({in.getValueRef(), in.getTimestamp()})) overruns.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * Takes the oldest sample, called by the receiving block only.
+   *
+   * @param s - sample
+   * @return false, if the buffer is empty
+   */
+  bool pop(Sample& s) {
+    return buffer.pop(s);
+  }
+
+  /**
+   * @return number of samples dropped because the buffer was full
+   */
+  uint64_t getOverruns() const {
+    return overruns.load(std::memory_order_relaxed);
+  }
+
+ private:
+  SpscRingBuffer<Sample, N> buffer;
+  std::atomic<uint64_t> overruns{0};
+};
+
+/**
+ * A decimator carries a signal from a fast time domain to a slow one, e.g. from a
+ * 4 kHz domain to a 250 Hz domain. Its sender block is added to the fast domain and
+ * the decimator itself to the slow one. The samples are passed through a wait-free
+ * buffer, so a matrix is never read while it is written and neither side blocks.
+ *
+ * Each run takes all samples sent since the last run. The output is their average,
+ * which filters the signal against aliasing, or the newest sample if averaging is
+ * disabled. The timestamp is the one of the newest sample. If no sample was sent,
+ * the output is held. The samples of the last run stay available as a batch, see
+ * getBatchLength(), so blocks of the slow domain can process all of them.
+ *
+ * The buffer must hold the samples of at least one period of the slow domain.
+ *
+ * Example:
+ * Decimator<Matrix<3,1>> decimator;
+ * decimator.getIn().connect(sensor.getOut());
+ * fastTimeDomain.addBlock(decimator.getSender());
+ * slowTimeDomain.addBlock(decimator);
+ *
+ * @tparam T - signal type, arithmetic or matrix (double - default type)
+ * @tparam N - capacity of the buffer, a power of two (64 - default value)
+ *
+ * @since v1.4.4
+ */
+template < typename T = double, int N = 64 >
+class Decimator : public Blockio<0,1,T> {
+  using Shape = math::ValueShape<T>;
+  using E = typename Shape::value_type;
+  using Sample = typename RateTransitionSender<T, N>::Sample;
+
+ public:
+  /**
+   * Constructs a decimator.
+   *
+   * @param average - output the average of the samples instead of the newest one
+   */
+  Decimator(bool average = true) : average(average) { }
+
+  /**
+   * Disabling use of copy constructor because the block should never be copied unintentionally.
+   */
+  Decimator(const Decimator& s) = delete;
+
+  /**
+   * @return input of the sender, which is connected in the fast time domain
+   */
+  Input<T>& getIn() {
+    return sender.getIn();
+  }
+
+  /**
+   * @return sender block, which must be added to the fast time domain
+   */
+  RateTransitionSender<T, N>& getSender() {
+    return sender;
+  }
+
+  /**
+   * Takes the samples sent since the last run and sets the output.
+   */
+  void run() override {
+    batchLength = 0;
+    while (batchLength < N && sender.pop(batch[batchLength])) batchLength++;
+    if (batchLength == 0) return;
+    const Sample& newest = batch[batchLength - 1];
+    if (!average) {
+      this->out.getSignal().set(newest.value, newest.timestamp);
+      return;
+    }
+    T sum = batch[0].value;
+    E* s = Shape::data(sum);
+    for (unsigned int i = 1; i < batchLength; i++) {
+      math::kernel::elementwise<math::kernel::Add>(s, s, Shape::data(batch[i].value), Shape::size);
+    }
+    math::kernel::elementwise<math::kernel::Div>(s, s, static_cast<E>(batchLength), Shape::size);
+    this->out.getSignal().set(sum, newest.timestamp);
+  }
+
+  /**
+   * @return number of samples taken by the last run
+   */
+  unsigned int getBatchLength() const {
+    return batchLength;
+  }
+
+  /**
+   * @param i - index of the sample, 0 is the oldest
+   * @return value of a sample taken by the last run
+   */
+  const T& getBatchValue(unsigned int i) const {
+    return batch[i].value;
+  }
+
+  /**
+   * @param i - index of the sample, 0 is the oldest
+   * @return timestamp of a sample taken by the last run
+   */
+  timestamp_t getBatchTimestamp(unsigned int i) const {
+    return batch[i].timestamp;
+  }
+
+ private:
+  RateTransitionSender<T, N> sender;
+  bool average;
+  std::array<Sample, N> batch;
+  unsigned int batchLength = 0;
+};
+
+/**
+ * Upsampling method of an Interpolator.
+ *
+ * @since v1.4.4
+ */
+enum class Interpolation { zeroOrderHold, linear };
+
+/**
+ * An interpolator carries a signal from a slow time domain to a fast one. Its sender
+ * block is added to the slow domain and the interpolator itself to the fast one, the
+ * samples are passed through a wait-free buffer as with a Decimator.
+ *
+ * With zero-order hold, the output is the newest sample. With linear interpolation,
+ * the output moves from the previous sample to the newest one in factor steps, so it
+ * reaches each sample one period of the slow domain later. If the next sample is
+ * late, the output stays at the newest one. As long as nothing was sent, the output
+ * keeps its initial value.
+ *
+ * @tparam T - signal type, arithmetic or matrix of floating point values (double - default type)
+ * @tparam N - capacity of the buffer, a power of two (8 - default value)
+ *
+ * @since v1.4.4
+ */
+template < typename T = double, int N = 8 >
+class Interpolator : public Blockio<0,1,T> {
+  using Shape = math::ValueShape<T>;
+  using E = typename Shape::value_type;
+  using Sample = typename RateTransitionSender<T, N>::Sample;
+
+ public:
+  /**
+   * Constructs an interpolator.
+   *
+   * @param factor - ratio of the sampling rates of both time domains
+   * @param mode - upsampling method
+   */
+  Interpolator(unsigned int factor, Interpolation mode = Interpolation::zeroOrderHold)
+      : factor(std::max(factor, 1u)), mode(mode) { }
+
+  /**
+   * Disabling use of copy constructor because the block should never be copied unintentionally.
+   */
+  Interpolator(const Interpolator& s) = delete;
+
+  /**
+   * @return input of the sender, which is connected in the slow time domain
+   */
+  Input<T>& getIn() {
+    return sender.getIn();
+  }
+
+  /**
+   * @return sender block, which must be added to the slow time domain
+   */
+  RateTransitionSender<T, N>& getSender() {
+    return sender;
+  }
+
+  /**
+   * Takes the newest sample, if any, and sets the output.
+   */
+  void run() override {
+    Sample s;
+    while (sender.pop(s)) {
+      prev = (received > 0) ? newest : s;
+      newest = s;
+      received++;
+      step = 0;
+    }
+    if (received == 0) return;
+    if (mode == Interpolation::zeroOrderHold) {
+      this->out.getSignal().set(newest.value, newest.timestamp);
+      return;
+    }
+    if (step < factor) step++;
+    E f = static_cast<E>(step) / static_cast<E>(factor);
+    T value;
+    math::kernel::lerp(Shape::data(value), Shape::data(prev.value), Shape::data(newest.value), f, Shape::size);
+    timestamp_t time = prev.timestamp + static_cast<timestamp_t>((newest.timestamp - prev.timestamp) * step / factor);
+    this->out.getSignal().set(value, time);
+  }
+
+ private:
+  RateTransitionSender<T, N> sender;
+  unsigned int factor;
+  Interpolation mode;
+  Sample prev;
+  Sample newest;
+  uint64_t received = 0;
+  unsigned int step = 0;
+};
+
+/**
+ * Operator overload (<<) to enable an easy way to print the state of a
+ * decimator instance to an output stream.\n
+ * Does not print a newline control character.
+ */
+template < typename T, int N >
+std::ostream& operator<<(std::ostream& os, Decimator<T, N>& b) {
+  os << "Block decimator: '" << b.getName() << "' overruns=" << b.getSender().getOverruns();
+  return os;
+}
+
+/**
+ * Operator overload (<<) to enable an easy way to print the state of an
+ * interpolator instance to an output stream.\n
+ * Does not print a newline control character.
+ */
+template < typename T, int N >
+std::ostream& operator<<(std::ostream& os, Interpolator<T, N>& b) {
+  os << "Block interpolator: '" << b.getName() << "' overruns=" << b.getSender().getOverruns();
+  return os;
+}
+
+}
+}
+
+#endif // ORG_EEROS_CONTROL_RATETRANSITION_HPP_
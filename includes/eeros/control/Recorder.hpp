@@ -0,0 +1,285 @@
+#ifndef ORG_EEROS_CONTROL_RECORDER_HPP_
+#define ORG_EEROS_CONTROL_RECORDER_HPP_
+
+#include <eeros/control/Block.hpp>
+#include <eeros/control/Output.hpp>
+#include <eeros/core/Fault.hpp>
+#include <eeros/core/FutexSemaphore.hpp>
+#include <eeros/logger/Logger.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace eeros {
+namespace control {
+
+/**
+ * Header at the start of a recorder file written by a RecorderWriter. It is
+ * followed by one RecorderColumn per column and then by the chunks.
+ *
+ * A chunk starts with the number of samples n (uint32_t) and 4 bytes padding,
+ * followed by the columns one after the other, each with n samples. All chunks
+ * except the last one hold chunkLength samples, so a column of a chunk k starts at
+ *
+ * header + k * (8 + chunkLength * sampleBytes) + 8 + chunkLength * offset
+ *
+ * where sampleBytes is the sum of the sample sizes of all columns and offset
+ * the sum of the sample sizes of the preceding columns. chunkLength is a multiple
+ * of 8, so every column of a full chunk is aligned to 8 bytes and the file can be
+ * memory mapped column by column. The first column is the time in ns (uint64_t)
+ * when the samples were taken. All values are stored in the byte order of the
+ * machine that wrote the file.
+ *
+ * A file written with compression has version 2. Its chunks start with the number
+ * of samples n (uint32_t) and the number of bytes b (uint32_t) that follow, then
+ * the encoded size of each column (uint32_t) and the encoded columns. Every column
+ * of every chunk is encoded on its own, see decodeRecorderColumn(), so a tool can
+ * skip from chunk to chunk and decode only the columns it needs.
+ *
+ * @since v1.4.4
+ */
+struct RecorderHeader {
+  char magic[4];        // "EERC"
+  uint32_t version;     // format version, 1 uncompressed, 2 compressed
+  uint32_t nofColumns;  // number of columns including the time column
+  uint32_t chunkLength; // samples of a full chunk
+};
+
+/**
+ * Description of a column of a recorder file, see RecorderHeader.
+ *
+ * @since v1.4.4
+ */
+struct RecorderColumn {
+  char name[64];        // name of the signal, zero terminated
+  uint32_t rows;        // rows of a sample, 1 for scalars
+  uint32_t cols;        // colums of a sample, 1 for scalars
+  uint32_t elementSize; // bytes of one element
+  uint32_t elementType; // 0 unsigned integer, 1 signed integer, 2 floating point
+};
+
+/**
+ * Decodes a column of a compressed chunk, see RecorderHeader. The encoder stores
+ * the difference of integer elements and the XOR of floating point elements to the
+ * element of the previous sample, splits these words into byte planes and run
+ * length encodes the planes. Slowly changing signals and timestamps thus shrink to
+ * a few bytes per sample, constant signals to almost nothing. The first sample of
+ * a chunk is encoded against 0.
+ *
+ * @param column - description of the column
+ * @param n - number of samples of the chunk
+ * @param src - encoded column
+ * @param size - bytes of the encoded column
+ * @param dst - buffer for n samples of the column
+ * @return false if the encoded column is corrupt
+ */
+bool decodeRecorderColumn(const RecorderColumn& column, uint32_t n, const void* src, size_t size, void* dst);
+
+/**
+ * A recorder block samples any number of signals into one file. The outputs to
+ * record are added with add(), each becomes a column of a chunked, columnar binary
+ * file (see RecorderHeader) which is written by a RecorderWriter in the background.
+ * Recording many signals thus needs a single block, thread and file.
+ *
+ * Like StreamingTrace, the recorder fills one of two preallocated chunks while the
+ * writer writes the other one. run() never blocks and never allocates memory. If
+ * the writer falls behind, samples are dropped and counted, see getOverruns().
+ * After disable(), the next run() hands over the partially filled chunk.
+ *
+ * @since v1.4.4
+ */
+class Recorder : public Block {
+ public:
+  /**
+   * Constructs a recorder.
+   *
+   * @param chunkLength - number of samples per chunk, rounded up to a multiple of 8
+   */
+  Recorder(uint32_t chunkLength = 1024);
+
+  /**
+   * Disabling use of copy constructor because the block should never be copied unintentionally.
+   */
+  Recorder(const Recorder& s) = delete;
+
+  /**
+   * Destructor frees buffers.
+   */
+  ~Recorder() override;
+
+  /**
+   * Adds an output to record. All outputs must be added before the writer is created.
+   *
+   * @param output - output of a block
+   * @param name - name of the column, the name of the signal if empty
+   */
+  template < typename T >
+  void add(Output<T>& output, std::string name = "") {
+    using S = math::ValueShape<T>;
+    using V = typename S::value_type;
+    static_assert(std::is_arithmetic_v<V>, "Recorder needs arithmetic values or matrices of them");
+    RecorderColumn desc{};
+    std::string n = name.empty() ? output.getSignal().getName() : name;
+    std::strncpy(desc.name, n.c_str(), sizeof(desc.name) - 1);
+    desc.rows = S::rows;
+    desc.cols = S::cols;
+    desc.elementSize = sizeof(V);
+    desc.elementType = std::is_floating_point_v<V> ? 2 : std::is_signed_v<V> ? 1 : 0;
+    addColumn(std::make_unique<SignalColumn<T>>(output.getSignal()), desc);
+  }
+
+  /**
+   * Samples all signals, if the recorder is enabled.
+   */
+  void run() override;
+
+  /**
+   * Starts recording.
+   */
+  void enable() override;
+
+  /**
+   * Stops recording, the next run hands over the samples recorded so far.
+   */
+  void disable() override;
+
+  /**
+   * @return number of columns including the time column
+   */
+  unsigned int getNofColumns() const;
+
+  /**
+   * @return samples of a full chunk
+   */
+  uint32_t getChunkLength() const;
+
+  /**
+   * @return number of samples dropped because the writer did not keep up
+   */
+  uint64_t getOverruns() const;
+
+  /*
+   * Friend operator overload to give the operator overload outside
+   * the class access to the private fields.
+   */
+  friend std::ostream& operator<<(std::ostream& os, Recorder& recorder);
+
+ private:
+  friend class RecorderWriter;
+
+  struct Column {
+    virtual ~Column() = default;
+    virtual void sample(char* dst) const = 0;
+    RecorderColumn desc;
+    uint32_t sampleSize; // bytes of one sample
+    size_t offset;       // sum of the sample sizes of the preceding columns
+  };
+
+  template < typename T >
+  struct SignalColumn : Column {
+    SignalColumn(const Signal<T>& signal) : signal(signal) { }
+    void sample(char* dst) const override {
+      std::memcpy(dst, math::ValueShape<T>::data(signal.getValueRef()), this->sampleSize);
+    }
+    const Signal<T>& signal;
+  };
+
+  void addColumn(std::unique_ptr<Column> column, const RecorderColumn& desc);
+  void allocate();
+  void publish();
+
+  uint32_t chunkLength;
+  size_t sampleBytes;                  // bytes of one sample of all columns
+  std::vector<std::unique_ptr<Column>> columns;
+  RecorderColumn timeColumn;
+  char* buf[2] = {nullptr, nullptr};
+  uint32_t len[2] = {0, 0};            // number of samples of a full chunk
+  std::atomic<bool> full[2] = {false, false}; // chunk belongs to the writer
+  uint32_t active = 0;                 // chunk written by run()
+  uint32_t fill = 0;                   // samples in the active chunk
+  bool hasWriter = false;
+  std::atomic<bool> running{false};
+  std::atomic<uint64_t> overruns{0};
+  FutexSemaphore ready;                // posted for each chunk handed over
+};
+
+/**
+ * Operator overload (<<) to enable an easy way to print the state of a
+ * recorder instance to an output stream.\n
+ * Does not print a newline control character.
+ */
+std::ostream& operator<<(std::ostream& os, Recorder& recorder);
+
+/**
+ * A recorder writer writes the chunks of a Recorder to a file, see RecorderHeader
+ * for the format. It starts its own non realtime thread, which sleeps until a chunk
+ * is handed over and writes each chunk with a single system call.
+ *
+ * With compression, the writer thread encodes each chunk before it is written, see
+ * decodeRecorderColumn(). The recorder block does the same work as without.
+ *
+ * @since v1.4.4
+ */
+class RecorderWriter {
+ public:
+  /**
+   * Opens the file, writes the header and starts the writer thread.
+   * No more outputs can be added to the recorder afterwards.
+   *
+   * @param recorder - recorder block
+   * @param fileName - name of the file, an existing file is overwritten
+   * @param compress - compress the chunks
+   */
+  RecorderWriter(Recorder& recorder, std::string fileName, bool compress = false);
+
+  RecorderWriter(const RecorderWriter&) = delete;
+
+  /**
+   * Stops the writer, see stop().
+   */
+  ~RecorderWriter();
+
+  /**
+   * Writes all chunks handed over so far, stops the thread and closes the file.
+   */
+  void stop();
+
+  /**
+   * @return number of samples written to the file
+   */
+  uint64_t getNofSamples() const;
+
+  /**
+   * @return number of bytes of the chunks written to the file
+   */
+  uint64_t getNofBytes() const;
+
+ private:
+  void loop();
+  void drain();
+  void writeCompressed(const char* chunk, uint32_t n);
+  void writeAll(const void* p, size_t n);
+
+  Recorder& recorder;
+  std::string fileName;
+  logger::Logger log;
+  int fd;
+  uint32_t next = 0; // next chunk to write
+  uint64_t samples = 0;
+  uint64_t bytes = 0;
+  bool compress;
+  std::vector<char> encoded;   // compressed chunk
+  std::vector<char> planes;    // byte planes of a column
+  std::atomic<bool> stopping{false};
+  std::thread thread;
+};
+
+};
+};
+
+#endif /* ORG_EEROS_CONTROL_RECORDER_HPP_ */
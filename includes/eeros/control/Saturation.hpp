@@ -2,8 +2,10 @@
 #define ORG_EEROS_CONTROL_SATURATION_HPP_
 
 #include <eeros/control/Blockio.hpp>
+#include <eeros/control/ElementPool.hpp>
+#include <eeros/core/ParameterSet.hpp>
+#include <eeros/math/Fixed.hpp>
 #include <eeros/math/Matrix.hpp>
-#include <mutex>
 #include <type_traits>
 
 namespace eeros {
@@ -13,6 +15,9 @@ namespace control {
  * A Saturation block limits an input value between two limit values.
  * The output value will always vary between lower and upper limit.
  * If the block is disabled, the output value will simply follow the input.
+ * The limits can be changed by other threads while the block is running, see
+ * ParameterSet. For large matrix signals, the limitation can be split over
+ * several cores with setElementPool().
  * 
  * @tparam T - input and output signal data type (double - default type)
  * @tparam Uin - input signal unit type (dimensionless - default type)
@@ -30,10 +35,7 @@ class Saturation : public Blockio<1,1,T,T,MakeUnitArray<Uin>::value,MakeUnitArra
    * @param lower - lower limit
    * @param upper - upper limit
    */
-  Saturation(T lower, T upper) : enabled(true) {
-    lowerLimit = lower;
-    upperLimit = upper;
-  }
+  Saturation(T lower, T upper) : limits(Limits{lower, upper}), enabled(true) { }
 
   /**
    * Constructs a Saturation instance specifying a limit.
@@ -53,12 +55,10 @@ class Saturation : public Blockio<1,1,T,T,MakeUnitArray<Uin>::value,MakeUnitArra
    * Runs the saturation algorithm, as described above.
    */
   void run() override {
-    std::lock_guard<std::mutex> lock(mtx);
-    T inVal = this->in.getSignal().getValue();
-    T outVal = inVal;
-    if (enabled) outVal = calculateResult<T>(inVal);
-    this->out.getSignal().setValue(outVal);
-    this->out.getSignal().setTimestamp(this->in.getSignal().getTimestamp());
+    const Limits& l = limits.acquire();
+    const Signal<T>& in = this->readSignal(this->in);
+    if (enabled) this->out.getSignal().set(calculateResult<T>(in.getValueRef(), l), in.getTimestamp());
+    else this->out.getSignal().set(in.getValueRef(), in.getTimestamp());
   }
 
   /**
@@ -70,6 +70,7 @@ class Saturation : public Blockio<1,1,T,T,MakeUnitArray<Uin>::value,MakeUnitArra
    */
   void enable() override {
     enabled = true;
+    this->markChanged();
   }
 
   /**
@@ -81,6 +82,7 @@ class Saturation : public Blockio<1,1,T,T,MakeUnitArray<Uin>::value,MakeUnitArra
    */
   void disable() override {
     enabled = false;
+    this->markChanged();
   }
 
   /**
@@ -90,32 +92,68 @@ class Saturation : public Blockio<1,1,T,T,MakeUnitArray<Uin>::value,MakeUnitArra
    * @param upper - upper limit
    */
   virtual void setLimit(T lower, T upper) {
-    lowerLimit = lower;
-    upperLimit = upper;
+    limits.publish(Limits{lower, upper});
+    this->markChanged();
+  }
+
+  /**
+   * The saturation can be skipped while its input and its limits do not change.
+   *
+   * @return true
+   * @see TimeDomain::setChangePropagation()
+   */
+  bool isSkippable() const override {
+    return true;
+  }
+
+  /**
+   * Splits the limitation of large matrix signals over the threads of an element pool.
+   *
+   * @param pool - element pool, nullptr to run on the thread of the time domain only
+   */
+  virtual void setElementPool(ElementPool* pool) {
+    this->pool = pool;
+  }
+
+  /**
+   * @return lower limit
+   */
+  T getLowerLimit() const {
+    return limits.get().lower;
+  }
+
+  /**
+   * @return upper limit
+   */
+  T getUpperLimit() const {
+    return limits.get().upper;
   }
 
  private:
+  struct Limits {
+    T lower, upper;
+  };
+
   template <typename S> 
-  typename std::enable_if<std::is_arithmetic<S>::value, S>::type calculateResult(S inVal) {
+  typename std::enable_if<math::isScalar<S>::value, S>::type calculateResult(S inVal, const Limits& l) {
     T outVal = inVal;
-    if (inVal > upperLimit) outVal = upperLimit;
-    if (inVal < lowerLimit) outVal = lowerLimit;
+    if (inVal > l.upper) outVal = l.upper;
+    if (inVal < l.lower) outVal = l.lower;
     return outVal;
   }
 
   template <typename S> 
-  typename std::enable_if<std::is_compound<S>::value, S>::type calculateResult(S inVal) {
-    T outVal = inVal;
-    for (unsigned int i = 0; i < outVal.size(); i++) {
-      if (inVal[i] > upperLimit[i]) outVal[i] = upperLimit[i];
-      if (inVal[i] < lowerLimit[i]) outVal[i] = lowerLimit[i];
-    }   
+  typename std::enable_if<!math::isScalar<S>::value, S>::type calculateResult(const S& inVal, const Limits& l) {
+    T outVal;
+    forEachElement(pool, outVal.size(), [&](unsigned int b, unsigned int e) {
+      math::kernel::clamp(outVal.data() + b, inVal.data() + b, l.lower.data() + b, l.upper.data() + b, e - b);
+    });
     return outVal;
   }
 
-  T lowerLimit, upperLimit;
+  ParameterSet<Limits> limits;
   bool enabled;
-  std::mutex mtx;
+  ElementPool* pool = nullptr;
 };
 
 /**
@@ -125,7 +163,7 @@ class Saturation : public Blockio<1,1,T,T,MakeUnitArray<Uin>::value,MakeUnitArra
  */
 template <typename T>
 std::ostream& operator<<(std::ostream& os, Saturation<T>& s) {
-  os << "Block saturation: '" << s.getName() << "' lower limit=" << s.lowerLimit << ", upper limit=" << s.upperLimit; 
+  os << "Block saturation: '" << s.getName() << "' lower limit=" << s.getLowerLimit() << ", upper limit=" << s.getUpperLimit(); 
   return os;
 }
 
@@ -0,0 +1,195 @@
+#ifndef ORG_EEROS_CONTROL_SEGMENTTRAJECTORY_HPP_
+#define ORG_EEROS_CONTROL_SEGMENTTRAJECTORY_HPP_
+
+#include <eeros/core/TripleBuffer.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <eeros/math/MatrixKernels.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <mutex>
+
+namespace eeros {
+namespace control {
+
+/**
+ * Trajectory of up to K segments, each given by the coefficients of its position
+ * polynome of at most third order and by its number of samples. It is used by
+ * the path planners to hand a trajectory over from the thread calling move()
+ * to the realtime thread running the block.
+ *
+ * A trajectory is computed in place into a free slot of a wait-free triple
+ * buffer and published with an atomic exchange. The realtime side takes over a
+ * published trajectory only at the boundary of a segment or when it is idle, so
+ * a trajectory is never changed within a segment and run() never blocks. Each
+ * published trajectory has an id, the realtime side reports the id of the
+ * trajectory it completed.
+ *
+ * @tparam T - value type, a matrix
+ * @tparam N - number of derivatives including the position, at most 4
+ * @tparam K - maximum number of segments
+ *
+ * @since v1.4.4
+ */
+template < typename T, int N, unsigned int K >
+class SegmentTrajectory {
+  using E = typename T::value_type;
+  static constexpr unsigned int C = math::ValueShape<T>::size;
+  static_assert(N >= 1 && N <= 4, "SegmentTrajectory supports up to the jerk");
+
+ public:
+  /**
+   * Constructs an empty trajectory.
+   *
+   * @param dt - sampling time
+   */
+  SegmentTrajectory(double dt) : dt(dt) { }
+
+  /**
+   * Trajectory as published to the realtime side.
+   */
+  struct Profile {
+    E coeff[K][4 * C];          // c0 of all elements followed by c1 ... c3 of each segment
+    uint64_t steps[K];          // number of samples of each segment
+    unsigned int segments;      // number of segments used
+    T endPos;                   // position when the trajectory is completed
+    std::array<T, N> start;     // state to hold, if hold is set
+    bool hold;                  // stop and hold start instead of moving
+    uint64_t id;
+  };
+
+  /**
+   * Returns the slot which is filled by prepare() and published by publish().
+   * Must only be called by the thread holding the lock, see mutex().
+   *
+   * @return profile to fill
+   */
+  Profile& prepare() {
+    Profile& p = buffer.writeBuffer();
+    p.segments = 0;
+    p.hold = false;
+    return p;
+  }
+
+  /**
+   * Sets a segment of the prepared profile.
+   *
+   * @param p - prepared profile
+   * @param duration - duration of the segment, a multiple of the sampling time
+   * @param c - position coefficients c0 ... c3 of the segment in its local time, missing ones are 0
+   */
+  void setSegment(Profile& p, double duration, std::initializer_list<T> c) {
+    unsigned int k = p.segments++;
+    p.steps[k] = static_cast<uint64_t>(std::llround(duration / dt));
+    std::fill(p.coeff[k], p.coeff[k] + 4 * C, E(0));
+    unsigned int j = 0;
+    for (auto& x : c) {
+      const E* src = math::ValueShape<T>::data(x);
+      std::copy(src, src + C, p.coeff[k] + j++ * C);
+    }
+  }
+
+  /**
+   * Publishes the prepared profile as a move to the realtime side.
+   *
+   * @param p - prepared profile
+   */
+  void publish(Profile& p) {
+    p.id = ++requested;
+    pendingMove.store(p.id, std::memory_order_relaxed);
+    buffer.publish();
+  }
+
+  /**
+   * Publishes a profile which stops the trajectory at the next segment
+   * boundary and holds the given state.
+   *
+   * @param start - state to hold
+   */
+  void publishHold(const std::array<T, N>& start) {
+    Profile& p = prepare();
+    p.hold = true;
+    p.start = start;
+    p.id = ++requested;
+    // a stopped trajectory counts as completed
+    pendingMove.store(0, std::memory_order_relaxed);
+    buffer.publish();
+  }
+
+  /**
+   * Serializes the threads which prepare and publish profiles, the realtime
+   * side never takes this lock.
+   *
+   * @return mutex of the publishing side
+   */
+  std::mutex& mutex() {
+    return mtx;
+  }
+
+  /**
+   * @return true, if the last move is completed or was stopped
+   */
+  bool completed() const {
+    return completedId.load(std::memory_order_acquire) >= pendingMove.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Calculates the next sample, called by the realtime side only.
+   *
+   * @param y - last state, updated with the next state
+   */
+  void next(std::array<T, N>& y) {
+    if (active == nullptr || !moving || sample == active->steps[segment]) {
+      bool newData;
+      const Profile& p = buffer.read(newData);
+      if (newData) {
+        active = &p;
+        segment = 0;
+        sample = 0;
+        moving = !p.hold;
+        if (p.hold) {
+          y = p.start;
+          completedId.store(p.id, std::memory_order_release);
+        }
+      }
+    }
+    if (!moving) return;
+    // skip completed and empty segments
+    while (segment < active->segments && sample == active->steps[segment]) {
+      segment++;
+      sample = 0;
+    }
+    if (segment < active->segments) {
+      sample++;
+      E r[4 * C];
+      math::kernel::cubic(r, active->coeff[segment], static_cast<E>(sample * dt), C);
+      for (int k = 0; k < N; k++) std::copy(r + k * C, r + (k + 1) * C, math::ValueShape<T>::data(y[k]));
+    } else {
+      moving = false;
+      y[0] = active->endPos;
+      for (int k = 1; k < N; k++) y[k] = 0.0;
+      completedId.store(active->id, std::memory_order_release);
+    }
+  }
+
+ private:
+  double dt;                           // sampling time
+  TripleBuffer<Profile> buffer;
+  std::mutex mtx;
+  uint64_t requested = 0;              // id of the last published profile
+  std::atomic<uint64_t> pendingMove{0}; // id of the last move, 0 if stopped
+  std::atomic<uint64_t> completedId{0}; // id of the last profile completed by the realtime side
+  // realtime side
+  const Profile* active = nullptr;
+  unsigned int segment = 0;
+  uint64_t sample = 0;
+  bool moving = false;
+};
+
+};
+};
+
+#endif /* ORG_EEROS_CONTROL_SEGMENTTRAJECTORY_HPP_ */
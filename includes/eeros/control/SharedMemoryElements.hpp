@@ -0,0 +1,41 @@
+#ifndef ORG_EEROS_CONTROL_SHAREDMEMORYELEMENTS_HPP_
+#define ORG_EEROS_CONTROL_SHAREDMEMORYELEMENTS_HPP_
+
+#include <eeros/math/Matrix.hpp>
+#include <type_traits>
+
+namespace eeros {
+namespace control {
+
+/**
+ * Maps a signal value to the plain elements stored in a signal channel.
+ * Only the elements are transferred, never the object itself, so that no
+ * process specific data like the virtual table pointer of a matrix ends up
+ * in shared memory.
+ *
+ * @tparam T - signal type, arithmetic or matrix
+ * @since v1.4.4
+ */
+template < typename T, typename Enable = void >
+struct SharedMemoryElements;
+
+template < typename T >
+struct SharedMemoryElements<T, typename std::enable_if<std::is_arithmetic<T>::value>::type> {
+  using Element = T;
+  static constexpr uint32_t count = 1;
+  static void put(const T& value, Element* data) { data[0] = value; }
+  static void get(T& value, const Element* data) { value = data[0]; }
+};
+
+template < unsigned int M, unsigned int N, typename E >
+struct SharedMemoryElements<math::Matrix<M, N, E>> {
+  using Element = E;
+  static constexpr uint32_t count = M * N;
+  static void put(const math::Matrix<M, N, E>& value, Element* data) { for (uint32_t i = 0; i < count; i++) data[i] = value(i); }
+  static void get(math::Matrix<M, N, E>& value, const Element* data) { for (uint32_t i = 0; i < count; i++) value(i) = data[i]; }
+};
+
+}
+}
+
+#endif // ORG_EEROS_CONTROL_SHAREDMEMORYELEMENTS_HPP_
@@ -0,0 +1,86 @@
+#ifndef ORG_EEROS_CONTROL_SHAREDMEMORYINPUT_HPP_
+#define ORG_EEROS_CONTROL_SHAREDMEMORYINPUT_HPP_
+
+#include <eeros/control/Blockio.hpp>
+#include <eeros/control/SharedMemoryElements.hpp>
+#include <eeros/core/SignalChannel.hpp>
+#include <array>
+#include <string>
+
+namespace eeros {
+namespace control {
+
+/**
+ * This block reads a signal from a named shared memory channel, which is written 
+ * by a SharedMemoryOutput block in another process on the same host. The output
+ * signal carries the value and the timestamp of the latest write. As long as 
+ * nothing was written, the output keeps its initial value.
+ *
+ * @tparam SigOutType - type of the output signal, arithmetic or matrix (double - default type)
+ * @see SharedMemoryOutput
+ * @since v1.4.4
+ */
+template < typename SigOutType = double >
+class SharedMemoryInput : public Blockio<0,1,SigOutType> {
+  using Elements = SharedMemoryElements<SigOutType>;
+
+ public:
+  /**
+   * Constructs a shared memory input block.
+   *
+   * @param name - name of the channel, e.g. "/eeros_setpoint"
+   */
+  SharedMemoryInput(std::string name) : channel(name, sizeof(typename Elements::Element), Elements::count) { }
+
+  /**
+   * Disabling use of copy constructor because the block should never be copied unintentionally.
+   */
+  SharedMemoryInput(const SharedMemoryInput& s) = delete;
+
+  /**
+   * Runs the reading algorithm.
+   */
+  virtual void run() {
+    uint64_t timestamp;
+    uint32_t seq;
+    newData = false;
+    if (!channel.read(data.data(), timestamp, seq)) return;
+    newData = (seq != sequence);
+    sequence = seq;
+    SigOutType value;
+    Elements::get(value, data.data());
+    this->out.getSignal().setValue(value);
+    this->out.getSignal().setTimestamp(timestamp);
+  }
+
+  /**
+   * Returns true if the last run has read a value, which was not read before.
+   *
+   * @return true, if new data was received
+   */
+  virtual bool isNew() {
+    return newData;
+  }
+
+ private:
+  SignalChannel channel;
+  std::array<typename Elements::Element, Elements::count> data;
+  uint32_t sequence = 0;
+  bool newData = false;
+};
+
+/**
+ * Operator overload (<<) to enable an easy way to print the state of a
+ * shared memory input instance to an output stream.\n
+ * Does not print a newline control character.
+ */
+template < typename T >
+std::ostream& operator<<(std::ostream& os, SharedMemoryInput<T>& b) {
+  os << "Block shared memory input: '" << b.getName() << "'"; 
+  return os;
+}
+
+}
+}
+
+#endif // ORG_EEROS_CONTROL_SHAREDMEMORYINPUT_HPP_
@@ -0,0 +1,68 @@
+#ifndef ORG_EEROS_CONTROL_SHAREDMEMORYOUTPUT_HPP_
+#define ORG_EEROS_CONTROL_SHAREDMEMORYOUTPUT_HPP_
+
+#include <eeros/control/Blockio.hpp>
+#include <eeros/control/SharedMemoryElements.hpp>
+#include <eeros/core/SignalChannel.hpp>
+#include <array>
+#include <string>
+
+namespace eeros {
+namespace control {
+
+/**
+ * This block publishes its input signal into a named shared memory channel, from where
+ * a SharedMemoryInput block in another process on the same host reads it. In contrast to 
+ * SocketData no network stack is involved, a transfer costs a copy of the signal elements.
+ * The block never blocks, the value and its timestamp are protected by a sequence lock.
+ * There must be only one output block per channel.
+ *
+ * @tparam SigInType - type of the input signal, arithmetic or matrix (double - default type)
+ * @see SharedMemoryInput
+ * @since v1.4.4
+ */
+template < typename SigInType = double >
+class SharedMemoryOutput : public Blockio<1,0,SigInType> {
+  using Elements = SharedMemoryElements<SigInType>;
+
+ public:
+  /**
+   * Constructs a shared memory output block.
+   *
+   * @param name - name of the channel, e.g. "/eeros_setpoint"
+   */
+  SharedMemoryOutput(std::string name) : channel(name, sizeof(typename Elements::Element), Elements::count) { }
+
+  /**
+   * Disabling use of copy constructor because the block should never be copied unintentionally.
+   */
+  SharedMemoryOutput(const SharedMemoryOutput& s) = delete;
+
+  /**
+   * Runs the publishing algorithm.
+   */
+  virtual void run() {
+    Elements::put(this->in.getSignal().getValue(), data.data());
+    channel.write(data.data(), this->in.getSignal().getTimestamp());
+  }
+
+ private:
+  SignalChannel channel;
+  std::array<typename Elements::Element, Elements::count> data;
+};
+
+/**
+ * Operator overload (<<) to enable an easy way to print the state of a
+ * shared memory output instance to an output stream.\n
+ * Does not print a newline control character.
+ */
+template < typename T >
+std::ostream& operator<<(std::ostream& os, SharedMemoryOutput<T>& b) {
+  os << "Block shared memory output: '" << b.getName() << "'"; 
+  return os;
+}
+
+}
+}
+
+#endif // ORG_EEROS_CONTROL_SHAREDMEMORYOUTPUT_HPP_
@@ -5,17 +5,38 @@
 #include <list>
 #include <type_traits>
 #include <limits>
+#include <sstream>
+#include <typeinfo>
+#include <eeros/config.hpp>
 #include <eeros/types.hpp>
+#include <eeros/math/Fixed.hpp>
 #include <eeros/control/SignalInterface.hpp>
+#include <eeros/control/SignalRegistry.hpp>
+
+/**
+ * With EEROS_FINAL_SIGNALS the accessors of a signal cannot be overridden, 
+ * which allows the compiler to inline them.
+ */
+#ifdef EEROS_FINAL_SIGNALS
+#define EEROS_SIGNAL_FINAL final
+#else
+#define EEROS_SIGNAL_FINAL
+#endif
 
 namespace eeros {
 namespace control {
-    
-extern uint16_t signalCounter;
+
+template < typename T, typename = void >
+struct isPrintable : std::false_type { };
+
+template < typename T >
+struct isPrintable<T, std::void_t<decltype(std::declval<std::ostream&>() << std::declval<const T&>())>> : std::true_type { };
       
 /**
  * A signal comprises several properties such as a value and a timestamp.
  * It is used to transport information between blocks of a control system.
+ * The name is kept in the signal registry, so a signal only holds the data
+ * accessed in the cycle.
  *
  * @tparam T - signal type (double - default type)
  * @since v0.4
@@ -25,10 +46,24 @@ template < typename T = double >
 class Signal : public SignalInterface {
  public:
   /**
-   * Constructs a signal instance.
+   * Constructs a signal instance and registers it with the signal registry.
+   */
+  Signal() : registered(true) {
+    id = SignalRegistry::instance().add(this);
+  }
+
+  /**
+   * Constructs a copy of a signal, e.g. to keep a previous value. The copy has the id 
+   * and name of the original, but is not registered, which keeps copying cheap.
+   * The name of the copy is available as long as the original exists.
    */
-  Signal() {
-   id = signalCounter++;
+  Signal(const Signal<T>& s) : value(s.value), timestamp(s.timestamp), id(s.id), registered(false) { }
+
+  /**
+   * Removes the signal from the signal registry.
+   */
+  virtual ~Signal() {
+    if (registered) SignalRegistry::instance().remove(id);
   }
       
   /**
@@ -37,7 +72,7 @@ class Signal : public SignalInterface {
    * @return id
    */
   virtual sigid_t getId() const {
-    return static_cast<sigid_t>(id) << 16;
+    return id;
   }
       
   /**
@@ -46,16 +81,16 @@ class Signal : public SignalInterface {
    * @return name
    */
   virtual std::string getName() const {
-    return name;
+    return SignalRegistry::instance().getName(id);
   }
       
   /**
-   * Sets the name of this signal.
+   * Sets the name of this signal. A copy cannot be renamed.
    * 
    * @param name - name of the signal
    */
   virtual void setName(std::string name) {
-    this->name = name;
+    if (registered) SignalRegistry::instance().setName(id, name);
   }
       
       virtual std::string getLabel() const {
@@ -68,7 +103,7 @@ class Signal : public SignalInterface {
 // 					label << " [" << getUnit(index) << ']';
 // 				}
 // 				return label.str();
-        return name; // TODO
+        return getName(); // TODO
       }
       
   /**
@@ -76,7 +111,7 @@ class Signal : public SignalInterface {
    * 
    * @return value
    */
-  virtual T getValue() const {
+  virtual T getValue() const EEROS_SIGNAL_FINAL {
     return value;
   }
       
@@ -85,8 +120,9 @@ class Signal : public SignalInterface {
    * 
    * @param newValue - value of the signal
    */
-  virtual void setValue(T newValue) {
+  virtual void setValue(T newValue) EEROS_SIGNAL_FINAL {
     value = newValue;
+    this->version++;
   }
       
 //       template < typename VT >
@@ -99,7 +135,7 @@ class Signal : public SignalInterface {
    * 
    * @return timestamp
    */
-  virtual timestamp_t getTimestamp() const {
+  virtual timestamp_t getTimestamp() const EEROS_SIGNAL_FINAL {
     return timestamp;
   }
       
@@ -108,25 +144,70 @@ class Signal : public SignalInterface {
    * 
    * @param newTimestamp - timestamp of the signal
    */
-  virtual void setTimestamp(timestamp_t newTimestamp) {
+  virtual void setTimestamp(timestamp_t newTimestamp) EEROS_SIGNAL_FINAL {
     timestamp = newTimestamp;
   }
+
+  /**
+   * Gets a reference to the value of this signal without a virtual call
+   * and without copying the value, which matters for large matrices.
+   * 
+   * @return value
+   */
+  const T& getValueRef() const {
+    return value;
+  }
+
+  /**
+   * Sets the value and the timestamp of this signal without a virtual call.
+   * 
+   * @param newValue - value of the signal
+   * @param newTimestamp - timestamp of the signal
+   */
+  void set(const T& newValue, timestamp_t newTimestamp) {
+    value = newValue;
+    timestamp = newTimestamp;
+    this->version++;
+  }
+
+  /**
+   * Gets the type of the value of this signal.
+   * 
+   * @return type
+   */
+  virtual const std::type_info& getType() const {
+    return typeid(T);
+  }
+
+  /**
+   * Gets the value of this signal as text.
+   * 
+   * @return value
+   */
+  virtual std::string getValueString() const {
+    std::stringstream s;
+    if constexpr (isPrintable<T>::value) s << value;
+    return s.str();
+  }
       
   /**
    * Clears the signal to NaN.
    */
   virtual void clear() {
     _clear<T>();
+    this->version++;
   }
       
-  Signal<T>& operator= (Signal<T> right) {
+  Signal<T>& operator= (const Signal<T>& right) {
     value = right.value;
     timestamp = right.timestamp;
+    this->version++;
     return *this;
   }
       
   Signal<T>& operator= (T right) {
     value = right;
+    this->version++;
     return *this;
   }
       
@@ -134,26 +215,34 @@ class Signal : public SignalInterface {
     return illegalSignal;
   }
       
+  /**
+   * Gets all registered signals of this type.
+   * 
+   * @return signals
+   */
   static std::list<SignalInterface*> getSignalList() {
-    return signalList;
+    std::list<SignalInterface*> signals;
+    for (auto s : SignalRegistry::instance().getSignals()) {
+      if (dynamic_cast<Signal<T>*>(s) != nullptr) signals.push_back(s);
+    }
+    return signals;
   }
       
+  /**
+   * Looks up a signal by its id in the signal registry.
+   * 
+   * @param id - id as returned by getId()
+   * @return signal or nullptr if there is no signal with this id
+   */
   static SignalInterface* getSignalById(sigid_t id) {
-    std::list<SignalInterface*>::iterator i = signalList.begin();
-    while(i != signalList.end()) {
-      if((*i)->getId() == id) {
-        return (*i);
-      }
-      i++;
-    }
-    return NULL;
+    return SignalRegistry::instance().get(id);
   }
       
  protected:
   T value; /** The value carries the signal value, it can be of any physical type */
   timestamp_t timestamp; /** The timestamp marks the time when this signal was captured */
   sigid_t id; /** Each signal has an unique id which is assigned automatically upon creation */
-  std::string name; /** Each signal can be named */
+  bool registered; /** Copies are not registered */
     
  private:
   template <typename S> typename std::enable_if<std::is_integral<S>::value>::type _clear() {
@@ -164,6 +253,10 @@ class Signal : public SignalInterface {
     value = std::numeric_limits<double>::quiet_NaN();
     timestamp = 0;
   }
+  template <typename S> typename std::enable_if<math::isFixed<S>::value>::type _clear() {
+    value = S::lowest();
+    timestamp = 0;
+  }
   template <typename S> typename std::enable_if<std::is_compound<S>::value && std::is_integral<typename S::value_type>::value>::type _clear() {
     value.fill(std::numeric_limits<typename S::value_type>::min());
     timestamp = 0;
@@ -177,13 +270,9 @@ class Signal : public SignalInterface {
     timestamp = 0;
   }
       
-  static std::list<SignalInterface*> signalList;
   static Signal<T> illegalSignal;
 };
     
-template < typename T>
-std::list<SignalInterface*> Signal<T>::signalList;
-    
 template < typename T>
 Signal<T> Signal<T>::illegalSignal;
   
@@ -91,7 +91,7 @@ class SignalChecker : public Blockio<1,0,Tsig> {
             if (activeLevel == nullptr ||
             (activeLevel != nullptr && safetySystem->getCurrentLevel() >= *activeLevel)
             ) {
-              log.warn() << "Signal checker \'" + this->getName() + "\' fires!";
+              EEROS_HOTPATH_LOG(log.warn() << "Signal checker \'" << this->getName() << "\' fires!");
               safetySystem->triggerEvent(*safetyEvent);
               fired = true;
             }
@@ -103,7 +103,7 @@ class SignalChecker : public Blockio<1,0,Tsig> {
             if (activeLevel == nullptr ||
             (activeLevel != nullptr && safetySystem->getCurrentLevel() >= *activeLevel)
             ) {
-              log.warn() << "Signal checker \'" + this->getName() + "\' fires!";
+              EEROS_HOTPATH_LOG(log.warn() << "Signal checker \'" << this->getName() << "\' fires!");
               safetySystem->triggerEvent(*safetyEvent);
               fired = true;
             }
@@ -4,6 +4,8 @@
 #include <string>
 #include <sstream>
 #include <vector>
+#include <typeinfo>
+#include <cstdint>
 #include <eeros/types.hpp>
 
 namespace eeros {
@@ -13,12 +15,44 @@ namespace eeros {
 		
 		class SignalInterface {
 		public:
+			virtual ~SignalInterface() { }
       
 			virtual sigid_t getId() const = 0;
 			
 			virtual std::string getName() const = 0;
 			
 			virtual std::string getLabel() const = 0;
+			
+			virtual timestamp_t getTimestamp() const = 0;
+			
+			/**
+			 * Gets the type of the signal value, which allows generic tools to
+			 * handle signals without knowing their type at compile time.
+			 * 
+			 * @return type of the value
+			 */
+			virtual const std::type_info& getType() const = 0;
+			
+			/**
+			 * Gets the value of the signal as text.
+			 * 
+			 * @return value
+			 */
+			virtual std::string getValueString() const = 0;
+			
+			/**
+			 * Gets the version of the signal, which is incremented each time the
+			 * value is written. Writing the timestamp only keeps the version.
+			 * 
+			 * @return version
+			 * @see TimeDomain::setChangePropagation()
+			 */
+			uint64_t getVersion() const {
+				return version;
+			}
+			
+		protected:
+			uint64_t version = 0;
 		};
 	};
 };
@@ -0,0 +1,145 @@
+#ifndef ORG_EEROS_CONTROL_SIGNALREGISTRY_HPP_
+#define ORG_EEROS_CONTROL_SIGNALREGISTRY_HPP_
+
+#include <atomic>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <eeros/types.hpp>
+#include <eeros/control/SignalInterface.hpp>
+
+namespace eeros {
+namespace control {
+
+/**
+ * The signal registry knows all signals of the application. Signals register 
+ * themselves upon creation and are removed upon destruction. A signal can be looked
+ * up by its id or by its name in constant time, which allows generic tools such as
+ * an HMI or a socket bridge to bind to signals without knowing their types at 
+ * compile time. Lookups can be done concurrently from several threads.
+ *
+ * Ids are taken from a 64 bit counter and are never reused.
+ *
+ * The registry also holds the names of the signals. Names are only needed by
+ * tools and for logging, keeping them out of the signal leaves the value and
+ * the timestamp, which are accessed in every cycle, close together.
+ *
+ * @since v1.4.4
+ */
+class SignalRegistry {
+ public:
+  /**
+   * Returns the registry of the application.
+   *
+   * @return registry
+   */
+  static SignalRegistry& instance();
+
+  /**
+   * Registers a signal and assigns it a new id.
+   *
+   * @param signal - signal
+   * @return id of the signal
+   */
+  sigid_t add(SignalInterface* signal);
+
+  /**
+   * Removes a signal.
+   *
+   * @param id - id of the signal
+   */
+  void remove(sigid_t id);
+
+  /**
+   * Changes the name a signal can be looked up with. If several signals have 
+   * the same name, the one which got the name first is found.
+   *
+   * @param id - id of the signal
+   * @param name - new name of the signal
+   */
+  void setName(sigid_t id, const std::string& name);
+
+  /**
+   * Gets the name of a signal.
+   *
+   * @param id - id of the signal
+   * @return name, empty if there is no signal with this id
+   */
+  std::string getName(sigid_t id) const;
+
+  /**
+   * Looks up a signal by its id.
+   *
+   * @param id - id of the signal
+   * @return signal or nullptr if there is no signal with this id
+   */
+  SignalInterface* get(sigid_t id) const;
+
+  /**
+   * Looks up a signal by its name.
+   *
+   * @param name - name of the signal
+   * @return signal or nullptr if there is no signal with this name
+   */
+  SignalInterface* get(const std::string& name) const;
+
+  /**
+   * Looks up a signal by its id and checks its type, e.g. get<Signal<double>>(id).
+   *
+   * @tparam S - signal type
+   * @param id - id of the signal
+   * @return signal or nullptr if there is no signal of this type with this id
+   */
+  template < typename S >
+  S* get(sigid_t id) const {
+    return dynamic_cast<S*>(get(id));
+  }
+
+  /**
+   * Looks up a signal by its name and checks its type, e.g. get<Signal<double>>("x").
+   *
+   * @tparam S - signal type
+   * @param name - name of the signal
+   * @return signal or nullptr if there is no signal of this type with this name
+   */
+  template < typename S >
+  S* get(const std::string& name) const {
+    return dynamic_cast<S*>(get(name));
+  }
+
+  /**
+   * Returns all registered signals.
+   *
+   * @return signals
+   */
+  std::vector<SignalInterface*> getSignals() const;
+
+  /**
+   * Returns the number of registered signals.
+   *
+   * @return number of signals
+   */
+  std::size_t size() const;
+
+  SignalRegistry(const SignalRegistry&) = delete;
+  SignalRegistry& operator=(const SignalRegistry&) = delete;
+
+ private:
+  SignalRegistry();
+
+  struct Entry {
+    SignalInterface* signal;
+    std::string name;
+  };
+
+  std::atomic<sigid_t> nextId;
+  mutable std::shared_mutex mtx;
+  std::unordered_map<sigid_t, Entry> byId;
+  std::unordered_map<std::string, SignalInterface*> byName;
+};
+
+}
+}
+
+#endif // ORG_EEROS_CONTROL_SIGNALREGISTRY_HPP_
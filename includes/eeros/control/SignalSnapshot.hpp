@@ -0,0 +1,167 @@
+#ifndef ORG_EEROS_CONTROL_SIGNALSNAPSHOT_HPP_
+#define ORG_EEROS_CONTROL_SIGNALSNAPSHOT_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include <eeros/control/Output.hpp>
+#include <eeros/control/Signal.hpp>
+#include <eeros/core/Fault.hpp>
+
+namespace eeros {
+namespace control {
+
+/**
+ * A signal snapshot publishes the values and timestamps of a set of signals,
+ * e.g. for a HMI or for telemetry, which read them on a non realtime thread.
+ * A timedomain with a snapshot (see TimeDomain::setSnapshot()) captures it at
+ * the end of each run, so a snapshot holds all signals of the same cycle.
+ *
+ * The snapshot is a sequence lock: capturing copies the selected signals into
+ * one buffer between two increments of a sequence counter. It never waits and
+ * never allocates. Any number of readers copy the buffer into their own view
+ * and retry if a capture overlapped the copy, they never block the timedomain.
+ *
+ * All signals must be added before the timedomain runs. The values are copied
+ * bytewise, so they must be plain values which own no resources, e.g.
+ * arithmetic types or matrices.
+ *
+ * @since v1.4.4
+ */
+class SignalSnapshot {
+ public:
+  /**
+   * Position of a signal in the snapshot, returned by add().
+   *
+   * @tparam T - value type of the signal
+   */
+  template < typename T >
+  class Entry {
+   public:
+    Entry() : offset(0) { }
+
+   private:
+    friend class SignalSnapshot;
+    explicit Entry(std::size_t offset) : offset(offset) { }
+    std::size_t offset;
+  };
+
+  /**
+   * Copy of a snapshot owned by one reader, filled in by read().
+   */
+  class View {
+   public:
+    /**
+     * Returns the value of a signal.
+     *
+     * @param e - entry of the signal
+     * @return value
+     */
+    template < typename T >
+    T getValue(Entry<T> e) const {
+      T value;
+      std::memcpy(static_cast<void*>(&value), data.data() + e.offset + sizeof(timestamp_t), sizeof(T));
+      return value;
+    }
+
+    /**
+     * Returns the timestamp of a signal.
+     *
+     * @param e - entry of the signal
+     * @return timestamp
+     */
+    template < typename T >
+    timestamp_t getTimestamp(Entry<T> e) const {
+      timestamp_t t;
+      std::memcpy(&t, data.data() + e.offset, sizeof(timestamp_t));
+      return t;
+    }
+
+    /**
+     * Returns the number of the cycle the view was captured in, starting with 1.
+     *
+     * @return cycle, 0 if nothing was captured yet
+     */
+    uint64_t getCycle() const {
+      return cycle;
+    }
+
+   private:
+    friend class SignalSnapshot;
+    std::vector<unsigned char> data;
+    uint64_t cycle = 0;
+  };
+
+  /**
+   * Adds a signal to the snapshot.
+   *
+   * @param signal - signal
+   * @return entry to read the signal from a view
+   */
+  template < typename T >
+  Entry<T> add(const Signal<T>& signal) {
+    static_assert(std::is_trivially_destructible<T>::value, "only signals of plain values, e.g. arithmetic types or matrices, can be captured");
+    if (sequence.load(std::memory_order_relaxed) != 0) throw Fault("signals cannot be added to a snapshot which was already captured");
+    std::size_t offset = buffer.size();
+    buffer.resize(offset + sizeof(timestamp_t) + sizeof(T));
+    copies.push_back({&signal, offset, [](const void* s, unsigned char* dst) {
+      const Signal<T>& sig = *static_cast<const Signal<T>*>(s);
+      timestamp_t t = sig.getTimestamp();
+      std::memcpy(dst, &t, sizeof(timestamp_t));
+      std::memcpy(dst + sizeof(timestamp_t), &sig.getValueRef(), sizeof(T));
+    }});
+    return Entry<T>(offset);
+  }
+
+  /**
+   * Adds the signal of an output to the snapshot.
+   *
+   * @param output - output
+   * @return entry to read the signal from a view
+   */
+  template < typename T >
+  Entry<T> add(Output<T>& output) {
+    return add(output.getSignal());
+  }
+
+  /**
+   * Copies all signals into the snapshot. Called by the timedomain at the end
+   * of each run, must not be called from more than one thread.
+   */
+  void capture();
+
+  /**
+   * Copies the last captured snapshot into a view. Retries as long as a capture
+   * overlaps the copy, at most the given number of times.
+   *
+   * @param view - view of the reader
+   * @param tries - maximum number of attempts
+   * @return true, if the view holds a consistent snapshot
+   */
+  bool read(View& view, unsigned int tries = 100) const;
+
+  /**
+   * Returns the number of captures.
+   *
+   * @return number of the last captured cycle
+   */
+  uint64_t getCycle() const;
+
+ private:
+  struct Copy {
+    const void* signal;
+    std::size_t offset;
+    void (*copy)(const void*, unsigned char*);
+  };
+
+  std::vector<Copy> copies;
+  std::vector<unsigned char> buffer;
+  std::atomic<uint64_t> sequence{0};   // odd while a capture is in progress
+};
+
+}
+}
+
+#endif // ORG_EEROS_CONTROL_SIGNALSNAPSHOT_HPP_
@@ -23,6 +23,13 @@ class SocketData: public Blockio<1,1,SigInType, SigOutType> { };
  * The connection is established automatically as soon as a server is alive an a client is starting.
  * When one of the two partners stops, the connection is broken. It is automatically re-
  * establed as soon as both are running again.
+ * With \ref Protocol::udp each period one datagram with a sequence number and a 
+ * timestamp is sent. Only the newest datagram received is used, losses and 
+ * reordering are counted, see getStatistics().
+ * With \ref Protocol::multicast a block SocketData<T, std::nullptr_t> publishes its
+ * input to the group address given as serverIP once per period, and any number of 
+ * blocks SocketData<std::nullptr_t, T> with the same group address and port receive it.
+ * The load of the publisher does not grow with the number of subscribers.
  * 
  * @tparam SigInType - type of the input signal (double - default type)
  * @tparam SigOutType - type of the output signal (double - default type)
@@ -42,15 +49,18 @@ class SocketData<SigInType, SigOutType,
    * @param port - port number, server and client must be opened on the same port number
    * @param period - period in s which the thread polls the connection
    * @param timeout - connection timeout time in s 
+   * @param protocol - TCP, or UDP with one datagram per period, the newest one is used, or UDP multicast
+   * @param options - socket options, e.g. to send as soon as the block ran
    */
-  SocketData(std::string serverIP, uint16_t port, double period = 0.01, double timeout = 1.0) {
-    bufInLen = sizeof(SigInType) / sizeof(SigInValueType);
-    bufOutLen = sizeof(SigOutType) / sizeof(SigOutValueType);
+  SocketData(std::string serverIP, uint16_t port, double period = 0.01, double timeout = 1.0, Protocol protocol = Protocol::tcp,
+             SocketOptions options = SocketOptions()) {
+    bufInLen = SigInType::nofElements;
+    bufOutLen = SigOutType::nofElements;
     isServer = serverIP.empty();
     if (isServer)
-      server = new SocketServer<sizeof(SigInType) / sizeof(SigInValueType), SigInValueType, sizeof(SigOutType) / sizeof(SigOutValueType), SigOutValueType>(port, period, timeout);
+      server = new SocketServer<SigInType::nofElements, SigInValueType, SigOutType::nofElements, SigOutValueType>(port, period, timeout, 5, 8, protocol, options);
     else 
-      client = new SocketClient<sizeof(SigInType) / sizeof(SigInValueType), SigInValueType, sizeof(SigOutType) / sizeof(SigOutValueType), SigOutValueType>(serverIP, port, period, timeout);;
+      client = new SocketClient<SigInType::nofElements, SigInValueType, SigOutType::nofElements, SigOutValueType>(serverIP, port, period, timeout, 5, protocol, options);
   }
   
   /**
@@ -68,13 +78,14 @@ class SocketData<SigInType, SigOutType,
    *
    */
   virtual void run() {
-    // receive
+    // receive, the time is read first so it is never newer than the data
+    uint64_t received = isServer ? server->getReceiveTime() : client->getReceiveTime();
     SigOutType output; 
     if (isServer) {
-      std::array<SigOutValueType, sizeof(SigOutType) / sizeof(SigOutValueType)>& getData = server->getReceiveBuffer();
+      const std::array<SigOutValueType, SigOutType::nofElements>& getData = server->getReceiveBuffer();
       for (uint32_t i = 0; i < bufOutLen; i++) output(i) = getData[i];
     } else {
-      std::array<SigOutValueType, sizeof(SigOutType) / sizeof(SigOutValueType)>& getData = client->getReceiveBuffer();
+      const std::array<SigOutValueType, SigOutType::nofElements>& getData = client->getReceiveBuffer();
       for (uint32_t i = 0; i < bufOutLen; i++) output(i) = getData[i];
     }
     // send
@@ -85,7 +96,7 @@ class SocketData<SigInType, SigOutType,
     }
     
     this->out.getSignal().setValue(output);
-    timestamp_t time = System::getTimeNs();
+    timestamp_t time = received != 0 ? received : System::getTimeNs();
     this->out.getSignal().setTimestamp(time);
   }
   
@@ -100,14 +111,34 @@ class SocketData<SigInType, SigOutType,
    * return true, if new data has arrived
    */
   virtual bool isNew() {
-    if (isServer) return server->newData; else return client->newData;
+    return getSequence() != seen;
+  }
+
+  /**
+   * Returns the counters of received, lost and reordered datagrams.
+   * Only counted with \ref Protocol::udp.
+   * 
+   * @return counters
+   */
+  virtual DatagramStatistics getStatistics() {
+    if (isServer) return server->getStatistics(); else return client->getStatistics();
   }
 
   /**
    * Use this function to reset the new data flag back to false.
    */
   virtual void resetNew() {
-    if (isServer) server->newData = false; else client->newData = false;
+    seen = getSequence();
+  }
+
+  /**
+   * Returns the number of messages received so far. The counter is also
+   * incremented when the buffer is cleared because the connection broke.
+   *
+   * @return sequence counter
+   */
+  virtual uint64_t getSequence() {
+    if (isServer) return server->getSequence(); else return client->getSequence();
   }
   
   /**
@@ -132,11 +163,12 @@ class SocketData<SigInType, SigOutType,
  private:
   typedef typename SigInType::value_type SigInValueType;
   typedef typename SigOutType::value_type SigOutValueType;
-  SocketServer<sizeof(SigInType) / sizeof(SigInValueType), SigInValueType, sizeof(SigOutType) / sizeof(SigOutValueType), SigOutValueType>* server;
-  SocketClient<sizeof(SigInType) / sizeof(SigInValueType), SigInValueType, sizeof(SigOutType) / sizeof(SigOutValueType), SigOutValueType>* client;
-  std::array<SigInValueType, sizeof(SigInType) / sizeof(SigInValueType)> sendData;
+  SocketServer<SigInType::nofElements, SigInValueType, SigOutType::nofElements, SigOutValueType>* server;
+  SocketClient<SigInType::nofElements, SigInValueType, SigOutType::nofElements, SigOutValueType>* client;
+  std::array<SigInValueType, SigInType::nofElements> sendData;
   uint32_t bufInLen, bufOutLen;
   bool isServer;
+  uint64_t seen = 0;
 };
 
 template < typename SigInType, typename SigOutType >
@@ -144,26 +176,28 @@ class SocketData<SigInType, SigOutType,
   typename std::enable_if<std::is_arithmetic<SigInType>::value && std::is_compound<SigOutType>::value>::type> 
   : public Blockio<1,1,SigInType, SigOutType> {			
 public:
-  SocketData(std::string serverIP, uint16_t port, double period = 0.01, double timeout = 1.0) {
+  SocketData(std::string serverIP, uint16_t port, double period = 0.01, double timeout = 1.0, Protocol protocol = Protocol::tcp,
+             SocketOptions options = SocketOptions()) {
     bufInLen = 1;
-    bufOutLen = sizeof(SigOutType) / sizeof(SigOutValueType);
+    bufOutLen = SigOutType::nofElements;
     isServer = serverIP.empty();
     if (isServer)
-      server =  new SocketServer<1, SigInType, sizeof(SigOutType) / sizeof(SigOutValueType), SigOutValueType>(port, period, timeout);
+      server =  new SocketServer<1, SigInType, SigOutType::nofElements, SigOutValueType>(port, period, timeout, 5, 8, protocol, options);
     else
-      client =  new SocketClient<1, SigInType, sizeof(SigOutType) / sizeof(SigOutValueType), SigOutValueType>(serverIP, port, period, timeout);
+      client =  new SocketClient<1, SigInType, SigOutType::nofElements, SigOutValueType>(serverIP, port, period, timeout, 5, protocol, options);
   }
   
   virtual ~SocketData() {if (isServer) server->stop(); else client->stop();}
         
   virtual void run() {
-    // receive
+    // receive, the time is read first so it is never newer than the data
+    uint64_t received = isServer ? server->getReceiveTime() : client->getReceiveTime();
     SigOutType output; 
     if (isServer) {
-      std::array<SigOutValueType, sizeof(SigOutType) / sizeof(SigOutValueType)>& getData = server->getReceiveBuffer();
+      const std::array<SigOutValueType, SigOutType::nofElements>& getData = server->getReceiveBuffer();
       for (uint32_t i = 0; i < bufOutLen; i++) output(i) = getData[i];
     } else {
-      std::array<SigOutValueType, sizeof(SigOutType) / sizeof(SigOutValueType)>& getData = client->getReceiveBuffer();
+      const std::array<SigOutValueType, SigOutType::nofElements>& getData = client->getReceiveBuffer();
       for (uint32_t i = 0; i < bufOutLen; i++) output(i) = getData[i];
     }
     
@@ -175,16 +209,30 @@ public:
     }
     
     this->out.getSignal().setValue(output);
-    timestamp_t time = System::getTimeNs();
+    timestamp_t time = received != 0 ? received : System::getTimeNs();
     this->out.getSignal().setTimestamp(time);
   }
   
   virtual bool isNew() {
-    if (isServer) return server->newData; else return client->newData;
+    return getSequence() != seen;
+  }
+
+  virtual DatagramStatistics getStatistics() {
+    if (isServer) return server->getStatistics(); else return client->getStatistics();
   }
 
   virtual void resetNew() {
-    if (isServer) server->newData = false; else client->newData = false;
+    seen = getSequence();
+  }
+
+  /**
+   * Returns the number of messages received so far. The counter is also
+   * incremented when the buffer is cleared because the connection broke.
+   *
+   * @return sequence counter
+   */
+  virtual uint64_t getSequence() {
+    if (isServer) return server->getSequence(); else return client->getSequence();
   }
   
   virtual bool isConnected() {
@@ -197,11 +245,12 @@ public:
 
  private:
   typedef typename SigOutType::value_type SigOutValueType;
-  SocketServer<1, SigInType, sizeof(SigOutType) / sizeof(SigOutValueType), SigOutValueType>* server;
-  SocketClient<1, SigInType, sizeof(SigOutType) / sizeof(SigOutValueType), SigOutValueType>* client;
+  SocketServer<1, SigInType, SigOutType::nofElements, SigOutValueType>* server;
+  SocketClient<1, SigInType, SigOutType::nofElements, SigOutValueType>* client;
   std::array<SigInType, 1> sendData;;
   uint32_t bufInLen, bufOutLen;
   bool isServer;
+  uint64_t seen = 0;
 };
 
 template < typename SigInType, typename SigOutType >
@@ -209,26 +258,28 @@ class SocketData<SigInType, SigOutType,
   typename std::enable_if<std::is_compound<SigInType>::value && std::is_arithmetic<SigOutType>::value>::type> 
   : public Blockio<1,1,SigInType, SigOutType> {			
 public:
-  SocketData(std::string serverIP, uint16_t port, double period = 0.01, double timeout = 1.0) {
-    bufInLen = sizeof(SigInType) / sizeof(SigInValueType);
+  SocketData(std::string serverIP, uint16_t port, double period = 0.01, double timeout = 1.0, Protocol protocol = Protocol::tcp,
+             SocketOptions options = SocketOptions()) {
+    bufInLen = SigInType::nofElements;
     bufOutLen = 1;
     isServer = serverIP.empty();
     if (isServer)
-      server =  new SocketServer<sizeof(SigInType) / sizeof(SigInValueType), SigInValueType, 1, SigOutType>(port, period, timeout);
+      server =  new SocketServer<SigInType::nofElements, SigInValueType, 1, SigOutType>(port, period, timeout, 5, 8, protocol, options);
     else
-      client =  new SocketClient<sizeof(SigInType) / sizeof(SigInValueType), SigInValueType, 1, SigOutType>(serverIP, port, period, timeout);
+      client =  new SocketClient<SigInType::nofElements, SigInValueType, 1, SigOutType>(serverIP, port, period, timeout, 5, protocol, options);
   }
   
   virtual ~SocketData() {if (isServer) server->stop(); else client->stop();}
         
   virtual void run() {
-    // receive
+    // receive, the time is read first so it is never newer than the data
+    uint64_t received = isServer ? server->getReceiveTime() : client->getReceiveTime();
     SigOutType output; 
     if (isServer) {
-      std::array<SigOutType, 1>& getData = server->getReceiveBuffer();
+      const std::array<SigOutType, 1>& getData = server->getReceiveBuffer();
       output = getData[0];
     } else {
-      std::array<SigOutType, 1>& getData = client->getReceiveBuffer();
+      const std::array<SigOutType, 1>& getData = client->getReceiveBuffer();
       output = getData[0];
     }
     
@@ -240,16 +291,30 @@ public:
     }
     
     this->out.getSignal().setValue(output);
-    timestamp_t time = System::getTimeNs();
+    timestamp_t time = received != 0 ? received : System::getTimeNs();
     this->out.getSignal().setTimestamp(time);
   }
   
   virtual bool isNew() {
-    if (isServer) return server->newData; else return client->newData;
+    return getSequence() != seen;
+  }
+
+  virtual DatagramStatistics getStatistics() {
+    if (isServer) return server->getStatistics(); else return client->getStatistics();
   }
 
   virtual void resetNew() {
-    if (isServer) server->newData = false; else client->newData = false;
+    seen = getSequence();
+  }
+
+  /**
+   * Returns the number of messages received so far. The counter is also
+   * incremented when the buffer is cleared because the connection broke.
+   *
+   * @return sequence counter
+   */
+  virtual uint64_t getSequence() {
+    if (isServer) return server->getSequence(); else return client->getSequence();
   }
   
   virtual bool isConnected() {
@@ -262,11 +327,12 @@ public:
 
  private:
   typedef typename SigInType::value_type SigInValueType;
-  SocketServer<sizeof(SigInType) / sizeof(SigInValueType), SigInValueType, 1, SigOutType>* server;
-  SocketClient<sizeof(SigInType) / sizeof(SigInValueType), SigInValueType, 1, SigOutType>* client;
-  std::array<SigInValueType, sizeof(SigInType) / sizeof(SigInValueType)> sendData;
+  SocketServer<SigInType::nofElements, SigInValueType, 1, SigOutType>* server;
+  SocketClient<SigInType::nofElements, SigInValueType, 1, SigOutType>* client;
+  std::array<SigInValueType, SigInType::nofElements> sendData;
   uint32_t bufInLen, bufOutLen;
   bool isServer;
+  uint64_t seen = 0;
 };
 
 template < typename SigInType, typename SigOutType >
@@ -274,26 +340,28 @@ class SocketData<SigInType, SigOutType,
   typename std::enable_if<std::is_arithmetic<SigInType>::value && std::is_arithmetic<SigOutType>::value>::type> 
   : public Blockio<1,1,SigInType, SigOutType> {			
 public:
-  SocketData(std::string serverIP, uint16_t port, double period = 0.01, double timeout = 1.0) {
+  SocketData(std::string serverIP, uint16_t port, double period = 0.01, double timeout = 1.0, Protocol protocol = Protocol::tcp,
+             SocketOptions options = SocketOptions()) {
     bufInLen = 1;
     bufOutLen = 1;
     isServer = serverIP.empty();
     if (isServer)
-      server =  new SocketServer<1, SigInType, 1, SigOutType>(port, period, timeout);
+      server =  new SocketServer<1, SigInType, 1, SigOutType>(port, period, timeout, 5, 8, protocol, options);
     else
-      client =  new SocketClient<1, SigInType, 1, SigOutType>(serverIP, port, period, timeout);
+      client =  new SocketClient<1, SigInType, 1, SigOutType>(serverIP, port, period, timeout, 5, protocol, options);
   }
   
   virtual ~SocketData() {if (isServer) server->stop(); else client->stop();}
         
   virtual void run() {
-    // receive
+    // receive, the time is read first so it is never newer than the data
+    uint64_t received = isServer ? server->getReceiveTime() : client->getReceiveTime();
     SigOutType output; 
     if (isServer) {
-      std::array<SigOutType, 1>& getData = server->getReceiveBuffer();
+      const std::array<SigOutType, 1>& getData = server->getReceiveBuffer();
       output = getData[0];
     } else {
-      std::array<SigOutType, 1>& getData = client->getReceiveBuffer();
+      const std::array<SigOutType, 1>& getData = client->getReceiveBuffer();
       output = getData[0];
     }
     
@@ -305,16 +373,30 @@ public:
     }
     
     this->out.getSignal().setValue(output);
-    timestamp_t time = System::getTimeNs();
+    timestamp_t time = received != 0 ? received : System::getTimeNs();
     this->out.getSignal().setTimestamp(time);
   }
   
   virtual bool isNew() {
-    if (isServer) return server->newData; else return client->newData;
+    return getSequence() != seen;
+  }
+
+  virtual DatagramStatistics getStatistics() {
+    if (isServer) return server->getStatistics(); else return client->getStatistics();
   }
 
   virtual void resetNew() {
-    if (isServer) server->newData = false; else client->newData = false;
+    seen = getSequence();
+  }
+
+  /**
+   * Returns the number of messages received so far. The counter is also
+   * incremented when the buffer is cleared because the connection broke.
+   *
+   * @return sequence counter
+   */
+  virtual uint64_t getSequence() {
+    if (isServer) return server->getSequence(); else return client->getSequence();
   }
   
   virtual bool isConnected() {
@@ -331,6 +413,7 @@ public:
   std::array<SigInType, 1> sendData;
   uint32_t bufInLen, bufOutLen;
   bool isServer;
+  uint64_t seen = 0;
 };
 
 template < typename SigInType, typename SigOutType >
@@ -338,13 +421,14 @@ class SocketData<SigInType, SigOutType,
   typename std::enable_if<std::is_compound<SigInType>::value && std::is_same<SigOutType, std::nullptr_t>::value>::type> 
   : public Blockio<1,1,SigInType> {			
 public:
-  SocketData(std::string serverIP, uint16_t port, double period = 0.01, double timeout = 1.0) {
-    bufInLen = sizeof(SigInType) / sizeof(SigInValueType);
+  SocketData(std::string serverIP, uint16_t port, double period = 0.01, double timeout = 1.0, Protocol protocol = Protocol::tcp,
+             SocketOptions options = SocketOptions()) {
+    bufInLen = SigInType::nofElements;
     isServer = serverIP.empty();
     if (isServer)
-      server =  new SocketServer<sizeof(SigInType) / sizeof(SigInValueType), SigInValueType, 0, std::nullptr_t>(port, period, timeout);
+      server =  new SocketServer<SigInType::nofElements, SigInValueType, 0, std::nullptr_t>(port, period, timeout, 5, 8, protocol, options);
     else 
-      client =  new SocketClient<sizeof(SigInType) / sizeof(SigInValueType), SigInValueType, 0, std::nullptr_t>(serverIP, port, period, timeout);
+      client =  new SocketClient<SigInType::nofElements, SigInValueType, 0, std::nullptr_t>(serverIP, port, period, timeout, 5, protocol, options);
   }
   
   virtual ~SocketData() {if (isServer) server->stop(); else client->stop();}
@@ -368,9 +452,9 @@ public:
 
  private:
   typedef typename SigInType::value_type SigInValueType;
-  SocketServer<sizeof(SigInType) / sizeof(SigInValueType), SigInValueType, 0, std::nullptr_t>* server;
-  SocketClient<sizeof(SigInType) / sizeof(SigInValueType), SigInValueType, 0, std::nullptr_t>* client;
-  std::array<SigInValueType, sizeof(SigInType) / sizeof(SigInValueType)> sendData;
+  SocketServer<SigInType::nofElements, SigInValueType, 0, std::nullptr_t>* server;
+  SocketClient<SigInType::nofElements, SigInValueType, 0, std::nullptr_t>* client;
+  std::array<SigInValueType, SigInType::nofElements> sendData;
   uint32_t bufInLen;
   bool isServer;
 };
@@ -380,39 +464,55 @@ class SocketData<SigInType, SigOutType,
   typename std::enable_if<std::is_same<SigInType, std::nullptr_t>::value && std::is_compound<SigOutType>::value>::type> 
   : public Blockio<1,1,SigOutType> {			
 public:
-  SocketData(std::string serverIP, uint16_t port, double period = 0.01, double timeout = 1.0) {
-    bufOutLen = sizeof(SigOutType) / sizeof(SigOutValueType);
+  SocketData(std::string serverIP, uint16_t port, double period = 0.01, double timeout = 1.0, Protocol protocol = Protocol::tcp,
+             SocketOptions options = SocketOptions()) {
+    bufOutLen = SigOutType::nofElements;
     isServer = serverIP.empty();
     if (isServer) 
-      server =  new SocketServer<0, std::nullptr_t, sizeof(SigOutType) / sizeof(SigOutValueType), SigOutValueType>(port, period, timeout);
+      server =  new SocketServer<0, std::nullptr_t, SigOutType::nofElements, SigOutValueType>(port, period, timeout, 5, 8, protocol, options);
     else
-      client =  new SocketClient<0, std::nullptr_t, sizeof(SigOutType) / sizeof(SigOutValueType), SigOutValueType>(serverIP, port, period, timeout);
+      client =  new SocketClient<0, std::nullptr_t, SigOutType::nofElements, SigOutValueType>(serverIP, port, period, timeout, 5, protocol, options);
   }
   
   virtual ~SocketData() {if (isServer) server->stop(); else client->stop();}
         
   virtual void run() {
-    // receive
+    // receive, the time is read first so it is never newer than the data
+    uint64_t received = isServer ? server->getReceiveTime() : client->getReceiveTime();
     SigOutType output; 
     if (isServer) {
-      std::array<SigOutValueType, sizeof(SigOutType) / sizeof(SigOutValueType)>& getData = server->getReceiveBuffer();
+      const std::array<SigOutValueType, SigOutType::nofElements>& getData = server->getReceiveBuffer();
       for (uint32_t i = 0; i < bufOutLen; i++) output(i) = getData[i];
     } else {
-      std::array<SigOutValueType, sizeof(SigOutType) / sizeof(SigOutValueType)>& getData = client->getReceiveBuffer();
+      const std::array<SigOutValueType, SigOutType::nofElements>& getData = client->getReceiveBuffer();
       for (uint32_t i = 0; i < bufOutLen; i++) output(i) = getData[i];
     }
             
     this->out.getSignal().setValue(output);
-    timestamp_t time = System::getTimeNs();
+    timestamp_t time = received != 0 ? received : System::getTimeNs();
     this->out.getSignal().setTimestamp(time);
   }
   
   virtual bool isNew() {
-    if (isServer) return server->newData; else return client->newData;
+    return getSequence() != seen;
+  }
+
+  virtual DatagramStatistics getStatistics() {
+    if (isServer) return server->getStatistics(); else return client->getStatistics();
   }
 
   virtual void resetNew() {
-    if (isServer) server->newData = false; else client->newData = false;
+    seen = getSequence();
+  }
+
+  /**
+   * Returns the number of messages received so far. The counter is also
+   * incremented when the buffer is cleared because the connection broke.
+   *
+   * @return sequence counter
+   */
+  virtual uint64_t getSequence() {
+    if (isServer) return server->getSequence(); else return client->getSequence();
   }
   
   virtual bool isConnected() {
@@ -425,10 +525,11 @@ public:
 
  private:
   typedef typename SigOutType::value_type SigOutValueType;
-  SocketServer<0, std::nullptr_t, sizeof(SigOutType) / sizeof(SigOutValueType), SigOutValueType>* server;
-  SocketClient<0, std::nullptr_t, sizeof(SigOutType) / sizeof(SigOutValueType), SigOutValueType>* client;
+  SocketServer<0, std::nullptr_t, SigOutType::nofElements, SigOutValueType>* server;
+  SocketClient<0, std::nullptr_t, SigOutType::nofElements, SigOutValueType>* client;
   uint32_t bufOutLen;
   bool isServer;
+  uint64_t seen = 0;
 };
 
 template < typename SigInType, typename SigOutType >
@@ -436,13 +537,14 @@ class SocketData<SigInType, SigOutType,
   typename std::enable_if<std::is_arithmetic<SigInType>::value && std::is_same<SigOutType, std::nullptr_t>::value>::type> 
   : public Blockio<1,1,SigInType> {			
 public:
-  SocketData(std::string serverIP, uint16_t port, double period = 0.01, double timeout = 1.0) {
+  SocketData(std::string serverIP, uint16_t port, double period = 0.01, double timeout = 1.0, Protocol protocol = Protocol::tcp,
+             SocketOptions options = SocketOptions()) {
     bufInLen = 1;
     isServer = serverIP.empty();
     if (isServer)
-      server =  new SocketServer<1, SigInType, 0, std::nullptr_t>(port, period, timeout);
+      server =  new SocketServer<1, SigInType, 0, std::nullptr_t>(port, period, timeout, 5, 8, protocol, options);
     else 
-      client =  new SocketClient<1, SigInType, 0, std::nullptr_t>(serverIP, port, period, timeout);
+      client =  new SocketClient<1, SigInType, 0, std::nullptr_t>(serverIP, port, period, timeout, 5, protocol, options);
   }
   
   virtual ~SocketData() {if (isServer) server->stop(); else client->stop();}
@@ -477,39 +579,55 @@ class SocketData<SigInType, SigOutType,
   typename std::enable_if<std::is_same<SigInType, std::nullptr_t>::value && std::is_arithmetic<SigOutType>::value>::type> 
   : public Blockio<1,1,SigOutType> {			
 public:
-  SocketData(std::string serverIP, uint16_t port, double period = 0.01, double timeout = 1.0) {
+  SocketData(std::string serverIP, uint16_t port, double period = 0.01, double timeout = 1.0, Protocol protocol = Protocol::tcp,
+             SocketOptions options = SocketOptions()) {
     bufOutLen = 1;
     isServer = serverIP.empty();
     if (isServer) 
-      server =  new SocketServer<0, std::nullptr_t, 1, SigOutType>(port, period, timeout);
+      server =  new SocketServer<0, std::nullptr_t, 1, SigOutType>(port, period, timeout, 5, 8, protocol, options);
     else
-      client =  new SocketClient<0, std::nullptr_t, 1, SigOutType>(serverIP, port, period, timeout);
+      client =  new SocketClient<0, std::nullptr_t, 1, SigOutType>(serverIP, port, period, timeout, 5, protocol, options);
   }
   
   virtual ~SocketData() {if (isServer) server->stop(); else client->stop();}
         
   virtual void run() {
-    // receive
+    // receive, the time is read first so it is never newer than the data
+    uint64_t received = isServer ? server->getReceiveTime() : client->getReceiveTime();
     SigOutType output; 
     if (isServer) {
-      std::array<SigOutType, 1>& getData = server->getReceiveBuffer();
+      const std::array<SigOutType, 1>& getData = server->getReceiveBuffer();
       output = getData[0];
     } else {
-      std::array<SigOutType, 1>& getData = client->getReceiveBuffer();
+      const std::array<SigOutType, 1>& getData = client->getReceiveBuffer();
       output = getData[0];
     }
             
     this->out.getSignal().setValue(output);
-    timestamp_t time = System::getTimeNs();
+    timestamp_t time = received != 0 ? received : System::getTimeNs();
     this->out.getSignal().setTimestamp(time);
   }
   
   virtual bool isNew() {
-    if (isServer) return server->newData; else return client->newData;
+    return getSequence() != seen;
+  }
+
+  virtual DatagramStatistics getStatistics() {
+    if (isServer) return server->getStatistics(); else return client->getStatistics();
   }
 
   virtual void resetNew() {
-    if (isServer) server->newData = false; else client->newData = false;
+    seen = getSequence();
+  }
+
+  /**
+   * Returns the number of messages received so far. The counter is also
+   * incremented when the buffer is cleared because the connection broke.
+   *
+   * @return sequence counter
+   */
+  virtual uint64_t getSequence() {
+    if (isServer) return server->getSequence(); else return client->getSequence();
   }
   
   virtual bool isConnected() {
@@ -525,6 +643,7 @@ public:
   SocketClient<0, std::nullptr_t, 1, SigOutType>* client;
   uint32_t bufOutLen;
   bool isServer;
+  uint64_t seen = 0;
 };
 
 /********** Print functions **********/
@@ -0,0 +1,245 @@
+#ifndef ORG_EEROS_CONTROL_SOCKETMESSAGE_HPP_
+#define ORG_EEROS_CONTROL_SOCKETMESSAGE_HPP_
+
+#include <eeros/control/Block.hpp>
+#include <eeros/control/Input.hpp>
+#include <eeros/control/Output.hpp>
+#include <eeros/core/Fault.hpp>
+#include <eeros/core/System.hpp>
+#include <eeros/core/TripleBuffer.hpp>
+#include <eeros/logger/Logger.hpp>
+#include <eeros/sockets/ClientConnection.hpp>
+#include <eeros/sockets/Message.hpp>
+#include <eeros/sockets/ServerConnections.hpp>
+#include <eeros/sockets/SocketOptions.hpp>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace eeros {
+namespace control {
+
+/**
+ * This block exchanges several named signals of different types with a peer over 
+ * one TCP connection. Each period one message is sent, which carries the values of
+ * all inputs, see \ref sockets::Message. The outputs hold the values of the newest 
+ * message received. The inputs of one peer must be added with the same names, types
+ * and in the same order as the outputs of the other peer. Messages of a different
+ * schema are counted, see getInvalid(), and ignored.
+ * Like \ref SocketData, one side acts as a server, the other one as a client, and the
+ * connection is reestablished automatically.
+ *
+ * Add all inputs and outputs, then call start().
+ * Signals may be of arithmetic types or of matrices of arithmetic types.
+ *
+ * @since v1.4.4
+ */
+class SocketMessage : public Block {
+ public:
+  /**
+   * Creates a socket message block.
+   *
+   * @param serverIP - IP number of the server, if left empty, block acts as server
+   * @param port - port number, server and client must be opened on the same port number
+   * @param period - period in s in which messages are sent
+   * @param timeout - connection timeout time in s
+   * @param options - socket options
+   */
+  SocketMessage(std::string serverIP, uint16_t port, double period = 0.01, double timeout = 1.0, 
+                sockets::SocketOptions options = sockets::SocketOptions());
+
+  /**
+   * Stops the thread and closes the connection.
+   */
+  virtual ~SocketMessage();
+
+  SocketMessage(const SocketMessage&) = delete;
+  SocketMessage& operator=(const SocketMessage&) = delete;
+
+  /**
+   * Adds an input, whose value is sent with every message.
+   *
+   * @tparam T - signal type
+   * @param name - name of the field in the message
+   * @return the new input
+   */
+  template < typename T >
+  Input<T>& addInput(const std::string& name) {
+    if (started) throw Fault("cannot add input '" + name + "' to running block '" + getName() + "'");
+    auto p = new InputPort<T>(this);
+    p->offset = sizeof(sockets::MessageHeader) + txSchema.add<typename Element<T>::type>(name, Element<T>::count);
+    inputs.emplace_back(p);
+    return p->in;
+  }
+
+  /**
+   * Adds an output, which holds the value of the field with this name of the newest message received.
+   *
+   * @tparam T - signal type
+   * @param name - name of the field in the message
+   * @return the new output
+   */
+  template < typename T >
+  Output<T>& addOutput(const std::string& name) {
+    if (started) throw Fault("cannot add output '" + name + "' to running block '" + getName() + "'");
+    auto p = new OutputPort<T>(this);
+    p->offset = sizeof(sockets::MessageHeader) + rxSchema.add<typename Element<T>::type>(name, Element<T>::count);
+    outputs.emplace_back(p);
+    return p->out;
+  }
+
+  /**
+   * Opens the socket and starts the thread which sends and receives the messages.
+   */
+  virtual void start();
+
+  /**
+   * Sends the values of the inputs and sets the outputs to the values received last.
+   */
+  virtual void run();
+
+  /**
+   * The outputs do not depend on the inputs of the same cycle.
+   *
+   * @return false
+   */
+  virtual bool hasDirectFeedthrough() const override;
+
+  virtual std::vector<Block*> getInputBlocks() override;
+  virtual bool hasKnownInputs() const override;
+
+  /**
+   * @return true, if connected
+   */
+  virtual bool isConnected();
+
+  /**
+   * Returns the number of messages received so far. The counter is also
+   * incremented when the outputs are cleared because the connection broke.
+   *
+   * @return sequence counter
+   */
+  virtual uint64_t getSequence();
+
+  /**
+   * @return true, if a message was received since the last call to resetNew()
+   */
+  virtual bool isNew();
+
+  /**
+   * Resets the flag returned by isNew().
+   */
+  virtual void resetNew();
+
+  /**
+   * @return number of messages of a different schema received
+   */
+  virtual uint64_t getInvalid();
+
+  /**
+   * @return time the newest message was sent in ns, in the time base of the peer
+   */
+  virtual uint64_t getTimestamp();
+
+  /**
+   * @return schema of the messages sent
+   */
+  const sockets::MessageSchema& getSendSchema() const;
+
+  /**
+   * @return schema of the messages received
+   */
+  const sockets::MessageSchema& getReceiveSchema() const;
+
+ private:
+  // elements of a signal, matrices are copied element by element like in SocketData
+  template < typename T, typename Enable = void >
+  struct Element {
+    using type = typename T::value_type;
+    static constexpr uint32_t count = T::nofElements;
+    static void store(const T& value, uint8_t* to) {
+      for (uint32_t i = 0; i < count; i++) {
+        type e = value(i);
+        std::memcpy(to + i * sizeof(type), &e, sizeof(type));
+      }
+    }
+    static void load(T& value, const uint8_t* from) {
+      for (uint32_t i = 0; i < count; i++) std::memcpy(&value(i), from + i * sizeof(type), sizeof(type));
+    }
+  };
+  template < typename T >
+  struct Element<T, typename std::enable_if<std::is_arithmetic<T>::value>::type> {
+    using type = T;
+    static constexpr uint32_t count = 1;
+    static void store(const T& value, uint8_t* to) { std::memcpy(to, &value, sizeof(T)); }
+    static void load(T& value, const uint8_t* from) { std::memcpy(&value, from, sizeof(T)); }
+  };
+
+  struct Port {
+    virtual ~Port() = default;
+    std::size_t offset;
+  };
+  struct SendPort : Port {
+    virtual void encode(uint8_t* frame) = 0;
+    virtual Block* getConnectedBlock() const = 0;
+  };
+  struct ReceivePort : Port {
+    virtual void decode(const uint8_t* frame, timestamp_t time) = 0;
+  };
+  template < typename T >
+  struct InputPort : SendPort {
+    InputPort(Block* owner) : in(owner) { }
+    void encode(uint8_t* frame) override {
+      if (!in.isConnected()) return;
+      Element<T>::store(in.getSignal().getValue(), frame + this->offset);
+    }
+    Block* getConnectedBlock() const override { return in.getConnectedBlock(); }
+    Input<T> in;
+  };
+  template < typename T >
+  struct OutputPort : ReceivePort {
+    OutputPort(Block* owner) : out(owner) { }
+    void decode(const uint8_t* frame, timestamp_t time) override {
+      T value;
+      Element<T>::load(value, frame + this->offset);
+      out.getSignal().setValue(value);
+      out.getSignal().setTimestamp(time);
+    }
+    Output<T> out;
+  };
+
+  void loop();
+  void received(const uint8_t* frame);
+  void clear();
+
+  std::string serverIP;
+  uint16_t port;
+  double period;
+  double timeout;
+  sockets::SocketOptions options;
+  sockets::MessageSchema txSchema, rxSchema;
+  std::vector<std::unique_ptr<SendPort>> inputs;
+  std::vector<std::unique_ptr<ReceivePort>> outputs;
+  std::unique_ptr<sockets::ServerConnections> connections;
+  std::unique_ptr<sockets::ClientConnection> stream;
+  std::unique_ptr<TripleBuffer<std::vector<uint8_t>>> txBuf, rxBuf;
+  uint32_t txSequence = 0;
+  uint64_t seen = 0;
+  std::atomic<uint64_t> sequence{0};
+  std::atomic<uint64_t> invalid{0};
+  std::atomic<uint64_t> timestamp{0};
+  std::atomic<bool> connected{false};
+  std::atomic<bool> running{false};
+  bool started = false;
+  logger::Logger log;
+  std::thread thread;
+};
+
+}
+}
+
+#endif // ORG_EEROS_CONTROL_SOCKETMESSAGE_HPP_
@@ -0,0 +1,179 @@
+#ifndef ORG_EEROS_CONTROL_STATICTIMEDOMAIN_HPP_
+#define ORG_EEROS_CONTROL_STATICTIMEDOMAIN_HPP_
+
+#include <eeros/control/Blockio.hpp>
+#include <array>
+#include <tuple>
+#include <utility>
+
+namespace eeros {
+namespace control {
+
+/**
+ * Stages for a StaticTimeDomain. A stage is a small value type with a call operator,
+ * which gets the value of the previous stage and the values of all inputs of the
+ * static timedomain and returns its own value. Any type with such a call operator
+ * can be used as stage.
+ *
+ * @since v1.4.4
+ */
+namespace fused {
+
+/**
+ * output = gain * value
+ */
+template < typename Tgain = double >
+struct Gain {
+  Tgain gain;
+  template < typename T, typename I >
+  T operator()(const T& value, const I&) const { return gain * value; }
+};
+
+/**
+ * output = value + offset
+ */
+template < typename T = double >
+struct Offset {
+  T offset;
+  template < typename I >
+  T operator()(const T& value, const I&) const { return value + offset; }
+};
+
+/**
+ * output = value + input[index], like a Sum block with a second input
+ */
+template < std::size_t index >
+struct AddInput {
+  template < typename T, typename I >
+  T operator()(const T& value, const I& in) const { return value + std::get<index>(in); }
+};
+
+/**
+ * output = value - input[index], like a Sum block with a negated second input
+ */
+template < std::size_t index >
+struct SubInput {
+  template < typename T, typename I >
+  T operator()(const T& value, const I& in) const { return value - std::get<index>(in); }
+};
+
+/**
+ * output = value limited to [lower, upper], for scalar values
+ */
+template < typename T = double >
+struct Saturation {
+  T lower;
+  T upper;
+  template < typename I >
+  T operator()(const T& value, const I&) const { return (value < lower) ? lower : ((value > upper) ? upper : value); }
+};
+
+/**
+ * output = f(value), for any function or lambda taking the value
+ */
+template < typename F >
+struct Function {
+  F f;
+  template < typename T, typename I >
+  T operator()(const T& value, const I&) const { return f(value); }
+};
+
+template < typename F >
+Function<F> function(F f) { return Function<F>{f}; }
+
+}
+
+/**
+ * A static timedomain fuses a fixed chain of stages into one block at compile time.
+ * Instead of a block per operation, each reading and writing signals over virtual 
+ * calls, the values are passed from stage to stage in local variables, so that the 
+ * compiler can inline the whole chain. The block reads each input once per run and 
+ * writes a single output, so it connects to normal blocks at its edges and is added 
+ * to a normal timedomain.
+ * 
+ * The value of the first input runs through the stages, further inputs can be 
+ * used by stages such as fused::AddInput. The output carries the timestamp of the 
+ * first input.
+ *
+ * Example, the equivalent of Gain -> Sum (with a feedforward input) -> Saturation:
+ * StaticTimeDomain<2, double, fused::Gain<>, fused::AddInput<1>, fused::Saturation<>> 
+ *     axis(fused::Gain<>{10.0}, fused::AddInput<1>{}, fused::Saturation<>{-1.0, 1.0});
+ *
+ * @tparam N - number of inputs
+ * @tparam T - signal data type
+ * @tparam Stages - types of the stages in the order they are run
+ *
+ * @since v1.4.4
+ */
+template < uint8_t N, typename T, typename... Stages >
+class StaticTimeDomain : public Blockio<N,1,T,T> {
+  static_assert(N >= 1, "a static time domain needs at least one input");
+
+ public:
+  /**
+   * Constructs a static timedomain from its stages.
+   *
+   * @param stages - stages in the order they are run
+   */
+  StaticTimeDomain(Stages... stages) : stages(stages...) { }
+
+  /**
+   * Disabling use of copy constructor because the block should never be copied unintentionally.
+   */
+  StaticTimeDomain(const StaticTimeDomain& s) = delete;
+
+  /**
+   * Runs all stages.
+   */
+  void run() override {
+    std::array<T, N> in;
+    uint64_t timestamp;
+    if constexpr (N == 1) {
+      in[0] = this->in.getSignal().getValue();
+      timestamp = this->in.getSignal().getTimestamp();
+    } else {
+      for (uint8_t i = 0; i < N; i++) in[i] = this->in[i].getSignal().getValue();
+      timestamp = this->in[0].getSignal().getTimestamp();
+    }
+    T value = runStages(in, std::index_sequence_for<Stages...>{});
+    this->out.getSignal().setValue(value);
+    this->out.getSignal().setTimestamp(timestamp);
+  }
+
+  /**
+   * Returns a stage, e.g. to change a gain while running.
+   *
+   * @tparam I - index of the stage
+   * @return stage
+   */
+  template < std::size_t I >
+  auto& getStage() {
+    return std::get<I>(stages);
+  }
+
+ private:
+  template < std::size_t... Is >
+  T runStages(const std::array<T, N>& in, std::index_sequence<Is...>) const {
+    T value = in[0];
+    ((value = std::get<Is>(stages)(value, in)), ...);
+    return value;
+  }
+
+  std::tuple<Stages...> stages;
+};
+
+/**
+ * Operator overload (<<) to enable an easy way to print the state of a
+ * static timedomain instance to an output stream.\n
+ * Does not print a newline control character.
+ */
+template < uint8_t N, typename T, typename... Stages >
+std::ostream& operator<<(std::ostream& os, StaticTimeDomain<N,T,Stages...>& b) {
+  os << "Block static time domain: '" << b.getName() << "'"; 
+  return os;
+}
+
+}
+}
+
+#endif // ORG_EEROS_CONTROL_STATICTIMEDOMAIN_HPP_
@@ -0,0 +1,422 @@
+#ifndef ORG_EEROS_CONTROL_STREAMINGTRACE_HPP_
+#define ORG_EEROS_CONTROL_STREAMINGTRACE_HPP_
+
+#include <eeros/control/Blockio.hpp>
+#include <eeros/core/Fault.hpp>
+#include <eeros/core/FutexSemaphore.hpp>
+#include <eeros/logger/Logger.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace eeros {
+namespace control {
+
+/**
+ * Header at the start of a binary trace file written by a StreamingTraceWriter.
+ * It is followed by chunks, each consisting of
+ * - the number of samples n of the chunk (uint32_t) and 4 bytes padding
+ * - n timestamps in ns (uint64_t)
+ * - n samples of rows x cols elements, each sample in column major order
+ * In triggered mode, each chunk is one window around a trigger.
+ * All values are stored in the byte order of the machine that wrote the file.
+ *
+ * @since v1.4.4
+ */
+struct StreamingTraceHeader {
+  char magic[4];        // "EETR"
+  uint32_t version;     // format version, 1
+  uint32_t rows;        // rows of a sample, 1 for scalars
+  uint32_t cols;        // colums of a sample, 1 for scalars
+  uint32_t elementSize; // bytes of one element
+  uint32_t elementType; // 0 unsigned integer, 1 signed integer, 2 floating point
+  char name[64];        // name of the trace block, zero terminated
+};
+
+template < typename T > class StreamingTraceWriter;
+
+/**
+ * A streaming trace block records its input signal continuously. Unlike Trace,
+ * which keeps the last samples in memory, the samples are handed to a
+ * StreamingTraceWriter which streams them to a binary file in the background.
+ *
+ * The block owns two preallocated halves. run() fills one half while the
+ * writer thread writes the other one to the file; when a half is full, it is
+ * handed over by an atomic flag and the halves are swapped. run() never blocks
+ * and never allocates memory. If the writer falls behind and both halves are
+ * full, samples are dropped and counted, see getOverruns().
+ *
+ * After disable(), the next run() hands over the partially filled half, so
+ * the last samples are written as well.
+ *
+ * With setTrigger(), the trace works as a flight recorder instead: each half is
+ * a ring which always records, and only windows around a trigger are written.
+ * A trigger is requested with trigger(), e.g. from the level action of a safety
+ * level entered after a SafetyEvent or a SignalChecker fired, or by a rising
+ * edge of a boolean signal connected to getTriggerIn(). When the samples after
+ * the trigger are recorded, the half holding the window is handed over as it is,
+ * no samples are copied, and recording continues in the other half. If the
+ * writer still holds the other half, the window is dropped and counted as overrun.
+ *
+ * @tparam T - signal data type, an arithmetic type or a matrix of it (double - default type)
+ *
+ * @since v1.4.4
+ */
+template < typename T = double >
+class StreamingTrace : public Blockio<1,0,T> {
+  using V = typename math::ValueShape<T>::value_type;
+  static constexpr unsigned int C = math::ValueShape<T>::size;
+  static_assert(std::is_arithmetic_v<V>, "StreamingTrace needs arithmetic values or a matrix of them");
+
+ public:
+  /**
+   * Constructs a streaming trace with two halves of a given number of samples.
+   * With a half of halfLen samples, the writer has halfLen sampling periods
+   * to write the other half.
+   *
+   * @param halfLen - number of samples of each half
+   */
+  StreamingTrace(uint32_t halfLen = 4096) : halfLen(halfLen), triggerIn(this) {
+    if (halfLen < 1) throw eeros::Fault("trace has zero length");
+    for (int h = 0; h < 2; h++) {
+      timeBuf[h] = new timestamp_t[halfLen]();
+      buf[h] = new V[halfLen * C]();
+    }
+  }
+
+  /**
+   * Disabling use of copy constructor because the block should never be copied unintentionally.
+   */
+  StreamingTrace(const StreamingTrace& s) = delete;
+
+  /**
+   * Destructor frees buffers.
+   */
+  ~StreamingTrace() override {
+    for (int h = 0; h < 2; h++) {
+      delete[] timeBuf[h];
+      delete[] buf[h];
+    }
+  }
+
+  /**
+   * Records the input signal, if the trace is enabled.
+   */
+  void run() override {
+    if (!running.load(std::memory_order_relaxed)) {
+      if (fill > 0 && !triggered) publish(0);
+      return;
+    }
+    if (triggered) {
+      recordWindow();
+      return;
+    }
+    if (full[active].load(std::memory_order_acquire)) {
+      overruns.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    const Signal<T>& sig = this->readSignal(this->in);
+    timeBuf[active][fill] = sig.getTimestamp();
+    const V* x = math::ValueShape<T>::data(sig.getValueRef());
+    std::copy(x, x + C, buf[active] + fill * C);
+    if (++fill == halfLen) publish(0);
+  }
+
+  /**
+   * Switches to the triggered mode, where only windows around a trigger are written.
+   * Must be called before recording starts.
+   *
+   * @param pre - number of samples before the trigger
+   * @param post - number of samples from the trigger on, at least 1
+   */
+  void setTrigger(uint32_t pre, uint32_t post) {
+    if (post < 1 || pre + post > halfLen) throw eeros::Fault("trigger window does not fit into trace '" + this->getName() + "'");
+    if (running.load(std::memory_order_relaxed) || fill > 0) throw eeros::Fault("trigger of trace '" + this->getName() + "' must be set before recording");
+    this->pre = pre;
+    this->post = post;
+    triggered = true;
+  }
+
+  /**
+   * Requests a trigger in triggered mode. Can be called from any thread, the
+   * trigger takes effect with the next run. A trigger while the samples after
+   * a previous trigger are still recorded is ignored.
+   */
+  void trigger() {
+    triggerRequest.store(true, std::memory_order_relaxed);
+  }
+
+  /**
+   * Gets the optional trigger input, a rising edge of its signal triggers.
+   *
+   * @return trigger input
+   */
+  Input<bool>& getTriggerIn() {
+    return triggerIn;
+  }
+
+  /**
+   * Returns the blocks connected to the input and the trigger input.
+   *
+   * @return blocks connected to the inputs
+   */
+  std::vector<Block*> getInputBlocks() override {
+    auto blocks = Blockio<1,0,T>::getInputBlocks();
+    Block* b = triggerIn.getConnectedBlock();
+    if (b != nullptr) blocks.push_back(b);
+    return blocks;
+  }
+
+  /**
+   * Starts recording.
+   */
+  void enable() override {
+    running.store(true, std::memory_order_relaxed);
+  }
+
+  /**
+   * Stops recording, the next run hands over the samples recorded so far.
+   */
+  void disable() override {
+    running.store(false, std::memory_order_relaxed);
+  }
+
+  /**
+   * @return number of samples, or windows in triggered mode, dropped because the writer did not keep up
+   */
+  uint64_t getOverruns() const {
+    return overruns.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @return number of samples of each half
+   */
+  uint32_t getHalfLength() const {
+    return halfLen;
+  }
+
+  /*
+   * Friend operator overload to give the operator overload outside
+   * the class access to the private fields.
+   */
+  template <typename X>
+  friend std::ostream& operator<<(std::ostream& os, StreamingTrace<X>& trace);
+
+ private:
+  friend class StreamingTraceWriter<T>;
+
+  // records into the ring of the active half and hands it over once a window is complete
+  void recordWindow() {
+    bool t = triggerRequest.load(std::memory_order_relaxed) && triggerRequest.exchange(false, std::memory_order_relaxed);
+    if (triggerIn.isConnected()) {
+      bool level = triggerIn.getSignal().getValue();
+      t = t || (level && !lastTriggerLevel);
+      lastTriggerLevel = level;
+    }
+    if (t && remaining == 0) remaining = post;
+    const Signal<T>& sig = this->readSignal(this->in);
+    timeBuf[active][pos] = sig.getTimestamp();
+    const V* x = math::ValueShape<T>::data(sig.getValueRef());
+    std::copy(x, x + C, buf[active] + pos * C);
+    if (++pos == halfLen) pos = 0;
+    if (fill < halfLen) fill++;
+    if (remaining > 0 && --remaining == 0) {
+      if (full[active ^ 1].load(std::memory_order_acquire)) {
+        overruns.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      uint32_t n = std::min(fill, pre + post);
+      fill = n;
+      publish(pos >= n ? pos - n : pos + halfLen - n);
+    }
+  }
+
+  // hands the active half over to the writer and continues with the other half
+  void publish(uint32_t first) {
+    len[active] = fill;
+    start[active] = first;
+    full[active].store(true, std::memory_order_release);
+    ready.post();
+    fill = 0;
+    pos = 0;
+    active ^= 1;
+  }
+
+  uint32_t halfLen;
+  timestamp_t* timeBuf[2];
+  V* buf[2];
+  uint32_t len[2] = {0, 0};            // number of samples of a full half
+  uint32_t start[2] = {0, 0};          // index of the first sample of a full half
+  std::atomic<bool> full[2] = {false, false}; // half belongs to the writer
+  uint32_t active = 0;                 // half written by run()
+  uint32_t fill = 0;                   // samples in the active half
+  std::atomic<bool> running{false};
+  std::atomic<uint64_t> overruns{0};
+  FutexSemaphore ready;                // posted for each half handed over
+  Input<bool> triggerIn;
+  bool triggered = false;              // triggered mode
+  uint32_t pre = 0, post = 0;          // window around a trigger
+  uint32_t pos = 0;                    // next index of the ring in triggered mode
+  uint32_t remaining = 0;              // samples still to record after a trigger
+  bool lastTriggerLevel = false;
+  std::atomic<bool> triggerRequest{false};
+};
+
+/**
+ * Operator overload (<<) to enable an easy way to print the state of a
+ * streaming trace instance to an output stream.\n
+ * Does not print a newline control character.
+ */
+template <typename T>
+std::ostream& operator<<(std::ostream& os, StreamingTrace<T>& trace) {
+  os << "Block streaming trace: '" << trace.getName() << "' with halves of " << trace.halfLen << " samples";
+  os << ", overruns=" << trace.getOverruns();
+  return os;
+}
+
+/**
+ * A streaming trace writer writes the halves of a StreamingTrace to a binary file,
+ * see StreamingTraceHeader for the format. It starts its own non realtime thread,
+ * which sleeps until a half is handed over and writes each half with a single
+ * system call, without formatting or flushing single lines.
+ *
+ * @tparam T - signal data type of the trace (double - default type)
+ *
+ * @since v1.4.4
+ */
+template < typename T = double >
+class StreamingTraceWriter {
+ public:
+  /**
+   * Opens the file, writes the header and starts the writer thread.
+   *
+   * @param trace - trace block
+   * @param fileName - name of the file, an existing file is overwritten
+   */
+  StreamingTraceWriter(StreamingTrace<T>& trace, std::string fileName)
+      : trace(trace), fileName(fileName), log(logger::Logger::getLogger()) {
+    fd = ::open(fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) throw eeros::Fault("could not open trace file " + fileName);
+    StreamingTraceHeader header{};
+    std::memcpy(header.magic, "EETR", 4);
+    header.version = 1;
+    header.rows = math::ValueShape<T>::rows;
+    header.cols = math::ValueShape<T>::cols;
+    header.elementSize = sizeof(V);
+    header.elementType = std::is_floating_point_v<V> ? 2 : std::is_signed_v<V> ? 1 : 0;
+    std::strncpy(header.name, trace.getName().c_str(), sizeof(header.name) - 1);
+    writeAll(&header, sizeof(header));
+    thread = std::thread([this]() { loop(); });
+  }
+
+  StreamingTraceWriter(const StreamingTraceWriter&) = delete;
+
+  /**
+   * Stops the writer, see stop().
+   */
+  ~StreamingTraceWriter() {
+    stop();
+  }
+
+  /**
+   * Writes all halves handed over so far, stops the thread and closes the file.
+   */
+  void stop() {
+    stopping.store(true, std::memory_order_relaxed);
+    trace.ready.post();
+    if (thread.joinable()) thread.join();
+    if (fd >= 0) {
+      ::close(fd);
+      fd = -1;
+      log.info() << "trace file " << fileName << " written, " << getNofSamples() << " samples";
+    }
+  }
+
+  /**
+   * @return number of samples written to the file
+   */
+  uint64_t getNofSamples() const {
+    return samples.load(std::memory_order_relaxed);
+  }
+
+ private:
+  using V = typename StreamingTrace<T>::V;
+  static constexpr unsigned int C = StreamingTrace<T>::C;
+
+  void loop() {
+    while (!stopping.load(std::memory_order_relaxed)) {
+      trace.ready.wait(0.1);
+      drain();
+    }
+    drain();
+  }
+
+  // writes the full halves in the order they were handed over
+  void drain() {
+    while (trace.full[next].load(std::memory_order_acquire)) {
+      // a window of the triggered mode may wrap around the end of the half
+      uint32_t n = trace.len[next];
+      uint32_t s = trace.start[next];
+      uint32_t n1 = std::min(n, trace.halfLen - s);
+      uint32_t n2 = n - n1;
+      uint32_t count[2] = {n, 0};
+      struct iovec iov[5] = {
+        {count, sizeof(count)},
+        {trace.timeBuf[next] + s, n1 * sizeof(timestamp_t)},
+        {trace.timeBuf[next], n2 * sizeof(timestamp_t)},
+        {trace.buf[next] + s * C, n1 * C * sizeof(V)},
+        {trace.buf[next], n2 * C * sizeof(V)}
+      };
+      ssize_t total = 0;
+      for (auto& v : iov) total += v.iov_len;
+      ssize_t written = ::writev(fd, iov, 5);
+      if (written != total) {
+        // write the rest after a short write
+        if (written < 0) written = 0;
+        for (auto& v : iov) {
+          size_t skip = std::min(static_cast<size_t>(written), v.iov_len);
+          writeAll(static_cast<char*>(v.iov_base) + skip, v.iov_len - skip);
+          written -= skip;
+        }
+      }
+      samples.fetch_add(n, std::memory_order_relaxed);
+      trace.full[next].store(false, std::memory_order_release);
+      next ^= 1;
+    }
+  }
+
+  void writeAll(const void* p, size_t n) {
+    const char* c = static_cast<const char*>(p);
+    while (n > 0) {
+      ssize_t w = ::write(fd, c, n);
+      if (w <= 0) {
+        log.error() << "writing trace file " << fileName << " failed";
+        return;
+      }
+      c += w;
+      n -= w;
+    }
+  }
+
+  StreamingTrace<T>& trace;
+  std::string fileName;
+  logger::Logger log;
+  int fd;
+  uint32_t next = 0; // next half to write
+  std::atomic<uint64_t> samples{0};
+  std::atomic<bool> stopping{false};
+  std::thread thread;
+};
+
+};
+};
+
+#endif /* ORG_EEROS_CONTROL_STREAMINGTRACE_HPP_ */
@@ -6,15 +6,62 @@
 #include <eeros/control/Output.hpp>
 #include <eeros/control/IndexOutOfBoundsFault.hpp>
 #include <functional>
+#include <vector>
 
 namespace eeros {
 namespace control {
 
+/**
+ * Common base class of all subsystem blocks.
+ *
+ * A subsystem can register its internal blocks with addBlock() in the order
+ * they are run, instead of overriding run(). A timedomain then runs the
+ * registered blocks directly in place of the subsystem, and the internal
+ * blocks read the signals of the subsystem inputs from the outputs these 
+ * are connected to, see TimeDomain::run(). Running the subsystem itself, 
+ * e.g. from within another block, runs the registered blocks as well.
+ * Connect the inputs of the subsystem before the timedomain is started.
+ * A subsystem which overrides run() must not register blocks.
+ *
+ * @since v1.4.4
+ */
+class SubioBase : public Block {
+ public:
+  /**
+   * Runs the registered blocks in the order they were added.
+   */
+  void run() override {
+    for (auto block : blocks) block->run();
+  }
+
+  /**
+   * Returns the registered internal blocks.
+   *
+   * @return blocks in the order they are run
+   */
+  const std::vector<Block*>& getBlocks() const {
+    return blocks;
+  }
+
+ protected:
+  /**
+   * Registers an internal block, blocks are run in the order they are added.
+   *
+   * @param block - internal block
+   */
+  void addBlock(Block& block) {
+    blocks.push_back(&block);
+  }
+
+ private:
+  std::vector<Block*> blocks;
+};
+
 /**
  * Base class for all subsystem blocks with inputs and outputs.
  *
- * Extend this class and override the run method to implement any
- * given subsystem. 
+ * Extend this class and register the internal blocks with addBlock(), or 
+ * override the run method to implement any given subsystem. 
  * 
  * @tparam N - number of inputs
  * @tparam M - number of outputs
@@ -24,7 +71,7 @@ namespace control {
  */
 
 template < uint8_t N, uint8_t M, typename Tin = double, typename Tout = Tin >
-class Subio : public Block {
+class Subio : public SubioBase {
  public:
   /**
    * Construct a subsystem block with inputs and outputs. 
@@ -82,7 +129,7 @@ class Subio : public Block {
  * Spezialization for several inputs and 1 output
  */
 template < uint8_t N, typename Tin, typename Tout >
-class Subio<N,1,Tin,Tout> : public Block {
+class Subio<N,1,Tin,Tout> : public SubioBase {
  public:
   /**
    * Construct a subsystem block with several inputs and one output. 
@@ -137,7 +184,7 @@ class Subio<N,1,Tin,Tout> : public Block {
  * Spezialization for several inputs and no output
  */
 template < uint8_t N, typename Tin >
-class Subio<N,0,Tin> : public Block {
+class Subio<N,0,Tin> : public SubioBase {
  public:
   /**
    * Construct a subsystem block with several inputs and no output. 
@@ -171,7 +218,7 @@ class Subio<N,0,Tin> : public Block {
  * Spezialization for 1 input and several outputs
  */
 template < uint8_t M, typename Tin, typename Tout >
-class Subio<1,M,Tin,Tout> : public Block {
+class Subio<1,M,Tin,Tout> : public SubioBase {
  public:
   /**
    * Construct a subsystem block with one input and several outputs. 
@@ -225,7 +272,7 @@ class Subio<1,M,Tin,Tout> : public Block {
  * Spezialization for 1 input and 1 output
  */
 template < typename Tin, typename Tout >
-class Subio<1,1,Tin,Tout> : public Block {
+class Subio<1,1,Tin,Tout> : public SubioBase {
  public:
   /**
    * Construct a subsystem block with one input and one output. 
@@ -276,7 +323,7 @@ class Subio<1,1,Tin,Tout> : public Block {
  * Spezialization for 1 input and no output
  */
 template < typename Tin >
-class Subio<1,0,Tin> : public Block {
+class Subio<1,0,Tin> : public SubioBase {
  public:
   /**
    * Construct a subsystem block with one input and no output. 
@@ -305,7 +352,7 @@ class Subio<1,0,Tin> : public Block {
  * Spezialization for no input and several outputs
  */
 template < uint8_t M, typename Tout >
-class Subio<0,M,Tout> : public Block {
+class Subio<0,M,Tout> : public SubioBase {
  public:
   /**
    * Construct a subsystem block with no input and several outputs. 
@@ -349,7 +396,7 @@ class Subio<0,M,Tout> : public Block {
  * Spezialization for no input and one output
  */
 template < typename Tout >
-class Subio<0,1,Tout> : public Block {
+class Subio<0,1,Tout> : public SubioBase {
  public:
   /**
    * Construct a subsystem block with no input and one output. 
@@ -389,7 +436,7 @@ class Subio<0,1,Tout> : public Block {
  * Spezialization for no input and no output
  */
 template < >
-class Subio<0,0> : public Block {
+class Subio<0,0> : public SubioBase {
  public:
   /**
    * Construct a subsystem block with no input and no output. 
@@ -1,6 +1,7 @@
 #ifndef ORG_EEROS_CONTROL_SUM_HPP_
 #define ORG_EEROS_CONTROL_SUM_HPP_
 
+#include <algorithm>
 #include <eeros/control/Blockio.hpp>
 #include <eeros/control/Input.hpp>
 
@@ -52,12 +53,14 @@ class Sum : public Blockio<N,1,T> {
       first = false;
     } else {
       for (uint8_t i = 0; i < N; i++) {
-        if (negated[i]) sum -= this->in[i].getSignal().getValue();
-        else sum += this->in[i].getSignal().getValue();
+        const T& val = this->readSignal(this->in[i]).getValueRef();
+        if (negated[i]) sum -= val;
+        else sum += val;
       }
     }
-    this->out.getSignal().setValue(sum);
-    this->out.getSignal().setTimestamp(this->in[0].getSignal().getTimestamp());
+    timestamp_t oldest = this->readSignal(this->in[0]).getTimestamp();
+    for (uint8_t i = 1; i < N; i++) oldest = std::min(oldest, this->readSignal(this->in[i]).getTimestamp());
+    this->out.getSignal().set(sum, oldest);
   }
   
   /**
@@ -68,6 +71,7 @@ class Sum : public Blockio<N,1,T> {
   virtual void negateInput(uint8_t index) {
     if (index >= N) throw eeros::Fault("Trying to get inexistent element of input vector in block '" + this->getName() + "'");
     negated[index] = true;
+    this->markChanged();
   }
   
   /**
@@ -84,8 +88,18 @@ class Sum : public Blockio<N,1,T> {
     if (index >= N) throw eeros::Fault("Trying to get inexistent element of input vector in block '" + this->getName() + "'");
     init[index] = true;
     initVal[index] = val;
+    this->markChanged();
   }
 
+  /**
+   * The sum can be skipped while its inputs do not change, after its first run.
+   *
+   * @return true, if it has run before
+   * @see TimeDomain::setChangePropagation()
+   */
+  bool isSkippable() const override {
+    return !first;
+  }
 
  private:
   bool negated[N];
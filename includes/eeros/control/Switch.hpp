@@ -61,7 +61,7 @@ class Switch : public Blockio<N,1,T> {
         if (activeLevel == nullptr ||
            (activeLevel != nullptr && safetySystem->getCurrentLevel() >= *activeLevel)
            ) {
-          log.warn() << "Switch \'" + this->getName() + "\' switches!";
+          EEROS_HOTPATH_LOG(log.warn() << "Switch \'" << this->getName() << "\' switches!");
           switchToInput(nextInput);
           for(Switch* i : c) i->switchToInput(nextInput);
           switched = true;
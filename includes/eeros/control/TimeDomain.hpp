@@ -1,11 +1,19 @@
 #ifndef ORG_EEROS_CONTROLTIMEDOMAIN_HPP
 #define ORG_EEROS_CONTROLTIMEDOMAIN_HPP
 
-#include <list>
 #include <string>
+#include <utility>
+#include <vector>
+#include <eeros/core/Arena.hpp>
+#include <eeros/core/Wcet.hpp>
 #include <eeros/control/Block.hpp>
+#include <eeros/control/BlockProfiler.hpp>
+#include <eeros/control/FaultSlot.hpp>
+#include <eeros/control/FusedBlock.hpp>
 #include <eeros/control/NotConnectedFault.hpp>
 #include <eeros/control/NaNOutputFault.hpp>
+#include <eeros/control/SignalSnapshot.hpp>
+#include <eeros/control/Subio.hpp>
 #include <eeros/safety/SafetySystem.hpp>
 #include <eeros/safety/SafetyLevel.hpp>
 
@@ -49,6 +57,33 @@ class TimeDomain : public virtual Runnable {
    */
   virtual void addBlock(Block& block);
 
+  /**
+   * Constructs a block in the arena of the time domain and adds it. Blocks
+   * created one after the other, together with their output signals, lie next
+   * to each other in memory, so create them in the order they are run. The
+   * block is owned by the time domain and destroyed with it, removing it only
+   * stops running it.
+   *
+   * @param args - constructor arguments of the block
+   * @return block
+   * @see getArena()
+   */
+  template < typename B, typename... Args >
+  B& createBlock(Args&&... args) {
+    B& block = arena.create<B>(std::forward<Args>(args)...);
+    addBlock(block);
+    return block;
+  }
+
+  /**
+   * Returns the arena the blocks of createBlock() are allocated in. It can be
+   * used for other data the blocks work on, e.g. buffers. Call Arena::reserve()
+   * before creating the blocks to get all of them into a single chunk.
+   *
+   * @return arena
+   */
+  Arena& getArena();
+
   /**
    * Removes a block from a time domain.
    *
@@ -62,6 +97,70 @@ class TimeDomain : public virtual Runnable {
    * @param block - block 
    */
   virtual void removeBlock(Block& block);
+
+  /**
+   * Adds a fused block, which replaces its members in the run list when the
+   * time domain is frozen. The members must be added to the time domain as
+   * well. They are run at the position of the first member, so all blocks
+   * the members read from must run before it.
+   *
+   * @param block - fused block
+   * @see FusedBlock
+   * @see setFrozen()
+   */
+  void addFusedBlock(FusedBlockBase& block);
+
+  /**
+   * Removes a fused block, its members are run on their own again.
+   *
+   * @param block - fused block
+   */
+  void removeFusedBlock(FusedBlockBase& block);
+
+  /**
+   * Sorts the blocks along their connections, so that each block runs after the 
+   * blocks it gets its input signals from. This avoids an additional cycle of latency 
+   * for every connection which points against the order the blocks were added in. 
+   * The order of added blocks is kept wherever the connections allow it.
+   * A loop must contain a block without direct feedthrough, e.g. a delay, which
+   * then runs before the other blocks of the loop.
+   * Call this method after all blocks are added and connected.
+   *
+   * @throw Fault if the blocks form a loop without a block breaking it
+   * @see Block::hasDirectFeedthrough()
+   */
+  void sortBlocks();
+
+  /**
+   * Checks the inputs of all blocks. Blocks with all inputs connected are bound and
+   * read their inputs without checking the connection. This is done on start() and 
+   * before the first run after blocks were added or removed. Connect all inputs 
+   * before, blocks connected later are only bound after the next validation.
+   *
+   * @return blocks with unconnected inputs
+   * @see Block::setBound()
+   */
+  std::vector<Block*> validate();
+
+  /**
+   * In frozen mode the blocks are packed into a flat run list at the next start or run,
+   * in which independent blocks of the same type are grouped, so that consecutive calls 
+   * of run() mostly go to the same function. Blocks only change their position with
+   * respect to blocks they are not connected to, blocks with hidden inputs are never moved.
+   * Adding or removing blocks repacks the run list. Fused blocks replace their
+   * members, see addFusedBlock().
+   *
+   * @param enable - enables the frozen mode
+   * @see Block::hasKnownInputs()
+   */
+  void setFrozen(bool enable);
+
+  /**
+   * Returns the blocks in the order they are run, subsystems are not flattened.
+   *
+   * @return blocks
+   */
+  const std::vector<Block*>& getBlocks() const;
   
   /**
    * Returns the name of the timedomain.
@@ -93,8 +192,80 @@ class TimeDomain : public virtual Runnable {
    */
   void registerSafetyEvent(SafetySystem& ss, SafetyEvent& e);
 
+  /**
+   * When enabled, the time is read once at the beginning of each run and all
+   * blocks of the timedomain get this timestamp from System::getTimeNs().
+   * This gives consistent timestamps within a cycle and saves repeated clock reads.
+   *
+   * @param enable - enables the cycle timestamp
+   * @see System::beginCycle()
+   */
+  void setCycleTimestamp(bool enable);
+
+  /**
+   * Returns true if the cycle timestamp is enabled.
+   *
+   * @return true, if enabled
+   */
+  bool getCycleTimestamp();
+
+  /**
+   * When enabled, the run time of each block is measured with System::getClockNs()
+   * and recorded in the profiler of the timedomain. When disabled, running the 
+   * timedomain costs nothing extra.
+   *
+   * @param enable - enables the profiling
+   * @see getProfiler()
+   */
+  void setProfiling(bool enable);
+
+  /**
+   * In change propagation mode, a block which reports Block::isSkippable() is not run
+   * as long as none of its input signals were written since its last run and its 
+   * parameters were not changed. The outputs of a skipped block keep their value and 
+   * their timestamp. A constant then only writes its output when its value is changed,
+   * so mostly static parts of a control system cost next to nothing.
+   *
+   * @param enable - enables change propagation
+   * @see Block::isSkippable()
+   * @see SignalInterface::getVersion()
+   */
+  void setChangePropagation(bool enable);
+
+  /**
+   * Returns true if change propagation is enabled.
+   *
+   * @return true, if enabled
+   */
+  bool getChangePropagation();
+
+  /**
+   * Sets a snapshot, which is captured at the end of each run, also after a
+   * fault. Readers on other threads then get the signals of one cycle.
+   *
+   * @param snapshot - snapshot, nullptr for none
+   * @see SignalSnapshot
+   */
+  void setSnapshot(SignalSnapshot* snapshot);
+
+  /**
+   * Returns the profiler with the run time statistics of all blocks.
+   * The profiler is filled in after the first run with profiling enabled.
+   *
+   * @return profiler
+   */
+  BlockProfiler& getProfiler();
+
   /**
    * The basic algorithm of the timedomain. It will run all blocks.
+   * Subsystems with registered blocks are flattened on start() or before the first run
+   * after blocks were added or removed: their blocks are run in their place, without 
+   * running the subsystem, and read the subsystem inputs directly from the connected outputs.
+   * If a block reports a fault, the remaining blocks are skipped for this run
+   * and the registered safety event is triggered. Without a registered safety 
+   * event a Fault is thrown.
+   *
+   * @see FaultSlot
    */
   virtual void run();
 
@@ -137,9 +308,41 @@ class TimeDomain : public virtual Runnable {
   double period;
   bool realtime;
   bool running = true;
-  std::list<Block*> blocks;
+  bool cycleTimestamp = false;
+  bool changePropagation = false;
+  SignalSnapshot* snapshot = nullptr;
+  void pack();
+  void fuse(FusedBlockBase* fused);
+  void flatten();
+  void expand(Block* block);
+  void watchInputs();
+  bool isUnchanged(std::size_t index);
+  void runProfiled(const std::vector<Block*>& list);
+  void raise(const std::string& message);
+  std::vector<Block*> blocks;
+  std::vector<Block*> runList;
+  std::vector<Block*> flatList;
+  struct Watch {
+    std::size_t first, count;
+    bool known;
+  };
+  std::vector<Watch> watches;   // inputs of the blocks of the flat list
+  std::vector<std::pair<const SignalInterface*, uint64_t>> versions;
+  std::vector<FusedBlockBase*> fusedBlocks;
+  bool frozen = false;
+  bool packed = false;
+  bool validated = false;
+  bool flattened = false;
+  bool profiling = false;
+  bool profiled = false;
+  BlockProfiler profiler;
+#ifdef EEROS_WCET
+  std::vector<Wcet::Probe*> wcetProbes;   // parallel to the flat list
+#endif
+  FaultSlot fault;
   SafetySystem* safetySystem;
   SafetyEvent* safetyEvent;
+  Arena arena;  // last member, so created blocks are destroyed first
 };
 
 }
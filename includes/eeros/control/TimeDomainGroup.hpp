@@ -0,0 +1,152 @@
+#ifndef ORG_EEROS_CONTROL_TIMEDOMAINGROUP_HPP_
+#define ORG_EEROS_CONTROL_TIMEDOMAINGROUP_HPP_
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <eeros/control/PipelineRegister.hpp>
+#include <eeros/control/TimeDomain.hpp>
+#include <eeros/core/FutexSemaphore.hpp>
+#include <eeros/logger/Logger.hpp>
+
+namespace eeros {
+namespace control {
+
+/**
+ * A timedomain group runs several timedomains with the same period in parallel.
+ * Dependencies between the timedomains can be declared, a timedomain only runs 
+ * after all timedomains it depends on have finished. The timedomains are arranged 
+ * in stages, all timedomains of a stage are independent of each other and are
+ * distributed over a set of worker threads, each pinned to its own core. 
+ * The thread of the group takes part in the work and waits at the end of each stage 
+ * until all timedomains of the stage have finished.
+ * 
+ * A chain of timedomains which does not fit into one period on one core can be
+ * pipelined: instead of declaring a dependency, the signals are passed through
+ * pipeline registers, see addPipelineRegister(). The timedomains then run in
+ * parallel, the consumer working on the result of the previous cycle.
+ *
+ * Add the group to the executor instead of the individual timedomains.
+ * The worker threads are started with the first run and inherit the
+ * scheduling policy and priority of the thread running the group.
+ *
+ * @since v1.4.4
+ */
+class TimeDomainGroup : public Runnable {
+ public:
+  /**
+   * Constructs a timedomain group.
+   *
+   * @param name - name
+   * @param period - periodicity of the execution, all timedomains must have this period
+   * @param realtime - when true, executor creates a realtime thread if available by the system
+   * @param cpus - cores of the worker threads, one worker per core
+   */
+  TimeDomainGroup(std::string name, double period, bool realtime, std::vector<int> cpus);
+  virtual ~TimeDomainGroup();
+
+  TimeDomainGroup(const TimeDomainGroup&) = delete;
+
+  /**
+   * Adds a timedomain to the group.
+   *
+   * @param td - timedomain, must have the period of the group
+   */
+  void add(TimeDomain& td);
+
+  /**
+   * Declares that a timedomain must not run before another one has finished in the same cycle.
+   *
+   * @param before - timedomain which runs first
+   * @param after - timedomain which depends on the output of before
+   */
+  void addDependency(TimeDomain& before, TimeDomain& after);
+
+  /**
+   * Adds a pipeline register, which is latched at the beginning of each cycle.
+   * Its block must be added to the producing timedomain, no dependency is
+   * declared between the producing and the consuming timedomain.
+   *
+   * @param reg - pipeline register
+   * @see PipelineRegister
+   */
+  void addPipelineRegister(PipelineRegisterBase& reg);
+
+  /**
+   * Returns the name of the group.
+   *
+   * @return name 
+   */
+  std::string getName();
+
+  /**
+   * Returns the period of the group.
+   *
+   * @return period 
+   */
+  double getPeriod();
+
+  /**
+   * Returns the true if the group is executed with a realtime thread.
+   *
+   * @return true, if realtime 
+   */
+  bool getRealtime();
+
+  /**
+   * Returns the stages as calculated from the dependencies, timedomains of a stage run in parallel.
+   *
+   * @return stages
+   */
+  const std::vector<std::vector<TimeDomain*>>& getStages();
+
+  /**
+   * Latches the pipeline registers and runs all timedomains of the group, stage after stage.
+   */
+  virtual void run();
+
+ private:
+  struct Worker {
+    FutexSemaphore wakeup;
+    std::thread thread;
+  };
+
+  void buildStages();
+  void startWorkers();
+  void work();
+  void workerLoop(Worker* w, int cpu);
+
+  std::string name;
+  double period;
+  bool realtime;
+  std::vector<int> cpus;
+  std::vector<TimeDomain*> domains;
+  std::vector<std::pair<TimeDomain*, TimeDomain*>> dependencies;
+  std::vector<PipelineRegisterBase*> registers;
+  std::vector<std::vector<TimeDomain*>> stages;
+  bool stagesValid = false;
+  std::vector<std::unique_ptr<Worker>> workers;
+  const std::vector<TimeDomain*>* current = nullptr;
+  std::atomic<size_t> next{0};
+  std::atomic<size_t> activeHelpers{0};
+  std::atomic<bool> finished{false};
+  FutexSemaphore stageDone;
+  std::exception_ptr error;
+  std::atomic<bool> failed{false};
+  logger::Logger log;
+};
+
+/**
+ * Operator overload (<<) to enable an easy way to print the state of a
+ * timedomain group instance to an output stream.\n
+ * Does not print a newline control character.
+ */
+std::ostream& operator<<(std::ostream& os, TimeDomainGroup& g);
+
+}
+}
+
+#endif // ORG_EEROS_CONTROL_TIMEDOMAINGROUP_HPP_
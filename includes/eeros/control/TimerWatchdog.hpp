@@ -0,0 +1,118 @@
+#ifndef ORG_EEROS_CONTROL_TIMERWATCHDOG_HPP_
+#define ORG_EEROS_CONTROL_TIMERWATCHDOG_HPP_
+
+#include <eeros/control/Block.hpp>
+#include <eeros/logger/Logger.hpp>
+#include <eeros/safety/SafetyLevel.hpp>
+#include <eeros/safety/SafetySystem.hpp>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <thread>
+
+namespace eeros {
+namespace control {
+
+/**
+ * A timer watchdog detects a stalled time domain. In contrast to Watchdog, which
+ * resets a hardware timer, it needs no hardware: a timer thread wakes up four
+ * times per timeout on a timerfd and checks whether the block was run in between.
+ * If the block did not run for the timeout, the registered safety event is
+ * triggered from the timer thread, so a complete stall of the time domain is
+ * noticed as well. The stall is detected between one and 1.25 timeouts after the
+ * last run, plus the wake-up latency of the timer thread, which should therefore
+ * get a realtime priority above the one of the watched time domain.
+ *
+ * run() costs a single atomic store. The watchdog only fires when it is armed.
+ * After it fired, it must be armed again.
+ *
+ * @since v1.4.4
+ */
+class TimerWatchdog : public Block {
+ public:
+  /**
+   * Constructs a timer watchdog and starts its timer thread.
+   *
+   * @param timeout - timeout in seconds
+   * @param priority - realtime priority of the timer thread, 0 for normal scheduling
+   */
+  TimerWatchdog(double timeout, int priority = 0);
+
+  /**
+   * Disabling use of copy constructor because the block should never be copied unintentionally.
+   */
+  TimerWatchdog(const TimerWatchdog& s) = delete;
+
+  /**
+   * Stops the timer thread.
+   */
+  ~TimerWatchdog() override;
+
+  /**
+   * Runs the watchdog block, which resets the timeout.
+   */
+  void run() override {
+    pets.store(++count, std::memory_order_relaxed);
+  }
+
+  /**
+   * Arms the watchdog, the timeout starts again.
+   */
+  void arm();
+
+  /**
+   * Disarms the watchdog, it does not fire anymore.
+   */
+  void disarm();
+
+  /**
+   * Returns the current status of the watchdog.
+   *
+   * @return - true -> no timeout, false -> timeout happened since arm()
+   */
+  bool getStatus() const;
+
+  /**
+   * @return timeout in seconds
+   */
+  double getTimeout() const;
+
+  /**
+   * Registers the safety event, which is triggered on a timeout.
+   *
+   * @param ss - SafetySystem
+   * @param e - SafetyEvent
+   */
+  void registerSafetyEvent(safety::SafetySystem& ss, safety::SafetyEvent& e);
+
+ private:
+  static constexpr int checksPerTimeout = 4;
+
+  void loop();
+
+  double timeout;
+  uint64_t count = 0;                 // written by run() only
+  std::atomic<uint64_t> pets{0};
+  std::atomic<bool> isArmed{false};
+  std::atomic<uint64_t> generation{0}; // incremented by each arm()
+  std::atomic<uint64_t> expiredGeneration{~0ull}; // generation which timed out
+  std::atomic<bool> stopping{false};
+  std::atomic<safety::SafetySystem*> safetySystem{nullptr};
+  std::atomic<safety::SafetyEvent*> safetyEvent{nullptr};
+  int fd;
+  int priority;
+  logger::Logger log;
+  std::thread thread;
+};
+
+/**
+ * Operator overload (<<) to enable an easy way to print the state of a
+ * timer watchdog instance to an output stream.\n
+ * Does not print a newline control character.
+ */
+std::ostream& operator<<(std::ostream& os, TimerWatchdog& wdt);
+
+}
+}
+
+#endif /* ORG_EEROS_CONTROL_TIMERWATCHDOG_HPP_ */
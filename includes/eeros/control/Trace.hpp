@@ -128,8 +128,10 @@ private:
       timestamp_t* timeStampBuf = trace.getTimestampTrace();
       T* buf = trace.getTrace();
       file << "name = " << trace.getName() << ", size = " << trace.getSize() << ", maxBufLen = " << trace.maxBufLen << "\n";
-      for (uint32_t i = 0; i < trace.getSize(); i++) file << timeStampBuf[i] << " " << buf[i] << std::endl;
+      for (uint32_t i = 0; i < trace.getSize(); i++) file << timeStampBuf[i] << " " << buf[i] << "\n";
       file.close();
+      delete[] timeStampBuf;
+      delete[] buf;
       log.info() << "trace file written";
     }
   }
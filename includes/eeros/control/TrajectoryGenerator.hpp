@@ -30,6 +30,7 @@ class TrajectoryGenerator : public Block {
    */
   TrajectoryGenerator() {
     for(auto& e : last) e = 0;
+    for(auto& e : target) e = 0;
   }
   
   /**
@@ -56,6 +57,7 @@ class TrajectoryGenerator : public Block {
   
   /**
    * Dispatches a new trajectory from the current position to the end position.
+   * The current position is where the last trajectory ends or the start position.
    * The higher derivatives of the position are set to 0.
    * 
    * @param end - end position
@@ -68,7 +70,7 @@ class TrajectoryGenerator : public Block {
     std::array<T, N> e;
     for(auto& i : e) i = 0;
     e[0] = end;
-    return move(last, e);
+    return move(target, e);
   }
   
   /**
@@ -81,7 +83,7 @@ class TrajectoryGenerator : public Block {
    * @see run()
    */
   virtual bool move(std::array<T, N> end) {
-    return move(last, end);
+    return move(target, end);
   }
   
   /**
@@ -123,7 +125,8 @@ class TrajectoryGenerator : public Block {
   }
   
  protected:
-  std::array<T, N> last;
+  std::array<T, N> last;   // state of the last run, written by the realtime thread
+  std::array<T, N> target; // state after the last requested trajectory, written by the thread calling move()
 };
 
 };
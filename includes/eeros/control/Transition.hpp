@@ -1,32 +1,51 @@
 #ifndef ORG_EEROS_CONTROL_TRANSITION_HPP_
 #define ORG_EEROS_CONTROL_TRANSITION_HPP_
 
-#include <mutex>
 #include <eeros/control/Blockio.hpp>
+#include <eeros/core/Fault.hpp>
+#include <eeros/core/SpscRingBuffer.hpp>
+#include <eeros/core/TripleBuffer.hpp>
+#include <array>
+#include <atomic>
+#include <cmath>
 #include <iostream>
 
 namespace eeros {
 namespace control {
 
-template < typename T > class TransitionInBlock;
-template < typename T > class TransitionOutBlock;
+template < typename T, int N > class TransitionInBlock;
+template < typename T, int N > class TransitionOutBlock;
+
+/** A sample handed over by a transition block */
+template < typename T >
+struct TransitionSample {
+  T value;
+  timestamp_t timestamp;
+};
 
 /**
- * A transition block serves to bring a signal from one timedomain to another. 
- * It consists of two separate blocks, each of them running in one of the 
+ * A transition block serves to bring a signal from one timedomain to another.
+ * It consists of two separate blocks, each of them running in one of the
  * two timedomains which the transition block connects.
  * You have to add the inBlock of this transition block to one timedomain
  * and the outBlock to the second timedomain.
  *
+ * The two blocks never lock, the samples are handed over through wait-free
+ * buffers. From fast to slow, the inBlock pushes each sample into a ring buffer
+ * and the outBlock drains all samples pushed since its last run in one call,
+ * they stay available as a batch, see TransitionOutBlock::getBatchLength().
+ * If the ring buffer is full, samples are dropped and counted, see getOverruns().
+ *
  * @tparam T - signal type (double - default type)
+ * @tparam N - capacity of the ring buffer from fast to slow, a power of two (128 - default value)
  *
  * @since v1.0
  */
 
-template < typename T = double >
+template < typename T = double, int N = 128 >
 class Transition {
-  friend class TransitionInBlock<T>;
-  friend class TransitionOutBlock<T>;
+  friend class TransitionInBlock<T, N>;
+  friend class TransitionOutBlock<T, N>;
  public:
   /**
    * Construct an transition block with one input and one output.
@@ -43,119 +62,151 @@ class Transition {
     if (ratio >= 1.0) {	// slow to fast time domain
       inBlock.up = true;
       outBlock.up = true;
-      refresh = false;
-      in.clear(); 
-      prevIn.clear();
     } else {	// fast to slow time domain
       inBlock.up = false;
       outBlock.up = false;
-      bufSize = 1 / ratio;
+      if (!steady && ratio > 0 && std::ceil(1 / ratio) > N) {
+        throw Fault("buffer of transition block is too small for ratio " + std::to_string(ratio));
+      }
     }
+    // the first interpolation starts from the cleared signal
+    inBlock.last = {outBlock.getOut().getSignal().getValue(), 0};
   }
 
   /**
    * Disabling use of copy constructor because the block should never be copied unintentionally.
    */
-  Transition(const Transition& s) = delete; 
+  Transition(const Transition& s) = delete;
+
+  /**
+   * @return number of samples dropped because the ring buffer was full
+   */
+  uint64_t getOverruns() const {
+    return overruns.load(std::memory_order_relaxed);
+  }
 
   /** The block running in the timedomain from which the signal originates */
-  TransitionInBlock<T> inBlock;
+  TransitionInBlock<T, N> inBlock;
   /** The block running in the timedomain to which the signal has to be delivered */
-  TransitionOutBlock<T> outBlock;
-  
- private: 
-  std::vector<Signal<T>> buf;
-  Signal<T> in, prevIn;
-  bool refresh;
+  TransitionOutBlock<T, N> outBlock;
+
+ private:
+  using Sample = TransitionSample<T>;
+  struct Interval {
+    Sample prev, in;
+  };
+
   bool steady;
   double ratio;
-  uint32_t bufSize;
-  std::mutex mtx;
+  TripleBuffer<Sample> latest;         // steady
+  TripleBuffer<Interval> interval;     // slow to fast
+  SpscRingBuffer<Sample, N> samples;   // fast to slow
+  std::atomic<uint64_t> overruns{0};
 };
 
-template < typename T = double >
+template < typename T = double, int N = 128 >
 class TransitionInBlock : public Blockio<1,0,T> {
-  friend class Transition<T>;
+  friend class Transition<T, N>;
  public:
-  TransitionInBlock(Transition<T>& c) : container(c) { }
-  
-  virtual void run() { 
+  TransitionInBlock(Transition<T, N>& c) : container(c) { }
+
+  virtual void run() {
+    const Signal<T>& sig = this->readSignal(this->in);
+    TransitionSample<T> s{sig.getValueRef(), sig.getTimestamp()};
     if (container.steady) {
-      container.mtx.lock();
-      container.in = this->getIn().getSignal(); 
-      container.mtx.unlock();
+      container.latest.write(s);
     } else {
       if (up) {	// up
-        container.mtx.lock();
-        container.prevIn = container.in;
-        container.in = this->getIn().getSignal(); 
-        container.refresh = true;
-        container.mtx.unlock();
+        container.interval.write({last, s});
+        last = s;
       } else {	//down
-        container.mtx.lock();
-        auto val = this->getIn().getSignal(); 
-        container.buf.push_back(val);
-        container.mtx.unlock();
+        if (!container.samples.push(s)) container.overruns.fetch_add(1, std::memory_order_relaxed);
       }
     }
   }
-  
+
  protected:
   bool up;
-  Transition<T>& container;
+  Transition<T, N>& container;
+  TransitionSample<T> last;
 };
 
-template < typename T = double >
+template < typename T = double, int N = 128 >
 class TransitionOutBlock : public Blockio<1,1,T> {
-  friend class Transition<T>;
+  friend class Transition<T, N>;
+  using Sample = TransitionSample<T>;
  public:
-  TransitionOutBlock(Transition<T>& c) : container(c), count(0) {in.clear(); prevIn.clear();}
-  
-  virtual void run() { 
+  TransitionOutBlock(Transition<T, N>& c) : container(c), count(0) { }
+
+  virtual void run() {
     if (container.steady) {
-      container.mtx.lock();
-      this->getOut().getSignal().setValue(container.in.getValue()); 
-      this->getOut().getSignal().setTimestamp(container.in.getTimestamp());
-      container.mtx.unlock();
+      bool newData;
+      const Sample& s = container.latest.read(newData);
+      received |= newData;
+      if (received) this->getOut().getSignal().set(s.value, s.timestamp);
     } else {
       if (up) {	// up
-        if (container.refresh) {
-          container.mtx.lock();
-          prevIn = container.prevIn;
-          in = container.in;
-          container.refresh = false;
-          container.mtx.unlock();
+        bool newData;
+        const typename Transition<T, N>::Interval& s = container.interval.read(newData);
+        if (newData) {
+          from = s.prev;
+          to = s.in;
+          received = true;
           count = 0;
-          dVal = (in.getValue() - prevIn.getValue()) / container.ratio;
-          dTime= (in.getTimestamp() - prevIn.getTimestamp()) / container.ratio;
+          dVal = (to.value - from.value) / container.ratio;
+          dTime = (to.timestamp - from.timestamp) / container.ratio;
         }
-        T val = prevIn.getValue() + dVal * count;
-        this->getOut().getSignal().setValue(val);
-        timestamp_t time = prevIn.getTimestamp() + count * dTime;
-        this->getOut().getSignal().setTimestamp(time);
+        if (!received) return;
+        T val = from.value + dVal * count;
+        timestamp_t time = from.timestamp + count * dTime;
+        this->getOut().getSignal().set(val, time);
         count++;
       } else {	//down
-        auto time = this->getIn().getSignal().getTimestamp();
-        container.mtx.lock();
-        std::size_t i = 0;
-        while (i < container.buf.size() && time > container.buf[i].getTimestamp()) i++;
+        auto time = this->readSignal(this->in).getTimestamp();
+        batchLength = 0;
+        while (batchLength < N && container.samples.pop(batch[batchLength])) batchLength++;
+        if (batchLength == 0) return;
+        unsigned int i = 0;
+        while (i < batchLength && time > batch[i].timestamp) i++;
         if (i > 0) i--;
-        Signal<T> sig = container.buf[i];
-        container.buf.clear();
-        container.mtx.unlock();
-        this->getOut().getSignal().setValue(sig.getValue());
-        this->getOut().getSignal().setTimestamp(sig.getTimestamp());
+        this->getOut().getSignal().set(batch[i].value, batch[i].timestamp);
       }
     }
   }
-  
+
+  /**
+   * @return number of samples drained by the last run from fast to slow
+   */
+  unsigned int getBatchLength() const {
+    return batchLength;
+  }
+
+  /**
+   * @param i - index of the sample, 0 is the oldest
+   * @return value of a sample drained by the last run
+   */
+  const T& getBatchValue(unsigned int i) const {
+    return batch[i].value;
+  }
+
+  /**
+   * @param i - index of the sample, 0 is the oldest
+   * @return timestamp of a sample drained by the last run
+   */
+  timestamp_t getBatchTimestamp(unsigned int i) const {
+    return batch[i].timestamp;
+  }
+
  protected:
   bool up;
-  Transition<T>& container;
-  Signal<T> prevIn, in;
+  Transition<T, N>& container;
+  Sample from, to;     // interval to interpolate
   T dVal;
   double dTime;
   uint32_t count;
+  bool received = false;
+  std::array<Sample, N> batch;
+  unsigned int batchLength = 0;
 };
 
 /**
@@ -163,10 +214,10 @@ class TransitionOutBlock : public Blockio<1,1,T> {
  * transition block instance to an output stream.\n
  * Does not print a newline control character.
  */
-template <typename T>
-std::ostream& operator<<(std::ostream& os, Transition<T>& t) {
-  os << "Block transition: '" << t.getName() << "'"; 
-        return os;
+template < typename T, int N >
+std::ostream& operator<<(std::ostream& os, Transition<T, N>& t) {
+  os << "Block transition: '" << t.inBlock.getName() << "' overruns=" << t.getOverruns();
+  return os;
 }
 
 }
@@ -0,0 +1,188 @@
+#ifndef ORG_EEROS_CONTROL_VARIABLEDELAY_HPP_
+#define ORG_EEROS_CONTROL_VARIABLEDELAY_HPP_
+
+#include <eeros/control/Blockio.hpp>
+#include <eeros/core/Fault.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <eeros/math/MatrixKernels.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace eeros {
+namespace control {
+
+/**
+ * A variable delay block delays an input signal by a delay which can be changed
+ * while the block is running, e.g. for a dead time compensation. The delay need
+ * not be a multiple of the sampling time, values between two samples are linearly
+ * interpolated. The timestamp of the output is interpolated in the same way.
+ *
+ * The history is kept in one ring buffer which is allocated for the maximum
+ * delay when the block is constructed. Its length is a power of two, so wrapping
+ * an index is a mask operation. If the signal is a matrix, each slot of the buffer
+ * holds all elements of one sample next to each other. A run writes one slot and
+ * reads at most two, the interpolation uses the vector kernels of the matrix library.
+ *
+ * Until the history is filled, the output is NaN.
+ *
+ * @tparam T - input and output signal data type, a floating point type or a matrix of it (double - default type)
+ * @tparam Uin - input signal unit type (dimensionless - default type)
+ * @tparam Uout - output signal unit type (dimensionless - default type)
+ *
+ * @since v1.4.4
+ */
+template < typename T = double, SIUnit Uin = SIUnit::create(), SIUnit Uout = SIUnit::create() >
+class VariableDelay : public Blockio<1,1,T,T,MakeUnitArray<Uin>::value,MakeUnitArray<Uout>::value> {
+  using V = typename math::ValueShape<T>::value_type;
+  static constexpr unsigned int C = math::ValueShape<T>::size;
+  static_assert(std::is_floating_point_v<V>, "VariableDelay needs floating point values or a matrix of them");
+
+ public:
+  /**
+   * Constructs a variable delay block instance with a given maximum delay in s.
+   * The delay is set to this maximum. The parameter maxDelay together with the
+   * sampling time determine the length of the buffer.
+   *
+   * @param maxDelay - maximum delay in s
+   * @param ts - sampling time in s
+   */
+  VariableDelay(double maxDelay, double ts) : ts(ts) {
+    double n = toSamples(maxDelay);
+    if (!(n >= 1)) throw eeros::Fault("delay has negative or zero length");
+    maxSamples = static_cast<uint32_t>(n);
+    // one more slot for the interpolation
+    capacity = 1;
+    while (capacity < maxSamples + 2) capacity <<= 1;
+    mask = capacity - 1;
+    buf = new V[capacity * C];
+    timeBuf = new timestamp_t[capacity];
+    samples = maxSamples;
+    reset();
+  }
+
+  /**
+   * Disabling use of copy constructor because the block should never be copied unintentionally.
+   */
+  VariableDelay(const VariableDelay& s) = delete;
+
+  /**
+   * Destructor frees buffers.
+   */
+  ~VariableDelay() override {
+    delete[] buf;
+    delete[] timeBuf;
+  }
+
+  /**
+   * The output does not depend on the input of the same cycle, so a delay breaks loops.
+   *
+   * @return false
+   */
+  bool hasDirectFeedthrough() const override {
+    return false;
+  }
+
+  /**
+   * Runs the delay block.
+   */
+  void run() override {
+    const Signal<T>& sig = this->readSignal(this->in);
+    const V* x = math::ValueShape<T>::data(sig.getValueRef());
+    std::copy(x, x + C, buf + head * C);
+    timeBuf[head] = sig.getTimestamp();
+
+    double d = samples.load(std::memory_order_relaxed);
+    uint32_t k = static_cast<uint32_t>(d);
+    V f = static_cast<V>(d - k);
+    uint32_t ia = (head - k) & mask;
+    uint32_t ib = (head - k - 1) & mask;
+    T y;
+    if (f == 0) {
+      std::copy(buf + ia * C, buf + ia * C + C, math::ValueShape<T>::data(y));
+      this->out.getSignal().set(y, timeBuf[ia]);
+    } else {
+      math::kernel::lerp(math::ValueShape<T>::data(y), buf + ia * C, buf + ib * C, f, C);
+      double dt = static_cast<double>(timeBuf[ia]) - static_cast<double>(timeBuf[ib]);
+      this->out.getSignal().set(y, timeBuf[ia] - static_cast<timestamp_t>(std::llround(f * dt)));
+    }
+    head = (head + 1) & mask;
+  }
+
+  /**
+   * Sets the delay. The delay can be changed while the block is running.
+   *
+   * @param delay - delay in s, between the sampling time and the maximum delay
+   */
+  virtual void setDelay(double delay) {
+    double n = toSamples(delay);
+    if (!(n >= 1 && n <= maxSamples)) throw eeros::Fault("delay out of range in block '" + this->getName() + "'");
+    samples.store(n, std::memory_order_relaxed);
+  }
+
+  /**
+   * @return delay in s
+   */
+  virtual double getDelay() const {
+    return samples.load(std::memory_order_relaxed) * ts;
+  }
+
+  /**
+   * @return maximum delay in s
+   */
+  virtual double getMaxDelay() const {
+    return maxSamples * ts;
+  }
+
+  /**
+   * Clears the history, the output is NaN until it is filled again.
+   */
+  virtual void reset() {
+    std::fill(buf, buf + capacity * C, std::numeric_limits<V>::quiet_NaN());
+    std::fill(timeBuf, timeBuf + capacity, 0);
+    head = 0;
+  }
+
+  /*
+   * Friend operator overload to give the operator overload outside
+   * the class access to the private fields.
+   */
+  template <typename X>
+  friend std::ostream& operator<<(std::ostream& os, VariableDelay<X>& delay);
+
+ private:
+  // delay in samples, rounded if it is a multiple of the sampling time up to rounding errors
+  double toSamples(double delay) const {
+    double n = delay / ts;
+    double r = std::round(n);
+    return (std::abs(n - r) < 1e-9) ? r : n;
+  }
+
+  double ts; // sampling time in s
+  std::atomic<double> samples; // delay in samples
+  uint32_t maxSamples; // maximum delay in samples
+  uint32_t capacity; // number of slots of the buffer, a power of two
+  uint32_t mask; // capacity - 1
+  uint32_t head{0}; // slot of the current input
+  V* buf; // delay buffer for signal values, capacity slots of C values
+  timestamp_t* timeBuf; // delay buffer for timestamps
+};
+
+/**
+ * Operator overload (<<) to enable an easy way to print the state of a
+ * variable delay instance to an output stream.\n
+ * Does not print a newline control character.
+ */
+template <typename T>
+std::ostream& operator<<(std::ostream& os, VariableDelay<T>& delay) {
+  os << "Block variable delay: '" << delay.getName() << "' with a delay of " << delay.getDelay() << "s";
+  os << ", maximum delay=" << delay.getMaxDelay() << "s";
+  return os;
+}
+
+};
+};
+
+#endif /* ORG_EEROS_CONTROL_VARIABLEDELAY_HPP_ */
@@ -0,0 +1,162 @@
+#ifndef ORG_EEROS_CONTROL_VECTORSIGNALCHECKER_HPP_
+#define ORG_EEROS_CONTROL_VECTORSIGNALCHECKER_HPP_
+
+#include <eeros/control/Blockio.hpp>
+#include <eeros/safety/SafetyLevel.hpp>
+#include <eeros/safety/SafetySystem.hpp>
+#include <eeros/logger/Logger.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <eeros/math/MatrixKernels.hpp>
+#include <mutex>
+
+
+namespace eeros {
+namespace control {
+
+/**
+ * A vector signal checker block checks each element of a matrix signal against
+ * its own lower and upper limit, e.g. the positions of all joints of a robot.
+ * It replaces one SignalChecker per element with a single block, which checks
+ * all elements in one pass without branches and fires a single safety event.
+ *
+ * An element violates its limits if it is not greater than its lower limit and
+ * smaller than its upper limit, NaN always violates the limits. On a violation,
+ * the index of the first violating element is kept, see getViolation(), and
+ * logged. The safety event is triggered only if a safety event is registered and
+ * the current safety level is greater or the same as the active level set on this
+ * checker. If a safety event was already triggered, the checker must be reset
+ * before it will trigger another safety event.
+ * @see reset()
+ *
+ * A vector signal checker block is suitable for use with multiple threads.
+ *
+ * @tparam Tsig - signal type, a matrix (Matrix<2,1> - default type)
+ *
+ * @since v1.4.4
+ */
+template < typename Tsig = math::Matrix<2,1> >
+class VectorSignalChecker : public Blockio<1,0,Tsig> {
+  using Shape = math::ValueShape<Tsig>;
+
+ public:
+  /**
+   * Constructs a vector signal checker instance with per element limits.\n
+   *
+   * @param lowerLimit - initial lower limits
+   * @param upperLimit - initial upper limits
+   */
+  VectorSignalChecker(Tsig lowerLimit, Tsig upperLimit)
+      : lowerLimit(lowerLimit),
+        upperLimit(upperLimit),
+        log(logger::Logger::getLogger()) { }
+
+  /**
+   * Disabling use of copy constructor because the block should never be copied unintentionally.
+   */
+  VectorSignalChecker(const VectorSignalChecker& s) = delete;
+
+  /**
+   * Runs the checker algorithm.
+   *
+   * Checks if all elements are in the band in between their lower and upper limit.
+   * Triggers a safety event otherwise.
+   *
+   * @see registerSafetyEvent()
+   * @see setActiveLevel()
+   */
+  void run() override {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (fired) return;
+    const Tsig& val = this->readSignal(this->in).getValueRef();
+    unsigned int i = math::kernel::firstOutside(Shape::data(val), Shape::data(lowerLimit), Shape::data(upperLimit), Shape::size);
+    if (i == Shape::size) return;
+    if (safetySystem != nullptr && safetyEvent != nullptr) {
+      if (activeLevel == nullptr || safetySystem->getCurrentLevel() >= *activeLevel) {
+        violation = i;
+        EEROS_HOTPATH_LOG(log.warn() << "Signal checker \'" << this->getName() << "\' fires, element " << i << " is " << Shape::data(val)[i]);
+        safetySystem->triggerEvent(*safetyEvent);
+        fired = true;
+      }
+    }
+  }
+
+  /**
+   * Sets the lower and upper limits.
+   *
+   * @param lowerLimit - lower limits
+   * @param upperLimit - upper limits
+   */
+  virtual void setLimits(Tsig lowerLimit, Tsig upperLimit) {
+    std::lock_guard<std::mutex> lock(mtx);
+    this->lowerLimit = lowerLimit;
+    this->upperLimit = upperLimit;
+  }
+
+  /**
+   * Resets the checker so it can fire a safety event again.
+   */
+  virtual void reset() {
+    std::lock_guard<std::mutex> lock(mtx);
+    fired = false;
+    violation = -1;
+  }
+
+  /**
+   * Returns the index of the first element, which violated its limits when
+   * the safety event was triggered. The index is column major for matrices.
+   *
+   * @return index of the violating element, -1 if the checker did not fire
+   */
+  virtual int getViolation() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return violation;
+  }
+
+  /**
+   * Registers a safety event.
+   *
+   * @param ss - SafetySystem
+   * @param e - SafetyEvent
+   */
+  virtual void registerSafetyEvent(safety::SafetySystem &ss, safety::SafetyEvent &e) {
+    std::lock_guard<std::mutex> lock(mtx);
+    safetySystem = &ss;
+    safetyEvent = &e;
+  }
+
+  /**
+   * Sets the active safety level on this checker.
+   *
+   * @param level - SafetyLevel
+   */
+  virtual void setActiveLevel(safety::SafetyLevel &level) {
+    std::lock_guard<std::mutex> lock(mtx);
+    activeLevel = &level;
+  }
+
+ protected:
+  Tsig lowerLimit, upperLimit;
+  bool fired = false;
+  int violation = -1;
+  safety::SafetySystem *safetySystem = nullptr;
+  safety::SafetyEvent *safetyEvent = nullptr;
+  safety::SafetyLevel *activeLevel = nullptr;
+  eeros::logger::Logger log;
+  std::mutex mtx{};
+};
+
+/**
+ * Operator overload (<<) to enable an easy way to print the state of a
+ * vector signal checker instance to an output stream.\n
+ * Does not print a newline control character.
+ */
+template < typename T >
+std::ostream& operator<<(std::ostream& os, VectorSignalChecker<T>& b) {
+  os << "Block vector signal checker: '" << b.getName() << "' violation=" << b.getViolation();
+  return os;
+}
+
+}
+}
+
+#endif /* ORG_EEROS_CONTROL_VECTORSIGNALCHECKER_HPP_ */
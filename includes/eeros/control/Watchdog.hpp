@@ -21,6 +21,7 @@ class Watchdog : public Block {
    */
   Watchdog() : hal(eeros::hal::HAL::instance()) {
     wdt = hal.getLogicInput("Wdt", false);
+    reset = hal.getInputFeatureHandle<>(wdt, "reset");
   }
 
   /**
@@ -32,7 +33,7 @@ class Watchdog : public Block {
    * Runs the watchdog block. Will reset the timer to its timeout value.
    */
   virtual void run() {
-    hal.callInputFeature(wdt, "reset");
+    reset();
   }
 
   /**
@@ -55,6 +56,7 @@ class Watchdog : public Block {
  protected:
   eeros::hal::HAL& hal;
   eeros::hal::Input<bool>* wdt;
+  eeros::hal::InputFeature<> reset;
 };
 
 /********** Print functions **********/
@@ -2,83 +2,107 @@
 #define ORG_EEROS_CONTROL_ZTRANSFERFUNCTION_HPP_
 
 #include <eeros/core/System.hpp>
-#include <eeros/control/Block1i1o.hpp>
+#include <eeros/control/Blockio.hpp>
 #include <eeros/math/Fraction.hpp>
 #include <vector>
 
 namespace eeros {
 namespace control {
 
-template < int ORDER >
-class ZTransferFunction: public Blockio<1,1> {
+/**
+ * Discrete transfer function in z, built from a fraction of polynomials.
+ * The signal type T may be a fixed point type, e.g. math::Fixed<12, int16_t>,
+ * the coefficients are then converted to T once, on construction, and must lie
+ * within its range.
+ *
+ * @tparam ORDER - order of the transfer function
+ * @tparam T - signal type (double - default type)
+ */
+template < int ORDER, typename T = double >
+class ZTransferFunction: public Blockio<1,1,T> {
   static constexpr int N = (ORDER + 1);
   
   public:
     ZTransferFunction(const eeros::math::Fraction<ORDER>& copy) :
-      fraction(copy) { }
+      fraction(copy) { convertCoefficients(); }
       
     ZTransferFunction(const std::vector<double> a, const std::vector<double> b) :
-      fraction(b,a) { }
+      fraction(b,a) { convertCoefficients(); }
     
-    static ZTransferFunction<1> PT1(double Ts, double K, double T1) {
-      return ZTransferFunction<1>( { Ts+T1, -T1 }, { K*Ts } );
+    static ZTransferFunction<1,T> PT1(double Ts, double K, double T1) {
+      return ZTransferFunction<1,T>( { Ts+T1, -T1 }, { K*Ts } );
     }
     
-    static ZTransferFunction<1> D(double Ts, double Tv) {
-      return ZTransferFunction<1>( { Ts }, { Tv, -Tv } );
+    static ZTransferFunction<1,T> D(double Ts, double Tv) {
+      return ZTransferFunction<1,T>( { Ts }, { Tv, -Tv } );
     }
     
-    static ZTransferFunction<1> I(double Ts, double Tn) {
-      return ZTransferFunction<1>( { Tn, -Tn }, { Ts } );
+    static ZTransferFunction<1,T> I(double Ts, double Tn) {
+      return ZTransferFunction<1,T>( { Tn, -Tn }, { Ts } );
     }
     
-    static ZTransferFunction<1> DT1(double Ts, double Tv, double T1) {
-      return ZTransferFunction<1>( { Ts+T1, -T1 }, { Tv, -Tv } );
+    static ZTransferFunction<1,T> DT1(double Ts, double Tv, double T1) {
+      return ZTransferFunction<1,T>( { Ts+T1, -T1 }, { Tv, -Tv } );
     }
     
-    static ZTransferFunction<2> PID(double Ts, double Kp, double Tn, double Tv, double Tv1) {
+    static ZTransferFunction<2,T> PID(double Ts, double Kp, double Tn, double Tv, double Tv1) {
       return (I(Ts, Tn) + DT1(Ts, Tv, Tv1) + 1)*Kp;
     }
     
     template < int RORDER >
-    ZTransferFunction<ORDER+RORDER> operator *(const ZTransferFunction<RORDER> right) {
-      return ZTransferFunction<ORDER+RORDER>(fraction * right.fraction);
+    ZTransferFunction<ORDER+RORDER,T> operator *(const ZTransferFunction<RORDER,T>& right) {
+      return ZTransferFunction<ORDER+RORDER,T>(fraction * right.getFraction());
     }
   
-    ZTransferFunction<ORDER> operator *(double right) {
-      return ZTransferFunction<ORDER>(fraction * right);
+    ZTransferFunction<ORDER,T> operator *(double right) {
+      return ZTransferFunction<ORDER,T>(fraction * right);
     }
     
     template < int RORDER >
-    ZTransferFunction<ORDER+RORDER> operator +(const ZTransferFunction<RORDER> right) {
-      return ZTransferFunction<ORDER+RORDER>(fraction + right.fraction);
+    ZTransferFunction<ORDER+RORDER,T> operator +(const ZTransferFunction<RORDER,T>& right) {
+      return ZTransferFunction<ORDER+RORDER,T>(fraction + right.getFraction());
     }
   
-    ZTransferFunction<ORDER> operator +(double right) {
-      return ZTransferFunction<ORDER>(fraction + right);
+    ZTransferFunction<ORDER,T> operator +(double right) {
+      return ZTransferFunction<ORDER,T>(fraction + right);
+    }
+    
+    /**
+     * @return transfer function as fraction of polynomes in z^-1
+     */
+    const eeros::math::Fraction<ORDER>& getFraction() const {
+      return fraction;
     }
     
     virtual void run() {
-      last_in[0] = in.getSignal().getValue();
-      last_out[0] = last_in[0] * fraction.numerator.c[0];
+      last_in[0] = this->in.getSignal().getValue();
+      last_out[0] = last_in[0] * num[0];
       for (int i = 1; i < N; i++) {
-        last_out[0] += (last_in[i] * fraction.numerator.c[i] - last_out[i] * fraction.denominator.c[i]);
+        last_out[0] += (last_in[i] * num[i] - last_out[i] * den[i]);
       }
-      last_out[0] /= fraction.denominator.c[0];
+      last_out[0] /= den[0];
       
-      out.getSignal().setValue(last_out[0]);
-      out.getSignal().setTimestamp(eeros::System::getTimeNs());
+      this->out.getSignal().setValue(last_out[0]);
+      this->out.getSignal().setTimestamp(this->in.getSignal().getTimestamp());
       
-      for (int i = (N - 1); i >= 0; i--) {
+      for (int i = (N - 1); i > 0; i--) {
         last_in[i] = last_in[i - 1];
         last_out[i] = last_out[i - 1];
       }
     }
     
   private:
+    void convertCoefficients() {
+      for (int i = 0; i < N; i++) {
+        num[i] = T(fraction.numerator.c[i]);
+        den[i] = T(fraction.denominator.c[i]);
+      }
+    }
+
     eeros::math::Fraction<ORDER> fraction;
-    double last_in[N];
-    double last_out[N];
+    T num[N], den[N];
+    T last_in[N];
+    T last_out[N];
 };
 
 }
@@ -7,9 +7,11 @@
 #include <eeros/core/System.hpp>
 #include <eeros/math/Matrix.hpp>
 #include <eeros/core/Fault.hpp>
+#include <eeros/hal/CanSocket.hpp>
 #include <CANopen.hpp>
 #include <vector>
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <initializer_list>
 #include <cstring>
@@ -81,7 +83,10 @@ class CANopenReceive : public Blockio<0,N,Matrix<M,1,double>> {
    */
   virtual void run() override {
     if (enabled.load(std::memory_order_relaxed)) {
-      uint64_t ts = eeros::System::getTimeNs();
+      if (socket != nullptr) {
+        receiveBatch();
+        return;
+      }
       for (uint32_t i = 0; i < nofPDO; i++) {
         coFrame_t frame;
         int err = co.frameRecv(frame);
@@ -101,39 +106,25 @@ class CANopenReceive : public Blockio<0,N,Matrix<M,1,double>> {
     }
   }
 
+  /**
+   * Decodes a received TPDO with one lookup in the table compiled by configureTPDO().
+   *
+   * @param frame - received frame
+   */
   void handlePDO(coFrame_t& frame) {
-          auto ts = eeros::System::getTimeNs();
-          // search for registered PDOreceive
-          for (const auto& p : pdo) {
-            uint8_t n = std::get<1>(p);
-            uint8_t r = std::get<2>(p);
-            auto node = frame.id;
-            auto TPDOnr = ((frame.fnctCode - CANopen::FNCT_CODE::PDO1_TX) >> 1) + 1;
-            if (node == n && TPDOnr == r) {
-              uint8_t nodeNr = std::get<0>(p);
-              std::vector<uint8_t> length = std::get<3>(p);
-              std::vector<int8_t> idx = std::get<4>(p);
-              uint8_t i = 0, start = 0;
-              for (auto& len : length) {
-                len /= 8;
-                int32_t val = co.getPDOdata(&frame.payload.data[0], start, start + len - 1);
-                // log.info() << "got value " << val << " for node:index " << (int)nodeNr << ':' <<(int)idx[i];
-                if (idx[i] > 0) {
-                  auto sig = this->getOut(nodeNr).getSignal().getValue();
-                  sig[idx[i]-1] = val * scale[nodeNr];
-                  this->getOut(nodeNr).getSignal().setValue(sig);
-                  this->getOut(nodeNr).getSignal().setTimestamp(ts);
-                } else if (idx[i] < 0) {
-                  auto sig = this->getDigOut(nodeNr).getSignal().getValue();
-                  sig[-idx[i]-1] = val;
-                  this->getDigOut(nodeNr).getSignal().setValue(sig);
-                  this->getDigOut(nodeNr).getSignal().setTimestamp(ts);
-                } else {/*std::cout << "R:status[" << (int)nodeNr << "] = 0x" << std::hex << val << '\n';*/ status[nodeNr] = val;}// & 0x26F;
-                start += len;
-                i++;
-              }
-            }
-          }
+    unsigned TPDOnr = ((frame.fnctCode - CANopen::FNCT_CODE::PDO1_TX) >> 1) + 1;
+    decodePDO(frame.id, TPDOnr, &frame.payload.data[0], eeros::System::getTimeNs());
+  }
+  
+  /**
+   * Receives through a batched SocketCAN socket instead of the CANopen object.
+   * run() then drains all pending frames with one system call and stamps the
+   * signals with the time of arrival of their frame.
+   *
+   * @param socket - socket bound to the CAN interface of the drives
+   */
+  virtual void setSocket(hal::CanSocket& socket) {
+    this->socket = &socket;
   }
   
   /**
@@ -144,7 +135,7 @@ class CANopenReceive : public Blockio<0,N,Matrix<M,1,double>> {
    * @see run()
    */
   virtual void enable() override {
-    nofPDO = pdo.size();
+    nofPDO = decode.size();
     enabled.store(true, std::memory_order_relaxed);
     log.trace() << "enabling can receive block";
   }
@@ -172,6 +163,7 @@ class CANopenReceive : public Blockio<0,N,Matrix<M,1,double>> {
    */
   virtual void setScale(Matrix<N,M,double>& scale) {
     this->scale = scale;
+    for (auto& d : decode) d.scale = scale[d.nodeIdx];
   }
 
   /**
@@ -206,12 +198,32 @@ class CANopenReceive : public Blockio<0,N,Matrix<M,1,double>> {
       log.warn() << "CAN configure TPDO: node id " << nodeId << " not found";
       return;
     }
-    uint8_t nodeIdx = std::distance(node.begin(), it);
-    std::vector<uint8_t> len;
-    for (coObject_t o : objs) {
-      len.push_back(o.len);
+    if (nodeId >= maxNodeId || TPDOnr < 1 || TPDOnr > nofTPDO || objs.size() > maxObjects || objs.size() != idx.size()) {
+      log.warn() << "CAN configure TPDO: invalid TPDO " << (int)TPDOnr << " for node id " << (int)nodeId;
+      return;
+    }
+    Decode d;
+    d.nodeIdx = std::distance(node.begin(), it);
+    d.scale = scale[d.nodeIdx];
+    uint8_t start = 0;
+    for (d.count = 0; d.count < objs.size(); d.count++) {
+      uint8_t len = objs[d.count].len / 8;
+      d.first[d.count] = start;
+      d.last[d.count] = start + len - 1;
+      d.idx[d.count] = idx[d.count];
+      start += len;
+    }
+    if (start > 8) {
+      log.warn() << "CAN configure TPDO: objects of TPDO " << (int)TPDOnr << " exceed 8 bytes";
+      return;
+    }
+    int16_t& slot = lookup[nodeId * nofTPDO + TPDOnr - 1];
+    if (slot < 0) {
+      slot = decode.size();
+      decode.push_back(d);
+    } else {
+      decode[slot] = d;   // configured again, replaces the mapping
     }
-    pdo.push_back(make_tuple(nodeIdx, nodeId, TPDOnr, len, idx));
   }
 
   /**
@@ -228,15 +240,80 @@ class CANopenReceive : public Blockio<0,N,Matrix<M,1,double>> {
  private:
   CANopen co;
   std::atomic<bool> enabled = false;
+  hal::CanSocket* socket = nullptr;
   Output<Matrix<P,1,uint32_t>> digOut[N];
   Matrix<N,1,uint16_t> status;
   Matrix<N,M,double> scale;
   std::vector<uint8_t> node;
-  // node index, node id, RPDOnr, length in bit of all objects, signal index of all objects
-  std::vector<std::tuple<uint8_t,uint8_t,uint8_t,std::vector<uint8_t>,std::vector<int8_t>>> pdo;
-  uint32_t nofPDO;
+  
+  static constexpr unsigned maxNodeId = 128;
+  static constexpr unsigned nofTPDO = 4;
+  static constexpr unsigned maxObjects = 8;
+  // mapping of a TPDO, compiled when it is configured
+  struct Decode {
+    uint8_t nodeIdx = 0;
+    uint8_t count = 0;
+    uint8_t first[maxObjects];   // first and last byte of each object
+    uint8_t last[maxObjects];
+    int8_t idx[maxObjects];      // signal index of each object
+    double scale = 1;
+  };
+  std::vector<Decode> decode;
+  std::array<int16_t, maxNodeId * nofTPDO> lookup = filledLookup();   // index into decode by node id and TPDO number, -1 if not configured
+  uint32_t nofPDO = 0;
   Logger log;
   uint64_t last_ts = 0;
+  
+  void receiveBatch() {
+    int n = socket->receive();
+    for (int i = 0; i < n; i++) {
+      can_frame f = socket->getFrame(i);
+      if (f.can_id & (CAN_EFF_FLAG | CAN_RTR_FLAG | CAN_ERR_FLAG)) continue;
+      unsigned fnctCode = (f.can_id & CAN_SFF_MASK) >> 7;   // COB-ID = function code << 7 | node id
+      if (fnctCode < CANopen::FNCT_CODE::PDO1_TX || fnctCode > CANopen::FNCT_CODE::PDO4_TX || ((fnctCode - CANopen::FNCT_CODE::PDO1_TX) & 1)) {
+        log.trace() << "unhandled CANOpen frame: id = 0x" << std::hex << f.can_id;
+        continue;
+      }
+      decodePDO(f.can_id & 0x7F, ((fnctCode - CANopen::FNCT_CODE::PDO1_TX) >> 1) + 1, f.data, socket->getTimestamp(i));
+    }
+  }
+  
+  void decodePDO(unsigned nodeId, unsigned TPDOnr, uint8_t* data, uint64_t ts) {
+    if (nodeId >= maxNodeId || TPDOnr < 1 || TPDOnr > nofTPDO) return;
+    int16_t slot = lookup[nodeId * nofTPDO + TPDOnr - 1];
+    if (slot < 0) return;
+    const Decode& d = decode[slot];
+    auto sig = this->getOut(d.nodeIdx).getSignal().getValue();
+    auto dig = this->getDigOut(d.nodeIdx).getSignal().getValue();
+    bool analog = false, digital = false;
+    for (uint8_t i = 0; i < d.count; i++) {
+      int32_t val = co.getPDOdata(data, d.first[i], d.last[i]);
+      int8_t idx = d.idx[i];
+      if (idx > 0) {
+        sig[idx - 1] = val * d.scale;
+        analog = true;
+      } else if (idx < 0) {
+        dig[-idx - 1] = val;
+        digital = true;
+      } else {
+        status[d.nodeIdx] = val;
+      }
+    }
+    if (analog) {
+      this->getOut(d.nodeIdx).getSignal().setValue(sig);
+      this->getOut(d.nodeIdx).getSignal().setTimestamp(ts);
+    }
+    if (digital) {
+      this->getDigOut(d.nodeIdx).getSignal().setValue(dig);
+      this->getDigOut(d.nodeIdx).getSignal().setTimestamp(ts);
+    }
+  }
+  
+  static constexpr std::array<int16_t, maxNodeId * nofTPDO> filledLookup() {
+    std::array<int16_t, maxNodeId * nofTPDO> a{};
+    for (auto& x : a) x = -1;
+    return a;
+  }
 };
 
 }
@@ -5,6 +5,8 @@
 #include <eeros/control/Blockio.hpp>
 #include <eeros/math/Matrix.hpp>
 #include <eeros/core/Fault.hpp>
+#include <eeros/hal/CanSocket.hpp>
+#include <eeros/hal/SdoClient.hpp>
 #include <CANopen.hpp>
 #include <vector>
 #include <initializer_list>
@@ -22,8 +24,9 @@ namespace control {
 /**
  * This block serves to send CANopen messages to one or several drives implementing the DS402
  * specification. The drive has to be initialized and brought up to its operational state
- * through SDO transfers. After this, SDO transfer must stop. All further communication is
- * then done through PDO transfer. These PDOs must have been configured on the drive beforehand.
+ * through SDO transfers. After this, all further communication is done through PDO transfer.
+ * SDO transfers during operation must go through a \ref hal::SdoClient set with setSdoClient().
+ * These PDOs must have been configured on the drive beforehand.
  * 
  * The drive must be configured to receive RPDOs which are sent by this block.
  * You have to configure this block by setting all PDOs which should be transmitted
@@ -78,6 +81,10 @@ class CANopenSend : public Blockio<N,0,Matrix<M,1,double>> {
    */
   virtual void run() override {
     if (enabled) {
+      if (socket != nullptr) {
+        sendBatch();
+        return;
+      }
       int err;
       if ((err = co.sendSync()) != 0){
         std::ostringstream os; log.error() << "send sync failed: " << std::strerror(errno);
@@ -85,32 +92,39 @@ class CANopenSend : public Blockio<N,0,Matrix<M,1,double>> {
       };
 
       for (const auto& p : pdo) {
-        uint8_t nodeNr = std::get<0>(p);
-        uint8_t nodeId = std::get<1>(p);
-        uint8_t RPDOnr = std::get<2>(p);
         uint8_t buf[8];
-        auto length = std::get<3>(p);
-        auto sigIdx = std::get<4>(p);
-        int i = 0, len = 0;
-        for (uint8_t l : length) {
-          l /= 8; // lenght is in bits
-          if (sigIdx[i] > 0) {
-            Matrix<N,M,double> val = this->getIn(nodeNr).getSignal().getValue() * scale[nodeNr];
-            co.can.encodeU32(buf+len, (uint32_t)val[sigIdx[i]-1], l);
-          } else if (sigIdx[i] < 0) {
-            Matrix<P,1,uint32_t> val = this->getDigIn(nodeNr).getSignal().getValue();
-            co.can.encodeU32(buf+len, val[-sigIdx[i]-1], l);
-          } else {
-            co.can.encodeU32(buf+len, ctrl[nodeNr], l);
-          }
-          len += l;
-          i++;
-        }
-        err = co.PDOsend(nodeId, RPDOnr, buf, len);
+        int len = encode(p, buf);
+        err = co.PDOsend(std::get<1>(p), std::get<2>(p), buf, len);
         if (err != 0) throw eeros::Fault("sending over CAN failed");
       }
+      if (sdo != nullptr) sdo->release();
     }
   }
+  
+  /**
+   * Sends through a batched SocketCAN socket instead of the CANopen object.
+   * run() then queues the RPDOs of all nodes followed by the sync package and
+   * sends them with one system call, so the drives take over their new
+   * set points together on the sync.
+   *
+   * @param socket - socket bound to the CAN interface of the drives
+   */
+  virtual void setSocket(hal::CanSocket& socket) {
+    this->socket = &socket;
+  }
+
+  /**
+   * Interleaves the SDO transfers of a client with the cyclic traffic of this
+   * block. The client then sends its requests only after run() has sent the
+   * PDOs and the sync package, so they never delay the cyclic frames.
+   * run() does not wait for the client.
+   *
+   * @param sdo - client for the SDO transfers to the drives
+   */
+  virtual void setSdoClient(hal::SdoClient& sdo) {
+    this->sdo = &sdo;
+    sdo.setPaced(true);
+  }
         
   /**
    * Enables the block.
@@ -199,6 +213,21 @@ class CANopenSend : public Blockio<N,0,Matrix<M,1,double>> {
     return digIn[index];
   }
 
+  std::vector<Block*> getInputBlocks() override {
+    std::vector<Block*> blocks = Blockio<N,0,Matrix<M,1,double>>::getInputBlocks();
+    for (auto& i : digIn) if (i.getConnectedBlock() != nullptr) blocks.push_back(i.getConnectedBlock());
+    return blocks;
+  }
+
+  bool areInputsConnected() const override {
+    if (!Blockio<N,0,Matrix<M,1,double>>::areInputsConnected()) return false;
+    // a digital input is only read if a configured RPDO maps one of its signals
+    for (const auto& p : pdo) {
+      for (int8_t idx : std::get<4>(p)) if (idx < 0 && !digIn[std::get<0>(p)].isConnected()) return false;
+    }
+    return true;
+  }
+
  private:
   CANopen co;
   bool enabled = false;
@@ -208,7 +237,51 @@ class CANopenSend : public Blockio<N,0,Matrix<M,1,double>> {
   std::vector<uint8_t> node;
   // node index, node id, RPDOnr, length in bit of all objects, signal index of all objects
   std::vector<std::tuple<uint8_t,uint8_t,uint8_t,std::vector<uint8_t>,std::vector<int8_t>>> pdo;
+  hal::CanSocket* socket = nullptr;
+  hal::SdoClient* sdo = nullptr;
   Logger log;
+  
+  static constexpr canid_t cobIdSync = 0x080;
+  static constexpr canid_t cobIdRPDO1 = 0x200;   // RPDO n of node k: 0x200 + (n - 1) * 0x100 + k
+  
+  template<typename PDO>
+  int encode(const PDO& p, uint8_t* buf) {
+    uint8_t nodeNr = std::get<0>(p);
+    const auto& length = std::get<3>(p);
+    const auto& sigIdx = std::get<4>(p);
+    int i = 0, len = 0;
+    for (uint8_t l : length) {
+      l /= 8; // lenght is in bits
+      if (sigIdx[i] > 0) {
+        Matrix<N,M,double> val = this->getIn(nodeNr).getSignal().getValue() * scale[nodeNr];
+        co.can.encodeU32(buf+len, (uint32_t)val[sigIdx[i]-1], l);
+      } else if (sigIdx[i] < 0) {
+        Matrix<P,1,uint32_t> val = this->getDigIn(nodeNr).getSignal().getValue();
+        co.can.encodeU32(buf+len, val[-sigIdx[i]-1], l);
+      } else {
+        co.can.encodeU32(buf+len, ctrl[nodeNr], l);
+      }
+      len += l;
+      i++;
+    }
+    return len;
+  }
+  
+  void sendBatch() {
+    can_frame f;
+    for (const auto& p : pdo) {
+      std::memset(&f, 0, sizeof(f));
+      f.can_id = cobIdRPDO1 + (std::get<2>(p) - 1) * 0x100 + std::get<1>(p);
+      f.can_dlc = encode(p, f.data);
+      if (!socket->queue(f)) throw eeros::Fault("sending over CAN failed, too many PDOs");
+    }
+    std::memset(&f, 0, sizeof(f));
+    f.can_id = cobIdSync;
+    if (!socket->queue(f)) throw eeros::Fault("sending over CAN failed, too many PDOs");
+    int queued = socket->getQueued();
+    if (socket->flush() != queued) throw eeros::Fault("sending over CAN failed");
+    if (sdo != nullptr) sdo->release();
+  }
 };
 
 }
@@ -30,6 +30,17 @@ class ODriveUARTInput : public Blockio<1,3,Vector2> {
    * @param priority - execution priority of this thread
    */
   ODriveUARTInput(std::string dev, int speed, int parity, int priority): odrive(dev, speed, parity, priority) { }
+
+  /**
+   * Constructs a ODriveUARTInput instance using the native protocol \n
+   * @param dev - string with device id
+   * @param speed - communication speed of UART
+   * @param parity - parity bit set or not
+   * @param priority - execution priority of this thread
+   * @param config - telemetry set, the velocities of both motors first
+   */
+  ODriveUARTInput(std::string dev, int speed, int parity, int priority, const ODriveUART::NativeConfig& config)
+      : odrive(dev, speed, parity, priority, config) { }
   
   /**
    * Disabling use of copy constructor because the block should never be copied unintentionally.
@@ -46,26 +46,19 @@ class ODriveUSBInput : public Blockio<1,3,Vector2> {
     // Set speed
     odrive.setRefVel(0, in.getSignal().getValue()(0), 1/6.28); // rad/s
     odrive.setRefVel(1, in.getSignal().getValue()(1), 1/6.28); // rad/s
-    // Output speed
-    double vel0 = odrive.getEncoderVel(0, 1/6.28); // rad/s
-    double vel1 = odrive.getEncoderVel(1, 1/6.28); // rad/s
-    Vector2 vel; vel << vel0, vel1;
+    // Outputs of the latest batch, read as one consistent copy
+    ODriveUSB::Telemetry t;
+    odrive.getTelemetry(t);
+    Vector2 vel; vel << t.vel[0] * 6.28, t.vel[1] * 6.28; // rad/s
     out[0].getSignal().setValue(vel);
-    // Output current
-    double curr0 = odrive.getCurrentMeasured(0);
-    double curr1 = odrive.getCurrentMeasured(1);
-    Vector2 curr; curr << curr0, curr1;
+    Vector2 curr; curr << t.iqMeasured[0], t.iqMeasured[1];
     out[1].getSignal().setValue(curr);
-    // Output current setpoint
-    double setp0 = odrive.getCurrentSetpoint(0);
-    double setp1 = odrive.getCurrentSetpoint(1);
-    Vector2 setp; setp << setp0, setp1;
+    Vector2 setp; setp << t.iqSetpoint[0], t.iqSetpoint[1];
     out[2].getSignal().setValue(setp);
     // set timestamps
-    uint64_t ts = eeros::System::getTimeNs();
-    out[0].getSignal().setTimestamp(ts);
-    out[1].getSignal().setTimestamp(ts);
-    out[2].getSignal().setTimestamp(ts);
+    out[0].getSignal().setTimestamp(t.timestamp);
+    out[1].getSignal().setTimestamp(t.timestamp);
+    out[2].getSignal().setTimestamp(t.timestamp);
   }
   
   /**
@@ -3,7 +3,7 @@
 
 #include <eeros/control/Blockio.hpp>
 #include <eeros/control/Output.hpp>
-#include <eeros/core/System.hpp>
+#include <eeros/core/Executor.hpp>
 #include <EcMasterlibMain.hpp>
 #include <device/Elmo.hpp>
 
@@ -33,7 +33,7 @@ class ElmoInput : public Blockio<0,0,double,double> {
    * Puts the drive inputs onto the output signals.
    */
   virtual void run() {
-    uint64_t ts = eeros::System::getTimeNs();
+    uint64_t ts = Executor::current().getCycleTimestamp();
     position.getSignal().setValue(iface.getPosition());
     position.getSignal().setTimestamp(ts);
     velocity.getSignal().setValue(iface.getVelocity());
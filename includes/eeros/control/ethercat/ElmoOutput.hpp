@@ -81,6 +81,18 @@ class ElmoOutput : public Blockio<0,0,double,double> {
    */
   virtual Input<int16_t>& getTorqueMaxIn() { return torqueMax; }
 
+  std::vector<Block*> getInputBlocks() override {
+    std::vector<Block*> blocks;
+    for (Block* b : {position.getConnectedBlock(), velocity.getConnectedBlock(), torque.getConnectedBlock(), torqueMax.getConnectedBlock()}) {
+      if (b != nullptr) blocks.push_back(b);
+    }
+    return blocks;
+  }
+
+  bool areInputsConnected() const override {
+    return position.isConnected() && velocity.isConnected() && torque.isConnected() && torqueMax.isConnected();
+  }
+
   /**
    * Sets the mode of the elmo drive.
    * Modes are: HOMING, PROFILE_VELOCITY, etc.
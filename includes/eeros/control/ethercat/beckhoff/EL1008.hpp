@@ -2,7 +2,7 @@
 #define ORG_EEROS_CONTROL_ETHERCAT_EL1008_
 
 #include <eeros/control/Blockio.hpp>
-#include <eeros/core/System.hpp>
+#include <eeros/core/Executor.hpp>
 #include <EcMasterlibMain.hpp>
 #include <device/beckhoff/EL1008.hpp>
 #include <eeros/hal/HAL.hpp> 
@@ -45,7 +45,7 @@ class BeckhoffEL1008 : public Blockio<0,8,bool,bool> {
    */
   virtual void run() {
     int val = iface.getInputs();
-    uint64_t ts = eeros::System::getTimeNs();
+    uint64_t ts = Executor::current().getCycleTimestamp();
     for(int i = 0; i < 8; i++) {
       out[i].getSignal().setValue((val & (1 << i)) != 0);
       out[i].getSignal().setTimestamp(ts);
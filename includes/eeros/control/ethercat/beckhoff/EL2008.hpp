@@ -30,7 +30,7 @@ class BeckhoffEL2008 : public Blockio<8,0,bool,bool> {
    * Puts the digital input signals onto the drive outputs.
    */
   virtual void run() {
-    int val;
+    int val = 0;
     for(int i = 0; i < 8; i++) {
       bool state = in[i].getSignal().getValue(); 
       if(state) val |= (1 << i);
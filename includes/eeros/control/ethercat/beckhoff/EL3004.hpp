@@ -2,7 +2,7 @@
 #define ORG_EEROS_CONTROL_ETHERCAT_EL3004_
 
 #include <eeros/control/Blockio.hpp>
-#include <eeros/core/System.hpp>
+#include <eeros/core/Executor.hpp>
 #include <EcMasterlibMain.hpp>
 #include <device/beckhoff/EL3004.hpp>
 
@@ -14,6 +14,8 @@ namespace control {
  * and outputs the values onto up to 8 analog output signals. 
  * EtherCAT delivers values of type int16_t. These values cover the range 
  * between -10V and +10V.
+ * All channels are converted together and stamped with the start of the
+ * EtherCAT cycle, see Executor::getCycleTimestamp().
  *
  * @since v1.3
  */
@@ -33,14 +35,19 @@ class BeckhoffEL3004 : public Blockio<0,4,double,double> {
    * Puts the drive inputs onto the analog output signals.
    */
   virtual void run() {
-    uint64_t ts = eeros::System::getTimeNs();
+    int16_t raw[4];
+    double val[4];
+    for(int i = 0; i < 4; i++) raw[i] = iface[i];
+    for(int i = 0; i < 4; i++) val[i] = raw[i] * scale;
+    uint64_t ts = Executor::current().getCycleTimestamp();
     for(int i = 0; i < 4; i++) {
-      out[i].getSignal().setValue((double)iface[i] / 3276.8);
+      out[i].getSignal().setValue(val[i]);
       out[i].getSignal().setTimestamp(ts);
     }
   }
   
  private:
+   static constexpr double scale = 1.0 / 3276.8;   // V per count
    ecmasterlib::device::beckhoff::EL3004& iface;
 };
 
@@ -32,15 +32,18 @@ class BeckhoffEL4004 : public Blockio<4,0,double,double> {
    * Puts the analog input signals onto the drive outputs.
    */
   virtual void run() {
+    int16_t raw[4];
     for(int i = 0; i < 4; i++) {
       double val = in[i].getSignal().getValue(); 
       if (val < 0.0 ) val = 0.0;   // not lower than  0V 
       if (val > 10.0 ) val = 10.0; // not higher than 10V
-      iface.setChannel(i, (int16_t)(val * 3276.7));             
+      raw[i] = (int16_t)(val * scale);
     }
+    for(int i = 0; i < 4; i++) iface.setChannel(i, raw[i]);
   }
   
  private:
+   static constexpr double scale = 3276.7;   // counts per V
    ecmasterlib::device::beckhoff::EL4004& iface;
 };
 
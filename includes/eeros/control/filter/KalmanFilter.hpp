@@ -9,7 +9,11 @@
 #include <eeros/control/DeMux.hpp>
 #include <eeros/control/IndexOutOfBoundsFault.hpp>
 #include <eeros/math/Matrix.hpp>
+#include <eeros/math/MatrixDecomposition.hpp>
+#include <algorithm>
+#include <cmath>
 #include <mutex>
+#include <vector>
 
 using namespace eeros::math;
 
@@ -74,6 +78,16 @@ class KalmanFilterCorrection;
  * prediction and the other one for the correction. The correction block
  * should be run after reading the sensor values, while the prediction block should 
  * run after the input vector is defined. The two blocks can run in different time domains.
+ *
+ * By default, the covariance P and the gain K are updated in every cycle as described
+ * above. For time invariant systems the gain converges, with setMode(Mode::steadyState)
+ * the steady state gain is computed once and the blocks only update the state vector.
+ * Mode::joseph updates the covariance with the numerically more robust Joseph form
+ * P = (I - K*C)*P*(I - K*C)' + K*R*K' and computes the gain with a Cholesky
+ * decomposition instead of inverting C*P*C' + R.
+ *
+ * Sensors sampled at different rates are combined with setAsynchronous(), the
+ * correction then only uses the measurements which are new since the last one.
  * 
  * @tparam nofInputs - number of system inputs
  * @tparam nofOutputs - number of system outputs
@@ -85,7 +99,11 @@ class KalmanFilterCorrection;
 template <uint8_t nofInputs, uint8_t nofOutputs, uint8_t nofStates, uint8_t nofRandVars>
 class KalmanFilter : public Blockio<0,0>{
  public:
-  
+  /**
+   * Selects how the covariance and the gain are updated.
+   */
+  enum class Mode { standard, joseph, steadyState };
+
   /**
    * Constructs a kalman filter instance by providing the matrices Ad, Bd, C, Gd, Q and R.
    * The matrix D is set to 0 (no feed forward path).
@@ -111,6 +129,7 @@ class KalmanFilter : public Blockio<0,0>{
     this->P.eye();
     this->eye.eye();
     this->GdQGdT = Gd * Q * Gd.transpose();
+    this->diagonalR = R.isDiagonal();
   }
   
   /**
@@ -138,6 +157,7 @@ class KalmanFilter : public Blockio<0,0>{
     this->P.eye();
     this->eye.eye();
     this->GdQGdT = Gd * Q * Gd.transpose();
+    this->diagonalR = R.isDiagonal();
   }
     
   /**
@@ -165,6 +185,7 @@ class KalmanFilter : public Blockio<0,0>{
       : Ad(Ad), Bd(Bd), C(C), D(D), Gd(Gd), Q(Q), R(R), P(P), x(x), predict(this), correct(this) {
     this->eye.eye();
     this->GdQGdT = Gd * Q * Gd.transpose();
+    this->diagonalR = R.isDiagonal();
   }
 
   /**
@@ -193,6 +214,19 @@ class KalmanFilter : public Blockio<0,0>{
     return inY[index];
   }
 
+  std::vector<Block*> getInputBlocks() override {
+    std::vector<Block*> blocks;
+    for (auto& i : inY) if (i.getConnectedBlock() != nullptr) blocks.push_back(i.getConnectedBlock());
+    for (auto& i : inU) if (i.getConnectedBlock() != nullptr) blocks.push_back(i.getConnectedBlock());
+    return blocks;
+  }
+
+  bool areInputsConnected() const override {
+    for (auto& i : inY) if (!i.isConnected()) return false;
+    for (auto& i : inU) if (!i.isConnected()) return false;
+    return true;
+  }
+
   /**
    * Get vector element with index index of system state vector x.
    * 
@@ -206,6 +240,76 @@ class KalmanFilter : public Blockio<0,0>{
     return out[index];
   }
 
+  /**
+   * Sets the mode used to update the covariance and the gain. Mode::steadyState
+   * iterates the Riccati equation, starting with the current covariance, until the
+   * predicted covariance converges. Call it before the filter is run.
+   *
+   * @param mode - update mode
+   * @param maxIterations - maximum number of iterations for Mode::steadyState
+   * @param tolerance - largest change of an element of the covariance at convergence
+   */
+  void setMode(Mode mode, uint32_t maxIterations = 10000, double tolerance = 1e-12) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (mode == Mode::steadyState) {
+      Matrix<nofStates, nofStates> prev;
+      uint32_t i = 0;
+      for (; i < maxIterations; i++) {
+        prev = P;
+        updateGain();
+        P = (eye - K * C) * P;
+        P = Ad * P * Ad.transpose() + GdQGdT;
+        double change = 0;
+        for (unsigned int j = 0; j < nofStates * nofStates; j++) change = std::max(change, std::abs(P[j] - prev[j]));
+        if (change <= tolerance) break;
+      }
+      if (i == maxIterations) {
+        throw Fault("Steady state gain of block '" + this->getName() + "' did not converge");
+      }
+      updateGain();
+      if (async) updateSubsetGains();
+    }
+    this->mode = mode;
+  }
+
+  /**
+   * Corrects the state only with the measurements which are new, e.g. for sensors
+   * sampled at different rates. A measurement is new if the timestamp of its signal
+   * changed since the last correction, without any new measurement the correction
+   * leaves the state as predicted. If only some measurements are new and R is
+   * diagonal, they are processed one after the other as scalar updates, which needs
+   * no matrix inversion. Otherwise the old measurements are masked out of C and R.
+   * In Mode::steadyState the gains for all subsets of the measurements are
+   * precomputed from the steady state covariance, for at most 8 outputs.
+   *
+   * @param async - true to use only new measurements
+   */
+  void setAsynchronous(bool async) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (async && mode == Mode::steadyState) updateSubsetGains();
+    this->async = async;
+  }
+
+  /**
+   * @return true if only new measurements are used
+   */
+  bool isAsynchronous() const { return async; }
+
+  /**
+   * @return mode used to update the covariance and the gain
+   */
+  Mode getMode() const { return mode; }
+
+  /**
+   * @return kalman gain, the steady state gain in Mode::steadyState
+   */
+  const Matrix<nofStates, nofOutputs>& getGain() const { return K; }
+
+  /**
+   * @return covariance of the estimation error
+   */
+  const Matrix<nofStates, nofStates>& getCovariance() const { return P; }
+
   /**
    * Predict current system state
    */
@@ -216,11 +320,12 @@ class KalmanFilter : public Blockio<0,0>{
         u[i] = inU[i].getSignal().getValue();
     }
     x = Ad * x + Bd * u;
+    timestamp_t time = eeros::System::getTimeNs();
     for (uint8_t i = 0; i < nofStates; i++) {
       out[i].getSignal().setValue(x[i]);
-      out[i].getSignal().setTimestamp(eeros::System::getTimeNs());
+      out[i].getSignal().setTimestamp(time);
     }
-    P = Ad * P * Ad.transpose() + GdQGdT;
+    if (mode != Mode::steadyState) P = Ad * P * Ad.transpose() + GdQGdT;
   }
 
   /**
@@ -229,10 +334,12 @@ class KalmanFilter : public Blockio<0,0>{
   void correction() {
     std::lock_guard<std::mutex> lock(mtx);
     if (first) {
+      timestamp_t time = eeros::System::getTimeNs();
       for (uint8_t i = 0; i < nofStates; i++) {
         out[i].getSignal().setValue(x[i]);
-        out[i].getSignal().setTimestamp(eeros::System::getTimeNs());
+        out[i].getSignal().setTimestamp(time);
       }
+      for (uint8_t i = 0; i < nofOutputs; i++) stamp[i] = inY[i].getSignal().getTimestamp();
       first = false;
     } else {
       for (uint8_t i = 0; i < nofOutputs; i++)
@@ -243,15 +350,41 @@ class KalmanFilter : public Blockio<0,0>{
       {
           u[i] = inU[i].getSignal().getValue();
       }
-      CPCTR = (C * P * C.transpose() + R);
-      K = P * C.transpose() * !CPCTR;
-      dy = y - C * x - D * u;
-      x = x + K * dy;
+      bool fresh[nofOutputs];
+      unsigned int count = nofOutputs;
+      if (async) {
+        count = 0;
+        for (uint8_t i = 0; i < nofOutputs; i++) {
+          timestamp_t t = inY[i].getSignal().getTimestamp();
+          fresh[i] = t != stamp[i];
+          stamp[i] = t;
+          if (fresh[i]) count++;
+        }
+        if (count == 0) return;
+      }
+      if (count < nofOutputs) {
+        partialCorrection(fresh);
+      } else {
+        if (mode == Mode::standard) {
+          CPCTR = (C * P * C.transpose() + R);
+          K = P * C.transpose() * !CPCTR;
+        } else if (mode == Mode::joseph) {
+          updateGain();
+        }
+        dy = y - C * x - D * u;
+        x = x + K * dy;
+        if (mode == Mode::standard) {
+          P = (eye - K * C) * P;
+        } else if (mode == Mode::joseph) {
+          IKC = eye - K * C;
+          P = IKC * P * IKC.transpose() + K * R * K.transpose();
+        }
+      }
+      timestamp_t time = eeros::System::getTimeNs();
       for (uint8_t i = 0; i < nofStates; i++) {
         out[i].getSignal().setValue(x[i]);
-        out[i].getSignal().setTimestamp(eeros::System::getTimeNs());
+        out[i].getSignal().setTimestamp(time);
       }
-      P = (eye - K * C) * P;
     }
   }
 
@@ -272,7 +405,14 @@ class KalmanFilter : public Blockio<0,0>{
   Matrix<nofStates, nofRandVars> Gd;
   Matrix<nofRandVars, nofRandVars> Q;
   Matrix<nofOutputs, nofOutputs> R, CPCTR;
+  Matrix<nofStates, nofStates> IKC;
+  Matrix<nofOutputs, nofStates> CP;
+  Mode mode = Mode::standard;
   bool first = true;
+  bool async = false;
+  bool diagonalR = true;
+  timestamp_t stamp[nofOutputs] = {};                        // timestamps of the measurements used last
+  std::vector<Matrix<nofStates, nofOutputs>> subsetGain;    // steady state gain by bit mask of the new measurements
 
  public:
   KalmanFilterPrediction<nofInputs, nofOutputs, nofStates, nofRandVars> predict;
@@ -285,6 +425,103 @@ class KalmanFilter : public Blockio<0,0>{
     * This run method does not do anything. Use the run methods of the helper classes instead.
     */
   void run(){};
+
+  /**
+   * Computes the gain from the current covariance, K = P*C' * (C*P*C' + R)^-1,
+   * by solving (C*P*C' + R) * K' = C*P.
+   */
+  void updateGain() {
+    K = gain(C, R);
+  }
+
+  Matrix<nofStates, nofOutputs> gain(const Matrix<nofOutputs, nofStates>& Cm, const Matrix<nofOutputs, nofOutputs>& Rm) {
+    CP = Cm * P;
+    CPCTR = CP * Cm.transpose() + Rm;
+    CholeskyDecomposition<nofOutputs> chol(CPCTR);
+    if (chol.isPositiveDefinite()) {
+      return chol.solve(CP).transpose();
+    } else {
+      return LUDecomposition<nofOutputs>(CPCTR).solve(CP).transpose();
+    }
+  }
+
+  /**
+   * Removes the old measurements from C and R, their rows of C are set to 0 and
+   * their rows and columns of R to those of the identity. The gain for them is 0.
+   */
+  void mask(const bool* fresh, Matrix<nofOutputs, nofStates>& Cm, Matrix<nofOutputs, nofOutputs>& Rm) const {
+    Cm = C;
+    Rm = R;
+    for (uint8_t i = 0; i < nofOutputs; i++) {
+      if (fresh[i]) continue;
+      for (uint8_t j = 0; j < nofStates; j++) Cm(i, j) = 0;
+      for (uint8_t j = 0; j < nofOutputs; j++) Rm(i, j) = Rm(j, i) = 0;
+      Rm(i, i) = 1;
+    }
+  }
+
+  void updateSubsetGains() {
+    if (nofOutputs > 8) {
+      throw Fault("Asynchronous steady state gains of block '" + this->getName() + "' are limited to 8 outputs");
+    }
+    subsetGain.resize(1u << nofOutputs);
+    Matrix<nofOutputs, nofStates> Cm;
+    Matrix<nofOutputs, nofOutputs> Rm;
+    for (unsigned int s = 0; s < subsetGain.size(); s++) {
+      bool fresh[nofOutputs];
+      for (uint8_t i = 0; i < nofOutputs; i++) fresh[i] = s & (1u << i);
+      mask(fresh, Cm, Rm);
+      subsetGain[s] = gain(Cm, Rm);
+    }
+  }
+
+  /**
+   * Corrects the state with the new measurements only.
+   */
+  void partialCorrection(const bool* fresh) {
+    if (mode == Mode::steadyState) {
+      unsigned int s = 0;
+      dy = y - C * x - D * u;
+      for (uint8_t i = 0; i < nofOutputs; i++) {
+        if (fresh[i]) s |= 1u << i;
+        else dy[i] = 0;
+      }
+      x = x + subsetGain[s] * dy;
+    } else if (diagonalR) {
+      // sequential scalar updates, each with the state corrected by the previous ones
+      Matrix<nofStates, 1> pc, k;
+      for (uint8_t i = 0; i < nofOutputs; i++) {
+        if (!fresh[i]) continue;
+        Matrix<1, nofStates> c = C.getRow(i);
+        pc = P * c.transpose();
+        double innovation = y[i], si = R(i, i);
+        for (uint8_t j = 0; j < nofStates; j++) {
+          innovation -= c(0, j) * x[j];
+          si += c(0, j) * pc(j, 0);
+        }
+        for (uint8_t j = 0; j < nofInputs; j++) innovation -= D(i, j) * u[j];
+        k = pc / si;
+        x = x + k * innovation;
+        if (mode == Mode::joseph) {
+          IKC = eye - k * c;
+          P = IKC * P * IKC.transpose() + k * R(i, i) * k.transpose();
+        } else {
+          P = P - k * pc.transpose();
+        }
+      }
+    } else {
+      Matrix<nofOutputs, nofStates> Cm;
+      Matrix<nofOutputs, nofOutputs> Rm;
+      mask(fresh, Cm, Rm);
+      K = gain(Cm, Rm);
+      dy = y - C * x - D * u;
+      for (uint8_t i = 0; i < nofOutputs; i++) if (!fresh[i]) dy[i] = 0;
+      x = x + K * dy;
+      IKC = eye - K * Cm;
+      if (mode == Mode::joseph) P = IKC * P * IKC.transpose() + K * Rm * K.transpose();
+      else P = IKC * P;
+    }
+  }
 };
 
 template <uint8_t nofInputs, uint8_t nofOutputs, uint8_t nofStates, uint8_t nofRandVars>
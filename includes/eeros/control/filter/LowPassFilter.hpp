@@ -2,6 +2,7 @@
 #define ORG_EEROS_CONTROL_FILTER_LOWPASSFILTER_HPP
 
 #include <eeros/control/Blockio.hpp>
+#include <eeros/math/Fixed.hpp>
 #include <eeros/math/Matrix.hpp>
 
 namespace eeros {
@@ -25,6 +26,9 @@ namespace control {
  * For example a 3-tuple of a Vector3 instance will be kept together during processing
  * in the LowPassFilter.\n
  * 
+ * With a fixed point type, alpha and 1-alpha are converted to the type once,
+ * so that filtering needs no floating point arithmetic.
+ * 
  * @tparam T - value type (double - default type)
  * 
  * @since 1.3
@@ -39,9 +43,7 @@ class LowPassFilter : public Blockio<1,1,T> {
    *
    * @param alpha - weight of input in the filter (value between 0 and 1)
    */
-  LowPassFilter(double alpha) : alpha(alpha) { 
-    prev.clear();
-  }
+  LowPassFilter(double alpha) : alpha(alpha), alphaFixed(fixedFactor(alpha)), complementFixed(fixedFactor(1 - alpha)) { }
     
   /**
   * Disabling use of copy constructor because the block should never be copied unintentionally.
@@ -56,19 +58,21 @@ class LowPassFilter : public Blockio<1,1,T> {
    * Saves output for next run
    */
   virtual void run() override {
-    Signal<T> sig = this->in.getSignal(); 
-    T valin = sig.getValue();
-    T valprev = prev.getValue();
+    const Signal<T>& sig = this->readSignal(this->in); 
+    const T& valin = sig.getValueRef();
     if (first) {
-      valprev = valin;
+      prev = valin;
       first = false;
     }
-    T valOut;
-    if(enabled) valOut = valin * alpha + valprev * (1 - alpha); 
-    else valOut = valin;
-    this->out.getSignal().setValue(valOut);
-    this->out.getSignal().setTimestamp(sig.getTimestamp());
-    prev = this->out.getSignal();
+    // for matrices, all elements are filtered in place in one pass
+    if constexpr (math::isFixed<T>::value) {
+      if(enabled) prev = valin * alphaFixed + prev * complementFixed;
+      else prev = valin;
+    } else {
+      if(enabled) prev = valin * alpha + prev * (1 - alpha); 
+      else prev = valin;
+    }
+    this->out.getSignal().set(prev, sig.getTimestamp());
   }
   
   /**
@@ -101,10 +105,17 @@ class LowPassFilter : public Blockio<1,1,T> {
   friend std::ostream& operator<<(std::ostream& os, LowPassFilter<ValT>& filter);
 
  private:
+  using Factor = typename std::conditional<math::isFixed<T>::value, T, double>::type;
+
+  static Factor fixedFactor(double f) {
+    return Factor(f);
+  }
+
   double alpha{1.0};
+  Factor alphaFixed, complementFixed;
   bool first{true};
   bool enabled{true};
-  Signal<T> prev;
+  T prev;
 };
 
 /**
@@ -26,6 +26,13 @@ namespace control {
  * For example a 3-tuple of a Vector3 instance will be kept together during processing
  * in the MedianFilter.\n
  * If the sort algorithm can not sort the values, they will be left unchanged.
+ *
+ * The values are stored in a circular buffer. For arithmetic types, a sorted
+ * copy of the buffer is updated with every new value: the oldest value is
+ * located by binary search and removed, the new value is inserted at its sorted
+ * position. Only the values between these two positions are moved, no sorting
+ * takes place in run(). Matrices are sorted in every run, as they can only be
+ * partially ordered.
  * 
  * @tparam N - number of considered values
  * @tparam Tval - value type (double - default type)
@@ -60,15 +67,23 @@ class MedianFilter : public Blockio<1,1,Tval> {
    * @see disable()
    */
   virtual void run() override {
-    for(size_t i = 0; i < N-1; i++) {
-      currentValues[i] = currentValues[i+1];
+    Tval value = this->in.getSignal().getValue();
+    Tval oldest = currentValues[next];
+    currentValues[next] = value;
+    next = (next + 1) % N;
+    if constexpr (std::is_arithmetic<Tval>::value) {
+      replaceSorted(oldest, value);
     }
-    currentValues[N-1] = this->in.getSignal().getValue();
     if(enabled) {
-      Tval temp[N]{};
-      std::copy(std::begin(currentValues), std::end(currentValues), std::begin(temp));
-      std::sort(std::begin(temp), std::end(temp));
-      currentMedianValue = temp[medianIndex];
+      if constexpr (std::is_arithmetic<Tval>::value) {
+        currentMedianValue = sortedValues[medianIndex];
+      } else {
+        Tval temp[N]{};
+        std::copy(std::begin(currentValues) + next, std::end(currentValues), std::begin(temp));
+        std::copy(std::begin(currentValues), std::begin(currentValues) + next, std::begin(temp) + (N - next));
+        std::sort(std::begin(temp), std::end(temp));
+        currentMedianValue = temp[medianIndex];
+      }
       this->out.getSignal().setValue(currentMedianValue);
     } else {
       this->out.getSignal().setValue(this->in.getSignal().getValue());
@@ -109,11 +124,40 @@ class MedianFilter : public Blockio<1,1,Tval> {
 
  protected:
   Tval currentValues[N]{};
+  Tval sortedValues[std::is_arithmetic<Tval>::value ? N : 1]{};
+  size_t next{0};
   Tval currentMedianValue;
   bool enabled{true};
   constexpr static int medianIndex{static_cast<int>(floor(N/2))};
 
  private:
+  /*
+   * Replaces the oldest value in the sorted values with the new value. If the
+   * oldest value is not found, e.g. because it is NaN, the sorted values are
+   * rebuilt from the circular buffer.
+   */
+  void replaceSorted(Tval oldest, Tval value) {
+    Tval* begin = std::begin(sortedValues);
+    Tval* end = std::end(sortedValues);
+    Tval* pos = std::lower_bound(begin, end, oldest);
+    if (pos == end || !(*pos == oldest)) {
+      std::copy(std::begin(currentValues), std::end(currentValues), begin);
+      std::sort(begin, end);
+      return;
+    }
+    if (oldest < value) {
+      Tval* to = std::upper_bound(pos + 1, end, value);
+      std::move(pos + 1, to, pos);
+      *(to - 1) = value;
+    } else if (value < oldest) {
+      Tval* to = std::upper_bound(begin, pos, value);
+      std::move_backward(to, pos, pos + 1);
+      *to = value;
+    } else {
+      *pos = value;
+    }
+  }
+
   template <typename S>
   typename std::enable_if<std::is_arithmetic<S>::value>::type zeroInitCurrentValues() {
     // is zeroed when initialized by default.
@@ -139,9 +183,9 @@ std::ostream& operator<<(std::ostream& os, MedianFilter<N,Tval>& filter) {
   os << filter.enabled << ", ";
   os << "current median=" << filter.currentMedianValue << ", ";
   os << "medianIndex=" << filter.medianIndex << ", ";
-  os << "current values:[" << filter.currentValues[0];
+  os << "current values:[" << filter.currentValues[filter.next];
   for(size_t i = 1; i < N; i++){
-    os << "," << filter.currentValues[i];
+    os << "," << filter.currentValues[(filter.next + i) % N];
   }
   os << "]";
   return os;
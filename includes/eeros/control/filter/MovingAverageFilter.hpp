@@ -2,6 +2,7 @@
 #define ORG_EEROS_CONTROL_MOVINGAVERAGEFILTER_HPP_
 
 #include <eeros/control/Blockio.hpp>
+#include <eeros/math/MatrixKernels.hpp>
 #include <type_traits>
 
 
@@ -26,6 +27,14 @@ namespace control {
  * values and the coefficients when the class template is instanciated.
  * The non-type template argument specifies the number of coefficients and the
  * number of concidered past values respectively.
+ *
+ * The past values are stored twice in a circular buffer, so that the current
+ * window is always contiguous in memory and no values are moved in run().
+ * For double and float values, the weighted sum is computed with a vectorized dot product,
+ * matrices with arithmetic coefficients are accumulated with vectorized kernels
+ * as well. If all coefficients are equal, the filter can be constructed with the
+ * single coefficient, it then keeps a running sum and needs constant time
+ * independent of N.
  * 
  * @tparam N - number of coefficients
  * @tparam Tval - value type (double - default type)
@@ -46,6 +55,16 @@ class MovingAverageFilter : public Blockio<1,1,Tval> {
     zeroInitPreviousValues<Tval>();
   }
 
+  /**
+   * Constructs a MovingAverageFilter instance where all N coefficients are equal,
+   * e.g. 1.0 / N for the arithmetic mean. The output is calculated from a running sum.\n
+   * @param coeff - coefficient of all values
+   */
+  explicit MovingAverageFilter(Tcoeff coeff) : coefficients{nullptr}, uniformCoefficient{coeff} {
+    zeroInitPreviousValues<Tval>();
+    sum = previousValues[0];
+  }
+
   /**
    * Runs the filter algorithm.
    * 
@@ -63,12 +82,22 @@ class MovingAverageFilter : public Blockio<1,1,Tval> {
    */
   virtual void run() override {
     Tval val = this->in.getSignal().getValue();
-    Tval result = coefficients[N-1] * val;
-    for(size_t i = 0; i < N - 1; i++) {
-      previousValues[i] = previousValues[i+1];
-      result += coefficients[i] * previousValues[i];
+    Tval oldest = previousValues[next];
+    previousValues[next] = val;
+    previousValues[next + N] = val;
+    if (++next == N) next = 0;
+    const Tval* window = previousValues + next;
+    Tval result;
+    if (coefficients == nullptr) {
+      sum += val - oldest;
+      if (next == 0) {  // against the accumulation of rounding errors
+        sum = window[0];
+        for(size_t i = 1; i < N; i++) sum += window[i];
+      }
+      result = uniformCoefficient * sum;
+    } else {
+      result = weightedSum(window);
     }
-    previousValues[N-1] = val;
     if(enabled) {
       this->out.getSignal().setValue(result);
     } else {
@@ -109,10 +138,31 @@ class MovingAverageFilter : public Blockio<1,1,Tval> {
 
  protected:
   const Tcoeff * coefficients;
-  Tval previousValues[N]{};
+  Tcoeff uniformCoefficient{};
+  Tval previousValues[2 * N]{};
+  Tval sum{};
+  size_t next{0};
   bool enabled{true};
 
  private:
+  Tval weightedSum(const Tval* window) const {
+    if constexpr (std::is_floating_point<Tval>::value && std::is_same<Tcoeff, Tval>::value) {
+      return math::kernel::dot(coefficients, window, N);
+    } else if constexpr (std::is_arithmetic<Tcoeff>::value &&
+                         requires(Tval v) { typename Tval::value_type; v.data(); v.size(); }) {
+      Tval result;
+      math::kernel::weightedSum(result.data(), [window](unsigned int i) { return window[i].data(); },
+                                coefficients, N, result.size());
+      return result;
+    } else {
+      Tval result = coefficients[N-1] * window[N-1];
+      for(size_t i = 0; i < N - 1; i++) {
+        result += coefficients[i] * window[i];
+      }
+      return result;
+    }
+  }
+
   template <typename S>
   typename std::enable_if<std::is_arithmetic<S>::value>::type zeroInitPreviousValues() {
     // is zeroed when initialized by default.
@@ -121,9 +171,10 @@ class MovingAverageFilter : public Blockio<1,1,Tval> {
 
   template <typename S>
   typename std::enable_if<!std::is_arithmetic<S>::value>::type zeroInitPreviousValues() {
-    for(size_t i = 0; i < N; i++) {
+    for(size_t i = 0; i < 2 * N; i++) {
       previousValues[i].zero();
     }
+    sum.zero();
   }
 };
 
@@ -138,15 +189,18 @@ std::ostream& operator<<(std::ostream& os, MovingAverageFilter<N,Tval,Tcoeff>& f
   os << "Block MovingAverageFilter: '" << filter.getName() << "' is enabled=";
   os << filter.enabled << ", ";
 
-  os << "coefficients:[" << filter.coefficients[0];
+  auto coefficient = [&filter](size_t i) {
+    return filter.coefficients == nullptr ? filter.uniformCoefficient : filter.coefficients[i];
+  };
+  os << "coefficients:[" << coefficient(0);
   for(size_t i = 1; i < N; i++){
-    os << "," << filter.coefficients[i];
+    os << "," << coefficient(i);
   }
   os << "], ";
 
-  os << "previousValues:[" << filter.previousValues[0];
+  os << "previousValues:[" << filter.previousValues[filter.next];
   for(size_t i = 1; i < N; i++){
-    os << "," << filter.previousValues[i];
+    os << "," << filter.previousValues[filter.next + i];
   }
   os << "]";
   return os;
@@ -0,0 +1,238 @@
+#ifndef ORG_EEROS_CONTROL_FILTER_SOSFILTER_HPP
+#define ORG_EEROS_CONTROL_FILTER_SOSFILTER_HPP
+
+#include <eeros/control/Blockio.hpp>
+#include <eeros/control/ZTransferFunction.hpp>
+#include <eeros/core/Fault.hpp>
+#include <eeros/math/Fraction.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <eeros/math/MatrixKernels.hpp>
+#include <array>
+#include <type_traits>
+
+namespace eeros {
+namespace control {
+
+/**
+ * Coefficients of a second order section, normalized to a0 = 1:
+ *
+ * H(z) = (b0 + b1*z^-1 + b2*z^-2) / (1 + a1*z^-1 + a2*z^-2)
+ *
+ * @since v1.4.4
+ */
+struct BiquadSection {
+  double b0{1.0}, b1{0.0}, b2{0.0}, a1{0.0}, a2{0.0};
+
+  /**
+   * Creates a section from a transfer function of first or second order,
+   * e.g. one created with ZTransferFunction::PID() or ZTransferFunction::DT1().
+   *
+   * @param f - transfer function as fraction of polynomes in z^-1
+   */
+  template <int ORDER>
+  static BiquadSection fromFraction(const math::Fraction<ORDER>& f) {
+    static_assert(ORDER >= 1 && ORDER <= 2, "A second order section needs a transfer function of first or second order");
+    double a0 = f.denominator.c[0];
+    if (a0 == 0) throw Fault("Creating second order section failed: leading denominator coefficient is 0");
+    BiquadSection s;
+    s.b0 = f.numerator.c[0] / a0;
+    s.b1 = f.numerator.c[1] / a0;
+    s.a1 = f.denominator.c[1] / a0;
+    if constexpr (ORDER == 2) {
+      s.b2 = f.numerator.c[2] / a0;
+      s.a2 = f.denominator.c[2] / a0;
+    }
+    return s;
+  }
+};
+
+/**
+ * A second order sections filter (SosFilter) block filters its input with a
+ * cascade of S second order sections (biquads), each evaluated in the transposed
+ * direct form II:
+ *
+ * y = b0*x + s1;  s1 = b1*x - a1*y + s2;  s2 = b2*x - a2*y
+ *
+ * Compared to a high order polynome in direct form, a cascade of sections is far
+ * less sensitive to rounding of the coefficients. Each section only keeps its two
+ * state values in place, no past values are shifted.
+ *
+ * If the value type is a matrix (Matrix, Vector), every element is filtered as
+ * a separate channel with the same coefficients. The channels are processed
+ * together with the vector kernels of the matrix library. With float values,
+ * the coefficients and the state are rounded to float and a vector register
+ * holds twice as many channels.
+ *
+ * The timestamp of the output is the timestamp of the input.
+ *
+ * @tparam S - number of second order sections
+ * @tparam T - value type, double, float or a matrix of them (double - default type)
+ *
+ * @since v1.4.4
+ */
+template <unsigned int S, typename T = double>
+class SosFilter : public Blockio<1,1,T> {
+  using E = typename math::ValueShape<T>::value_type;
+  static constexpr unsigned int C = math::ValueShape<T>::size;
+  static_assert(std::is_floating_point_v<E>, "SosFilter needs floating point values or a matrix of them");
+
+ public:
+  /**
+   * Constructs a filter from the coefficients of its sections.
+   *
+   * @param sections - coefficients, the input passes the sections in this order
+   */
+  SosFilter(const std::array<BiquadSection, S>& sections) : sections(sections) {
+    prepare();
+    reset();
+  }
+
+  /**
+   * Constructs a filter with one section per transfer function, e.g.
+   * SosFilter<1> pid(ZTransferFunction<1>::PID(Ts, Kp, Tn, Tv, Tv1));
+   *
+   * @param tf - transfer functions of first or second order
+   */
+  template <int... ORDER>
+    requires (sizeof...(ORDER) == S)
+  SosFilter(const ZTransferFunction<ORDER>&... tf)
+      : sections{BiquadSection::fromFraction(tf.getFraction())...} {
+    prepare();
+    reset();
+  }
+
+  /**
+   * Disabling use of copy constructor because the block should never be copied unintentionally.
+   */
+  SosFilter(const SosFilter& s) = delete;
+
+  /**
+   * Runs the filter algorithm.
+   *
+   * Passes the input through all sections, if the filter is enabled.
+   * Otherwise the input is directed to the output and the state is kept.
+   */
+  virtual void run() override {
+    const Signal<T>& sig = this->readSignal(this->in);
+    T val = sig.getValueRef();
+    if (enabled) process(math::ValueShape<T>::data(val));
+    this->out.getSignal().set(val, sig.getTimestamp());
+  }
+
+  /**
+   * Sets the state of all sections to 0.
+   */
+  void reset() {
+    for (auto& s : state) s = 0;
+  }
+
+  /**
+   * Enables the filter.
+   *
+   * @see run()
+   */
+  virtual void enable() override {
+    enabled = true;
+  }
+
+  /**
+   * Disables the filter.
+   *
+   * If disabled, run() will set the output signal to the input signal.
+   *
+   * @see run()
+   */
+  virtual void disable() override {
+    enabled = false;
+  }
+
+  /**
+   * @param index - index of the section
+   * @return coefficients of a section
+   */
+  const BiquadSection& getSection(unsigned int index) const {
+    return sections.at(index);
+  }
+
+  /*
+   * Friend operator overload to give the operator overload outside
+   * the class access to the private fields.
+   */
+  template <unsigned int No, typename ValT>
+  friend std::ostream& operator<<(std::ostream& os, SosFilter<No,ValT>& filter);
+
+ private:
+  struct Coefficients {
+    E b0, b1, b2, a1, a2;
+  };
+
+  /*
+   * Rounds the coefficients to the value type.
+   */
+  void prepare() {
+    for (unsigned int k = 0; k < S; k++) {
+      const BiquadSection& c = sections[k];
+      coeff[k] = {static_cast<E>(c.b0), static_cast<E>(c.b1), static_cast<E>(c.b2), static_cast<E>(c.a1), static_cast<E>(c.a2)};
+    }
+  }
+
+  /*
+   * Filters the C channels of x in place.
+   */
+  void process(E* x) {
+    unsigned int j = 0;
+#ifdef EEROS_MATH_DOUBLE_PACK
+    if constexpr (math::kernel::hasPack<E>) {
+      using P = typename math::kernel::PackOf<E>::type;
+      for (; j + P::width <= C; j += P::width) {
+        auto v = P::load(x + j);
+        for (unsigned int k = 0; k < S; k++) {
+          const Coefficients& c = coeff[k];
+          E* s1 = state + 2 * C * k + j;
+          E* s2 = s1 + C;
+          auto y = P::add(P::mul(P::set(c.b0), v), P::load(s1));
+          P::store(s1, P::add(P::sub(P::mul(P::set(c.b1), v), P::mul(P::set(c.a1), y)), P::load(s2)));
+          P::store(s2, P::sub(P::mul(P::set(c.b2), v), P::mul(P::set(c.a2), y)));
+          v = y;
+        }
+        P::store(x + j, v);
+      }
+    }
+#endif
+    for (; j < C; j++) {
+      E v = x[j];
+      for (unsigned int k = 0; k < S; k++) {
+        const Coefficients& c = coeff[k];
+        E* s1 = state + 2 * C * k + j;
+        E* s2 = s1 + C;
+        E y = c.b0 * v + *s1;
+        *s1 = c.b1 * v - c.a1 * y + *s2;
+        *s2 = c.b2 * v - c.a2 * y;
+        v = y;
+      }
+      x[j] = v;
+    }
+  }
+
+  std::array<BiquadSection, S> sections;
+  std::array<Coefficients, S> coeff;
+  E state[2 * C * S];
+  bool enabled{true};
+};
+
+/**
+ * Operator overload (<<) to enable an easy way to print the state of a
+ * SosFilter instance to an output stream.
+ * Does not print a newline control character.
+ */
+template <unsigned int S, typename T>
+std::ostream& operator<<(std::ostream& os, SosFilter<S,T>& filter) {
+  os << "Block SosFilter: '" << filter.getName() << "' is enabled=";
+  os << filter.enabled << ", sections=" << S;
+  return os;
+}
+
+}
+}
+
+#endif /* ORG_EEROS_CONTROL_FILTER_SOSFILTER_HPP */
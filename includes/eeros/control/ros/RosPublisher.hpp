@@ -4,12 +4,17 @@
 #include <ros/ros.h>
 #include <ros/callback_queue.h>
 #include <eeros/control/Block1i.hpp>
+#include <eeros/control/ros/RosPublisherThread.hpp>
+#include <memory>
 
 namespace eeros {
 namespace control {
 
 /**
  * This is the base class for all blocks which publish ROS messages.
+ * By default, the block publishes a message whenever it runs. With a rate, the block
+ * only fills a message and a background thread publishes the newest one at that rate,
+ * see RosPublisherThread. A fast time domain then does not pay for ROS on every cycle.
  * 
  * @tparam TRosMsg - type of the ROS message
  * @tparam SigInType - type of the input signal
@@ -26,13 +31,15 @@ class RosPublisher : public Block1i<SigInType> {
    * @param topic - name of the topic
    * @param queueSize - maximum number of outgoing messages to be queued for delivery to subscribers
    * @param callNewest - not used
+   * @param rate - publishing rate in Hz of a background thread, 0 to publish whenever the block runs
    */
-  RosPublisher(const std::string& topic, uint32_t queueSize=1000, bool callNewest=false) 
+  RosPublisher(const std::string& topic, uint32_t queueSize=1000, bool callNewest=false, double rate=0) 
       : topic(topic) {
     if (ros::master::check()) {    
       ros::NodeHandle handle;
       publisher = handle.advertise<TRosMsg>(topic, queueSize);
       ROS_DEBUG_STREAM("RosBlockPublisher, reading from topic: '" << topic << "' created.");
+      if (rate > 0) decoupled = std::make_unique<RosPublisherThread<TRosMsg>>(publisher, rate);
       running = true;
     }
   }
@@ -53,9 +60,14 @@ class RosPublisher : public Block1i<SigInType> {
    * This method will be executed whenever the block runs.
    */
   virtual void run() {
-    if (running) {    
-      setRosMsg(msg);
-      publisher.publish(msg);
+    if (running) {
+      if (decoupled) {
+        setRosMsg(decoupled->message());
+        decoupled->commit();
+      } else {
+        setRosMsg(msg);
+        publisher.publish(msg);
+      }
     }
   }
 
@@ -65,6 +77,7 @@ class RosPublisher : public Block1i<SigInType> {
   const std::string& topic;
   TRosMsg msg;
   bool running = false;
+  std::unique_ptr<RosPublisherThread<TRosMsg>> decoupled;
 };
 
 }
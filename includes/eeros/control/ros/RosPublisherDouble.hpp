@@ -24,9 +24,10 @@ class RosPublisherDouble : public RosPublisher<std_msgs::Float64::Type, double>
    * 
    * @param topic - name of the topic
    * @param queueSize - maximum number of outgoing messages to be queued for delivery to subscribers
+   * @param rate - publishing rate in Hz of a background thread, 0 to publish whenever the block runs
    */ 
-  RosPublisherDouble (const std::string& topic, const uint32_t queueSize=1000) 
-      : RosPublisher<TRosMsg, double>(topic, queueSize) { }
+  RosPublisherDouble (const std::string& topic, const uint32_t queueSize=1000, double rate=0) 
+      : RosPublisher<TRosMsg, double>(topic, queueSize, false, rate) { }
   
   /**
    * Disabling use of copy constructor because the block should never be copied unintentionally.
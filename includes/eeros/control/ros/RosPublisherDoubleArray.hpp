@@ -26,9 +26,10 @@ class RosPublisherDoubleArray : public RosPublisher<std_msgs::Float64MultiArray:
    * 
    * @param topic - name of the topic
    * @param queueSize - maximum number of outgoing messages to be queued for delivery to subscribers
+   * @param rate - publishing rate in Hz of a background thread, 0 to publish whenever the block runs
    */ 
-  RosPublisherDoubleArray(const std::string& topic, const uint32_t queueSize=1000) :
-    RosPublisher<TRosMsg, SigInType>(topic, queueSize) { }
+  RosPublisherDoubleArray(const std::string& topic, const uint32_t queueSize=1000, double rate=0) :
+    RosPublisher<TRosMsg, SigInType>(topic, queueSize, false, rate) { }
     
   /**
    * Disabling use of copy constructor because the block should never be copied unintentionally.
@@ -37,14 +38,15 @@ class RosPublisherDoubleArray : public RosPublisher<std_msgs::Float64MultiArray:
 
   /**
    * Sets the message to be published by this block.
+   * The values are copied into the data of the message, which keeps its memory.
    * 
    * @param msg - message content
    */
   void setRosMsg(TRosMsg& msg) {
     if (this->in.isConnected()) {
-      auto val = this->in.getSignal().getValue();
-      auto valTmpDouble = val.getColVector(0);
-      msg.data = valTmpDouble;
+      const auto& val = this->in.getSignal().getValue();
+      msg.data.resize(val.getNofRows());
+      for (unsigned int i = 0; i < val.getNofRows(); i++) msg.data[i] = val(i, 0);
     }
   }
 };
@@ -21,8 +21,8 @@ class RosPublisherLaserScan : public RosPublisher<sensor_msgs::LaserScan::Type,
   // A-2 Define the type of the ROS message
   typedef sensor_msgs::LaserScan::Type	TRosMsg;
  public:
-  RosPublisherLaserScan(const std::string& topic, const std::string& frame_id, const uint32_t queueSize=1000) 
-      : RosPublisher<TRosMsg, double>(topic, queueSize), frame_id(frame_id) { }
+  RosPublisherLaserScan(const std::string& topic, const std::string& frame_id, const uint32_t queueSize=1000, double rate=0) 
+      : RosPublisher<TRosMsg, double>(topic, queueSize, false, rate), frame_id(frame_id) { }
 
   void setRosMsg(TRosMsg& msg) {
     // B-3 If available, set time in msg header
@@ -48,16 +48,12 @@ class RosPublisherLaserScan : public RosPublisher<sensor_msgs::LaserScan::Type,
     if (rangesInput.isConnected() ) {
       // C-5 Get the vector from the EEROS input
       rangesValue = rangesInput.getSignal().getValue();
-      auto rangesTmpDouble = rangesValue.getColVector(0);
-      // C-6 Cast the vector and assign it to the appropriate ROS data field
-      std::vector<float> rangesTmpFloat( rangesTmpDouble.begin(), rangesTmpDouble.end() );	// cast to float vector
-      msg.ranges			= rangesTmpFloat;
+      // C-6 Cast the vector into the appropriate ROS data field, which keeps its memory
+      set(msg.ranges, rangesValue);
     }
     if (intensitiesInput.isConnected() ) {
       intensitiesValue = intensitiesInput.getSignal().getValue();
-      auto intensitiesTmpDouble = rangesValue.getColVector(0);
-      std::vector<float> intensitiesTmpFloat( intensitiesTmpDouble.begin(), intensitiesTmpDouble.end() );	// cast to float vector
-      msg.intensities		= intensitiesTmpFloat;
+      set(msg.intensities, intensitiesValue);
     }
   }
   
@@ -88,6 +84,13 @@ class RosPublisherLaserScan : public RosPublisher<sensor_msgs::LaserScan::Type,
   TIntensitiesInput			intensitiesValue;
   Input<TIntensitiesInput>	intensitiesInput;
   std::string frame_id;
+
+ private:
+  template < typename T >
+  static void set(std::vector<float>& dst, const T& value) {
+    dst.resize(value.getNofRows());
+    for (unsigned int i = 0; i < value.getNofRows(); i++) dst[i] = static_cast<float>(value(i, 0));
+  }
 };
 
 };
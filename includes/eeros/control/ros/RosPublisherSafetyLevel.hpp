@@ -2,6 +2,7 @@
 #define ORG_EEROS_CONTROL_ROSPUBLISHER_SAFETYLEVEL_HPP_
 
 #include <eeros/control/ros/RosPublisher.hpp>
+#include <eeros/control/ros/RosPublisherThread.hpp>
 #include <std_msgs/UInt32.h>
 #include <eeros/safety/SafetySystem.hpp>
 #include <eeros/control/Block.hpp>
@@ -26,13 +27,15 @@ class RosPublisherSafetyLevel : public Block {
    * 
    * @param topic - name of the topic
    * @param queueSize - maximum number of outgoing messages to be queued for delivery to subscribers
+   * @param rate - publishing rate in Hz of a background thread, 0 to publish whenever the block runs
    */ 
-  RosPublisherSafetyLevel(const std::string& topic, const uint32_t queueSize=1000) 
+  RosPublisherSafetyLevel(const std::string& topic, const uint32_t queueSize=1000, double rate=0) 
       : topic(topic) {
     if (ros::master::check()) {    
       ros::NodeHandle handle;
       publisher = handle.advertise<TRosMsg>(topic, queueSize);
       ROS_DEBUG_STREAM("RosPublisherSafetyLevel, reading from topic: '" << topic << "' created.");
+      if (rate > 0) decoupled = std::make_unique<RosPublisherThread<TRosMsg>>(publisher, rate);
       running = true;
     }
   }
@@ -58,8 +61,13 @@ class RosPublisherSafetyLevel : public Block {
   virtual void run() {
     if (running && safetySystem != nullptr) {
       SafetyLevel sl = safetySystem->getCurrentLevel();
-      msg.data = sl.getLevelId();
-      publisher.publish(msg);
+      if (decoupled) {
+        decoupled->message().data = sl.getLevelId();
+        decoupled->commit();
+      } else {
+        msg.data = sl.getLevelId();
+        publisher.publish(msg);
+      }
     }
   }
   
@@ -67,8 +75,9 @@ class RosPublisherSafetyLevel : public Block {
   ros::Publisher publisher;
   const std::string& topic;
   TRosMsg msg;
-  SafetySystem* safetySystem;
+  SafetySystem* safetySystem = nullptr;
   bool running = false;
+  std::unique_ptr<RosPublisherThread<TRosMsg>> decoupled;
 };
 
 }
@@ -0,0 +1,96 @@
+#ifndef ORG_EEROS_CONTROL_ROSPUBLISHERTHREAD_HPP_
+#define ORG_EEROS_CONTROL_ROSPUBLISHERTHREAD_HPP_
+
+#include <ros/ros.h>
+#include <eeros/core/TripleBuffer.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace eeros {
+namespace control {
+
+/**
+ * Publishes ROS messages at a fixed rate from a background thread, decoupled from
+ * the rate of the time domain a publisher block runs in. The block fills the writer
+ * slot of a triple buffer in place and hands it over without a lock, the thread
+ * publishes the newest message once per period, if there is a new one. The three
+ * messages of the buffer are reused, so vectors in a message only allocate until
+ * they have reached their size.
+ *
+ * @tparam TRosMsg - type of the ROS message
+ *
+ * @since v1.4.4
+ */
+template < typename TRosMsg >
+class RosPublisherThread {
+ public:
+  /**
+   * Starts the publisher thread.
+   *
+   * @param publisher - ROS publisher
+   * @param rate - publishing rate in Hz
+   */
+  RosPublisherThread(ros::Publisher& publisher, double rate)
+      : publisher(publisher), period(std::chrono::duration<double>(1.0 / rate)) {
+    thread = std::thread([this]() { run(); });
+  }
+
+  /**
+   * Stops the publisher thread.
+   */
+  ~RosPublisherThread() {
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      running = false;
+    }
+    cv.notify_one();
+    if (thread.joinable()) thread.join();
+  }
+
+  RosPublisherThread(const RosPublisherThread&) = delete;
+  RosPublisherThread& operator=(const RosPublisherThread&) = delete;
+
+  /**
+   * Returns the message to be filled by the block.
+   *
+   * @return message owned by the block until commit()
+   */
+  TRosMsg& message() {
+    return buffer.writeBuffer();
+  }
+
+  /**
+   * Makes the message filled by the block the newest one to be published.
+   */
+  void commit() {
+    buffer.publish();
+  }
+
+ private:
+  void run() {
+    auto next = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(mtx);
+    while (running) {
+      next += std::chrono::duration_cast<std::chrono::steady_clock::duration>(period);
+      if (cv.wait_until(lock, next, [this]() { return !running; })) break;
+      bool newData;
+      const TRosMsg& msg = buffer.read(newData);
+      if (newData) publisher.publish(msg);
+    }
+  }
+
+  ros::Publisher& publisher;
+  std::chrono::duration<double> period;
+  TripleBuffer<TRosMsg> buffer;
+  std::mutex mtx;                 // only guards sleeping and stopping, never taken by the block
+  std::condition_variable cv;
+  bool running = true;
+  std::thread thread;
+};
+
+}
+}
+
+#endif /* ORG_EEROS_CONTROL_ROSPUBLISHERTHREAD_HPP_ */
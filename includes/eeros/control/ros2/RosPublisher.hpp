@@ -3,7 +3,12 @@
 #include <rclcpp/rclcpp.hpp>
 #include <eeros/control/ros2/RosTools.hpp>
 #include <eeros/control/Blockio.hpp>
+#include <eeros/core/SpscRingBuffer.hpp>
 #include <eeros/logger/Logger.hpp>
+#include <atomic>
+#include <memory>
+#include <semaphore>
+#include <thread>
 
 using namespace eeros::logger;
 
@@ -12,6 +17,16 @@ namespace control {
 
 /**
  * This is the base class for all blocks which publish ROS messages.
+ * When the block runs, setRosMsg() fills a preallocated message in a lock-free
+ * queue. A publisher thread of the block calls publish(), so serialization and
+ * the DDS write do not run in the time domain. If the publisher thread falls 
+ * behind and the queue is full, the message is dropped and counted, see getDropped().
+ * 
+ * If the middleware can loan messages, e.g. iceoryx or CycloneDDS with shared memory
+ * for messages of a fixed size, the message is copied into a loaned message and
+ * published without serialization. If the node uses intra-process communication, 
+ * the message is published as a unique_ptr, so subscribers in the same process 
+ * receive it without serialization either.
  * 
  * @tparam TRosMsg - type of the ROS message
  * @tparam N - number of inputs
@@ -30,17 +45,31 @@ class RosPublisher : public Blockio<N,0,SigInType> {
    * @param node - ROS node as a shared ptr
    * @param topic - name of the topic
    * @param queueSize - maximum number of outgoing messages to be queued for delivery to subscribers
+   * @param prototype - initial content of the reused messages, e.g. with vectors already of their final size
    */
-  RosPublisher(const rclcpp::Node::SharedPtr node, const std::string& topic, uint32_t queueSize=1000)
-      : log(Logger::getLogger()) {
+  RosPublisher(const rclcpp::Node::SharedPtr node, const std::string& topic, uint32_t queueSize=1000, const TRosMsg& prototype=TRosMsg())
+      : log(Logger::getLogger()), queue(prototype) {
     if (rclcpp::ok()) {
       publisher = node->create_publisher<TRosMsg>(topic, queueSize);
+      loan = publisher->can_loan_messages();
+      intraProcess = node->get_node_options().use_intra_process_comms();
       log.info() << "RosBlockPublisher, writing to topic: '" << topic << "' on node '" << node->get_name();
 //       RCLCPP_INFO_STREAM(node->get_logger(), "RosBlockPublisher to topic: '" << topic << "' created.");
       running = true;
+      publishing = true;
+      thread = std::thread([this]() { publishMessages(); });
     }
   }
 
+  /**
+   * Stops the publisher thread.
+   */
+  virtual ~RosPublisher() {
+    publishing = false;
+    ready.release();
+    if (thread.joinable()) thread.join();
+  }
+
   /**
    * Disabling use of copy constructor because the block should never be copied unintentionally.
    */
@@ -57,18 +86,57 @@ class RosPublisher : public Blockio<N,0,SigInType> {
    * This method will be executed whenever the block runs.
    */
   virtual void run() {
-    if (running) {    
-      setRosMsg(msg);
-      publisher->publish(msg);
+    if (running) {
+      TRosMsg* msg = queue.claim();
+      if (msg == nullptr) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      setRosMsg(*msg);
+      queue.push();
+      ready.release();
     }
   }
 
+  /**
+   * @return number of messages dropped because the publisher thread fell behind
+   */
+  uint64_t getDropped() const {
+    return dropped.load(std::memory_order_relaxed);
+  }
+
 
  protected:
   typename rclcpp::Publisher<TRosMsg>::SharedPtr publisher;
-  TRosMsg msg;
   bool running = false;
   Logger log;
+
+ private:
+  void publishMessages() {
+    while (publishing) {
+      ready.acquire();
+      while (const TRosMsg* msg = queue.front()) {
+        if (loan) {
+          auto loaned = publisher->borrow_loaned_message();
+          loaned.get() = *msg;
+          publisher->publish(std::move(loaned));
+        } else if (intraProcess) {
+          publisher->publish(std::make_unique<TRosMsg>(*msg));
+        } else {
+          publisher->publish(*msg);
+        }
+        queue.pop();
+      }
+    }
+  }
+
+  SpscRingBuffer<TRosMsg, 16> queue;    // messages keep their memory when they are reused
+  std::counting_semaphore<> ready{0};
+  std::atomic<uint64_t> dropped{0};
+  std::atomic<bool> publishing{false};
+  bool loan = false;
+  bool intraProcess = false;
+  std::thread thread;
 };
 
 }
@@ -1,79 +1,98 @@
 #pragma once
 
 #include <eeros/control/ros2/RosPublisher.hpp>
+#include <eeros/control/ros2/RosTools.hpp>
 #include <eeros/math/Matrix.hpp>
-#include <eeros/control/ros2/EerosRosTools.hpp>
 #include <eeros/core/System.hpp>
 
-// A-1 Include the header file of the ROS message
-#include <sensor_msgs/LaserScan.h>
-
-
+#include <sensor_msgs/msg/laser_scan.hpp>
 
 namespace eeros {
 namespace control {
 
-// C-1 Create the template definition. Each EEROS matrix input needs its own type
-template < typename TRangesInput, typename TIntensitiesInput >
-// A-3 Name your block and create the constructor. Copy the type definition
-class RosPublisherLaserScan : public RosPublisher<sensor_msgs::LaserScan::Type, double> {
-  // A-2 Define the type of the ROS message
-  typedef sensor_msgs::LaserScan::Type	TRosMsg;
+/**
+ * This block publishes a laser scan as a ROS message of type sensor_msgs::msg::LaserScan.
+ * The input of the block carries the ranges, further inputs the intensities and the
+ * parameters of the scan. The ranges and intensities are converted into the vectors of
+ * the reused messages, which are preallocated for the expected number of beams, so no
+ * memory is allocated when the block runs. Large scans benefit from loaned messages and intra-process 
+ * communication, see \ref RosPublisher.
+ *
+ * @tparam TRangesInput - type of the ranges input, a vector
+ * @tparam TIntensitiesInput - type of the intensities input, a vector
+ *
+ * @since v1.0
+ */
+template < typename TRangesInput, typename TIntensitiesInput = TRangesInput >
+class RosPublisherLaserScan : public RosPublisher<sensor_msgs::msg::LaserScan, 1, TRangesInput> {
+  typedef sensor_msgs::msg::LaserScan TRosMsg;
  public:
-  RosPublisherLaserScan(const std::string& topic, const std::string& frame_id, const uint32_t queueSize=1000) 
-      : RosPublisher<TRosMsg, double>(topic, queueSize), frame_id(frame_id) { }
+  /**
+   * Creates an instance of a laser scan publisher block.
+   *
+   * @param node - ROS node as a shared ptr
+   * @param topic - name of the topic
+   * @param frame_id - frame of the scan
+   * @param queueSize - maximum number of outgoing messages to be queued for delivery to subscribers
+   * @param beams - expected number of beams of a scan
+   */
+  RosPublisherLaserScan(const rclcpp::Node::SharedPtr node, const std::string& topic, const std::string& frame_id, const uint32_t queueSize = 1000,
+                        const uint32_t beams = TRangesInput::nofElements) 
+      : RosPublisher<TRosMsg, 1, TRangesInput>(node, topic, queueSize, prototype(beams)), 
+        angle_minInput(this), angle_maxInput(this), angle_incrementInput(this), time_incrementInput(this),
+        scan_timeInput(this), range_minInput(this), range_maxInput(this), intensitiesInput(this), frame_id(frame_id) { }
 
+  /**
+   * Disabling use of copy constructor because the block should never be copied unintentionally.
+   */
+  RosPublisherLaserScan(const RosPublisherLaserScan& other) = delete;
+
+  /**
+   * Sets the message to be published by this block.
+   *
+   * @param msg - message content
+   */
   void setRosMsg(TRosMsg& msg) override {
-    // B-3 If available, set time in msg header
-    msg.header.stamp = eeros::control::rosTools::convertToRosTime(eeros::System::getTimeNs());
+    msg.header.stamp = RosTools::convertToRosTime(this->in.getSignal().getTimestamp());
     msg.header.frame_id = frame_id;
-    
-    // B-4 Check if EEROS input is connected. Cast the data. Assign casted data to ROS message field
-    if (angle_minInput.isConnected() )
-      msg.angle_min		= static_cast<float>( angle_minInput.getSignal().getValue() );
-    if (angle_maxInput.isConnected() )
-      msg.angle_max 		= static_cast<float>( angle_maxInput.getSignal().getValue() );
-    if (angle_incrementInput.isConnected() )
-      msg.angle_increment = static_cast<float>( angle_incrementInput.getSignal().getValue() );
-    if (time_incrementInput.isConnected() )
-      msg.time_increment	= static_cast<float>( time_incrementInput.getSignal().getValue() );
-    if (scan_timeInput.isConnected() )
-      msg.scan_time		= static_cast<float>( scan_timeInput.getSignal().getValue() );
-    if (range_minInput.isConnected() )
-      msg.range_min		= static_cast<float>( range_minInput.getSignal().getValue() );
-    if (range_maxInput.isConnected() )
-      msg.range_max		= static_cast<float>( range_maxInput.getSignal().getValue() );
-    // C-4 Check if EEROS input is connected
-    if (rangesInput.isConnected() ) {
-      // C-5 Get the vector from the EEROS input
-      rangesValue = rangesInput.getSignal().getValue();
-      auto rangesTmpDouble = rangesValue.getColVector(0);
-      // C-6 Cast the vector and assign it to the appropriate ROS data field
-      std::vector<float> rangesTmpFloat( rangesTmpDouble.begin(), rangesTmpDouble.end() );	// cast to float vector
-      msg.ranges			= rangesTmpFloat;
-    }
-    if (intensitiesInput.isConnected() ) {
-      intensitiesValue = intensitiesInput.getSignal().getValue();
-      auto intensitiesTmpDouble = rangesValue.getColVector(0);
-      std::vector<float> intensitiesTmpFloat( intensitiesTmpDouble.begin(), intensitiesTmpDouble.end() );	// cast to float vector
-      msg.intensities		= intensitiesTmpFloat;
-    }
+    if (angle_minInput.isConnected()) msg.angle_min = static_cast<float>(angle_minInput.getSignal().getValue());
+    if (angle_maxInput.isConnected()) msg.angle_max = static_cast<float>(angle_maxInput.getSignal().getValue());
+    if (angle_incrementInput.isConnected()) msg.angle_increment = static_cast<float>(angle_incrementInput.getSignal().getValue());
+    if (time_incrementInput.isConnected()) msg.time_increment = static_cast<float>(time_incrementInput.getSignal().getValue());
+    if (scan_timeInput.isConnected()) msg.scan_time = static_cast<float>(scan_timeInput.getSignal().getValue());
+    if (range_minInput.isConnected()) msg.range_min = static_cast<float>(range_minInput.getSignal().getValue());
+    if (range_maxInput.isConnected()) msg.range_max = static_cast<float>(range_maxInput.getSignal().getValue());
+    // converted in place, the vectors keep their capacity in the reused message
+    if (this->in.isConnected()) set(msg.ranges, this->in.getSignal().getValue());
+    else msg.ranges.clear();
+    if (intensitiesInput.isConnected()) set(msg.intensities, intensitiesInput.getSignal().getValue());
+    else msg.intensities.clear();
   }
-  
-  // B-2 Add a 'getInput()' function for each input
-  Input<double>& getAngle_minInput()			{return angle_minInput; };
-  Input<double>& getAngle_maxInput()			{return angle_maxInput; };
-  Input<double>& getAngle_incrementInput()	{return angle_incrementInput; };
-  Input<double>& getTime_incrementInput()	{return time_incrementInput; };
-  Input<double>& getScan_timeInput()			{return scan_timeInput; };
-  Input<double>& getRange_minInput()			{return range_minInput; };
-  Input<double>& getRange_maxInput()			{return range_maxInput; };
-  // C-3 Add a 'getInput()' function for each EEROS matrix Input
-  Input<TRangesInput>& getRangesInput()				{return rangesInput; };
-  Input<TIntensitiesInput>& getIntensitiessInput()	{return intensitiesInput; };
-    
+
+  Input<double>& getAngle_minInput() { return angle_minInput; }
+  Input<double>& getAngle_maxInput() { return angle_maxInput; }
+  Input<double>& getAngle_incrementInput() { return angle_incrementInput; }
+  Input<double>& getTime_incrementInput() { return time_incrementInput; }
+  Input<double>& getScan_timeInput() { return scan_timeInput; }
+  Input<double>& getRange_minInput() { return range_minInput; }
+  Input<double>& getRange_maxInput() { return range_maxInput; }
+  Input<TRangesInput>& getRangesInput() { return this->in; }
+  Input<TIntensitiesInput>& getIntensitiesInput() { return intensitiesInput; }
+
  protected:
-  // B-1 Create EEROS inputs
+  static TRosMsg prototype(uint32_t beams) {
+    TRosMsg msg;
+    msg.ranges.resize(beams);
+    msg.intensities.resize(beams);
+    return msg;
+  }
+
+  template < typename T >
+  static void set(std::vector<float>& to, const T& from) {
+    to.resize(from.size());
+    for (unsigned int i = 0; i < from.size(); i++) to[i] = static_cast<float>(from[i]);
+  }
+
   Input<double> angle_minInput;
   Input<double> angle_maxInput;
   Input<double> angle_incrementInput;
@@ -81,17 +100,13 @@ class RosPublisherLaserScan : public RosPublisher<sensor_msgs::LaserScan::Type,
   Input<double> scan_timeInput;
   Input<double> range_minInput;
   Input<double> range_maxInput;
-  // C-2 Create a 'value' and an 'input' variable for each EEROS matrix input
-  TRangesInput				rangesValue;
-  Input<TRangesInput>			rangesInput;
-  TIntensitiesInput			intensitiesValue;
-  Input<TIntensitiesInput>	intensitiesInput;
+  Input<TIntensitiesInput> intensitiesInput;
   std::string frame_id;
 };
 
 /********** Print functions **********/
 template < typename TRangesInput, typename TIntensitiesInput >
-std::ostream& operator<<(std::ostream& os, RosPublisherLaserScan& p) {
+std::ostream& operator<<(std::ostream& os, RosPublisherLaserScan<TRangesInput, TIntensitiesInput>& p) {
   os << "Block RosPublisherLaserScan: '" << p.getName();
   return os;
 }
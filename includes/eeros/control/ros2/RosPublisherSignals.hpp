@@ -0,0 +1,163 @@
+#pragma once
+
+#include <eeros/control/ros2/RosPublisher.hpp>
+#include <eeros/core/Fault.hpp>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <std_msgs/msg/float64_multi_array.hpp>
+#include <std_msgs/msg/multi_array_layout.hpp>
+
+namespace eeros {
+namespace control {
+
+/**
+ * This block publishes any number of signals in one message of type
+ * std_msgs::msg::Float64MultiArray, instead of one publisher block per signal.
+ * All values are converted to double and packed into the data of the message,
+ * matrices element by element, in the order the inputs were added.
+ *
+ * The name table is published once on the topic with "/names" appended, as a
+ * std_msgs::msg::MultiArrayLayout with a transient local QoS, so late subscribers
+ * receive it as well. The label of each dimension is the name of a signal, its size
+ * is the number of elements and its stride is the index of the first element in the data.
+ *
+ * Add all inputs before the block runs the first time.
+ *
+ * @since v1.4.4
+ */
+class RosPublisherSignals : public RosPublisher<std_msgs::msg::Float64MultiArray, 0, double> {
+  typedef std_msgs::msg::Float64MultiArray TRosMsg;
+ public:
+  /**
+   * Creates an instance of a publisher block for several signals.
+   *
+   * @param node - ROS node as a shared ptr
+   * @param topic - name of the topic
+   * @param queueSize - maximum number of outgoing messages to be queued for delivery to subscribers
+   */
+  RosPublisherSignals(const rclcpp::Node::SharedPtr node, const std::string& topic, const uint32_t queueSize = 1000)
+      : RosPublisher<TRosMsg, 0, double>(node, topic, queueSize) {
+    if (running) names = node->create_publisher<std_msgs::msg::MultiArrayLayout>(topic + "/names", rclcpp::QoS(1).reliable().transient_local());
+  }
+
+  /**
+   * Disabling use of copy constructor because the block should never be copied unintentionally.
+   */
+  RosPublisherSignals(const RosPublisherSignals& other) = delete;
+
+  /**
+   * Adds an input, whose value is published with every message.
+   *
+   * @tparam T - signal type, arithmetic or a matrix
+   * @param name - name of the signal in the name table
+   * @return the new input
+   */
+  template < typename T >
+  Input<T>& addInput(const std::string& name) {
+    if (started) throw Fault("cannot add input '" + name + "' to running block '" + getName() + "'");
+    auto p = new Port<T>(this);
+    p->offset = size;
+    size += Element<T>::count;
+    std_msgs::msg::MultiArrayDimension dim;
+    dim.label = name;
+    dim.size = Element<T>::count;
+    dim.stride = p->offset;
+    layout.dim.push_back(dim);
+    ports.emplace_back(p);
+    return p->in;
+  }
+
+  /**
+   * Publishes the name table when the block runs the first time, then the values of all inputs.
+   */
+  virtual void run() override {
+    if (!started) {
+      started = true;
+      if (names) names->publish(layout);
+    }
+    RosPublisher<TRosMsg, 0, double>::run();
+  }
+
+  /**
+   * Sets the message to be published by this block.
+   *
+   * @param msg - message content
+   */
+  virtual void setRosMsg(TRosMsg& msg) override {
+    msg.data.resize(size);
+    for (auto& p : ports) p->store(msg.data.data());
+  }
+
+  /**
+   * @return name table of the published data
+   */
+  const std_msgs::msg::MultiArrayLayout& getLayout() const {
+    return layout;
+  }
+
+  virtual std::vector<Block*> getInputBlocks() override {
+    std::vector<Block*> blocks;
+    for (auto& p : ports) {
+      Block* b = p->getConnectedBlock();
+      if (b != nullptr) blocks.push_back(b);
+    }
+    return blocks;
+  }
+
+  virtual bool areInputsConnected() const override {
+    for (auto& p : ports) if (!p->isConnected()) return false;
+    return true;
+  }
+
+ private:
+  template < typename T, typename Enable = void >
+  struct Element {
+    static constexpr uint32_t count = T::nofElements;
+    static void store(const T& value, double* to) {
+      for (uint32_t i = 0; i < count; i++) to[i] = static_cast<double>(value(i));
+    }
+  };
+
+  template < typename T >
+  struct Element<T, typename std::enable_if<std::is_arithmetic<T>::value>::type> {
+    static constexpr uint32_t count = 1;
+    static void store(const T& value, double* to) { *to = static_cast<double>(value); }
+  };
+
+  struct PortBase {
+    virtual ~PortBase() = default;
+    virtual void store(double* data) = 0;
+    virtual Block* getConnectedBlock() const = 0;
+    virtual bool isConnected() const = 0;
+    uint32_t offset;
+  };
+
+  template < typename T >
+  struct Port : PortBase {
+    Port(Block* owner) : in(owner) { }
+    void store(double* data) override {
+      if (in.isConnected()) Element<T>::store(in.getSignal().getValue(), data + this->offset);
+    }
+    Block* getConnectedBlock() const override { return in.getConnectedBlock(); }
+    bool isConnected() const override { return in.isConnected(); }
+    Input<T> in;
+  };
+
+  std::vector<std::unique_ptr<PortBase>> ports;
+  std_msgs::msg::MultiArrayLayout layout;
+  rclcpp::Publisher<std_msgs::msg::MultiArrayLayout>::SharedPtr names;
+  uint32_t size = 0;
+  bool started = false;
+};
+
+/********** Print functions **********/
+inline std::ostream& operator<<(std::ostream& os, RosPublisherSignals& p) {
+  os << "Block RosPublisherSignals: '" << p.getName();
+  return os;
+}
+
+}
+}
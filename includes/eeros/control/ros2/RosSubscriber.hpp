@@ -7,8 +7,7 @@
 #include <eeros/core/Thread.hpp>
 #include <eeros/core/Executor.hpp>
 #include <eeros/control/ros2/RosTools.hpp>
-#include <deque>
-#include <thread>
+#include <eeros/core/TripleBuffer.hpp>
 
 using namespace eeros::logger;
 using namespace eeros;
@@ -20,6 +19,12 @@ using std::placeholders::_1;
 
 /**
  * This is the base class for all blocks which subscribe to ROS messages.
+ *
+ * The callback copies a received message into the writer slot of a triple buffer
+ * and the block reads the newest message in run(). Neither side takes a lock, so a
+ * ROS thread copying a big message never blocks the realtime thread. Each subscriber
+ * has its own mutually exclusive callback group, so its callback never runs on two
+ * ROS threads at the same time, while different subscribers are still handled in parallel.
  * 
  * @tparam TRosMsg - type of the ROS message
  * @tparam M - number of outputs
@@ -40,9 +45,11 @@ class RosSubscriber : public Blockio<0,M,SigOutType> {
    * @param topic - name of the topic
    * @param syncWithTopic - when set to true the executor runs all time domains upon receiving this message
    * @param queueSize - maximum number of incoming messages to be queued for delivery to subscribers
+   * @param prototype - initial content of the reused messages, e.g. with vectors already of their final size
    */
-  RosSubscriber(const rclcpp::Node::SharedPtr node, const std::string& topic, bool syncWithTopic=false, const uint32_t queueSize=1000)
-      : node(node), sync(syncWithTopic), log(Logger::getLogger()) {
+  RosSubscriber(const rclcpp::Node::SharedPtr node, const std::string& topic, bool syncWithTopic=false, const uint32_t queueSize=1000,
+                const TRosMsg& prototype=TRosMsg())
+      : node(node), sync(syncWithTopic), buffer(prototype), log(Logger::getLogger()) {
   if (rclcpp::ok()) {
     auto qos = rclcpp::SensorDataQoS();
     qos.keep_last(queueSize);
@@ -62,11 +69,12 @@ class RosSubscriber : public Blockio<0,M,SigOutType> {
 
   /**
    * This is the callback which is called on every message the subscriber receives.
-   * The queue is afterwards worked by the run method which is called form the EEROS-Executor.
+   * The message is afterwards parsed by the run method which is called form the EEROS-Executor.
+   * Messages reuse the memory of the slot, so strings and vectors do not reallocate
+   * once they have reached their size.
    */
   void rosSubscriberCallback(const TRosMsg& msg) {
-    std::lock_guard<std::mutex> lock(queue_mutex);
-    queue.push_back(std::move(msg));
+    buffer.write(msg);
     if (sync) {
       Executor::instance().handleTopic();
     }
@@ -84,11 +92,10 @@ class RosSubscriber : public Blockio<0,M,SigOutType> {
    * This method will be executed whenever the block runs.
    */
   virtual void run() {
-    if (running && !queue.empty()) {
-      std::lock_guard<std::mutex> lock(queue_mutex);
-      TRosMsg msg = std::move(queue.back());
-      parseMsg(msg);
-      queue.clear();
+    if (running) {
+      bool newData;
+      const TRosMsg& msg = buffer.read(newData);
+      if (newData) parseMsg(msg);
     }
   }
 
@@ -97,10 +104,8 @@ class RosSubscriber : public Blockio<0,M,SigOutType> {
   typename rclcpp::Subscription<TRosMsg>::SharedPtr subscriber;
   bool running = false;
   bool sync;
-  // thread-safe queue which is filled in callback function called by ROS::Executor
-  // emptied by handled by run method called by EEROS::Executor
-  std::deque<TRosMsg> queue;
-  std::mutex queue_mutex;
+  // written by the callback called by the ROS executor, read by run called by the EEROS executor
+  TripleBuffer<TRosMsg> buffer;
   Logger log;
 };
 
@@ -1,92 +1,120 @@
 #pragma once
 
 #include <eeros/control/ros2/RosSubscriber.hpp>
-#include <eeros/core/System.hpp>
+#include <eeros/control/ros2/RosTools.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <algorithm>
 
-// A-1 Include the header file of the ROS message
-#include <sensor_msgs/LaserScan.h>
+#include <sensor_msgs/msg/laser_scan.hpp>
 
 namespace eeros {
 namespace control {
 
-// C-1 Create the template definition. Each EEROS matrix output needs its own type
-template < typename TRangesOutput, typename TIntensitiesOutput >
-// A-3 Name your block and create the constructor. Copy the type definition
-class RosSubscriberLaserScan : public RosSubscriber<sensor_msgs::LaserScan::Type, double> {
-  // A-2 Define the type of the ROS message
-  typedef sensor_msgs::LaserScan::Type	TRosMsg;
+/**
+ * This block subscribes to a laser scan of type sensor_msgs::msg::LaserScan.
+ * The output of the block carries the ranges, further outputs the intensities and the
+ * parameters of the scan. The reused messages of the block are preallocated for the
+ * expected number of beams, so receiving a scan copies it into memory which is already
+ * there and converting it into the output matrices does not allocate either.
+ * Beams missing in a scan are set to 0, beams beyond the size of an output are ignored.
+ *
+ * @tparam TRangesOutput - type of the ranges output, a vector
+ * @tparam TIntensitiesOutput - type of the intensities output, a vector
+ *
+ * @since v1.0
+ */
+template < typename TRangesOutput, typename TIntensitiesOutput = TRangesOutput >
+class RosSubscriberLaserScan : public RosSubscriber<sensor_msgs::msg::LaserScan, 1, TRangesOutput> {
+  typedef sensor_msgs::msg::LaserScan TRosMsg;
  public:
-  RosSubscriberLaserScan(const std::string& topic, const uint32_t queueSize=1000, const bool callNewest=false ) :
-    RosSubscriber<TRosMsg, double>(topic, queueSize, callNewest){ }
-    
-  void rosCallbackFct(const TRosMsg& msg) {
-    // B-3 Set the timestamp of all EEROS signals
-// 			auto time = eeros::System::getTimeNs();	// use system time for timestamp
-    auto time = msg.header.stamp.toNSec();	// use received timestamp
-    angle_minOutput.getSignal().setTimestamp( time );
-    angle_maxOutput.getSignal().setTimestamp( time );
-    angle_incrementOutput.getSignal().setTimestamp( time );
-    time_incrementOutput.getSignal().setTimestamp( time );
-    scan_timeOutput.getSignal().setTimestamp( time );
-    range_minOutput.getSignal().setTimestamp( time );
-    range_maxOutput.getSignal().setTimestamp( time );
-    
-    // B-4 Cast the data of the ROS message and fill it into the EEROS signals
-    angle_minOutput.getSignal().setValue(		static_cast< double > ( msg.angle_min ) );
-    angle_maxOutput.getSignal().setValue(		static_cast< double > ( msg.angle_max ) );
-    angle_incrementOutput.getSignal().setValue(	static_cast< double > ( msg.angle_increment ) );
-    time_incrementOutput.getSignal().setValue(	static_cast< double > ( msg.time_increment ) );
-    scan_timeOutput.getSignal().setValue(		static_cast< double > ( msg.scan_time ) );
-    range_minOutput.getSignal().setValue(		static_cast< double > ( msg.range_min ) );
-    range_maxOutput.getSignal().setValue(		static_cast< double > ( msg.range_max ) );
-    
-    // C-4 Convert the vector of the ROS message to a <double>-vector
-    std::vector<double> rangesTmp( msg.ranges.begin(), msg.ranges.end() );	//cast because axes is a float32 vector
-    // C-5 Fill the vector into an EEROS matrix
-    rangesValue.setCol(0, rangesTmp);
-    // C-6 Fill the EEROS matrix in a EEROS signal
-    rangesOutput.getSignal().setValue(rangesValue);
-    
-    std::vector<double> intensitiesTmp( msg.intensities.begin(), msg.intensities.end() );	//cast because axes is a float32 vector
-    intensitiesValue.setCol(0, intensitiesTmp);
-    intensitiesOutput.getSignal().setValue(intensitiesValue);
+  /**
+   * Creates an instance of a laser scan subscriber block.
+   *
+   * @param node - ROS node as a shared ptr
+   * @param topic - name of the topic
+   * @param syncWithTopic - when set to true the executor runs all time domains upon receiving this message
+   * @param queueSize - maximum number of incoming messages to be queued for delivery to subscribers
+   * @param beams - expected number of beams of a scan
+   */
+  RosSubscriberLaserScan(const rclcpp::Node::SharedPtr node, const std::string& topic, bool syncWithTopic = false,
+                         const uint32_t queueSize = 1000, const uint32_t beams = TRangesOutput::nofElements)
+      : RosSubscriber<TRosMsg, 1, TRangesOutput>(node, topic, syncWithTopic, queueSize, prototype(beams)),
+        angle_minOutput(this), angle_maxOutput(this), angle_incrementOutput(this), time_incrementOutput(this),
+        scan_timeOutput(this), range_minOutput(this), range_maxOutput(this), intensitiesOutput(this) { }
+
+  /**
+   * Disabling use of copy constructor because the block should never be copied unintentionally.
+   */
+  RosSubscriberLaserScan(const RosSubscriberLaserScan& other) = delete;
+
+  /**
+   * This function is called whenever the run function reads the
+   * next pending ROS message.
+   *
+   * @param msg - message content
+   */
+  void parseMsg(const TRosMsg& msg) override {
+    uint64_t time = RosTools::convertToEerosTime(msg.header.stamp);
+    set(angle_minOutput, msg.angle_min, time);
+    set(angle_maxOutput, msg.angle_max, time);
+    set(angle_incrementOutput, msg.angle_increment, time);
+    set(time_incrementOutput, msg.time_increment, time);
+    set(scan_timeOutput, msg.scan_time, time);
+    set(range_minOutput, msg.range_min, time);
+    set(range_maxOutput, msg.range_max, time);
+    set(this->out, msg.ranges, time);
+    set(intensitiesOutput, msg.intensities, time);
   }
 
-  // B-2 Add a 'getOutput()' function for each output
-  Output<double>& getAngle_minOutput()			{return angle_minOutput; }
-  Output<double>& getAngle_maxOutput()			{return angle_maxOutput; }
-  Output<double>& getAngle_incrementOutput()		{return angle_incrementOutput; }
-  Output<double>& getTime_incrementOutput()		{return time_incrementOutput; }
-  Output<double>& getScan_timeOutput()			{return scan_timeOutput; }
-  Output<double>& getRange_minOutput()			{return range_minOutput; }
-  Output<double>& getRange_maxOutput()			{return range_maxOutput; }
-  // C-3 Add a 'getOutput()' function for each EEROS matrix output
-  Output<TRangesOutput>& getRangesOutput()			{return rangesOutput; }
-  Output<TIntensitiesOutput>& getIntensitiesOutput()	{return intensitiesOutput; }
-  
+  Output<double>& getAngle_minOutput() { return angle_minOutput; }
+  Output<double>& getAngle_maxOutput() { return angle_maxOutput; }
+  Output<double>& getAngle_incrementOutput() { return angle_incrementOutput; }
+  Output<double>& getTime_incrementOutput() { return time_incrementOutput; }
+  Output<double>& getScan_timeOutput() { return scan_timeOutput; }
+  Output<double>& getRange_minOutput() { return range_minOutput; }
+  Output<double>& getRange_maxOutput() { return range_maxOutput; }
+  Output<TRangesOutput>& getRangesOutput() { return this->out; }
+  Output<TIntensitiesOutput>& getIntensitiesOutput() { return intensitiesOutput; }
+
  protected:
-  //TODO Header
-  // B-1 Create EEROS outputs
-  Output<double>		angle_minOutput;
-  Output<double>		angle_maxOutput;
-  Output<double>		angle_incrementOutput;
-  Output<double>		time_incrementOutput;
-  Output<double>		scan_timeOutput;
-  Output<double>		range_minOutput;
-  Output<double>		range_maxOutput;
-  // C-2 Create a 'value' and an 'output' variable for each EEROS matrix output
-  TRangesOutput				rangesValue;
-  Output<TRangesOutput>		rangesOutput;
-  TIntensitiesOutput			intensitiesValue;
-  Output<TIntensitiesOutput>	intensitiesOutput;
+  static TRosMsg prototype(uint32_t beams) {
+    TRosMsg msg;
+    msg.ranges.resize(beams);
+    msg.intensities.resize(beams);
+    return msg;
+  }
+
+  static void set(Output<double>& to, float from, uint64_t time) {
+    to.getSignal().setValue(static_cast<double>(from));
+    to.getSignal().setTimestamp(time);
+  }
+
+  template < typename T >
+  static void set(Output<T>& to, const std::vector<float>& from, uint64_t time) {
+    T value;
+    unsigned int n = std::min<std::size_t>(from.size(), value.size());
+    for (unsigned int i = 0; i < n; i++) value[i] = static_cast<double>(from[i]);
+    for (unsigned int i = n; i < value.size(); i++) value[i] = 0;
+    to.getSignal().setValue(value);
+    to.getSignal().setTimestamp(time);
+  }
+
+  Output<double> angle_minOutput;
+  Output<double> angle_maxOutput;
+  Output<double> angle_incrementOutput;
+  Output<double> time_incrementOutput;
+  Output<double> scan_timeOutput;
+  Output<double> range_minOutput;
+  Output<double> range_maxOutput;
+  Output<TIntensitiesOutput> intensitiesOutput;
 };
 
 /********** Print functions **********/
 template < typename TRangesOutput, typename TIntensitiesOutput >
-std::ostream& operator<<(std::ostream& os, RosSubscriberLaserScan& s) {
+std::ostream& operator<<(std::ostream& os, RosSubscriberLaserScan<TRangesOutput, TIntensitiesOutput>& s) {
   os << "Block RosSubscriberLaserScan: '" << s.getName();
   return os;
 }
+
 }
 }
-
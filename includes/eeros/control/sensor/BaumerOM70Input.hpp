@@ -47,8 +47,20 @@ class BaumerOM70Input: public Blockio<0,1,double> {
    * Gets input data from Baumer OM70 thread and outputs them
    */
   virtual void run() {
-    this->out.getSignal().setValue(om70.getDistance());
-    this->out.getSignal().setTimestamp(eeros::System::getTimeNs());
+    BaumerOM70::Sample s;
+    if (!om70.getSample(s) || s.timestamp == 0) return;
+    this->out.getSignal().setValue(s.distance);
+    this->out.getSignal().setTimestamp(s.timestamp);
+  }
+
+  /**
+   * Reads the sample rate and the transaction latency of the sensor thread
+   *
+   * @param timing - target
+   * @return true, if a consistent copy could be made
+   */
+  bool getTiming(BaumerOM70::Timing& timing) const {
+    return om70.getTiming(timing);
   }
       
  protected:        
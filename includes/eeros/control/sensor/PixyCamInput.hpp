@@ -94,23 +94,35 @@ class PixyCamInput : public Blockio<0,1,Vector3> {
   }
 
   /**
-   * Gets input data from the camera thread and outputs it
+   * Gets the number of failed requests to the camera
+   * 
+   * @return number of errors
+   */
+  virtual uint64_t getErrors() {
+    return p.getErrors();
+  }
+
+  /**
+   * Gets the newest detection from the camera thread and outputs it. 
+   * The timestamps of the outputs are the time of acquisition.
    */
   virtual void run() {
-    out.getSignal().setValue(p.getPos());
-    auto t = eeros::System::getTimeNs();
+    PixyCam::Detection d;
+    if (!p.getDetection(d) || d.frame == 0) return;
+    auto t = d.timestamp;
+    out.getSignal().setValue(d.pos);
     out.getSignal().setTimestamp(t);
   
-    outRaw.getSignal().setValue(p.getPosRaw());
+    outRaw.getSignal().setValue(d.posRaw);
     outRaw.getSignal().setTimestamp(t);
   
-    outDots.getSignal().setValue(p.getDots());
+    outDots.getSignal().setValue(d.dots);
     outDots.getSignal().setTimestamp(t);
   
-    outHeight.getSignal().setValue(p.getHeight());
+    outHeight.getSignal().setValue(d.height);
     outHeight.getSignal().setTimestamp(t);
   
-    outValid.getSignal().setValue(p.isDataValid());
+    outValid.getSignal().setValue(d.valid);
     outValid.getSignal().setTimestamp(t);
   }
 
@@ -40,13 +40,18 @@ class RPLidarInput : public Blockio<0,2,Matrix<LASER_COUNT_MAX,1>> {
    *
    * output[0] = angles
    * output[1] = ranges
-   * output timestamp = system time
+   * output timestamp = time the scan was received
+   *
+   * The outputs are only updated when a new scan was published.
    */
   virtual void run() {
-    this->out[0].getSignal().setValue(rplidar.getAngles());
-    this->out[1].getSignal().setValue(rplidar.getRanges());
-    uint64_t ts = eeros::System::getTimeNs();
-    this->out[0].getSignal().setTimestamp(ts);
+    bool newScan;
+    const eeros::hal::RPLidar::Scan& scan = rplidar.getScan(newScan);
+    if (!newScan) return;
+    this->out[0].getSignal().setValue(scan.angles);
+    this->out[1].getSignal().setValue(scan.ranges);
+    this->out[0].getSignal().setTimestamp(scan.timestamp);
+    this->out[1].getSignal().setTimestamp(scan.timestamp);
   }
     
  private:                     
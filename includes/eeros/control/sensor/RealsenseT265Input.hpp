@@ -16,6 +16,11 @@ namespace control {
 /**
  * This block reads a Realsense T256 camera over USB3.
  *
+ * The camera delivers poses at 200 Hz, independent of the time domain of the
+ * block. With extrapolation enabled, the outputs are predicted from the latest
+ * pose to the time the block runs, using its velocities and accelerations,
+ * see setExtrapolation(). Otherwise they hold the latest pose and its timestamp.
+ *
  * @since v1.3
  */
   
@@ -41,21 +46,66 @@ class RealsenseT265Input : public Blockio<0,0> {
    * Gets input data from Realsense Tracking T265 Thread and outputs them
    */
   virtual void run() {
-    translation.getSignal().setValue(t265.translation);
-    velocity.getSignal().setValue(t265.velocity);
-    acceleration.getSignal().setValue(t265.acceleration);
-    angularVelocity.getSignal().setValue(t265.angVelocity);
-    angularAcceleration.getSignal().setValue(t265.angAcceleration);
-    quaternion.getSignal().setValue(t265.quaternion);
+    eeros::hal::RealsenseT265::Pose p;
+    if (!t265.getPose(p)) return;
+    uint64_t ts = p.timestamp;
+    if (maxAge > 0) {
+      uint64_t now = eeros::System::getTimeNs();
+      double dt = now > p.timestamp ? (now - p.timestamp) * 1e-9 : 0;
+      if (dt > maxAge) dt = maxAge;
+      extrapolate(p, dt);
+      ts = p.timestamp + static_cast<uint64_t>(dt * 1e9);
+    }
+    translation.getSignal().setValue(p.translation);
+    velocity.getSignal().setValue(p.velocity);
+    acceleration.getSignal().setValue(p.acceleration);
+    angularVelocity.getSignal().setValue(p.angVelocity);
+    angularAcceleration.getSignal().setValue(p.angAcceleration);
+    quaternion.getSignal().setValue(p.quaternion);
+    confidence.getSignal().setValue(p.confidence);
       
     // Timestamps
-    uint64_t ts = eeros::System::getTimeNs();
     translation.getSignal().setTimestamp(ts);
     velocity.getSignal().setTimestamp(ts);
     acceleration.getSignal().setTimestamp(ts);
     angularVelocity.getSignal().setTimestamp(ts);
     angularAcceleration.getSignal().setTimestamp(ts);
     quaternion.getSignal().setTimestamp(ts);
+    confidence.getSignal().setTimestamp(p.timestamp);
+  }
+
+  /**
+   * Enables the extrapolation of the pose to the time the block runs.
+   * A pose is extrapolated at most by maxAge, so a stalled camera does
+   * not let the outputs drift away.
+   *
+   * @param maxAge - maximum extrapolation in seconds, 0 disables it
+   */
+  void setExtrapolation(double maxAge = 0.02) {
+    this->maxAge = maxAge;
+  }
+
+  /**
+   * Predicts a pose dt into the future with constant acceleration and
+   * constant angular velocity.
+   *
+   * @param p - pose, extrapolated in place
+   * @param dt - time in seconds
+   */
+  static void extrapolate(eeros::hal::RealsenseT265::Pose& p, double dt) {
+    p.translation = p.translation + p.velocity * dt + p.acceleration * (0.5 * dt * dt);
+    p.velocity = p.velocity + p.acceleration * dt;
+    p.angVelocity = p.angVelocity + p.angAcceleration * dt;
+    // rotate by the angular velocity, given in the reference frame: q = dq * q
+    Vector3 half = p.angVelocity * (0.5 * dt);
+    double w = p.quaternion(0), x = p.quaternion(1), y = p.quaternion(2), z = p.quaternion(3);
+    double dw = 1, dx = half(0), dy = half(1), dz = half(2);
+    Vector4 q;
+    q << dw*w - dx*x - dy*y - dz*z,
+         dw*x + dx*w + dy*z - dz*y,
+         dw*y - dx*z + dy*w + dz*x,
+         dw*z + dx*y - dy*x + dz*w;
+    p.quaternion = q * (1.0 / q.norm());
   }
   
   /**
@@ -111,10 +161,21 @@ class RealsenseT265Input : public Blockio<0,0> {
   virtual Output<Vector4>& getQuaternion(){
     return quaternion;
   }
+
+  /**
+   * Gets the output tracker confidence, 0 failed, 1 low, 2 medium, 3 high
+   * 
+   * @return confidence
+   */
+  virtual Output<unsigned int>& getConfidence(){
+    return confidence;
+  }
   
  private:
   Output<Vector3> translation, velocity, acceleration, angularVelocity, angularAcceleration;
   Output<Vector4> quaternion;
+  Output<unsigned int> confidence;
+  double maxAge = 0;
   eeros::hal::RealsenseT265 t265;
 };
 
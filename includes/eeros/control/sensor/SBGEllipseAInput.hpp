@@ -8,6 +8,7 @@
 #include <eeros/logger/Logger.hpp>
 #include <eeros/math/Matrix.hpp>
 #include <eeros/hal/SBGEllipseA.hpp>
+#include <array>
 
 using namespace eeros::hal;
 using namespace eeros::math;
@@ -19,6 +20,11 @@ namespace control {
 /**
  * This block reads a SBG Ellipse-A IMU sensor over USB and outputs the distance.
  *
+ * The IMU delivers 200 Hz or 1 kHz, faster than most time domains. Each run
+ * collects all IMU samples received since the previous run, see getNofSamples()
+ * and getSample(), e.g. for integration or filtering in a derived block.
+ * The acc and gyro outputs hold the latest of them.
+ *
  * @since v1.3
  */
 
@@ -41,19 +47,44 @@ class SBGEllipseAInput: public Blockio<0,0> {
    * Gets input data from SBGEllipseA thread and outputs them
    */
   virtual void run() {
-    euler.getSignal().setValue(SBGEllipseA::eulerData);
-    quaternion.getSignal().setValue(SBGEllipseA::quatData);
-    acc.getSignal().setValue(SBGEllipseA::accData);
-    gyro.getSignal().setValue(SBGEllipseA::gyroData);
-    timestamp.getSignal().setValue(SBGEllipseA::timestampEuler);
-      
-    // Timestamps
+    nofSamples = 0;
+    while (nofSamples < SBGEllipseA::ringSize && sbg.popImuSample(samples[nofSamples])) nofSamples++;
     uint64_t ts = eeros::System::getTimeNs();
-    euler.getSignal().setTimestamp(ts);
-    quaternion.getSignal().setTimestamp(ts);
-    acc.getSignal().setTimestamp(ts);
-    gyro.getSignal().setTimestamp(ts);
-    timestamp.getSignal().setTimestamp(ts);
+    if (nofSamples > 0) {
+      const SBGEllipseA::ImuSample& last = samples[nofSamples - 1];
+      acc.getSignal().setValue(last.acc);
+      gyro.getSignal().setValue(last.gyro);
+      acc.getSignal().setTimestamp(last.timestamp);
+      gyro.getSignal().setTimestamp(last.timestamp);
+    }
+    SBGEllipseA::Ekf ekf;
+    if (sbg.getEkf(ekf)) {
+      euler.getSignal().setValue(ekf.euler);
+      quaternion.getSignal().setValue(ekf.quaternion);
+      timestamp.getSignal().setValue(ekf.timestampEuler);
+      euler.getSignal().setTimestamp(ts);
+      quaternion.getSignal().setTimestamp(ts);
+      timestamp.getSignal().setTimestamp(ts);
+    }
+  }
+
+  /**
+   * Gets the number of IMU samples received between the previous and the last run
+   *
+   * @return number of samples
+   */
+  int getNofSamples() const {
+    return nofSamples;
+  }
+
+  /**
+   * Gets an IMU sample received between the previous and the last run, the oldest first
+   *
+   * @param i - index of the sample, below getNofSamples()
+   * @return sample with its device timestamp
+   */
+  const SBGEllipseA::ImuSample& getSample(int i) const {
+    return samples[i];
   }
   
   /**
@@ -108,6 +139,8 @@ class SBGEllipseAInput: public Blockio<0,0> {
   
   SBGEllipseA sbg;
   Logger log;
+  std::array<SBGEllipseA::ImuSample, SBGEllipseA::ringSize> samples;
+  int nofSamples = 0;
 };
 
 /**
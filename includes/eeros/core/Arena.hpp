@@ -0,0 +1,124 @@
+#ifndef ORG_EEROS_CORE_ARENA_HPP_
+#define ORG_EEROS_CORE_ARENA_HPP_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace eeros {
+
+/**
+ * Allocates objects one after the other in large chunks of memory, e.g. the
+ * blocks of a timedomain in the order they are run, see TimeDomain::createBlock().
+ * Objects created together then share cache lines instead of being spread over
+ * the heap, and allocating them costs a pointer increment after the first chunk
+ * has been allocated. Memory is only released when the arena is destroyed, which
+ * destroys the objects in the reverse order of their creation.
+ *
+ * The arena is not thread safe, objects are meant to be created during startup.
+ *
+ * @since v1.4.4
+ */
+class Arena {
+ public:
+  static constexpr std::size_t defaultChunkSize = 64 * 1024;
+  static constexpr std::size_t chunkAlignment = 64;
+
+  /**
+   * Constructs an arena. No memory is allocated until the first object is created.
+   *
+   * @param chunkSize - size of a chunk in bytes, larger objects get a chunk of their own
+   */
+  explicit Arena(std::size_t chunkSize = defaultChunkSize);
+
+  /**
+   * Destroys all objects created in the arena in reverse order and frees the memory.
+   */
+  ~Arena();
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  /**
+   * Allocates uninitialized memory in the current chunk, or in a new one if it is full.
+   *
+   * @param size - bytes to allocate
+   * @param align - alignment, a power of 2 not larger than chunkAlignment
+   * @return memory
+   */
+  void* allocate(std::size_t size, std::size_t align = alignof(std::max_align_t));
+
+  /**
+   * Makes sure that the next size bytes are allocated from one chunk, so that
+   * objects created afterwards are contiguous, and allocates that chunk now.
+   *
+   * @param size - bytes
+   */
+  void reserve(std::size_t size);
+
+  /**
+   * Constructs an object in the arena. Its destructor is run when the arena is destroyed.
+   *
+   * @param args - constructor arguments
+   * @return object
+   */
+  template < typename T, typename... Args >
+  T& create(Args&&... args) {
+    if constexpr (!std::is_trivially_destructible_v<T>) destructors.reserve(destructors.size() + 1);
+    T* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      destructors.push_back({[](void* p) { static_cast<T*>(p)->~T(); }, object});
+    }
+    return *object;
+  }
+
+  /**
+   * Constructs a value initialized array in the arena, e.g. a buffer.
+   *
+   * @param n - number of elements
+   * @return first element
+   */
+  template < typename T >
+  T* createArray(std::size_t n) {
+    static_assert(std::is_trivially_destructible_v<T>, "arena arrays need a trivially destructible element type");
+    T* array = static_cast<T*>(allocate(sizeof(T) * n, alignof(T)));
+    for (std::size_t i = 0; i < n; i++) new (array + i) T();
+    return array;
+  }
+
+  /**
+   * @return bytes allocated by objects, including padding
+   */
+  std::size_t getUsed() const;
+
+  /**
+   * @return bytes of all chunks
+   */
+  std::size_t getCapacity() const;
+
+ private:
+  struct Chunk {
+    char* data;
+    std::size_t size;
+  };
+
+  struct Destructor {
+    void (*destroy)(void*);
+    void* object;
+  };
+
+  void addChunk(std::size_t size);
+
+  std::size_t chunkSize;
+  std::vector<Chunk> chunks;
+  std::vector<Destructor> destructors;
+  char* next = nullptr;
+  char* end = nullptr;
+  std::size_t used = 0;
+};
+
+}
+
+#endif /* ORG_EEROS_CORE_ARENA_HPP_ */
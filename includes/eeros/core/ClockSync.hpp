@@ -0,0 +1,74 @@
+#ifndef ORG_EEROS_CORE_CLOCKSYNC_HPP_
+#define ORG_EEROS_CORE_CLOCKSYNC_HPP_
+
+#include <cstdint>
+
+namespace eeros {
+
+/**
+ * Tracks a periodic reference clock, e.g. the distributed clock of an EtherCAT
+ * bus, in the host time base. It is fed with the host time of each reference
+ * event and predicts the next one with a PI controlled phase locked loop:
+ * the proportional part corrects the phase, the integral part learns the
+ * drift between the two clocks.
+ *
+ * An event which deviates by more than half a period from the prediction,
+ * e.g. after a missed cycle, restarts the phase without changing the drift.
+ *
+ * @since v1.4.4
+ */
+class ClockSync {
+ public:
+  /**
+   * @param period - nominal period of the reference clock in ns
+   * @param kp - proportional gain on the phase error
+   * @param ki - integral gain on the phase error
+   */
+  ClockSync(int64_t period, double kp = 0.05, double ki = 0.001);
+
+  /**
+   * Feeds the host time of a reference event.
+   *
+   * @param time - host time of the event in ns
+   */
+  void update(int64_t time);
+
+  /**
+   * @return predicted host time of the next reference event in ns
+   */
+  int64_t predict() const { return next; }
+
+  /**
+   * @return period of the reference clock measured in host time, in ns
+   */
+  double getPeriod() const { return period; }
+
+  /**
+   * @return relative drift of the reference clock against the host clock, e.g. 1e-6 for 1 ppm
+   */
+  double getDrift() const { return period / nominal - 1.0; }
+
+  /**
+   * @return phase error of the last event against its prediction in ns
+   */
+  int64_t getOffset() const { return offset; }
+
+  /**
+   * @return number of events which restarted the phase
+   */
+  uint64_t getResyncs() const { return resyncs; }
+
+ private:
+  double nominal;
+  double period;
+  double kp;
+  double ki;
+  int64_t next = 0;
+  int64_t offset = 0;
+  uint64_t resyncs = 0;
+  bool locked = false;
+};
+
+}
+
+#endif // ORG_EEROS_CORE_CLOCKSYNC_HPP_
@@ -0,0 +1,109 @@
+#ifndef ORG_EEROS_CORE_CPUPOWER_HPP_
+#define ORG_EEROS_CORE_CPUPOWER_HPP_
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include <eeros/logger/Logger.hpp>
+
+namespace eeros {
+
+/**
+ * Holds power management settings which lower the wakeup latency of realtime
+ * threads, and restores the previous settings when it is released.
+ *
+ * - A PM QoS latency request: /dev/cpu_dma_latency is kept open with a target
+ *   latency, which keeps the cores out of C-states with a longer exit latency.
+ *   The kernel drops the request as soon as the file is closed.
+ * - The cpufreq governor of a set of cores, e.g. "performance".
+ * - A fixed frequency of a set of cores, by setting the minimum and the maximum
+ *   scaling frequency to the same value.
+ *
+ * All settings need root privileges. A setting which fails is reported, the
+ * others are applied anyway. Used by the executor, see Executor::setCpuLatency().
+ *
+ * @since v1.4.4
+ */
+class CpuPower {
+ public:
+  /**
+   * Constructs a power control without any setting applied.
+   *
+   * @param sysfsPath - directory of the cpu devices
+   * @param latencyPath - PM QoS device of the cpu latency
+   */
+  CpuPower(std::string sysfsPath = "/sys/devices/system/cpu", std::string latencyPath = "/dev/cpu_dma_latency");
+  ~CpuPower();
+
+  CpuPower(const CpuPower&) = delete;
+  CpuPower& operator=(const CpuPower&) = delete;
+
+  /**
+   * Requests a maximum wakeup latency for all cores until release().
+   *
+   * @param us - target latency in us, 0 disables all C-states but the shallowest
+   * @return true, if the request is active
+   */
+  bool requestLatency(int32_t us);
+
+  /**
+   * Gets the latency which is in effect, i.e. the minimum of all requests.
+   *
+   * @return latency in us, -1 if it cannot be read
+   */
+  int32_t getLatency() const;
+
+  /**
+   * Sets the cpufreq governor of a set of cores until release().
+   *
+   * @param cpus - indices of the cores
+   * @param governor - governor, e.g. "performance"
+   * @return true, if all cores use the governor
+   */
+  bool setGovernor(const std::vector<int>& cpus, std::string governor);
+
+  /**
+   * Fixes the frequency of a set of cores until release().
+   *
+   * @param cpus - indices of the cores
+   * @param khz - frequency in kHz
+   * @return true, if the frequency could be fixed on all cores
+   */
+  bool setFrequency(const std::vector<int>& cpus, uint32_t khz);
+
+  /**
+   * Reads a cpufreq attribute of a core, e.g. to report the obtained settings.
+   *
+   * @param cpu - index of the core
+   * @param attribute - attribute, e.g. "scaling_governor" or "scaling_cur_freq"
+   * @return value, empty if it cannot be read
+   */
+  std::string read(int cpu, std::string attribute) const;
+
+  /**
+   * Logs the latency in effect and the governor and frequency range of a set of cores.
+   *
+   * @param log - logger
+   * @param cpus - indices of the cores
+   */
+  void report(logger::Logger& log, const std::vector<int>& cpus) const;
+
+  /**
+   * Drops the latency request and restores the governors and frequencies.
+   */
+  void release();
+
+ private:
+  std::string path(int cpu, std::string attribute) const;
+  bool write(int cpu, std::string attribute, std::string value);
+
+  std::string sysfsPath;
+  std::string latencyPath;
+  int latencyFd;
+  std::vector<std::pair<std::string, std::string>> saved;   // file and previous value, restored in reverse order
+};
+
+}
+
+#endif // ORG_EEROS_CORE_CPUPOWER_HPP_
@@ -1,12 +1,23 @@
 #ifndef ORG_EEROS_CORE_EXECUTOR_HPP_
 #define ORG_EEROS_CORE_EXECUTOR_HPP_
 
+#include <atomic>
+#include <cstdint>
 #include <vector>
+#include <memory>
 #include <condition_variable>
 
 #include <eeros/core/Runnable.hpp>
+#include <eeros/core/ClockSync.hpp>
+#include <eeros/core/CpuPower.hpp>
+#include <eeros/core/ExternalClock.hpp>
 #include <eeros/core/PeriodicCounter.hpp>
+#include <eeros/core/TaskTrace.hpp>
+#include <eeros/core/TimingExport.hpp>
 #include <eeros/task/Periodic.hpp>
+#include <eeros/task/OverrunHandler.hpp>
+#include <eeros/task/HarmonicTaskList.hpp>
+#include <eeros/task/Schedulability.hpp>
 #include <eeros/logger/Logger.hpp>
 
 #ifdef USE_ETHERCAT
@@ -15,6 +26,7 @@
 
 #ifdef USE_ROS
 #include <ros/ros.h>
+#include <ros/callback_queue.h>
 #endif
 
 #ifdef USE_ROS2
@@ -26,6 +38,7 @@ namespace eeros {
 
 namespace control {
   class TimeDomain;
+  class TimeDomainGroup;
 }
 
 namespace safety {
@@ -39,10 +52,42 @@ namespace safety {
  * If the main task is not set, the executor will create a default main task with 
  * a chosen period.
  *
+ * Usually the single instance returned by instance() is used. To run independent
+ * machines from one process, further executors can be constructed, each with its own
+ * main task, base period, priority band (setPriorityOffset()), cores and periodics.
+ * Each runs in its own thread and only one of them should update the HAL, see setHalUpdate().
+ *
  * @since v0.6
  */
 class Executor : public Runnable {
  public:
+  /**
+   * Timing backend used by the executor main loop when it is not synched
+   * to an external time source such as EtherCAT or ROS.
+   *
+   * - steadyClock: std::this_thread::sleep_until on the steady clock
+   * - absoluteNanosleep: clock_nanosleep with an absolute deadline in integer nanoseconds
+   * - timerfd: periodic timerfd, missed expirations are counted as overruns
+   * - hybridSpin: absolute clock_nanosleep until a margin before the deadline, then busy wait;
+   *   use this only on isolated cores where burning CPU time is acceptable
+   * - lockstep: no timing at all, a simulator advances the executor with step(), see there
+   */
+  enum class TimingMode { steadyClock, absoluteNanosleep, timerfd, hybridSpin, lockstep };
+
+  /**
+   * Reaction of the executor to a realtime task set which is not schedulable,
+   * see setSchedulabilityCheck().
+   *
+   * - off: no analysis (default)
+   * - warn: the analysis is logged, unschedulable periodics on level ERROR
+   * - enforce: like warn, additionally the executor refuses to start, or stops after calibration
+   */
+  enum class SchedulabilityCheck { off, warn, enforce };
+
+  /**
+   * Constructs a further executor, in addition to the one returned by instance().
+   */
+  Executor();
   virtual ~Executor();
 
   /**
@@ -50,9 +95,16 @@ class Executor : public Runnable {
    */
   static Executor& instance();
 
+  /**
+   * Gets the executor which runs the calling thread, i.e. the executor itself or one
+   * of its harmonic threads. Blocks use it to get the cycle of their own executor.
+   *
+   * @return executor of the calling thread, instance() on any other thread
+   */
+  static Executor& current();
 
   /**
-   * Copy and assignemt for a singleton is disabled
+   * Copy and assignemt for an executor is disabled
    */
   Executor(Executor const&) = delete;
   void operator=(Executor const&) = delete;
@@ -80,6 +132,68 @@ class Executor : public Runnable {
    */
   void setExecutorPeriod(double period);
 
+  /**
+   * Selects the timing backend of the main loop. Has to be called before 
+   * the executor is started. Default is TimingMode::steadyClock.
+   * 
+   * @param mode - timing backend
+   */
+  void setTimingMode(TimingMode mode);
+
+  /**
+   * Gets the timing backend of the main loop.
+   * 
+   * @return timing mode
+   */
+  TimingMode getTimingMode();
+
+  /**
+   * Advances the executor by a number of cycles in TimingMode::lockstep and waits
+   * until they have run. This is called by a simulator, e.g. once per simulation step.
+   * The cycles run back to back without sleeping, so a closed loop simulation runs as
+   * fast as the computation allows.
+   *
+   * In lockstep all periodics run in the executor thread instead of their own threads,
+   * in the same order and with the same harmonic ratios. Each cycle is a cycle of the
+   * executor thread (see System::beginCycle(uint64_t)) with a simulated time, which starts
+   * at one period and advances by one period per cycle, so all blocks using
+   * System::getTimeNs() see the nominal period.
+   *
+   * Cycles requested before the executor is started run as soon as it is.
+   *
+   * @param cycles - number of cycles
+   * @return false, if the executor was stopped before all cycles have run
+   */
+  bool step(uint64_t cycles = 1);
+
+  /**
+   * Sets the margin before the deadline at which the executor stops sleeping and
+   * starts busy waiting in TimingMode::hybridSpin. With auto tuning enabled, the margin
+   * is adapted every 1000 cycles to 1.5 times the worst wakeup latency observed 
+   * in the sleep phase, limited to half the period.
+   * 
+   * @param margin - initial spin margin in sec (default 50 us)
+   * @param autoTune - if true, the margin is tuned from the observed wakeup latency
+   */
+  void setSpinMargin(double margin, bool autoTune = true);
+
+  /**
+   * Analyzes whether the realtime periodics and the executor main loop meet their
+   * periods with the rate monotonic priorities assigned upon starting, see
+   * \ref task::Schedulability. The report lists the utilization per core and the worst
+   * case response time of each periodic.
+   *
+   * Without calibration, the analysis runs before any thread is started and uses the
+   * execution times set with task::Periodic::setWcet(). With calibration, the executor
+   * first runs the given number of cycles and then uses the longest measured run of each
+   * periodic, or its set execution time if that is longer. Has to be called before the
+   * executor is started, it has no effect in TimingMode::lockstep.
+   *
+   * @param check - reaction to an unschedulable task set
+   * @param calibrationCycles - executor cycles to measure the run times, 0 to use the set ones
+   */
+  void setSchedulabilityCheck(SchedulabilityCheck check, uint64_t calibrationCycles = 0);
+
   /**
    * Get the main task.
    * 
@@ -103,11 +217,39 @@ class Executor : public Runnable {
    * @param timedomain - timedomain
    */
   void add(control::TimeDomain &timedomain);
+
+  /**
+   * An instance of the class \ref task::Periodic will be created which in turn is 
+   * added to the executor. The executor will periodically execute the runnable
+   * of the periodic, which is the timedomain group running its timedomains in parallel.
+   * 
+   * @param group - timedomain group
+   */
+  void add(control::TimeDomainGroup &group);
   
+  /**
+   * Default number of bytes of the stack prefaulted by prefault_stack().
+   */
+  static constexpr std::size_t defaultStackPrefault = 64 * 1024;
+
   /*
-   * Allocates memory chunck on the stack. Used for later locking.
+   * Allocates memory chunck on the stack and touches each of its pages,
+   * so they are mapped before the memory is locked.
+   *
+   * @param size - bytes to prefault, has to be smaller than the stack
+   */
+  static void prefault_stack(std::size_t size = defaultStackPrefault);
+
+  /**
+   * Allocates and touches a block of heap memory and keeps it in the allocator
+   * after freeing it: trimming and mmap allocations are turned off and a single
+   * arena is used. Allocations of realtime threads are then served from already
+   * mapped pages and the memory is not given back to the kernel.
+   *
+   * @param size - bytes to reserve
+   * @return true, if successful
    */
-  static void prefault_stack();
+  static bool reserve_heap(std::size_t size);
 
   /*
    * Locks all pages associated with the current process, which
@@ -122,16 +264,186 @@ class Executor : public Runnable {
    */
   static bool set_priority(int nice);
 
+  /**
+   * Pins the calling thread to a set of CPU cores.
+   *
+   * @param cpus - indices of the cores the thread may run on
+   * @return true, if the affinity could be set
+   */
+  static bool set_affinity(const std::vector<int> &cpus);
+
+  /**
+   * Switches the calling thread to SCHED_DEADLINE.
+   *
+   * @param runtime - runtime budget per period in sec
+   * @param deadline - relative deadline in sec
+   * @param period - period in sec
+   * @return true, if the policy could be set, otherwise errno tells why
+   */
+  static bool set_deadline(double runtime, double deadline, double period);
+
+  /**
+   * Pins the executor main loop to a set of CPU cores. 
+   * Has to be called before the executor is started.
+   *
+   * @param cpus - indices of the cores the main loop may run on
+   */
+  void setAffinity(std::vector<int> cpus);
+
+  /**
+   * Sets the maximum time the executor waits for all harmonic threads to 
+   * become ready upon starting. Default is 5 sec.
+   *
+   * @param timeout - startup timeout in sec
+   */
+  void setStartupTimeout(double timeout);
+
+  /**
+   * Sets how many bytes of its stack the executor prefaults before locking
+   * memory. Harmonic threads with a stack size set prefault their whole stack,
+   * see task::Periodic::setStackSize(). Default is defaultStackPrefault.
+   *
+   * @param size - bytes to prefault
+   */
+  void setStackPrefault(std::size_t size);
+
+  /**
+   * Reserves heap memory before locking memory, see reserve_heap().
+   * Default is 0, no reservation.
+   *
+   * @param size - bytes to reserve
+   */
+  void setHeapReserve(std::size_t size);
+
+  /**
+   * Publishes the statistics of the executor counter and of all harmonic thread 
+   * counters into a shared memory region. The region is created upon starting
+   * the executor, record 0 belongs to the executor. The statistics can then be 
+   * read with TimingExport::open() and TimingExport::read() by an external tool.
+   *
+   * @param path - name of the shared memory object, e.g. "/eeros_timing"
+   */
+  void setTimingExport(std::string path);
+
+  /**
+   * Samples context switches, page faults and migrations of the executor and of all
+   * harmonic threads every given number of cycles, see PeriodicCounter::setOsSampling().
+   * Has to be called before the executor is started.
+   *
+   * @param cycles - sampling interval in cycles, 0 disables the sampling (default)
+   */
+  void setOsCounters(unsigned cycles);
+
+  /**
+   * Records a timeline of the executor, the harmonic threads and the time domains
+   * while the executor runs and writes it as Chrome trace JSON, see \ref TaskTrace.
+   * The file can be opened with Perfetto or chrome://tracing.
+   *
+   * @param file - name of the trace file, e.g. "trace.json"
+   */
+  void setTaskTrace(std::string file);
+
+  /**
+   * If enabled, periodics without an explicitly set phase are spread over the 
+   * cycles of their base task instead of all being released in the same cycle.
+   * Has to be called before the executor is started.
+   *
+   * @param enable - true to distribute the phases automatically
+   * @see task::Periodic::setPhase()
+   */
+  void setPhaseDistribution(bool enable);
+
+  /**
+   * Runs all non realtime periodics on a small work-stealing thread pool instead
+   * of a thread per periodic. Realtime periodics keep their own threads. The timing
+   * of pooled periodics is tracked as before, a run which is still queued or running
+   * when the periodic is released again is skipped and counted as overrun.
+   * Has to be called before the executor is started.
+   *
+   * @param threads - number of pool threads, 0 disables the pool
+   * @param cpus - cores the pool threads may run on, all cores if empty
+   */
+  void setWorkerPool(int threads, std::vector<int> cpus = {});
+
+  /**
+   * Holds a PM QoS request for a maximum wakeup latency of all cores while the executor
+   * runs, which keeps the cores out of deep C-states. See \ref CpuPower.
+   *
+   * @param us - target latency in us, -1 for no request (default)
+   */
+  void setCpuLatency(int32_t us);
+
+  /**
+   * Sets the cpufreq governor, e.g. "performance", of the cores running the executor and
+   * its realtime periodics while the executor runs. If neither is pinned, all cores are set.
+   *
+   * @param governor - governor, empty to keep the governor (default)
+   */
+  void setCpuGovernor(std::string governor);
+
+  /**
+   * Fixes the frequency of the cores running the executor and its realtime periodics
+   * while the executor runs, see setCpuGovernor() for the cores.
+   *
+   * @param khz - frequency in kHz, 0 to keep the frequency (default)
+   */
+  void setCpuFrequency(uint32_t khz);
+
+  /**
+   * Lowers the realtime priorities of the executor and of all its periodics by an offset,
+   * so several executors get separate priority bands. The executor runs with
+   * basePriority - offset, its periodics below. Has to be called before the executor is started.
+   *
+   * @param offset - priority offset, 0 by default
+   */
+  void setPriorityOffset(int offset);
+
+  /**
+   * Selects whether the executor updates the inputs and commits the outputs of the HAL
+   * in each cycle. With several executors only one of them should update the HAL.
+   * Default is true.
+   *
+   * @param enable - true to update the HAL
+   */
+  void setHalUpdate(bool enable);
+
+  /**
+   * Selects whether the critical inputs of the safety system are checked at the start
+   * of each base cycle, before any periodic runs, see SafetySystem::checkCriticalInputs().
+   * The reaction to an emergency stop then takes at most one base period, independent
+   * of the period of the safety system. The safety system is the main task or the
+   * first periodic running one. If the executor does not update the HAL, the batches
+   * of the critical inputs are read by the check itself. Default is true.
+   *
+   * @param enable - true to check the critical inputs in each base cycle
+   */
+  void setCriticalInputFastPath(bool enable);
+
+  /**
+   * Gets the time at which the current cycle of the main loop started, i.e. when the
+   * executor woke up or, synched to EtherCAT, when the stack released the cycle.
+   * Blocks which read a process image stamp all their signals with it instead of
+   * reading the clock for each signal.
+   *
+   * @return start of the current cycle in ns, in the time base of System::getTimeNs()
+   */
+  uint64_t getCycleTimestamp() const { return cycleTimestamp.load(std::memory_order_relaxed); }
+
   /**
    * Starts the executor.
    */
   virtual void run();
 
   /**
-   * Stops the executor.
+   * Stops all executors.
    */
   static void stop();
 
+  /**
+   * Stops this executor only.
+   */
+  void shutdown();
+
   static constexpr int basePriority = 49;
   PeriodicCounter counter;
 
@@ -142,22 +454,88 @@ class Executor : public Runnable {
    * @param etherCATStack - reference to the EtherCAT stack
    */
   void syncWithEtherCATSTack(ecmasterlib::EcMasterlibMain* etherCATStack);
+
+  /**
+   * Shifts the computation of each cycle towards the next EtherCAT frame. The executor
+   * tracks the bus cycle with a \ref ClockSync fed by the returns of the stack's sync().
+   * With a lead > 0 it waits after sync() until the computation, estimated from the
+   * longest recent cycle, ends lead before the predicted next frame. The inputs are then
+   * as fresh as possible when the outputs go out. With a lead of 0 (default), the cycle
+   * starts immediately after sync().
+   *
+   * @param lead - time in sec between the end of the computation and the next frame
+   */
+  void setEtherCATLead(double lead);
+
+  /**
+   * Gets the bus cycle as tracked in host time, e.g. to monitor the drift between
+   * the host clock and the distributed clock.
+   *
+   * @return clock sync of the EtherCAT loop
+   */
+  const ClockSync& getEtherCATClock() const;
 #endif
 #if defined USE_ROS || defined USE_ROS2
   /**
    * Caused the executor to fetch its time base from ROS time.
    * Further, all blocks using the system time base will also switch.
+   * The executor subscribes to /clock and sleeps until the published time
+   * reaches the next cycle, see getRosClock().
    * Do not use this together with EtherCAT.
    */
   void syncWithRosTime();
+
+  /**
+   * Gets the time published on /clock, which wakes the executor when it is synchronized
+   * to ROS time or to gazebo. Its latency histogram holds the delay between the arrival
+   * of a clock message and the wake up of the executor, i.e. the latency added to each
+   * simulation step.
+   *
+   * @return clock of the simulation
+   */
+  const ExternalClock& getRosClock() const;
+#endif
+#ifdef USE_ROS2
+  /**
+   * Like syncWithRosTime() but subscribes to /clock on the given node
+   * instead of an own node.
+   *
+   * @param node - ROS node as a shared ptr
+   */
+  void syncWithRosTime(rclcpp::Node::SharedPtr node);
 #endif
 #ifdef USE_ROS
   void syncWithRosTopic(ros::CallbackQueue* syncRosCallbackQueue);
   ros::CallbackQueue* syncRosCallbackQueue;
 #endif
 #ifdef USE_ROS2
+  /**
+   * ROS executor which handles the callbacks of the registered subscribers.
+   *
+   * - multiThreaded: rclcpp::executors::MultiThreadedExecutor, callbacks of different subscribers run concurrently (default)
+   * - singleThreaded: rclcpp::executors::SingleThreadedExecutor
+   * - staticSingleThreaded: rclcpp::executors::StaticSingleThreadedExecutor, does not rebuild its wait set on every wakeup
+   * - events: rclcpp::experimental::executors::EventsExecutor, wakes up once per message instead of
+   *   waiting on all entities, falls back to staticSingleThreaded if rclcpp does not provide it
+   */
+  enum class RosExecutor { multiThreaded, singleThreaded, staticSingleThreaded, events };
+
+  /**
+   * Selects the ROS executor which handles the subscriptions, its number of threads and
+   * the cores it runs on, e.g. the housekeeping cores. Its threads always run with the
+   * normal scheduling policy, they do not inherit the realtime priority of the executor.
+   * Has to be called before the first subscriber is registered.
+   *
+   * @param type - ROS executor
+   * @param threads - number of threads of a multithreaded executor, 0 for one per core
+   * @param cpus - cores the threads may run on, all cores if empty
+   */
+  void setRosExecutor(RosExecutor type, std::size_t threads = 0, std::vector<int> cpus = {});
+
   /**
    * Called by a ROS subscriber, registers a subscriber.
+   * Every subscriber gets its own mutually exclusive callback group, so the
+   * callbacks of one subscriber never run concurrently.
    * Do not use this together with EtherCAT.
    *
    * @param node - ROS node as a shared ptr
@@ -171,25 +549,83 @@ class Executor : public Runnable {
 #endif
 
  private:
-  Executor();
   void assignPriorities();
+  void runSteadyClock(task::HarmonicTaskList &taskList, Runnable *mainTask);
+  void runAbsoluteNanosleep(task::HarmonicTaskList &taskList, Runnable *mainTask);
+  void runTimerfd(task::HarmonicTaskList &taskList, Runnable *mainTask);
+  void runHybridSpin(task::HarmonicTaskList &taskList, Runnable *mainTask);
+  void runLockstep(task::HarmonicTaskList &taskList, Runnable *mainTask);
+  void startCycle();
+  bool checkSchedulability();
+  void applyCpuPower();
+#if defined USE_ROS || defined USE_ROS2
+  void subscribeRosClock();
+#endif
   double period;
+  TimingMode timingMode;
+  double spinMargin;
+  bool spinAutoTune;
+  std::vector<int> cpus;
+  double startupTimeout;
+  std::size_t stackPrefault = defaultStackPrefault;
+  std::size_t heapReserve = 0;
+  task::OverrunHandler overrun;
+  std::string timingExportPath;
+  bool distributePhases;
+  int priorityOffset = 0;
+  bool updateHal = true;
+  bool criticalFastPath = true;
+  safety::SafetySystem* criticalSafetySystem = nullptr;   // safety system checked in each cycle, if any
+  int32_t cpuLatency = -1;
+  std::string cpuGovernor;
+  uint32_t cpuFrequency = 0;
+  unsigned osCounters = 0;
+  CpuPower cpuPower;
+  SchedulabilityCheck schedulabilityCheck = SchedulabilityCheck::off;
+  uint64_t calibrationCycles = 0;
+  uint64_t cycleCount = 0;
+  std::vector<std::pair<task::Periodic*, PeriodicCounter*>> scheduled;   // realtime periodics and their counters
+  int poolThreads = 0;
+  std::vector<int> poolCpus;
+  std::unique_ptr<TimingExport> timingExport;
+  std::string taskTracePath;
+  std::unique_ptr<TaskTrace> taskTrace;
   task::Periodic* mainTask;
   std::vector<task::Periodic> tasks;
   bool syncWithEtherCatStackSet;
   bool syncWithRosTimeSet;
   bool syncWithRosTopicSet;
   bool running = true;
+  std::atomic<uint64_t> cycleTimestamp{0};
+  std::mutex stepMutex;
+  std::condition_variable stepCv;
+  uint64_t stepsRequested = 0;
+  uint64_t stepsDone = 0;
   logger::Logger log;
+#if defined USE_ROS || defined USE_ROS2
+  ExternalClock rosClock;
+#endif
+#ifdef USE_ROS
+  ros::CallbackQueue clockQueue;
+  std::unique_ptr<ros::AsyncSpinner> clockSpinner;
+  ros::Subscriber clockSubscriber;
+#endif
 #ifdef USE_ROS2
+  rclcpp::Node::SharedPtr clockNode;
+  rclcpp::SubscriptionBase::SharedPtr clockSubscription;
   rclcpp::Executor::SharedPtr subscriberExecutor;
+  RosExecutor rosExecutorType = RosExecutor::multiThreaded;
+  std::size_t rosExecutorThreads = 0;
+  std::vector<int> rosExecutorCpus;
   std::shared_ptr<std::thread> subscriberThread;
   std::condition_variable cv;
   std::mutex cv_m;
   int count;
 #endif
 #ifdef USE_ETHERCAT
-  ecmasterlib::EcMasterlibMain* etherCATStack;
+  ecmasterlib::EcMasterlibMain* etherCATStack = nullptr;
+  int64_t etherCATLead = 0;
+  ClockSync etherCATClock{0};
 #endif
 };
 
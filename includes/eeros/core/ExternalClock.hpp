@@ -0,0 +1,79 @@
+#ifndef ORG_EEROS_CORE_EXTERNALCLOCK_HPP_
+#define ORG_EEROS_CORE_EXTERNALCLOCK_HPP_
+
+#include <eeros/core/Histogram.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace eeros {
+
+/**
+ * Time published by another process, e.g. the simulation time a simulator
+ * publishes on the ROS topic /clock. The subscription callback feeds every
+ * published time with update(), which wakes the threads waiting for it, so a
+ * thread synchronized to the simulation sleeps instead of polling the time.
+ *
+ * The delay between an update and the wake up of the thread waiting for it,
+ * i.e. the latency added to every simulation step, is recorded in a histogram.
+ *
+ * @since v1.4.4
+ */
+class ExternalClock {
+ public:
+  /**
+   * Sets the latest published time and wakes all waiting threads.
+   * Called by the subscription callback.
+   *
+   * @param timeNs - published time in nsec
+   */
+  void update(uint64_t timeNs);
+
+  /**
+   * @return latest published time in nsec, 0 if nothing was published yet
+   */
+  uint64_t getTimeNs() const;
+
+  /**
+   * Waits until the published time reaches the given time.
+   *
+   * @param timeNs - time in nsec
+   * @param timeout - maximum time to wait in sec, negative to wait forever
+   * @return false, if the clock was stopped or the timeout expired
+   */
+  bool waitUntil(uint64_t timeNs, double timeout = -1);
+
+  /**
+   * Waits until a time different from the given one is published,
+   * which also covers a simulation being reset to an earlier time.
+   *
+   * @param timeNs - time in nsec
+   * @param timeout - maximum time to wait in sec, negative to wait forever
+   * @return false, if the clock was stopped or the timeout expired
+   */
+  bool waitForChange(uint64_t timeNs, double timeout = -1);
+
+  /**
+   * Releases all waiting threads, waiting returns false from now on.
+   */
+  void stop();
+
+  /**
+   * @return delays between an update and the wake up of the thread waiting for it
+   */
+  const Histogram& getLatency() const;
+
+ private:
+  template < typename Ready > bool wait(Ready ready, double timeout);
+
+  mutable std::mutex mtx;
+  std::condition_variable cv;
+  uint64_t time = 0;
+  uint64_t updated = 0;   // monotonic time of the latest update in nsec
+  bool stopped = false;
+  Histogram latency;      // written by the waiting thread only
+};
+
+}
+
+#endif /* ORG_EEROS_CORE_EXTERNALCLOCK_HPP_ */
@@ -1,12 +1,30 @@
 #ifndef ORG_EEROS_CORE_FAULT_HPP
 #define ORG_EEROS_CORE_FAULT_HPP
 
+#include <cstdint>
 #include <string>
 #include <sstream>
 #include <exception>
 
 namespace eeros {
 
+/**
+ * Static descriptor of a fault. It can be reported on realtime paths without
+ * allocation, see FaultRegister.
+ */
+struct FaultCode {
+  uint32_t code;
+  const char* message;
+};
+
+/**
+ * Descriptors of the faults reported by EEROS itself.
+ */
+namespace faults {
+  constexpr FaultCode clock{1, "Failed to get time!"};
+  constexpr FaultCode matrixIndex{2, "Matrix index out of bound"};
+}
+
 /**
  * Base class for EEROS faults. 
  */
@@ -24,6 +42,13 @@ class Fault : public std::exception {
    * @param m - name of the fault
    */
   explicit Fault(std::string m);
+
+  /**
+   * Constructor for a fault from a static descriptor.
+   * 
+   * @param f - descriptor of the fault
+   */
+  explicit Fault(const FaultCode& f);
   
   /**
    * Default constructor for a fault.
@@ -35,8 +60,53 @@ class Fault : public std::exception {
    */
   virtual const char* what() const throw();
 
+  /**
+   * Returns the code of the fault, 0 if the fault was not created from a descriptor.
+   * 
+   * @return code
+   */
+  uint32_t getCode() const;
+
  protected:
   std::string message;
+  uint32_t code = 0;
+};
+
+/**
+ * Records faults on realtime paths instead of throwing. Building with
+ * EEROS_RT_HOTPATH, the runtime checks of EEROS report here, otherwise they throw.
+ * The first fault reported since the last clear is kept, all reports are counted.
+ * All functions are lock-free and may be called from any thread.
+ */
+class FaultRegister {
+ public:
+  /**
+   * Reports a fault.
+   * 
+   * @param fault - descriptor of the fault, must have static storage duration
+   */
+  static void report(const FaultCode& fault) noexcept;
+
+  /**
+   * @return first fault reported since the last clear, nullptr if none
+   */
+  static const FaultCode* first() noexcept;
+
+  /**
+   * @return number of faults reported since the last clear
+   */
+  static uint64_t count() noexcept;
+
+  /**
+   * Clears the register.
+   */
+  static void clear() noexcept;
+
+  /**
+   * Throws the first fault reported since the last clear as Fault and clears the
+   * register. Meant for setup time or for a non realtime thread.
+   */
+  static void rethrow();
 };
 
 }
@@ -0,0 +1,51 @@
+#ifndef ORG_EEROS_CORE_FUTEXEVENT_HPP_
+#define ORG_EEROS_CORE_FUTEXEVENT_HPP_
+
+#include <atomic>
+#include <cstdint>
+
+namespace eeros {
+
+/**
+ * Event which wakes up all waiting threads, built directly on a Linux futex.
+ * A waiter reads the generation with prepare(), checks whatever it is waiting for
+ * and then calls wait() with that generation. A notify() between prepare() and
+ * wait() is never lost, as wait() returns immediately if the generation changed.
+ * notify() never blocks and only enters the kernel if a thread is actually
+ * waiting, so it may be called from a realtime thread.
+ *
+ * @since v1.4.4
+ */
+class FutexEvent {
+ public:
+  FutexEvent();
+  FutexEvent(const FutexEvent&) = delete;
+  FutexEvent& operator=(const FutexEvent&) = delete;
+
+  /**
+   * @return current generation, to be passed to wait()
+   */
+  uint32_t prepare() const;
+
+  /**
+   * Blocks until notify() is called after prepare() returned the given generation.
+   *
+   * @param generation - generation returned by prepare()
+   * @param timeout_sec - timeout in sec
+   * @return true, if notified, false if the timeout expired
+   */
+  bool wait(uint32_t generation, double timeout_sec);
+
+  /**
+   * Wakes up all waiting threads.
+   */
+  void notify();
+
+ private:
+  std::atomic<int32_t> generation;
+  std::atomic<int32_t> waiters;
+};
+
+}
+
+#endif /* ORG_EEROS_CORE_FUTEXEVENT_HPP_ */
@@ -0,0 +1,59 @@
+#ifndef ORG_EEROS_CORE_FUTEXSEMAPHORE_HPP_
+#define ORG_EEROS_CORE_FUTEXSEMAPHORE_HPP_
+
+#include <atomic>
+#include <cstdint>
+
+namespace eeros {
+
+/**
+ * Counting semaphore built directly on a Linux futex. 
+ * A waiter first spins for a limited number of iterations before it blocks in
+ * the kernel, and post() only enters the kernel if a thread is actually blocked.
+ * This keeps the handoff between the executor and the harmonic threads cheap.
+ * It has the same interface as @ref Semaphore.
+ *
+ * @since v1.4.4
+ */
+class FutexSemaphore {
+ public:
+  /**
+   * Constructs a semaphore.
+   *
+   * @param value - initial count
+   * @param spin - number of iterations to spin before blocking
+   */
+  FutexSemaphore(int value = 0, int spin = 100);
+
+  FutexSemaphore(const FutexSemaphore&) = delete;
+  FutexSemaphore& operator=(const FutexSemaphore&) = delete;
+
+  /**
+   * Decrements the count, blocks while the count is zero.
+   */
+  void wait();
+
+  /**
+   * Decrements the count, blocks at most for the given time while the count is zero.
+   *
+   * @param timeout_sec - timeout in sec
+   * @return true, if the count could be decremented
+   */
+  bool wait(double timeout_sec);
+
+  /**
+   * Increments the count and wakes up one waiting thread.
+   */
+  void post();
+
+ private:
+  bool tryWait();
+  bool spinWait();
+  std::atomic<int32_t> counter;
+  std::atomic<int32_t> waiters;
+  int spin;
+};
+
+}
+
+#endif /* ORG_EEROS_CORE_FUTEXSEMAPHORE_HPP_ */
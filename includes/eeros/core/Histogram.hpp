@@ -0,0 +1,89 @@
+#ifndef ORG_EEROS_CORE_HISTOGRAM_HPP_
+#define ORG_EEROS_CORE_HISTOGRAM_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace eeros {
+
+/**
+ * Fixed memory histogram with logarithmic buckets for timing values.
+ * Values are recorded in nanoseconds. Each power of two is split into
+ * 32 linear sub-buckets, which results in a relative precision of about 3%
+ * over a range from 1 ns to about 18 min. Negative values are recorded in
+ * a separate set of buckets, which allows to record jitter as well.
+ *
+ * Recording never allocates and is wait free. The histogram is meant to be
+ * written by a single thread, a consistent snapshot can be taken from
+ * any other thread without stopping the writer.
+ *
+ * @since v1.4.4
+ */
+class Histogram {
+ public:
+  static constexpr int subBucketBits = 5;
+  static constexpr int subBuckets = 1 << subBucketBits;
+  static constexpr int maxExponent = 40;
+  static constexpr int bucketCount = (maxExponent - subBucketBits + 2) * subBuckets;
+
+  /**
+   * Copy of the bucket counts, used for evaluating percentiles outside the realtime thread.
+   */
+  struct Snapshot {
+    /**
+     * Returns the value below which the given fraction of all recorded values lie.
+     * The upper bound of the matching bucket is returned.
+     *
+     * @param p - fraction between 0 and 1, e.g. 0.999 for p99.9
+     * @return value in sec
+     */
+    double percentile(double p) const;
+
+    uint64_t count = 0;
+    std::array<uint64_t, bucketCount> positive{};
+    std::array<uint64_t, bucketCount> negative{};
+  };
+
+  Histogram();
+  Histogram(const Histogram& other);
+  Histogram& operator=(const Histogram& other);
+
+  /**
+   * Records a value.
+   *
+   * @param value - value in sec
+   */
+  void add(double value);
+
+  /**
+   * Clears all buckets.
+   */
+  void reset();
+
+  /**
+   * Copies the bucket counts. Can be called from any thread.
+   *
+   * @return snapshot of the histogram
+   */
+  Snapshot snapshot() const;
+
+  /**
+   * Returns the number of recorded values.
+   *
+   * @return count
+   */
+  uint64_t getCount() const;
+
+  static int bucketIndex(uint64_t ns);
+  static uint64_t bucketUpperBound(int index);
+
+ private:
+  std::array<std::atomic<uint64_t>, bucketCount> positive;
+  std::array<std::atomic<uint64_t>, bucketCount> negative;
+  std::atomic<uint64_t> count;
+};
+
+}
+
+#endif // ORG_EEROS_CORE_HISTOGRAM_HPP_
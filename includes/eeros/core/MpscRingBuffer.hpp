@@ -0,0 +1,99 @@
+#ifndef ORG_EEROS_CORE_MPSCRINGBUFFER_HPP_
+#define ORG_EEROS_CORE_MPSCRINGBUFFER_HPP_
+
+#include <atomic>
+#include <cstddef>
+
+namespace eeros {
+
+/**
+ * Bounded lock-free ring buffer for several producer threads and one consumer thread.
+ * It has the same interface as RingBuffer. Each slot carries a sequence number,
+ * producers claim a slot with a compare and swap on the head index and publish
+ * the item by updating the sequence number of the slot. A producer never waits
+ * for another producer, a full buffer is reported immediately.
+ *
+ * @tparam T - item type
+ * @tparam N - capacity, must be a power of two
+ *
+ * @since v1.4.4
+ */
+template < typename T, int N = 32 >
+class MpscRingBuffer {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "capacity of MpscRingBuffer must be a power of two");
+
+ public:
+  static constexpr std::size_t cacheLineSize = 64;
+
+  MpscRingBuffer() : head(0), tail(0) {
+    for (unsigned int i = 0; i < N; i++) slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  /**
+   * Appends an item. May be called by any number of producer threads.
+   *
+   * @param v - item
+   * @return false, if the buffer is full
+   */
+  bool push(T v) {
+    unsigned int h = head.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot& s = slots[h & mask];
+      int diff = static_cast<int>(s.sequence.load(std::memory_order_acquire) - h);
+      if (diff == 0) {
+        if (head.compare_exchange_weak(h, h + 1, std::memory_order_relaxed)) {
+          s.item = v;
+          s.sequence.store(h + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        h = head.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * Removes the oldest item. Must only be called by the consumer thread.
+   *
+   * @param v - item
+   * @return false, if the buffer is empty or the oldest item is not yet published
+   */
+  bool pop(T& v) {
+    unsigned int t = tail.load(std::memory_order_relaxed);
+    Slot& s = slots[t & mask];
+    if (s.sequence.load(std::memory_order_acquire) != t + 1) return false;
+    v = s.item;
+    s.sequence.store(t + N, std::memory_order_release);
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Returns the number of claimed items. The value may be outdated as soon as it is returned.
+   *
+   * @return number of items
+   */
+  unsigned int length() const {
+    return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+  }
+
+  constexpr int size() const { return N; }
+
+ private:
+  static constexpr unsigned int mask = N - 1;
+
+  struct Slot {
+    std::atomic<unsigned int> sequence;
+    T item;
+  };
+
+  alignas(cacheLineSize) std::atomic<unsigned int> head; // next index to claim by a producer
+  alignas(cacheLineSize) std::atomic<unsigned int> tail; // next index to read by the consumer
+  alignas(cacheLineSize) Slot slots[N];
+};
+
+}
+
+#endif // ORG_EEROS_CORE_MPSCRINGBUFFER_HPP_
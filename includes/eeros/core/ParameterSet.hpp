@@ -0,0 +1,135 @@
+#ifndef ORG_EEROS_CORE_PARAMETERSET_HPP_
+#define ORG_EEROS_CORE_PARAMETERSET_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace eeros {
+
+/**
+ * Parameters of a block, e.g. gains or limits, which are changed by other threads
+ * while the block is running, in the manner of read-copy-update. A writer copies
+ * the parameters, changes the copy and publishes it with an atomic pointer swap.
+ * The reader, i.e. the thread running the block, calls acquire() once at the
+ * beginning of each run and then reads a consistent set, even of wide matrix
+ * parameters, without taking a lock.
+ *
+ * A replaced set is reclaimed after a grace period: every acquire() announces
+ * that the reader no longer uses the set of the previous acquire(), so a set is
+ * freed by the next writer as soon as the reader has called acquire() twice after
+ * it has been replaced. Sets replaced while the block does not run are kept
+ * until it runs again.
+ *
+ * Writers are serialized by a mutex, there must be only one reader thread.
+ *
+ * @tparam P - parameter type, must be copyable
+ *
+ * @since v1.4.4
+ */
+template < typename P >
+class ParameterSet {
+ public:
+  /**
+   * Constructs a parameter set.
+   *
+   * @param initial - initial parameters
+   */
+  explicit ParameterSet(P initial = P{}) : current(new P(std::move(initial))) { }
+
+  ~ParameterSet() {
+    delete current.load();
+    for (auto& r : retired) delete r.set;
+  }
+
+  ParameterSet(const ParameterSet&) = delete;
+  ParameterSet& operator=(const ParameterSet&) = delete;
+
+  /**
+   * Returns the latest published parameters. They stay valid and unchanged until
+   * the next call of acquire(). Must only be called by the reader thread.
+   *
+   * @return parameters
+   */
+  const P& acquire() {
+    const P* p = current.load(std::memory_order_seq_cst);
+    generation.store(generation.load(std::memory_order_relaxed) + 1, std::memory_order_seq_cst);
+    return *p;
+  }
+
+  /**
+   * Returns a copy of the latest published parameters. Must not be called by the reader thread
+   * while it runs with realtime constraints.
+   *
+   * @return parameters
+   */
+  P get() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return *current.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Publishes new parameters, the reader gets them at its next acquire().
+   *
+   * @param p - parameters
+   */
+  void publish(P p) {
+    P* next = new P(std::move(p));
+    std::lock_guard<std::mutex> lock(mtx);
+    swap(next);
+  }
+
+  /**
+   * Copies the latest parameters, calls f with the copy and publishes it.
+   * Concurrent modifications do not get lost.
+   *
+   * @param f - function changing the parameters, gets P& as argument
+   */
+  template < typename F >
+  void modify(F f) {
+    std::lock_guard<std::mutex> lock(mtx);
+    P* next = new P(*current.load(std::memory_order_relaxed));
+    f(*next);
+    swap(next);
+  }
+
+  /**
+   * @return number of replaced sets which are not reclaimed yet
+   */
+  std::size_t getRetired() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return retired.size();
+  }
+
+ private:
+  struct Retired {
+    P* set;
+    uint64_t generation;
+  };
+
+  void swap(P* next) {
+    retired.reserve(retired.size() + 1);
+    P* old = current.exchange(next, std::memory_order_seq_cst);
+    uint64_t now = generation.load(std::memory_order_seq_cst);
+    retired.push_back({old, now});
+    // The reader may have loaded the old set just before announcing the generation
+    // read above, it has certainly left it once it announced two more generations.
+    std::size_t kept = 0;
+    for (auto& r : retired) {
+      if (now >= r.generation + 2) delete r.set;
+      else retired[kept++] = r;
+    }
+    retired.resize(kept);
+  }
+
+  std::atomic<P*> current;
+  std::atomic<uint64_t> generation{0};
+  mutable std::mutex mtx;
+  std::vector<Retired> retired;
+};
+
+}
+
+#endif /* ORG_EEROS_CORE_PARAMETERSET_HPP_ */
@@ -2,14 +2,19 @@
 #define ORG_EEROS_CORE_PERIODICCOUNTER_HPP_
 
 #include <chrono>
+#include <cstdint>
 #include <vector>
 #include <functional>
+#include <string>
 
 #include <eeros/core/Statistics.hpp>
+#include <eeros/core/Histogram.hpp>
 #include <eeros/logger/Logger.hpp>
 
 namespace eeros {
 
+struct TimingRecord;
+
 class PeriodicCounter {
   using clk = std::chrono::steady_clock;
   using time_point = clk::time_point;
@@ -27,6 +32,13 @@ class PeriodicCounter {
   void tick();
   void tock();
   void reset();
+  void addOverruns(uint64_t count);
+  void setExport(TimingRecord* record);
+
+  /*
+   * With a trace name, tick() and tock() record a slice in the active TaskTrace.
+   */
+  void setTraceName(std::string name);
 
   void operator >> (logger::LogEntry &event);
   void operator >> (logger::LogEntry &&event);
@@ -34,6 +46,38 @@ class PeriodicCounter {
   Statistics period;
   Statistics jitter;
   Statistics run;
+  uint64_t overruns;
+
+  /*
+   * Histograms are never reset automatically, take a snapshot to
+   * evaluate percentiles while the task keeps running.
+   */
+  Histogram periodHistogram;
+  Histogram jitterHistogram;
+  Histogram runHistogram;
+
+  /*
+   * Counters of the operating system for the thread calling tock(), sampled
+   * every few cycles, see setOsSampling(). Migrations are counted whenever a run
+   * ends on another core than the previous one.
+   */
+  struct OsCounters {
+    uint64_t voluntarySwitches = 0;
+    uint64_t involuntarySwitches = 0;
+    uint64_t minorFaults = 0;
+    uint64_t majorFaults = 0;
+    uint64_t migrations = 0;
+  };
+
+  /*
+   * Samples the counters of the operating system every given number of cycles,
+   * with getrusage(RUSAGE_THREAD) from within the thread of the task. 0 disables
+   * the sampling (default). The report (operator >>) shows the changes since
+   * the previous report.
+   */
+  void setOsSampling(unsigned cycles);
+
+  OsCounters os;
 
   std::vector<MonitorFunc> monitors;
 
@@ -46,6 +90,12 @@ class PeriodicCounter {
   int reset_counter;
   time_point start;
   time_point last;
+  TimingRecord* exportRecord;
+  std::string traceName;
+  unsigned osSampling;
+  unsigned osCountdown;
+  int lastCpu;
+  OsCounters osReported;
   logger::Logger log;
 };
 }
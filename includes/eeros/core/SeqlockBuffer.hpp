@@ -0,0 +1,79 @@
+#ifndef ORG_EEROS_CORE_SEQLOCKBUFFER_HPP_
+#define ORG_EEROS_CORE_SEQLOCKBUFFER_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace eeros {
+
+/**
+ * Buffer protected by a sequence lock for one writer and any number of readers.
+ * The writer never blocks and never waits for a reader. A reader copies the data
+ * and retries if the writer updated it in the meantime. The sequence number is
+ * incremented before and after each update, an odd number indicates that an
+ * update is in progress. The sequence number 0 indicates that nothing has been
+ * written yet, it is skipped when the sequence number wraps around.
+ *
+ * @tparam T - payload type without owned heap memory, e.g. arithmetic types, plain structures or Matrix
+ *
+ * @since v1.4.4
+ */
+template < typename T >
+class SeqlockBuffer {
+  // a torn copy must never be able to corrupt owned memory
+  static_assert(std::is_trivially_destructible<T>::value, "payload of SeqlockBuffer must not own heap memory");
+
+ public:
+  /**
+   * Writes new data. Must only be called by the writer thread.
+   *
+   * @param value - data to write
+   */
+  void write(const T& value) {
+    uint32_t seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    data = value;
+    seq += 2;
+    if (seq == 0) seq = 2; // 0 stays reserved for nothing written, also after the sequence wrapped
+    sequence.store(seq, std::memory_order_release);
+  }
+
+  /**
+   * Reads a consistent copy of the data. Can be called from any thread.
+   *
+   * @param value - target
+   * @param retries - maximum number of retries
+   * @return true, if data has been written and a consistent copy could be made
+   */
+  bool read(T& value, int retries = 1000) const {
+    for (int i = 0; i < retries; i++) {
+      uint32_t before = sequence.load(std::memory_order_acquire);
+      if (before == 0) return false; // nothing written yet
+      if (before & 1) continue;
+      value = data;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence.load(std::memory_order_relaxed) == before) return true;
+    }
+    return false;
+  }
+
+  /**
+   * Returns the sequence number, which changes with every write.
+   * Readers can compare it with a previous value to detect new data.
+   *
+   * @return sequence number
+   */
+  uint32_t getSequence() const {
+    return sequence.load(std::memory_order_acquire);
+  }
+
+ private:
+  std::atomic<uint32_t> sequence{0};
+  T data{};
+};
+
+}
+
+#endif // ORG_EEROS_CORE_SEQLOCKBUFFER_HPP_
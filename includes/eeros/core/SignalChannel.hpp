@@ -0,0 +1,95 @@
+#ifndef ORG_EEROS_CORE_SIGNALCHANNEL_HPP_
+#define ORG_EEROS_CORE_SIGNALCHANNEL_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace eeros {
+
+/**
+ * Header of a signal channel in shared memory, followed by the signal elements.
+ */
+struct SignalChannelRegion {
+  static constexpr uint32_t magicNumber = 0x45455343; // "EESC"
+  static constexpr uint32_t initializing = 1;         // claimed, the layout is being written
+  static constexpr uint32_t layoutVersion = 2;
+
+  std::atomic<uint32_t> magic;
+  uint32_t version;
+  uint32_t elementSize;
+  uint32_t elements;
+  std::atomic<uint32_t> sequence;
+  std::atomic<uint32_t> published;                    // set with the first write, the sequence may wrap to 0
+  uint64_t timestamp;
+  unsigned char data[];
+};
+
+/**
+ * Named shared memory channel which moves the value of one signal between processes
+ * on the same host. The latest value and its timestamp are protected by a sequence lock,
+ * so the writer never blocks and readers never see a partially written value.
+ * Writer and reader can be started in any order, both create the shared memory object
+ * if it does not exist yet. The object is not removed when a channel is destroyed,
+ * so that either side can be restarted, use remove() to delete it.
+ *
+ * @since v1.4.4
+ */
+class SignalChannel {
+ public:
+  /**
+   * Opens or creates a channel.
+   *
+   * @param name - name of the shared memory object, e.g. "/eeros_setpoint"
+   * @param elementSize - size of one element in bytes
+   * @param elements - number of elements
+   */
+  SignalChannel(std::string name, uint32_t elementSize, uint32_t elements);
+  virtual ~SignalChannel();
+
+  SignalChannel(const SignalChannel&) = delete;
+  SignalChannel& operator=(const SignalChannel&) = delete;
+
+  /**
+   * Publishes a new value. Must only be called by a single writer.
+   *
+   * @param data - elements of the value
+   * @param timestamp - timestamp of the value in ns
+   */
+  void write(const void* data, uint64_t timestamp);
+
+  /**
+   * Reads a consistent copy of the latest value.
+   *
+   * @param data - target for the elements
+   * @param timestamp - timestamp of the value in ns
+   * @param sequence - sequence number of the value, changes with every write
+   * @param retries - maximum number of retries
+   * @return true, if a value has been written and could be copied consistently
+   */
+  bool read(void* data, uint64_t& timestamp, uint32_t& sequence, int retries = 1000) const;
+
+  /**
+   * Returns the name of the channel.
+   *
+   * @return name
+   */
+  std::string getName() const;
+
+  /**
+   * Removes the shared memory object of a channel.
+   *
+   * @param name - name of the shared memory object
+   */
+  static void remove(std::string name);
+
+ private:
+  std::string name;
+  uint32_t size;
+  uint32_t dataSize;
+  SignalChannelRegion* region;
+};
+
+}
+
+#endif // ORG_EEROS_CORE_SIGNALCHANNEL_HPP_
@@ -0,0 +1,144 @@
+#ifndef ORG_EEROS_CORE_SPSCRINGBUFFER_HPP_
+#define ORG_EEROS_CORE_SPSCRINGBUFFER_HPP_
+
+#include <atomic>
+#include <cstddef>
+
+namespace eeros {
+
+/**
+ * Wait-free ring buffer for exactly one producer thread and one consumer thread.
+ * It has the same interface as RingBuffer but never takes a lock, which makes it
+ * suitable for passing data between a realtime and a non realtime thread without
+ * risking priority inversion.
+ * The indices are kept on separate cache lines to avoid false sharing between
+ * producer and consumer.
+ *
+ * @tparam T - item type
+ * @tparam N - capacity, must be a power of two
+ *
+ * @since v1.4.4
+ */
+template < typename T, int N = 32 >
+class SpscRingBuffer {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "capacity of SpscRingBuffer must be a power of two");
+
+ public:
+  static constexpr std::size_t cacheLineSize = 64;
+
+  SpscRingBuffer() : head(0), tail(0), cachedTail(0), cachedHead(0) { }
+
+  /**
+   * Initializes all slots, e.g. with vectors of a size only known at runtime,
+   * which then never reallocate when claimed slots are filled in place.
+   *
+   * @param initial - initial content of all slots
+   */
+  explicit SpscRingBuffer(const T& initial) : SpscRingBuffer() {
+    for (auto& item : items) item = initial;
+  }
+
+  /**
+   * Appends an item. Must only be called by the producer thread.
+   *
+   * @param v - item
+   * @return false, if the buffer is full
+   */
+  bool push(T v) {
+    unsigned int h = head.load(std::memory_order_relaxed);
+    if (h - cachedTail == N) {
+      cachedTail = tail.load(std::memory_order_acquire);
+      if (h - cachedTail == N) return false;
+    }
+    items[h & mask] = v;
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Removes the oldest item. Must only be called by the consumer thread.
+   *
+   * @param v - item
+   * @return false, if the buffer is empty
+   */
+  bool pop(T& v) {
+    unsigned int t = tail.load(std::memory_order_relaxed);
+    if (t == cachedHead) {
+      cachedHead = head.load(std::memory_order_acquire);
+      if (t == cachedHead) return false;
+    }
+    v = items[t & mask];
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Returns the next free slot to be filled in place, e.g. to reuse the memory 
+   * an item already allocated. push() makes the item available to the consumer.
+   * Must only be called by the producer thread.
+   *
+   * @return free slot, nullptr if the buffer is full
+   */
+  T* claim() {
+    unsigned int h = head.load(std::memory_order_relaxed);
+    if (h - cachedTail == N) {
+      cachedTail = tail.load(std::memory_order_acquire);
+      if (h - cachedTail == N) return nullptr;
+    }
+    return &items[h & mask];
+  }
+
+  /**
+   * Appends the item filled in the slot returned by claim().
+   * Must only be called by the producer thread.
+   */
+  void push() {
+    head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  /**
+   * Returns the oldest item without removing it, so it can be used in place.
+   * Must only be called by the consumer thread.
+   *
+   * @return oldest item, nullptr if the buffer is empty
+   */
+  const T* front() {
+    unsigned int t = tail.load(std::memory_order_relaxed);
+    if (t == cachedHead) {
+      cachedHead = head.load(std::memory_order_acquire);
+      if (t == cachedHead) return nullptr;
+    }
+    return &items[t & mask];
+  }
+
+  /**
+   * Removes the item returned by front(). Must only be called by the consumer thread.
+   */
+  void pop() {
+    tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  /**
+   * Returns the number of items. The value may be outdated as soon as it is returned.
+   *
+   * @return number of items
+   */
+  unsigned int length() const {
+    return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+  }
+
+  constexpr int size() const { return N; }
+
+ private:
+  static constexpr unsigned int mask = N - 1;
+
+  alignas(cacheLineSize) std::atomic<unsigned int> head; // next index to write, owned by the producer
+  alignas(cacheLineSize) std::atomic<unsigned int> tail; // next index to read, owned by the consumer
+  alignas(cacheLineSize) unsigned int cachedTail;        // producer's copy of tail
+  alignas(cacheLineSize) unsigned int cachedHead;        // consumer's copy of head
+  alignas(cacheLineSize) T items[N];
+};
+
+}
+
+#endif // ORG_EEROS_CORE_SPSCRINGBUFFER_HPP_
@@ -0,0 +1,69 @@
+#ifndef ORG_EEROS_CORE_STACKTHREAD_HPP_
+#define ORG_EEROS_CORE_STACKTHREAD_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <pthread.h>
+
+namespace eeros {
+
+/**
+ * A thread like std::thread, but with a given stack size. A realtime thread
+ * can then prefault its whole stack, see Executor::prefault_stack(), so a deep
+ * call chain does not page fault after the memory has been locked.
+ *
+ * @since v1.4.4
+ */
+class StackThread {
+ public:
+  /**
+   * Constructs an object which is not a thread.
+   */
+  StackThread() = default;
+
+  /**
+   * Starts a thread, throws a Fault if it can not be created.
+   *
+   * @param stackSize - stack size in bytes, 0 for the default stack size
+   * @param f - function run by the thread
+   */
+  StackThread(std::size_t stackSize, std::function<void()> f);
+
+  /**
+   * Joins the thread.
+   */
+  ~StackThread();
+
+  StackThread(const StackThread&) = delete;
+  StackThread& operator=(const StackThread&) = delete;
+
+  StackThread(StackThread&& other);
+  StackThread& operator=(StackThread&& other);
+
+  bool joinable() const;
+  void join();
+  pthread_t native_handle() const;
+
+  /**
+   * @return stack size in bytes, 0 for the default stack size
+   */
+  std::size_t getStackSize() const;
+
+  /**
+   * Returns how many bytes of a stack can be prefaulted, leaving room for the
+   * frames already in use and the thread local storage at the top of the stack.
+   *
+   * @param stackSize - stack size in bytes
+   * @return bytes to prefault
+   */
+  static std::size_t usableStack(std::size_t stackSize);
+
+ private:
+  pthread_t handle = {};
+  bool running = false;
+  std::size_t stackSize = 0;
+};
+
+}
+
+#endif /* ORG_EEROS_CORE_STACKTHREAD_HPP_ */
@@ -15,6 +15,32 @@ static bool rosTimeIsUsed __attribute__((unused)) = false;
  */
 class System {
  public:
+  /**
+   * Clock sources for the system time.
+   *
+   * - monotonic: CLOCK_MONOTONIC, served by the vDSO on most kernels
+   * - monotonicRaw: CLOCK_MONOTONIC_RAW, not slewed by NTP but often a real syscall (default)
+   * - tsc: CPU time stamp counter calibrated against CLOCK_MONOTONIC, x86 with invariant TSC only
+   */
+  enum class ClockSource { monotonic, monotonicRaw, tsc };
+
+  /**
+   * Selects the clock source for the system time. Select the clock source 
+   * before starting the executor, as time stamps of different clock sources 
+   * must not be compared.
+   *
+   * @param source - clock source
+   * @return true, if the clock source is available on this system
+   */
+  static bool setClockSource(ClockSource source);
+
+  /**
+   * Gets the selected clock source.
+   *
+   * @return clock source
+   */
+  static ClockSource getClockSource();
+
   /**
    * Returns the clock resolution in seconds
    *
@@ -31,11 +57,46 @@ class System {
 
   /**
    * Returns the system time in nanoseconds.
+   * Within a cycle started with beginCycle() the cached cycle timestamp
+   * of the calling thread is returned instead of reading the clock.
    *
    * @return system time in nsec
    */
   static uint64_t getTimeNs();
 
+  /**
+   * Reads the selected clock in nanoseconds. Unlike getTimeNs(), neither
+   * the cycle timestamp nor the ROS time is used, which makes it suitable
+   * for measuring durations.
+   *
+   * @return clock time in nsec
+   */
+  static uint64_t getClockNs();
+
+  /**
+   * Captures the current time as cycle timestamp of the calling thread.
+   * Until endCycle() is called, getTime() and getTimeNs() return this
+   * timestamp, so that all blocks of a cycle see the same time.
+   * Nested calls keep the timestamp of the outermost cycle.
+   *
+   * @return true, if a new cycle was started, false if already within a cycle
+   */
+  static bool beginCycle();
+
+  /**
+   * Starts a cycle of the calling thread with the given timestamp instead of
+   * the current time, e.g. the simulated time of an offline run.
+   *
+   * @param timeNs - cycle timestamp in nsec, must not be 0
+   * @return true, if a new cycle was started, false if already within a cycle
+   */
+  static bool beginCycle(uint64_t timeNs);
+
+  /**
+   * Ends the cycle of the calling thread, getTimeNs() reads the clock again.
+   */
+  static void endCycle();
+
 #if defined (USE_ROS) || defined (USE_ROS2)
   /**
    * Makes the system reading the system time from ROS.
@@ -0,0 +1,112 @@
+#ifndef ORG_EEROS_CORE_TASKTRACE_HPP_
+#define ORG_EEROS_CORE_TASKTRACE_HPP_
+
+#include <eeros/core/SpscRingBuffer.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+namespace eeros {
+
+/**
+ * Records a timeline of the execution of tasks and writes it as Chrome trace JSON,
+ * which can be opened with Perfetto (ui.perfetto.dev) or chrome://tracing. It shows
+ * how the executor, the harmonic threads and the time domains interleave on the cores.
+ *
+ * Periodic counters with a trace name (see PeriodicCounter::setTraceName()) record
+ * a begin event in tick() and an end event in tock(), time domains record their run.
+ * Each event holds the clock in nanoseconds, the thread id and the cpu it ran on.
+ * Like \ref logger::AsyncLogWriter, each thread which records gets its own wait-free
+ * ring buffer. A background thread drains all ring buffers and writes the file. If a
+ * ring buffer is full or more than maxThreads threads record, the event is dropped
+ * and counted, see getDropped(). Names longer than nameLength - 1 characters are
+ * truncated.
+ *
+ * Only one trace records at a time, the last one created. It must outlive all threads
+ * which record, the file is completed by the destructor.
+ *
+ * @since v1.4.4
+ */
+class TaskTrace {
+ public:
+  static constexpr int maxThreads = 32;
+  static constexpr int ringSize = 4096;
+  static constexpr int nameLength = 41;
+
+  /**
+   * Creates the trace file and starts recording.
+   *
+   * @param file - file name, e.g. "trace.json"
+   */
+  TaskTrace(std::string file);
+
+  /**
+   * Stops recording, writes all pending events and completes the file.
+   */
+  ~TaskTrace();
+
+  /**
+   * Returns true, if the trace file could be created.
+   *
+   * @return true, if open
+   */
+  bool isOpen() const;
+
+  /**
+   * @return number of events dropped because a ring buffer was full
+   */
+  uint64_t getDropped() const;
+
+  /**
+   * Records the begin of a slice on the calling thread, if a trace is recording.
+   *
+   * @param name - name of the slice
+   * @param category - category, e.g. "task" or "timedomain"
+   */
+  static void begin(const char* name, const char* category) {
+    TaskTrace* t = active.load(std::memory_order_acquire);
+    if (t != nullptr) t->record(name, category, 'B');
+  }
+
+  /**
+   * Records the end of a slice on the calling thread, if a trace is recording.
+   *
+   * @param name - name of the slice
+   * @param category - category, e.g. "task" or "timedomain"
+   */
+  static void end(const char* name, const char* category) {
+    TaskTrace* t = active.load(std::memory_order_acquire);
+    if (t != nullptr) t->record(name, category, 'E');
+  }
+
+ private:
+  struct Event;
+  struct Channel;
+
+  void record(const char* name, const char* category, char phase);
+  Channel* channel();
+  void drain();
+  void run();
+
+  static std::atomic<TaskTrace*> active;
+
+  std::array<std::shared_ptr<Channel>, maxThreads> channels;
+  std::ofstream out;
+  bool first = true;
+  int pid;
+  std::set<int> named;
+  std::atomic<uint64_t> dropped{0};
+  std::atomic<bool> running{true};
+  std::mutex drainMtx;
+  std::thread thread;
+};
+
+}
+
+#endif // ORG_EEROS_CORE_TASKTRACE_HPP_
@@ -3,8 +3,9 @@
 
 #include <eeros/logger/Logger.hpp>
 #include <eeros/logger/StreamLogWriter.hpp>
+#include <eeros/core/StackThread.hpp>
 
-#include <thread>
+#include <cstddef>
 #include <functional>
 #include <string>
 
@@ -26,10 +27,12 @@ class Thread {
    * default priority.
    * If the default priority of 20 chosen, no priority assigment is made and the
    * thread will start to run with default priority. 
+   * If a stack size is given, the thread prefaults its whole stack before running.
    * 
    * @param priority - priority of the thread
+   * @param stackSize - stack size in bytes, 0 for the default stack size
    */
-  Thread(int priority = 20);
+  Thread(int priority = 20, std::size_t stackSize = 0);
   
   /**
    * Destructor
@@ -54,7 +57,7 @@ class Thread {
   virtual void run();
   
   logger::Logger log;
-  std::thread t;
+  StackThread t;
 };
 
 }
@@ -0,0 +1,113 @@
+#ifndef ORG_EEROS_CORE_TIMINGEXPORT_HPP_
+#define ORG_EEROS_CORE_TIMINGEXPORT_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <eeros/core/SharedMemory.hpp>
+
+namespace eeros {
+
+class PeriodicCounter;
+
+/**
+ * Timing statistics of one task as laid out in shared memory.
+ * Each record is protected by its own sequence lock. The writer increments
+ * the sequence number before and after updating the record, an odd number
+ * indicates that an update is in progress.
+ *
+ * @since v1.4.4
+ */
+struct TimingRecord {
+  static constexpr int nameLength = 48;
+
+  std::atomic<uint32_t> sequence;
+  char name[nameLength];
+  uint64_t count;
+  uint64_t overruns;
+  double periodLast, periodMean, periodMin, periodMax;
+  double jitterLast, jitterMean, jitterMin, jitterMax;
+  double runLast, runMean, runMin, runMax;
+};
+
+/**
+ * Header of the shared memory region, followed by the timing records.
+ */
+struct TimingRegion {
+  static constexpr uint32_t magicNumber = 0x45455453; // "EETS"
+  static constexpr uint32_t layoutVersion = 1;
+
+  uint32_t magic;
+  uint32_t version;
+  uint32_t records;
+  uint32_t reserved;
+  TimingRecord record[];
+};
+
+/**
+ * Publishes the statistics of periodic counters into a shared memory region,
+ * so that external tools can watch period, jitter, run time and overruns of all
+ * tasks without ever blocking the realtime threads.
+ * The writer side never blocks, the reader retries until it gets a consistent copy.
+ *
+ * @since v1.4.4
+ */
+class TimingExport {
+ public:
+  /**
+   * Creates and maps a shared memory region with a given number of records.
+   *
+   * @param path - name of the shared memory object, e.g. "/eeros_timing"
+   * @param records - number of records
+   */
+  TimingExport(std::string path, uint32_t records);
+
+  /**
+   * Opens an existing region for reading, e.g. from an external tool.
+   *
+   * @param path - name of the shared memory object
+   */
+  static TimingRegion* open(std::string path);
+
+  /**
+   * Returns true, if the region could be mapped.
+   *
+   * @return true, if mapped
+   */
+  bool isValid() const;
+
+  /**
+   * Assigns a record to a task.
+   *
+   * @param index - index of the record
+   * @param name - name of the task
+   * @return pointer to the record or nullptr if the index is out of range
+   */
+  TimingRecord* getRecord(uint32_t index, std::string name);
+
+  /**
+   * Copies the current statistics of a counter into a record. Never blocks.
+   *
+   * @param record - target record
+   * @param counter - periodic counter
+   */
+  static void write(TimingRecord& record, const PeriodicCounter& counter);
+
+  /**
+   * Reads a consistent copy of a record.
+   *
+   * @param record - source record in shared memory
+   * @param copy - target
+   * @param retries - maximum number of retries
+   * @return true, if a consistent copy could be made
+   */
+  static bool read(const TimingRecord& record, TimingRecord& copy, int retries = 1000);
+
+ private:
+  SharedMemory shm;
+  TimingRegion* region;
+};
+
+}
+
+#endif // ORG_EEROS_CORE_TIMINGEXPORT_HPP_
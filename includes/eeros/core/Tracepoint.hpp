@@ -0,0 +1,54 @@
+#ifndef ORG_EEROS_CORE_TRACEPOINT_HPP_
+#define ORG_EEROS_CORE_TRACEPOINT_HPP_
+
+#include <eeros/config.hpp>
+
+/**
+ * Static tracepoints on the realtime paths of EEROS. With EEROS_TRACEPOINTS each
+ * EEROS_TRACE statement becomes a USDT probe of the provider "eeros", i.e. a single
+ * nop in the code and a note in the ELF file. perf, bpftrace, SystemTap and LTTng
+ * attach to them at runtime, so the activity of the framework can be correlated with
+ * the scheduling events of the kernel, e.g.
+ *
+ *   perf buildid-cache --add libeeros.so && perf record -e sdt_eeros:* -e sched:sched_switch ...
+ *   bpftrace -e 'usdt:libeeros.so:eeros:timedomain_end { ... }'
+ *
+ * Without EEROS_TRACEPOINTS the statements are compiled out and their arguments
+ * are not evaluated. The probes around every block run additionally need
+ * EEROS_TRACE_BLOCKS, as they are by far the most frequent ones.
+ *
+ * Probes and their arguments:
+ * - executor_cycle(timestamp ns): the executor main loop starts a cycle
+ * - periodic_tick(counter): a periodic counter starts measuring a run
+ * - periodic_tock(counter, run ns): a periodic counter ends measuring a run
+ * - async_wake(async, pending): a harmonic task is released
+ * - async_run(async): the thread of a harmonic task starts a run
+ * - async_finish(async, missed): the thread of a harmonic task finished a run
+ * - timedomain_begin(timedomain, name), timedomain_end(timedomain)
+ * - block_begin(block), block_end(block): EEROS_TRACE_BLOCKS only
+ * - safety_transition(from level id, to level id): -1 for no level
+ * - log_enqueue(writer, ok): a log record is queued for the writer thread, ok is 0 if it was dropped
+ *
+ * @since v1.4.4
+ */
+
+#ifdef EEROS_TRACEPOINTS
+#include <sys/sdt.h>
+#define EEROS_TRACE0(name) DTRACE_PROBE(eeros, name)
+#define EEROS_TRACE1(name, a) DTRACE_PROBE1(eeros, name, a)
+#define EEROS_TRACE2(name, a, b) DTRACE_PROBE2(eeros, name, a, b)
+#define EEROS_TRACE3(name, a, b, c) DTRACE_PROBE3(eeros, name, a, b, c)
+#else
+#define EEROS_TRACE0(name) ((void)0)
+#define EEROS_TRACE1(name, a) ((void)0)
+#define EEROS_TRACE2(name, a, b) ((void)0)
+#define EEROS_TRACE3(name, a, b, c) ((void)0)
+#endif
+
+#if defined(EEROS_TRACEPOINTS) && defined(EEROS_TRACE_BLOCKS)
+#define EEROS_TRACE_BLOCK1(name, a) DTRACE_PROBE1(eeros, name, a)
+#else
+#define EEROS_TRACE_BLOCK1(name, a) ((void)0)
+#endif
+
+#endif // ORG_EEROS_CORE_TRACEPOINT_HPP_
@@ -0,0 +1,96 @@
+#ifndef ORG_EEROS_CORE_TRIPLEBUFFER_HPP_
+#define ORG_EEROS_CORE_TRIPLEBUFFER_HPP_
+
+#include <array>
+#include <atomic>
+
+namespace eeros {
+
+/**
+ * Wait-free triple buffer for one writer and one reader, meant for large payloads
+ * like laser scans or socket frames. In contrast to AsyncBuffer, nothing is copied
+ * on the reader side: read() returns a view of the slot owned by the reader, which
+ * stays valid and unchanged until the next call to read(). The writer can fill its
+ * slot in place with writeBuffer() and publish() to avoid a copy on the writer side too.
+ *
+ * @tparam T - payload type, must be default-constructible
+ *
+ * @since v1.4.4
+ */
+template < typename T >
+class TripleBuffer {
+ public:
+  TripleBuffer() = default;
+
+  /**
+   * Initializes all slots, e.g. with vectors of a size only known at runtime,
+   * which then never reallocate when they are filled in place.
+   *
+   * @param initial - initial content of all slots
+   */
+  explicit TripleBuffer(const T& initial) : buffer{initial, initial, initial} { }
+
+  /**
+   * Returns the slot owned by the writer, which may be filled in place.
+   * Must only be called by the writer thread.
+   *
+   * @return slot of the writer
+   */
+  T& writeBuffer() {
+    return buffer[back];
+  }
+
+  /**
+   * Makes the content of the writer slot the latest data.
+   * Must only be called by the writer thread.
+   */
+  void publish() {
+    back = middle.exchange(back | newDataFlag, std::memory_order_acq_rel) & indexMask;
+  }
+
+  /**
+   * Copies data into the writer slot and publishes it.
+   *
+   * @param data - data to write
+   */
+  void write(const T& data) {
+    buffer[back] = data;
+    publish();
+  }
+
+  /**
+   * Returns a view of the latest published data. The view is valid until the
+   * next call to read(). Must only be called by the reader thread.
+   *
+   * @param newData - set to true, if data was published since the last read
+   * @return latest data
+   */
+  const T& read(bool& newData) {
+    newData = middle.load(std::memory_order_relaxed) & newDataFlag;
+    if (newData) front = middle.exchange(front, std::memory_order_acq_rel) & indexMask;
+    return buffer[front];
+  }
+
+  /**
+   * Returns a view of the latest published data.
+   *
+   * @return latest data
+   */
+  const T& read() {
+    bool newData;
+    return read(newData);
+  }
+
+ private:
+  static constexpr unsigned char indexMask = 0x03;
+  static constexpr unsigned char newDataFlag = 0x04;
+
+  std::array<T, 3> buffer{T{}, T{}, T{}};
+  std::atomic<unsigned char> middle{1}; // index of the shared slot and new data flag
+  unsigned char back = 0;               // slot of the writer
+  unsigned char front = 2;              // slot of the reader
+};
+
+}
+
+#endif // ORG_EEROS_CORE_TRIPLEBUFFER_HPP_
@@ -0,0 +1,153 @@
+#ifndef ORG_EEROS_CORE_WCET_HPP_
+#define ORG_EEROS_CORE_WCET_HPP_
+
+#include <eeros/config.hpp>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace eeros {
+
+/**
+ * Measurement of the worst case execution time of the callables which run in
+ * realtime threads. With the build option EEROS_WCET, the run of each block and
+ * the level action, onEntry and onExit of each safety level are measured, and the
+ * longest run of each of them is kept over the whole run of the program, e.g. a
+ * soak test. Without EEROS_WCET nothing is measured and nothing is compiled in.
+ *
+ * A run is measured in cycles of the time stamp counter on x86, on other
+ * architectures in ns of System::getClockNs(). Optionally the caches are flushed
+ * before each measured run, so the maximum also covers runs with cold caches.
+ * The probes are registered when a time domain or a safety system is set up,
+ * measuring neither allocates nor locks. The probes are never destroyed, so the
+ * report can also be written when the program exits.
+ *
+ * The report lists one line per probe, keyed by its kind and name, e.g.
+ *
+ *   kind,name,runs,max ticks,max us
+ *   block,td1/controller,120000,8412,3.12
+ *   level,emergency/onEntry,2,15310,5.67
+ *
+ * @since v1.4.4
+ */
+class Wcet {
+ public:
+  /**
+   * Longest run of one callable.
+   */
+  struct Probe {
+    std::string kind;
+    std::string name;
+    std::atomic<uint64_t> runs{0};
+    std::atomic<uint64_t> max{0};   // ticks
+
+    /**
+     * Records a run.
+     *
+     * @param ticks - duration of the run
+     */
+    void record(uint64_t ticks) {
+      runs.fetch_add(1, std::memory_order_relaxed);
+      uint64_t m = max.load(std::memory_order_relaxed);
+      while (ticks > m && !max.compare_exchange_weak(m, ticks, std::memory_order_relaxed));
+    }
+  };
+
+  /**
+   * Measures the run of a callable from its construction to its destruction.
+   */
+  class Scope {
+   public:
+    Scope(Probe* probe) : probe(probe) {
+      if (probe == nullptr) return;
+      flushCaches();
+      start = ticks();
+    }
+    ~Scope() {
+      if (probe != nullptr) probe->record(ticks() - start);
+    }
+   private:
+    Probe* probe;
+    uint64_t start = 0;
+  };
+
+  /**
+   * Returns the probe of a callable, a probe which does not exist yet is created.
+   * Allocates, so it must be called while setting up.
+   *
+   * @param kind - kind of the callable, e.g. "block" or "level"
+   * @param name - name of the callable
+   * @return probe, valid until the end of the program
+   */
+  static Probe* probe(const std::string& kind, const std::string& name);
+
+  /**
+   * @return current time in ticks, see ticksPerSecond()
+   */
+  static uint64_t ticks();
+
+  /**
+   * Measures the rate of the ticks once, which takes about 10 ms.
+   *
+   * @return ticks per second
+   */
+  static double ticksPerSecond();
+
+  /**
+   * Flushes the caches before each measured run by reading a buffer larger than
+   * the last level cache. Flushing adds the time of reading the buffer to every
+   * measured callable, so the program runs much slower.
+   *
+   * @param bytes - size of the buffer, 0 to disable flushing (default)
+   */
+  static void setCacheFlush(std::size_t bytes);
+
+  /**
+   * Reads the flush buffer, if cache flushing is enabled.
+   */
+  static void flushCaches();
+
+  /**
+   * Clears the runs and the maximum of all probes.
+   */
+  static void reset();
+
+  /**
+   * Writes the report of all probes which ran at least once.
+   *
+   * @param out - output stream
+   */
+  static void report(std::ostream& out);
+
+  /**
+   * Writes the report of all probes into a file.
+   *
+   * @param path - path of the file
+   * @return true, if the file could be written
+   */
+  static bool report(const std::string& path);
+
+ private:
+  struct Registry {
+    std::mutex mtx;
+    std::deque<Probe> probes;
+    std::vector<char> flushBuffer;
+    std::atomic<const char*> flushData{nullptr};
+    std::atomic<std::size_t> flushSize{0};
+  };
+  static Registry& registry();
+};
+
+}
+
+#ifdef EEROS_WCET
+#define EEROS_WCET_SCOPE(probe) eeros::Wcet::Scope eerosWcetScope(probe)
+#else
+#define EEROS_WCET_SCOPE(probe) ((void)0)
+#endif
+
+#endif // ORG_EEROS_CORE_WCET_HPP_
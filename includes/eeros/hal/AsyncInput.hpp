@@ -0,0 +1,140 @@
+#ifndef ORG_EEROS_HAL_ASYNCINPUT_HPP_
+#define ORG_EEROS_HAL_ASYNCINPUT_HPP_
+
+#include <memory>
+#include <eeros/core/SeqlockBuffer.hpp>
+#include <eeros/core/System.hpp>
+#include <eeros/hal/AsyncPoller.hpp>
+#include <eeros/hal/Input.hpp>
+#include <eeros/hal/ScalableInput.hpp>
+
+namespace eeros {
+namespace hal {
+
+/**
+ * Latest value of a slow channel together with the time it was read.
+ */
+template < typename T >
+class AsyncValue {
+ public:
+  struct Sample {
+    T value;
+    uint64_t timestamp;
+  };
+
+  void publish(T value) {
+    buffer.write({value, System::getTimeNs()});
+  }
+
+  Sample get() const {
+    Sample s{};
+    buffer.read(s);
+    return s;
+  }
+
+ private:
+  SeqlockBuffer<Sample> buffer;
+};
+
+/**
+ * Reads a slow input in the thread of the \ref AsyncPoller at its own rate,
+ * so a peripheral input on it never blocks its time domain. get() returns the
+ * value of the last read and getTimestamp() the time of that read, getAge()
+ * tells how old the value is. The input is read once on construction.
+ *
+ * The HAL wraps a channel with "asyncPeriod" set in the configuration.
+ * Features of the library cannot be called on a wrapped channel.
+ *
+ * @tparam T - value type
+ *
+ * @since v1.4.4
+ */
+template < typename T >
+class AsyncInput : public Input<T> {
+ public:
+  /**
+   * Constructs an asynchronous input.
+   *
+   * @param input - input which is read, owned by this input
+   * @param period - period of the reads in sec
+   */
+  AsyncInput(Input<T>* input, double period) : Input<T>(input->getId(), input->getLibHandle()), input(input) {
+    cache.publish(input->get());
+    id = AsyncPoller::instance().add([this]() { cache.publish(this->input->get()); }, period);
+  }
+
+  virtual ~AsyncInput() {
+    AsyncPoller::instance().remove(id);
+  }
+
+  SIUnit getUnit() override { return input->getUnit(); }
+  T get() override { return cache.get().value; }
+  uint64_t getTimestamp() override { return cache.get().timestamp; }
+
+  /**
+   * @return age of the value in sec
+   */
+  double getAge() { return (System::getTimeNs() - getTimestamp()) * 1.0e-9; }
+
+  /**
+   * @return input which is read
+   */
+  Input<T>* getInput() { return input.get(); }
+
+ private:
+  std::unique_ptr<Input<T>> input;
+  AsyncValue<T> cache;
+  int id;
+};
+
+/**
+ * Asynchronous version of a scalable input, see \ref AsyncInput.
+ * The value is scaled in the thread of the poller, changing the scale
+ * changes it on the input which is read.
+ *
+ * @since v1.4.4
+ */
+class AsyncScalableInput : public ScalableInput<double> {
+ public:
+  /**
+   * Constructs an asynchronous input.
+   *
+   * @param input - input which is read, owned by this input
+   * @param period - period of the reads in sec
+   */
+  AsyncScalableInput(ScalableInput<double>* input, double period)
+      : ScalableInput<double>(input->getId(), input->getLibHandle(), input->getScale(), input->getOffset(),
+                              input->getMinIn(), input->getMaxIn(), input->getUnit()), input(input) {
+    cache.publish(input->get());
+    id = AsyncPoller::instance().add([this]() { cache.publish(this->input->get()); }, period);
+  }
+
+  virtual ~AsyncScalableInput() {
+    AsyncPoller::instance().remove(id);
+  }
+
+  double get() override { return cache.get().value; }
+  uint64_t getTimestamp() override { return cache.get().timestamp; }
+  void setScale(double s) override { ScalableInput<double>::setScale(s); input->setScale(s); }
+  void setOffset(double o) override { ScalableInput<double>::setOffset(o); input->setOffset(o); }
+
+  /**
+   * @return age of the value in sec
+   */
+  double getAge() { return (System::getTimeNs() - getTimestamp()) * 1.0e-9; }
+
+  /**
+   * @return input which is read
+   */
+  ScalableInput<double>* getInput() { return input.get(); }
+
+ private:
+  std::unique_ptr<ScalableInput<double>> input;
+  AsyncValue<double> cache;
+  int id;
+};
+
+}
+}
+
+#endif // ORG_EEROS_HAL_ASYNCINPUT_HPP_
@@ -0,0 +1,81 @@
+#ifndef ORG_EEROS_HAL_ASYNCPOLLER_HPP_
+#define ORG_EEROS_HAL_ASYNCPOLLER_HPP_
+
+#include <eeros/logger/Logger.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace eeros {
+namespace hal {
+
+/**
+ * One thread which reads all slow channels, e.g. I2C temperature sensors or
+ * sysfs files, each at its own rate. A channel registers a poll function which
+ * reads the device and publishes the value, see \ref AsyncInput. The thread
+ * sleeps until the next channel is due.
+ *
+ * @since v1.4.4
+ */
+class AsyncPoller {
+ public:
+  /**
+   * Returns the poller, its thread is started on the first call.
+   *
+   * @return instance of the poller
+   */
+  static AsyncPoller& instance();
+
+  ~AsyncPoller();
+
+  AsyncPoller(const AsyncPoller&) = delete;
+  AsyncPoller& operator=(const AsyncPoller&) = delete;
+
+  /**
+   * Registers a poll function, which is first called one period from now.
+   *
+   * @param poll - reads the channel, called by the thread of the poller
+   * @param period - period in sec
+   * @return id to remove the function
+   */
+  int add(std::function<void()> poll, double period);
+
+  /**
+   * Unregisters a poll function. When it returns, the function does not run
+   * and will not be called again, so the channel may be destroyed.
+   *
+   * @param id - id returned by add()
+   */
+  void remove(int id);
+
+  /**
+   * @return number of registered poll functions
+   */
+  int getCount();
+
+ private:
+  AsyncPoller();
+  void run();
+
+  struct Entry {
+    std::function<void()> poll;
+    int64_t periodNs;
+    int64_t next;
+  };
+
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::map<int, Entry> entries;
+  int nextId = 0;
+  bool running = true;
+  logger::Logger log;
+  std::thread thread;
+};
+
+}
+}
+
+#endif // ORG_EEROS_HAL_ASYNCPOLLER_HPP_
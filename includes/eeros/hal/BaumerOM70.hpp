@@ -4,6 +4,8 @@
 #ifdef EEROS_USE_MODBUS
 
 #include <eeros/core/Thread.hpp>
+#include <eeros/core/SeqlockBuffer.hpp>
+#include <eeros/core/Statistics.hpp>
 #include <eeros/logger/Logger.hpp>
 #include <modbus/modbus.h>    
 #include <atomic>
@@ -17,11 +19,37 @@ namespace hal {
  * This class is part of the hardware abstraction layer. 
  * It is used by \ref eeros::control::BaumerOM70Input class. 
  * Do not use it directly.
+ *
+ * The thread reads the whole process data block of the sensor, distance, quality,
+ * alarm, measurement rate and timestamp, with one Modbus transaction. A sample is
+ * published through a sequence lock when the timestamp of the sensor changed, so
+ * polling faster than the sensor measures does not yield duplicates. The rate of
+ * new samples and the latency of the transactions are recorded, see getTiming().
  * 
  * @since v1.3
  */
 class BaumerOM70 : public eeros::Thread {
  public: 
+  /**
+   * One measurement of the sensor.
+   */
+  struct Sample {
+    float distance = 0;      // [m]
+    uint16_t quality = 0;    // raw quality register of the sensor
+    uint16_t alarm = 0;      // raw alarm register of the sensor
+    float measRate = 0;      // measurement rate of the sensor [Hz]
+    uint32_t deviceTime = 0; // timestamp of the sensor [us]
+    uint64_t timestamp = 0;  // time the sample was received, see System::getTimeNs()
+  };
+
+  /**
+   * Rate of new samples [Hz] and latency of a read transaction [s].
+   */
+  struct Timing {
+    Statistics rate, latency;
+    uint64_t errors = 0;     // failed transactions
+  };
+
   /**
    * Constructs a thread to get Baumer OM70 sensors data \n
    * Calls BaumerOM70(std::string dev, int port, int slave_id, int priority)
@@ -73,6 +101,22 @@ class BaumerOM70 : public eeros::Thread {
    */
   float getDistance();
 
+  /**
+   * Reads a consistent copy of the latest measurement, never blocks
+   *
+   * @param sample - target
+   * @return true, if a consistent copy could be made
+   */
+  bool getSample(Sample& sample) const;
+
+  /**
+   * Reads a consistent copy of the sample rate and transaction latency
+   *
+   * @param timing - target
+   * @return true, if a consistent copy could be made
+   */
+  bool getTiming(Timing& timing) const;
+
  private:
   /**
    * Runs methods for data acquisition from sensor
@@ -85,9 +129,11 @@ class BaumerOM70 : public eeros::Thread {
   int id;
   modbus_t *ctx;
   uint16_t tabReg[32];
-  float distance;
-  uint32_t timestampUs;
-  float measRate;
+  SeqlockBuffer<Sample> sample;
+  SeqlockBuffer<Timing> timing;
+  Sample latest;  // owned by the thread
+  Timing stats;   // owned by the thread
+  bool first = true;
   Logger log;
 };
 
@@ -0,0 +1,111 @@
+#ifndef ORG_EEROS_HAL_CANSOCKET_HPP_
+#define ORG_EEROS_HAL_CANSOCKET_HPP_
+
+#include <cstdint>
+#include <string>
+#include <linux/can.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+#include <sys/socket.h>
+
+namespace eeros {
+namespace hal {
+
+/**
+ * A raw SocketCAN socket which receives frames in batches. receive() drains the
+ * pending frames with one recvmmsg() call into a preallocated array, so a
+ * cycle costs one system call instead of one per frame. Each frame is stamped
+ * by the kernel when it arrives (SO_TIMESTAMPING), the stamps are converted to
+ * the time base of System::getTimeNs().
+ *
+ * Frames to send are queued and sent together with one sendmmsg() call by
+ * flush(), in the order they were queued.
+ *
+ * @since v1.4.4
+ */
+class CanSocket {
+ public:
+  static constexpr int capacity = 64;
+
+  /**
+   * Opens a raw CAN socket bound to an interface.
+   *
+   * @param interface - name of the CAN interface, e.g. can0
+   */
+  explicit CanSocket(std::string interface);
+
+  /**
+   * Uses a socket which is already open and bound, the socket is closed
+   * by the destructor.
+   *
+   * @param fd - file descriptor of the socket
+   */
+  explicit CanSocket(int fd);
+
+  ~CanSocket();
+
+  CanSocket(const CanSocket&) = delete;
+  CanSocket& operator=(const CanSocket&) = delete;
+
+  /**
+   * Receives the pending frames without waiting, at most capacity.
+   *
+   * @return number of frames received
+   */
+  int receive();
+
+  /**
+   * @param i - index of the frame, below the count returned by receive()
+   * @return frame i of the last receive()
+   */
+  const can_frame& getFrame(int i) const { return frames[i]; }
+
+  /**
+   * @param i - index of the frame, below the count returned by receive()
+   * @return time of arrival of frame i in ns, as System::getTimeNs()
+   */
+  uint64_t getTimestamp(int i) const { return timestamps[i]; }
+
+  /**
+   * Queues a frame, it is sent by the next flush().
+   *
+   * @param frame - frame
+   * @return false if the queue is full
+   */
+  bool queue(const can_frame& frame);
+
+  /**
+   * Sends all queued frames with one system call and empties the queue.
+   * If the kernel does not accept all frames, the frames after the first
+   * rejected one are not sent either.
+   *
+   * @return number of frames sent
+   */
+  int flush();
+
+  /**
+   * @return number of frames queued
+   */
+  int getQueued() const { return queued; }
+
+  int getFd() const { return fd; }
+
+ private:
+  void prepare();
+
+  int fd;
+  can_frame frames[capacity];
+  uint64_t timestamps[capacity];
+  mmsghdr msgs[capacity];
+  iovec iov[capacity];
+  alignas(cmsghdr) char control[capacity][CMSG_SPACE(sizeof(scm_timestamping))];
+  can_frame txFrames[capacity];
+  mmsghdr txMsgs[capacity];
+  iovec txIov[capacity];
+  int queued = 0;
+};
+
+}
+}
+
+#endif /* ORG_EEROS_HAL_CANSOCKET_HPP_ */
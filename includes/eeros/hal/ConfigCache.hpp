@@ -0,0 +1,81 @@
+#ifndef ORG_EEROS_HAL_CONFIGCACHE_HPP_
+#define ORG_EEROS_HAL_CONFIGCACHE_HPP_
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace eeros {
+namespace hal {
+
+/**
+ * Channel of the HAL configuration with all values resolved, i.e. the scale,
+ * offset and range folded from the chain of scale and range entries.
+ *
+ * @since v1.4.4
+ */
+struct ChannelConfig {
+  enum Kind : uint8_t { logic, real, comediFqd };
+
+  Kind kind = logic;
+  std::string library;
+  bool lazyBinding = false;
+  std::string type;
+  std::string id;
+  std::string devHandle;
+  uint32_t subDevice = 0;
+  uint32_t channel[3] = {0, 0, 0};   // encoder channels A, B and Z of a comedi Fqd
+  bool inverted = false;
+  double scale = 1;
+  double offset = 0;
+  double rangeMin = 0;
+  double rangeMax = 0;
+  double safe = std::numeric_limits<double>::quiet_NaN();
+  std::string unit;
+  std::string additionalArguments;
+  double asyncPeriod = 0;   // read by the AsyncPoller with this period, 0 for direct reads
+};
+
+/**
+ * Binary cache of a resolved HAL configuration. The cache is keyed by a hash of
+ * the configuration file, a changed file invalidates it. Loading the cache skips
+ * parsing the file and resolving the scales, see HAL::setConfigCache().
+ *
+ * @since v1.4.4
+ */
+class ConfigCache {
+ public:
+  /**
+   * Computes the hash of a configuration file (64 bit FNV-1a).
+   *
+   * @param file - path of the configuration file
+   * @return hash, 0 if the file cannot be read
+   */
+  static uint64_t hash(const std::string& file);
+
+  /**
+   * Writes the channels to a cache file. The file is replaced atomically.
+   *
+   * @param file - path of the cache file
+   * @param hash - hash of the configuration file
+   * @param channels - resolved channels
+   * @return true, if the cache was written
+   */
+  static bool save(const std::string& file, uint64_t hash, const std::vector<ChannelConfig>& channels);
+
+  /**
+   * Reads the channels from a cache file.
+   *
+   * @param file - path of the cache file
+   * @param hash - hash of the configuration file
+   * @param channels - resolved channels
+   * @return true, if the cache exists, is valid and has the given hash
+   */
+  static bool load(const std::string& file, uint64_t hash, std::vector<ChannelConfig>& channels);
+};
+
+}
+}
+
+#endif // ORG_EEROS_HAL_CONFIGCACHE_HPP_
@@ -0,0 +1,59 @@
+#ifndef ORG_EEROS_HAL_GPIODIGIN_HPP_
+#define ORG_EEROS_HAL_GPIODIGIN_HPP_
+
+#include <eeros/hal/Input.hpp>
+#include <eeros/hal/GpioLines.hpp>
+#include <memory>
+#include <string>
+
+namespace eeros {
+namespace hal {
+
+/**
+ * Digital input on one line of a \ref GpioLines request of the GPIO character device.
+ * Several inputs can share one request, which is their batch: get() returns the
+ * value of the last read of all lines by HAL::updateInputs().
+ *
+ * @since v1.4.4
+ */
+class GpioDigIn : public Input<bool> {
+ public:
+  /**
+   * Constructs a digital input on a line of a request.
+   *
+   * @param id - name of the input
+   * @param libHandle - handle of the library
+   * @param lines - request of input lines
+   * @param line - index of the line in the request
+   * @param inverted - true, if the line is active low
+   */
+  GpioDigIn(std::string id, void* libHandle, std::shared_ptr<GpioLines> lines, unsigned int line, bool inverted = false)
+      : Input<bool>(id, libHandle), lines(lines), mask(1ull << line), inverted(inverted) { }
+
+  /**
+   * Disabling use of copy constructor because the block should never be copied unintentionally.
+   */
+  GpioDigIn(const GpioDigIn& s) = delete;
+
+  /**
+   * @return state of the digital input
+   */
+  virtual bool get() {
+    bool value = (lines->getValues() & mask) != 0;
+    return inverted ? !value : value;
+  }
+
+  virtual InputBatch* getBatch() {
+    return lines.get();
+  }
+
+ private:
+  std::shared_ptr<GpioLines> lines;
+  uint64_t mask;
+  bool inverted;
+};
+
+}
+}
+
+#endif /* ORG_EEROS_HAL_GPIODIGIN_HPP_ */
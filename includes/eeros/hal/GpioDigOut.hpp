@@ -0,0 +1,70 @@
+#ifndef ORG_EEROS_HAL_GPIODIGOUT_HPP_
+#define ORG_EEROS_HAL_GPIODIGOUT_HPP_
+
+#include <eeros/hal/Output.hpp>
+#include <eeros/hal/GpioLines.hpp>
+#include <memory>
+#include <string>
+
+namespace eeros {
+namespace hal {
+
+/**
+ * Digital output on one line of a \ref GpioLines request of the GPIO character device.
+ * Several outputs can share one request, which is their batch: set() stages the
+ * value and HAL::commitOutputs() writes all lines which changed at once.
+ * get() returns the value last set.
+ *
+ * @since v1.4.4
+ */
+class GpioDigOut : public Output<bool> {
+ public:
+  /**
+   * Constructs a digital output on a line of a request.
+   *
+   * @param id - name of the output
+   * @param libHandle - handle of the library
+   * @param lines - request of output lines
+   * @param line - index of the line in the request
+   * @param inverted - true, if the line is active low
+   */
+  GpioDigOut(std::string id, void* libHandle, std::shared_ptr<GpioLines> lines, unsigned int line, bool inverted = false)
+      : Output<bool>(id, libHandle), lines(lines), mask(1ull << line), inverted(inverted) { }
+
+  /**
+   * Disabling use of copy constructor because the block should never be copied unintentionally.
+   */
+  GpioDigOut(const GpioDigOut& s) = delete;
+
+  /**
+   * @return value last set
+   */
+  virtual bool get() {
+    return value;
+  }
+
+  /**
+   * Stages the value of the line.
+   *
+   * @param value - value
+   */
+  virtual void set(bool value) {
+    this->value = value;
+    lines->stage((value != inverted) ? mask : 0, mask);
+  }
+
+  virtual OutputBatch* getBatch() {
+    return lines.get();
+  }
+
+ private:
+  std::shared_ptr<GpioLines> lines;
+  uint64_t mask;
+  bool inverted;
+  bool value = false;
+};
+
+}
+}
+
+#endif /* ORG_EEROS_HAL_GPIODIGOUT_HPP_ */
@@ -0,0 +1,126 @@
+#ifndef ORG_EEROS_HAL_GPIOLINES_HPP_
+#define ORG_EEROS_HAL_GPIOLINES_HPP_
+
+#include <eeros/hal/Input.hpp>
+#include <eeros/hal/Output.hpp>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace eeros {
+namespace hal {
+
+/**
+ * A request of several lines of a GPIO chip through the GPIO character device,
+ * e.g. /dev/gpiochip0. It uses the same kernel interface as libgpiod, without
+ * depending on it. All lines of the request are read or written with a single
+ * ioctl, and edges of input lines are reported as events through poll().
+ * Line i of the request is bit i of the values.
+ *
+ * A request of inputs is an \ref InputBatch: HAL::updateInputs() reads all
+ * lines once per cycle and the inputs return the values of this read.
+ * A request of outputs is an \ref OutputBatch: outputs stage their values and
+ * HAL::commitOutputs() writes the lines which changed with one ioctl per cycle.
+ *
+ * @since v1.4.4
+ */
+class GpioLines : public InputBatch, public OutputBatch {
+ public:
+  enum class Direction { input, output };
+  enum class Edge { none, rising, falling, both };
+
+  /** An edge on one of the lines */
+  struct Event {
+    unsigned int line;    // index of the line in the request
+    bool rising;
+    uint64_t timestamp;   // nanoseconds, CLOCK_MONOTONIC
+  };
+
+  /**
+   * Requests lines of a GPIO chip.
+   *
+   * @param chip - path of the GPIO chip, e.g. /dev/gpiochip0
+   * @param offsets - offsets of the lines on the chip, at most 64
+   * @param direction - direction of all lines
+   * @param edge - edges reported by waitForEdge(), inputs only
+   * @param consumer - name of the consumer shown by the kernel
+   */
+  GpioLines(std::string chip, std::vector<unsigned int> offsets, Direction direction, Edge edge = Edge::none, std::string consumer = "eeros");
+
+  /**
+   * Releases the lines.
+   */
+  ~GpioLines();
+
+  GpioLines(const GpioLines&) = delete;
+  GpioLines& operator=(const GpioLines&) = delete;
+
+  /**
+   * Reads all lines with one ioctl.
+   *
+   * @return values, bit i is line i
+   */
+  uint64_t read();
+
+  /**
+   * Reads all lines with one ioctl and keeps the values, see getValues().
+   */
+  void update() override;
+
+  /**
+   * @return values of the last update(), bit i is line i
+   */
+  uint64_t getValues() const;
+
+  /**
+   * Stages the lines selected by mask, they are written by the next commit().
+   * May be called from several threads.
+   *
+   * @param values - values, bit i is line i
+   * @param mask - lines to stage
+   */
+  void stage(uint64_t values, uint64_t mask);
+
+  /**
+   * Writes the staged lines which changed with one ioctl.
+   */
+  void commit() override;
+
+  /**
+   * Writes the lines selected by mask with one ioctl.
+   *
+   * @param values - values, bit i is line i
+   * @param mask - lines to write
+   */
+  void write(uint64_t values, uint64_t mask = ~0ull);
+
+  /**
+   * Waits for an edge on one of the lines, needs an edge set on construction.
+   *
+   * @param timeout - timeout in milliseconds, -1 waits forever
+   * @param event - edge
+   * @return true, if an edge occurred before the timeout
+   */
+  bool waitForEdge(int timeout, Event& event);
+
+  /**
+   * @return number of lines
+   */
+  unsigned int size() const;
+
+ private:
+  int fd;
+  unsigned int nofLines;
+  std::vector<unsigned int> offsets;
+  std::atomic<uint64_t> values{0};
+  std::atomic<uint64_t> staged{0};
+  std::atomic<uint64_t> dirty{0};     // lines staged since the last commit
+  uint64_t written = 0;               // values of the last commit
+  uint64_t writtenMask = 0;           // lines written at least once
+};
+
+}
+}
+
+#endif /* ORG_EEROS_HAL_GPIOLINES_HPP_ */
@@ -1,15 +1,21 @@
 #ifndef ORG_EEROS_HAL_HAL_HPP_
 #define ORG_EEROS_HAL_HAL_HPP_
 
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <map>
+#include <type_traits>
+#include <mutex>
 #include <unordered_set>
+#include <vector>
 #include <eeros/hal/Input.hpp>
 #include <eeros/hal/Output.hpp>
 #include <eeros/hal/ScalableOutput.hpp>
 #include <eeros/hal/ScalableInput.hpp>
 #include <eeros/hal/JsonParser.hpp>
+#include <eeros/hal/InputRecorder.hpp>
 #include <eeros/core/Fault.hpp>
 #include "Input.hpp"
 
@@ -17,6 +23,47 @@
 namespace eeros {
 	namespace hal {
 		
+		/**
+		 * A feature function of a hardware wrapper library, resolved once for an
+		 * input or output. Calling it is a plain function call.
+		 * @see HAL::getInputFeatureHandle()
+		 * @see HAL::getOutputFeatureHandle()
+		 */
+		template<typename Obj, typename ... ArgTypes>
+		class FeatureHandle {
+		public:
+			FeatureHandle() : obj(nullptr), function(nullptr) { }
+			FeatureHandle(Obj* obj, void (*function)(Obj*, ArgTypes...)) : obj(obj), function(function) { }
+			
+			void operator()(ArgTypes... args) const { function(obj, args...); }
+			explicit operator bool() const { return function != nullptr; }
+			
+		private:
+			Obj* obj;
+			void (*function)(Obj*, ArgTypes...);
+		};
+		
+		template<typename ... ArgTypes> using InputFeature = FeatureHandle<InputInterface, ArgTypes...>;
+		template<typename ... ArgTypes> using OutputFeature = FeatureHandle<OutputInterface, ArgTypes...>;
+		
+		/**
+		 * Id of a channel of type T, resolved once with HAL::getInputId() or
+		 * HAL::getOutputId(). HAL::get() looks up a channel by its id with an
+		 * index into a vector.
+		 */
+		template<typename T>
+		class ChannelId {
+		public:
+			ChannelId() : index(invalid) { }
+			explicit operator bool() const { return index != invalid; }
+			
+		private:
+			friend class HAL;
+			explicit ChannelId(uint32_t index) : index(index) { }
+			static constexpr uint32_t invalid = UINT32_MAX;
+			uint32_t index;
+		};
+		
 		class HAL {
 		public:
 			template<typename T>
@@ -40,9 +87,134 @@ namespace eeros {
 			void releaseInput(std::string name);
 			void releaseOutput(std::string name);
 			
+			/**
+			 * Reads the process image: updates each batch of the claimed inputs once,
+			 * so a device reads all its inputs in one transaction.
+			 * The executor calls it at the start of each cycle.
+			 */
+			void updateInputs();
+			
+			/**
+			 * Writes the process image: commits each batch of the claimed outputs once,
+			 * so a device writes all its outputs in one transaction and they change
+			 * at the same moment. The executor calls it at the end of each cycle.
+			 */
+			void commitOutputs();
+			
 			bool addInput(InputInterface* systemInput);
 			bool addOutput(OutputInterface* systemOutput);
 			
+			/**
+			 * Adds an input which is created when it is first claimed or looked up.
+			 * The configuration file adds its channels this way, so devices and
+			 * channels which the application does not use are never opened.
+			 *
+			 * @param id - signal id of the input
+			 * @param create - creates the input
+			 * @return true
+			 */
+			bool addInput(std::string id, std::function<InputInterface*()> create);
+			
+			/**
+			 * Adds an output which is created when it is first claimed or looked up.
+			 *
+			 * @param id - signal id of the output
+			 * @param create - creates the output
+			 * @return true
+			 */
+			bool addOutput(std::string id, std::function<OutputInterface*()> create);
+			
+			/**
+			 * Resolves the id of an input. Ids are meant to be resolved at
+			 * configuration time, looking up the input with get() is then
+			 * O(1) and never allocates. Resolving an id does not claim the input.
+			 *
+			 * @param name - signal id of the input
+			 * @return id of the input
+			 */
+			template<typename T = InputInterface>
+			ChannelId<T> getInputId(const std::string& name) {
+				static_assert(std::is_base_of_v<InputInterface, T>, "T must be an input");
+				T* in = dynamic_cast<T*>(input(name));
+				if(in == nullptr) throw Fault("System input '" + name + "' not found!");
+				return ChannelId<T>(internInput(name, in));
+			}
+			
+			/**
+			 * Resolves the id of an output, see getInputId().
+			 *
+			 * @param name - signal id of the output
+			 * @return id of the output
+			 */
+			template<typename T = OutputInterface>
+			ChannelId<T> getOutputId(const std::string& name) {
+				static_assert(std::is_base_of_v<OutputInterface, T>, "T must be an output");
+				T* out = dynamic_cast<T*>(output(name));
+				if(out == nullptr) throw Fault("System output '" + name + "' not found!");
+				return ChannelId<T>(internOutput(name, out));
+			}
+			
+			/**
+			 * Looks up a channel by its id.
+			 *
+			 * @param id - id of the channel
+			 * @return channel
+			 */
+			template<typename T>
+			T* get(ChannelId<T> id) const {
+				if constexpr (std::is_base_of_v<InputInterface, T>) {
+					if(id.index >= inputTable.size()) throw Fault("invalid system input id");
+					return static_cast<T*>(inputTable[id.index]);
+				}
+				else {
+					if(id.index >= outputTable.size()) throw Fault("invalid system output id");
+					return static_cast<T*>(outputTable[id.index]);
+				}
+			}
+			
+			/**
+			 * Makes the HAL read-only. Afterwards, channels can neither be added
+			 * nor claimed and no further ids can be resolved, so no lookup allocates.
+			 * Call it when the configuration is complete, before the executor starts.
+			 */
+			void freeze();
+			
+			/**
+			 * Makes the HAL writable again, e.g. to reconfigure it after a restart.
+			 */
+			void unfreeze();
+			bool isFrozen() const;
+			
+			/**
+			 * Records the values read by the peripheral inputs into a file, which
+			 * the replay HAL library feeds back in, see InputRecorder.
+			 * Only peripheral inputs created afterwards are recorded.
+			 *
+			 * @param file - name of the recording file
+			 * @return true, if the file could be created
+			 */
+			bool recordInputs(std::string file);
+			
+			/**
+			 * Stops recording and writes all pending values.
+			 */
+			void stopRecording();
+			
+			/**
+			 * @return recorder, nullptr if the inputs are not recorded
+			 */
+			InputRecorder* getInputRecorder();
+			
+			/**
+			 * Keeps the resolved configuration in a binary cache file. A later
+			 * readConfigFromFile() with an unchanged configuration file loads the
+			 * channels from the cache instead of parsing the file and resolving the
+			 * scales, see \ref ConfigCache. A changed file rewrites the cache.
+			 *
+			 * @param file - path of the cache file, empty to disable the cache (default)
+			 */
+			void setConfigCache(std::string file);
+			
 			bool readConfigFromFile(std::string file);
 			bool readConfigFromFile(int* argc, char** argv);
 			
@@ -58,6 +230,22 @@ namespace eeros {
 				featureFunction(obj, args...);
 			}
 			
+			/**
+			 * Resolves a feature function of an output once.
+			 *
+			 * @param obj - output
+			 * @param featureName - name of the feature function
+			 * @return handle, which calls the feature function on obj
+			 */
+			template<typename ... ArgTypesOut>
+			OutputFeature<ArgTypesOut...> getOutputFeatureHandle(OutputInterface *obj, std::string featureName){
+				void (*featureFunction)(OutputInterface*, ArgTypesOut...) = reinterpret_cast<void(*)(OutputInterface*, ArgTypesOut...)>(getOutputFeature(obj, featureName));
+				if(featureFunction == nullptr){
+					throw Fault("could not find method in dynamic library: " + featureName);
+				}
+				return OutputFeature<ArgTypesOut...>(obj, featureFunction);
+			}
+			
 			template<typename ... ArgTypesIn>
 			void callInputFeature(InputInterface *obj, std::string featureName, ArgTypesIn... args){
 				
@@ -68,6 +256,22 @@ namespace eeros {
 				featureFunction(obj, args...);
 			}
 			
+			/**
+			 * Resolves a feature function of an input once.
+			 *
+			 * @param obj - input
+			 * @param featureName - name of the feature function
+			 * @return handle, which calls the feature function on obj
+			 */
+			template<typename ... ArgTypesIn>
+			InputFeature<ArgTypesIn...> getInputFeatureHandle(InputInterface *obj, std::string featureName){
+				void (*featureFunction)(InputInterface*, ArgTypesIn...) = reinterpret_cast<void(*)(InputInterface*, ArgTypesIn...)>(getInputFeature(obj, featureName));
+				if(featureFunction == nullptr){
+					throw Fault("could not find method in dynamic library: " + featureName);
+				}
+				return InputFeature<ArgTypesIn...>(obj, featureFunction);
+			}
+			
 		private:
 			HAL();
 			HAL(const HAL&);
@@ -79,17 +283,38 @@ namespace eeros {
 			void* getOutputFeature(OutputInterface * obj, std::string featureName);
 			void* getInputFeature(std::string name, std::string featureName);
 			void* getInputFeature(InputInterface * obj, std::string featureName);
+			void* getFeature(void* libHandle, const std::string& featureName);
+			void collectInputBatches();
+			void collectOutputBatches();
+			InputInterface* input(const std::string& name);
+			OutputInterface* output(const std::string& name);
+			uint32_t internInput(const std::string& name, InputInterface* in);
+			uint32_t internOutput(const std::string& name, OutputInterface* out);
 			
 			std::unordered_set<OutputInterface*> exclusiveReservedOutputs;
 			std::unordered_set<OutputInterface*> nonExclusiveOutputs;
 			std::unordered_set<InputInterface*> exclusiveReservedInputs;
 			std::unordered_set<InputInterface*> nonExclusiveInputs;
+			std::vector<InputBatch*> inputBatches;	// distinct batches of the claimed inputs
+			std::vector<OutputBatch*> outputBatches;	// distinct batches of the claimed outputs
 			
 			std::map<std::string, Handle<InputInterface>> inputs;
 			std::map<std::string, Handle<OutputInterface>> outputs;
+			std::map<std::string, std::function<InputInterface*()>> pendingInputs;	// added, but not created yet
+			std::map<std::string, std::function<OutputInterface*()>> pendingOutputs;
+			std::map<std::string, uint32_t> inputIds;
+			std::map<std::string, uint32_t> outputIds;
+			std::vector<InputInterface*> inputTable;	// indexed by ChannelId
+			std::vector<OutputInterface*> outputTable;
+			bool frozen = false;
 			
 			std::map<std::string, void*> hwLibraries;
+			std::map<std::pair<void*, std::string>, void*> features;	// resolved feature functions per library
+			std::mutex featureMtx;
+			bool loadConfig(std::string file);
 			JsonParser parser;
+			std::string configCache;
+			std::unique_ptr<InputRecorder> recorder;
 			
 			logger::Logger log;
 			
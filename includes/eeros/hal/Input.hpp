@@ -8,11 +8,28 @@
 namespace eeros {
 namespace hal {
 
+/**
+ * A batch of inputs of one device, e.g. the process image of a bus coupler.
+ * update() reads all inputs of the device in one transaction, get() of the
+ * inputs of the batch returns the values of the last update().
+ * update() is called by HAL::updateInputs() while other threads may call get(),
+ * so a batch must publish its values such that get() never sees a torn value.
+ */
+class InputBatch {
+ public:
+  virtual ~InputBatch() { }
+  virtual void update() = 0;
+};
+
 class InputInterface {
  public:
   virtual ~InputInterface() { }
   virtual std::string getId() const = 0;
   virtual void* getLibHandle() = 0;
+  /**
+   * @return batch of this input, nullptr if get() reads from the device itself
+   */
+  virtual InputBatch* getBatch() { return nullptr; }
 };
 
 template <typename T>
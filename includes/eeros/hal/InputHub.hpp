@@ -0,0 +1,79 @@
+#ifndef ORG_EEROS_HAL_INPUTHUB_HPP_
+#define ORG_EEROS_HAL_INPUTHUB_HPP_
+
+#include <eeros/logger/Logger.hpp>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace eeros {
+namespace hal {
+
+/**
+ * One thread which serves all human input devices like keyboard, mouse, XBox
+ * controller and space navigator. A device registers the non blocking file
+ * descriptor it reads from together with a handler. The thread waits for all
+ * of them with one epoll_wait() and calls the handler of a descriptor when
+ * data is available; the handler reads everything pending and publishes the
+ * new state of the device.
+ *
+ * @since v1.4.4
+ */
+class InputHub {
+ public:
+  /**
+   * Returns the hub, its thread is started on the first call.
+   *
+   * @return instance of the hub
+   */
+  static InputHub& instance();
+
+  ~InputHub();
+
+  InputHub(const InputHub&) = delete;
+  InputHub& operator=(const InputHub&) = delete;
+
+  /**
+   * Registers a file descriptor. The handler is called by the thread of the hub.
+   *
+   * @param fd - non blocking file descriptor
+   * @param handler - called when fd is readable
+   * @param priority - realtime priority of the thread, the highest requested is used, 20 for none
+   * @return false, if fd could not be registered
+   */
+  bool add(int fd, std::function<void()> handler, int priority = 20);
+
+  /**
+   * Unregisters a file descriptor. When it returns, the handler does not run
+   * and will not be called again, so the device may be destroyed.
+   *
+   * @param fd - file descriptor
+   */
+  void remove(int fd);
+
+  /**
+   * @return number of registered file descriptors
+   */
+  int getCount();
+
+ private:
+  InputHub();
+  void run();
+
+  int epollFd;
+  int wakeFd;
+  int priority = 20;
+  std::mutex mtx;
+  std::map<int, std::function<void()>> handlers;
+  std::atomic<bool> running{true};
+  logger::Logger log;
+  std::thread thread;
+};
+
+}
+}
+
+#endif // ORG_EEROS_HAL_INPUTHUB_HPP_
@@ -0,0 +1,158 @@
+#ifndef ORG_EEROS_HAL_INPUTRECORDER_HPP_
+#define ORG_EEROS_HAL_INPUTRECORDER_HPP_
+
+#include <eeros/core/SpscRingBuffer.hpp>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace eeros {
+namespace hal {
+
+/**
+ * Records the values which peripheral inputs read from the HAL into a compact
+ * binary file, so that a run can be replayed offline with the replay HAL library
+ * (libreplayeeros), see InputRecording.
+ *
+ * Each recorded input gets a channel with its own wait-free ring buffer, which is
+ * filled by the thread running the peripheral input. A background thread drains
+ * the ring buffers and writes the file. If a ring buffer is full, the value is
+ * dropped and counted, see getDropped(). A dropped value breaks the replay of its
+ * input, so the ring buffers hold ringSize values per input.
+ *
+ * File layout (native byte order): a header with magicNumber and formatVersion,
+ * followed by frames. A channel frame ('C') holds the index, the kind (logic or
+ * real) and the signal id of an input, a value frame ('V') holds the index and a
+ * number of consecutive values of an input, one byte per logic value and eight
+ * bytes per real value.
+ *
+ * @since v1.4.4
+ */
+class InputRecorder {
+ public:
+  static constexpr int ringSize = 1024;
+  static constexpr uint32_t magicNumber = 0x52484545;  // "EEHR"
+  static constexpr uint16_t formatVersion = 1;
+
+  /**
+   * Ring buffer of one recorded input.
+   */
+  class Channel {
+   public:
+    Channel(uint16_t index, std::string id, bool logic) : index(index), id(id), logic(logic) { }
+
+    /**
+     * Records a value. Must only be called by one thread.
+     *
+     * @param value - value read from the input
+     */
+    void push(double value) {
+      if (!ring.push(value)) dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const uint16_t index;
+    const std::string id;
+    const bool logic;
+
+   private:
+    friend class InputRecorder;
+    SpscRingBuffer<double, ringSize> ring;
+    std::atomic<uint64_t> dropped{0};
+  };
+
+  /**
+   * Creates the recording file and starts the background thread.
+   *
+   * @param file - file name
+   */
+  InputRecorder(std::string file);
+
+  /**
+   * Stops the background thread and writes all pending values.
+   */
+  ~InputRecorder();
+
+  /**
+   * Returns true, if the recording file could be created.
+   *
+   * @return true, if open
+   */
+  bool isOpen() const;
+
+  /**
+   * Adds an input to the recording. Not realtime safe, call it at configuration time.
+   *
+   * @param id - signal id of the input
+   * @param logic - true for a logic input
+   * @return channel of the input
+   */
+  Channel* addChannel(std::string id, bool logic);
+
+  /**
+   * @return number of values dropped because a ring buffer was full
+   */
+  uint64_t getDropped() const;
+
+ private:
+  void drain();
+  void run();
+
+  std::ofstream out;
+  std::deque<Channel> channels;
+  size_t defined = 0;  // channels already written to the file
+  mutable std::mutex mtx;
+  std::atomic<bool> running{true};
+  std::thread thread;
+};
+
+/**
+ * Recorded values of all inputs of a file written by an InputRecorder.
+ *
+ * @since v1.4.4
+ */
+class InputRecording {
+ public:
+  /**
+   * Reads a recording file.
+   *
+   * @param file - file name
+   */
+  InputRecording(std::string file);
+
+  /**
+   * Returns true, if the file could be read.
+   *
+   * @return true, if valid
+   */
+  bool isValid() const;
+
+  /**
+   * Returns the signal ids of all recorded inputs.
+   *
+   * @return signal ids
+   */
+  std::vector<std::string> getIds() const;
+
+  /**
+   * Returns the recorded values of an input in the order they were read.
+   *
+   * @param id - signal id of the input
+   * @return values, nullptr if the input was not recorded
+   */
+  const std::vector<double>* getValues(const std::string& id) const;
+
+ private:
+  std::map<std::string, std::vector<double>> values;
+  bool valid = false;
+};
+
+}
+}
+
+#endif // ORG_EEROS_HAL_INPUTRECORDER_HPP_
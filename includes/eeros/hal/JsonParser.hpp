@@ -2,6 +2,10 @@
 #define ORG_EEROS_HAL_JSONPARSER_HPP_
 
 #include <ucl++.h>
+#include <map>
+#include <string>
+#include <vector>
+#include <eeros/hal/ConfigCache.hpp>
 #include <eeros/logger/Logger.hpp>
 #include <eeros/SIUnit.hpp>
 
@@ -12,10 +16,37 @@ namespace eeros {
 		public:
 			JsonParser();
 			JsonParser(std::string filePath);
-			virtual void createHalObjects(std::map<std::string, void*> lib);
+			/**
+			 * Loads the libraries of the configured devices and adds their channels
+			 * to the HAL. A channel is only created when it is first claimed.
+			 * A device with "lazyBinding": true loads its library with RTLD_LAZY.
+			 * An input channel with "asyncPeriod" set is read by the AsyncPoller with
+			 * this period in sec, see \ref AsyncInput.
+			 *
+			 * @param lib - libraries already loaded, newly loaded ones are added
+			 */
+			virtual void createHalObjects(std::map<std::string, void*>& lib);
+			
+			/**
+			 * Resolves the channels of the configuration without loading any library,
+			 * the scales and ranges of each channel are folded into a single scale,
+			 * offset and range.
+			 *
+			 * @return channels
+			 */
+			std::vector<ChannelConfig> resolveChannels();
+			
+			/**
+			 * Loads the libraries of resolved channels and adds the channels to the HAL,
+			 * e.g. channels read from a \ref ConfigCache.
+			 *
+			 * @param channels - resolved channels
+			 * @param lib - libraries already loaded, newly loaded ones are added
+			 */
+			void createHalObjects(const std::vector<ChannelConfig>& channels, std::map<std::string, void*>& lib);
 		private:
-			virtual void createLogicObject(void *libHandle, std::string type, std::string id, std::string devHandle, uint32_t subDevNumber, uint32_t channelNumber, bool inverted, std::string additionalArguments);
-			virtual void createRealObject(void *libHandle, std::string type, std::string id, std::string devHandle, uint32_t subDevNumber, uint32_t channelNumber, double scale, double offset, double rangeMin, double rangeMax, double safe, SIUnit unit, std::string additionalArguments);
+			virtual void createLogicObject(void *libHandle, std::string type, std::string id, std::string devHandle, uint32_t subDevNumber, uint32_t channelNumber, bool inverted, std::string additionalArguments, double asyncPeriod);
+			virtual void createRealObject(void *libHandle, std::string type, std::string id, std::string devHandle, uint32_t subDevNumber, uint32_t channelNumber, double scale, double offset, double rangeMin, double rangeMax, double safe, SIUnit unit, std::string additionalArguments, double asyncPeriod);
 			virtual void parseChannelProperties(ucl::Ucl chanObj, std::string *chanType, std::string *sigId, double *scale, double *offset, double *rangeMin, double *rangeMax, double* safe, std::string *chanUnit, bool *inverted, std::string *additionalArguments);
 			virtual void createComediFqd(void *libHandle, std::string type, std::string id, std::string devHandle, uint32_t subDevNumber, uint32_t channelA, uint32_t channelB, uint32_t channelZ, double scale, double offset, double rangeMin, double rangeMax, std::string unit);
 
@@ -1,6 +1,8 @@
 #ifndef ORG_EEROS_HAL_KEYLIST_HPP_
 #define ORG_EEROS_HAL_KEYLIST_HPP_
 
+#include <atomic>
+#include <deque>
 #include <vector>
 #include <string>
 
@@ -11,6 +13,8 @@ namespace hal {
  * This class is part of the hardware abstraction layer. 
  * It holds registered keyboard keys, which in turn can be read by a control block
  * input or a critical input to the safety system.
+ * The states are written by the input thread and read by the control and
+ * safety system, they are atomic so that no lock is needed.
  *
  * @since v1.2
  */
@@ -42,8 +46,8 @@ class KeyList {
     for (auto k : asciiCode) {
       this->key.push_back(name[nofKeys]);
       this->asciiCode.push_back(k);
-      this->state.push_back(false);
-      this->event.push_back(false);
+      this->state.emplace_back(false);
+      this->event.emplace_back(false);
       nofKeys++;
     }
   }
@@ -51,8 +55,8 @@ class KeyList {
   uint8_t nofKeys;
   std::vector<std::string> key;
   std::vector<char> asciiCode;
-  std::vector<bool> state;
-  std::vector<bool> event;
+  std::deque<std::atomic<bool>> state;
+  std::deque<std::atomic<bool>> event;
 };
 
 }
@@ -2,7 +2,6 @@
 #define ORG_EEROS_HAL_KEYBOARD_HPP_
 
 #include <termios.h>
-#include <eeros/core/Thread.hpp>
 
 namespace eeros {
 namespace hal {
@@ -11,18 +10,25 @@ namespace hal {
  * This class is part of the hardware abstraction layer. 
  * It is used by \ref eeros::control::KeyboardInput and \ref eeros::hal::KeyboardDigIn class. 
  * Do not use it directly.
+ * The standard input is read by the thread of the \ref InputHub whenever keys 
+ * were pressed, there is no polling.
  *
  * @since v0.6
  */
-class Keyboard : public Thread {
+class Keyboard {
  public:
+  /**
+   * Sets the terminal to non canonical mode and registers the standard input with the \ref InputHub.
+   *
+   * @param priority - realtime priority of the input thread
+   */
   explicit Keyboard(int priority);
   ~Keyboard();
   
  private:
-  virtual void run();
-  bool running;
+  void onReadable();
   struct termios tio;
+  int flags;
 };
 
 }
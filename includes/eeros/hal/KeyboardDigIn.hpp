@@ -41,9 +41,7 @@ class KeyboardDigIn : public Input<bool> {
   virtual bool get() {
     for (uint8_t i = 0; i < list.nofKeys; i++) {
       if (list.key[i] == getId()) {
-        bool val = list.event[i];  
-        list.event[i] = false;
-        return val;
+        return list.event[i].exchange(false);
       }
     }
     return false;
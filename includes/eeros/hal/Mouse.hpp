@@ -6,7 +6,7 @@
 #include <atomic>
 #include <linux/input.h>
 #include <eeros/hal/Input.hpp>
-#include <eeros/core/Thread.hpp>
+#include <eeros/logger/Logger.hpp>
 #include <eeros/core/AsyncBuffer.hpp>
 
 #define MOUSE_BUTTON_COUNT (16)
@@ -33,11 +33,20 @@ struct MouseState {
  * This class is part of the hardware abstraction layer. 
  * It is used by \ref eeros::control::MouseInput and \ref eeros::hal::MouseDigIn class. 
  * Do not use it directly.
+ * The device is read by the thread of the \ref InputHub as soon as events
+ * arrive. All pending events are processed at once and the resulting state is
+ * published to \ref current and \ref last, which can be read without locking.
  *
  * @since v0.6
  */
-class Mouse : public eeros::Thread {
+class Mouse {
  public:
+  /**
+   * Opens the input device and registers it with the \ref InputHub.
+   *
+   * @param dev - path of the input device, e.g. /dev/input/event1
+   * @param priority - realtime priority of the input thread
+   */
   explicit Mouse(std::string dev, int priority);
   ~Mouse();
   virtual void on_event(std::function<void(struct input_event)> action);
@@ -49,11 +58,13 @@ class Mouse : public eeros::Thread {
   eeros::AsyncBuffer<MouseState> last;
 
  private:
-  virtual void run();
+  void onReadable();
   virtual bool open(const char* device);
   virtual void close();
   int fd;
-  std::atomic<bool> running{false};
+  MouseState currentState{};
+  MouseState lastState{};
+  eeros::logger::Logger log;
   std::function<void(struct input_event)> event_action;
   std::function<void(int, bool)> button_action;
   std::function<void(int, signed)> axis_action;
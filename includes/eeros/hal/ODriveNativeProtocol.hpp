@@ -0,0 +1,103 @@
+#ifndef ORG_EEROS_HAL_ODRIVENATIVEPROTOCOL_HPP_
+#define ORG_EEROS_HAL_ODRIVENATIVEPROTOCOL_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace eeros {
+namespace hal {
+
+/**
+ * Framing of the ODrive native protocol on a byte stream like a UART.
+ * A frame consists of the sync byte 0xAA, the length of the packet, a CRC8
+ * of these two bytes, the packet and a CRC16 of the packet (big endian).
+ *
+ * A request packet holds a sequence number, the endpoint id, the expected
+ * response size, the payload written and the CRC of the JSON description of
+ * the endpoints. A response packet holds the sequence number with bit 15 set
+ * and the payload read. Requests can be pipelined, as every response can
+ * be matched to its request by the sequence number.
+ *
+ * The parser is fed byte by byte and resynchronizes on the next sync byte
+ * after a corrupted or truncated frame.
+ *
+ * @since v1.4.4
+ */
+class ODriveNativeProtocol {
+ public:
+  static constexpr uint8_t sync = 0xAA;
+  static constexpr int maxPacket = 127;
+
+  /**
+   * @param jsonCrc - CRC of the JSON description of the endpoints of the firmware
+   */
+  explicit ODriveNativeProtocol(uint16_t jsonCrc = 0x9b40);
+
+  /**
+   * Appends the frame of a request to a buffer.
+   *
+   * @param out - buffer the frame is appended to
+   * @param endpoint - endpoint id
+   * @param payload - value written, nullptr for reads and functions
+   * @param length - length of the value written
+   * @param responseSize - size of the value read
+   * @param ack - the odrive responds to the request
+   * @return sequence number of the request
+   */
+  uint16_t request(std::vector<uint8_t>& out, uint16_t endpoint, const void* payload, int length,
+                   int responseSize, bool ack = true);
+
+  /**
+   * Appends a frame with an arbitrary packet to a buffer.
+   *
+   * @param out - buffer the frame is appended to
+   * @param packet - packet
+   * @param length - length of the packet, at most maxPacket
+   */
+  static void frame(std::vector<uint8_t>& out, const uint8_t* packet, int length);
+
+  /**
+   * Feeds one received byte to the parser.
+   *
+   * @param b - byte received
+   * @return true, if b completed a valid response, see getSeqNo() and getPayload()
+   */
+  bool parse(uint8_t b);
+
+  /**
+   * @return sequence number of the last complete response
+   */
+  uint16_t getSeqNo() const;
+
+  /**
+   * @return payload of the last complete response
+   */
+  const uint8_t* getPayload() const;
+
+  /**
+   * @return length of the payload of the last complete response
+   */
+  int getPayloadLength() const;
+
+  /**
+   * @return number of frames dropped because of a wrong CRC or length
+   */
+  uint64_t getErrors() const;
+
+  static uint8_t crc8(uint8_t crc, const uint8_t* data, std::size_t length);
+  static uint16_t crc16(uint16_t crc, const uint8_t* data, std::size_t length);
+
+ private:
+  uint16_t jsonCrc;
+  uint16_t seqNo = 0;
+  uint8_t rx[3 + maxPacket + 2];
+  int rxIndex = 0;
+  int rxLength = 0;
+  uint64_t errors = 0;
+};
+
+}
+}
+
+#endif /* ORG_EEROS_HAL_ODRIVENATIVEPROTOCOL_HPP_ */
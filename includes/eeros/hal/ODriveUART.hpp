@@ -4,14 +4,23 @@
 #include <eeros/logger/Logger.hpp>
 #include <eeros/core/Thread.hpp>
 #include <eeros/hal/HAL.hpp>
+#include <eeros/hal/ODriveNativeProtocol.hpp>
 #include <eeros/core/Fault.hpp>
+#include <eeros/core/SeqlockBuffer.hpp>
+#include <eeros/core/System.hpp>
 #include <eeros/math/Matrix.hpp>
 #include <errno.h>
 #include <fcntl.h> 
 #include <termios.h>
 #include <iomanip>
 #include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <cstring>
+#include <vector>
 
 # define FULL_STATE_CALIBRATION 3
 # define CLOSED_LOOP_CONTROL 8
@@ -26,8 +35,56 @@ namespace eeros {
 namespace hal {
 
 // this class is not fully tested yet !!
+/**
+ * Communicates with an ODrive over UART, either with the ASCII protocol, one
+ * request and response per value, or with the native protocol.
+ *
+ * In native mode, a timer starts a cycle in every period. The setpoints are
+ * written without acknowledge, then the telemetry set is read with up to
+ * window requests in flight; a new request is sent for every response received.
+ * The thread waits for the UART and the timer with epoll, the UART is non blocking.
+ * A complete telemetry set is published through a sequence lock, see getTelemetry().
+ * Calibration and the change of the axis states still use ASCII commands,
+ * the odrive accepts both protocols on the same UART.
+ */
 class ODriveUART : public eeros::Thread {
  public: 
+  static constexpr int maxProperties = 16;
+
+  /**
+   * Type of a property in native mode.
+   */
+  enum class Type { boolean, int32, uint32, float32 };
+
+  /**
+   * A property of the odrive, given by its endpoint id in the JSON description of the firmware.
+   */
+  struct Property {
+    uint16_t endpoint;
+    Type type;
+  };
+
+  /**
+   * Configuration of the native mode.
+   * The first two properties of the telemetry set are returned by getVel(),
+   * the first two setpoints are set by setSpeed().
+   */
+  struct NativeConfig {
+    std::vector<Property> telemetry;
+    std::vector<Property> setpoints;
+    std::chrono::microseconds period{1000};
+    int window = 4;             // requests in flight
+    uint16_t jsonCrc = 0x9b40;  // CRC of the JSON description of the firmware
+  };
+
+  /**
+   * Values of the telemetry set, in the order of the configuration.
+   */
+  struct Telemetry {
+    double values[maxProperties];
+    uint64_t timestamp;  // time the last value was received
+  };
+
   /**
    * Constructs a Thread to communicate with ODrive Device over UART \n
    *
@@ -45,11 +102,37 @@ class ODriveUART : public eeros::Thread {
     sleep(1);  // wait to be finished..
     starting = false;
   }
+
+  /**
+   * Constructs a Thread to communicate with ODrive Device over UART with the native protocol \n
+   *
+   * @param dev - string with device id
+   * @param speed - communication speed of UART
+   * @param parity - parity bit set or not
+   * @param priority - execution priority of this thread
+   * @param config - telemetry set, setpoints and timing
+   */
+  ODriveUART(std::string dev, int speed, int parity, int priority, const NativeConfig& config)
+      : Thread(priority), starting(true), running(false), native(true), config(config),
+        protocol(config.jsonCrc), log(Logger::getLogger('P')) {
+    if (config.telemetry.size() > maxProperties || config.setpoints.size() > maxProperties)
+      throw eeros::Fault("too many odrive properties configured");
+    if (config.window < 1) throw eeros::Fault("odrive request window must be at least 1");
+    openTty(dev, speed, parity);
+    calibrate_motors();
+    sleep(15);  // wait to be finished..
+    set_closed_loop_control();
+    sleep(1);  // wait to be finished..
+    fcntl(ttyFd, F_SETFL, fcntl(ttyFd, F_GETFL) | O_NONBLOCK);
+    starting = false;
+  }
     
   /**
    * Destructs a Thread to get and send data from and to odrive \n
    */
   ~ODriveUART(){
+    running = false;
+    join();
     for (int i = 0; i <= nofaxis_odrive - 1; i++) {
        setSpeed(i, 0);
       // Set axis to IDLE
@@ -60,7 +143,6 @@ class ODriveUART : public eeros::Thread {
       int n = write(ttyFd, str.c_str(), str.length());
       if (n < 0) log.error() << "error " << errno << " set axes to idle -> write to ODrive device failed";
     }
-    running = false;
     closeTty();
   }
         
@@ -90,6 +172,13 @@ class ODriveUART : public eeros::Thread {
    * @param motor_id - motor id (0 or 1)
    */
   double getVel(int motor_id){
+    if (native) {
+      Telemetry t{};
+      telemetry.read(t);
+      if (motor_id >= 0 && motor_id < 2 && motor_id < (int)config.telemetry.size()) return t.values[motor_id];
+      log.error() << "Wrong motor ID. Encoder speed not valid";
+      return 0;
+    }
     if(motor_id == 0)
       return encoder_vel0;
     else if(motor_id == 1)
@@ -100,12 +189,49 @@ class ODriveUART : public eeros::Thread {
     }
   }
   
+  /**
+   * Reads a consistent copy of the latest telemetry set in native mode.
+   *
+   * @param t - target
+   * @return true, if a consistent copy could be made
+   */
+  bool getTelemetry(Telemetry& t) const {
+    return telemetry.read(t);
+  }
+
+  /**
+   * Sets a setpoint in native mode, it is written in the next cycle.
+   *
+   * @param index - index of the setpoint in the configuration
+   * @param value - value
+   */
+  void setSetpoint(int index, double value) {
+    if (index >= 0 && index < (int)config.setpoints.size()) setpoints[index] = value;
+  }
+
+  /**
+   * @return number of telemetry sets not completed within their period
+   */
+  uint64_t getIncomplete() const {
+    return incomplete.load(std::memory_order_relaxed);
+  }
+
   /**
    * Sets speed setpoint \n
    * @param motor - motor id (0 or 1)
    * @param speed - speed to be set to the motor
    */
-  void setSpeed(int motor, int speed);
+  void setSpeed(int motor, int speed) {
+    if (native && running) {
+      setSetpoint(motor, speed);
+      return;
+    }
+    std::stringstream stream;
+    stream << "v " << motor << " " << speed << '\r';
+    std::string str(stream.str());
+    int n = write(ttyFd, str.c_str(), str.length());
+    if (n < 0) log.error() << "error " << errno << " setSpeed() -> write to ODrive device failed";
+  }
   
  private:
   /**
@@ -229,20 +355,170 @@ class ODriveUART : public eeros::Thread {
   virtual void run() {
     while(starting);
     running = true;
-    static int count = 0;
+    if (native) {
+      runNative();
+      return;
+    }
     while (running) {
-      setSpeed(0, 10000);
       get_vel_from_encoder(0);
       get_vel_from_encoder(1);
-      count++;
-      if (count % 100 == 0)
-        std::cout << eeros::System::getTimeNs() << std::endl;
     }
   }
-  
+
+  static int sizeOf(Type type) {
+    return type == Type::boolean ? 1 : 4;
+  }
+
+  static double decode(Type type, const uint8_t* data) {
+    switch (type) {
+      case Type::boolean: return data[0] != 0;
+      case Type::int32: {int32_t v; memcpy(&v, data, 4); return v;}
+      case Type::uint32: {uint32_t v; memcpy(&v, data, 4); return v;}
+      default: {float v; memcpy(&v, data, 4); return v;}
+    }
+  }
+
+  static void encode(Type type, double value, uint8_t* data) {
+    switch (type) {
+      case Type::boolean: data[0] = value != 0; break;
+      case Type::int32: {int32_t v = value; memcpy(data, &v, 4); break;}
+      case Type::uint32: {uint32_t v = value; memcpy(data, &v, 4); break;}
+      default: {float v = value; memcpy(data, &v, 4); break;}
+    }
+  }
+
+  /**
+   * Writes all bytes queued in tx, waits for the UART to accept them
+   */
+  void send() {
+    std::size_t done = 0;
+    while (done < tx.size() && running) {
+      ssize_t n = write(ttyFd, tx.data() + done, tx.size() - done);
+      if (n > 0) done += n;
+      else if (n < 0 && errno != EAGAIN && errno != EINTR) {
+        log.error() << "error " << errno << " write to ODrive device failed";
+        break;
+      }
+      else usleep(100);
+    }
+    tx.clear();
+  }
+
+  /**
+   * Sends the next request of the telemetry set
+   */
+  void requestNext() {
+    const Property& p = config.telemetry[requested];
+    seqNos[requested] = protocol.request(tx, p.endpoint, nullptr, 0, sizeOf(p.type));
+    requested++;
+  }
+
+  /**
+   * Starts a cycle: writes the setpoints and sends the first requests of the telemetry set
+   */
+  void startCycle() {
+    if (received < (int)config.telemetry.size()) incomplete.fetch_add(1, std::memory_order_relaxed);
+    for (std::size_t i = 0; i < config.setpoints.size(); i++) {
+      uint8_t data[4];
+      encode(config.setpoints[i].type, setpoints[i], data);
+      protocol.request(tx, config.setpoints[i].endpoint, data, sizeOf(config.setpoints[i].type), 0, false);
+    }
+    requested = 0;
+    received = 0;
+    while (requested < (int)config.telemetry.size() && requested < config.window) requestNext();
+    send();
+  }
+
+  /**
+   * Parses the bytes received, stores the values of the responses and keeps the window filled
+   */
+  void receive() {
+    uint8_t buf[256];
+    ssize_t n;
+    while ((n = read(ttyFd, buf, sizeof(buf))) > 0) {
+      for (ssize_t i = 0; i < n; i++) {
+        if (!protocol.parse(buf[i])) continue;
+        for (int j = 0; j < requested; j++) {
+          const Property& p = config.telemetry[j];
+          if (seqNos[j] != protocol.getSeqNo() || protocol.getPayloadLength() < sizeOf(p.type)) continue;
+          latest.values[j] = decode(p.type, protocol.getPayload());
+          seqNos[j] = invalidSeqNo;
+          received++;
+          if (requested < (int)config.telemetry.size()) requestNext();
+          break;
+        }
+      }
+    }
+    send();
+    if (received == (int)config.telemetry.size() && received > 0 && !published) {
+      latest.timestamp = System::getTimeNs();
+      telemetry.write(latest);
+      published = true;
+    }
+  }
+
+  /**
+   * Main loop in native mode, driven by epoll on the UART and a periodic timer
+   */
+  void runNative() {
+    int timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (timerFd < 0 || epollFd < 0) {
+      log.error() << "error " << errno << " could not create odrive timer";
+      if (timerFd >= 0) close(timerFd);
+      if (epollFd >= 0) close(epollFd);
+      return;
+    }
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(config.period).count();
+    itimerspec spec;
+    spec.it_interval = {static_cast<time_t>(ns / 1000000000), static_cast<long>(ns % 1000000000)};
+    spec.it_value = spec.it_interval;
+    timerfd_settime(timerFd, 0, &spec, nullptr);
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = ttyFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, ttyFd, &ev);
+    ev.data.fd = timerFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, timerFd, &ev);
+
+    received = config.telemetry.size();  // no incomplete set before the first cycle
+    while (running) {
+      epoll_event events[2];
+      int n = epoll_wait(epollFd, events, 2, 100);
+      for (int i = 0; i < n; i++) {
+        if (events[i].data.fd == timerFd) {
+          uint64_t expirations;
+          if (read(timerFd, &expirations, sizeof(expirations)) > 0) {
+            published = false;
+            startCycle();
+          }
+        } else {
+          receive();
+        }
+      }
+    }
+    close(epollFd);
+    close(timerFd);
+  }
+
+  static constexpr int invalidSeqNo = 0xFFFF;
+
   int ttyFd;
-  std::atomic<double> starting, running;
+  std::atomic<bool> starting, running;
   std::atomic<double> encoder_vel0, encoder_vel1;
+  bool native = false;
+  NativeConfig config;
+  ODriveNativeProtocol protocol;
+  std::array<std::atomic<double>, maxProperties> setpoints{};
+  SeqlockBuffer<Telemetry> telemetry;
+  std::atomic<uint64_t> incomplete{0};
+  // owned by the thread
+  Telemetry latest{};
+  std::vector<uint8_t> tx;
+  int seqNos[maxProperties];
+  int requested = 0;
+  int received = 0;
+  bool published = false;
   Logger log;
 };
 
@@ -1,10 +1,15 @@
 #ifndef ORG_EEROS_HAL_ODRIVE_USB_HP
 #define ORG_EEROS_HAL_ODRIVE_USB_HP
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cstring>
 #include <jsoncpp/json/json.h>
 #include <math.h>
 #include <eeros/logger/Logger.hpp>
+#include <eeros/core/SeqlockBuffer.hpp>
+#include <eeros/core/System.hpp>
 #include <eeros/core/Thread.hpp>
 #include <odrive/odriveEP.hpp>
 
@@ -30,10 +35,27 @@ namespace hal {
  * It is used by \ref eeros::control::ODriveUSBInput class. 
  * Do not use it directly.
  *
+ * Once calibrated, the thread exchanges all cyclic properties of both axes in one
+ * batch per millisecond: every property is an ODrive packet of its own, and all
+ * request and response transfers of a batch are submitted at once with
+ * libusb_submit_transfer(), so they share the USB frames instead of waiting for
+ * each other. The measurements are published through a sequence lock, see getTelemetry().
+ *
  * @since v1.3
  */
 class ODriveUSB : public eeros::Thread {
  public: 
+  /**
+   * Latest measurements of both axes.
+   */
+  struct Telemetry {
+    float vel[2];
+    float iqMeasured[2];
+    float iqSetpoint[2];
+    bool endstop[2];
+    uint64_t timestamp;  // time of the batch
+  };
+
   /**
    * Constructs a thread to communicate with ODrive device over USB \n
    *
@@ -52,6 +74,11 @@ class ODriveUSB : public eeros::Thread {
       log.error() << std::hex << "odrive with serial number 0x" << serialNr << " not found";
     }
     config();
+    for (auto& r : requests) {
+      r.out = libusb_alloc_transfer(0);
+      r.in = libusb_alloc_transfer(0);
+      if (r.out == nullptr || r.in == nullptr) log.error() << "could not allocate usb transfers";
+    }
     starting = false;
   }
       
@@ -59,17 +86,24 @@ class ODriveUSB : public eeros::Thread {
    * Destructs the thread to get and send data from and to odrive \n
    */
   ~ODriveUSB() {
+    // stop the thread first, no transfer may be in flight below
+    terminate = true;
+    running = false;
+    join();
     // Set speed to zero
     ep->setData(param_m0_input_vel, (float)0.0); // motor0 vel_setpoint 
     ep->setData(param_m1_input_vel, (float)0.0); // motor1 vel_setpoint
     disableDrives();
     disable_watchdog();
+    for (auto& r : requests) {
+      libusb_free_transfer(r.out);
+      libusb_free_transfer(r.in);
+    }
     delete ep;
     if (libusbContext) { 
       libusb_exit(libusbContext); 
       libusbContext = NULL;
     }
-    running = false;
   }
 
   
@@ -202,9 +236,29 @@ class ODriveUSB : public eeros::Thread {
     return 0;
   }
   
+  /**
+   * Reads a consistent copy of the latest measurements of both axes.
+   * Never blocks the thread communicating with the odrive.
+   *
+   * @param t - target
+   * @return true, if a consistent copy could be made
+   */
+  bool getTelemetry(Telemetry& t) const {
+    return telemetry.read(t);
+  }
+
+  /**
+   * @return number of failed usb transfers
+   */
+  uint64_t getTransferErrors() const {
+    return transferErrors.load(std::memory_order_relaxed);
+  }
+
   double getEncoderVel(int motor, int turns_per_rev) {
-    if (motor == 0) return encoder_vel0 / turns_per_rev;
-    else if (motor == 1) return encoder_vel1 / turns_per_rev;
+    Telemetry t{};
+    telemetry.read(t);
+    if (motor == 0) return t.vel[0] / turns_per_rev;
+    else if (motor == 1) return t.vel[1] / turns_per_rev;
     else {
       log.error() << "Wrong motor ID. Encoder speed not valid";
       return 0;
@@ -218,13 +272,11 @@ class ODriveUSB : public eeros::Thread {
   }
   
   void enableDrives(){
-    ep->setData(param_a0_requested_state, AXIS_STATE_CLOSED_LOOP_CONTROL);
-    ep->setData(param_a1_requested_state, AXIS_STATE_CLOSED_LOOP_CONTROL);
+    requestState(AXIS_STATE_CLOSED_LOOP_CONTROL);
   }
   
   void disableDrives(){
-    ep->setData(param_a0_requested_state, AXIS_STATE_IDLE);
-    ep->setData(param_a1_requested_state, AXIS_STATE_IDLE);
+    requestState(AXIS_STATE_IDLE);
   }
   
   void startCalibration(){
@@ -232,7 +284,9 @@ class ODriveUSB : public eeros::Thread {
   }
   
   bool isEndstopActive(){	
-    return (endpoint_state0 || endpoint_state1);
+    Telemetry t{};
+    telemetry.read(t);
+    return (t.endstop[0] || t.endstop[1]);
   }
   
   /**
@@ -251,8 +305,10 @@ class ODriveUSB : public eeros::Thread {
    * @return current setpoint of motor
    */
   double getCurrentSetpoint(int motor){
-    if (motor == 0) return iq_setpoint0;
-    else if (motor == 1) return iq_setpoint1;
+    Telemetry t{};
+    telemetry.read(t);
+    if (motor == 0) return t.iqSetpoint[0];
+    else if (motor == 1) return t.iqSetpoint[1];
     else {
       log.error() << "Wrong motor ID. Current not valid";
       return 0;
@@ -266,8 +322,10 @@ class ODriveUSB : public eeros::Thread {
    * @return current of motor
    */
   double getCurrentMeasured(int motor){
-    if (motor == 0) return iq_measured0;
-    else if (motor == 1) return iq_measured1;
+    Telemetry t{};
+    telemetry.read(t);
+    if (motor == 0) return t.iqMeasured[0];
+    else if (motor == 1) return t.iqMeasured[1];
     else {
       log.error() << "Wrong motor ID. Current not valid";
       return 0;
@@ -278,6 +336,24 @@ class ODriveUSB : public eeros::Thread {
   Json::Value json;
   
  private:
+  static constexpr int maxRequests = 16;
+  static constexpr int packetSize = ODRIVE_MAX_BYTES_TO_RECEIVE;
+  static constexpr auto period = std::chrono::milliseconds(1);
+
+  /**
+   * One property exchanged in a batch, with its request and response transfer.
+   */
+  struct Request {
+    libusb_transfer* out = nullptr;
+    libusb_transfer* in = nullptr;
+    uint8_t tx[packetSize];
+    uint8_t rx[packetSize];
+    int length;      // length of the request packet
+    uint16_t seqNo;
+    void* value;     // target of a read, nullptr for writes and functions
+    int size;        // size of the value read
+  };
+
   libusb_context* libusbContext;
   uint64_t serialNr;
   float encTicks;
@@ -286,11 +362,141 @@ class ODriveUSB : public eeros::Thread {
   bool calibrated = false;
   int nof_motors;
   std::atomic<bool> starting, running;
-  std::atomic<double> encoder_vel0, encoder_vel1;
+  std::atomic<bool> terminate{false};
   std::atomic<float> ref_vel0, ref_vel1;
-  std::atomic<bool> endpoint_state0, endpoint_state1;
-  std::atomic<double> iq_setpoint0, iq_setpoint1, iq_measured0, iq_measured1;
+  std::atomic<int> requestedState{0};
+  std::atomic<uint64_t> transferErrors{0};
+  SeqlockBuffer<Telemetry> telemetry;
+  Telemetry latest{};  // owned by the thread
+  Request requests[maxRequests];
+  int nofRequests = 0;
+  int pending = 0;     // transfers in flight, only touched by the thread
+  uint16_t seqNo = 0;
   Logger log;
+
+  /**
+   * Sets the requested state of both axes. While the cyclic batches run, the
+   * request is sent with the next batch, as the endpoints are used by the batch.
+   */
+  void requestState(int state) {
+    if (running) {
+      requestedState = state;
+    } else {
+      ep->setData(param_a0_requested_state, state);
+      ep->setData(param_a1_requested_state, state);
+    }
+  }
+
+  /**
+   * Adds an ODrive packet to the current batch.
+   *
+   * @param id - endpoint id of the property or function
+   * @param payload - value written, nullptr for reads and functions
+   * @param length - length of the value written
+   * @param value - target of the value read, nullptr for writes and functions
+   * @param size - size of the value read
+   * @return false, if the batch is full
+   */
+  bool queue(int id, const void* payload, int length, void* value, int size) {
+    if (nofRequests >= maxRequests || length + 8 > packetSize) return false;
+    Request& r = requests[nofRequests++];
+    seqNo = (seqNo + 1) & 0x7fff;
+    r.seqNo = seqNo;
+    r.value = value;
+    r.size = size;
+    uint16_t header[3] = {seqNo, static_cast<uint16_t>(id | 0x8000), static_cast<uint16_t>(size)};
+    int n = 0;
+    for (uint16_t h : header) {
+      r.tx[n++] = h & 0xFF;
+      r.tx[n++] = h >> 8;
+    }
+    if (length > 0) memcpy(&r.tx[n], payload, length);
+    n += length;
+    r.tx[n++] = ODRIVE_DEFAULT_CRC_VALUE & 0xFF;
+    r.tx[n++] = ODRIVE_DEFAULT_CRC_VALUE >> 8;
+    r.length = n;
+    return true;
+  }
+
+  template<typename T> void queueRead(int id, T& value) {queue(id, nullptr, 0, &value, sizeof(T));}
+  template<typename T> void queueWrite(int id, const T& value) {queue(id, &value, sizeof(T), nullptr, 0);}
+  void queueFunc(int id) {queue(id, nullptr, 0, nullptr, 0);}
+
+  static void LIBUSB_CALL transferDone(libusb_transfer* t) {
+    static_cast<ODriveUSB*>(t->user_data)->pending--;
+  }
+
+  /**
+   * Submits all request and response transfers of the batch, waits until
+   * all of them are completed and stores the values read. The responses are
+   * matched to the requests by their sequence numbers.
+   */
+  void transfer() {
+    for (int i = 0; i < nofRequests; i++) {
+      Request& r = requests[i];
+      libusb_fill_bulk_transfer(r.out, ep->devHandle, ODRIVE_OUT_EP, r.tx, r.length, transferDone, this, ODRIVE_TIMEOUT);
+      libusb_fill_bulk_transfer(r.in, ep->devHandle, ODRIVE_IN_EP, r.rx, packetSize, transferDone, this, ODRIVE_TIMEOUT);
+      r.in->status = LIBUSB_TRANSFER_ERROR;
+      if (libusb_submit_transfer(r.out) != LIBUSB_SUCCESS) {
+        transferErrors.fetch_add(1, std::memory_order_relaxed);
+        continue;
+      }
+      pending++;
+      if (libusb_submit_transfer(r.in) != LIBUSB_SUCCESS) {
+        transferErrors.fetch_add(1, std::memory_order_relaxed);
+        continue;
+      }
+      pending++;
+    }
+    timeval tv = {0, 10000};
+    while (pending > 0) libusb_handle_events_timeout_completed(libusbContext, &tv, nullptr);
+    for (int i = 0; i < nofRequests; i++) {
+      libusb_transfer* in = requests[i].in;
+      if (in->status != LIBUSB_TRANSFER_COMPLETED || in->actual_length < 2) {
+        transferErrors.fetch_add(1, std::memory_order_relaxed);
+        continue;
+      }
+      uint16_t seq = (requests[i].rx[0] | (requests[i].rx[1] << 8)) & 0x7fff;
+      for (int j = 0; j < nofRequests; j++) {
+        Request& r = requests[j];
+        if (r.seqNo != seq) continue;
+        if (r.value != nullptr) memcpy(r.value, &requests[i].rx[2], std::min(r.size, in->actual_length - 2));
+        break;
+      }
+    }
+  }
+
+  /**
+   * Exchanges setpoints and measurements of both axes in one batch and
+   * publishes the measurements.
+   *
+   * @param feedWatchdog - feeds the watchdog of both axes in this batch
+   */
+  void cycle(bool feedWatchdog) {
+    nofRequests = 0;
+    queueWrite(param_m0_input_vel, ref_vel0.load());
+    queueWrite(param_m1_input_vel, ref_vel1.load());
+    int state = requestedState.exchange(0);
+    if (state != 0) {
+      queueWrite(param_a0_requested_state, state);
+      queueWrite(param_a1_requested_state, state);
+    }
+    if (feedWatchdog) {
+      queueFunc(fcn_a0_watchdog_feed);
+      queueFunc(fcn_a1_watchdog_feed);
+    }
+    queueRead(param_m0_enc_vel_estimate, latest.vel[0]);
+    queueRead(param_m1_enc_vel_estimate, latest.vel[1]);
+    queueRead(param_m0_iq_measured, latest.iqMeasured[0]);
+    queueRead(param_m1_iq_measured, latest.iqMeasured[1]);
+    queueRead(param_m0_iq_setpoint, latest.iqSetpoint[0]);
+    queueRead(param_m1_iq_setpoint, latest.iqSetpoint[1]);
+    queueRead(param_m0_endstop_state, latest.endstop[0]);
+    queueRead(param_m1_endstop_state, latest.endstop[1]);
+    transfer();
+    latest.timestamp = System::getTimeNs();
+    telemetry.write(latest);
+  }
   
   /**
    * Configures odrive: clears errors, sets watchdog, endpoints, control mode, gains  \n
@@ -427,50 +633,13 @@ class ODriveUSB : public eeros::Thread {
   }
   
   /**
-   * Returns velocity values of motors connected to odrive \n
-   */
-  void get_vel_from_odrive(){
-    float vel0, vel1;
-    ep->getData(param_m0_enc_vel_estimate, vel0); // encoder, vel_estimate
-    ep->getData(param_m1_enc_vel_estimate, vel1); // encoder, vel_estimate
-    encoder_vel0 = vel0;
-    encoder_vel1 = vel1;
-  }
-  
-  /**
-   * Sets velocity setpoints of motors connected to odrive \n
-   */
-  void set_vel_to_odrive(){
-    float vel0 = ref_vel0;
-    ep->setData(param_m0_input_vel, vel0);
-    float vel1 = ref_vel1;
-    ep->setData(param_m1_input_vel, vel1);
-  }
-  
-  /**
-   * Returns endpoint state from odrive \n
+   * Returns endpoint state from odrive, used until the cyclic batches run \n
    */
   void get_endpoint_state_from_odrive(){
-    bool ep0, ep1; 
-    ep->getData(param_m0_endstop_state, ep0);
-    ep->getData(param_m1_endstop_state, ep1);
-    endpoint_state0 = ep0;
-    endpoint_state1 = ep1;
-  }
-  
-  /**
-   * Returns current value from odrive \n
-   */
-  void get_current_from_odrive(){
-    float iq_m_0, iq_s_0, iq_m_1, iq_s_1;
-    ep->getData(param_m0_iq_measured, iq_m_0); 
-    ep->getData(param_m0_iq_setpoint, iq_s_0); 
-    ep->getData(param_m1_iq_measured, iq_m_1); 
-    ep->getData(param_m1_iq_setpoint, iq_s_1); 
-    iq_measured0 = iq_m_0;
-    iq_setpoint0 = iq_s_0;
-    iq_measured1 = iq_m_1;
-    iq_setpoint1 = iq_s_1;
+    ep->getData(param_m0_endstop_state, latest.endstop[0]);
+    ep->getData(param_m1_endstop_state, latest.endstop[1]);
+    latest.timestamp = System::getTimeNs();
+    telemetry.write(latest);
   }
   
   /**
@@ -481,6 +650,7 @@ class ODriveUSB : public eeros::Thread {
     int count = 0; // for watchdog feed
     
     while(!startCalibrationCmd){
+      if (terminate) return;
       get_endpoint_state_from_odrive(); // emergency button
       usleep(10000);
     }
@@ -491,6 +661,7 @@ class ODriveUSB : public eeros::Thread {
     enable_watchdog();
     
     while(!calibrated){
+      if (terminate) return;
       get_endpoint_state_from_odrive(); // emergency button
       
       if (count % 500 == 0) {
@@ -501,16 +672,14 @@ class ODriveUSB : public eeros::Thread {
       usleep(10000);
     }
     running = true;
-    while (running) {
-      set_vel_to_odrive();
-      get_vel_from_odrive();
-      get_endpoint_state_from_odrive(); // emergency button
-      if (count % 500 == 0) {
-        ep->execFunc(fcn_a0_watchdog_feed);
-        ep->execFunc(fcn_a1_watchdog_feed);
-        count = 0;
-      } else count++;
-      usleep(1000);
+    auto next = std::chrono::steady_clock::now();
+    while (!terminate) {
+      cycle(count == 0);
+      count = (count + 1) % 500;
+      next += period;
+      auto now = std::chrono::steady_clock::now();
+      if (next < now) next = now;  // do not catch up after an overrun
+      std::this_thread::sleep_until(next);
     }
   }
   
@@ -8,6 +8,18 @@
 namespace eeros {
 namespace hal {
 
+/**
+ * A batch of outputs of one device, e.g. the process image of a bus coupler.
+ * Outputs of the batch buffer the values passed to set(), commit() writes
+ * them to the device in one transaction, and may skip values which did not change.
+ * commit() is called by HAL::commitOutputs() and SafetySystem::run().
+ */
+class OutputBatch {
+ public:
+  virtual ~OutputBatch() { }
+  virtual void commit() = 0;
+};
+
 /**
  * Base class for all output classes
  */
@@ -16,6 +28,10 @@ class OutputInterface {
   virtual ~OutputInterface() { }
   virtual std::string getId() const = 0;
   virtual void* getLibHandle() = 0;
+  /**
+   * @return batch of this output, nullptr if set() writes to the device at once
+   */
+  virtual OutputBatch* getBatch() { return nullptr; }
 };
 
 template <typename T>
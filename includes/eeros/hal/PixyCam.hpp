@@ -6,9 +6,12 @@
 #include <eeros/math/Matrix.hpp>
 #include <eeros/logger/Logger.hpp>
 #include <eeros/core/Thread.hpp>
+#include <eeros/core/System.hpp>
+#include <eeros/core/SeqlockBuffer.hpp>
 #include <pixy2/libpixyusb2.h>
 #include <unistd.h>
 #include <atomic>
+#include <cstdint>
 
 #define nrDots 4
 
@@ -28,22 +31,43 @@ namespace hal {
  * code, eeros cannot be built with pixy code in it and all the 
  * code has been placed into this header file.
  *
+ * The thread requests the blocks of every new frame of the camera without
+ * pausing. Each result is evaluated and published together with the time it was
+ * acquired, replacing the previous one. Readers always get the newest detection,
+ * older ones are dropped and nobody waits for the USB transfer.
+ *
  * @since v1.3
  */
 
 class PixyCam : public eeros::Thread {
  public:
+  /**
+   * Result of one frame of the camera.
+   */
+  struct Detection {
+    Matrix<nrDots,2,double> dots;   // position of the dots in pixels
+    Vector3 pos;                    // x, y, phi, lowpass filtered
+    Vector3 posRaw;                 // x, y, phi
+    double height = 0;
+    bool valid = false;             // all markers detected and within the field of view
+    int nofBlocks = 0;
+    uint64_t frame = 0;             // number of the frame since start
+    uint64_t timestamp = 0;         // time of acquisition, see System::getTimeNs()
+  };
+
   explicit PixyCam(std::string dev, int priority) : starting(true), running(false), log(Logger::getLogger()) {
     log.info() << "Connecting to Pixy2";
     auto res = pixy.init();
     if (res < 0) {
       log.warn() << "no connection to Pixy2 possible";
+      starting = false;
       return;
     } else log.info() << "Pixy2 connected";
     pixy.getVersion();
     log.info() << "Pixy2 version = " << pixy.version;
     // Set Pixy2 to color connected components program 
     pixy.changeProg("color_connected_components");
+    connected = true;
     starting = false;
   }
   
@@ -51,9 +75,19 @@ class PixyCam : public eeros::Thread {
    * Destructs the thread.
    */
   virtual ~PixyCam() { 
-    pixy.setLamp(0, 0);
     running = false; 
     join(); 
+    if (connected) pixy.setLamp(0, 0);
+  }
+
+  /**
+   * Reads a consistent copy of the newest detection, never blocks.
+   *
+   * @param detection - target
+   * @return true, if a consistent copy could be made
+   */
+  virtual bool getDetection(Detection& detection) const {
+    return detections.read(detection);
   }
 
   /**
@@ -61,54 +95,67 @@ class PixyCam : public eeros::Thread {
    * markers pattern, with lowpass filter
    */
   virtual Vector3 getPos() {
-    return output;
+    return newest().pos;
   }
   
   /**
    * Returns the position of the camera, with respect to the middle of the markers pattern 
    */
   virtual Vector3 getPosRaw() {
-    return outputRaw;
+    return newest().posRaw;
   }
   
   /**
    * Returns the position of the detected dots on the markers pattern in pixels 
    */
   virtual Matrix<nrDots,2,double> getDots() {
-    return pos;
+    return newest().dots;
   }
 
   /**
    * Returns the height of the camera to the markers pattern
    */
   virtual double getHeight() {
-    return height;
+    return newest().height;
   }
   
   /**
    * Returns true if data are valid, i.e. if all markers are within the field of view of the camera
    */
   virtual double isDataValid() {
-    return valid;
+    return newest().valid;
   }
   
   /**
    * Returns the nu,ber of markers detected by the camera
    */
   virtual int getNofBlocks() {
-    return nofBlocks;
+    return newest().nofBlocks;
+  }
+
+  /**
+   * Returns the number of failed requests for blocks
+   */
+  virtual uint64_t getErrors() const {
+    return errors.load(std::memory_order_relaxed);
   }
 
   /**
-   * Sets the lamp of the camera
+   * Sets the lamp of the camera. The request is passed to the thread
+   * which owns the USB connection.
    * @param white: white light on if true
    * @param rgb: rgb light on if true
    */
   virtual void setLamp(bool white, bool rgb) {
-    pixy.setLamp(white, rgb);
+    lamp.store((white ? 1 : 0) | (rgb ? 2 : 0) | 4, std::memory_order_relaxed);
   }
 
  private:
+  Detection newest() const {
+    Detection d{};
+    detections.read(d);
+    return d;
+  }
     
   /**
    * Gets sensor data and outputs position of the camera with respect to the middle of the markers pattern. 
@@ -116,113 +163,133 @@ class PixyCam : public eeros::Thread {
    */
   virtual void run() {
     while (starting); 
+    if (!connected) return;
     running = true;
+    Detection d;
     while (running) {
-      pixy.ccc.getBlocks();
-      nofBlocks = pixy.ccc.numBlocks;
-      for(int i=0;i<nrDots; i++) {
-        auto block = pixy.ccc.blocks[i];
-        pos(i,0) = block.m_x;
-        pos(i,1) = block.m_y;
+      int l = lamp.exchange(0, std::memory_order_relaxed);
+      if (l != 0) pixy.setLamp(l & 1, (l & 2) >> 1);
+      // waits for the next frame of the camera, there is no backlog of older frames
+      auto res = pixy.ccc.getBlocks(true);
+      d.timestamp = eeros::System::getTimeNs();
+      if (res < 0) {
+        errors.fetch_add(1, std::memory_order_relaxed);
+        usleep(1000);
+        continue;
       }
-      double i_x_min = 0;
-      double i_x_max = 0;
-      double i_y_min = 0;
-      double i_y_max = 0;
-      double xO = 0;
-      double yO = 0;
-
-      for (int i=0; i<4; i++) {
-        xO = xO + pos.get(i,0)/4;
-        yO = yO + pos.get(i,1)/4;
-        if (pos.get(i,0) < pos.get(i_x_min,0))
-          i_x_min = i;
-        if (pos.get(i,0) > pos.get(i_x_max,0))
-          i_x_max = i;
-        if (pos.get(i,1) < pos.get(i_y_min,1))
-          i_y_min = i;
-        if (pos.get(i,1) > pos.get(i_y_max,1))
-          i_y_max = i;
+      d.frame++;
+      d.nofBlocks = pixy.ccc.numBlocks;
+      if (d.nofBlocks < nrDots) {
+        // blocks behind numBlocks are left over from older frames
+        d.valid = false;
+        detections.write(d);
+        continue;
       }
+      evaluate(d);
+      detections.write(d);
+    }
+  }
+
+  void evaluate(Detection& d) {
+    auto& pos = d.dots;
+    for(int i=0;i<nrDots; i++) {
+      auto block = pixy.ccc.blocks[i];
+      pos(i,0) = block.m_x;
+      pos(i,1) = block.m_y;
+    }
+  double i_x_min = 0;
+    double i_x_max = 0;
+    double i_y_min = 0;
+    double i_y_max = 0;
+    double xO = 0;
+    double yO = 0;
+
+    for (int i=0; i<4; i++) {
+      xO = xO + pos.get(i,0)/4;
+      yO = yO + pos.get(i,1)/4;
+      if (pos.get(i,0) < pos.get(i_x_min,0))
+        i_x_min = i;
+      if (pos.get(i,0) > pos.get(i_x_max,0))
+        i_x_max = i;
+      if (pos.get(i,1) < pos.get(i_y_min,1))
+        i_y_min = i;
+      if (pos.get(i,1) > pos.get(i_y_max,1))
+        i_y_max = i;
+    }
+  
+    // Shift centre ref system to middle
+    xO = xO - max_pixel_x/2;
+    yO = yO - max_pixel_y/2;
+
+    double scaling_height = 3.02 / (3.02 + 1.43);
+    double distWorld = 0.335 * scaling_height; 
+    double distCam = (sqrt((pos.get(i_x_max,0) - pos.get(i_x_min,0)) * (pos.get(i_x_max,0) - pos.get(i_x_min,0))
+          + (pos.get(i_x_max,1) - pos.get(i_x_min,1)) * (pos.get(i_x_max,1) - pos.get(i_x_min,1)) )
+          + sqrt((pos.get(i_y_max,0) - pos.get(i_y_min,0)) * (pos.get(i_y_max,0) - pos.get(i_y_min,0))
+          + (pos.get(i_y_max,1) - pos.get(i_y_min,1)) * (pos.get(i_y_max,1) - pos.get(i_y_min,1))))/2;
+  
+    // Define height from markers
+    double pixel_fix = 93;     // pixel
+    double height_fix = 0.915; // m
+    d.height = pixel_fix * height_fix / distCam;
+  
+    // Define if markers in central region on picture
+    if(pos.get(i_x_min,0) > delta_pixel_range && pos.get(i_x_min,0) < (max_pixel_x-delta_pixel_range) &&
+    pos.get(i_x_max,0) > delta_pixel_range && pos.get(i_x_max,0) < (max_pixel_x-delta_pixel_range) &&
+    pos.get(i_y_min,0) > delta_pixel_range && pos.get(i_y_min,0) < (max_pixel_x-delta_pixel_range) &&
+    pos.get(i_y_max,0) > delta_pixel_range && pos.get(i_y_max,0) < (max_pixel_x-delta_pixel_range) &&
+    pos.get(i_x_min,1) > delta_pixel_range && pos.get(i_x_min,1) < (max_pixel_y-delta_pixel_range) &&
+    pos.get(i_x_max,1) > delta_pixel_range && pos.get(i_x_max,1) < (max_pixel_y-delta_pixel_range) &&
+    pos.get(i_y_min,1) > delta_pixel_range && pos.get(i_y_min,1) < (max_pixel_y-delta_pixel_range) &&
+    pos.get(i_y_max,1) > delta_pixel_range && pos.get(i_y_max,1) < (max_pixel_y-delta_pixel_range) )
+      markersInRange = true;
+    else
+      markersInRange = false;
+  
+    d.valid = (d.height < height_limit && markersInRange);
+                
+    double xS = xO * distWorld / distCam;
+    double yS = yO * distWorld / distCam;
+
+    double phiS = (atan2((pos.get(i_x_max,1) - pos.get(i_x_min,1)), (pos.get(i_x_max,0) - pos.get(i_x_min,0)))
+          + atan2((pos.get(i_y_min,0) - pos.get(i_y_max,0)), (pos.get(i_y_max,1) - pos.get(i_y_min,1)))) / 2;
     
-      // Shift centre ref system to middle
-      xO = xO - max_pixel_x/2;
-      yO = yO - max_pixel_y/2;
-
-      double scaling_height = 3.02 / (3.02 + 1.43);
-      double distWorld = 0.335 * scaling_height; 
-      double distCam = (sqrt((pos.get(i_x_max,0) - pos.get(i_x_min,0)) * (pos.get(i_x_max,0) - pos.get(i_x_min,0))
-            + (pos.get(i_x_max,1) - pos.get(i_x_min,1)) * (pos.get(i_x_max,1) - pos.get(i_x_min,1)) )
-            + sqrt((pos.get(i_y_max,0) - pos.get(i_y_min,0)) * (pos.get(i_y_max,0) - pos.get(i_y_min,0))
-            + (pos.get(i_y_max,1) - pos.get(i_y_min,1)) * (pos.get(i_y_max,1) - pos.get(i_y_min,1))))/2;
-    
-      // Define height from markers
-      double pixel_fix = 93;     // pixel
-      double height_fix = 0.915; // m
-      height = pixel_fix * height_fix / distCam;
-    
-      // Define if markers in central region on picture
-      if(pos.get(i_x_min,0) > delta_pixel_range && pos.get(i_x_min,0) < (max_pixel_x-delta_pixel_range) &&
-      pos.get(i_x_max,0) > delta_pixel_range && pos.get(i_x_max,0) < (max_pixel_x-delta_pixel_range) &&
-      pos.get(i_y_min,0) > delta_pixel_range && pos.get(i_y_min,0) < (max_pixel_x-delta_pixel_range) &&
-      pos.get(i_y_max,0) > delta_pixel_range && pos.get(i_y_max,0) < (max_pixel_x-delta_pixel_range) &&
-      pos.get(i_x_min,1) > delta_pixel_range && pos.get(i_x_min,1) < (max_pixel_y-delta_pixel_range) &&
-      pos.get(i_x_max,1) > delta_pixel_range && pos.get(i_x_max,1) < (max_pixel_y-delta_pixel_range) &&
-      pos.get(i_y_min,1) > delta_pixel_range && pos.get(i_y_min,1) < (max_pixel_y-delta_pixel_range) &&
-      pos.get(i_y_max,1) > delta_pixel_range && pos.get(i_y_max,1) < (max_pixel_y-delta_pixel_range) )
-        markersInRange = true;
-      else
-        markersInRange = false;
-    
-      if(height < height_limit && markersInRange == true) valid = true;
-      else valid = false;
-                  
-      double xS = xO * distWorld / distCam;
-      double yS = yO * distWorld / distCam;
-
-      double phiS = (atan2((pos.get(i_x_max,1) - pos.get(i_x_min,1)), (pos.get(i_x_max,0) - pos.get(i_x_min,0)))
-            + atan2((pos.get(i_y_min,0) - pos.get(i_y_max,0)), (pos.get(i_y_max,1) - pos.get(i_y_min,1)))) / 2;
-      
-      // Filtering
-      double alpha_xy = 0.05; 
-      double alpha_phi = 0.1; 
-      double xS_filtered, yS_filtered, phiS_filtered;
-    
-      if(first){
-        xS_filtered = xS;
-        yS_filtered = yS;
-        phiS_filtered = phiS;
-        first = false;
-      } else {
-        xS_filtered = xS*alpha_xy + xS_prev*(1-alpha_xy);
-        yS_filtered = yS*alpha_xy + yS_prev*(1-alpha_xy);
-        phiS_filtered = phiS*alpha_phi + phiS_prev*(1-alpha_phi);
-      }
-      xS_prev = xS_filtered;
-      yS_prev = yS_filtered;
-      phiS_prev = phiS_filtered;
-
-      double xS_out_f, yS_out_f;
-      xS_out_f = yS_filtered;
-      yS_out_f = xS_filtered;
-        
-      // Set output 
-      outputRaw << xS, yS, phiS;
-      output << xS_out_f, yS_out_f, phiS_filtered;
-      
-      usleep(5000);
+    // Filtering
+    double alpha_xy = 0.05; 
+    double alpha_phi = 0.1; 
+    double xS_filtered, yS_filtered, phiS_filtered;
+  
+    if(first){
+      xS_filtered = xS;
+      yS_filtered = yS;
+      phiS_filtered = phiS;
+      first = false;
+    } else {
+      xS_filtered = xS*alpha_xy + xS_prev*(1-alpha_xy);
+      yS_filtered = yS*alpha_xy + yS_prev*(1-alpha_xy);
+      phiS_filtered = phiS*alpha_phi + phiS_prev*(1-alpha_phi);
     }
+    xS_prev = xS_filtered;
+    yS_prev = yS_filtered;
+    phiS_prev = phiS_filtered;
+
+    double xS_out_f, yS_out_f;
+    xS_out_f = yS_filtered;
+    yS_out_f = xS_filtered;
+      
+    // Set output 
+    d.posRaw << xS, yS, phiS;
+    d.pos << xS_out_f, yS_out_f, phiS_filtered;
   }
   
   std::atomic<bool> starting;
   std::atomic<bool> running;
+  bool connected = false;
   bool first = true;
-  bool valid = false;
   bool markersInRange = false;
-  int nofBlocks;
-  Matrix<nrDots,2,double> pos;
-  Vector3 output, outputRaw;
-  double height = 0;
+  SeqlockBuffer<Detection> detections;
+  std::atomic<int> lamp{0};
+  std::atomic<uint64_t> errors{0};
   Pixy2 pixy;
   Logger log;
   double xS_prev = 0;
@@ -6,9 +6,11 @@
 #include <eeros/control/TimeDomain.hpp>
 #include <eeros/logger/Logger.hpp>
 #include <eeros/core/Thread.hpp>
+#include <eeros/core/TripleBuffer.hpp>
 #include <eeros/math/Matrix.hpp>
 #include <rplidar.h>
 #include <atomic>
+#include <limits>
 
 #define LASER_COUNT_MAX 380
 
@@ -24,10 +26,27 @@ namespace hal {
  * It is used by \ref eeros::control::RPLidarInput class. 
  * Do not use it directly.
  *
+ * The thread fills a complete scan in the back slot of a triple buffer and
+ * publishes it with one atomic exchange, so a scan is never torn and the reader
+ * gets it as a const view without copying, see getScan(). All getters read
+ * the triple buffer and must be called by the same thread.
+ *
  * @since v1.3
  */
 class RPLidar : public eeros::Thread {
  public:
+  /**
+   * One 360 degrees' scan in ascending angles; slots from count on are infinity,
+   * as a LaserScan message expects for missing measurements.
+   */
+  struct Scan {
+    Scan() : angles(std::numeric_limits<double>::infinity()), ranges(std::numeric_limits<double>::infinity()),
+             intensities(std::numeric_limits<double>::infinity()) { }
+    Vector<LASER_COUNT_MAX,double> angles, ranges, intensities;
+    int count = LASER_COUNT_MAX;  // number of measurements
+    uint64_t timestamp = 0;       // time the scan was received
+  };
+
   /**
    * Constructs a Thread to get RPLidar (Laserscanner) sensors data. \n
    *
@@ -48,6 +67,15 @@ class RPLidar : public eeros::Thread {
    */
   float getScanFrequency();
   
+  /**
+   * Gets the latest scan. The view stays valid and unchanged until the
+   * next call. Must only be called by one thread, the reader.
+   *
+   * @param newScan - set to true, if the scan was published since the last call
+   * @return latest scan
+   */
+  const Scan& getScan(bool& newScan);
+
   /**
    * Gets angles where a range has been measured
    * 
@@ -77,7 +105,7 @@ class RPLidar : public eeros::Thread {
   std::atomic<bool> starting;
   std::atomic<bool> running;
   Logger log;
-  Vector<LASER_COUNT_MAX,double> angles, ranges, intensities; 
+  TripleBuffer<Scan> scans;
 };
 
 }
@@ -4,9 +4,9 @@
 #ifdef EEROS_USE_REALSENSE
 
 #include <eeros/core/Runnable.hpp>
+#include <eeros/core/SeqlockBuffer.hpp>
 #include <eeros/control/TimeDomain.hpp>
 #include <eeros/logger/Logger.hpp>
-#include <eeros/core/Thread.hpp>
 #include <eeros/math/Matrix.hpp>
 #include <librealsense2/rs.hpp>
 #include <librealsense2/h/rs_types.h>
@@ -23,10 +23,24 @@ namespace hal {
  * This class is part of the hardware abstraction layer. 
  * It is used by \ref eeros::control::RealsenseT265Input class. 
  * Do not use it directly.
+ *
+ * The pose stream is delivered by the callback of librealsense, which writes
+ * each pose into a sequence lock, so no thread of its own polls the device.
  * @since v1.3
  */
-class RealsenseT265 : public Thread {
+class RealsenseT265 {
  public:
+  /**
+   * A pose of the tracking system with its derivatives.
+   */
+  struct Pose {
+    Vector3 translation, velocity, acceleration, angVelocity, angAcceleration;
+    Vector4 quaternion;             // w, x, y, z
+    unsigned int confidence = 0;    // 0 failed, 1 low, 2 medium, 3 high
+    double deviceTime = 0;          // timestamp of the device in ms
+    uint64_t timestamp = 0;         // time of the pose in the time base of System::getTimeNs()
+  };
+
   // struct to store trajectory points
   struct tracked_point {
     rs2_vector point;
@@ -34,43 +48,49 @@ class RealsenseT265 : public Thread {
   };
   
   /**
-   * Constructs a Thread to get Realsense Tracking T265 sensors data \n
+   * Starts the pose stream of a Realsense Tracking T265 sensor \n
    * Calls RealsenseT265(std::string dev, int priority)
    *
    * @see RealsenseT265(std::string dev, int priority)
    * @param dev - string with device name (USB3)
-   * @param priority - execution priority or RealsenseT265 thread, to get sensors data
+   * @param priority - not used, the poses are delivered by the thread of librealsense
    */
   explicit RealsenseT265(std::string dev, int priority); 
   
   /**
-   * Destructs a Thread to get RealsenseT265 sensors data \n
+   * Stops the pose stream \n
    */
   ~RealsenseT265();
   
-  Vector3 translation, velocity, acceleration, angVelocity, angAcceleration;
-  Vector4 quaternion;
+  /**
+   * Reads a consistent copy of the latest pose, never blocks.
+   *
+   * @param pose - target
+   * @return true, if a consistent copy could be made
+   */
+  bool getPose(Pose& pose) const;
 
- private:
   /**
-   * Runs methods for data acquisition from sensor
-   * Gets data, performs scaling, saves tracked_point information on a vector
-   * @see calc_transform
-   * @see tracked_point
+   * Returns the sequence number of the latest pose, which changes with every pose.
+   *
+   * @return sequence number
    */
-  virtual void run();
-  
+  uint32_t getSequence() const;
+
   /**
    * Calculates transformation matrix based on pose data from the device 
-   * Is called by the run() method
-   * @see run()
    */
-  void calc_transform(rs2_pose& pose_data, float mat[16]);
+  static void calc_transform(rs2_pose& pose_data, float mat[16]);
+
+ private:
+  /**
+   * Called by librealsense for every frame, stores the pose
+   */
+  void onFrame(const rs2::frame& frame);
      
   rs2::pipeline pipe;  // Declare RealSense pipeline, encapsulating the actual device and sensors
   rs2::config cfg;     // Create a configuration for configuring the pipeline with a non default profile
-  std::atomic<bool> starting;
-  std::atomic<bool> running;
+  SeqlockBuffer<Pose> pose;
   Logger log;
 };
 
@@ -5,6 +5,9 @@
 
 #include <eeros/logger/Logger.hpp>
 #include <eeros/core/Thread.hpp>
+#include <eeros/core/SeqlockBuffer.hpp>
+#include <eeros/core/SpscRingBuffer.hpp>
+#include <eeros/core/System.hpp>
 #include <eeros/math/Matrix.hpp>
 #include <sbgEComLib.h>
 #include <atomic>
@@ -20,10 +23,35 @@ namespace hal {
  * It is used by \ref eeros::control::SBGEllipseAInput class. 
  * Do not use it directly.
  *
+ * The logs are decoded in the thread of this class. Every IMU sample is pushed
+ * into a preallocated wait-free ring with its device timestamp, so a reader can
+ * consume all samples since its last run, see popImuSample(). The latest EKF
+ * orientation is published through a sequence lock, see getEkf().
+ *
  * @since v1.3
  */
 class SBGEllipseA : public eeros::Thread {
  public: 
+  static constexpr int ringSize = 1024;  // 1 s at 1 kHz
+
+  /**
+   * One sample of accelerometers and gyroscopes.
+   */
+  struct ImuSample {
+    Vector3 acc, gyro;
+    uint32_t deviceTime;  // timestamp of the device in us
+    uint64_t timestamp;   // time the sample was received, see System::getTimeNs()
+  };
+
+  /**
+   * Latest orientation of the EKF.
+   */
+  struct Ekf {
+    Vector3 euler;
+    Vector4 quaternion;
+    uint32_t timestampEuler = 0, timestampQuat = 0;  // timestamps of the device in us
+  };
+
   /**
    * Constructs a thread to get SBGEllipseA (IMU) sensors data \n
    *
@@ -55,7 +83,7 @@ class SBGEllipseA : public eeros::Thread {
       configureLogsLowRate();   // IMU data, euler angles and quaternions (200Hz) -> see "sbgEComCmdOutput.c"
     }
     errorCode = sbgEComCmdSettingsAction(&comHandle, SBG_ECOM_SAVE_SETTINGS);
-    errorCode = sbgEComSetReceiveLogCallback(&comHandle, onLogReceived, NULL); // -> see: sbgECom.c
+    errorCode = sbgEComSetReceiveLogCallback(&comHandle, onLogReceived, this); // -> see: sbgECom.c
     starting = false;
   }
           
@@ -69,10 +97,34 @@ class SBGEllipseA : public eeros::Thread {
     sbgInterfaceSerialDestroy(&sbgInterface);
   }
     
-  static Vector3 eulerData, accData, gyroData;
-  static Vector4 quatData;
-  static uint32_t timestampEuler, timestampQuat, timestampAcc, timestampGyro;
-  static uint32_t count, count0, countEuler, countQuat, countImu;
+  /**
+   * Takes the oldest IMU sample not consumed yet. Must only be called by one thread.
+   *
+   * @param sample - target
+   * @return false, if there is no new sample
+   */
+  bool popImuSample(ImuSample& sample) {
+    return imuSamples.pop(sample);
+  }
+
+  /**
+   * Reads a consistent copy of the latest EKF orientation, never blocks.
+   *
+   * @param ekf - target
+   * @return true, if a consistent copy could be made
+   */
+  bool getEkf(Ekf& ekf) const {
+    return this->ekf.read(ekf);
+  }
+
+  /**
+   * @return number of IMU samples dropped because the ring was full
+   */
+  uint64_t getDropped() const {
+    return dropped.load(std::memory_order_relaxed);
+  }
+
+  std::atomic<uint32_t> count{0}, count0{0}, countEuler{0}, countQuat{0}, countImu{0};
   
  private:
   std::atomic<bool> starting;
@@ -83,6 +135,20 @@ class SBGEllipseA : public eeros::Thread {
   SbgInterface sbgInterface;
   int32 retValue;
   SbgEComDeviceInfo deviceInfo;
+  SpscRingBuffer<ImuSample, ringSize> imuSamples;
+  SeqlockBuffer<Ekf> ekf;
+  Ekf latestEkf;  // owned by the thread
+  std::atomic<uint64_t> dropped{0};
+
+  void pushImu(const float acc[3], const float gyro[3], uint32_t deviceTime) {
+    ImuSample s;
+    s.acc << acc[0], acc[1], acc[2];
+    s.gyro << gyro[0], gyro[1], gyro[2];
+    s.deviceTime = deviceTime;
+    s.timestamp = System::getTimeNs();
+    if (!imuSamples.push(s)) dropped.fetch_add(1, std::memory_order_relaxed);
+    countImu++;
+  }
     
   /**
    * Main run method. Gets sensor measurements \n
@@ -146,50 +212,38 @@ class SBGEllipseA : public eeros::Thread {
    * @return SBG_NO_ERROR if the received log has been used successfully.
    */
   static SbgErrorCode onLogReceived(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msg, const SbgBinaryLogData *pLogData, void *pUserArg) {  
-    count++;
+    SBGEllipseA* self = static_cast<SBGEllipseA*>(pUserArg);
+    self->count++;
     switch (msg) {
       case SBG_ECOM_LOG_EKF_EULER:    
-        eulerData << pLogData->ekfEulerData.euler[0],   
-                     pLogData->ekfEulerData.euler[1],    
-                     pLogData->ekfEulerData.euler[2];
-        timestampEuler = pLogData->ekfEulerData.timeStamp;
-        countEuler++;
+        self->latestEkf.euler << pLogData->ekfEulerData.euler[0],   
+                                 pLogData->ekfEulerData.euler[1],    
+                                 pLogData->ekfEulerData.euler[2];
+        self->latestEkf.timestampEuler = pLogData->ekfEulerData.timeStamp;
+        self->ekf.write(self->latestEkf);
+        self->countEuler++;
         break;
       case SBG_ECOM_LOG_EKF_QUAT: 
-        quatData << pLogData->ekfQuatData.quaternion[0],   
-                    pLogData->ekfQuatData.quaternion[1],    
-                    pLogData->ekfQuatData.quaternion[2],    
-                    pLogData->ekfQuatData.quaternion[3];
-        timestampQuat = pLogData->ekfQuatData.timeStamp;
-        countQuat++;
+        self->latestEkf.quaternion << pLogData->ekfQuatData.quaternion[0],   
+                                      pLogData->ekfQuatData.quaternion[1],    
+                                      pLogData->ekfQuatData.quaternion[2],    
+                                      pLogData->ekfQuatData.quaternion[3];
+        self->latestEkf.timestampQuat = pLogData->ekfQuatData.timeStamp;
+        self->ekf.write(self->latestEkf);
+        self->countQuat++;
         break;
       case SBG_ECOM_LOG_IMU_DATA: 
-        accData << pLogData->imuData.accelerometers[0],   
-                   pLogData->imuData.accelerometers[1],    
-                   pLogData->imuData.accelerometers[2];
-        timestampAcc = pLogData->imuData.timeStamp;
-        gyroData << pLogData->imuData.gyroscopes[0],   
-                    pLogData->imuData.gyroscopes[1],    
-                    pLogData->imuData.gyroscopes[2];
-        timestampGyro = pLogData->imuData.timeStamp;
-        countImu++;
+        self->pushImu(pLogData->imuData.accelerometers, pLogData->imuData.gyroscopes, pLogData->imuData.timeStamp);
         break;
       case SBG_ECOM_LOG_FAST_IMU_DATA: // sbgEComBinaryLogImu.h
-        accData << pLogData->fastImuData.accelerometers[0],   
-                   pLogData->fastImuData.accelerometers[1],    
-                   pLogData->fastImuData.accelerometers[2];
-        timestampAcc = pLogData->fastImuData.timeStamp;
-        gyroData << pLogData->fastImuData.gyroscopes[0],   
-                    pLogData->fastImuData.gyroscopes[1],    
-                    pLogData->fastImuData.gyroscopes[2];
-        timestampGyro = pLogData->fastImuData.timeStamp;
+        self->pushImu(pLogData->fastImuData.accelerometers, pLogData->fastImuData.gyroscopes, pLogData->fastImuData.timeStamp);
         break;
-     default:
-       count0++;
-       break;
-   }
-   return SBG_NO_ERROR;
- }
+      default:
+        self->count0++;
+        break;
+    }
+    return SBG_NO_ERROR;
+  }
 };
 
 }
@@ -4,33 +4,68 @@
 #include <string>
 #include <eeros/hal/Input.hpp>
 #include <eeros/SIUnit.hpp>
+#include <eeros/math/Fixed.hpp>
 
 namespace eeros {
 namespace hal {
 
+/**
+ * An input whose raw readings are scaled into the signal value by
+ * value = (raw - offset) / scale.
+ * The unit is checked once when a peripheral input claims the input, reads carry no unit.
+ * Scale and offset are folded into one gain and bias when they are set, so that
+ * toValue() costs a single multiply-add per read.
+ */
 template <typename T>
 class ScalableInput : public Input<T> {
  public:
   ScalableInput(std::string id, void* libHandle, T scale, T offset, T minIn, T maxIn, SIUnit unit = SIUnit::create()) 
-      : Input<T>(id, libHandle), scale(scale), offset(offset), minIn(minIn), maxIn(maxIn), unit(unit)  { }
+      : Input<T>(id, libHandle), scale(scale), offset(offset), unit(unit), minIn(minIn), maxIn(maxIn)  { fold(); }
 
   virtual T getScale() { return scale; }
   virtual T getOffset() { return offset; }
   SIUnit getUnit() override { return unit; }
   virtual T getMinIn() { return minIn; }
   virtual T getMaxIn() { return maxIn; }
-  virtual void setScale(T s) { scale = s; }
-  virtual void setOffset(T o) { offset = o; }
+  virtual void setScale(T s) { scale = s; fold(); }
+  virtual void setOffset(T o) { offset = o; fold(); }
   virtual void setUnit(SIUnit unit) { this->unit = unit; }
   virtual void setMinIn(T minI) { minIn = minI; }
   virtual void setMaxIn(T maxI) { maxIn = maxI; }
+  T getGain() const { return gain; }
+  T getBias() const { return bias; }
+
+  /**
+   * Converts a raw reading into the signal value.
+   *
+   * @param raw - raw reading of the hardware
+   * @return (raw - offset) / scale
+   */
+  T toValue(T raw) const { return raw * gain + bias; }
+
+  /**
+   * Returns a conversion of raw counts into fixed point values with the scale and 
+   * offset of this input, which needs no floating point arithmetic.
+   *
+   * @tparam Q - fixed point type, e.g. math::Q15
+   * @return scaling
+   */
+  template < typename Q >
+  math::FixedScaling<Q> getFixedScaling() const { return math::FixedScaling<Q>(gain, bias); }
 
  protected:
+  void fold() {
+    gain = T(1) / scale;
+    bias = -offset / scale;
+  }
+
   T scale;
   T offset;
   SIUnit unit;
   T minIn;
   T maxIn;
+  T gain;
+  T bias;
 };
 
 }
@@ -3,15 +3,25 @@
 
 #include <eeros/core/System.hpp>
 #include <eeros/hal/Output.hpp>
+#include <eeros/math/Fixed.hpp>
+#include <algorithm>
+#include <limits>
 
 namespace eeros {
 namespace hal {
 
+/**
+ * An output whose signal value is scaled into the raw value written to the
+ * hardware by raw = value * scale + offset, see toRaw().
+ * The raw value is clamped to [minOut, maxOut] if minOut < maxOut. The limits are
+ * prepared when they are set, so that toRaw() costs a multiply-add and a clamp.
+ * The unit is checked once when a peripheral output claims the output, writes carry no unit.
+ */
 template <typename T>
 class ScalableOutput : public Output<T> {
  public:
   explicit ScalableOutput(std::string id, void* libHandle, T scale, T offset, T minOut, T maxOut, SIUnit unit = SIUnit::create()) 
-      : Output<T>(id, libHandle), scale(scale), offset(offset), minOut(minOut), maxOut(maxOut), unit(unit) { }
+      : Output<T>(id, libHandle), scale(scale), offset(offset), minOut(minOut), maxOut(maxOut), unit(unit) { fold(); }
   
   virtual T getScale() { return scale; }
   virtual T getOffset() { return offset; }
@@ -21,15 +31,42 @@ class ScalableOutput : public Output<T> {
   virtual void setScale(T s) { scale = s; }
   virtual void setOffset(T o) { offset = o; }
   virtual void setUnit(SIUnit unit) { this->unit = unit; }
-  virtual void setMinOut(T minO) { minOut = minO; }
-  virtual void setMaxOut(T maxO) { maxOut = maxO; }
+  virtual void setMinOut(T minO) { minOut = minO; fold(); }
+  virtual void setMaxOut(T maxO) { maxOut = maxO; fold(); }
+
+  /**
+   * Converts a signal value into the raw value of the hardware.
+   *
+   * @param value - signal value
+   * @return value * scale + offset, clamped to the output range
+   */
+  T toRaw(T value) const { return std::clamp(value * scale + offset, lower, upper); }
+
+  /**
+   * Returns a conversion of fixed point values into raw counts with the scale and
+   * offset of this output, which needs no floating point arithmetic. The counts
+   * are not clamped to the output range.
+   *
+   * @tparam Q - fixed point type, e.g. math::Q15
+   * @return scaling, use FixedScaling::toCounts()
+   */
+  template < typename Q >
+  math::FixedScaling<Q> getFixedScaling() const { return math::FixedScaling<Q>(1 / scale, -offset / scale); }
   
  protected:
+  void fold() {
+    bool limited = minOut < maxOut;   // no range configured otherwise
+    lower = limited ? minOut : std::numeric_limits<T>::lowest();
+    upper = limited ? maxOut : std::numeric_limits<T>::max();
+  }
+
   T scale;
   T offset;
   SIUnit unit;
   T minOut;
   T maxOut;
+  T lower;
+  T upper;
 };
 
 }
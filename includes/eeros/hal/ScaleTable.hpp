@@ -0,0 +1,64 @@
+#ifndef ORG_EEROS_HAL_SCALETABLE_HPP_
+#define ORG_EEROS_HAL_SCALETABLE_HPP_
+
+#include <cstddef>
+#include <vector>
+#include <eeros/hal/ScalableInput.hpp>
+
+namespace eeros {
+namespace hal {
+
+/**
+ * The gains and biases of the scalable inputs of a device, stored as arrays.
+ * A device which reads the raw counts of all its inputs at once converts them
+ * with one call to convert(), a loop the compiler vectorizes, instead of
+ * calling toValue() per channel.
+ *
+ * The table copies gain and bias, so it has to be built again after the scale
+ * or offset of an input changed.
+ *
+ * @since v1.4.4
+ */
+template <typename T>
+class ScaleTable {
+ public:
+  /**
+   * Appends an input, raw reading i of convert() belongs to the i-th input added.
+   *
+   * @param in - input
+   */
+  void add(const ScalableInput<T>& in) {
+    gain.push_back(in.getGain());
+    bias.push_back(in.getBias());
+  }
+
+  void clear() {
+    gain.clear();
+    bias.clear();
+  }
+
+  std::size_t size() const { return gain.size(); }
+
+  /**
+   * Converts the raw readings of all inputs into their signal values.
+   *
+   * @param raw - raw readings, size() elements
+   * @param values - signal values, size() elements
+   */
+  template <typename R>
+  void convert(const R* raw, T* values) const {
+    const T* g = gain.data();
+    const T* b = bias.data();
+    std::size_t n = gain.size();
+    for (std::size_t i = 0; i < n; i++) values[i] = static_cast<T>(raw[i]) * g[i] + b[i];
+  }
+
+ private:
+  std::vector<T> gain;
+  std::vector<T> bias;
+};
+
+}
+}
+
+#endif /* ORG_EEROS_HAL_SCALETABLE_HPP_ */
@@ -0,0 +1,194 @@
+#ifndef ORG_EEROS_HAL_SDOCLIENT_HPP_
+#define ORG_EEROS_HAL_SDOCLIENT_HPP_
+
+#include <eeros/core/FutexSemaphore.hpp>
+#include <eeros/hal/CanSocket.hpp>
+#include <eeros/logger/Logger.hpp>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace eeros {
+namespace hal {
+
+/**
+ * Result of an SDO transfer.
+ *
+ * @since v1.4.4
+ */
+struct SdoResult {
+  enum Status : uint8_t { ok, aborted, timeout, unsupported };
+
+  Status status = ok;
+  uint32_t value = 0;       // value read by an upload
+  uint32_t abortCode = 0;   // abort code sent by the node, if aborted
+};
+
+/**
+ * Client for expedited CANopen SDO transfers (up to 4 bytes) which never blocks
+ * the caller. Transfers are queued and completed by the thread of the client
+ * through a future or a callback. The client holds at most one transfer per node
+ * in flight, as an SDO server handles one transfer at a time.
+ *
+ * The client uses a socket of its own, so SDO traffic does not touch the sockets
+ * of the CANopen blocks. When the bus also carries cyclic PDOs, pass the client
+ * to CANopenSend::setSdoClient(): request frames are then only sent right after
+ * the PDOs and the sync of a cycle, in the spare time of the bus until the next
+ * cycle, at most getFramesPerSlot() frames per cycle. The send block only posts
+ * a semaphore for this, the frames are built and sent by the client thread.
+ *
+ * Segmented and block transfers are not supported, an upload answered with a
+ * segmented response is aborted and completes as unsupported.
+ *
+ * @since v1.4.4
+ */
+class SdoClient {
+ public:
+  using Callback = std::function<void(const SdoResult&)>;
+
+  /**
+   * Opens a raw CAN socket bound to an interface which only receives SDO responses.
+   *
+   * @param interface - name of the CAN interface, e.g. can0
+   */
+  explicit SdoClient(std::string interface);
+
+  /**
+   * Uses a socket which is already open and bound, the socket is closed
+   * by the destructor.
+   *
+   * @param fd - file descriptor of the socket
+   */
+  explicit SdoClient(int fd);
+
+  /**
+   * Stops the thread, transfers which are not completed yet complete as timed out.
+   */
+  ~SdoClient();
+
+  SdoClient(const SdoClient&) = delete;
+  SdoClient& operator=(const SdoClient&) = delete;
+
+  /**
+   * Queues a read of an object of the dictionary of a node.
+   *
+   * @param node - node id
+   * @param index - index of the object
+   * @param subIndex - sub index of the object
+   * @return future of the result
+   */
+  std::future<SdoResult> upload(uint8_t node, uint16_t index, uint8_t subIndex);
+
+  /**
+   * Queues a read of an object of the dictionary of a node.
+   *
+   * @param node - node id
+   * @param index - index of the object
+   * @param subIndex - sub index of the object
+   * @param done - called by the thread of the client with the result
+   */
+  void upload(uint8_t node, uint16_t index, uint8_t subIndex, Callback done);
+
+  /**
+   * Queues a write of an object of the dictionary of a node.
+   *
+   * @param node - node id
+   * @param index - index of the object
+   * @param subIndex - sub index of the object
+   * @param value - value to write
+   * @param size - size of the object in bytes (1 to 4)
+   * @return future of the result
+   */
+  std::future<SdoResult> download(uint8_t node, uint16_t index, uint8_t subIndex, uint32_t value, uint8_t size);
+
+  /**
+   * Queues a write of an object of the dictionary of a node.
+   *
+   * @param node - node id
+   * @param index - index of the object
+   * @param subIndex - sub index of the object
+   * @param value - value to write
+   * @param size - size of the object in bytes (1 to 4)
+   * @param done - called by the thread of the client with the result
+   */
+  void download(uint8_t node, uint16_t index, uint8_t subIndex, uint32_t value, uint8_t size, Callback done);
+
+  /**
+   * Opens a slot for request frames, called after the cyclic frames of a cycle
+   * were sent. Does not block and only wakes the client thread if transfers
+   * are pending.
+   */
+  void release();
+
+  /**
+   * Sends request frames only in the slots opened by release() if paced,
+   * otherwise as soon as they are queued (default). Set by CANopenSend::setSdoClient().
+   *
+   * @param paced - true to pace the requests
+   */
+  void setPaced(bool paced);
+
+  /**
+   * @param n - maximal number of request frames sent per slot (1 - default)
+   */
+  void setFramesPerSlot(int n);
+
+  /**
+   * @return maximal number of request frames sent per slot
+   */
+  int getFramesPerSlot() const { return framesPerSlot; }
+
+  /**
+   * @param sec - time a node has to respond to a request (0.5 s - default)
+   */
+  void setTimeout(double sec);
+
+  /**
+   * @return number of transfers which are queued or in flight
+   */
+  int getPending();
+
+ private:
+  struct Request {
+    uint8_t node;
+    uint16_t index;
+    uint8_t subIndex;
+    bool upload;
+    uint32_t value;
+    uint8_t size;
+    std::promise<SdoResult> promise;
+    Callback done;
+    int64_t deadline;
+  };
+
+  void submit(Request r);
+  void run();
+  void receive();
+  void expire(int64_t now);
+  void send(int64_t now);
+  void complete(Request& r, const SdoResult& result);
+
+  CanSocket socket;
+  std::mutex mtx;
+  std::deque<Request> queue;
+  std::map<uint8_t, Request> active;   // node id, transfer in flight
+  std::atomic<int> pending;
+  FutexSemaphore wakeup;
+  std::atomic<bool> paced;
+  std::atomic<int> framesPerSlot;
+  std::atomic<int64_t> timeoutNs;
+  std::atomic<bool> running;
+  logger::Logger log;
+  std::thread thread;
+};
+
+}
+}
+
+#endif // ORG_EEROS_HAL_SDOCLIENT_HPP_
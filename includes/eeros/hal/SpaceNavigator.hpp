@@ -3,8 +3,10 @@
 
 #include <string>
 #include <functional>
+#include <cstdint>
+#include <linux/input.h>
 #include <eeros/hal/Input.hpp>
-#include <eeros/core/Thread.hpp>
+#include <eeros/core/AsyncBuffer.hpp>
 #include <eeros/logger/Logger.hpp>
 
 #define SPACENAVIGATOR_AXIS_COUNT (3)
@@ -36,20 +38,43 @@ namespace eeros {
 			};
 		};
 		
-		class SpaceNavigator : public eeros::Thread {
+		/**
+		 * This class is part of the hardware abstraction layer.
+		 * It is used by \ref eeros::control::SpaceNavigatorInput and \ref eeros::hal::SpaceNavigatorDigIn class.
+		 * Do not use it directly.
+		 * The device is read by the thread of the \ref InputHub as soon as data
+		 * arrives. Raw HID packets may arrive in pieces, they are reassembled before
+		 * being decoded. The resulting state is published to \ref current, which can
+		 * be read without locking.
+		 *
+		 * @since v1.0
+		 */
+		class SpaceNavigator {
 		public:
+			/**
+			 * Opens the device and registers it with the \ref InputHub.
+			 * A path containing "raw" selects the raw HID protocol, otherwise input events are read.
+			 *
+			 * @param dev - path of the device, e.g. /dev/hidraw0 or /dev/input/event3
+			 * @param priority - realtime priority of the input thread
+			 */
 			explicit SpaceNavigator(std::string dev, int priority = 20);
 			~SpaceNavigator();
 			virtual std::string name();
 			
-			SpaceState current;
+			eeros::AsyncBuffer<SpaceState> current;
 			
 		private:
-			virtual void run();			
+			void onReadable();
+			bool parseRaw();
+			bool parseEvent(const struct input_event& ev);
 			virtual bool open(const char* device);
 			virtual void close();
-			FILE* file;
-			bool running, useRaw;
+			int fd;
+			bool useRaw;
+			SpaceState state{};
+			uint8_t rawBuffer[64];
+			int rawLength = 0;
 			Input<bool>* button[SPACENAVIGATOR_BUTTON_COUNT];
 			eeros::logger::Logger log;
 		};
@@ -2,21 +2,35 @@
 #define ORG_EEROS_HAL_SYSFSDIGIN_HPP_
 
 #include <eeros/hal/Input.hpp>
-#include <fstream>
 #include <string>
 
 namespace eeros {
 	namespace hal {
+		/**
+		 * Digital input on a GPIO of the sysfs interface. The value file is kept open
+		 * and read with a single pread() per get(). With an edge set, waitForEdge()
+		 * blocks until the kernel reports an edge on the GPIO.
+		 */
 		class SysFsDigIn : public Input<bool> {
 		public:
-			SysFsDigIn(std::string id, void* libHandle, unsigned int gpio, bool inverted = false);
+			enum class Edge { none, rising, falling, both };
+
+			SysFsDigIn(std::string id, void* libHandle, unsigned int gpio, bool inverted = false, Edge edge = Edge::none);
 			~SysFsDigIn();
 			virtual bool get();
+
+			/**
+			 * Waits for an edge, needs an edge set on construction.
+			 *
+			 * @param timeout - timeout in milliseconds, -1 waits forever
+			 * @return true, if an edge occurred before the timeout
+			 */
+			bool waitForEdge(int timeout);
 			
 		private:
 			bool inverted;
 			std::string basePath;
-			std::fstream valueFile;
+			int fd;
 		};
 
 	};
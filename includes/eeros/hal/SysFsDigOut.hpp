@@ -2,11 +2,15 @@
 #define ORG_EEROS_HAL_SYSFSDIGOUT_HPP_
 
 #include <eeros/hal/Output.hpp>
-#include <fstream>
 #include <string>
 
 namespace eeros {
 	namespace hal {
+		/**
+		 * Digital output on a GPIO of the sysfs interface. The value file is kept open
+		 * and written with a single pwrite() per set(). get() returns the value
+		 * last set without accessing the GPIO.
+		 */
 		class SysFsDigOut : public Output<bool> {
 		public:
 			SysFsDigOut(std::string id, void* libHandle, unsigned int gpio, bool inverted = false);
@@ -16,8 +20,9 @@ namespace eeros {
 			
 		private:
 			bool inverted;
+			bool value;
 			std::string basePath;
-			std::fstream valueFile;
+			int fd;
 		};
 
 	};
@@ -5,7 +5,8 @@
 #include <functional>
 #include <linux/joystick.h>
 #include <eeros/hal/Input.hpp>
-#include <eeros/core/Thread.hpp>
+#include <eeros/core/AsyncBuffer.hpp>
+#include <eeros/logger/Logger.hpp>
 
 #define XBOX_BUTTON_COUNT (8)
 #define XBOX_AXIS_COUNT (8)
@@ -44,8 +45,24 @@ namespace eeros {
 			};
 		};
 		
-		class XBox : public eeros::Thread{
+		/**
+		 * This class is part of the hardware abstraction layer.
+		 * It is used by \ref eeros::control::XBoxInput and \ref eeros::hal::XBoxDigIn class.
+		 * Do not use it directly.
+		 * The joystick device is read by the thread of the \ref InputHub as soon as
+		 * events arrive. All pending events are processed at once and the resulting
+		 * state is published to \ref current and \ref last, which can be read without locking.
+		 *
+		 * @since v0.6
+		 */
+		class XBox {
 		public:
+			/**
+			 * Opens the joystick device and registers it with the \ref InputHub.
+			 *
+			 * @param dev - path of the joystick device, e.g. /dev/input/js0
+			 * @param priority - realtime priority of the input thread
+			 */
 			explicit XBox(std::string dev, int priority);
 			~XBox();
 			virtual void on_event(std::function<void(struct js_event)> action);
@@ -53,15 +70,17 @@ namespace eeros {
 			virtual void on_axis(std::function<void(int, double)> action);
 			virtual std::string name();
 			
-			XBoxState last;
-			XBoxState current;
+			eeros::AsyncBuffer<XBoxState> last;
+			eeros::AsyncBuffer<XBoxState> current;
 			
 		private:
-			virtual void run();
+			void onReadable();
 			virtual bool open(const char* device);
 			virtual void close();
 			int fd;
-			bool running;
+			XBoxState currentState{};
+			XBoxState lastState{};
+			eeros::logger::Logger log;
 			std::function<void(struct js_event)> event_action;
 			std::function<void(int, bool)> button_action;
 			std::function<void(int, double)> axis_action;
@@ -0,0 +1,98 @@
+#ifndef ORG_EEROS_LOGGER_ASYNCLOGWRITER_HPP_
+#define ORG_EEROS_LOGGER_ASYNCLOGWRITER_HPP_
+
+#include <eeros/logger/StreamLogWriter.hpp>
+#include <eeros/core/SpscRingBuffer.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace eeros {
+namespace logger {
+
+/**
+ * An AsyncLogWriter writes the same output as a \ref StreamLogWriter, but never
+ * writes to the stream or the log file on the thread which logs. Each thread
+ * which logs gets its own wait-free ring buffer. When a \ref LogEntry ends, its
+ * text is copied into the ring buffer of the calling thread together with the
+ * time, the level and the category. A background thread drains all ring buffers,
+ * formats the time, adds the colors and writes to the stream and the log file.
+ *
+ * Logging therefore does not block a realtime thread on terminal or file I/O.
+ * If the ring buffer of a thread is full, or more than maxThreads threads log at
+ * the same time, the message is dropped and counted, see getDropped(). Messages
+ * longer than maxLength characters are truncated. Messages of the same thread
+ * keep their order, messages of different threads are written in the order in
+ * which the background thread drains them.
+ *
+ * Messages of Logger::deferred() are not formatted on the calling thread at all,
+ * only the pointer to the format string and the raw arguments are queued.
+ *
+ * @since v1.4.4
+ */
+
+class AsyncLogWriter : public StreamLogWriter {
+ public:
+  static constexpr int maxThreads = 16;
+  static constexpr int ringSize = 64;
+  static constexpr int maxLength = 240;
+
+  /**
+   * Creates an AsyncLogWriter sending its messages to a std::ostream such as std::cout.
+   *
+   * @param out - std::ostream
+   */
+  AsyncLogWriter(std::ostream& out);
+
+  /**
+   * Creates an AsyncLogWriter sending its messages to a std::ostream such as std::cout
+   * and a log file. The file name is appended with the current time and date.
+   *
+   * @param out - std::ostream
+   * @param logFile - log file name
+   */
+  AsyncLogWriter(std::ostream& out, std::string logFile);
+
+  /**
+   * Destructor, stops the background thread and writes all pending messages.
+   */
+  ~AsyncLogWriter();
+
+  /**
+   * Writes all pending messages on the calling thread. Must not be called
+   * from a realtime thread.
+   */
+  void flush();
+
+  /**
+   * @return number of messages dropped because a ring buffer was full
+   */
+  uint64_t getDropped() const;
+
+ private:
+  struct Record;
+  struct Channel;
+
+  virtual void begin(std::ostringstream& os, LogLevel level, unsigned category);
+  virtual void end(std::ostringstream& os);
+  virtual void write(LogLevel level, unsigned category, const char* format, const LogArg* args, int nofArgs);
+  void push(const Record& r);
+
+  Channel* channel();
+  void drain();
+  void run();
+
+  std::array<std::shared_ptr<Channel>, maxThreads> channels;
+  std::atomic<uint64_t> dropped{0};
+  std::atomic<bool> running{true};
+  std::mutex drainMtx;
+  std::thread thread;
+};
+
+}
+}
+
+#endif /* ORG_EEROS_LOGGER_ASYNCLOGWRITER_HPP_ */
@@ -4,6 +4,7 @@
 #include <eeros/logger/LogWriter.hpp>
 #include <memory>
 #include <iostream>
+#include <optional>
 
 namespace eeros {
 namespace logger {
@@ -11,25 +12,44 @@ namespace logger {
 /**
  * LogEntries are used by the \ref Logger to create log messages. The can be 
  * daisy chained using the insertion operator.
+ * A disabled LogEntry neither constructs a stream nor formats its values.
  * 
  * @since v0.6
  */
 
 class LogEntry {
 public:
+  /**
+   * Creates a disabled LogEntry, which discards everything inserted.
+   */
+  LogEntry() : w(nullptr), enable(false) { }
+
   /**
    * Creates a LogEntry which is inserted into a given \ref LogWriter.
+   * The writer must outlive the LogEntry.
    * @see Logger
    * 
    * @param writer - LogWriter
    * @param level - LogLevel
    * @param category - category
    */
-  LogEntry(std::shared_ptr<LogWriter> writer, LogLevel level, unsigned category = 0) 
-      : w(std::move(writer)) {
-    enable = (level <= w->visible_level);
-    if(enable) w->begin(os, level, category);
+  LogEntry(LogWriter* writer, LogLevel level, unsigned category = 0) 
+      : w(writer) {
+    enable = (w != nullptr && w->isVisible(level, category));
+    if(enable) w->begin(os.emplace(), level, category);
   }
+
+  /**
+   * Creates a LogEntry which is inserted into a given \ref LogWriter.
+   * The writer must outlive the LogEntry.
+   * @see Logger
+   * 
+   * @param writer - LogWriter
+   * @param level - LogLevel
+   * @param category - category
+   */
+  LogEntry(const std::shared_ptr<LogWriter>& writer, LogLevel level, unsigned category = 0) 
+      : LogEntry(writer.get(), level, category) { }
   
   /** 
    * Copy constructor, default initializes the class members.
@@ -40,7 +60,7 @@ public:
    * Ends inserting into \ref LogWriter.
    */
   virtual ~LogEntry() {
-    if(enable) w->end(os);
+    if(enable) w->end(*os);
   }
 
   /**
@@ -52,7 +72,7 @@ public:
    */
   template <typename T>
   LogEntry& operator<<(const T& value) {
-    os << value;
+    if(enable) *os << value;
     return *this;
   }
   
@@ -65,7 +85,7 @@ public:
    */
   template <typename T> 
   LogEntry& operator<<(T&& value) {
-    os << std::forward<T>(value);
+    if(enable) *os << std::forward<T>(value);
     return *this;
   }
   
@@ -76,13 +96,13 @@ public:
    * @return LogEntry
    */
   LogEntry& operator<<(void (*f)(LogWriter&) ) {
-    w->endl(os);
+    if(enable) w->endl(*os);
     return *this;
   }
   
  private:
-  std::shared_ptr<LogWriter> w;
-  std::ostringstream os;
+  LogWriter* w;
+  std::optional<std::ostringstream> os;
   bool enable;  // every LogEntry must decide itself, if it gets logged
 };
 
@@ -0,0 +1,91 @@
+#ifndef ORG_EEROS_LOGGER_LOGFORMAT_HPP_
+#define ORG_EEROS_LOGGER_LOGFORMAT_HPP_
+
+#include <cstdint>
+#include <ostream>
+#include <type_traits>
+
+namespace eeros {
+namespace logger {
+
+/** Maximal number of arguments of a deferred log message */
+constexpr int maxLogArgs = 8;
+
+/**
+ * A raw argument of a deferred log message, see Logger::deferred().
+ * Only arithmetic types and enumerations are accepted, they are copied
+ * as they are and formatted later.
+ *
+ * @since v1.4.4
+ */
+struct LogArg {
+  enum class Type : uint8_t { INT, UINT, DOUBLE, BOOL, CHAR };
+
+  LogArg() : type(Type::INT), i(0) { }
+
+  template < typename T >
+  LogArg(T v) {
+    static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "deferred log arguments must be numbers or enumerations");
+    if constexpr (std::is_same_v<T, bool>) { type = Type::BOOL; u = v; }
+    else if constexpr (std::is_same_v<T, char>) { type = Type::CHAR; i = v; }
+    else if constexpr (std::is_enum_v<T>) { type = Type::INT; i = static_cast<int64_t>(v); }
+    else if constexpr (std::is_floating_point_v<T>) { type = Type::DOUBLE; d = v; }
+    else if constexpr (std::is_signed_v<T>) { type = Type::INT; i = v; }
+    else { type = Type::UINT; u = v; }
+  }
+
+  Type type;
+  union {
+    int64_t i;
+    uint64_t u;
+    double d;
+  };
+};
+
+/**
+ * Invoked during constant evaluation if the number of placeholders does not
+ * match the number of arguments. It is not constexpr, so a mismatch fails to compile.
+ */
+inline void logFormatArgumentCountMismatch() { }
+
+/**
+ * A format string of a deferred log message, where each "{}" is replaced by
+ * the next argument. It must be a string literal, the number of placeholders is
+ * checked against the number of arguments at compile time. Only the pointer to
+ * the literal is kept, so the text itself is never copied.
+ *
+ * @tparam Args - types of the arguments
+ *
+ * @since v1.4.4
+ */
+template < typename... Args >
+class FormatString {
+ public:
+  consteval FormatString(const char* s) : str(s) {
+    int n = 0;
+    for (const char* c = s; *c != 0; c++) {
+      if (c[0] == '{' && c[1] == '}') n++;
+    }
+    if (n != static_cast<int>(sizeof...(Args))) logFormatArgumentCountMismatch();
+  }
+
+  const char* get() const { return str; }
+
+ private:
+  const char* str;
+};
+
+/**
+ * Writes a deferred log message, replacing each "{}" of the format by the next argument.
+ *
+ * @param os - output stream
+ * @param format - format string
+ * @param args - arguments
+ * @param nofArgs - number of arguments
+ */
+void format(std::ostream& os, const char* format, const LogArg* args, int nofArgs);
+
+}
+}
+
+#endif /* ORG_EEROS_LOGGER_LOGFORMAT_HPP_ */
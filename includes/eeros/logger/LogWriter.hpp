@@ -2,6 +2,8 @@
 #define ORG_EEROS_LOGGER_LOGWRITER_HPP_
 
 #include <eeros/logger/Writer.hpp>
+#include <eeros/logger/LogFormat.hpp>
+#include <array>
 
 namespace eeros {
 namespace logger {
@@ -19,11 +21,19 @@ class LogWriter : public Writer {
   friend class LogEntry;
   
  protected:
-  LogWriter() : visible_level(LogLevel::INFO) { }
+  LogWriter() : visible_level(LogLevel::INFO) { levels.fill(LogLevel::INFO); }
   virtual void begin(std::ostringstream& os, LogLevel level, unsigned category) = 0;	
   virtual void end(std::ostringstream& os) = 0;
   virtual void endl(std::ostringstream& os) = 0;
+  // writes a deferred message, formats it at once unless a writer defers the formatting
+  virtual void write(LogLevel level, unsigned category, const char* format, const LogArg* args, int nofArgs);
+  // each category 'A' .. 'Z' has its own visible level, all other categories share the one of category 0
+  bool isVisible(LogLevel level, unsigned category) const { return level <= levels[index(category)]; }
+  void setVisibleLevel(LogLevel level) { visible_level = level; levels.fill(level); }
+  void setVisibleLevel(LogLevel level, unsigned category) { levels[index(category)] = level; }
+  static unsigned index(unsigned category) { return (category >= 'A' && category <= 'Z') ? category - 'A' + 1 : 0; }
   LogLevel visible_level;
+  std::array<LogLevel, 27> levels;
 };
 
 void endl(LogWriter& w);
@@ -1,21 +1,50 @@
 #ifndef ORG_EEROS_LOGGER_LOGGER_HPP_
 #define ORG_EEROS_LOGGER_LOGGER_HPP_
 
+#include <eeros/config.hpp>
+#include <eeros/logger/AsyncLogWriter.hpp>
 #include <eeros/logger/LogEntry.hpp>
 #include <eeros/logger/LogWriter.hpp>
+#include <eeros/logger/MappedLogWriter.hpp>
+#include <eeros/logger/SharedLogWriter.hpp>
+#include <eeros/logger/SysLogWriter.hpp>
 #include <eeros/logger/StreamLogWriter.hpp>
 #include <sstream>
 #include <string>
 #include <memory>
 
+/**
+ * Logs from a path which runs in a realtime thread, e.g. in the run method of a block
+ * or in SafetySystem::run(), as in EEROS_HOTPATH_LOG(log.warn() << "value " << x).
+ * With EEROS_RT_HOTPATH the statement is compiled out, its arguments are not evaluated,
+ * so no LogEntry is built and no string is allocated or formatted.
+ */
+#ifdef EEROS_RT_HOTPATH
+#define EEROS_HOTPATH_LOG(entry) do { if (false) { entry; } } while (0)
+#else
+#define EEROS_HOTPATH_LOG(entry) do { entry; } while (0)
+#endif
+
+#ifndef EEROS_LOG_LEVEL
+#define EEROS_LOG_LEVEL TRACE
+#endif
+
 namespace eeros {
 namespace logger {
 
+/**
+ * Most verbose log level which is compiled in, set with the CMake variable EEROS_LOG_LEVEL.
+ * Messages of less urgent levels are removed at compile time.
+ */
+constexpr LogLevel compiledLevel = LogLevel::EEROS_LOG_LEVEL;
+
 /**
  * A logger allows to log formatted output onto various streams. 
  * Different log levels \ref LogLevel show the urgency of a log message.
  * It is further possible to block messages of a certain level below 
- * a preset log level.
+ * a preset log level, for all categories or for a single category.
+ * The level is checked before a \ref LogEntry is built, a suppressed message
+ * costs a comparison only.
  * 
  * @since v0.6
  */
@@ -30,7 +59,7 @@ class Logger {
    * 
    * @return - LogEntry
    */
-  LogEntry fatal() { return LogEntry(w, LogLevel::FATAL, category); }
+  LogEntry fatal() { return entry<LogLevel::FATAL>(); }
 
   /**
    * Generates a log message with log level ERROR. The return value is a \ref LogEntry.
@@ -39,7 +68,7 @@ class Logger {
    * 
    * @return - LogEntry
    */
-  LogEntry error() { return LogEntry(w, LogLevel::ERROR, category); }
+  LogEntry error() { return entry<LogLevel::ERROR>(); }
 
   /**
    * Generates a log message with log level WARN. The return value is a \ref LogEntry.
@@ -48,7 +77,7 @@ class Logger {
    * 
    * @return - LogEntry
    */
-  LogEntry warn() { return LogEntry(w, LogLevel::WARN, category); }
+  LogEntry warn() { return entry<LogLevel::WARN>(); }
 
   /**
    * Generates a log message with log level INFO. The return value is a \ref LogEntry.
@@ -57,7 +86,7 @@ class Logger {
    * 
    * @return - LogEntry
    */
-  LogEntry info() { return LogEntry(w, LogLevel::INFO, category); }
+  LogEntry info() { return entry<LogLevel::INFO>(); }
 
   /**
    * Generates a log message with log level TRACE. The return value is a \ref LogEntry.
@@ -66,7 +95,27 @@ class Logger {
    * 
    * @return - LogEntry
    */
-  LogEntry trace() { return LogEntry(w, LogLevel::TRACE, category); }
+  LogEntry trace() { return entry<LogLevel::TRACE>(); }
+
+  /**
+   * Generates a log message whose formatting is deferred. The format is a string
+   * literal, where each "{}" is replaced by the next argument. The number of
+   * placeholders is checked at compile time. Only numbers and enumerations can
+   * be passed, they are copied as raw values.
+   * With an \ref AsyncLogWriter, the message is formatted on its background thread,
+   * so the calling thread neither formats nor allocates. Other writers format at once.
+   *
+   * @param level - LogLevel
+   * @param format - format string
+   * @param args - arguments
+   */
+  template < typename... Args >
+  void deferred(LogLevel level, FormatString<std::type_identity_t<Args>...> format, Args... args) {
+    static_assert(sizeof...(Args) <= maxLogArgs, "too many arguments for a deferred log message");
+    if (level > compiledLevel || !w->isVisible(level, category)) return;
+    const LogArg a[sizeof...(Args) + 1] = {LogArg(args)...};
+    w->write(level, category, format.get(), a, sizeof...(Args));
+  }
   
   /**
    * Returns a new logger with a chosen category. The category must
@@ -102,7 +151,68 @@ class Logger {
   static void setDefaultStreamLogger(std::ostream& os, std::string logFile) {
     log = makeLogger<StreamLogWriter>(os, logFile);
   }
+
+  /**
+   * Sets the default in such a way that all logger that will be created by
+   * \ref getLogger() will have their \ref LogWriter set to an \ref AsyncLogWriter.
+   * The \ref AsyncLogWriter will write to a std::ostream from a background thread.
+   *
+   * @param os - output stream to which the AsyncLogWriter will write
+   */
+  static void setDefaultAsyncLogger(std::ostream& os) {
+    log = makeLogger<AsyncLogWriter>(os);
+  }
+
+  /**
+   * Sets the default in such a way that all logger that will be created by
+   * \ref getLogger() will have their \ref LogWriter set to an \ref AsyncLogWriter.
+   * The \ref AsyncLogWriter will write to a std::ostream and into a log file
+   * from a background thread.
+   *
+   * @param os - output stream to which the AsyncLogWriter will write
+   * @param logFile - log file name
+   */
+  static void setDefaultAsyncLogger(std::ostream& os, std::string logFile) {
+    log = makeLogger<AsyncLogWriter>(os, logFile);
+  }
+
+  /**
+   * Sets the default in such a way that all logger that will be created by
+   * \ref getLogger() will have their \ref LogWriter set to a \ref MappedLogWriter.
+   * The \ref MappedLogWriter will write to a std::ostream and into a rotating
+   * log file of preallocated segments.
+   *
+   * @param os - output stream to which the MappedLogWriter will write
+   * @param logFile - log file name, the index of the segment is appended
+   * @param segmentSize - size of a segment in bytes
+   * @param nofSegments - number of segments, at least 2
+   */
+  static void setDefaultMappedLogger(std::ostream& os, std::string logFile, std::size_t segmentSize = 1 << 20, int nofSegments = 8) {
+    log = makeLogger<MappedLogWriter>(os, logFile, segmentSize, nofSegments);
+  }
   
+  /**
+   * Sets the default in such a way that all logger that will be created by
+   * \ref getLogger() will have their \ref LogWriter set to a \ref SysLogWriter.
+   *
+   * @param name - name of the program in the syslog
+   */
+  static void setDefaultSysLogger(std::string name) {
+    log = makeLogger<SysLogWriter>(name);
+  }
+
+  /**
+   * Sets the default in such a way that all logger that will be created by
+   * \ref getLogger() will have their \ref LogWriter set to a \ref SharedLogWriter.
+   * The \ref SharedLogWriter will write into a shared memory ring, which a log
+   * daemon writes together with the messages of other processes.
+   *
+   * @param name - name of the shared memory object of the ring
+   */
+  static void setDefaultSharedLogger(std::string name = "/eeros_log") {
+    log = makeLogger<SharedLogWriter>(name);
+  }
+
   /**
    * Sets the visible level of this logger to a chosen level.
    * All messages with a level below this chosen level are suppressed.
@@ -110,7 +220,18 @@ class Logger {
    * @param level - log level, messages with equal level or above get through
    */
   void show(LogLevel level = LogLevel::TRACE) {
-    w->visible_level = level;
+    w->setVisibleLevel(level);
+  }
+
+  /**
+   * Sets the visible level of a single category to a chosen level.
+   * Categories other than A .. Z share the level of category 0.
+   *
+   * @param level - log level, messages with equal level or above get through
+   * @param category - category, capital letter A .. Z
+   */
+  void show(LogLevel level, unsigned category) {
+    w->setVisibleLevel(level, category);
   }
 
  private:
@@ -118,6 +239,12 @@ class Logger {
   unsigned category;
 
   Logger(std::shared_ptr<LogWriter>&& writer): w(writer) { }
+  template < LogLevel level >
+  LogEntry entry() {
+    if constexpr (level > compiledLevel) return LogEntry();
+    else if (!w->isVisible(level, category)) return LogEntry();
+    else return LogEntry(w.get(), level, category);
+  }
   template <typename ConcreteWriter, typename ... Args>
   static Logger makeLogger(Args&& ... args) {
     return Logger(std::make_shared<ConcreteWriter>(std::forward<Args>(args)...));
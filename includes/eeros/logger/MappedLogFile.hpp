@@ -0,0 +1,96 @@
+#ifndef ORG_EEROS_LOGGER_MAPPEDLOGFILE_HPP_
+#define ORG_EEROS_LOGGER_MAPPEDLOGFILE_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace eeros {
+namespace logger {
+
+/**
+ * A log file of a fixed number of preallocated segments of a fixed size, named
+ * path.0, path.1 and so on. Each segment is allocated on disk with posix_fallocate()
+ * and mapped into memory, so writing a message only copies it into the mapping.
+ * A background thread writes the dirty pages back with msync() and prepares the
+ * next segment in advance. When the current segment is full, writing continues
+ * in the next one. After the last segment, the first one is overwritten, so the
+ * disk usage is bounded by the number of segments times their size.
+ *
+ * If the next segment is not ready when it is needed, the message is dropped
+ * and counted, see getDropped(). Writing never waits for the disk.
+ * When a segment is closed, its file is truncated to its content.
+ *
+ * @since v1.4.4
+ */
+
+class MappedLogFile {
+ public:
+  /**
+   * Creates the first two segments and starts the background thread.
+   *
+   * @param path - path of the log file, the index of the segment is appended
+   * @param segmentSize - size of a segment in bytes, rounded up to full pages
+   * @param nofSegments - number of segments, at least 2
+   */
+  MappedLogFile(std::string path, std::size_t segmentSize = 1 << 20, int nofSegments = 8);
+
+  /**
+   * Stops the background thread, writes back and closes all segments.
+   */
+  ~MappedLogFile();
+
+  MappedLogFile(const MappedLogFile&) = delete;
+  MappedLogFile& operator=(const MappedLogFile&) = delete;
+
+  /**
+   * Copies data into the current segment. A message is never split across
+   * two segments, data longer than a segment is truncated.
+   *
+   * @param data - data
+   * @param length - length of data in bytes
+   */
+  void write(const char* data, std::size_t length);
+
+  /**
+   * @return number of messages dropped because the next segment was not ready
+   */
+  uint64_t getDropped() const;
+
+  /**
+   * @return size of a segment in bytes
+   */
+  std::size_t getSegmentSize() const;
+
+ private:
+  struct Segment {
+    int fd = -1;
+    char* data = nullptr;
+    std::size_t used = 0;
+    int index = 0;
+  };
+
+  Segment open(int index);
+  void close(Segment& s);
+  void sync();
+  void run();
+
+  std::string path;
+  std::size_t size;
+  int nofSegments;
+  std::mutex mtx;
+  Segment current, next, retired;
+  std::size_t synced = 0;          // bytes of the current segment written back, owned by the background thread
+  std::atomic<uint64_t> dropped{0};
+  std::atomic<bool> running{true};
+  std::thread thread;
+};
+
+}
+}
+
+#endif /* ORG_EEROS_LOGGER_MAPPEDLOGFILE_HPP_ */
@@ -0,0 +1,47 @@
+#ifndef ORG_EEROS_LOGGER_MAPPEDLOGWRITER_HPP_
+#define ORG_EEROS_LOGGER_MAPPEDLOGWRITER_HPP_
+
+#include <eeros/logger/StreamLogWriter.hpp>
+#include <eeros/logger/MappedLogFile.hpp>
+
+namespace eeros {
+namespace logger {
+
+/**
+ * A MappedLogWriter sends its messages to a std::ostream like a \ref StreamLogWriter,
+ * but writes the log file through a \ref MappedLogFile: a fixed number of
+ * preallocated, memory mapped segments, which are written back by a background
+ * thread. Writing a message into the log file does not block on the disk and
+ * the log file does not grow without bound.
+ *
+ * @since v1.4.4
+ */
+
+class MappedLogWriter : public StreamLogWriter {
+ public:
+  /**
+   * Creates a MappedLogWriter sending its messages to a std::ostream such as std::cout
+   * and into a segmented log file.
+   *
+   * @param out - std::ostream
+   * @param logFile - log file name, the index of the segment is appended
+   * @param segmentSize - size of a segment in bytes
+   * @param nofSegments - number of segments, at least 2
+   */
+  MappedLogWriter(std::ostream& out, std::string logFile, std::size_t segmentSize = 1 << 20, int nofSegments = 8);
+
+  /**
+   * @return number of messages dropped from the log file
+   */
+  uint64_t getDropped() const;
+
+ private:
+  virtual void end(std::ostringstream& os);
+
+  MappedLogFile file;
+};
+
+}
+}
+
+#endif /* ORG_EEROS_LOGGER_MAPPEDLOGWRITER_HPP_ */
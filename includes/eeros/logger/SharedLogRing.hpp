@@ -0,0 +1,150 @@
+#ifndef ORG_EEROS_LOGGER_SHAREDLOGRING_HPP_
+#define ORG_EEROS_LOGGER_SHAREDLOGRING_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace eeros {
+namespace logger {
+
+/**
+ * Fixed size record of a log message in a \ref SharedLogRing.
+ */
+struct SharedLogRecord {
+  static constexpr int maxLength = 236;
+
+  uint64_t time;      // ns since the epoch of the system clock
+  int32_t pid;        // process which wrote the message
+  uint32_t category;
+  uint8_t level;      // LogLevel
+  uint8_t reserved;
+  uint16_t length;    // characters of text
+  char text[maxLength];
+};
+static_assert(sizeof(SharedLogRecord) == 256, "shared log records must keep their size");
+
+/**
+ * Ring of one producer in a \ref SharedLogRing. Head and tail lie on their
+ * own cache lines, the producer writes head, the consumer tail.
+ */
+struct SharedLogProducer {
+  std::atomic<uint64_t> owner;   // process id << 32 | thread id of the producer, 0 if the ring is free
+  std::atomic<uint64_t> dropped;
+  alignas(64) std::atomic<uint64_t> head;
+  alignas(64) std::atomic<uint64_t> tail;
+};
+
+/**
+ * Header of a shared log ring in shared memory, followed by the producers
+ * and their records.
+ */
+struct SharedLogRegion {
+  static constexpr uint32_t magicNumber = 0x45454C52; // "EELR"
+  static constexpr uint32_t initializing = 1;         // claimed, the layout is being written
+  static constexpr uint32_t layoutVersion = 1;
+
+  std::atomic<uint32_t> magic;
+  uint32_t version;
+  uint32_t nofProducers;
+  uint32_t ringSize;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared log rings need lock free atomics");
+
+/**
+ * Named shared memory of log records, which collects the log messages of all
+ * processes on a host for one log daemon. Each thread which logs claims a
+ * producer, a wait-free single producer single consumer ring of fixed size
+ * records. Writing a message copies it into the ring and never blocks; if the
+ * ring is full, the message is dropped and counted.
+ *
+ * The daemon polls all rings and merges the records by their time stamps, see
+ * poll(). Producers of processes which ended without releasing them are freed
+ * by poll(). Producers and daemon can be started in any order, both create the
+ * shared memory object if it does not exist yet.
+ *
+ * @since v1.4.4
+ */
+class SharedLogRing {
+ public:
+  /**
+   * Opens or creates a ring.
+   *
+   * @param name - name of the shared memory object, e.g. "/eeros_log"
+   * @param nofProducers - number of producers
+   * @param ringSize - records per producer
+   */
+  SharedLogRing(std::string name = "/eeros_log", uint32_t nofProducers = 32, uint32_t ringSize = 256);
+  ~SharedLogRing();
+
+  SharedLogRing(const SharedLogRing&) = delete;
+  SharedLogRing& operator=(const SharedLogRing&) = delete;
+
+  /**
+   * Claims a free producer for the calling thread.
+   *
+   * @return index of the producer, -1 if all are taken
+   */
+  int claim();
+
+  /**
+   * Frees a producer, its pending records are still polled.
+   *
+   * @param producer - index of the producer
+   */
+  void release(int producer);
+
+  /**
+   * Copies a record into the ring of a producer. Must only be called by
+   * the thread which claimed the producer.
+   *
+   * @param producer - index of the producer
+   * @param record - record
+   * @return false if the ring is full and the record was dropped
+   */
+  bool push(int producer, const SharedLogRecord& record);
+
+  /**
+   * Takes the records of all producers and passes them ordered by time to a handler.
+   * Records younger than a delay are held back until the next poll, so that late
+   * records of other producers are still sorted in. Must only be called by one
+   * consumer.
+   *
+   * @param handler - called for each record
+   * @param delay - time to hold back records
+   * @return number of records passed to the handler
+   */
+  std::size_t poll(const std::function<void(const SharedLogRecord&)>& handler,
+                   std::chrono::nanoseconds delay = std::chrono::milliseconds(50));
+
+  /**
+   * @return number of records dropped by all producers
+   */
+  uint64_t getDropped() const;
+
+  /**
+   * Removes the shared memory object of a ring.
+   *
+   * @param name - name of the shared memory object
+   */
+  static void remove(std::string name);
+
+ private:
+  SharedLogProducer& producer(uint32_t i) const;
+  SharedLogRecord* records(uint32_t i) const;
+  void reclaim();
+
+  std::string name;
+  std::size_t size;
+  SharedLogRegion* region;
+  std::vector<SharedLogRecord> pending;   // records taken by poll, owned by the consumer
+};
+
+}
+}
+
+#endif /* ORG_EEROS_LOGGER_SHAREDLOGRING_HPP_ */
@@ -0,0 +1,55 @@
+#ifndef ORG_EEROS_LOGGER_SHAREDLOGWRITER_HPP_
+#define ORG_EEROS_LOGGER_SHAREDLOGWRITER_HPP_
+
+#include <eeros/logger/LogWriter.hpp>
+#include <eeros/logger/SharedLogRing.hpp>
+#include <atomic>
+#include <memory>
+
+namespace eeros {
+namespace logger {
+
+/**
+ * A SharedLogWriter writes its messages as fixed size records into a
+ * \ref SharedLogRing in shared memory instead of a stream or a file. A log
+ * daemon polls the ring and writes the messages of all processes on the host
+ * on one timeline, so no process does any log I/O itself.
+ *
+ * Each thread which logs claims its own producer of the ring with its first
+ * message and frees it when it ends. If the ring of a thread is full, or all
+ * producers are taken, the message is dropped and counted, see getDropped().
+ * Messages longer than SharedLogRecord::maxLength characters are truncated.
+ *
+ * @since v1.4.4
+ */
+
+class SharedLogWriter : public LogWriter {
+ public:
+  /**
+   * Creates a SharedLogWriter, the ring is created if no daemon runs yet.
+   *
+   * @param name - name of the shared memory object of the ring
+   * @param nofProducers - number of producers of the ring
+   * @param ringSize - records per producer
+   */
+  SharedLogWriter(std::string name = "/eeros_log", uint32_t nofProducers = 32, uint32_t ringSize = 256);
+
+  /**
+   * @return number of messages of this writer dropped because a ring was full or no producer was free
+   */
+  uint64_t getDropped() const;
+
+ private:
+  virtual void begin(std::ostringstream& os, LogLevel level, unsigned category);
+  virtual void end(std::ostringstream& os);
+  virtual void endl(std::ostringstream& os);
+  int producer();
+
+  std::shared_ptr<SharedLogRing> ring;
+  std::atomic<uint64_t> dropped{0};
+};
+
+}
+}
+
+#endif /* ORG_EEROS_LOGGER_SHAREDLOGWRITER_HPP_ */
@@ -2,6 +2,7 @@
 #define ORG_EEROS_LOGGER_STREAMLOGWRITER_HPP_
 
 #include <eeros/logger/LogWriter.hpp>
+#include <chrono>
 #include <fstream>
 
 namespace eeros {
@@ -37,15 +38,33 @@ class StreamLogWriter : public LogWriter {
    */
   ~StreamLogWriter();
 
- private:  
-  virtual void show(LogLevel level = LogLevel::TRACE);	
-  virtual void begin(std::ostringstream& os, LogLevel level, unsigned category);
-  virtual void end(std::ostringstream& os);
-  virtual void endl(std::ostringstream& os);
+ protected:
+  /**
+   * Writes the time, the category and the level of a message.
+   *
+   * @param os - stream of the message
+   * @param level - LogLevel
+   * @param category - category
+   * @param time - time of the message
+   */
+  void header(std::ostream& os, LogLevel level, unsigned category, std::chrono::system_clock::time_point time);
+
+  /**
+   * Terminates a message.
+   *
+   * @param os - stream of the message
+   */
+  void footer(std::ostream& os);
 
   std::ostream& out;
   std::ofstream fileOut;
   bool colored;
+
+ private:
+  virtual void show(LogLevel level = LogLevel::TRACE);
+  virtual void begin(std::ostringstream& os, LogLevel level, unsigned category);
+  virtual void end(std::ostringstream& os);
+  virtual void endl(std::ostringstream& os);
 };
     
 }
@@ -2,26 +2,65 @@
 #define ORG_EEROS_LOGGER_SYSLOGWRITER_HPP_
 
 #include <eeros/logger/LogWriter.hpp>
-#include <eeros/logger/Logger.hpp>
+#include <eeros/core/MpscRingBuffer.hpp>
+#include <atomic>
+#include <cstdint>
 #include <sstream>
+#include <string>
+#include <thread>
 
 namespace eeros {
 	namespace logger {
+
+		/**
+		 * A SysLogWriter sends log messages to the syslog daemon. The thread which logs
+		 * only formats the message and queues it. A background thread sends the queued
+		 * messages in batches with one sendmmsg() call over a non blocking socket. If the
+		 * queue is full or the daemon does not accept a message, the message is dropped
+		 * and counted, see getDropped(), so logging never blocks.
+		 *
+		 * @since v1.4.4
+		 */
 		class SysLogWriter : public LogWriter {
 		public:
-			SysLogWriter(const std::string name);
+			static constexpr int maxLength = 480;
+
+			/**
+			 * Creates a SysLogWriter.
+			 *
+			 * @param name - name of the program in the syslog
+			 * @param socketPath - socket of the syslog daemon
+			 */
+			SysLogWriter(const std::string name, const std::string socketPath = "/dev/log");
 			virtual ~SysLogWriter();
-			
-			virtual void show(LogLevel level = LogLevel::TRACE);	
+
+			virtual void show(LogLevel level = LogLevel::TRACE);
 			virtual void begin(std::ostringstream& os, LogLevel level, unsigned category);
 			virtual void end(std::ostringstream& os);
 			virtual void endl(std::ostringstream& os);
-						
+
+			/**
+			 * @return number of messages dropped
+			 */
+			uint64_t getDropped() const;
+
 		private:
+			struct Record {
+				uint16_t length;
+				char text[maxLength];
+			};
+
+			void connect();
+			void send();
+			void run();
+
 			std::string name;
-			LogLevel level;
-			LogLevel visibleLevel;
-			bool enabled;
+			std::string socketPath;
+			int fd;
+			MpscRingBuffer<Record, 256> queue;
+			std::atomic<uint64_t> dropped{0};
+			std::atomic<bool> running{true};
+			std::thread thread;
 		};
 	}
 }
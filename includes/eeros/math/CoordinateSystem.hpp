@@ -1,8 +1,10 @@
 #ifndef ORG_EEROS_MATH_COORDINATESYSTEM_HPP_
 #define ORG_EEROS_MATH_COORDINATESYSTEM_HPP_
 
+#include <cstdint>
 #include <string>
-#include <map>
+#include <unordered_map>
+#include <vector>
 #include <ostream>
 
 namespace eeros {
@@ -20,15 +22,40 @@ namespace eeros {
 			bool operator!=(const CoordinateSystem& right) const;
 			
 			
-			static CoordinateSystem* getCoordinateSystem(std::string id);
+			/**
+			 * Every coordinate system gets a small index upon creation, which is 
+			 * reused after the coordinate system has been destroyed. 
+			 * 
+			 * @return index of this coordinate system
+			 */
+			uint32_t getIndex() const { return index; }
+			
+			/**
+			 * @param id - id of a coordinate system
+			 * @return coordinate system with this id or nullptr
+			 */
+			static CoordinateSystem* getCoordinateSystem(const std::string& id);
+			
+			/**
+			 * @param index - index of a coordinate system
+			 * @return coordinate system with this index or nullptr
+			 */
+			static CoordinateSystem* getCoordinateSystem(uint32_t index);
+			
+			/**
+			 * @return upper limit of the indices of all coordinate systems
+			 */
+			static uint32_t getIndexLimit();
 			
 		private:
 			CoordinateSystem(const CoordinateSystem&);
 			CoordinateSystem& operator=(const CoordinateSystem&) = delete;
 			
 			std::string id;
+			uint32_t index;
 			
-			static std::map<std::string, CoordinateSystem*> list;
+			static std::unordered_map<std::string, CoordinateSystem*> list;
+			static std::vector<CoordinateSystem*> indices;  // coordinate systems by index, nullptr if free
 			
 		
 		}; // END class CoordinateSystem
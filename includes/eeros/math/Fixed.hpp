@@ -0,0 +1,276 @@
+#ifndef ORG_EEROS_MATH_FIXED_HPP_
+#define ORG_EEROS_MATH_FIXED_HPP_
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+
+namespace eeros {
+namespace math {
+
+/**
+ * Fixed point number with F fractional bits, stored in the signed integer R,
+ * for targets without a fast floating point unit. A Fixed<15, int16_t> (Q15)
+ * covers -1 ... 1 - 2^-15, a Fixed<12, int16_t> covers -8 ... 8 - 2^-12.
+ *
+ * All arithmetic saturates at the limits of the range instead of wrapping
+ * around, a division by zero gives the limit with the sign of the dividend.
+ * Products and quotients are rounded to the nearest value.
+ * Arithmetic with a double, e.g. the time step of an integrator, is done in
+ * double and rounded back, it costs a floating point multiplication.
+ *
+ * The blocks Gain, Sum, Saturation, I, D, LowPassFilter and ZTransferFunction
+ * accept fixed point signals. Use FixedScaling to convert raw counts of a
+ * ScalableInput or ScalableOutput without floating point arithmetic.
+ *
+ * @tparam F - number of fractional bits
+ * @tparam R - signed integer type holding the raw value, at most 32 bits
+ *
+ * @since v1.4.4
+ */
+template < unsigned int F, typename R >
+class Fixed {
+  static_assert(std::is_integral<R>::value && std::is_signed<R>::value, "raw type of a fixed point number must be a signed integer");
+  static_assert(sizeof(R) <= 4, "raw type of a fixed point number must have at most 32 bits");
+  static_assert(F < sizeof(R) * 8, "too many fractional bits for the raw type");
+
+ public:
+  using Raw = R;
+  using Wide = typename std::conditional<sizeof(R) <= 2, int32_t, int64_t>::type;
+  static constexpr unsigned int fractionBits = F;
+  static constexpr double scale = static_cast<double>(static_cast<int64_t>(1) << F);
+
+  /**
+   * Constructs a zero.
+   */
+  constexpr Fixed() : r(0) { }
+
+  /**
+   * Constructs the fixed point number nearest to a value, saturated to the range.
+   *
+   * @param value - value
+   */
+  Fixed(double value) : r(fromDouble(value)) { }
+
+  /**
+   * Constructs a fixed point number from its raw value.
+   *
+   * @param raw - value * 2^F
+   * @return fixed point number
+   */
+  static constexpr Fixed fromRaw(R raw) {
+    Fixed f;
+    f.r = raw;
+    return f;
+  }
+
+  /**
+   * Returns the raw value.
+   *
+   * @return value * 2^F
+   */
+  constexpr R raw() const {
+    return r;
+  }
+
+  /**
+   * Returns the value as a double.
+   *
+   * @return value
+   */
+  constexpr double toDouble() const {
+    return r / scale;
+  }
+
+  explicit constexpr operator double() const {
+    return toDouble();
+  }
+
+  static constexpr Fixed max() { return fromRaw(std::numeric_limits<R>::max()); }
+  static constexpr Fixed lowest() { return fromRaw(std::numeric_limits<R>::lowest()); }
+  static constexpr Fixed epsilon() { return fromRaw(1); }
+
+  constexpr Fixed operator+(Fixed right) const { return fromRaw(saturate(static_cast<Wide>(r) + right.r)); }
+  constexpr Fixed operator-(Fixed right) const { return fromRaw(saturate(static_cast<Wide>(r) - right.r)); }
+  constexpr Fixed operator-() const { return fromRaw(saturate(-static_cast<Wide>(r))); }
+
+  constexpr Fixed operator*(Fixed right) const {
+    Wide p = static_cast<Wide>(r) * right.r;
+    if constexpr (F > 0) p = (p + (static_cast<Wide>(1) << (F - 1))) >> F;
+    return fromRaw(saturate(p));
+  }
+
+  constexpr Fixed operator/(Fixed right) const {
+    if (right.r == 0) return r > 0 ? max() : (r < 0 ? lowest() : Fixed());
+    Wide n = static_cast<Wide>(r) * (static_cast<Wide>(1) << F);
+    Wide half = (right.r > 0 ? right.r : -static_cast<Wide>(right.r)) / 2;
+    n += ((n < 0) != (right.r < 0)) ? -half : half;
+    return fromRaw(saturate(n / right.r));
+  }
+
+  Fixed operator*(double right) const { return Fixed(toDouble() * right); }
+  Fixed operator/(double right) const { return Fixed(toDouble() / right); }
+
+  Fixed& operator+=(Fixed right) { return *this = *this + right; }
+  Fixed& operator-=(Fixed right) { return *this = *this - right; }
+  Fixed& operator*=(Fixed right) { return *this = *this * right; }
+  Fixed& operator/=(Fixed right) { return *this = *this / right; }
+
+  constexpr bool operator==(Fixed right) const { return r == right.r; }
+  constexpr bool operator!=(Fixed right) const { return r != right.r; }
+  constexpr bool operator<(Fixed right) const { return r < right.r; }
+  constexpr bool operator>(Fixed right) const { return r > right.r; }
+  constexpr bool operator<=(Fixed right) const { return r <= right.r; }
+  constexpr bool operator>=(Fixed right) const { return r >= right.r; }
+
+  /**
+   * Saturates a wide value to the raw type.
+   *
+   * @param v - value
+   * @return v limited to the range of R
+   */
+  template < typename W >
+  static constexpr R saturate(W v) {
+    if (v > static_cast<W>(std::numeric_limits<R>::max())) return std::numeric_limits<R>::max();
+    if (v < static_cast<W>(std::numeric_limits<R>::lowest())) return std::numeric_limits<R>::lowest();
+    return static_cast<R>(v);
+  }
+
+ private:
+  static R fromDouble(double v) {
+    if (std::isnan(v)) return 0;
+    double raw = std::round(v * scale);
+    if (raw >= static_cast<double>(std::numeric_limits<R>::max())) return std::numeric_limits<R>::max();
+    if (raw <= static_cast<double>(std::numeric_limits<R>::lowest())) return std::numeric_limits<R>::lowest();
+    return static_cast<R>(raw);
+  }
+
+  R r;
+};
+
+/**
+ * Fixed point number in -1 ... 1 with 15 fractional bits.
+ */
+using Q15 = Fixed<15, int16_t>;
+
+/**
+ * Fixed point number in -1 ... 1 with 31 fractional bits.
+ */
+using Q31 = Fixed<31, int32_t>;
+
+template < typename T >
+struct isFixed : std::false_type { };
+
+template < unsigned int F, typename R >
+struct isFixed<Fixed<F, R>> : std::true_type { };
+
+/**
+ * True for types which blocks treat as a single number, i.e. arithmetic and fixed point types.
+ */
+template < typename T >
+struct isScalar : std::integral_constant<bool, std::is_arithmetic<T>::value || isFixed<T>::value> { };
+
+template < unsigned int F, typename R >
+Fixed<F, R> operator*(double left, Fixed<F, R> right) {
+  return right * left;
+}
+
+template < unsigned int F, typename R >
+std::ostream& operator<<(std::ostream& os, Fixed<F, R> f) {
+  return os << f.toDouble();
+}
+
+/**
+ * Converts between the raw counts of a device and fixed point values with an
+ * integer multiplication and shift, value = counts * gain + bias. The factors
+ * are prepared once, from the gain and bias of a ScalableInput or from the
+ * scale and offset of a ScalableOutput, see getFixedScaling() there.
+ *
+ * @tparam Q - fixed point type
+ *
+ * @since v1.4.4
+ */
+template < typename Q >
+class FixedScaling {
+ public:
+  /**
+   * Constructs a scaling with value = counts * gain + bias.
+   *
+   * @param gain - value of one count
+   * @param bias - value at zero counts
+   */
+  FixedScaling(double gain = 1, double bias = 0)
+      : forward(gain, bias, 0, Q::fractionBits), backward(1 / gain, -bias / gain, Q::fractionBits, 0) { }
+
+  /**
+   * Converts raw counts to a value, saturated to the range of Q.
+   *
+   * @param counts - raw counts
+   * @return value
+   */
+  Q toValue(int32_t counts) const {
+    return Q::fromRaw(Q::saturate(forward.apply(counts)));
+  }
+
+  /**
+   * Converts a value to raw counts, saturated to 32 bits.
+   *
+   * @param value - value
+   * @return counts
+   */
+  int32_t toCounts(Q value) const {
+    return Fixed<0, int32_t>::saturate(backward.apply(value.raw()));
+  }
+
+ private:
+  // y = (x * m + b) >> s, for x with fi and y with fo fractional bits
+  struct Affine {
+    Affine(double factor, double add, int fi, int fo) {
+      double f = std::ldexp(factor, fo - fi);
+      s = 0;
+      while (s < 31 && std::fabs(std::ldexp(f, s + 1)) < 2147483647.0) s++;
+      m = clamp(std::round(std::ldexp(f, s)), 2147483647.0);
+      b = clamp(std::round(std::ldexp(add, fo + s)), 2305843009213693952.0);   // 2^61
+      if (s > 0) b += static_cast<int64_t>(1) << (s - 1);   // rounds to nearest
+    }
+
+    static int64_t clamp(double v, double limit) {
+      return static_cast<int64_t>(v > limit ? limit : (v < -limit ? -limit : v));
+    }
+
+    int64_t apply(int64_t x) const {
+      return (x * m + b) >> s;
+    }
+
+    int64_t m, b;
+    int s;
+  };
+
+  Affine forward, backward;
+};
+
+}
+}
+
+namespace std {
+
+template < unsigned int F, typename R >
+class numeric_limits<eeros::math::Fixed<F, R>> {
+  using T = eeros::math::Fixed<F, R>;
+ public:
+  static constexpr bool is_specialized = true;
+  static constexpr bool is_signed = true;
+  static constexpr bool is_integer = false;
+  static constexpr bool is_exact = true;
+  static constexpr bool has_quiet_NaN = false;
+  static constexpr T min() { return T::lowest(); }
+  static constexpr T max() { return T::max(); }
+  static constexpr T lowest() { return T::lowest(); }
+  static constexpr T epsilon() { return T::epsilon(); }
+};
+
+}
+
+#endif /* ORG_EEROS_MATH_FIXED_HPP_ */
@@ -3,12 +3,19 @@
 
 #include <eeros/math/Matrix.hpp>
 #include <eeros/math/CoordinateSystem.hpp>
-#include <list>
+#include <vector>
 
 namespace eeros {
 	namespace math {
 		
+		/**
+		 * A frame is the transformation from one coordinate system to another. There is
+		 * at most one frame per pair of coordinate systems. All frames are registered in 
+		 * a table indexed by the indices of both coordinate systems, so \ref getFrame
+		 * takes constant time.
+		 */
 		class Frame {
+			friend class CoordinateSystem;
 		public:
 			Frame(const CoordinateSystem& a, const CoordinateSystem& b);
 			Frame(const CoordinateSystem& a, const CoordinateSystem& b, const eeros::math::Matrix<4, 4, double>& T);
@@ -31,7 +38,12 @@ namespace eeros {
 			const CoordinateSystem& b;
 			eeros::math::Matrix<4, 4, double> T;
 			
-			static std::list<Frame*> list;
+			void add();
+			static void removeFrames(const CoordinateSystem& cs);
+			
+			static std::vector<Frame*> table;  // frames by index of a * size + index of b
+			static uint32_t size;              // number of rows and columns of the table
+			static uint32_t nofFrames;
 		
 		}; // END class Frame
 	} // END namespace math
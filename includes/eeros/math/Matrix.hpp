@@ -4,16 +4,65 @@
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
+#include <eeros/config.hpp>
 #include <eeros/core/Fault.hpp>
 #include <sstream>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "MatrixExpression.hpp"
 #include "MatrixIndexOutOfBoundException.hpp"
+#include "MatrixKernels.hpp"
 
 namespace eeros {
 namespace math {
 
+/**
+ * Sine and cosine which can be evaluated at compile time, e.g. for constant
+ * rotation matrices. At runtime they call std::sin and std::cos, in a constant
+ * expression the angle is reduced to [-pi/2, pi/2] and a Taylor series is summed
+ * up to double precision.
+ *
+ * @since v1.4.4
+ */
+namespace trig {
+
+constexpr double pi = 3.14159265358979323846;
+
+// sums up the series starting with term until the terms no longer change the sum
+constexpr double series(double x, double term, int k) {
+  double sum = term;
+  for (;; k += 2) {
+    term *= -x * x / (k * (k + 1));
+    if (sum + term == sum) return sum;
+    sum += term;
+  }
+}
+
+constexpr double reduce(double x) {
+  double k = static_cast<double>(static_cast<long long>(x / (2 * pi) + (x < 0 ? -0.5 : 0.5)));
+  return x - k * 2 * pi;
+}
+
+constexpr double sin(double x) {
+  if (!std::is_constant_evaluated()) return std::sin(x);
+  x = reduce(x);
+  if (x > pi / 2) x = pi - x;
+  else if (x < -pi / 2) x = -pi - x;
+  return series(x, x, 2);
+}
+
+constexpr double cos(double x) {
+  if (!std::is_constant_evaluated()) return std::cos(x);
+  x = reduce(x);
+  if (x < 0) x = -x;
+  if (x > pi / 2) return -series(pi - x, 1, 1);
+  return series(x, 1, 1);
+}
+
+}
+
 /**
  * Base class for matrix operations.
  *
@@ -31,6 +80,18 @@ class Matrix {
 
   using value_type = T;
 
+  /**
+   * Alignment of the element storage, wide enough for the vector units
+   * used by the kernels as long as the matrix is large enough.
+   */
+  static constexpr std::size_t alignment = (sizeof(T) * M * N >= 32) ? 32 : (sizeof(T) * M * N >= 16) ? 16 : alignof(T);
+
+  /**
+   * Number of elements. The size of a matrix in bytes may be larger because
+   * of the alignment, so the elements must not be counted with sizeof.
+   */
+  static constexpr unsigned int nofElements = M * N;
+
   /**
    * Matrices can be initialized with the input operator (<<)
    */
@@ -51,89 +112,99 @@ class Matrix {
 
   /********** Constructors **********/
 
-  Matrix() {}
+  /**
+   * Constructs a matrix without initializing the elements. The constructors,
+   * the initializing functions, the element access and the operations on
+   * small matrices are constexpr, so constant matrices, e.g. gains or fixed
+   * rotations, can be built at compile time:
+   *
+   *   static constexpr auto R = Matrix<3, 3>::createRotZ(trig::pi / 4);
+   *
+   * An index out of bound is a compile error in a constant expression.
+   */
+  constexpr Matrix() {}
 
-  Matrix(const T v) { (*this) = v; }
+  constexpr Matrix(const T v) { (*this) = v; }
+
+  /**
+   * Evaluates a matrix expression, e.g. the sum of two matrices.
+   */
+  template <typename Node>
+  Matrix(const MatrixExpression<M, N, T, Node>& e) { e.evalTo(value); }
 
   template <typename... S>
-  Matrix(const S... v) : value{std::forward<const T>(v)...} {
+  constexpr Matrix(const S... v) : value{std::forward<const T>(v)...} {
     static_assert(sizeof...(S) == M * N,
                   "Invalid number of constructor arguments!");
   }
 
   /********** Initializing the matrix **********/
 
-  void zero() {
+  constexpr void zero() {
     for (unsigned int i = 0; i < M * N; i++) {
       value[i] = 0;
     }
   }
 
-  void eye() {
+  constexpr void eye() {
     zero();
     unsigned int j = (M < N) ? M : N;
     for (unsigned int i = 0; i < j; i++) {
-      (*this)(i, i) = 1;
+      element(i, i) = 1;
     }
   }
 
-  void fill(T v) { (*this) = v; }
+  constexpr void fill(T v) { (*this) = v; }
 
-  void rotx(double angle) {
+  constexpr void rotx(double angle) {
+    static_assert(M == 3 && N == 3, "rotx(double) is only implemented for 3x3 matrices");
     Matrix<M, N, T>& m = *this;
-    if (M == 3 && N == 3) {
-      m(0, 0) = 1;
-      m(1, 0) = 0;
-      m(2, 0) = 0;
-
-      m(0, 1) = 0;
-      m(1, 1) = std::cos(angle);
-      m(2, 1) = std::sin(angle);
-
-      m(0, 2) = 0;
-      m(1, 2) = -std::sin(angle);
-      m(2, 2) = std::cos(angle);
-    } else {
-      throw Fault("rotx(double) is only implemented for 3x3 matrices");
-    }
+    const T c = trig::cos(angle), s = trig::sin(angle);
+    m(0, 0) = 1;
+    m(1, 0) = 0;
+    m(2, 0) = 0;
+
+    m(0, 1) = 0;
+    m(1, 1) = c;
+    m(2, 1) = s;
+
+    m(0, 2) = 0;
+    m(1, 2) = -s;
+    m(2, 2) = c;
   }
 
-  void roty(double angle) {
+  constexpr void roty(double angle) {
+    static_assert(M == 3 && N == 3, "roty(double) is only implemented for 3x3 matrices");
     Matrix<M, N, T>& m = *this;
-    if (M == 3 && N == 3) {
-      m(0, 0) = std::cos(angle);
-      m(1, 0) = 0;
-      m(2, 0) = -std::sin(angle);
-
-      m(0, 1) = 0;
-      m(1, 1) = 1;
-      m(2, 1) = 0;
-
-      m(0, 2) = std::sin(angle);
-      m(1, 2) = 0;
-      m(2, 2) = std::cos(angle);
-    } else {
-      throw Fault("roty(double) is only implemented for 3x3 matrices");
-    }
+    const T c = trig::cos(angle), s = trig::sin(angle);
+    m(0, 0) = c;
+    m(1, 0) = 0;
+    m(2, 0) = -s;
+
+    m(0, 1) = 0;
+    m(1, 1) = 1;
+    m(2, 1) = 0;
+
+    m(0, 2) = s;
+    m(1, 2) = 0;
+    m(2, 2) = c;
   }
 
-  void rotz(double angle) {
+  constexpr void rotz(double angle) {
+    static_assert(M == 3 && N == 3, "rotz(double) is only implemented for 3x3 matrices");
     Matrix<M, N, T>& m = *this;
-    if (M == 3 && N == 3) {
-      m(0, 0) = std::cos(angle);
-      m(1, 0) = std::sin(angle);
-      m(2, 0) = 0;
-
-      m(0, 1) = -std::sin(angle);
-      m(1, 1) = std::cos(angle);
-      m(2, 1) = 0;
-
-      m(0, 2) = 0;
-      m(1, 2) = 0;
-      m(2, 2) = 1;
-    } else {
-      throw Fault("rotz(double) is only implemented for 3x3 matrices");
-    }
+    const T c = trig::cos(angle), s = trig::sin(angle);
+    m(0, 0) = c;
+    m(1, 0) = s;
+    m(2, 0) = 0;
+
+    m(0, 1) = -s;
+    m(1, 1) = c;
+    m(2, 1) = 0;
+
+    m(0, 2) = 0;
+    m(1, 2) = 0;
+    m(2, 2) = 1;
   }
 
   /**
@@ -146,9 +217,9 @@ class Matrix {
 
   /********** Element access **********/
 
-  const T get(unsigned int m, unsigned int n) const { return (*this)(m, n); }
+  constexpr const T get(unsigned int m, unsigned int n) const { return (*this)(m, n); }
 
-  Matrix<M, 1, T> getCol(unsigned int n) const {
+  constexpr Matrix<M, 1, T> getCol(unsigned int n) const {
     Matrix<M, 1, T> col;
     for (unsigned int m = 0; m < M; m++) {
       col(m, 0) = (*this)(m, n);
@@ -164,7 +235,7 @@ class Matrix {
     return col;
   }
 
-  Matrix<1, N, T> getRow(unsigned int m) const {
+  constexpr Matrix<1, N, T> getRow(unsigned int m) const {
     Matrix<1, N, T> row;
     for (unsigned int n = 0; n < N; n++) {
       row(0, n) = (*this)(m, n);
@@ -181,7 +252,7 @@ class Matrix {
   }
 
   template <unsigned int U, unsigned int V>
-  Matrix<U, V, T> getSubMatrix(unsigned int m, unsigned int n) const {
+  constexpr Matrix<U, V, T> getSubMatrix(unsigned int m, unsigned int n) const {
     static_assert(U <= M && V <= N,
                   "Dimension of the sub matrix must be lower or equal than of "
                   "the origin!");
@@ -189,7 +260,7 @@ class Matrix {
       Matrix<U, V, T> sub;
       for (unsigned int u = 0; u < U; u++) {
         for (unsigned int v = 0; v < V; v++) {
-          sub(u, v) = (*this)(m + u, n + v);
+          sub.element(u, v) = element(m + u, n + v);
         }
       }
       return sub;
@@ -198,9 +269,9 @@ class Matrix {
     }
   }
 
-  void set(unsigned int m, unsigned int n, T value) { (*this)(m, n) = value; }
+  constexpr void set(unsigned int m, unsigned int n, T value) { (*this)(m, n) = value; }
 
-  void setCol(unsigned int n, const Matrix<M, 1, T>& col) {
+  constexpr void setCol(unsigned int n, const Matrix<M, 1, T>& col) {
     for (unsigned int m = 0; m < M; m++) {
       (*this)(m, n) = col(m, 0);
     }
@@ -212,7 +283,7 @@ class Matrix {
     }
   }
 
-  void setRow(unsigned int m, const Matrix<1, N, T>& row) {
+  constexpr void setRow(unsigned int m, const Matrix<1, N, T>& row) {
     for (unsigned int n = 0; n < N; n++) {
       (*this)(m, n) = row(0, n);
     }
@@ -224,52 +295,35 @@ class Matrix {
     }
   }
 
-  T& operator()(unsigned int m, unsigned int n) {
-    if (m >= 0 && m < M && n >= 0 && n < N) {
-      return value[M * n + m];
-    } else {
-      throw MatrixIndexOutOfBoundException(m, M, n, N);
-    }
+  /**
+   * Returns the elements in column major order.
+   */
+  constexpr T* data() { return value; }
+
+  constexpr const T* data() const { return value; }
+
+  constexpr T& operator()(unsigned int m, unsigned int n) {
+    return value[index(m, n)];
   }
 
-  const T operator()(unsigned int m, unsigned int n) const {
-    if (m >= 0 && m < M && n >= 0 && n < N) {
-      return value[M * n + m];
-    } else {
-      throw MatrixIndexOutOfBoundException(m, M, n, N);
-    }
+  constexpr const T operator()(unsigned int m, unsigned int n) const {
+    return value[index(m, n)];
   }
 
-  T& operator()(unsigned int i) {
-    if (i >= 0 && i < M * N) {
-      return value[i];
-    } else {
-      throw MatrixIndexOutOfBoundException(i, M * N);
-    }
+  constexpr T& operator()(unsigned int i) {
+    return value[index(i)];
   }
 
-  const T operator()(unsigned int i) const {
-    if (i >= 0 && i < M * N) {
-      return value[i];
-    } else {
-      throw MatrixIndexOutOfBoundException(i, M * N);
-    }
+  constexpr const T operator()(unsigned int i) const {
+    return value[index(i)];
   }
 
-  T& operator[](unsigned int i) {
-    if (i >= 0 && i < M * N) {
-      return value[i];
-    } else {
-      throw MatrixIndexOutOfBoundException(i, M * N);
-    }
+  constexpr T& operator[](unsigned int i) {
+    return value[index(i)];
   }
 
-  const T operator[](unsigned int i) const {
-    if (i >= 0 && i < M * N) {
-      return value[i];
-    } else {
-      throw MatrixIndexOutOfBoundException(i, M * N);
-    }
+  constexpr const T operator[](unsigned int i) const {
+    return value[index(i)];
   }
 
   /********** Matrix characteristics **********/
@@ -284,13 +338,13 @@ class Matrix {
     return result == eye;
   }
 
-  bool isSymmetric() const { return (*this) == this->transpose(); }
+  constexpr bool isSymmetric() const { return (*this) == this->transpose(); }
 
-  bool isDiagonal() const {
+  constexpr bool isDiagonal() const {
     for (unsigned int m = 0; m < M; m++) {
       for (unsigned int n = 0; n < N; n++) {
         if (m != n) {
-          if ((*this)(m, n) != 0) {
+          if (element(m, n) != 0) {
             return false;
           }
         }
@@ -299,11 +353,11 @@ class Matrix {
     return true;
   }
 
-  bool isLowerTriangular() const {
+  constexpr bool isLowerTriangular() const {
     for (unsigned int m = 0; m < M; m++) {
       for (unsigned int n = 0; n < N; n++) {
         if (m < n) {
-          if ((*this)(m, n) != 0) {
+          if (element(m, n) != 0) {
             return false;
           }
         }
@@ -312,11 +366,11 @@ class Matrix {
     return true;
   }
 
-  bool isUpperTriangular() const {
+  constexpr bool isUpperTriangular() const {
     for (unsigned int m = 0; m < M; m++) {
       for (unsigned int n = 0; n < N; n++) {
         if (m > n) {
-          if ((*this)(m, n) != 0) {
+          if (element(m, n) != 0) {
             return false;
           }
         }
@@ -343,7 +397,7 @@ class Matrix {
     temp.gaussRowElimination();
     for (unsigned int m = 0; m < M; m++) {
       for (unsigned int n = 0; n < N; n++) {
-        if (temp(m, n) != 0) {
+        if (temp.element(m, n) != 0) {
           numberOfNonZeroRows++;
           break;
         }
@@ -366,39 +420,18 @@ class Matrix {
               (*this)(0, 1) * (*this)(1, 0) * (*this)(2, 2);
         return det;
       } else {  // 4x4 and bigger square matrices
-        // Use recursive laplace formula to calculate the determinat.
-        // For big matrices this method needs a lot of time, this
-        // could be improved with another algorithm.
-        T det = 0;
-        unsigned int ignoredRow = 0;
-        for (unsigned int m = 0; m < M; m++) {
-          Matrix<M - 1, N - 1, T> subMatrix;
-          unsigned int x = 0, y = 0;
-          unsigned int a = 0, b = 1;
-          while (a < M) {
-            while (b < N) {
-              if (a != ignoredRow) {
-                subMatrix(y, x) = (*this)(a, b);
-                x++;
-              }
-              b++;
-            }
-            b = 1;
-            x = 0;
-            if (a != ignoredRow) {
-              y++;
-            }
-            a++;
-          }
-          ignoredRow++;
-          T detSubMatrix = subMatrix.det();
-          if (m % 2 == 0) {  // even
-            det = det + (*this)(m, 0) * detSubMatrix;
-          } else {  // odd
-            det = det - (*this)(m, 0) * detSubMatrix;
-          }
+        // LU decomposition with partial pivoting, the determinant
+        // is the product of the diagonal of U
+        if constexpr (M == N) {
+          using F = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+          F lu[M * N];
+          unsigned int pivot[M];
+          for (unsigned int i = 0; i < M * N; i++) lu[i] = static_cast<F>(value[i]);
+          F det = kernel::lu<M>(lu, pivot);
+          for (unsigned int i = 0; i < M && det != 0; i++) det *= lu[M * i + i];
+          if constexpr (std::is_floating_point_v<T>) return det;
+          else return static_cast<T>(std::llround(det));
         }
-        return det;
       }
     } else {
       throw Fault("Calculating determinant failed: Matrix must be square");
@@ -406,37 +439,40 @@ class Matrix {
     return 0;
   }
 
-  T trace() const {
+  constexpr T trace() const {
     T result = 0;
     unsigned int j = (M < N) ? M : N;
     for (unsigned int i = 0; i < j; i++) {
-      result += (*this)(i, i);
+      result += element(i, i);
     }
     return result;
   }
 
-  Matrix<N, M, T> transpose() const {
+  constexpr Matrix<N, M, T> transpose() const {
     Matrix<N, M, T> result;
     for (unsigned int m = 0; m < M; m++) {
       for (unsigned int n = 0; n < N; n++) {
-        result(n, m) = (*this)(m, n);
+        result.element(n, m) = element(m, n);
       }
     }
     return result;
   }
 
   /**
-   * The inverse operation is only implemented for a 2x2 or a 3x3 matrix of
-   * doubles. Make sure that the dimensions are correct and the determinate is
-   * not 0.
+   * Inverts a square matrix, 2x2 to 4x4 matrices with closed formulas, bigger
+   * matrices with an LU decomposition. Make sure that the dimensions are
+   * correct and the determinate is not 0. To solve a system of equations
+   * use solve(), which does not form the inverse. The inverse of a float matrix
+   * is a float matrix, all other types are inverted in double.
    *
    * @return inverse of the matrix
    */
-  Matrix<N, M, double> inverse() const {
+  Matrix<N, M, std::conditional_t<std::is_floating_point_v<T>, T, double>> inverse() const {
+    using F = std::conditional_t<std::is_floating_point_v<T>, T, double>;
     if (isInvertible()) {
       if (M == 2) {  // 2x2 matrix
         T det = (*this).det();
-        Matrix<N, M, double> inv, subDetMat;
+        Matrix<N, M, F> inv, subDetMat;
         if (det != 0.0) {
           subDetMat[0] = value[3];
           subDetMat[1] = -value[2];
@@ -448,7 +484,7 @@ class Matrix {
         return inv;
       } else if (M == 3) {  // 3x3 matrix
         T det = (*this).det();
-        Matrix<N, M, double> inv, subDetMat;
+        Matrix<N, M, F> inv, subDetMat;
         if (det != 0.0) {
           subDetMat[0] = value[4] * value[8] - value[5] * value[7];
           subDetMat[1] = value[5] * value[6] - value[3] * value[8];
@@ -465,7 +501,7 @@ class Matrix {
         return inv;
       } else if (M == 4) {  // 4x4 matrix
         T det = (*this).det();
-        Matrix<N, M, double> inv, subDetMat;
+        Matrix<N, M, F> inv, subDetMat;
         if (det != 0.0) {
           subDetMat(0) = value[5] * value[10] * value[15] -
                          value[5] * value[11] * value[14] -
@@ -563,8 +599,18 @@ class Matrix {
           inv = subDetMat * 1 / det;
         }
         return inv;
-      } else
-        throw Fault("inverse is only implemented for up to 4x4 matrices");
+      } else {
+        Matrix<N, M, F> inv;
+        if constexpr (M == N) {
+          F lu[M * N];
+          unsigned int pivot[M];
+          for (unsigned int i = 0; i < M * N; i++) lu[i] = static_cast<F>(value[i]);
+          kernel::lu<M>(lu, pivot);
+          inv.eye();
+          kernel::luSolve<M, M>(lu, pivot, inv.data());
+        }
+        return inv;
+      }
     } else {
       throw Fault("Inverting matrix failed: Matrix must be invertible");
     }
@@ -580,10 +626,10 @@ class Matrix {
    * @return true if every element of this matrix is equal to the element in the
    * matrix right.
    */
-  bool operator==(const Matrix<M, N, T>& right) const {
+  constexpr bool operator==(const Matrix<M, N, T>& right) const {
     for (unsigned int m = 0; m < M; m++) {
       for (unsigned int n = 0; n < N; n++) {
-        if ((*this)(m, n) != right(m, n)) return false;
+        if (element(m, n) != right(m, n)) return false;
       }
     }
     return true;
@@ -597,10 +643,10 @@ class Matrix {
    * @return true if at least one element of this matrix is not equal to the
    * element in the matrix right.
    */
-  bool operator!=(const Matrix<M, N, T>& right) const {
+  constexpr bool operator!=(const Matrix<M, N, T>& right) const {
     for (unsigned int m = 0; m < M; m++) {
       for (unsigned int n = 0; n < N; n++) {
-        if ((*this)(m, n) != right(m, n)) {
+        if (element(m, n) != right(m, n)) {
           return true;
         }
       }
@@ -619,7 +665,7 @@ class Matrix {
   bool operator<(const Matrix<M, N, T>& right) const {
     for (unsigned int m = 0; m < M; m++) {
       for (unsigned int n = 0; n < N; n++) {
-        if ((*this)(m, n) >= right(m, n)) {
+        if (element(m, n) >= right(m, n)) {
           return false;
         }
       }
@@ -638,7 +684,7 @@ class Matrix {
   bool operator<=(const Matrix<M, N, T>& right) const {
     for (unsigned int m = 0; m < M; m++) {
       for (unsigned int n = 0; n < N; n++) {
-        if ((*this)(m, n) > right(m, n)) {
+        if (element(m, n) > right(m, n)) {
           return false;
         }
       }
@@ -657,7 +703,7 @@ class Matrix {
   bool operator>(const Matrix<M, N, T>& right) const {
     for (unsigned int m = 0; m < M; m++) {
       for (unsigned int n = 0; n < N; n++) {
-        if ((*this)(m, n) <= right(m, n)) {
+        if (element(m, n) <= right(m, n)) {
           return false;
         }
       }
@@ -676,7 +722,7 @@ class Matrix {
   bool operator>=(const Matrix<M, N, T>& right) const {
     for (unsigned int m = 0; m < M; m++) {
       for (unsigned int n = 0; n < N; n++) {
-        if ((*this)(m, n) < right(m, n)) {
+        if (element(m, n) < right(m, n)) {
           return false;
         }
       }
@@ -684,124 +730,50 @@ class Matrix {
     return true;
   }
 
-  Matrix<M, N, T>& operator=(T right) {
+  constexpr Matrix<M, N, T>& operator=(T right) {
     for (unsigned int m = 0; m < M; m++) {
       for (unsigned int n = 0; n < N; n++) {
-        (*this)(m, n) = right;
+        element(m, n) = right;
       }
     }
     return *this;
   }
 
   /**
-   * Multiply matrix with second matrix, vector product
+   * Evaluates a matrix expression into this matrix.
    */
-  template <unsigned int K>
-  Matrix<M, K, T> operator*(const Matrix<N, K, T> right) const {
-    Matrix<M, K, T> result;
-    for (unsigned int m = 0; m < M; m++) {
-      for (unsigned int k = 0; k < K; k++) {
-        result(m, k) = 0;
-        for (unsigned int n = 0; n < N; n++) {
-          result(m, k) += (*this)(m, n) * right(n, k);
-        }
-      }
-    }
-    return result;
-  }
-
-  /**
-   * Each element of the matrix is multiplied with the parameter
-   * which is the base type of the matrix
-   */
-  Matrix<M, N, T> operator*(T right) const {
-    Matrix<M, N, T> result;
-    for (unsigned int m = 0; m < M; m++) {
-      for (unsigned int n = 0; n < N; n++) {
-        result(m, n) = (*this)(m, n) * right;
-      }
-    }
-    return result;
-  }
-
-  Matrix<M, N, T> multiplyElementWise(const Matrix<M, N, T> right) const {
-    Matrix<M, N, T> result;
-    for (unsigned int m = 0; m < M; m++) {
-      for (unsigned int n = 0; n < N; n++) {
-        result(m, n) = (*this)(m, n) * right(m, n);
-      }
-    }
-    return result;
-  }
-
-  Matrix<M, N, T> operator+(const Matrix<M, N, T> right) const {
-    Matrix<M, N, T> result;
-    for (unsigned int m = 0; m < M; m++) {
-      for (unsigned int n = 0; n < N; n++) {
-        result(m, n) = (*this)(m, n) + right(m, n);
-      }
-    }
-    return result;
+  template <typename Node>
+  Matrix<M, N, T>& operator=(const MatrixExpression<M, N, T, Node>& right) {
+    right.evalTo(value);
+    return *this;
   }
 
-  Matrix<M, N, T> operator+(const T right) const {
+  Matrix<M, N, T> multiplyElementWise(const Matrix<M, N, T>& right) const {
     Matrix<M, N, T> result;
-    for (unsigned int m = 0; m < M; m++) {
-      for (unsigned int n = 0; n < N; n++) {
-        result(m, n) = (*this)(m, n) + right;
-      }
-    }
+    kernel::elementwise<kernel::Mul>(result.value, value, right.value, M * N);
     return result;
   }
 
-  Matrix<M, N, T>& operator+=(const Matrix<M, N, T> right) {
-    (*this) = (*this) + right;
+  Matrix<M, N, T>& operator+=(const Matrix<M, N, T>& right) {
+    kernel::elementwise<kernel::Add>(value, value, right.value, M * N);
     return (*this);
   }
 
-  Matrix<M, N, T> operator-(const Matrix<M, N, T> right) const {
-    Matrix<M, N, T> result;
-    for (unsigned int m = 0; m < M; m++) {
-      for (unsigned int n = 0; n < N; n++) {
-        result(m, n) = (*this)(m, n) - right(m, n);
-      }
-    }
-    return result;
-  }
-
-  Matrix<M, N, T> operator-(const T right) const {
-    Matrix<M, N, T> result;
-    for (unsigned int m = 0; m < M; m++) {
-      for (unsigned int n = 0; n < N; n++) {
-        result(m, n) = (*this)(m, n) - right;
-      }
-    }
-    return result;
-  }
-
-  Matrix<M, N, T>& operator-=(const Matrix<M, N, T> right) {
-    (*this) = (*this) - right;
+  template <typename Node>
+  Matrix<M, N, T>& operator+=(const MatrixExpression<M, N, T, Node>& right) {
+    for (unsigned int i = 0; i < M * N; i++) value[i] += right.node[i];
     return (*this);
   }
 
-  Matrix<M, N, T> operator-() {
-    Matrix<M, N, T> result;
-    for (unsigned int m = 0; m < M; m++) {
-      for (unsigned int n = 0; n < N; n++) {
-        result(m, n) = -(*this)(m, n);
-      }
-    }
-    return result;
+  Matrix<M, N, T>& operator-=(const Matrix<M, N, T>& right) {
+    kernel::elementwise<kernel::Sub>(value, value, right.value, M * N);
+    return (*this);
   }
 
-  Matrix<M, N, T> operator/(T right) const {
-    Matrix<M, N, T> result;
-    for (unsigned int m = 0; m < M; m++) {
-      for (unsigned int n = 0; n < N; n++) {
-        result(m, n) = (*this)(m, n) / right;
-      }
-    }
-    return result;
+  template <typename Node>
+  Matrix<M, N, T>& operator-=(const MatrixExpression<M, N, T, Node>& right) {
+    for (unsigned int i = 0; i < M * N; i++) value[i] -= right.node[i];
+    return (*this);
   }
 
   Matrix<M, N, T> operator!() const {
@@ -841,54 +813,49 @@ class Matrix {
           (*this)(0, 0) * (*this)(1, 1) - (*this)(0, 1) * (*this)(1, 0);
       return result / determinant;
     } else {
-      // This algorithm needs a lot of time maybe there is a better one?
       Matrix<M, N, T> result;
-      Matrix<M - 1, N - 1, T> smallerPart;
-      for (unsigned int m = 0; m < M; m++) {
-        for (unsigned int n = 0; n < N; n++) {
-          unsigned int a = 0, b = 0;
-          // 1. Create "matrix of minors"
-          for (unsigned int u = 0; u < M; u++) {
-            for (unsigned int w = 0; w < N; w++) {
-              if (u != m && w != n) {
-                smallerPart(a, b) = (*this)(u, w);
-                b++;
-                b = b % (N - 1);
-              }
-            }
-            if (u != m) {
-              a++;
-              a = a & (M - 1);
-            }
-          }
-          // 2. Swapp signs
-          if (m % 2 == 0) {
-            if (n % 2 != 0) {
-              result(m, n) = -smallerPart.det();
-            } else {
-              result(m, n) = smallerPart.det();
-            }
-          } else {
-            if (n % 2 != 0) {
-              result(m, n) = smallerPart.det();
-            } else {
-              result(m, n) = -smallerPart.det();
-            }
-          }
-          // 3. Divide throu det of the original matrix
-          result(m, n) = result(m, n) / determinant;
+      if constexpr (M == N) {
+        using F = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+        F lu[M * N], inv[M * N];
+        unsigned int pivot[M];
+        for (unsigned int i = 0; i < M * N; i++) {
+          lu[i] = static_cast<F>(value[i]);
+          inv[i] = (i % (M + 1) == 0) ? F(1) : F(0);
         }
+        kernel::lu<M>(lu, pivot);
+        kernel::luSolve<M, M>(lu, pivot, inv);
+        for (unsigned int i = 0; i < M * N; i++) result(i) = static_cast<T>(inv[i]);
       }
-      // 4. transpose
-      return result.transpose();
+      return result;
     }
   }
 
+  /**
+   * Solves the system of equations A * X = B with an LU decomposition with
+   * partial pivoting, without forming the inverse of A. For symmetric positive
+   * definite or overdetermined systems see CholeskyDecomposition and
+   * QRDecomposition in MatrixDecomposition.hpp.
+   *
+   * @param b - right hand side, one system per colum
+   * @return solution X
+   */
+  template <unsigned int K>
+  Matrix<N, K, T> solve(const Matrix<M, K, T>& b) const {
+    static_assert(M == N, "Solving needs a square matrix");
+    static_assert(std::is_floating_point_v<T>, "Solving needs a floating point value type");
+    unsigned int pivot[M];
+    Matrix<M, N, T> lu = (*this);
+    if (kernel::lu<M>(lu.data(), pivot) == 0) throw Fault("Solving failed: matrix is singular");
+    Matrix<N, K, T> x = b;
+    kernel::luSolve<M, K>(lu.data(), pivot, x.data());
+    return x;
+  }
+
   T norm() const {
     T result = 0;
     for (unsigned int m = 0; m < M; m++) {
       for (unsigned int n = 0; n < N; n++) {
-        result += (*this)(m, n) * (*this)(m, n);
+        result += element(m, n) * element(m, n);
       }
     }
     return std::sqrt(result);
@@ -896,32 +863,32 @@ class Matrix {
 
   /********** Static functions **********/
 
-  static Matrix<M, N, T> createRotX(double angle) {
+  static constexpr Matrix<M, N, T> createRotX(double angle) {
     Matrix<M, N, T> m;
     m.rotx(angle);
     return m;
   }
 
-  static Matrix<M, N, T> createRotY(double angle) {
+  static constexpr Matrix<M, N, T> createRotY(double angle) {
     Matrix<M, N, T> m;
     m.roty(angle);
     return m;
   }
 
-  static Matrix<M, N, T> createRotZ(double angle) {
+  static constexpr Matrix<M, N, T> createRotZ(double angle) {
     Matrix<M, N, T> m;
     m.rotz(angle);
     return m;
   }
 
-  static Matrix<2, 1, T> createVector2(T x, T y) {
+  static constexpr Matrix<2, 1, T> createVector2(T x, T y) {
     Matrix<2, 1, T> v;
     v(0) = x;
     v(1) = y;
     return v;
   }
 
-  static Matrix<3, 1, T> createVector3(T x, T y, T z) {
+  static constexpr Matrix<3, 1, T> createVector3(T x, T y, T z) {
     Matrix<3, 1, T> v;
     v(0) = x;
     v(1) = y;
@@ -938,10 +905,12 @@ class Matrix {
    *
    * @return diagonal matrix
    */
-  static Matrix<M, N, T> createDiag(T v) {
+  static constexpr Matrix<M, N, T> createDiag(T v) {
     Matrix<M, N, T> d;
-    d.eye();
-    return d * v;
+    d.zero();
+    unsigned int j = (M < N) ? M : N;
+    for (unsigned int i = 0; i < j; i++) d.element(i, i) = v;
+    return d;
   }
 
   /**
@@ -953,7 +922,7 @@ class Matrix {
    *
    * @return skew-symmetric matrix
    */
-  static Matrix<3, 3, T> createSkewSymmetric(Matrix<3, 1, T> a) {
+  static constexpr Matrix<3, 3, T> createSkewSymmetric(Matrix<3, 1, T> a) {
     Matrix<3, 3, T> result;
     result(0, 0) = 0;
     result(0, 1) = -a(2);
@@ -967,7 +936,7 @@ class Matrix {
     return result;
   }
 
-  static Matrix<3, 1, T> crossProduct(Matrix<3, 1, T> a, Matrix<3, 1, T> b) {
+  static constexpr Matrix<3, 1, T> crossProduct(Matrix<3, 1, T> a, Matrix<3, 1, T> b) {
     Matrix<3, 1, T> result;
     result(0, 0) = a(1, 0) * b(2, 0) - a(2, 0) * b(1, 0);
     result(1, 0) = a(2, 0) * b(0, 0) - a(0, 0) * b(2, 0);
@@ -986,13 +955,13 @@ class Matrix {
     while (completedColum < N) {
       rootRow = completedRow;
       checkingRow = rootRow + 1;
-      while (checkingRow < M && (*this)(rootRow, completedColum) != 0) {
-        if ((*this)(checkingRow, completedColum) != 0) {
-          rowFactor = (*this)(checkingRow, completedColum) /
-                      (*this)(rootRow, completedColum);
+      while (checkingRow < M && element(rootRow, completedColum) != 0) {
+        if (element(checkingRow, completedColum) != 0) {
+          rowFactor = element(checkingRow, completedColum) /
+                      element(rootRow, completedColum);
           for (unsigned int n = completedColum; n < N; n++) {
-            (*this)(checkingRow, n) =
-                (*this)(checkingRow, n) - rowFactor * (*this)(rootRow, n);
+            element(checkingRow, n) =
+                element(checkingRow, n) - rowFactor * element(rootRow, n);
           }
         }
         checkingRow++;
@@ -1008,7 +977,7 @@ class Matrix {
 
     while (completedColum < N) {
       while (completedRow < M) {
-        if ((*this)(completedRow, completedColum) == 0 && swapRow < M &&
+        if (element(completedRow, completedColum) == 0 && swapRow < M &&
             completedRow < M - 1) {
           swapRows(completedRow, swapRow);
           swapRow++;
@@ -1023,9 +992,9 @@ class Matrix {
 
   void swapRows(unsigned int rowA, unsigned int rowB) {
     for (unsigned int n = 0; n < N; n++) {
-      T t = (*this)(rowA, n);
-      (*this)(rowA, n) = (*this)(rowB, n);
-      (*this)(rowB, n) = t;
+      T t = element(rowA, n);
+      element(rowA, n) = element(rowB, n);
+      element(rowB, n) = t;
     }
   }
 
@@ -1034,7 +1003,7 @@ class Matrix {
     for (unsigned int n = 0; n < N; n++) {
       os << '[';
       for (unsigned int m = 0; m < M; m++) {
-        os << (*this)(m, n);
+        os << element(m, n);
         if (m < M - 1) os << ' ';
       }
       os << "]' ";
@@ -1043,70 +1012,248 @@ class Matrix {
   }
 
  protected:
-  T value[M * N];
+  template <unsigned int, unsigned int, typename> friend class Matrix;
+
+  /**
+   * Element access without checking the index, for loops over the own
+   * dimensions, which the compiler can then vectorize.
+   */
+  constexpr T& element(unsigned int m, unsigned int n) { return value[M * n + m]; }
+
+  constexpr const T& element(unsigned int m, unsigned int n) const { return value[M * n + m]; }
+
+  /**
+   * Returns the storage index of element m,n. An index out of bound throws, with
+   * EEROS_RT_HOTPATH it is reported to the FaultRegister and element 0 is used.
+   * Without EEROS_MATRIX_BOUNDS_CHECK, the index is not checked.
+   */
+  static constexpr unsigned int index(unsigned int m, unsigned int n) {
+    if (!checkedElementAccess || (m < M && n < N)) return M * n + m;
+#ifdef EEROS_RT_HOTPATH
+    FaultRegister::report(faults::matrixIndex);
+    return 0;
+#else
+    throw MatrixIndexOutOfBoundException(m, M, n, N);
+#endif
+  }
+
+  static constexpr unsigned int index(unsigned int i) {
+    if (!checkedElementAccess || i < M * N) return i;
+#ifdef EEROS_RT_HOTPATH
+    FaultRegister::report(faults::matrixIndex);
+    return 0;
+#else
+    throw MatrixIndexOutOfBoundException(i, M * N);
+#endif
+  }
+
+  alignas(alignment) T value[M * N];
 
 };  // END class Matrix
 
 /********** Operator overloads **********/
-// The following operator overloads are for the cases when the first parameter
-// of a matrix operation is of type T (base type of the matrix)
-// e.g. m2 = 3.5 + m1;
-template <unsigned int M, unsigned int N = 1, typename T = double>
-Matrix<M, N, T> operator+(T left, Matrix<M, N, T> right) {
-  Matrix<M, N, T> result;
-  for (unsigned int m = 0; m < M; m++) {
-    for (unsigned int n = 0; n < N; n++) {
-      result(m, n) = left + right(m, n);
-    }
-  }
-  return result;
+// Sums, differences and scalar operations return a MatrixExpression, which is
+// evaluated elementwise in a single loop when it is assigned to a matrix,
+// e.g. x = A * x + B * u - K * (y - C * x);
+// Matrix products are evaluated immediately.
+
+namespace expr {
+
+template <unsigned int M, unsigned int N, typename T>
+Matrix<M, N, T> matrixBase(const Matrix<M, N, T>*);
+
+void matrixBase(...);
+
+/**
+ * Properties of an operand of the matrix operators, which is a matrix, a class
+ * derived from a matrix or a matrix expression. 1x1 matrices are no elementwise
+ * operands, they convert to their value type and are treated as a scalar.
+ */
+template <typename X, typename B = decltype(matrixBase(static_cast<X*>(nullptr)))>
+struct Operand {
+  static constexpr bool elementwise = false;
+  static constexpr bool product = false;
+};
+
+template <typename X, unsigned int M, unsigned int N, typename T>
+struct Operand<X, Matrix<M, N, T>> {
+  static constexpr bool elementwise = (M * N > 1);
+  static constexpr bool product = true;
+  static constexpr unsigned int rows = M;
+  static constexpr unsigned int cols = N;
+  using type = T;
+  static Ref<T> node(const Matrix<M, N, T>& m) { return {m.data()}; }
+  static Value<M, N, T> node(Matrix<M, N, T>&& m) { return {std::move(m)}; }
+  static constexpr const Matrix<M, N, T>& eval(const Matrix<M, N, T>& m) { return m; }
+};
+
+template <unsigned int M, unsigned int N, typename T, typename Node>
+struct Operand<MatrixExpression<M, N, T, Node>, void> {
+  static constexpr bool elementwise = true;
+  static constexpr bool product = true;
+  static constexpr unsigned int rows = M;
+  static constexpr unsigned int cols = N;
+  using type = T;
+  static Node node(const MatrixExpression<M, N, T, Node>& e) { return e.node; }
+  static Node node(MatrixExpression<M, N, T, Node>&& e) { return std::move(e.node); }
+  static Matrix<M, N, T> eval(const MatrixExpression<M, N, T, Node>& e) { return e.eval(); }
+};
+
+template <typename X>
+using OperandOf = Operand<std::remove_cvref_t<X>>;
+
+template <typename X>
+concept ElementwiseOperand = OperandOf<X>::elementwise;
+
+template <typename L, typename R>
+concept SameShape = ElementwiseOperand<L> && ElementwiseOperand<R> &&
+                    OperandOf<L>::rows == OperandOf<R>::rows && OperandOf<L>::cols == OperandOf<R>::cols &&
+                    std::is_same_v<typename OperandOf<L>::type, typename OperandOf<R>::type>;
+
+template <typename L, typename R>
+concept Multipliable = ElementwiseOperand<L> && OperandOf<R>::product &&
+                       OperandOf<L>::cols == OperandOf<R>::rows &&
+                       std::is_same_v<typename OperandOf<L>::type, typename OperandOf<R>::type>;
+
+template <typename X>
+using ValueOf = typename OperandOf<X>::type;
+
+template <typename X>
+auto node(X&& x) { return OperandOf<X>::node(std::forward<X>(x)); }
+
+template <typename X, typename Node>
+using ExpressionOf = MatrixExpression<OperandOf<X>::rows, OperandOf<X>::cols, ValueOf<X>, Node>;
+
+template <typename Op, typename L, typename R>
+auto binary(L&& left, R&& right) {
+  using Node = Binary<Op, decltype(node(std::forward<L>(left))), decltype(node(std::forward<R>(right)))>;
+  return ExpressionOf<L, Node>{Node{node(std::forward<L>(left)), node(std::forward<R>(right))}};
 }
 
-template <unsigned int M, unsigned int N = 1, typename T = double>
-Matrix<M, N, T> operator-(T left, Matrix<M, N, T> right) {
-  Matrix<M, N, T> result;
-  for (unsigned int m = 0; m < M; m++) {
-    for (unsigned int n = 0; n < N; n++) {
-      result(m, n) = left - right(m, n);
-    }
-  }
-  return result;
+template <typename Op, typename L>
+auto scalarRight(L&& left, ValueOf<L> right) {
+  using Node = ScalarRight<Op, decltype(node(std::forward<L>(left))), ValueOf<L>>;
+  return ExpressionOf<L, Node>{Node{node(std::forward<L>(left)), right}};
 }
 
-template <unsigned int M, unsigned int N = 1, typename T = double>
-Matrix<M, N, T> operator-(const Matrix<M, N, T>& right) {
-  Matrix<M, N, T> result;
-  for (unsigned int m = 0; m < M; m++) {
-    for (unsigned int n = 0; n < N; n++) {
-      result(m, n) = -right(m, n);
+template <typename Op, typename R>
+auto scalarLeft(ValueOf<R> left, R&& right) {
+  using Node = ScalarLeft<Op, ValueOf<R>, decltype(node(std::forward<R>(right)))>;
+  return ExpressionOf<R, Node>{Node{left, node(std::forward<R>(right))}};
+}
+
+}
+
+/**
+ * Multiply matrix with second matrix, vector product
+ */
+template <typename L, typename R>
+  requires expr::Multipliable<L, R>
+constexpr Matrix<expr::OperandOf<L>::rows, expr::OperandOf<R>::cols, expr::ValueOf<L>> operator*(L&& left, R&& right) {
+  constexpr unsigned int M = expr::OperandOf<L>::rows, N = expr::OperandOf<L>::cols, K = expr::OperandOf<R>::cols;
+  Matrix<M, K, expr::ValueOf<L>> result;
+  const auto& l = expr::OperandOf<L>::eval(left);
+  const auto& r = expr::OperandOf<R>::eval(right);
+  if (std::is_constant_evaluated()) {
+    for (unsigned int k = 0; k < K; k++) {
+      for (unsigned int m = 0; m < M; m++) {
+        expr::ValueOf<L> sum = 0;
+        for (unsigned int n = 0; n < N; n++) sum += l(m, n) * r(n, k);
+        result(m, k) = sum;
+      }
     }
+  } else {
+    kernel::multiply<M, N, K>(result.data(), l.data(), r.data());
   }
   return result;
 }
 
+template <typename L, typename R>
+  requires expr::SameShape<L, R>
+auto operator+(L&& left, R&& right) {
+  return expr::binary<kernel::Add>(std::forward<L>(left), std::forward<R>(right));
+}
+
+template <typename L, typename R>
+  requires expr::SameShape<L, R>
+auto operator-(L&& left, R&& right) {
+  return expr::binary<kernel::Sub>(std::forward<L>(left), std::forward<R>(right));
+}
+
+template <typename R>
+  requires expr::ElementwiseOperand<R>
+auto operator-(R&& right) {
+  return expr::scalarRight<kernel::Mul>(std::forward<R>(right), expr::ValueOf<R>(-1));
+}
+
+/**
+ * Each element of the matrix is multiplied with the parameter
+ * which is the base type of the matrix
+ */
+template <typename L>
+  requires expr::ElementwiseOperand<L>
+auto operator*(L&& left, expr::ValueOf<L> right) {
+  return expr::scalarRight<kernel::Mul>(std::forward<L>(left), right);
+}
+
+template <typename L>
+  requires expr::ElementwiseOperand<L>
+auto operator/(L&& left, expr::ValueOf<L> right) {
+  return expr::scalarRight<kernel::Div>(std::forward<L>(left), right);
+}
+
+template <typename L>
+  requires expr::ElementwiseOperand<L>
+auto operator+(L&& left, expr::ValueOf<L> right) {
+  return expr::scalarRight<kernel::Add>(std::forward<L>(left), right);
+}
+
+template <typename L>
+  requires expr::ElementwiseOperand<L>
+auto operator-(L&& left, expr::ValueOf<L> right) {
+  return expr::scalarRight<kernel::Sub>(std::forward<L>(left), right);
+}
+
+// The following operator overloads are for the cases when the first parameter
+// of a matrix operation is of type T (base type of the matrix)
+// e.g. m2 = 3.5 + m1;
+template <typename R>
+  requires expr::ElementwiseOperand<R>
+auto operator+(expr::ValueOf<R> left, R&& right) {
+  return expr::scalarLeft<kernel::Add>(left, std::forward<R>(right));
+}
+
+template <typename R>
+  requires expr::ElementwiseOperand<R>
+auto operator-(expr::ValueOf<R> left, R&& right) {
+  return expr::scalarLeft<kernel::Sub>(left, std::forward<R>(right));
+}
+
 /**
  * Multiply base of matrix with matrix
  */
-template <unsigned int M, unsigned int N = 1, typename T = double>
-Matrix<M, N, T> operator*(T left, Matrix<M, N, T> right) {
-  Matrix<M, N, T> result;
-  for (unsigned int m = 0; m < M; m++) {
-    for (unsigned int n = 0; n < N; n++) {
-      result(m, n) = left * right(m, n);
-    }
-  }
-  return result;
+template <typename R>
+  requires expr::ElementwiseOperand<R>
+auto operator*(expr::ValueOf<R> left, R&& right) {
+  return expr::scalarLeft<kernel::Mul>(left, std::forward<R>(right));
 }
 
-template <unsigned int M, unsigned int N = 1, typename T = double>
-Matrix<M, N, T> operator/(T left, Matrix<M, N, T> right) {
-  Matrix<M, N, T> result;
-  for (unsigned int m = 0; m < M; m++) {
-    for (unsigned int n = 0; n < N; n++) {
-      result(m, n) = left / right(m, n);
-    }
-  }
-  return result;
+template <typename R>
+  requires expr::ElementwiseOperand<R>
+auto operator/(expr::ValueOf<R> left, R&& right) {
+  return expr::scalarLeft<kernel::Div>(left, std::forward<R>(right));
+}
+
+template <unsigned int M, unsigned int N, typename T, typename Node, typename R>
+  requires expr::SameShape<MatrixExpression<M, N, T, Node>, R>
+bool operator==(const MatrixExpression<M, N, T, Node>& left, const R& right) {
+  return left.eval() == expr::OperandOf<R>::eval(right);
+}
+
+template <unsigned int M, unsigned int N, typename T, typename Node, typename R>
+  requires expr::SameShape<MatrixExpression<M, N, T, Node>, R>
+bool operator!=(const MatrixExpression<M, N, T, Node>& left, const R& right) {
+  return left.eval() != expr::OperandOf<R>::eval(right);
 }
 
 /********** Print functions **********/
@@ -1133,6 +1280,8 @@ class Matrix<1, 1, T> {
  public:
   using value_type = T;
 
+  static constexpr unsigned int nofElements = 1;
+
   Matrix() {}
 
   Matrix(const T v) { value = v; }
@@ -1143,6 +1292,10 @@ class Matrix<1, 1, T> {
 
   void fill(T v) { value = v; }
 
+  T* data() { return &value; }
+
+  const T* data() const { return &value; }
+
   const T get(uint8_t m, uint8_t n) const { return (*this)(m, n); }
 
   Matrix<1, 1, T> getCol(uint8_t n) const { return (*this); }
@@ -1152,45 +1305,33 @@ class Matrix<1, 1, T> {
   void set(uint8_t m, uint8_t n, T value) { (*this)(m, n) = value; }
 
   T& operator()(uint8_t m, uint8_t n) {
-    if (m == 0 && n == 0)
-      return value;
-    else
-      throw MatrixIndexOutOfBoundException(m, 1, n, 1);
+    if (checkedElementAccess && !(m == 0 && n == 0)) outOfBound(m, 1, n, 1);
+    return value;
   }
 
   const T operator()(uint8_t m, uint8_t n) const {
-    if (m == 0 && n == 0)
-      return value;
-    else
-      throw MatrixIndexOutOfBoundException(m, 1, n, 1);
+    if (checkedElementAccess && !(m == 0 && n == 0)) outOfBound(m, 1, n, 1);
+    return value;
   }
 
   T& operator()(unsigned int i) {
-    if (i == 0)
-      return value;
-    else
-      throw MatrixIndexOutOfBoundException(i, 1);
+    if (checkedElementAccess && !(i == 0)) outOfBound(i, 1);
+    return value;
   }
 
   const T operator()(unsigned int i) const {
-    if (i == 0)
-      return value;
-    else
-      throw MatrixIndexOutOfBoundException(i, 1);
+    if (checkedElementAccess && !(i == 0)) outOfBound(i, 1);
+    return value;
   }
 
   T& operator[](unsigned int i) {
-    if (i == 0)
-      return value;
-    else
-      throw MatrixIndexOutOfBoundException(i, 1);
+    if (checkedElementAccess && !(i == 0)) outOfBound(i, 1);
+    return value;
   }
 
   const T operator[](unsigned int i) const {
-    if (i == 0)
-      return value;
-    else
-      throw MatrixIndexOutOfBoundException(i, 1);
+    if (checkedElementAccess && !(i == 0)) outOfBound(i, 1);
+    return value;
   }
 
   constexpr bool isSquare() const { return true; }
@@ -1241,9 +1382,56 @@ class Matrix<1, 1, T> {
   }
 
  protected:
+  template <unsigned int, unsigned int, typename> friend class Matrix;
+
+  constexpr T& element(unsigned int, unsigned int) { return value; }
+
+  constexpr const T& element(unsigned int, unsigned int) const { return value; }
+
+  /**
+   * Throws on an index out of bound, with EEROS_RT_HOTPATH it is reported
+   * to the FaultRegister and the only element is used.
+   */
+  template <typename... I>
+  static void outOfBound(I... i) {
+#ifdef EEROS_RT_HOTPATH
+    FaultRegister::report(faults::matrixIndex);
+#else
+    throw MatrixIndexOutOfBoundException(i...);
+#endif
+  }
+
   T value;
 };
 
+/**
+ * Element type and shape of a signal value, which is either a scalar or a matrix.
+ * Blocks use it to process the elements of a value as separate channels.
+ *
+ * @tparam T - scalar or matrix type
+ *
+ * @since v1.4.4
+ */
+template <typename T>
+struct ValueShape {
+  using value_type = T;
+  static constexpr unsigned int rows = 1;
+  static constexpr unsigned int cols = 1;
+  static constexpr unsigned int size = 1;
+  static value_type* data(T& v) { return &v; }
+  static const value_type* data(const T& v) { return &v; }
+};
+
+template <unsigned int M, unsigned int N, typename T>
+struct ValueShape<Matrix<M, N, T>> {
+  using value_type = T;
+  static constexpr unsigned int rows = M;
+  static constexpr unsigned int cols = N;
+  static constexpr unsigned int size = M * N;
+  static value_type* data(Matrix<M, N, T>& v) { return v.data(); }
+  static const value_type* data(const Matrix<M, N, T>& v) { return v.data(); }
+};
+
 }  // namespace math
 }  // namespace eeros
 
@@ -0,0 +1,241 @@
+#ifndef ORG_EEROS_MATH_MATRIXBATCH_HPP_
+#define ORG_EEROS_MATH_MATRIXBATCH_HPP_
+
+#include <eeros/math/Matrix.hpp>
+#include <eeros/math/MatrixKernels.hpp>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+namespace eeros {
+namespace math {
+
+/**
+ * Batch of K matrices of the same size, e.g. the rotations or the inertias of
+ * all axes of a robot. The elements are stored as structure of arrays: the K
+ * values of element (m, n) lie one after the other, the elements in column major
+ * order like in Matrix. An operation on the batch is a sequence of operations on
+ * these arrays of length K, which the kernels run on the vector unit across the
+ * matrices, instead of one small matrix after the other.
+ *
+ * @tparam K - number of matrices
+ * @tparam M - number of rows
+ * @tparam N - number of columns
+ * @tparam T - value type (double - default type)
+ *
+ * @since v1.4.4
+ */
+template < unsigned int K, unsigned int M, unsigned int N, typename T = double >
+class MatrixBatch {
+ public:
+  using value_type = T;
+
+  /**
+   * Constructs a batch of zero matrices.
+   */
+  MatrixBatch() { zero(); }
+
+  /**
+   * Sets all matrices to 0.
+   */
+  void zero() {
+    for (auto& v : value) v = 0;
+  }
+
+  /**
+   * Sets all matrices to the identity.
+   */
+  void eye() {
+    zero();
+    for (unsigned int i = 0; i < M && i < N; i++) {
+      T* r = lanes(i, i);
+      for (unsigned int k = 0; k < K; k++) r[k] = 1;
+    }
+  }
+
+  /**
+   * @param k - index of the matrix
+   * @param m - row
+   * @param n - column
+   * @return element (m, n) of matrix k
+   */
+  T& operator()(unsigned int k, unsigned int m, unsigned int n) { return value[(n * M + m) * K + k]; }
+  T operator()(unsigned int k, unsigned int m, unsigned int n) const { return value[(n * M + m) * K + k]; }
+
+  /**
+   * @param m - row
+   * @param n - column
+   * @return array with element (m, n) of all K matrices
+   */
+  T* lanes(unsigned int m, unsigned int n) { return value + (n * M + m) * K; }
+  const T* lanes(unsigned int m, unsigned int n) const { return value + (n * M + m) * K; }
+
+  /**
+   * Sets one matrix of the batch.
+   *
+   * @param k - index of the matrix
+   * @param a - matrix
+   */
+  void set(unsigned int k, const Matrix<M, N, T>& a) {
+    for (unsigned int n = 0; n < N; n++) {
+      for (unsigned int m = 0; m < M; m++) (*this)(k, m, n) = a(m, n);
+    }
+  }
+
+  /**
+   * @param k - index of the matrix
+   * @return matrix k of the batch
+   */
+  Matrix<M, N, T> get(unsigned int k) const {
+    Matrix<M, N, T> a;
+    for (unsigned int n = 0; n < N; n++) {
+      for (unsigned int m = 0; m < M; m++) a(m, n) = (*this)(k, m, n);
+    }
+    return a;
+  }
+
+  /**
+   * @return batch of the transposed matrices
+   */
+  MatrixBatch<K, N, M, T> transpose() const {
+    MatrixBatch<K, N, M, T> result;
+    for (unsigned int n = 0; n < N; n++) {
+      for (unsigned int m = 0; m < M; m++) {
+        const T* a = lanes(m, n);
+        T* r = result.lanes(n, m);
+        for (unsigned int k = 0; k < K; k++) r[k] = a[k];
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Multiplies each matrix with the matrix of the same index of another batch.
+   *
+   * @param right - batch of the right operands
+   * @return batch of the products
+   */
+  template < unsigned int J >
+  MatrixBatch<K, M, J, T> operator*(const MatrixBatch<K, N, J, T>& right) const {
+    MatrixBatch<K, M, J, T> result;
+    for (unsigned int j = 0; j < J; j++) {
+      for (unsigned int n = 0; n < N; n++) {
+        const T* b = right.lanes(n, j);
+        for (unsigned int m = 0; m < M; m++) kernel::multiplyAdd(result.lanes(m, j), lanes(m, n), b, K);
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Multiplies each matrix with the same matrix, e.g. a constant offset transform.
+   *
+   * @param right - right operand of all products
+   * @return batch of the products
+   */
+  template < unsigned int J >
+  MatrixBatch<K, M, J, T> operator*(const Matrix<N, J, T>& right) const {
+    MatrixBatch<K, M, J, T> result;
+    for (unsigned int j = 0; j < J; j++) {
+      for (unsigned int n = 0; n < N; n++) {
+        T b = right(n, j);
+        for (unsigned int m = 0; m < M; m++) kernel::axpy(result.lanes(m, j), lanes(m, n), b, K);
+      }
+    }
+    return result;
+  }
+
+  MatrixBatch operator+(const MatrixBatch& right) const {
+    MatrixBatch result;
+    kernel::elementwise<kernel::Add>(result.value, value, right.value, M * N * K);
+    return result;
+  }
+
+  MatrixBatch operator-(const MatrixBatch& right) const {
+    MatrixBatch result;
+    kernel::elementwise<kernel::Sub>(result.value, value, right.value, M * N * K);
+    return result;
+  }
+
+  MatrixBatch operator*(T right) const {
+    MatrixBatch result;
+    kernel::elementwise<kernel::Mul>(result.value, value, right, M * N * K);
+    return result;
+  }
+
+  bool operator==(const MatrixBatch& right) const {
+    for (unsigned int i = 0; i < M * N * K; i++) {
+      if (value[i] != right.value[i]) return false;
+    }
+    return true;
+  }
+
+  bool operator!=(const MatrixBatch& right) const { return !(*this == right); }
+
+  /**
+   * Inverts the square matrices by Gauss-Jordan elimination. The pivot is
+   * searched per matrix, the elimination runs across the batch. A singular
+   * matrix is inverted to the zero matrix, like Matrix::inverse().
+   *
+   * @param result - batch of the inverses
+   * @return true if all matrices are invertible
+   */
+  bool inverse(MatrixBatch<K, N, M, T>& result) const {
+    static_assert(M == N, "only square matrices can be inverted");
+    static_assert(std::is_floating_point_v<T>, "only floating point matrices can be inverted");
+    MatrixBatch a = *this;
+    result.eye();
+    bool singular[K] = {};
+    T f[K];
+    for (unsigned int c = 0; c < N; c++) {
+      // partial pivoting per matrix, rows are swapped element by element
+      for (unsigned int k = 0; k < K; k++) {
+        unsigned int p = c;
+        for (unsigned int r = c + 1; r < N; r++) {
+          if (std::fabs(a(k, r, c)) > std::fabs(a(k, p, c))) p = r;
+        }
+        if (a(k, p, c) == 0) {
+          singular[k] = true;
+          a(k, c, c) = 1;   // keeps the lane finite, it is cleared at the end
+          continue;
+        }
+        if (p != c) {
+          for (unsigned int j = 0; j < N; j++) {
+            std::swap(a(k, p, j), a(k, c, j));
+            std::swap(result(k, p, j), result(k, c, j));
+          }
+        }
+      }
+      kernel::elementwise<kernel::Div>(f, static_cast<T>(1), a.lanes(c, c), K);
+      for (unsigned int j = 0; j < N; j++) {
+        kernel::elementwise<kernel::Mul>(a.lanes(c, j), a.lanes(c, j), f, K);
+        kernel::elementwise<kernel::Mul>(result.lanes(c, j), result.lanes(c, j), f, K);
+      }
+      for (unsigned int r = 0; r < N; r++) {
+        if (r == c) continue;
+        kernel::elementwise<kernel::Mul>(f, a.lanes(r, c), static_cast<T>(-1), K);
+        for (unsigned int j = 0; j < N; j++) {
+          kernel::multiplyAdd(a.lanes(r, j), f, a.lanes(c, j), K);
+          kernel::multiplyAdd(result.lanes(r, j), f, result.lanes(c, j), K);
+        }
+      }
+    }
+    bool invertible = true;
+    for (unsigned int k = 0; k < K; k++) {
+      if (!singular[k]) continue;
+      invertible = false;
+      for (unsigned int j = 0; j < N; j++) {
+        for (unsigned int m = 0; m < M; m++) result(k, m, j) = 0;
+      }
+    }
+    return invertible;
+  }
+
+ private:
+  alignas(32) T value[M * N * K];
+};
+
+}
+}
+
+#endif // ORG_EEROS_MATH_MATRIXBATCH_HPP_
@@ -0,0 +1,285 @@
+#ifndef ORG_EEROS_MATH_MATRIXDECOMPOSITION_HPP_
+#define ORG_EEROS_MATH_MATRIXDECOMPOSITION_HPP_
+
+#include <eeros/core/Fault.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <type_traits>
+
+namespace eeros {
+namespace math {
+
+/**
+ * LU decomposition with partial pivoting, P * A = L * U, of a square matrix.
+ * The factors are computed once in the constructor and can be used to solve
+ * several systems of equations. No memory is allocated.
+ *
+ * @tparam N - number of rows and colums
+ * @tparam T - value type (double - default type)
+ *
+ * @since v1.4.4
+ */
+template <unsigned int N, typename T = double>
+class LUDecomposition {
+  static_assert(std::is_floating_point_v<T>, "LU decomposition needs a floating point value type");
+
+ public:
+  /**
+   * Decomposes a matrix.
+   *
+   * @param a - square matrix
+   */
+  LUDecomposition(const Matrix<N, N, T>& a) : lu(a) {
+    sign = kernel::lu<N>(lu.data(), pivot);
+  }
+
+  /**
+   * @return true if the matrix is singular and no system can be solved
+   */
+  bool isSingular() const { return sign == 0; }
+
+  /**
+   * @return determinant of the matrix
+   */
+  T det() const {
+    if (sign == 0) return 0;
+    T d = sign;
+    for (unsigned int i = 0; i < N; i++) d *= lu(i, i);
+    return d;
+  }
+
+  /**
+   * Solves A * X = B without forming the inverse of A.
+   *
+   * @param b - right hand side, one system per colum
+   * @return solution X
+   */
+  template <unsigned int K>
+  Matrix<N, K, T> solve(const Matrix<N, K, T>& b) const {
+    if (sign == 0) throw Fault("Solving failed: matrix is singular");
+    Matrix<N, K, T> x = b;
+    kernel::luSolve<N, K>(lu.data(), pivot, x.data());
+    return x;
+  }
+
+  /**
+   * @return inverse of the matrix
+   */
+  Matrix<N, N, T> inverse() const {
+    Matrix<N, N, T> eye;
+    eye.eye();
+    return solve(eye);
+  }
+
+  /**
+   * @return unit lower triangular factor L
+   */
+  Matrix<N, N, T> getL() const {
+    Matrix<N, N, T> l;
+    for (unsigned int n = 0; n < N; n++) {
+      for (unsigned int m = 0; m < N; m++) l(m, n) = (m > n) ? lu(m, n) : (m == n) ? T(1) : T(0);
+    }
+    return l;
+  }
+
+  /**
+   * @return upper triangular factor U
+   */
+  Matrix<N, N, T> getU() const {
+    Matrix<N, N, T> u;
+    for (unsigned int n = 0; n < N; n++) {
+      for (unsigned int m = 0; m < N; m++) u(m, n) = (m <= n) ? lu(m, n) : T(0);
+    }
+    return u;
+  }
+
+  /**
+   * @return row permutation P
+   */
+  Matrix<N, N, T> getP() const {
+    unsigned int row[N];
+    for (unsigned int i = 0; i < N; i++) row[i] = i;
+    for (unsigned int i = 0; i < N && sign != 0; i++) std::swap(row[i], row[pivot[i]]);
+    Matrix<N, N, T> p;
+    p.zero();
+    for (unsigned int i = 0; i < N; i++) p(i, row[i]) = 1;
+    return p;
+  }
+
+ private:
+  Matrix<N, N, T> lu;
+  unsigned int pivot[N];
+  int sign;
+};
+
+/**
+ * Cholesky decomposition, A = L * L', of a symmetric positive definite matrix,
+ * e.g. a covariance matrix. It needs about half the operations of an LU
+ * decomposition. Only the lower triangle of the matrix is used.
+ *
+ * @tparam N - number of rows and colums
+ * @tparam T - value type (double - default type)
+ *
+ * @since v1.4.4
+ */
+template <unsigned int N, typename T = double>
+class CholeskyDecomposition {
+  static_assert(std::is_floating_point_v<T>, "Cholesky decomposition needs a floating point value type");
+
+ public:
+  /**
+   * Decomposes a matrix.
+   *
+   * @param a - symmetric positive definite matrix
+   */
+  CholeskyDecomposition(const Matrix<N, N, T>& a) : l(a) {
+    positiveDefinite = kernel::cholesky<N>(l.data());
+  }
+
+  /**
+   * @return true if the matrix is positive definite and the decomposition succeeded
+   */
+  bool isPositiveDefinite() const { return positiveDefinite; }
+
+  /**
+   * @return determinant of the matrix
+   */
+  T det() const {
+    if (!positiveDefinite) throw Fault("Cholesky decomposition failed: matrix is not positive definite");
+    T d = 1;
+    for (unsigned int i = 0; i < N; i++) d *= l(i, i) * l(i, i);
+    return d;
+  }
+
+  /**
+   * Solves A * X = B without forming the inverse of A.
+   *
+   * @param b - right hand side, one system per colum
+   * @return solution X
+   */
+  template <unsigned int K>
+  Matrix<N, K, T> solve(const Matrix<N, K, T>& b) const {
+    if (!positiveDefinite) throw Fault("Solving failed: matrix is not positive definite");
+    Matrix<N, K, T> x = b;
+    kernel::choleskySolve<N, K>(l.data(), x.data());
+    return x;
+  }
+
+  /**
+   * @return inverse of the matrix
+   */
+  Matrix<N, N, T> inverse() const {
+    Matrix<N, N, T> eye;
+    eye.eye();
+    return solve(eye);
+  }
+
+  /**
+   * @return lower triangular factor L
+   */
+  Matrix<N, N, T> getL() const {
+    Matrix<N, N, T> result;
+    for (unsigned int n = 0; n < N; n++) {
+      for (unsigned int m = 0; m < N; m++) result(m, n) = (m >= n) ? l(m, n) : T(0);
+    }
+    return result;
+  }
+
+ private:
+  Matrix<N, N, T> l;
+  bool positiveDefinite;
+};
+
+/**
+ * Householder QR decomposition, A = Q * R, of a matrix with at least as many rows
+ * as colums. solve() returns the least squares solution of an overdetermined system.
+ *
+ * @tparam M - number of rows
+ * @tparam N - number of colums
+ * @tparam T - value type (double - default type)
+ *
+ * @since v1.4.4
+ */
+template <unsigned int M, unsigned int N, typename T = double>
+class QRDecomposition {
+  static_assert(std::is_floating_point_v<T>, "QR decomposition needs a floating point value type");
+  static_assert(M >= N, "QR decomposition needs at least as many rows as colums");
+
+ public:
+  /**
+   * Decomposes a matrix.
+   *
+   * @param a - matrix
+   */
+  QRDecomposition(const Matrix<M, N, T>& a) : qr(a) {
+    kernel::qr<M, N>(qr.data(), tau);
+  }
+
+  /**
+   * @return true if the colums of the matrix are linearly independent
+   */
+  bool isFullRank() const {
+    for (unsigned int i = 0; i < N; i++) {
+      if (qr(i, i) == T(0)) return false;
+    }
+    return true;
+  }
+
+  /**
+   * Solves A * X = B, in the least squares sense if M > N.
+   *
+   * @param b - right hand side, one system per colum
+   * @return solution X
+   */
+  template <unsigned int K>
+  Matrix<N, K, T> solve(const Matrix<M, K, T>& b) const {
+    if (!isFullRank()) throw Fault("Solving failed: matrix does not have full rank");
+    Matrix<M, K, T> y = b;
+    kernel::qrApplyTransposedQ<M, N, K>(qr.data(), tau, y.data());
+    kernel::backSubstitute<N, K, M, M>(qr.data(), y.data());
+    Matrix<N, K, T> x;
+    for (unsigned int k = 0; k < K; k++) {
+      for (unsigned int n = 0; n < N; n++) x(n, k) = y(n, k);
+    }
+    return x;
+  }
+
+  /**
+   * @return orthogonal factor Q
+   */
+  Matrix<M, M, T> getQ() const {
+    Matrix<M, M, T> q;
+    q.eye();
+    // Q = H_0 * ... * H_(N-1), applied to the identity from the last reflection on
+    for (unsigned int k = N; k-- > 0;) {
+      const T* v = qr.data() + M * k;
+      for (unsigned int j = 0; j < M; j++) {
+        T w = q(k, j);
+        for (unsigned int i = k + 1; i < M; i++) w += v[i] * q(i, j);
+        w *= tau[k];
+        q(k, j) -= w;
+        for (unsigned int i = k + 1; i < M; i++) q(i, j) -= w * v[i];
+      }
+    }
+    return q;
+  }
+
+  /**
+   * @return upper triangular factor R
+   */
+  Matrix<M, N, T> getR() const {
+    Matrix<M, N, T> r;
+    for (unsigned int n = 0; n < N; n++) {
+      for (unsigned int m = 0; m < M; m++) r(m, n) = (m <= n) ? qr(m, n) : T(0);
+    }
+    return r;
+  }
+
+ private:
+  Matrix<M, N, T> qr;
+  T tau[N];
+};
+
+}
+}
+
+#endif // ORG_EEROS_MATH_MATRIXDECOMPOSITION_HPP_
@@ -0,0 +1,172 @@
+#ifndef ORG_EEROS_MATH_MATRIXEXPRESSION_HPP_
+#define ORG_EEROS_MATH_MATRIXEXPRESSION_HPP_
+
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include "MatrixIndexOutOfBoundException.hpp"
+#include "MatrixKernels.hpp"
+
+namespace eeros {
+namespace math {
+
+template <unsigned int M, unsigned int N, typename T>
+class Matrix;
+
+/**
+ * Nodes of a matrix expression. Each node returns the element with a
+ * given index in column major order, or for double and float values a vector
+ * of consecutive elements (see kernel::PackOf). The operations are only
+ * carried out when the expression is assigned to a matrix.
+ *
+ * @since v1.4.4
+ */
+namespace expr {
+
+/**
+ * Refers to the elements of an existing matrix.
+ */
+template <typename T>
+struct Ref {
+  const T* data;
+  T operator[](unsigned int i) const { return data[i]; }
+  template <typename P> typename P::V pack(unsigned int i) const { return P::load(data + i); }
+};
+
+/**
+ * Holds a matrix, e.g. a temporary or the result of a product.
+ */
+template <unsigned int M, unsigned int N, typename T>
+struct Value {
+  Matrix<M, N, T> matrix;
+  T operator[](unsigned int i) const { return matrix.data()[i]; }
+  template <typename P> typename P::V pack(unsigned int i) const { return P::load(matrix.data() + i); }
+};
+
+/**
+ * Elementwise operation of two nodes.
+ */
+template <typename Op, typename L, typename R>
+struct Binary {
+  L left;
+  R right;
+  auto operator[](unsigned int i) const { return Op::apply(left[i], right[i]); }
+  template <typename P> typename P::V pack(unsigned int i) const {
+    return Op::template pack<P>(left.template pack<P>(i), right.template pack<P>(i));
+  }
+};
+
+/**
+ * Elementwise operation of a node and a scalar.
+ */
+template <typename Op, typename L, typename T>
+struct ScalarRight {
+  L left;
+  T right;
+  T operator[](unsigned int i) const { return Op::apply(left[i], right); }
+  template <typename P> typename P::V pack(unsigned int i) const {
+    return Op::template pack<P>(left.template pack<P>(i), P::set(right));
+  }
+};
+
+/**
+ * Elementwise operation of a scalar and a node.
+ */
+template <typename Op, typename T, typename R>
+struct ScalarLeft {
+  T left;
+  R right;
+  T operator[](unsigned int i) const { return Op::apply(left, right[i]); }
+  template <typename P> typename P::V pack(unsigned int i) const {
+    return Op::template pack<P>(P::set(left), right.template pack<P>(i));
+  }
+};
+
+}
+
+/**
+ * A matrix expression is the result of an elementwise operation such as a sum.
+ * Chained operations are combined into one loop when the expression is assigned
+ * to a matrix, no temporary matrices are created for the intermediate results.
+ * Matrix products are evaluated immediately, since each element of a product
+ * needs a whole row and column of its operands.
+ *
+ * A matrix can be constructed from or assigned an expression. An expression
+ * stored with auto refers to its operands and is evaluated each time it is read,
+ * declare the variable as matrix to store the result.
+ *
+ * @tparam M - number of rows
+ * @tparam N - number of columns
+ * @tparam T - value type
+ * @tparam Node - expression node
+ *
+ * @since v1.4.4
+ */
+template <unsigned int M, unsigned int N, typename T, typename Node>
+class MatrixExpression {
+ public:
+  using value_type = T;
+
+  /**
+   * Returns the element with a given index in column major order.
+   */
+  T operator[](unsigned int i) const {
+    if (checkedElementAccess && i >= M * N) throw MatrixIndexOutOfBoundException(i, M * N);
+    return node[i];
+  }
+
+  T operator()(unsigned int i) const { return (*this)[i]; }
+
+  T operator()(unsigned int m, unsigned int n) const {
+    if (checkedElementAccess && (m >= M || n >= N)) throw MatrixIndexOutOfBoundException(m, M, n, N);
+    return node[M * n + m];
+  }
+
+  /**
+   * Writes all elements to the storage of a matrix.
+   *
+   * @param dst - elements of the target in column major order
+   */
+  void evalTo(T* dst) const {
+    unsigned int i = 0;
+#ifdef EEROS_MATH_DOUBLE_PACK
+    if constexpr (kernel::hasPack<T>) {
+      using P = typename kernel::PackOf<T>::type;
+      for (; i + P::width <= M * N; i += P::width) P::store(dst + i, node.template pack<P>(i));
+    }
+#endif
+    for (; i < M * N; i++) dst[i] = node[i];
+  }
+
+  /**
+   * Evaluates the expression.
+   *
+   * @return matrix
+   */
+  Matrix<M, N, T> eval() const {
+    Matrix<M, N, T> result;
+    evalTo(result.data());
+    return result;
+  }
+
+  Matrix<N, M, T> transpose() const { return eval().transpose(); }
+
+  T norm() const { return eval().norm(); }
+
+  constexpr unsigned int getNofRows() const { return M; }
+
+  constexpr unsigned int getNofColums() const { return N; }
+
+  Node node;
+};
+
+template <unsigned int M, unsigned int N, typename T, typename Node>
+std::ostream& operator<<(std::ostream& os, const MatrixExpression<M, N, T, Node>& right) {
+  right.eval().print(os);
+  return os;
+}
+
+}
+}
+
+#endif // ORG_EEROS_MATH_MATRIXEXPRESSION_HPP_
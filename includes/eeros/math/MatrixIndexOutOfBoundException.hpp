@@ -4,8 +4,24 @@
 #include <eeros/core/Fault.hpp>
 #include <string>
 
+/**
+ * The index of the matrix element access is checked unless NDEBUG is defined,
+ * so debug and test builds check it and release builds do not. Define
+ * EEROS_MATRIX_BOUNDS_CHECK as 1 or 0 to override the default, the same way
+ * for all translation units.
+ */
+#ifndef EEROS_MATRIX_BOUNDS_CHECK
+#ifdef NDEBUG
+#define EEROS_MATRIX_BOUNDS_CHECK 0
+#else
+#define EEROS_MATRIX_BOUNDS_CHECK 1
+#endif
+#endif
+
 namespace eeros {
 	namespace math {
+		constexpr bool checkedElementAccess = (EEROS_MATRIX_BOUNDS_CHECK != 0);
+
 		class MatrixIndexOutOfBoundException : public eeros::Fault {
 
 		public:
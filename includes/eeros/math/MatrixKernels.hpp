@@ -0,0 +1,703 @@
+#ifndef ORG_EEROS_MATH_MATRIXKERNELS_HPP_
+#define ORG_EEROS_MATH_MATRIXKERNELS_HPP_
+
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace eeros {
+namespace math {
+
+/**
+ * Kernels for the matrix operations, working on the flat column major storage
+ * of a matrix. For double and float values, the kernels use the widest vector
+ * unit the target is compiled for (AVX, SSE2 or NEON), other types are processed
+ * with plain loops, which the compiler may vectorize on its own.
+ *
+ * @since v1.4.4
+ */
+namespace kernel {
+
+#if defined(__AVX__)
+struct DoublePack {
+  using V = __m256d;
+  static constexpr unsigned int width = 4;
+  static V load(const double* p) { return _mm256_loadu_pd(p); }
+  static void store(double* p, V v) { _mm256_storeu_pd(p, v); }
+  static V set(double s) { return _mm256_set1_pd(s); }
+  static V add(V a, V b) { return _mm256_add_pd(a, b); }
+  static V sub(V a, V b) { return _mm256_sub_pd(a, b); }
+  static V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+  static V div(V a, V b) { return _mm256_div_pd(a, b); }
+  static V min(V a, V b) { return _mm256_min_pd(a, b); }
+  static V max(V a, V b) { return _mm256_max_pd(a, b); }
+};
+struct FloatPack {
+  using V = __m256;
+  static constexpr unsigned int width = 8;
+  static V load(const float* p) { return _mm256_loadu_ps(p); }
+  static void store(float* p, V v) { _mm256_storeu_ps(p, v); }
+  static V set(float s) { return _mm256_set1_ps(s); }
+  static V add(V a, V b) { return _mm256_add_ps(a, b); }
+  static V sub(V a, V b) { return _mm256_sub_ps(a, b); }
+  static V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+  static V div(V a, V b) { return _mm256_div_ps(a, b); }
+  static V min(V a, V b) { return _mm256_min_ps(a, b); }
+  static V max(V a, V b) { return _mm256_max_ps(a, b); }
+};
+#define EEROS_MATH_DOUBLE_PACK
+#elif defined(__SSE2__)
+struct DoublePack {
+  using V = __m128d;
+  static constexpr unsigned int width = 2;
+  static V load(const double* p) { return _mm_loadu_pd(p); }
+  static void store(double* p, V v) { _mm_storeu_pd(p, v); }
+  static V set(double s) { return _mm_set1_pd(s); }
+  static V add(V a, V b) { return _mm_add_pd(a, b); }
+  static V sub(V a, V b) { return _mm_sub_pd(a, b); }
+  static V mul(V a, V b) { return _mm_mul_pd(a, b); }
+  static V div(V a, V b) { return _mm_div_pd(a, b); }
+  static V min(V a, V b) { return _mm_min_pd(a, b); }
+  static V max(V a, V b) { return _mm_max_pd(a, b); }
+};
+struct FloatPack {
+  using V = __m128;
+  static constexpr unsigned int width = 4;
+  static V load(const float* p) { return _mm_loadu_ps(p); }
+  static void store(float* p, V v) { _mm_storeu_ps(p, v); }
+  static V set(float s) { return _mm_set1_ps(s); }
+  static V add(V a, V b) { return _mm_add_ps(a, b); }
+  static V sub(V a, V b) { return _mm_sub_ps(a, b); }
+  static V mul(V a, V b) { return _mm_mul_ps(a, b); }
+  static V div(V a, V b) { return _mm_div_ps(a, b); }
+  static V min(V a, V b) { return _mm_min_ps(a, b); }
+  static V max(V a, V b) { return _mm_max_ps(a, b); }
+};
+#define EEROS_MATH_DOUBLE_PACK
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+struct DoublePack {
+  using V = float64x2_t;
+  static constexpr unsigned int width = 2;
+  static V load(const double* p) { return vld1q_f64(p); }
+  static void store(double* p, V v) { vst1q_f64(p, v); }
+  static V set(double s) { return vdupq_n_f64(s); }
+  static V add(V a, V b) { return vaddq_f64(a, b); }
+  static V sub(V a, V b) { return vsubq_f64(a, b); }
+  static V mul(V a, V b) { return vmulq_f64(a, b); }
+  static V div(V a, V b) { return vdivq_f64(a, b); }
+  static V min(V a, V b) { return vbslq_f64(vcltq_f64(a, b), a, b); }
+  static V max(V a, V b) { return vbslq_f64(vcgtq_f64(a, b), a, b); }
+};
+struct FloatPack {
+  using V = float32x4_t;
+  static constexpr unsigned int width = 4;
+  static V load(const float* p) { return vld1q_f32(p); }
+  static void store(float* p, V v) { vst1q_f32(p, v); }
+  static V set(float s) { return vdupq_n_f32(s); }
+  static V add(V a, V b) { return vaddq_f32(a, b); }
+  static V sub(V a, V b) { return vsubq_f32(a, b); }
+  static V mul(V a, V b) { return vmulq_f32(a, b); }
+  static V div(V a, V b) { return vdivq_f32(a, b); }
+  static V min(V a, V b) { return vbslq_f32(vcltq_f32(a, b), a, b); }
+  static V max(V a, V b) { return vbslq_f32(vcgtq_f32(a, b), a, b); }
+};
+#define EEROS_MATH_DOUBLE_PACK
+#endif
+
+/**
+ * Vector pack of a value type, FloatPack holds twice as many elements as
+ * DoublePack. The type is void if the target has no vector unit for T.
+ */
+template < typename T >
+struct PackOf { using type = void; };
+
+#ifdef EEROS_MATH_DOUBLE_PACK
+template < >
+struct PackOf<double> { using type = DoublePack; };
+
+template < >
+struct PackOf<float> { using type = FloatPack; };
+#endif
+
+template < typename T >
+constexpr bool hasPack = !std::is_void_v<typename PackOf<T>::type>;
+
+struct Add {
+  template < typename T > static T apply(T a, T b) { return a + b; }
+  template < typename P > static typename P::V pack(typename P::V a, typename P::V b) { return P::add(a, b); }
+};
+
+struct Sub {
+  template < typename T > static T apply(T a, T b) { return a - b; }
+  template < typename P > static typename P::V pack(typename P::V a, typename P::V b) { return P::sub(a, b); }
+};
+
+struct Mul {
+  template < typename T > static T apply(T a, T b) { return a * b; }
+  template < typename P > static typename P::V pack(typename P::V a, typename P::V b) { return P::mul(a, b); }
+};
+
+struct Div {
+  template < typename T > static T apply(T a, T b) { return a / b; }
+  template < typename P > static typename P::V pack(typename P::V a, typename P::V b) { return P::div(a, b); }
+};
+
+/**
+ * r[i] = a[i] op b[i]
+ */
+template < typename Op, typename T >
+inline void elementwise(T* r, const T* a, const T* b, unsigned int n) {
+  unsigned int i = 0;
+#ifdef EEROS_MATH_DOUBLE_PACK
+  if constexpr (hasPack<T>) {
+    using P = typename PackOf<T>::type;
+    for (; i + P::width <= n; i += P::width) P::store(r + i, Op::template pack<P>(P::load(a + i), P::load(b + i)));
+  }
+#endif
+  for (; i < n; i++) r[i] = Op::apply(a[i], b[i]);
+}
+
+/**
+ * r[i] = a[i] op s
+ */
+template < typename Op, typename T >
+inline void elementwise(T* r, const T* a, T s, unsigned int n) {
+  unsigned int i = 0;
+#ifdef EEROS_MATH_DOUBLE_PACK
+  if constexpr (hasPack<T>) {
+    using P = typename PackOf<T>::type;
+    auto vs = P::set(s);
+    for (; i + P::width <= n; i += P::width) P::store(r + i, Op::template pack<P>(P::load(a + i), vs));
+  }
+#endif
+  for (; i < n; i++) r[i] = Op::apply(a[i], s);
+}
+
+/**
+ * r[i] = s op a[i]
+ */
+template < typename Op, typename T >
+inline void elementwise(T* r, T s, const T* a, unsigned int n) {
+  unsigned int i = 0;
+#ifdef EEROS_MATH_DOUBLE_PACK
+  if constexpr (hasPack<T>) {
+    using P = typename PackOf<T>::type;
+    auto vs = P::set(s);
+    for (; i + P::width <= n; i += P::width) P::store(r + i, Op::template pack<P>(vs, P::load(a + i)));
+  }
+#endif
+  for (; i < n; i++) r[i] = Op::apply(s, a[i]);
+}
+
+/**
+ * r[i] += a[i] * s
+ */
+template < typename T >
+inline void axpy(T* r, const T* a, T s, unsigned int n) {
+  unsigned int i = 0;
+#ifdef EEROS_MATH_DOUBLE_PACK
+  if constexpr (hasPack<T>) {
+    using P = typename PackOf<T>::type;
+    auto vs = P::set(s);
+    for (; i + P::width <= n; i += P::width) P::store(r + i, P::add(P::load(r + i), P::mul(P::load(a + i), vs)));
+  }
+#endif
+  for (; i < n; i++) r[i] += a[i] * s;
+}
+
+/**
+ * r[i] += a[i] * b[i]
+ */
+template < typename T >
+inline void multiplyAdd(T* r, const T* a, const T* b, unsigned int n) {
+  unsigned int i = 0;
+#ifdef EEROS_MATH_DOUBLE_PACK
+  if constexpr (hasPack<T>) {
+    using P = typename PackOf<T>::type;
+    for (; i + P::width <= n; i += P::width) P::store(r + i, P::add(P::load(r + i), P::mul(P::load(a + i), P::load(b + i))));
+  }
+#endif
+  for (; i < n; i++) r[i] += a[i] * b[i];
+}
+
+/**
+ * r[i] = a[i] limited to lo[i] ... hi[i], the lower limit wins if lo[i] > hi[i]
+ * and NaN values of a pass unchanged. Without branches, the packs use
+ * min(a, b) = a < b ? a : b and max(a, b) = a > b ? a : b.
+ */
+template < typename T >
+inline void clamp(T* r, const T* a, const T* lo, const T* hi, unsigned int n) {
+  unsigned int i = 0;
+#ifdef EEROS_MATH_DOUBLE_PACK
+  if constexpr (hasPack<T>) {
+    using P = typename PackOf<T>::type;
+    for (; i + P::width <= n; i += P::width) P::store(r + i, P::max(P::load(lo + i), P::min(P::load(hi + i), P::load(a + i))));
+  }
+#endif
+  for (; i < n; i++) {
+    T x = hi[i] < a[i] ? hi[i] : a[i];
+    r[i] = lo[i] > x ? lo[i] : x;
+  }
+}
+
+/**
+ * r[i] = a[i] limited to p[i] + dt * f ... p[i] + dt * g, where the rates f and g
+ * are either arrays or one scalar for all elements (see clamp).
+ */
+template < typename T, typename R >
+inline void limitRate(T* r, const T* a, const T* p, R f, R g, T dt, unsigned int n) {
+  unsigned int i = 0;
+#ifdef EEROS_MATH_DOUBLE_PACK
+  if constexpr (hasPack<T>) {
+    using P = typename PackOf<T>::type;
+    auto rate = [](auto x, unsigned int i) {
+      if constexpr (std::is_pointer_v<decltype(x)>) return P::load(x + i);
+      else return P::set(x);
+    };
+    auto vdt = P::set(dt);
+    for (; i + P::width <= n; i += P::width) {
+      auto vp = P::load(p + i);
+      auto lo = P::add(vp, P::mul(vdt, rate(f, i)));
+      auto hi = P::add(vp, P::mul(vdt, rate(g, i)));
+      P::store(r + i, P::max(lo, P::min(hi, P::load(a + i))));
+    }
+  }
+#endif
+  auto rate = [](auto x, unsigned int i) -> T {
+    if constexpr (std::is_pointer_v<decltype(x)>) return x[i];
+    else return x;
+  };
+  for (; i < n; i++) {
+    T lo = p[i] + dt * rate(f, i);
+    T hi = p[i] + dt * rate(g, i);
+    T x = hi < a[i] ? hi : a[i];
+    r[i] = lo > x ? lo : x;
+  }
+}
+
+/**
+ * r[i] = p[i] + a[i] * s
+ *
+ * @return true if lo[i] < r[i] < hi[i] for all elements
+ */
+template < typename T >
+inline bool integrate(T* r, const T* p, const T* a, T s, const T* lo, const T* hi, unsigned int n) {
+  unsigned int i = 0;
+#ifdef EEROS_MATH_DOUBLE_PACK
+  if constexpr (hasPack<T>) {
+    using P = typename PackOf<T>::type;
+    auto vs = P::set(s);
+    for (; i + P::width <= n; i += P::width) P::store(r + i, P::add(P::load(p + i), P::mul(P::load(a + i), vs)));
+  }
+#endif
+  for (; i < n; i++) r[i] = p[i] + a[i] * s;
+  bool inside = true;
+  for (i = 0; i < n; i++) inside &= (r[i] < hi[i]) & (r[i] > lo[i]);
+  return inside;
+}
+
+/**
+ * Index of the first a[i] which is not within lo[i] < a[i] < hi[i], NaN is never
+ * within. The check of all elements is an OR reduction without branches, only
+ * if an element is outside, the index is searched.
+ *
+ * @return index of the first element outside, n if all are within
+ */
+template < typename T >
+inline unsigned int firstOutside(const T* a, const T* lo, const T* hi, unsigned int n) {
+  bool outside = false;
+  for (unsigned int i = 0; i < n; i++) outside |= !((a[i] > lo[i]) & (a[i] < hi[i]));
+  if (!outside) return n;
+  for (unsigned int i = 0; i < n; i++) {
+    if (!(a[i] > lo[i] && a[i] < hi[i])) return i;
+  }
+  return n;
+}
+
+/**
+ * Index of the first a[i] with a[i] < lo[i] or a[i] > hi[i], NaN is never beyond.
+ * Branch free like firstOutside().
+ *
+ * @return index of the first element beyond, n if none is
+ */
+template < typename T >
+inline unsigned int firstBeyond(const T* a, const T* lo, const T* hi, unsigned int n) {
+  bool beyond = false;
+  for (unsigned int i = 0; i < n; i++) beyond |= (a[i] < lo[i]) | (a[i] > hi[i]);
+  if (!beyond) return n;
+  for (unsigned int i = 0; i < n; i++) {
+    if (a[i] < lo[i] || a[i] > hi[i]) return i;
+  }
+  return n;
+}
+
+/**
+ * Index of the first a[i] within lo[i] < a[i] < hi[i], NaN is never within.
+ * Branch free like firstOutside().
+ *
+ * @return index of the first element within, n if none is
+ */
+template < typename T >
+inline unsigned int firstWithin(const T* a, const T* lo, const T* hi, unsigned int n) {
+  bool within = false;
+  for (unsigned int i = 0; i < n; i++) within |= (a[i] > lo[i]) & (a[i] < hi[i]);
+  if (!within) return n;
+  for (unsigned int i = 0; i < n; i++) {
+    if (a[i] > lo[i] && a[i] < hi[i]) return i;
+  }
+  return n;
+}
+
+/**
+ * r[i] = a[i] + (b[i] - a[i]) * s, linear interpolation between a and b
+ */
+template < typename T >
+inline void lerp(T* r, const T* a, const T* b, T s, unsigned int n) {
+  unsigned int i = 0;
+#ifdef EEROS_MATH_DOUBLE_PACK
+  if constexpr (hasPack<T>) {
+    using P = typename PackOf<T>::type;
+    auto vs = P::set(s);
+    for (; i + P::width <= n; i += P::width) {
+      auto va = P::load(a + i);
+      P::store(r + i, P::add(va, P::mul(P::sub(P::load(b + i), va), vs)));
+    }
+  }
+#endif
+  for (; i < n; i++) r[i] = a[i] + (b[i] - a[i]) * s;
+}
+
+/**
+ * Evaluates the n cubic polynomes p(t) = c0[i] + c1[i] * t + c2[i] * t^2 + c3[i] * t^3
+ * and their derivatives with Horner's scheme. The coefficients c0 ... c3 are stored
+ * one after the other in c, each with n elements. The values of p and of its first,
+ * second and third derivative are stored the same way in r.
+ */
+template < typename T >
+inline void cubic(T* r, const T* c, T t, unsigned int n) {
+  const T* c0 = c;
+  const T* c1 = c + n;
+  const T* c2 = c + 2 * n;
+  const T* c3 = c + 3 * n;
+  unsigned int i = 0;
+#ifdef EEROS_MATH_DOUBLE_PACK
+  if constexpr (hasPack<T>) {
+    using P = typename PackOf<T>::type;
+    auto vt = P::set(t);
+    auto two = P::set(2.0), three = P::set(3.0), six = P::set(6.0);
+    for (; i + P::width <= n; i += P::width) {
+      auto a0 = P::load(c0 + i), a1 = P::load(c1 + i), a2 = P::load(c2 + i), a3 = P::load(c3 + i);
+      P::store(r + i, P::add(P::mul(P::add(P::mul(P::add(P::mul(a3, vt), a2), vt), a1), vt), a0));
+      P::store(r + n + i, P::add(P::mul(P::add(P::mul(P::mul(three, a3), vt), P::mul(two, a2)), vt), a1));
+      P::store(r + 2 * n + i, P::add(P::mul(P::mul(six, a3), vt), P::mul(two, a2)));
+      P::store(r + 3 * n + i, P::mul(six, a3));
+    }
+  }
+#endif
+  for (; i < n; i++) {
+    r[i] = ((c3[i] * t + c2[i]) * t + c1[i]) * t + c0[i];
+    r[n + i] = (3 * c3[i] * t + 2 * c2[i]) * t + c1[i];
+    r[2 * n + i] = 6 * c3[i] * t + 2 * c2[i];
+    r[3 * n + i] = 6 * c3[i];
+  }
+}
+
+/**
+ * Returns the sum of a[i] * b[i]
+ */
+template < typename T >
+inline T dot(const T* a, const T* b, unsigned int n) {
+  unsigned int i = 0;
+  T sum = 0;
+#ifdef EEROS_MATH_DOUBLE_PACK
+  if constexpr (hasPack<T>) {
+    using P = typename PackOf<T>::type;
+    if (n >= 2 * P::width) {
+      // two accumulators to hide the latency of the additions
+      auto acc0 = P::set(0), acc1 = P::set(0);
+      for (; i + 2 * P::width <= n; i += 2 * P::width) {
+        acc0 = P::add(acc0, P::mul(P::load(a + i), P::load(b + i)));
+        acc1 = P::add(acc1, P::mul(P::load(a + i + P::width), P::load(b + i + P::width)));
+      }
+      T lanes[P::width];
+      P::store(lanes, P::add(acc0, acc1));
+      for (unsigned int j = 0; j < P::width; j++) sum += lanes[j];
+    }
+  }
+#endif
+  for (; i < n; i++) sum += a[i] * b[i];
+  return sum;
+}
+
+/**
+ * r[j] = sum of s[i] * a(i)[j] over the k vectors a(i) of length n. Each part
+ * of r is accumulated in a register over all vectors before it is stored.
+ *
+ * @param a - function returning a pointer to the vector with a given index
+ */
+template < typename T, typename A, typename S >
+inline void weightedSum(T* r, A a, const S* s, unsigned int k, unsigned int n) {
+  unsigned int j = 0;
+#ifdef EEROS_MATH_DOUBLE_PACK
+  if constexpr (hasPack<T>) {
+    using P = typename PackOf<T>::type;
+    constexpr unsigned int W = P::width;
+    // four independent accumulators: two parts of r, even and odd vectors
+    for (; j + 2 * W <= n; j += 2 * W) {
+      auto acc0 = P::set(0), acc1 = P::set(0), acc2 = P::set(0), acc3 = P::set(0);
+      unsigned int i = 0;
+      for (; i + 1 < k; i += 2) {
+        auto s0 = P::set(static_cast<T>(s[i])), s1 = P::set(static_cast<T>(s[i + 1]));
+        const T* a0 = a(i) + j;
+        const T* a1 = a(i + 1) + j;
+        acc0 = P::add(acc0, P::mul(P::load(a0), s0));
+        acc1 = P::add(acc1, P::mul(P::load(a1), s1));
+        acc2 = P::add(acc2, P::mul(P::load(a0 + W), s0));
+        acc3 = P::add(acc3, P::mul(P::load(a1 + W), s1));
+      }
+      if (i < k) {
+        auto s0 = P::set(static_cast<T>(s[i]));
+        acc0 = P::add(acc0, P::mul(P::load(a(i) + j), s0));
+        acc2 = P::add(acc2, P::mul(P::load(a(i) + j + W), s0));
+      }
+      P::store(r + j, P::add(acc0, acc1));
+      P::store(r + j + W, P::add(acc2, acc3));
+    }
+    for (; j + W <= n; j += W) {
+      auto acc0 = P::set(0), acc1 = P::set(0);
+      unsigned int i = 0;
+      for (; i + 1 < k; i += 2) {
+        acc0 = P::add(acc0, P::mul(P::load(a(i) + j), P::set(static_cast<T>(s[i]))));
+        acc1 = P::add(acc1, P::mul(P::load(a(i + 1) + j), P::set(static_cast<T>(s[i + 1]))));
+      }
+      if (i < k) acc0 = P::add(acc0, P::mul(P::load(a(i) + j), P::set(static_cast<T>(s[i]))));
+      P::store(r + j, P::add(acc0, acc1));
+    }
+  }
+#endif
+  for (; j < n; j++) {
+    T acc = 0;
+    for (unsigned int i = 0; i < k; i++) acc += static_cast<T>(s[i]) * a(i)[j];
+    r[j] = acc;
+  }
+}
+
+/**
+ * Matrix product r = a * b of column major matrices, r is MxK, a is MxN and b is NxK.
+ * Each column of the result is accumulated from the columns of a, so that the
+ * inner loop runs over contiguous memory. r must not overlap a or b.
+ */
+template < unsigned int M, unsigned int N, unsigned int K, typename T >
+inline void multiply(T* r, const T* a, const T* b) {
+  for (unsigned int k = 0; k < K; k++) {
+    T* rk = r + M * k;
+    for (unsigned int m = 0; m < M; m++) rk[m] = 0;
+    for (unsigned int n = 0; n < N; n++) axpy(rk, a + M * n, b[N * k + n], M);
+  }
+}
+
+/**
+ * Product r = diag(d) * b, r and b are column major NxK matrices.
+ */
+template < unsigned int N, unsigned int K, typename T >
+inline void diagonalMultiply(T* r, const T* d, const T* b) {
+  for (unsigned int k = 0; k < K; k++) elementwise<Mul>(r + N * k, d, b + N * k, N);
+}
+
+/**
+ * Product r = a * b of a block diagonal matrix a with L column major BxB blocks
+ * stored one after the other, r and b are column major (L*B)xK matrices. r must
+ * not overlap a or b.
+ */
+template < unsigned int B, unsigned int L, unsigned int K, typename T >
+inline void blockDiagonalMultiply(T* r, const T* a, const T* b) {
+  constexpr unsigned int N = B * L;
+  for (unsigned int k = 0; k < K; k++) {
+    for (unsigned int l = 0; l < L; l++) multiply<B, B, 1>(r + N * k + B * l, a + B * B * l, b + N * k + B * l);
+  }
+}
+
+/**
+ * Product r = a * b of a MxN matrix a in compressed sparse row form and the
+ * column major NxK matrix b, r is MxK. The non-zeros of row m are
+ * values[rowStart[m]] ... values[rowStart[m + 1] - 1] in the columns col[...].
+ * r must not overlap b.
+ */
+template < unsigned int M, unsigned int N, unsigned int K, typename T, typename I >
+inline void sparseMultiply(T* r, const T* values, const I* col, const I* rowStart, const T* b) {
+  for (unsigned int k = 0; k < K; k++) {
+    const T* bk = b + N * k;
+    for (unsigned int m = 0; m < M; m++) {
+      T acc = 0;
+      for (I j = rowStart[m]; j < rowStart[m + 1]; j++) acc += values[j] * bk[col[j]];
+      r[M * k + m] = acc;
+    }
+  }
+}
+
+/**
+ * LU decomposition with partial pivoting of the column major NxN matrix a, in place.
+ * Afterwards the unit lower triangular factor L is stored below the diagonal and
+ * the upper triangular factor U on and above. Row k was swapped with row pivot[k]
+ * in step k.
+ *
+ * @return sign of the row permutation, 0 if the matrix is singular
+ */
+template < unsigned int N, typename T >
+inline int lu(T* a, unsigned int* pivot) {
+  int sign = 1;
+  for (unsigned int k = 0; k < N; k++) {
+    T* ak = a + N * k;
+    unsigned int p = k;
+    for (unsigned int i = k + 1; i < N; i++) {
+      if (std::abs(ak[i]) > std::abs(ak[p])) p = i;
+    }
+    pivot[k] = p;
+    if (ak[p] == T(0)) return 0;
+    if (p != k) {
+      for (unsigned int j = 0; j < N; j++) std::swap(a[N * j + k], a[N * j + p]);
+      sign = -sign;
+    }
+    T d = ak[k];
+    for (unsigned int i = k + 1; i < N; i++) ak[i] /= d;
+    for (unsigned int j = k + 1; j < N; j++) axpy(a + N * j + k + 1, ak + k + 1, -a[N * j + k], N - k - 1);
+  }
+  return sign;
+}
+
+/**
+ * Solves a * x = b for the K columns of b, in place, with the factors of lu().
+ */
+template < unsigned int N, unsigned int K, typename T >
+inline void luSolve(const T* a, const unsigned int* pivot, T* b) {
+  for (unsigned int k = 0; k < K; k++) {
+    T* x = b + N * k;
+    for (unsigned int i = 0; i < N; i++) {
+      if (pivot[i] != i) std::swap(x[i], x[pivot[i]]);
+    }
+    for (unsigned int j = 0; j < N; j++) axpy(x + j + 1, a + N * j + j + 1, -x[j], N - j - 1);
+    for (unsigned int j = N; j-- > 0;) {
+      x[j] /= a[N * j + j];
+      axpy(x, a + N * j, -x[j], j);
+    }
+  }
+}
+
+/**
+ * Cholesky decomposition a = L * L' of the column major symmetric positive definite
+ * NxN matrix a, in place. Only the lower triangle of a is read, L is stored on and
+ * below the diagonal, the upper triangle is left unchanged.
+ *
+ * @return false if the matrix is not positive definite
+ */
+template < unsigned int N, typename T >
+inline bool cholesky(T* a) {
+  for (unsigned int k = 0; k < N; k++) {
+    T* ak = a + N * k;
+    if (!(ak[k] > T(0))) return false;
+    T d = std::sqrt(ak[k]);
+    ak[k] = d;
+    for (unsigned int i = k + 1; i < N; i++) ak[i] /= d;
+    for (unsigned int j = k + 1; j < N; j++) axpy(a + N * j + j, ak + j, -ak[j], N - j);
+  }
+  return true;
+}
+
+/**
+ * Solves a * x = b for the K columns of b, in place, with the factor of cholesky().
+ */
+template < unsigned int N, unsigned int K, typename T >
+inline void choleskySolve(const T* l, T* b) {
+  for (unsigned int k = 0; k < K; k++) {
+    T* x = b + N * k;
+    for (unsigned int j = 0; j < N; j++) {
+      x[j] /= l[N * j + j];
+      axpy(x + j + 1, l + N * j + j + 1, -x[j], N - j - 1);
+    }
+    for (unsigned int j = N; j-- > 0;) {
+      T sum = x[j];
+      for (unsigned int i = j + 1; i < N; i++) sum -= l[N * j + i] * x[i];
+      x[j] = sum / l[N * j + j];
+    }
+  }
+}
+
+/**
+ * Householder QR decomposition of the column major MxN matrix a (M >= N), in place.
+ * Afterwards R is stored on and above the diagonal, and the Householder vectors
+ * v_k = [1, a(k+1..M-1, k)] of Q = H_0 * ... * H_(N-1), H_k = I - tau[k] * v_k * v_k',
+ * below the diagonal.
+ */
+template < unsigned int M, unsigned int N, typename T >
+inline void qr(T* a, T* tau) {
+  static_assert(M >= N, "QR decomposition needs at least as many rows as colums");
+  for (unsigned int k = 0; k < N; k++) {
+    T* ak = a + M * k;
+    T norm = 0;
+    for (unsigned int i = k; i < M; i++) norm += ak[i] * ak[i];
+    norm = std::sqrt(norm);
+    tau[k] = 0;
+    if (norm == T(0)) continue;
+    T beta = (ak[k] > T(0)) ? -norm : norm;
+    T scale = T(1) / (ak[k] - beta);
+    for (unsigned int i = k + 1; i < M; i++) ak[i] *= scale;
+    tau[k] = (beta - ak[k]) / beta;
+    ak[k] = beta;
+    for (unsigned int j = k + 1; j < N; j++) {
+      T* aj = a + M * j;
+      T w = aj[k];
+      for (unsigned int i = k + 1; i < M; i++) w += ak[i] * aj[i];
+      w *= tau[k];
+      aj[k] -= w;
+      axpy(aj + k + 1, ak + k + 1, -w, M - k - 1);
+    }
+  }
+}
+
+/**
+ * Computes b = Q' * b for the K columns of b with the factors of qr().
+ */
+template < unsigned int M, unsigned int N, unsigned int K, typename T >
+inline void qrApplyTransposedQ(const T* a, const T* tau, T* b) {
+  for (unsigned int c = 0; c < K; c++) {
+    T* x = b + M * c;
+    for (unsigned int k = 0; k < N; k++) {
+      const T* ak = a + M * k;
+      T w = x[k];
+      for (unsigned int i = k + 1; i < M; i++) w += ak[i] * x[i];
+      w *= tau[k];
+      x[k] -= w;
+      axpy(x + k + 1, ak + k + 1, -w, M - k - 1);
+    }
+  }
+}
+
+/**
+ * Solves r * x = b for the K columns of b, in place, where r is the upper triangle
+ * of the column major matrix r with leading dimension L. b has leading dimension LB,
+ * only its first N rows are used.
+ */
+template < unsigned int N, unsigned int K, unsigned int L, unsigned int LB, typename T >
+inline void backSubstitute(const T* r, T* b) {
+  for (unsigned int k = 0; k < K; k++) {
+    T* x = b + LB * k;
+    for (unsigned int j = N; j-- > 0;) {
+      x[j] /= r[L * j + j];
+      axpy(x, r + L * j, -x[j], j);
+    }
+  }
+}
+
+}
+}
+}
+
+#endif // ORG_EEROS_MATH_MATRIXKERNELS_HPP_
@@ -2,6 +2,9 @@
 
 #include <eeros/logger/Logger.hpp>
 #include <eeros/math/Matrix.hpp>
+#include <eeros/math/MatrixKernels.hpp>
+#include <cmath>
+#include <cstddef>
 #include <sstream>
 #include <stdexcept>
 
@@ -10,40 +13,47 @@ namespace math {
 
 enum QUAT { w, x, y, z };
 
-class Quaternion {
+/**
+ * Quaternion with values of type T, float or double. Use the aliases
+ * Quaternion and QuaternionF.
+ *
+ * @tparam T - value type
+ */
+template <typename T>
+class QuaternionT {
  public:
-  Quaternion() {
+  QuaternionT() {
     x=0.0; y=0.0; z=0.0; w=1.0;
   }
 
-  Quaternion(double _w, double _x, double _y, double _z)
+  QuaternionT(T _w, T _x, T _y, T _z)
       : w(_w), x(_x),y(_y),z(_z) { }
 
-  Quaternion(Matrix<4, 1, double> m)
+  QuaternionT(Matrix<4, 1, T> m)
       : w(m(0)), x(m(1)), y(m(2)), z(m(3)) { }
 
-  Quaternion(double roll, double pitch, double yaw) {
+  QuaternionT(T roll, T pitch, T yaw) {
     setFromRPY(roll, pitch, yaw);
   }
 
-  Quaternion(eeros::math::Matrix<3, 1, double> angles) {
+  QuaternionT(eeros::math::Matrix<3, 1, T> angles) {
     setFromRPY(angles);
   }
 
-  Matrix<4, 1, double> get() {
-    return Matrix<4,1,double>(w, x, y, z);
+  Matrix<4, 1, T> get() const {
+    return Matrix<4,1,T>(w, x, y, z);
   }
 
-  void set(double _w, double _x, double _y, double _z) {
+  void set(T _w, T _x, T _y, T _z) {
     x = _x; y = _y; z = _z; w =_w;
   }
 
-  void set(Matrix<4, 1, double> m) {
+  void set(Matrix<4, 1, T> m) {
     w = m(0); x = m(1); y = m(2); z = m(3);
   }
 
-  Quaternion operator+(const Quaternion quat) {
-    Quaternion tmp;
+  QuaternionT operator+(const QuaternionT quat) const {
+    QuaternionT tmp;
     tmp.w = w + quat.w;
     tmp.x = x + quat.x;
     tmp.y = y + quat.y;
@@ -51,13 +61,13 @@ class Quaternion {
     return tmp;
   }
 
-  Quaternion operator+=(const Quaternion quat) {
+  QuaternionT operator+=(const QuaternionT quat) {
     (*this) = (*this) + quat;
     return (*this);
   }
 
-  Quaternion operator-(const Quaternion quat) {
-    Quaternion tmp;
+  QuaternionT operator-(const QuaternionT quat) const {
+    QuaternionT tmp;
     tmp.w = w - quat.w;
     tmp.x = x - quat.x;
     tmp.y = y - quat.y;
@@ -65,18 +75,18 @@ class Quaternion {
     return tmp;
   }
 
-  Quaternion operator-=(const Quaternion quat) {
+  QuaternionT operator-=(const QuaternionT quat) {
     (*this) = (*this) - quat;
     return (*this);
   }
 
-  Quaternion operator*(const double f) {
-    Quaternion tmp( (w * f), (x * f), (y * f), (z * f));
+  QuaternionT operator*(const T f) const {
+    QuaternionT tmp( (w * f), (x * f), (y * f), (z * f));
     return tmp;
   }
 
-  Quaternion operator*(const Quaternion quat) {
-    Quaternion tmp;
+  QuaternionT operator*(const QuaternionT quat) const {
+    QuaternionT tmp;
     tmp.w = (w * quat.w) - (x * quat.x) - (y * quat.y) - (z * quat.z);
     tmp.x = (w * quat.x) + (x * quat.w) + (y * quat.z) - (z * quat.y);
     tmp.y = (w * quat.y) + (y * quat.w) + (z * quat.x) - (x * quat.z);
@@ -84,75 +94,199 @@ class Quaternion {
     return tmp;
   }
 
-  Quaternion operator*=(const double f) {
+  QuaternionT operator*=(const T f) {
     (*this) = (*this) * f;
     return (*this);
   }
 
-  Quaternion operator*=(const Quaternion quat) {
+  QuaternionT operator*=(const QuaternionT quat) {
     (*this) = (*this) * quat;
     return (*this);
   }
 
-  Quaternion operator/(const double f) {
+  QuaternionT operator/(const T f) const {
     if (f != 0.0) {
-      Quaternion tmp((w / f), (x / f), (y / f), (z / f));
+      QuaternionT tmp((w / f), (x / f), (y / f), (z / f));
       return tmp;
     } else {
-      throw Fault("Quaternion: division by zero");
+      throw Fault("QuaternionT: division by zero");
     }
   }
 
-  Quaternion operator/=(const double f) {
+  QuaternionT operator/=(const T f) {
     (*this) = (*this) / f;
     return (*this);
   }
 
   void normalize() {
-    double mag = sqrt(x*x + y*y + z*z + w*w);
+    T mag = sqrt(x*x + y*y + z*z + w*w);
     x = x / mag;
     y = y / mag;
     z = z / mag;
     w = w / mag;
   }
 
-  Quaternion conj() {
-    Quaternion tmp;
+  QuaternionT conj() const {
+    QuaternionT tmp;
     tmp.w = w; tmp.x = -x; tmp.y = -y; tmp.z = -z;
     return tmp;
   }
 
-  Quaternion inv() {
+  QuaternionT inv() const {
      return conj() / std::pow(len(),2);
   }
 
-  double len() {
+  T len() const {
     return sqrt(x*x + y*y + z*z + w*w);
   }
 
-  void setFromRot(Matrix<3, 3, double> rot) {
-    double trace = rot(0,0) + rot(1,1) + rot(2,2);
+  T dot(const QuaternionT& q) const {
+    return w * q.w + x * q.x + y * q.y + z * q.z;
+  }
+
+  /**
+   * Rotates a vector by this unit quaternion, without forming the rotation matrix.
+   *
+   * @param v - vector
+   * @return rotated vector
+   */
+  Matrix<3, 1, T> rotate(const Matrix<3, 1, T>& v) const {
+    // t = 2 (q x v), v' = v + w t + q x t
+    T tx = 2.0 * (y * v(2) - z * v(1));
+    T ty = 2.0 * (z * v(0) - x * v(2));
+    T tz = 2.0 * (x * v(1) - y * v(0));
+    return Matrix<3, 1, T>(v(0) + w * tx + (y * tz - z * ty),
+                                v(1) + w * ty + (z * tx - x * tz),
+                                v(2) + w * tz + (x * ty - y * tx));
+  }
+
+  /**
+   * Rotates n vectors given as separate arrays of their coordinates by this unit
+   * quaternion. The rotation matrix is calculated once and the vectors are processed
+   * in vector registers, see \ref kernel::PackOf. The output arrays may be 
+   * the input arrays, but must not overlap them otherwise.
+   *
+   * @param vx - x coordinates
+   * @param vy - y coordinates
+   * @param vz - z coordinates
+   * @param xOut - rotated x coordinates
+   * @param yOut - rotated y coordinates
+   * @param zOut - rotated z coordinates
+   * @param n - number of vectors
+   */
+  void rotate(const T* vx, const T* vy, const T* vz,
+              T* xOut, T* yOut, T* zOut, std::size_t n) const {
+    Matrix<3, 3, T> rot = getRot();
+    const T r[9] = {rot(0, 0), rot(0, 1), rot(0, 2), rot(1, 0), rot(1, 1), rot(1, 2), rot(2, 0), rot(2, 1), rot(2, 2)};
+    std::size_t i = 0;
+#ifdef EEROS_MATH_DOUBLE_PACK
+    if constexpr (kernel::hasPack<T>) {
+      using P = typename kernel::PackOf<T>::type;
+      typename P::V rv[9];
+      for (int k = 0; k < 9; k++) rv[k] = P::set(r[k]);
+      for (; i + P::width <= n; i += P::width) {
+        typename P::V px = P::load(vx + i), py = P::load(vy + i), pz = P::load(vz + i);
+        P::store(xOut + i, P::add(P::add(P::mul(rv[0], px), P::mul(rv[1], py)), P::mul(rv[2], pz)));
+        P::store(yOut + i, P::add(P::add(P::mul(rv[3], px), P::mul(rv[4], py)), P::mul(rv[5], pz)));
+        P::store(zOut + i, P::add(P::add(P::mul(rv[6], px), P::mul(rv[7], py)), P::mul(rv[8], pz)));
+      }
+    }
+#endif
+    for (; i < n; i++) {
+      T px = vx[i], py = vy[i], pz = vz[i];
+      xOut[i] = r[0] * px + r[1] * py + r[2] * pz;
+      yOut[i] = r[3] * px + r[4] * py + r[5] * pz;
+      zOut[i] = r[6] * px + r[7] * py + r[8] * pz;
+    }
+  }
+
+  /**
+   * Interpolates linearly between two unit quaternions along the shorter path
+   * and normalizes the result. Needs no trigonometric functions. The direction 
+   * is exact for t of 0, 0.5 and 1, in between it deviates from \ref slerp, 
+   * see slerp(const QuaternionT&, const QuaternionT&, T, T).
+   *
+   * @param a - start
+   * @param b - end
+   * @param t - interpolation parameter between 0 and 1
+   * @return interpolated unit quaternion
+   */
+  static QuaternionT nlerp(const QuaternionT& a, const QuaternionT& b, T t) {
+    T s = (a.dot(b) < 0.0) ? -t : t;
+    QuaternionT q(a.w + (s * b.w - t * a.w), a.x + (s * b.x - t * a.x),
+                 a.y + (s * b.y - t * a.y), a.z + (s * b.z - t * a.z));
+    q.normalize();
+    return q;
+  }
+
+  /**
+   * Interpolates spherically between two unit quaternions along the shorter path,
+   * with constant angular velocity.
+   *
+   * @param a - start
+   * @param b - end
+   * @param t - interpolation parameter between 0 and 1
+   * @return interpolated unit quaternion
+   */
+  static QuaternionT slerp(const QuaternionT& a, const QuaternionT& b, T t) {
+    T d = a.dot(b);
+    T sign = 1.0;
+    if (d < 0.0) {
+      d = -d;
+      sign = -1.0;
+    }
+    if (d > 1 - parallel) return nlerp(a, b, t);  // nearly parallel, the deviation of nlerp is below the precision of T
+    T omega = std::acos(d);
+    T sinOmega = std::sin(omega);
+    T ka = std::sin((1.0 - t) * omega) / sinOmega;
+    T kb = sign * std::sin(t * omega) / sinOmega;
+    return QuaternionT(ka * a.w + kb * b.w, ka * a.x + kb * b.x, ka * a.y + kb * b.y, ka * a.z + kb * b.z);
+  }
+
+  /**
+   * Interpolates spherically between two unit quaternions with a bounded error.
+   * Uses \ref nlerp, if its worst case deviation from the exact slerp, measured as 
+   * rotation angle, is below maxError, else the exact \ref slerp.
+   * The bound is checked without trigonometric functions: the deviation of nlerp is 
+   * below 0.037 * angle^3, where angle is the angle between a and b on the unit sphere.
+   *
+   * @param a - start
+   * @param b - end
+   * @param t - interpolation parameter between 0 and 1
+   * @param maxError - largest allowed error of the rotation angle in rad
+   * @return interpolated unit quaternion
+   */
+  static QuaternionT slerp(const QuaternionT& a, const QuaternionT& b, T t, T maxError) {
+    // angle^2 <= pi^2/4 * (1 - |dot|) on the shorter path
+    T a2 = 2.4674011 * (1.0 - std::abs(a.dot(b)));
+    T e = 0.037 * a2;
+    if (e * e * a2 <= maxError * maxError) return nlerp(a, b, t);
+    return slerp(a, b, t);
+  }
+
+  void setFromRot(Matrix<3, 3, T> rot) {
+    T trace = rot(0,0) + rot(1,1) + rot(2,2);
     if( trace > 0 ) {
-      double s = 0.5 / std::sqrt(trace + 1.0);
+      T s = 0.5 / std::sqrt(trace + 1.0);
       w = 0.25 / s;
       x = (rot(2,1) - rot(1,2)) * s;
       y = (rot(0,2) - rot(2,0)) * s;
       z = (rot(1,0) - rot(0,1)) * s;
     } else {
       if ( rot(0,0) > rot(1,1) && rot(0,0) > rot(2,2) ) {
-        double s = 2.0 * std::sqrt( 1.0 + rot(0,0) - rot(1,1) - rot(2,2));
+        T s = 2.0 * std::sqrt( 1.0 + rot(0,0) - rot(1,1) - rot(2,2));
         w = (rot(2,1) - rot(1,2)) / s;
         x = 0.25 * s;
         y = (rot(0,1) + rot(1,0)) / s;
         z = (rot(0,2) + rot(2,0)) / s;
       } else if (rot(1,1) > rot(2,2)) {
-        float s = 2.0* std::sqrt(1.0 + rot(1,1) - rot(0,0) - rot(2,2));
+        T s = 2.0* std::sqrt(1.0 + rot(1,1) - rot(0,0) - rot(2,2));
         w = (rot(0,2) - rot(2,0)) / s;
         x = (rot(0,1) + rot(1,0)) / s;
         y = 0.25 * s;
         z = (rot(1,2) + rot(2,1)) / s;
       } else {
-        float s = 2.0 * std::sqrt( 1.0 + rot(2,2) - rot(0,0) -rot(1,1));
+        T s = 2.0 * std::sqrt( 1.0 + rot(2,2) - rot(0,0) -rot(1,1));
         w = (rot(1,0) - rot(0,1)) / s;
         x = (rot(0,2) + rot(2,0)) / s;
         y = (rot(1,2) + rot(2,1)) / s;
@@ -161,12 +295,12 @@ class Quaternion {
     }
   }
 
-  void setFromRPY(Matrix<3, 1, double> rpy) {
+  void setFromRPY(Matrix<3, 1, T> rpy) {
     setFromRPY(rpy(0), rpy(1), rpy(2));
   }
 
-  void setFromRPY(double roll, double pitch, double yaw) {
-    Matrix<3,3,double> m, mx, my, mz;
+  void setFromRPY(T roll, T pitch, T yaw) {
+    Matrix<3,3,T> m, mx, my, mz;
     m.eye();
     mx.rotx(roll);
     my.roty(pitch);
@@ -175,13 +309,13 @@ class Quaternion {
     setFromRot(m);
   }
 
-  Matrix<3, 1, double> getRPY() {
-    Matrix<3,1,double> angle;
-    Matrix<3,3,double> mat = getRot();
+  Matrix<3, 1, T> getRPY() {
+    Matrix<3,1,T> angle;
+    Matrix<3,3,T> mat = getRot();
     // beta
     angle(1)= -std::asin(mat(2,0) );
     if(mat(2,0) == 1 || mat(2,0) == -1) {       // gimbal lock
-      eeros::logger::Logger::getLogger().warn() << "Quaternion: angle beta is pi/-pi an RPY cannot be calculated! ";
+      eeros::logger::Logger::getLogger().warn() << "QuaternionT: angle beta is pi/-pi an RPY cannot be calculated! ";
     } else {
       // gamma: acos([0,0] /cos(beta)); check if [1,0] < 0.0 -> gamma is negativ
       angle(2)= std::acos(mat(0,0)/std::cos(angle(1)));
@@ -195,8 +329,8 @@ class Quaternion {
     return angle;
   }
 
-  Matrix<3, 3, double> getRot() {
-    Matrix<3,3,double> rot;
+  Matrix<3, 3, T> getRot() const {
+    Matrix<3,3,T> rot;
     rot(0,0) = 1- 2*(y*y) - 2*(z*z); rot(0,1) = 2*x*y - 2* z*w;      rot(0,2) = 2*x*z + 2*y*w;
     rot(1,0) = 2*x*y + 2*z*w;        rot(1,1) = 1- 2*(x*x)- 2*(z*z); rot(1,2) = 2*y*z - 2*x*w;
     rot(2,0) = 2*x*z - 2*y*w;        rot(2,1) = 2*y*z +2*x*w;        rot(2,2) = 1-2*(x*x) - 2*(y*y);
@@ -204,15 +338,32 @@ class Quaternion {
   }
 
  public:
-  double w; // real
-  double x; // complex
-  double y;
-  double z;
+  T w; // real
+  T x; // complex
+  T y;
+  T z;
+
+ private:
+  // largest 1 - dot of two quaternions which slerp treats as parallel
+  static constexpr T parallel = sizeof(T) < sizeof(double) ? T(1e-5) : T(1e-10);
 };
 
+/**
+ * Quaternion of doubles.
+ */
+using Quaternion = QuaternionT<double>;
+
+/**
+ * Quaternion of floats.
+ */
+using QuaternionF = QuaternionT<float>;
+
+
+
 /********** Print functions **********/
 
-std::ostream& operator<<(std::ostream& os, const Quaternion& q) {
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const QuaternionT<T>& q) {
   os << "real w: " << q.w << ", vec: [ " << q.x << " , " << q.y << " , " << q.z << " ]' ";
   return os;
 }
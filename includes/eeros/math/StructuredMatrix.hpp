@@ -0,0 +1,470 @@
+#ifndef ORG_EEROS_MATH_STRUCTUREDMATRIX_HPP_
+#define ORG_EEROS_MATH_STRUCTUREDMATRIX_HPP_
+
+#include <eeros/core/Fault.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <eeros/math/MatrixKernels.hpp>
+#include <algorithm>
+#include <initializer_list>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace eeros {
+namespace math {
+
+/*
+ * Structured matrices store only the elements of their structure, e.g. the
+ * diagonal, and multiply a Matrix with a cost proportional to the number of
+ * stored elements. They can be used as gain of a control::Gain block.
+ *
+ * The relational and arithmetic operators work on the stored elements only,
+ * the structural zeros are not part of the matrix. As with Matrix, a relation
+ * holds if it holds for every element.
+ */
+
+/**
+ * Diagonal NxN matrix, which stores its N diagonal elements.
+ *
+ * @tparam N - number of rows and columns
+ * @tparam T - value type (double - default type)
+ *
+ * @since v1.4.4
+ */
+template < unsigned int N, typename T = double >
+class DiagonalMatrix {
+ public:
+  using value_type = T;
+
+  /**
+   * Constructs a zero matrix.
+   */
+  DiagonalMatrix() { fill(0); }
+
+  /**
+   * Constructs a matrix with all diagonal elements set to v.
+   *
+   * @param v - value of the diagonal elements
+   */
+  DiagonalMatrix(const T v) { fill(v); }
+
+  /**
+   * Constructs a matrix from its diagonal.
+   *
+   * @param diagonal - diagonal elements
+   */
+  DiagonalMatrix(const Matrix<N, 1, T>& diagonal) {
+    for (unsigned int i = 0; i < N; i++) value[i] = diagonal(i);
+  }
+
+  /**
+   * @param i - index of the diagonal element
+   * @return diagonal element i
+   */
+  T& operator()(unsigned int i) { return value[i]; }
+  const T& operator()(unsigned int i) const { return value[i]; }
+
+  /**
+   * @return element in row m and column n, 0 outside the diagonal
+   */
+  T operator()(unsigned int m, unsigned int n) const { return m == n ? value[m] : T(0); }
+
+  /**
+   * Sets all diagonal elements.
+   *
+   * @param v - value of the diagonal elements
+   */
+  void fill(T v) { std::fill(value, value + N, v); }
+
+  DiagonalMatrix& operator=(T v) {
+    fill(v);
+    return *this;
+  }
+
+  DiagonalMatrix& operator+=(const DiagonalMatrix& right) {
+    kernel::elementwise<kernel::Add>(value, value, right.value, N);
+    return *this;
+  }
+
+  DiagonalMatrix& operator-=(const DiagonalMatrix& right) {
+    kernel::elementwise<kernel::Sub>(value, value, right.value, N);
+    return *this;
+  }
+
+  bool operator<(const DiagonalMatrix& right) const { return allOf(right, [](T a, T b) { return a < b; }); }
+  bool operator<=(const DiagonalMatrix& right) const { return allOf(right, [](T a, T b) { return a <= b; }); }
+  bool operator>(const DiagonalMatrix& right) const { return allOf(right, [](T a, T b) { return a > b; }); }
+  bool operator>=(const DiagonalMatrix& right) const { return allOf(right, [](T a, T b) { return a >= b; }); }
+
+  /**
+   * Multiplies a matrix with N rows, with N multiplications per column.
+   */
+  template < unsigned int K >
+  Matrix<N, K, T> operator*(const Matrix<N, K, T>& right) const {
+    Matrix<N, K, T> result;
+    kernel::diagonalMultiply<N, K>(result.data(), value, right.data());
+    return result;
+  }
+
+  /**
+   * @return dense matrix with the same elements
+   */
+  Matrix<N, N, T> toMatrix() const {
+    Matrix<N, N, T> m;
+    m.zero();
+    for (unsigned int i = 0; i < N; i++) m(i, i) = value[i];
+    return m;
+  }
+
+  T* data() { return value; }
+  const T* data() const { return value; }
+
+ private:
+  template < typename P >
+  bool allOf(const DiagonalMatrix& right, P p) const {
+    for (unsigned int i = 0; i < N; i++) {
+      if (!p(value[i], right.value[i])) return false;
+    }
+    return true;
+  }
+
+  T value[N];
+};
+
+/**
+ * Block diagonal matrix of L square BxB blocks on its diagonal, e.g. the
+ * decoupling gain of L identical axes with B coupled inputs each.
+ *
+ * @tparam B - number of rows and columns of a block
+ * @tparam L - number of blocks
+ * @tparam T - value type (double - default type)
+ *
+ * @since v1.4.4
+ */
+template < unsigned int B, unsigned int L, typename T = double >
+class BlockDiagonalMatrix {
+  static constexpr unsigned int N = B * L;
+  static constexpr unsigned int S = B * B * L;
+
+ public:
+  using value_type = T;
+
+  /**
+   * Constructs a zero matrix.
+   */
+  BlockDiagonalMatrix() { fill(0); }
+
+  /**
+   * Constructs a matrix with all elements of all blocks set to v.
+   *
+   * @param v - value of the block elements
+   */
+  BlockDiagonalMatrix(const T v) { fill(v); }
+
+  /**
+   * Constructs a matrix with the same block repeated on the diagonal.
+   *
+   * @param block - block
+   */
+  BlockDiagonalMatrix(const Matrix<B, B, T>& block) {
+    for (unsigned int l = 0; l < L; l++) setBlock(l, block);
+  }
+
+  /**
+   * Constructs a matrix from its blocks.
+   *
+   * @param blocks - L blocks from top left to bottom right
+   */
+  BlockDiagonalMatrix(std::initializer_list<Matrix<B, B, T>> blocks) {
+    if (blocks.size() != L) throw Fault("block diagonal matrix needs " + std::to_string(L) + " blocks");
+    unsigned int l = 0;
+    for (auto& b : blocks) setBlock(l++, b);
+  }
+
+  /**
+   * Sets a block.
+   *
+   * @param l - index of the block
+   * @param block - block
+   */
+  void setBlock(unsigned int l, const Matrix<B, B, T>& block) {
+    std::copy(block.data(), block.data() + B * B, value + B * B * l);
+  }
+
+  /**
+   * @param l - index of the block
+   * @return block l
+   */
+  Matrix<B, B, T> getBlock(unsigned int l) const {
+    Matrix<B, B, T> block;
+    std::copy(value + B * B * l, value + B * B * (l + 1), block.data());
+    return block;
+  }
+
+  /**
+   * @return element in row m and column n, 0 outside the blocks
+   */
+  T operator()(unsigned int m, unsigned int n) const {
+    unsigned int l = m / B;
+    if (n / B != l) return T(0);
+    return value[B * B * l + B * (n % B) + m % B];
+  }
+
+  /**
+   * Sets all elements of all blocks.
+   *
+   * @param v - value of the block elements
+   */
+  void fill(T v) { std::fill(value, value + S, v); }
+
+  BlockDiagonalMatrix& operator=(T v) {
+    fill(v);
+    return *this;
+  }
+
+  BlockDiagonalMatrix& operator+=(const BlockDiagonalMatrix& right) {
+    kernel::elementwise<kernel::Add>(value, value, right.value, S);
+    return *this;
+  }
+
+  BlockDiagonalMatrix& operator-=(const BlockDiagonalMatrix& right) {
+    kernel::elementwise<kernel::Sub>(value, value, right.value, S);
+    return *this;
+  }
+
+  bool operator<(const BlockDiagonalMatrix& right) const { return allOf(right, [](T a, T b) { return a < b; }); }
+  bool operator<=(const BlockDiagonalMatrix& right) const { return allOf(right, [](T a, T b) { return a <= b; }); }
+  bool operator>(const BlockDiagonalMatrix& right) const { return allOf(right, [](T a, T b) { return a > b; }); }
+  bool operator>=(const BlockDiagonalMatrix& right) const { return allOf(right, [](T a, T b) { return a >= b; }); }
+
+  /**
+   * Multiplies a matrix with B*L rows, with B*B*L multiplications per column.
+   */
+  template < unsigned int K >
+  Matrix<N, K, T> operator*(const Matrix<N, K, T>& right) const {
+    Matrix<N, K, T> result;
+    kernel::blockDiagonalMultiply<B, L, K>(result.data(), value, right.data());
+    return result;
+  }
+
+  /**
+   * @return dense matrix with the same elements
+   */
+  Matrix<N, N, T> toMatrix() const {
+    Matrix<N, N, T> m;
+    for (unsigned int n = 0; n < N; n++) {
+      for (unsigned int i = 0; i < N; i++) m(i, n) = (*this)(i, n);
+    }
+    return m;
+  }
+
+  T* data() { return value; }
+  const T* data() const { return value; }
+
+ private:
+  template < typename P >
+  bool allOf(const BlockDiagonalMatrix& right, P p) const {
+    for (unsigned int i = 0; i < S; i++) {
+      if (!p(value[i], right.value[i])) return false;
+    }
+    return true;
+  }
+
+  T value[S];
+};
+
+/**
+ * Sparse MxN matrix in compressed sparse row form with room for up to NNZ
+ * stored elements. The storage has a fixed size, so matrices are copied
+ * without allocating memory.
+ *
+ * The structure is set on construction. The arithmetic and relational
+ * operators use the structure of the left operand, elements which are not
+ * stored in the right operand count as 0. All matrices combined, e.g. the
+ * gain and its limits in a control::Gain block, should therefore have the
+ * same structure.
+ *
+ * @tparam M - number of rows
+ * @tparam N - number of columns
+ * @tparam NNZ - maximum number of stored elements (M * N - default)
+ * @tparam T - value type (double - default type)
+ *
+ * @since v1.4.4
+ */
+template < unsigned int M, unsigned int N, unsigned int NNZ = M * N, typename T = double >
+class SparseMatrix {
+  static_assert(NNZ >= 1, "a sparse matrix needs room for at least one element");
+
+ public:
+  using value_type = T;
+
+  /**
+   * Stored element of a sparse matrix.
+   */
+  struct Element {
+    unsigned int row;
+    unsigned int col;
+    T value;
+  };
+
+  /**
+   * Constructs a zero matrix without stored elements.
+   */
+  SparseMatrix() : nnz(0) {
+    std::fill(rowStart, rowStart + M + 1, 0u);
+  }
+
+  /**
+   * Constructs a matrix storing the non-zero elements of a dense matrix.
+   *
+   * @param dense - dense matrix
+   */
+  SparseMatrix(const Matrix<M, N, T>& dense) : nnz(0) {
+    rowStart[0] = 0;
+    for (unsigned int m = 0; m < M; m++) {
+      for (unsigned int n = 0; n < N; n++) {
+        if (dense(m, n) == T(0)) continue;
+        if (nnz == NNZ) throw Fault("sparse matrix has more than " + std::to_string(NNZ) + " non-zero elements");
+        col[nnz] = n;
+        value[nnz++] = dense(m, n);
+      }
+      rowStart[m + 1] = nnz;
+    }
+  }
+
+  /**
+   * Constructs a matrix from its stored elements, which may be given in any
+   * order. Elements which are 0 are stored as well.
+   *
+   * @param elements - stored elements
+   */
+  SparseMatrix(std::initializer_list<Element> elements) : nnz(0) {
+    if (elements.size() > NNZ) throw Fault("sparse matrix has more than " + std::to_string(NNZ) + " elements");
+    std::vector<Element> e(elements);
+    std::sort(e.begin(), e.end(), [](const Element& a, const Element& b) {
+      return a.row < b.row || (a.row == b.row && a.col < b.col);
+    });
+    std::fill(rowStart, rowStart + M + 1, 0u);
+    for (unsigned int i = 0; i < e.size(); i++) {
+      if (e[i].row >= M || e[i].col >= N) throw Fault("sparse matrix element out of range");
+      if (i > 0 && e[i].row == e[i - 1].row && e[i].col == e[i - 1].col) throw Fault("sparse matrix element given twice");
+      col[nnz] = e[i].col;
+      value[nnz++] = e[i].value;
+      rowStart[e[i].row + 1]++;
+    }
+    for (unsigned int m = 0; m < M; m++) rowStart[m + 1] += rowStart[m];
+  }
+
+  /**
+   * @return number of stored elements
+   */
+  unsigned int getNofNonZeros() const { return nnz; }
+
+  /**
+   * @return element in row m and column n, 0 if it is not stored
+   */
+  T operator()(unsigned int m, unsigned int n) const {
+    const unsigned int* end = col + rowStart[m + 1];
+    const unsigned int* c = std::lower_bound(col + rowStart[m], end, n);
+    return (c != end && *c == n) ? value[c - col] : T(0);
+  }
+
+  /**
+   * Sets all stored elements.
+   *
+   * @param v - value of the stored elements
+   */
+  void fill(T v) { std::fill(value, value + nnz, v); }
+
+  SparseMatrix& operator=(T v) {
+    fill(v);
+    return *this;
+  }
+
+  SparseMatrix& operator+=(const SparseMatrix& right) {
+    forEach(*this, right, [](T& a, T b) { a += b; return true; });
+    return *this;
+  }
+
+  SparseMatrix& operator-=(const SparseMatrix& right) {
+    forEach(*this, right, [](T& a, T b) { a -= b; return true; });
+    return *this;
+  }
+
+  bool operator<(const SparseMatrix& right) const { return allOf(right, [](T a, T b) { return a < b; }); }
+  bool operator<=(const SparseMatrix& right) const { return allOf(right, [](T a, T b) { return a <= b; }); }
+  bool operator>(const SparseMatrix& right) const { return allOf(right, [](T a, T b) { return a > b; }); }
+  bool operator>=(const SparseMatrix& right) const { return allOf(right, [](T a, T b) { return a >= b; }); }
+
+  /**
+   * Multiplies a matrix with N rows, with one multiplication per stored
+   * element and column.
+   */
+  template < unsigned int K >
+  Matrix<M, K, T> operator*(const Matrix<N, K, T>& right) const {
+    Matrix<M, K, T> result;
+    kernel::sparseMultiply<M, N, K>(result.data(), value, col, rowStart, right.data());
+    return result;
+  }
+
+  /**
+   * @return dense matrix with the same elements
+   */
+  Matrix<M, N, T> toMatrix() const {
+    Matrix<M, N, T> d;
+    d.zero();
+    for (unsigned int m = 0; m < M; m++) {
+      for (unsigned int j = rowStart[m]; j < rowStart[m + 1]; j++) d(m, col[j]) = value[j];
+    }
+    return d;
+  }
+
+ private:
+  // calls f(a, b) for each stored element a of left and the element b of right
+  // at the same position, until f returns false; both rows are sorted by column
+  template < typename S, typename F >
+  static bool forEach(S& left, const SparseMatrix& right, F f) {
+    for (unsigned int m = 0; m < M; m++) {
+      unsigned int k = right.rowStart[m];
+      for (unsigned int j = left.rowStart[m]; j < left.rowStart[m + 1]; j++) {
+        while (k < right.rowStart[m + 1] && right.col[k] < left.col[j]) k++;
+        T b = (k < right.rowStart[m + 1] && right.col[k] == left.col[j]) ? right.value[k] : T(0);
+        if (!f(left.value[j], b)) return false;
+      }
+    }
+    return true;
+  }
+
+  template < typename P >
+  bool allOf(const SparseMatrix& right, P p) const {
+    return forEach(*this, right, [&p](const T& a, T b) { return p(a, b); });
+  }
+
+  T value[NNZ];
+  unsigned int col[NNZ];
+  unsigned int rowStart[M + 1];
+  unsigned int nnz;
+};
+
+template < unsigned int N, typename T >
+std::ostream& operator<<(std::ostream& os, const DiagonalMatrix<N, T>& right) {
+  right.toMatrix().print(os);
+  return os;
+}
+
+template < unsigned int B, unsigned int L, typename T >
+std::ostream& operator<<(std::ostream& os, const BlockDiagonalMatrix<B, L, T>& right) {
+  right.toMatrix().print(os);
+  return os;
+}
+
+template < unsigned int M, unsigned int N, unsigned int NNZ, typename T >
+std::ostream& operator<<(std::ostream& os, const SparseMatrix<M, N, NNZ, T>& right) {
+  right.toMatrix().print(os);
+  return os;
+}
+
+}  // namespace math
+}  // namespace eeros
+
+#endif /* ORG_EEROS_MATH_STRUCTUREDMATRIX_HPP_ */
@@ -66,7 +66,7 @@ class TF_Node {
    *
    * @return list of parents
    */
-  const std::vector<int> getParents() const { return parents; }
+  const std::vector<int>& getParents() const { return parents; }
 
   /**
    * Returns the transformation matrix of this node.
@@ -87,7 +87,7 @@ class TF_Node {
    *
    * @return list of children
    */
-  std::vector<int> getChildren() const { return children; }
+  const std::vector<int>& getChildren() const { return children; }
 
  private:
   std::string name, baseName;
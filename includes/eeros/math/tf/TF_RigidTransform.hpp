@@ -0,0 +1,150 @@
+#pragma once
+
+#include <eeros/math/Matrix.hpp>
+#include <eeros/math/tf/TF_Matrix.hpp>
+#include <cstddef>
+
+namespace eeros {
+namespace math {
+namespace tf {
+
+using namespace eeros::math;
+
+/**
+ * Rigid body transformation, consisting of a rotation and a translation.
+ * Compared to a general 4x4 \ref TF_Matrix, composing two transformations
+ * takes 36 instead of 64 multiplications and the inverse is calculated in closed
+ * form by transposing the rotation, so it stays orthonormal.
+ *
+ * @since v1.4.4
+ */
+class TF_RigidTransform {
+ public:
+  /**
+   * Creates the identity transformation.
+   */
+  TF_RigidTransform() : r{1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0}, t{0.0, 0.0, 0.0} { }
+
+  /**
+   * Creates a transformation from a rotation and a translation.
+   *
+   * @param rot - rotation matrix
+   * @param trans - translation
+   */
+  TF_RigidTransform(const Matrix<3, 3, double>& rot, const Vector3& trans);
+
+  /**
+   * Creates a transformation from the rotation and translation of 
+   * a transformation matrix, see \ref isRigid.
+   *
+   * @param m - transformation matrix
+   */
+  explicit TF_RigidTransform(const Matrix<4, 4, double>& m);
+
+  /**
+   * Checks whether a transformation matrix describes a rigid body transformation,
+   * that is an orthonormal rotation, a translation and a last row of [0 0 0 1].
+   *
+   * @param m - transformation matrix
+   * @param tolerance - tolerance of the orthonormality
+   * @return true, if rigid
+   */
+  static bool isRigid(const Matrix<4, 4, double>& m, double tolerance = 1e-9);
+
+  /**
+   * Composes two transformations, this one applied after the right one.
+   *
+   * @param right - transformation applied first
+   * @return composed transformation
+   */
+  TF_RigidTransform operator*(const TF_RigidTransform& right) const {
+    TF_RigidTransform c;
+    for (int i = 0; i < 3; i++) {
+      const double* row = &r[3 * i];
+      for (int j = 0; j < 3; j++) {
+        c.r[3 * i + j] = row[0] * right.r[j] + row[1] * right.r[3 + j] + row[2] * right.r[6 + j];
+      }
+      c.t[i] = row[0] * right.t[0] + row[1] * right.t[1] + row[2] * right.t[2] + t[i];
+    }
+    return c;
+  }
+
+  /**
+   * Transforms a point.
+   *
+   * @param p - point
+   * @return transformed point
+   */
+  Vector3 operator*(const Vector3& p) const {
+    return Vector3(r[0] * p(0) + r[1] * p(1) + r[2] * p(2) + t[0],
+                   r[3] * p(0) + r[4] * p(1) + r[5] * p(2) + t[1],
+                   r[6] * p(0) + r[7] * p(1) + r[8] * p(2) + t[2]);
+  }
+
+  /**
+   * Transforms n points given as separate arrays of their coordinates, e.g.
+   * a laser scan or a point cloud. The points are processed in vector registers
+   * of the target (AVX, SSE2 or NEON), see \ref kernel::DoublePack.
+   * The output arrays may be the input arrays, but must not overlap them otherwise.
+   *
+   * @param x - x coordinates
+   * @param y - y coordinates
+   * @param z - z coordinates
+   * @param xOut - transformed x coordinates
+   * @param yOut - transformed y coordinates
+   * @param zOut - transformed z coordinates
+   * @param n - number of points
+   */
+  void transform(const double* x, const double* y, const double* z,
+                 double* xOut, double* yOut, double* zOut, std::size_t n) const;
+
+  /**
+   * Calculates the inverse in closed form, the transposed rotation 
+   * and the negative, back rotated translation.
+   *
+   * @return inverse transformation
+   */
+  TF_RigidTransform inverse() const {
+    TF_RigidTransform inv;
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) inv.r[3 * i + j] = r[3 * j + i];
+      inv.t[i] = -(r[i] * t[0] + r[3 + i] * t[1] + r[6 + i] * t[2]);
+    }
+    return inv;
+  }
+
+  /**
+   * Makes the rotation orthonormal again with Gram-Schmidt, e.g. after 
+   * composing many transformations.
+   */
+  void orthonormalize();
+
+  /**
+   * Gets the rotation.
+   *
+   * @return rotation
+   */
+  Matrix<3, 3, double> getRot() const;
+
+  /**
+   * Gets the translation.
+   *
+   * @return translation
+   */
+  Vector3 getTrans() const;
+
+  /**
+   * Gets the transformation as transformation matrix.
+   *
+   * @return transformation matrix
+   */
+  TF_Matrix getTF() const;
+
+ private:
+  double r[9];  // rotation, row major
+  double t[3];  // translation
+};
+
+}  // namespace tf
+}  // namespace math
+}  // namespace eeros
@@ -7,8 +7,11 @@
 
 #include <eeros/math/tf/TF_Exceptions.hpp>
 #include <eeros/math/tf/TF_Node.hpp>
+#include <eeros/math/tf/TF_RigidTransform.hpp>
+#include <cstdint>
 #include <exception>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace eeros {
@@ -19,7 +22,12 @@ using namespace eeros::math;
 using namespace eeros::logger;
 
 /**
- * A tree consisting of nodes containing transformation matrices
+ * A tree consisting of nodes containing transformation matrices.
+ * The result of each queried pair of nodes is cached. A repeated query only
+ * compares the matrices along the path with the ones used for the cached
+ * result and recalculates it if any of them has been changed.
+ * As long as all matrices along the path are rigid body transformations,
+ * they are composed as \ref TF_RigidTransform.
  */
 class TF_Tree {
  private:
@@ -103,6 +111,16 @@ class TF_Tree {
    */
   TF_Matrix& getTF(const std::string name);
 
+  /**
+   * Returns the id of the node with a given name. Querying by id saves 
+   * looking up the names.
+   *
+   * @param name - name of the node
+   *
+   * @return id of the node
+   */
+  int getId(const std::string& name);
+
   /**
    * Returns the transformation matrix leading from a start node
    * to a destination node. Both nodes must be present in this tree.
@@ -117,6 +135,51 @@ class TF_Tree {
   virtual TF_Matrix tfFrameToOrigin(const std::string frame,
                                 const std::string origin);
 
+  /**
+   * Returns the transformation matrix leading from a start node
+   * to a destination node, see \ref tfFrameToOrigin(const std::string, const std::string).
+   * Does not allocate memory once the pair has been queried.
+   *
+   * @param frame - id of the start node
+   * @param origin - id of the destination node
+   *
+   * @return transformation matrix
+   */
+  virtual TF_Matrix tfFrameToOrigin(int frame, int origin);
+
+  /**
+   * Returns the rigid body transformation leading from a start node
+   * to a destination node, see \ref tfFrameToOrigin(int, int).
+   *
+   * @param frame - id of the start node
+   * @param origin - id of the destination node
+   *
+   * @return rigid body transformation
+   */
+  TF_RigidTransform rigidFrameToOrigin(int frame, int origin) {
+    return TF_RigidTransform(tfFrameToOrigin(frame, origin));
+  }
+
+  /**
+   * Transforms n points given in the coordinates of the destination node into
+   * the coordinates of the start node, with the transformation resolved once,
+   * see \ref TF_RigidTransform::transform.
+   *
+   * @param frame - id of the start node
+   * @param origin - id of the destination node
+   * @param x - x coordinates
+   * @param y - y coordinates
+   * @param z - z coordinates
+   * @param xOut - transformed x coordinates
+   * @param yOut - transformed y coordinates
+   * @param zOut - transformed z coordinates
+   * @param n - number of points
+   */
+  void transformPoints(int frame, int origin, const double* x, const double* y, const double* z,
+                       double* xOut, double* yOut, double* zOut, std::size_t n) {
+    rigidFrameToOrigin(frame, origin).transform(x, y, z, xOut, yOut, zOut, n);
+  }
+
   /**
    * Print tree from given node
    *
@@ -127,17 +190,29 @@ class TF_Tree {
 
  protected:
   virtual TF_Node& getNode(std::string name) {
-    for (uint32_t i = 0; i < nodes.size(); i++) {
-      if (nodes[i].getName() == name) {
-        return nodes[i];
-      }
-    }
-    throw(TF_NotFoundException(name));
+    return nodes[getId(name)];
   }
 
  private:
+  struct NodeState {
+    Matrix<4, 4, double> used;  // matrix used for the cached results
+    bool rigid;                 // used is a rigid body transformation
+    uint64_t changedAt;         // revision, at which a change of the matrix was detected
+    int parent;
+  };
+  struct CachedTF {
+    TF_Matrix tf;
+    int sameParent;
+    uint64_t revision;  // revision at which tf was calculated
+  };
+  bool changedSince(int node, int ancestor, uint64_t revision);
+
   ucl::Ucl jsonParameter;
   std::vector<TF_Node> nodes;
+  std::vector<NodeState> states;               // indexed by node id
+  std::unordered_map<std::string, int> ids;
+  std::unordered_map<uint64_t, CachedTF> cache;  // key: frame and origin id
+  uint64_t revision = 0;
   Logger log;
 };
 
@@ -2,7 +2,10 @@
 #define ORG_EEROS_SAFETY_INPUTACTION_HPP_
 
 #include <stdint.h>
+#include <array>
+#include <vector>
 #include <eeros/hal/Input.hpp>
+#include <eeros/math/MatrixKernels.hpp>
 #include <eeros/safety/SafetyLevel.hpp>
 #include <eeros/safety/SafetyContext.hpp>
 
@@ -17,6 +20,7 @@ class InputAction {
   virtual ~InputAction() { }
   virtual bool check(SafetyContext* context) { return false; }
   virtual hal::InputInterface* getInput() {return input;}
+  virtual std::vector<hal::InputInterface*> getInputs() { return {input}; }
  protected:
   hal::InputInterface* input;
 };
@@ -32,16 +36,17 @@ class IgnoreInputAction : public InputAction {
 template <typename T>
 class CheckInputAction : public InputAction {
  public:
-  CheckInputAction(hal::Input<T>& input, T value, SafetyEvent& event) : InputAction(input), value(value), event(event) { }
+  CheckInputAction(hal::Input<T>& input, T value, SafetyEvent& event) : InputAction(input), typedInput(&input), value(value), event(event) { }
   virtual ~CheckInputAction() { }
   virtual bool check(SafetyContext* context) {
-    if (dynamic_cast<hal::Input<T>*>(input)->get() != value) {
+    if (typedInput->get() != value) {
       context->triggerEvent(event);
       return true;
     }
     return false;
   }
  private:
+  hal::Input<T>* typedInput;
   T value;
   SafetyEvent& event;
 };
@@ -50,10 +55,10 @@ template <typename T>
 class CheckRangeInputAction : public InputAction {
  public:
   CheckRangeInputAction(hal::Input<T>& input, T min, T max, SafetyEvent& event, bool offRange = false) 
-      : InputAction(input), min(min), max(max), event(event), offRange(offRange) { }
+      : InputAction(input), typedInput(&input), min(min), max(max), event(event), offRange(offRange) { }
   virtual ~CheckRangeInputAction() { }
   virtual bool check(SafetyContext* context) {
-    T value = dynamic_cast<hal::Input<T>*>(input)->get();
+    T value = typedInput->get();
     if (offRange) {
       if (value > min && value < max) {
         context->triggerEvent(event);
@@ -68,12 +73,52 @@ class CheckRangeInputAction : public InputAction {
     return false;
   }
  private:
+  hal::Input<T>* typedInput;
   T min;
   T max;
   SafetyEvent& event;
   bool offRange;
 };
 
+/**
+ * Checks the ranges of a group of inputs with a single input action, e.g. all
+ * analog inputs of one device. The inputs are read back to back into a contiguous
+ * array, which is then checked in one branch free pass, see math::kernel::firstBeyond().
+ * Hardware wrappers which read a device image once per cycle serve all reads of
+ * the group from the same transfer.
+ * If an input is out of range, the event is triggered once and getInput() returns
+ * the first input out of range.
+ *
+ * @tparam T - value type of the inputs
+ * @tparam N - number of inputs
+ */
+template <typename T, int N>
+class CheckRangeInputGroupAction : public InputAction {
+ public:
+  CheckRangeInputGroupAction(std::array<hal::Input<T>*, N> inputs, std::array<T, N> min, std::array<T, N> max, SafetyEvent& event, bool offRange = false)
+      : InputAction(*inputs[0]), inputs(inputs), min(min), max(max), event(event), offRange(offRange) { }
+  virtual ~CheckRangeInputGroupAction() { }
+  virtual bool check(SafetyContext* context) {
+    for (int i = 0; i < N; i++) values[i] = inputs[i]->get();
+    unsigned int i = offRange ? math::kernel::firstWithin(values.data(), min.data(), max.data(), N)
+                              : math::kernel::firstBeyond(values.data(), min.data(), max.data(), N);
+    if (i == N) return false;
+    input = inputs[i];
+    context->triggerEvent(event);
+    return true;
+  }
+  virtual std::vector<hal::InputInterface*> getInputs() {
+    return std::vector<hal::InputInterface*>(inputs.begin(), inputs.end());
+  }
+ private:
+  std::array<hal::Input<T>*, N> inputs;
+  std::array<T, N> values;
+  std::array<T, N> min;
+  std::array<T, N> max;
+  SafetyEvent& event;
+  bool offRange;
+};
+
 template <typename T>
 IgnoreInputAction<T>* ignore(eeros::hal::Input<T>& input) {
   return new IgnoreInputAction<T>(input);
@@ -104,6 +149,11 @@ CheckRangeInputAction<T>* range(eeros::hal::Input<T>* input, T min, T max, Safet
   return new CheckRangeInputAction<T>(*input, min, max, event, offRange);
 }
 
+template <typename T, std::size_t N>
+CheckRangeInputGroupAction<T, N>* range(std::array<eeros::hal::Input<T>*, N> inputs, std::array<T, N> min, std::array<T, N> max, SafetyEvent& event, bool offRange = false) {
+  return new CheckRangeInputGroupAction<T, N>(inputs, min, max, event, offRange);
+}
+
 }
 }
 
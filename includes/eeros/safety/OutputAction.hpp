@@ -9,6 +9,11 @@
 namespace eeros {
 	namespace safety {
 
+		/**
+		 * An output action sets a critical output in every cycle of the safety system.
+		 * Outputs which belong to a hal::OutputBatch are committed once per cycle
+		 * after all output actions of the level were applied.
+		 */
 		class OutputAction {
 		public:
 			OutputAction(hal::OutputInterface* out) : output(out) { }
@@ -27,31 +32,37 @@ namespace eeros {
 			virtual void set() { }
 		};
 
+		/**
+		 * Sets an output to a constant value. The output is only written if it
+		 * does not have this value already.
+		 */
 		template < typename T >
 		class SetOutputAction : public OutputAction {
 		public:
-			SetOutputAction(hal::Output<T>* output, T value) : OutputAction(output), value(value) { }
+			SetOutputAction(hal::Output<T>* output, T value) : OutputAction(output), typedOutput(output), value(value) { }
 			virtual ~SetOutputAction() { }
 			virtual void set() { 
-				dynamic_cast<hal::Output<T>*>(output)->set(value);
+				if (typedOutput->get() != value) typedOutput->set(value);
 			}
 		private:
+			hal::Output<T>* typedOutput;
 			T value;
 		};
 	
 		template < typename T >
 		class ToggleOutputAction : public OutputAction {
 		public:
-			ToggleOutputAction(hal::Output<T>* output, T low, T high) : OutputAction(output), value(low), low(low), high(high) { }
+			ToggleOutputAction(hal::Output<T>* output, T low, T high) : OutputAction(output), typedOutput(output), value(low), low(low), high(high) { }
 			virtual ~ToggleOutputAction() { }
 			virtual void set() {
-				dynamic_cast<hal::Output<T>*>(output)->set(value);
+				typedOutput->set(value);
 				if (value == low)
 					value = high;
 				else
 					value = low;
 			}
 		private:
+			hal::Output<T>* typedOutput;
 			T value;
 			T low;
 			T high;
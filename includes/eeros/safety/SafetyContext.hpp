@@ -13,7 +13,7 @@ namespace eeros {
 			friend class SafetySystem;
 			
 		public:
-			void triggerEvent(SafetyEvent event);
+			void triggerEvent(const SafetyEvent& event);
 			
 		private:
 			SafetyContext(SafetySystem* parent);
@@ -27,6 +27,7 @@ enum EventType { kPrivateEvent, kPublicEvent };
  */
 class SafetyEvent {
   friend class SafetyLevel;
+  friend class SafetySystem;
 
  public:
   /**
@@ -44,6 +45,15 @@ class SafetyEvent {
   std::string getDescription();
 
  private:
+  /**
+   * Returns the name of the event with the given id, used to format
+   * deferred log messages which only carry the id.
+   *
+   * @param id id of the event
+   * @return the name of the event
+   */
+  static std::string getDescription(uint32_t id);
+
   std::string description;
   uint32_t id;
 };
@@ -99,7 +109,7 @@ class SafetyLevel {
    * @return the destination level of this event,
    *         nullptr: if no event was registered for this level or registered event is private
    */
-  SafetyLevel* getDestLevelForEvent(SafetyEvent event, bool privateEventOk = false);
+  SafetyLevel* getDestLevelForEvent(const SafetyEvent& event, bool privateEventOk = false);
 
   /**
    * Adds an event to a safety level. Every safety event has exactly one destination level
@@ -218,13 +228,27 @@ class SafetyLevel {
   bool operator!=(const SafetyLevel& level);
 
  private:
+  using Transition = std::pair<SafetyLevel*, EventType>;
+
+  /**
+   * Compiles the transitions into a dense table indexed by event id, so that
+   * getDestLevelForEvent() becomes a single array load. Called by SafetyProperties::verify().
+   *
+   * @param firstEvent smallest event id of the table
+   * @param nofEvents number of event ids covered by the table
+   */
+  void compileTransitions(uint32_t firstEvent, uint32_t nofEvents);
+
   std::function<void (SafetyContext*)> action;
   int32_t id;
   uint32_t nofActivations;
   std::string description;
-  std::map<uint32_t, std::pair<SafetyLevel*, EventType>> transitions;
+  std::map<uint32_t, Transition> transitions;
+  std::vector<Transition> table;  // compiled transitions, level is nullptr if not registered
+  uint32_t tableBase = 0;         // event id of the first table entry
   std::vector<InputAction*> inputAction;
   std::vector<OutputAction*> outputAction;
+  std::vector<hal::OutputBatch*> outputBatches;  // distinct batches of the output actions
   std::function<void (SafetyContext*)> onEntry;
   std::function<void ()> onExit;
   logger::Logger log;
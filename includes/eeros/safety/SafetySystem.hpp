@@ -1,14 +1,20 @@
 #ifndef ORG_EEROS_SAFETY_SAFETYSYSTEM_HPP_
 #define ORG_EEROS_SAFETY_SAFETYSYSTEM_HPP_
 
+#include <array>
 #include <atomic>
+#include <eeros/core/MpscRingBuffer.hpp>
+#include <eeros/core/PeriodicCounter.hpp>
 #include <eeros/core/Runnable.hpp>
+#include <eeros/core/Wcet.hpp>
 #include <eeros/logger/LogWriter.hpp>
 #include <eeros/logger/Logger.hpp>
 #include <eeros/safety/SafetyContext.hpp>
 #include <eeros/safety/SafetyLevel.hpp>
 #include <eeros/safety/SafetyProperties.hpp>
 #include <mutex>
+#include <string>
+#include <thread>
 #include <vector>
 
 namespace eeros {
@@ -45,11 +51,65 @@ class SafetySystem : public Runnable {
    * Causes a fire a safety event. Make sure that this event is registered for
    * the actual safety level and that it is a public event in case of being
    * fired from outside of the safety system.
+   * Neither allocates nor formats, the event is logged later by a logger thread
+   * of the safety system, so it may be called from realtime threads.
    * @param event The safety event to be fired.
    * @param context The context, in which the event is fired, this could be
    * public or private.
    */
-  void triggerEvent(SafetyEvent event, SafetyContext* context = nullptr);
+  void triggerEvent(const SafetyEvent& event, SafetyContext* context = nullptr);
+
+  /**
+   * Getter function for the number of triggered events, which could not be logged
+   * because the queue of the logger thread was full.
+   * @return The number of lost event log messages.
+   */
+  uint64_t getLostEventRecords() const;
+
+  /**
+   * Triggers an event in the private context of the safety system, if the
+   * period of the safety system exceeds a threshold in count consecutive cycles,
+   * so that a scheduling overload drives the system into a safe level.
+   * The event is triggered again after each further count late cycles.
+   * If the safety system is the main task of the executor, the executor installs
+   * the monitor itself. Otherwise, add getTimingMonitor() to the monitors of the
+   * periodic running the safety system.
+   * @param event The safety event to be fired.
+   * @param threshold The longest period in seconds, which is not late.
+   * @param count The number of consecutive late cycles.
+   */
+  void setLatenessEvent(SafetyEvent& event, double threshold, unsigned int count = 3);
+
+  /**
+   * Getter function for the timing monitor of the safety system, see setLatenessEvent().
+   * @return The monitor, which checks the period measured by a PeriodicCounter.
+   */
+  PeriodicCounter::MonitorFunc getTimingMonitor();
+
+  /**
+   * Getter function for the lateness monitoring.
+   * @return true, if a lateness event is set.
+   */
+  bool hasLatenessEvent() const;
+
+  /**
+   * Sets the file, to which the audit ring is dumped by the terminate handler
+   * and by exitHandler(). The audit ring holds the last auditSize triggered events,
+   * level transitions, input action hits and onEntry/onExit calls with a
+   * nanosecond timestamp. It is recorded always, without locks or allocations.
+   * No file is written as long as no file is set.
+   * @param path The path of the dump file.
+   */
+  void setAuditFile(std::string path);
+
+  /**
+   * Writes the audit ring, oldest entry first.
+   * @param path The path of the dump file.
+   * @return true, if the file could be written.
+   */
+  bool dumpAudit(const std::string& path);
+
+  static constexpr unsigned int auditSize = 1024;
 
   /**
    * Getter function for the current safety properties.
@@ -69,6 +129,33 @@ class SafetySystem : public Runnable {
    */
   void run();
 
+  /**
+   * Enables the fast path of the critical inputs. The input actions of the current
+   * level which check a critical input are then no longer run by run(), but by
+   * checkCriticalInputs(), which the executor calls at the start of every base
+   * cycle before any task. The executor enables the fast path when it starts,
+   * see Executor::setCriticalInputFastPath().
+   * @param enable true to check the critical inputs with checkCriticalInputs().
+   */
+  void setCriticalFastPath(bool enable);
+
+  /**
+   * Getter function for the fast path of the critical inputs.
+   * @return true, if the critical inputs are checked by checkCriticalInputs().
+   */
+  bool hasCriticalFastPath() const;
+
+  /**
+   * Runs the input actions of the current level which check a critical input.
+   * If an action triggers a transition, the critical outputs are set at once as
+   * in the destination level, the transition itself is made by the next run().
+   * Neither allocates nor locks. Called by the executor, do not call manually.
+   * @param readBatches true to read the batches of the critical inputs first,
+   * if the HAL does not update them.
+   * @return true, if an input action triggered.
+   */
+  bool checkCriticalInputs(bool readBatches = false);
+
   /**
    * This method can be used to shut the system down gracefully when stopping a
    * program with signals, e.g. SIGINT. Register a signal handler and call this
@@ -80,10 +167,64 @@ class SafetySystem : public Runnable {
                          safety system */
 
  private:
+  enum class AuditKind : uint32_t { event, transition, inputAction, entry, exit };
+
+  struct AuditRecord {
+    std::atomic<uint64_t> sequence{0};  // index + 1 of the record, 0 while written
+    std::atomic<uint64_t> timestamp{0};
+    std::atomic<uint32_t> kind{0};
+    std::atomic<int32_t> level{-1};     // level in which it happened
+    std::atomic<int32_t> arg{-1};       // event id, destination level or input action index
+    std::atomic<int32_t> dest{-1};      // destination level of an event, -1 if none
+  };
+
+  // input and output actions of a level, which concern critical inputs and outputs
+  struct CriticalActions {
+    std::vector<std::size_t> inputs;         // indices of the input actions
+    std::vector<bool> inputMask;             // input action checks a critical input
+    std::vector<OutputAction*> outputs;      // output actions of critical outputs
+    std::vector<bool> outputMask;            // output action sets a critical output
+    std::vector<hal::OutputBatch*> outputBatches;
+  };
+
+  struct EventRecord {
+    uint32_t event;
+    SafetyLevel* from;
+    SafetyLevel* to;  // nullptr if no transition is registered for the event
+    uint64_t timestamp;
+  };
+
   bool setProperties(SafetyProperties& safetyProperties);
+  void compileCriticalActions();
   static void printStackTrace();
+  void logEvents();
+  void checkTiming(double period);
+  void audit(AuditKind kind, int32_t level, int32_t arg = -1, int32_t dest = -1) noexcept;
+  void writeEventRecords();
+  MpscRingBuffer<EventRecord, 256> eventRecords;
+  std::atomic<uint64_t> lostEventRecords{0};
+  std::atomic<bool> stopping{false};
+  std::thread logThread;
+  SafetyEvent* latenessEvent = nullptr;
+  double latenessThreshold = 0;
+  unsigned int latenessCount = 0;
+  unsigned int lateCycles = 0;
+  std::atomic<uint64_t> auditHead{0};
+  std::array<AuditRecord, auditSize> auditRing;
+  std::string auditFile;
   std::mutex mtx;
   SafetyProperties properties;
+  std::vector<CriticalActions> critical;         // indexed by level id
+  std::vector<hal::InputBatch*> criticalBatches; // distinct batches of the critical inputs
+  std::atomic<bool> criticalFastPath{false};
+#ifdef EEROS_WCET
+  struct LevelProbes {
+    Wcet::Probe* action = nullptr;
+    Wcet::Probe* onEntry = nullptr;
+    Wcet::Probe* onExit = nullptr;
+  };
+  std::vector<LevelProbes> wcetProbes;   // indexed by level id
+#endif
   std::atomic<SafetyLevel*> currentLevel;
   std::atomic<SafetyLevel*> nextLevel;
   std::atomic<SafetyLevel*> entryLevel;
@@ -5,8 +5,8 @@
 #include <eeros/sequencer/ConditionTimeout.hpp>
 #include <eeros/sequencer/ConditionAbort.hpp>
 #include <eeros/sequencer/Monitor.hpp>
+#include <atomic>
 #include <vector>
-#include <mutex>
 
 
 namespace eeros {
@@ -25,6 +25,23 @@ enum class SequenceState {
   restarting    // repeat 
 };
 
+/**
+ * Holds the state of a sequence, so that other threads, e.g. a user interface,
+ * can read it without locking. Every change increments Sequencer::stateChanges.
+ *
+ * @since v1.4.4
+ */
+class SequenceStateCell {
+ public:
+  SequenceStateCell(SequenceState s = SequenceState::idle) : value(s) { }
+  SequenceStateCell(const SequenceStateCell&) = delete;
+  SequenceStateCell& operator=(SequenceState s);
+  operator SequenceState() const { return value.load(std::memory_order_acquire); }
+
+ private:
+  std::atomic<SequenceState> value;
+};
+
 /**
  * This is the base class for all \ref Sequence and \ref Step.
  * It defines the common basic functionalities.
@@ -84,6 +101,13 @@ class BaseSequence {
    * @return - name of the sequence
    */
   std::string getName() const;
+
+  /**
+   * Returns the state of the sequence, can be called from any thread.
+   *
+   * @return - state
+   */
+  SequenceState getState() const;
   
   /** 
    * Every sequence gets a id upon creation.
@@ -102,11 +126,21 @@ class BaseSequence {
   /**
    * The function \ref checkExitCondition() periodically checks for the exit 
    * condition to become true. In between checks the thread will wait for 
-   * polling time in ms.
+   * polling time in ms or until \ref Condition::notify() is called.
+   * With a polling time of 0 the sequence only checks when notified, which is
+   * enough if all its conditions notify, e.g. waits, timeouts, aborts and 
+   * conditions of a \ref ConditionScheduler.
    * 
-   * @param timeInMilliseconds - polling time in ms
+   * @param timeInMilliseconds - polling time in ms, 0 disables polling
    */
   void setPollingTime(int timeInMilliseconds);
+
+  /**
+   * Returns the polling time.
+   * 
+   * @return - polling time in ms, 0 if polling is disabled
+   */
+  int getPollingTime() const;
   
   /**
    * Adds a \ref Monitor to this sequence or step.
@@ -164,13 +198,14 @@ class BaseSequence {
   BaseSequence* caller; // calling sequence
   bool blocking;  // standard run mode
   bool inExcProcessing = false;	// this sequence started an exception sequence due to one of its monitors which is still running
-  SequenceState state;	
+  SequenceStateCell state;
   Logger log;
   
  private:
   void checkMonitors();
   BaseSequence* checkMonitor(Monitor* m);
   void clearActiveMonitor();	// clears any active monitor
+  double getWaitTime() const;	// polling time in sec
   std::vector<Monitor*> getMonitors() const;
   
   int id;
@@ -183,7 +218,7 @@ class BaseSequence {
   ConditionAbort conditionAbort;
   int pollingTime;  // in milliseconds for checkExitCondition monitors)
   Monitor* activeMonitor; // monitor, which fired and causes exception sequence to run
-  std::mutex mtx;
+  std::atomic<bool> active{false};  // a run of this sequence is active
 };
 
 /**
@@ -1,13 +1,26 @@
 #ifndef ORG_EEROS_SEQUENCER_CONDITION_HPP_
 #define ORG_EEROS_SEQUENCER_CONDITION_HPP_
 
+#include <atomic>
+
 namespace eeros {
+
+class FutexEvent;
+
 namespace sequencer {
 
+class ConditionScheduler;
+
 /**
  * A condition is checked by a \ref Monitor. You can define your 
  * own conditions by extending this class.
  * 
+ * Sequences check their exit conditions and monitors every polling time.
+ * Whoever changes what a condition depends on can call notify(), which wakes the
+ * waiting sequences to check again immediately.
+ * A condition watched by many sequences can be added to a \ref ConditionScheduler,
+ * which validates it once per tick for all of them.
+ * 
  * @since v1.0
  */
 class Condition {
@@ -22,8 +35,23 @@ class Condition {
    */
   virtual bool validate() = 0;
 
+  virtual ~Condition() = default;
+
+  /**
+   * Wakes all sequences waiting for their exit conditions or monitors, so they check 
+   * them without waiting for the polling time. Never blocks, so it may also be called
+   * from a time domain. The safety system calls it on every change of the safety level.
+   */
+  static void notify();
+
  private:
-  bool isTrue() {return validate();}
+  friend class BaseSequence;
+  friend class SequencePool;
+  friend class ConditionScheduler;
+  bool isTrue() {return scheduler.load(std::memory_order_acquire) ? result.load(std::memory_order_acquire) : validate();}
+  static FutexEvent& getEvent();
+  std::atomic<ConditionScheduler*> scheduler{nullptr};
+  std::atomic<bool> result{false};  // last result of the scheduler
 };
 
 } // namespace sequencer
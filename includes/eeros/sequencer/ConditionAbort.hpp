@@ -12,7 +12,7 @@ namespace eeros {
 			virtual ~ConditionAbort() { }
 			
 			bool validate() {return abort;}
-			void set() {abort = true;}
+			void set() {abort = true; notify();}
 			void reset() {abort = false;}
 		private:
 			bool abort = false;			
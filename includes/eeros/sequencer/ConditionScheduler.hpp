@@ -0,0 +1,80 @@
+#ifndef ORG_EEROS_SEQUENCER_CONDITIONSCHEDULER_HPP_
+#define ORG_EEROS_SEQUENCER_CONDITIONSCHEDULER_HPP_
+
+#include <eeros/core/Runnable.hpp>
+#include <eeros/sequencer/Condition.hpp>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace eeros {
+namespace sequencer {
+
+/**
+ * Validates shared conditions centrally. Each added condition is validated once
+ * per run, however many monitors or sequences check it. They read its last result
+ * instead of validating it themselves. Whenever a result changes, 
+ * \ref Condition::notify() wakes the waiting sequences.
+ * 
+ * Add the scheduler to a periodic task or a time domain, its period is the tick
+ * with which the results are updated. run() never blocks, so validate() of the
+ * added conditions must not block either.
+ * 
+ * A condition must be removed before it is destroyed.
+ * 
+ * @since v1.4.4
+ */
+class ConditionScheduler : public Runnable {
+ public:
+  ConditionScheduler();
+
+  /**
+   * Removes all conditions, which are then validated directly again.
+   */
+  virtual ~ConditionScheduler();
+
+  ConditionScheduler(const ConditionScheduler&) = delete;
+  ConditionScheduler& operator=(const ConditionScheduler&) = delete;
+
+  /**
+   * Adds a condition and validates it the first time.
+   * Adding a condition twice has no effect.
+   * 
+   * @param condition - condition
+   */
+  void add(Condition& condition);
+
+  /**
+   * Removes a condition, which is then validated directly by the monitors again.
+   * 
+   * @param condition - condition
+   */
+  void remove(Condition& condition);
+
+  /**
+   * Validates all conditions once. Skips the tick, if a condition is being 
+   * added or removed at the same time.
+   */
+  virtual void run() override;
+
+  /**
+   * @return - number of conditions
+   */
+  std::size_t size();
+
+  /**
+   * @return - number of validations since creation
+   */
+  uint64_t getNofValidations() const;
+
+ private:
+  std::mutex mtx;
+  std::vector<Condition*> conditions;
+  std::atomic<uint64_t> nofValidations;
+};
+
+} // namespace sequencer
+} // namespace eeros
+
+#endif // ORG_EEROS_SEQUENCER_CONDITIONSCHEDULER_HPP_
@@ -2,11 +2,17 @@
 #define ORG_EEROS_SEQUENCER_CONDITIONTIMEOUT_HPP_
 
 #include <eeros/sequencer/Condition.hpp>
+#include <eeros/sequencer/DeadlineTimer.hpp>
 #include <chrono>
 
 namespace eeros {
 	namespace sequencer {
 		
+		/**
+		 * Condition which becomes true when the timeout has passed since the last
+		 * reset. The deadline is registered with the \ref DeadlineTimer, which
+		 * wakes the sequences when it passes, so no polling is needed.
+		 */
 		class ConditionTimeout : public Condition {
 		public:
 			ConditionTimeout() : timeout(0) { }
@@ -17,19 +23,17 @@ namespace eeros {
 					resetTimeout();
 					return false;
 				}
-				auto now = std::chrono::steady_clock::now();
-				auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime);
-				return (duration.count() > timeout * 1000);
+				return std::chrono::steady_clock::now() >= deadline;
 			};
 			
 			void setTimeoutTime(double timeInSec) {timeout = timeInSec;}	// 0 = not set or infinite
 			void resetTimeout() {
 				started = true;
-				startTime = std::chrono::steady_clock::now();
+				if (timeout > 0) deadline = DeadlineTimer::instance().schedule(timeout);
 			}
 		private:
 			bool started = false;			
-			std::chrono::steady_clock::time_point startTime;
+			std::chrono::steady_clock::time_point deadline;
 			double timeout;	// 0 = not set or infinite, in seconds
 		};
 		
@@ -0,0 +1,78 @@
+#ifndef ORG_EEROS_SEQUENCER_DEADLINETIMER_HPP_
+#define ORG_EEROS_SEQUENCER_DEADLINETIMER_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <set>
+
+namespace eeros {
+namespace sequencer {
+
+/**
+ * Central timer of the sequencer. Waits and timeouts register their deadline,
+ * the timer thread sleeps until the earliest one and then calls
+ * \ref Condition::notify() once, which wakes the waiting sequences to check
+ * their conditions. A sequence waiting for several seconds therefore does not
+ * have to poll for its deadline, see BaseSequence::setPollingTime().
+ *
+ * The thread is started with the first deadline and is never stopped.
+ *
+ * @since v1.4.4
+ */
+class DeadlineTimer {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * Returns the timer of the application.
+   *
+   * @return timer
+   */
+  static DeadlineTimer& instance();
+
+  /**
+   * Notifies the waiting sequences once the deadline has passed. A deadline
+   * which is registered several times notifies once.
+   *
+   * @param deadline - deadline
+   */
+  void schedule(Clock::time_point deadline);
+
+  /**
+   * Notifies the waiting sequences after a delay from now.
+   *
+   * @param delay - delay in sec
+   * @return deadline
+   */
+  Clock::time_point schedule(double delay);
+
+  /**
+   * @return number of deadlines not passed yet
+   */
+  std::size_t size();
+
+  /**
+   * @return number of notifications since creation
+   */
+  uint64_t getNofNotifications();
+
+  DeadlineTimer(const DeadlineTimer&) = delete;
+  DeadlineTimer& operator=(const DeadlineTimer&) = delete;
+
+ private:
+  DeadlineTimer();
+  void run();
+
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::set<Clock::time_point> deadlines;
+  uint64_t nofNotifications = 0;
+  bool started = false;
+};
+
+} // namespace sequencer
+} // namespace eeros
+
+#endif // ORG_EEROS_SEQUENCER_DEADLINETIMER_HPP_
@@ -20,6 +20,7 @@ class Sequencer;
  */
 class Sequence : public BaseSequence {
   friend class Sequencer;
+  friend class SequencePool;
  public:
   /**
    * Constructs a main sequence instance with a name and a reference to
@@ -39,7 +40,8 @@ class Sequence : public BaseSequence {
    * the calling sequence. You can also choose whether it should block or not. 
    * A blocking sequence blocks its calling sequence so that no more steps in the calling 
    * sequence will execute as long as this sequence runs. A non blocking sequence starts
-   * a new thread and runs in parallel to the calling sequence.
+   * a new thread, or a task of the thread pool of the sequencer, see \ref Sequencer::useThreadPool,
+   * and runs in parallel to the calling sequence.
    * 
    * @param name - name of the step
    * @param caller - calling sequence
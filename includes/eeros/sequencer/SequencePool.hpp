@@ -0,0 +1,102 @@
+#ifndef ORG_EEROS_SEQUENCER_SEQUENCEPOOL_HPP_
+#define ORG_EEROS_SEQUENCER_SEQUENCEPOOL_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace eeros {
+namespace sequencer {
+
+class Sequence;
+
+/**
+ * Runs non blocking sequences as cooperative tasks on a small number of threads,
+ * instead of one thread per sequence, see \ref Sequencer::useThreadPool.
+ * Each task has its own stack, of which only the touched pages use memory.
+ * A task gives up its thread whenever its sequence waits for an exit 
+ * condition, a monitor, the next step command or another sequence. It is resumed
+ * when \ref Condition::notify() is called or its polling time has expired.
+ * A task always stays on the thread it was started on.
+ * 
+ * The action of a sequence running on the pool must not block, as this would
+ * also block all other tasks of the same thread.
+ * 
+ * @since v1.4.4
+ */
+class SequencePool {
+ public:
+  /**
+   * Creates a pool and starts its threads.
+   * 
+   * @param nofThreads - number of threads
+   * @param stackSize - stack size of each task in bytes
+   */
+  SequencePool(int nofThreads, std::size_t stackSize);
+
+  /**
+   * Stops the threads. Tasks which have not finished are discarded, so all
+   * sequences should be terminated beforehand.
+   */
+  ~SequencePool();
+
+  SequencePool(const SequencePool&) = delete;
+  SequencePool& operator=(const SequencePool&) = delete;
+
+  /**
+   * Starts a sequence as new task.
+   * 
+   * @param sequence - non blocking sequence
+   * @return - result of the sequence
+   */
+  std::future<int> start(Sequence& sequence);
+
+  /**
+   * @return - number of tasks which have not finished yet
+   */
+  int getNofTasks() const;
+
+  /**
+   * @return - true, if called from a task of a pool
+   */
+  static bool inTask();
+
+  /**
+   * Waits for \ref Condition::notify() after the given generation of the condition
+   * event was taken, or for the timeout. In a task, its thread runs other tasks in 
+   * the meantime, else the calling thread blocks.
+   * 
+   * @param generation - generation of the condition event
+   * @param timeout_sec - timeout in sec
+   */
+  static void wait(uint32_t generation, double timeout_sec);
+
+  /**
+   * Waits until a result is ready, in a task without blocking its thread.
+   * 
+   * @param result - result of a sequence
+   */
+  static void await(std::future<int>& result);
+
+ private:
+  struct Task;
+  struct Worker;
+  static void entry();
+  void run(Worker& worker);
+
+  static thread_local Task* current;  // task running on this thread
+
+  std::size_t stackSize;
+  std::vector<std::unique_ptr<Worker>> workers;
+  std::atomic<unsigned> nextWorker;
+  std::atomic<int> nofTasks;
+  std::atomic<bool> running;
+};
+
+} // namespace sequencer
+} // namespace eeros
+
+#endif // ORG_EEROS_SEQUENCER_SEQUENCEPOOL_HPP_
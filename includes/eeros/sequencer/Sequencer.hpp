@@ -4,14 +4,19 @@
 #include <eeros/logger/Logger.hpp>
 #include <thread>
 #include <vector>
+#include <string>
+#include <unordered_map>
 #include <atomic>
 #include <memory>
+#include <cstddef>
+#include <cstdint>
 
 namespace eeros {
 namespace sequencer {
 
 class Sequence;
 class SequencerUI;
+class SequencePool;
 
 /**
  * The sequencer keeps a list of all \ref Sequence. It allows to abort all running sequences
@@ -37,7 +42,7 @@ class Sequencer {
   
   /**
    * Every registered sequence has a unique identifier. This function returns the sequence 
-   * with a given identifier
+   * with a given identifier in constant time.
    * 
    * @param id - id of a sequence
    * @return - sequence with this id
@@ -46,19 +51,20 @@ class Sequencer {
 
   /**
    * Every registered sequence has a unique name. This function returns the sequence 
-   * with a given name
+   * with a given name, looked up in a hash table.
    * 
-   * @param name - id of a sequence
+   * @param name - name of a sequence
    * @return - sequence with this name
    */
-  Sequence* getSequenceByName(std::string name);
+  Sequence* getSequenceByName(const std::string& name);
 
   /**
-   * Returns a vector containing all registered sequences.
+   * Returns a vector containing all registered sequences, ordered by their id.
+   * The reference stays valid, but sequences created meanwhile change its content.
    * 
    * @return - vector with all registered sequences
    */
-  std::vector<Sequence*> getListOfAllSequences();
+  const std::vector<Sequence*>& getListOfAllSequences() const;
   
   /**
    * Clears the list with all sequences
@@ -83,6 +89,18 @@ class Sequencer {
    * debugging purposes, E.g. upon entering a given sequence. 
    */
   void singleStepping();
+
+  /**
+   * By default, each non blocking sequence runs in its own thread. With a thread pool,
+   * non blocking sequences started afterwards run as cooperative tasks on a few threads,
+   * see \ref SequencePool. This allows for many concurrent sequences with little memory
+   * and few context switches, as long as their actions do not block.
+   * Call this only while no sequence is running.
+   * 
+   * @param nofThreads - number of threads, 0 for one thread per sequence
+   * @param stackSize - stack size of each sequence in bytes
+   */
+  void useThreadPool(int nofThreads, std::size_t stackSize = 256 * 1024);
   
   /**
    * State of the sequencer, set to true upon creation. Aborting the sequencer will 
@@ -90,17 +108,28 @@ class Sequencer {
    */
   static std::atomic<bool> running;
 
+  /**
+   * Counts the changes of the state of any sequence. A user interface compares it
+   * with its last value and only reads the states of the sequences if it changed.
+   *
+   * @see BaseSequence::getState()
+   */
+  static std::atomic<uint64_t> stateChanges;
+
  private:
   Sequencer();
+  ~Sequencer();
   void addSequence(Sequence& seq);
   void step();
   void restart();
   Sequence* mainSequence;
-  std::vector<Sequence*> sequenceList;	// list of all sequences
+  std::vector<Sequence*> sequenceList;	// list of all sequences, indexed by id
+  std::unordered_map<std::string, Sequence*> sequenceNames;
   logger::Logger log;	
   std::atomic<bool> stepping;
   volatile std::atomic<bool> nextStep;
   SequencerUI ui;
+  std::unique_ptr<SequencePool> pool;
   static int sequenceCount;
 };
 
@@ -2,12 +2,16 @@
 #define ORG_EEROS_SEQUENCER_WAIT_HPP_
 
 #include <eeros/sequencer/Step.hpp>
+#include <eeros/sequencer/DeadlineTimer.hpp>
 
 namespace eeros {
 namespace sequencer {
 
 /**
  * This is a special \ref Step which simply wait for a given time.
+ * The end of the wait is registered with the \ref DeadlineTimer, which wakes
+ * the step when it is reached. The step checks the monitors with the polling 
+ * time of its caller, with polling disabled it sleeps until the deadline.
  * 
  * @since v1.0
  */
@@ -20,7 +24,9 @@ public:
    * @param name - name of the step
    * @param caller - calling sequence
    */
-  Wait(std::string name, BaseSequence* caller) : Step(name, caller) { }
+  Wait(std::string name, BaseSequence* caller) : Step(name, caller) {
+    if (caller != nullptr) setPollingTime(caller->getPollingTime());
+  }
 
   /**
    * Disabling use of copy constructor because a Step should never be copied unintentionally.
@@ -35,10 +41,10 @@ public:
   int operator() (double waitingTime) {this->waitingTime = waitingTime; return start();}
  
  private:
-  int action() {time = std::chrono::steady_clock::now(); return 0;}
-  bool checkExitCondition() {return ((std::chrono::duration<double>)(std::chrono::steady_clock::now() - time)).count() > waitingTime;}
+  int action() {deadline = DeadlineTimer::instance().schedule(waitingTime); return 0;}
+  bool checkExitCondition() {return std::chrono::steady_clock::now() >= deadline;}
   
-  std::chrono::time_point<std::chrono::steady_clock> time;
+  DeadlineTimer::Clock::time_point deadline;
   double waitingTime;
 };
 
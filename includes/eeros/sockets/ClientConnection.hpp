@@ -0,0 +1,111 @@
+#ifndef ORG_EEROS_SOCKETS_CLIENTCONNECTION_HPP_
+#define ORG_EEROS_SOCKETS_CLIENTCONNECTION_HPP_
+
+#include <eeros/sockets/FrameAssembler.hpp>
+#include <eeros/sockets/SocketOptions.hpp>
+#include <eeros/logger/Logger.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace eeros {
+namespace sockets {
+
+/**
+ * The TCP connection of a \ref SocketClient. The socket is non blocking and is
+ * waited for with one epoll_wait() together with a timer which ticks once per
+ * period and an eventfd, which another thread may signal with wake() to have 
+ * new data sent at once. Received frames of a fixed size are reassembled, all
+ * pending frames are read, so the newest one is delivered without delay.
+ *
+ * @since v1.4.4
+ */
+class ClientConnection {
+ public:
+  /**
+   * Prepares the connection, connect() establishes it.
+   *
+   * @param serverIP - address of the server
+   * @param port - TCP port of the server
+   * @param rxFrameSize - size of a frame sent by the server in bytes, 0 if it sends nothing
+   * @param period - period of the timer in s
+   * @param timeout - time in s after which the connection is closed if no frame arrived
+   * @param options - socket options
+   */
+  ClientConnection(std::string serverIP, uint16_t port, std::size_t rxFrameSize, double period, double timeout,
+                   const SocketOptions& options = SocketOptions());
+  ~ClientConnection();
+
+  ClientConnection(const ClientConnection&) = delete;
+  ClientConnection& operator=(const ClientConnection&) = delete;
+
+  /**
+   * Tries to connect to the server, waits at most for the timeout.
+   *
+   * @return true, if connected
+   */
+  bool connect();
+
+  /**
+   * Waits for the next tick of the timer or a call to wake(). Meanwhile received 
+   * frames are passed to onFrame. If the server closes the connection or does 
+   * not send within the timeout, the connection is closed.
+   *
+   * @param onFrame - called for every complete frame received
+   * @return whether the timer ticked or wake() was called
+   */
+  PollResult poll(const std::function<void(const uint8_t*)>& onFrame);
+
+  /**
+   * Sends a frame. If the socket does not take it at once, waits at most for the timeout.
+   *
+   * @param data - frame
+   * @param length - length of the frame in bytes
+   * @return false, if the connection broke
+   */
+  bool send(const void* data, std::size_t length);
+
+  /**
+   * Wakes up poll(), may be called from any thread.
+   */
+  void wake();
+
+  /**
+   * Sets how the frames sent by the server are delimited, by default they have the 
+   * fixed size rxFrameSize.
+   *
+   * @param framing - reassembly of the frames
+   */
+  void setFraming(const FrameAssembler& framing);
+
+  /**
+   * @return true, if connected
+   */
+  bool isConnected() const;
+
+ private:
+  void close();
+  void receive(const std::function<void(const uint8_t*)>& onFrame);
+
+  std::string serverIP;
+  uint16_t port;
+  std::size_t rxFrameSize;
+  std::chrono::steady_clock::duration timeout;
+  SocketOptions options;
+  int fd = -1;
+  int epollFd;
+  int timerFd;
+  int wakeFd;
+  FrameAssembler rx;
+  uint8_t discard[256];
+  std::chrono::steady_clock::time_point lastFrame;
+  logger::Logger log;
+};
+
+}
+}
+
+#endif // ORG_EEROS_SOCKETS_CLIENTCONNECTION_HPP_
@@ -0,0 +1,154 @@
+#ifndef ORG_EEROS_SOCKETS_DATAGRAMLINK_HPP_
+#define ORG_EEROS_SOCKETS_DATAGRAMLINK_HPP_
+
+#include <eeros/core/SeqlockBuffer.hpp>
+#include <eeros/sockets/SocketOptions.hpp>
+#include <eeros/logger/Logger.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include <netinet/in.h>
+
+namespace eeros {
+namespace sockets {
+
+/**
+ * Transport used by \ref SocketServer and \ref SocketClient. With multicast a
+ * client publishes to a group address and any number of clients subscribe to it.
+ */
+enum class Protocol { tcp, udp, multicast };
+
+/**
+ * Counters of a \ref DatagramLink.
+ */
+struct DatagramStatistics {
+  uint64_t received = 0;    // datagrams accepted
+  uint64_t lost = 0;        // gaps in the sequence numbers, includes datagrams which arrive too late
+  uint64_t reordered = 0;   // datagrams older than the newest one, they are discarded
+  uint64_t invalid = 0;     // datagrams of a wrong size or with a wrong header
+  uint32_t sequence = 0;    // sequence number of the newest datagram
+  uint64_t timestamp = 0;   // time the newest datagram was sent, in the time base of the sender
+};
+
+/**
+ * A point to point link which carries one datagram per period. Each datagram starts
+ * with a header holding a sequence number and the time it was sent, followed by the
+ * payload of a fixed size. The receiver keeps only the newest datagram, older ones
+ * are counted as reordered and discarded, gaps are counted as lost. For cyclic
+ * control data freshness matters more than reliability, a lost datagram is replaced
+ * by the next one instead of being retransmitted.
+ *
+ * The server side binds to a port and sends to the peer it received from last,
+ * the client side sends to the given address. Both send every period, even if
+ * there is no payload, so that the server learns the address of the client.
+ *
+ * A multicast link carries data in one direction only. A publisher, which 
+ * receives no payload, sends to a group address once per period, independent
+ * of the number of subscribers. A subscriber joins the group and only receives.
+ *
+ * @since v1.4.4
+ */
+class DatagramLink {
+ public:
+  static constexpr uint32_t magic = 0x45455544;   // "EEUD"
+
+  struct Header {
+    uint32_t magic;
+    uint32_t sequence;
+    uint64_t timestamp;
+  };
+
+  /**
+   * Opens the socket.
+   *
+   * @param peer - address of the server, empty for the server side
+   * @param port - UDP port of the server, 0 selects a free port on the server side, see getPort()
+   * @param rxPayloadSize - size of the payload received in bytes
+   * @param period - period of the timer in s
+   * @param timeout - time in s without a datagram after which the link is disconnected
+   * @param options - socket options
+   * @param multicast - peer is a multicast group, publish to it if rxPayloadSize is 0, else subscribe to it
+   */
+  DatagramLink(std::string peer, uint16_t port, std::size_t rxPayloadSize, double period, double timeout,
+               const SocketOptions& options = SocketOptions(), bool multicast = false);
+  ~DatagramLink();
+
+  DatagramLink(const DatagramLink&) = delete;
+  DatagramLink& operator=(const DatagramLink&) = delete;
+
+  /**
+   * Waits for the next tick of the timer or a call to wake(). All datagrams which 
+   * arrive meanwhile are read, the payload of the newest one is passed to onPayload.
+   *
+   * @param onPayload - called with the newest payload received
+   * @return whether the timer ticked or wake() was called
+   */
+  PollResult poll(const std::function<void(const uint8_t*)>& onPayload);
+
+  /**
+   * Wakes up poll(), may be called from any thread.
+   */
+  void wake();
+
+  /**
+   * Sends a datagram with the next sequence number.
+   *
+   * @param payload - payload
+   * @param length - length of the payload in bytes
+   */
+  void send(const void* payload, std::size_t length);
+
+  /**
+   * @return true, if a datagram was received within the timeout, always true for a multicast publisher
+   */
+  bool isConnected() const;
+
+  /**
+   * Reads the counters, may be called from any thread.
+   *
+   * @return counters
+   */
+  DatagramStatistics getStatistics() const;
+
+  /**
+   * @return local port of the socket
+   */
+  uint16_t getPort() const;
+
+ private:
+  static constexpr int batchSize = 8;   // datagrams read with one recvmmsg()
+
+  bool accept(const Header& h, const sockaddr_in& from);
+  void joinGroup(uint16_t port, const SocketOptions& options);
+
+  int fd;
+  int epollFd;
+  int timerFd;
+  int wakeFd;
+  bool server;
+  bool multicast;
+  bool receiving;
+  std::size_t rxPayloadSize;
+  std::chrono::steady_clock::duration timeout;
+  sockaddr_in peerAddr{};
+  bool peerKnown = false;
+  sockaddr_in sourceAddr{};
+  bool sourceKnown = false;
+  bool first = true;
+  uint32_t txSequence = 0;
+  std::chrono::steady_clock::time_point lastReceived;
+  std::atomic<bool> connected{false};
+  std::vector<uint8_t> rx, newest;
+  DatagramStatistics stats;
+  SeqlockBuffer<DatagramStatistics> published;
+  logger::Logger log;
+};
+
+}
+}
+
+#endif // ORG_EEROS_SOCKETS_DATAGRAMLINK_HPP_
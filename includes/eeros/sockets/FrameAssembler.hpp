@@ -0,0 +1,97 @@
+#ifndef ORG_EEROS_SOCKETS_FRAMEASSEMBLER_HPP_
+#define ORG_EEROS_SOCKETS_FRAMEASSEMBLER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace eeros {
+namespace sockets {
+
+/**
+ * Reassembles the frames of a TCP stream. Frames either have a fixed size, or 
+ * start with a header of a fixed size from which the size of the whole frame
+ * is read, see \ref Message. The stream is received directly into the buffer 
+ * returned by next(), which has room for one frame and some more bytes, so that
+ * one recv() usually takes all frames queued in the socket. pop() then returns 
+ * them one after the other without copying them.
+ *
+ * @since v1.4.4
+ */
+class FrameAssembler {
+ public:
+  enum class State { partial, complete, invalid };
+
+  /**
+   * Frames of a fixed size.
+   *
+   * @param frameSize - size of a frame in bytes
+   */
+  explicit FrameAssembler(std::size_t frameSize = 0);
+
+  /**
+   * Frames of a variable size.
+   *
+   * @param headerSize - size of the header in bytes
+   * @param maxFrameSize - maximum size of a frame including the header
+   * @param frameSize - returns the size of the frame including the header, given the header
+   */
+  FrameAssembler(std::size_t headerSize, std::size_t maxFrameSize, std::function<std::size_t(const uint8_t*)> frameSize);
+
+  /**
+   * Makes room for more data, frames returned by pop() are no longer valid afterwards.
+   *
+   * @param length - set to the number of bytes which may be received
+   * @return where to receive the next bytes to
+   */
+  uint8_t* next(std::size_t& length);
+
+  /**
+   * Accounts for n bytes received into the buffer returned by next().
+   *
+   * @param n - number of bytes received
+   */
+  void received(std::size_t n);
+
+  /**
+   * Takes the next frame received.
+   *
+   * @return complete, if frame() holds the next frame, partial, if more data is
+   *         needed, invalid, if a header announces a frame which does not fit, 
+   *         the stream is then out of sync
+   */
+  State pop();
+
+  /**
+   * @return the frame taken by the last call to pop()
+   */
+  const uint8_t* frame() const;
+
+  /**
+   * @return size of the frame taken by the last call to pop()
+   */
+  std::size_t getFrameSize() const;
+
+  /**
+   * Discards all data received, e.g. when the connection is reestablished.
+   */
+  void reset();
+
+ private:
+  static constexpr std::size_t batchSize = 4096;   // room for more frames behind a complete one
+
+  std::size_t headerSize;
+  std::size_t maxFrameSize;
+  std::function<std::size_t(const uint8_t*)> frameSize;
+  std::vector<uint8_t> buffer;
+  std::size_t begin = 0;       // start of the first frame not yet taken
+  std::size_t end = 0;         // end of the data received
+  std::size_t current = 0;     // start of the frame taken last
+  std::size_t completed = 0;
+};
+
+}
+}
+
+#endif // ORG_EEROS_SOCKETS_FRAMEASSEMBLER_HPP_
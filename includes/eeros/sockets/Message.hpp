@@ -0,0 +1,190 @@
+#ifndef ORG_EEROS_SOCKETS_MESSAGE_HPP_
+#define ORG_EEROS_SOCKETS_MESSAGE_HPP_
+
+#include <eeros/sockets/FrameAssembler.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace eeros {
+namespace sockets {
+
+/**
+ * Element type of a field of a \ref MessageSchema.
+ */
+enum class FieldType : uint8_t { boolean, int8, uint8, int16, uint16, int32, uint32, int64, uint64, float32, float64 };
+
+/**
+ * Returns the field type of an arithmetic type.
+ *
+ * @tparam T - arithmetic type
+ * @return field type
+ */
+template < typename T >
+constexpr FieldType fieldTypeOf() {
+  static_assert(std::is_arithmetic<T>::value, "message fields must consist of arithmetic types");
+  if constexpr (std::is_same<T, bool>::value) return FieldType::boolean;
+  else if constexpr (std::is_floating_point<T>::value) return sizeof(T) == 4 ? FieldType::float32 : FieldType::float64;
+  else if constexpr (std::is_signed<T>::value) {
+    if constexpr (sizeof(T) == 1) return FieldType::int8;
+    else if constexpr (sizeof(T) == 2) return FieldType::int16;
+    else if constexpr (sizeof(T) == 4) return FieldType::int32;
+    else return FieldType::int64;
+  } else {
+    if constexpr (sizeof(T) == 1) return FieldType::uint8;
+    else if constexpr (sizeof(T) == 2) return FieldType::uint16;
+    else if constexpr (sizeof(T) == 4) return FieldType::uint32;
+    else return FieldType::uint64;
+  }
+}
+
+/**
+ * A named field of a \ref MessageSchema, an array of count elements.
+ */
+struct MessageField {
+  std::string name;
+  FieldType type;
+  uint32_t count;
+  std::size_t offset;   // in the payload in bytes
+};
+
+/**
+ * Describes the payload of a \ref Message as a sequence of named fields. The fields 
+ * are packed without padding in the order they were added. Both peers must describe
+ * the same fields, the id of the schema, a hash of the names, types and counts of 
+ * all fields, is sent with every message, so that messages of a different schema 
+ * are recognized and rejected.
+ *
+ * @since v1.4.4
+ */
+class MessageSchema {
+ public:
+  /**
+   * Appends a field.
+   *
+   * @param name - name of the field
+   * @param type - element type
+   * @param count - number of elements
+   * @return offset of the field in the payload in bytes
+   */
+  std::size_t add(const std::string& name, FieldType type, uint32_t count = 1);
+
+  /**
+   * Appends a field of elements of type T.
+   *
+   * @tparam T - arithmetic element type
+   * @param name - name of the field
+   * @param count - number of elements
+   * @return offset of the field in the payload in bytes
+   */
+  template < typename T >
+  std::size_t add(const std::string& name, uint32_t count = 1) {
+    return add(name, fieldTypeOf<T>(), count);
+  }
+
+  /**
+   * @return field with the given name, nullptr if there is none
+   */
+  const MessageField* find(const std::string& name) const;
+
+  /**
+   * @return all fields in the order they were added
+   */
+  const std::vector<MessageField>& getFields() const;
+
+  /**
+   * @return size of the payload in bytes
+   */
+  std::size_t getPayloadSize() const;
+
+  /**
+   * @return id of the schema
+   */
+  uint32_t getId() const;
+
+  /**
+   * @return size of an element of the given type in bytes
+   */
+  static std::size_t sizeOf(FieldType type);
+
+ private:
+  std::vector<MessageField> fields;
+  std::size_t size = 0;
+  uint32_t id = 2166136261u;   // FNV-1a offset basis
+};
+
+/**
+ * Header of a message, sent in the native byte order like the data of \ref SocketData.
+ */
+struct MessageHeader {
+  uint32_t magic;
+  uint32_t schema;      // id of the schema of the payload
+  uint32_t length;      // size of the payload in bytes
+  uint32_t sequence;    // incremented by the sender with every message
+  uint64_t timestamp;   // time the message was sent in ns, in the time base of the sender
+};
+
+/**
+ * Framing of variable-length messages on a TCP stream. Each message consists of 
+ * a \ref MessageHeader followed by a payload described by a \ref MessageSchema.
+ * The length in the header delimits the messages, so a receiver can skip 
+ * messages of a schema it does not know without losing the synchronization.
+ *
+ * @since v1.4.4
+ */
+class Message {
+ public:
+  static constexpr uint32_t magic = 0x4545534D;   // "EESM"
+  static constexpr std::size_t maxPayloadSize = 65536;
+
+  /**
+   * Writes the header of a message in front of its payload.
+   *
+   * @param frame - message, at least sizeof(MessageHeader) plus the payload size of the schema
+   * @param schema - schema of the payload
+   * @param sequence - sequence number
+   * @param timestamp - time in ns
+   */
+  static void writeHeader(uint8_t* frame, const MessageSchema& schema, uint32_t sequence, uint64_t timestamp);
+
+  /**
+   * Reads the header of a message.
+   *
+   * @param frame - message
+   * @return header
+   */
+  static MessageHeader readHeader(const uint8_t* frame);
+
+  /**
+   * Returns the size of a message including its header, given its header.
+   *
+   * @param header - header of the message
+   * @return size, 0 if the header is not valid
+   */
+  static std::size_t frameSize(const uint8_t* header);
+
+  /**
+   * Checks whether a message has the given schema.
+   *
+   * @param frame - received message
+   * @param schema - expected schema
+   * @return true, if magic, schema id and length match
+   */
+  static bool matches(const uint8_t* frame, const MessageSchema& schema);
+
+  /**
+   * Returns the reassembly of messages with payloads up to the given size, but at
+   * least maxPayloadSize, so that messages of other schemas can be skipped.
+   *
+   * @param payloadSize - size of the expected payload in bytes
+   * @return reassembly for \ref ServerConnections::setFraming() or \ref ClientConnection::setFraming()
+   */
+  static FrameAssembler framing(std::size_t payloadSize);
+};
+
+}
+}
+
+#endif // ORG_EEROS_SOCKETS_MESSAGE_HPP_
@@ -0,0 +1,127 @@
+#ifndef ORG_EEROS_SOCKETS_SERVERCONNECTIONS_HPP_
+#define ORG_EEROS_SOCKETS_SERVERCONNECTIONS_HPP_
+
+#include <eeros/sockets/FrameAssembler.hpp>
+#include <eeros/sockets/SocketOptions.hpp>
+#include <eeros/logger/Logger.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace eeros {
+namespace sockets {
+
+/**
+ * The connections of a \ref SocketServer. It listens on a TCP port and serves
+ * several clients from a single thread. All sockets are non blocking and are
+ * waited for with one epoll_wait() together with a timer which ticks once per
+ * period. Each client has its own receive buffer, in which frames of a fixed
+ * size are reassembled, and its own send buffer, which holds the rest of a
+ * frame the socket did not accept at once. A slow client skips frames instead
+ * of delaying the others. Another thread may wake up the waiting thread with
+ * wake(), e.g. to send new data at once.
+ *
+ * @since v1.4.4
+ */
+class ServerConnections {
+ public:
+  /**
+   * Opens the listening socket.
+   *
+   * @param port - TCP port, 0 selects a free port, see getPort()
+   * @param rxFrameSize - size of a frame sent by the clients in bytes, 0 if clients send nothing
+   * @param period - period of the timer in s
+   * @param timeout - time in s after which a client which did not send a frame is dropped
+   * @param maxClients - maximum number of clients connected at the same time
+   * @param options - options applied to the socket of every client
+   */
+  ServerConnections(uint16_t port, std::size_t rxFrameSize, double period, double timeout, int maxClients = 8, 
+                    const SocketOptions& options = SocketOptions());
+  ~ServerConnections();
+
+  ServerConnections(const ServerConnections&) = delete;
+  ServerConnections& operator=(const ServerConnections&) = delete;
+
+  /**
+   * Waits for the next tick of the timer or a call to wake(). Meanwhile new clients 
+   * are accepted, buffered data is sent and received frames are passed to onFrame.
+   *
+   * @param onFrame - called for every complete frame received from any client
+   * @return whether the timer ticked or wake() was called
+   */
+  PollResult poll(const std::function<void(const uint8_t*)>& onFrame);
+
+  /**
+   * Wakes up poll(), may be called from any thread.
+   */
+  void wake();
+
+  /**
+   * Sets how the frames sent by the clients are delimited, by default they have the 
+   * fixed size rxFrameSize. Takes effect for clients connecting afterwards.
+   *
+   * @param framing - prototype of the reassembly of each client
+   */
+  void setFraming(const FrameAssembler& framing);
+
+  /**
+   * Sends a frame to all clients. A client which has not yet taken the
+   * previous frame completely skips this one.
+   *
+   * @param data - frame
+   * @param length - length of the frame in bytes
+   */
+  void broadcast(const void* data, std::size_t length);
+
+  /**
+   * @return number of connected clients
+   */
+  int getNofClients() const;
+
+  /**
+   * @return port the server listens on
+   */
+  uint16_t getPort() const;
+
+  /**
+   * @return number of frames skipped because a client was too slow
+   */
+  uint64_t getSkipped() const;
+
+ private:
+  struct Client {
+    FrameAssembler rx;
+    std::vector<uint8_t> tx;
+    std::size_t txOffset = 0;
+    std::chrono::steady_clock::time_point lastFrame;
+  };
+
+  void accept();
+  void receive(int fd, Client& c, const std::function<void(const uint8_t*)>& onFrame);
+  void flush(int fd, Client& c);
+  void watch(int fd, bool output);
+  void drop(int fd);
+  void dropIdle();
+
+  int listenFd;
+  int epollFd;
+  int timerFd;
+  int wakeFd;
+  SocketOptions options;
+  std::size_t rxFrameSize;
+  FrameAssembler framing;
+  std::chrono::steady_clock::duration timeout;
+  int maxClients;
+  uint16_t port;
+  uint64_t skipped = 0;
+  std::map<int, Client> clients;
+  logger::Logger log;
+};
+
+}
+}
+
+#endif // ORG_EEROS_SOCKETS_SERVERCONNECTIONS_HPP_
@@ -1,35 +1,73 @@
 #ifndef ORG_EEROS_SOCKET_CLIENT_HPP_
 #define ORG_EEROS_SOCKET_CLIENT_HPP_
 
-#include <eeros/core/Thread.hpp>
+#include <eeros/sockets/ClientConnection.hpp>
+#include <eeros/sockets/DatagramLink.hpp>
+#include <eeros/sockets/SocketOptions.hpp>
+#include <eeros/logger/Logger.hpp>
 #include <array>
-#include <unistd.h>
-#include <netdb.h> 
-#include <arpa/inet.h> 		/* inet_ntoa() to format IP address */
-#include <string.h>
-#include <sys/socket.h>
-#include <fcntl.h>
+#include <atomic>
 #include <eeros/core/Fault.hpp>
-#include <iostream>
+#include <eeros/core/System.hpp>
+#include <eeros/core/TripleBuffer.hpp>
 #include <cstring>
 #include <signal.h>
-#include <mutex>
+#include <memory>
+#include <thread>
 
 namespace eeros {
 namespace sockets {
 
+void sigPipeHandler(int signum);
+bool setThreadPriority(int priority);
+
+/**
+ * A client which sends an array of inT to its server and receives an array of outT 
+ * from it once per period. The connection is reestablished when it breaks.
+ * With \ref Protocol::udp one datagram is exchanged per period instead of using
+ * a TCP connection, see \ref DatagramLink.
+ * With \ref SocketOptions::sendOnUpdate the thread is woken up by setSendBuffer()
+ * and sends the new data at once. Data is passed between the threads without locks.
+ *
+ * @tparam BufInLen - number of elements sent
+ * @tparam inT - type of the elements sent
+ * @tparam BufOutLen - number of elements received
+ * @tparam outT - type of the elements received
+ * @since v1.0
+ */
 template < uint32_t BufInLen, typename inT, uint32_t BufOutLen, typename outT >
-class SocketClient : public eeros::Thread {
+class SocketClient {
  public:
-  SocketClient(std::string serverIP, uint16_t port, double period = 0.01, double timeout = 1.0, int priority = 5) 
-      : Thread(priority), serverIP(serverIP), port(port), period(period), timeout(timeout) {
+  /**
+   * Starts the thread, which connects to the server.
+   *
+   * @param serverIP - address of the server
+   * @param port - port number
+   * @param period - period in s in which data is sent to the server
+   * @param timeout - time in s after which the connection is considered broken
+   * @param priority - realtime priority of the thread
+   * @param protocol - transport
+   * @param options - socket options
+   */
+  SocketClient(std::string serverIP, uint16_t port, double period = 0.01, double timeout = 1.0, int priority = 5, 
+               Protocol protocol = Protocol::tcp, SocketOptions options = SocketOptions()) 
+      : serverIP(serverIP), port(port), period(period), timeout(timeout), options(options), log(logger::Logger::getLogger()) {
     signal(SIGPIPE, sigPipeHandler);	// make sure, that a broken pipe does not stop application
-    running = false;
+    if (protocol == Protocol::multicast && BufInLen > 0 && BufOutLen > 0) throw Fault("multicast carries data in one direction only");
+    if (protocol != Protocol::tcp) 
+      link.reset(new DatagramLink(serverIP, port, BufOutLen * sizeof(outT), period, timeout, options, protocol == Protocol::multicast));
+    else stream.reset(new ClientConnection(serverIP, port, BufOutLen * sizeof(outT), period, timeout, options));
+    running = true;
     connected = false;
+    thread = std::thread([this, priority]() {
+      if (!setThreadPriority(priority)) log.error() << "could not set realtime priority";
+      run();
+    });
   }
   
   virtual ~SocketClient() {
-    join();
+    running = false;
+    if (thread.joinable()) thread.join();
   }
   
   virtual void stop() {
@@ -44,115 +82,122 @@ class SocketClient : public eeros::Thread {
     return connected;
   }
   
-  virtual std::array<outT, BufOutLen>& getReceiveBuffer() {
-    std::lock_guard<std::mutex> lock(mtx);
-    return rxBuf;
+  /**
+   * Returns a view of the latest received data, which stays valid until the next call.
+   * Must only be called by a single reader, usually the control loop.
+   */
+  virtual const std::array<outT, BufOutLen>& getReceiveBuffer() {
+    return rxBuf.read();
   }
   
+  /**
+   * Returns the counters of received datagrams, UDP only.
+   */
+  virtual DatagramStatistics getStatistics() {
+    return link ? link->getStatistics() : DatagramStatistics();
+  }
+  
+  /**
+   * Sets the data sent next. Must only be called by a single writer, usually the control loop.
+   */
   virtual void setSendBuffer(std::array<inT, BufInLen>& data) {
-    std::lock_guard<std::mutex> lock(mtx);
-    txBuf = data;
+    txBuf.write(data);
+    if (options.sendOnUpdate) {
+      if (link) link->wake(); else stream->wake();
+    }
   }
 
-  bool newData = false;
+  /**
+   * Returns the number of times the receive buffer was updated, a new frame or
+   * the buffer cleared after the connection broke.
+   */
+  virtual uint64_t getSequence() {
+    return sequence.load(std::memory_order_acquire);
+  }
+
+  /**
+   * Returns the time the latest datagram or frame was received, in the time base of
+   * System::getTimeNs(). Read it before the receive buffer, then it is never newer
+   * than the data.
+   *
+   * @return time in ns, 0 if nothing was received yet
+   */
+  virtual uint64_t getReceiveTime() {
+    return receiveTime.load(std::memory_order_relaxed);
+  }
   
  private:
   virtual void run() {
     log.info() << "SocketClient thread started";
-    running = true;
+    SendSchedule schedule(options.sendOnUpdate);
+    auto onFrame = [this](const uint8_t* frame) {
+      receiveTime.store(System::getTimeNs(), std::memory_order_relaxed);
+      std::memcpy(rxBuf.writeBuffer().data(), frame, BufOutLen * sizeof(outT));
+      rxBuf.publish();
+      sequence.fetch_add(1, std::memory_order_release);
+    };
     while (running) {
-      struct sockaddr_in servAddr;
-      int sockfd = socket(AF_INET, SOCK_STREAM, 0);
-      if (sockfd < 0) throw Fault("ERROR opening socket");
-
-      auto server = gethostbyname(serverIP.c_str()); 
-      if (server == NULL) {
-        throw Fault("Server ip not found");
-      }
-      bzero((char *) &servAddr, sizeof(servAddr));
-      servAddr.sin_family = AF_INET;
-      bcopy((char *)server->h_addr,(char *)&servAddr.sin_addr.s_addr, server->h_length);
-      servAddr.sin_port = htons(port);
-    
-      using seconds = std::chrono::duration<double, std::chrono::seconds::period>;
-      auto next_cycle = std::chrono::steady_clock::now() + seconds(period);
-      while (connect(sockfd, (struct sockaddr *) &servAddr, sizeof(servAddr)) < 0) {
-        std::this_thread::sleep_until(next_cycle);
-        next_cycle += seconds(period);
-      }
-      log.info() << "Client connected to ip=" << serverIP;
-      inT b_write[BufInLen]; outT b_read[BufOutLen];							
-      connected = true;
-    
-      while (connected) {
-        std::this_thread::sleep_until(next_cycle);
-        
-        // write
-        std::unique_lock<std::mutex> wlck(mtx);
-        for(uint32_t i = 0; i < BufInLen; i++) b_write[i] = txBuf[i]; 
-        wlck.unlock();
-        int n = write(sockfd, b_write, BufInLen * sizeof(inT));
-        if (n < 0) {
-          log.trace() << "error = " << std::strerror(errno);
-          connected = false;
-        }
-        
-        // read
-        size_t count = BufOutLen * sizeof(outT);
-        uint8_t* ptr = (uint8_t *)b_read;
-        auto endTime = std::chrono::steady_clock::now() + seconds(timeout);
-        while (connected && count) {
-          if (std::chrono::steady_clock::now() > endTime) {
-            log.trace() << "error = socket read timed out";
-            connected = false;
-          }
-          n = read(sockfd, ptr, count);
-          if (n < 0) {
-            log.trace() << "error = " << std::strerror(errno);
-            connected = false;
-          }
-          ptr += n;
-          count -= n;
+      if (stream && !stream->isConnected()) {
+        if (!stream->connect()) {
+          stream->poll(onFrame);   // retry in the next period
+          continue;
         }
-        std::unique_lock<std::mutex> rlck(mtx);
-        for(uint32_t i = 0; i < BufOutLen; i++) rxBuf[i] = b_read[i];
-        rlck.unlock();
-        newData = true;
-        next_cycle += seconds(period);
+        log.info() << "Client connected to ip=" << serverIP;
+      }
+      PollResult r = link ? link->poll(onFrame) : stream->poll(onFrame);
+      bool c = link ? link->isConnected() : stream->isConnected();
+      if (!c && connected) {
+        // if disconnected clear receive buffer
+        rxBuf.writeBuffer().fill(0);
+        rxBuf.publish();
+        sequence.fetch_add(1, std::memory_order_release);
       }
-      close(sockfd);
-      // if disconnected clear receive buffer
-      for(uint32_t i = 0; i < BufOutLen; i++) rxBuf[i] = 0;
-      newData = true;
+      connected = c;
+      if (!schedule.due(r)) continue;
+      const auto& b_write = txBuf.read();
+      if (link) link->send(b_write.data(), BufInLen * sizeof(inT));
+      else if (c) stream->send(b_write.data(), BufInLen * sizeof(inT));
     }
   }
   
-  bool running;
+  std::atomic<bool> running;
   std::string serverIP;
   uint16_t port;
   double period;
   double timeout;	// time which thread tries to read until socket read timed out
-  struct hostent *server;
-  int sockfd;
-  bool connected;
-  std::mutex mtx;
-  std::array<outT, BufOutLen> rxBuf;
-  std::array<inT, BufInLen> txBuf;
+  SocketOptions options;
+  std::atomic<bool> connected;
+  std::unique_ptr<ClientConnection> stream;
+  std::unique_ptr<DatagramLink> link;
+  TripleBuffer<std::array<outT, BufOutLen>> rxBuf;
+  std::atomic<uint64_t> sequence{0};
+  std::atomic<uint64_t> receiveTime{0};
+  TripleBuffer<std::array<inT, BufInLen>> txBuf;
+  logger::Logger log;
+  std::thread thread;
 };
 
 // specialization used when client doesn't receive data from its server
 template < uint32_t BufInLen, typename inT >
-class SocketClient<BufInLen, inT, 0, std::nullptr_t> : public eeros::Thread {
+class SocketClient<BufInLen, inT, 0, std::nullptr_t> {
 public:	
-  SocketClient(std::string serverIP, uint16_t port, double period = 0.01, double timeout = 1.0, int priority = 5) 
-      : Thread(priority), serverIP(serverIP), port(port), period(period), timeout(timeout) {
+  SocketClient(std::string serverIP, uint16_t port, double period = 0.01, double timeout = 1.0, int priority = 5, 
+               Protocol protocol = Protocol::tcp, SocketOptions options = SocketOptions()) 
+      : serverIP(serverIP), port(port), period(period), timeout(timeout), options(options), log(logger::Logger::getLogger()) {
     signal(SIGPIPE, sigPipeHandler);	// make sure, that a broken pipe does not stop application
-    running = false;
+    if (protocol != Protocol::tcp) link.reset(new DatagramLink(serverIP, port, 0, period, timeout, options, protocol == Protocol::multicast));
+    else stream.reset(new ClientConnection(serverIP, port, 0, period, timeout, options));
+    running = true;
     connected = false;
+    thread = std::thread([this, priority]() {
+      if (!setThreadPriority(priority)) log.error() << "could not set realtime priority";
+      run();
+    });
   }
   
   virtual ~SocketClient() {
-    join();
+    running = false;
+    if (thread.joinable()) thread.join();
   }
   
   virtual void stop() {
@@ -168,67 +213,47 @@ public:
   }
   
   virtual void setSendBuffer(std::array<inT, BufInLen>& data) {
-    std::lock_guard<std::mutex> lock(mtx);
-    txBuf = data;
+    txBuf.write(data);
+    if (options.sendOnUpdate) {
+      if (link) link->wake(); else stream->wake();
+    }
   }
 
  private:
   virtual void run() {	
     log.info() << "SocketClient thread started";
-    running = true;
+    SendSchedule schedule(options.sendOnUpdate);
+    auto onFrame = [](const uint8_t*) { };
     while (running) {
-      struct sockaddr_in servAddr;
-      int sockfd = socket(AF_INET, SOCK_STREAM, 0);
-      if (sockfd < 0) throw Fault("ERROR opening socket");
-
-      auto server = gethostbyname(serverIP.c_str()); 
-      if (server == NULL) {
-        throw Fault("Server ip not found");
-      }
-      bzero((char *) &servAddr, sizeof(servAddr));
-      servAddr.sin_family = AF_INET;
-      bcopy((char *)server->h_addr,(char *)&servAddr.sin_addr.s_addr, server->h_length);
-      servAddr.sin_port = htons(port);
-    
-      using seconds = std::chrono::duration<double, std::chrono::seconds::period>;
-      auto next_cycle = std::chrono::steady_clock::now() + seconds(period);
-      while (connect(sockfd, (struct sockaddr *) &servAddr, sizeof(servAddr)) < 0) {
-        std::this_thread::sleep_until(next_cycle);
-        next_cycle += seconds(period);
-      }
-      log.info() << "Client connected to ip=" << serverIP;
-      inT b_write[BufInLen]; 	
-
-      connected = true;
-    
-      while (connected) {
-        std::this_thread::sleep_until(next_cycle);
-      
-        // write
-        std::unique_lock<std::mutex> wlck(mtx);
-        for(uint32_t i = 0; i < BufInLen; i++) b_write[i] = txBuf[i]; 
-        int n = write(sockfd, b_write, BufInLen * sizeof(inT));
-        wlck.unlock();
-        if (n < 0) {
-          log.trace() << "error = " << std::strerror(errno);
-          connected = false;
+      if (stream && !stream->isConnected()) {
+        if (!stream->connect()) {
+          stream->poll(onFrame);   // retry in the next period
+          continue;
         }
-        next_cycle += seconds(period);
+        log.info() << "Client connected to ip=" << serverIP;
       }
-      close(sockfd);
+      PollResult r = link ? link->poll(onFrame) : stream->poll(onFrame);
+      bool c = link ? link->isConnected() : stream->isConnected();
+      connected = c;
+      if (!schedule.due(r)) continue;
+      const auto& b_write = txBuf.read();
+      if (link) link->send(b_write.data(), BufInLen * sizeof(inT));
+      else if (c) stream->send(b_write.data(), BufInLen * sizeof(inT));
     }
   }
   
-  bool running;
+  std::atomic<bool> running;
   std::string serverIP;
   uint16_t port;
   double period;
   double timeout;	// time which thread tries to read until socket read timed out
-  struct hostent *server;
-  int sockfd;
-  bool connected;
-  std::mutex mtx;
-  std::array<inT, BufInLen> txBuf;
+  SocketOptions options;
+  std::atomic<bool> connected;
+  std::unique_ptr<ClientConnection> stream;
+  std::unique_ptr<DatagramLink> link;
+  TripleBuffer<std::array<inT, BufInLen>> txBuf;
+  logger::Logger log;
+  std::thread thread;
 };
 
 }
@@ -0,0 +1,83 @@
+#ifndef ORG_EEROS_SOCKETS_SOCKETOPTIONS_HPP_
+#define ORG_EEROS_SOCKETS_SOCKETOPTIONS_HPP_
+
+#include <string>
+
+namespace eeros {
+namespace sockets {
+
+/**
+ * Options of the sockets used by \ref SocketServer and \ref SocketClient.
+ *
+ * @since v1.4.4
+ */
+struct SocketOptions {
+  bool noDelay = true;          // disables Nagle's algorithm, so small frames are sent at once, TCP only
+  int busyPoll = 0;             // SO_BUSY_POLL in us, the kernel polls the device instead of waiting for an interrupt, 0 disables it
+  int priority = -1;            // SO_PRIORITY of the packets sent, 0 .. 6, -1 keeps the default
+  bool sendOnUpdate = false;    // send as soon as new data is set instead of once per period
+  int multicastTtl = 1;         // number of routers a multicast datagram may pass, 1 keeps it in the local network
+  std::string multicastInterface;   // address of the local interface used for multicast, empty for the default one
+};
+
+/**
+ * Result of waiting for the sockets.
+ */
+struct PollResult {
+  bool tick = false;            // the period elapsed
+  bool wakeup = false;          // new data to send was set
+};
+
+/**
+ * Decides when data is sent. Without \ref SocketOptions::sendOnUpdate data is sent 
+ * once per period. With it, data is sent as soon as it was set, and once per period 
+ * only if nothing was set during the period, to keep the connection alive.
+ */
+class SendSchedule {
+ public:
+  explicit SendSchedule(bool onUpdate) : onUpdate(onUpdate) { }
+
+  /**
+   * @param r - result of waiting for the sockets
+   * @return true, if data has to be sent now
+   */
+  bool due(const PollResult& r) {
+    bool send = false;
+    if (r.tick) {
+      send = !onUpdate || !sent;
+      sent = false;
+    }
+    if (onUpdate && r.wakeup) {
+      send = true;
+      sent = true;
+    }
+    return send;
+  }
+
+ private:
+  bool onUpdate;
+  bool sent = false;
+};
+
+/**
+ * Applies the options to a socket.
+ *
+ * @param fd - socket
+ * @param options - options
+ * @param tcp - true for a TCP socket
+ * @return false, if an option could not be set
+ */
+bool applySocketOptions(int fd, const SocketOptions& options, bool tcp);
+
+/**
+ * Creates a non blocking timerfd which expires once per period.
+ *
+ * @param period - period in s
+ * @return file descriptor
+ */
+int createPeriodicTimer(double period);
+
+}
+}
+
+#endif // ORG_EEROS_SOCKETS_SOCKETOPTIONS_HPP_
@@ -1,40 +1,84 @@
 #ifndef ORG_EEROS_SOCKET_SERVER_HPP_
 #define ORG_EEROS_SOCKET_SERVER_HPP_
 
-#include <eeros/core/Thread.hpp>
+#include <eeros/sockets/ServerConnections.hpp>
+#include <eeros/sockets/DatagramLink.hpp>
+#include <eeros/sockets/SocketOptions.hpp>
+#include <eeros/logger/Logger.hpp>
 #include <array>
-#include <unistd.h>
-#include <netdb.h> 
-#include <arpa/inet.h> 		/* inet_ntoa() to format IP address */
-#include <string.h>
-#include <sys/socket.h>
-#include <fcntl.h>
+#include <atomic>
 #include <eeros/core/Fault.hpp>
-#include <iostream>
+#include <eeros/core/System.hpp>
+#include <eeros/core/TripleBuffer.hpp>
 #include <cstring>
 #include <signal.h>
-#include <mutex>
+#include <memory>
+#include <thread>
 
 namespace eeros {
 namespace sockets {
     
 void sigPipeHandler(int signum);
 
+/**
+ * Sets the realtime priority of the calling thread, 20 leaves it unchanged.
+ *
+ * @param priority - realtime priority
+ * @return false, if the priority could not be set
+ */
+bool setThreadPriority(int priority);
+
+/**
+ * A server which sends an array of inT to its clients and receives an array of outT 
+ * from them once per period. Several clients may be connected at the same time. 
+ * All of them receive the same data, the data received last from any of them 
+ * is returned by getReceiveBuffer(). All clients are served by one thread, 
+ * see \ref ServerConnections.
+ * With \ref Protocol::udp one datagram is exchanged with a single client per period 
+ * instead, see \ref DatagramLink.
+ * With \ref SocketOptions::sendOnUpdate the thread is woken up by setSendBuffer()
+ * and sends the new data at once. Data is passed between the threads without locks.
+ *
+ * @tparam BufInLen - number of elements sent
+ * @tparam inT - type of the elements sent
+ * @tparam BufOutLen - number of elements received
+ * @tparam outT - type of the elements received
+ * @since v1.0
+ */
 template < uint32_t BufInLen, typename inT, uint32_t BufOutLen, typename outT >
-class SocketServer : public eeros::Thread {
+class SocketServer {
  public:
-  SocketServer(uint16_t port, double period = 0.01, double timeout = 1.0, int priority = 5) 
-     : Thread(priority) {
+  /**
+   * Opens the server socket and starts the thread.
+   *
+   * @param port - port number
+   * @param period - period in s in which data is sent to the clients
+   * @param timeout - time in s after which a client which does not send is disconnected
+   * @param priority - realtime priority of the thread
+   * @param maxClients - maximum number of clients, TCP only
+   * @param protocol - transport
+   * @param options - socket options
+   */
+  SocketServer(uint16_t port, double period = 0.01, double timeout = 1.0, int priority = 5, int maxClients = 8, 
+               Protocol protocol = Protocol::tcp, SocketOptions options = SocketOptions()) 
+      : options(options), log(logger::Logger::getLogger()) {
     this->port = port;
     this->period = period;
     this->timeout = timeout;
+    if (protocol == Protocol::multicast) throw Fault("multicast needs the address of a group");
+    if (protocol == Protocol::udp) link.reset(new DatagramLink("", port, BufOutLen * sizeof(outT), period, timeout, options));
+    else connections.reset(new ServerConnections(port, BufOutLen * sizeof(outT), period, timeout, maxClients, options));
     signal(SIGPIPE, sigPipeHandler);	// make sure, that a broken pipe does not stop application
-    running = false;
-    connected = false;
+    running = true;
+    thread = std::thread([this, priority]() {
+      if (!setThreadPriority(priority)) log.error() << "could not set realtime priority";
+      run();
+    });
   }
   
   virtual ~SocketServer() {
-    join();
+    running = false;
+    if (thread.joinable()) thread.join();
   }
   
   virtual void stop() {
@@ -45,129 +89,130 @@ class SocketServer : public eeros::Thread {
     return running;
   }
   
+  /**
+   * Returns true if at least one client is connected.
+   */
   virtual bool isConnected() {
-    return connected;
+    return nofClients > 0;
+  }
+  
+  /**
+   * Returns the number of connected clients.
+   */
+  virtual int getNofClients() {
+    return nofClients;
+  }
+  
+  /**
+   * Returns a view of the latest received data, which stays valid until the next call.
+   * Must only be called by a single reader, usually the control loop.
+   */
+  virtual const std::array<outT, BufOutLen>& getReceiveBuffer() {
+    return rxBuf.read();
   }
   
-  virtual std::array<outT, BufOutLen>& getReceiveBuffer() {
-    std::lock_guard<std::mutex> lock(mtx);
-    return rxBuf;
+  /**
+   * Returns the counters of received datagrams, UDP only.
+   */
+  virtual DatagramStatistics getStatistics() {
+    return link ? link->getStatistics() : DatagramStatistics();
   }
   
+  /**
+   * Sets the data sent next. Must only be called by a single writer, usually the control loop.
+   */
   virtual void setSendBuffer(std::array<inT, BufInLen>& data) {
-    std::lock_guard<std::mutex> lock(mtx);
-    txBuf = data;
+    txBuf.write(data);
+    if (options.sendOnUpdate) {
+      if (link) link->wake(); else connections->wake();
+    }
+  }
+
+  /**
+   * Returns the number of times the receive buffer was updated, a new frame or
+   * the buffer cleared after the connection broke.
+   */
+  virtual uint64_t getSequence() {
+    return sequence.load(std::memory_order_acquire);
   }
 
-  bool newData = false;
+  /**
+   * Returns the time the latest datagram or frame was received, in the time base of
+   * System::getTimeNs(). Read it before the receive buffer, then it is never newer
+   * than the data.
+   *
+   * @return time in ns, 0 if nothing was received yet
+   */
+  virtual uint64_t getReceiveTime() {
+    return receiveTime.load(std::memory_order_relaxed);
+  }
   
  private:
   virtual void run() {	
     log.info() << "SocketServer thread started";
-    struct sockaddr_in servAddr;
-    sockfd = socket(AF_INET, SOCK_STREAM, 0);
-    if (sockfd < 0) throw Fault("ERROR opening socket");
-    
-    bzero((char *) &servAddr, sizeof(servAddr));	
-    servAddr.sin_port = htons(port); 
-    servAddr.sin_family = AF_INET;
-    servAddr.sin_addr.s_addr = htonl(INADDR_ANY) ;
-    int yes = 1;
-    if (setsockopt(sockfd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes)) == -1)
-      throw Fault("ERROR on set socket option");
-    if (bind(sockfd, (struct sockaddr *) &servAddr, sizeof(servAddr)) < 0) 
-      throw Fault("ERROR on socket binding");
-    
-    socklen_t clilen;
-    listen(sockfd,1);
-    struct sockaddr_in cliAddr;
-    clilen = sizeof(cliAddr);
-    
-    running = true;
+    SendSchedule schedule(options.sendOnUpdate);
+    auto onFrame = [this](const uint8_t* frame) {
+      receiveTime.store(System::getTimeNs(), std::memory_order_relaxed);
+      std::memcpy(rxBuf.writeBuffer().data(), frame, BufOutLen * sizeof(outT));
+      rxBuf.publish();
+      sequence.fetch_add(1, std::memory_order_release);
+    };
     while (running) {
-      newsockfd = accept(sockfd, (struct sockaddr *) &cliAddr,  &clilen);
-      if (newsockfd < 0) throw Fault("ERROR on socket accept");
-      connected = true;
-      char cliName[INET6_ADDRSTRLEN];
-      getnameinfo((struct sockaddr*)&cliAddr, sizeof cliAddr, cliName, sizeof(cliName), NULL, 0, NI_NUMERICHOST|NI_NUMERICSERV);
-      log.info() << "Client connection from ip=" << cliName << " accepted";
-      inT b_write[BufInLen]; outT b_read[BufOutLen];
-      using seconds = std::chrono::duration<double, std::chrono::seconds::period>;
-      auto next_cycle = std::chrono::steady_clock::now() + seconds(period);
-    
-      while (connected) {
-        std::this_thread::sleep_until(next_cycle);
-  
-        // write
-        std::unique_lock<std::mutex> wlck(mtx);
-        for(uint32_t i = 0; i < BufInLen; i++) b_write[i] = txBuf[i]; 
-        wlck.unlock();
-//         log.warn() << "try to write ";
-        int n = write(newsockfd, b_write, BufInLen * sizeof(inT));
-        if (n < 0) {
-          log.trace() << "error = " << std::strerror(errno);
-          connected = false;
-        }	
-        
-        // read
-        size_t count = BufOutLen * sizeof(outT);
-        uint8_t* ptr = (uint8_t *)b_read;
-        auto endTime = std::chrono::steady_clock::now() + seconds(timeout);
-        while (connected && count) {
-          if (std::chrono::steady_clock::now() > endTime) {
-            log.trace() << "error = socket read timed out";
-            connected = false;
-          }
-//           log.warn() << "try to read " << count << " Bytes";
-          n = read(newsockfd, ptr, count);
-          if (n < 0) {
-            log.trace() << "error = " << std::strerror(errno);
-            connected = false;
-          }
-          ptr += n;
-          count -= n;
-        }
-        std::unique_lock<std::mutex> rlck(mtx);
-        for(uint32_t i = 0; i < BufOutLen; i++) rxBuf[i] = b_read[i];
-        rlck.unlock();
-        newData = true;
-        next_cycle += seconds(period);
+      PollResult r = link ? link->poll(onFrame) : connections->poll(onFrame);
+      int n = link ? link->isConnected() : connections->getNofClients();
+      if (n == 0 && nofClients > 0) {
+        // if the last client disconnected clear receive buffer
+        rxBuf.writeBuffer().fill(0);
+        rxBuf.publish();
+        sequence.fetch_add(1, std::memory_order_release);
       }
-      close(newsockfd);
-      // if disconnected clear receive buffer
-      for(uint32_t i = 0; i < BufOutLen; i++) rxBuf[i] = 0;
-      newData = true;
+      nofClients = n;
+      if (!schedule.due(r)) continue;
+      const auto& b_write = txBuf.read();
+      if (link) link->send(b_write.data(), BufInLen * sizeof(inT));
+      else if (n > 0) connections->broadcast(b_write.data(), BufInLen * sizeof(inT));
     }
-    close(sockfd);
   }
   
-  bool running;
+  std::atomic<bool> running;
   uint16_t port;
   double period;
-  double timeout;	// time which thread tries to read until socket read timed out
-  struct hostent *server;
-  int sockfd;
-  int newsockfd;
-  bool connected;
-  std::mutex mtx;
-  std::array<outT, BufOutLen> rxBuf;
-  std::array<inT, BufInLen> txBuf;
+  double timeout;	// time after which a client which does not send is disconnected
+  SocketOptions options;
+  std::unique_ptr<ServerConnections> connections;
+  std::unique_ptr<DatagramLink> link;
+  std::atomic<int> nofClients{0};
+  TripleBuffer<std::array<outT, BufOutLen>> rxBuf;
+  std::atomic<uint64_t> sequence{0};
+  std::atomic<uint64_t> receiveTime{0};
+  TripleBuffer<std::array<inT, BufInLen>> txBuf;
+  logger::Logger log;
+  std::thread thread;
 };
 
 // specialization used when server doesn't receive data from its client
 template < uint32_t BufInLen, typename inT >
-class SocketServer<BufInLen, inT, 0, std::nullptr_t> : public eeros::Thread {
+class SocketServer<BufInLen, inT, 0, std::nullptr_t> {
  public:
-  SocketServer(uint16_t port, double period = 0.01, double timeout = 1.0, int priority = 5) : Thread(priority) {
+  SocketServer(uint16_t port, double period = 0.01, double timeout = 1.0, int priority = 5, int maxClients = 8, 
+               Protocol protocol = Protocol::tcp, SocketOptions options = SocketOptions()) 
+      : options(options), log(logger::Logger::getLogger()) {
     this->port = port;
     this->period = period;
+    if (protocol == Protocol::multicast) throw Fault("multicast needs the address of a group");
+    if (protocol == Protocol::udp) link.reset(new DatagramLink("", port, 0, period, timeout, options));
+    else connections.reset(new ServerConnections(port, 0, period, timeout, maxClients, options));
     signal(SIGPIPE, sigPipeHandler);	// make sure, that a broken pipe does not stop application
-    running = false;
-    connected = false;
+    running = true;
+    thread = std::thread([this, priority]() {
+      if (!setThreadPriority(priority)) log.error() << "could not set realtime priority";
+      run();
+    });
   }
   
   virtual ~SocketServer() {
-    join();
+    running = false;
+    if (thread.joinable()) thread.join();
   }
   
   virtual void stop(){
@@ -179,76 +224,46 @@ class SocketServer<BufInLen, inT, 0, std::nullptr_t> : public eeros::Thread {
   }
   
   virtual bool isConnected() {
-    return connected;
+    return nofClients > 0;
+  }
+  
+  virtual int getNofClients() {
+    return nofClients;
   }
   
   virtual void setSendBuffer(std::array<inT, BufInLen>& data) {
-    std::lock_guard<std::mutex> lock(mtx);
-    txBuf = data;
+    txBuf.write(data);
+    if (options.sendOnUpdate) {
+      if (link) link->wake(); else connections->wake();
+    }
   }
 
  private:
   virtual void run() {	
     log.info() << "SocketServer thread started";
-    struct sockaddr_in servAddr;
-    sockfd = socket(AF_INET, SOCK_STREAM, 0);
-    if (sockfd < 0) throw Fault("ERROR opening socket");
-    
-    bzero((char *) &servAddr, sizeof(servAddr));	
-    servAddr.sin_port = htons(port); 
-    servAddr.sin_family = AF_INET;
-    servAddr.sin_addr.s_addr = htonl(INADDR_ANY) ;
-    int yes = 1;
-    if (setsockopt(sockfd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes)) == -1)
-      throw Fault("ERROR on set socket option");
-    if (bind(sockfd, (struct sockaddr *) &servAddr, sizeof(servAddr)) < 0) 
-      throw Fault("ERROR on socket binding");
-    
-    socklen_t clilen;
-    listen(sockfd,1);
-    struct sockaddr_in cliAddr;
-    clilen = sizeof(cliAddr);
-    
-    running = true;
+    SendSchedule schedule(options.sendOnUpdate);
+    auto onFrame = [](const uint8_t*) { };
     while (running) {
-      newsockfd = accept(sockfd, (struct sockaddr *) &cliAddr,  &clilen);
-      if (newsockfd < 0) throw Fault("ERROR on accept");
-      connected = true;
-      char cliName[INET6_ADDRSTRLEN];
-      getnameinfo((struct sockaddr*)&cliAddr, sizeof cliAddr, cliName, sizeof(cliName), NULL, 0, NI_NUMERICHOST|NI_NUMERICSERV);
-      log.info() << "Client connection from ip=" << cliName << " accepted";
-      inT b_write[BufInLen];
-      using seconds = std::chrono::duration<double, std::chrono::seconds::period>;
-      auto next_cycle = std::chrono::steady_clock::now() + seconds(period);
-    
-      while (connected) {
-        std::this_thread::sleep_until(next_cycle);
-      
-        // write
-        std::unique_lock<std::mutex> wlck(mtx);
-        for(uint32_t i = 0; i < BufInLen; i++) b_write[i] = txBuf[i]; 
-        wlck.unlock();
-        int n = write(newsockfd, b_write, BufInLen * sizeof(inT));
-        if (n < 0) {
-          log.trace() << "error = " << std::strerror(errno);
-          connected = false;
-        }
-        next_cycle += seconds(period);
-      }
-      close(newsockfd);
+      PollResult r = link ? link->poll(onFrame) : connections->poll(onFrame);
+      int n = link ? link->isConnected() : connections->getNofClients();
+      nofClients = n;
+      if (!schedule.due(r)) continue;
+      const auto& b_write = txBuf.read();
+      if (link) link->send(b_write.data(), BufInLen * sizeof(inT));
+      else if (n > 0) connections->broadcast(b_write.data(), BufInLen * sizeof(inT));
     }
-    close(sockfd);
   }
   
-  bool running;
+  std::atomic<bool> running;
   uint16_t port;
   double period;
-  struct hostent *server;
-  int sockfd;
-  int newsockfd;
-  bool connected;
-  std::mutex mtx;
-  std::array<inT, BufInLen> txBuf;
+  SocketOptions options;
+  std::unique_ptr<ServerConnections> connections;
+  std::unique_ptr<DatagramLink> link;
+  std::atomic<int> nofClients{0};
+  TripleBuffer<std::array<inT, BufInLen>> txBuf;
+  logger::Logger log;
+  std::thread thread;
 };
 
 }
@@ -1,35 +1,99 @@
 #ifndef ORG_EEROS_TASK_ASYNC_HPP_
 #define ORG_EEROS_TASK_ASYNC_HPP_
 
-#include <thread>
+#include <atomic>
+#include <cstddef>
+#include <vector>
 
 #include <eeros/core/Runnable.hpp>
 #include <eeros/core/Semaphore.hpp>
+#include <eeros/core/FutexSemaphore.hpp>
 #include <eeros/core/PeriodicCounter.hpp>
+#include <eeros/core/StackThread.hpp>
+#include <eeros/task/Periodic.hpp>
 #include <eeros/logger/Logger.hpp>
 
 namespace eeros {
 namespace task {
 
 class Async : public Runnable {
+  using Logger = logger::Logger;
+
  public:
-  Async(Runnable &task, bool realtime = false, int nice = 0);
-  Async(Runnable *task, bool realtime = false, int nice = 0);
+  Async(Runnable &task, bool realtime = false, int nice = 0, std::vector<int> cpus = {}, std::size_t stackSize = 0);
+  Async(Runnable *task, bool realtime = false, int nice = 0, std::vector<int> cpus = {}, std::size_t stackSize = 0);
   virtual ~Async();
   virtual void run();
   void stop();
   void join();
 
+  /**
+   * Switches the thread to SCHED_DEADLINE before its next run. If the runtime 
+   * budget is 0, the budget is measured during the first calibrationCycles runs.
+   * Must be called before the first run of the task.
+   * The kernel refuses SCHED_DEADLINE for a thread whose affinity does not cover
+   * all CPUs of its root domain, so with cpus restricted to a subset the thread
+   * needs an exclusive cpuset of exactly these CPUs, otherwise it keeps its policy.
+   *
+   * @param period - period and relative deadline in sec
+   * @param runtime - runtime budget in sec, 0 to measure the budget
+   */
+  void setDeadline(double period, double runtime = 0);
+
+  /**
+   * Waits until the thread has started, set its priority and affinity, 
+   * locked memory and prefaulted its stack.
+   *
+   * @param timeout - maximum time to wait in sec
+   * @return true, if the thread is ready
+   */
+  bool waitReady(double timeout);
+
+  /**
+   * Sets the policy applied if run() is called while the previous run 
+   * has not finished yet.
+   *
+   * @param policy - overrun policy
+   * @param ss - safety system, only used with OverrunPolicy::safetyEvent
+   * @param e - safety event, only used with OverrunPolicy::safetyEvent
+   */
+  void setOverrunPolicy(OverrunPolicy policy, safety::SafetySystem* ss = nullptr, safety::SafetyEvent* e = nullptr);
+
+  /**
+   * Returns the runtime budget derived from the measured maximum run time,
+   * which is the maximum with a margin of budgetMargin, limited to the period.
+   *
+   * @param maxRun - maximum measured run time in sec
+   * @param period - period in sec
+   * @return runtime budget in sec
+   */
+  static double calibratedBudget(double maxRun, double period);
+
+  static constexpr int calibrationCycles = 100;
+  static constexpr double budgetMargin = 1.5;
+
   PeriodicCounter counter;
 
  private:
   void run_thread();
+  void apply_deadline(Logger &log);
   Runnable &task;
   bool realtime;
   int nice;
-  Semaphore semaphore;
-  std::thread thread;
+  std::vector<int> cpus;
+  bool deadline = false;
+  double deadlinePeriod = 0;
+  double deadlineRuntime = 0;
+  OverrunPolicy overrunPolicy = OverrunPolicy::catchUp;
+  safety::SafetySystem* safetySystem = nullptr;
+  safety::SafetyEvent* safetyEvent = nullptr;
+  std::atomic<int> pending{0};
+  std::atomic<uint64_t> missed{0};
+  Semaphore readySemaphore;
+  bool ready = false;
+  FutexSemaphore semaphore;
   bool finished;
+  StackThread thread;
 };
 
 }
@@ -8,8 +8,8 @@ namespace eeros {
 
 		class Harmonic : public Runnable {
 		public:
-			Harmonic(Runnable &task, int n = 1);
-			Harmonic(Runnable *task, int n = 1);
+			Harmonic(Runnable &task, int n = 1, int phase = 0);
+			Harmonic(Runnable *task, int n = 1, int phase = 0);
 			Runnable *getTask();
 			virtual void run();
 		private:
@@ -0,0 +1,71 @@
+#ifndef ORG_EEROS_TASK_OVERRUNHANDLER_HPP_
+#define ORG_EEROS_TASK_OVERRUNHANDLER_HPP_
+
+#include <cstdint>
+
+#include <eeros/core/PeriodicCounter.hpp>
+#include <eeros/task/Periodic.hpp>
+
+namespace eeros {
+namespace task {
+
+/**
+ * Applies an overrun policy to a loop which releases a run every period.
+ * After each run the loop passes the regular release of the next run and
+ * gets the release it must actually wait for. Each missed release is counted
+ * once in the periodic counter, also while catching up the missed cycles
+ * one after the other.
+ *
+ * @since v1.4.4
+ */
+class OverrunHandler {
+ public:
+  /**
+   * Sets the overrun policy.
+   *
+   * @param policy - overrun policy
+   * @param ss - safety system, only used with OverrunPolicy::safetyEvent
+   * @param e - safety event, only used with OverrunPolicy::safetyEvent
+   */
+  void setPolicy(OverrunPolicy policy, safety::SafetySystem* ss = nullptr, safety::SafetyEvent* e = nullptr);
+
+  /**
+   * @return overrun policy
+   */
+  OverrunPolicy getPolicy() const;
+
+  /**
+   * Returns the release of the next run. If the next regular release has already
+   * passed, the missed releases are counted and the policy decides whether they
+   * are run back to back or dropped.
+   *
+   * @param next - next regular release in ns
+   * @param now - current time in ns
+   * @param periodNs - period in ns
+   * @param counter - counter the missed releases are added to
+   * @return release of the next run in ns
+   */
+  int64_t release(int64_t next, int64_t now, int64_t periodNs, PeriodicCounter& counter);
+
+  /**
+   * Triggers the safety event, if the policy is OverrunPolicy::safetyEvent and
+   * an event is registered.
+   */
+  void triggerEvent();
+
+  /**
+   * Forgets the releases counted so far, must be called before a loop starts.
+   */
+  void reset();
+
+ private:
+  OverrunPolicy policy = OverrunPolicy::catchUp;
+  safety::SafetySystem* safetySystem = nullptr;
+  safety::SafetyEvent* safetyEvent = nullptr;
+  int64_t countedUntil = 0;   // latest release already counted as missed
+};
+
+}
+}
+
+#endif // ORG_EEROS_TASK_OVERRUNHANDLER_HPP_
@@ -1,6 +1,7 @@
 #ifndef ORG_EEROS_TASK_PERIODIC_HPP_
 #define ORG_EEROS_TASK_PERIODIC_HPP_
 
+#include <cstddef>
 #include <vector>
 #include <functional>
 
@@ -8,11 +9,27 @@
 #include <eeros/core/PeriodicCounter.hpp>
 
 namespace eeros {
+
+namespace safety {
+  class SafetySystem;
+  class SafetyEvent;
+}
+
 namespace task {
 
+/**
+ * Defines what happens if a run of a periodic did not finish before its next release.
+ * 
+ * - catchUp: the missed cycles are run back to back (default)
+ * - skip: the missed cycles are dropped and the periodic continues with the next regular cycle
+ * - safetyEvent: like skip, additionally a registered safety event is triggered
+ */
+enum class OverrunPolicy { catchUp, skip, safetyEvent };
+
 /**
  * A periodic is used to be run by the @ref Executor. 
- * All periodics must be harmonic. That is, their periods must be a integral multiple the base periodic.
+ * All periodics must be harmonic. That is, their periods must be a integral multiple the base periodic,
+ * unless they run with an independent timer, see setIndependentTimer().
  *  
  * @since v0.4
  */
@@ -109,6 +126,197 @@ class Periodic {
     nice = value;
   }
 
+  /**
+   * Pins the thread of the periodic to a set of CPU cores. Use this together
+   * with isolated cores (isolcpus) to avoid migrations of control threads.
+   * An empty set leaves the placement to the scheduler (default).
+   * 
+   * @param cpus - indices of the cores the thread may run on
+   */
+  void setAffinity(std::vector<int> cpus) {
+    this->cpus = cpus;
+  }
+
+  /**
+   * Gets the set of CPU cores the thread of the periodic is pinned to.
+   * 
+   * @return cpu cores, empty if not pinned
+   */
+  std::vector<int> getAffinity() {
+    return cpus;
+  }
+
+  /**
+   * Sets the stack size of the thread of the periodic. A realtime thread with a
+   * stack size set prefaults its whole stack before it locks memory, so even deep
+   * call chains do not page fault while running. 0 leaves the default stack size
+   * and prefaults Executor::defaultStackPrefault bytes (default).
+   *
+   * @param size - stack size in bytes
+   */
+  void setStackSize(std::size_t size) {
+    stackSize = size;
+  }
+
+  /**
+   * Gets the stack size of the thread of the periodic.
+   *
+   * @return stack size in bytes, 0 for the default stack size
+   */
+  std::size_t getStackSize() {
+    return stackSize;
+  }
+
+  /**
+   * Runs the thread of the periodic under SCHED_DEADLINE instead of SCHED_FIFO.
+   * Period and relative deadline are set to the period of the periodic. The kernel
+   * then guarantees the runtime budget per period and throttles the thread as soon as
+   * it exceeds its budget, which protects faster tasks from a runaway slow task.
+   * If no budget is given, the thread runs for a number of calibration cycles under its 
+   * normal policy and the budget is derived from the measured maximum run time.
+   * Combined with setAffinity() on a subset of the cores, the cores must form an
+   * exclusive cpuset, see task::Async::setDeadline().
+   *
+   * @param runtime - runtime budget per period in sec, 0 to measure the budget
+   */
+  void setDeadlineScheduling(double runtime = 0) {
+    deadline = true;
+    deadlineRuntime = runtime;
+  }
+
+  /**
+   * Gets the SCHED_DEADLINE flag of the periodic.
+   * 
+   * @return true, if the thread runs under SCHED_DEADLINE
+   */
+  bool getDeadlineScheduling() {
+    return deadline;
+  }
+
+  /**
+   * Gets the runtime budget used for SCHED_DEADLINE.
+   * 
+   * @return runtime budget in sec, 0 if the budget is measured
+   */
+  double getDeadlineRuntime() {
+    return deadlineRuntime;
+  }
+
+  /**
+   * Sets the worst case execution time of one run, used by the schedulability
+   * analysis of the executor, see Executor::setSchedulabilityCheck().
+   *
+   * @param wcet - worst case execution time in sec, 0 if unknown (default)
+   */
+  void setWcet(double wcet) {
+    this->wcet = wcet;
+  }
+
+  /**
+   * Gets the worst case execution time of one run.
+   *
+   * @return worst case execution time in sec, 0 if unknown
+   */
+  double getWcet() {
+    return wcet;
+  }
+
+  /**
+   * Releases the periodic by its own absolute timer in its own thread instead of by
+   * the executor main loop, see \ref Timed. Its period then does not have to be a multiple
+   * of the executor period, e.g. a 3 ms periodic with a 2 ms executor. Such a periodic
+   * must be added directly to the executor, not to before or after of another periodic,
+   * and it is not synchronized with the executor cycles, so it must not share blocks
+   * with other time domains without synchronization. Periodics in its before and after
+   * lists are run harmonically to it. Not supported in Executor::TimingMode::lockstep.
+   *
+   * @param independent - true to run the periodic with an independent timer
+   */
+  void setIndependentTimer(bool independent = true) {
+    this->independent = independent;
+  }
+
+  /**
+   * Gets the independent timer flag of the periodic.
+   *
+   * @return true, if the periodic runs with an independent timer
+   */
+  bool getIndependentTimer() {
+    return independent;
+  }
+
+  /**
+   * Delays the execution of the periodic by a number of cycles of its base task.
+   * Periodics with the same period can be spread over the cycles of the base task, 
+   * which flattens the load peaks. The phase has to be smaller than the ratio of 
+   * the period of the periodic and the period of its base task.
+   * 
+   * @param cycles - phase offset in base cycles
+   * @see Executor::setPhaseDistribution()
+   */
+  void setPhase(int cycles) {
+    phase = cycles;
+  }
+
+  /**
+   * Gets the phase offset of the periodic.
+   * 
+   * @return phase offset in base cycles, -1 if not set
+   */
+  int getPhase() {
+    return phase;
+  }
+
+  /**
+   * Sets the policy applied if a run did not finish before the next release.
+   * Overruns are counted in the periodic counter regardless of the policy.
+   * 
+   * @param policy - overrun policy
+   * @see registerSafetyEvent()
+   */
+  void setOverrunPolicy(OverrunPolicy policy) {
+    overrunPolicy = policy;
+  }
+
+  /**
+   * Gets the overrun policy.
+   * 
+   * @return overrun policy
+   */
+  OverrunPolicy getOverrunPolicy() {
+    return overrunPolicy;
+  }
+
+  /**
+   * Registers the safety event which is triggered on an overrun 
+   * with policy OverrunPolicy::safetyEvent.
+   *
+   * @param ss - safety system
+   * @param e - safety event
+   */
+  void registerSafetyEvent(safety::SafetySystem& ss, safety::SafetyEvent& e) {
+    safetySystem = &ss;
+    safetyEvent = &e;
+  }
+
+  /**
+   * Gets the safety system registered for overruns.
+   * 
+   * @return safety system or nullptr
+   */
+  safety::SafetySystem* getSafetySystem() {
+    return safetySystem;
+  }
+
+  /**
+   * Gets the safety event registered for overruns.
+   * 
+   * @return safety event or nullptr
+   */
+  safety::SafetyEvent* getSafetyEvent() {
+    return safetyEvent;
+  }
+
   /**
    * A periodic can be chosen to be run before another periodic.
    * In such a case you have to add it to this vector.
@@ -133,6 +341,16 @@ class Periodic {
   Runnable *task;
   bool realtime;
   int nice;
+  std::vector<int> cpus;
+  std::size_t stackSize = 0;
+  bool deadline = false;
+  double deadlineRuntime = 0;
+  double wcet = 0;
+  bool independent = false;
+  int phase = -1;
+  OverrunPolicy overrunPolicy = OverrunPolicy::catchUp;
+  safety::SafetySystem* safetySystem = nullptr;
+  safety::SafetyEvent* safetyEvent = nullptr;
 };
 
 }
@@ -0,0 +1,105 @@
+#ifndef ORG_EEROS_TASK_SCHEDULABILITY_HPP_
+#define ORG_EEROS_TASK_SCHEDULABILITY_HPP_
+
+#include <string>
+#include <vector>
+
+#include <eeros/logger/Logger.hpp>
+
+namespace eeros {
+namespace task {
+
+/**
+ * Schedulability analysis of a set of realtime periodics under fixed priority
+ * preemptive scheduling (SCHED_FIFO), as assigned by the executor in rate
+ * monotonic order. The deadline of each periodic is its period.
+ *
+ * The periodics are grouped by core: a periodic pinned to one or more cores
+ * belongs to the first of them, all periodics which are not pinned are
+ * analyzed as if they shared a single core, which is pessimistic on a
+ * multicore machine. For each core the utilization is compared to the
+ * Liu & Layland bound, and for each periodic the worst case response time is
+ * computed from its own execution time and the interference of all periodics
+ * on the same core with a higher or the same priority.
+ *
+ * @since v1.4.4
+ */
+class Schedulability {
+ public:
+  /**
+   * Core of periodics which are not pinned.
+   */
+  static constexpr int anyCore = -1;
+
+  /**
+   * Result for one periodic.
+   */
+  struct Task {
+    std::string name;
+    double period;
+    double wcet;
+    int priority;
+    int core;
+    double responseTime;   // worst case response time in sec, infinity if it does not converge
+    bool schedulable;
+  };
+
+  /**
+   * Utilization of one core.
+   */
+  struct Core {
+    int core;
+    int tasks;
+    double utilization;
+    double bound;   // Liu & Layland bound n * (2^(1/n) - 1)
+  };
+
+  /**
+   * Adds a periodic.
+   *
+   * @param name - name of the periodic
+   * @param period - period in sec
+   * @param wcet - worst case execution time in sec
+   * @param priority - realtime priority, higher values preempt lower ones
+   * @param cpus - cores the periodic is pinned to, empty if not pinned
+   */
+  void add(std::string name, double period, double wcet, int priority, const std::vector<int>& cpus = {});
+
+  /**
+   * Computes the utilization of each core and the response time of each periodic.
+   *
+   * @return true, if all periodics finish within their period
+   */
+  bool analyze();
+
+  /**
+   * Logs a breakdown per core and per periodic, unschedulable periodics on level ERROR,
+   * the others on level INFO.
+   *
+   * @param log - logger
+   */
+  void report(logger::Logger& log) const;
+
+  /**
+   * Gets the results per periodic, valid after analyze().
+   *
+   * @return periodics in the order they were added
+   */
+  const std::vector<Task>& getTasks() const;
+
+  /**
+   * Gets the utilization per core, valid after analyze().
+   *
+   * @return cores in ascending order, anyCore first
+   */
+  const std::vector<Core>& getCores() const;
+
+ private:
+  std::vector<Task> tasks;
+  std::vector<Core> cores;
+};
+
+}
+}
+
+#endif // ORG_EEROS_TASK_SCHEDULABILITY_HPP_
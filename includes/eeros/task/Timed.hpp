@@ -0,0 +1,106 @@
+#ifndef ORG_EEROS_TASK_TIMED_HPP_
+#define ORG_EEROS_TASK_TIMED_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <eeros/core/Runnable.hpp>
+#include <eeros/core/Semaphore.hpp>
+#include <eeros/core/FutexSemaphore.hpp>
+#include <eeros/core/PeriodicCounter.hpp>
+#include <eeros/core/StackThread.hpp>
+#include <eeros/task/Periodic.hpp>
+#include <eeros/task/OverrunHandler.hpp>
+
+namespace eeros {
+namespace task {
+
+/**
+ * Runs a runnable in its own thread, released by its own absolute timer
+ * (clock_nanosleep on CLOCK_MONOTONIC) instead of by the executor main loop.
+ * The executor uses it for periodics which are not a multiple of the
+ * executor period, see Periodic::setIndependentTimer().
+ *
+ * The releases do not drift, the n-th release is at start + n * period.
+ * If a run did not finish before the next release, the overrun policy decides
+ * whether the missed releases are run back to back or skipped.
+ *
+ * @since v1.4.4
+ */
+class Timed {
+ public:
+  /**
+   * Creates the thread, which sets its priority and affinity, locks memory,
+   * prefaults its stack and then waits for start().
+   *
+   * @param task - runnable
+   * @param period - period in sec
+   * @param realtime - if true, the thread runs with a realtime priority
+   * @param nice - nice level, the priority is Executor::basePriority - nice
+   * @param cpus - cores the thread may run on, all cores if empty
+   * @param stackSize - stack size in bytes, 0 for the default stack size
+   */
+  Timed(Runnable &task, double period, bool realtime = false, int nice = 0, std::vector<int> cpus = {}, std::size_t stackSize = 0);
+  virtual ~Timed();
+
+  Timed(const Timed&) = delete;
+
+  /**
+   * Releases the first run.
+   *
+   * @param startNs - time of the first release in ns on CLOCK_MONOTONIC
+   */
+  void start(int64_t startNs);
+
+  /**
+   * Stops the thread after its current run, at the latest after one period.
+   */
+  void stop();
+
+  /**
+   * Waits until the thread has stopped.
+   */
+  void join();
+
+  /**
+   * Waits until the thread has started, set its priority and affinity,
+   * locked memory and prefaulted its stack.
+   *
+   * @param timeout - maximum time to wait in sec
+   * @return true, if the thread is ready
+   */
+  bool waitReady(double timeout);
+
+  /**
+   * Sets the policy applied if a run did not finish before the next release.
+   *
+   * @param policy - overrun policy
+   * @param ss - safety system, only used with OverrunPolicy::safetyEvent
+   * @param e - safety event, only used with OverrunPolicy::safetyEvent
+   */
+  void setOverrunPolicy(OverrunPolicy policy, safety::SafetySystem* ss = nullptr, safety::SafetyEvent* e = nullptr);
+
+  PeriodicCounter counter;
+
+ private:
+  void run_thread();
+  Runnable &task;
+  int64_t periodNs;
+  bool realtime;
+  int nice;
+  std::vector<int> cpus;
+  OverrunHandler overrun;
+  std::atomic<int64_t> startNs{0};
+  std::atomic<bool> finished{false};
+  Semaphore readySemaphore;
+  bool ready = false;
+  FutexSemaphore startSemaphore;
+  StackThread thread;
+};
+
+}
+}
+
+#endif // ORG_EEROS_TASK_TIMED_HPP_
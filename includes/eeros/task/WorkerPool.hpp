@@ -0,0 +1,118 @@
+#ifndef ORG_EEROS_TASK_WORKERPOOL_HPP_
+#define ORG_EEROS_TASK_WORKERPOOL_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <eeros/core/Runnable.hpp>
+#include <eeros/core/PeriodicCounter.hpp>
+
+namespace eeros {
+namespace task {
+
+/**
+ * Small work-stealing thread pool for non realtime tasks.
+ * Each worker has its own queue, submitted jobs are distributed round robin
+ * over the queues. A worker runs the jobs of its own queue in order and steals 
+ * from the other queues when its own queue is empty. Idle workers sleep.
+ * The pool uses normal scheduling, it must not be used for realtime tasks.
+ *
+ * @since v1.4.4
+ */
+class WorkerPool {
+ public:
+  /**
+   * Starts the worker threads.
+   *
+   * @param threads - number of worker threads
+   * @param cpus - cores the workers may run on, all cores if empty
+   */
+  WorkerPool(int threads, std::vector<int> cpus = {});
+  virtual ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+
+  /**
+   * Queues a job. The job must stay alive until it has been run.
+   *
+   * @param job - job
+   */
+  void submit(Runnable& job);
+
+  /**
+   * Stops the workers after their current job, queued jobs are dropped.
+   */
+  void stop();
+
+  /**
+   * Waits until all workers have stopped.
+   */
+  void join();
+
+  /**
+   * Returns the number of worker threads.
+   *
+   * @return number of threads
+   */
+  int getThreadCount() const;
+
+ private:
+  struct Queue {
+    std::mutex mtx;
+    std::deque<Runnable*> jobs;
+  };
+
+  void workerLoop(int index);
+  Runnable* take(int index);
+
+  std::vector<int> cpus;
+  std::vector<std::unique_ptr<Queue>> queues;
+  std::vector<std::thread> workers;
+  std::atomic<unsigned int> nextQueue{0};
+  std::atomic<int> queued{0};
+  std::mutex sleepMtx;
+  std::condition_variable sleepCv;
+  std::atomic<bool> finished{false};
+};
+
+/**
+ * Runs a task on a worker pool, used by the executor for non realtime periodics.
+ * Each call of run() queues one execution of the task, the timing is tracked by 
+ * the periodic counter as for a task on its own thread. If the previous execution 
+ * has not finished yet, the call is skipped and counted as overrun.
+ *
+ * @since v1.4.4
+ */
+class PooledTask : public Runnable {
+ public:
+  PooledTask(Runnable& task, WorkerPool& pool);
+
+  virtual void run();
+
+  PeriodicCounter counter;
+
+ private:
+  struct Job : public Runnable {
+    Job(PooledTask& owner) : owner(owner) { }
+    virtual void run() { owner.execute(); }
+    PooledTask& owner;
+  };
+
+  void execute();
+
+  Runnable& task;
+  WorkerPool& pool;
+  Job job;
+  std::atomic<bool> pending{false};
+  std::atomic<uint64_t> missed{0};
+};
+
+}
+}
+
+#endif // ORG_EEROS_TASK_WORKERPOOL_HPP_
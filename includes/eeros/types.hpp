@@ -6,7 +6,7 @@
 typedef uint16_t sigdim_t;
 typedef uint16_t sigindex_t;
 
-typedef uint32_t sigid_t;
+typedef uint64_t sigid_t;
 typedef uint16_t sigmajorid_t;
 typedef uint32_t sigtype_t;
 typedef uint64_t timestamp_t;
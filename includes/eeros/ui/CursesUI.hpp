@@ -2,9 +2,16 @@
 #define ORG_EEROS_UI_TUI_HPP_
 
 #include <atomic>
+#include <cstdint>
 #include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #include <eeros/sequencer/Sequencer.hpp>
+#include <eeros/sequencer/BaseSequence.hpp>
+#include <eeros/safety/SafetySystem.hpp>
+#include <eeros/core/FutexSemaphore.hpp>
 #include <eeros/core/Thread.hpp>
 
 #define INPUT_TIMEOUT 50
@@ -17,59 +24,83 @@
 
 namespace eeros {
 	namespace ui {
-		
+
+		/**
+		 * Text user interface for the sequencer. The screen is only redrawn if the
+		 * state of a sequence, the safety level or the messages changed, at most
+		 * with the maximum refresh rate. The states are read from a snapshot, which is
+		 * taken with atomic loads only, and only the lines which differ from the
+		 * last redraw are written to the terminal.
+		 */
 		class CursesUI : public eeros::Thread {
-			
+
 		public:
 			enum State { idle, active, stopping, stopped };
-			
-			CursesUI(eeros::sequencer::Sequencer& sequencer);
+
+			CursesUI(eeros::sequencer::Sequencer& sequencer, eeros::safety::SafetySystem* safetySystem = nullptr);
 			virtual ~CursesUI();
-			
+
 			virtual void dispay();
 			virtual void exit();
-			
+
 			virtual void addMessage(std::string message);
-			
+
+			/**
+			 * Sets the maximum refresh rate, changes in between are batched into one redraw.
+			 *
+			 * @param hz - redraws per second
+			 */
+			void setMaxRefreshRate(double hz);
+
 		protected:
-			
+
 		private:
+			// state of the sequencer and the safety system, read without locks
+			struct Snapshot {
+				uint64_t stateChanges = ~0ull;
+				std::vector<eeros::sequencer::SequenceState> states;
+				std::vector<std::string> names;
+				eeros::safety::SafetyLevel* level = nullptr;
+				uint64_t messages = 0;
+			};
+
 			virtual void run();
 			eeros::sequencer::Sequencer& sequencer;
-// 			eeros::sequencer::state::type cachedState;
-// 			eeros::sequencer::mode::type cachedMode;
-			std::atomic<bool> messageListUpdated;
+			eeros::safety::SafetySystem* safetySystem;
 			std::atomic<State> state;
+			FutexSemaphore wakeup;
 			unsigned int headerStart;
 			unsigned int sequenceListStart;
 			unsigned int messageListStart;
 			unsigned int statusStart;
 			unsigned int commandListStart;
 			unsigned int footerStart;
+			std::mutex messageMutex;
 			std::deque<std::string> messageList;
-			
+			std::atomic<uint64_t> messageCount;
+			std::atomic<uint64_t> minRedrawPeriodNs;
+			uint64_t lastRedrawNs = 0;
+			bool dirty = true;
+			Snapshot shown;
+			std::vector<std::pair<short, std::string>> lines;   // content of each screen line
+
 			void initScreen();
-			void updateScreen();
-			void printTitle(std::string text, unsigned int line);
+			void layout();
+			bool takeSnapshot(Snapshot& s);
+			void updateScreen(const Snapshot& s);
+			void printLine(unsigned int line, short color, const std::string& text, bool centered = false);
 			void printHeader();
 			void printFooter(std::string msg);
-			void printSequenceList(unsigned int first);
+			void printSequenceList(const Snapshot& s);
 			void printMessageList();
-			void printMessage(std::string msg, unsigned int index);
-			void printStatus();
-			void printCommandList();
-			void printCommand(std::string cmd, std::string description, bool active, unsigned int index);
-			int promptForInt(std::string message);
-// 			double promptForDouble(std::string message);
-// 			bool promptConfirm(std::string message);
-			
-			bool checkCmdToggleIsActive();
-			bool checkCmdAbortIsActive();
-			bool checkCmdProceedIsActive();
-			bool checkCmdChooseSeqIsActive();
-			
+			void printStatus(const Snapshot& s);
+			void printCommandList(const Snapshot& s);
+			std::string command(std::string cmd, std::string description, bool active);
+
+			bool checkCmdAbortIsActive(const Snapshot& s);
+
 			static unsigned int instanceCounter;
-			
+
 		}; // class TUI
 	}; // namespace ui
 }; // namespace eeros
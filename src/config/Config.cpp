@@ -1,116 +1,194 @@
 #include <eeros/config/Config.hpp>
 #include <eeros/core/Fault.hpp>
 
-#include <sstream>
+#include <charconv>
 
 using namespace eeros::config;
 
-void Config::add(std::string name, int &value) {
-  auto k = properties.find(name);
-  if (k != properties.end()) {
-    throw eeros::Fault(std::string("Property '") + name + "' already added.");
+namespace {
+
+template <typename T>
+void append(std::string& s, T value) {
+  char buf[32];
+  auto r = std::to_chars(buf, buf + sizeof(buf), value);
+  s.append(buf, r.ptr);
+}
+
+template <typename T>
+void appendList(std::string& s, const T* start, std::size_t length) {
+  for (std::size_t i = 0; i < length; i++) {
+    if (i != 0) s += ", ";
+    append(s, start[i]);
   }
-  properties[name] = ConfigPropertyAccessor {
-    [&value] (std::string name, std::string& val) -> void {
-      val = std::to_string(value);
+}
+
+const char* skipSpace(const char* p, const char* end) {
+  while (p != end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+  return p;
+}
+
+template <typename T>
+const char* parse(const std::string& name, const char* p, const char* end, T& value) {
+  p = skipSpace(p, end);
+  if (p != end && *p == '+') p++;
+  auto r = std::from_chars(p, end, value);
+  if (r.ec != std::errc()) {
+    throw eeros::Fault(std::string("Property '") + name + "': invalid value '" + std::string(p, end) + "'");
+  }
+  return r.ptr;
+}
+
+/*
+ * Parses a comma separated list in one pass, store(i, value) is called for each value.
+ * Returns the number of values.
+ */
+template <typename T, typename F>
+std::size_t parseList(const std::string& name, std::string_view text, F&& store) {
+  const char* p = text.data();
+  const char* end = p + text.size();
+  std::size_t i = 0;
+  if (skipSpace(p, end) == end) return 0;
+  for (;;) {
+    T value;
+    p = skipSpace(parse(name, p, end, value), end);
+    store(i++, value);
+    if (p == end) return i;
+    if (*p != ',') {
+      throw eeros::Fault(std::string("Property '") + name + "': invalid value '" + std::string(p, end) + "'");
+    }
+    p++;
+  }
+}
+
+template <typename T>
+ConfigPropertyAccessor valueAccessor(std::string name, T& value) {
+  return ConfigPropertyAccessor {
+    [&value] (std::string& val) -> void {
+      append(val, value);
     },
-    [&value] (std::string name, const std::string& val) -> void {
-      value = std::stoi(val);
+    [name, &value] (std::string_view val) -> void {
+      parse(name, val.data(), val.data() + val.size(), value);
     }
   };
 }
 
-void Config::add(std::string name, double &value) {
-  auto k = properties.find(name);
-  if (k != properties.end()) {
-    throw eeros::Fault(std::string("Property '") + name + "' already added.");
-  }
-  properties[name] = ConfigPropertyAccessor {
-    [&value] (std::string name, std::string& val) -> void {
-      val = std::to_string(value);
+template <typename T>
+ConfigPropertyAccessor arrayAccessor(std::string name, std::size_t length, T* start, T defaultValue) {
+  return ConfigPropertyAccessor {
+    [length, start] (std::string& val) -> void {
+      appendList(val, start, length);
     },
-    [&value] (std::string name, const std::string& val) -> void {
-      value = std::stod(val);
+    [name, length, start, defaultValue] (std::string_view val) -> void {
+      std::size_t n = parseList<T>(name, val, [&](std::size_t i, T v) {
+        if (i >= length) throw eeros::Fault(std::string("Property '") + name + "': too many values");
+        start[i] = v;
+      });
+      while (n < length) start[n++] = defaultValue;
     }
   };
 }
 
-void Config::add(std::string name, std::size_t length, int *start, int *end, int defaultValue) {
-  if (start + length != end) {
-    throw eeros::Fault(std::string("Property '") + name + "': array length inconsistent");
-  }
-  auto k = properties.find(name);
-  if (k != properties.end()) {
-    throw eeros::Fault(std::string("Property '") + name + "' already added.");
-  }
-  properties[name] = ConfigPropertyAccessor{
-    [length, start] (std::string name, std::string& val) -> void {
-      std::stringstream ss;
-      for (std::size_t i = 0; i < length; i++) {
-        if (i != 0) ss << ", ";
-        ss << start[i];
-      }
-      val = ss.str();
+template <typename T>
+ConfigPropertyAccessor vectorAccessor(std::string name, std::vector<T>& value) {
+  return ConfigPropertyAccessor {
+    [&value] (std::string& val) -> void {
+      appendList(val, value.data(), value.size());
     },
-    [length, start, defaultValue] (std::string name, const std::string& val) -> void {
-      std::size_t i = 0;
-      std::stringstream ss(val);
-      std::string el;
-      while (getline(ss, el, ',')) {
-        int v = std::stoi(el);
-        start[i++] = v;
-      }
-      while (i < length) {
-        start[i++] = defaultValue;
-      }
+    [name, &value] (std::string_view val) -> void {
+      value.clear();
+      parseList<T>(name, val, [&value](std::size_t, T v) { value.push_back(v); });
     }
   };
 }
 
-void Config::add(std::string name, std::size_t length, double *start, double *end, double defaultValue) {
-  if (start + length != end) {
-    throw eeros::Fault(std::string("Property '") + name + "': array length inconsistent");
-  }
-  auto k = properties.find(name);
-  if (k != properties.end()) {
-    throw eeros::Fault(std::string("Property '") + name + "' already added.");
-  }
-  properties[name] = ConfigPropertyAccessor {
-    [length, start] (std::string name, std::string& val) -> void {
-      std::stringstream ss;
-      for (std::size_t i = 0; i < length; i++) {
-        if (i != 0) ss << ", ";
-        ss << start[i];
-      }
-      val = ss.str();
+template <typename T>
+ConfigPropertyAccessor tableAccessor(std::string name, std::span<const T>& value,
+                                     std::function<const MappedTable&(std::string_view)> open) {
+  auto file = std::make_shared<std::string>();
+  return ConfigPropertyAccessor {
+    [file] (std::string& val) -> void {
+      val += *file;
     },
-    [length, start, defaultValue] (std::string name, std::string val) -> void {
-      std::size_t i = 0;
-      std::stringstream ss(std::move(val));
-      std::string el;
-      while (getline(ss, el, ',')) {
-        double v = std::stod(el);
-        start[i++] = v;
-      }
-      while (i < length) {
-        start[i++] = defaultValue;
+    [open, name, file, &value] (std::string_view val) -> void {
+      auto b = val.find_first_not_of(" \t\r");
+      auto e = val.find_last_not_of(" \t\r");
+      if (b == std::string_view::npos) {
+        throw eeros::Fault(std::string("Property '") + name + "': no table file");
       }
+      std::string_view path = val.substr(b, e + 1 - b);
+      value = open(path).template get<T>(name);
+      *file = path;
     }
   };
 }
 
-void Config::add(std::string name, std::string &value) {
+}
+
+void Config::addProperty(std::string name, ConfigPropertyAccessor accessor) {
   auto k = properties.find(name);
   if (k != properties.end()) {
     throw eeros::Fault(std::string("Property '") + name + "' already added.");
   }
-  properties[name] = ConfigPropertyAccessor {
-    [&value] (std::string name, std::string& val) -> void {
-      val = value;
+  properties.emplace(name, std::move(accessor));
+  names.push_back(std::move(name));
+}
+
+void Config::add(std::string name, int &v) {
+  addProperty(name, valueAccessor(name, v));
+}
+
+void Config::add(std::string name, double &v) {
+  addProperty(name, valueAccessor(name, v));
+}
+
+void Config::add(std::string name, std::size_t length, int *start, int *end, int defaultValue) {
+  if (start + length != end) {
+    throw eeros::Fault(std::string("Property '") + name + "': array length inconsistent");
+  }
+  addProperty(name, arrayAccessor(name, length, start, defaultValue));
+}
+
+void Config::add(std::string name, std::size_t length, double *start, double *end, double defaultValue) {
+  if (start + length != end) {
+    throw eeros::Fault(std::string("Property '") + name + "': array length inconsistent");
+  }
+  addProperty(name, arrayAccessor(name, length, start, defaultValue));
+}
+
+void Config::add(std::string name, std::vector<int> &v) {
+  addProperty(name, vectorAccessor(name, v));
+}
+
+void Config::add(std::string name, std::vector<double> &v) {
+  addProperty(name, vectorAccessor(name, v));
+}
+
+void Config::add(std::string name, std::span<const int32_t> &v) {
+  addProperty(name, tableAccessor(name, v, [this](std::string_view path) -> const MappedTable& {
+    return getTable(path);
+  }));
+}
+
+void Config::add(std::string name, std::span<const double> &v) {
+  addProperty(name, tableAccessor(name, v, [this](std::string_view path) -> const MappedTable& {
+    return getTable(path);
+  }));
+}
+
+const MappedTable& Config::getTable(std::string_view path) {
+  auto t = tables.find(path);
+  if (t == tables.end()) t = tables.emplace(std::string(path), std::make_unique<MappedTable>(std::string(path))).first;
+  return *t->second;
+}
+
+void Config::add(std::string name, std::string &value) {
+  addProperty(name, ConfigPropertyAccessor {
+    [&value] (std::string& val) -> void {
+      val += value;
     },
-    [&value] (std::string name, const std::string_view val) -> void {
-      if (val.size() > 0) value = val.substr(1,val.size() - 1);
+    [&value] (std::string_view val) -> void {
+      if (val.size() > 0) value = val.substr(1, val.size() - 1);
       else value = "";
     }
-  };
+  });
 }
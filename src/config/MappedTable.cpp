@@ -0,0 +1,160 @@
+#include <eeros/config/MappedTable.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace eeros;
+using namespace eeros::config;
+
+namespace {
+  constexpr char magic[8] = {'E', 'E', 'R', 'O', 'S', 'T', 'B', 'L'};
+  constexpr uint32_t byteOrder = 0x01020304;
+  constexpr uint64_t alignment = 64;
+
+  static_assert(sizeof(MappedTable::Header) == 64);
+  static_assert(sizeof(MappedTable::Entry) == 128);
+
+  uint64_t align(uint64_t n) {
+    return (n + alignment - 1) / alignment * alignment;
+  }
+
+  std::size_t sizeOf(MappedTable::Type type) {
+    switch (type) {
+      case MappedTable::Type::int32: return sizeof(int32_t);
+      case MappedTable::Type::float32: return sizeof(float);
+      case MappedTable::Type::float64: return sizeof(double);
+    }
+    return 0;
+  }
+}
+
+MappedTable::MappedTable(std::string path) : path(path), data(nullptr), size(0), entries(nullptr), nofTables(0) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) throw Fault("could not open table file '" + path + "'");
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header))) {
+    ::close(fd);
+    throw Fault("table file '" + path + "' is too short");
+  }
+  size = st.st_size;
+  void* p = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);  // the mapping keeps the file
+  if (p == MAP_FAILED) throw Fault("could not map table file '" + path + "'");
+  data = static_cast<const char*>(p);
+
+  const Header* h = reinterpret_cast<const Header*>(data);
+  const char* error = nullptr;
+  if (std::memcmp(h->magic, magic, sizeof(magic)) != 0) error = "is no table file";
+  else if (h->byteOrder != byteOrder) error = "has a different byte order";
+  else if (h->version != version) error = "has an unsupported version";
+  else if (sizeof(Header) + uint64_t(h->nofTables) * sizeof(Entry) > size) error = "is truncated";
+  if (error == nullptr) {
+    nofTables = h->nofTables;
+    entries = reinterpret_cast<const Entry*>(data + sizeof(Header));
+    for (uint32_t i = 0; i < nofTables && error == nullptr; i++) {
+      const Entry& e = entries[i];
+      std::size_t s = sizeOf(e.type);
+      if (s == 0 || e.rank > maxRank || e.name[maxNameLength] != '\0') error = "has an invalid table entry";
+      else if (e.offset % alignment != 0 || e.offset > size || e.count > (size - e.offset) / s) error = "is truncated";
+    }
+  }
+  if (error != nullptr) {
+    ::munmap(const_cast<char*>(data), size);
+    throw Fault("table file '" + path + "' " + error);
+  }
+}
+
+MappedTable::~MappedTable() {
+  ::munmap(const_cast<char*>(data), size);
+}
+
+bool MappedTable::has(std::string_view name) const {
+  for (uint32_t i = 0; i < nofTables; i++) {
+    if (name == entries[i].name) return true;
+  }
+  return false;
+}
+
+const MappedTable::Entry& MappedTable::find(std::string_view name) const {
+  for (uint32_t i = 0; i < nofTables; i++) {
+    if (name == entries[i].name) return entries[i];
+  }
+  throw Fault("table '" + std::string(name) + "' not found in '" + path + "'");
+}
+
+const MappedTable::Entry& MappedTable::find(std::string_view name, Type type) const {
+  const Entry& e = find(name);
+  if (e.type != type) throw Fault("table '" + std::string(name) + "' in '" + path + "' has another value type");
+  return e;
+}
+
+std::vector<uint32_t> MappedTable::getShape(std::string_view name) const {
+  const Entry& e = find(name);
+  return std::vector<uint32_t>(e.shape, e.shape + e.rank);
+}
+
+std::vector<std::string> MappedTable::getNames() const {
+  std::vector<std::string> names;
+  for (uint32_t i = 0; i < nofTables; i++) names.push_back(entries[i].name);
+  return names;
+}
+
+const std::string& MappedTable::getPath() const {
+  return path;
+}
+
+void MappedTable::Writer::add(std::string& name, Type type, const void* values, std::size_t count,
+                              std::size_t size, std::vector<uint32_t>& shape) {
+  if (name.empty() || name.size() > maxNameLength) throw Fault("invalid table name '" + name + "'");
+  for (auto& t : tables) {
+    if (t.name == name) throw Fault("table '" + name + "' already added");
+  }
+  if (shape.empty()) shape.push_back(count);
+  if (shape.size() > maxRank) throw Fault("table '" + name + "' has more than 4 dimensions");
+  uint64_t n = 1;
+  for (auto d : shape) n *= d;
+  if (n != count) throw Fault("shape of table '" + name + "' does not match the number of values");
+  auto bytes = static_cast<const char*>(values);
+  tables.push_back({name, type, shape, std::vector<char>(bytes, bytes + count * size), count});
+}
+
+bool MappedTable::Writer::save(std::string path) const {
+  std::vector<char> file(sizeof(Header) + tables.size() * sizeof(Entry));
+  Header h = {};
+  std::memcpy(h.magic, magic, sizeof(magic));
+  h.byteOrder = byteOrder;
+  h.version = version;
+  h.nofTables = tables.size();
+  std::memcpy(file.data(), &h, sizeof(h));
+  for (std::size_t i = 0; i < tables.size(); i++) {
+    const Table& t = tables[i];
+    Entry e = {};
+    std::memcpy(e.name, t.name.data(), t.name.size());
+    e.type = t.type;
+    e.rank = t.shape.size();
+    for (std::size_t d = 0; d < t.shape.size(); d++) e.shape[d] = t.shape[d];
+    e.offset = align(file.size());
+    e.count = t.count;
+    file.resize(e.offset);
+    file.insert(file.end(), t.bytes.begin(), t.bytes.end());
+    std::memcpy(file.data() + sizeof(Header) + i * sizeof(Entry), &e, sizeof(e));
+  }
+
+  std::string tmp = path + ".tmp";
+  int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0) return false;
+  std::size_t written = 0;
+  while (written < file.size()) {
+    ssize_t n = ::write(fd, file.data() + written, file.size() - written);
+    if (n <= 0) break;
+    written += n;
+  }
+  bool ok = (written == file.size()) && ::fsync(fd) == 0;
+  ok = (::close(fd) == 0) && ok;
+  if (ok) ok = (std::rename(tmp.c_str(), path.c_str()) == 0);
+  if (!ok) ::unlink(tmp.c_str());
+  return ok;
+}
@@ -0,0 +1,128 @@
+#include <eeros/control/BatchRunner.hpp>
+#include <eeros/core/System.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+using namespace eeros;
+using namespace eeros::control;
+
+void BatchInstance::addTimeDomain(TimeDomain& timeDomain) {
+  timeDomains.push_back(&timeDomain);
+}
+
+uint64_t BatchResult::getNofSamples() const {
+  return samples;
+}
+
+bool BatchResult::hasColumn(const std::string& name) const {
+  return columns.find(name) != columns.end();
+}
+
+const std::vector<double>& BatchResult::getColumn(const std::string& name) const {
+  return find(name).values;
+}
+
+double BatchResult::get(const std::string& name, uint64_t sample, unsigned int element) const {
+  const Data& d = find(name);
+  if (sample >= samples || element >= d.elements) throw Fault("sample out of range in batch result column '" + name + "'");
+  return d.values[sample * d.elements + element];
+}
+
+const BatchResult::Data& BatchResult::find(const std::string& name) const {
+  auto c = columns.find(name);
+  if (c == columns.end()) throw Fault("batch result has no column '" + name + "'");
+  return c->second;
+}
+
+BatchRunner::BatchRunner(double period, unsigned int threads)
+    : period(period), periodNs(static_cast<uint64_t>(std::llround(period * 1e9))), threads(threads) {
+  if (periodNs == 0) throw Fault("period of a batch runner must be at least 1 ns");
+  if (this->threads == 0) this->threads = std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+unsigned int BatchRunner::getNofThreads() const {
+  return threads;
+}
+
+std::vector<BatchResult> BatchRunner::run(unsigned int nofInstances, uint64_t steps, Factory factory, unsigned int recordEvery) {
+  std::vector<BatchResult> results(nofInstances);
+  std::atomic<unsigned int> next{0};
+  std::atomic<bool> failed{false};
+  std::exception_ptr error;
+  std::mutex errorMtx;
+  recordEvery = std::max(recordEvery, 1u);
+
+  auto worker = [&]() {
+    while (!failed.load(std::memory_order_relaxed)) {
+      unsigned int k = next.fetch_add(1, std::memory_order_relaxed);
+      if (k >= nofInstances) return;
+      try {
+        std::unique_ptr<BatchInstance> instance = factory(k);
+        if (!instance) throw Fault("batch runner factory returned no instance " + std::to_string(k));
+        runInstance(*instance, steps, recordEvery, results[k]);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(errorMtx);
+        if (!error) error = std::current_exception();
+        failed.store(true, std::memory_order_relaxed);
+      }
+    }
+  };
+
+  unsigned int n = std::min(threads, nofInstances);
+  std::vector<std::thread> workers;
+  for (unsigned int i = 1; i < n; i++) workers.emplace_back(worker);
+  if (n > 0) worker(); // the calling thread is a worker too
+  for (auto& w : workers) w.join();
+  if (error) std::rethrow_exception(error);
+  return results;
+}
+
+void BatchRunner::runInstance(BatchInstance& instance, uint64_t steps, unsigned int recordEvery, BatchResult& result) {
+  std::vector<uint64_t> ratio;
+  for (auto td : instance.timeDomains) {
+    double r = td->getPeriod() / period;
+    uint64_t q = std::llround(r);
+    if (q == 0 || std::fabs(r - q) > 1e-6 * r) {
+      throw Fault("period of time domain '" + td->getName() + "' is not a multiple of the batch runner period");
+    }
+    ratio.push_back(q);
+  }
+
+  std::vector<std::vector<double>*> dst;
+  uint64_t expected = steps / recordEvery;
+  BatchResult::Data& time = result.columns["time"];
+  time.elements = 1;
+  time.values.reserve(expected);
+  for (auto& c : instance.columns) {
+    if (result.columns.count(c->name) > 0) throw Fault("batch instance records column '" + c->name + "' twice");
+    BatchResult::Data& d = result.columns[c->name];
+    d.elements = c->elements;
+    d.values.reserve(expected * c->elements);
+    dst.push_back(&d.values);
+  }
+
+  for (uint64_t k = 1; k <= steps; k++) {
+    // the simulated time starts at one period, as a cycle timestamp of 0 means no cycle
+    uint64_t now = k * periodNs;
+    System::beginCycle(now);
+    try {
+      for (std::size_t i = 0; i < instance.timeDomains.size(); i++) {
+        if ((k - 1) % ratio[i] == 0) instance.timeDomains[i]->run();
+      }
+    } catch (...) {
+      System::endCycle();
+      throw;
+    }
+    System::endCycle();
+    if (k % recordEvery == 0) {
+      time.values.push_back(now / 1e9);
+      for (std::size_t c = 0; c < instance.columns.size(); c++) instance.columns[c]->sample(*dst[c]);
+      result.samples++;
+    }
+    if (instance.done()) break;
+  }
+}
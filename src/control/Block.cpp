@@ -8,4 +8,41 @@ void Block::setName(std::string name) {
 
 std::string Block::getName() const {
 	return name;
-}
\ No newline at end of file
+}
+std::vector<Block*> Block::getInputBlocks() {
+	return {};
+}
+
+bool Block::hasDirectFeedthrough() const {
+	return true;
+}
+
+bool Block::hasKnownInputs() const {
+	return false;
+}
+
+bool Block::areInputsConnected() const {
+	return true;
+}
+
+void Block::resolveInputs() { }
+
+std::vector<const eeros::control::SignalInterface*> Block::getInputSignals() {
+	return {};
+}
+
+bool Block::isSkippable() const {
+	return false;
+}
+
+bool Block::takeChanged() {
+	return changed.load(std::memory_order_relaxed) && changed.exchange(false, std::memory_order_relaxed);
+}
+
+void Block::setBound(bool bound) {
+	this->bound = bound;
+}
+
+bool Block::isBound() const {
+	return bound;
+}
@@ -0,0 +1,33 @@
+#include <eeros/control/BlockProfiler.hpp>
+
+using namespace eeros::control;
+
+void BlockProfiler::assign(const std::vector<Block*>& blocks) {
+  entries.clear();
+  entries.resize(blocks.size());
+  for (std::size_t i = 0; i < blocks.size(); i++) {
+    entries[i].block = blocks[i];
+    entries[i].name = blocks[i]->getName();
+  }
+}
+
+void BlockProfiler::reset() {
+  for (auto& e : entries) {
+    e.run.reset();
+    e.histogram.reset();
+  }
+}
+
+const std::vector<BlockProfiler::Entry>& BlockProfiler::getEntries() const {
+  return entries;
+}
+
+void BlockProfiler::log(logger::Logger& log) const {
+  for (auto& e : entries) {
+    if (e.run.count == 0) continue;
+    auto h = e.histogram.snapshot();
+    log.info() << "block '" << e.name << "': runs = " << e.run.count
+               << ", mean = " << e.run.mean * 1e6 << " us, min = " << e.run.min * 1e6
+               << " us, max = " << e.run.max * 1e6 << " us, p99 = " << h.percentile(0.99) * 1e6 << " us";
+  }
+}
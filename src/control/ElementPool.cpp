@@ -0,0 +1,56 @@
+#include <eeros/control/ElementPool.hpp>
+#include <eeros/core/Executor.hpp>
+#include <algorithm>
+
+using namespace eeros::control;
+
+namespace {
+  constexpr unsigned int lineElements = 8;   // doubles per cache line
+}
+
+ElementPool::ElementPool(std::vector<int> cpus, unsigned int grain)
+    : cpus(cpus), grain(std::max(grain, lineElements)), log(logger::Logger::getLogger()) { }
+
+ElementPool::~ElementPool() {
+  finished = true;
+  for (auto& h : helpers) h->wakeup.post();
+  for (auto& h : helpers) if (h->thread.joinable()) h->thread.join();
+}
+
+unsigned int ElementPool::getThreads() const {
+  return cpus.size() + 1;
+}
+
+unsigned int ElementPool::boundary(unsigned int part) const {
+  if (part >= parts) return elements;
+  unsigned int b = static_cast<unsigned int>(static_cast<uint64_t>(elements) * part / parts);
+  return b - b % lineElements;
+}
+
+void ElementPool::helperLoop(int index) {
+  if (!Executor::set_affinity({cpus[index]})) log.warn() << "element pool could not pin helper to cpu " << cpus[index];
+  auto& h = *helpers[index];
+  while (true) {
+    h.wakeup.wait();
+    if (finished) break;
+    job(context, boundary(index + 1), boundary(index + 2));
+    if (active.fetch_sub(1, std::memory_order_acq_rel) == 1) done.post();
+  }
+}
+
+void ElementPool::split(unsigned int n, Job job, void* context) {
+  for (size_t i = helpers.size(); i < cpus.size(); i++) {
+    helpers.push_back(std::make_unique<Helper>());
+    helpers.back()->thread = std::thread(&ElementPool::helperLoop, this, static_cast<int>(i));
+  }
+  this->job = job;
+  this->context = context;
+  elements = n;
+  parts = std::min<unsigned int>(helpers.size() + 1, n / grain);
+  // the split ends when all woken helpers are back, so no helper can reach into the next split
+  unsigned int woken = parts - 1;
+  active.store(woken, std::memory_order_release);
+  for (unsigned int h = 0; h < woken; h++) helpers[h]->wakeup.post();
+  job(context, 0, boundary(1));
+  if (woken > 0) done.wait();
+}
@@ -0,0 +1,37 @@
+#include <eeros/control/FaultSlot.hpp>
+#include <eeros/control/Block.hpp>
+
+using namespace eeros::control;
+
+namespace {
+
+thread_local FaultSlot* activeSlot = nullptr;
+
+}
+
+FaultSlot::Scope::Scope(FaultSlot& slot) : previous(activeSlot) {
+  activeSlot = &slot;
+}
+
+FaultSlot::Scope::~Scope() {
+  activeSlot = previous;
+}
+
+bool FaultSlot::report(Type type, const Block* block) {
+  FaultSlot* slot = activeSlot;
+  if (slot == nullptr) return false;
+  if (!slot->isSet()) {
+    slot->type = type;
+    slot->block = block;
+  }
+  return true;
+}
+
+std::string FaultSlot::getMessage() const {
+  std::string name = (block != nullptr) ? block->getName() : "";
+  switch (type) {
+    case Type::notConnected: return "Read from an unconnected input in block '" + name + "'";
+    case Type::nanOutput: return "NaN written to output '" + name + "', set to safe level if safe level is defined";
+    default: return "";
+  }
+}
@@ -0,0 +1,97 @@
+#include <eeros/control/JerkProfile.hpp>
+#include <algorithm>
+#include <cmath>
+
+using namespace eeros::control;
+
+namespace {
+
+constexpr int iterations = 52;   // resolution of the peak velocity, about 1e-15 * velMax
+
+struct State {
+  double p, v, a;
+};
+
+void step(State& s, double j, double t) {
+  s.p += t * (s.v + t * (s.a / 2 + t * j / 6));
+  s.v += t * (s.a + t * j / 2);
+  s.a += t * j;
+}
+
+// Fastest change from velocity v and acceleration a to velocity vt at rest (3 phases):
+// the acceleration is moved to a peak, possibly held at the limit and brought back to 0.
+template < typename Phase >
+void velocityChange(double v, double a, double vt, double accMax, double jerkMax, Phase* ph) {
+  a = std::clamp(a, -accMax, accMax);
+  double vStop = v + a * std::fabs(a) / (2 * jerkMax);   // velocity if the acceleration is brought to 0 now
+  double s = vt >= vStop ? 1 : -1;
+  double dv = vt - v;
+  double ap = s * std::sqrt(std::max(0.0, s * jerkMax * dv + a * a / 2));
+  double t2 = 0;
+  if (std::fabs(ap) > accMax) {
+    ap = s * accMax;
+    double j1 = ap >= a ? jerkMax : -jerkMax;
+    t2 = std::max(0.0, (dv - (ap * ap - a * a) / (2 * j1) - ap * ap / (2 * s * jerkMax)) / ap);
+  }
+  ph[0] = {ap >= a ? jerkMax : -jerkMax, std::fabs(ap - a) / jerkMax};
+  ph[1] = {0, t2};
+  ph[2] = {-s * jerkMax, std::fabs(ap) / jerkMax};
+}
+
+// Plans the phases over a peak velocity vp with cruise phase 3, returns the displacement without cruising.
+template < typename Phase >
+double displacement(const State& start, double vp, double accMax, double jerkMax, Phase* ph) {
+  velocityChange(start.v, start.a, vp, accMax, jerkMax, ph);
+  ph[3] = {0, 0};
+  velocityChange(vp, 0, 0, accMax, jerkMax, ph + 4);
+  State s = start;
+  for (int i = 0; i < 7; i++) step(s, ph[i].jerk, ph[i].duration);
+  return s.p - start.p;
+}
+
+}
+
+void JerkProfile::plan(double pos, double vel, double acc, double target, double velMax, double accMax, double jerkMax) {
+  this->pos = pos;
+  this->vel = vel;
+  this->acc = std::clamp(acc, -accMax, accMax);
+  State start{pos, vel, this->acc};
+  double distance = target - pos;
+  count = maxPhases;
+
+  // the direction of the peak velocity follows from where a braking axis would stop
+  double stop = displacement(start, 0, accMax, jerkMax, phase);
+  double dir = distance >= stop ? 1 : -1;
+  double high = dir * velMax;
+  double d = displacement(start, high, accMax, jerkMax, phase);
+  if (dir * (distance - d) >= 0) {
+    phase[3].duration = (distance - d) / high;   // the peak velocity is reached and held
+  } else {
+    // displacement grows with the peak velocity, the target lies between stop (vp = 0) and d (vp = high)
+    double low = 0;
+    for (int i = 0; i < iterations; i++) {
+      double mid = (low + high) / 2;
+      if (dir * (distance - displacement(start, mid, accMax, jerkMax, phase)) >= 0) low = mid;
+      else high = mid;
+    }
+    d = displacement(start, low, accMax, jerkMax, phase);
+    if (std::fabs(low) > 0) phase[3].duration = std::max(0.0, (distance - d) / low);
+  }
+  duration = 0;
+  for (int i = 0; i < count; i++) duration += phase[i].duration;
+}
+
+void JerkProfile::sample(double t, double& pos, double& vel, double& acc, double& jerk) const {
+  State s{this->pos, this->vel, this->acc};
+  jerk = 0;
+  for (int i = 0; i < count && t > 0; i++) {
+    double dt = std::min(t, phase[i].duration);
+    step(s, phase[i].jerk, dt);
+    if (dt > 0) jerk = phase[i].jerk;
+    t -= dt;
+  }
+  if (t > 0) jerk = 0;
+  pos = s.p;
+  vel = s.v;
+  acc = s.a;
+}
@@ -0,0 +1,363 @@
+#include <eeros/control/Recorder.hpp>
+#include <eeros/core/System.hpp>
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+using namespace eeros;
+using namespace eeros::control;
+
+namespace {
+
+uint64_t load(const char* p, uint32_t size) {
+  switch (size) {
+    case 1: { uint8_t v; std::memcpy(&v, p, 1); return v; }
+    case 2: { uint16_t v; std::memcpy(&v, p, 2); return v; }
+    case 4: { uint32_t v; std::memcpy(&v, p, 4); return v; }
+    default: { uint64_t v; std::memcpy(&v, p, 8); return v; }
+  }
+}
+
+void store(char* p, uint64_t w, uint32_t size) {
+  switch (size) {
+    case 1: { uint8_t v = w; std::memcpy(p, &v, 1); break; }
+    case 2: { uint16_t v = w; std::memcpy(p, &v, 2); break; }
+    case 4: { uint32_t v = w; std::memcpy(p, &v, 4); break; }
+    default: std::memcpy(p, &w, 8);
+  }
+}
+
+uint64_t mask(uint32_t size) {
+  return size >= 8 ? ~0ull : (1ull << (8 * size)) - 1;
+}
+
+// maps small negative and positive differences to small unsigned words
+uint64_t zigzag(uint64_t d, uint32_t size) {
+  int shift = 64 - 8 * size;
+  int64_t s = static_cast<int64_t>(d << shift) >> shift;
+  return ((static_cast<uint64_t>(s) << 1) ^ static_cast<uint64_t>(s >> 63)) & mask(size);
+}
+
+uint64_t unzigzag(uint64_t z) {
+  return (z >> 1) ^ (0 - (z & 1));
+}
+
+size_t maxEncodedSize(size_t len) {
+  return len + len / 128 + 2;
+}
+
+// a control byte c < 128 is followed by c + 1 literal bytes, otherwise by one byte repeated (c & 0x7F) + 3 times
+size_t runLengthEncode(const uint8_t* s, size_t len, uint8_t* d) {
+  size_t o = 0, i = 0, lit = 0;
+  auto literals = [&](size_t end) {
+    while (lit < end) {
+      size_t k = std::min<size_t>(end - lit, 128);
+      d[o++] = k - 1;
+      std::memcpy(d + o, s + lit, k);
+      o += k;
+      lit += k;
+    }
+  };
+  while (i < len) {
+    size_t r = 1;
+    while (i + r < len && r < 130 && s[i + r] == s[i]) r++;
+    if (r >= 3) {
+      literals(i);
+      d[o++] = 0x80 | (r - 3);
+      d[o++] = s[i];
+      i += r;
+      lit = i;
+    } else {
+      i++;
+    }
+  }
+  literals(len);
+  return o;
+}
+
+bool runLengthDecode(const uint8_t* s, size_t size, uint8_t* d, size_t len) {
+  size_t i = 0, o = 0;
+  while (i < size) {
+    uint8_t c = s[i++];
+    if (c < 128) {
+      size_t k = c + 1;
+      if (i + k > size || o + k > len) return false;
+      std::memcpy(d + o, s + i, k);
+      i += k;
+      o += k;
+    } else {
+      size_t r = (c & 0x7F) + 3;
+      if (i >= size || o + r > len) return false;
+      std::memset(d + o, s[i++], r);
+      o += r;
+    }
+  }
+  return o == len;
+}
+
+// byte b of element e of sample i is stored at planes[(b * elements + e) * n + i]
+size_t encodeColumn(const RecorderColumn& column, uint32_t n, const char* src, uint8_t* planes, uint8_t* dst) {
+  uint32_t size = column.elementSize;
+  uint32_t elements = column.rows * column.cols;
+  for (uint32_t e = 0; e < elements; e++) {
+    uint64_t prev = 0;
+    for (uint32_t i = 0; i < n; i++) {
+      uint64_t w = load(src + (i * elements + e) * size, size);
+      uint64_t t = column.elementType == 2 ? w ^ prev : zigzag(w - prev, size);
+      prev = w;
+      for (uint32_t b = 0; b < size; b++) planes[(b * elements + e) * n + i] = t >> (8 * b);
+    }
+  }
+  return runLengthEncode(planes, static_cast<size_t>(n) * elements * size, dst);
+}
+
+}
+
+namespace eeros {
+namespace control {
+
+bool decodeRecorderColumn(const RecorderColumn& column, uint32_t n, const void* src, size_t size, void* dst) {
+  uint32_t s = column.elementSize;
+  uint32_t elements = column.rows * column.cols;
+  if (s != 1 && s != 2 && s != 4 && s != 8) return false;
+  std::vector<uint8_t> planes(static_cast<size_t>(n) * elements * s);
+  if (!runLengthDecode(static_cast<const uint8_t*>(src), size, planes.data(), planes.size())) return false;
+  char* d = static_cast<char*>(dst);
+  for (uint32_t e = 0; e < elements; e++) {
+    uint64_t prev = 0;
+    for (uint32_t i = 0; i < n; i++) {
+      uint64_t t = 0;
+      for (uint32_t b = 0; b < s; b++) t |= static_cast<uint64_t>(planes[(b * elements + e) * n + i]) << (8 * b);
+      uint64_t w = (column.elementType == 2 ? t ^ prev : prev + unzigzag(t)) & mask(s);
+      store(d + (i * elements + e) * s, w, s);
+      prev = w;
+    }
+  }
+  return true;
+}
+
+}
+}
+
+Recorder::Recorder(uint32_t chunkLength) : chunkLength((std::max(chunkLength, 1u) + 7) / 8 * 8), sampleBytes(0) {
+  timeColumn = RecorderColumn{};
+  std::strncpy(timeColumn.name, "time", sizeof(timeColumn.name) - 1);
+  timeColumn.rows = 1;
+  timeColumn.cols = 1;
+  timeColumn.elementSize = sizeof(timestamp_t);
+  timeColumn.elementType = 0;
+  sampleBytes = sizeof(timestamp_t);
+  allocate();
+}
+
+Recorder::~Recorder() {
+  delete[] buf[0];
+  delete[] buf[1];
+}
+
+void Recorder::addColumn(std::unique_ptr<Column> column, const RecorderColumn& desc) {
+  if (hasWriter || running.load(std::memory_order_relaxed) || fill > 0) {
+    throw Fault("outputs must be added to recorder '" + getName() + "' before recording");
+  }
+  column->desc = desc;
+  column->sampleSize = desc.rows * desc.cols * desc.elementSize;
+  column->offset = sampleBytes;
+  sampleBytes += column->sampleSize;
+  columns.push_back(std::move(column));
+  allocate();
+}
+
+void Recorder::allocate() {
+  for (int c = 0; c < 2; c++) {
+    delete[] buf[c];
+    buf[c] = new char[chunkLength * sampleBytes]();
+  }
+}
+
+void Recorder::run() {
+  if (!running.load(std::memory_order_relaxed)) {
+    if (fill > 0) publish();
+    return;
+  }
+  if (full[active].load(std::memory_order_acquire)) {
+    overruns.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  char* chunk = buf[active];
+  timestamp_t now = System::getTimeNs();
+  std::memcpy(chunk + fill * sizeof(timestamp_t), &now, sizeof(now));
+  for (auto& c : columns) c->sample(chunk + chunkLength * c->offset + fill * c->sampleSize);
+  if (++fill == chunkLength) publish();
+}
+
+void Recorder::publish() {
+  len[active] = fill;
+  full[active].store(true, std::memory_order_release);
+  ready.post();
+  fill = 0;
+  active ^= 1;
+}
+
+void Recorder::enable() {
+  running.store(true, std::memory_order_relaxed);
+}
+
+void Recorder::disable() {
+  running.store(false, std::memory_order_relaxed);
+}
+
+unsigned int Recorder::getNofColumns() const {
+  return columns.size() + 1;
+}
+
+uint32_t Recorder::getChunkLength() const {
+  return chunkLength;
+}
+
+uint64_t Recorder::getOverruns() const {
+  return overruns.load(std::memory_order_relaxed);
+}
+
+namespace eeros {
+namespace control {
+
+std::ostream& operator<<(std::ostream& os, Recorder& recorder) {
+  os << "Block recorder: '" << recorder.getName() << "' with " << recorder.getNofColumns() << " columns";
+  os << ", chunks of " << recorder.chunkLength << " samples, overruns=" << recorder.getOverruns();
+  return os;
+}
+
+}
+}
+
+RecorderWriter::RecorderWriter(Recorder& recorder, std::string fileName, bool compress)
+    : recorder(recorder), fileName(fileName), log(logger::Logger::getLogger()), compress(compress) {
+  fd = ::open(fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) throw Fault("could not open recorder file " + fileName);
+  recorder.hasWriter = true;
+  RecorderHeader header{};
+  std::memcpy(header.magic, "EERC", 4);
+  header.version = compress ? 2 : 1;
+  header.nofColumns = recorder.getNofColumns();
+  header.chunkLength = recorder.chunkLength;
+  writeAll(&header, sizeof(header));
+  writeAll(&recorder.timeColumn, sizeof(RecorderColumn));
+  for (auto& c : recorder.columns) writeAll(&c->desc, sizeof(RecorderColumn));
+  if (compress) {
+    // buffers for the largest chunk, the writer thread does not allocate
+    size_t size = 8 + 4 * recorder.getNofColumns() + maxEncodedSize(recorder.chunkLength * sizeof(timestamp_t));
+    size_t largest = sizeof(timestamp_t);
+    for (auto& c : recorder.columns) {
+      size += 4 + maxEncodedSize(recorder.chunkLength * c->sampleSize);
+      largest = std::max<size_t>(largest, c->sampleSize);
+    }
+    encoded.resize(size);
+    planes.resize(recorder.chunkLength * largest);
+  }
+  thread = std::thread([this]() { loop(); });
+}
+
+RecorderWriter::~RecorderWriter() {
+  stop();
+}
+
+void RecorderWriter::stop() {
+  stopping.store(true, std::memory_order_relaxed);
+  recorder.ready.post();
+  if (thread.joinable()) thread.join();
+  if (fd >= 0) {
+    ::close(fd);
+    fd = -1;
+    log.info() << "recorder file " << fileName << " written, " << samples << " samples";
+  }
+}
+
+uint64_t RecorderWriter::getNofSamples() const {
+  return samples;
+}
+
+uint64_t RecorderWriter::getNofBytes() const {
+  return bytes;
+}
+
+void RecorderWriter::loop() {
+  while (!stopping.load(std::memory_order_relaxed)) {
+    recorder.ready.wait(0.1);
+    drain();
+  }
+  drain();
+}
+
+// writes the full chunks in the order they were handed over
+void RecorderWriter::drain() {
+  std::vector<struct iovec> iov(recorder.columns.size() + 2);
+  while (recorder.full[next].load(std::memory_order_acquire)) {
+    uint32_t n = recorder.len[next];
+    char* chunk = recorder.buf[next];
+    if (compress) {
+      writeCompressed(chunk, n);
+      samples += n;
+      recorder.full[next].store(false, std::memory_order_release);
+      next ^= 1;
+      continue;
+    }
+    uint32_t count[2] = {n, 0};
+    iov[0] = {count, sizeof(count)};
+    iov[1] = {chunk, n * sizeof(timestamp_t)};
+    for (size_t i = 0; i < recorder.columns.size(); i++) {
+      auto& c = recorder.columns[i];
+      iov[i + 2] = {chunk + recorder.chunkLength * c->offset, n * c->sampleSize};
+    }
+    ssize_t total = 0;
+    for (auto& v : iov) total += v.iov_len;
+    bytes += total;
+    ssize_t written = ::writev(fd, iov.data(), iov.size());
+    if (written != total) {
+      // write the rest after a short write
+      if (written < 0) written = 0;
+      for (auto& v : iov) {
+        size_t skip = std::min(static_cast<size_t>(written), v.iov_len);
+        writeAll(static_cast<char*>(v.iov_base) + skip, v.iov_len - skip);
+        written -= skip;
+      }
+    }
+    samples += n;
+    recorder.full[next].store(false, std::memory_order_release);
+    next ^= 1;
+  }
+}
+
+void RecorderWriter::writeCompressed(const char* chunk, uint32_t n) {
+  uint32_t nofColumns = recorder.getNofColumns();
+  char* out = encoded.data();
+  uint8_t* planes = reinterpret_cast<uint8_t*>(this->planes.data());
+  uint8_t* dst = reinterpret_cast<uint8_t*>(out + 8 + 4 * nofColumns);
+  uint32_t size = encodeColumn(recorder.timeColumn, n, chunk, planes, dst);
+  std::memcpy(out + 8, &size, 4);
+  dst += size;
+  for (uint32_t i = 1; i < nofColumns; i++) {
+    auto& c = recorder.columns[i - 1];
+    size = encodeColumn(c->desc, n, chunk + recorder.chunkLength * c->offset, planes, dst);
+    std::memcpy(out + 8 + 4 * i, &size, 4);
+    dst += size;
+  }
+  uint32_t total = reinterpret_cast<char*>(dst) - out;
+  uint32_t count[2] = {n, total - 8};
+  std::memcpy(out, count, sizeof(count));
+  writeAll(out, total);
+  bytes += total;
+}
+
+void RecorderWriter::writeAll(const void* p, size_t n) {
+  const char* c = static_cast<const char*>(p);
+  while (n > 0) {
+    ssize_t w = ::write(fd, c, n);
+    if (w <= 0) {
+      log.error() << "writing recorder file " << fileName << " failed";
+      return;
+    }
+    c += w;
+    n -= w;
+  }
+}
@@ -1,7 +0,0 @@
-#include <eeros/types.hpp>
-
-namespace eeros {
-	namespace control {
-		uint16_t signalCounter = 1;
-	};
-};
@@ -0,0 +1,73 @@
+#include <eeros/control/SignalRegistry.hpp>
+#include <mutex>
+
+using namespace eeros::control;
+
+SignalRegistry::SignalRegistry() : nextId(startSignalId) { }
+
+SignalRegistry& SignalRegistry::instance() {
+  // never destroyed, so that static signals can still remove themselves at exit
+  static SignalRegistry* registry = new SignalRegistry();
+  return *registry;
+}
+
+sigid_t SignalRegistry::add(SignalInterface* signal) {
+  sigid_t id = nextId.fetch_add(1, std::memory_order_relaxed);
+  std::unique_lock<std::shared_mutex> lock(mtx);
+  byId[id] = Entry{signal, ""};
+  return id;
+}
+
+void SignalRegistry::remove(sigid_t id) {
+  std::unique_lock<std::shared_mutex> lock(mtx);
+  auto s = byId.find(id);
+  if (s == byId.end()) return;
+  if (!s->second.name.empty()) {
+    auto n = byName.find(s->second.name);
+    if (n != byName.end() && n->second == s->second.signal) byName.erase(n);
+  }
+  byId.erase(s);
+}
+
+void SignalRegistry::setName(sigid_t id, const std::string& name) {
+  std::unique_lock<std::shared_mutex> lock(mtx);
+  auto s = byId.find(id);
+  if (s == byId.end()) return;
+  if (!s->second.name.empty()) {
+    auto n = byName.find(s->second.name);
+    if (n != byName.end() && n->second == s->second.signal) byName.erase(n);
+  }
+  s->second.name = name;
+  if (!name.empty()) byName.emplace(name, s->second.signal);
+}
+
+std::string SignalRegistry::getName(sigid_t id) const {
+  std::shared_lock<std::shared_mutex> lock(mtx);
+  auto s = byId.find(id);
+  return (s != byId.end()) ? s->second.name : std::string();
+}
+
+SignalInterface* SignalRegistry::get(sigid_t id) const {
+  std::shared_lock<std::shared_mutex> lock(mtx);
+  auto s = byId.find(id);
+  return (s != byId.end()) ? s->second.signal : nullptr;
+}
+
+SignalInterface* SignalRegistry::get(const std::string& name) const {
+  std::shared_lock<std::shared_mutex> lock(mtx);
+  auto n = byName.find(name);
+  return (n != byName.end()) ? n->second : nullptr;
+}
+
+std::vector<SignalInterface*> SignalRegistry::getSignals() const {
+  std::shared_lock<std::shared_mutex> lock(mtx);
+  std::vector<SignalInterface*> signals;
+  signals.reserve(byId.size());
+  for (auto& s : byId) signals.push_back(s.second.signal);
+  return signals;
+}
+
+std::size_t SignalRegistry::size() const {
+  std::shared_lock<std::shared_mutex> lock(mtx);
+  return byId.size();
+}
@@ -0,0 +1,34 @@
+#include <eeros/control/SignalSnapshot.hpp>
+#include <thread>
+
+using namespace eeros::control;
+
+void SignalSnapshot::capture() {
+  uint64_t s = sequence.load(std::memory_order_relaxed);
+  sequence.store(s + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  unsigned char* data = buffer.data();
+  for (auto& c : copies) c.copy(c.signal, data + c.offset);
+  sequence.store(s + 2, std::memory_order_release);
+}
+
+bool SignalSnapshot::read(View& view, unsigned int tries) const {
+  view.data.resize(buffer.size());
+  for (unsigned int i = 0; i < tries; i++) {
+    uint64_t before = sequence.load(std::memory_order_acquire);
+    if ((before & 1) == 0) {
+      std::memcpy(view.data.data(), buffer.data(), buffer.size());
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence.load(std::memory_order_relaxed) == before) {
+        view.cycle = before / 2;
+        return true;
+      }
+    }
+    std::this_thread::yield();
+  }
+  return false;
+}
+
+uint64_t SignalSnapshot::getCycle() const {
+  return sequence.load(std::memory_order_acquire) / 2;
+}
@@ -0,0 +1,144 @@
+#include <eeros/control/SocketMessage.hpp>
+#include <eeros/sockets/SocketServer.hpp>
+#include <algorithm>
+
+using namespace eeros;
+using namespace eeros::control;
+using namespace eeros::sockets;
+
+SocketMessage::SocketMessage(std::string serverIP, uint16_t port, double period, double timeout, SocketOptions options)
+    : serverIP(serverIP), port(port), period(period), timeout(timeout), options(options), log(logger::Logger::getLogger()) { }
+
+SocketMessage::~SocketMessage() {
+  running = false;
+  if (connections) connections->wake();
+  if (stream) stream->wake();
+  if (thread.joinable()) thread.join();
+}
+
+void SocketMessage::start() {
+  if (started) return;
+  std::vector<uint8_t> tx(sizeof(MessageHeader) + txSchema.getPayloadSize(), 0);
+  Message::writeHeader(tx.data(), txSchema, 0, 0);
+  txBuf.reset(new TripleBuffer<std::vector<uint8_t>>(tx));
+  rxBuf.reset(new TripleBuffer<std::vector<uint8_t>>(std::vector<uint8_t>(sizeof(MessageHeader) + rxSchema.getPayloadSize(), 0)));
+  // messages are sent every period even without payload, so the peer always sends frames
+  std::size_t maxFrameSize = sizeof(MessageHeader) + std::max(rxSchema.getPayloadSize(), Message::maxPayloadSize);
+  if (serverIP.empty()) {
+    connections.reset(new ServerConnections(port, maxFrameSize, period, timeout, 8, options));
+    connections->setFraming(Message::framing(rxSchema.getPayloadSize()));
+  } else {
+    stream.reset(new ClientConnection(serverIP, port, maxFrameSize, period, timeout, options));
+    stream->setFraming(Message::framing(rxSchema.getPayloadSize()));
+  }
+  started = true;
+  running = true;
+  thread = std::thread([this]() { loop(); });
+}
+
+void SocketMessage::run() {
+  if (!started) throw Fault("socket message block '" + getName() + "' not started");
+  timestamp_t time = System::getTimeNs();
+  // receive
+  const auto& rx = rxBuf->read();
+  for (auto& o : outputs) o->decode(rx.data(), time);
+  // send
+  auto& tx = txBuf->writeBuffer();
+  for (auto& i : inputs) i->encode(tx.data());
+  Message::writeHeader(tx.data(), txSchema, ++txSequence, time);
+  txBuf->publish();
+  if (options.sendOnUpdate) {
+    if (connections) connections->wake(); else stream->wake();
+  }
+}
+
+bool SocketMessage::hasDirectFeedthrough() const {
+  return false;
+}
+
+std::vector<Block*> SocketMessage::getInputBlocks() {
+  std::vector<Block*> blocks;
+  for (auto& i : inputs) {
+    Block* b = i->getConnectedBlock();
+    if (b != nullptr) blocks.push_back(b);
+  }
+  return blocks;
+}
+
+bool SocketMessage::hasKnownInputs() const {
+  return true;
+}
+
+bool SocketMessage::isConnected() {
+  return connected;
+}
+
+uint64_t SocketMessage::getSequence() {
+  return sequence.load(std::memory_order_acquire);
+}
+
+bool SocketMessage::isNew() {
+  return getSequence() != seen;
+}
+
+void SocketMessage::resetNew() {
+  seen = getSequence();
+}
+
+uint64_t SocketMessage::getInvalid() {
+  return invalid;
+}
+
+uint64_t SocketMessage::getTimestamp() {
+  return timestamp;
+}
+
+const MessageSchema& SocketMessage::getSendSchema() const {
+  return txSchema;
+}
+
+const MessageSchema& SocketMessage::getReceiveSchema() const {
+  return rxSchema;
+}
+
+void SocketMessage::received(const uint8_t* frame) {
+  if (!Message::matches(frame, rxSchema)) {
+    if (invalid.fetch_add(1) == 0) log.warn() << "socket message block '" << getName() << "' received a message of another schema";
+    return;
+  }
+  auto& rx = rxBuf->writeBuffer();
+  std::memcpy(rx.data(), frame, rx.size());
+  rxBuf->publish();
+  timestamp = Message::readHeader(frame).timestamp;
+  sequence.fetch_add(1, std::memory_order_release);
+}
+
+void SocketMessage::clear() {
+  rxBuf->writeBuffer().assign(rxBuf->writeBuffer().size(), 0);
+  rxBuf->publish();
+  sequence.fetch_add(1, std::memory_order_release);
+}
+
+void SocketMessage::loop() {
+  if (!setThreadPriority(5)) log.error() << "could not set realtime priority";
+  SendSchedule schedule(options.sendOnUpdate);
+  auto onFrame = [this](const uint8_t* frame) { received(frame); };
+  while (running) {
+    if (stream && !stream->isConnected()) {
+      if (!stream->connect()) {
+        stream->poll(onFrame);   // retry in the next period
+        continue;
+      }
+      log.info() << "Client connected to ip=" << serverIP;
+    }
+    PollResult r = connections ? connections->poll(onFrame) : stream->poll(onFrame);
+    bool c = connections ? connections->getNofClients() > 0 : stream->isConnected();
+    if (!c && connected) clear();   // if disconnected clear the outputs
+    connected = c;
+    bool due = schedule.due(r);
+    if (!c || !due) continue;
+    const auto& tx = txBuf->read();
+    if (connections) connections->broadcast(tx.data(), tx.size());
+    else stream->send(tx.data(), tx.size());
+  }
+}
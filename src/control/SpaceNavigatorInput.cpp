@@ -10,22 +10,23 @@ SpaceNavigatorInput::SpaceNavigatorInput(std::string dev, int priority) : sn(dev
 SpaceNavigatorInput::~SpaceNavigatorInput() { }
 
 void SpaceNavigatorInput::run() {
+	auto current = sn.current.read();
 	out.getSignal().setValue(Matrix<SPACENAVIGATOR_AXIS_COUNT>{
-		sn.current.axis[SpaceNav::Axis::X],
-		sn.current.axis[SpaceNav::Axis::Y],
-		sn.current.axis[SpaceNav::Axis::Z],
+		current.axis[SpaceNav::Axis::X],
+		current.axis[SpaceNav::Axis::Y],
+		current.axis[SpaceNav::Axis::Z],
 	});	
 	uint64_t ts = eeros::System::getTimeNs();
 	out.getSignal().setTimestamp(ts);
 	rotOut.getSignal().setValue(Matrix<SPACENAVIGATOR_ROT_AXIS_COUNT>{
-		sn.current.rotAxis[SpaceNav::RotAxis::RX],
-		sn.current.rotAxis[SpaceNav::RotAxis::RY],
-		sn.current.rotAxis[SpaceNav::RotAxis::RZ],
+		current.rotAxis[SpaceNav::RotAxis::RX],
+		current.rotAxis[SpaceNav::RotAxis::RY],
+		current.rotAxis[SpaceNav::RotAxis::RZ],
 	});	
 	rotOut.getSignal().setTimestamp(ts);
 	buttonOut.getSignal().setValue(Matrix<SPACENAVIGATOR_BUTTON_COUNT,1,bool>{
-		sn.current.button[SpaceNav::Button::L],
-		sn.current.button[SpaceNav::Button::R]
+		current.button[SpaceNav::Button::L],
+		current.button[SpaceNav::Button::R]
 	});
 	buttonOut.getSignal().setTimestamp(ts);
 }
@@ -1,7 +1,28 @@
 #include <eeros/control/TimeDomain.hpp>
+#include <eeros/core/System.hpp>
+#include <eeros/core/Fault.hpp>
+#include <eeros/core/TaskTrace.hpp>
+#include <eeros/core/Tracepoint.hpp>
+#include <eeros/core/Wcet.hpp>
+#include <algorithm>
+#include <map>
+#include <typeindex>
 
 using namespace eeros::control;
 
+namespace {
+
+// ends the cycle also if a block throws
+class CycleGuard {
+ public:
+  CycleGuard(bool enable) : started(enable && eeros::System::beginCycle()) { }
+  ~CycleGuard() { if (started) eeros::System::endCycle(); }
+ private:
+  bool started;
+};
+
+}
+
 TimeDomain::TimeDomain(std::string name, double period, bool realtime) 
     : name(name), period(period), realtime(realtime), safetySystem(nullptr), safetyEvent(nullptr) { }
 
@@ -17,29 +38,129 @@ bool TimeDomain::getRealtime() {
   return realtime;
 }
 
+eeros::Arena& TimeDomain::getArena() {
+  return arena;
+}
+
 void TimeDomain::registerSafetyEvent(SafetySystem& ss, SafetyEvent& e) {
   safetySystem = &ss;
   safetyEvent = &e;
 }
 
+void TimeDomain::setCycleTimestamp(bool enable) {
+  cycleTimestamp = enable;
+}
+
+bool TimeDomain::getCycleTimestamp() {
+  return cycleTimestamp;
+}
+
 void TimeDomain::run() {
   if(!running) return;
+  CycleGuard cycle(cycleTimestamp);
+  EEROS_TRACE2(timedomain_begin, this, name.c_str());
+  TaskTrace::begin(name.c_str(), "timedomain");
+  if (!validated) validate();
+  if (frozen && !packed) pack();
+  if (!flattened) flatten();
+  const std::vector<Block*>& list = flatList;
+  FaultSlot::Scope scope(fault);
+  fault.clear();
   try {
-    for(auto block : blocks) block->run();
+    if (profiling) runProfiled(list);
+    else {
+      for (std::size_t i = 0; i < list.size(); i++) {
+        Block* block = list[i];
+        if (changePropagation && isUnchanged(i)) continue;
+        EEROS_TRACE_BLOCK1(block_begin, block);
+        {
+          EEROS_WCET_SCOPE(wcetProbes[i]);
+          block->run();
+        }
+        EEROS_TRACE_BLOCK1(block_end, block);
+        if (fault.isSet()) break;
+      }
+    }
   } catch (NotConnectedFault const& e) {
-    if(safetySystem != nullptr && safetyEvent != nullptr) {
-      safetySystem->triggerEvent(*safetyEvent);
-      safetySystem->log.error() << e.what();
-    } else throw eeros::Fault(std::string(e.what()) + ", time domain cannot trigger safety event");
+    raise(e.what());
   } catch (NaNOutputFault const& e) {
-    if(safetySystem != nullptr && safetyEvent != nullptr) {
-      safetySystem->triggerEvent(*safetyEvent);
-      safetySystem->log.error() << e.what();
-    } else throw eeros::Fault(std::string(e.what()) + ", time domain cannot trigger safety event");
+    raise(e.what());
+  }
+  if (snapshot != nullptr) snapshot->capture();
+  EEROS_TRACE1(timedomain_end, this);
+  TaskTrace::end(name.c_str(), "timedomain");
+  if (fault.isSet()) raise(fault.getMessage());
+}
+
+void TimeDomain::raise(const std::string& message) {
+  if(safetySystem != nullptr && safetyEvent != nullptr) {
+    safetySystem->triggerEvent(*safetyEvent);
+    EEROS_HOTPATH_LOG(safetySystem->log.error() << message);
+  } else throw eeros::Fault(message + ", time domain cannot trigger safety event");
+}
+
+void TimeDomain::runProfiled(const std::vector<Block*>& list) {
+  if (!profiled) {
+    profiler.assign(list);
+    profiled = true;
   }
+  uint64_t start = eeros::System::getClockNs();
+  for (std::size_t i = 0; i < list.size(); i++) {
+    if (changePropagation && isUnchanged(i)) continue;
+    EEROS_TRACE_BLOCK1(block_begin, list[i]);
+    {
+      EEROS_WCET_SCOPE(wcetProbes[i]);
+      list[i]->run();
+    }
+    EEROS_TRACE_BLOCK1(block_end, list[i]);
+    uint64_t end = eeros::System::getClockNs();
+    profiler.record(i, end - start);
+    start = end;
+    if (fault.isSet()) break;
+  }
+}
+
+bool TimeDomain::isUnchanged(std::size_t index) {
+  // the versions are updated before the block runs, so writes during its run are seen next cycle
+  Block* block = flatList[index];
+  Watch& w = watches[index];
+  if (!w.known || !block->isBound()) return false;
+  bool changed = block->takeChanged();
+  for (std::size_t k = w.first; k < w.first + w.count; k++) {
+    uint64_t v = versions[k].first->getVersion();
+    if (v != versions[k].second) {
+      versions[k].second = v;
+      changed = true;
+    }
+  }
+  return !changed && block->isSkippable();
+}
+
+void TimeDomain::setChangePropagation(bool enable) {
+  changePropagation = enable;
+  flattened = false;
+}
+
+bool TimeDomain::getChangePropagation() {
+  return changePropagation;
+}
+
+void TimeDomain::setSnapshot(SignalSnapshot* snapshot) {
+  this->snapshot = snapshot;
+}
+
+void TimeDomain::setProfiling(bool enable) {
+  profiling = enable;
+}
+
+BlockProfiler& TimeDomain::getProfiler() {
+  return profiler;
 }
 
 void TimeDomain::start() {
+  validate();
+  if (frozen && !packed) pack();
+  flatten();
   running = true;
 }
 
@@ -49,23 +170,232 @@ void TimeDomain::stop() {
 
 void TimeDomain::addBlock(Block* block) {
   blocks.push_back(block);
+  packed = false;
+  profiled = false;
+  flattened = false;
+  validated = false;
 }
 
 void TimeDomain::addBlock(Block& block) {
-  blocks.push_back(&block);
+  addBlock(&block);
 }
 
 void TimeDomain::removeBlock(Block* block) {
-  blocks.remove(block);
+  blocks.erase(std::remove(blocks.begin(), blocks.end(), block), blocks.end());
+  packed = false;
+  profiled = false;
+  flattened = false;
+  validated = false;
 }
 
 void TimeDomain::removeBlock(Block& block) {
-  blocks.remove(&block);
+  removeBlock(&block);
 }
 
-// void TimeDomain::sortBlocks() {
-// 	// TODO
-// }
+void TimeDomain::addFusedBlock(FusedBlockBase& block) {
+  fusedBlocks.push_back(&block);
+  packed = false;
+  profiled = false;
+  flattened = false;
+}
+
+void TimeDomain::removeFusedBlock(FusedBlockBase& block) {
+  fusedBlocks.erase(std::remove(fusedBlocks.begin(), fusedBlocks.end(), &block), fusedBlocks.end());
+  packed = false;
+  profiled = false;
+  flattened = false;
+}
+
+void TimeDomain::sortBlocks() {
+  // Kahn's algorithm, among the ready blocks the one added first is taken
+  size_t n = blocks.size();
+  std::map<Block*, size_t> index;
+  for (size_t i = 0; i < n; i++) index[blocks[i]] = i;
+  std::vector<std::vector<size_t>> successors(n);
+  std::vector<size_t> inDegree(n, 0);
+  for (size_t i = 0; i < n; i++) {
+    for (auto pred : blocks[i]->getInputBlocks()) {
+      auto it = index.find(pred);
+      if (it == index.end() || it->second == i) continue; // outside of this time domain or self loop
+      successors[it->second].push_back(i);
+      inDegree[i]++;
+    }
+  }
+  std::vector<Block*> sorted;
+  std::vector<bool> placed(n, false);
+  sorted.reserve(n);
+  while (sorted.size() < n) {
+    size_t next = n;
+    for (size_t i = 0; i < n; i++) {
+      if (!placed[i] && inDegree[i] == 0) { next = i; break; }
+    }
+    if (next == n) {
+      // only loops and the blocks behind them left, break a loop at its first block without direct feedthrough
+      std::vector<bool> onLoop(n, false);
+      for (size_t i = 0; i < n; i++) {
+        if (placed[i]) continue;
+        // a block is on a loop, if it can be reached from itself
+        std::vector<bool> reached(n, false);
+        std::vector<size_t> open(successors[i]);
+        while (!open.empty() && !onLoop[i]) {
+          size_t j = open.back();
+          open.pop_back();
+          if (placed[j] || reached[j]) continue;
+          reached[j] = true;
+          if (j == i) onLoop[i] = true;
+          else open.insert(open.end(), successors[j].begin(), successors[j].end());
+        }
+      }
+      for (size_t i = 0; i < n; i++) {
+        if (onLoop[i] && !blocks[i]->hasDirectFeedthrough()) { next = i; break; }
+      }
+      if (next == n) {
+        std::string loop;
+        for (size_t i = 0; i < n; i++) if (onLoop[i]) loop += " '" + blocks[i]->getName() + "'";
+        throw Fault("blocks in time domain '" + name + "' form a loop without delay:" + loop);
+      }
+    }
+    placed[next] = true;
+    sorted.push_back(blocks[next]);
+    for (auto s : successors[next]) if (inDegree[s] > 0) inDegree[s]--;
+  }
+  blocks = sorted;
+  packed = false;
+  profiled = false;
+  flattened = false;
+}
+
+std::vector<Block*> TimeDomain::validate() {
+  std::vector<Block*> unconnected;
+  for (auto block : blocks) {
+    bool connected = block->areInputsConnected();
+    block->setBound(connected);
+    if (!connected) unconnected.push_back(block);
+  }
+  validated = true;
+  flattened = false;
+  return unconnected;
+}
+
+void TimeDomain::setFrozen(bool enable) {
+  frozen = enable;
+  packed = false;
+  profiled = false;
+  flattened = false;
+}
+
+void TimeDomain::pack() {
+  // Between blocks with hidden inputs, each block gets a level, which is one more than the
+  // level of any block that must run before it. A connection to a block added later is read
+  // with one cycle delay and must stay so, the reading block keeps running first.
+  // Sorting by level and type groups equal blocks without changing what a block reads.
+  runList.clear();
+  runList.reserve(blocks.size());
+  size_t n = blocks.size(), start = 0;
+  while (start < n) {
+    if (!blocks[start]->hasKnownInputs()) {
+      runList.push_back(blocks[start++]);
+      continue;
+    }
+    size_t end = start;
+    while (end < n && blocks[end]->hasKnownInputs()) end++;
+    std::map<Block*, size_t> position;
+    for (size_t i = start; i < end; i++) position[blocks[i]] = i - start;
+    size_t len = end - start;
+    std::vector<std::vector<size_t>> before(len);
+    for (size_t i = 0; i < len; i++) {
+      for (auto pred : blocks[start + i]->getInputBlocks()) {
+        auto it = position.find(pred);
+        if (it == position.end() || it->second == i) continue;
+        size_t first = std::min(it->second, i), second = std::max(it->second, i);
+        before[second].push_back(first);
+      }
+    }
+    std::vector<size_t> level(len, 0), order(len);
+    for (size_t i = 0; i < len; i++) {
+      for (auto b : before[i]) level[i] = std::max(level[i], level[b] + 1);
+      order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      if (level[a] != level[b]) return level[a] < level[b];
+      return std::type_index(typeid(*blocks[start + a])) < std::type_index(typeid(*blocks[start + b]));
+    });
+    for (auto i : order) runList.push_back(blocks[start + i]);
+    start = end;
+  }
+  for (auto f : fusedBlocks) fuse(f);
+  packed = true;
+  profiled = false;
+  flattened = false;
+}
+
+void TimeDomain::fuse(FusedBlockBase* fused) {
+  // the fused block runs at the position of its first member
+  const std::vector<Block*>& members = fused->getMembers();
+  size_t first = runList.size();
+  for (auto m : members) {
+    auto it = std::find(runList.begin(), runList.end(), m);
+    if (it == runList.end()) {
+      throw Fault("block '" + m->getName() + "' of fused block '" + fused->getName() + "' is not in time domain '" + name + "'");
+    }
+    first = std::min(first, static_cast<size_t>(it - runList.begin()));
+  }
+  for (auto pred : fused->getInputBlocks()) {
+    auto it = std::find(runList.begin(), runList.end(), pred);
+    if (it != runList.end() && static_cast<size_t>(it - runList.begin()) > first) {
+      throw Fault("block '" + pred->getName() + "' runs after the first block of fused block '" + fused->getName() + "'");
+    }
+  }
+  runList[first] = fused;
+  runList.erase(std::remove_if(runList.begin(), runList.end(), [&members](Block* b) {
+    return std::find(members.begin(), members.end(), b) != members.end();
+  }), runList.end());
+}
+
+void TimeDomain::flatten() {
+  flatList.clear();
+  for (auto block : frozen ? runList : blocks) expand(block);
+  watchInputs();
+#ifdef EEROS_WCET
+  wcetProbes.clear();
+  for (auto block : flatList) wcetProbes.push_back(Wcet::probe("block", name + "/" + block->getName()));
+#endif
+  flattened = true;
+  profiled = false;
+}
+
+void TimeDomain::expand(Block* block) {
+  auto sub = dynamic_cast<SubioBase*>(block);
+  if (sub == nullptr || sub->getBlocks().empty()) {
+    flatList.push_back(block);
+    return;
+  }
+  for (auto b : sub->getBlocks()) {
+    b->resolveInputs();
+    b->setBound(b->areInputsConnected());
+    expand(b);
+  }
+}
+
+void TimeDomain::watchInputs() {
+  // a version which never matches, so each block runs once after the inputs are collected
+  constexpr uint64_t unseen = ~static_cast<uint64_t>(0);
+  watches.clear();
+  versions.clear();
+  if (!changePropagation) return;
+  for (auto block : flatList) {
+    Watch w{versions.size(), 0, block->hasKnownInputs()};
+    if (w.known) {
+      for (auto s : block->getInputSignals()) versions.emplace_back(s, unseen);
+      w.count = versions.size() - w.first;
+    }
+    watches.push_back(w);
+  }
+}
+
+const std::vector<Block*>& TimeDomain::getBlocks() const {
+  return (frozen && packed) ? runList : blocks;
+}
 
 void TimeDomain::enableBlocks()
 {
@@ -0,0 +1,150 @@
+#include <eeros/control/TimeDomainGroup.hpp>
+#include <eeros/core/Executor.hpp>
+#include <eeros/core/Fault.hpp>
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+using namespace eeros::control;
+
+TimeDomainGroup::TimeDomainGroup(std::string name, double period, bool realtime, std::vector<int> cpus)
+    : name(name), period(period), realtime(realtime), cpus(cpus), log(logger::Logger::getLogger()) { }
+
+TimeDomainGroup::~TimeDomainGroup() {
+  finished = true;
+  for (auto& w : workers) w->wakeup.post();
+  for (auto& w : workers) if (w->thread.joinable()) w->thread.join();
+}
+
+void TimeDomainGroup::add(TimeDomain& td) {
+  if (std::fabs(td.getPeriod() - period) > 1e-12)
+    throw Fault("time domain '" + td.getName() + "' has a different period than time domain group '" + name + "'");
+  if (std::find(domains.begin(), domains.end(), &td) != domains.end())
+    throw Fault("time domain '" + td.getName() + "' is added twice to time domain group '" + name + "'");
+  domains.push_back(&td);
+  stagesValid = false;
+}
+
+void TimeDomainGroup::addDependency(TimeDomain& before, TimeDomain& after) {
+  dependencies.emplace_back(&before, &after);
+  stagesValid = false;
+}
+
+void TimeDomainGroup::addPipelineRegister(PipelineRegisterBase& reg) {
+  if (std::find(registers.begin(), registers.end(), &reg) == registers.end()) registers.push_back(&reg);
+}
+
+std::string TimeDomainGroup::getName() {
+  return name;
+}
+
+double TimeDomainGroup::getPeriod() {
+  return period;
+}
+
+bool TimeDomainGroup::getRealtime() {
+  return realtime;
+}
+
+const std::vector<std::vector<TimeDomain*>>& TimeDomainGroup::getStages() {
+  if (!stagesValid) buildStages();
+  return stages;
+}
+
+void TimeDomainGroup::buildStages() {
+  // stage of a domain = length of the longest dependency chain leading to it
+  std::map<TimeDomain*, int> inDegree;
+  std::map<TimeDomain*, std::vector<TimeDomain*>> successors;
+  for (auto td : domains) inDegree[td] = 0;
+  for (auto& d : dependencies) {
+    if (inDegree.find(d.first) == inDegree.end() || inDegree.find(d.second) == inDegree.end())
+      throw Fault("dependency in time domain group '" + name + "' refers to a time domain not in the group");
+    successors[d.first].push_back(d.second);
+    inDegree[d.second]++;
+  }
+  stages.clear();
+  std::vector<TimeDomain*> ready;
+  for (auto td : domains) if (inDegree[td] == 0) ready.push_back(td);
+  size_t placed = 0;
+  while (!ready.empty()) {
+    stages.push_back(ready);
+    placed += ready.size();
+    std::vector<TimeDomain*> nextReady;
+    for (auto td : ready) {
+      for (auto s : successors[td]) if (--inDegree[s] == 0) nextReady.push_back(s);
+    }
+    ready = nextReady;
+  }
+  if (placed != domains.size()) throw Fault("dependencies in time domain group '" + name + "' form a cycle");
+  stagesValid = true;
+}
+
+void TimeDomainGroup::startWorkers() {
+  size_t widest = 0;
+  for (auto& s : stages) widest = std::max(widest, s.size());
+  size_t count = std::min(cpus.size(), widest > 0 ? widest - 1 : 0);
+  for (size_t i = workers.size(); i < count; i++) {
+    // the thread gets its worker, a later push_back may move the elements of workers
+    workers.push_back(std::make_unique<Worker>());
+    Worker* w = workers.back().get();
+    w->thread = std::thread(&TimeDomainGroup::workerLoop, this, w, cpus[i]);
+  }
+}
+
+void TimeDomainGroup::workerLoop(Worker* w, int cpu) {
+  if (!Executor::set_affinity({cpu})) log.warn() << "time domain group '" << name << "' could not pin worker to cpu " << cpu;
+  while (true) {
+    w->wakeup.wait();
+    if (finished) break;
+    work();
+    if (activeHelpers.fetch_sub(1, std::memory_order_acq_rel) == 1) stageDone.post();
+  }
+}
+
+void TimeDomainGroup::work() {
+  size_t i;
+  while ((i = next.fetch_add(1, std::memory_order_acq_rel)) < current->size()) {
+    try {
+      (*current)[i]->run();
+    } catch (...) {
+      if (!failed.exchange(true)) error = std::current_exception();
+    }
+  }
+}
+
+void TimeDomainGroup::run() {
+  if (!stagesValid) buildStages();
+  if (workers.empty() && !cpus.empty()) startWorkers();
+  // no stage runs between two cycles, so the registers can be latched without synchronization
+  for (auto r : registers) r->latch();
+  for (auto& stage : stages) {
+    if (stage.size() == 1 || workers.empty()) {
+      for (auto td : stage) td->run();
+      continue;
+    }
+    // the stage ends when all woken workers are back, so no worker can reach into the next stage
+    current = &stage;
+    next.store(0, std::memory_order_relaxed);
+    size_t helpers = std::min(workers.size(), stage.size() - 1);
+    activeHelpers.store(helpers, std::memory_order_release);
+    for (size_t w = 0; w < helpers; w++) workers[w]->wakeup.post();
+    work();
+    stageDone.wait();
+    if (failed.exchange(false)) {
+      auto e = error;
+      error = nullptr;
+      std::rethrow_exception(e);
+    }
+  }
+}
+
+namespace eeros {
+namespace control {
+
+std::ostream& operator<<(std::ostream& os, TimeDomainGroup& g) {
+  os << "Time domain group: '" << g.getName() << "'";
+  return os;
+}
+
+}
+}
@@ -0,0 +1,100 @@
+#include <eeros/control/TimerWatchdog.hpp>
+#include <eeros/core/Fault.hpp>
+#include <cmath>
+#include <sched.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+using namespace eeros;
+using namespace eeros::control;
+
+TimerWatchdog::TimerWatchdog(double timeout, int priority)
+    : timeout(timeout), priority(priority), log(logger::Logger::getLogger()) {
+  if (!(timeout > 0)) throw Fault("timeout of timer watchdog must be positive");
+  fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+  if (fd < 0) throw Fault("could not create timer of timer watchdog");
+  int64_t tick = std::llround(timeout * 1e9 / checksPerTimeout);
+  if (tick < 1) tick = 1;
+  struct itimerspec spec;
+  spec.it_interval.tv_sec = tick / 1000000000;
+  spec.it_interval.tv_nsec = tick % 1000000000;
+  spec.it_value = spec.it_interval;
+  if (::timerfd_settime(fd, 0, &spec, nullptr) != 0) {
+    ::close(fd);
+    throw Fault("could not start timer of timer watchdog");
+  }
+  thread = std::thread([this]() { loop(); });
+}
+
+TimerWatchdog::~TimerWatchdog() {
+  stopping.store(true, std::memory_order_relaxed);
+  // let the timer expire at once, so the thread does not wait for the next tick
+  struct itimerspec spec = {};
+  spec.it_value.tv_nsec = 1;
+  ::timerfd_settime(fd, 0, &spec, nullptr);
+  if (thread.joinable()) thread.join();
+  ::close(fd);
+}
+
+void TimerWatchdog::arm() {
+  generation.fetch_add(1, std::memory_order_release);
+  isArmed.store(true, std::memory_order_release);
+}
+
+void TimerWatchdog::disarm() {
+  isArmed.store(false, std::memory_order_release);
+}
+
+bool TimerWatchdog::getStatus() const {
+  return expiredGeneration.load(std::memory_order_relaxed) != generation.load(std::memory_order_relaxed);
+}
+
+double TimerWatchdog::getTimeout() const {
+  return timeout;
+}
+
+void TimerWatchdog::registerSafetyEvent(safety::SafetySystem& ss, safety::SafetyEvent& e) {
+  safetyEvent.store(&e, std::memory_order_relaxed);
+  safetySystem.store(&ss, std::memory_order_release);
+}
+
+void TimerWatchdog::loop() {
+  if (priority > 0) {
+    struct sched_param schedulingParam;
+    schedulingParam.sched_priority = priority;
+    if (sched_setscheduler(0, SCHED_FIFO, &schedulingParam) != 0) log.error() << "could not set realtime priority of timer watchdog";
+  }
+  uint64_t seenPets = pets.load(std::memory_order_relaxed);
+  uint64_t seenGeneration = 0;
+  int missed = 0;
+  while (!stopping.load(std::memory_order_relaxed)) {
+    uint64_t expirations;
+    // a late wake-up with several expirations counts as a single check
+    if (::read(fd, &expirations, sizeof(expirations)) != sizeof(expirations)) continue;
+    uint64_t p = pets.load(std::memory_order_relaxed);
+    uint64_t g = generation.load(std::memory_order_acquire);
+    if (!isArmed.load(std::memory_order_acquire) || g != seenGeneration || p != seenPets) {
+      seenPets = p;
+      seenGeneration = g;
+      missed = 0;
+      continue;
+    }
+    if (++missed < checksPerTimeout || expiredGeneration.load(std::memory_order_relaxed) == g) continue;
+    expiredGeneration.store(g, std::memory_order_relaxed);
+    EEROS_HOTPATH_LOG(log.error() << "timer watchdog '" << getName() << "' timed out");
+    safety::SafetySystem* ss = safetySystem.load(std::memory_order_acquire);
+    safety::SafetyEvent* e = safetyEvent.load(std::memory_order_relaxed);
+    if (ss != nullptr && e != nullptr) ss->triggerEvent(*e);
+  }
+}
+
+namespace eeros {
+namespace control {
+
+std::ostream& operator<<(std::ostream& os, TimerWatchdog& wdt) {
+  os << "Block timer watchdog: '" << wdt.getName() << "' timeout=" << wdt.getTimeout() << ", status=" << wdt.getStatus();
+  return os;
+}
+
+}
+}
@@ -14,27 +14,28 @@ XBoxInput::XBoxInput(std::string dev, int priority) : x(dev, priority), buttonOu
 XBoxInput::~XBoxInput() { }
 
 void XBoxInput::run() {
+	auto current = x.current.read();
 	out.getSignal().setValue(Matrix<XBOX_AXIS_COUNT>{
-		x.current.axis[XBoxController::Axis::LX],
-		x.current.axis[XBoxController::Axis::LY],
-		x.current.axis[XBoxController::Axis::LT],
-		x.current.axis[XBoxController::Axis::RX],
-		x.current.axis[XBoxController::Axis::RY],
-		x.current.axis[XBoxController::Axis::RT],
-		x.current.axis[XBoxController::Axis::CX],
-		x.current.axis[XBoxController::Axis::CY]
+		current.axis[XBoxController::Axis::LX],
+		current.axis[XBoxController::Axis::LY],
+		current.axis[XBoxController::Axis::LT],
+		current.axis[XBoxController::Axis::RX],
+		current.axis[XBoxController::Axis::RY],
+		current.axis[XBoxController::Axis::RT],
+		current.axis[XBoxController::Axis::CX],
+		current.axis[XBoxController::Axis::CY]
 	});	
 	uint64_t ts = eeros::System::getTimeNs();
 	out.getSignal().setTimestamp(ts);
 	buttonOut.getSignal().setValue(Matrix<XBOX_BUTTON_COUNT,1,bool>{
-		x.current.button_state[XBoxController::Button::A],
-		x.current.button_state[XBoxController::Button::B],
-		x.current.button_state[XBoxController::Button::X],
-		x.current.button_state[XBoxController::Button::Y],
-		x.current.button_state[XBoxController::Button::LB],
-		x.current.button_state[XBoxController::Button::RB],
-		x.current.button_state[XBoxController::Button::back],
-		x.current.button_state[XBoxController::Button::start]
+		current.button_state[XBoxController::Button::A],
+		current.button_state[XBoxController::Button::B],
+		current.button_state[XBoxController::Button::X],
+		current.button_state[XBoxController::Button::Y],
+		current.button_state[XBoxController::Button::LB],
+		current.button_state[XBoxController::Button::RB],
+		current.button_state[XBoxController::Button::back],
+		current.button_state[XBoxController::Button::start]
 	});
 	buttonOut.getSignal().setTimestamp(ts);
 }
@@ -0,0 +1,49 @@
+#include <eeros/core/Arena.hpp>
+#include <eeros/core/Fault.hpp>
+#include <algorithm>
+#include <cstdint>
+
+using namespace eeros;
+
+Arena::Arena(std::size_t chunkSize) : chunkSize(chunkSize) { }
+
+Arena::~Arena() {
+  for (auto d = destructors.rbegin(); d != destructors.rend(); ++d) d->destroy(d->object);
+  for (auto& c : chunks) ::operator delete(c.data, std::align_val_t(chunkAlignment));
+}
+
+void* Arena::allocate(std::size_t size, std::size_t align) {
+  if (align == 0 || (align & (align - 1)) != 0 || align > chunkAlignment) throw Fault("invalid alignment for arena allocation");
+  auto p = (reinterpret_cast<std::uintptr_t>(next) + align - 1) & ~(std::uintptr_t(align) - 1);
+  if (next == nullptr || p + size > reinterpret_cast<std::uintptr_t>(end)) {
+    addChunk(size);
+    p = reinterpret_cast<std::uintptr_t>(next);
+  }
+  used += p + size - reinterpret_cast<std::uintptr_t>(next);
+  next = reinterpret_cast<char*>(p + size);
+  return reinterpret_cast<void*>(p);
+}
+
+void Arena::reserve(std::size_t size) {
+  if (next == nullptr || static_cast<std::size_t>(end - next) < size) addChunk(size);
+}
+
+std::size_t Arena::getUsed() const {
+  return used;
+}
+
+std::size_t Arena::getCapacity() const {
+  std::size_t capacity = 0;
+  for (auto& c : chunks) capacity += c.size;
+  return capacity;
+}
+
+void Arena::addChunk(std::size_t size) {
+  size = std::max(size, chunkSize);
+  size = (size + chunkAlignment - 1) / chunkAlignment * chunkAlignment;
+  chunks.reserve(chunks.size() + 1);
+  char* data = static_cast<char*>(::operator new(size, std::align_val_t(chunkAlignment)));
+  chunks.push_back({data, size});
+  next = data;
+  end = data + size;
+}
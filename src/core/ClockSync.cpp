@@ -0,0 +1,23 @@
+#include <eeros/core/ClockSync.hpp>
+#include <cmath>
+
+using namespace eeros;
+
+ClockSync::ClockSync(int64_t period, double kp, double ki) : nominal(period), period(period), kp(kp), ki(ki) { }
+
+void ClockSync::update(int64_t time) {
+  if (!locked) {
+    locked = true;
+    offset = 0;
+    next = time + std::llround(period);
+    return;
+  }
+  offset = time - next;
+  if (std::abs(offset) > period / 2) {
+    resyncs++;
+    next = time + std::llround(period);
+    return;
+  }
+  period += ki * offset;
+  next += std::llround(period + kp * offset);
+}
@@ -0,0 +1,102 @@
+#include <eeros/core/CpuPower.hpp>
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace eeros;
+
+CpuPower::CpuPower(std::string sysfsPath, std::string latencyPath)
+    : sysfsPath(sysfsPath), latencyPath(latencyPath), latencyFd(-1) { }
+
+CpuPower::~CpuPower() {
+  release();
+}
+
+bool CpuPower::requestLatency(int32_t us) {
+  if (latencyFd < 0) latencyFd = open(latencyPath.c_str(), O_RDWR);
+  if (latencyFd < 0) return false;
+  // the request stays active as long as the file is open
+  return ::write(latencyFd, &us, sizeof(us)) == sizeof(us);
+}
+
+int32_t CpuPower::getLatency() const {
+  int fd = open(latencyPath.c_str(), O_RDONLY);
+  if (fd < 0) return -1;
+  int32_t us = -1;
+  if (::read(fd, &us, sizeof(us)) != sizeof(us)) us = -1;
+  close(fd);
+  return us;
+}
+
+bool CpuPower::setGovernor(const std::vector<int>& cpus, std::string governor) {
+  bool ok = true;
+  for (auto cpu : cpus) ok = write(cpu, "scaling_governor", governor) && ok;
+  return ok;
+}
+
+bool CpuPower::setFrequency(const std::vector<int>& cpus, uint32_t khz) {
+  bool ok = true;
+  std::string value = std::to_string(khz);
+  for (auto cpu : cpus) {
+    // depending on the current range either limit has to be moved first
+    write(cpu, "scaling_max_freq", value);
+    bool min = write(cpu, "scaling_min_freq", value);
+    bool max = write(cpu, "scaling_max_freq", value);
+    ok = ok && min && max;
+  }
+  return ok;
+}
+
+std::string CpuPower::read(int cpu, std::string attribute) const {
+  std::ifstream file(path(cpu, attribute));
+  std::string value;
+  std::getline(file, value);
+  return value;
+}
+
+void CpuPower::report(logger::Logger& log, const std::vector<int>& cpus) const {
+  if (latencyFd >= 0) log.info() << "cpu latency limited to " << getLatency() << " us";
+  for (auto cpu : cpus) {
+    std::string governor = read(cpu, "scaling_governor");
+    if (governor.empty()) {
+      log.info() << "cpu " << cpu << " has no frequency scaling";
+      continue;
+    }
+    log.info() << "cpu " << cpu << ": governor " << governor << ", " << read(cpu, "scaling_min_freq")
+               << " ... " << read(cpu, "scaling_max_freq") << " kHz, current " << read(cpu, "scaling_cur_freq") << " kHz";
+  }
+}
+
+void CpuPower::release() {
+  if (latencyFd >= 0) {
+    close(latencyFd);
+    latencyFd = -1;
+  }
+  // a restored limit can be rejected until the other limit is restored, so restore twice
+  for (int pass = 0; pass < 2; pass++) {
+    for (auto s = saved.rbegin(); s != saved.rend(); s++) {
+      std::ofstream file(s->first);
+      file << s->second;
+    }
+  }
+  saved.clear();
+}
+
+std::string CpuPower::path(int cpu, std::string attribute) const {
+  return sysfsPath + "/cpu" + std::to_string(cpu) + "/cpufreq/" + attribute;
+}
+
+bool CpuPower::write(int cpu, std::string attribute, std::string value) {
+  std::string file = path(cpu, attribute);
+  bool known = false;
+  for (auto& s : saved) known = known || s.first == file;
+  if (!known) {
+    std::string previous = read(cpu, attribute);
+    if (previous.empty()) return false;
+    saved.emplace_back(file, previous);
+  }
+  std::ofstream out(file);
+  out << value;
+  out.flush();
+  return out.good();
+}
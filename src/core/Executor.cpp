@@ -4,21 +4,39 @@
 #include <vector>
 #include <memory>
 #include <cmath>
+#include <cerrno>
 #include <thread>
+#include <alloca.h>
+#include <malloc.h>
 #include <signal.h>
 #include <sched.h>
 #include <sys/mman.h>
 #include <sys/syscall.h>
+#include <sys/timerfd.h>
+#include <time.h>
 #include <unistd.h>
 #include <eeros/core/Executor.hpp>
 #include <eeros/task/Async.hpp>
+#include <eeros/task/WorkerPool.hpp>
+#include <eeros/task/Timed.hpp>
 #include <eeros/task/Lambda.hpp>
 #include <eeros/task/HarmonicTaskList.hpp>
 #include <eeros/control/TimeDomain.hpp>
+#include <eeros/control/TimeDomainGroup.hpp>
 #include <eeros/safety/SafetySystem.hpp>
+#include <eeros/hal/HAL.hpp>
+#include <eeros/core/System.hpp>
+#include <eeros/core/Tracepoint.hpp>
 #ifdef USE_ROS
 #include <ros/callback_queue_interface.h>
 #include <ros/callback_queue.h>
+#include <rosgraph_msgs/Clock.h>
+#endif
+#ifdef USE_ROS2
+#include <rosgraph_msgs/msg/clock.hpp>
+#if __has_include(<rclcpp/experimental/executors/events_executor/events_executor.hpp>)
+#include <rclcpp/experimental/executors/events_executor/events_executor.hpp>
+#endif
 #endif
 
 using namespace eeros;
@@ -28,14 +46,94 @@ namespace {
 
 using Logger = logger::Logger;
 
+constexpr int64_t nsPerSec = 1000000000;
+
+// executor whose periodics run on the calling thread, see Executor::current()
+thread_local Executor *currentExecutor = nullptr;
+
+std::mutex executorsMutex;
+std::vector<Executor*> executors;
+
+int64_t toNs(const struct timespec &ts) {
+  return static_cast<int64_t>(ts.tv_sec) * nsPerSec + ts.tv_nsec;
+}
+
+#if defined USE_ROS || defined USE_ROS2
+void logRosClockLatency(Logger &log, const ExternalClock &clock) {
+  auto latency = clock.getLatency().snapshot();
+  if (latency.count == 0) return;
+  log.info() << "latency of /clock to the executor over " << latency.count << " steps: p50 "
+             << latency.percentile(0.5) << " sec, p99 " << latency.percentile(0.99) << " sec";
+}
+#endif
+
+struct timespec toTimespec(int64_t ns) {
+  struct timespec ts;
+  ts.tv_sec = ns / nsPerSec;
+  ts.tv_nsec = ns % nsPerSec;
+  return ts;
+}
+
+// glibc does not provide sched_setattr(), layout as in linux/sched/types.h
+struct SchedAttr {
+  uint32_t size;
+  uint32_t sched_policy;
+  uint64_t sched_flags;
+  int32_t sched_nice;
+  uint32_t sched_priority;
+  uint64_t sched_runtime;
+  uint64_t sched_deadline;
+  uint64_t sched_period;
+};
+
+int64_t monotonicNowNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return toNs(ts);
+}
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  asm volatile("yield");
+#endif
+}
+
+// runs the task list of a periodic on its own thread, on the worker pool or, with an independent timer, on a timed thread
 struct TaskThread {
-  TaskThread(double period, task::Periodic &task, task::HarmonicTaskList tasks) 
-      : taskList(tasks), async(taskList, task.getRealtime(), task.getNice()) {
-    async.counter.setPeriod(period);
-    async.counter.monitors = task.monitors;
+  TaskThread(double period, task::Periodic &task, task::HarmonicTaskList tasks, task::WorkerPool *pool) 
+      : name(task.getName()), periodic(&task), taskList(tasks) {
+    if (task.getIndependentTimer()) {
+      timed = std::make_unique<task::Timed>(taskList, period, task.getRealtime(), task.getNice(), task.getAffinity(), task.getStackSize());
+      timed->setOverrunPolicy(task.getOverrunPolicy(), task.getSafetySystem(), task.getSafetyEvent());
+    } else if (pool != nullptr && !task.getRealtime()) {
+      pooled = std::make_unique<task::PooledTask>(taskList, *pool);
+    } else {
+      async = std::make_unique<task::Async>(taskList, task.getRealtime(), task.getNice(), task.getAffinity(), task.getStackSize());
+      if (task.getDeadlineScheduling()) async->setDeadline(period, task.getDeadlineRuntime());
+      async->setOverrunPolicy(task.getOverrunPolicy(), task.getSafetySystem(), task.getSafetyEvent());
+    }
+    counter().setPeriod(period);
+    counter().monitors = task.monitors;
+  }
+  PeriodicCounter &counter() { return timed ? timed->counter : (async ? async->counter : pooled->counter); }
+  void bind(Executor *executor) {
+    binding = task::Lambda([executor]() { currentExecutor = executor; });
+    taskList.tasks.insert(taskList.tasks.begin(), task::Harmonic(binding, 1, 0));
   }
+  Runnable &runnable() { return async ? static_cast<Runnable&>(*async) : static_cast<Runnable&>(*pooled); }
+  bool waitReady(double timeout) { return timed ? timed->waitReady(timeout) : (async ? async->waitReady(timeout) : true); }
+  void start(int64_t nowNs) { if (timed) timed->start(nowNs + llround(periodic->getPeriod() * 1.0e9)); }
+  void stop() { if (async) async->stop(); if (timed) timed->stop(); }
+  void join() { if (async) async->join(); if (timed) timed->join(); }
+  std::string name;
+  task::Periodic *periodic;
   task::HarmonicTaskList taskList;
-  task::Async async;
+  std::unique_ptr<task::Async> async;
+  std::unique_ptr<task::PooledTask> pooled;
+  std::unique_ptr<task::Timed> timed;
+  task::Lambda binding;
 };
 
 template < typename F >
@@ -47,39 +145,71 @@ void traverse(std::vector<task::Periodic> &tasks, F func) {
   }
 }
 
-void createThread(Logger &log, task::Periodic &task, task::Periodic &baseTask, std::vector<std::shared_ptr<TaskThread>> &threads, std::vector<task::Harmonic> &output);
+void createThread(Logger &log, bool distributePhases, task::WorkerPool *pool, int &slot, task::Periodic &task, task::Periodic &baseTask, std::vector<std::shared_ptr<TaskThread>> &threads, std::vector<task::Harmonic> &output);
 
-void createThreads(Logger &log, std::vector<task::Periodic> &tasks, task::Periodic &baseTask, std::vector<std::shared_ptr<TaskThread>> &threads, task::HarmonicTaskList &output) {
+void createThreads(Logger &log, bool distributePhases, task::WorkerPool *pool, std::vector<task::Periodic> &tasks, task::Periodic &baseTask, std::vector<std::shared_ptr<TaskThread>> &threads, task::HarmonicTaskList &output) {
+  int slot = 0;
   for (task::Periodic &t: tasks) {
-    createThread(log, t, baseTask, threads, output.tasks);
+    createThread(log, distributePhases, pool, slot, t, baseTask, threads, output.tasks);
   }
 }
 
-void createThread(Logger &log, task::Periodic &task, task::Periodic &baseTask, std::vector<std::shared_ptr<TaskThread>> &threads, std::vector<task::Harmonic> &output) {
+void createTimedThread(Logger &log, bool distributePhases, task::WorkerPool *pool, task::Periodic &task, std::vector<std::shared_ptr<TaskThread>> &threads) {
+  task::HarmonicTaskList taskList;
+  if (task.before.size() > 0) createThreads(log, distributePhases, pool, task.before, task, threads, taskList);
+  taskList.add(task.getTask());
+  if (task.after.size() > 0) createThreads(log, distributePhases, pool, task.after, task, threads, taskList);
+
+  if (task.getRealtime())
+    log.trace() << "creating realtime task '" << task.getName() << "' with period " << task.getPeriod()
+          << " sec and priority " << ((int)(Executor::basePriority) - task.getNice()) << " on an independent timer";
+  else
+    log.trace() << "creating task '" << task.getName() << "' with period " << task.getPeriod() << " sec on an independent timer";
+
+  if (task.getRealtime() && task.getNice() <= 0)
+    throw std::runtime_error("priority not set");
+  if (task.getDeadlineScheduling())
+    log.warn() << "periodic '" << task.getName() << "' on an independent timer does not run under SCHED_DEADLINE";
+
+  threads.push_back(std::make_shared<TaskThread>(task.getPeriod(), task, taskList, pool));
+}
+
+void createThread(Logger &log, bool distributePhases, task::WorkerPool *pool, int &slot, task::Periodic &task, task::Periodic &baseTask, std::vector<std::shared_ptr<TaskThread>> &threads, std::vector<task::Harmonic> &output) {
+  if (task.getIndependentTimer()) {
+    if (dynamic_cast<Executor*>(&baseTask.getTask()) == nullptr)
+      throw std::runtime_error("periodic '" + task.getName() + "' with an independent timer must be added directly to the executor");
+    createTimedThread(log, distributePhases, pool, task, threads);
+    return;
+  }
   int k = static_cast<int>(task.getPeriod() / baseTask.getPeriod());
   double actualPeriod = k * baseTask.getPeriod();
   double deviation = std::abs(task.getPeriod() - actualPeriod) / task.getPeriod();
   task::HarmonicTaskList taskList;
 
   if (task.before.size() > 0) {
-    createThreads(log, task.before, task, threads, taskList);
+    createThreads(log, distributePhases, pool, task.before, task, threads, taskList);
   }
   taskList.add(task.getTask());
   if (task.after.size() > 0) {
-    createThreads(log, task.after, task, threads, taskList);
+    createThreads(log, distributePhases, pool, task.after, task, threads, taskList);
   }
 
+  // spread slow periodics sharing the same base task over the base cycles
+  int phase = task.getPhase();
+  if (phase < 0) phase = (distributePhases && k > 1) ? (slot++ % k) : 0;
+  if (phase >= k) throw std::runtime_error("phase of periodic '" + task.getName() + "' must be smaller than " + std::to_string(k));
+
   if (task.getRealtime())
     log.trace() << "creating harmonic realtime task '" << task.getName()
           << "' with period " << actualPeriod << " sec (k = "
           << k << ") and priority " << ((int)(Executor::basePriority) - task.getNice())
-          << " based on '" << baseTask.getName() << "'";
+          << " and phase " << phase << " based on '" << baseTask.getName() << "'";
   else
     log.trace() << "creating harmonic task '" << task.getName() << "' with period "
-          << actualPeriod << " sec (k = " << k << ")"
+          << actualPeriod << " sec (k = " << k << ") and phase " << phase
           << " based on '" << baseTask.getName() << "'";
 
-  if (deviation > 0.01) throw std::runtime_error("period deviation too high");
+  if (deviation > 0.01) throw std::runtime_error("period deviation of periodic '" + task.getName() + "' too high, use an independent timer for periods which are not harmonic");
 
   if (task.getRealtime() && task.getNice() <= 0)
     throw std::runtime_error("priority not set");
@@ -87,29 +217,68 @@ void createThread(Logger &log, task::Periodic &task, task::Periodic &baseTask, s
   if (taskList.tasks.size() == 0)
     throw std::runtime_error("no task to execute");
 
-  threads.push_back(std::make_shared<TaskThread>(actualPeriod, task, taskList));
-  output.emplace_back(threads.back()->async, k);
+  threads.push_back(std::make_shared<TaskThread>(actualPeriod, task, taskList, pool));
+  output.emplace_back(threads.back()->runnable(), k, phase);
+}
+
+// lockstep: builds the same task lists as createThreads, but they run inline in the executor thread
+void createInline(bool distributePhases, std::vector<task::Periodic> &tasks, task::Periodic &baseTask, std::vector<std::unique_ptr<task::HarmonicTaskList>> &lists, task::HarmonicTaskList &output) {
+  int slot = 0;
+  for (task::Periodic &t: tasks) {
+    if (t.getIndependentTimer()) throw std::runtime_error("periodic '" + t.getName() + "' with an independent timer cannot run in lockstep");
+    int k = static_cast<int>(t.getPeriod() / baseTask.getPeriod());
+    double deviation = std::abs(t.getPeriod() - k * baseTask.getPeriod()) / t.getPeriod();
+    if (deviation > 0.01) throw std::runtime_error("period deviation too high");
+    int phase = t.getPhase();
+    if (phase < 0) phase = (distributePhases && k > 1) ? (slot++ % k) : 0;
+    if (phase >= k) throw std::runtime_error("phase of periodic '" + t.getName() + "' must be smaller than " + std::to_string(k));
+    lists.push_back(std::make_unique<task::HarmonicTaskList>());
+    task::HarmonicTaskList &taskList = *lists.back();
+    createInline(distributePhases, t.before, t, lists, taskList);
+    taskList.add(t.getTask());
+    createInline(distributePhases, t.after, t, lists, taskList);
+    output.add(taskList, k, phase);
+  }
 }
 }
 
 Executor::Executor() 
-    : period(0), mainTask(nullptr), syncWithEtherCatStackSet(false),
+    : period(0), timingMode(TimingMode::steadyClock), spinMargin(50e-6), spinAutoTune(true), startupTimeout(5),
+      distributePhases(false), mainTask(nullptr), syncWithEtherCatStackSet(false),
       syncWithRosTimeSet(false), syncWithRosTopicSet(false),
-      log(logger::Logger::getLogger('E')) { }
+      log(logger::Logger::getLogger('E')) {
+  std::lock_guard<std::mutex> lock(executorsMutex);
+  executors.push_back(this);
+}
 
-Executor::~Executor() { }
+Executor::~Executor() {
+  std::lock_guard<std::mutex> lock(executorsMutex);
+  executors.erase(std::remove(executors.begin(), executors.end(), this), executors.end());
+}
 
 Executor& Executor::instance() {
   static Executor executor;
   return executor;
 }
 
+Executor& Executor::current() {
+  return currentExecutor != nullptr ? *currentExecutor : instance();
+}
+
 
 #ifdef USE_ETHERCAT
 void Executor::syncWithEtherCATSTack(ecmasterlib::EcMasterlibMain* etherCATStack) {
   syncWithEtherCatStackSet = true;
   this->etherCATStack = etherCATStack;
 }
+
+void Executor::setEtherCATLead(double lead) {
+  etherCATLead = llround(lead * 1.0e9);
+}
+
+const ClockSync& Executor::getEtherCATClock() const {
+  return etherCATClock;
+}
 #endif
 
 
@@ -133,6 +302,61 @@ void Executor::setExecutorPeriod(double period) {
   setMainTask(*task);
 }
 
+void Executor::setTimingMode(TimingMode mode) {
+  timingMode = mode;
+}
+
+Executor::TimingMode Executor::getTimingMode() {
+  return timingMode;
+}
+
+bool Executor::step(uint64_t cycles) {
+  std::unique_lock<std::mutex> lock(stepMutex);
+  stepsRequested += cycles;
+  uint64_t target = stepsRequested;
+  stepCv.notify_all();
+  stepCv.wait(lock, [this, target]() { return stepsDone >= target || !running; });
+  return stepsDone >= target;
+}
+
+void Executor::startCycle() {
+  counter.tick();
+  uint64_t timestamp = System::getTimeNs();
+  cycleTimestamp.store(timestamp, std::memory_order_relaxed);
+  EEROS_TRACE1(executor_cycle, timestamp);
+  if (calibrationCycles > 0 && ++cycleCount == calibrationCycles) {
+    if (!checkSchedulability() && schedulabilityCheck == SchedulabilityCheck::enforce) {
+      log.error() << "stopping the executor, the task set is not schedulable";
+      shutdown();
+    }
+  }
+  if (updateHal) hal::HAL::instance().updateInputs();
+  if (criticalSafetySystem != nullptr) criticalSafetySystem->checkCriticalInputs(!updateHal);
+}
+
+bool Executor::checkSchedulability() {
+  // a measured run is the upper bound of its histogram bucket, i.e. slightly pessimistic
+  auto wcet = [](task::Periodic *t, PeriodicCounter *c) {
+    double measured = c != nullptr ? c->runHistogram.snapshot().percentile(1.0) : 0;
+    return std::max(t->getWcet(), measured);
+  };
+  task::Schedulability analysis;
+  analysis.add(mainTask->getName(), period, wcet(mainTask, calibrationCycles > 0 ? &counter : nullptr), basePriority, cpus);
+  for (auto &s : scheduled) {
+    double c = wcet(s.first, calibrationCycles > 0 ? s.second : nullptr);
+    if (c <= 0) log.warn() << "periodic '" << s.first->getName() << "' has no worst case execution time, it is analyzed with 0 sec";
+    analysis.add(s.first->getName(), s.first->getPeriod(), c, basePriority - s.first->getNice(), s.first->getAffinity());
+  }
+  bool schedulable = analysis.analyze();
+  analysis.report(log);
+  return schedulable;
+}
+
+void Executor::setSpinMargin(double margin, bool autoTune) {
+  spinMargin = margin;
+  spinAutoTune = autoTune;
+}
+
 task::Periodic* Executor::getMainTask() {
   return mainTask;
 }
@@ -152,9 +376,29 @@ void Executor::add(control::TimeDomain &td) {
   tasks.push_back(task);
 }
 
-void Executor::prefault_stack() {
-  unsigned char dummy[8*1024] = {};
-    (void)dummy;
+void Executor::add(control::TimeDomainGroup &group) {
+  task::Periodic task(group.getName(), group.getPeriod(), group, group.getRealtime());
+  for(auto& t: tasks) {
+    if (&group == &t.getTask()) log.error() << "periodic of time domain group '" << group.getName() << "' is added twice to the executor";
+  }
+  tasks.push_back(task);
+}
+
+void Executor::prefault_stack(std::size_t size) {
+  volatile unsigned char* p = static_cast<volatile unsigned char*>(alloca(size));
+  const long pageSize = sysconf(_SC_PAGESIZE);
+  for (std::size_t i = 0; i < size; i += pageSize) p[i] = 0;
+  if (size > 0) p[size - 1] = 0;
+}
+
+bool Executor::reserve_heap(std::size_t size) {
+  if (!mallopt(M_TRIM_THRESHOLD, -1) || !mallopt(M_MMAP_MAX, 0) || !mallopt(M_ARENA_MAX, 1)) return false;
+  unsigned char* p = static_cast<unsigned char*>(malloc(size));
+  if (p == nullptr) return false;
+  const long pageSize = sysconf(_SC_PAGESIZE);
+  for (std::size_t i = 0; i < size; i += pageSize) static_cast<volatile unsigned char*>(p)[i] = 0;
+  free(p);
+  return true;
 }
 
 bool Executor::lock_memory() {
@@ -167,6 +411,124 @@ bool Executor::set_priority(int nice) {
   return (sched_setscheduler(0, SCHED_FIFO, &schedulingParam) != -1);
 }
 
+bool Executor::set_affinity(const std::vector<int> &cpus) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (auto cpu : cpus) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+    CPU_SET(cpu, &set);
+  }
+  return (sched_setaffinity(0, sizeof(set), &set) != -1);
+}
+
+bool Executor::set_deadline(double runtime, double deadline, double period) {
+#ifdef SYS_sched_setattr
+  constexpr uint64_t minRuntime = 1024; // the kernel rejects budgets below 1 us
+  SchedAttr attr = {};
+  attr.size = sizeof(attr);
+  attr.sched_policy = SCHED_DEADLINE;
+  attr.sched_runtime = std::max(static_cast<uint64_t>(llround(runtime * 1.0e9)), minRuntime);
+  attr.sched_deadline = llround(deadline * 1.0e9);
+  attr.sched_period = llround(period * 1.0e9);
+  if (attr.sched_runtime > attr.sched_deadline) {
+    errno = EINVAL;
+    return false;
+  }
+  return (syscall(SYS_sched_setattr, 0, &attr, 0) != -1);
+#else
+  errno = ENOSYS;
+  return false;
+#endif
+}
+
+void Executor::setAffinity(std::vector<int> cpus) {
+  this->cpus = cpus;
+}
+
+void Executor::setStartupTimeout(double timeout) {
+  startupTimeout = timeout;
+}
+
+void Executor::setStackPrefault(std::size_t size) {
+  stackPrefault = size;
+}
+
+void Executor::setHeapReserve(std::size_t size) {
+  heapReserve = size;
+}
+
+void Executor::setTimingExport(std::string path) {
+  timingExportPath = path;
+}
+
+void Executor::setOsCounters(unsigned cycles) {
+  osCounters = cycles;
+}
+
+void Executor::setTaskTrace(std::string file) {
+  taskTracePath = file;
+}
+
+void Executor::setWorkerPool(int threads, std::vector<int> cpus) {
+  poolThreads = threads;
+  poolCpus = cpus;
+}
+
+void Executor::setPhaseDistribution(bool enable) {
+  distributePhases = enable;
+}
+
+void Executor::setPriorityOffset(int offset) {
+  priorityOffset = offset;
+}
+
+void Executor::setHalUpdate(bool enable) {
+  updateHal = enable;
+}
+
+void Executor::setCriticalInputFastPath(bool enable) {
+  criticalFastPath = enable;
+}
+
+void Executor::setCpuLatency(int32_t us) {
+  cpuLatency = us;
+}
+
+void Executor::setCpuGovernor(std::string governor) {
+  cpuGovernor = governor;
+}
+
+void Executor::setCpuFrequency(uint32_t khz) {
+  cpuFrequency = khz;
+}
+
+void Executor::applyCpuPower() {
+  if (cpuLatency >= 0 && !cpuPower.requestLatency(cpuLatency))
+    log.error() << "could not request a cpu latency of " << cpuLatency << " us";
+  if (cpuGovernor.empty() && cpuFrequency == 0) {
+    if (cpuLatency >= 0) cpuPower.report(log, {});
+    return;
+  }
+  // cores of the executor and of the realtime periodics, all cores if none is pinned
+  std::vector<int> cores = cpus;
+  traverse(tasks, [&cores] (task::Periodic *task) {
+    if (task->getRealtime()) for (auto c : task->getAffinity()) cores.push_back(c);
+  });
+  if (cores.empty()) for (long c = 0; c < sysconf(_SC_NPROCESSORS_ONLN); c++) cores.push_back(c);
+  std::sort(cores.begin(), cores.end());
+  cores.erase(std::unique(cores.begin(), cores.end()), cores.end());
+  if (!cpuGovernor.empty() && !cpuPower.setGovernor(cores, cpuGovernor))
+    log.error() << "could not set cpu governor '" << cpuGovernor << "' on all cores";
+  if (cpuFrequency > 0 && !cpuPower.setFrequency(cores, cpuFrequency))
+    log.error() << "could not fix the cpu frequency to " << cpuFrequency << " kHz on all cores";
+  cpuPower.report(log, cores);
+}
+
+void Executor::setSchedulabilityCheck(SchedulabilityCheck check, uint64_t calibrationCycles) {
+  schedulabilityCheck = check;
+  this->calibrationCycles = check != SchedulabilityCheck::off ? calibrationCycles : 0;
+}
+
 void Executor::assignPriorities() {
   std::vector<task::Periodic*> priorityAssignments;
 
@@ -184,7 +546,7 @@ void Executor::assignPriorities() {
   });
 
   // assign priorities
-  int nice = 1;
+  int nice = priorityOffset + 1;
   for (auto t: priorityAssignments) {
     if (t->getRealtime()) {
       t->setNice(nice++);
@@ -193,17 +555,31 @@ void Executor::assignPriorities() {
 }
 
 void Executor::stop() {
-  auto &instance = Executor::instance();
-  instance.running = false;
+  std::lock_guard<std::mutex> lock(executorsMutex);
+  for (auto e : executors) e->shutdown();
+}
+
+void Executor::shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(stepMutex);
+    running = false;
+  }
+  stepCv.notify_all();
 #ifdef USE_ETHERCAT
-  if(instance.etherCATStack) instance.etherCATStack->stop();
+  if(etherCATStack) etherCATStack->stop();
+#endif
+#if defined USE_ROS || defined USE_ROS2
+  rosClock.stop();
+#endif
+#ifdef USE_ROS
+  if (clockSpinner) clockSpinner->stop();
 #endif
 #ifdef USE_ROS2
   rclcpp::shutdown();
-  if (instance.subscriberThread != nullptr) {
-    instance.subscriberThread->join();
+  if (subscriberThread != nullptr) {
+    subscriberThread->join();
   }
-  instance.handleTopic(); // release lock to stop executor
+  handleTopic(); // release lock to stop executor
 #endif
 }
 
@@ -211,6 +587,11 @@ void Executor::stop() {
 void Executor::syncWithRosTime() {
   syncWithRosTimeSet = true;
   eeros::System::useRosTime();
+  subscribeRosClock();
+}
+
+const ExternalClock& Executor::getRosClock() const {
+  return rosClock;
 }
 #endif
 
@@ -219,30 +600,84 @@ void Executor::syncWithRosTopic(ros::CallbackQueue* syncRosCallbackQueue) {
   log.warn() << "sync executor with gazebo";
   syncWithRosTopicSet = true;
   this->syncRosCallbackQueue = syncRosCallbackQueue;
+  subscribeRosClock();
+}
+
+void Executor::subscribeRosClock() {
+  if (clockSpinner) return;
+  // the clock has its own queue and spinner, so it wakes the executor independent of other callbacks
+  ros::NodeHandle handle;
+  handle.setCallbackQueue(&clockQueue);
+  boost::function<void(const rosgraph_msgs::Clock::ConstPtr&)> callback = [this](const rosgraph_msgs::Clock::ConstPtr& msg) {
+    rosClock.update(msg->clock.toNSec());
+  };
+  clockSubscriber = handle.subscribe<rosgraph_msgs::Clock>("/clock", 1, callback, ros::VoidConstPtr(), ros::TransportHints().tcpNoDelay());
+  clockSpinner = std::make_unique<ros::AsyncSpinner>(1, &clockQueue);
+  clockSpinner->start();
 }
 #endif
 
 #ifdef USE_ROS2
+void Executor::syncWithRosTime(rclcpp::Node::SharedPtr node) {
+  clockNode = node;
+  syncWithRosTime();
+}
+
+void Executor::subscribeRosClock() {
+  if (clockSubscription != nullptr) return;
+  if (clockNode == nullptr) clockNode = std::make_shared<rclcpp::Node>("eeros_clock");
+  rclcpp::SubscriptionOptions options;
+  options.callback_group = registerSubscriber(clockNode);
+  clockSubscription = clockNode->create_subscription<rosgraph_msgs::msg::Clock>("/clock", rclcpp::ClockQoS(),
+    [this](const rosgraph_msgs::msg::Clock& msg) { rosClock.update(rclcpp::Time(msg.clock).nanoseconds()); }, options);
+}
+
 rclcpp::CallbackGroup::SharedPtr Executor::registerSubscriber(rclcpp::Node::SharedPtr node, const bool sync) {
   if (sync) {
     syncWithRosTopicSet = true;
     log.warn() << "sync executor with gazebo";
   }
   if (subscriberExecutor == nullptr) {
-    subscriberExecutor = rclcpp::executors::MultiThreadedExecutor::make_shared();
+    switch (rosExecutorType) {
+      case RosExecutor::singleThreaded:
+        subscriberExecutor = std::make_shared<rclcpp::executors::SingleThreadedExecutor>();
+        break;
+      case RosExecutor::events:
+#if __has_include(<rclcpp/experimental/executors/events_executor/events_executor.hpp>)
+        subscriberExecutor = std::make_shared<rclcpp::experimental::executors::EventsExecutor>();
+        break;
+#else
+        log.warn() << "events executor not available in this ROS distribution, using a static single threaded executor";
+        [[fallthrough]];
+#endif
+      case RosExecutor::staticSingleThreaded:
+        subscriberExecutor = std::make_shared<rclcpp::executors::StaticSingleThreadedExecutor>();
+        break;
+      default:
+        subscriberExecutor = std::make_shared<rclcpp::executors::MultiThreadedExecutor>(rclcpp::ExecutorOptions(), rosExecutorThreads);
+        break;
+    }
   }
-  auto callback_group = node->create_callback_group(rclcpp::CallbackGroupType::Reentrant);
+  auto callback_group = node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
   subscriberExecutor->add_callback_group(callback_group, node->get_node_base_interface());
   return callback_group;
 }
 
+void Executor::setRosExecutor(RosExecutor type, std::size_t threads, std::vector<int> cpus) {
+  if (subscriberExecutor != nullptr) log.warn() << "ROS executor already created, call setRosExecutor() before registering subscribers";
+  rosExecutorType = type;
+  rosExecutorThreads = threads;
+  rosExecutorCpus = cpus;
+}
+
 void Executor::handleTopic() {
   cv.notify_one();
 }
 #endif
 
 void Executor::run() {
-  log.trace() << "starting executor with base period " << period << " sec and priority " << (int)(basePriority) << " (thread " << getpid() << ":" << syscall(SYS_gettid) << ")";
+  currentExecutor = this;
+  log.trace() << "starting executor with base period " << period << " sec and priority " << basePriority - priorityOffset << " (thread " << getpid() << ":" << syscall(SYS_gettid) << ")";
   if (period == 0.0) throw std::runtime_error("period of executor not set");
   log.trace() << "assigning priorities";
   assignPriorities();
@@ -255,12 +690,89 @@ void Executor::run() {
   task::HarmonicTaskList taskList;
   task::Periodic executorTask("executor", period, this, true);
   counter.monitors = this->mainTask->monitors;
-  createThreads(log, tasks, executorTask, threads, taskList);
-  using seconds = std::chrono::duration<double, std::chrono::seconds::period>;
-  std::this_thread::sleep_for(seconds(1)); // wait 1 sec to allow threads to be created
-  if (!set_priority(0))
+  auto safetySystem = dynamic_cast<safety::SafetySystem*>(mainTask);
+  if (safetySystem != nullptr && safetySystem->hasLatenessEvent()) counter.monitors.push_back(safetySystem->getTimingMonitor());
+  overrun.setPolicy(this->mainTask->getOverrunPolicy(), this->mainTask->getSafetySystem(), this->mainTask->getSafetyEvent());
+  overrun.reset();
+  criticalSafetySystem = nullptr;
+  if (criticalFastPath) {
+    criticalSafetySystem = safetySystem;
+    traverse(tasks, [this] (task::Periodic *task) {
+      if (criticalSafetySystem == nullptr) criticalSafetySystem = dynamic_cast<safety::SafetySystem*>(&task->getTask());
+    });
+    if (criticalSafetySystem != nullptr) {
+      criticalSafetySystem->setCriticalFastPath(true);
+      log.trace() << "checking the critical inputs in each base cycle";
+    }
+  }
+  for (auto& t : tasks) {
+    auto td = dynamic_cast<control::TimeDomain*>(&t.getTask());
+    if (td == nullptr) continue;
+    for (auto block : td->validate()) {
+      log.warn() << "block '" << block->getName() << "' in time domain '" << td->getName() << "' has unconnected inputs";
+    }
+  }
+  std::unique_ptr<task::WorkerPool> pool;
+  if (poolThreads > 0) {
+    pool = std::make_unique<task::WorkerPool>(poolThreads, poolCpus);
+    log.trace() << "running non realtime periodics on a pool of " << poolThreads << " threads";
+  }
+  if (timingMode == TimingMode::lockstep) calibrationCycles = 0;
+  scheduled.clear();
+  cycleCount = 0;
+  if (schedulabilityCheck != SchedulabilityCheck::off && timingMode != TimingMode::lockstep) {
+    traverse(tasks, [this] (task::Periodic *task) {
+      if (task->getRealtime()) scheduled.emplace_back(task, nullptr);
+    });
+    if (calibrationCycles == 0 && !checkSchedulability() && schedulabilityCheck == SchedulabilityCheck::enforce)
+      throw std::runtime_error("task set is not schedulable");
+  }
+  std::vector<std::unique_ptr<task::HarmonicTaskList>> inlineLists;
+  if (timingMode == TimingMode::lockstep) createInline(distributePhases, tasks, executorTask, inlineLists, taskList);
+  else createThreads(log, distributePhases, pool.get(), tasks, executorTask, threads, taskList);
+  for (auto &s : scheduled) {
+    for (auto &t : threads) if (t->periodic == s.first && !t->pooled) s.second = &t->counter();
+  }
+  for (auto &t : threads) t->bind(this);
+  counter.setOsSampling(osCounters);
+  for (auto &t : threads) t->counter().setOsSampling(osCounters);
+  if (!timingExportPath.empty()) {
+    timingExport = std::make_unique<TimingExport>(timingExportPath, threads.size() + 1);
+    if (timingExport->isValid()) {
+      counter.setExport(timingExport->getRecord(0, "executor"));
+      for (uint32_t i = 0; i < threads.size(); i++) 
+        threads[i]->counter().setExport(timingExport->getRecord(i + 1, threads[i]->name));
+      log.trace() << "exporting timing statistics to '" << timingExportPath << "'";
+    } else {
+      log.error() << "could not create shared memory '" << timingExportPath << "' for timing statistics";
+    }
+  }
+  if (!taskTracePath.empty()) {
+    taskTrace = std::make_unique<TaskTrace>(taskTracePath);
+    if (taskTrace->isOpen()) {
+      counter.setTraceName("executor");
+      for (auto &t: threads) t->counter().setTraceName(t->name);
+      log.trace() << "recording task trace to '" << taskTracePath << "'";
+    } else {
+      log.error() << "could not create task trace '" << taskTracePath << "'";
+      taskTrace.reset();
+    }
+  }
+  // wait until all threads have set their priority, locked memory and prefaulted their stack
+  auto startupDeadline = steady_clock::now() + duration<double>(startupTimeout);
+  for (auto &t: threads) {
+    double remaining = duration<double>(startupDeadline - steady_clock::now()).count();
+    if (!t->waitReady(std::max(remaining, 0.0)))
+      log.error() << "harmonic thread not ready within " << startupTimeout << " sec";
+  }
+  applyCpuPower();
+  if (!set_priority(priorityOffset))
     log.error() << "could not set realtime priority";
-  prefault_stack();
+  if (!cpus.empty() && !set_affinity(cpus))
+    log.error() << "could not set cpu affinity of executor";
+  prefault_stack(stackPrefault);
+  if (heapReserve > 0 && !reserve_heap(heapReserve))
+    log.error() << "could not reserve " << heapReserve << " bytes of heap memory";
   if (!lock_memory())
     log.error() << "could not lock memory in RAM";
 
@@ -268,25 +780,45 @@ void Executor::run() {
   // starts spinning ROS2 subscribers in an own thread
   if (subscriberExecutor != nullptr) {
     subscriberThread = std::make_shared<std::thread>([this]() {
+      // threads of a multithreaded executor are spawned from here and inherit policy and affinity
+      struct sched_param param = {};
+      if (sched_setscheduler(0, SCHED_OTHER, &param) == -1) log.warn() << "could not reset scheduling policy of ROS executor";
+      if (!rosExecutorCpus.empty() && !set_affinity(rosExecutorCpus)) log.error() << "could not set cpu affinity of ROS executor";
       log.info() << "Starting ROS executor for handling ROS subscriptions";
       subscriberExecutor->spin();
     });
   }
 #endif
   running = true;
+  int64_t startNs = monotonicNowNs();
+  for (auto &t: threads) t->start(startNs);
 
 #ifdef USE_ETHERCAT
   if (etherCATStack) {
     log.trace() << "starting execution synched to etcherCAT stack";
     if (syncWithRosTimeSet) log.error() << "Can't use both etherCAT and RosTime to sync executor";
     if (syncWithRosTopicSet) log.error() << "Can't use both etherCAT and RosTopic to sync executor";
+    etherCATClock = ClockSync(llround(period * 1.0e9));
+    int64_t compute = 0;   // longest recent computation, decays slowly
     while (running) {
       etherCATStack->sync();
-      counter.tick();
+      int64_t synced = monotonicNowNs();
+      etherCATClock.update(synced);
+      if (etherCATLead > 0) {
+        int64_t wake = etherCATClock.predict() - etherCATLead - compute;
+        if (wake > synced) {
+          struct timespec deadline = toTimespec(wake);
+          while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR);
+        }
+      }
+      int64_t start = monotonicNowNs();
+      startCycle();
       taskList.run();
       if (mainTask != nullptr)
         mainTask->run();
+      if (updateHal) hal::HAL::instance().commitOutputs();
       counter.tock();
+      compute = std::max(monotonicNowNs() - start, compute - compute / 1024);
     }
   } else
 #else
@@ -296,17 +828,27 @@ void Executor::run() {
     if (syncWithEtherCatStackSet) log.error() << "Can't use both RosTime and etherCAT to sync executor";
     if (syncWithRosTopicSet) log.error() << "Can't use both RosTime and RosTopic to sync executor";
     uint64_t periodNsec = static_cast<uint64_t>(period * 1.0e9);
-    uint64_t nextCycle = eeros::System::getTimeNs() + periodNsec;
+    // without a simulation publishing /clock, ROS time is the wall clock and the executor sleeps for the remaining time
+    bool simulated = rosClock.waitForChange(0, 1.0);
+    if (!simulated) log.warn() << "no time published on /clock, running with ROS wall time";
+    uint64_t nextCycle = (simulated ? rosClock.getTimeNs() : eeros::System::getTimeNs()) + periodNsec;
     while (running) {
-      // spin and wait for next execution time to match ROS time
-      while (eeros::System::getTimeNs() < nextCycle && running) usleep(10);
-      counter.tick();
+      // sleep until the next execution time matches ROS time
+      if (simulated) {
+        if (!rosClock.waitUntil(nextCycle)) break;
+      } else {
+        uint64_t now = eeros::System::getTimeNs();
+        if (now < nextCycle) std::this_thread::sleep_for(nanoseconds(nextCycle - now));
+      }
+      startCycle();
       taskList.run();
       if (mainTask != nullptr)
         mainTask->run();
+      if (updateHal) hal::HAL::instance().commitOutputs();
       counter.tock();
       nextCycle += periodNsec;
     }
+    logRosClockLatency(log, rosClock);
   }
 #endif //(USE_ROS || USE_ROS2)
 #ifdef USE_ROS
@@ -314,31 +856,27 @@ void Executor::run() {
     log.trace() << "starting execution synched to gazebo";
     if (syncWithRosTimeSet) log.error() << "Can't use both RosTopic and RosTime to sync executor";
     if (syncWithEtherCatStackSet) log.error() << "Can't use both RosTopic and etherCAT to sync executor";
-    auto timeOld = ros::Time::now();
-    auto timeNew = ros::Time::now();
-    static bool first = true;
+    // waits for the first rosTime being published
+    uint64_t timeOld = 0;
+    if (!rosClock.waitForChange(timeOld)) running = false;
+    timeOld = rosClock.getTimeNs();
     while (running) {
-      if (first) {
-        while (timeOld == timeNew  && running) {	// waits for new rosTime beeing published
-          usleep(10);
-          timeNew = ros::Time::now();
-        }
-        first = false;
-        timeOld = timeNew;
-      }
-      while (syncRosCallbackQueue->isEmpty() && running) usleep(10);	//waits for new message;
-      while (timeOld == timeNew  && running) {		// waits for new rosTime beeing published
-        usleep(10);
-        timeNew = ros::Time::now();
+      // waits for a new message, blocking on the queue instead of polling it
+      if (syncRosCallbackQueue->isEmpty()) {
+        while (running && syncRosCallbackQueue->callOne(ros::WallDuration(0.01)) == ros::CallbackQueue::Empty);
       }
-      timeOld = timeNew;
+      // waits for a new rosTime being published
+      if (!running || !rosClock.waitForChange(timeOld)) break;
+      timeOld = rosClock.getTimeNs();
       syncRosCallbackQueue->callAvailable();
-      counter.tick();
+      startCycle();
       taskList.run();
       if (mainTask != nullptr)
         mainTask->run();
+      if (updateHal) hal::HAL::instance().commitOutputs();
       counter.tock();
     }
+    logRosClockLatency(log, rosClock);
   } else
 #endif //(USE_ROS)
 #ifdef USE_ROS2
@@ -349,33 +887,167 @@ void Executor::run() {
       while (running) {
         std::unique_lock<std::mutex> lk(cv_m);
         cv.wait(lk);
-        counter.tick();
+        startCycle();
         taskList.run();
         if (mainTask != nullptr)
           mainTask->run();
+        if (updateHal) hal::HAL::instance().commitOutputs();
         counter.tock();
       }
     } else
 #endif //(USE_ROS2)
   {
-    log.trace() << "starting periodic execution";
-    // use system time as a start and wait for regular intervals
-    auto nextCycle = std::chrono::steady_clock::now() + seconds(period);
-    while (running) {
-      std::this_thread::sleep_until(nextCycle);
-      counter.tick();
-      taskList.run();
-      if (mainTask != nullptr)
-        mainTask->run();
-      counter.tock();
-      nextCycle += seconds(period);
+    switch (timingMode) {
+      case TimingMode::absoluteNanosleep: runAbsoluteNanosleep(taskList, mainTask); break;
+      case TimingMode::timerfd: runTimerfd(taskList, mainTask); break;
+      case TimingMode::hybridSpin: runHybridSpin(taskList, mainTask); break;
+      case TimingMode::lockstep: runLockstep(taskList, mainTask); break;
+      default: runSteadyClock(taskList, mainTask); break;
     }
   }
 #endif //(USE_ETHERCAT)
 
   log.trace() << "stopping all threads";
-  for (auto &t: threads) t->async.stop();
+  for (auto &t: threads) t->stop();
+  if (criticalSafetySystem != nullptr) criticalSafetySystem->setCriticalFastPath(false);
+  criticalSafetySystem = nullptr;
+  if (pool) pool->stop();
   log.trace() << "joining all threads";
-  for (auto &t: threads) t->async.join();
+  for (auto &t: threads) t->join();
+  if (pool) pool->join();
+  cpuPower.release();
+  if (taskTrace) {
+    if (taskTrace->getDropped() > 0) log.warn() << "task trace dropped " << taskTrace->getDropped() << " events";
+    taskTrace.reset();
+  }
   log.trace() << "exiting executor " << " (thread " << getpid() << ":" << syscall(SYS_gettid) << ")";
 }
+
+void Executor::runSteadyClock(task::HarmonicTaskList &taskList, Runnable *mainTask) {
+  log.trace() << "starting periodic execution";
+  // use system time as a start and wait for regular intervals
+  auto steadyNowNs = []() { return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count(); };
+  const int64_t periodNs = llround(period * 1.0e9);
+  int64_t nextCycle = steadyNowNs() + periodNs;
+  while (running) {
+    std::this_thread::sleep_until(steady_clock::time_point(nanoseconds(nextCycle)));
+    startCycle();
+    taskList.run();
+    if (mainTask != nullptr)
+      mainTask->run();
+    if (updateHal) hal::HAL::instance().commitOutputs();
+    counter.tock();
+    nextCycle = overrun.release(nextCycle + periodNs, steadyNowNs(), periodNs, counter);
+  }
+}
+
+void Executor::runAbsoluteNanosleep(task::HarmonicTaskList &taskList, Runnable *mainTask) {
+  log.trace() << "starting periodic execution with absolute clock_nanosleep";
+  const int64_t periodNs = llround(period * 1.0e9);
+  int64_t nextCycle = monotonicNowNs() + periodNs;
+  while (running) {
+    struct timespec deadline = toTimespec(nextCycle);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR);
+    startCycle();
+    taskList.run();
+    if (mainTask != nullptr)
+      mainTask->run();
+    if (updateHal) hal::HAL::instance().commitOutputs();
+    counter.tock();
+    nextCycle = overrun.release(nextCycle + periodNs, monotonicNowNs(), periodNs, counter);
+  }
+}
+
+void Executor::runTimerfd(task::HarmonicTaskList &taskList, Runnable *mainTask) {
+  log.trace() << "starting periodic execution with timerfd";
+  const int64_t periodNs = llround(period * 1.0e9);
+  int fd = timerfd_create(CLOCK_MONOTONIC, 0);
+  if (fd < 0) throw std::runtime_error("could not create timerfd for executor");
+  struct itimerspec spec;
+  spec.it_interval = toTimespec(periodNs);
+  spec.it_value = toTimespec(monotonicNowNs() + periodNs);
+  if (timerfd_settime(fd, TFD_TIMER_ABSTIME, &spec, nullptr) != 0) {
+    close(fd);
+    throw std::runtime_error("could not start timerfd for executor");
+  }
+  uint64_t backlog = 0;
+  while (running) {
+    if (backlog == 0) {
+      uint64_t expirations = 0;
+      if (read(fd, &expirations, sizeof(expirations)) != sizeof(expirations)) continue;
+      if (expirations > 1) {
+        // the timer already coalesces missed expirations into one wakeup
+        counter.addOverruns(expirations - 1);
+        if (overrun.getPolicy() == task::OverrunPolicy::catchUp) backlog = expirations - 1;
+        else overrun.triggerEvent();
+      }
+    } else {
+      backlog--;
+    }
+    startCycle();
+    taskList.run();
+    if (mainTask != nullptr)
+      mainTask->run();
+    if (updateHal) hal::HAL::instance().commitOutputs();
+    counter.tock();
+  }
+  close(fd);
+}
+
+void Executor::runHybridSpin(task::HarmonicTaskList &taskList, Runnable *mainTask) {
+  constexpr int tuneCycles = 1000;
+  constexpr int64_t minMarginNs = 1000;
+  const int64_t periodNs = llround(period * 1.0e9);
+  int64_t marginNs = std::clamp<int64_t>(llround(spinMargin * 1.0e9), 0, periodNs / 2);
+  log.trace() << "starting periodic execution with hybrid sleep and spin, margin " << marginNs << " ns";
+  Statistics wakeup;
+  int64_t nextCycle = monotonicNowNs() + periodNs;
+  while (running) {
+    int64_t sleepUntil = nextCycle - marginNs;
+    if (monotonicNowNs() < sleepUntil) {
+      struct timespec deadline = toTimespec(sleepUntil);
+      while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR);
+      wakeup.add(static_cast<double>(monotonicNowNs() - sleepUntil));
+    }
+    while (monotonicNowNs() < nextCycle) cpuRelax();
+    startCycle();
+    taskList.run();
+    if (mainTask != nullptr)
+      mainTask->run();
+    if (updateHal) hal::HAL::instance().commitOutputs();
+    counter.tock();
+    if (spinAutoTune && wakeup.count >= tuneCycles) {
+      marginNs = std::clamp<int64_t>(llround(wakeup.max * 1.5), minMarginNs, periodNs / 2);
+      wakeup.reset();
+    }
+    nextCycle = overrun.release(nextCycle + periodNs, monotonicNowNs(), periodNs, counter);
+  }
+}
+
+void Executor::runLockstep(task::HarmonicTaskList &taskList, Runnable *mainTask) {
+  log.trace() << "starting execution in lockstep";
+  const uint64_t periodNs = llround(period * 1.0e9);
+  uint64_t now = 0;
+  std::unique_lock<std::mutex> lock(stepMutex);
+  while (running) {
+    stepCv.wait(lock, [this]() { return stepsRequested > stepsDone || !running; });
+    uint64_t cycles = stepsRequested - stepsDone;
+    lock.unlock();
+    uint64_t done = 0;
+    for (; done < cycles && running; done++) {
+      // the simulated time starts at one period, as a cycle timestamp of 0 means no cycle
+      now += periodNs;
+      System::beginCycle(now);
+      startCycle();
+      taskList.run();
+      if (mainTask != nullptr)
+        mainTask->run();
+      if (updateHal) hal::HAL::instance().commitOutputs();
+      counter.tock();
+      System::endCycle();
+    }
+    lock.lock();
+    stepsDone += done;
+    stepCv.notify_all();
+  }
+}
@@ -0,0 +1,57 @@
+#include <eeros/core/ExternalClock.hpp>
+#include <chrono>
+
+using namespace eeros;
+
+namespace {
+  uint64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+}
+
+void ExternalClock::update(uint64_t timeNs) {
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    time = timeNs;
+    updated = steadyNowNs();
+  }
+  cv.notify_all();
+}
+
+uint64_t ExternalClock::getTimeNs() const {
+  std::lock_guard<std::mutex> lock(mtx);
+  return time;
+}
+
+bool ExternalClock::waitUntil(uint64_t timeNs, double timeout) {
+  return wait([this, timeNs]() { return time >= timeNs; }, timeout);
+}
+
+bool ExternalClock::waitForChange(uint64_t timeNs, double timeout) {
+  return wait([this, timeNs]() { return time != timeNs; }, timeout);
+}
+
+void ExternalClock::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    stopped = true;
+  }
+  cv.notify_all();
+}
+
+const Histogram& ExternalClock::getLatency() const {
+  return latency;
+}
+
+template < typename Ready >
+bool ExternalClock::wait(Ready ready, double timeout) {
+  std::unique_lock<std::mutex> lock(mtx);
+  if (ready()) return !stopped;
+  auto done = [&]() { return stopped || ready(); };
+  if (timeout < 0) cv.wait(lock, done);
+  else if (!cv.wait_for(lock, std::chrono::duration<double>(timeout), done)) return false;
+  if (stopped) return false;
+  // only a thread which had to wait measures the delay of its wake up
+  latency.add((steadyNowNs() - updated) * 1e-9);
+  return true;
+}
@@ -1,13 +1,52 @@
 #include <eeros/core/Fault.hpp>
+#include <atomic>
 
 using namespace eeros;
 
+namespace {
+
+std::atomic<const FaultCode*> firstFault{nullptr};
+std::atomic<uint64_t> faultCount{0};
+
+}
+
 Fault::Fault() { }
 
 Fault::Fault(std::string m) : message(m) { }
 
+Fault::Fault(const FaultCode& f) : message(f.message), code(f.code) { }
+
 Fault::~Fault() throw() { }
 
 const char* Fault::what() const throw() {
   return message.c_str();
 }
+
+uint32_t Fault::getCode() const {
+  return code;
+}
+
+void FaultRegister::report(const FaultCode& fault) noexcept {
+  const FaultCode* expected = nullptr;
+  firstFault.compare_exchange_strong(expected, &fault, std::memory_order_release, std::memory_order_relaxed);
+  faultCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+const FaultCode* FaultRegister::first() noexcept {
+  return firstFault.load(std::memory_order_acquire);
+}
+
+uint64_t FaultRegister::count() noexcept {
+  return faultCount.load(std::memory_order_relaxed);
+}
+
+void FaultRegister::clear() noexcept {
+  faultCount.store(0, std::memory_order_relaxed);
+  firstFault.store(nullptr, std::memory_order_release);
+}
+
+void FaultRegister::rethrow() {
+  const FaultCode* f = firstFault.exchange(nullptr, std::memory_order_acq_rel);
+  faultCount.store(0, std::memory_order_relaxed);
+  if (f != nullptr) throw Fault(*f);
+}
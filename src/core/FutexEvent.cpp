@@ -0,0 +1,45 @@
+#include <eeros/core/FutexEvent.hpp>
+#include <chrono>
+#include <climits>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+using namespace eeros;
+
+namespace {
+
+long futex(std::atomic<int32_t>* addr, int op, int32_t val, const struct timespec* timeout = nullptr) {
+  return syscall(SYS_futex, reinterpret_cast<int32_t*>(addr), op, val, timeout, nullptr, 0);
+}
+
+}
+
+FutexEvent::FutexEvent() : generation(0), waiters(0) { }
+
+uint32_t FutexEvent::prepare() const {
+  return generation.load(std::memory_order_acquire);
+}
+
+bool FutexEvent::wait(uint32_t gen, double timeout_sec) {
+  using namespace std::chrono;
+  auto deadline = steady_clock::now() + duration_cast<steady_clock::duration>(duration<double>(timeout_sec));
+  bool notified = false;
+  waiters.fetch_add(1, std::memory_order_seq_cst);
+  while (!(notified = (static_cast<uint32_t>(generation.load(std::memory_order_acquire)) != gen))) {
+    auto remaining = duration_cast<nanoseconds>(deadline - steady_clock::now()).count();
+    if (remaining <= 0) break;
+    struct timespec ts;
+    ts.tv_sec = remaining / 1000000000;
+    ts.tv_nsec = remaining % 1000000000;
+    futex(&generation, FUTEX_WAIT_PRIVATE, static_cast<int32_t>(gen), &ts);
+  }
+  waiters.fetch_sub(1, std::memory_order_relaxed);
+  return notified;
+}
+
+void FutexEvent::notify() {
+  generation.fetch_add(1, std::memory_order_seq_cst);
+  if (waiters.load(std::memory_order_seq_cst) > 0) futex(&generation, FUTEX_WAKE_PRIVATE, INT_MAX);
+}
@@ -0,0 +1,76 @@
+#include <eeros/core/FutexSemaphore.hpp>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+using namespace eeros;
+
+namespace {
+
+long futex(std::atomic<int32_t>* addr, int op, int32_t val, const struct timespec* timeout = nullptr) {
+  return syscall(SYS_futex, reinterpret_cast<int32_t*>(addr), op, val, timeout, nullptr, 0);
+}
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  asm volatile("yield");
+#endif
+}
+
+}
+
+FutexSemaphore::FutexSemaphore(int value, int spin) : counter(value), waiters(0), spin(spin) { }
+
+bool FutexSemaphore::tryWait() {
+  int32_t c = counter.load(std::memory_order_relaxed);
+  while (c > 0) {
+    if (counter.compare_exchange_weak(c, c - 1, std::memory_order_acquire, std::memory_order_relaxed)) return true;
+  }
+  return false;
+}
+
+bool FutexSemaphore::spinWait() {
+  for (int i = 0; i < spin; i++) {
+    if (tryWait()) return true;
+    cpuRelax();
+  }
+  return tryWait();
+}
+
+void FutexSemaphore::wait() {
+  if (spinWait()) return;
+  waiters.fetch_add(1, std::memory_order_seq_cst);
+  while (!tryWait()) {
+    futex(&counter, FUTEX_WAIT_PRIVATE, 0);
+  }
+  waiters.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool FutexSemaphore::wait(double timeout_sec) {
+  if (spinWait()) return true;
+  using namespace std::chrono;
+  auto deadline = steady_clock::now() + duration_cast<steady_clock::duration>(duration<double>(timeout_sec));
+  bool result = false;
+  waiters.fetch_add(1, std::memory_order_seq_cst);
+  while (!(result = tryWait())) {
+    auto remaining = duration_cast<nanoseconds>(deadline - steady_clock::now()).count();
+    if (remaining <= 0) break;
+    struct timespec ts;
+    ts.tv_sec = remaining / 1000000000;
+    ts.tv_nsec = remaining % 1000000000;
+    futex(&counter, FUTEX_WAIT_PRIVATE, 0, &ts);
+  }
+  waiters.fetch_sub(1, std::memory_order_relaxed);
+  return result;
+}
+
+void FutexSemaphore::post() {
+  counter.fetch_add(1, std::memory_order_seq_cst);
+  if (waiters.load(std::memory_order_seq_cst) > 0) futex(&counter, FUTEX_WAKE_PRIVATE, 1);
+}
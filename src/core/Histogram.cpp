@@ -0,0 +1,82 @@
+#include <eeros/core/Histogram.hpp>
+#include <cmath>
+
+using namespace eeros;
+
+Histogram::Histogram() {
+  reset();
+}
+
+Histogram::Histogram(const Histogram& other) {
+  *this = other;
+}
+
+Histogram& Histogram::operator=(const Histogram& other) {
+  for (int i = 0; i < bucketCount; i++) {
+    positive[i].store(other.positive[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    negative[i].store(other.negative[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+  count.store(other.count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  return *this;
+}
+
+int Histogram::bucketIndex(uint64_t ns) {
+  if (ns < static_cast<uint64_t>(subBuckets)) return static_cast<int>(ns);
+  int msb = 63 - __builtin_clzll(ns);
+  if (msb > maxExponent) return bucketCount - 1;
+  int shift = msb - subBucketBits;
+  int mantissa = static_cast<int>(ns >> shift);
+  return (shift + 1) * subBuckets + (mantissa - subBuckets);
+}
+
+uint64_t Histogram::bucketUpperBound(int index) {
+  if (index < subBuckets) return static_cast<uint64_t>(index);
+  int shift = index / subBuckets - 1;
+  uint64_t mantissa = static_cast<uint64_t>(index % subBuckets + subBuckets);
+  return ((mantissa + 1) << shift) - 1;
+}
+
+void Histogram::add(double value) {
+  // single writer, a plain load and store avoids a locked read-modify-write
+  double ns = std::fabs(value) * 1.0e9;
+  int index = (ns >= 1.8e18) ? bucketCount - 1 : bucketIndex(static_cast<uint64_t>(ns));
+  auto &bucket = (value < 0) ? negative[index] : positive[index];
+  bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void Histogram::reset() {
+  for (auto &b : positive) b.store(0, std::memory_order_relaxed);
+  for (auto &b : negative) b.store(0, std::memory_order_relaxed);
+  count.store(0, std::memory_order_relaxed);
+}
+
+Histogram::Snapshot Histogram::snapshot() const {
+  Snapshot s;
+  for (int i = 0; i < bucketCount; i++) {
+    s.positive[i] = positive[i].load(std::memory_order_relaxed);
+    s.negative[i] = negative[i].load(std::memory_order_relaxed);
+    s.count += s.positive[i] + s.negative[i];
+  }
+  return s;
+}
+
+uint64_t Histogram::getCount() const {
+  return count.load(std::memory_order_relaxed);
+}
+
+double Histogram::Snapshot::percentile(double p) const {
+  if (count == 0) return 0;
+  uint64_t rank = static_cast<uint64_t>(std::ceil(p * count));
+  if (rank < 1) rank = 1;
+  uint64_t sum = 0;
+  for (int i = bucketCount - 1; i >= 0; i--) {
+    sum += negative[i];
+    if (sum >= rank) return -static_cast<double>(bucketUpperBound(i)) / 1.0e9;
+  }
+  for (int i = 0; i < bucketCount; i++) {
+    sum += positive[i];
+    if (sum >= rank) return static_cast<double>(bucketUpperBound(i)) / 1.0e9;
+  }
+  return static_cast<double>(bucketUpperBound(bucketCount - 1)) / 1.0e9;
+}
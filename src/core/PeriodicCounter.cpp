@@ -1,10 +1,17 @@
 #include <eeros/core/PeriodicCounter.hpp>
+#include <eeros/core/TaskTrace.hpp>
+#include <eeros/core/TimingExport.hpp>
+#include <eeros/core/Tracepoint.hpp>
 #include <eeros/logger/Pretty.hpp>
 #include <eeros/logger/StreamLogWriter.hpp>
+#ifdef __linux__
+#include <sched.h>
+#include <sys/resource.h>
+#endif
 using namespace eeros;
 
 PeriodicCounter::PeriodicCounter(double period, unsigned logger_category) :
-  reset_after(20), log(logger::Logger::getLogger('P')) {
+  overruns(0), reset_after(20), exportRecord(nullptr), osSampling(0), osCountdown(0), lastCpu(-1), log(logger::Logger::getLogger('P')) {
     
   setPeriod(period);
   start = clk::now();
@@ -27,12 +34,34 @@ void PeriodicCounter::addDefaultMonitor(double tolerance) {
 void PeriodicCounter::tick() {
   last = start;
   start = clk::now();
+  EEROS_TRACE1(periodic_tick, this);
+  if (!traceName.empty()) TaskTrace::begin(traceName.c_str(), "task");
 }
 
 void PeriodicCounter::tock() {
   time_point stop = clk::now();
+  EEROS_TRACE2(periodic_tock, this, std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+  if (!traceName.empty()) TaskTrace::end(traceName.c_str(), "task");
   double new_run = std::chrono::duration<double>(stop - start).count();
   run.add(new_run);
+  runHistogram.add(new_run);
+#ifdef __linux__
+  if (osSampling > 0) {
+    int cpu = sched_getcpu();
+    if (lastCpu >= 0 && cpu != lastCpu) os.migrations++;
+    lastCpu = cpu;
+    if (osCountdown-- == 0) {
+      osCountdown = osSampling - 1;
+      struct rusage usage;
+      if (getrusage(RUSAGE_THREAD, &usage) == 0) {
+        os.voluntarySwitches = usage.ru_nvcsw;
+        os.involuntarySwitches = usage.ru_nivcsw;
+        os.minorFaults = usage.ru_minflt;
+        os.majorFaults = usage.ru_majflt;
+      }
+    }
+  }
+#endif
   
   if (first) {
     first = false;
@@ -44,14 +73,37 @@ void PeriodicCounter::tock() {
   
   period.add(new_period);
   jitter.add(new_jitter);
+  periodHistogram.add(new_period);
+  jitterHistogram.add(new_jitter);
+  if (exportRecord != nullptr) TimingExport::write(*exportRecord, *this);
   
   for (auto &func: monitors) func(*this, log);
 }
 
+void PeriodicCounter::addOverruns(uint64_t count) {
+  overruns += count;
+}
+
+void PeriodicCounter::setExport(TimingRecord* record) {
+  exportRecord = record;
+}
+
+void PeriodicCounter::setTraceName(std::string name) {
+  traceName = name;
+}
+
+void PeriodicCounter::setOsSampling(unsigned cycles) {
+  osSampling = cycles;
+  osCountdown = 0;
+}
+
 void PeriodicCounter::reset() {
   period.reset();
   jitter.reset();
   run.reset();
+  periodHistogram.reset();
+  jitterHistogram.reset();
+  runHistogram.reset();
   reset_counter = (int)(reset_after / counter_period);
 }
 
@@ -73,7 +125,31 @@ void PeriodicCounter:: operator >> (eeros::logger::LogEntry &event) {
   event << "run   \t";
   l(event, run) << endl;
 
-  event << "count = " << period.count;
+  auto h = [](LogEntry &e, const Histogram &x) -> decltype(e) {
+    auto s = x.snapshot();
+    return e << pretty(s.percentile(0.99)) << "\t" << pretty(s.percentile(0.999)) << "\t" << pretty(s.percentile(0.99999));
+  };
+
+  event << "pctl: \t      p99\t    p99.9\t  p99.999" << endl;
+
+  event << "period\t";
+  h(event, periodHistogram) << endl;
+
+  event << "jitter\t";
+  h(event, jitterHistogram) << endl;
+
+  event << "run   \t";
+  h(event, runHistogram) << endl;
+
+  event << "count = " << period.count << "\toverruns = " << overruns;
+
+  if (osSampling > 0) {
+    event << endl << "os:   \t   vol cs\t invol cs\t  min flt\t  maj flt\t migrations" << endl;
+    event << "delta \t" << os.voluntarySwitches - osReported.voluntarySwitches << "\t" << os.involuntarySwitches - osReported.involuntarySwitches
+          << "\t" << os.minorFaults - osReported.minorFaults << "\t" << os.majorFaults - osReported.majorFaults
+          << "\t" << os.migrations - osReported.migrations;
+    osReported = os;
+  }
 }
 
 void PeriodicCounter:: operator >> (eeros::logger::LogEntry &&event) {
@@ -0,0 +1,89 @@
+#include <eeros/core/SignalChannel.hpp>
+#include <eeros/core/Fault.hpp>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace eeros;
+
+SignalChannel::SignalChannel(std::string name, uint32_t elementSize, uint32_t elements)
+    : name(name), size(sizeof(SignalChannelRegion) + elementSize * elements), dataSize(elementSize * elements), region(nullptr) {
+  int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0666);
+  if (fd == -1) throw Fault("Failed to open shared memory of signal channel '" + name + "'");
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (st.st_size < static_cast<off_t>(size) && ftruncate(fd, size) != 0)) {
+    close(fd);
+    throw Fault("Failed to size shared memory of signal channel '" + name + "'");
+  }
+  void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED) throw Fault("Failed to map shared memory of signal channel '" + name + "'");
+  region = static_cast<SignalChannelRegion*>(memory);
+
+  // a new object is zero filled, the side which claims it writes the layout and
+  // publishes it with the magic number, the others wait until it is published
+  uint32_t expected = 0;
+  if (region->magic.compare_exchange_strong(expected, SignalChannelRegion::initializing, std::memory_order_acquire)) {
+    region->version = SignalChannelRegion::layoutVersion;
+    region->elementSize = elementSize;
+    region->elements = elements;
+    region->magic.store(SignalChannelRegion::magicNumber, std::memory_order_release);
+  }
+  for (int i = 0; i < 1000 && region->magic.load(std::memory_order_acquire) == SignalChannelRegion::initializing; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  if (region->magic.load(std::memory_order_acquire) == SignalChannelRegion::initializing) {
+    munmap(region, size);
+    region = nullptr;
+    throw Fault("Layout of signal channel '" + name + "' was not published in time");
+  }
+  if (region->magic.load(std::memory_order_acquire) != SignalChannelRegion::magicNumber ||
+      region->version != SignalChannelRegion::layoutVersion ||
+      region->elementSize != elementSize || region->elements != elements) {
+    munmap(region, size);
+    region = nullptr;
+    throw Fault("Signal channel '" + name + "' exists with a different layout");
+  }
+}
+
+SignalChannel::~SignalChannel() {
+  if (region != nullptr) munmap(region, size);
+}
+
+void SignalChannel::write(const void* data, uint64_t timestamp) {
+  uint32_t seq = region->sequence.load(std::memory_order_relaxed);
+  region->sequence.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(region->data, data, dataSize);
+  region->timestamp = timestamp;
+  region->sequence.store(seq + 2, std::memory_order_release);
+  if (region->published.load(std::memory_order_relaxed) == 0) region->published.store(1, std::memory_order_release);
+}
+
+bool SignalChannel::read(void* data, uint64_t& timestamp, uint32_t& sequence, int retries) const {
+  if (region->published.load(std::memory_order_acquire) == 0) return false; // nothing written yet
+  for (int i = 0; i < retries; i++) {
+    uint32_t before = region->sequence.load(std::memory_order_acquire);
+    if (before & 1) continue;
+    std::memcpy(data, region->data, dataSize);
+    timestamp = region->timestamp;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (region->sequence.load(std::memory_order_relaxed) == before) {
+      sequence = before;
+      return true;
+    }
+  }
+  return false;
+}
+
+std::string SignalChannel::getName() const {
+  return name;
+}
+
+void SignalChannel::remove(std::string name) {
+  shm_unlink(name.c_str());
+}
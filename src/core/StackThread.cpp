@@ -0,0 +1,72 @@
+#include <eeros/core/StackThread.hpp>
+#include <eeros/core/Fault.hpp>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+using namespace eeros;
+
+namespace {
+  constexpr std::size_t reserve = 64 * 1024;
+
+  void* start(void* arg) {
+    std::unique_ptr<std::function<void()>> f(static_cast<std::function<void()>*>(arg));
+    (*f)();
+    return nullptr;
+  }
+}
+
+StackThread::StackThread(std::size_t stackSize, std::function<void()> f) : stackSize(stackSize) {
+  pthread_attr_t attr;
+  pthread_attr_init(&attr);
+  int error = 0;
+  if (stackSize > 0) error = pthread_attr_setstacksize(&attr, stackSize);
+  auto arg = new std::function<void()>(std::move(f));
+  if (error == 0) error = pthread_create(&handle, &attr, start, arg);
+  pthread_attr_destroy(&attr);
+  if (error != 0) {
+    delete arg;
+    throw Fault(std::string("could not create thread: ") + std::strerror(error));
+  }
+  running = true;
+}
+
+StackThread::~StackThread() {
+  join();
+}
+
+StackThread::StackThread(StackThread&& other)
+    : handle(other.handle), running(std::exchange(other.running, false)), stackSize(other.stackSize) { }
+
+StackThread& StackThread::operator=(StackThread&& other) {
+  if (this != &other) {
+    join();
+    handle = other.handle;
+    running = std::exchange(other.running, false);
+    stackSize = other.stackSize;
+  }
+  return *this;
+}
+
+bool StackThread::joinable() const {
+  return running;
+}
+
+void StackThread::join() {
+  if (running && !pthread_equal(handle, pthread_self())) {
+    pthread_join(handle, nullptr);
+    running = false;
+  }
+}
+
+pthread_t StackThread::native_handle() const {
+  return handle;
+}
+
+std::size_t StackThread::getStackSize() const {
+  return stackSize;
+}
+
+std::size_t StackThread::usableStack(std::size_t stackSize) {
+  return (stackSize > 2 * reserve) ? stackSize - reserve : stackSize / 2;
+}
@@ -1,6 +1,12 @@
+#include <eeros/config.hpp>
 #include <eeros/core/System.hpp>
 #include <eeros/core/Fault.hpp>
 #include <time.h>
+#include <fstream>
+#include <string>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
 #ifdef USE_ROS
 #include <ros/ros.h>
@@ -11,10 +17,36 @@
 #endif
 
 #define NS_PER_SEC 1000000000
-#define CLOCK CLOCK_MONOTONIC_RAW
 
 using namespace eeros;
 
+namespace {
+
+System::ClockSource clockSource = System::ClockSource::monotonicRaw;
+clockid_t clockId = CLOCK_MONOTONIC_RAW;
+
+// tsc to nanoseconds conversion: ns = tscBaseNs + ((tsc - tscBase) * tscMult) >> tscShift
+constexpr int tscShift = 32;
+uint64_t tscBase = 0;
+uint64_t tscBaseNs = 0;
+uint64_t tscMult = 0;
+
+// cycle timestamp of the calling thread, 0 if not within a cycle
+thread_local uint64_t cycleTimeNs = 0;
+
+bool invariantTsc() {
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(cpuinfo, line)) {
+    if (line.rfind("flags", 0) == 0) {
+      return line.find(" constant_tsc") != std::string::npos && line.find(" nonstop_tsc") != std::string::npos;
+    }
+  }
+  return false;
+}
+
+}
+
 uint64_t timespec2nsec(struct timespec ts) {
   return static_cast<uint64_t>(ts.tv_sec) * NS_PER_SEC + static_cast<uint64_t>(ts.tv_nsec);
 }
@@ -23,9 +55,48 @@ double timespec2sec(struct timespec ts) {
   return static_cast<double>(timespec2nsec(ts)) / NS_PER_SEC;
 }
 
+bool System::setClockSource(ClockSource source) {
+  switch (source) {
+    case ClockSource::monotonic:
+      clockId = CLOCK_MONOTONIC;
+      break;
+    case ClockSource::monotonicRaw:
+      clockId = CLOCK_MONOTONIC_RAW;
+      break;
+    case ClockSource::tsc: {
+#if defined(__x86_64__) || defined(__i386__)
+      if (!invariantTsc()) return false;
+      // calibrate against CLOCK_MONOTONIC over 20 ms
+      struct timespec t0, t1, delay = {0, 20000000};
+      clock_gettime(CLOCK_MONOTONIC, &t0);
+      uint64_t c0 = __rdtsc();
+      nanosleep(&delay, nullptr);
+      clock_gettime(CLOCK_MONOTONIC, &t1);
+      uint64_t c1 = __rdtsc();
+      uint64_t ns0 = timespec2nsec(t0), ns1 = timespec2nsec(t1);
+      if (c1 <= c0 || ns1 <= ns0) return false;
+      tscMult = static_cast<uint64_t>((static_cast<unsigned __int128>(ns1 - ns0) << tscShift) / (c1 - c0));
+      tscBase = c1;
+      tscBaseNs = ns1;
+      clockId = CLOCK_MONOTONIC;
+      break;
+#else
+      return false;
+#endif
+    }
+  }
+  clockSource = source;
+  return true;
+}
+
+System::ClockSource System::getClockSource() {
+  return clockSource;
+}
+
 double System::getClockResolution() {
+  if (clockSource == ClockSource::tsc) return static_cast<double>(tscMult) / (1ull << tscShift) / NS_PER_SEC;
   struct timespec ts;
-  if(clock_getres(CLOCK, &ts) != 0) {
+  if(clock_getres(clockId, &ts) != 0) {
     throw Fault("Failed to get clock resolution!");
   }
   return timespec2sec(ts);
@@ -41,7 +112,24 @@ void System::useRosTime() {
 }
 #endif
 
+bool System::beginCycle() {
+  if (cycleTimeNs != 0) return false;
+  cycleTimeNs = getTimeNs();
+  return true;
+}
+
+bool System::beginCycle(uint64_t timeNs) {
+  if (cycleTimeNs != 0) return false;
+  cycleTimeNs = timeNs;
+  return true;
+}
+
+void System::endCycle() {
+  cycleTimeNs = 0;
+}
+
 uint64_t System::getTimeNs() {
+  if (cycleTimeNs != 0) return cycleTimeNs;
 #ifdef USE_ROS
   if (rosTimeIsUsed) {
     auto time = ros::Time::now();
@@ -53,10 +141,23 @@ uint64_t System::getTimeNs() {
     return rclcpp::Clock(RCL_ROS_TIME).now().nanoseconds();
   }
 #endif
+  return getClockNs();
+}
 
+uint64_t System::getClockNs() {
+#if defined(__x86_64__) || defined(__i386__)
+  if (clockSource == ClockSource::tsc) {
+    return tscBaseNs + static_cast<uint64_t>((static_cast<unsigned __int128>(__rdtsc() - tscBase) * tscMult) >> tscShift);
+  }
+#endif
   struct timespec ts;
-  if(clock_gettime(CLOCK, &ts) != 0) {
-    throw Fault("Failed to get time!");
+  if(clock_gettime(clockId, &ts) != 0) {
+#ifdef EEROS_RT_HOTPATH
+    FaultRegister::report(faults::clock);
+    return 0;
+#else
+    throw Fault(faults::clock);
+#endif
   }
   return timespec2nsec(ts);
 }
@@ -39,7 +39,10 @@ uint64_t System::getTimeNs() {
     return rclcpp::Clock(RCL_ROS_TIME).now().nanoseconds();
   }
   #endif
+  return getClockNs();
+}
 
+uint64_t System::getClockNs() {
   auto nsecs = std::chrono::high_resolution_clock::now().time_since_epoch();
   return std::chrono::duration_cast<std::chrono::nanoseconds>(nsecs).count();
 }
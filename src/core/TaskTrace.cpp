@@ -0,0 +1,126 @@
+#include <eeros/core/TaskTrace.hpp>
+#include <eeros/core/System.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using namespace eeros;
+
+namespace {
+  constexpr auto period = std::chrono::milliseconds(10);
+}
+
+// one cache line, the name is copied as the owner of the name may be gone when the event is written
+struct TaskTrace::Event {
+  uint64_t ns;
+  const char* category;
+  int32_t tid;
+  int16_t cpu;
+  char phase;
+  char name[nameLength];
+};
+
+struct TaskTrace::Channel {
+  std::atomic<std::thread::id> owner{};
+  std::atomic<TaskTrace*> trace{nullptr};
+  int32_t tid = 0;
+  eeros::SpscRingBuffer<Event, ringSize> ring;
+};
+
+std::atomic<TaskTrace*> TaskTrace::active{nullptr};
+
+TaskTrace::TaskTrace(std::string file) : out(file), pid(getpid()) {
+  for (auto& c : channels) {
+    c = std::make_shared<Channel>();
+    c->trace.store(this, std::memory_order_relaxed);
+  }
+  out << "{\"traceEvents\":[";
+  thread = std::thread([this]() { run(); });
+  active.store(this, std::memory_order_release);
+}
+
+TaskTrace::~TaskTrace() {
+  TaskTrace* self = this;
+  active.compare_exchange_strong(self, nullptr, std::memory_order_acq_rel);
+  running.store(false, std::memory_order_relaxed);
+  if (thread.joinable()) thread.join();
+  drain();
+  out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+  // threads which still cache a channel must not find this trace again
+  for (auto& c : channels) c->trace.store(nullptr, std::memory_order_relaxed);
+}
+
+bool TaskTrace::isOpen() const {
+  return out.is_open();
+}
+
+uint64_t TaskTrace::getDropped() const {
+  return dropped.load(std::memory_order_relaxed);
+}
+
+void TaskTrace::record(const char* name, const char* category, char phase) {
+  Channel* c = channel();
+  Event e{System::getClockNs(), category, 0, static_cast<int16_t>(sched_getcpu()), phase, {}};
+  std::strncpy(e.name, name, nameLength - 1);
+  if (c != nullptr) e.tid = c->tid;
+  if (c == nullptr || !c->ring.push(e)) dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+TaskTrace::Channel* TaskTrace::channel() {
+  // releases the channel when the thread ends, so another thread can take it
+  struct Slot {
+    std::shared_ptr<Channel> channel;
+    ~Slot() {
+      if (channel) channel->owner.store(std::thread::id(), std::memory_order_release);
+    }
+  };
+  thread_local Slot slot;
+  if (slot.channel && slot.channel->trace.load(std::memory_order_relaxed) == this) return slot.channel.get();
+
+  // first event of this thread to this trace, a thread keeps one channel only
+  std::thread::id self = std::this_thread::get_id();
+  for (auto& c : channels) {
+    std::thread::id free{};
+    if (c->owner.compare_exchange_strong(free, self, std::memory_order_acquire)) {
+      if (slot.channel) slot.channel->owner.store(std::thread::id(), std::memory_order_release);
+      c->tid = static_cast<int32_t>(syscall(SYS_gettid));
+      slot.channel = c;
+      return c.get();
+    }
+  }
+  return nullptr;
+}
+
+void TaskTrace::drain() {
+  std::lock_guard<std::mutex> lock(drainMtx);
+  Event e;
+  bool written = false;
+  for (auto& c : channels) {
+    while (c->ring.pop(e)) {
+      // a thread is named after the first slice it recorded
+      if (named.insert(e.tid).second) {
+        out << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << e.tid
+            << ",\"args\":{\"name\":\"" << e.name << "\"}}";
+        first = false;
+      }
+      // microseconds with nanosecond resolution
+      char ts[32];
+      std::snprintf(ts, sizeof(ts), "%llu.%03llu", static_cast<unsigned long long>(e.ns / 1000), static_cast<unsigned long long>(e.ns % 1000));
+      out << (first ? "\n" : ",\n") << "{\"name\":\"" << e.name << "\",\"cat\":\"" << e.category << "\",\"ph\":\"" << e.phase
+          << "\",\"ts\":" << ts << ",\"pid\":" << pid << ",\"tid\":" << e.tid << ",\"args\":{\"cpu\":" << e.cpu << "}}";
+      first = false;
+      written = true;
+    }
+  }
+  if (written) out.flush();
+}
+
+void TaskTrace::run() {
+  while (running.load(std::memory_order_relaxed)) {
+    drain();
+    std::this_thread::sleep_for(period);
+  }
+}
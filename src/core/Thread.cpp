@@ -1,4 +1,5 @@
 #include <eeros/core/Thread.hpp>
+#include <eeros/core/Executor.hpp>
 #include <sstream>
 #include <sched.h>
 #include <sys/syscall.h>
@@ -6,7 +7,8 @@
 
 using namespace eeros;
 
-Thread::Thread(int priority) : log(logger::Logger::getLogger('T')), t([&,priority]() {
+Thread::Thread(int priority, std::size_t stackSize) : log(logger::Logger::getLogger('T')), t(stackSize, [&,priority,stackSize]() {
+  if (stackSize > 0) Executor::prefault_stack(StackThread::usableStack(stackSize));
   if (priority != 20) {
     struct sched_param schedulingParam;
     schedulingParam.sched_priority = priority;
@@ -18,13 +20,13 @@ Thread::Thread(int priority) : log(logger::Logger::getLogger('T')), t([&,priorit
   log.trace() << "thread " << getpid() << ":" << syscall(SYS_gettid) << " finished.";
 }) { }
 
-Thread::Thread(std::function<void ()> t) : log(logger::Logger::getLogger('T')), t(t) { }
+Thread::Thread(std::function<void ()> t) : log(logger::Logger::getLogger('T')), t(0, t) { }
 
 Thread::~Thread() {join();}
 
 std::string Thread::getId() const {
   std::ostringstream s;
-  s << t.get_id();
+  s << t.native_handle();
   return s.str();
 }
 
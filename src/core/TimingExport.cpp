@@ -0,0 +1,95 @@
+#include <eeros/core/TimingExport.hpp>
+#include <eeros/core/PeriodicCounter.hpp>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace eeros;
+
+namespace {
+
+uint32_t regionSize(uint32_t records) {
+  return sizeof(TimingRegion) + records * sizeof(TimingRecord);
+}
+
+// the fields of a record are only accessed between the fences of the sequence lock
+void copyFields(TimingRecord& to, const TimingRecord& from) {
+  std::memcpy(to.name, from.name, sizeof(to.name));
+  to.count = from.count;
+  to.overruns = from.overruns;
+  to.periodLast = from.periodLast; to.periodMean = from.periodMean; to.periodMin = from.periodMin; to.periodMax = from.periodMax;
+  to.jitterLast = from.jitterLast; to.jitterMean = from.jitterMean; to.jitterMin = from.jitterMin; to.jitterMax = from.jitterMax;
+  to.runLast = from.runLast; to.runMean = from.runMean; to.runMin = from.runMin; to.runMax = from.runMax;
+}
+
+}
+
+TimingExport::TimingExport(std::string path, uint32_t records) : shm(path, regionSize(records)), region(nullptr) {
+  void* memory = shm.getMemoryPointer();
+  if (memory == MAP_FAILED || memory == (void*)kShmError) return;
+  std::memset(memory, 0, regionSize(records));
+  region = static_cast<TimingRegion*>(memory);
+  region->magic = TimingRegion::magicNumber;
+  region->version = TimingRegion::layoutVersion;
+  region->records = records;
+}
+
+TimingRegion* TimingExport::open(std::string path) {
+  int fd = shm_open(path.c_str(), O_RDONLY, 0);
+  if (fd == -1) return nullptr;
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(TimingRegion))) {
+    close(fd);
+    return nullptr;
+  }
+  void* memory = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED) return nullptr;
+  auto r = static_cast<TimingRegion*>(memory);
+  if (r->magic != TimingRegion::magicNumber || r->version != TimingRegion::layoutVersion ||
+      regionSize(r->records) > static_cast<uint32_t>(st.st_size)) {
+    munmap(memory, st.st_size);
+    return nullptr;
+  }
+  return r;
+}
+
+bool TimingExport::isValid() const {
+  return region != nullptr;
+}
+
+TimingRecord* TimingExport::getRecord(uint32_t index, std::string name) {
+  if (region == nullptr || index >= region->records) return nullptr;
+  TimingRecord& r = region->record[index];
+  std::strncpy(r.name, name.c_str(), TimingRecord::nameLength - 1);
+  return &r;
+}
+
+void TimingExport::write(TimingRecord& r, const PeriodicCounter& c) {
+  uint32_t seq = r.sequence.load(std::memory_order_relaxed);
+  r.sequence.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  r.count = c.period.count;
+  r.overruns = c.overruns;
+  r.periodLast = c.period.last; r.periodMean = c.period.mean; r.periodMin = c.period.min; r.periodMax = c.period.max;
+  r.jitterLast = c.jitter.last; r.jitterMean = c.jitter.mean; r.jitterMin = c.jitter.min; r.jitterMax = c.jitter.max;
+  r.runLast = c.run.last; r.runMean = c.run.mean; r.runMin = c.run.min; r.runMax = c.run.max;
+  r.sequence.store(seq + 2, std::memory_order_release);
+}
+
+bool TimingExport::read(const TimingRecord& r, TimingRecord& copy, int retries) {
+  for (int i = 0; i < retries; i++) {
+    uint32_t before = r.sequence.load(std::memory_order_acquire);
+    if (before & 1) continue;
+    copyFields(copy, r);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint32_t after = r.sequence.load(std::memory_order_relaxed);
+    if (before == after) {
+      copy.sequence.store(before, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,119 @@
+#include <eeros/core/Wcet.hpp>
+#include <eeros/core/System.hpp>
+#include <chrono>
+#include <fstream>
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+using namespace eeros;
+
+namespace {
+  constexpr std::size_t cacheLine = 64;
+  volatile char flushSink;
+
+  // level descriptions may contain commas
+  std::string field(const std::string& s) {
+    if (s.find_first_of(",\"") == std::string::npos) return s;
+    std::string quoted = "\"";
+    for (char c : s) {
+      if (c == '"') quoted += '"';
+      quoted += c;
+    }
+    return quoted + '"';
+  }
+}
+
+// never destroyed, the blocks and levels keep their probes until the program exits
+Wcet::Registry& Wcet::registry() {
+  static Registry* r = new Registry();
+  return *r;
+}
+
+Wcet::Probe* Wcet::probe(const std::string& kind, const std::string& name) {
+  Registry& r = registry();
+  std::lock_guard<std::mutex> lock(r.mtx);
+  for (auto& p : r.probes) {
+    if (p.kind == kind && p.name == name) return &p;
+  }
+  // a deque keeps the probes in place while new ones are added
+  Probe& p = r.probes.emplace_back();
+  p.kind = kind;
+  p.name = name;
+  return &p;
+}
+
+uint64_t Wcet::ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+  unsigned int aux;
+  return __rdtscp(&aux);   // waits for the preceding instructions
+#else
+  return System::getClockNs();
+#endif
+}
+
+double Wcet::ticksPerSecond() {
+#if defined(__x86_64__) || defined(__i386__)
+  static double rate = []() {
+    uint64_t t0 = ticks(), n0 = System::getClockNs();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    uint64_t t1 = ticks(), n1 = System::getClockNs();
+    return (t1 - t0) * 1.0e9 / (n1 - n0);
+  }();
+  return rate;
+#else
+  return 1.0e9;
+#endif
+}
+
+void Wcet::setCacheFlush(std::size_t bytes) {
+  Registry& r = registry();
+  std::lock_guard<std::mutex> lock(r.mtx);
+  // the buffer is only replaced while flushing is disabled, so no thread reads the old one
+  r.flushSize.store(0, std::memory_order_release);
+  r.flushData.store(nullptr, std::memory_order_release);
+  if (bytes > r.flushBuffer.size()) r.flushBuffer.assign(bytes, 1);
+  if (bytes == 0) return;
+  r.flushData.store(r.flushBuffer.data(), std::memory_order_release);
+  r.flushSize.store(bytes, std::memory_order_release);
+}
+
+void Wcet::flushCaches() {
+  Registry& r = registry();
+  std::size_t size = r.flushSize.load(std::memory_order_acquire);
+  if (size == 0) return;
+  const char* data = r.flushData.load(std::memory_order_acquire);
+  char sum = 0;
+  for (std::size_t i = 0; i < size; i += cacheLine) sum += data[i];
+  flushSink = sum;
+}
+
+void Wcet::reset() {
+  Registry& r = registry();
+  std::lock_guard<std::mutex> lock(r.mtx);
+  for (auto& p : r.probes) {
+    p.runs.store(0, std::memory_order_relaxed);
+    p.max.store(0, std::memory_order_relaxed);
+  }
+}
+
+void Wcet::report(std::ostream& out) {
+  double us = 1.0e6 / ticksPerSecond();
+  Registry& r = registry();
+  std::lock_guard<std::mutex> lock(r.mtx);
+  out << "kind,name,runs,max ticks,max us\n";
+  for (auto& p : r.probes) {
+    uint64_t runs = p.runs.load(std::memory_order_relaxed);
+    if (runs == 0) continue;
+    uint64_t max = p.max.load(std::memory_order_relaxed);
+    out << p.kind << ',' << field(p.name) << ',' << runs << ',' << max << ',' << max * us << '\n';
+  }
+}
+
+bool Wcet::report(const std::string& path) {
+  std::ofstream file(path);
+  if (!file) return false;
+  report(file);
+  return static_cast<bool>(file);
+}
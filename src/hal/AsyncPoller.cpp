@@ -0,0 +1,78 @@
+#include <eeros/hal/AsyncPoller.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+using namespace eeros::hal;
+
+namespace {
+
+int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+AsyncPoller& AsyncPoller::instance() {
+  static AsyncPoller poller;
+  return poller;
+}
+
+AsyncPoller::AsyncPoller() : log(logger::Logger::getLogger('H')) {
+  thread = std::thread([this]() { run(); });
+}
+
+AsyncPoller::~AsyncPoller() {
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    running = false;
+  }
+  cv.notify_one();
+  if (thread.joinable()) thread.join();
+}
+
+int AsyncPoller::add(std::function<void()> poll, double period) {
+  int64_t periodNs = std::max<int64_t>(llround(period * 1.0e9), 1);
+  int id;
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    id = nextId++;
+    entries[id] = Entry{poll, periodNs, nowNs() + periodNs};
+  }
+  cv.notify_one();
+  return id;
+}
+
+void AsyncPoller::remove(int id) {
+  std::lock_guard<std::mutex> lock(mtx);  // waits for a running poll
+  entries.erase(id);
+}
+
+int AsyncPoller::getCount() {
+  std::lock_guard<std::mutex> lock(mtx);
+  return entries.size();
+}
+
+void AsyncPoller::run() {
+  std::unique_lock<std::mutex> lock(mtx);
+  while (running) {
+    int64_t next = std::numeric_limits<int64_t>::max();
+    int64_t now = nowNs();
+    for (auto& e : entries) {
+      if (e.second.next <= now) {
+        try {
+          e.second.poll();
+        } catch (std::exception& ex) {
+          log.error() << "async poller: " << ex.what();
+        }
+        e.second.next += e.second.periodNs;
+        // a device slower than its period is read as often as it can be, not in bursts
+        if (e.second.next <= now) e.second.next = now + e.second.periodNs;
+      }
+      next = std::min(next, e.second.next);
+    }
+    if (next == std::numeric_limits<int64_t>::max()) cv.wait(lock);
+    else cv.wait_for(lock, std::chrono::nanoseconds(next - nowNs()));
+  }
+}
@@ -1,4 +1,6 @@
 #include <eeros/hal/BaumerOM70.hpp>
+#include <eeros/core/System.hpp>
+#include <cstring>
 
 using namespace eeros::hal;
 
@@ -12,6 +14,8 @@ BaumerOM70::BaumerOM70 (std::string dev, int port, int slaveId, int priority)
   if (connectOutput == -1) {
     log.info() << "Baumer OM70, Modbus connection failed: " << modbus_strerror ( errno );
     modbus_free(ctx);
+    ctx = nullptr;
+    starting = false;
     return;
   } else {
     log.info() << "Baumer OM70, Modbus connection successfull";
@@ -22,27 +26,42 @@ BaumerOM70::BaumerOM70 (std::string dev, int port, int slaveId, int priority)
 BaumerOM70::~BaumerOM70() {
   running = false;
   join();
+  if (ctx == nullptr) return;
   modbus_close(ctx);
   modbus_free(ctx);
 }
 
 void BaumerOM70::getMeasurements() {
-  modbus_read_input_registers (ctx, 200, 17, tabReg);
-
-  // Distance [mm]
-  uint32_t* ptr_i = (uint32_t*) &tabReg[3];
-  float* ptr_f = reinterpret_cast<float*> (ptr_i);
-
-  distance = (*ptr_f) * 0.001; // from [mm] to [m]
+  uint64_t start = System::getTimeNs();
+  int rc = modbus_read_input_registers (ctx, 200, 17, tabReg);
+  uint64_t now = System::getTimeNs();
+  if (rc != 17) {
+    stats.errors++;
+    timing.write(stats);
+    return;
+  }
+  stats.latency.add((now - start) * 1e-9);
 
-  // Measurement rate [Hz]
-//   uint32_t* ptr_i_rate = (uint32_t*) &tabReg[5];
-//   float* ptr_rate = reinterpret_cast<float*> (ptr_i_rate);
-//   measRate = *ptr_rate;
+  // 32 bit values span two registers, in the word order of the host
+  uint32_t deviceTime;
+  memcpy(&deviceTime, &tabReg[15], sizeof(deviceTime)); // Timestamp [us]
+  if (!first && deviceTime == latest.deviceTime) {
+    timing.write(stats);
+    return;  // no new measurement since the last transaction
+  }
+  if (!first) stats.rate.add(1e6 / (uint32_t)(deviceTime - latest.deviceTime));
+  first = false;
 
-  // Timestamp [us]
-//   uint32_t* ptr_i_stamp = (uint32_t*) &tabReg[15];
-//   timestampUs = *ptr_i_stamp;
+  float value;
+  memcpy(&value, &tabReg[3], sizeof(value)); // Distance [mm]
+  latest.distance = value * 0.001;           // from [mm] to [m]
+  memcpy(&latest.measRate, &tabReg[5], sizeof(latest.measRate)); // Measurement rate [Hz]
+  latest.quality = tabReg[0];
+  latest.alarm = tabReg[1];
+  latest.deviceTime = deviceTime;
+  latest.timestamp = now;
+  sample.write(latest);
+  timing.write(stats);
 }
 
 void BaumerOM70::getMeasRangeLimits() {
@@ -75,11 +94,22 @@ void BaumerOM70::switchOffLaser() {
 }
 
 float BaumerOM70::getDistance() {
-  return distance;
+  Sample s{};
+  sample.read(s);
+  return s.distance;
+}
+
+bool BaumerOM70::getSample(Sample& s) const {
+  return sample.read(s);
+}
+
+bool BaumerOM70::getTiming(Timing& t) const {
+  return timing.read(t);
 }
 
 void BaumerOM70::run() {
   while(starting);
+  if (ctx == nullptr) return;
   running = true;
   while (running) {
     getMeasurements();
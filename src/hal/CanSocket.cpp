@@ -0,0 +1,103 @@
+#include <eeros/hal/CanSocket.hpp>
+#include <eeros/core/Fault.hpp>
+#include <eeros/core/System.hpp>
+#include <cstring>
+#include <ctime>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+using namespace eeros;
+using namespace eeros::hal;
+
+CanSocket::CanSocket(std::string interface) : fd(-1) {
+  fd = ::socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, CAN_RAW);
+  if (fd < 0) throw Fault("failed to open CAN socket for " + interface);
+  ifreq ifr;
+  std::memset(&ifr, 0, sizeof(ifr));
+  interface.copy(ifr.ifr_name, sizeof(ifr.ifr_name) - 1);
+  if (::ioctl(fd, SIOCGIFINDEX, &ifr) < 0) {
+    ::close(fd);
+    throw Fault("CAN interface " + interface + " not found");
+  }
+  sockaddr_can addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.can_family = AF_CAN;
+  addr.can_ifindex = ifr.ifr_ifindex;
+  if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+    ::close(fd);
+    throw Fault("failed to bind CAN socket to " + interface);
+  }
+  int flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+  if (::setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) != 0) { /* frames are stamped on receive() */ }
+  prepare();
+}
+
+CanSocket::CanSocket(int fd) : fd(fd) {
+  prepare();
+}
+
+CanSocket::~CanSocket() {
+  if (fd >= 0) ::close(fd);
+}
+
+void CanSocket::prepare() {
+  std::memset(msgs, 0, sizeof(msgs));
+  for (int i = 0; i < capacity; i++) {
+    iov[i] = {&frames[i], sizeof(can_frame)};
+    msgs[i].msg_hdr.msg_iov = &iov[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+    msgs[i].msg_hdr.msg_control = control[i];
+  }
+  std::memset(txMsgs, 0, sizeof(txMsgs));
+  for (int i = 0; i < capacity; i++) {
+    txIov[i] = {&txFrames[i], sizeof(can_frame)};
+    txMsgs[i].msg_hdr.msg_iov = &txIov[i];
+    txMsgs[i].msg_hdr.msg_iovlen = 1;
+  }
+}
+
+bool CanSocket::queue(const can_frame& frame) {
+  if (queued >= capacity) return false;
+  txFrames[queued++] = frame;
+  return true;
+}
+
+int CanSocket::flush() {
+  int sent = 0;
+  while (sent < queued) {
+    int n = ::sendmmsg(fd, txMsgs + sent, queued - sent, MSG_DONTWAIT);
+    if (n <= 0) break;
+    sent += n;
+  }
+  queued = 0;
+  return sent;
+}
+
+int CanSocket::receive() {
+  for (int i = 0; i < capacity; i++) msgs[i].msg_hdr.msg_controllen = sizeof(control[i]);
+  int n = ::recvmmsg(fd, msgs, capacity, MSG_DONTWAIT, nullptr);
+  if (n <= 0) return 0;
+
+  // kernel stamps are CLOCK_REALTIME, shift them to the system time base
+  timespec rt;
+  clock_gettime(CLOCK_REALTIME, &rt);
+  uint64_t now = System::getTimeNs();
+  int64_t shift = static_cast<int64_t>(now) - (static_cast<int64_t>(rt.tv_sec) * 1000000000 + rt.tv_nsec);
+
+  int count = 0;
+  for (int i = 0; i < n; i++) {
+    if (msgs[i].msg_len != sizeof(can_frame)) continue;   // e.g. CAN FD frames
+    uint64_t ts = now;
+    for (cmsghdr* c = CMSG_FIRSTHDR(&msgs[i].msg_hdr); c != nullptr; c = CMSG_NXTHDR(&msgs[i].msg_hdr, c)) {
+      if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SO_TIMESTAMPING) {
+        scm_timestamping stamp;
+        std::memcpy(&stamp, CMSG_DATA(c), sizeof(stamp));
+        if (stamp.ts[0].tv_sec != 0) ts = static_cast<int64_t>(stamp.ts[0].tv_sec) * 1000000000 + stamp.ts[0].tv_nsec + shift;
+      }
+    }
+    if (count != i) frames[count] = frames[i];
+    timestamps[count++] = ts;
+  }
+  return count;
+}
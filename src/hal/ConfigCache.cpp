@@ -0,0 +1,119 @@
+#include <eeros/hal/ConfigCache.hpp>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+using namespace eeros::hal;
+
+namespace {
+
+constexpr uint32_t magic = 0x43484545;   // "EEHC"
+constexpr uint32_t version = 2;
+constexpr uint32_t maxChannels = 1 << 16;
+
+class Writer {
+ public:
+  Writer(std::ostream& os) : os(os) { }
+  template < typename T > void put(T value) {
+    os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+  void put(const std::string& s) {
+    put(static_cast<uint32_t>(s.size()));
+    os.write(s.data(), s.size());
+  }
+ private:
+  std::ostream& os;
+};
+
+class Reader {
+ public:
+  Reader(std::istream& is) : is(is) { }
+  template < typename T > bool get(T& value) {
+    return static_cast<bool>(is.read(reinterpret_cast<char*>(&value), sizeof(value)));
+  }
+  bool get(std::string& s) {
+    uint32_t size;
+    if (!get(size) || size > maxString) return false;
+    s.resize(size);
+    return static_cast<bool>(is.read(s.data(), size));
+  }
+ private:
+  static constexpr uint32_t maxString = 1 << 20;
+  std::istream& is;
+};
+
+}
+
+uint64_t ConfigCache::hash(const std::string& file) {
+  std::ifstream in(file, std::ios::binary);
+  if (!in) return 0;
+  uint64_t h = 0xcbf29ce484222325ull;
+  for (std::istreambuf_iterator<char> it(in), end; it != end; ++it) {
+    h ^= static_cast<unsigned char>(*it);
+    h *= 0x100000001b3ull;
+  }
+  return h;
+}
+
+bool ConfigCache::save(const std::string& file, uint64_t hash, const std::vector<ChannelConfig>& channels) {
+  std::string tmp = file + ".tmp";
+  {
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    Writer w(out);
+    w.put(magic);
+    w.put(version);
+    w.put(hash);
+    w.put(static_cast<uint32_t>(channels.size()));
+    for (auto& c : channels) {
+      w.put(static_cast<uint8_t>(c.kind));
+      w.put(c.library);
+      w.put(c.lazyBinding);
+      w.put(c.type);
+      w.put(c.id);
+      w.put(c.devHandle);
+      w.put(c.subDevice);
+      for (auto ch : c.channel) w.put(ch);
+      w.put(c.inverted);
+      w.put(c.scale);
+      w.put(c.offset);
+      w.put(c.rangeMin);
+      w.put(c.rangeMax);
+      w.put(c.safe);
+      w.put(c.unit);
+      w.put(c.additionalArguments);
+      w.put(c.asyncPeriod);
+    }
+    out.flush();
+    if (!out) {
+      std::remove(tmp.c_str());
+      return false;
+    }
+  }
+  // a crash while writing leaves the previous cache intact
+  return std::rename(tmp.c_str(), file.c_str()) == 0;
+}
+
+bool ConfigCache::load(const std::string& file, uint64_t hash, std::vector<ChannelConfig>& channels) {
+  if (hash == 0) return false;
+  std::ifstream in(file, std::ios::binary);
+  if (!in) return false;
+  Reader r(in);
+  uint32_t m, v, count;
+  uint64_t h;
+  if (!r.get(m) || m != magic || !r.get(v) || v != version || !r.get(h) || h != hash || !r.get(count)) return false;
+  if (count > maxChannels) return false;
+  std::vector<ChannelConfig> result(count);
+  for (auto& c : result) {
+    uint8_t kind;
+    bool ok = r.get(kind) && r.get(c.library) && r.get(c.lazyBinding) && r.get(c.type) && r.get(c.id) &&
+              r.get(c.devHandle) && r.get(c.subDevice) && r.get(c.channel[0]) && r.get(c.channel[1]) &&
+              r.get(c.channel[2]) && r.get(c.inverted) && r.get(c.scale) && r.get(c.offset) &&
+              r.get(c.rangeMin) && r.get(c.rangeMax) && r.get(c.safe) && r.get(c.unit) && r.get(c.additionalArguments) &&
+              r.get(c.asyncPeriod);
+    if (!ok || kind > ChannelConfig::comediFqd) return false;
+    c.kind = static_cast<ChannelConfig::Kind>(kind);
+  }
+  channels = std::move(result);
+  return true;
+}
@@ -0,0 +1,95 @@
+#include <eeros/hal/GpioLines.hpp>
+#include <eeros/core/Fault.hpp>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/gpio.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+using namespace eeros;
+using namespace eeros::hal;
+
+GpioLines::GpioLines(std::string chip, std::vector<unsigned int> offsets, Direction direction, Edge edge, std::string consumer)
+    : fd(-1), nofLines(offsets.size()), offsets(offsets) {
+  if (offsets.empty() || offsets.size() > GPIO_V2_LINES_MAX) throw Fault("invalid number of lines requested from GPIO chip " + chip);
+  int chipFd = ::open(chip.c_str(), O_RDWR | O_CLOEXEC);
+  if (chipFd < 0) throw Fault("failed to open GPIO chip " + chip);
+
+  gpio_v2_line_request req;
+  std::memset(&req, 0, sizeof(req));
+  for (unsigned int i = 0; i < nofLines; i++) req.offsets[i] = offsets[i];
+  consumer.copy(req.consumer, sizeof(req.consumer) - 1);
+  req.num_lines = nofLines;
+  if (direction == Direction::output) {
+    req.config.flags = GPIO_V2_LINE_FLAG_OUTPUT;
+  } else {
+    req.config.flags = GPIO_V2_LINE_FLAG_INPUT;
+    if (edge == Edge::rising || edge == Edge::both) req.config.flags |= GPIO_V2_LINE_FLAG_EDGE_RISING;
+    if (edge == Edge::falling || edge == Edge::both) req.config.flags |= GPIO_V2_LINE_FLAG_EDGE_FALLING;
+  }
+  int r = ::ioctl(chipFd, GPIO_V2_GET_LINE_IOCTL, &req);
+  ::close(chipFd);
+  if (r < 0) throw Fault("failed to request lines of GPIO chip " + chip);
+  fd = req.fd;
+  if (direction == Direction::input) update();
+}
+
+GpioLines::~GpioLines() {
+  if (fd >= 0) ::close(fd);
+}
+
+uint64_t GpioLines::read() {
+  gpio_v2_line_values v;
+  v.mask = (nofLines == 64) ? ~0ull : (1ull << nofLines) - 1;
+  v.bits = 0;
+  if (::ioctl(fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &v) < 0) return 0;
+  return v.bits;
+}
+
+void GpioLines::update() {
+  values.store(read(), std::memory_order_relaxed);
+}
+
+uint64_t GpioLines::getValues() const {
+  return values.load(std::memory_order_relaxed);
+}
+
+void GpioLines::stage(uint64_t v, uint64_t mask) {
+  uint64_t old = staged.load(std::memory_order_relaxed);
+  while (!staged.compare_exchange_weak(old, (old & ~mask) | (v & mask), std::memory_order_relaxed)) { }
+  dirty.fetch_or(mask, std::memory_order_release);
+}
+
+void GpioLines::commit() {
+  uint64_t mask = dirty.exchange(0, std::memory_order_acquire);
+  uint64_t v = staged.load(std::memory_order_relaxed);
+  mask &= (v ^ written) | ~writtenMask;   // skips lines which did not change
+  if (mask == 0) return;
+  write(v, mask);
+  written = (written & ~mask) | (v & mask);
+  writtenMask |= mask;
+}
+
+void GpioLines::write(uint64_t values, uint64_t mask) {
+  gpio_v2_line_values v;
+  v.mask = mask;
+  v.bits = values;
+  ::ioctl(fd, GPIO_V2_LINE_SET_VALUES_IOCTL, &v);
+}
+
+bool GpioLines::waitForEdge(int timeout, Event& event) {
+  struct pollfd p = {fd, POLLIN, 0};
+  if (::poll(&p, 1, timeout) < 1) return false;
+  gpio_v2_line_event e;
+  if (::read(fd, &e, sizeof(e)) != sizeof(e)) return false;
+  event.line = 0;
+  while (event.line < nofLines && offsets[event.line] != e.offset) event.line++;
+  event.rising = (e.id == GPIO_V2_LINE_EVENT_RISING_EDGE);
+  event.timestamp = e.timestamp_ns;
+  return true;
+}
+
+unsigned int GpioLines::size() const {
+  return nofLines;
+}
@@ -1,5 +1,6 @@
 #include <eeros/hal/HAL.hpp>
 #include <eeros/core/Fault.hpp>
+#include <algorithm>
 #include <dlfcn.h>
 #include <getopt.h>
 
@@ -14,12 +15,33 @@ HAL& HAL::instance() {
 	return halInstance;
 }
 
-bool HAL::readConfigFromFile(std::string file) {
+void HAL::setConfigCache(std::string file) {
+	configCache = file;
+}
+
+bool HAL::loadConfig(std::string file) {
+	std::vector<ChannelConfig> channels;
+	uint64_t hash = 0;
+	if(!configCache.empty()) {
+		hash = ConfigCache::hash(file);
+		if(ConfigCache::load(configCache, hash, channels)) {
+			log.trace() << "configuration of '" << file << "' loaded from cache '" << configCache << "'";
+			parser.createHalObjects(channels, hwLibraries);
+			return true;
+		}
+	}
 	parser = JsonParser(file);
-	parser.createHalObjects(hwLibraries);
+	channels = parser.resolveChannels();
+	parser.createHalObjects(channels, hwLibraries);
+	if(!configCache.empty() && hash != 0 && !ConfigCache::save(configCache, hash, channels))
+		log.warn() << "could not write configuration cache '" << configCache << "'";
 	return true;
 }
 
+bool HAL::readConfigFromFile(std::string file) {
+	return loadConfig(file);
+}
+
 bool HAL::readConfigFromFile(int* argc, char** argv) {
 	if (*argc < 3) throw Fault("no configuration file given as argument. Use -c ConfigFile.json");
 	
@@ -58,9 +80,24 @@ bool HAL::readConfigFromFile(int* argc, char** argv) {
 	}
 	
 	
-	parser = JsonParser(configPath);
-	parser.createHalObjects(hwLibraries);
-	return true;
+	return loadConfig(configPath);
+}
+
+bool HAL::recordInputs(std::string file) {
+	recorder = std::make_unique<InputRecorder>(file);
+	if(recorder->isOpen()) return true;
+	log.error() << "could not create recording file '" << file << "'";
+	recorder.reset();
+	return false;
+}
+
+void HAL::stopRecording() {
+	if(recorder && recorder->getDropped() > 0) log.warn() << "recording dropped " << recorder->getDropped() << " input values";
+	recorder.reset();
+}
+
+InputRecorder* HAL::getInputRecorder() {
+	return recorder.get();
 }
 
 bool HAL::loadModule(std::string moduleName) {
@@ -69,8 +106,9 @@ bool HAL::loadModule(std::string moduleName) {
 }
 
 bool HAL::addInput(InputInterface* systemInput) {
+	if(frozen) throw Fault("Could not add Input to HAL, HAL is frozen!");
 	if(systemInput != nullptr) {
-		if( inputs.find(systemInput->getId()) != inputs.end() ){
+		if( inputs.find(systemInput->getId()) != inputs.end() || pendingInputs.find(systemInput->getId()) != pendingInputs.end() ){
 			throw Fault("Could not add Input to HAL, signal id '" + systemInput->getId() + "' already exists!");
 		}
 		inputs.insert(std::pair(systemInput->getId(), eeros::hal::HAL::Handle{systemInput}));
@@ -79,8 +117,9 @@ bool HAL::addInput(InputInterface* systemInput) {
 	throw Fault("System input is null");
 }
 bool HAL::addOutput(OutputInterface* systemOutput) {
+	if(frozen) throw Fault("Could not add Output to HAL, HAL is frozen!");
 	if(systemOutput != nullptr) {
-		if( outputs.find(systemOutput->getId()) != outputs.end() ){
+		if( outputs.find(systemOutput->getId()) != outputs.end() || pendingOutputs.find(systemOutput->getId()) != pendingOutputs.end() ){
 			throw Fault("Could not add Output to HAL, signal id '" + systemOutput->getId() + "' already exists!");
 		}
 		outputs.insert(std::pair(systemOutput->getId(), eeros::hal::HAL::Handle{systemOutput}));
@@ -89,15 +128,85 @@ bool HAL::addOutput(OutputInterface* systemOutput) {
 	throw Fault("System output is null");
 }
 
+bool HAL::addInput(std::string id, std::function<InputInterface*()> create) {
+	if(frozen) throw Fault("Could not add Input to HAL, HAL is frozen!");
+	if( inputs.find(id) != inputs.end() || pendingInputs.find(id) != pendingInputs.end() ){
+		throw Fault("Could not add Input to HAL, signal id '" + id + "' already exists!");
+	}
+	pendingInputs.emplace(id, create);
+	return true;
+}
+
+bool HAL::addOutput(std::string id, std::function<OutputInterface*()> create) {
+	if(frozen) throw Fault("Could not add Output to HAL, HAL is frozen!");
+	if( outputs.find(id) != outputs.end() || pendingOutputs.find(id) != pendingOutputs.end() ){
+		throw Fault("Could not add Output to HAL, signal id '" + id + "' already exists!");
+	}
+	pendingOutputs.emplace(id, create);
+	return true;
+}
+
+void HAL::freeze() {
+	frozen = true;
+}
+
+void HAL::unfreeze() {
+	frozen = false;
+}
+
+bool HAL::isFrozen() const {
+	return frozen;
+}
+
+InputInterface* HAL::input(const std::string& name) {
+	auto inIt = inputs.find(name);
+	if(inIt != inputs.end()) return inIt->second.get();
+	auto it = pendingInputs.find(name);
+	if(it == pendingInputs.end()) return nullptr;
+	if(frozen) throw Fault("Could not create system input '" + name + "', HAL is frozen!");
+	Handle<InputInterface> in(it->second());	// stays pending if creating fails
+	pendingInputs.erase(it);
+	return (inputs[name] = std::move(in)).get();
+}
+
+OutputInterface* HAL::output(const std::string& name) {
+	auto outIt = outputs.find(name);
+	if(outIt != outputs.end()) return outIt->second.get();
+	auto it = pendingOutputs.find(name);
+	if(it == pendingOutputs.end()) return nullptr;
+	if(frozen) throw Fault("Could not create system output '" + name + "', HAL is frozen!");
+	Handle<OutputInterface> out(it->second());
+	pendingOutputs.erase(it);
+	return (outputs[name] = std::move(out)).get();
+}
+
+uint32_t HAL::internInput(const std::string& name, InputInterface* in) {
+	auto it = inputIds.find(name);
+	if(it != inputIds.end()) return it->second;
+	if(frozen) throw Fault("Could not resolve id of system input '" + name + "', HAL is frozen!");
+	inputTable.push_back(in);
+	return inputIds[name] = inputTable.size() - 1;
+}
+
+uint32_t HAL::internOutput(const std::string& name, OutputInterface* out) {
+	auto it = outputIds.find(name);
+	if(it != outputIds.end()) return it->second;
+	if(frozen) throw Fault("Could not resolve id of system output '" + name + "', HAL is frozen!");
+	outputTable.push_back(out);
+	return outputIds[name] = outputTable.size() - 1;
+}
+
 void HAL::releaseInput(std::string name) {
+	auto it = inputs.find(name);
+	InputInterface* in = (it != inputs.end()) ? it->second.get() : nullptr;
 	bool found = false;
-	auto inIt = nonExclusiveInputs.find(inputs[name]);
+	auto inIt = nonExclusiveInputs.find(in);
 	if(inIt != nonExclusiveInputs.end()){
 		nonExclusiveInputs.erase(inIt);
 		found = true;
 	}
 	  
-	inIt = exclusiveReservedInputs.find(inputs[name]);
+	inIt = exclusiveReservedInputs.find(in);
 	if(inIt != exclusiveReservedInputs.end()){
 		exclusiveReservedInputs.erase(inIt);
 		found = true;
@@ -105,17 +214,35 @@ void HAL::releaseInput(std::string name) {
 	if(!found){
 		throw Fault("Could not release system input '" + name + "', id not found.");
 	}
+	collectInputBatches();
+}
+
+void HAL::updateInputs() {
+	for(auto batch : inputBatches) batch->update();
+}
+
+void HAL::collectInputBatches() {
+	inputBatches.clear();
+	for(auto set : {&exclusiveReservedInputs, &nonExclusiveInputs}) {
+		for(auto in : *set) {
+			if(in == nullptr) continue;
+			auto batch = in->getBatch();
+			if(batch != nullptr && std::find(inputBatches.begin(), inputBatches.end(), batch) == inputBatches.end()) inputBatches.push_back(batch);
+		}
+	}
 }
 
 void HAL::releaseOutput(std::string name) {
+	auto it = outputs.find(name);
+	OutputInterface* out = (it != outputs.end()) ? it->second.get() : nullptr;
 	bool found = false;
-	auto outIt = nonExclusiveOutputs.find(outputs[name]);
+	auto outIt = nonExclusiveOutputs.find(out);
 	if(outIt != nonExclusiveOutputs.end()){
 		nonExclusiveOutputs.erase(outIt);
 		found = true;
 	}
 	
-	outIt = exclusiveReservedOutputs.find(outputs[name]);
+	outIt = exclusiveReservedOutputs.find(out);
 	if(outIt != exclusiveReservedOutputs.end()){
 		exclusiveReservedOutputs.erase(outIt);
 		found = true;
@@ -123,124 +250,164 @@ void HAL::releaseOutput(std::string name) {
 	if(!found){
 		throw Fault("Could not release system output '" + name + "', id not found.");
 	}
+	collectOutputBatches();
+}
+
+void HAL::commitOutputs() {
+	for(auto batch : outputBatches) batch->commit();
+}
+
+void HAL::collectOutputBatches() {
+	outputBatches.clear();
+	for(auto set : {&exclusiveReservedOutputs, &nonExclusiveOutputs}) {
+		for(auto out : *set) {
+			if(out == nullptr) continue;
+			auto batch = out->getBatch();
+			if(batch != nullptr && std::find(outputBatches.begin(), outputBatches.end(), batch) == outputBatches.end()) outputBatches.push_back(batch);
+		}
+	}
 }
 
 OutputInterface* HAL::getOutput(std::string name, bool exclusive) {
-	if( exclusiveReservedOutputs.find(outputs[name]) != exclusiveReservedOutputs.end() ) throw Fault("System output '" + name + "' is exclusive reserved!");
+	if(frozen) throw Fault("Could not claim system output '" + name + "', HAL is frozen!");
+	if(output(name) == nullptr) throw Fault("System output '" + name + "' not found!");
+	if( exclusiveReservedOutputs.find(output(name)) != exclusiveReservedOutputs.end() ) throw Fault("System output '" + name + "' is exclusive reserved!");
 	
 	if(exclusive) {
-		if( nonExclusiveOutputs.find(outputs[name]) != nonExclusiveOutputs.end() ){
+		if( nonExclusiveOutputs.find(output(name)) != nonExclusiveOutputs.end() ){
 			throw Fault("System output '" + name + "' is already claimed as non-exclusive output!");
 		}
-		if(!exclusiveReservedOutputs.insert(outputs[name]).second) throw Fault("System output '" + name + "' is exclusive reserved!"); // should not fail here because already checked at the beginning
+		if(!exclusiveReservedOutputs.insert(output(name)).second) throw Fault("System output '" + name + "' is exclusive reserved!"); // should not fail here because already checked at the beginning
 	}
 	else{
-		nonExclusiveOutputs.insert(outputs[name]).second;
+		nonExclusiveOutputs.insert(output(name)).second;
 	}
-	return outputs[name];
+	collectOutputBatches();
+	return output(name);
 }
 
 Output<bool>* HAL::getLogicOutput(std::string name, bool exclusive) {
-	Output<bool>* out = dynamic_cast<Output<bool>*>(outputs[name].get());
+	if(frozen) throw Fault("Could not claim system output '" + name + "', HAL is frozen!");
+	Output<bool>* out = dynamic_cast<Output<bool>*>(output(name));
 	if(out == nullptr) throw Fault("Logic system output '" + name + "' not found!");
 	
-	if( exclusiveReservedOutputs.find(outputs[name]) != exclusiveReservedOutputs.end() ) throw Fault("Logic system output '" + name + "' is exclusive reserved!");
+	if( exclusiveReservedOutputs.find(output(name)) != exclusiveReservedOutputs.end() ) throw Fault("Logic system output '" + name + "' is exclusive reserved!");
 	
 	if(exclusive) {
-		if( nonExclusiveOutputs.find(outputs[name]) != nonExclusiveOutputs.end() ){
+		if( nonExclusiveOutputs.find(output(name)) != nonExclusiveOutputs.end() ){
 			throw Fault("Logic system output '" + name + "' is already claimed as non-exclusive output!");
 		}
-		if(!exclusiveReservedOutputs.insert(outputs[name]).second) throw Fault("Logic system output '" + name + "' is exclusive reserved!"); // should not fail here because already checked at the beginning
+		if(!exclusiveReservedOutputs.insert(output(name)).second) throw Fault("Logic system output '" + name + "' is exclusive reserved!"); // should not fail here because already checked at the beginning
 	}
 	else{
-		nonExclusiveOutputs.insert(outputs[name]).second;
+		nonExclusiveOutputs.insert(output(name)).second;
 	}
+	collectOutputBatches();
 	return out;
 }
 
 ScalableOutput<double>* HAL::getScalableOutput(std::string name, bool exclusive) {
-	ScalableOutput<double>* out = dynamic_cast<ScalableOutput<double>*>(outputs[name].get());
+	if(frozen) throw Fault("Could not claim system output '" + name + "', HAL is frozen!");
+	ScalableOutput<double>* out = dynamic_cast<ScalableOutput<double>*>(output(name));
 	if(out == nullptr) throw Fault("Scalable system output '" + name + "' not found!");
 	
-	if( exclusiveReservedOutputs.find(outputs[name]) != exclusiveReservedOutputs.end() ) throw Fault("Scalable system output '" + name + "' is exclusive reserved!");
+	if( exclusiveReservedOutputs.find(output(name)) != exclusiveReservedOutputs.end() ) throw Fault("Scalable system output '" + name + "' is exclusive reserved!");
 	
 	if(exclusive) {
-		if( nonExclusiveOutputs.find(outputs[name]) != nonExclusiveOutputs.end() ){
+		if( nonExclusiveOutputs.find(output(name)) != nonExclusiveOutputs.end() ){
 			throw Fault("Scalable system output '" + name + "' is already claimed as non-exclusive output!");
 		}
-		if(!exclusiveReservedOutputs.insert(outputs[name]).second) throw Fault("Scalable system output '" + name + "' is exclusive reserved!"); // should not fail here because already checked at the beginning
+		if(!exclusiveReservedOutputs.insert(output(name)).second) throw Fault("Scalable system output '" + name + "' is exclusive reserved!"); // should not fail here because already checked at the beginning
 	}
 	else{
-		nonExclusiveOutputs.insert(outputs[name]).second;
+		nonExclusiveOutputs.insert(output(name)).second;
 	}
+	collectOutputBatches();
 	return out;
 }
 
 InputInterface* HAL::getInput(std::string name, bool exclusive) {
-	if( exclusiveReservedInputs.find(inputs[name]) != exclusiveReservedInputs.end() ) throw Fault("System input '" + name + "' is exclusive reserved!");
+	if(frozen) throw Fault("Could not claim system input '" + name + "', HAL is frozen!");
+	if(input(name) == nullptr) throw Fault("System input '" + name + "' not found!");
+	if( exclusiveReservedInputs.find(input(name)) != exclusiveReservedInputs.end() ) throw Fault("System input '" + name + "' is exclusive reserved!");
 	
 	if(exclusive) {
-		if( nonExclusiveInputs.find(inputs[name]) != nonExclusiveInputs.end() ){
+		if( nonExclusiveInputs.find(input(name)) != nonExclusiveInputs.end() ){
 			throw Fault("System input '" + name + "' is already claimed as non-exclusive input!");
 		}
-		if(!exclusiveReservedInputs.insert(inputs[name]).second) throw Fault("System input '" + name + "' is exclusive reserved!");	// should not fail here because already checked at the beginning
+		if(!exclusiveReservedInputs.insert(input(name)).second) throw Fault("System input '" + name + "' is exclusive reserved!");	// should not fail here because already checked at the beginning
 	}
 	else{	
-		nonExclusiveInputs.insert(inputs[name]).second;
+		nonExclusiveInputs.insert(input(name)).second;
 	}
-	return inputs[name];
+	collectInputBatches();
+	return input(name);
 }
 
 Input<bool>* HAL::getLogicInput(std::string name, bool exclusive) {
-	Input<bool>* in = dynamic_cast<Input<bool>*>(inputs[name].get());
+	if(frozen) throw Fault("Could not claim system input '" + name + "', HAL is frozen!");
+	Input<bool>* in = dynamic_cast<Input<bool>*>(input(name));
 	if(in == nullptr) throw Fault("Logic system input '" + name + "' not found!");
 	
-	if( exclusiveReservedInputs.find(inputs[name]) != exclusiveReservedInputs.end() ) throw Fault("Logic system input '" + name + "' is exclusive reserved!");
+	if( exclusiveReservedInputs.find(input(name)) != exclusiveReservedInputs.end() ) throw Fault("Logic system input '" + name + "' is exclusive reserved!");
 		
 	if(exclusive) {
-		if( nonExclusiveInputs.find(inputs[name]) != nonExclusiveInputs.end() ){
+		if( nonExclusiveInputs.find(input(name)) != nonExclusiveInputs.end() ){
 			throw Fault("Logic system input '" + name + "' is already claimed as non-exclusive input!");
 		}
-		if(!exclusiveReservedInputs.insert(inputs[name]).second) throw Fault("Logic system input '" + name + "' is exclusive reserved!");	// should not fail here because already checked at the beginning
+		if(!exclusiveReservedInputs.insert(input(name)).second) throw Fault("Logic system input '" + name + "' is exclusive reserved!");	// should not fail here because already checked at the beginning
 	}
 	else{	
-		nonExclusiveInputs.insert(inputs[name]).second;
+		nonExclusiveInputs.insert(input(name)).second;
 	}
+	collectInputBatches();
 	return in;
 }
 
 ScalableInput<double>* HAL::getScalableInput(std::string name, bool exclusive) {
-	ScalableInput<double>* in = dynamic_cast<ScalableInput<double>*>(inputs[name].get());
+	if(frozen) throw Fault("Could not claim system input '" + name + "', HAL is frozen!");
+	ScalableInput<double>* in = dynamic_cast<ScalableInput<double>*>(input(name));
 	if(in == nullptr) throw Fault("Scalable system input '" + name + "' not found!");
 	
-	if( exclusiveReservedInputs.find(inputs[name]) != exclusiveReservedInputs.end() ) throw Fault("Scalable system input '" + name + "' is exclusive reserved!");
+	if( exclusiveReservedInputs.find(input(name)) != exclusiveReservedInputs.end() ) throw Fault("Scalable system input '" + name + "' is exclusive reserved!");
 	
 	if(exclusive) {
-		if( nonExclusiveInputs.find(inputs[name]) != nonExclusiveInputs.end() ){
+		if( nonExclusiveInputs.find(input(name)) != nonExclusiveInputs.end() ){
 			throw Fault("Scalable system input '" + name + "' is already claimed as non-exclusive input!");
 		}
-		if(!exclusiveReservedInputs.insert(inputs[name]).second) throw Fault("Scalable system input '" + name + "' is exclusive reserved!");	// should not fail here because already checked at the beginning
+		if(!exclusiveReservedInputs.insert(input(name)).second) throw Fault("Scalable system input '" + name + "' is exclusive reserved!");	// should not fail here because already checked at the beginning
 	}
 	else{	
-		nonExclusiveInputs.insert(inputs[name]).second;
+		nonExclusiveInputs.insert(input(name)).second;
 	}
+	collectInputBatches();
 	return in;
 }
 
 void * HAL::getOutputFeature(std::string name, std::string featureName){
-	auto outObj = outputs[name].get();
+	auto outObj = output(name);
 	return getOutputFeature(outObj, featureName);
 }
 
 void* HAL::getOutputFeature(OutputInterface * obj, std::string featureName){
-	return dlsym(obj->getLibHandle(), featureName.c_str());
+	return getFeature(obj->getLibHandle(), featureName);
 }
 
 void * HAL::getInputFeature(std::string name, std::string featureName){
-	auto inObj = inputs[name].get();
+	auto inObj = input(name);
 	return getInputFeature(inObj, featureName);
 }
 
 void* HAL::getInputFeature(InputInterface * obj, std::string featureName){
-	return dlsym(obj->getLibHandle(), featureName.c_str());
+	return getFeature(obj->getLibHandle(), featureName);
+}
+
+void* HAL::getFeature(void* libHandle, const std::string& featureName){
+	std::lock_guard<std::mutex> lock(featureMtx);
+	auto key = std::make_pair(libHandle, featureName);
+	auto it = features.find(key);
+	if(it != features.end()) return it->second;
+	void* f = dlsym(libHandle, featureName.c_str());
+	if(f != nullptr) features.emplace(key, f);
+	return f;
 }
@@ -0,0 +1,84 @@
+#include <eeros/hal/InputHub.hpp>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+using namespace eeros::hal;
+
+InputHub& InputHub::instance() {
+  static InputHub hub;
+  return hub;
+}
+
+InputHub::InputHub() : log(logger::Logger::getLogger('H')) {
+  epollFd = epoll_create1(EPOLL_CLOEXEC);
+  wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  epoll_event ev{};
+  ev.events = EPOLLIN;
+  ev.data.fd = wakeFd;
+  if (epollFd < 0 || wakeFd < 0 || epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &ev) != 0)
+    log.error() << "input hub: could not create epoll instance";
+  thread = std::thread([this]() { run(); });
+}
+
+InputHub::~InputHub() {
+  running.store(false, std::memory_order_relaxed);
+  uint64_t one = 1;
+  if (::write(wakeFd, &one, sizeof(one)) < 0) { /* the thread wakes up within its timeout */ }
+  if (thread.joinable()) thread.join();
+  ::close(wakeFd);
+  ::close(epollFd);
+}
+
+bool InputHub::add(int fd, std::function<void()> handler, int priority) {
+  std::lock_guard<std::mutex> lock(mtx);
+  epoll_event ev{};
+  ev.events = EPOLLIN;
+  ev.data.fd = fd;
+  if (fd < 0 || epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+    log.error() << "input hub: could not register file descriptor " << fd;
+    return false;
+  }
+  handlers[fd] = handler;
+  if (priority != 20 && priority > this->priority) {
+    sched_param param;
+    param.sched_priority = priority;
+    if (pthread_setschedparam(thread.native_handle(), SCHED_FIFO, &param) != 0) log.error() << "input hub: could not set realtime priority";
+    else this->priority = priority;
+  }
+  return true;
+}
+
+void InputHub::remove(int fd) {
+  std::lock_guard<std::mutex> lock(mtx);  // waits for a running handler
+  epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+  handlers.erase(fd);
+}
+
+int InputHub::getCount() {
+  std::lock_guard<std::mutex> lock(mtx);
+  return handlers.size();
+}
+
+void InputHub::run() {
+  constexpr int maxEvents = 16;
+  epoll_event events[maxEvents];
+  while (running.load(std::memory_order_relaxed)) {
+    int n = epoll_wait(epollFd, events, maxEvents, 100);
+    std::lock_guard<std::mutex> lock(mtx);
+    for (int i = 0; i < n; i++) {
+      int fd = events[i].data.fd;
+      if (fd == wakeFd) continue;
+      auto h = handlers.find(fd);  // the descriptor may have been removed meanwhile
+      if (h == handlers.end()) continue;
+      if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+        // a device was unplugged, stop polling it instead of spinning
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        log.warn() << "input hub: device on file descriptor " << fd << " disconnected";
+      }
+      h->second();
+    }
+  }
+}
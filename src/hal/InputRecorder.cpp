@@ -0,0 +1,142 @@
+#include <eeros/hal/InputRecorder.hpp>
+#include <eeros/core/Fault.hpp>
+#include <chrono>
+
+using namespace eeros;
+using namespace eeros::hal;
+
+namespace {
+  constexpr auto period = std::chrono::milliseconds(10);
+  constexpr int maxFrameValues = 256;
+
+  template < typename T >
+  void put(std::ostream& os, T v) {
+    os.write(reinterpret_cast<const char*>(&v), sizeof(v));
+  }
+
+  template < typename T >
+  bool take(std::istream& is, T& v) {
+    return static_cast<bool>(is.read(reinterpret_cast<char*>(&v), sizeof(v)));
+  }
+}
+
+InputRecorder::InputRecorder(std::string file) : out(file, std::ios::binary) {
+  put(out, magicNumber);
+  put(out, formatVersion);
+  put<uint16_t>(out, 0);
+  thread = std::thread([this]() { run(); });
+}
+
+InputRecorder::~InputRecorder() {
+  running.store(false, std::memory_order_relaxed);
+  if (thread.joinable()) thread.join();
+  drain();
+}
+
+bool InputRecorder::isOpen() const {
+  return out.is_open();
+}
+
+InputRecorder::Channel* InputRecorder::addChannel(std::string id, bool logic) {
+  std::lock_guard<std::mutex> lock(mtx);
+  if (channels.size() > UINT16_MAX) throw Fault("too many recorded inputs");
+  return &channels.emplace_back(static_cast<uint16_t>(channels.size()), id, logic);
+}
+
+uint64_t InputRecorder::getDropped() const {
+  std::lock_guard<std::mutex> lock(mtx);
+  uint64_t n = 0;
+  for (auto& c : channels) n += c.dropped.load(std::memory_order_relaxed);
+  return n;
+}
+
+void InputRecorder::drain() {
+  std::lock_guard<std::mutex> lock(mtx);
+  for (; defined < channels.size(); defined++) {
+    auto& c = channels[defined];
+    put<uint8_t>(out, 'C');
+    put(out, c.index);
+    put<uint8_t>(out, c.logic);
+    put<uint16_t>(out, c.id.size());
+    out.write(c.id.data(), c.id.size());
+  }
+  double frame[maxFrameValues];
+  for (auto& c : channels) {
+    uint16_t n;
+    do {
+      for (n = 0; n < maxFrameValues && c.ring.pop(frame[n]); n++);
+      if (n == 0) break;
+      put<uint8_t>(out, 'V');
+      put(out, c.index);
+      put(out, n);
+      for (uint16_t i = 0; i < n; i++) {
+        if (c.logic) put<uint8_t>(out, frame[i] != 0);
+        else put(out, frame[i]);
+      }
+    } while (n == maxFrameValues);
+  }
+  out.flush();
+}
+
+void InputRecorder::run() {
+  while (running.load(std::memory_order_relaxed)) {
+    drain();
+    std::this_thread::sleep_for(period);
+  }
+}
+
+InputRecording::InputRecording(std::string file) {
+  std::ifstream in(file, std::ios::binary);
+  uint32_t magic;
+  uint16_t version, reserved;
+  if (!take(in, magic) || !take(in, version) || !take(in, reserved)) return;
+  if (magic != InputRecorder::magicNumber || version != InputRecorder::formatVersion) return;
+  std::vector<std::vector<double>*> channels;
+  std::vector<bool> logic;
+  uint8_t kind;
+  while (take(in, kind)) {
+    uint16_t index;
+    if (!take(in, index)) return;
+    if (kind == 'C') {
+      uint8_t l;
+      uint16_t length;
+      if (!take(in, l) || !take(in, length)) return;
+      std::string id(length, '\0');
+      if (!in.read(id.data(), length)) return;
+      if (index >= channels.size()) {
+        channels.resize(index + 1, nullptr);
+        logic.resize(index + 1);
+      }
+      channels[index] = &values[id];
+      logic[index] = l != 0;
+    } else if (kind == 'V') {
+      uint16_t n;
+      if (!take(in, n) || index >= channels.size() || channels[index] == nullptr) return;
+      for (uint16_t i = 0; i < n; i++) {
+        double v;
+        if (logic[index]) {
+          uint8_t b;
+          if (!take(in, b)) return;
+          v = b;
+        } else if (!take(in, v)) return;
+        channels[index]->push_back(v);
+      }
+    } else return;
+  }
+  valid = true;
+}
+
+bool InputRecording::isValid() const {
+  return valid;
+}
+
+std::vector<std::string> InputRecording::getIds() const {
+  std::vector<std::string> ids;
+  for (auto& v : values) ids.push_back(v.first);
+  return ids;
+}
+
+const std::vector<double>* InputRecording::getValues(const std::string& id) const {
+  auto it = values.find(id);
+  return it != values.end() ? &it->second : nullptr;
+}
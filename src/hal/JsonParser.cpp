@@ -8,6 +8,7 @@
 #include <eeros/hal/Input.hpp>
 #include <eeros/hal/ScalableInput.hpp>
 #include <eeros/hal/ScalableOutput.hpp>
+#include <eeros/hal/AsyncInput.hpp>
 #include <eeros/hal/HAL.hpp>
 #include <eeros/hal/HALFeatures.hpp>
 #include <stdexcept>
@@ -16,6 +17,13 @@
 using namespace eeros;
 using namespace eeros::hal;
 
+namespace {
+	// compiled once, not for every key of the configuration
+	const std::regex sdRegex("subdevice[0-9]+", std::regex_constants::extended);
+	const std::regex chanRegex("channel[0-9]+", std::regex_constants::extended);
+	const std::regex comediRegex("libcomedi[a-z.A-z]+", std::regex_constants::extended);
+}
+
 JsonParser::JsonParser() : log(logger::Logger::getLogger('J')) { }
 
 JsonParser::JsonParser(std::string filePath) : log(logger::Logger::getLogger('J')) {
@@ -31,7 +39,12 @@ JsonParser::JsonParser(std::string filePath) : log(logger::Logger::getLogger('J'
 	}
 }
 
-void JsonParser::createHalObjects(std::map<std::string, void*> libHandles){
+void JsonParser::createHalObjects(std::map<std::string, void*>& libHandles){
+	createHalObjects(resolveChannels(), libHandles);
+}
+
+std::vector<ChannelConfig> JsonParser::resolveChannels(){
+	std::vector<ChannelConfig> channels;
 	std::string library;
 	std::string devHandle;
 	std::string type;
@@ -51,29 +64,22 @@ void JsonParser::createHalObjects(std::map<std::string, void*> libHandles){
 		  
 		for (const auto &o : halRootObj) {
 			auto devObj = o;
+			// symbols of a library are resolved on first use instead of at load time if the device allows it
+			bool lazyBinding = devObj["lazyBinding"].bool_value();
 			for(const auto &subO : devObj){
-				std::regex sdRegex("subdevice[0-9]+", std::regex_constants::extended);
 				if(subO.key() == "library"){
 					library = subO.string_value();
-					auto libIt = libHandles.find(library);
-					// if library not already in map of opened libraries -> try to open it
-					if(libIt == libHandles.end()){
-						libHandles[library] = dlopen(library.c_str(), RTLD_NOW); // try to load the given library and add it to libHandles map
-						auto libIt = libHandles.find(library);	
-						if(libIt->second == nullptr){
-							libHandles.erase(libIt);
-							throw Fault(std::string(dlerror()));
-						}
-					}
 				}
 				else if(subO.key() == "devHandle"){
 					devHandle = subO.string_value();
 				}
+				else if(subO.key() == "lazyBinding"){
+					// handled before the channels
+				}
 				else if(std::regex_match(subO.key(), sdRegex)){
 					auto subDevO = subO;
 					int subDevNumber = std::stoi(subDevO.key().substr(9, subDevO.key().length()));
 					for(const auto &chanO : subDevO){
-						std::regex chanRegex("channel[0-9]+", std::regex_constants::extended);
 						std::string subDevParam = chanO.key();
 						if(chanO.key() == "type"){
 							type = chanO.string_value();
@@ -83,71 +89,90 @@ void JsonParser::createHalObjects(std::map<std::string, void*> libHandles){
 							int channelNumber = std::stoi(chanObj.key().substr(7, chanObj.key().length()));
 						
 							//----------------------------------
-							// create HAL Object for channel
+							// resolve channel
 							//----------------------------------
 							
-							// check if library is loaded
-							auto libIt = libHandles.find(library);
 							if(!library.empty()){
-								if(libIt != libHandles.end()){
-									if(!devHandle.empty()){
-									  
-										parseChannelProperties(chanObj, &chanType, &sigId, &scale, &offset, &rangeMin, &rangeMax, &safe, &chanUnit, &inverted, &additionalArguments);
-										
-										if(chanType.empty()){
-											chanType = type;
-										}
-										
-										// exception for comedi Fqd
-										if(chanType == "Fqd"){
-											std::regex comediRegex("libcomedi[a-z.A-z]+", std::regex_constants::extended);
-											if(std::regex_match(library, comediRegex)){		// exception: comedi fqd regex matches?
-												int channelA = -1;
-												int channelB = -1;
-												int channelZ = -1;
-												channelA = chanObj["encChannelA"].int_value();
-												channelB = chanObj["encChannelB"].int_value();
-												channelZ = chanObj["encChannelZ"].int_value();
-												if(channelA == -1 || channelB == -1){
-													throw Fault("no channels defined for comedi FQD signalId: '" + sigId + "'" );
-												}
-												createComediFqd(libIt->second, chanType, sigId, devHandle, subDevNumber, channelA, channelB, channelZ, scale, offset, rangeMin, rangeMax, chanUnit);
-												channelCreated = true;
+								if(!devHandle.empty()){
+								  
+									parseChannelProperties(chanObj, &chanType, &sigId, &scale, &offset, &rangeMin, &rangeMax, &safe, &chanUnit, &inverted, &additionalArguments);
+									
+									if(chanType.empty()){
+										chanType = type;
+									}
+									
+									ChannelConfig c;
+									c.library = library;
+									c.lazyBinding = lazyBinding;
+									c.type = chanType;
+									c.id = sigId;
+									c.devHandle = devHandle;
+									c.subDevice = subDevNumber;
+									c.channel[0] = channelNumber;
+									c.inverted = inverted;
+									c.scale = scale;
+									c.offset = offset;
+									c.rangeMin = rangeMin;
+									c.rangeMax = rangeMax;
+									c.safe = safe;
+									c.unit = chanUnit;
+									c.additionalArguments = additionalArguments;
+									c.asyncPeriod = chanObj["asyncPeriod"].number_value();
+									if(c.asyncPeriod < 0){
+										throw Fault("invalid asyncPeriod for " + sigId);
+									}
+									
+									// exception for comedi Fqd
+									if(chanType == "Fqd"){
+										if(std::regex_match(library, comediRegex)){		// exception: comedi fqd regex matches?
+											int channelA = -1;
+											int channelB = -1;
+											int channelZ = -1;
+											channelA = chanObj["encChannelA"].int_value();
+											channelB = chanObj["encChannelB"].int_value();
+											channelZ = chanObj["encChannelZ"].int_value();
+											if(channelA == -1 || channelB == -1){
+												throw Fault("no channels defined for comedi FQD signalId: '" + sigId + "'" );
 											}
+											c.kind = ChannelConfig::comediFqd;
+											c.channel[0] = channelA;
+											c.channel[1] = channelB;
+											c.channel[2] = channelZ;
+											channels.push_back(c);
+											channelCreated = true;
 										}
-										
-										auto typeIt = typeOfChannel.find(chanType);
-										if(typeIt != typeOfChannel.end() && !channelCreated) {
-											auto unitIt = typeOfUnit.find(chanUnit);
-											if(typeIt->second == Real && unitIt != typeOfUnit.end()) {
-												createRealObject(libIt->second, chanType, sigId, devHandle, subDevNumber, channelNumber, scale, offset, rangeMin, rangeMax, safe, unitIt->second, additionalArguments);
-											}
-											else if(typeIt->second == Logic){
-												createLogicObject(libIt->second, chanType, sigId, devHandle, subDevNumber, channelNumber, inverted, additionalArguments);
-											}
+									}
+									
+									auto typeIt = typeOfChannel.find(chanType);
+									if(typeIt != typeOfChannel.end() && !channelCreated) {
+										auto unitIt = typeOfUnit.find(chanUnit);
+										if(typeIt->second == Real && unitIt != typeOfUnit.end()) {
+											c.kind = ChannelConfig::real;
+											channels.push_back(c);
 										}
-										else{
-											if(!channelCreated){
-												throw Fault("undefined type: " + chanType + " for unit: " + chanUnit + " for " + sigId);
-											}
+										else if(typeIt->second == Logic){
+											c.kind = ChannelConfig::logic;
+											channels.push_back(c);
 										}
-										sigId.clear();
-										chanType.clear();
-										chanUnit.clear();
-										inverted = false;
-										scale = 1;
-										offset = 0;
-										rangeMin = 0;
-										rangeMax = 0;
-										safe = std::numeric_limits<double>::quiet_NaN();
-										channelCreated = false;
 									}
 									else{
-										throw Fault("no device handle defined for " + subDevParam);
+										if(!channelCreated){
+											throw Fault("undefined type: " + chanType + " for unit: " + chanUnit + " for " + sigId);
+										}
 									}
+									sigId.clear();
+									chanType.clear();
+									chanUnit.clear();
+									inverted = false;
+									scale = 1;
+									offset = 0;
+									rangeMin = 0;
+									rangeMax = 0;
+									safe = std::numeric_limits<double>::quiet_NaN();
+									channelCreated = false;
 								}
 								else{
-									throw Fault("library not loaded for " + subDevParam + " ('" + library + "')");
+									throw Fault("no device handle defined for " + subDevParam);
 								}
 							}
 							else{
@@ -169,6 +194,32 @@ void JsonParser::createHalObjects(std::map<std::string, void*> libHandles){
 	else{
 		throw Fault("No parsed HAL root object");
 	}
+	return channels;
+}
+
+void JsonParser::createHalObjects(const std::vector<ChannelConfig>& channels, std::map<std::string, void*>& libHandles){
+	for(const auto &c : channels){
+		auto libIt = libHandles.find(c.library);
+		// if library not already in map of opened libraries -> try to open it
+		if(libIt == libHandles.end()){
+			void *handle = dlopen(c.library.c_str(), c.lazyBinding ? RTLD_LAZY : RTLD_NOW);
+			if(handle == nullptr){
+				throw Fault(std::string(dlerror()));
+			}
+			libIt = libHandles.emplace(c.library, handle).first;
+		}
+		switch(c.kind){
+			case ChannelConfig::comediFqd:
+				createComediFqd(libIt->second, c.type, c.id, c.devHandle, c.subDevice, c.channel[0], c.channel[1], c.channel[2], c.scale, c.offset, c.rangeMin, c.rangeMax, c.unit);
+				break;
+			case ChannelConfig::real:
+				createRealObject(libIt->second, c.type, c.id, c.devHandle, c.subDevice, c.channel[0], c.scale, c.offset, c.rangeMin, c.rangeMax, c.safe, typeOfUnit.at(c.unit), c.additionalArguments, c.asyncPeriod);
+				break;
+			case ChannelConfig::logic:
+				createLogicObject(libIt->second, c.type, c.id, c.devHandle, c.subDevice, c.channel[0], c.inverted, c.additionalArguments, c.asyncPeriod);
+				break;
+		}
+	}
 	log.trace() << "HAL objects created";
 }
 
@@ -256,7 +307,7 @@ void JsonParser::calcScale(ucl::Ucl obj, double *scale, double *offset, double *
 				pos = i;
 				if(obj["range"].at(pos)["noLimit"].bool_value() == true){
 					noRangeLimit = true;
-					*rangeMin = std::numeric_limits<double>::min();
+					*rangeMin = std::numeric_limits<double>::lowest();
 					*rangeMax = std::numeric_limits<double>::max();
 				}
 			}
@@ -352,7 +403,7 @@ void JsonParser::calcScale(ucl::Ucl obj, double *scale, double *offset, double *
 	}
 }
 
-void JsonParser::createLogicObject(void *libHandle, std::string type, std::string id, std::string devHandle, uint32_t subDevNumber, uint32_t channelNumber, bool inverted, std::string additionalArguments){
+void JsonParser::createLogicObject(void *libHandle, std::string type, std::string id, std::string devHandle, uint32_t subDevNumber, uint32_t channelNumber, bool inverted, std::string additionalArguments, double asyncPeriod){
 	HAL& hal = HAL::instance();
 	
 	if(libHandle == nullptr || type.empty() || id.empty() || devHandle.empty()){
@@ -367,12 +418,16 @@ void JsonParser::createLogicObject(void *libHandle, std::string type, std::strin
 	auto dirIt = directionOfChannel.find(type);
 	if(dirIt != directionOfChannel.end()){
 		if(dirIt->second == In){
-			Input<bool> *halObj = reinterpret_cast<Input<bool> *(*)(std::string, void*, std::string, uint32_t, uint32_t, bool, std::string)>(createHandle)(id, libHandle, devHandle, subDevNumber, channelNumber, inverted, additionalArguments);
-			hal.addInput(halObj);
+			auto create = reinterpret_cast<Input<bool> *(*)(std::string, void*, std::string, uint32_t, uint32_t, bool, std::string)>(createHandle);
+			hal.addInput(id, [=]() -> InputInterface* {
+				Input<bool> *halObj = create(id, libHandle, devHandle, subDevNumber, channelNumber, inverted, additionalArguments);
+				if(asyncPeriod > 0) return new AsyncInput<bool>(halObj, asyncPeriod);
+				return halObj;
+			});
 		}
 		else if(dirIt->second == Out){
-			Output<bool> *halObj = reinterpret_cast<Output<bool> *(*)(std::string, void*, std::string, uint32_t, uint32_t, bool, std::string)>(createHandle)(id, libHandle, devHandle, subDevNumber, channelNumber, inverted, additionalArguments);
-			hal.addOutput(halObj);
+			auto create = reinterpret_cast<Output<bool> *(*)(std::string, void*, std::string, uint32_t, uint32_t, bool, std::string)>(createHandle);
+			hal.addOutput(id, [=]() -> OutputInterface* { return create(id, libHandle, devHandle, subDevNumber, channelNumber, inverted, additionalArguments); });
 		}
 		else{
 			throw Fault("undefined direction for channel " + id);
@@ -383,7 +438,7 @@ void JsonParser::createLogicObject(void *libHandle, std::string type, std::strin
 	}
 }
 
-void JsonParser::createRealObject(void *libHandle, std::string type, std::string id, std::string devHandle, uint32_t subDevNumber, uint32_t channelNumber, double scale, double offset, double rangeMin, double rangeMax, double safe, SIUnit unit, std::string additionalArguments){
+void JsonParser::createRealObject(void *libHandle, std::string type, std::string id, std::string devHandle, uint32_t subDevNumber, uint32_t channelNumber, double scale, double offset, double rangeMin, double rangeMax, double safe, SIUnit unit, std::string additionalArguments, double asyncPeriod){
 	HAL& hal = HAL::instance();
 	
 	if(libHandle == nullptr || type.empty() || id.empty() || devHandle.empty()){
@@ -398,13 +453,20 @@ void JsonParser::createRealObject(void *libHandle, std::string type, std::string
 	auto dirIt = directionOfChannel.find(type);
 	if(dirIt != directionOfChannel.end()){
 		if(dirIt->second == In){
-			ScalableInput<double> *halObj = reinterpret_cast<ScalableInput<double> *(*)(std::string, void*, std::string, uint32_t, uint32_t, double, double, double, double, SIUnit, std::string)>(createHandle)(id, libHandle, devHandle, subDevNumber, channelNumber, scale, offset, rangeMin, rangeMax, unit, additionalArguments);
-			hal.addInput(halObj);
+			auto create = reinterpret_cast<ScalableInput<double> *(*)(std::string, void*, std::string, uint32_t, uint32_t, double, double, double, double, SIUnit, std::string)>(createHandle);
+			hal.addInput(id, [=]() -> InputInterface* {
+				ScalableInput<double> *halObj = create(id, libHandle, devHandle, subDevNumber, channelNumber, scale, offset, rangeMin, rangeMax, unit, additionalArguments);
+				if(asyncPeriod > 0) return new AsyncScalableInput(halObj, asyncPeriod);
+				return halObj;
+			});
 		}
 		else if(dirIt->second == Out){
-			ScalableOutput<double> *halObj = reinterpret_cast<ScalableOutput<double> *(*)(std::string, void*, std::string, uint32_t, uint32_t, double, double, double, double, SIUnit, std::string)>(createHandle)(id, libHandle, devHandle, subDevNumber, channelNumber, scale, offset, rangeMin, rangeMax, unit, additionalArguments);
-			halObj->safe = safe;
-			hal.addOutput(halObj);
+			auto create = reinterpret_cast<ScalableOutput<double> *(*)(std::string, void*, std::string, uint32_t, uint32_t, double, double, double, double, SIUnit, std::string)>(createHandle);
+			hal.addOutput(id, [=]() -> OutputInterface* {
+				ScalableOutput<double> *halObj = create(id, libHandle, devHandle, subDevNumber, channelNumber, scale, offset, rangeMin, rangeMax, unit, additionalArguments);
+				halObj->safe = safe;
+				return halObj;
+			});
 		}
 		else{
 			throw Fault("undefined direction for channel " + id);
@@ -430,8 +492,8 @@ void JsonParser::createComediFqd(void *libHandle, std::string type, std::string
 	auto dirIt = directionOfChannel.find(type);
 	if(dirIt != directionOfChannel.end()){
 		if(dirIt->second == In){
-			ScalableInput<double> *halObj = reinterpret_cast<ScalableInput<double> *(*)(std::string, void*, std::string, uint32_t, uint32_t, uint32_t, uint32_t, double, double, double, double, std::string)>(createHandle)(id, libHandle, devHandle, subDevNumber, channelA, channelB, channelZ, scale, offset, rangeMin, rangeMax, unit);
-			hal.addInput(halObj);
+			auto create = reinterpret_cast<ScalableInput<double> *(*)(std::string, void*, std::string, uint32_t, uint32_t, uint32_t, uint32_t, double, double, double, double, std::string)>(createHandle);
+			hal.addInput(id, [=]() -> InputInterface* { return create(id, libHandle, devHandle, subDevNumber, channelA, channelB, channelZ, scale, offset, rangeMin, rangeMax, unit); });
 		}
 		else{
 			throw Fault("wrong direction for comedi FQD channel " + id);
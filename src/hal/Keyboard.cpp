@@ -1,34 +1,39 @@
 #include <eeros/hal/Keyboard.hpp>
 #include <eeros/hal/KeyList.hpp>
+#include <eeros/hal/InputHub.hpp>
 #include <unistd.h>
 #include <fcntl.h>
 
 using namespace eeros::hal;
 
-Keyboard::Keyboard(int priority) : Thread(priority) {
+Keyboard::Keyboard(int priority) {
   tcgetattr(STDIN_FILENO, &tio);
   tio.c_lflag &=(~ICANON & ~ECHO);
   tcsetattr(STDIN_FILENO, TCSANOW, &tio);
+  flags = fcntl(STDIN_FILENO, F_GETFL);
+  fcntl(STDIN_FILENO, F_SETFL, flags | O_NONBLOCK);
+  InputHub::instance().add(STDIN_FILENO, [this]() { onReadable(); }, priority);
 }
 
 Keyboard::~Keyboard() {     
-  running = false; 
-  join(); 
+  InputHub::instance().remove(STDIN_FILENO);
+  fcntl(STDIN_FILENO, F_SETFL, flags);
   tio.c_lflag |=(ICANON | ECHO);
   tcsetattr(STDIN_FILENO, TCSANOW, &tio);
 }
 
-void Keyboard::run() {
-  running = true;
+void Keyboard::onReadable() {
   auto& list = KeyList::instance();
-  while (running) {
-    char c = std::cin.get();
-    for (uint8_t i = 0; i < list.nofKeys; i++) {
-      if (c == list.asciiCode[i]) {
-        list.state[i] = true;
-        list.event[i] = true;
+  char buf[64];
+  ssize_t n;
+  while ((n = ::read(STDIN_FILENO, buf, sizeof(buf))) > 0) {
+    for (ssize_t k = 0; k < n; k++) {
+      for (uint8_t i = 0; i < list.nofKeys; i++) {
+        if (buf[k] == list.asciiCode[i]) {
+          list.state[i].store(true, std::memory_order_relaxed);
+          list.event[i].store(true, std::memory_order_relaxed);
+        }
       }
     }
-    usleep(10000);
   }
 }
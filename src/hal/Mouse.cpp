@@ -1,6 +1,7 @@
 #include <eeros/hal/Mouse.hpp>
 #include <eeros/hal/HAL.hpp>
 #include <eeros/hal/MouseDigIn.hpp>
+#include <eeros/hal/InputHub.hpp>
 #include <eeros/core/Fault.hpp>
 
 #include <fcntl.h>
@@ -8,7 +9,7 @@
 
 using namespace eeros::hal;
 
-Mouse::Mouse(std::string dev, int priority) : Thread(priority) {
+Mouse::Mouse(std::string dev, int priority) : log(logger::Logger::getLogger()) {
   open(dev.c_str());
   left = new MouseDigIn("leftMouseButton", this);
   middle = new MouseDigIn("middleMouseButton", this);
@@ -17,12 +18,11 @@ Mouse::Mouse(std::string dev, int priority) : Thread(priority) {
   hal.addInput(left);
   hal.addInput(middle);
   hal.addInput(right);
-  running.store(true, std::memory_order_release);
+  if (fd >= 0) InputHub::instance().add(fd, [this]() { onReadable(); }, priority);
 }
 
 Mouse::~Mouse() {
-  running.store(false, std::memory_order_relaxed);
-  join();
+  if (fd >= 0) InputHub::instance().remove(fd);
   close();
 }
 
@@ -33,7 +33,7 @@ bool Mouse::open(const char* device) {
 }
 
 void Mouse::close() {
-        ::close(fd);
+  if (fd >= 0) ::close(fd);
 }
 
 std::string Mouse::name() {
@@ -58,47 +58,38 @@ void Mouse::on_axis(std::function<void(int, signed)> action) {
 }
 
 
-void Mouse::run() {
-  // synchronize with constructor
-  // this is vital to read from the actual fd and not whatever happened to be
-  // stored in the unitialized fd
-  while(!running.load(std::memory_order_acquire)) usleep(1000);
-  if (fd < 0) {
-    log.error() << "failed to open mouse file descriptor";
-    return;
-  }
+void Mouse::onReadable() {
   struct input_event e;
-  eeros::hal::MouseState currentState{};
-  eeros::hal::MouseState lastState{};
-  while (running.load(std::memory_order_relaxed)) {
-    ssize_t n = read(fd, &e, sizeof(struct input_event));
-    if (n > 0) {
-      if (e.type == EV_KEY) {
-        switch (e.code) {
-          case BTN_LEFT: currentState.button.left = e.value; break;
-          case BTN_MIDDLE: currentState.button.middle = e.value; break;
-          case BTN_RIGHT: currentState.button.right = e.value; break;
-          default: break;
-        }
-
-        if (button_action != nullptr) button_action(e.code, e.value);
-      } else if (e.type == EV_REL) {
-        switch (e.code) {
-          case REL_X: currentState.axis.x += e.value; break;
-          case REL_Y: currentState.axis.y += e.value; break;
-          case REL_WHEEL: currentState.axis.z += e.value; break;
-          case REL_HWHEEL: currentState.axis.r += e.value; break;
-          default: break;
-        }
+  bool changed = false;
+  while (read(fd, &e, sizeof(struct input_event)) == sizeof(struct input_event)) {
+    if (e.type == EV_KEY) {
+      switch (e.code) {
+        case BTN_LEFT: currentState.button.left = e.value; break;
+        case BTN_MIDDLE: currentState.button.middle = e.value; break;
+        case BTN_RIGHT: currentState.button.right = e.value; break;
+        default: break;
+      }
 
-        if (axis_action != nullptr) axis_action(e.code, e.value);
+      if (button_action != nullptr) button_action(e.code, e.value);
+      changed = true;
+    } else if (e.type == EV_REL) {
+      switch (e.code) {
+        case REL_X: currentState.axis.x += e.value; break;
+        case REL_Y: currentState.axis.y += e.value; break;
+        case REL_WHEEL: currentState.axis.z += e.value; break;
+        case REL_HWHEEL: currentState.axis.r += e.value; break;
+        default: break;
       }
 
-      if (event_action != nullptr) event_action(e);
+      if (axis_action != nullptr) axis_action(e.code, e.value);
+      changed = true;
+    }
 
-      current.write(currentState);
-      last.write(lastState);
-      lastState = currentState;
-    } else usleep(1000);
+    if (event_action != nullptr) event_action(e);
+  }
+  if (changed) {
+    current.write(currentState);
+    last.write(lastState);
+    lastState = currentState;
   }
 }
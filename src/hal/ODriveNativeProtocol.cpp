@@ -0,0 +1,110 @@
+#include <eeros/hal/ODriveNativeProtocol.hpp>
+#include <cstring>
+
+using namespace eeros::hal;
+
+namespace {
+  constexpr uint8_t crc8Init = 0x42;
+  constexpr uint8_t crc8Polynomial = 0x37;
+  constexpr uint16_t crc16Init = 0x1337;
+  constexpr uint16_t crc16Polynomial = 0x3d65;
+
+  void put16(std::vector<uint8_t>& out, uint16_t value) {
+    out.push_back(value & 0xFF);
+    out.push_back(value >> 8);
+  }
+}
+
+ODriveNativeProtocol::ODriveNativeProtocol(uint16_t jsonCrc) : jsonCrc(jsonCrc) { }
+
+uint8_t ODriveNativeProtocol::crc8(uint8_t crc, const uint8_t* data, std::size_t length) {
+  for (std::size_t i = 0; i < length; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++) crc = (crc & 0x80) ? (crc << 1) ^ crc8Polynomial : crc << 1;
+  }
+  return crc;
+}
+
+uint16_t ODriveNativeProtocol::crc16(uint16_t crc, const uint8_t* data, std::size_t length) {
+  for (std::size_t i = 0; i < length; i++) {
+    crc ^= data[i] << 8;
+    for (int bit = 0; bit < 8; bit++) crc = (crc & 0x8000) ? (crc << 1) ^ crc16Polynomial : crc << 1;
+  }
+  return crc;
+}
+
+void ODriveNativeProtocol::frame(std::vector<uint8_t>& out, const uint8_t* packet, int length) {
+  uint8_t header[3] = {sync, static_cast<uint8_t>(length), 0};
+  header[2] = crc8(crc8Init, header, 2);
+  out.insert(out.end(), header, header + 3);
+  out.insert(out.end(), packet, packet + length);
+  uint16_t crc = crc16(crc16Init, packet, length);
+  out.push_back(crc >> 8);
+  out.push_back(crc & 0xFF);
+}
+
+uint16_t ODriveNativeProtocol::request(std::vector<uint8_t>& out, uint16_t endpoint, const void* payload,
+                                       int length, int responseSize, bool ack) {
+  seqNo = (seqNo + 1) & 0x7fff;
+  std::vector<uint8_t> packet;
+  packet.reserve(8 + length);
+  put16(packet, seqNo);
+  put16(packet, ack ? (endpoint | 0x8000) : endpoint);
+  put16(packet, responseSize);
+  const uint8_t* p = static_cast<const uint8_t*>(payload);
+  if (length > 0) packet.insert(packet.end(), p, p + length);
+  put16(packet, (endpoint & 0x7fff) == 0 ? 1 : jsonCrc);  // protocol version for endpoint 0
+  frame(out, packet.data(), packet.size());
+  return seqNo;
+}
+
+bool ODriveNativeProtocol::parse(uint8_t b) {
+  if (rxIndex == 0 && b != sync) return false;
+  rx[rxIndex++] = b;
+  if (rxIndex == 2) {
+    if (b > maxPacket) {
+      errors++;
+      rxIndex = (b == sync) ? 1 : 0;  // may be the start of the next frame
+    }
+    return false;
+  }
+  if (rxIndex == 3) {
+    if (crc8(crc8Init, rx, 3) != 0) {
+      errors++;
+      rxIndex = 0;
+      uint8_t b1 = rx[1], b2 = rx[2];
+      if (b1 == sync) {
+        parse(b1);
+        parse(b2);
+      } else if (b2 == sync) {
+        parse(b2);
+      }
+      return false;
+    }
+    rxLength = rx[1];
+    return false;
+  }
+  if (rxIndex < 3 + rxLength + 2) return false;
+  rxIndex = 0;
+  if (crc16(crc16Init, &rx[3], rxLength + 2) != 0 || rxLength < 2) {
+    errors++;
+    return false;
+  }
+  return true;
+}
+
+uint16_t ODriveNativeProtocol::getSeqNo() const {
+  return (rx[3] | (rx[4] << 8)) & 0x7fff;
+}
+
+const uint8_t* ODriveNativeProtocol::getPayload() const {
+  return &rx[5];
+}
+
+int ODriveNativeProtocol::getPayloadLength() const {
+  return rxLength - 2;
+}
+
+uint64_t ODriveNativeProtocol::getErrors() const {
+  return errors;
+}
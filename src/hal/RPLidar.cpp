@@ -1,4 +1,5 @@
 #include <eeros/hal/RPLidar.hpp>
+#include <eeros/core/System.hpp>
 
 using namespace eeros::hal;
 
@@ -63,16 +64,20 @@ float RPLidar::getScanFrequency(){
   return frequency;
 }
 
+const RPLidar::Scan& RPLidar::getScan(bool& newScan) {
+  return scans.read(newScan);
+}
+
 Vector<LASER_COUNT_MAX,double> RPLidar::getAngles() {
-  return angles;
+  return scans.read().angles;
 }
 
 Vector<LASER_COUNT_MAX,double> RPLidar::getRanges() {
-  return ranges;
+  return scans.read().ranges;
 }
 
 Vector<LASER_COUNT_MAX,double> RPLidar::getIntensities() {
-  return intensities;
+  return scans.read().intensities;
 }
 
 void RPLidar::run() {
@@ -87,35 +92,25 @@ void RPLidar::run() {
     bufSize = count; 
     if (IS_OK(ans)){  
       ld->ascendScanData(nodes, count);
-      // Set angles
-//      int start_node = 0, end_node = 0;
-      int i = 0;
-      // find the first valid node and last valid node
-      while (nodes[i++].dist_mm_q2 == 0);
-//       start_node = i-1;
-      i = count -1;
-      while (nodes[i--].dist_mm_q2 == 0);
-//       end_node = i+1;
-      
-      // Set ranges and intensities
-      ranges.zero();
-      intensities.zero();
-      
+      Scan& scan = scans.writeBuffer();
       for (int pos = 0; pos < (int)count ; ++pos) {               
         float read_value = (float) nodes[pos].dist_mm_q2/4.0f/1000;
         if (fabs(read_value) < 0.01)
-          ranges[pos] = std::numeric_limits<float>::infinity();
+          scan.ranges[pos] = std::numeric_limits<double>::infinity();
         else
-          ranges[pos] = read_value;
-        intensities[pos] = (float) (nodes[pos].quality >> 2);
-        angles[pos] = (nodes[pos].angle_z_q14 * 90.f / 16384.f) * 3.1415926535/180;
+          scan.ranges[pos] = read_value;
+        scan.intensities[pos] = (float) (nodes[pos].quality >> 2);
+        scan.angles[pos] = (nodes[pos].angle_z_q14 * 90.f / 16384.f) * 3.1415926535/180;
       }
-      // Set to infinite all elements of the fixed-sized vector for control system
-      for (int pos = (int)count; pos < LASER_COUNT_MAX; ++pos) {  
-        ranges[pos] = std::numeric_limits<float>::infinity();
-        intensities[pos] = std::numeric_limits<float>::infinity();
-        angles[pos] = std::numeric_limits<float>::infinity();
+      // the slots behind count are infinity already, except those of a longer scan before
+      for (int pos = (int)count; pos < scan.count; ++pos) {  
+        scan.ranges[pos] = std::numeric_limits<double>::infinity();
+        scan.intensities[pos] = std::numeric_limits<double>::infinity();
+        scan.angles[pos] = std::numeric_limits<double>::infinity();
       }
+      scan.count = count;
+      scan.timestamp = eeros::System::getTimeNs();
+      scans.publish();
     } else if(ans == RESULT_OPERATION_TIMEOUT){
       log.error() << "RPLidar Laser Timeout! error code: " << ans;
     } else {
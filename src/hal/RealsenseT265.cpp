@@ -1,47 +1,50 @@
 #include <eeros/hal/RealsenseT265.hpp>
+#include <eeros/core/System.hpp>
+#include <time.h>
  
 using namespace eeros::logger;
 using namespace eeros::hal;
 
-RealsenseT265::RealsenseT265(std::string dev, int priority) 
-    : Thread(priority), starting(true), running (false), log(Logger::getLogger('P')) {
+RealsenseT265::RealsenseT265(std::string dev, int priority) : log(Logger::getLogger('P')) {
   cfg.enable_stream(RS2_STREAM_POSE, RS2_FORMAT_6DOF);  // Add pose stream
-  pipe.start(cfg);                                      // Start pipeline with chosen configuration
-  starting = false;
+  pipe.start(cfg, [this](const rs2::frame& frame) { onFrame(frame); });
 }
 
 RealsenseT265::~RealsenseT265() { 
-  running = false;
-  join();
+  pipe.stop();  // no callback runs after stop() returned
 }
 
-void RealsenseT265::run(){
-  while(starting);
-  running = true;
-  while (running) {
-    // Wait for the next set of frames from the camera
-    auto frames = pipe.wait_for_frames();
-    // Get a frame from the pose stream
-    auto f = frames.first_or_default(RS2_STREAM_POSE);
-    // Cast the frame to pose_frame and get its data
-    auto pose_data = f.as<rs2::pose_frame>().get_pose_data();
-    
-    // outputs for eeros
-    translation     << pose_data.translation.x, pose_data.translation.y, pose_data.translation.z;
-    velocity        << pose_data.velocity.x, pose_data.velocity.y, pose_data.velocity.z;
-    acceleration    << pose_data.acceleration.x, pose_data.acceleration.y, pose_data.acceleration.z;
-    quaternion      << pose_data.rotation.w, pose_data.rotation.x, pose_data.rotation.y, pose_data.rotation.z;
-    angVelocity     << pose_data.angular_velocity.x, pose_data.angular_velocity.y, pose_data.angular_velocity.z;
-    angAcceleration << pose_data.angular_acceleration.x, pose_data.angular_acceleration.y, pose_data.angular_acceleration.z;
-    
-    // Calculate current transformation matrix
-    float r[16];
-    calc_transform(pose_data, r);
-    // From the matrix we found, get the new location point
-//     rs2_vector tr{ r[12], r[13], r[14] };
-    // Create a new point to be added to the trajectory
-//     tracked_point p{ tr , pose_data.tracker_confidence };        
+bool RealsenseT265::getPose(Pose& p) const {
+  return pose.read(p);
+}
+
+uint32_t RealsenseT265::getSequence() const {
+  return pose.getSequence();
+}
+
+void RealsenseT265::onFrame(const rs2::frame& frame) {
+  auto f = frame.as<rs2::pose_frame>();
+  if (!f) return;
+  uint64_t now = System::getTimeNs();
+  rs2_pose data = f.get_pose_data();
+  Pose p;
+  p.translation     << data.translation.x, data.translation.y, data.translation.z;
+  p.velocity        << data.velocity.x, data.velocity.y, data.velocity.z;
+  p.acceleration    << data.acceleration.x, data.acceleration.y, data.acceleration.z;
+  p.quaternion      << data.rotation.w, data.rotation.x, data.rotation.y, data.rotation.z;
+  p.angVelocity     << data.angular_velocity.x, data.angular_velocity.y, data.angular_velocity.z;
+  p.angAcceleration << data.angular_acceleration.x, data.angular_acceleration.y, data.angular_acceleration.z;
+  p.confidence = data.tracker_confidence;
+  p.deviceTime = f.get_timestamp();
+  p.timestamp = now;
+  if (f.get_frame_timestamp_domain() == RS2_TIMESTAMP_DOMAIN_GLOBAL_TIME) {
+    // global time is the host realtime clock in ms, shift it to the system time base
+    timespec rt;
+    clock_gettime(CLOCK_REALTIME, &rt);
+    int64_t age = (int64_t)rt.tv_sec * 1000000000 + rt.tv_nsec - (int64_t)(p.deviceTime * 1e6);
+    if (age > 0 && (uint64_t)age < now) p.timestamp = now - age;
   }
+  pose.write(p);  // only the thread of librealsense writes
 }
 
 void RealsenseT265::calc_transform(rs2_pose& pose_data, float mat[16]) {
@@ -0,0 +1,219 @@
+#include <eeros/hal/SdoClient.hpp>
+#include <eeros/core/Fault.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <linux/can/raw.h>
+
+using namespace eeros;
+using namespace eeros::hal;
+
+namespace {
+
+constexpr canid_t cobIdRequest = 0x600;    // client to node k: 0x600 + k
+constexpr canid_t cobIdResponse = 0x580;   // node k to client: 0x580 + k
+constexpr uint8_t ccsUpload = 0x40;
+constexpr uint8_t ccsDownload = 0x23;      // expedited, size indicated in bits 2 and 3
+constexpr uint8_t scsAbort = 0x80;
+constexpr uint32_t abortInvalidCommand = 0x05040001;
+constexpr double pollTime = 0.001;         // while transfers are in flight
+
+int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+can_frame frame(uint8_t node, uint8_t command, uint16_t index, uint8_t subIndex, uint32_t data) {
+  can_frame f;
+  std::memset(&f, 0, sizeof(f));
+  f.can_id = cobIdRequest + node;
+  f.can_dlc = 8;
+  f.data[0] = command;
+  f.data[1] = index & 0xFF;
+  f.data[2] = index >> 8;
+  f.data[3] = subIndex;
+  for (int i = 0; i < 4; i++) f.data[4 + i] = (data >> (8 * i)) & 0xFF;
+  return f;
+}
+
+}
+
+SdoClient::SdoClient(std::string interface)
+    : socket(interface), pending(0), wakeup(0, 0), paced(false), framesPerSlot(1), timeoutNs(500000000), running(true),
+      log(logger::Logger::getLogger('H')) {
+  can_filter filter;
+  filter.can_id = cobIdResponse;
+  filter.can_mask = CAN_SFF_MASK & ~0x7F;   // responses of all nodes
+  if (::setsockopt(socket.getFd(), SOL_CAN_RAW, CAN_RAW_FILTER, &filter, sizeof(filter)) != 0) {
+    throw Fault("failed to set SDO filter on CAN socket for " + interface);
+  }
+  thread = std::thread([this]() { run(); });
+}
+
+SdoClient::SdoClient(int fd)
+    : socket(fd), pending(0), wakeup(0, 0), paced(false), framesPerSlot(1), timeoutNs(500000000), running(true),
+      log(logger::Logger::getLogger('H')) {
+  thread = std::thread([this]() { run(); });
+}
+
+SdoClient::~SdoClient() {
+  running = false;
+  wakeup.post();
+  if (thread.joinable()) thread.join();
+  SdoResult result;
+  result.status = SdoResult::timeout;
+  for (auto& a : active) complete(a.second, result);
+  for (auto& r : queue) complete(r, result);
+}
+
+std::future<SdoResult> SdoClient::upload(uint8_t node, uint16_t index, uint8_t subIndex) {
+  Request r{node, index, subIndex, true, 0, 0, {}, nullptr, 0};
+  auto future = r.promise.get_future();
+  submit(std::move(r));
+  return future;
+}
+
+void SdoClient::upload(uint8_t node, uint16_t index, uint8_t subIndex, Callback done) {
+  submit(Request{node, index, subIndex, true, 0, 0, {}, done, 0});
+}
+
+std::future<SdoResult> SdoClient::download(uint8_t node, uint16_t index, uint8_t subIndex, uint32_t value, uint8_t size) {
+  if (size < 1 || size > 4) throw Fault("SDO download of " + std::to_string(size) + " bytes is not supported");
+  Request r{node, index, subIndex, false, value, size, {}, nullptr, 0};
+  auto future = r.promise.get_future();
+  submit(std::move(r));
+  return future;
+}
+
+void SdoClient::download(uint8_t node, uint16_t index, uint8_t subIndex, uint32_t value, uint8_t size, Callback done) {
+  if (size < 1 || size > 4) throw Fault("SDO download of " + std::to_string(size) + " bytes is not supported");
+  submit(Request{node, index, subIndex, false, value, size, {}, done, 0});
+}
+
+void SdoClient::submit(Request r) {
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    queue.push_back(std::move(r));
+  }
+  pending++;
+  if (!paced) wakeup.post();
+}
+
+void SdoClient::release() {
+  if (pending.load(std::memory_order_relaxed) > 0) wakeup.post();
+}
+
+void SdoClient::setPaced(bool paced) {
+  this->paced = paced;
+}
+
+void SdoClient::setFramesPerSlot(int n) {
+  framesPerSlot = std::max(n, 1);
+}
+
+void SdoClient::setTimeout(double sec) {
+  timeoutNs = llround(sec * 1.0e9);
+}
+
+int SdoClient::getPending() {
+  return pending;
+}
+
+void SdoClient::run() {
+  while (running) {
+    bool idle = active.empty() && (paced || pending == 0);
+    bool slot = idle ? (wakeup.wait(), true) : wakeup.wait(pollTime);
+    if (!running) break;
+    while (wakeup.wait(0)) { }   // slots missed while busy are not made up
+    int64_t now = nowNs();
+    receive();
+    expire(now);
+    if (slot || !paced) send(now);
+  }
+}
+
+void SdoClient::receive() {
+  int n;
+  while ((n = socket.receive()) > 0) {
+    for (int i = 0; i < n; i++) {
+      const can_frame& f = socket.getFrame(i);
+      canid_t id = f.can_id & CAN_SFF_MASK;
+      if ((f.can_id & (CAN_EFF_FLAG | CAN_RTR_FLAG)) || id <= cobIdResponse || id > cobIdResponse + 0x7F || f.can_dlc < 8) continue;
+      auto it = active.find(id - cobIdResponse);
+      if (it == active.end()) continue;
+      Request& r = it->second;
+      uint16_t index = f.data[1] | (f.data[2] << 8);
+      if (index != r.index || f.data[3] != r.subIndex) continue;   // late response of an expired transfer
+      uint32_t data = f.data[4] | (f.data[5] << 8) | (f.data[6] << 16) | (static_cast<uint32_t>(f.data[7]) << 24);
+      uint8_t command = f.data[0];
+      SdoResult result;
+      if (command == scsAbort) {
+        result.status = SdoResult::aborted;
+        result.abortCode = data;
+      } else if (r.upload && (command & 0xE0) == 0x40) {
+        if (command & 0x02) {
+          int size = (command & 0x01) ? 4 - ((command >> 2) & 0x03) : 4;
+          result.value = size == 4 ? data : data & ((1u << (8 * size)) - 1);
+        } else {
+          // segmented upload, abort it on the node as well
+          can_frame abort = frame(r.node, scsAbort, r.index, r.subIndex, abortInvalidCommand);
+          socket.queue(abort);
+          socket.flush();
+          result.status = SdoResult::unsupported;
+        }
+      } else if (!r.upload && command == 0x60) {
+        result.value = r.value;
+      } else {
+        continue;
+      }
+      complete(r, result);
+      active.erase(it);
+    }
+  }
+}
+
+void SdoClient::expire(int64_t now) {
+  for (auto it = active.begin(); it != active.end(); ) {
+    if (it->second.deadline <= now) {
+      log.warn() << "SDO transfer to node " << (int)it->first << " timed out";
+      SdoResult result;
+      result.status = SdoResult::timeout;
+      complete(it->second, result);
+      it = active.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void SdoClient::send(int64_t now) {
+  int frames = framesPerSlot;
+  std::lock_guard<std::mutex> lock(mtx);
+  for (auto it = queue.begin(); it != queue.end() && socket.getQueued() < frames; ) {
+    if (active.count(it->node) != 0) {   // one transfer per node
+      ++it;
+      continue;
+    }
+    uint8_t command = it->upload ? ccsUpload : ccsDownload | ((4 - it->size) << 2);
+    socket.queue(frame(it->node, command, it->index, it->subIndex, it->value));
+    it->deadline = now + timeoutNs;
+    uint8_t node = it->node;
+    active.emplace(node, std::move(*it));
+    it = queue.erase(it);
+  }
+  int queued = socket.getQueued();
+  if (queued > 0 && socket.flush() != queued) log.warn() << "sending SDO request failed";
+}
+
+void SdoClient::complete(Request& r, const SdoResult& result) {
+  pending--;
+  if (r.done) {
+    try {
+      r.done(result);
+    } catch (std::exception& e) {
+      log.error() << "SDO callback: " << e.what();
+    }
+  } else {
+    r.promise.set_value(result);
+  }
+}
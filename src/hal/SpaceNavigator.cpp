@@ -1,48 +1,49 @@
-#include <eeros/hal/XBox.hpp>
+#include <eeros/hal/SpaceNavigator.hpp>
 #include <eeros/hal/HAL.hpp>
 #include <eeros/hal/SpaceNavigatorDigIn.hpp>
+#include <eeros/hal/InputHub.hpp>
 
-#include <cstdio>
-#include <fstream>
+#include <cstring>
 #include <fcntl.h>
+#include <linux/joystick.h>
+#include <sys/ioctl.h>
 #include <unistd.h>
 
 using namespace eeros;
 using namespace eeros::hal;
 
-SpaceNavigator::SpaceNavigator(std::string dev, int priority) : Thread(priority), log(logger::Logger::getLogger('N')) {
+SpaceNavigator::SpaceNavigator(std::string dev, int priority) : log(logger::Logger::getLogger('N')) {
 		this->open(dev.c_str());
 		this->useRaw = (dev.find("raw") != std::string::npos);
 		button[0] = new SpaceNavigatorDigIn("SpaceNavButtonL", this);
 		button[1] = new SpaceNavigatorDigIn("SpaceNavButtonR", this);
 		HAL& hal = HAL::instance();
 		for (int i = 0; i < SPACENAVIGATOR_BUTTON_COUNT; i++) hal.addInput(button[i]);
-		for (int i = 0; i < SPACENAVIGATOR_AXIS_COUNT; i++) current.axis[i] = 0;
-		for (int i = 0; i < SPACENAVIGATOR_BUTTON_COUNT; i++) current.button[i] = false;
+		log.info() << "use raw: " << useRaw;
+		if (fd >= 0) InputHub::instance().add(fd, [this]() { onReadable(); }, priority);
 }
 
 
 SpaceNavigator::~SpaceNavigator() { 
-	running = false; 
-	join(); 
+	if (fd >= 0) InputHub::instance().remove(fd);
 	this->close(); 
 }
 
 bool SpaceNavigator::open(const char* device) {
-	file = ::fopen(device, "rb");
-	if (file == NULL) {
+	fd = ::open(device, O_RDONLY | O_NONBLOCK);
+	if (fd < 0) {
 		log.error() << "Space Navigator: could not open input device on " + std::string(device);
 	}
 	return true;
 }
 
-void SpaceNavigator::close() { ::fclose(file); }
+void SpaceNavigator::close() { if (fd >= 0) ::close(fd); }
 
 std::string SpaceNavigator::name() {
-	if (!file) return "";
+	if (fd < 0) return "";
 	
 	char name[128];
-	if (ioctl(fileno(file), JSIOCGNAME (sizeof(name)), name)) {
+	if (ioctl(fd, JSIOCGNAME (sizeof(name)), name)) {
 		name[127] = 0;
 		return name;
 	} else return "";
@@ -88,121 +89,84 @@ std::string SpaceNavigator::name() {
      * As such, byte 1 can take values 0x00, 0x01, 0x02, or 0x03.
      */
 
-void SpaceNavigator::run() {
-	running = true;
-	log.info() << "use raw: " << useRaw;
-	if (!file) return;
+void SpaceNavigator::onReadable() {
+	bool changed = false;
 	if (useRaw) {	// read from raw hid stream
-		uint8_t readbuff[14];
-		while (running) {
-			*readbuff = fgetc(file);
-			switch(*readbuff) {
-			case 0x01: // position/rotation packet 
-				if (fread(readbuff+1, 1, 13, file));
-				current.axis[0] = (int16_t)(((int16_t)readbuff[2]<<8)&0xff00) | ((int16_t)readbuff[1]&0xff);
-				current.axis[1] = (int16_t)(((int16_t)readbuff[4]<<8)&0xff00) | ((int16_t)readbuff[3]&0xff);
-				current.axis[2] = (int16_t)(((int16_t)readbuff[6]<<8)&0xff00) | ((int16_t)readbuff[5]&0xff);
-				current.rotAxis[0] = (int16_t)(((int16_t)readbuff[9]<<8)&0xff00) | ((int16_t)readbuff[8]&0xff);
-				current.rotAxis[1] = (int16_t)(((int16_t)readbuff[11]<<8)&0xff00) | ((int16_t)readbuff[10]&0xff);
-				current.rotAxis[2] = (int16_t)(((int16_t)readbuff[13]<<8)&0xff00) | ((int16_t)readbuff[12]&0xff);
-				break;
-			case 0x03: // button event
-				if (fread(readbuff+1, 1, 2, file)); 
-				switch(readbuff[1]) {
-				case 0x00:
-					current.button[0] = false;
-					current.button[1] = false;
-					break;
-				case 0x01:
-					current.button[0] = true;
-					current.button[1] = false;
-					break;
-				case 0x02:
-					current.button[0] = false;
-					current.button[1] = true;
-					break;
-				case 0x03:
-					current.button[0] = true;
-					current.button[1] = true;
-					break;
-				default: 
-					break;
-				}
-				break;
-			default: // bad header
-				break;
-			}
+		ssize_t n;
+		while ((n = ::read(fd, rawBuffer + rawLength, sizeof(rawBuffer) - rawLength)) > 0) {
+			rawLength += n;
+			changed |= parseRaw();
 		}
 	} else {	// read events
 		struct input_event ev;
-		while (running) {
-			if (fread(&ev, sizeof(struct input_event), 1, file));
-			switch(ev.type) {
-			case 1: // button event
-				switch(ev.code) {
-				case 256:	// button 0
-					if (ev.value) current.button[0] = true;
-					else current.button[0] = false;
-					break;
-				case 257:	// button 1
-					if (ev.value) current.button[1] = true;
-					else current.button[1] = false;
-					break;
-				default: 
-					break;
-				}
-				break;
-			case 2: // position/rotation packet (rel), sent by: 3Dconnexion SpaceNavigator for Notebooks, vendor 0x46d product 0xc628 version 0x111
-				switch(ev.code) {
-				case 0:	// X
-					current.axis[0] = ev.value;
-					break;
-				case 1:	// Y
-					current.axis[1] = ev.value;
-					break;
-				case 2:	// Z
-					current.axis[2] = ev.value;
-					break;
-				case 3:	// RY
-					current.rotAxis[0] = ev.value;
-					break;
-				case 4:	// RY
-					current.rotAxis[1] = ev.value;
-					break;
-				case 5:	// RZ
-					current.rotAxis[2] = ev.value;
-					break;
-				default: 
-					break;
-				}
-				break;
-			case 3: // position/rotation packet (abs), sent by: 3Dc̘3Dconne SpaceMouse Wireless Receiver, vendor 0x256f product 0xc62f version 0x111
-				switch(ev.code) {
-				case 0:	// X
-					current.axis[0] = ev.value;
-					break;
-				case 1:	// Y
-					current.axis[1] = ev.value;
-					break;
-				case 2:	// Z
-					current.axis[2] = ev.value;
-					break;
-				case 3:	// RY
-					current.rotAxis[0] = ev.value;
-					break;
-				case 4:	// RY
-					current.rotAxis[1] = ev.value;
-					break;
-				case 5:	// RZ
-					current.rotAxis[2] = ev.value;
-					break;
-				default: 
-					break;
-				}
-				break;
-			default: // other
-				break;
-			}
+		while (::read(fd, &ev, sizeof(struct input_event)) == sizeof(struct input_event)) {
+			changed |= parseEvent(ev);
 		}
 	}
+	if (changed) current.write(state);
+}
+
+bool SpaceNavigator::parseRaw() {
+	bool changed = false;
+	int pos = 0;
+	while (pos < rawLength) {
+		const uint8_t* readbuff = rawBuffer + pos;
+		int available = rawLength - pos;
+		if (readbuff[0] == 0x01) { // position/rotation packet 
+			if (available < 14) break;
+			state.axis[0] = (int16_t)(((int16_t)readbuff[2]<<8)&0xff00) | ((int16_t)readbuff[1]&0xff);
+			state.axis[1] = (int16_t)(((int16_t)readbuff[4]<<8)&0xff00) | ((int16_t)readbuff[3]&0xff);
+			state.axis[2] = (int16_t)(((int16_t)readbuff[6]<<8)&0xff00) | ((int16_t)readbuff[5]&0xff);
+			state.rotAxis[0] = (int16_t)(((int16_t)readbuff[9]<<8)&0xff00) | ((int16_t)readbuff[8]&0xff);
+			state.rotAxis[1] = (int16_t)(((int16_t)readbuff[11]<<8)&0xff00) | ((int16_t)readbuff[10]&0xff);
+			state.rotAxis[2] = (int16_t)(((int16_t)readbuff[13]<<8)&0xff00) | ((int16_t)readbuff[12]&0xff);
+			pos += 14;
+			changed = true;
+		} else if (readbuff[0] == 0x03) { // button event
+			if (available < 3) break;
+			state.button[0] = readbuff[1] & 0x01;
+			state.button[1] = readbuff[1] & 0x02;
+			pos += 3;
+			changed = true;
+		} else { // bad header, resynchronize on the next byte
+			pos++;
+		}
+	}
+	rawLength -= pos;
+	std::memmove(rawBuffer, rawBuffer + pos, rawLength);
+	return changed;
+}
+
+bool SpaceNavigator::parseEvent(const struct input_event& ev) {
+	switch(ev.type) {
+	case 1: // button event
+		switch(ev.code) {
+		case 256:	// button 0
+			state.button[0] = ev.value;
+			return true;
+		case 257:	// button 1
+			state.button[1] = ev.value;
+			return true;
+		default: 
+			return false;
+		}
+	case 2: // position/rotation packet (rel), sent by: 3Dconnexion SpaceNavigator for Notebooks, vendor 0x46d product 0xc628 version 0x111
+	case 3: // position/rotation packet (abs), sent by: 3Dconnexion SpaceMouse Wireless Receiver, vendor 0x256f product 0xc62f version 0x111
+		switch(ev.code) {
+		case 0:	// X
+		case 1:	// Y
+		case 2:	// Z
+			state.axis[ev.code] = ev.value;
+			return true;
+		case 3:	// RX
+		case 4:	// RY
+		case 5:	// RZ
+			state.rotAxis[ev.code - 3] = ev.value;
+			return true;
+		default: 
+			return false;
+		}
+	default: // other
+		return false;
+	}
 }
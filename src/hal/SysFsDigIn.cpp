@@ -1,11 +1,16 @@
 #include <eeros/hal/SysFsDigIn.hpp>
 #include <eeros/core/Fault.hpp>
+#include <fstream>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
 
 using namespace eeros::hal;
 
-SysFsDigIn::SysFsDigIn(std::string id, void* libHandle, unsigned int gpio, bool inverted) : Input<bool>(id, libHandle), basePath("/sys/class/gpio/gpio" + std::to_string(gpio) + "/") {
+SysFsDigIn::SysFsDigIn(std::string id, void* libHandle, unsigned int gpio, bool inverted, Edge edge) : Input<bool>(id, libHandle), inverted(inverted), basePath("/sys/class/gpio/gpio" + std::to_string(gpio) + "/") {
 	std::ofstream exportFile;
 	std::ofstream directionFile;
+	std::ofstream edgeFile;
 	
 	// Export GPIO
 	exportFile.open("/sys/class/gpio/export");
@@ -15,28 +20,51 @@ SysFsDigIn::SysFsDigIn(std::string id, void* libHandle, unsigned int gpio, bool
 	exportFile << gpio;
 	exportFile.close();
 	
-	// Set GPIO direction to output
+	// Set GPIO direction to input
 	directionFile.open(basePath + "direction");
 	if(!directionFile.is_open()) {
-		throw Fault("Failed to set direction to output for GPIO" +  std::to_string(gpio) + "!");
+		throw Fault("Failed to set direction to input for GPIO" +  std::to_string(gpio) + "!");
 	}
 	directionFile << "in";
 	directionFile.close();
 	
+	// Set edge which is reported to poll()
+	if(edge != Edge::none) {
+		edgeFile.open(basePath + "edge");
+		if(!edgeFile.is_open()) {
+			throw Fault("Failed to set edge for GPIO" +  std::to_string(gpio) + "!");
+		}
+		switch(edge) {
+			case Edge::rising: edgeFile << "rising"; break;
+			case Edge::falling: edgeFile << "falling"; break;
+			default: edgeFile << "both"; break;
+		}
+		edgeFile.close();
+	}
+	
 	// Open value file
-	valueFile.open(basePath + "value");
-	if(!valueFile.is_open()) {
+	fd = open((basePath + "value").c_str(), O_RDONLY | O_CLOEXEC);
+	if(fd < 0) {
 		throw Fault("Failed to open value file for GPIO" +  std::to_string(gpio) + "!");
 	}
 }
 
 SysFsDigIn::~SysFsDigIn(){
-	valueFile.close();
+	close(fd);
 }
+
 bool SysFsDigIn::get() {
-	int value;
-	if(!valueFile.is_open()) return false;
-	valueFile >> value;
-	if(inverted) value = !value;
-	return static_cast<bool>(value);
+	char buf[2];
+	// reading from offset 0 always returns the current value
+	if(pread(fd, buf, sizeof(buf), 0) < 1) return false;
+	bool value = (buf[0] == '1');
+	return inverted ? !value : value;
+}
+
+bool SysFsDigIn::waitForEdge(int timeout) {
+	struct pollfd p = {fd, POLLPRI | POLLERR, 0};
+	if(poll(&p, 1, timeout) < 1) return false;
+	char buf[2];
+	if(pread(fd, buf, sizeof(buf), 0) < 0) { }	// acknowledges the edge
+	return true;
 }
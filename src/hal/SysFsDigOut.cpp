@@ -1,9 +1,12 @@
 #include <eeros/hal/SysFsDigOut.hpp>
 #include <eeros/core/Fault.hpp>
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
 
 using namespace eeros::hal;
 
-SysFsDigOut::SysFsDigOut(std::string id, void* libHandle, unsigned int gpio, bool inverted) : Output<bool>(id, libHandle), basePath("/sys/class/gpio/gpio" + std::to_string(gpio) + "/") {
+SysFsDigOut::SysFsDigOut(std::string id, void* libHandle, unsigned int gpio, bool inverted) : Output<bool>(id, libHandle), inverted(inverted), value(false), basePath("/sys/class/gpio/gpio" + std::to_string(gpio) + "/") {
 	std::ofstream exportFile;
 	std::ofstream directionFile;
 	
@@ -24,26 +27,25 @@ SysFsDigOut::SysFsDigOut(std::string id, void* libHandle, unsigned int gpio, boo
 	directionFile.close();
 	
 	// Open value file
-	valueFile.open(basePath + "value");
-	if(!valueFile.is_open()) {
+	fd = open((basePath + "value").c_str(), O_RDWR | O_CLOEXEC);
+	if(fd < 0) {
 		throw Fault("Failed to open value file for GPIO" +  std::to_string(gpio) + "!");
 	}
+	char buf[2];
+	if(pread(fd, buf, sizeof(buf), 0) > 0) value = ((buf[0] == '1') != inverted);
 }
 
 SysFsDigOut::~SysFsDigOut(){
-	valueFile.close();
+	close(fd);
 }
+
 bool SysFsDigOut::get() {
-	int value;
-	if(!valueFile.is_open()) return false;
-	valueFile >> value;
-	if(inverted) value = !value;
-	return static_cast<bool>(value);
+	return value;
 }
 
 void SysFsDigOut::set(bool value) {
+	this->value = value;
 	if(inverted) value = !value;
-	if(valueFile.is_open()) {
-		valueFile << static_cast<int>(value);
-	}
+	const char c = value ? '1' : '0';
+	if(pwrite(fd, &c, 1, 0) != 1) { }	// a failed write shows up in the next cycle again
 }
@@ -1,6 +1,7 @@
 #include <eeros/hal/XBox.hpp>
 #include <eeros/hal/HAL.hpp>
 #include <eeros/hal/XBoxDigIn.hpp>
+#include <eeros/hal/InputHub.hpp>
 
 #include <cstdio>
 #include <fcntl.h>
@@ -10,7 +11,7 @@ using namespace eeros::hal;
 
 const double XBoxState::axis_max = 0x7fff;
 
-XBox::XBox(std::string dev, int priority) : Thread(priority) {
+XBox::XBox(std::string dev, int priority) : log(logger::Logger::getLogger()) {
 	open(dev.c_str());
 	button[0] = new XBoxDigIn("XBoxButtonA", this);
 	button[1] = new XBoxDigIn("XBoxButtonB", this);
@@ -22,35 +23,22 @@ XBox::XBox(std::string dev, int priority) : Thread(priority) {
 	button[7] = new XBoxDigIn("XBoxButtonStart", this);
 	HAL& hal = HAL::instance();
 	for (int i = 0; i < XBOX_BUTTON_COUNT; i++) hal.addInput(button[i]);
-
-	for (int i = 0; i < XBOX_AXIS_COUNT; i++) 	{
-		last.axis[i] = 0;
-		current.axis[i] = 0;
-	}
-	for (int i = 0; i < XBOX_BUTTON_COUNT; i++)	{
-		last.button_state[i] = false;
-		last.button_up[i] = false;
-		last.button_down[i] = false;
-		current.button_state[i] = false;
-		current.button_up[i] = false;
-		current.button_down[i] = false;
-	}
+	if (fd >= 0) InputHub::instance().add(fd, [this]() { onReadable(); }, priority);
 }
 
 
 XBox::~XBox() {
-	running = false; 
-	join(); 
-	close(); 
+	if (fd >= 0) InputHub::instance().remove(fd);
+	close();
 }
 
 bool XBox::open(const char* device) {
-	fd = ::open(device, O_RDONLY);
+	fd = ::open(device, O_RDONLY | O_NONBLOCK);
 	if (fd < 0) log.error() << "XBox: could not open input device on " + std::string(device);
 	return fd;
 }
 
-void XBox::close() { ::close(fd); }
+void XBox::close() { if (fd >= 0) ::close(fd); }
 
 std::string XBox::name() {
 	if (!fd) return "";
@@ -75,20 +63,18 @@ void XBox::on_axis(std::function<void(int, double)> action) {
 }
 
 
-void XBox::run() {
-	running = true;
-	if (fd < 0) return;
+void XBox::onReadable() {
 	struct js_event e;
-	while (running) 	{
-		if (read(fd, &e, sizeof(struct js_event)));
-		
+	bool changed = false;
+	while (read(fd, &e, sizeof(struct js_event)) == sizeof(struct js_event)) {
 		switch (e.type) {
 			case (JS_EVENT_BUTTON | JS_EVENT_INIT):
 			case JS_EVENT_BUTTON:
 				if (e.number < XBOX_BUTTON_COUNT) {
-					current.button_state[e.number] = e.value;
-					current.button_up[e.number] = (!current.button_state[e.number] & last.button_state[e.number]);
-					current.button_down[e.number] = (current.button_state[e.number] & !last.button_state[e.number]);
+					currentState.button_state[e.number] = e.value;
+					currentState.button_up[e.number] = (!currentState.button_state[e.number] & lastState.button_state[e.number]);
+					currentState.button_down[e.number] = (currentState.button_state[e.number] & !lastState.button_state[e.number]);
+					changed = true;
 					
 					if (e.type != (JS_EVENT_BUTTON | JS_EVENT_INIT))
 						if (button_action != nullptr)
@@ -99,11 +85,12 @@ void XBox::run() {
 			case (JS_EVENT_AXIS | JS_EVENT_INIT):
 			case JS_EVENT_AXIS:
 				if (e.number < XBOX_AXIS_COUNT) {
-					current.axis[e.number] = (e.value / XBoxState::axis_max);
+					currentState.axis[e.number] = (e.value / XBoxState::axis_max);
+					changed = true;
 					
 					if (e.type != (JS_EVENT_AXIS | JS_EVENT_INIT))
 						if (axis_action != nullptr)
-							axis_action(e.number, current.axis[e.number]);
+							axis_action(e.number, currentState.axis[e.number]);
 				}
 				break;
 				
@@ -112,7 +99,10 @@ void XBox::run() {
 		}
 		
 		if (event_action != nullptr) event_action(e);
-
-		last = current;
+	}
+	if (changed) {
+		current.write(currentState);
+		last.write(lastState);
+		lastState = currentState;
 	}
 }
@@ -0,0 +1,156 @@
+#include <eeros/logger/AsyncLogWriter.hpp>
+#include <eeros/core/Tracepoint.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+using namespace eeros::logger;
+
+namespace {
+  // written by begin() in front of the text of each message
+  struct Meta {
+    LogLevel level;
+    unsigned category;
+    std::chrono::system_clock::rep time;
+  };
+
+  constexpr auto period = std::chrono::milliseconds(10);
+}
+
+// holds either the text of a message, or the raw arguments of a deferred message
+struct AsyncLogWriter::Record {
+  Record() { }
+  Meta meta;
+  const char* format;
+  uint16_t length;   // characters of the text or number of arguments
+  union {
+    char text[maxLength];
+    LogArg args[maxLogArgs];
+  };
+};
+static_assert(sizeof(LogArg) * maxLogArgs <= AsyncLogWriter::maxLength, "too many deferred log arguments");
+
+struct AsyncLogWriter::Channel {
+  std::atomic<std::thread::id> owner{};
+  std::atomic<AsyncLogWriter*> writer{nullptr};
+  eeros::SpscRingBuffer<Record, ringSize> ring;
+};
+
+AsyncLogWriter::AsyncLogWriter(std::ostream& out) : StreamLogWriter(out) {
+  for (auto& c : channels) {
+    c = std::make_shared<Channel>();
+    c->writer.store(this, std::memory_order_relaxed);
+  }
+  thread = std::thread([this]() { run(); });
+}
+
+AsyncLogWriter::AsyncLogWriter(std::ostream& out, std::string logFile) : StreamLogWriter(out, logFile) {
+  for (auto& c : channels) {
+    c = std::make_shared<Channel>();
+    c->writer.store(this, std::memory_order_relaxed);
+  }
+  thread = std::thread([this]() { run(); });
+}
+
+AsyncLogWriter::~AsyncLogWriter() {
+  running.store(false, std::memory_order_relaxed);
+  if (thread.joinable()) thread.join();
+  drain();
+  // threads which still cache a channel must not find this writer again
+  for (auto& c : channels) c->writer.store(nullptr, std::memory_order_relaxed);
+}
+
+void AsyncLogWriter::flush() {
+  drain();
+}
+
+uint64_t AsyncLogWriter::getDropped() const {
+  return dropped.load(std::memory_order_relaxed);
+}
+
+void AsyncLogWriter::begin(std::ostringstream& os, LogLevel level, unsigned category) {
+  Meta meta{level, category, std::chrono::system_clock::now().time_since_epoch().count()};
+  os.write(reinterpret_cast<const char*>(&meta), sizeof(meta));
+}
+
+void AsyncLogWriter::end(std::ostringstream& os) {
+  auto text = os.view();
+  if (text.size() < sizeof(Meta)) return;
+  Record r;
+  std::memcpy(&r.meta, text.data(), sizeof(Meta));
+  r.format = nullptr;
+  r.length = std::min<std::size_t>(text.size() - sizeof(Meta), maxLength);
+  std::memcpy(r.text, text.data() + sizeof(Meta), r.length);
+  push(r);
+}
+
+void AsyncLogWriter::write(LogLevel level, unsigned category, const char* format, const LogArg* args, int nofArgs) {
+  Record r;
+  r.meta = {level, category, std::chrono::system_clock::now().time_since_epoch().count()};
+  r.format = format;
+  r.length = nofArgs;
+  std::copy(args, args + nofArgs, r.args);
+  push(r);
+}
+
+void AsyncLogWriter::push(const Record& r) {
+  Channel* c = channel();
+  bool ok = c != nullptr && c->ring.push(r);
+  EEROS_TRACE2(log_enqueue, this, ok);
+  if (!ok) dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+AsyncLogWriter::Channel* AsyncLogWriter::channel() {
+  // releases the channel when the thread ends, so another thread can take it
+  struct Slot {
+    std::shared_ptr<Channel> channel;
+    ~Slot() {
+      if (channel) channel->owner.store(std::thread::id(), std::memory_order_release);
+    }
+  };
+  thread_local Slot slot;
+  if (slot.channel && slot.channel->writer.load(std::memory_order_relaxed) == this) return slot.channel.get();
+
+  // first message of this thread to this writer, a thread keeps one channel only
+  std::thread::id self = std::this_thread::get_id();
+  for (auto& c : channels) {
+    std::thread::id free{};
+    if (c->owner.compare_exchange_strong(free, self, std::memory_order_acquire)) {
+      if (slot.channel) slot.channel->owner.store(std::thread::id(), std::memory_order_release);
+      slot.channel = c;
+      return c.get();
+    }
+  }
+  return nullptr;
+}
+
+void AsyncLogWriter::drain() {
+  std::lock_guard<std::mutex> lock(drainMtx);
+  std::ostringstream os;
+  Record r;
+  bool written = false;
+  for (auto& c : channels) {
+    while (c->ring.pop(r)) {
+      os.str("");
+      std::chrono::system_clock::time_point time{std::chrono::system_clock::duration(r.meta.time)};
+      header(os, r.meta.level, r.meta.category, time);
+      if (r.format != nullptr) format(os, r.format, r.args, r.length);
+      else os.write(r.text, r.length);
+      footer(os);
+      out << os.str();
+      fileOut << os.str();
+      written = true;
+    }
+  }
+  if (written) {
+    out.flush();
+    fileOut.flush();
+  }
+}
+
+void AsyncLogWriter::run() {
+  while (running.load(std::memory_order_relaxed)) {
+    drain();
+    std::this_thread::sleep_for(period);
+  }
+}
@@ -0,0 +1,20 @@
+#include <eeros/logger/LogFormat.hpp>
+
+void eeros::logger::format(std::ostream& os, const char* format, const LogArg* args, int nofArgs) {
+  int n = 0;
+  for (const char* c = format; *c != 0; c++) {
+    if (c[0] == '{' && c[1] == '}' && n < nofArgs) {
+      const LogArg& a = args[n++];
+      switch (a.type) {
+        case LogArg::Type::INT: os << a.i; break;
+        case LogArg::Type::UINT: os << a.u; break;
+        case LogArg::Type::DOUBLE: os << a.d; break;
+        case LogArg::Type::BOOL: os << (a.u != 0); break;
+        case LogArg::Type::CHAR: os << static_cast<char>(a.i); break;
+      }
+      c++;
+    } else {
+      os << *c;
+    }
+  }
+}
@@ -1,3 +1,10 @@
 #include <eeros/logger/LogWriter.hpp>
 
 void eeros::logger::endl(LogWriter& w) { }  // implementation never user
+
+void eeros::logger::LogWriter::write(LogLevel level, unsigned category, const char* format, const LogArg* args, int nofArgs) {
+  std::ostringstream os;
+  begin(os, level, category);
+  logger::format(os, format, args, nofArgs);
+  end(os);
+}
@@ -0,0 +1,124 @@
+#include <eeros/logger/MappedLogFile.hpp>
+#include <eeros/core/Fault.hpp>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace eeros;
+using namespace eeros::logger;
+
+namespace {
+  constexpr auto period = std::chrono::milliseconds(100);
+}
+
+MappedLogFile::MappedLogFile(std::string path, std::size_t segmentSize, int nofSegments)
+    : path(path), nofSegments(nofSegments) {
+  if (nofSegments < 2) throw Fault("mapped log file needs at least 2 segments");
+  std::size_t page = ::sysconf(_SC_PAGESIZE);
+  size = (segmentSize + page - 1) / page * page;
+  if (size == 0) size = page;
+  current = open(0);
+  next = open(1);
+  if (current.data == nullptr || next.data == nullptr) {
+    close(current);
+    close(next);
+    throw Fault("could not create mapped log file '" + path + "'");
+  }
+  thread = std::thread([this]() { run(); });
+}
+
+MappedLogFile::~MappedLogFile() {
+  running.store(false, std::memory_order_relaxed);
+  if (thread.joinable()) thread.join();
+  close(retired);
+  close(current);
+  close(next);
+}
+
+void MappedLogFile::write(const char* data, std::size_t length) {
+  if (length > size) length = size;
+  std::lock_guard<std::mutex> lock(mtx);
+  if (current.used + length > size) {
+    if (next.data == nullptr || retired.data != nullptr) {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    retired = current;
+    current = next;
+    next = Segment();
+  }
+  std::memcpy(current.data + current.used, data, length);
+  current.used += length;
+}
+
+uint64_t MappedLogFile::getDropped() const {
+  return dropped.load(std::memory_order_relaxed);
+}
+
+std::size_t MappedLogFile::getSegmentSize() const {
+  return size;
+}
+
+MappedLogFile::Segment MappedLogFile::open(int index) {
+  Segment s;
+  s.index = index;
+  std::string name = path + '.' + std::to_string(index);
+  s.fd = ::open(name.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (s.fd < 0) return Segment();
+  if (::posix_fallocate(s.fd, 0, size) != 0) {
+    ::close(s.fd);
+    return Segment();
+  }
+  void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, s.fd, 0);
+  if (p == MAP_FAILED) {
+    ::close(s.fd);
+    return Segment();
+  }
+  s.data = static_cast<char*>(p);
+  return s;
+}
+
+void MappedLogFile::close(Segment& s) {
+  if (s.data == nullptr) return;
+  ::msync(s.data, size, MS_SYNC);
+  ::munmap(s.data, size);
+  if (::ftruncate(s.fd, s.used) != 0) { /* the file keeps its preallocated size */ }
+  ::close(s.fd);
+  s = Segment();
+}
+
+void MappedLogFile::sync() {
+  Segment r, c;
+  bool prepare;
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    r = retired;
+    retired = Segment();
+    c = current;
+    prepare = (next.data == nullptr);
+  }
+  // segments are unmapped by this thread only, so c stays mapped outside the lock
+  if (r.data != nullptr) {
+    close(r);
+    synced = 0;
+  }
+  std::size_t page = ::sysconf(_SC_PAGESIZE);
+  if (c.used > synced) {
+    std::size_t from = synced / page * page;
+    ::msync(c.data + from, c.used - from, MS_SYNC);
+    synced = c.used;
+  }
+  if (prepare) {
+    Segment s = open((c.index + 1) % nofSegments);
+    std::lock_guard<std::mutex> lock(mtx);
+    next = s;
+  }
+}
+
+void MappedLogFile::run() {
+  while (running.load(std::memory_order_relaxed)) {
+    std::this_thread::sleep_for(period);
+    sync();
+  }
+}
@@ -0,0 +1,17 @@
+#include <eeros/logger/MappedLogWriter.hpp>
+
+using namespace eeros::logger;
+
+MappedLogWriter::MappedLogWriter(std::ostream& out, std::string logFile, std::size_t segmentSize, int nofSegments)
+    : StreamLogWriter(out), file(logFile, segmentSize, nofSegments) { }
+
+uint64_t MappedLogWriter::getDropped() const {
+  return file.getDropped();
+}
+
+void MappedLogWriter::end(std::ostringstream& os) {
+  footer(os);
+  auto text = os.view();
+  out << text;
+  file.write(text.data(), text.size());
+}
@@ -0,0 +1,146 @@
+#include <eeros/logger/SharedLogRing.hpp>
+#include <eeros/core/Fault.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace eeros;
+using namespace eeros::logger;
+
+namespace {
+  constexpr std::size_t headerSize = 64;
+
+  std::size_t regionSize(uint32_t nofProducers, uint32_t ringSize) {
+    return headerSize + nofProducers * (sizeof(SharedLogProducer) + ringSize * sizeof(SharedLogRecord));
+  }
+}
+
+SharedLogRing::SharedLogRing(std::string name, uint32_t nofProducers, uint32_t ringSize)
+    : name(name), size(regionSize(nofProducers, ringSize)), region(nullptr) {
+  if (nofProducers == 0 || ringSize == 0) throw Fault("shared log ring '" + name + "' needs producers and records");
+  int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0666);
+  if (fd == -1) throw Fault("Failed to open shared memory of log ring '" + name + "'");
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (st.st_size < static_cast<off_t>(size) && ftruncate(fd, size) != 0)) {
+    close(fd);
+    throw Fault("Failed to size shared memory of log ring '" + name + "'");
+  }
+  void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED) throw Fault("Failed to map shared memory of log ring '" + name + "'");
+  region = static_cast<SharedLogRegion*>(memory);
+
+  // a new object is zero filled, the side which claims it writes the layout and
+  // publishes it with the magic number, the others wait until it is published
+  uint32_t expected = 0;
+  if (region->magic.compare_exchange_strong(expected, SharedLogRegion::initializing, std::memory_order_acquire)) {
+    region->version = SharedLogRegion::layoutVersion;
+    region->nofProducers = nofProducers;
+    region->ringSize = ringSize;
+    region->magic.store(SharedLogRegion::magicNumber, std::memory_order_release);
+  }
+  for (int i = 0; i < 1000 && region->magic.load(std::memory_order_acquire) == SharedLogRegion::initializing; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  if (region->magic.load(std::memory_order_acquire) == SharedLogRegion::initializing) {
+    munmap(region, size);
+    region = nullptr;
+    throw Fault("Layout of shared log ring '" + name + "' was not published in time");
+  }
+  if (region->magic.load(std::memory_order_acquire) != SharedLogRegion::magicNumber ||
+      region->version != SharedLogRegion::layoutVersion ||
+      region->nofProducers != nofProducers || region->ringSize != ringSize) {
+    munmap(region, size);
+    region = nullptr;
+    throw Fault("Shared log ring '" + name + "' exists with a different layout");
+  }
+}
+
+SharedLogRing::~SharedLogRing() {
+  if (region != nullptr) munmap(region, size);
+}
+
+SharedLogProducer& SharedLogRing::producer(uint32_t i) const {
+  return reinterpret_cast<SharedLogProducer*>(reinterpret_cast<char*>(region) + headerSize)[i];
+}
+
+SharedLogRecord* SharedLogRing::records(uint32_t i) const {
+  char* first = reinterpret_cast<char*>(region) + headerSize + region->nofProducers * sizeof(SharedLogProducer);
+  return reinterpret_cast<SharedLogRecord*>(first) + i * region->ringSize;
+}
+
+int SharedLogRing::claim() {
+  uint64_t self = static_cast<uint64_t>(::getpid()) << 32 | static_cast<uint32_t>(::syscall(SYS_gettid));
+  for (uint32_t i = 0; i < region->nofProducers; i++) {
+    uint64_t free = 0;
+    if (producer(i).owner.compare_exchange_strong(free, self, std::memory_order_acquire)) return i;
+  }
+  return -1;
+}
+
+void SharedLogRing::release(int producer) {
+  this->producer(producer).owner.store(0, std::memory_order_release);
+}
+
+bool SharedLogRing::push(int producer, const SharedLogRecord& record) {
+  SharedLogProducer& p = this->producer(producer);
+  uint64_t head = p.head.load(std::memory_order_relaxed);
+  if (head - p.tail.load(std::memory_order_acquire) >= region->ringSize) {
+    p.dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  SharedLogRecord& r = records(producer)[head % region->ringSize];
+  std::memcpy(&r, &record, offsetof(SharedLogRecord, text) + std::min<std::size_t>(record.length, SharedLogRecord::maxLength));
+  p.head.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+std::size_t SharedLogRing::poll(const std::function<void(const SharedLogRecord&)>& handler, std::chrono::nanoseconds delay) {
+  reclaim();
+  for (uint32_t i = 0; i < region->nofProducers; i++) {
+    SharedLogProducer& p = producer(i);
+    uint64_t tail = p.tail.load(std::memory_order_relaxed);
+    uint64_t head = p.head.load(std::memory_order_acquire);
+    for (; tail != head; tail++) pending.push_back(records(i)[tail % region->ringSize]);
+    p.tail.store(tail, std::memory_order_release);
+  }
+  // the records of each producer are already in order, the sort merges them
+  std::stable_sort(pending.begin(), pending.end(), [](const SharedLogRecord& a, const SharedLogRecord& b) { return a.time < b.time; });
+  auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch());
+  uint64_t until = now.count() - delay.count();
+  std::size_t n = 0;
+  while (n < pending.size() && pending[n].time <= until) handler(pending[n++]);
+  pending.erase(pending.begin(), pending.begin() + n);
+  return n;
+}
+
+// frees the producers of processes which ended without releasing them
+void SharedLogRing::reclaim() {
+  for (uint32_t i = 0; i < region->nofProducers; i++) {
+    SharedLogProducer& p = producer(i);
+    uint64_t owner = p.owner.load(std::memory_order_acquire);
+    pid_t pid = owner >> 32;
+    if (owner != 0 && ::kill(pid, 0) != 0 && errno == ESRCH) {
+      p.owner.compare_exchange_strong(owner, 0, std::memory_order_release);
+    }
+  }
+}
+
+uint64_t SharedLogRing::getDropped() const {
+  uint64_t dropped = 0;
+  for (uint32_t i = 0; i < region->nofProducers; i++) dropped += producer(i).dropped.load(std::memory_order_relaxed);
+  return dropped;
+}
+
+void SharedLogRing::remove(std::string name) {
+  shm_unlink(name.c_str());
+}
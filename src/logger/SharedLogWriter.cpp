@@ -0,0 +1,71 @@
+#include <eeros/logger/SharedLogWriter.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <unistd.h>
+
+using namespace eeros::logger;
+
+namespace {
+  // written by begin() in front of the text of each message
+  struct Meta {
+    LogLevel level;
+    unsigned category;
+    uint64_t time;
+  };
+}
+
+SharedLogWriter::SharedLogWriter(std::string name, uint32_t nofProducers, uint32_t ringSize)
+    : ring(std::make_shared<SharedLogRing>(name, nofProducers, ringSize)) { }
+
+uint64_t SharedLogWriter::getDropped() const {
+  return dropped.load(std::memory_order_relaxed);
+}
+
+void SharedLogWriter::begin(std::ostringstream& os, LogLevel level, unsigned category) {
+  auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch());
+  Meta meta{level, category, static_cast<uint64_t>(now.count())};
+  os.write(reinterpret_cast<const char*>(&meta), sizeof(meta));
+}
+
+void SharedLogWriter::end(std::ostringstream& os) {
+  auto text = os.view();
+  if (text.size() < sizeof(Meta)) return;
+  Meta meta;
+  std::memcpy(&meta, text.data(), sizeof(Meta));
+  SharedLogRecord r;
+  r.time = meta.time;
+  r.pid = ::getpid();
+  r.category = meta.category;
+  r.level = static_cast<uint8_t>(meta.level);
+  r.reserved = 0;
+  r.length = std::min<std::size_t>(text.size() - sizeof(Meta), SharedLogRecord::maxLength);
+  std::memcpy(r.text, text.data() + sizeof(Meta), r.length);
+  int p = producer();
+  if (p < 0 || !ring->push(p, r)) dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SharedLogWriter::endl(std::ostringstream& os) {
+  os << '\n';
+}
+
+int SharedLogWriter::producer() {
+  // frees the producer when the thread ends, the slot keeps the ring mapped until then
+  struct Slot {
+    std::shared_ptr<SharedLogRing> ring;
+    int index = -1;
+    ~Slot() {
+      if (ring && index >= 0) ring->release(index);
+    }
+  };
+  thread_local Slot slot;
+  if (slot.ring == ring && slot.index >= 0) return slot.index;
+
+  // first message of this thread to this writer, a thread keeps one producer only
+  int index = ring->claim();
+  if (index < 0) return -1;
+  if (slot.ring && slot.index >= 0) slot.ring->release(slot.index);
+  slot.ring = ring;
+  slot.index = index;
+  return index;
+}
@@ -22,6 +22,15 @@
 
 using namespace eeros::logger;
 
+namespace {
+  // date and time up to the second, formatted once per second and thread
+  struct TimePrefix {
+    time_t second = -1;
+    char text[20];
+  };
+  thread_local TimePrefix prefix;
+}
+
 StreamLogWriter::StreamLogWriter(std::ostream& out) : out(out), colored(true) {  }  // nothing to do
 
 StreamLogWriter::StreamLogWriter(std::ostream& out, std::string logFile) : out(out), colored(true) {
@@ -35,20 +44,25 @@ StreamLogWriter::StreamLogWriter(std::ostream& out, std::string logFile) : out(o
 
 StreamLogWriter::~StreamLogWriter() {fileOut.close();}
 
-void StreamLogWriter::show(LogLevel level) { visible_level = level; }
+void StreamLogWriter::show(LogLevel level) { setVisibleLevel(level); }
 
 void StreamLogWriter::begin(std::ostringstream& os, LogLevel level, unsigned category) {
-  tm localTime;
-  std::chrono::system_clock::time_point tx = std::chrono::system_clock::now();
+  header(os, level, category, std::chrono::system_clock::now());
+}
+
+void StreamLogWriter::header(std::ostream& os, LogLevel level, unsigned category, std::chrono::system_clock::time_point tx) {
   time_t now = std::chrono::system_clock::to_time_t(tx);
-  localtime_r(&now, &localTime);
-  const std::chrono::duration<double> tse = tx.time_since_epoch();
-  std::chrono::seconds::rep milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(tse).count() % 1000;
+  if (now != prefix.second) {
+    tm localTime;
+    localtime_r(&now, &localTime);
+    strftime(prefix.text, sizeof(prefix.text), "%Y-%m-%d %H:%M:%S", &localTime);
+    prefix.second = now;
+  }
+  int milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(tx.time_since_epoch()).count() % 1000;
+  char ms[] = {':', char('0' + milliseconds / 100), char('0' + milliseconds / 10 % 10), char('0' + milliseconds % 10), ' ', ' '};
   os << std::setfill('0');
-  os << std::setw(4) << (1900 + localTime.tm_year) << '-' << std::setw(2) << (localTime.tm_mon + 1) << '-' << std::setw(2) << localTime.tm_mday;
-  os << ' ';
-  os << std::setw(2) << localTime.tm_hour << ':' << std::setw(2) << localTime.tm_min << ':' << std::setw(2) << localTime.tm_sec << ':' << std::setw(3) << milliseconds;
-  os << "  ";
+  os.write(prefix.text, sizeof(prefix.text) - 1);
+  os.write(ms, sizeof(ms));
 
   if (category == 0) os << ' ';
   else {
@@ -79,9 +93,13 @@ void StreamLogWriter::begin(std::ostringstream& os, LogLevel level, unsigned cat
   os << ":  ";
 }
 
-void StreamLogWriter::end(std::ostringstream& os) {
+void StreamLogWriter::footer(std::ostream& os) {
   if (colored) os << COLOR_RESET;
   os << std::endl;
+}
+
+void StreamLogWriter::end(std::ostringstream& os) {
+  footer(os);
   out << os.str();
   fileOut << os.str();
   fileOut.flush();
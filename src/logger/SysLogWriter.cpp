@@ -1,32 +1,72 @@
 #include <eeros/logger/SysLogWriter.hpp>
+#include <eeros/core/Tracepoint.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <ctime>
 #include <syslog.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 
 using namespace eeros::logger;
 
-SysLogWriter::SysLogWriter(const std::string name) : 
-	name(name), 
-	visibleLevel(LogLevel::INFO), 
-	enabled(false)
+namespace {
+	constexpr auto period = std::chrono::milliseconds(10);
+	constexpr int batchSize = 32;
+
+	// syslog timestamp, formatted once per second and thread
+	struct TimeStamp {
+		time_t second = -1;
+		char text[16];
+	};
+	thread_local TimeStamp stamp;
+}
+
+SysLogWriter::SysLogWriter(const std::string name, const std::string socketPath) :
+	name(name),
+	socketPath(socketPath),
+	fd(-1)
 {
-	openlog(this->name.c_str(), LOG_CONS | LOG_PID | LOG_NDELAY, LOG_LOCAL0);
+	connect();
+	thread = std::thread([this]() { run(); });
 }
 
 SysLogWriter::~SysLogWriter() {
-	closelog();
+	running.store(false, std::memory_order_relaxed);
+	if (thread.joinable()) thread.join();
+	send();
+	if (fd >= 0) ::close(fd);
 }
 
 void SysLogWriter::show(LogLevel level) {
-	visibleLevel = level;
+	setVisibleLevel(level);
+}
+
+uint64_t SysLogWriter::getDropped() const {
+	return dropped.load(std::memory_order_relaxed);
 }
 
 void SysLogWriter::begin(std::ostringstream& os, LogLevel level, unsigned category) {
-	enabled = (level <= visibleLevel);
-	if(!enabled) return;
-	
-	this->level = level;
-	
-	using namespace std;
-	
+	int priority;
+	switch(level) {
+		case LogLevel::FATAL: priority = LOG_ALERT; break;
+		case LogLevel::ERROR: priority = LOG_ERR; break;
+		case LogLevel::WARN: priority = LOG_WARNING; break;
+		case LogLevel::INFO: priority = LOG_INFO; break;
+		case LogLevel::TRACE: priority = LOG_DEBUG; break;
+		default: priority = LOG_INFO; break;
+	}
+	time_t now = time(nullptr);
+	if (now != stamp.second) {
+		tm localTime;
+		localtime_r(&now, &localTime);
+		strftime(stamp.text, sizeof(stamp.text), "%b %e %H:%M:%S", &localTime);
+		stamp.second = now;
+	}
+	os << '<' << (LOG_LOCAL0 | priority) << '>' << stamp.text << ' ' << name << '[' << getpid() << "]: ";
+
 	if (category == 0) os << ' ';
 	else {
 		if (category >= 'A' && category <= 'Z')
@@ -45,39 +85,68 @@ void SysLogWriter::begin(std::ostringstream& os, LogLevel level, unsigned catego
 		default: os << 5; break;
 	}
 	os << ":  ";
-	return;
 }
 
 void SysLogWriter::end(std::ostringstream& os) {
-	if(!enabled) {
-		os.clear();
-		os.str("");
-		return;
-	}
-	
-	switch(level) {
-		case LogLevel::FATAL:
-			syslog(LOG_ALERT, "%s", os.str().c_str());
-			break;
-		case LogLevel::ERROR:
-			syslog(LOG_ERR, "%s", os.str().c_str());
-			break;
-		case LogLevel::WARN:
-			syslog(LOG_WARNING, "%s", os.str().c_str());
-			break;
-		case LogLevel::INFO:
-			syslog(LOG_INFO, "%s", os.str().c_str());
-			break;
-		case LogLevel::TRACE:
-			syslog(LOG_DEBUG, "%s", os.str().c_str());
-			break;
-		default:
-			syslog(LOG_INFO, "%s", os.str().c_str());
-			break;
-	}
+	auto text = os.view();
+	Record r;
+	r.length = std::min<std::size_t>(text.size(), maxLength);
+	std::memcpy(r.text, text.data(), r.length);
+	bool ok = queue.push(r);
+	EEROS_TRACE2(log_enqueue, this, ok);
+	if (!ok) dropped.fetch_add(1, std::memory_order_relaxed);
 }
 
 void SysLogWriter::endl(std::ostringstream& os) {
-	if(!enabled) return;
 	os << " \u21A9 ";
-}
\ No newline at end of file
+}
+
+void SysLogWriter::connect() {
+	fd = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (fd < 0) return;
+	sockaddr_un addr = {};
+	addr.sun_family = AF_UNIX;
+	std::strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+	if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+		::close(fd);
+		fd = -1;
+	}
+}
+
+void SysLogWriter::send() {
+	Record batch[batchSize];
+	mmsghdr msgs[batchSize];
+	iovec iov[batchSize];
+	for (;;) {
+		int n = 0;
+		while (n < batchSize && queue.pop(batch[n])) n++;
+		if (n == 0) return;
+		if (fd < 0) connect();   // the daemon may have been restarted
+		if (fd < 0) {
+			dropped.fetch_add(n, std::memory_order_relaxed);
+			continue;
+		}
+		for (int i = 0; i < n; i++) {
+			iov[i] = {batch[i].text, batch[i].length};
+			msgs[i] = {};
+			msgs[i].msg_hdr.msg_iov = &iov[i];
+			msgs[i].msg_hdr.msg_iovlen = 1;
+		}
+		int sent = ::sendmmsg(fd, msgs, n, MSG_DONTWAIT);
+		if (sent < 0) {
+			sent = 0;
+			if (errno != EAGAIN && errno != EWOULDBLOCK) {
+				::close(fd);
+				fd = -1;
+			}
+		}
+		if (sent < n) dropped.fetch_add(n - sent, std::memory_order_relaxed);
+	}
+}
+
+void SysLogWriter::run() {
+	while (running.load(std::memory_order_relaxed)) {
+		send();
+		std::this_thread::sleep_for(period);
+	}
+}
@@ -4,7 +4,8 @@
 using namespace eeros;
 using namespace eeros::math;
 
-std::map<std::string, CoordinateSystem*> CoordinateSystem::list;
+std::unordered_map<std::string, CoordinateSystem*> CoordinateSystem::list;
+std::vector<CoordinateSystem*> CoordinateSystem::indices;
 
 CoordinateSystem::CoordinateSystem(const CoordinateSystem&) { }
 
@@ -14,10 +15,16 @@ CoordinateSystem::CoordinateSystem(std::string id) : id(id) {
 		msg << "Coordinate system with id '" << id << "' exists already, pleace choose a unique name!";
 		throw Fault(msg.str());
 	}
+	index = 0;
+	while(index < indices.size() && indices[index] != nullptr) index++;
+	if(index == indices.size()) indices.push_back(this);
+	else indices[index] = this;
 }
 
 CoordinateSystem::~CoordinateSystem() {
+	Frame::removeFrames(*this);
 	CoordinateSystem::list.erase(id);
+	indices[index] = nullptr;
 }
 
 bool CoordinateSystem::operator==(const CoordinateSystem& right) const {
@@ -28,8 +35,17 @@ bool CoordinateSystem::operator!=(const CoordinateSystem& right) const {
 	return this != &right;
 }
 
-CoordinateSystem* CoordinateSystem::getCoordinateSystem(std::string id) {
-	return CoordinateSystem::list[id];
+CoordinateSystem* CoordinateSystem::getCoordinateSystem(const std::string& id) {
+	auto it = CoordinateSystem::list.find(id);
+	return (it != CoordinateSystem::list.end()) ? it->second : nullptr;
+}
+
+CoordinateSystem* CoordinateSystem::getCoordinateSystem(uint32_t index) {
+	return (index < indices.size()) ? indices[index] : nullptr;
+}
+
+uint32_t CoordinateSystem::getIndexLimit() {
+	return indices.size();
 }
 
 std::ostream& eeros::math::operator<<(std::ostream& os, const CoordinateSystem& cs) {
@@ -1,10 +1,13 @@
 #include <eeros/math/Frame.hpp>
 #include <eeros/core/Fault.hpp>
+#include <algorithm>
 
 using namespace eeros;
 using namespace eeros::math;
 
-std::list<Frame*> Frame::list;
+std::vector<Frame*> Frame::table;
+uint32_t Frame::size = 0;
+uint32_t Frame::nofFrames = 0;
 
 Frame::Frame(const CoordinateSystem& a, const CoordinateSystem& b) : a(a), b(b) {
 	T.eye();
@@ -13,7 +16,7 @@ Frame::Frame(const CoordinateSystem& a, const CoordinateSystem& b) : a(a), b(b)
 		msg << "Frame with a = '" << a << "' and b = '" << b << "' exists already!";
 		throw Fault(msg.str());
 	}
-	list.push_back(this);
+	add();
 }
 
 Frame::Frame(const CoordinateSystem& a, const CoordinateSystem& b, const eeros::math::Matrix<4, 4, double>& T) : a(a), b(b), T(T) {
@@ -22,7 +25,7 @@ Frame::Frame(const CoordinateSystem& a, const CoordinateSystem& b, const eeros::
 		msg << "Frame with a = '" << a << "' and b = '" << b << "' exists already!";
 		throw Fault(msg.str());
 	}
-	list.push_back(this);
+	add();
 }
 
 Frame::Frame(const CoordinateSystem& a, const CoordinateSystem& b, const eeros::math::Matrix<3, 3, double>& R, const eeros::math::Matrix<3, 1, double>& r) : a(a), b(b) {
@@ -32,11 +35,39 @@ Frame::Frame(const CoordinateSystem& a, const CoordinateSystem& b, const eeros::
 		msg << "Frame with a = '" << a << "' and b = '" << b << "' exists already!";
 		throw Fault(msg.str());
 	}
-	list.push_back(this);
+	add();
 }
 
 Frame::~Frame() {
-	list.remove(this);
+	uint32_t i = a.getIndex(), j = b.getIndex();
+	if(i < size && j < size && table[i * size + j] == this) {
+		table[i * size + j] = nullptr;
+		nofFrames--;
+	}
+}
+
+void Frame::add() {
+	uint32_t limit = CoordinateSystem::getIndexLimit();
+	if(limit > size) {  // grow the table, twice the size to keep this rare
+		uint32_t newSize = std::max(limit, 2 * size);
+		std::vector<Frame*> t(newSize * newSize, nullptr);
+		for(uint32_t i = 0; i < size; i++) {
+			for(uint32_t j = 0; j < size; j++) t[i * newSize + j] = table[i * size + j];
+		}
+		table.swap(t);
+		size = newSize;
+	}
+	table[a.getIndex() * size + b.getIndex()] = this;
+	nofFrames++;
+}
+
+void Frame::removeFrames(const CoordinateSystem& cs) {
+	uint32_t k = cs.getIndex();
+	if(k >= size) return;
+	for(uint32_t i = 0; i < size; i++) {
+		if(table[k * size + i] != nullptr) { table[k * size + i] = nullptr; nofFrames--; }
+		if(i != k && table[i * size + k] != nullptr) { table[i * size + k] = nullptr; nofFrames--; }
+	}
 }
 
 void Frame::set(const eeros::math::Matrix<4, 4, double>& T) {
@@ -77,12 +108,11 @@ Frame Frame::operator*(const Frame& right) const {
 }
 
 Frame* Frame::getFrame(const CoordinateSystem& a, const CoordinateSystem& b) {
-	for(auto f : list) {
-		if(f->getFromCoordinateSystem() == a && f->getToCoordinateSystem() == b) return f;
-	}
-	return nullptr;
+	uint32_t i = a.getIndex(), j = b.getIndex();
+	if(i >= size || j >= size) return nullptr;
+	return table[i * size + j];
 }
 
 uint32_t Frame::getNofFrames() {
-	return list.size();
+	return nofFrames;
 }
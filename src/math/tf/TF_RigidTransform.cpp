@@ -0,0 +1,88 @@
+#include <eeros/math/tf/TF_RigidTransform.hpp>
+#include <eeros/math/MatrixKernels.hpp>
+#include <cmath>
+
+using namespace eeros::math::tf;
+
+TF_RigidTransform::TF_RigidTransform(const Matrix<3, 3, double>& rot, const Vector3& trans) {
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) r[3 * i + j] = rot(i, j);
+    t[i] = trans(i);
+  }
+}
+
+TF_RigidTransform::TF_RigidTransform(const Matrix<4, 4, double>& m) {
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) r[3 * i + j] = m(i, j);
+    t[i] = m(i, 3);
+  }
+}
+
+bool TF_RigidTransform::isRigid(const Matrix<4, 4, double>& m, double tolerance) {
+  if (m(3, 0) != 0.0 || m(3, 1) != 0.0 || m(3, 2) != 0.0 || m(3, 3) != 1.0) return false;
+  for (int i = 0; i < 3; i++) {
+    for (int j = i; j < 3; j++) {
+      double dot = m(0, i) * m(0, j) + m(1, i) * m(1, j) + m(2, i) * m(2, j);
+      if (std::abs(dot - (i == j ? 1.0 : 0.0)) > tolerance) return false;
+    }
+  }
+  return true;
+}
+
+void TF_RigidTransform::transform(const double* x, const double* y, const double* z,
+                                  double* xOut, double* yOut, double* zOut, std::size_t n) const {
+  std::size_t i = 0;
+#ifdef EEROS_MATH_DOUBLE_PACK
+  using P = eeros::math::kernel::DoublePack;
+  P::V rv[9], tv[3];
+  for (int k = 0; k < 9; k++) rv[k] = P::set(r[k]);
+  for (int k = 0; k < 3; k++) tv[k] = P::set(t[k]);
+  for (; i + P::width <= n; i += P::width) {
+    P::V px = P::load(x + i), py = P::load(y + i), pz = P::load(z + i);
+    P::store(xOut + i, P::add(P::add(P::mul(rv[0], px), P::mul(rv[1], py)), P::add(P::mul(rv[2], pz), tv[0])));
+    P::store(yOut + i, P::add(P::add(P::mul(rv[3], px), P::mul(rv[4], py)), P::add(P::mul(rv[5], pz), tv[1])));
+    P::store(zOut + i, P::add(P::add(P::mul(rv[6], px), P::mul(rv[7], py)), P::add(P::mul(rv[8], pz), tv[2])));
+  }
+#endif
+  for (; i < n; i++) {
+    double px = x[i], py = y[i], pz = z[i];
+    xOut[i] = r[0] * px + r[1] * py + (r[2] * pz + t[0]);
+    yOut[i] = r[3] * px + r[4] * py + (r[5] * pz + t[1]);
+    zOut[i] = r[6] * px + r[7] * py + (r[8] * pz + t[2]);
+  }
+}
+
+void TF_RigidTransform::orthonormalize() {
+  double* x = &r[0];
+  double* y = &r[3];
+  double* z = &r[6];
+  // normalize the first row, make the second one orthogonal to it, the third is their cross product
+  double n = std::sqrt(x[0] * x[0] + x[1] * x[1] + x[2] * x[2]);
+  for (int i = 0; i < 3; i++) x[i] /= n;
+  double d = x[0] * y[0] + x[1] * y[1] + x[2] * y[2];
+  for (int i = 0; i < 3; i++) y[i] -= d * x[i];
+  n = std::sqrt(y[0] * y[0] + y[1] * y[1] + y[2] * y[2]);
+  for (int i = 0; i < 3; i++) y[i] /= n;
+  z[0] = x[1] * y[2] - x[2] * y[1];
+  z[1] = x[2] * y[0] - x[0] * y[2];
+  z[2] = x[0] * y[1] - x[1] * y[0];
+}
+
+Matrix<3, 3, double> TF_RigidTransform::getRot() const {
+  Matrix<3, 3, double> rot;
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) rot(i, j) = r[3 * i + j];
+  }
+  return rot;
+}
+
+Vector3 TF_RigidTransform::getTrans() const {
+  return Vector3(t[0], t[1], t[2]);
+}
+
+TF_Matrix TF_RigidTransform::getTF() const {
+  TF_Matrix tf;
+  tf.setRot(getRot());
+  tf.setTrans(getTrans());
+  return tf;
+}
@@ -47,17 +47,19 @@ void TF_Tree::addTF(const std::string name, const std::string base,
                     const Matrix<4, 4, double> m) {
   std::vector<int> parents;
   int id = nodes.size();
+  int parent = -1;
   if (name != "global") {
-    for (uint32_t i = 0; i < nodes.size(); i++) {
-      if (nodes[i].getName() == name) throw TF_SameNameException(name);
-    }
+    if (ids.count(name) > 0) throw TF_SameNameException(name);
     TF_Node& node = getNode(base);
     parents = node.getParents();
     parents.push_back(node.getId());
     node.addChild(id);
+    parent = node.getId();
   }
   TF_Node node(name, base, id, parents, m);
   nodes.push_back(node);
+  states.push_back(NodeState{m, TF_RigidTransform::isRigid(m), ++revision, parent});
+  ids[name] = id;
 }
 
 void TF_Tree::addTF(const std::string name, const std::string base,
@@ -74,47 +76,90 @@ TF_Matrix& TF_Tree::getTF(const std::string name) {
   return node.getTF();
 }
 
+int TF_Tree::getId(const std::string& name) {
+  auto it = ids.find(name);
+  if (it == ids.end()) throw(TF_NotFoundException(name));
+  return it->second;
+}
+
 TF_Matrix TF_Tree::tfFrameToOrigin(const std::string frame, const std::string origin) {
-  int from = -1, to = -1;
-  for (int i = 0; i < (int)nodes.size(); i++) {
-    if (nodes[i].getName() == frame) from = i;
-    if (nodes[i].getName() == origin) to = i;
-    if (from >= 0 && to >= 0) break;
+  int from = getId(frame);
+  return tfFrameToOrigin(from, getId(origin));
+}
+
+TF_Matrix TF_Tree::tfFrameToOrigin(int from, int to) {
+  if (from < 0 || from >= (int)nodes.size()) throw(TF_NotFoundException(std::to_string(from)));
+  if (to < 0 || to >= (int)nodes.size()) throw(TF_NotFoundException(std::to_string(to)));
+  uint64_t key = (static_cast<uint64_t>(from) << 32) | static_cast<uint32_t>(to);
+  auto it = cache.find(key);
+  if (it != cache.end()) {
+    CachedTF& c = it->second;
+    bool changed = changedSince(to, c.sameParent, c.revision);
+    changed |= changedSince(from, c.sameParent, c.revision);
+    if (!changed) return c.tf;
   }
-  if (from == -1) throw(TF_NotFoundException(frame));
-  if (to == -1) throw(TF_NotFoundException(origin));
-  std::vector<int> fromList = nodes[from].getParents();
-  fromList.push_back(from);
-  std::vector<int> toList = nodes[to].getParents();
-  toList.push_back(to);
+  // node ids from the root down to "from" and "to", the node itself is the last one
+  const std::vector<int>& fromParents = nodes[from].getParents();
+  const std::vector<int>& toParents = nodes[to].getParents();
+  auto fromList = [&](std::size_t i) { return i < fromParents.size() ? fromParents[i] : from; };
+  auto toList = [&](std::size_t i) { return i < toParents.size() ? toParents[i] : to; };
   // search nearest parent
-  int sameParent, cnt = 0;
-  bool hasSameParent = true;
-  while (hasSameParent && cnt < (int)fromList.size() &&
-         cnt < (int)toList.size()) {
-    if (fromList[cnt] == toList[cnt]) {
-      sameParent = fromList[cnt];
-      cnt++;
-    } else {
-      hasSameParent = false;
-    }
+  int sameParent = 0;
+  std::size_t cnt = 0;
+  while (cnt <= fromParents.size() && cnt <= toParents.size() && fromList(cnt) == toList(cnt)) {
+    sameParent = fromList(cnt);
+    cnt++;
   }
+  changedSince(to, sameParent, revision);  // takes note of the matrices used below
+  changedSince(from, sameParent, revision);
+  bool rigid = true;
+  for (int n = to; rigid && n != sameParent; n = states[n].parent) rigid = states[n].rigid;
+  for (int n = from; rigid && n != sameParent; n = states[n].parent) rigid = states[n].rigid;
   TF_Matrix tf;
-  tf.eye();
-  // count backward from "to" to "sameParent"
-  cnt = toList.size() - 1;
-  while (toList[cnt] != sameParent) {
-    tf.setMatrix(nodes[toList[cnt]].getTF() * tf.getMatrix());
-    cnt--;
-  }
-  // count forward from "sameParent" to "from"
-  while (fromList[cnt] != from) {
-    cnt++;
-    tf.setMatrix(nodes[fromList[cnt]].getTF().inverse() * tf.getMatrix());
+  if (rigid) {  // compose in closed form
+    TF_RigidTransform r;
+    for (int n = to; n != sameParent; n = states[n].parent) {
+      r = TF_RigidTransform(nodes[n].getTF()) * r;
+    }
+    for (; cnt <= fromParents.size(); cnt++) {
+      r = TF_RigidTransform(nodes[fromList(cnt)].getTF()).inverse() * r;
+    }
+    tf = r.getTF();
+  } else {
+    tf.eye();
+    // count backward from "to" to "sameParent"
+    for (int n = to; n != sameParent; n = states[n].parent) {
+      tf.setMatrix(nodes[n].getTF() * tf.getMatrix());
+    }
+    // count forward from "sameParent" to "from"
+    for (; cnt <= fromParents.size(); cnt++) {
+      tf.setMatrix(nodes[fromList(cnt)].getTF().inverse() * tf.getMatrix());
+    }
   }
+  cache[key] = CachedTF{tf, sameParent, revision};
   return tf;
 }
 
+/*
+ * Compares the matrices from node up to, but without ancestor with the ones 
+ * used last and notes any changes. Returns true, if any of these matrices
+ * has changed after the given revision.
+ */
+bool TF_Tree::changedSince(int node, int ancestor, uint64_t rev) {
+  bool changed = false;
+  for (int n = node; n != ancestor; n = states[n].parent) {
+    NodeState& s = states[n];
+    const TF_Matrix& m = nodes[n].getTF();
+    if (!(m == s.used)) {
+      s.used = m;
+      s.rigid = TF_RigidTransform::isRigid(m);
+      s.changedAt = ++revision;
+    }
+    if (s.changedAt > rev) changed = true;
+  }
+  return changed;
+}
+
 void TF_Tree::print(std::string start, bool showTF) {
   static int printLevel = 0;
   if (printLevel == 0) {
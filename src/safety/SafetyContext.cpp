@@ -7,7 +7,7 @@ using namespace eeros::safety;
 SafetyContext::SafetyContext(SafetySystem* parent) : parent(parent) { }
 
 
-void SafetyContext::triggerEvent(SafetyEvent event) {	
+void SafetyContext::triggerEvent(const SafetyEvent& event) {	
 	// Trigger event in private context
 	parent->triggerEvent(event, this);
 }
@@ -1,18 +1,30 @@
 #include <eeros/safety/SafetyLevel.hpp>
 #include <eeros/safety/InputAction.hpp>
+#include <mutex>
 
 namespace eeros {
 namespace safety {
 
+namespace {
+  std::mutex eventMtx;
+  std::vector<std::string> eventDescriptions;  // indexed by event id
+}
+
 SafetyEvent::SafetyEvent(std::string description) : description(description) {
-  static int count = 0;
-  id = count++;
+  std::lock_guard<std::mutex> lock(eventMtx);
+  id = eventDescriptions.size();
+  eventDescriptions.push_back(description);
 }
 
 std::string SafetyEvent::getDescription() {
   return description;
 }
 
+std::string SafetyEvent::getDescription(uint32_t id) {
+  std::lock_guard<std::mutex> lock(eventMtx);
+  return id < eventDescriptions.size() ? eventDescriptions[id] : std::string();
+}
+
 SafetyLevel::SafetyLevel(std::string description) : description(description), log(logger::Logger::getLogger('S')) {
   // number the levels when adding them to the safety system
 }
@@ -53,17 +65,31 @@ uint32_t SafetyLevel::getNofActivations() {
   return nofActivations;
 }
 
-SafetyLevel* SafetyLevel::getDestLevelForEvent(SafetyEvent event, bool privateEventOk) {
-  auto it = transitions.find(event.id);
-  if(it != transitions.end()) {
-    if((it->second.second != kPrivateEvent) || privateEventOk) return it->second.first;
-    else log.error() << "triggering private event \'" << event << "\' from nonprivate context";
+SafetyLevel* SafetyLevel::getDestLevelForEvent(const SafetyEvent& event, bool privateEventOk) {
+  const Transition* t = nullptr;
+  uint32_t i = event.id - tableBase;  // wraps for ids below the table
+  if(i < table.size()) {
+    t = &table[i];
+  } else if(table.empty()) {  // not compiled
+    auto it = transitions.find(event.id);
+    if(it != transitions.end()) t = &it->second;
+  }
+  if(t != nullptr && t->first != nullptr) {
+    if((t->second != kPrivateEvent) || privateEventOk) return t->first;
+    else EEROS_HOTPATH_LOG(log.error() << "triggering private event \'" << event.description << "\' from nonprivate context");
   }
   return nullptr;
 }
 
 void SafetyLevel::addEvent(SafetyEvent event, SafetyLevel& nextLevel, EventType type) {
   transitions.insert(std::make_pair(event.id, std::make_pair(&nextLevel, type)));
+  table.clear();  // the map is the reference until compiled again
+}
+
+void SafetyLevel::compileTransitions(uint32_t firstEvent, uint32_t nofEvents) {
+  table.assign(nofEvents, Transition(nullptr, kPrivateEvent));
+  tableBase = firstEvent;
+  for(auto& t : transitions) table[t.first - firstEvent] = t.second;
 }
 
 void SafetyLevel::setLevelAction(std::function<void (SafetyContext*)> action) {
@@ -1,6 +1,8 @@
 #include <eeros/core/Fault.hpp>
 #include <eeros/safety/SafetyProperties.hpp>
 #include <eeros/safety/InputAction.hpp>
+#include <algorithm>
+#include <cstdint>
 #include <sstream>
 
 namespace eeros {
@@ -31,6 +33,13 @@ bool SafetyProperties::verify() {
           ++it;
       }
     }
+    l->outputBatches.clear();
+    for (auto& action : l->outputAction) {
+      auto batch = action->getOutput()->getBatch();
+      if (batch != nullptr && std::find(l->outputBatches.begin(), l->outputBatches.end(), batch) == l->outputBatches.end()) {
+        l->outputBatches.push_back(batch);
+      }
+    }
     if (!copy1.empty())
       throw Fault(
           "verification of safety properties failed, all critical outputs must "
@@ -41,13 +50,14 @@ bool SafetyProperties::verify() {
     // if the input action for every critical input is defined
     std::vector<hal::InputInterface*> copy2 = criticalInputs;
     for (auto& action : l->inputAction) {
-      auto input = action->getInput();
-      std::vector<hal::InputInterface*>::iterator it = copy2.begin();
-      while (it != copy2.end()) {
-        if (*it == input)
-          it = copy2.erase(it);
-        else
-          ++it;
+      for (auto input : action->getInputs()) {
+        std::vector<hal::InputInterface*>::iterator it = copy2.begin();
+        while (it != copy2.end()) {
+          if (*it == input)
+            it = copy2.erase(it);
+          else
+            ++it;
+        }
       }
     }
     if (!copy2.empty())
@@ -61,6 +71,17 @@ bool SafetyProperties::verify() {
   // Check entry level
   check = check && getEntryLevel() != nullptr;
 
+  // Compile the transitions of all levels into a level x event table
+  uint32_t firstEvent = UINT32_MAX, lastEvent = 0;
+  for (auto& l : levels) {
+    if (l->transitions.empty()) continue;
+    firstEvent = std::min(firstEvent, l->transitions.begin()->first);
+    lastEvent = std::max(lastEvent, l->transitions.rbegin()->first);
+  }
+  if (firstEvent <= lastEvent) {
+    for (auto& l : levels) l->compileTransitions(firstEvent, lastEvent - firstEvent + 1);
+  }
+
   return check;
 }
 
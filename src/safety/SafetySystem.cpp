@@ -3,8 +3,16 @@
 
 #include <array>
 #include <eeros/core/Fault.hpp>
+#include <eeros/core/System.hpp>
+#include <eeros/core/Tracepoint.hpp>
+#include <eeros/core/Wcet.hpp>
 #include <eeros/safety/SafetySystem.hpp>
 #include <eeros/safety/InputAction.hpp>
+#include <eeros/safety/OutputAction.hpp>
+#include <algorithm>
+#include <eeros/sequencer/Condition.hpp>
+#include <chrono>
+#include <cstdio>
 #include <exception>
 #include <typeinfo>
 
@@ -26,6 +34,7 @@ SafetySystem::SafetySystem(SafetyProperties& safetyProperties, double period)
     throw Fault("verification of safety properties failed!");
   }
   instance = this;
+  logThread = std::thread([this]() { logEvents(); });
   std::set_terminate([]() {
     try {
       try {
@@ -43,6 +52,7 @@ SafetySystem::SafetySystem(SafetyProperties& safetyProperties, double period)
       }
       if (instance) {
         printStackTrace();
+        if (!instance->auditFile.empty()) instance->dumpAudit(instance->auditFile);
         instance->log.error() << "Terminating";
         if (instance->properties.abortFunction)
           instance->properties.abortFunction();
@@ -56,7 +66,11 @@ SafetySystem::SafetySystem(SafetyProperties& safetyProperties, double period)
   });
 }
 
-SafetySystem::~SafetySystem() { instCount--; }
+SafetySystem::~SafetySystem() {
+  stopping.store(true, std::memory_order_relaxed);
+  if (logThread.joinable()) logThread.join();
+  instCount--;
+}
 
 SafetyLevel& SafetySystem::getCurrentLevel(void) {
   auto cLevel = currentLevel.load(std::memory_order_relaxed);
@@ -77,6 +91,15 @@ bool SafetySystem::setProperties(SafetyProperties& safetyProperties) {
     eLevel->nofActivations = 0;
     entryLevel.store(eLevel, std::memory_order_release);
     nextLevel.store(eLevel, std::memory_order_release);
+    compileCriticalActions();
+#ifdef EEROS_WCET
+    wcetProbes.assign(properties.levels.size(), LevelProbes{});
+    for (auto level : properties.levels) {
+      std::string name = level->getDescription();
+      wcetProbes[level->id] = {Wcet::probe("level", name + "/action"), Wcet::probe("level", name + "/onEntry"),
+                               Wcet::probe("level", name + "/onExit")};
+    }
+#endif
     log.warn() << "safety system verified: " << (int)properties.levels.size()
                << " safety levels are present";
     return true;
@@ -84,11 +107,86 @@ bool SafetySystem::setProperties(SafetyProperties& safetyProperties) {
   return false;
 }
 
-void SafetySystem::triggerEvent(SafetyEvent event, SafetyContext* context) {
+void SafetySystem::compileCriticalActions() {
+  auto isCriticalInput = [this](hal::InputInterface* in) {
+    return std::find(properties.criticalInputs.begin(), properties.criticalInputs.end(), in) != properties.criticalInputs.end();
+  };
+  auto isCriticalOutput = [this](hal::OutputInterface* out) {
+    return std::find(properties.criticalOutputs.begin(), properties.criticalOutputs.end(), out) != properties.criticalOutputs.end();
+  };
+  critical.assign(properties.levels.size(), CriticalActions());
+  for (auto l : properties.levels) {
+    CriticalActions& c = critical[l->id];
+    c.inputMask.assign(l->inputAction.size(), false);
+    for (std::size_t i = 0; i < l->inputAction.size(); i++) {
+      auto ia = l->inputAction[i];
+      if (ia == nullptr) continue;
+      auto inputs = ia->getInputs();
+      if (std::any_of(inputs.begin(), inputs.end(), isCriticalInput)) {
+        c.inputs.push_back(i);
+        c.inputMask[i] = true;
+      }
+    }
+    c.outputMask.assign(l->outputAction.size(), false);
+    for (std::size_t i = 0; i < l->outputAction.size(); i++) {
+      auto oa = l->outputAction[i];
+      if (oa == nullptr || !isCriticalOutput(oa->getOutput())) continue;
+      c.outputs.push_back(oa);
+      c.outputMask[i] = true;
+      auto batch = oa->getOutput()->getBatch();
+      if (batch != nullptr && std::find(c.outputBatches.begin(), c.outputBatches.end(), batch) == c.outputBatches.end()) {
+        c.outputBatches.push_back(batch);
+      }
+    }
+  }
+  criticalBatches.clear();
+  for (auto in : properties.criticalInputs) {
+    auto batch = in != nullptr ? in->getBatch() : nullptr;
+    if (batch != nullptr && std::find(criticalBatches.begin(), criticalBatches.end(), batch) == criticalBatches.end()) {
+      criticalBatches.push_back(batch);
+    }
+  }
+}
+
+void SafetySystem::setCriticalFastPath(bool enable) {
+  criticalFastPath.store(enable, std::memory_order_release);
+}
+
+bool SafetySystem::hasCriticalFastPath() const {
+  return criticalFastPath.load(std::memory_order_relaxed);
+}
+
+bool SafetySystem::checkCriticalInputs(bool readBatches) {
+  SafetyLevel* level = currentLevel.load(std::memory_order_acquire);
+  if (level == nullptr) return false;  // the first run has not entered the entry level yet
+  if (readBatches) {
+    for (auto batch : criticalBatches) batch->update();
+  }
+  bool triggered = false;
+  for (auto i : critical[level->id].inputs) {
+    if (level->inputAction[i]->check(&privateContext)) {
+      audit(AuditKind::inputAction, level->id, i);
+      triggered = true;
+    }
+  }
+  if (triggered) {
+    // the destination is already resolved by triggerEvent(), its critical outputs need not wait for run()
+    SafetyLevel* dest = nextLevel.load(std::memory_order_relaxed);
+    if (dest != nullptr && dest != level) {
+      CriticalActions& c = critical[dest->id];
+      for (auto oa : c.outputs) oa->set();
+      for (auto batch : c.outputBatches) batch->commit();
+    }
+  }
+  return triggered;
+}
+
+void SafetySystem::triggerEvent(const SafetyEvent& event, SafetyContext* context) {
   auto current = currentLevel.load(std::memory_order_acquire);
   if (current) {
     SafetyLevel* newLevel =
         current->getDestLevelForEvent(event, context == &privateContext);
+    audit(AuditKind::event, current->id, event.id, newLevel != nullptr ? newLevel->id : -1);
     if (newLevel != nullptr) {
       SafetyLevel* expected = nullptr;
       // using std::memory_order_relaxed should be ok even though we access
@@ -100,12 +198,9 @@ void SafetySystem::triggerEvent(SafetyEvent event, SafetyContext* context) {
         // lower
         if (expected->id < newLevel->id) return;
       }
-
-      log.info() << "triggering event \'" << event << "\' in level '" << current
-                 << "\': transition to safety level: '" << newLevel << "\'";
-    } else {
-      log.error() << "triggering event \'" << event << "\' in level '"
-                  << current << "\': no transition for this event";
+    }
+    if (!eventRecords.push({event.id, current, newLevel, System::getTimeNs()})) {
+      lostEventRecords.fetch_add(1, std::memory_order_relaxed);
     }
   } else {
     throw Fault("current level not defined");  // TODO define error number and
@@ -113,6 +208,58 @@ void SafetySystem::triggerEvent(SafetyEvent event, SafetyContext* context) {
   }
 }
 
+uint64_t SafetySystem::getLostEventRecords() const {
+  return lostEventRecords.load(std::memory_order_relaxed);
+}
+
+void SafetySystem::setLatenessEvent(SafetyEvent& event, double threshold, unsigned int count) {
+  if (count == 0) throw Fault("count of late cycles must be at least 1");
+  latenessThreshold = threshold;
+  latenessCount = count;
+  lateCycles = 0;
+  latenessEvent = &event;
+}
+
+PeriodicCounter::MonitorFunc SafetySystem::getTimingMonitor() {
+  return [this](PeriodicCounter& counter, logger::Logger&) { checkTiming(counter.period.last); };
+}
+
+bool SafetySystem::hasLatenessEvent() const {
+  return latenessEvent != nullptr;
+}
+
+void SafetySystem::checkTiming(double period) {
+  if (latenessEvent == nullptr) return;
+  if (period <= latenessThreshold) {
+    lateCycles = 0;
+  } else if (++lateCycles >= latenessCount) {
+    lateCycles = 0;
+    triggerEvent(*latenessEvent, &privateContext);
+  }
+}
+
+void SafetySystem::logEvents() {
+  while (!stopping.load(std::memory_order_relaxed)) {
+    writeEventRecords();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  writeEventRecords();
+}
+
+void SafetySystem::writeEventRecords() {
+  EventRecord r;
+  while (eventRecords.pop(r)) {
+    std::string event = SafetyEvent::getDescription(r.event);
+    if (r.to != nullptr) {
+      log.info() << "triggering event \'" << event << "\' in level '" << r.from
+                 << "\': transition to safety level: '" << r.to << "\' at " << r.timestamp << " ns";
+    } else {
+      log.error() << "triggering event \'" << event << "\' in level '"
+                  << r.from << "\': no transition for this event at " << r.timestamp << " ns";
+    }
+  }
+}
+
 const SafetyProperties* SafetySystem::getProperties() const {
   return &properties;
 }
@@ -131,51 +278,122 @@ void SafetySystem::run() {
 
   if (nLevel != nullptr && nLevel != level) {
     if (level && level->onExit) {
-      log.info() << "running " << level << "->onExit()";
+      EEROS_HOTPATH_LOG(log.info() << "running " << level << "->onExit()");
+      audit(AuditKind::exit, level->id);
+      EEROS_WCET_SCOPE(wcetProbes[level->id].onExit);
       level->onExit();
     }
+    audit(AuditKind::transition, level != nullptr ? level->id : -1, nLevel->id);
+    EEROS_TRACE2(safety_transition, level != nullptr ? level->id : -1, nLevel->id);
     currentLevel.store(nLevel, std::memory_order_acq_rel);
     level = nLevel;
     if (nLevel->onEntry) {
-      log.info() << "running " << nLevel << "->onEntry()";
+      EEROS_HOTPATH_LOG(log.info() << "running " << nLevel << "->onEntry()");
+      audit(AuditKind::entry, nLevel->id);
+      EEROS_WCET_SCOPE(wcetProbes[nLevel->id].onEntry);
       nLevel->onEntry(&privateContext);
     }
+    sequencer::Condition::notify();  // sequences waiting for this level check at once
   }
 
   if (level != nullptr) {
     level->nofActivations++;
+    bool fastPath = criticalFastPath.load(std::memory_order_acquire);
+    CriticalActions& c = critical[level->id];
 
-    // 3) Read inputs
-    for (auto ia : level->inputAction) {
-      if (ia != nullptr) {
+    // 3) Read inputs, the critical ones are checked by checkCriticalInputs() on the fast path
+    for (std::size_t i = 0; i < level->inputAction.size(); i++) {
+      auto ia = level->inputAction[i];
+      if (ia != nullptr && !(fastPath && c.inputMask[i])) {
         if (ia->check(&privateContext)) {
+          audit(AuditKind::inputAction, level->id, i);
           using namespace logger;
           hal::InputInterface* input = (hal::InputInterface*)(ia->getInput());
-          log.info() << "input action triggered: " << input->getId();
+          EEROS_HOTPATH_LOG(log.info() << "input action triggered: " << input->getId());
         }
       }
     }
 
     // 4) Execute level action
     if (level->action != nullptr) {
+      EEROS_WCET_SCOPE(wcetProbes[level->id].action);
       level->action(&privateContext);
     }
 
-    // 5) Set outputs
-    for (auto oa : level->outputAction) {
-      if (oa != nullptr) {
+    // 5) Set outputs, a pending transition of the fast path keeps the critical outputs of its destination
+    bool pending = fastPath && nextLevel.load(std::memory_order_relaxed) != nullptr;
+    for (std::size_t i = 0; i < level->outputAction.size(); i++) {
+      auto oa = level->outputAction[i];
+      if (oa != nullptr && !(pending && c.outputMask[i])) {
         oa->set();
       }
     }
+    for (auto batch : level->outputBatches) batch->commit();
 
   } else {
-    log.error() << "current level is null!";
+    EEROS_HOTPATH_LOG(log.error() << "current level is null!");
   }
 }
 
 void SafetySystem::exitHandler() {
   SafetySystem* ss = SafetySystem::instance;
-  if (ss) ss->properties.exitFunction(&ss->privateContext);
+  if (ss) {
+    if (!ss->auditFile.empty()) ss->dumpAudit(ss->auditFile);
+    ss->properties.exitFunction(&ss->privateContext);
+  }
+}
+
+void SafetySystem::setAuditFile(std::string path) {
+  auditFile = path;
+}
+
+void SafetySystem::audit(AuditKind kind, int32_t level, int32_t arg, int32_t dest) noexcept {
+  uint64_t i = auditHead.fetch_add(1, std::memory_order_relaxed);
+  AuditRecord& r = auditRing[i % auditSize];
+  r.sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  r.timestamp.store(System::getTimeNs(), std::memory_order_relaxed);
+  r.kind.store(static_cast<uint32_t>(kind), std::memory_order_relaxed);
+  r.level.store(level, std::memory_order_relaxed);
+  r.arg.store(arg, std::memory_order_relaxed);
+  r.dest.store(dest, std::memory_order_relaxed);
+  r.sequence.store(i + 1, std::memory_order_release);
+}
+
+bool SafetySystem::dumpAudit(const std::string& path) {
+  FILE* f = std::fopen(path.c_str(), "w");
+  if (f == nullptr) return false;
+  auto name = [this](int32_t id) -> const char* {
+    if (id < 0 || id >= (int32_t)properties.levels.size()) return "-";
+    return properties.levels[id]->description.c_str();
+  };
+  uint64_t head = auditHead.load(std::memory_order_acquire);
+  for (uint64_t i = head > auditSize ? head - auditSize : 0; i < head; i++) {
+    AuditRecord& r = auditRing[i % auditSize];
+    if (r.sequence.load(std::memory_order_acquire) != i + 1) continue;  // overwritten or being written
+    unsigned long long t = r.timestamp.load(std::memory_order_relaxed);
+    int32_t level = r.level.load(std::memory_order_relaxed);
+    int32_t arg = r.arg.load(std::memory_order_relaxed);
+    switch (static_cast<AuditKind>(r.kind.load(std::memory_order_relaxed))) {
+      case AuditKind::event:
+        std::fprintf(f, "%llu event '%s' in level '%s' -> '%s'\n", t, SafetyEvent::getDescription(arg).c_str(),
+                     name(level), name(r.dest.load(std::memory_order_relaxed)));
+        break;
+      case AuditKind::transition:
+        std::fprintf(f, "%llu transition '%s' -> '%s'\n", t, name(level), name(arg));
+        break;
+      case AuditKind::inputAction:
+        std::fprintf(f, "%llu input action %d in level '%s'\n", t, arg, name(level));
+        break;
+      case AuditKind::entry:
+        std::fprintf(f, "%llu onEntry '%s'\n", t, name(level));
+        break;
+      case AuditKind::exit:
+        std::fprintf(f, "%llu onExit '%s'\n", t, name(level));
+        break;
+    }
+  }
+  return std::fclose(f) == 0;
 }
 
 void SafetySystem::printStackTrace() {
@@ -1,7 +1,8 @@
 #include <eeros/sequencer/BaseSequence.hpp>
 #include <eeros/sequencer/Sequencer.hpp>
+#include <eeros/sequencer/SequencePool.hpp>
 #include <eeros/core/Fault.hpp>
-#include <unistd.h>
+#include <eeros/core/FutexEvent.hpp>
 
 namespace eeros {
 namespace sequencer {
@@ -24,12 +25,26 @@ int BaseSequence::action() {
   int retVal = -1;
   state = SequenceState::idle;
   auto& seq = Sequencer::instance();
+  auto& event = Condition::getEvent();
   if (seq.stepping) {
     log.warn() << "wait for next step command";
-    while (Sequencer::running && !seq.nextStep);
+    for (;;) {
+      uint32_t generation = event.prepare();
+      if (!Sequencer::running || seq.nextStep) break;
+      SequencePool::wait(generation, getWaitTime());
+    }
     seq.nextStep = false;
   }
-  std::lock_guard<std::mutex> lock(mtx);
+  // a second run of the same sequence waits until the first one has finished
+  for (;;) {
+    uint32_t generation = event.prepare();
+    if (!active.exchange(true, std::memory_order_acquire)) break;
+    SequencePool::wait(generation, getWaitTime());
+  }
+  struct Release {
+    std::atomic<bool>& active;
+    ~Release() {active.store(false, std::memory_order_release); Condition::notify();}
+  } release{active};
   while (state != SequenceState::terminated) {
     switch (state) {
       case SequenceState::idle: { // upon creation
@@ -49,10 +64,13 @@ int BaseSequence::action() {
         break;
       }
       case SequenceState::running: { // active and running, eigentlich checking
+        // taken before checking, so a notification while checking is not lost
+        uint32_t generation = event.prepare();
         checkMonitors();    // check monitors of this sequence and all callers, execute exception if necessary
         if (state == SequenceState::restarting) continue; // stop any further actions when restarting
         if (checkExitCondition()) state = SequenceState::terminated;
-        if (state == SequenceState::running) usleep(pollingTime * 1000);  // wait only in case of normal execution
+        // wait only in case of normal execution, until notified or for the polling time
+        if (state == SequenceState::running) SequencePool::wait(generation, getWaitTime());
         break;
       }
       case SequenceState::paused: { // not used
@@ -163,6 +181,8 @@ void BaseSequence::setName(std::string name) {this->name = name;}
 
 std::string BaseSequence::getName() const {return name;}
 
+SequenceState BaseSequence::getState() const {return state;}
+
 void BaseSequence::setId(int id) {this->id = id;}
 
 int BaseSequence::getId() const {return id;}
@@ -171,6 +191,15 @@ void BaseSequence::setPollingTime(int timeInMilliseconds) {
   pollingTime = timeInMilliseconds;
 }
 
+int BaseSequence::getPollingTime() const {
+  return pollingTime;
+}
+
+double BaseSequence::getWaitTime() const {
+  // without polling the sequence still wakes up once an hour
+  return pollingTime > 0 ? pollingTime / 1000.0 : 3600.0;
+}
+
 void BaseSequence::setTimeoutTime(double timeoutInSec) {
   conditionTimeout.setTimeoutTime(timeoutInSec);
 }
@@ -195,6 +224,12 @@ void BaseSequence::abort() {
   conditionAbort.set();
 }
 
+SequenceStateCell& SequenceStateCell::operator=(SequenceState s) {
+  value.store(s, std::memory_order_release);
+  Sequencer::stateChanges.fetch_add(1, std::memory_order_release);
+  return *this;
+}
+
 std::ostream& operator<<(std::ostream& os, const SequenceState& state) {
   switch (state) {
     case SequenceState::idle: os << "idle"; break;
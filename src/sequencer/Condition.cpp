@@ -0,0 +1,17 @@
+#include <eeros/sequencer/Condition.hpp>
+#include <eeros/core/FutexEvent.hpp>
+
+namespace eeros {
+namespace sequencer {
+
+void Condition::notify() {
+  getEvent().notify();
+}
+
+FutexEvent& Condition::getEvent() {
+  static FutexEvent* event = new FutexEvent();  // never destroyed, the sequencer may still notify at exit
+  return *event;
+}
+
+} // namespace sequencer
+} // namespace eeros
@@ -0,0 +1,59 @@
+#include <eeros/sequencer/ConditionScheduler.hpp>
+#include <eeros/core/Fault.hpp>
+#include <algorithm>
+
+namespace eeros {
+namespace sequencer {
+
+ConditionScheduler::ConditionScheduler() : nofValidations(0) { }
+
+ConditionScheduler::~ConditionScheduler() {
+  std::lock_guard<std::mutex> lock(mtx);
+  for (Condition* c : conditions) c->scheduler.store(nullptr, std::memory_order_release);
+}
+
+void ConditionScheduler::add(Condition& condition) {
+  std::lock_guard<std::mutex> lock(mtx);
+  ConditionScheduler* s = condition.scheduler.load(std::memory_order_acquire);
+  if (s == this) return;
+  if (s != nullptr) throw Fault("condition is already added to another scheduler");
+  condition.result.store(condition.validate(), std::memory_order_release);
+  nofValidations.fetch_add(1, std::memory_order_relaxed);
+  condition.scheduler.store(this, std::memory_order_release);
+  conditions.push_back(&condition);
+}
+
+void ConditionScheduler::remove(Condition& condition) {
+  std::lock_guard<std::mutex> lock(mtx);
+  auto it = std::find(conditions.begin(), conditions.end(), &condition);
+  if (it == conditions.end()) return;
+  conditions.erase(it);
+  condition.scheduler.store(nullptr, std::memory_order_release);
+}
+
+void ConditionScheduler::run() {
+  std::unique_lock<std::mutex> lock(mtx, std::try_to_lock);
+  if (!lock.owns_lock()) return;
+  bool changed = false;
+  for (Condition* c : conditions) {
+    bool value = c->validate();
+    if (value != c->result.load(std::memory_order_relaxed)) {
+      c->result.store(value, std::memory_order_release);
+      changed = true;
+    }
+  }
+  nofValidations.fetch_add(conditions.size(), std::memory_order_relaxed);
+  if (changed) Condition::notify();
+}
+
+std::size_t ConditionScheduler::size() {
+  std::lock_guard<std::mutex> lock(mtx);
+  return conditions.size();
+}
+
+uint64_t ConditionScheduler::getNofValidations() const {
+  return nofValidations.load(std::memory_order_relaxed);
+}
+
+} // namespace sequencer
+} // namespace eeros
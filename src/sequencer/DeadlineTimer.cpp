@@ -0,0 +1,66 @@
+#include <eeros/sequencer/DeadlineTimer.hpp>
+#include <eeros/sequencer/Condition.hpp>
+#include <thread>
+
+namespace eeros {
+namespace sequencer {
+
+DeadlineTimer::DeadlineTimer() { }
+
+DeadlineTimer& DeadlineTimer::instance() {
+  // never destroyed, the detached thread may still wait on it at exit
+  static DeadlineTimer* timer = new DeadlineTimer();
+  return *timer;
+}
+
+void DeadlineTimer::schedule(Clock::time_point deadline) {
+  std::lock_guard<std::mutex> lock(mtx);
+  if (!started) {
+    started = true;
+    std::thread(&DeadlineTimer::run, this).detach();
+  }
+  bool earliest = deadlines.empty() || deadline < *deadlines.begin();
+  deadlines.insert(deadline);
+  if (earliest) cv.notify_one();
+}
+
+DeadlineTimer::Clock::time_point DeadlineTimer::schedule(double delay) {
+  auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(delay));
+  schedule(deadline);
+  return deadline;
+}
+
+std::size_t DeadlineTimer::size() {
+  std::lock_guard<std::mutex> lock(mtx);
+  return deadlines.size();
+}
+
+uint64_t DeadlineTimer::getNofNotifications() {
+  std::lock_guard<std::mutex> lock(mtx);
+  return nofNotifications;
+}
+
+void DeadlineTimer::run() {
+  std::unique_lock<std::mutex> lock(mtx);
+  for (;;) {
+    if (deadlines.empty()) {
+      cv.wait(lock);
+      continue;
+    }
+    auto next = *deadlines.begin();
+    if (Clock::now() < next) {
+      cv.wait_until(lock, next);  // woken early by an earlier deadline
+      continue;
+    }
+    // all passed deadlines are served by one notification
+    auto now = Clock::now();
+    while (!deadlines.empty() && *deadlines.begin() <= now) deadlines.erase(deadlines.begin());
+    nofNotifications++;
+    lock.unlock();
+    Condition::notify();
+    lock.lock();
+  }
+}
+
+} // namespace sequencer
+} // namespace eeros
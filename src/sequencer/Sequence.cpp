@@ -1,5 +1,6 @@
 #include <eeros/sequencer/Sequence.hpp>
 #include <eeros/sequencer/Sequencer.hpp>
+#include <eeros/sequencer/SequencePool.hpp>
 #include <eeros/core/Fault.hpp>
 #include <unistd.h>
 #include <sys/syscall.h>
@@ -13,15 +14,9 @@ Sequence::Sequence(std::string name, Sequencer& seq) : Sequence(name, seq, nullp
 Sequence::Sequence(std::string name, BaseSequence* caller, bool blocking) : Sequence(name, caller ? caller->seq : Sequencer::instance(), caller, blocking) { }
 
 Sequence::Sequence(std::string name, Sequencer& seq, BaseSequence* caller, bool blocking) : BaseSequence(seq, caller, blocking) {
-  if (name.empty()) {
-    throw Fault("all sequences must have a name");
-  } else {
-    for (Sequence *s : seq.getListOfAllSequences()) {
-      if (name == s->getName()) throw Fault("all sequences must have different names"); 
-    }
-    this->name = name;
-  }
-  seq.addSequence(*this);	// register in sequencer
+  if (name.empty()) throw Fault("all sequences must have a name");
+  this->name = name;
+  seq.addSequence(*this);	// register in sequencer, throws if the name is already used
   log.trace() << "sequence '" << name << "' created";
 }
 
@@ -49,6 +44,8 @@ int Sequence::start() {
     log.info() << "create sequence '" << name << "' (blocking), caller sequence: '" << ((caller != nullptr)?caller->getName():"no caller") << "'";
     retVal = BaseSequence::action();
     log.info() << "sequence '" << name << "' terminated";
+  } else if (seq.pool) {
+    fut = seq.pool->start(*this);
   } else {
     fut = std::async(std::launch::async, &Sequence::run, this);
   }
@@ -64,7 +61,9 @@ bool Sequence::done() {
 }
 
 void Sequence::wait() {
-  if (fut.valid()) retVal = fut.get();
+  if (!fut.valid()) return;
+  SequencePool::await(fut);  // only blocks the calling task, if it runs on the thread pool
+  retVal = fut.get();
 }
 
 } // namespace sequencer
@@ -0,0 +1,173 @@
+#include <eeros/sequencer/SequencePool.hpp>
+#include <eeros/sequencer/Sequence.hpp>
+#include <eeros/sequencer/Condition.hpp>
+#include <eeros/core/FutexEvent.hpp>
+#include <eeros/core/Fault.hpp>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+namespace eeros {
+namespace sequencer {
+
+using SteadyClock = std::chrono::steady_clock;
+
+struct SequencePool::Task {
+  Sequence* sequence;
+  SequencePool* pool;
+  std::promise<int> result;
+  ucontext_t context;
+  char* stack = nullptr;
+  std::size_t mappedSize = 0;
+  uint32_t generation = 0;
+  SteadyClock::time_point deadline = SteadyClock::time_point::min();  // ready to run at once
+  bool finished = false;
+  ~Task() {if (stack != nullptr) ::munmap(stack, mappedSize);}
+};
+
+struct SequencePool::Worker {
+  std::thread thread;
+  std::mutex mtx;
+  std::vector<Task*> incoming;               // started by other threads, guarded by mtx
+  std::vector<std::unique_ptr<Task>> tasks;  // owned by the worker thread
+  ucontext_t context;
+};
+
+thread_local SequencePool::Task* SequencePool::current = nullptr;
+
+namespace {
+  constexpr auto idlePeriod = std::chrono::milliseconds(100);
+}
+
+SequencePool::SequencePool(int nofThreads, std::size_t stackSize) 
+    : stackSize(stackSize), nextWorker(0), nofTasks(0), running(true) {
+  if (nofThreads < 1) throw Fault("sequence pool needs at least one thread");
+  for (int i = 0; i < nofThreads; i++) workers.push_back(std::make_unique<Worker>());
+  for (auto& w : workers) {
+    Worker* worker = w.get();
+    worker->thread = std::thread([this, worker]() { run(*worker); });
+  }
+}
+
+SequencePool::~SequencePool() {
+  running = false;
+  Condition::notify();
+  for (auto& w : workers) w->thread.join();
+  for (auto& w : workers) {
+    for (Task* t : w->incoming) delete t;
+  }
+}
+
+std::future<int> SequencePool::start(Sequence& sequence) {
+  std::size_t page = ::sysconf(_SC_PAGESIZE);
+  auto task = std::make_unique<Task>();
+  task->sequence = &sequence;
+  task->pool = this;
+  task->mappedSize = (stackSize + page - 1) / page * page + page;
+  void* p = ::mmap(nullptr, task->mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_STACK, -1, 0);
+  if (p == MAP_FAILED) throw Fault("could not allocate stack for sequence '" + sequence.getName() + "'");
+  task->stack = static_cast<char*>(p);
+  ::mprotect(task->stack, page, PROT_NONE);  // guard page, a stack overflow faults instead of corrupting memory
+  
+  Worker& worker = *workers[nextWorker++ % workers.size()];
+  getcontext(&task->context);
+  task->context.uc_stack.ss_sp = task->stack + page;
+  task->context.uc_stack.ss_size = task->mappedSize - page;
+  task->context.uc_link = &worker.context;  // return to the worker when the sequence has finished
+  makecontext(&task->context, &SequencePool::entry, 0);
+  
+  auto result = task->result.get_future();
+  nofTasks++;
+  {
+    std::lock_guard<std::mutex> lock(worker.mtx);
+    worker.incoming.push_back(task.release());
+  }
+  Condition::notify();
+  return result;
+}
+
+int SequencePool::getNofTasks() const {
+  return nofTasks;
+}
+
+bool SequencePool::inTask() {
+  return current != nullptr;
+}
+
+void SequencePool::wait(uint32_t generation, double timeout_sec) {
+  Task* t = current;
+  if (t == nullptr) {
+    Condition::getEvent().wait(generation, timeout_sec);
+    return;
+  }
+  t->generation = generation;
+  t->deadline = SteadyClock::now() + std::chrono::duration_cast<SteadyClock::duration>(std::chrono::duration<double>(timeout_sec));
+  ucontext_t* worker = t->context.uc_link;
+  swapcontext(&t->context, worker);
+}
+
+void SequencePool::await(std::future<int>& result) {
+  if (!inTask()) {
+    result.wait();
+    return;
+  }
+  auto& event = Condition::getEvent();
+  for (;;) {
+    uint32_t generation = event.prepare();  // a finishing task notifies
+    if (result.wait_for(std::chrono::seconds(0)) == std::future_status::ready) return;
+    wait(generation, 0.1);
+  }
+}
+
+void SequencePool::entry() {
+  Task* t = current;
+  int retVal = 0;
+  std::exception_ptr exception;
+  try {
+    retVal = t->sequence->run();
+  } catch (...) {
+    exception = std::current_exception();
+  }
+  t->finished = true;
+  t->pool->nofTasks--;  // before the result is ready, so the pool may be changed after waiting for it
+  if (exception) t->result.set_exception(exception);
+  else t->result.set_value(retVal);
+  Condition::notify();  // wakes sequences waiting for this one
+}
+
+void SequencePool::run(Worker& worker) {
+  auto& event = Condition::getEvent();
+  while (running) {
+    uint32_t generation = event.prepare();
+    {
+      std::lock_guard<std::mutex> lock(worker.mtx);
+      for (Task* t : worker.incoming) worker.tasks.emplace_back(t);
+      worker.incoming.clear();
+    }
+    auto now = SteadyClock::now();
+    auto next = now + idlePeriod;
+    bool resumed = false;
+    for (auto it = worker.tasks.begin(); it != worker.tasks.end(); ) {
+      Task* t = it->get();
+      if (t->generation != generation || t->deadline <= now) {
+        current = t;
+        swapcontext(&worker.context, &t->context);
+        current = nullptr;
+        resumed = true;
+        if (t->finished) {
+          it = worker.tasks.erase(it);
+          continue;
+        }
+      }
+      if (t->deadline < next) next = t->deadline;
+      ++it;
+    }
+    if (!resumed) event.wait(generation, std::chrono::duration<double>(next - now).count());
+  }
+}
+
+} // namespace sequencer
+} // namespace eeros
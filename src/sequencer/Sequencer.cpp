@@ -1,50 +1,53 @@
 #include <eeros/sequencer/Sequencer.hpp>
 #include <eeros/sequencer/Sequence.hpp>
 #include <eeros/sequencer/SequencerUI.hpp>
+#include <eeros/sequencer/SequencePool.hpp>
 #include <eeros/core/Fault.hpp>
 
 namespace eeros {
 namespace sequencer {
   
 std::atomic<bool> Sequencer::running(true);
+std::atomic<uint64_t> Sequencer::stateChanges(0);
 int Sequencer::sequenceCount = 0;
 
 Sequencer::Sequencer() : log(logger::Logger::getLogger('R')), stepping(false), nextStep(false) {
   running = true;
 }
 
+Sequencer::~Sequencer() { }
+
 Sequencer& Sequencer::instance() {
   static Sequencer seq;
   return seq;
 }
 
 void Sequencer::addSequence(Sequence& seq) {
+  if (!sequenceNames.emplace(seq.getName(), &seq).second) throw Fault("all sequences must have different names");
   seq.setId(sequenceCount++);
   sequenceList.push_back(&seq);
 }
 
 Sequence* Sequencer::getSequenceById(int id) {
-  for (Sequence *seq : getListOfAllSequences()) {
-    if (id == seq->getId()) return seq;
-  }
+  if (id >= 0 && id < static_cast<int>(sequenceList.size())) return sequenceList[id];
   log.error() << "No sequence with id '" << id << "' found.";
   return nullptr;
 }
 
-Sequence* Sequencer::getSequenceByName(std::string name) {
-  for (Sequence *seq : getListOfAllSequences()) {
-    if ( name == seq->getName() ) return seq;
-  }
+Sequence* Sequencer::getSequenceByName(const std::string& name) {
+  auto it = sequenceNames.find(name);
+  if (it != sequenceNames.end()) return it->second;
   log.error() << "No sequence with name '" << name << "' found.";
   return nullptr;
 }
 
-std::vector<Sequence*> Sequencer::getListOfAllSequences() {
+const std::vector<Sequence*>& Sequencer::getListOfAllSequences() const {
   return sequenceList;
 }
 
 void Sequencer::clearList() {
   sequenceList.clear();
+  sequenceNames.clear();
   sequenceCount = 0;
 }
 
@@ -52,17 +55,25 @@ void Sequencer::singleStepping() {
   stepping = true;
 }
 
+void Sequencer::useThreadPool(int nofThreads, std::size_t stackSize) {
+  if (pool && pool->getNofTasks() > 0) throw Fault("thread pool can not be changed while sequences are running");
+  pool.reset();
+  if (nofThreads > 0) pool = std::make_unique<SequencePool>(nofThreads, stackSize);
+}
+
 void Sequencer::step() {
   nextStep = true;
+  Condition::notify();
 }
 
 void Sequencer::restart() {
   stepping = false;
   nextStep = true;
+  Condition::notify();
 }
 
 void Sequencer::wait() {
-  std::vector<Sequence*> list = getListOfAllSequences();
+  std::vector<Sequence*> list = getListOfAllSequences();  // copy, as waiting sequences may create new ones
   for (Sequence* s : list) {
     s->wait();
   }
@@ -75,6 +86,7 @@ void Sequencer::abort() {
     s->conditionAbort.set();
   }
   running = false;
+  Condition::notify();
 }
 
 } // namespace sequencer
@@ -0,0 +1,175 @@
+#include <eeros/sockets/ClientConnection.hpp>
+#include <eeros/core/Fault.hpp>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace eeros;
+using namespace eeros::sockets;
+
+namespace {
+  int toMs(std::chrono::steady_clock::duration d) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(d).count();
+  }
+}
+
+ClientConnection::ClientConnection(std::string serverIP, uint16_t port, std::size_t rxFrameSize, double period, double timeout,
+                                   const SocketOptions& options)
+    : serverIP(serverIP),
+      port(port),
+      rxFrameSize(rxFrameSize),
+      timeout(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(timeout))),
+      options(options),
+      rx(rxFrameSize),
+      log(logger::Logger::getLogger()) {
+  epollFd = epoll_create1(EPOLL_CLOEXEC);
+  timerFd = createPeriodicTimer(period);
+  wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  epoll_event ev{};
+  ev.events = EPOLLIN;
+  ev.data.fd = timerFd;
+  epoll_ctl(epollFd, EPOLL_CTL_ADD, timerFd, &ev);
+  ev.data.fd = wakeFd;
+  epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &ev);
+}
+
+ClientConnection::~ClientConnection() {
+  close();
+  ::close(wakeFd);
+  ::close(timerFd);
+  ::close(epollFd);
+}
+
+bool ClientConnection::connect() {
+  close();
+  addrinfo hints{}, *res;
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  if (getaddrinfo(serverIP.c_str(), nullptr, &hints, &res) != 0) throw Fault("Server ip not found");
+  sockaddr_in servAddr = *reinterpret_cast<sockaddr_in*>(res->ai_addr);
+  servAddr.sin_port = htons(port);
+  freeaddrinfo(res);
+
+  fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) throw Fault("ERROR opening socket");
+  if (::connect(fd, reinterpret_cast<sockaddr*>(&servAddr), sizeof(servAddr)) < 0) {
+    int err = errno;
+    if (err == EINPROGRESS) {
+      pollfd p{fd, POLLOUT, 0};
+      socklen_t len = sizeof(err);
+      if (::poll(&p, 1, toMs(timeout)) != 1 || getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len) != 0) err = ETIMEDOUT;
+    }
+    if (err != 0 && err != EINPROGRESS) {
+      close();
+      return false;
+    }
+  }
+  if (!applySocketOptions(fd, options, true)) log.warn() << "could not set socket options";
+  epoll_event ev{};
+  ev.events = EPOLLIN;
+  ev.data.fd = fd;
+  epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+  rx.reset();
+  lastFrame = std::chrono::steady_clock::now();
+  return true;
+}
+
+PollResult ClientConnection::poll(const std::function<void(const uint8_t*)>& onFrame) {
+  epoll_event events[3];
+  int n = epoll_wait(epollFd, events, 3, -1);
+  PollResult result;
+  for (int i = 0; i < n; i++) {
+    uint64_t value;
+    int efd = events[i].data.fd;
+    if (efd == timerFd) {
+      if (::read(timerFd, &value, sizeof(value)) > 0) result.tick = true;
+    } else if (efd == wakeFd) {
+      if (::read(wakeFd, &value, sizeof(value)) > 0) result.wakeup = true;
+    } else if (efd == fd) {
+      receive(onFrame);
+    }
+  }
+  if (result.tick && fd >= 0 && rxFrameSize > 0 && std::chrono::steady_clock::now() - lastFrame > timeout) {
+    log.trace() << "error = socket read timed out";
+    close();
+  }
+  return result;
+}
+
+void ClientConnection::receive(const std::function<void(const uint8_t*)>& onFrame) {
+  while (fd >= 0) {
+    ssize_t n;
+    std::size_t length = sizeof(discard);
+    if (rxFrameSize == 0) n = ::recv(fd, discard, length, 0);
+    else n = ::recv(fd, rx.next(length), length, 0);
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+      if (n < 0) log.trace() << "error = " << std::strerror(errno);
+      close();
+      return;
+    }
+    if (n < 0) return;
+    if (rxFrameSize > 0) {
+      rx.received(n);
+      FrameAssembler::State state;
+      while ((state = rx.pop()) == FrameAssembler::State::complete) {
+        lastFrame = std::chrono::steady_clock::now();
+        onFrame(rx.frame());
+      }
+      if (state == FrameAssembler::State::invalid) {
+        log.warn() << "invalid frame header, connection closed";
+        close();
+        return;
+      }
+    }
+    if (static_cast<std::size_t>(n) < length) return;   // all queued data was read
+  }
+}
+
+bool ClientConnection::send(const void* data, std::size_t length) {
+  auto bytes = static_cast<const uint8_t*>(data);
+  auto end = std::chrono::steady_clock::now() + timeout;
+  while (fd >= 0 && length > 0) {
+    ssize_t n = ::send(fd, bytes, length, MSG_NOSIGNAL | MSG_DONTWAIT);
+    if (n > 0) {
+      bytes += n;
+      length -= n;
+      continue;
+    }
+    auto left = end - std::chrono::steady_clock::now();
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) && left.count() > 0) {
+      pollfd p{fd, POLLOUT, 0};
+      ::poll(&p, 1, toMs(left) + 1);
+      continue;
+    }
+    log.trace() << "error = " << (n < 0 ? std::strerror(errno) : "socket write timed out");
+    close();
+  }
+  return fd >= 0;
+}
+
+void ClientConnection::wake() {
+  uint64_t one = 1;
+  if (::write(wakeFd, &one, sizeof(one)) < 0) { /* the counter is already set */ }
+}
+
+void ClientConnection::setFraming(const FrameAssembler& framing) {
+  rx = framing;
+}
+
+bool ClientConnection::isConnected() const {
+  return fd >= 0;
+}
+
+void ClientConnection::close() {
+  if (fd < 0) return;
+  epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+  ::close(fd);
+  fd = -1;
+}
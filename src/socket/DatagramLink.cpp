@@ -0,0 +1,245 @@
+#include <eeros/sockets/DatagramLink.hpp>
+#include <eeros/core/Fault.hpp>
+#include <eeros/core/System.hpp>
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netdb.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace eeros;
+using namespace eeros::sockets;
+
+namespace {
+  // a sequence number this far behind the newest one means that the peer restarted
+  constexpr int32_t restartDistance = 1000;
+}
+
+DatagramLink::DatagramLink(std::string peer, uint16_t port, std::size_t rxPayloadSize, double period, double timeout,
+                           const SocketOptions& options, bool multicast)
+    : server(peer.empty()),
+      multicast(multicast),
+      receiving(!multicast || rxPayloadSize > 0),
+      rxPayloadSize(rxPayloadSize),
+      timeout(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(timeout))),
+      rx(batchSize * (sizeof(Header) + rxPayloadSize + 1)),
+      newest(rxPayloadSize),
+      log(logger::Logger::getLogger()) {
+  fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) throw Fault("ERROR opening socket");
+  if (!applySocketOptions(fd, options, false)) log.warn() << "could not set socket options";
+  if (multicast && server) {
+    ::close(fd);
+    throw Fault("multicast needs the address of a group");
+  }
+  if (server) {
+    int yes = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+      ::close(fd);
+      throw Fault("ERROR on socket binding");
+    }
+  } else {
+    addrinfo hints{}, *res;
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    if (getaddrinfo(peer.c_str(), nullptr, &hints, &res) != 0) {
+      ::close(fd);
+      throw Fault("Server ip not found");
+    }
+    peerAddr = *reinterpret_cast<sockaddr_in*>(res->ai_addr);
+    peerAddr.sin_port = htons(port);
+    freeaddrinfo(res);
+    peerKnown = true;
+  }
+  if (multicast) joinGroup(port, options);
+
+  epollFd = epoll_create1(EPOLL_CLOEXEC);
+  timerFd = createPeriodicTimer(period);
+  wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  epoll_event ev{};
+  ev.events = EPOLLIN;
+  ev.data.fd = fd;
+  epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+  ev.data.fd = timerFd;
+  epoll_ctl(epollFd, EPOLL_CTL_ADD, timerFd, &ev);
+  ev.data.fd = wakeFd;
+  epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &ev);
+  lastReceived = std::chrono::steady_clock::now();
+  published.write(stats);
+}
+
+DatagramLink::~DatagramLink() {
+  ::close(wakeFd);
+  ::close(timerFd);
+  ::close(epollFd);
+  ::close(fd);
+}
+
+PollResult DatagramLink::poll(const std::function<void(const uint8_t*)>& onPayload) {
+  epoll_event events[3];
+  int n = epoll_wait(epollFd, events, 3, -1);
+  PollResult result;
+  bool received = false;
+  for (int i = 0; i < n; i++) {
+    uint64_t value;
+    if (events[i].data.fd == timerFd) {
+      if (::read(timerFd, &value, sizeof(value)) > 0) result.tick = true;
+      continue;
+    }
+    if (events[i].data.fd == wakeFd) {
+      if (::read(wakeFd, &value, sizeof(value)) > 0) result.wakeup = true;
+      continue;
+    }
+    // read up to batchSize datagrams per system call, one too large does not fit its slot
+    std::size_t slot = rx.size() / batchSize;
+    mmsghdr msgs[batchSize];
+    iovec iov[batchSize];
+    sockaddr_in from[batchSize];
+    for (;;) {
+      for (int j = 0; j < batchSize; j++) {
+        iov[j] = {rx.data() + j * slot, slot};
+        msgs[j] = {};
+        msgs[j].msg_hdr.msg_name = &from[j];
+        msgs[j].msg_hdr.msg_namelen = sizeof(from[j]);
+        msgs[j].msg_hdr.msg_iov = &iov[j];
+        msgs[j].msg_hdr.msg_iovlen = 1;
+      }
+      int m = ::recvmmsg(fd, msgs, batchSize, MSG_DONTWAIT, nullptr);
+      if (m <= 0) break;
+      const uint8_t* accepted = nullptr;
+      for (int j = 0; j < m; j++) {
+        const uint8_t* d = rx.data() + j * slot;
+        std::size_t len = msgs[j].msg_len;
+        Header h;
+        std::memcpy(&h, d, std::min<std::size_t>(len, sizeof(h)));
+        if (len != sizeof(Header) + rxPayloadSize || h.magic != magic) {
+          stats.invalid++;
+          continue;
+        }
+        if (accept(h, from[j])) accepted = d;
+      }
+      // only the newest datagram of a batch is copied
+      if (accepted != nullptr) {
+        std::memcpy(newest.data(), accepted + sizeof(Header), rxPayloadSize);
+        received = true;
+      }
+      if (m < batchSize) break;
+    }
+  }
+  auto now = std::chrono::steady_clock::now();
+  if (received) {
+    lastReceived = now;
+    connected = true;
+  } else if (receiving && connected && now - lastReceived > timeout) {
+    connected = false;
+    first = true;   // accept any sequence number from a restarted peer
+    log.trace() << "error = no datagram received within timeout";
+  }
+  if (received || result.tick) published.write(stats);
+  if (received) onPayload(newest.data());
+  return result;
+}
+
+void DatagramLink::wake() {
+  uint64_t one = 1;
+  if (::write(wakeFd, &one, sizeof(one)) < 0) { /* the counter is already set */ }
+}
+
+void DatagramLink::joinGroup(uint16_t port, const SocketOptions& options) {
+  if (!IN_MULTICAST(ntohl(peerAddr.sin_addr.s_addr))) {
+    ::close(fd);
+    throw Fault("not a multicast group address");
+  }
+  in_addr local{};
+  local.s_addr = htonl(INADDR_ANY);
+  if (!options.multicastInterface.empty() && inet_pton(AF_INET, options.multicastInterface.c_str(), &local) != 1) {
+    ::close(fd);
+    throw Fault("invalid multicast interface address");
+  }
+  if (receiving) {
+    int yes = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));   // several subscribers on one host
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr = peerAddr.sin_addr;   // only datagrams sent to the group
+    ip_mreq mreq{};
+    mreq.imr_multiaddr = peerAddr.sin_addr;
+    mreq.imr_interface = local;
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0) {
+      ::close(fd);
+      throw Fault("could not join multicast group");
+    }
+    peerKnown = false;   // subscribers only receive
+  } else {
+    unsigned char ttl = options.multicastTtl;
+    setsockopt(fd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+    if (!options.multicastInterface.empty()) setsockopt(fd, IPPROTO_IP, IP_MULTICAST_IF, &local, sizeof(local));
+    connected = true;
+  }
+}
+
+bool DatagramLink::accept(const Header& h, const sockaddr_in& from) {
+  bool otherSource = sourceKnown && (from.sin_addr.s_addr != sourceAddr.sin_addr.s_addr || from.sin_port != sourceAddr.sin_port);
+  if ((server || multicast) && otherSource) {
+    first = true;   // a new client or publisher took over
+  }
+  int32_t d = static_cast<int32_t>(h.sequence - stats.sequence);
+  if (!first && d <= 0 && d > -restartDistance) {
+    stats.reordered++;
+    return false;
+  }
+  if (!first && d > 1) stats.lost += d - 1;
+  first = false;
+  stats.received++;
+  stats.sequence = h.sequence;
+  stats.timestamp = h.timestamp;
+  sourceAddr = from;
+  sourceKnown = true;
+  if (server) {
+    peerAddr = from;
+    peerKnown = true;
+  }
+  return true;
+}
+
+void DatagramLink::send(const void* payload, std::size_t length) {
+  if (!peerKnown) return;
+  Header h{magic, txSequence++, System::getTimeNs()};
+  iovec iov[2] = {{&h, sizeof(h)}, {const_cast<void*>(payload), length}};
+  msghdr msg{};
+  msg.msg_name = &peerAddr;
+  msg.msg_namelen = sizeof(peerAddr);
+  msg.msg_iov = iov;
+  msg.msg_iovlen = length > 0 ? 2 : 1;
+  if (::sendmsg(fd, &msg, MSG_DONTWAIT | MSG_NOSIGNAL) < 0 && errno != EAGAIN && errno != ECONNREFUSED) {
+    log.trace() << "error = " << std::strerror(errno);
+  }
+}
+
+bool DatagramLink::isConnected() const {
+  return connected;
+}
+
+DatagramStatistics DatagramLink::getStatistics() const {
+  DatagramStatistics s{};
+  published.read(s);
+  return s;
+}
+
+uint16_t DatagramLink::getPort() const {
+  sockaddr_in addr{};
+  socklen_t len = sizeof(addr);
+  getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len);
+  return ntohs(addr.sin_port);
+}
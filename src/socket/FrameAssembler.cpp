@@ -0,0 +1,60 @@
+#include <eeros/sockets/FrameAssembler.hpp>
+#include <algorithm>
+#include <cstring>
+
+using namespace eeros::sockets;
+
+FrameAssembler::FrameAssembler(std::size_t frameSize) 
+    : headerSize(frameSize), maxFrameSize(frameSize), buffer(frameSize > 0 ? frameSize + batchSize : 0) { }
+
+FrameAssembler::FrameAssembler(std::size_t headerSize, std::size_t maxFrameSize, std::function<std::size_t(const uint8_t*)> frameSize)
+    : headerSize(headerSize), 
+      maxFrameSize(std::max(headerSize, maxFrameSize)), 
+      frameSize(frameSize), 
+      buffer(this->maxFrameSize + batchSize) { }
+
+uint8_t* FrameAssembler::next(std::size_t& length) {
+  if (begin > 0) {
+    // move the beginning of the next frame to the front, this is less than one frame
+    std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+    end -= begin;
+    begin = 0;
+  }
+  length = buffer.size() - end;
+  return buffer.data() + end;
+}
+
+void FrameAssembler::received(std::size_t n) {
+  end += n;
+}
+
+FrameAssembler::State FrameAssembler::pop() {
+  std::size_t available = end - begin;
+  if (available < headerSize || headerSize == 0) return State::partial;
+  std::size_t size = headerSize;
+  if (frameSize) {
+    size = frameSize(buffer.data() + begin);
+    if (size < headerSize || size > maxFrameSize) {
+      reset();
+      return State::invalid;
+    }
+  }
+  if (available < size) return State::partial;
+  current = begin;
+  completed = size;
+  begin += size;
+  return State::complete;
+}
+
+const uint8_t* FrameAssembler::frame() const {
+  return buffer.data() + current;
+}
+
+std::size_t FrameAssembler::getFrameSize() const {
+  return completed;
+}
+
+void FrameAssembler::reset() {
+  begin = 0;
+  end = 0;
+}
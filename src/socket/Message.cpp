@@ -0,0 +1,83 @@
+#include <eeros/sockets/Message.hpp>
+#include <eeros/core/Fault.hpp>
+#include <algorithm>
+#include <cstring>
+
+using namespace eeros;
+using namespace eeros::sockets;
+
+namespace {
+  void hash(uint32_t& h, const void* data, std::size_t length) {
+    auto bytes = static_cast<const uint8_t*>(data);
+    for (std::size_t i = 0; i < length; i++) {
+      h ^= bytes[i];
+      h *= 16777619u;   // FNV-1a prime
+    }
+  }
+}
+
+std::size_t MessageSchema::add(const std::string& name, FieldType type, uint32_t count) {
+  if (find(name) != nullptr) throw Fault("message field '" + name + "' already exists");
+  std::size_t offset = size;
+  fields.push_back({name, type, count, offset});
+  size += sizeOf(type) * count;
+  hash(id, name.c_str(), name.size() + 1);
+  hash(id, &type, sizeof(type));
+  hash(id, &count, sizeof(count));
+  return offset;
+}
+
+const MessageField* MessageSchema::find(const std::string& name) const {
+  for (auto& f : fields) {
+    if (f.name == name) return &f;
+  }
+  return nullptr;
+}
+
+const std::vector<MessageField>& MessageSchema::getFields() const {
+  return fields;
+}
+
+std::size_t MessageSchema::getPayloadSize() const {
+  return size;
+}
+
+uint32_t MessageSchema::getId() const {
+  return id;
+}
+
+std::size_t MessageSchema::sizeOf(FieldType type) {
+  switch (type) {
+    case FieldType::boolean: return sizeof(bool);
+    case FieldType::int8: case FieldType::uint8: return 1;
+    case FieldType::int16: case FieldType::uint16: return 2;
+    case FieldType::int32: case FieldType::uint32: case FieldType::float32: return 4;
+    default: return 8;
+  }
+}
+
+void Message::writeHeader(uint8_t* frame, const MessageSchema& schema, uint32_t sequence, uint64_t timestamp) {
+  MessageHeader h{magic, schema.getId(), static_cast<uint32_t>(schema.getPayloadSize()), sequence, timestamp};
+  std::memcpy(frame, &h, sizeof(h));
+}
+
+MessageHeader Message::readHeader(const uint8_t* frame) {
+  MessageHeader h;
+  std::memcpy(&h, frame, sizeof(h));
+  return h;
+}
+
+std::size_t Message::frameSize(const uint8_t* header) {
+  MessageHeader h = readHeader(header);
+  if (h.magic != magic) return 0;
+  return sizeof(MessageHeader) + h.length;
+}
+
+bool Message::matches(const uint8_t* frame, const MessageSchema& schema) {
+  MessageHeader h = readHeader(frame);
+  return h.magic == magic && h.schema == schema.getId() && h.length == schema.getPayloadSize();
+}
+
+FrameAssembler Message::framing(std::size_t payloadSize) {
+  return FrameAssembler(sizeof(MessageHeader), sizeof(MessageHeader) + std::max(payloadSize, maxPayloadSize), frameSize);
+}
@@ -0,0 +1,233 @@
+#include <eeros/sockets/ServerConnections.hpp>
+#include <eeros/core/Fault.hpp>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace eeros;
+using namespace eeros::sockets;
+
+ServerConnections::ServerConnections(uint16_t port, std::size_t rxFrameSize, double period, double timeout, int maxClients, 
+                                     const SocketOptions& options)
+    : options(options),
+      rxFrameSize(rxFrameSize),
+      framing(rxFrameSize),
+      timeout(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(timeout))),
+      maxClients(maxClients),
+      log(logger::Logger::getLogger()) {
+  listenFd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (listenFd < 0) throw Fault("ERROR opening socket");
+  int yes = 1;
+  if (setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes)) == -1) {
+    ::close(listenFd);
+    throw Fault("ERROR on set socket option");
+  }
+  sockaddr_in servAddr{};
+  servAddr.sin_family = AF_INET;
+  servAddr.sin_port = htons(port);
+  servAddr.sin_addr.s_addr = htonl(INADDR_ANY);
+  if (bind(listenFd, reinterpret_cast<sockaddr*>(&servAddr), sizeof(servAddr)) < 0 || listen(listenFd, maxClients) < 0) {
+    ::close(listenFd);
+    throw Fault("ERROR on socket binding");
+  }
+  socklen_t len = sizeof(servAddr);
+  getsockname(listenFd, reinterpret_cast<sockaddr*>(&servAddr), &len);
+  this->port = ntohs(servAddr.sin_port);
+
+  epollFd = epoll_create1(EPOLL_CLOEXEC);
+  timerFd = createPeriodicTimer(period);
+  wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  epoll_event ev{};
+  ev.events = EPOLLIN;
+  ev.data.fd = listenFd;
+  epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &ev);
+  ev.data.fd = timerFd;
+  epoll_ctl(epollFd, EPOLL_CTL_ADD, timerFd, &ev);
+  ev.data.fd = wakeFd;
+  epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &ev);
+}
+
+ServerConnections::~ServerConnections() {
+  for (auto& c : clients) ::close(c.first);
+  ::close(wakeFd);
+  ::close(timerFd);
+  ::close(epollFd);
+  ::close(listenFd);
+}
+
+PollResult ServerConnections::poll(const std::function<void(const uint8_t*)>& onFrame) {
+  constexpr int maxEvents = 16;
+  epoll_event events[maxEvents];
+  int n = epoll_wait(epollFd, events, maxEvents, -1);
+  PollResult result;
+  for (int i = 0; i < n; i++) {
+    int fd = events[i].data.fd;
+    uint64_t value;
+    if (fd == timerFd) {
+      if (::read(timerFd, &value, sizeof(value)) > 0) result.tick = true;
+    } else if (fd == wakeFd) {
+      if (::read(wakeFd, &value, sizeof(value)) > 0) result.wakeup = true;
+    } else if (fd == listenFd) {
+      accept();
+    } else {
+      auto c = clients.find(fd);
+      if (c == clients.end()) continue;
+      if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+        drop(fd);
+        continue;
+      }
+      if (events[i].events & EPOLLOUT) flush(fd, c->second);
+      if ((events[i].events & EPOLLIN) && clients.count(fd)) receive(fd, c->second, onFrame);
+    }
+  }
+  if (result.tick) dropIdle();
+  return result;
+}
+
+void ServerConnections::wake() {
+  uint64_t one = 1;
+  if (::write(wakeFd, &one, sizeof(one)) < 0) { /* the counter is already set */ }
+}
+
+void ServerConnections::setFraming(const FrameAssembler& framing) {
+  this->framing = framing;
+}
+
+void ServerConnections::broadcast(const void* data, std::size_t length) {
+  auto bytes = static_cast<const uint8_t*>(data);
+  std::vector<int> failed;
+  for (auto& e : clients) {
+    Client& c = e.second;
+    if (c.txOffset < c.tx.size()) {
+      skipped++;
+      continue;
+    }
+    ssize_t n = ::send(e.first, bytes, length, MSG_NOSIGNAL | MSG_DONTWAIT);
+    if (n < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        failed.push_back(e.first);
+        continue;
+      }
+      n = 0;
+    }
+    if (static_cast<std::size_t>(n) < length) {
+      c.tx.assign(bytes + n, bytes + length);
+      c.txOffset = 0;
+      watch(e.first, true);
+    }
+  }
+  for (int fd : failed) drop(fd);
+}
+
+int ServerConnections::getNofClients() const {
+  return clients.size();
+}
+
+uint16_t ServerConnections::getPort() const {
+  return port;
+}
+
+uint64_t ServerConnections::getSkipped() const {
+  return skipped;
+}
+
+void ServerConnections::accept() {
+  for (;;) {
+    sockaddr_in cliAddr;
+    socklen_t clilen = sizeof(cliAddr);
+    int fd = accept4(listenFd, reinterpret_cast<sockaddr*>(&cliAddr), &clilen, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0) return;
+    char cliName[INET6_ADDRSTRLEN];
+    getnameinfo(reinterpret_cast<sockaddr*>(&cliAddr), clilen, cliName, sizeof(cliName), NULL, 0, NI_NUMERICHOST | NI_NUMERICSERV);
+    if (static_cast<int>(clients.size()) >= maxClients) {
+      log.warn() << "Client connection from ip=" << cliName << " refused, too many clients";
+      ::close(fd);
+      continue;
+    }
+    if (!applySocketOptions(fd, options, true)) log.warn() << "could not set socket options of client ip=" << cliName;
+    Client& c = clients[fd];
+    c.rx = framing;
+    c.lastFrame = std::chrono::steady_clock::now();
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+    log.info() << "Client connection from ip=" << cliName << " accepted";
+  }
+}
+
+void ServerConnections::receive(int fd, Client& c, const std::function<void(const uint8_t*)>& onFrame) {
+  uint8_t discard[256];
+  for (;;) {
+    ssize_t n;
+    std::size_t length = sizeof(discard);
+    if (rxFrameSize == 0) n = ::recv(fd, discard, length, 0);
+    else n = ::recv(fd, c.rx.next(length), length, 0);
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+      drop(fd);
+      return;
+    }
+    if (n < 0) return;
+    if (rxFrameSize > 0) {
+      c.rx.received(n);
+      FrameAssembler::State state;
+      while ((state = c.rx.pop()) == FrameAssembler::State::complete) {
+        c.lastFrame = std::chrono::steady_clock::now();
+        onFrame(c.rx.frame());
+      }
+      if (state == FrameAssembler::State::invalid) {
+        log.warn() << "invalid frame header, client dropped";
+        drop(fd);
+        return;
+      }
+    }
+    if (static_cast<std::size_t>(n) < length) return;   // all queued data was read
+  }
+}
+
+void ServerConnections::flush(int fd, Client& c) {
+  ssize_t n = ::send(fd, c.tx.data() + c.txOffset, c.tx.size() - c.txOffset, MSG_NOSIGNAL | MSG_DONTWAIT);
+  if (n < 0) {
+    if (errno != EAGAIN && errno != EWOULDBLOCK) drop(fd);
+    return;
+  }
+  c.txOffset += n;
+  if (c.txOffset == c.tx.size()) {
+    c.tx.clear();
+    c.txOffset = 0;
+    watch(fd, false);
+  }
+}
+
+void ServerConnections::watch(int fd, bool output) {
+  epoll_event ev{};
+  ev.events = EPOLLIN | (output ? EPOLLOUT : 0);
+  ev.data.fd = fd;
+  epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev);
+}
+
+void ServerConnections::drop(int fd) {
+  epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+  ::close(fd);
+  clients.erase(fd);
+  log.trace() << "client disconnected, " << clients.size() << " clients left";
+}
+
+void ServerConnections::dropIdle() {
+  if (rxFrameSize == 0) return;
+  auto now = std::chrono::steady_clock::now();
+  std::vector<int> idle;
+  for (auto& c : clients) {
+    if (now - c.second.lastFrame > timeout) idle.push_back(c.first);
+  }
+  for (int fd : idle) {
+    log.trace() << "error = socket read timed out";
+    drop(fd);
+  }
+}
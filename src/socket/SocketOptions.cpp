@@ -0,0 +1,37 @@
+#include <eeros/sockets/SocketOptions.hpp>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+
+namespace eeros {
+namespace sockets {
+
+bool applySocketOptions(int fd, const SocketOptions& options, bool tcp) {
+  bool ok = true;
+  if (tcp) {
+    int noDelay = options.noDelay ? 1 : 0;
+    ok &= setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay)) == 0;
+  }
+  if (options.busyPoll > 0) {
+    ok &= setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &options.busyPoll, sizeof(options.busyPoll)) == 0;
+  }
+  if (options.priority >= 0) {
+    ok &= setsockopt(fd, SOL_SOCKET, SO_PRIORITY, &options.priority, sizeof(options.priority)) == 0;
+  }
+  return ok;
+}
+
+int createPeriodicTimer(double period) {
+  int fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  long ns = static_cast<long>(period * 1e9);
+  itimerspec spec{};
+  spec.it_interval.tv_sec = ns / 1000000000;
+  spec.it_interval.tv_nsec = ns % 1000000000;
+  spec.it_value = spec.it_interval;
+  timerfd_settime(fd, 0, &spec, nullptr);
+  return fd;
+}
+
+}
+}
@@ -1,9 +1,17 @@
 #include <eeros/sockets/SocketServer.hpp>
+#include <sched.h>
 
 namespace eeros {
 	namespace sockets {
 
 		void sigPipeHandler(int signum) { }
 
+		bool setThreadPriority(int priority) {
+			if (priority == 20) return true;
+			struct sched_param schedulingParam;
+			schedulingParam.sched_priority = priority;
+			return sched_setscheduler(0, SCHED_FIFO, &schedulingParam) == 0;
+		}
+
 	}
 }
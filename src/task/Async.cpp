@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <stdexcept>
 #include <sys/types.h>
 #include <sys/syscall.h>
@@ -5,18 +8,19 @@
 
 #include <eeros/task/Async.hpp>
 #include <eeros/core/Executor.hpp>
+#include <eeros/core/Tracepoint.hpp>
+#include <eeros/safety/SafetySystem.hpp>
 
 using namespace eeros::task;
 using namespace eeros::logger;
 
-Async::Async(Runnable &task, bool realtime , int nice) 
-    : task(task), realtime(realtime), nice(nice), thread(&Async::run_thread, this), 
-      finished(false) {
-      }
+Async::Async(Runnable &task, bool realtime , int nice, std::vector<int> cpus, std::size_t stackSize) 
+    : task(task), realtime(realtime), nice(nice), cpus(cpus), finished(false),
+      thread(stackSize, [this]() { run_thread(); }) { }
 
-Async::Async(Runnable *task, bool realtime , int nice) 
-    : task(*task), realtime(realtime), nice(nice), thread(&Async::run_thread, this), 
-      finished(false) { }
+Async::Async(Runnable *task, bool realtime , int nice, std::vector<int> cpus, std::size_t stackSize) 
+    : task(*task), realtime(realtime), nice(nice), cpus(cpus), finished(false),
+      thread(stackSize, [this]() { run_thread(); }) { }
 
 Async::~Async() {
   stop();
@@ -24,9 +28,26 @@ Async::~Async() {
 }
 
 void Async::run() {
+  if (pending.load(std::memory_order_acquire) > 0) {
+    // previous run has not finished yet
+    missed.fetch_add(1, std::memory_order_relaxed);
+    if (overrunPolicy == OverrunPolicy::skip) return;
+    if (overrunPolicy == OverrunPolicy::safetyEvent) {
+      if (safetySystem != nullptr && safetyEvent != nullptr) safetySystem->triggerEvent(*safetyEvent);
+      return;
+    }
+  }
+  pending.fetch_add(1, std::memory_order_release);
+  EEROS_TRACE2(async_wake, this, pending.load(std::memory_order_relaxed));
   semaphore.post();
 }
 
+void Async::setOverrunPolicy(OverrunPolicy policy, safety::SafetySystem* ss, safety::SafetyEvent* e) {
+  overrunPolicy = policy;
+  safetySystem = ss;
+  safetyEvent = e;
+}
+
 void Async::stop() {
   finished = true;
   semaphore.post();
@@ -36,14 +57,48 @@ void Async::join() {
   if (thread.joinable()) thread.join();
 }
 
+void Async::setDeadline(double period, double runtime) {
+  deadlinePeriod = period;
+  deadlineRuntime = runtime;
+  deadline = true;
+}
+
+bool Async::waitReady(double timeout) {
+  if (!ready) ready = readySemaphore.wait(timeout);
+  return ready;
+}
+
+double Async::calibratedBudget(double maxRun, double period) {
+  return std::min(maxRun * budgetMargin, period);
+}
+
+void Async::apply_deadline(Logger &log) {
+  double runtime = deadlineRuntime;
+  if (runtime <= 0) runtime = calibratedBudget(counter.run.max, deadlinePeriod);
+  if (Executor::set_deadline(runtime, deadlinePeriod, deadlinePeriod)) {
+    log.trace() << "thread " << getpid() << ":" << syscall(SYS_gettid) << " runs under SCHED_DEADLINE with budget " 
+                << runtime << " sec per " << deadlinePeriod << " sec";
+  } else {
+    int err = errno;
+    log.error() << "could not set SCHED_DEADLINE with budget " << runtime << " sec per " << deadlinePeriod << " sec: " << std::strerror(err);
+    if (err == EPERM && !cpus.empty())
+      log.error() << "the affinity of the thread must cover all cpus of its root domain, use an exclusive cpuset for its cpus";
+  }
+  deadline = false;
+}
+
 void Async::run_thread() {
   const auto pid = getpid();
   const auto tid = syscall(SYS_gettid);
 
-  Executor::prefault_stack();
+  const std::size_t stackSize = thread.getStackSize();
+  Executor::prefault_stack(stackSize > 0 ? StackThread::usableStack(stackSize) : Executor::defaultStackPrefault);
 
   auto log = Logger::getLogger('A');
 
+  if (!cpus.empty() && !Executor::set_affinity(cpus))
+    log.error() << "could not set cpu affinity of thread " << pid << ":" << tid;
+
   if (realtime) {
     int priority = Executor::basePriority - nice;
     log.trace() << "starting realtime thread " << pid << ":" << tid << " with priority " << priority;
@@ -58,11 +113,18 @@ void Async::run_thread() {
     log.trace() << "starting thread " << pid << ":" << tid;
   }
 
+  readySemaphore.post();
   semaphore.wait();
   while (!finished) {
+    if (deadline && (deadlineRuntime > 0 || counter.run.count >= calibrationCycles)) apply_deadline(log);
+    EEROS_TRACE1(async_run, this);
     counter.tick();
     task.run();
     counter.tock();
+    uint64_t m = missed.exchange(0, std::memory_order_relaxed);
+    if (m > 0) counter.addOverruns(m);
+    EEROS_TRACE2(async_finish, this, m);
+    pending.fetch_sub(1, std::memory_order_release);
     semaphore.wait();
   }
 
@@ -3,11 +3,12 @@
 using namespace eeros::task;
 
 
-Harmonic::Harmonic(Runnable &task, int n) :
-	n(n), k(0), task(&task) { }
+// the phase delays the execution by a number of base cycles
+Harmonic::Harmonic(Runnable &task, int n, int phase) :
+	n(n), k((n - phase % n) % n), task(&task) { }
 
-Harmonic::Harmonic(Runnable *task, int n) :
-	n(n), k(0), task(task) { }
+Harmonic::Harmonic(Runnable *task, int n, int phase) :
+	n(n), k((n - phase % n) % n), task(task) { }
 
 eeros::Runnable * Harmonic::getTask() {
 	return task;
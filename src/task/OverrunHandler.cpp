@@ -0,0 +1,47 @@
+#include <eeros/task/OverrunHandler.hpp>
+#include <eeros/safety/SafetySystem.hpp>
+#include <algorithm>
+
+using namespace eeros::task;
+
+void OverrunHandler::setPolicy(OverrunPolicy policy, safety::SafetySystem* ss, safety::SafetyEvent* e) {
+  this->policy = policy;
+  safetySystem = ss;
+  safetyEvent = e;
+}
+
+OverrunPolicy OverrunHandler::getPolicy() const {
+  return policy;
+}
+
+int64_t OverrunHandler::release(int64_t next, int64_t now, int64_t periodNs, PeriodicCounter& counter) {
+  if (now < next) return next;
+  // the last run did not finish before the next release
+  int64_t missed = (now - next) / periodNs + 1;
+  // while catching up, the releases of the backlog were already counted when the lateness was detected
+  int64_t last = next + (missed - 1) * periodNs;
+  int64_t first = std::max(next, countedUntil + periodNs);
+  if (last >= first) {
+    counter.addOverruns(static_cast<uint64_t>((last - first) / periodNs + 1));
+    countedUntil = last;
+  }
+  switch (policy) {
+    case OverrunPolicy::safetyEvent:
+      triggerEvent();
+      return next + missed * periodNs;
+    case OverrunPolicy::skip:
+      return next + missed * periodNs;
+    default:
+      return next; // run missed cycles back to back
+  }
+}
+
+void OverrunHandler::triggerEvent() {
+  if (policy == OverrunPolicy::safetyEvent && safetySystem != nullptr && safetyEvent != nullptr) {
+    safetySystem->triggerEvent(*safetyEvent);
+  }
+}
+
+void OverrunHandler::reset() {
+  countedUntil = 0;
+}
@@ -0,0 +1,79 @@
+#include <eeros/task/Schedulability.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace eeros::task;
+
+namespace {
+constexpr double eps = 1e-12;   // tolerance for rounding the number of releases
+constexpr int maxIterations = 1000;
+}
+
+void Schedulability::add(std::string name, double period, double wcet, int priority, const std::vector<int>& cpus) {
+  int core = cpus.empty() ? anyCore : cpus.front();
+  tasks.push_back({name, period, wcet, priority, core, 0, false});
+}
+
+bool Schedulability::analyze() {
+  cores.clear();
+  for (auto& t : tasks) {
+    auto c = std::find_if(cores.begin(), cores.end(), [&t](const Core& c) { return c.core == t.core; });
+    if (c == cores.end()) {
+      cores.push_back({t.core, 0, 0, 0});
+      c = cores.end() - 1;
+    }
+    c->tasks++;
+    c->utilization += t.wcet / t.period;
+  }
+  for (auto& c : cores) c.bound = c.tasks * (std::pow(2.0, 1.0 / c.tasks) - 1);
+  std::sort(cores.begin(), cores.end(), [](const Core& a, const Core& b) { return a.core < b.core; });
+
+  // response time analysis: R = C + sum over interfering tasks of ceil(R / T) * C
+  bool all = true;
+  for (auto& t : tasks) {
+    double r = t.wcet;
+    bool converged = false;
+    for (int i = 0; i < maxIterations && r <= t.period + eps; i++) {
+      double next = t.wcet;
+      for (auto& o : tasks) {
+        if (&o == &t || o.core != t.core || o.priority < t.priority) continue;
+        next += std::ceil(r / o.period - eps) * o.wcet;
+      }
+      if (next <= r + eps) {
+        converged = true;
+        break;
+      }
+      r = next;
+    }
+    t.responseTime = converged ? r : std::numeric_limits<double>::infinity();
+    t.schedulable = converged && r <= t.period + eps;
+    all = all && t.schedulable;
+  }
+  return all;
+}
+
+void Schedulability::report(logger::Logger& log) const {
+  for (auto& c : cores) {
+    std::string core = c.core == anyCore ? "unpinned periodics" : "core " + std::to_string(c.core);
+    log.info() << core << ": " << c.tasks << " periodics, utilization " << c.utilization * 100
+               << " %, rate monotonic bound " << c.bound * 100 << " %";
+  }
+  for (auto& t : tasks) {
+    if (t.schedulable) {
+      log.info() << "periodic '" << t.name << "' (priority " << t.priority << "): wcet " << t.wcet
+                 << " sec, response time " << t.responseTime << " sec, period " << t.period << " sec";
+    } else {
+      log.error() << "periodic '" << t.name << "' (priority " << t.priority << ") is not schedulable: wcet " << t.wcet
+                  << " sec, response time " << t.responseTime << " sec exceeds period " << t.period << " sec";
+    }
+  }
+}
+
+const std::vector<Schedulability::Task>& Schedulability::getTasks() const {
+  return tasks;
+}
+
+const std::vector<Schedulability::Core>& Schedulability::getCores() const {
+  return cores;
+}
@@ -0,0 +1,102 @@
+#include <cmath>
+#include <cerrno>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <eeros/task/Timed.hpp>
+#include <eeros/core/Executor.hpp>
+
+using namespace eeros::task;
+using namespace eeros::logger;
+
+namespace {
+
+constexpr int64_t nsPerSec = 1000000000;
+
+int64_t monotonicNowNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * nsPerSec + ts.tv_nsec;
+}
+
+void sleepUntil(int64_t ns) {
+  struct timespec ts;
+  ts.tv_sec = ns / nsPerSec;
+  ts.tv_nsec = ns % nsPerSec;
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR);
+}
+
+}
+
+Timed::Timed(Runnable &task, double period, bool realtime, int nice, std::vector<int> cpus, std::size_t stackSize)
+    : counter(period), task(task), periodNs(llround(period * 1.0e9)), realtime(realtime), nice(nice), cpus(cpus),
+      thread(stackSize, [this]() { run_thread(); }) { }
+
+Timed::~Timed() {
+  stop();
+  join();
+}
+
+void Timed::start(int64_t startNs) {
+  this->startNs.store(startNs, std::memory_order_relaxed);
+  startSemaphore.post();
+}
+
+void Timed::stop() {
+  finished = true;
+  startSemaphore.post();
+}
+
+void Timed::join() {
+  if (thread.joinable()) thread.join();
+}
+
+bool Timed::waitReady(double timeout) {
+  if (!ready) ready = readySemaphore.wait(timeout);
+  return ready;
+}
+
+void Timed::setOverrunPolicy(OverrunPolicy policy, safety::SafetySystem* ss, safety::SafetyEvent* e) {
+  overrun.setPolicy(policy, ss, e);
+}
+
+void Timed::run_thread() {
+  const auto pid = getpid();
+  const auto tid = syscall(SYS_gettid);
+
+  const std::size_t stackSize = thread.getStackSize();
+  Executor::prefault_stack(stackSize > 0 ? StackThread::usableStack(stackSize) : Executor::defaultStackPrefault);
+
+  auto log = Logger::getLogger('A');
+
+  if (!cpus.empty() && !Executor::set_affinity(cpus))
+    log.error() << "could not set cpu affinity of thread " << pid << ":" << tid;
+
+  if (realtime) {
+    log.trace() << "starting timed realtime thread " << pid << ":" << tid << " with priority " << Executor::basePriority - nice;
+    if (!Executor::set_priority(nice))
+      log.error() << "could not set realtime priority";
+    if (!Executor::lock_memory())
+      log.error() << "could not lock memory in RAM";
+  }
+  else {
+    log.trace() << "starting timed thread " << pid << ":" << tid;
+  }
+
+  readySemaphore.post();
+  startSemaphore.wait();
+  overrun.reset();
+  int64_t next = startNs.load(std::memory_order_relaxed);
+  while (!finished) {
+    sleepUntil(next);
+    if (finished) break;
+    counter.tick();
+    task.run();
+    counter.tock();
+    next = overrun.release(next + periodNs, monotonicNowNs(), periodNs, counter);
+  }
+
+  log.trace() << "stopping timed thread " << pid << ":" << tid;
+}
@@ -0,0 +1,98 @@
+#include <eeros/task/WorkerPool.hpp>
+#include <eeros/core/Executor.hpp>
+#include <eeros/logger/Logger.hpp>
+
+using namespace eeros::task;
+
+WorkerPool::WorkerPool(int threads, std::vector<int> cpus) : cpus(cpus) {
+  if (threads < 1) threads = 1;
+  for (int i = 0; i < threads; i++) queues.push_back(std::make_unique<Queue>());
+  for (int i = 0; i < threads; i++) workers.emplace_back(&WorkerPool::workerLoop, this, i);
+}
+
+WorkerPool::~WorkerPool() {
+  stop();
+  join();
+}
+
+void WorkerPool::submit(Runnable& job) {
+  unsigned int index = nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+  {
+    std::lock_guard<std::mutex> lock(queues[index]->mtx);
+    queues[index]->jobs.push_back(&job);
+  }
+  queued.fetch_add(1, std::memory_order_release);
+  // taking the lock avoids a lost wakeup between the check and the wait of a worker
+  { std::lock_guard<std::mutex> lock(sleepMtx); }
+  sleepCv.notify_one();
+}
+
+void WorkerPool::stop() {
+  {
+    std::lock_guard<std::mutex> lock(sleepMtx);
+    finished = true;
+  }
+  sleepCv.notify_all();
+}
+
+void WorkerPool::join() {
+  for (auto& t : workers) if (t.joinable()) t.join();
+}
+
+int WorkerPool::getThreadCount() const {
+  return static_cast<int>(workers.size());
+}
+
+eeros::Runnable* WorkerPool::take(int index) {
+  int n = static_cast<int>(queues.size());
+  for (int i = 0; i < n; i++) {
+    // own queue first, oldest job first; steal the newest job of the others
+    Queue& q = *queues[(index + i) % n];
+    std::lock_guard<std::mutex> lock(q.mtx);
+    if (q.jobs.empty()) continue;
+    Runnable* job;
+    if (i == 0) {
+      job = q.jobs.front();
+      q.jobs.pop_front();
+    } else {
+      job = q.jobs.back();
+      q.jobs.pop_back();
+    }
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    return job;
+  }
+  return nullptr;
+}
+
+void WorkerPool::workerLoop(int index) {
+  auto log = logger::Logger::getLogger('A');
+  if (!cpus.empty() && !Executor::set_affinity(cpus)) log.error() << "could not set cpu affinity of pool worker " << index;
+  while (!finished) {
+    Runnable* job = take(index);
+    if (job != nullptr) {
+      job->run();
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleepMtx);
+    sleepCv.wait(lock, [this]() { return finished || queued.load(std::memory_order_acquire) > 0; });
+  }
+}
+
+PooledTask::PooledTask(Runnable& task, WorkerPool& pool) : task(task), pool(pool), job(*this) { }
+
+void PooledTask::run() {
+  if (pending.exchange(true, std::memory_order_acq_rel)) {
+    missed.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  pool.submit(job);
+}
+
+void PooledTask::execute() {
+  counter.tick();
+  task.run();
+  counter.tock();
+  uint64_t m = missed.exchange(0, std::memory_order_relaxed);
+  if (m > 0) counter.addOverruns(m);
+  pending.store(false, std::memory_order_release);
+}
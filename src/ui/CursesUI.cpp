@@ -1,17 +1,16 @@
 #include <eeros/ui/CursesUI.hpp>
 #include <eeros/core/Fault.hpp>
+#include <eeros/core/System.hpp>
 #include <eeros/sequencer/Sequence.hpp>
 #include <curses.h>
 #include <sstream>
-#include <thread>
-#include <chrono>
 #include <stdlib.h>
-#include <unistd.h>
 
 
 
 using namespace eeros;
 using namespace eeros::sequencer;
+using namespace eeros::safety;
 using namespace eeros::ui;
 
 unsigned int CursesUI::instanceCounter = 0;
@@ -20,8 +19,8 @@ void closeUI() {
 	endwin();
 }
 
-CursesUI::CursesUI(Sequencer& sequencer) : sequencer(sequencer), state(idle) {
-	log.warn() << "ahsdkhak";
+CursesUI::CursesUI(Sequencer& sequencer, SafetySystem* safetySystem)
+		: sequencer(sequencer), safetySystem(safetySystem), state(idle), messageCount(0), minRedrawPeriodNs(100000000) {
 	if(++instanceCounter > 1) {
 		throw Fault("Only a single user interface can exist at the same time!");
 	}
@@ -32,163 +31,140 @@ CursesUI::~CursesUI() {
 }
 
 void CursesUI::dispay() {
-// 	cachedMode = sequencer.getMode();
-// 	cachedState = sequencer.getState();
-	
 	state = active;
+	wakeup.post();
 }
 
 void CursesUI::exit() {
-	state = stopping;
-	clear();
-	refresh();
-	closeUI();
+	State s = state.exchange(stopping);
+	wakeup.post();
+	if(s == active) {
+		clear();
+		refresh();
+		closeUI();
+	}
 }
 
-void CursesUI::printHeader() {
-	color_set(5, nullptr);
-	for(int j = headerStart; j < HEADER_LINES; j++) {
-		for(int i = 0; i < COLS; i++) {
-			move(j, i);
-			addch(' ');
-		}
-	}
-//	attron(A_BOLD);
-	std::stringstream title;
-	title << "User interface for sequencer ";
-	mvprintw(headerStart + 1, (COLS - title.str().size()) / 2, "%s", title.str().c_str());
-	color_set(1, nullptr);
-	attrset(A_NORMAL);
+void CursesUI::setMaxRefreshRate(double hz) {
+	minRedrawPeriodNs = hz > 0 ? static_cast<uint64_t>(1.0e9 / hz) : 0;
 }
 
-void CursesUI::printFooter(std::string msg) {
-	color_set(5, nullptr);
-	for(int j = 1; j < FOOTER_LINES; j++) {
-		for(int i = 0; i < COLS; i++) {
-			move(footerStart + j, i);
-			addch(' ');
-		}
-	}
-	mvprintw(LINES - 1, 1, "%s", msg.c_str());
+void CursesUI::printLine(unsigned int line, short color, const std::string& text, bool centered) {
+	if(line >= lines.size()) return;
+	std::string padded(COLS > 0 ? COLS : 0, ' ');
+	std::size_t start = centered && text.size() < padded.size() ? (padded.size() - text.size()) / 2 : 1;
+	if(start < padded.size()) padded.replace(start, std::min(text.size(), padded.size() - start), text, 0, padded.size() - start);
+	auto& shadow = lines[line];
+	if(shadow.first == color && shadow.second == padded) return;   // unchanged, not written
+	shadow.first = color;
+	shadow.second = padded;
+	color_set(color, nullptr);
+	mvaddnstr(line, 0, padded.c_str(), COLS);
 	color_set(1, nullptr);
 }
 
-void CursesUI::printTitle(std::string text, unsigned int line) {
-	color_set(2, nullptr);
-	for(int i = 0; i < COLS; i++) {
-		move(line, i);
-		addch(' ');
-	}
-	mvprintw(line, (COLS - text.size()) / 2, "%s", text.c_str());
-	color_set(1, nullptr);
+void CursesUI::printHeader() {
+	printLine(headerStart, 5, "");
+	printLine(headerStart + 1, 5, "User interface for sequencer", true);
+	printLine(headerStart + 2, 5, "");
 }
 
-void CursesUI::printSequenceList(unsigned int first) {
-// 	const std::vector<Sequence<void>*>& list = sequencer.getListOfCmdSequences();
-	const std::vector<Sequence*>& list = sequencer.getListOfAllSequences();
-	unsigned int i = 0;
-	printTitle("Command sequences", sequenceListStart);
-	for(auto entry : list) {
-		mvprintw(sequenceListStart + 1 + i, 1, "%i) %s", i, entry->getName().c_str());
-		i++;
-	}
+void CursesUI::printFooter(std::string msg) {
+	printLine(footerStart, 1, "");
+	printLine(footerStart + 1, 5, msg);
 }
 
-void CursesUI::printMessage(std::string msg, unsigned int index) {
-	int line = messageListStart + 1 + index;
-	mvprintw(line, 1, msg.c_str());
+void CursesUI::printSequenceList(const Snapshot& s) {
+	printLine(sequenceListStart, 2, "Sequences", true);
+	for(unsigned int i = 0; sequenceListStart + 1 + i < messageListStart; i++) {
+		std::stringstream text;
+		if(i < s.names.size()) text << i << ") " << s.names[i] << ": " << s.states[i];
+		printLine(sequenceListStart + 1 + i, 1, text.str());
+	}
 }
 
 void CursesUI::printMessageList() {
-	printTitle("Messages", messageListStart);
-	int i = 0;
-	for(auto msg : messageList) {
-		printMessage(msg, i++);
-	}
+	printLine(messageListStart, 2, "Messages", true);
+	std::lock_guard<std::mutex> lock(messageMutex);
+	unsigned int i = 0;
+	for(auto& msg : messageList) printLine(messageListStart + 1 + i++, 1, msg.substr(0, MESSAGE_LINE_MAX_LENGTH));
+	for(; i < MESSAGE_LINES - 1; i++) printLine(messageListStart + 1 + i, 1, "");
 }
 
-void CursesUI::printStatus() {
-	printTitle("Status", statusStart);
-	mvprintw(statusStart + 1, 1, "State:");
-	SequenceState s = sequencer.getMainSequence()->getRunningState();
-// 	state::type s = sequencer.getState();
-	switch(s) {
-		case SequenceState::running:
-			mvprintw(statusStart + 1, 9, "running    ");
-			break;
-		case SequenceState::aborted:
-			mvprintw(statusStart + 1, 9, "aborted    ");
-			break;
-		case SequenceState::aborting:
-			mvprintw(statusStart + 1, 9, "aborting   ");
-			break;
-		case SequenceState::terminated:
-			mvprintw(statusStart + 1, 9, "terminated ");
-			break;
-		case SequenceState::idle:
-			mvprintw(statusStart + 1, 9, "idle       ");
-			break;
-		case SequenceState::restarting:
-			mvprintw(statusStart + 1, 9, "restarting ");
-			break;
-		default:
-			mvprintw(statusStart + 1, 9, "unknown (%u)", static_cast<unsigned int>(s));
-			break;
+void CursesUI::printStatus(const Snapshot& s) {
+	printLine(statusStart, 2, "Status", true);
+	unsigned int running = 0;
+	for(auto st : s.states) {
+		if(st == SequenceState::running || st == SequenceState::starting) running++;
 	}
-	
-	mvprintw(statusStart + 1, COLS / 2 + 1, "Mode:");
-// 	mode::type m = sequencer.getMode();
-// 	switch(m) {
-// 		case mode::automatic:
-// 			mvprintw(statusStart + 1, COLS / 2 + 7, "automatic   ");
-// 			break;
-// 		case mode::stepping:
-// 			mvprintw(statusStart + 1, COLS / 2 + 7, "stepping    ");
-// 			break;
-// 		default:
-// 			mvprintw(statusStart + 1, COLS / 2 + 7, "unknown (%u)", static_cast<unsigned int>(s));
-// 			break;
-// 	}
-	
-// 	mvprintw(statusStart + 2, 1, "Current Sequence:");
-// 	const Sequence<>* cs = sequencer.getCurrentSequence();
-// 	move(statusStart + 2, 19); clrtoeol();
-// 	if(cs != nullptr) addstr(cs->getName().c_str());
-//	printw("%p", cs);
-	
+	std::stringstream text;
+	text << "Sequences running: " << running << " of " << s.states.size();
+	printLine(statusStart + 1, 1, text.str());
+	printLine(statusStart + 2, 1, s.level != nullptr ? "Safety level: " + s.level->getDescription() : "");
+	printLine(statusStart + 3, 1, "");
 }
 
-void CursesUI::printCommandList() {
-	printTitle("Commands", commandListStart);
-	printCommand("F2 ", "toggle step mode", checkCmdToggleIsActive(), 0);
-	printCommand("F5 ", "choose sequence", checkCmdChooseSeqIsActive(), 1);
-	printCommand("F3 ", "proceed", checkCmdProceedIsActive(), 2);
-	printCommand("F4 ", "abort", checkCmdAbortIsActive(), 4);
-	printCommand("F10", "exit", true, 5);
+std::string CursesUI::command(std::string cmd, std::string description, bool active) {
+	return cmd + " " + description + (active ? "" : " (not available)");
 }
 
-void CursesUI::printCommand(std::string cmd, std::string description, bool active, unsigned int index) {
-	if(active) color_set(3, nullptr);
-	else color_set(4, nullptr);
-	
-	int line = commandListStart + 1 + index / 2;
-	int startCol = 1; if(index % 2 > 0) startCol = COLS / 2 + 1;
-	
-	mvprintw(line, startCol, cmd.c_str());
-	mvprintw(line, startCol + 4, description.c_str());
-	color_set(1, nullptr);
+void CursesUI::printCommandList(const Snapshot& s) {
+	printLine(commandListStart, 2, "Commands", true);
+	bool abort = checkCmdAbortIsActive(s);
+	printLine(commandListStart + 1, abort ? 3 : 4, command("F4 ", "abort", abort));
+	printLine(commandListStart + 2, 3, command("F10", "exit", true));
+	printLine(commandListStart + 3, 1, "");
+}
+
+bool CursesUI::takeSnapshot(Snapshot& s) {
+	bool changed = false;
+	uint64_t changes = Sequencer::stateChanges.load(std::memory_order_acquire);
+	const std::vector<Sequence*>& list = sequencer.getListOfAllSequences();
+	if(changes != s.stateChanges || list.size() != s.states.size()) {
+		s.stateChanges = changes;
+		s.states.resize(list.size());
+		s.names.resize(list.size());
+		for(std::size_t i = 0; i < list.size(); i++) {
+			s.states[i] = list[i]->getState();
+			if(s.names[i].empty()) s.names[i] = list[i]->getName();
+		}
+		changed = true;
+	}
+	SafetyLevel* level = safetySystem != nullptr ? &safetySystem->getCurrentLevel() : nullptr;
+	if(level != s.level) {
+		s.level = level;
+		changed = true;
+	}
+	uint64_t messages = messageCount.load(std::memory_order_acquire);
+	if(messages != s.messages) {
+		s.messages = messages;
+		changed = true;
+	}
+	return changed;
 }
 
-void CursesUI::updateScreen() {
+void CursesUI::updateScreen(const Snapshot& s) {
 	printHeader();
-	printSequenceList(0);
+	printSequenceList(s);
 	printMessageList();
-	printStatus();
-	printCommandList();
+	printStatus(s);
+	printCommandList(s);
 	printFooter("");
 	refresh();
 }
 
+void CursesUI::layout() {
+	headerStart = 0;
+	footerStart = LINES - FOOTER_LINES;
+	sequenceListStart = HEADER_LINES + 1;
+	commandListStart = footerStart - MAX_NOF_COMMANDS / 2 - 1;
+	statusStart = commandListStart - STATUS_LINES;
+	messageListStart = statusStart - MESSAGE_LINES;
+	lines.assign(LINES > 0 ? LINES : 0, {0, ""});
+	clear();
+	dirty = true;
+}
+
 void CursesUI::initScreen() {
 	initscr();
 	atexit(closeUI);
@@ -200,119 +176,73 @@ void CursesUI::initScreen() {
 	noecho();
 	cbreak();
 	timeout(INPUT_TIMEOUT);
-	
+
 	init_pair(1, COLOR_WHITE, COLOR_BLACK); // Default
 	init_pair(2, COLOR_BLACK, COLOR_WHITE);   // Title
 	init_pair(3, COLOR_GREEN, COLOR_BLACK); // Available
 	init_pair(4, COLOR_RED, COLOR_BLACK);   // Not available
 	init_pair(5, COLOR_WHITE, COLOR_RED);   // Header and footer
-	
-	headerStart = 0;
-	footerStart = LINES - FOOTER_LINES;
-	sequenceListStart = HEADER_LINES + 1;
-	commandListStart = footerStart - MAX_NOF_COMMANDS / 2 - 1;
-	statusStart = commandListStart - STATUS_LINES;
-	messageListStart = statusStart - MESSAGE_LINES;
+
+	layout();
 }
 
 void CursesUI::run() {
-		log.trace() << "UI '" << "' bbbbbbbbbbbbbbbbbbbbbbbbbbbb.";
-	
-	// idle state
-	std::chrono::milliseconds sleepDuration(100);
-	while(state == idle) {
-		usleep(sleepDuration.count() * 1000);
+	// idle state, sleeps until displayed or exited
+	while(state == idle) wakeup.wait();
+	if(state != active) {
+		state = stopped;
+		return;
 	}
-	
+
 	// active state
 	initScreen();
-
-	while(state != active) {
+	Snapshot next;
+	while(state == active) {
 		int c = getch();
-		char input[10];
 		switch(c) {
-// 			case KEY_F(2):
-// 				if(checkCmdToggleIsActive()) sequencer.toggleMode();
-// 				updateScreen();
-// 				break;
-// 			case KEY_F(3):
-// 				if(checkCmdProceedIsActive()) sequencer.proceed();
-// 				updateScreen();
-// 				break;
-// 			case KEY_F(4):
-// 				if(checkCmdAbortIsActive()) sequencer.abort();
-// 				updateScreen();
-// 				break;
-// 			case KEY_F(5):
-// 				if(checkCmdChooseSeqIsActive()){
-// 					while(!sequencer.start(promptForInt("Enter sequence number:")));
-// 				}
-// 				break;
-// 			case 27: // Esc
-// 			case KEY_F(10):
-// 				sequencer.stepMode();
-// 				sequencer.abort();
-// 				while(sequencer.getState() != state::idle);
-// 				sequencer.shutdown();
-// 				exit();
-// 				break;
-// 			default:
-// 				if(sequencer.getState() != cachedState || sequencer.getMode() != cachedMode || messageListUpdated) {
-// 					updateScreen();
-// 					cachedState = sequencer.getState();
-// 					cachedMode = sequencer.getMode();
-// 					messageListUpdated = false;
-// 				}
-// 				break;
+			case KEY_F(4):
+				if(checkCmdAbortIsActive(shown)) sequencer.abort();
+				break;
+			case 27: // Esc
+			case KEY_F(10):
+				sequencer.abort();
+				exit();
+				break;
+			case KEY_RESIZE:
+				layout();
+				break;
+			default:
+				break;
+		}
+		if(state != active) break;
+
+		// batch all changes since the last redraw, at most with the maximum refresh rate
+		uint64_t now = System::getClockNs();
+		if(now - lastRedrawNs < minRedrawPeriodNs) continue;
+		if(takeSnapshot(next) || dirty) {
+			shown = next;
+			updateScreen(shown);
+			dirty = false;
+			lastRedrawNs = now;
 		}
 	}
-	
+
 	// stopping
 	state = stopped;
 }
 
-bool CursesUI::checkCmdToggleIsActive() {
-// 	return sequencer.getState() == state::executing || sequencer.getState() == state::waiting;
-}
-
-bool CursesUI::checkCmdAbortIsActive() {
-// 	return sequencer.getState() == state::executing || sequencer.getState() == state::waiting;
-}
-
-bool CursesUI::checkCmdProceedIsActive() {
-// 	return sequencer.getState() == state::waiting && sequencer.getMode() == mode::stepping;
-}
-
-bool CursesUI::checkCmdChooseSeqIsActive() {
-// 	return sequencer.getState() == state::idle && sequencer.getMode() == mode::stepping;
+bool CursesUI::checkCmdAbortIsActive(const Snapshot& s) {
+	for(auto st : s.states) {
+		if(st == SequenceState::running || st == SequenceState::starting) return true;
+	}
+	return false;
 }
 
 void CursesUI::addMessage(std::string message) {
+	std::lock_guard<std::mutex> lock(messageMutex);
 	messageList.push_back(message);
 	if(messageList.size() > MESSAGE_LINES - 1) {
 		messageList.pop_front();
 	}
-	messageListUpdated = true;
+	messageCount.fetch_add(1, std::memory_order_release);
 }
-
-int CursesUI::promptForInt(std::string message) {
-	char input[10];
-	printFooter(message);
-	nocbreak();
-	timeout(-1);
-	echo();
-	mvgetstr(LINES - 1, message.size() + 2, input);
-	cbreak();
-	noecho();
-	timeout(INPUT_TIMEOUT);
-	printFooter("");
-	return atoi(input);
-}
-
-// double CursesUI::promptForDouble(std::string message) {
-// 	
-// }
-// 
-// bool CursesUI::promptConfirm(std::string message) {
-// 	
-// }
@@ -66,3 +66,61 @@ TEST(configFile, string) {
 	EXPECT_EQ(config.str, std::string("test string 1"));
 }
 
+namespace {
+	class TableConfig : public eeros::config::FileConfig {
+	public:
+		TableConfig(const char *name) : FileConfig(name) {
+			add("gain", gain);
+			add("offsets", offsets);
+			add("table", table);
+			add("index", index);
+		}
+		
+		double gain;
+		std::array<double, 3> offsets;
+		std::vector<double> table;
+		std::vector<int> index;
+	};
+}
+
+TEST(configFile, arrays) {
+	TableConfig config("tableConfig.txt");
+	config.gain = 0.1;
+	config.offsets = {1.0 / 3, -2.5e-7, 4};
+	for (int i = 0; i < 20000; i++) {
+		config.table.push_back(i * 0.001);
+		config.index.push_back(-i);
+	}
+	EXPECT_TRUE(config.save());
+	
+	TableConfig loaded("tableConfig.txt");
+	EXPECT_TRUE(loaded.load());
+	EXPECT_EQ(loaded.gain, 0.1);
+	EXPECT_EQ(loaded.offsets, config.offsets);
+	EXPECT_EQ(loaded.table, config.table);
+	EXPECT_EQ(loaded.index, config.index);
+}
+
+TEST(configFile, parsing) {
+	{
+		std::ofstream file("parseConfig.txt");
+		file << "gain = +2.5\n\n  offsets = 1,2 ,  3\ntable = \nunknown = 7\nindex = 4,5\n";
+	}
+	TableConfig config("parseConfig.txt");
+	config.table = {1, 2};
+	EXPECT_TRUE(config.load());
+	EXPECT_EQ(config.gain, 2.5);
+	EXPECT_EQ(config.offsets, (std::array<double, 3>{1, 2, 3}));
+	EXPECT_TRUE(config.table.empty());
+	EXPECT_EQ(config.index, (std::vector<int>{4, 5}));
+	{
+		std::ofstream file("parseConfig.txt");
+		file << "offsets = 1, 2, 3, 4\n";
+	}
+	EXPECT_THROW(config.load(), eeros::Fault);
+	{
+		std::ofstream file("parseConfig.txt");
+		file << "gain = x\n";
+	}
+	EXPECT_THROW(config.load(), eeros::Fault);
+}
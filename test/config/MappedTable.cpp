@@ -0,0 +1,85 @@
+#include <eeros/config/FileConfig.hpp>
+#include <eeros/config/MappedTable.hpp>
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <vector>
+
+using namespace eeros::config;
+
+namespace {
+	class CalibrationConfig : public FileConfig {
+	public:
+		CalibrationConfig(const char *name) : FileConfig(name) {
+			add("gain", gain);
+			add("cogging", cogging);
+			add("steps", steps);
+		}
+		
+		double gain = 0;
+		std::span<const double> cogging;
+		std::span<const int32_t> steps;
+	};
+	
+	void writeTables(const char* path) {
+		std::vector<double> cogging;
+		for (int i = 0; i < 1000; i++) cogging.push_back(i * 0.5);
+		MappedTable::Writer w;
+		w.add("cogging", cogging, {10, 100});
+		w.add("steps", std::vector<int32_t>{1, -2, 3});
+		w.add("empty", std::vector<float>{});
+		ASSERT_TRUE(w.save(path));
+	}
+}
+
+TEST(configMappedTable, writeAndMap) {
+	writeTables("tables.bin");
+	MappedTable t("tables.bin");
+	EXPECT_TRUE(t.has("cogging"));
+	EXPECT_FALSE(t.has("missing"));
+	EXPECT_EQ(t.getNames(), (std::vector<std::string>{"cogging", "steps", "empty"}));
+	EXPECT_EQ(t.getShape("cogging"), (std::vector<uint32_t>{10, 100}));
+	auto c = t.get<double>("cogging");
+	ASSERT_EQ(c.size(), 1000);
+	EXPECT_EQ(c[999], 499.5);
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(c.data()) % 64, 0);
+	auto s = t.get<int32_t>("steps");
+	EXPECT_EQ(std::vector<int32_t>(s.begin(), s.end()), (std::vector<int32_t>{1, -2, 3}));
+	EXPECT_TRUE(t.get<float>("empty").empty());
+	EXPECT_THROW(t.get<float>("steps"), eeros::Fault);
+	EXPECT_THROW(t.get<double>("missing"), eeros::Fault);
+}
+
+TEST(configMappedTable, invalid) {
+	MappedTable::Writer w;
+	EXPECT_THROW(w.add("shape", std::vector<double>{1, 2, 3}, {2, 2}), eeros::Fault);
+	EXPECT_THROW(w.add(std::string(100, 'x'), std::vector<double>{1}), eeros::Fault);
+	w.add("a", std::vector<double>{1});
+	EXPECT_THROW(w.add("a", std::vector<double>{2}), eeros::Fault);
+	
+	EXPECT_THROW(MappedTable("noSuchTables.bin"), eeros::Fault);
+	{
+		std::ofstream file("noTables.bin");
+		file << "gain = 1\n" << std::string(100, ' ');
+	}
+	EXPECT_THROW(MappedTable("noTables.bin"), eeros::Fault);
+}
+
+TEST(configMappedTable, config) {
+	writeTables("tables.bin");
+	{
+		std::ofstream file("calibration.txt");
+		file << "gain = 2\ncogging = tables.bin\nsteps = tables.bin  \n";
+	}
+	CalibrationConfig config("calibration.txt");
+	EXPECT_TRUE(config.load());
+	EXPECT_EQ(config.gain, 2);
+	ASSERT_EQ(config.cogging.size(), 1000);
+	EXPECT_EQ(config.cogging[1], 0.5);
+	EXPECT_EQ(config.steps[1], -2);
+	EXPECT_TRUE(config.save("calibration2.txt"));
+	
+	CalibrationConfig copy("calibration2.txt");
+	EXPECT_TRUE(copy.load());
+	EXPECT_EQ(copy.cogging[999], 499.5);
+}
@@ -0,0 +1,92 @@
+#include <eeros/control/BatchRunner.hpp>
+#include <eeros/control/Constant.hpp>
+#include <eeros/control/Gain.hpp>
+#include <eeros/control/I.hpp>
+#include <eeros/control/TimeDomain.hpp>
+#include <eeros/core/Fault.hpp>
+#include <gtest/gtest.h>
+
+using namespace eeros;
+using namespace eeros::control;
+
+namespace {
+
+// integrates a constant k, the fast domain scales the integral with a gain
+class Ramp : public BatchInstance {
+ public:
+  Ramp(unsigned int k) : c(k), g(2.0), slow("slow", 0.004, false), fast("fast", 0.001, false) {
+    i.getIn().connect(c.getOut());
+    i.setInitCondition(0);
+    i.enable();
+    g.getIn().connect(i.getOut());
+    slow.addBlock(c);
+    slow.addBlock(i);
+    fast.addBlock(g);
+    addTimeDomain(slow);
+    addTimeDomain(fast);
+    record(i.getOut(), "integral");
+    record(g.getOut(), "gain");
+  }
+  Constant<> c;
+  I<> i;
+  Gain<> g;
+  TimeDomain slow, fast;
+};
+
+}
+
+TEST(controlBatchRunnerTest, simulatedTime) {
+  BatchRunner runner(0.001, 4);
+  EXPECT_EQ(runner.getNofThreads(), 4u);
+  auto results = runner.run(8, 1000, [](unsigned int k) { return std::make_unique<Ramp>(k); });
+  ASSERT_EQ(results.size(), 8u);
+  for (unsigned int k = 0; k < 8; k++) {
+    const BatchResult& r = results[k];
+    ASSERT_EQ(r.getNofSamples(), 1000u);
+    EXPECT_DOUBLE_EQ(r.get("time", 0), 0.001);
+    EXPECT_DOUBLE_EQ(r.get("time", 999), 1.0);
+    // the slow domain runs in steps 1, 5, 9 ..., the first run does not integrate
+    EXPECT_NEAR(r.get("integral", 3), 0, 1e-12);
+    EXPECT_NEAR(r.get("integral", 4), 0.004 * k, 1e-12);
+    EXPECT_NEAR(r.get("integral", 999), 0.996 * k, 1e-9);
+    EXPECT_NEAR(r.get("gain", 999), 2 * 0.996 * k, 1e-9);
+  }
+}
+
+TEST(controlBatchRunnerTest, recordEveryAndDone) {
+  struct Limited : Ramp {
+    Limited(unsigned int k) : Ramp(k) { }
+    bool done() override { return ++steps == 30; }
+    int steps = 0;
+  };
+  BatchRunner runner(0.001, 2);
+  auto results = runner.run(3, 1000, [](unsigned int k) { return std::make_unique<Limited>(k); }, 10);
+  for (auto& r : results) {
+    EXPECT_EQ(r.getNofSamples(), 3u);
+    EXPECT_EQ(r.getColumn("time").size(), 3u);
+    EXPECT_DOUBLE_EQ(r.get("time", 2), 0.03);
+    EXPECT_TRUE(r.hasColumn("gain"));
+    EXPECT_FALSE(r.hasColumn("other"));
+    EXPECT_THROW(r.getColumn("other"), Fault);
+  }
+}
+
+TEST(controlBatchRunnerTest, errors) {
+  struct Unconnected : BatchInstance {
+    Unconnected() : td("td", 0.001, false) {
+      g.setName("g");
+      td.addBlock(g);
+      addTimeDomain(td);
+    }
+    Gain<> g;
+    TimeDomain td;
+  };
+  BatchRunner runner(0.001, 2);
+  EXPECT_THROW(runner.run(4, 10, [](unsigned int) { return std::make_unique<Unconnected>(); }), Fault);
+
+  struct Odd : Ramp {
+    Odd() : Ramp(1) { }
+  };
+  BatchRunner coarse(0.003, 1);
+  EXPECT_THROW(coarse.run(1, 10, [](unsigned int) { return std::make_unique<Odd>(); }), Fault);
+}
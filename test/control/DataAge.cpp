@@ -0,0 +1,57 @@
+#include <eeros/control/DataAge.hpp>
+#include <eeros/control/Sum.hpp>
+#include <eeros/control/Mul.hpp>
+#include <eeros/control/Constant.hpp>
+#include <eeros/core/System.hpp>
+#include <gtest/gtest.h>
+
+using namespace eeros;
+using namespace eeros::control;
+
+// Test age of a signal with a fixed timestamp
+TEST(controlDataAgeTest, age) {
+  Constant<> c(1.0);
+  DataAge<> a;
+  a.getIn().connect(c.getOut());
+  timestamp_t stamp = System::getTimeNs() - 5000000;
+  c.run();
+  c.getOut().getSignal().setTimestamp(stamp);
+  a.run();
+  a.run();
+  EXPECT_GE(a.getLastAge(), 0.005);
+  EXPECT_LT(a.getLastAge(), 1.0);
+  EXPECT_GE(a.getMaxAge(), a.getLastAge());
+  EXPECT_EQ(a.getDistribution().count, 2u);
+  a.reset();
+  a.run();
+  EXPECT_EQ(a.getDistribution().count, 1u);
+}
+
+// Test signals without a timestamp are ignored
+TEST(controlDataAgeTest, unstamped) {
+  Constant<> c(1.0);
+  DataAge<> a;
+  a.getIn().connect(c.getOut());
+  c.run();
+  c.getOut().getSignal().setTimestamp(0);
+  a.run();
+  EXPECT_EQ(a.getDistribution().count, 0u);
+  EXPECT_EQ(a.getMaxAge(), 0.0);
+}
+
+// Test blocks with several inputs propagate the oldest timestamp
+TEST(controlDataAgeTest, oldestInput) {
+  Constant<> c1(1.0), c2(2.0);
+  Sum<> s;
+  Mul<> m;
+  s.getIn(0).connect(c1.getOut());
+  s.getIn(1).connect(c2.getOut());
+  m.getIn1().connect(c1.getOut());
+  m.getIn2().connect(c2.getOut());
+  c1.getOut().getSignal().set(1.0, 2000);
+  c2.getOut().getSignal().set(2.0, 1000);
+  s.run();
+  m.run();
+  EXPECT_EQ(s.getOut().getSignal().getTimestamp(), 1000u);
+  EXPECT_EQ(m.getOut().getSignal().getTimestamp(), 1000u);
+}
@@ -67,3 +67,16 @@ TEST(controlDeMuxTest, vector) {
   EXPECT_TRUE(Utils::compareApprox(dm.getOut(1).getSignal().getValue()[0], 2.1, 0.0001));
   EXPECT_TRUE(Utils::compareApprox(dm.getOut(1).getSignal().getValue()[1], 2.2, 0.0001));
 }
+
+// Test that all outputs get the timestamp of the input
+TEST(controlDeMuxTest, timestamp) {
+  Constant<Matrix<3,1,double>> c0;
+  DeMux<3> dm;
+  dm.getIn().connect(c0.getOut());
+  c0.getOut().getSignal().set(Matrix<3,1,double>{1.0, 2.0, 3.0}, 1234);
+  dm.run();
+  for (unsigned int i = 0; i < 3; i++) {
+    EXPECT_EQ(dm.getOut(i).getSignal().getValue(), i + 1.0);
+    EXPECT_EQ(dm.getOut(i).getSignal().getTimestamp(), 1234);
+  }
+}
@@ -0,0 +1,69 @@
+#include <eeros/control/ElementPool.hpp>
+#include <eeros/control/Gain.hpp>
+#include <eeros/control/Saturation.hpp>
+#include <eeros/control/Constant.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <vector>
+
+using namespace eeros;
+using namespace eeros::control;
+using namespace eeros::math;
+
+// The ranges cover every element exactly once
+TEST(controlElementPoolTest, ranges) {
+  ElementPool pool({0, 0, 0}, 16);
+  EXPECT_EQ(pool.getThreads(), 4u);
+  for (unsigned int n : {0u, 10u, 31u, 32u, 100u, 1001u}) {
+    std::vector<std::atomic<int>> hits(n);
+    std::atomic<int> calls{0};
+    pool.forEach(n, [&](unsigned int b, unsigned int e) {
+      calls++;
+      for (unsigned int i = b; i < e; i++) hits[i]++;
+    });
+    for (unsigned int i = 0; i < n; i++) EXPECT_EQ(hits[i], 1) << "n=" << n << " i=" << i;
+    if (n < 32) EXPECT_EQ(calls, 1);
+    else EXPECT_GT(calls, 1);
+  }
+}
+
+// Without helpers, all elements are processed by the calling thread
+TEST(controlElementPoolTest, noHelpers) {
+  ElementPool pool({}, 8);
+  int calls = 0;
+  pool.forEach(1000, [&](unsigned int b, unsigned int e) { calls++; EXPECT_EQ(b, 0u); EXPECT_EQ(e, 1000u); });
+  EXPECT_EQ(calls, 1);
+}
+
+// A split gain and saturation give the same result as the serial ones
+TEST(controlElementPoolTest, blocks) {
+  using M = Matrix<64, 64>;
+  ElementPool pool({0, 0}, 256);
+  M value, lower, upper, gain;
+  for (unsigned int i = 0; i < value.size(); i++) {
+    value[i] = i * 0.01 - 20;
+    lower[i] = -10;
+    upper[i] = 10;
+    gain[i] = i % 7;
+  }
+  Constant<M> c(value);
+  c.run();
+  Gain<M> g1(2), g2(2);
+  Gain<M, M, true> e1(gain), e2(gain);
+  Saturation<M> s1(lower, upper), s2(lower, upper);
+  g2.setElementPool(&pool);
+  e2.setElementPool(&pool);
+  s2.setElementPool(&pool);
+  for (Block* b : std::vector<Block*>{&g1, &g2, &e1, &e2, &s1, &s2}) {
+    if (auto g = dynamic_cast<Blockio<1,1,M,M>*>(b)) g->getIn().connect(c.getOut());
+    b->run();
+  }
+  for (unsigned int i = 0; i < value.size(); i++) {
+    EXPECT_EQ(g2.getOut().getSignal().getValue()[i], g1.getOut().getSignal().getValue()[i]);
+    EXPECT_EQ(e2.getOut().getSignal().getValue()[i], e1.getOut().getSignal().getValue()[i]);
+    EXPECT_EQ(s2.getOut().getSignal().getValue()[i], s1.getOut().getSignal().getValue()[i]);
+  }
+  EXPECT_EQ(g2.getOut().getSignal().getValue()[5], 2 * value[5]);
+  EXPECT_EQ(s2.getOut().getSignal().getValue()[0], -10);
+}
@@ -0,0 +1,81 @@
+#include <eeros/control/FusedBlock.hpp>
+#include <eeros/control/TimeDomain.hpp>
+#include <eeros/control/Constant.hpp>
+#include <eeros/control/Gain.hpp>
+#include <eeros/control/Sum.hpp>
+#include <eeros/control/Saturation.hpp>
+#include <eeros/core/Fault.hpp>
+#include <gtest/gtest.h>
+
+using namespace eeros;
+using namespace eeros::control;
+
+// A fused chain replaces its members in a frozen time domain and gives the same results
+TEST(controlFusedBlockTest, timeDomain) {
+  TimeDomain td("td", 0.1, false);
+  Constant<> ref(0.3), fb(0.1);
+  Sum<2> s;
+  Gain<> g(10.0);
+  Saturation<> sat(-1.0, 1.0);
+  s.negateInput(1);
+  s.getIn(0).connect(ref.getOut());
+  s.getIn(1).connect(fb.getOut());
+  g.getIn().connect(s.getOut());
+  sat.getIn().connect(g.getOut());
+  FusedBlock<Sum<2>, Gain<>, Saturation<>> axis(s, g, sat);
+  axis.setName("axis");
+  td.addBlock(ref);
+  td.addBlock(fb);
+  td.addBlock(s);
+  td.addBlock(g);
+  td.addBlock(sat);
+  td.addFusedBlock(axis);
+  td.setFrozen(true);
+  td.run();
+  auto& b = td.getBlocks();
+  ASSERT_EQ(b.size(), 3u);
+  EXPECT_EQ(b[2], &axis);
+  // the members keep their outputs
+  EXPECT_DOUBLE_EQ(s.getOut().getSignal().getValue(), 0.2);
+  EXPECT_DOUBLE_EQ(g.getOut().getSignal().getValue(), 2.0);
+  EXPECT_DOUBLE_EQ(sat.getOut().getSignal().getValue(), 1.0);
+  ref.setValue(0.12);
+  td.run();
+  EXPECT_DOUBLE_EQ(sat.getOut().getSignal().getValue(), 0.2);
+  // without the fused block the members run on their own
+  td.removeFusedBlock(axis);
+  td.run();
+  EXPECT_EQ(td.getBlocks().size(), 5u);
+}
+
+// Only chains can be fused
+TEST(controlFusedBlockTest, chain) {
+  Constant<> c(1);
+  Gain<> g1(2), g2(3);
+  g1.getIn().connect(c.getOut());
+  g2.getIn().connect(c.getOut());
+  EXPECT_THROW((FusedBlock<Gain<>, Gain<>>(g1, g2)), Fault);
+  g2.getIn().disconnect();
+  g2.getIn().connect(g1.getOut());
+  EXPECT_NO_THROW((FusedBlock<Gain<>, Gain<>>(g1, g2)));
+}
+
+// All blocks the members read from must run before the fused block
+TEST(controlFusedBlockTest, order) {
+  TimeDomain td("td", 0.1, false);
+  Constant<> c1(1), c2(2);
+  Gain<> g(2);
+  Sum<2> s;
+  g.getIn().connect(c1.getOut());
+  s.getIn(0).connect(g.getOut());
+  s.getIn(1).connect(c2.getOut());
+  FusedBlock<Gain<>, Sum<2>> fused(g, s);
+  td.addBlock(c1);
+  td.addBlock(g);
+  td.addBlock(s);
+  // read by the sum with one cycle delay, runs after the first member
+  td.addBlock(c2);
+  td.addFusedBlock(fused);
+  td.setFrozen(true);
+  EXPECT_THROW(td.run(), Fault);
+}
@@ -1,6 +1,7 @@
 #include <eeros/control/Gain.hpp>
 #include <eeros/control/Constant.hpp>
 #include <eeros/math/Matrix.hpp>
+#include <eeros/math/StructuredMatrix.hpp>
 #include <Utils.hpp>
 #include <gtest/gtest.h>
 
@@ -435,6 +436,53 @@ TEST(controlGainTest, smoothChangingMatrixGainMinMaxLimits) {
   EXPECT_DOUBLE_EQ (res2[3],1);
 }
 
+TEST(controlGainTest, diagonalMatrixGain) {
+  Gain<Matrix<3,1>,DiagonalMatrix<3>> g1{DiagonalMatrix<3>(Matrix<3,1>{1,2,3})};
+  Constant<Matrix<3,1>> c1{};
+  c1.getOut().getSignal().set(Matrix<3,1>{1,1,2}, 0);
+  g1.getIn().connect(c1.getOut());
+  g1.run();
+  EXPECT_EQ(g1.getOut().getSignal().getValue(), (Matrix<3,1>{1,2,6}));
+  g1.enableSmoothChange(true);
+  g1.setGain(DiagonalMatrix<3>(Matrix<3,1>{2,3,4}));
+  g1.setGainDiff(DiagonalMatrix<3>(0.5));
+  g1.run(); // gain at [1.5,2.5,3.5]
+  EXPECT_EQ(g1.getOut().getSignal().getValue(), (Matrix<3,1>{1.5,2.5,7}));
+  g1.run();
+  g1.run(); // target reached
+  EXPECT_EQ(g1.getOut().getSignal().getValue(), (Matrix<3,1>{2,3,8}));
+  g1.setMaxGain(DiagonalMatrix<3>(1.0));
+  g1.run();
+  EXPECT_EQ(g1.getOut().getSignal().getValue(), (Matrix<3,1>{1,1,2}));
+}
+
+TEST(controlGainTest, blockDiagonalMatrixGain) {
+  BlockDiagonalMatrix<2,2> gB{Matrix<2,2>{2,0,1,2}, Matrix<2,2>{1,0,0,-1}};
+  Gain<Matrix<4,1>,BlockDiagonalMatrix<2,2>> g1{gB};
+  Constant<Matrix<4,1>> c1{};
+  c1.getOut().getSignal().set(Matrix<4,1>{1,2,3,4}, 0);
+  g1.getIn().connect(c1.getOut());
+  g1.run();
+  EXPECT_EQ(g1.getOut().getSignal().getValue(), (Matrix<4,1>{4,4,3,-4}));
+}
+
+TEST(controlGainTest, sparseMatrixGain) {
+  using Sparse = SparseMatrix<3,3,4>;
+  Gain<Matrix<3,1>,Sparse> g1{Sparse{{0,0,1}, {0,2,1}, {1,1,2}, {2,0,-1}}};
+  Constant<Matrix<3,1>> c1{};
+  c1.getOut().getSignal().set(Matrix<3,1>{1,2,3}, 0);
+  g1.getIn().connect(c1.getOut());
+  g1.run();
+  EXPECT_EQ(g1.getOut().getSignal().getValue(), (Matrix<3,1>{4,4,-1}));
+  g1.enableSmoothChange(true);
+  g1.setGain(Sparse{{0,0,2}, {0,2,2}, {1,1,3}, {2,0,0}});
+  g1.setGainDiff(Sparse{{0,0,1}, {0,2,1}, {1,1,1}, {2,0,1}});
+  g1.run();
+  EXPECT_EQ(g1.getOut().getSignal().getValue(), (Matrix<3,1>{8,6,0}));
+  g1.run(); // should not change anything since reached targetGain
+  EXPECT_EQ(g1.getOut().getSignal().getValue(), (Matrix<3,1>{8,6,0}));
+}
+
 TEST(controlGainTest, parabolicDouble) {
   Gain<> g1{5};
   Constant<> c1{1};
@@ -1,4 +1,4 @@
-// #include <eeros/control/filter/KalmanFilter.hpp>
+#include <eeros/control/filter/KalmanFilter.hpp>
 #include <eeros/core/Fault.hpp>
 #include <eeros/math/Matrix.hpp>
 #include <eeros/control/Constant.hpp>
@@ -45,3 +45,174 @@ TEST(controlKLFTest, input) {
 }
 
 
+
+namespace {
+
+using Filter = KalmanFilter<1, 1, 2, 1>;
+
+// Position and velocity of a mass driven by a force, the position is measured
+class Plant {
+ public:
+  Plant() : kf(Matrix<2, 2>{1.0, 0.0, 0.01, 1.0}, Matrix<2, 1>{0.00005, 0.01}, Matrix<1, 2>{1.0, 0.0},
+               Matrix<2, 1>{0.00005, 0.01}, Matrix<1, 1>{0.5}, Matrix<1, 1>{0.01}),
+            u(0.5), y(0.0) {
+    kf.getU(0).connect(u.getOut());
+    kf.getY(0).connect(y.getOut());
+  }
+
+  void step(double measurement) {
+    y.setValue(measurement);
+    u.run();
+    y.run();
+    kf.correction();
+    kf.prediction();
+  }
+
+  Filter kf;
+  Constant<> u, y;
+};
+
+}
+
+// The steady state gain is the limit of the gain updated in every cycle
+TEST(controlKLFTest, steadyState) {
+  Plant standard, steady;
+  steady.kf.setMode(Filter::Mode::steadyState);
+  EXPECT_EQ(steady.kf.getMode(), Filter::Mode::steadyState);
+  for (int i = 0; i < 2000; i++) standard.step(0.001 * i);
+  Matrix<2, 1> k = standard.kf.getGain(), kss = steady.kf.getGain();
+  EXPECT_NEAR(k(0), kss(0), 1e-7);
+  EXPECT_NEAR(k(1), kss(1), 1e-7);
+  Matrix<2, 2> p = steady.kf.getCovariance();
+  for (int i = 0; i < 2000; i++) steady.step(0.001 * i);
+  EXPECT_EQ(steady.kf.getCovariance(), p);
+  EXPECT_NEAR(standard.kf.getX(0).getSignal().getValue(), steady.kf.getX(0).getSignal().getValue(), 1e-6);
+  EXPECT_NEAR(standard.kf.getX(1).getSignal().getValue(), steady.kf.getX(1).getSignal().getValue(), 1e-5);
+}
+
+// The Joseph form gives the same estimate as the standard update
+TEST(controlKLFTest, joseph) {
+  Plant standard, joseph;
+  joseph.kf.setMode(Filter::Mode::joseph);
+  for (int i = 0; i < 500; i++) {
+    standard.step(std::sin(0.01 * i));
+    joseph.step(std::sin(0.01 * i));
+  }
+  Matrix<2, 2> p = standard.kf.getCovariance(), pj = joseph.kf.getCovariance();
+  for (unsigned int i = 0; i < 4; i++) EXPECT_NEAR(p(i), pj(i), 1e-9);
+  EXPECT_NEAR(pj(0, 1), pj(1, 0), 1e-15);
+  EXPECT_NEAR(standard.kf.getX(0).getSignal().getValue(), joseph.kf.getX(0).getSignal().getValue(), 1e-9);
+}
+
+// The iteration for the steady state gain is limited
+TEST(controlKLFTest, steadyStateIterations) {
+  Plant plant;
+  plant.kf.setName("kf");
+  try {
+    plant.kf.setMode(Filter::Mode::steadyState, 2);
+    FAIL();
+  } catch (eeros::Fault const& err) {
+    EXPECT_EQ(err.what(), std::string("Steady state gain of block 'kf' did not converge"));
+  }
+  EXPECT_EQ(plant.kf.getMode(), Filter::Mode::standard);
+}
+
+namespace {
+
+using Filter2 = KalmanFilter<1, 2, 2, 1>;
+
+// Position and velocity of the same mass, the position is measured by a second sensor as well
+class Plant2 {
+ public:
+  Plant2(Matrix<2, 2> R)
+      : kf(Matrix<2, 2>{1.0, 0.0, 0.01, 1.0}, Matrix<2, 1>{0.00005, 0.01}, Matrix<2, 2>{1.0, 1.0, 0.0, 0.0},
+           Matrix<2, 1>{0.00005, 0.01}, Matrix<1, 1>{0.5}, R),
+        u(0.5) {
+    kf.getU(0).connect(u.getOut());
+    kf.getY(0).connect(y[0]);
+    kf.getY(1).connect(y[1]);
+    kf.setAsynchronous(true);
+  }
+
+  void measure(int i, double value, timestamp_t time) {
+    y[i].getSignal().setValue(value);
+    y[i].getSignal().setTimestamp(time);
+  }
+
+  void step() {
+    u.run();
+    kf.correction();
+    kf.prediction();
+  }
+
+  Filter2 kf;
+  Constant<> u;
+  Output<double> y[2];
+};
+
+}
+
+// Only new measurements are used, a filter with a stale sensor equals a filter without it
+TEST(controlKLFTest, asynchronous) {
+  for (bool joseph : {false, true}) {
+    for (double r01 : {0.0, 0.004}) {
+      Plant single;
+      Plant2 dual(Matrix<2, 2>{0.01, r01, r01, 0.04});
+      if (joseph) {
+        single.kf.setMode(Filter::Mode::joseph);
+        dual.kf.setMode(Filter2::Mode::joseph);
+      }
+      dual.measure(1, 5.0, 1);
+      for (int i = 0; i < 300; i++) {
+        double m = std::sin(0.01 * i);
+        single.step(m);
+        dual.measure(0, m, i + 1);
+        dual.step();
+      }
+      EXPECT_NEAR(single.kf.getX(0).getSignal().getValue(), dual.kf.getX(0).getSignal().getValue(), 1e-9);
+      EXPECT_NEAR(single.kf.getX(1).getSignal().getValue(), dual.kf.getX(1).getSignal().getValue(), 1e-9);
+      Matrix<2, 2> p = single.kf.getCovariance(), pd = dual.kf.getCovariance();
+      for (unsigned int i = 0; i < 4; i++) EXPECT_NEAR(p(i), pd(i), 1e-9);
+    }
+  }
+}
+
+// Sensors at different rates, the slow one improves the estimate when it has new data
+TEST(controlKLFTest, asynchronousRates) {
+  Plant2 fast(Matrix<2, 2>{0.01, 0, 0, 0.0001}), sync(Matrix<2, 2>{0.01, 0, 0, 0.0001});
+  sync.kf.setAsynchronous(false);
+  EXPECT_FALSE(sync.kf.isAsynchronous());
+  for (int i = 0; i < 300; i++) {
+    fast.measure(0, 1.0, i + 1);
+    if (i % 10 == 0) fast.measure(1, 1.0, i + 1);
+    sync.measure(0, 1.0, i + 1);
+    sync.measure(1, 1.0, i + 1);
+    fast.step();
+    sync.step();
+  }
+  // the synchronous filter uses every sample of the slow sensor
+  EXPECT_NEAR(fast.kf.getX(0).getSignal().getValue(), 1.0, 0.05);
+  EXPECT_NEAR(sync.kf.getX(0).getSignal().getValue(), 1.0, 0.05);
+  EXPECT_GT(fast.kf.getCovariance()(0, 0), sync.kf.getCovariance()(0, 0));
+
+  // without new data the correction leaves the prediction
+  fast.step();
+  double x = fast.kf.getX(0).getSignal().getValue();
+  fast.kf.correction();
+  EXPECT_EQ(fast.kf.getX(0).getSignal().getValue(), x);
+}
+
+// In steady state mode the gains of the subsets are precomputed
+TEST(controlKLFTest, asynchronousSteadyState) {
+  Plant2 dual(Matrix<2, 2>{0.01, 0, 0, 0.04});
+  dual.kf.setMode(Filter2::Mode::steadyState);
+  Matrix<2, 2> p = dual.kf.getCovariance();
+  dual.measure(1, 5.0, 1);
+  for (int i = 0; i < 300; i++) {
+    dual.measure(0, 1.0, i + 1);
+    dual.step();
+  }
+  // follows the first sensor, the stale value of the second one is not used
+  EXPECT_NEAR(dual.kf.getX(0).getSignal().getValue(), 1.0, 0.1);
+  EXPECT_EQ(dual.kf.getCovariance(), p);
+}
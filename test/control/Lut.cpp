@@ -0,0 +1,97 @@
+#include <eeros/control/Constant.hpp>
+#include <eeros/control/Lut1D.hpp>
+#include <eeros/control/Lut2D.hpp>
+#include <eeros/config/MappedTable.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+using namespace eeros;
+using namespace eeros::control;
+using namespace eeros::math;
+
+TEST(controlLutTest, axis) {
+  LutAxis a(1.0, 0.5, 5);  // 1.0 .. 3.0
+  uint32_t i = 0;
+  EXPECT_TRUE(a.isUniform());
+  EXPECT_DOUBLE_EQ(a.locate(1.75, i), 0.5);
+  EXPECT_EQ(i, 1u);
+  EXPECT_EQ(a.locate(-5, i), 0);
+  EXPECT_EQ(i, 0u);
+  EXPECT_EQ(a.locate(3.5, i), 1);
+  EXPECT_EQ(i, 3u);
+  EXPECT_TRUE(std::isnan(a.locate(NAN, i)));
+
+  std::vector<double> x{0, 1, 3, 7, 15};
+  LutAxis b(x);
+  EXPECT_FALSE(b.isUniform());
+  i = 0;
+  for (double u : {0.5, 2.0, 5.0, 11.0, 6.0, 0.1, 14.0}) {
+    double f = b.locate(u, i);
+    EXPECT_LE(x[i], u);
+    EXPECT_LT(u, x[i + 1]);
+    EXPECT_DOUBLE_EQ(x[i] + f * (x[i + 1] - x[i]), u);
+  }
+  std::vector<double> y{0, 0.25, 0.5, 0.75};
+  EXPECT_TRUE(LutAxis(y).isUniform());
+  EXPECT_THROW(LutAxis(std::vector<double>{0, 1, 1}), Fault);
+  EXPECT_THROW(LutAxis(0, 0, 4), Fault);
+  EXPECT_THROW(LutAxis(0, 1, 1), Fault);
+}
+
+TEST(controlLutTest, lut1D) {
+  Constant<> c(1.25);
+  Lut1D<> lut(0.0, 0.5, std::vector<double>{0, 1, 4, 9});
+  lut.getIn().connect(c.getOut());
+  c.run();
+  lut.run();
+  EXPECT_DOUBLE_EQ(lut.getOut().getSignal().getValue(), 6.5);
+  c.setValue(10);
+  c.run();
+  lut.run();
+  EXPECT_EQ(lut.getOut().getSignal().getValue(), 9);
+
+  Constant<Vector3> cv(Vector3{0.5, 2.0, -1.0});
+  Lut1D<Vector3> lutv(std::vector<double>{0, 1, 3}, std::vector<double>{10, 20, 0});
+  lutv.getIn().connect(cv.getOut());
+  cv.run();
+  lutv.run();
+  EXPECT_EQ(lutv.getOut().getSignal().getValue(), (Vector3{15, 10, 10}));
+  EXPECT_THROW(Lut1D<>(std::vector<double>{0, 1}, std::vector<double>{0, 1, 2}), Fault);
+}
+
+TEST(controlLutTest, lut2D) {
+  // z = x + 10 * y on x = 0, 1, 2 and y = 0, 2
+  Constant<> cx(1.5), cy(0.5);
+  Lut2D<> lut(LutAxis(0, 1, 3), LutAxis(0, 2, 2), std::vector<double>{0, 20, 1, 21, 2, 22});
+  lut.getIn(0).connect(cx.getOut());
+  lut.getIn(1).connect(cy.getOut());
+  cx.run();
+  cy.run();
+  lut.run();
+  EXPECT_DOUBLE_EQ(lut.getOut().getSignal().getValue(), 6.5);
+  EXPECT_THROW(Lut2D<>(LutAxis(0, 1, 3), LutAxis(0, 2, 2), std::vector<double>{0, 1}), Fault);
+}
+
+TEST(controlLutTest, mappedTable) {
+  config::MappedTable::Writer w;
+  w.add("x", std::vector<double>{0, 1, 2});
+  w.add("y", std::vector<double>{0, 1, 4});
+  w.add("z", std::vector<double>{0, 1, 2, 3, 4, 5, 6, 7, 8}, {3, 3});
+  ASSERT_TRUE(w.save("lutTables.bin"));
+  config::MappedTable t("lutTables.bin");
+
+  Constant<> cx(0.5), cy(2.5);
+  Lut1D<> lut1(t, "x", "y");
+  lut1.getIn().connect(cy.getOut());
+  Lut2D<> lut2(t, "x", "y", "z");
+  lut2.getIn(0).connect(cx.getOut());
+  lut2.getIn(1).connect(cy.getOut());
+  cx.run();
+  cy.run();
+  lut1.run();
+  lut2.run();
+  EXPECT_EQ(lut1.getOut().getSignal().getValue(), 4);
+  EXPECT_DOUBLE_EQ(lut2.getOut().getSignal().getValue(), 0.5 * 3 + 1.5);
+}
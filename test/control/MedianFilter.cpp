@@ -4,8 +4,11 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <limits>
 #include <sstream>
 #include <string>
+#include <vector>
 
 using namespace eeros;
 using namespace eeros::control;
@@ -321,3 +324,40 @@ TEST(controlMedianFilterTest, printMedianFilter) {
   std::string str2 = sstream.str();
   EXPECT_STREQ (str1.c_str(), str2.c_str());
 }
+
+
+TEST(controlMedianFilterTest, slidingWindow) {
+  MedianFilter<101> mf{};
+  Constant<> c1{0};
+  mf.getIn().connect(c1.getOut());
+
+  std::vector<double> window(101, 0.0);
+  unsigned int seed = 1;
+  for (int i = 0; i < 1000; i++) {
+    seed = seed * 1103515245 + 12345;
+    double value = static_cast<double>((seed >> 16) % 50) - 25.0;  // with duplicates
+    if (i % 97 == 0) value = 1000.0;                                 // spikes
+    window.erase(window.begin());
+    window.push_back(value);
+    c1.setValue(value);
+    c1.run();
+    mf.run();
+
+    std::vector<double> sorted = window;
+    std::sort(sorted.begin(), sorted.end());
+    ASSERT_DOUBLE_EQ(mf.getOut().getSignal().getValue(), sorted[50]) << "sample " << i;
+  }
+}
+
+
+TEST(controlMedianFilterTest, nanRecovery) {
+  MedianFilter<3> mf{};
+  Constant<> c1{1};
+  mf.getIn().connect(c1.getOut());
+  for (double value : {1.0, std::numeric_limits<double>::quiet_NaN(), 2.0, 3.0, 4.0, 5.0}) {
+    c1.setValue(value);
+    c1.run();
+    mf.run();
+  }
+  EXPECT_DOUBLE_EQ(mf.getOut().getSignal().getValue(), 4.0);
+}
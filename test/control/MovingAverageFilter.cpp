@@ -4,12 +4,16 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <sstream>
 #include <string>
+#include <vector>
 
 using namespace eeros;
 using namespace eeros::control;
 
+template class eeros::control::MovingAverageFilter<5, float>;
+
 
 TEST(controlMAFilterTest, templateInstantiations) {
   double dcoeffs[] = {0.5, 0.5};
@@ -147,3 +151,74 @@ TEST(controlMAFilterTest, printMAFilter) {
   std::string str2 = sstream.str();
   EXPECT_STREQ (str1.c_str(), str2.c_str());
 }
+
+
+TEST(controlMAFilterTest, circularBuffer) {
+  double coeffs[64];
+  for (unsigned int i = 0; i < 64; i++) coeffs[i] = (i + 1) / 2080.0;
+  MovingAverageFilter<64> ma{coeffs};
+  Constant<> c1{0};
+  ma.getIn().connect(c1.getOut());
+
+  std::vector<double> window(64, 0.0);
+  for (int t = 0; t < 300; t++) {
+    double value = std::sin(0.1 * t) + (t % 7);
+    window.erase(window.begin());
+    window.push_back(value);
+    c1.setValue(value);
+    c1.run();
+    ma.run();
+    double expected = 0;
+    for (unsigned int i = 0; i < 64; i++) expected += coeffs[i] * window[i];
+    ASSERT_NEAR(ma.getOut().getSignal().getValue(), expected, 1e-12) << "sample " << t;
+  }
+}
+
+
+TEST(controlMAFilterTest, uniformCoefficients) {
+  using namespace math;
+  MovingAverageFilter<4> ma{0.25};
+  MovingAverageFilter<4, Vector2, double> mv{0.25};
+  Constant<> c1{0};
+  Constant<Vector2> c2{};
+  ma.getIn().connect(c1.getOut());
+  mv.getIn().connect(c2.getOut());
+
+  double values[] = {4, 8, 12, 16, 20, 0, 0, 0, 0};
+  double expected[] = {1, 3, 6, 10, 14, 12, 9, 5, 0};
+  for (int t = 0; t < 9; t++) {
+    c1.setValue(values[t]);
+    c1.run();
+    ma.run();
+    c2.setValue(Vector2{values[t], -values[t]});
+    c2.run();
+    mv.run();
+    EXPECT_DOUBLE_EQ(ma.getOut().getSignal().getValue(), expected[t]);
+    EXPECT_DOUBLE_EQ(mv.getOut().getSignal().getValue()[0], expected[t]);
+    EXPECT_DOUBLE_EQ(mv.getOut().getSignal().getValue()[1], -expected[t]);
+  }
+
+  std::stringstream sstream{};
+  sstream << ma;
+  EXPECT_EQ(sstream.str(), "Block MovingAverageFilter: '' is enabled=1, coefficients:[0.25,0.25,0.25,0.25], previousValues:[0,0,0,0]");
+}
+
+TEST(controlMAFilterTest, floatMAFilter) {
+  float coeffs[] = {0.1f, 0.2f, 0.3f, 0.2f, 0.1f, 0.05f, 0.05f, 0.0f, 0.0f};
+  double dcoeffs[] = {0.1, 0.2, 0.3, 0.2, 0.1, 0.05, 0.05, 0.0, 0.0};
+  MovingAverageFilter<9, float> ma{coeffs};
+  MovingAverageFilter<9> mad{dcoeffs};
+  Constant<float> c;
+  Constant<> cd;
+  ma.getIn().connect(c.getOut());
+  mad.getIn().connect(cd.getOut());
+  for (int k = 0; k < 30; k++) {
+    c.setValue(std::sin(0.4f * k));
+    cd.setValue(std::sin(0.4f * k));
+    c.run();
+    cd.run();
+    ma.run();
+    mad.run();
+    EXPECT_NEAR(ma.getOut().getSignal().getValue(), mad.getOut().getSignal().getValue(), 1e-6);
+  }
+}
@@ -8,6 +8,8 @@ using namespace eeros;
 using namespace eeros::control;
 using namespace eeros::math;
 
+template class eeros::control::PathPlannerConstAcc<Matrix<2,1,float>>;
+
 
 // Test name
 TEST(controlPathPlannerConstAcc, name) {
@@ -72,3 +74,64 @@ TEST(controlPathPlannerConstAcc, init2) {
   EXPECT_TRUE(Utils::compareApprox(planner.getPosOut().getSignal().getValue()[0], 10, 1e-10));
   EXPECT_TRUE(Utils::compareApprox(planner.getPosOut().getSignal().getValue()[1], 15, 1e-10));
 }
+
+// Test that a new start is taken over at the end of the running segment
+TEST(controlPathPlannerConstAcc, setStartAtSegmentBoundary) {
+  PathPlannerConstAcc<Matrix<2,1,double>> planner({1,1}, {1,1}, {1,1}, 0.1);
+  Matrix<2,1,double> start{10, 5}, end{20, 15};
+  planner.move(start, end);
+  for (int i = 0; i < 3; i++) planner.run();
+  EXPECT_FALSE(planner.endReached());
+  EXPECT_FALSE(planner.move(start, end));
+  planner.setStart(Matrix<2,1,double>{0, 0});
+  EXPECT_TRUE(planner.endReached());
+  // the first segment lasts 1s, it is not torn
+  for (int i = 3; i < 10; i++) {
+    planner.run();
+    EXPECT_TRUE(Utils::compareApprox(planner.getAccOut().getSignal().getValue()[0], 1, 1e-10));
+  }
+  EXPECT_TRUE(Utils::compareApprox(planner.getPosOut().getSignal().getValue()[0], 10.5, 1e-10));
+  planner.run();
+  EXPECT_EQ(planner.getPosOut().getSignal().getValue()[0], 0);
+  EXPECT_EQ(planner.getVelOut().getSignal().getValue()[0], 0);
+  EXPECT_EQ(planner.getAccOut().getSignal().getValue()[0], 0);
+}
+
+// Test moving from a new start which is not yet taken over
+TEST(controlPathPlannerConstAcc, setStartAndMove) {
+  PathPlannerConstAcc<Matrix<2,1,double>> planner({1,1}, {1,1}, {1,1}, 0.1);
+  planner.setStart(Matrix<2,1,double>{10, 5});
+  EXPECT_TRUE(planner.move(Matrix<2,1,double>{20, 15}));
+  EXPECT_FALSE(planner.endReached());
+  planner.run();
+  EXPECT_TRUE(Utils::compareApprox(planner.getPosOut().getSignal().getValue()[0], 10.005, 1e-10));
+  EXPECT_TRUE(Utils::compareApprox(planner.getPosOut().getSignal().getValue()[1], 5.005, 1e-10));
+  int n = 1;
+  while (!planner.endReached() && n < 1000) {
+    planner.run();
+    n++;
+  }
+  // 10 samples accelerating, 90 at constant velocity, 10 decelerating and the end position
+  EXPECT_EQ(n, 111);
+  EXPECT_EQ(planner.getPosOut().getSignal().getValue()[0], 20);
+  // the next move starts at the end of the last one
+  EXPECT_TRUE(planner.move(Matrix<2,1,double>{10, 5}));
+  planner.run();
+  EXPECT_TRUE(Utils::compareApprox(planner.getPosOut().getSignal().getValue()[0], 19.995, 1e-10));
+}
+
+// Test a move with float values
+TEST(controlPathPlannerConstAcc, float) {
+  PathPlannerConstAcc<Matrix<2,1,float>> planner({1,1}, {1,1}, {1,1}, 0.1);
+  EXPECT_TRUE(planner.move(Matrix<2,1,float>{10, 5}, Matrix<2,1,float>{20, 15}));
+  planner.run();
+  EXPECT_NEAR(planner.getPosOut().getSignal().getValue()[0], 10.005f, 1e-5);
+  int n = 1;
+  while (!planner.endReached() && n < 1000) {
+    planner.run();
+    n++;
+  }
+  EXPECT_EQ(n, 111);
+  EXPECT_NEAR(planner.getPosOut().getSignal().getValue()[0], 20, 1e-5);
+  EXPECT_NEAR(planner.getPosOut().getSignal().getValue()[1], 15, 1e-5);
+}
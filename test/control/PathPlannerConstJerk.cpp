@@ -8,6 +8,8 @@ using namespace eeros;
 using namespace eeros::control;
 using namespace eeros::math;
 
+template class eeros::control::PathPlannerConstJerk<Matrix<3,1,float>>;
+
 
 // Test name
 TEST(controlPathPlannerConstJerk, name) {
@@ -30,3 +32,51 @@ TEST(controlPathPlannerConstJerk, nan) {
 //   EXPECT_TRUE(std::isnan(planner.getPosOut().getSignal().getValue()[1]));
 }
 
+
+// Test a move of three axes
+TEST(controlPathPlannerConstJerk, axes) {
+  PathPlannerConstJerk<Matrix<3,1,double>> planner({1,1,1}, {10,10,10}, 0.01);
+  Matrix<3,1,double> start{0, 0, 0}, end{1, 2, -1};
+  EXPECT_TRUE(planner.move(start, end));
+  Matrix<3,1,double> prevPos = start, prevVel{0, 0, 0};
+  int n = 0;
+  while (!planner.endReached() && n < 10000) {
+    planner.run();
+    Matrix<3,1,double> pos = planner.getPosOut().getSignal().getValue();
+    Matrix<3,1,double> vel = planner.getVelOut().getSignal().getValue();
+    for (unsigned int i = 0; i < 3; i++) {
+      // the axes move synchronously, no axis exceeds its limits
+      EXPECT_TRUE(Utils::compareApprox(pos[i] - start[i], (end[i] - start[i]) / 2 * pos[1], 1e-10));
+      EXPECT_LE(std::fabs(vel[i]), 1 + 1e-10);
+      // position and velocity are continuous, also between the segments
+      EXPECT_NEAR(pos[i] - prevPos[i], (vel[i] + prevVel[i]) / 2 * 0.01, 1e-4);
+    }
+    prevPos = pos;
+    prevVel = vel;
+    n++;
+  }
+  EXPECT_TRUE(planner.endReached());
+  for (unsigned int i = 0; i < 3; i++) {
+    EXPECT_DOUBLE_EQ(planner.getPosOut().getSignal().getValue()[i], end[i]);
+    EXPECT_EQ(planner.getVelOut().getSignal().getValue()[i], 0);
+  }
+}
+
+// Test a move with float values
+TEST(controlPathPlannerConstJerk, float) {
+  PathPlannerConstJerk<Matrix<3,1,float>> planner({1,1,1}, {10,10,10}, 0.01);
+  Matrix<3,1,float> start{0, 0, 0}, end{1, 2, -1};
+  EXPECT_TRUE(planner.move(start, end));
+  int n = 0;
+  while (!planner.endReached() && n < 10000) {
+    planner.run();
+    Matrix<3,1,float> vel = planner.getVelOut().getSignal().getValue();
+    for (unsigned int i = 0; i < 3; i++) EXPECT_LE(std::fabs(vel[i]), 1 + 1e-5);
+    n++;
+  }
+  EXPECT_TRUE(planner.endReached());
+  for (unsigned int i = 0; i < 3; i++) {
+    EXPECT_NEAR(planner.getPosOut().getSignal().getValue()[i], end[i], 1e-5);
+    EXPECT_EQ(planner.getVelOut().getSignal().getValue()[i], 0);
+  }
+}
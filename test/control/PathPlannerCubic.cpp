@@ -2,6 +2,8 @@
 #include <eeros/core/Fault.hpp>
 #include <gtest/gtest.h>
 #include <Utils.hpp>
+#include <cstdio>
+#include <unistd.h>
 
 using namespace eeros;
 using namespace eeros::control;
@@ -73,3 +75,48 @@ TEST(controlPathPlannerCubicTest, pos) {
 	EXPECT_TRUE(Utils::compareApprox(planner.getVelOut().getSignal().getValue(), 0, 1e-10));
 	EXPECT_TRUE(Utils::compareApprox(planner.getPosOut().getSignal().getValue(), 1183.04, 1e-3));
 }
+
+// Test binary trajectory file against text file
+TEST(controlPathPlannerCubicTest, binary) {
+	std::string fileName = "pathPlannerCubicTest.bin";
+	PathPlannerCubic text(0.1), binary(0.1);
+	text.init("path1.txt");
+	text.save(fileName);
+	binary.init(fileName);
+	text.move(10, 200, 1000);
+	binary.move(10, 200, 1000);
+	for (int i = 0; i < 110; i++) {
+		text.run();
+		binary.run();
+		EXPECT_TRUE(Utils::compareApprox(binary.getJerkOut().getSignal().getValue(), text.getJerkOut().getSignal().getValue(), 1e-9));
+		EXPECT_TRUE(Utils::compareApprox(binary.getAccOut().getSignal().getValue(), text.getAccOut().getSignal().getValue(), 1e-9));
+		EXPECT_TRUE(Utils::compareApprox(binary.getVelOut().getSignal().getValue(), text.getVelOut().getSignal().getValue(), 1e-9));
+		EXPECT_TRUE(Utils::compareApprox(binary.getPosOut().getSignal().getValue(), text.getPosOut().getSignal().getValue(), 1e-9));
+	}
+	EXPECT_TRUE(binary.endReached());
+	EXPECT_TRUE(Utils::compareApprox(binary.getPosOut().getSignal().getValue(), 1200, 1e-10));
+	text.move(-50);
+	binary.move(-50);
+	for (int i = 0; i < 30; i++) {
+		text.run();
+		binary.run();
+		EXPECT_EQ(binary.getJerkOut().getSignal().getValue(), text.getJerkOut().getSignal().getValue());
+		EXPECT_EQ(binary.getAccOut().getSignal().getValue(), text.getAccOut().getSignal().getValue());
+		EXPECT_EQ(binary.getVelOut().getSignal().getValue(), text.getVelOut().getSignal().getValue());
+		EXPECT_EQ(binary.getPosOut().getSignal().getValue(), text.getPosOut().getSignal().getValue());
+	}
+	std::remove(fileName.c_str());
+}
+
+// Test inconsistent binary trajectory file
+TEST(controlPathPlannerCubicTest, binaryInconsistent) {
+	std::string fileName = "pathPlannerCubicTest.bin";
+	PathPlannerCubic planner(0.1);
+	planner.init("path1.txt");
+	planner.save(fileName);
+	truncate(fileName.c_str(), sizeof(PathPlannerCubicHeader) + 3 * sizeof(PathPlannerCubicSegment));
+	EXPECT_THROW(planner.init(fileName), eeros::Fault);
+	truncate(fileName.c_str(), 4);
+	EXPECT_THROW(planner.init(fileName), eeros::Fault);
+	std::remove(fileName.c_str());
+}
@@ -0,0 +1,101 @@
+#include <eeros/control/PathPlannerOnline.hpp>
+#include <eeros/control/Constant.hpp>
+#include <eeros/control/JerkProfile.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+
+using namespace eeros;
+using namespace eeros::control;
+using namespace eeros::math;
+
+template class eeros::control::PathPlannerOnline<Matrix<2,1,float>>;
+
+
+// Test the duration of a move from rest to rest reaching all limits
+TEST(controlPathPlannerOnline, profileDuration) {
+  JerkProfile profile;
+  profile.plan(0, 0, 0, 5, 1, 2, 10);
+  EXPECT_NEAR(profile.getDuration(), 5 / 1.0 + 1 / 2.0 + 2 / 10.0, 1e-9);
+  double p, v, a, j;
+  profile.sample(profile.getDuration(), p, v, a, j);
+  EXPECT_NEAR(p, 5, 1e-12);
+  EXPECT_NEAR(v, 0, 1e-12);
+  EXPECT_NEAR(a, 0, 1e-12);
+}
+
+// Test profiles from moving states, the target is reached at rest within the limits
+TEST(controlPathPlannerOnline, profileFromMovingState) {
+  JerkProfile profile;
+  double states[][4] = {{0, 0.8, 1.5, -1}, {0, -0.9, 0.5, 0.01}, {1, 0.5, -2, 1}, {0, 1, 0, 0.05}, {0, 0, 0, 0}};
+  for (auto& s : states) {
+    profile.plan(s[0], s[1], s[2], s[3], 1, 2, 10);
+    double p, v, a, j;
+    for (double t = 0; t < profile.getDuration(); t += 0.001) {
+      profile.sample(t, p, v, a, j);
+      EXPECT_LE(std::fabs(a), 2 + 1e-9);
+      EXPECT_LE(std::fabs(j), 10 + 1e-9);
+    }
+    profile.sample(profile.getDuration(), p, v, a, j);
+    EXPECT_NEAR(p, s[3], 1e-12);
+    EXPECT_NEAR(v, 0, 1e-12);
+    EXPECT_NEAR(a, 0, 1e-12);
+  }
+}
+
+// Test a move of two axes, each within its limits
+TEST(controlPathPlannerOnline, axes) {
+  PathPlannerOnline<Matrix<2,1,double>> planner({1, 2}, {2, 2}, {10, 10}, 0.01);
+  Matrix<2,1,double> end{1, -2};
+  EXPECT_TRUE(planner.move(end));
+  EXPECT_FALSE(planner.endReached());
+  Matrix<2,1,double> prevAcc{0, 0};
+  int n = 0;
+  while (!planner.endReached() && n < 1000) {
+    planner.run();
+    Matrix<2,1,double> acc = planner.getAccOut().getSignal().getValue();
+    for (unsigned int i = 0; i < 2; i++) {
+      EXPECT_LE(std::fabs(planner.getVelOut().getSignal().getValue()[i]), (i == 0 ? 1 : 2) + 1e-9);
+      EXPECT_LE(std::fabs(acc[i]), 2 + 1e-9);
+      EXPECT_LE(std::fabs(acc[i] - prevAcc[i]), 10 * 0.01 + 1e-9);
+    }
+    prevAcc = acc;
+    n++;
+  }
+  EXPECT_TRUE(planner.endReached());
+  EXPECT_EQ(planner.getPosOut().getSignal().getValue()[0], 1);
+  EXPECT_EQ(planner.getPosOut().getSignal().getValue()[1], -2);
+  EXPECT_EQ(planner.getRemainingTime(), 0);
+}
+
+// Test retargeting while moving, the motion stays continuous
+TEST(controlPathPlannerOnline, retarget) {
+  PathPlannerOnline<Matrix<1,1,double>> planner({1}, {2}, {10}, 0.001);
+  planner.move(Matrix<1,1,double>{5});
+  for (int i = 0; i < 1000; i++) planner.run();
+  EXPECT_GT(planner.getVelOut().getSignal().getValue()[0], 0.9);
+  planner.move(Matrix<1,1,double>{-1});
+  double prevAcc = planner.getAccOut().getSignal().getValue()[0];
+  int n = 0;
+  while (!planner.endReached() && n < 20000) {
+    planner.run();
+    double acc = planner.getAccOut().getSignal().getValue()[0];
+    EXPECT_LE(std::fabs(acc - prevAcc), 10 * 0.001 + 1e-9);
+    prevAcc = acc;
+    n++;
+  }
+  EXPECT_TRUE(planner.endReached());
+  EXPECT_EQ(planner.getPosOut().getSignal().getValue()[0], -1);
+}
+
+// Test following the target input
+TEST(controlPathPlannerOnline, targetInput) {
+  Constant<Matrix<1,1,double>> target(Matrix<1,1,double>{0.5});
+  PathPlannerOnline<Matrix<1,1,double>> planner({1}, {2}, {10}, 0.01);
+  planner.setStart(Matrix<1,1,double>{0.2});
+  planner.getTargetIn().connect(target.getOut());
+  target.run();
+  for (int i = 0; i < 300 && !planner.endReached(); i++) planner.run();
+  EXPECT_TRUE(planner.endReached());
+  EXPECT_EQ(planner.getPosOut().getSignal().getValue()[0], 0.5);
+}
@@ -0,0 +1,105 @@
+#include <eeros/control/RateTransition.hpp>
+#include <eeros/control/Constant.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace eeros;
+using namespace eeros::control;
+using namespace eeros::math;
+
+// The decimator averages all samples sent since its last run
+TEST(controlRateTransitionTest, decimatorAverage) {
+  Constant<Matrix<2,1>> c;
+  Decimator<Matrix<2,1>> d;
+  d.getIn().connect(c.getOut());
+  EXPECT_TRUE(std::isnan(d.getOut().getSignal().getValue()(0)));
+  for (int i = 1; i <= 4; i++) {
+    c.getOut().getSignal().set(Matrix<2,1>{1.0 * i, -2.0 * i}, 100 * i);
+    d.getSender().run();
+  }
+  d.run();
+  EXPECT_EQ(d.getBatchLength(), 4u);
+  EXPECT_EQ(d.getBatchValue(0), (Matrix<2,1>{1, -2}));
+  EXPECT_EQ(d.getBatchTimestamp(3), 400u);
+  EXPECT_EQ(d.getOut().getSignal().getValue(), (Matrix<2,1>{2.5, -5}));
+  EXPECT_EQ(d.getOut().getSignal().getTimestamp(), 400u);
+
+  // nothing sent, the output is held
+  d.run();
+  EXPECT_EQ(d.getBatchLength(), 0u);
+  EXPECT_EQ(d.getOut().getSignal().getValue(), (Matrix<2,1>{2.5, -5}));
+}
+
+TEST(controlRateTransitionTest, decimatorNewest) {
+  Constant<> c;
+  Decimator<double, 4> d(false);
+  d.getIn().connect(c.getOut());
+  for (int i = 1; i <= 6; i++) {
+    c.getOut().getSignal().set(i, i);
+    d.getSender().run();
+  }
+  d.run();
+  // the last two samples did not fit into the buffer
+  EXPECT_EQ(d.getSender().getOverruns(), 2u);
+  EXPECT_EQ(d.getBatchLength(), 4u);
+  EXPECT_DOUBLE_EQ(d.getOut().getSignal().getValue(), 4);
+}
+
+TEST(controlRateTransitionTest, interpolatorHold) {
+  Constant<> c;
+  Interpolator<> p(4);
+  p.getIn().connect(c.getOut());
+  p.run();
+  EXPECT_TRUE(std::isnan(p.getOut().getSignal().getValue()));
+  c.getOut().getSignal().set(3, 10);
+  p.getSender().run();
+  for (int i = 0; i < 4; i++) {
+    p.run();
+    EXPECT_DOUBLE_EQ(p.getOut().getSignal().getValue(), 3);
+    EXPECT_EQ(p.getOut().getSignal().getTimestamp(), 10u);
+  }
+}
+
+TEST(controlRateTransitionTest, interpolatorLinear) {
+  Constant<Matrix<2,1>> c;
+  Interpolator<Matrix<2,1>> p(4, Interpolation::linear);
+  p.getIn().connect(c.getOut());
+  c.getOut().getSignal().set(Matrix<2,1>{0, 4}, 0);
+  p.getSender().run();
+  p.run();
+  EXPECT_EQ(p.getOut().getSignal().getValue(), (Matrix<2,1>{0, 4}));
+  c.getOut().getSignal().set(Matrix<2,1>{4, 0}, 400);
+  p.getSender().run();
+  for (int i = 1; i <= 4; i++) {
+    p.run();
+    EXPECT_EQ(p.getOut().getSignal().getValue(), (Matrix<2,1>{1.0 * i, 4.0 - i}));
+    EXPECT_EQ(p.getOut().getSignal().getTimestamp(), 100u * i);
+  }
+  // the next sample is late
+  p.run();
+  EXPECT_EQ(p.getOut().getSignal().getValue(), (Matrix<2,1>{4, 0}));
+}
+
+// A matrix is never read while it is written
+TEST(controlRateTransitionTest, threads) {
+  Constant<Matrix<8,1>> c;
+  Decimator<Matrix<8,1>, 16> d(false);
+  d.getIn().connect(c.getOut());
+  std::thread fast([&]() {
+    for (int i = 0; i < 20000; i++) {
+      c.getOut().getSignal().set(Matrix<8,1>(static_cast<double>(i)), i);
+      d.getSender().run();
+    }
+  });
+  int mixed = 0;
+  for (int k = 0; k < 20000; k++) {
+    d.run();
+    for (unsigned int j = 0; j < d.getBatchLength(); j++) {
+      const Matrix<8,1>& v = d.getBatchValue(j);
+      for (unsigned int i = 1; i < 8; i++) if (v(i) != v(0)) mixed++;
+    }
+  }
+  fast.join();
+  EXPECT_EQ(mixed, 0);
+}
@@ -0,0 +1,179 @@
+#include <eeros/control/Recorder.hpp>
+#include <eeros/control/Constant.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <vector>
+
+using namespace eeros;
+using namespace eeros::control;
+using namespace eeros::math;
+
+// Outputs can only be added before recording
+TEST(controlRecorderTest, columns) {
+  Recorder rec(10);
+  rec.setName("rec");
+  EXPECT_EQ(rec.getChunkLength(), 16);
+  EXPECT_EQ(rec.getNofColumns(), 1);
+  Constant<> c1;
+  Constant<Vector3> c2;
+  rec.add(c1.getOut(), "c1");
+  rec.add(c2.getOut());
+  EXPECT_EQ(rec.getNofColumns(), 3);
+  rec.enable();
+  rec.run();
+  try {
+    rec.add(c1.getOut());
+    FAIL();
+  } catch(eeros::Fault const & err) {
+    EXPECT_EQ(err.what(), std::string("outputs must be added to recorder 'rec' before recording"));
+  }
+}
+
+// All columns are written into one file, which can be read column by column
+TEST(controlRecorderTest, write) {
+  static std::ostringstream log;
+  logger::Logger::setDefaultStreamLogger(log);
+  std::string fileName = "recorderTest.bin";
+  Recorder rec(16);
+  Constant<> c1;
+  Constant<Vector3> c2;
+  Constant<int> c3;
+  rec.add(c1.getOut(), "c1");
+  rec.add(c2.getOut(), "c2");
+  rec.add(c3.getOut(), "c3");
+  {
+    RecorderWriter writer(rec, fileName);
+    rec.enable();
+    for (int i = 0; i < 20; i++) {
+      c1.getOut().getSignal().setValue(0.5 * i);
+      c2.getOut().getSignal().setValue(Vector3{1.0 * i, 2.0 * i, 3.0 * i});
+      c3.getOut().getSignal().setValue(-i);
+      rec.run();
+    }
+    rec.disable();
+    rec.run();
+    writer.stop();
+    EXPECT_EQ(writer.getNofSamples(), 20);
+  }
+  EXPECT_EQ(rec.getOverruns(), 0);
+
+  std::ifstream file(fileName, std::ios::binary);
+  std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  RecorderHeader header;
+  ASSERT_GE(data.size(), sizeof(RecorderHeader));
+  std::memcpy(&header, data.data(), sizeof(header));
+  EXPECT_EQ(std::string(header.magic, 4), "EERC");
+  EXPECT_EQ(header.version, 1);
+  ASSERT_EQ(header.nofColumns, 4);
+  EXPECT_EQ(header.chunkLength, 16);
+  RecorderColumn col[4];
+  std::memcpy(col, data.data() + sizeof(header), sizeof(col));
+  EXPECT_EQ(std::string(col[0].name), "time");
+  EXPECT_EQ(std::string(col[2].name), "c2");
+  EXPECT_EQ(col[2].rows, 3);
+  EXPECT_EQ(col[3].elementSize, sizeof(int));
+  EXPECT_EQ(col[3].elementType, 1);
+
+  size_t start = sizeof(header) + sizeof(col);
+  size_t sampleBytes = 8 + 8 + 24 + 4;
+  size_t chunkBytes = 8 + header.chunkLength * sampleBytes;
+  ASSERT_EQ(data.size(), start + chunkBytes + 8 + 4 * sampleBytes);
+  // first chunk is full
+  const char* chunk = data.data() + start;
+  uint32_t n;
+  std::memcpy(&n, chunk, sizeof(n));
+  EXPECT_EQ(n, 16);
+  const double* c2Data = reinterpret_cast<const double*>(chunk + 8 + header.chunkLength * 16);
+  const int* c3Data = reinterpret_cast<const int*>(chunk + 8 + header.chunkLength * 40);
+  for (int i = 0; i < 16; i++) {
+    EXPECT_EQ(c2Data[3 * i + 1], 2.0 * i);
+    EXPECT_EQ(c3Data[i], -i);
+  }
+  // last chunk is partial
+  chunk = data.data() + start + chunkBytes;
+  std::memcpy(&n, chunk, sizeof(n));
+  EXPECT_EQ(n, 4);
+  const double* c1Data = reinterpret_cast<const double*>(chunk + 8 + 4 * 8);
+  EXPECT_EQ(c1Data[3], 0.5 * 19);
+  const uint64_t* time = reinterpret_cast<const uint64_t*>(chunk + 8);
+  EXPECT_LE(time[0], time[3]);
+  std::remove(fileName.c_str());
+}
+
+// Compressed chunks decode column by column to the recorded samples
+TEST(controlRecorderTest, compressed) {
+  static std::ostringstream log;
+  logger::Logger::setDefaultStreamLogger(log);
+  std::string fileName = "recorderCompressedTest.bin";
+  Recorder rec(64);
+  Constant<> c1;
+  Constant<Vector3> c2;
+  Constant<int> c3;
+  rec.add(c1.getOut(), "c1");
+  rec.add(c2.getOut(), "c2");
+  rec.add(c3.getOut(), "c3");
+  uint64_t nofBytes;
+  {
+    RecorderWriter writer(rec, fileName, true);
+    rec.enable();
+    for (int i = 0; i < 100; i++) {
+      c1.getOut().getSignal().setValue(0.5 * i);
+      c2.getOut().getSignal().setValue(Vector3{1.0, -2.0, 3.0});
+      c3.getOut().getSignal().setValue(-i);
+      rec.run();
+    }
+    rec.disable();
+    rec.run();
+    writer.stop();
+    EXPECT_EQ(writer.getNofSamples(), 100);
+    nofBytes = writer.getNofBytes();
+  }
+  EXPECT_LT(nofBytes, 100 * (8 + 8 + 24 + 4) / 2);
+
+  std::ifstream file(fileName, std::ios::binary);
+  std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  RecorderHeader header;
+  std::memcpy(&header, data.data(), sizeof(header));
+  EXPECT_EQ(header.version, 2);
+  ASSERT_EQ(header.nofColumns, 4);
+  RecorderColumn col[4];
+  std::memcpy(col, data.data() + sizeof(header), sizeof(col));
+  size_t pos = sizeof(header) + sizeof(col);
+  ASSERT_EQ(data.size(), pos + nofBytes);
+
+  // second chunk, decoded without the first one
+  uint32_t count[2];
+  std::memcpy(count, data.data() + pos, sizeof(count));
+  EXPECT_EQ(count[0], 64);
+  pos += 8 + count[1];
+  std::memcpy(count, data.data() + pos, sizeof(count));
+  EXPECT_EQ(count[0], 36);
+  ASSERT_EQ(pos + 8 + count[1], data.size());
+  uint32_t size[4];
+  std::memcpy(size, data.data() + pos + 8, sizeof(size));
+  const char* column = data.data() + pos + 8 + sizeof(size);
+  uint64_t time[36];
+  ASSERT_TRUE(decodeRecorderColumn(col[0], 36, column, size[0], time));
+  EXPECT_LE(time[0], time[35]);
+  column += size[0];
+  double c1Data[36];
+  ASSERT_TRUE(decodeRecorderColumn(col[1], 36, column, size[1], c1Data));
+  column += size[1];
+  double c2Data[3 * 36];
+  ASSERT_TRUE(decodeRecorderColumn(col[2], 36, column, size[2], c2Data));
+  column += size[2];
+  int c3Data[36];
+  ASSERT_TRUE(decodeRecorderColumn(col[3], 36, column, size[3], c3Data));
+  EXPECT_FALSE(decodeRecorderColumn(col[3], 36, column, size[3] - 1, c3Data));
+  for (int i = 0; i < 36; i++) {
+    EXPECT_EQ(c1Data[i], 0.5 * (64 + i));
+    EXPECT_EQ(c2Data[3 * i + 1], -2.0);
+    EXPECT_EQ(c3Data[i], -(64 + i));
+  }
+  std::remove(fileName.c_str());
+}
@@ -88,4 +88,22 @@ TEST(controlSatTest, vector) {
   EXPECT_EQ(sat.getOut().getSignal().getValue()[1], -0.8);
 }
 
-
+// Many channels are limited in one pass
+TEST(controlSatTest, channels) {
+  Vector<7> in, lower, upper;
+  in << -3, -1, 0, 1, 3, std::nan(""), 2;
+  lower.fill(-2);
+  upper.fill(2);
+  Constant<Vector<7>> c0(in);
+  Saturation<Vector<7>> sat(lower, upper);
+  sat.getIn().connect(c0.getOut());
+  c0.run(); sat.run();
+  auto out = sat.getOut().getSignal().getValue();
+  EXPECT_EQ(out[0], -2);
+  EXPECT_EQ(out[1], -1);
+  EXPECT_EQ(out[2], 0);
+  EXPECT_EQ(out[3], 1);
+  EXPECT_EQ(out[4], 2);
+  EXPECT_TRUE(std::isnan(out[5]));
+  EXPECT_EQ(out[6], 2);
+}
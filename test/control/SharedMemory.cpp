@@ -0,0 +1,123 @@
+#include <eeros/control/SharedMemoryOutput.hpp>
+#include <eeros/control/SharedMemoryInput.hpp>
+#include <eeros/control/Constant.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <eeros/core/Fault.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace eeros;
+using namespace eeros::control;
+using namespace eeros::math;
+
+static std::string channelName(const char* n) {
+  return std::string("/eeros_test_") + n + "_" + std::to_string(getpid());
+}
+
+// Nothing is read before the first write
+TEST(controlSharedMemoryTest, noData) {
+  std::string name = channelName("noData");
+  SharedMemoryInput<> in(name);
+  in.run();
+  EXPECT_FALSE(in.isNew());
+  EXPECT_TRUE(std::isnan(in.getOut().getSignal().getValue()));
+  SignalChannel::remove(name);
+}
+
+// A scalar signal and its timestamp are transferred
+TEST(controlSharedMemoryTest, scalar) {
+  std::string name = channelName("scalar");
+  Constant<> c(2.5);
+  SharedMemoryInput<> in(name);
+  SharedMemoryOutput<> out(name);
+  out.getIn().connect(c.getOut());
+  c.run();
+  out.run();
+  in.run();
+  EXPECT_TRUE(in.isNew());
+  EXPECT_EQ(in.getOut().getSignal().getValue(), 2.5);
+  EXPECT_EQ(in.getOut().getSignal().getTimestamp(), c.getOut().getSignal().getTimestamp());
+  in.run();
+  EXPECT_FALSE(in.isNew());
+  EXPECT_EQ(in.getOut().getSignal().getValue(), 2.5);
+  SignalChannel::remove(name);
+}
+
+// A matrix signal is transferred element by element
+TEST(controlSharedMemoryTest, matrix) {
+  std::string name = channelName("matrix");
+  Matrix<2,3,float> m{1, 2, 3, 4, 5, 6};
+  Constant<Matrix<2,3,float>> c(m);
+  SharedMemoryOutput<Matrix<2,3,float>> out(name);
+  SharedMemoryInput<Matrix<2,3,float>> in(name);
+  out.getIn().connect(c.getOut());
+  c.run();
+  out.run();
+  in.run();
+  EXPECT_TRUE(in.isNew());
+  EXPECT_EQ(in.getOut().getSignal().getValue(), m);
+  SignalChannel::remove(name);
+}
+
+// Channels with a different layout are rejected
+TEST(controlSharedMemoryTest, layoutMismatch) {
+  std::string name = channelName("layout");
+  SharedMemoryOutput<Matrix<2,1,double>> out(name);
+  using WrongSize = Matrix<3,1,double>;
+  EXPECT_THROW(SharedMemoryInput<WrongSize> in(name), Fault);
+  EXPECT_THROW(SharedMemoryInput<float> in(name), Fault);
+  SignalChannel::remove(name);
+}
+
+// Sides opening a new channel at the same time agree on one layout
+TEST(controlSharedMemoryTest, concurrentCreate) {
+  for (int round = 0; round < 20; round++) {
+    std::string name = channelName("concurrent");
+    std::atomic<bool> go{false};
+    std::atomic<int> opened[2] = {0, 0};
+    std::vector<std::thread> sides;
+    for (int i = 0; i < 8; i++) {
+      sides.emplace_back([&, i]() {
+        while (!go) { }
+        try {
+          SignalChannel c(name, sizeof(double), 1 + i % 2);
+          opened[i % 2]++;
+        } catch (Fault&) { }
+      });
+    }
+    go = true;
+    for (auto& t : sides) t.join();
+    EXPECT_EQ(opened[0] + opened[1], 4);
+    SignalChannel::remove(name);
+  }
+}
+
+// Written values can still be read after the sequence number wrapped around
+TEST(controlSharedMemoryTest, sequenceWrap) {
+  std::string name = channelName("wrap");
+  SignalChannel c(name, sizeof(double), 1);
+  double v = 1.5, r = 0;
+  uint64_t timestamp;
+  uint32_t seq;
+  c.write(&v, 10);
+  // move the sequence number of the channel to the end of its range
+  int fd = shm_open(name.c_str(), O_RDWR, 0666);
+  ASSERT_NE(fd, -1);
+  void* memory = mmap(nullptr, sizeof(SignalChannelRegion), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  ASSERT_NE(memory, MAP_FAILED);
+  static_cast<SignalChannelRegion*>(memory)->sequence.store(0xfffffffe);
+  v = 2.5;
+  c.write(&v, 20);
+  EXPECT_EQ(static_cast<SignalChannelRegion*>(memory)->sequence.load(), 0u);
+  munmap(memory, sizeof(SignalChannelRegion));
+  EXPECT_TRUE(c.read(&r, timestamp, seq));
+  EXPECT_EQ(r, 2.5);
+  EXPECT_EQ(timestamp, 20u);
+  SignalChannel::remove(name);
+}
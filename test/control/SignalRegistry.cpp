@@ -0,0 +1,54 @@
+#include <eeros/control/Signal.hpp>
+#include <eeros/control/Output.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace eeros;
+using namespace eeros::control;
+
+// Signals are found by id and name
+TEST(controlSignalRegistryTest, lookup) {
+  auto& reg = SignalRegistry::instance();
+  Output<> a;
+  Output<math::Vector2> b;
+  a.getSignal().setName("regTestA");
+  b.getSignal().setName("regTestB");
+  a.getSignal().setValue(1.5);
+
+  EXPECT_EQ(reg.get(a.getSignal().getId()), &a.getSignal());
+  EXPECT_EQ(Signal<>::getSignalById(b.getSignal().getId()), &b.getSignal());
+  EXPECT_EQ(reg.get("regTestA"), &a.getSignal());
+  EXPECT_EQ(reg.get<Signal<math::Vector2>>("regTestB"), &b.getSignal());
+  EXPECT_EQ(reg.get<Signal<double>>("regTestB"), nullptr);
+  EXPECT_EQ(reg.get("regTestA")->getType(), typeid(double));
+  EXPECT_EQ(reg.get("regTestA")->getValueString(), "1.5");
+
+  a.getSignal().setName("regTestC");
+  EXPECT_EQ(reg.get("regTestA"), nullptr);
+  EXPECT_EQ(reg.get("regTestC"), &a.getSignal());
+}
+
+// Ids are unique and destroyed signals are removed
+TEST(controlSignalRegistryTest, lifetime) {
+  auto& reg = SignalRegistry::instance();
+  std::size_t n = reg.size();
+  sigid_t id;
+  {
+    auto s = std::make_unique<Signal<int>>();
+    s->setName("regTestTemp");
+    id = s->getId();
+    Signal<int> copy(*s);
+    EXPECT_EQ(copy.getId(), id);
+    EXPECT_EQ(copy.getName(), "regTestTemp");
+    EXPECT_EQ(reg.getName(id), "regTestTemp");
+    EXPECT_EQ(reg.size(), n + 1);
+    EXPECT_EQ(reg.get(id), s.get());
+  }
+  EXPECT_EQ(reg.size(), n);
+  EXPECT_EQ(reg.get(id), nullptr);
+  EXPECT_EQ(reg.get("regTestTemp"), nullptr);
+  EXPECT_EQ(reg.getName(id), "");
+  Signal<int> next;
+  EXPECT_GT(next.getId(), id);
+}
@@ -0,0 +1,78 @@
+#include <eeros/control/SignalSnapshot.hpp>
+#include <eeros/control/TimeDomain.hpp>
+#include <eeros/control/Constant.hpp>
+#include <eeros/control/Gain.hpp>
+#include <eeros/core/Fault.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+using namespace eeros;
+using namespace eeros::control;
+
+TEST(controlSignalSnapshotTest, capture) {
+  Constant<> c(1.5);
+  Constant<math::Vector3> v(math::Vector3{1, 2, 3});
+  SignalSnapshot snapshot;
+  auto ec = snapshot.add(c.getOut());
+  auto ev = snapshot.add(v.getOut());
+  SignalSnapshot::View view;
+  EXPECT_TRUE(snapshot.read(view));
+  EXPECT_EQ(view.getCycle(), 0u);
+  c.run();
+  v.run();
+  c.getOut().getSignal().set(1.5, 1234);
+  snapshot.capture();
+  EXPECT_EQ(snapshot.getCycle(), 1u);
+  c.setValue(2.5);
+  c.run();
+  ASSERT_TRUE(snapshot.read(view));
+  EXPECT_EQ(view.getCycle(), 1u);
+  EXPECT_EQ(view.getValue(ec), 1.5);
+  EXPECT_EQ(view.getTimestamp(ec), 1234u);
+  EXPECT_EQ(view.getValue(ev), (math::Vector3{1, 2, 3}));
+  EXPECT_THROW(snapshot.add(c.getOut()), Fault);
+}
+
+// Readers always see the outputs of one cycle, while the timedomain runs
+TEST(controlSignalSnapshotTest, consistentWhileRunning) {
+  TimeDomain td("td", 0.001, false);
+  Constant<math::Matrix<8, 8>> c;
+  Gain<math::Matrix<8, 8>> g(2.0);
+  g.getIn().connect(c.getOut());
+  td.addBlock(c);
+  td.addBlock(g);
+  SignalSnapshot snapshot;
+  auto ec = snapshot.add(c.getOut());
+  auto eg = snapshot.add(g.getOut());
+  td.setSnapshot(&snapshot);
+  std::atomic<bool> stop{false};
+  std::atomic<int> inconsistent{0}, reads{0};
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 3; r++) {
+    readers.emplace_back([&]() {
+      SignalSnapshot::View view;
+      while (!stop) {
+        if (!snapshot.read(view) || view.getCycle() == 0) continue;
+        auto in = view.getValue(ec);
+        auto out = view.getValue(eg);
+        for (unsigned int i = 0; i < 64; i++) {
+          if (out(i) != 2 * in(i) || in(i) != in(0)) inconsistent++;
+        }
+        reads++;
+      }
+    });
+  }
+  for (int k = 1; k <= 20000; k++) {
+    math::Matrix<8, 8> m;
+    m.fill(k);
+    c.setValue(m);
+    td.run();
+  }
+  stop = true;
+  for (auto& t : readers) t.join();
+  EXPECT_EQ(snapshot.getCycle(), 20000u);
+  EXPECT_GT(reads, 0);
+  EXPECT_EQ(inconsistent, 0);
+}
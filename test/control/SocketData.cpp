@@ -1,14 +1,20 @@
 #include <eeros/control/SocketData.hpp>
 #include <eeros/core/Fault.hpp>
+#include <eeros/logger/Logger.hpp>
 #include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <thread>
 
 using namespace eeros;
 using namespace eeros::control;
 using namespace eeros::math;
+using namespace eeros::logger;
 
 
 // Test name
 TEST(controlSocketDataTest, name) {
+  Logger::setDefaultStreamLogger(std::cout);
   SocketData<Vector2, Vector2> s("192.168.1.1", 9876);
   EXPECT_STREQ (s.getName().c_str(), "");
 
@@ -18,6 +24,7 @@ TEST(controlSocketDataTest, name) {
 
 // Test allocation
 TEST(controlSocketDataTest, alloc) {
+  Logger::setDefaultStreamLogger(std::cout);
   SocketData<Vector2, int> s1("192.168.1.1", 9876);
   SocketData<Vector2, Matrix<2,3,double>> s2("192.168.1.1", 9876);
   SocketData<Vector2, Matrix<2,3,int>> s3("192.168.1.1", 9876);
@@ -28,3 +35,15 @@ TEST(controlSocketDataTest, alloc) {
   SocketData<Vector2, std::nullptr_t> s8("192.168.1.1", 9876);
   SocketData<std::nullptr_t, Vector2> s9("192.168.1.1", 9876);
 }
+
+// Test sequence counter of received data
+TEST(controlSocketDataTest, sequence) {
+  Logger::setDefaultStreamLogger(std::cout);
+  SocketData<Vector2, Vector2> server("", 9877, 0.5, 5.0);
+  SocketData<Vector2, Vector2> client("127.0.0.1", 9877, 0.01, 5.0);
+  for (int i = 0; i < 400 && !client.isNew(); i++) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  EXPECT_TRUE(client.isNew());
+  EXPECT_GT(client.getSequence(), 0);
+  client.resetNew();
+  EXPECT_FALSE(client.isNew());
+}
@@ -0,0 +1,71 @@
+#include <eeros/control/SocketMessage.hpp>
+#include <eeros/control/Constant.hpp>
+#include <eeros/core/Fault.hpp>
+#include <eeros/logger/Logger.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+using namespace eeros;
+using namespace eeros::control;
+using namespace eeros::math;
+using namespace eeros::logger;
+
+namespace {
+
+template < typename F >
+bool waitFor(F done) {
+  for (int i = 0; i < 400 && !done(); i++) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  return done();
+}
+
+}
+
+// Several signals of different types are carried by one message
+TEST(controlSocketMessageTest, exchangesSignals) {
+  Logger::setDefaultStreamLogger(std::cout);
+  SocketMessage server("", 9878, 0.005, 5.0);
+  SocketMessage client("127.0.0.1", 9878, 0.005, 5.0);
+  Constant<Vector3> position({1.0, 2.0, 3.0});
+  Constant<int> mode(7);
+  Constant<double> command(0.5);
+  server.addInput<Vector3>("position").connect(position.getOut());
+  server.addInput<int>("mode").connect(mode.getOut());
+  client.addInput<double>("command").connect(command.getOut());
+  auto& p = client.addOutput<Vector3>("position");
+  auto& m = client.addOutput<int>("mode");
+  auto& c = server.addOutput<double>("command");
+  EXPECT_EQ(server.getSendSchema().getId(), client.getReceiveSchema().getId());
+  server.start();
+  client.start();
+  position.run(); mode.run(); command.run();
+
+  EXPECT_TRUE(waitFor([&]() { server.run(); client.run(); return m.getSignal().getValue() == 7 && c.getSignal().getValue() == 0.5; }));
+  EXPECT_EQ(p.getSignal().getValue()(2), 3.0);
+  EXPECT_TRUE(client.isNew());
+  EXPECT_GT(client.getTimestamp(), 0);
+  EXPECT_EQ(client.getInvalid(), 0);
+  EXPECT_THROW(client.addOutput<double>("late"), Fault);
+}
+
+// Messages of another schema are counted and ignored
+TEST(controlSocketMessageTest, rejectsOtherSchema) {
+  Logger::setDefaultStreamLogger(std::cout);
+  SocketMessage server("", 9879, 0.005, 5.0);
+  SocketMessage client("127.0.0.1", 9879, 0.005, 5.0);
+  server.addInput<double>("speed");
+  auto& s = client.addOutput<float>("speed");
+  server.start();
+  client.start();
+  EXPECT_TRUE(waitFor([&]() { server.run(); client.run(); return client.getInvalid() > 0; }));
+  EXPECT_EQ(s.getSignal().getValue(), 0);
+  EXPECT_TRUE(client.isConnected());
+}
+
+TEST(controlSocketMessageTest, notStarted) {
+  Logger::setDefaultStreamLogger(std::cout);
+  SocketMessage s("", 9880);
+  EXPECT_THROW(s.run(), Fault);
+}
@@ -0,0 +1,147 @@
+#include <eeros/control/filter/SosFilter.hpp>
+#include <eeros/control/ZTransferFunction.hpp>
+#include <eeros/control/Constant.hpp>
+#include <eeros/math/Matrix.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+using namespace eeros;
+using namespace eeros::control;
+using namespace math;
+
+template class eeros::control::SosFilter<2, float>;
+template class eeros::control::SosFilter<2, Vector<9, float>>;
+
+namespace {
+  // Evaluates a fraction in z^-1 in direct form as reference
+  template <int ORDER>
+  struct Reference {
+    Reference(const Fraction<ORDER>& f) : f(f) { }
+    double step(double x) {
+      for (int i = ORDER; i > 0; i--) { xs[i] = xs[i - 1]; ys[i] = ys[i - 1]; }
+      xs[0] = x;
+      double y = f.numerator.c[0] * x;
+      for (int i = 1; i <= ORDER; i++) y += f.numerator.c[i] * xs[i] - f.denominator.c[i] * ys[i];
+      ys[0] = y / f.denominator.c[0];
+      return ys[0];
+    }
+    Fraction<ORDER> f;
+    double xs[ORDER + 1]{};
+    double ys[ORDER + 1]{};
+  };
+}
+
+TEST(controlSosFilterTest, naming) {
+  SosFilter<1> f{ZTransferFunction<1>::PT1(0.01, 1.0, 0.1)};
+  EXPECT_EQ(f.getName(), std::string(""));
+  f.setName("sos");
+  EXPECT_EQ(f.getName(), std::string("sos"));
+}
+
+TEST(controlSosFilterTest, sections) {
+  SosFilter<2> f{ZTransferFunction<1>::DT1(0.01, 2.0, 0.1), ZTransferFunction<1>::PID(0.01, 1.0, 0.5, 0.1, 0.05)};
+  auto pid = ZTransferFunction<1>::PID(0.01, 1.0, 0.5, 0.1, 0.05).getFraction();
+  EXPECT_DOUBLE_EQ(f.getSection(1).b0, pid.numerator.c[0] / pid.denominator.c[0]);
+  EXPECT_DOUBLE_EQ(f.getSection(1).a2, pid.denominator.c[2] / pid.denominator.c[0]);
+  EXPECT_DOUBLE_EQ(f.getSection(0).b2, 0);
+  EXPECT_DOUBLE_EQ(f.getSection(0).a2, 0);
+  EXPECT_THROW(f.getSection(2), std::out_of_range);
+}
+
+TEST(controlSosFilterTest, cascade) {
+  auto dt1 = ZTransferFunction<1>::DT1(0.01, 2.0, 0.1);
+  auto pid = ZTransferFunction<1>::PID(0.01, 1.0, 0.5, 0.1, 0.05);
+  SosFilter<2> f{dt1, pid};
+  Reference<1> r1(dt1.getFraction());
+  Reference<2> r2(pid.getFraction());
+  Constant<> c;
+  f.getIn().connect(c.getOut());
+  for (int k = 0; k < 200; k++) {
+    c.setValue(std::sin(0.1 * k) + (k % 7 == 0 ? 1.0 : 0.0));
+    c.run();
+    f.run();
+    double expected = r2.step(r1.step(c.getOut().getSignal().getValue()));
+    EXPECT_NEAR(f.getOut().getSignal().getValue(), expected, 1e-9 * (1 + std::abs(expected)));
+  }
+}
+
+TEST(controlSosFilterTest, channels) {
+  BiquadSection s{0.2, 0.3, 0.1, -0.5, 0.2};
+  SosFilter<2,Vector<5>> f{{s, s}};
+  SosFilter<2> scalar[5] = {{{s, s}}, {{s, s}}, {{s, s}}, {{s, s}}, {{s, s}}};
+  Constant<Vector<5>> c;
+  Constant<> cs;
+  f.getIn().connect(c.getOut());
+  for (auto& sf : scalar) sf.getIn().connect(cs.getOut());
+  for (int k = 0; k < 50; k++) {
+    Vector<5> x;
+    for (unsigned int j = 0; j < 5; j++) x(j) = std::cos(0.3 * k + j);
+    c.setValue(x);
+    c.run();
+    f.run();
+    for (unsigned int j = 0; j < 5; j++) {
+      cs.setValue(x(j));
+      cs.run();
+      scalar[j].run();
+      EXPECT_DOUBLE_EQ(f.getOut().getSignal().getValue()(j), scalar[j].getOut().getSignal().getValue());
+    }
+  }
+}
+
+TEST(controlSosFilterTest, timestampAndEnable) {
+  SosFilter<1> f{{BiquadSection{0.5, 0.5, 0, 0, 0}}};
+  Constant<> c{2.0};
+  f.getIn().connect(c.getOut());
+  c.run();
+  c.getOut().getSignal().set(2.0, 12345);
+  f.run();
+  EXPECT_EQ(f.getOut().getSignal().getTimestamp(), 12345);
+  EXPECT_DOUBLE_EQ(f.getOut().getSignal().getValue(), 1.0);
+  f.disable();
+  f.run();
+  EXPECT_DOUBLE_EQ(f.getOut().getSignal().getValue(), 2.0);
+  f.enable();
+  f.run();
+  EXPECT_DOUBLE_EQ(f.getOut().getSignal().getValue(), 2.0);
+  f.reset();
+  f.run();
+  EXPECT_DOUBLE_EQ(f.getOut().getSignal().getValue(), 1.0);
+}
+
+TEST(controlSosFilterTest, invalidFraction) {
+  Fraction<1> f;
+  f.numerator.c[0] = 1;
+  f.numerator.c[1] = 0;
+  f.denominator.c[0] = 0;
+  f.denominator.c[1] = 1;
+  EXPECT_THROW(BiquadSection::fromFraction(f), Fault);
+}
+
+TEST(controlSosFilterTest, float) {
+  auto dt1 = ZTransferFunction<1>::DT1(0.01, 2.0, 0.1);
+  auto pid = ZTransferFunction<1>::PID(0.01, 1.0, 0.5, 0.1, 0.05);
+  SosFilter<2> f{dt1, pid};
+  SosFilter<2, float> ff{dt1, pid};
+  SosFilter<2, Vector<9, float>> fv{dt1, pid};
+  Constant<> c;
+  Constant<float> cf;
+  Constant<Vector<9, float>> cv;
+  f.getIn().connect(c.getOut());
+  ff.getIn().connect(cf.getOut());
+  fv.getIn().connect(cv.getOut());
+  for (int k = 0; k < 200; k++) {
+    double x = std::sin(0.1 * k) + (k % 7 == 0 ? 1.0 : 0.0);
+    c.setValue(x);
+    cf.setValue(x);
+    Vector<9, float> v;
+    v.fill(static_cast<float>(x));
+    cv.setValue(v);
+    c.run(); cf.run(); cv.run();
+    f.run(); ff.run(); fv.run();
+    double expected = f.getOut().getSignal().getValue();
+    EXPECT_NEAR(ff.getOut().getSignal().getValue(), expected, 1e-3 * (1 + std::abs(expected)));
+    for (unsigned int j = 0; j < 9; j++) EXPECT_FLOAT_EQ(fv.getOut().getSignal().getValue()(j), ff.getOut().getSignal().getValue());
+  }
+}
@@ -0,0 +1,49 @@
+#include <eeros/control/StaticTimeDomain.hpp>
+#include <eeros/control/Constant.hpp>
+#include <eeros/control/Gain.hpp>
+#include <eeros/control/Sum.hpp>
+#include <eeros/control/Saturation.hpp>
+#include <gtest/gtest.h>
+
+using namespace eeros;
+using namespace eeros::control;
+
+// A fused chain gives the same result as the equivalent blocks
+TEST(controlStaticTimeDomainTest, sameAsBlocks) {
+  Constant<> in(0), ff(0.2);
+  Gain<> g(10.0);
+  Sum<2> s;
+  Saturation<> sat(-1.0, 1.0);
+  g.getIn().connect(in.getOut());
+  s.getIn(0).connect(g.getOut());
+  s.getIn(1).connect(ff.getOut());
+  sat.getIn().connect(s.getOut());
+
+  StaticTimeDomain<2, double, fused::Gain<>, fused::AddInput<1>, fused::Saturation<>> 
+      axis(fused::Gain<>{10.0}, fused::AddInput<1>{}, fused::Saturation<>{-1.0, 1.0});
+  axis.getIn(0).connect(in.getOut());
+  axis.getIn(1).connect(ff.getOut());
+
+  for (double x : {-1.0, -0.1, 0.0, 0.05, 0.1, 2.0}) {
+    in.setValue(x);
+    in.run(); ff.run(); g.run(); s.run(); sat.run();
+    axis.run();
+    EXPECT_DOUBLE_EQ(axis.getOut().getSignal().getValue(), sat.getOut().getSignal().getValue());
+    EXPECT_EQ(axis.getOut().getSignal().getTimestamp(), in.getOut().getSignal().getTimestamp());
+  }
+}
+
+// Stages can be changed and custom functions used
+TEST(controlStaticTimeDomainTest, stages) {
+  Constant<> in(2.0);
+  auto square = fused::function([](double x) { return x * x; });
+  StaticTimeDomain<1, double, fused::Offset<>, decltype(square), fused::Gain<>> 
+      td(fused::Offset<>{1.0}, square, fused::Gain<>{0.5});
+  td.getIn().connect(in.getOut());
+  in.run();
+  td.run();
+  EXPECT_DOUBLE_EQ(td.getOut().getSignal().getValue(), 4.5);
+  td.getStage<2>().gain = 2.0;
+  td.run();
+  EXPECT_DOUBLE_EQ(td.getOut().getSignal().getValue(), 18.0);
+}
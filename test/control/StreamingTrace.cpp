@@ -0,0 +1,148 @@
+#include <eeros/control/StreamingTrace.hpp>
+#include <eeros/control/Constant.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+using namespace eeros;
+using namespace eeros::control;
+using namespace eeros::math;
+
+namespace {
+  template <typename V>
+  void readTrace(const std::string& fileName, StreamingTraceHeader& header,
+                 std::vector<timestamp_t>& time, std::vector<V>& values) {
+    std::ifstream file(fileName, std::ios::binary);
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    uint32_t count[2];
+    while (file.read(reinterpret_cast<char*>(count), sizeof(count))) {
+      size_t t = time.size(), v = values.size();
+      unsigned int c = header.rows * header.cols;
+      time.resize(t + count[0]);
+      values.resize(v + count[0] * c);
+      file.read(reinterpret_cast<char*>(time.data() + t), count[0] * sizeof(timestamp_t));
+      file.read(reinterpret_cast<char*>(values.data() + v), count[0] * c * sizeof(V));
+    }
+  }
+}
+
+// Samples are dropped if both halves are full
+TEST(controlStreamingTraceTest, overrun) {
+  StreamingTrace<> trace(2);
+  Constant<> c(1.0);
+  trace.getIn().connect(c.getOut());
+  c.run();
+  for (int i = 0; i < 5; i++) trace.run();
+  EXPECT_EQ(trace.getOverruns(), 0);
+  trace.enable();
+  for (int i = 0; i < 5; i++) trace.run();
+  EXPECT_EQ(trace.getOverruns(), 1);
+}
+
+// All samples are streamed to the binary file
+TEST(controlStreamingTraceTest, write) {
+  static std::ostringstream log;
+  logger::Logger::setDefaultStreamLogger(log);
+  std::string fileName = "streamingTraceTest.bin";
+  StreamingTrace<Vector3> trace(64);
+  trace.setName("trace");
+  Constant<Vector3> c;
+  trace.getIn().connect(c.getOut());
+  {
+    StreamingTraceWriter<Vector3> writer(trace, fileName);
+    trace.enable();
+    for (int i = 0; i < 100; i++) {
+      c.getOut().getSignal().set(Vector3{1.0 * i, 2.0 * i, 3.0 * i}, 1000 * i);
+      trace.run();
+    }
+    trace.disable();
+    trace.run();
+    writer.stop();
+    EXPECT_EQ(writer.getNofSamples(), 100);
+  }
+  EXPECT_EQ(trace.getOverruns(), 0);
+
+  StreamingTraceHeader header;
+  std::vector<timestamp_t> time;
+  std::vector<double> values;
+  readTrace(fileName, header, time, values);
+  EXPECT_EQ(std::string(header.magic, 4), "EETR");
+  EXPECT_EQ(header.version, 1);
+  EXPECT_EQ(header.rows, 3);
+  EXPECT_EQ(header.cols, 1);
+  EXPECT_EQ(header.elementSize, sizeof(double));
+  EXPECT_EQ(header.elementType, 2);
+  EXPECT_EQ(std::string(header.name), "trace");
+  ASSERT_EQ(time.size(), 100);
+  ASSERT_EQ(values.size(), 300);
+  for (int i = 0; i < 100; i++) {
+    EXPECT_EQ(time[i], 1000 * i);
+    EXPECT_EQ(values[3 * i], 1.0 * i);
+    EXPECT_EQ(values[3 * i + 2], 3.0 * i);
+  }
+  std::remove(fileName.c_str());
+}
+
+// Only windows around a trigger are written
+TEST(controlStreamingTraceTest, triggered) {
+  static std::ostringstream log;
+  logger::Logger::setDefaultStreamLogger(log);
+  std::string fileName = "triggeredTraceTest.bin";
+  StreamingTrace<> trace(8);
+  Constant<> c;
+  Constant<bool> t(false);
+  trace.getIn().connect(c.getOut());
+  trace.getTriggerIn().connect(t.getOut());
+  EXPECT_THROW(trace.setTrigger(6, 3), eeros::Fault);
+  EXPECT_THROW(trace.setTrigger(3, 0), eeros::Fault);
+  trace.setTrigger(3, 2);
+  ASSERT_EQ(trace.getInputBlocks().size(), 2);
+  t.run();
+  {
+    StreamingTraceWriter<> writer(trace, fileName);
+    trace.enable();
+    // the window of the first trigger wraps around the end of the ring
+    for (int i = 0; i < 26; i++) {
+      if (i == 24) trace.trigger();
+      c.getOut().getSignal().set(i, 100 * i);
+      trace.run();
+    }
+    for (int k = 0; k < 1000 && writer.getNofSamples() < 5; k++) usleep(1000);
+    ASSERT_EQ(writer.getNofSamples(), 5);
+    // a second trigger by the trigger input, only one sample of the new ring before it
+    for (int i = 26; i < 34; i++) {
+      if (i == 27) t.getOut().getSignal().setValue(true);
+      c.getOut().getSignal().set(i, 100 * i);
+      trace.run();
+    }
+    trace.disable();
+    trace.run();
+    writer.stop();
+    EXPECT_EQ(writer.getNofSamples(), 8);
+  }
+  EXPECT_EQ(trace.getOverruns(), 0);
+
+  StreamingTraceHeader header;
+  std::vector<timestamp_t> time;
+  std::vector<double> values;
+  readTrace(fileName, header, time, values);
+  std::vector<double> expected = {21, 22, 23, 24, 25, 26, 27, 28};
+  ASSERT_EQ(values.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    EXPECT_EQ(values[i], expected[i]);
+    EXPECT_EQ(time[i], 100 * expected[i]);
+  }
+  std::remove(fileName.c_str());
+}
+
+// Opening the file fails
+TEST(controlStreamingTraceTest, openFails) {
+  StreamingTrace<> trace;
+  EXPECT_THROW(StreamingTraceWriter<> writer(trace, "/nonexistent/dir/trace.bin"), eeros::Fault);
+}
@@ -0,0 +1,461 @@
+#include <eeros/control/TimeDomain.hpp>
+#include <eeros/control/Constant.hpp>
+#include <eeros/control/Gain.hpp>
+#include <eeros/control/Sum.hpp>
+#include <eeros/control/Delay.hpp>
+#include <eeros/control/Subio.hpp>
+#include <eeros/core/Fault.hpp>
+#include <eeros/core/System.hpp>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+
+using namespace eeros;
+using namespace eeros::control;
+
+class SleepBlock : public Block {
+ public:
+  void run() override { std::this_thread::sleep_for(std::chrono::microseconds(100)); }
+};
+
+// Without cycle timestamp every block reads the clock
+TEST(controlTimeDomainTest, noCycleTimestamp) {
+  TimeDomain td("td", 0.1, false);
+  Constant<> c1(1), c2(2);
+  SleepBlock s;
+  td.addBlock(c1);
+  td.addBlock(s);
+  td.addBlock(c2);
+  EXPECT_FALSE(td.getCycleTimestamp());
+  td.run();
+  EXPECT_LT(c1.getOut().getSignal().getTimestamp(), c2.getOut().getSignal().getTimestamp());
+}
+
+// With cycle timestamp all blocks get the same timestamp
+TEST(controlTimeDomainTest, cycleTimestamp) {
+  TimeDomain td("td", 0.1, false);
+  Constant<> c1(1), c2(2);
+  SleepBlock s;
+  td.addBlock(c1);
+  td.addBlock(s);
+  td.addBlock(c2);
+  td.setCycleTimestamp(true);
+  td.run();
+  uint64_t t1 = c1.getOut().getSignal().getTimestamp();
+  EXPECT_EQ(t1, c2.getOut().getSignal().getTimestamp());
+  // the clock is read again after the cycle and in the next cycle
+  EXPECT_GT(System::getTimeNs(), t1);
+  td.run();
+  EXPECT_GT(c1.getOut().getSignal().getTimestamp(), t1);
+}
+
+// Nested cycles keep the timestamp of the outer cycle
+TEST(controlTimeDomainTest, nestedCycle) {
+  EXPECT_TRUE(System::beginCycle());
+  uint64_t t = System::getTimeNs();
+  EXPECT_FALSE(System::beginCycle());
+  EXPECT_EQ(System::getTimeNs(), t);
+  System::endCycle();
+  EXPECT_NE(System::getTimeNs(), t);
+}
+
+// Blocks are sorted along their connections
+TEST(controlTimeDomainTest, sortChain) {
+  TimeDomain td("td", 0.1, false);
+  Constant<> c(1);
+  Gain<> g1(2), g2(3);
+  g1.getIn().connect(c.getOut());
+  g2.getIn().connect(g1.getOut());
+  td.addBlock(g2);
+  td.addBlock(g1);
+  td.addBlock(c);
+  td.sortBlocks();
+  auto& b = td.getBlocks();
+  ASSERT_EQ(b.size(), 3u);
+  EXPECT_EQ(b[0], &c);
+  EXPECT_EQ(b[1], &g1);
+  EXPECT_EQ(b[2], &g2);
+  td.run();
+  EXPECT_EQ(g2.getOut().getSignal().getValue(), 6);
+}
+
+// Unconnected blocks keep the order they were added in
+TEST(controlTimeDomainTest, sortKeepsOrder) {
+  TimeDomain td("td", 0.1, false);
+  Constant<> c1(1), c2(2), c3(3);
+  td.addBlock(c2);
+  td.addBlock(c3);
+  td.addBlock(c1);
+  td.sortBlocks();
+  auto& b = td.getBlocks();
+  EXPECT_EQ(b[0], &c2);
+  EXPECT_EQ(b[1], &c3);
+  EXPECT_EQ(b[2], &c1);
+  td.removeBlock(c3);
+  EXPECT_EQ(td.getBlocks().size(), 2u);
+}
+
+// A loop is broken at its delay
+TEST(controlTimeDomainTest, sortLoopWithDelay) {
+  TimeDomain td("td", 0.1, false);
+  Constant<> c(1);
+  Sum<2> s;
+  Gain<> g(2);
+  Delay<> d(0.1, 0.1);
+  s.getIn(0).connect(c.getOut());
+  s.getIn(1).connect(d.getOut());
+  g.getIn().connect(s.getOut());
+  d.getIn().connect(g.getOut());
+  td.addBlock(g);
+  td.addBlock(d);
+  td.addBlock(s);
+  td.addBlock(c);
+  td.sortBlocks();
+  auto& b = td.getBlocks();
+  ASSERT_EQ(b.size(), 4u);
+  EXPECT_EQ(b[0], &c);
+  EXPECT_EQ(b[1], &d);
+  EXPECT_EQ(b[2], &s);
+  EXPECT_EQ(b[3], &g);
+}
+
+// A loop without delay is reported
+TEST(controlTimeDomainTest, sortLoopWithoutDelay) {
+  TimeDomain td("td", 0.1, false);
+  Gain<> g1(2), g2(3);
+  g1.setName("g1");
+  g2.setName("g2");
+  g1.getIn().connect(g2.getOut());
+  g2.getIn().connect(g1.getOut());
+  td.addBlock(g1);
+  td.addBlock(g2);
+  EXPECT_THROW(td.sortBlocks(), eeros::Fault);
+}
+
+// A loop is broken at its own delay, not at a delay behind the loop
+TEST(controlTimeDomainTest, sortLoopWithDelayBehind) {
+  TimeDomain td("td", 0.1, false);
+  Constant<> c(1);
+  Sum<2> s;
+  Gain<> g(2);
+  Delay<> d(0.1, 0.1), behind(0.1, 0.1);
+  s.getIn(0).connect(c.getOut());
+  s.getIn(1).connect(d.getOut());
+  g.getIn().connect(s.getOut());
+  d.getIn().connect(g.getOut());
+  behind.getIn().connect(g.getOut());
+  td.addBlock(behind);
+  td.addBlock(g);
+  td.addBlock(d);
+  td.addBlock(s);
+  td.addBlock(c);
+  td.sortBlocks();
+  auto& b = td.getBlocks();
+  ASSERT_EQ(b.size(), 5u);
+  EXPECT_EQ(b[0], &c);
+  EXPECT_EQ(b[1], &d);
+  EXPECT_EQ(b[2], &s);
+  EXPECT_EQ(b[3], &g);
+  EXPECT_EQ(b[4], &behind);
+}
+
+// Only the blocks on a loop without delay are reported
+TEST(controlTimeDomainTest, sortLoopWithoutDelayReportsLoop) {
+  TimeDomain td("td", 0.1, false);
+  Gain<> g1(2), g2(3), g3(4);
+  g1.setName("g1");
+  g2.setName("g2");
+  g3.setName("g3");
+  g1.getIn().connect(g2.getOut());
+  g2.getIn().connect(g1.getOut());
+  g3.getIn().connect(g2.getOut());
+  td.addBlock(g3);
+  td.addBlock(g1);
+  td.addBlock(g2);
+  try {
+    td.sortBlocks();
+    FAIL() << "loop without delay not reported";
+  } catch (eeros::Fault& e) {
+    std::string msg = e.what();
+    EXPECT_NE(msg.find("'g1'"), std::string::npos);
+    EXPECT_NE(msg.find("'g2'"), std::string::npos);
+    EXPECT_EQ(msg.find("'g3'"), std::string::npos);
+  }
+}
+
+// A frozen time domain groups independent blocks of the same type
+TEST(controlTimeDomainTest, frozen) {
+  TimeDomain td("td", 0.1, false);
+  Constant<> c1(1), c2(2);
+  Gain<> g1(2), g2(3), g3(4);
+  g1.getIn().connect(c1.getOut());
+  g2.getIn().connect(c2.getOut());
+  g3.getIn().connect(g1.getOut());
+  td.addBlock(c1);
+  td.addBlock(g1);
+  td.addBlock(c2);
+  td.addBlock(g2);
+  td.addBlock(g3);
+  td.setFrozen(true);
+  td.run();
+  auto& b = td.getBlocks();
+  ASSERT_EQ(b.size(), 5u);
+  // the constants, the gains depending on them and finally g3
+  EXPECT_EQ(b[0], &c1);
+  EXPECT_EQ(b[1], &c2);
+  EXPECT_EQ(b[2], &g1);
+  EXPECT_EQ(b[3], &g2);
+  EXPECT_EQ(b[4], &g3);
+  EXPECT_EQ(g2.getOut().getSignal().getValue(), 6);
+  EXPECT_EQ(g3.getOut().getSignal().getValue(), 8);
+  // adding a block repacks the run list
+  Constant<> c3(3);
+  td.addBlock(c3);
+  td.run();
+  EXPECT_EQ(td.getBlocks().size(), 6u);
+}
+
+// A frozen time domain keeps reads of blocks added later delayed by one cycle
+TEST(controlTimeDomainTest, frozenKeepsDelayedReads) {
+  TimeDomain td("td", 0.1, false);
+  Constant<> c(1);
+  Gain<> g1(2), g2(3);
+  g2.getIn().connect(g1.getOut());
+  g1.getIn().connect(c.getOut());
+  td.addBlock(g2); // reads g1 of the previous cycle
+  td.addBlock(c);
+  td.addBlock(g1);
+  td.setFrozen(true);
+  td.start();
+  auto& b = td.getBlocks();
+  ASSERT_EQ(b.size(), 3u);
+  auto pos = [&b](Block* x) { return std::find(b.begin(), b.end(), x) - b.begin(); };
+  EXPECT_LT(pos(&g2), pos(&g1));
+  EXPECT_LT(pos(&c), pos(&g1));
+}
+
+// Each block gets its own run time statistics
+TEST(controlTimeDomainTest, profiling) {
+  TimeDomain td("td", 0.1, false);
+  Constant<> c(1.0);
+  SleepBlock s;
+  c.setName("c");
+  s.setName("sleep");
+  td.addBlock(c);
+  td.addBlock(s);
+  td.run();
+  EXPECT_EQ(td.getProfiler().getEntries().size(), 0);
+  td.setProfiling(true);
+  for (int i = 0; i < 5; i++) td.run();
+  auto& entries = td.getProfiler().getEntries();
+  ASSERT_EQ(entries.size(), 2);
+  EXPECT_EQ(entries[0].name, "c");
+  EXPECT_EQ(entries[1].name, "sleep");
+  EXPECT_EQ(entries[1].run.count, 5);
+  EXPECT_EQ(entries[1].histogram.getCount(), 5);
+  EXPECT_GE(entries[1].run.min, 100e-6);
+  EXPECT_LT(entries[0].run.max, entries[1].run.min);
+  td.getProfiler().reset();
+  EXPECT_EQ(entries[1].run.count, 0);
+}
+
+class CountBlock : public Block {
+ public:
+  void run() override { count++; }
+  int count = 0;
+};
+
+// An unconnected input is reported to the time domain, the remaining blocks are skipped
+TEST(controlTimeDomainTest, faultSlot) {
+  TimeDomain td("td", 0.1, false);
+  Gain<> g(2.0);
+  CountBlock after;
+  g.setName("g");
+  td.addBlock(g);
+  td.addBlock(after);
+  try {
+    td.run();
+    FAIL() << "no fault thrown";
+  } catch (Fault const& e) {
+    EXPECT_EQ(std::string(e.what()), "Read from an unconnected input in block 'g', time domain cannot trigger safety event");
+  }
+  EXPECT_EQ(after.count, 0);
+  EXPECT_THROW(g.getIn().getSignal(), NotConnectedFault);
+
+  Constant<> c(1.0);
+  g.getIn().connect(c.getOut());
+  td.run();
+  EXPECT_EQ(after.count, 1);
+}
+
+// Blocks with all inputs connected are bound, disconnecting unbinds them
+TEST(controlTimeDomainTest, validate) {
+  TimeDomain td("td", 0.1, false);
+  Constant<> c(2.0);
+  Gain<> g1(2.0), g2(3.0);
+  Sum<2> s;
+  g1.getIn().connect(c.getOut());
+  g2.getIn().connect(g1.getOut());
+  s.getIn(0).connect(g2.getOut());
+  td.addBlock(c);
+  td.addBlock(g1);
+  td.addBlock(g2);
+  td.addBlock(s);
+  auto unconnected = td.validate();
+  ASSERT_EQ(unconnected.size(), 1);
+  EXPECT_EQ(unconnected[0], &s);
+  EXPECT_TRUE(c.isBound());
+  EXPECT_TRUE(g2.isBound());
+  EXPECT_FALSE(s.isBound());
+
+  s.getIn(1).connect(c.getOut());
+  td.start();
+  EXPECT_TRUE(s.isBound());
+  td.run();
+  EXPECT_DOUBLE_EQ(s.getOut().getSignal().getValue(), 14.0);
+
+  g2.getIn().disconnect();
+  EXPECT_FALSE(g2.isBound());
+  EXPECT_THROW(td.run(), Fault);
+}
+
+// Blocks created by the time domain are run and placed next to each other
+TEST(controlTimeDomainTest, createBlock) {
+  TimeDomain td("td", 0.1, false);
+  td.getArena().reserve(4 * sizeof(Gain<>));
+  auto& c = td.createBlock<Constant<>>(3.0);
+  auto& g = td.createBlock<Gain<>>(2.0);
+  g.getIn().connect(c.getOut());
+  ASSERT_EQ(td.getBlocks().size(), 2);
+  EXPECT_EQ(td.getBlocks()[1], &g);
+  auto gap = reinterpret_cast<char*>(&g) - reinterpret_cast<char*>(&c);
+  EXPECT_GE(gap, static_cast<std::ptrdiff_t>(sizeof(Constant<>)));
+  EXPECT_LT(gap, static_cast<std::ptrdiff_t>(sizeof(Constant<>) + alignof(Gain<>)));
+  td.run();
+  EXPECT_DOUBLE_EQ(g.getOut().getSignal().getValue(), 6.0);
+}
+
+namespace {
+
+// output = 3 * input + input
+class Amplifier : public Subio<1,1> {
+ public:
+  Amplifier() : gain(3.0) {
+    gain.getIn().connect(in);
+    sum.getIn(0).connect(in);
+    sum.getIn(1).connect(gain.getOut());
+    setOut(sum.getOut());
+    addBlock(gain);
+    addBlock(sum);
+  }
+  Gain<> gain;
+  Sum<2> sum;
+};
+
+// two amplifiers in series
+class Chain : public Subio<1,1> {
+ public:
+  Chain() {
+    first.getIn().connect(in);
+    second.getIn().connect(first.getOut());
+    setOut(second.getOut());
+    addBlock(first);
+    addBlock(second);
+  }
+  Amplifier first, second;
+};
+
+}
+
+// Subsystems with registered blocks are replaced by their blocks, which read the source directly
+TEST(controlTimeDomainTest, flattenSubsystems) {
+  TimeDomain td("td", 0.1, false);
+  Constant<> c(2.0);
+  Chain chain;
+  Gain<> g(0.5);
+  chain.getIn().connect(c.getOut());
+  g.getIn().connect(chain.getOut());
+  td.addBlock(c);
+  td.addBlock(chain);
+  td.addBlock(g);
+  td.setProfiling(true);
+  td.run();
+  EXPECT_DOUBLE_EQ(g.getOut().getSignal().getValue(), 16.0);
+  EXPECT_EQ(td.getBlocks().size(), 3u);
+  auto& entries = td.getProfiler().getEntries();
+  ASSERT_EQ(entries.size(), 6u);
+  EXPECT_EQ(entries[1].block, &chain.first.gain);
+  EXPECT_EQ(entries[4].block, &chain.second.sum);
+  EXPECT_EQ(chain.first.gain.getIn().getConnectedBlock(), &c);
+  EXPECT_EQ(chain.second.sum.getIn(0).getConnectedBlock(), &chain.first);
+  EXPECT_TRUE(chain.first.gain.isBound());
+
+  // running a subsystem on its own runs its blocks
+  c.setValue(1.0);
+  c.run();
+  chain.run();
+  EXPECT_DOUBLE_EQ(chain.getOut().getSignal().getValue(), 16.0);
+}
+
+namespace {
+
+// counts its runs, output = input
+class CountingBlock : public Blockio<1,1> {
+ public:
+  void run() override {
+    runs++;
+    out.getSignal().set(in.getSignal().getValue(), in.getSignal().getTimestamp());
+  }
+  bool isSkippable() const override { return true; }
+  int runs = 0;
+};
+
+}
+
+// Skippable blocks only run if an input or a parameter changed
+TEST(controlTimeDomainTest, changePropagation) {
+  TimeDomain td("td", 0.1, false);
+  Constant<> c(2.0);
+  Gain<> g(3.0);
+  CountingBlock counter;
+  g.getIn().connect(c.getOut());
+  counter.getIn().connect(g.getOut());
+  td.addBlock(c);
+  td.addBlock(g);
+  td.addBlock(counter);
+  td.setChangePropagation(true);
+  EXPECT_TRUE(td.getChangePropagation());
+  for (int i = 0; i < 5; i++) td.run();
+  EXPECT_EQ(counter.runs, 1);
+  EXPECT_DOUBLE_EQ(counter.getOut().getSignal().getValue(), 6.0);
+  uint64_t version = g.getOut().getSignal().getVersion();
+
+  c.setValue(4.0);
+  td.run();
+  td.run();
+  EXPECT_EQ(counter.runs, 2);
+  EXPECT_EQ(g.getOut().getSignal().getVersion(), version + 1);
+  EXPECT_DOUBLE_EQ(counter.getOut().getSignal().getValue(), 12.0);
+
+  g.setGain(0.5);
+  td.run();
+  EXPECT_EQ(counter.runs, 3);
+  EXPECT_DOUBLE_EQ(counter.getOut().getSignal().getValue(), 2.0);
+
+  // a smooth gain change runs the gain every cycle
+  g.enableSmoothChange(true);
+  g.setGainDiff(0.5);
+  g.setGain(1.5);
+  td.run();
+  td.run();
+  td.run();
+  EXPECT_EQ(counter.runs, 6);
+  EXPECT_DOUBLE_EQ(counter.getOut().getSignal().getValue(), 6.0);
+
+  // without change propagation all blocks run
+  td.setChangePropagation(false);
+  td.run();
+  td.run();
+  EXPECT_EQ(counter.runs, 8);
+}
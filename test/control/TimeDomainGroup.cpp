@@ -0,0 +1,120 @@
+#include <eeros/control/TimeDomainGroup.hpp>
+#include <eeros/control/Blockio.hpp>
+#include <eeros/core/Fault.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace eeros;
+using namespace eeros::control;
+
+// Records the order in which blocks run
+class OrderBlock : public Block {
+ public:
+  OrderBlock(std::atomic<int>& clock, int sleepUs = 0) : clock(clock), sleepUs(sleepUs) { }
+  void run() override {
+    start = clock.fetch_add(1);
+    if (sleepUs > 0) std::this_thread::sleep_for(std::chrono::microseconds(sleepUs));
+    stop = clock.fetch_add(1);
+    runs++;
+  }
+  std::atomic<int>& clock;
+  int sleepUs;
+  int start = -1, stop = -1, runs = 0;
+};
+
+// Dependent time domains run in stages
+TEST(controlTimeDomainGroupTest, stages) {
+  TimeDomain a("a", 0.001, true), b("b", 0.001, true), c("c", 0.001, true), d("d", 0.001, true);
+  TimeDomainGroup g("g", 0.001, true, {0, 0});
+  g.add(a); g.add(b); g.add(c); g.add(d);
+  g.addDependency(a, c);
+  g.addDependency(b, c);
+  g.addDependency(c, d);
+  auto& stages = g.getStages();
+  ASSERT_EQ(stages.size(), 3u);
+  EXPECT_EQ(stages[0].size(), 2u);
+  EXPECT_EQ(stages[1][0], &c);
+  EXPECT_EQ(stages[2][0], &d);
+}
+
+// All time domains run once per cycle and dependencies are kept
+TEST(controlTimeDomainGroupTest, run) {
+  std::atomic<int> clock{0};
+  TimeDomain a("a", 0.001, true), b("b", 0.001, true), c("c", 0.001, true);
+  OrderBlock ba(clock, 2000), bb(clock, 2000), bc(clock);
+  a.addBlock(ba); b.addBlock(bb); c.addBlock(bc);
+  TimeDomainGroup g("g", 0.001, true, {0});
+  g.add(a); g.add(b); g.add(c);
+  g.addDependency(a, c);
+  g.addDependency(b, c);
+  for (int i = 0; i < 10; i++) {
+    g.run();
+    EXPECT_GT(bc.start, ba.stop);
+    EXPECT_GT(bc.start, bb.stop);
+  }
+  EXPECT_EQ(ba.runs, 10);
+  EXPECT_EQ(bb.runs, 10);
+  EXPECT_EQ(bc.runs, 10);
+  // a and b overlap as they run on different threads
+  EXPECT_LT(std::max(ba.start, bb.start), std::min(ba.stop, bb.stop));
+}
+
+// Counts its runs on its output
+class CounterBlock : public Blockio<0,1> {
+ public:
+  void run() override {
+    count++;
+    this->out.getSignal().set(count, static_cast<timestamp_t>(count));
+  }
+  double count = 0;
+};
+
+// Records its input
+class RecordBlock : public Blockio<1,0> {
+ public:
+  void run() override {
+    value = this->in.getSignal().getValue();
+  }
+  double value = 0;
+};
+
+// Pipelined time domains run in parallel, the consumer is one cycle behind
+TEST(controlTimeDomainGroupTest, pipeline) {
+  std::atomic<int> clock{0};
+  TimeDomain a("a", 0.001, true), b("b", 0.001, true);
+  OrderBlock ba(clock, 2000), bb(clock, 2000);
+  CounterBlock counter;
+  PipelineRegister<> reg;
+  RecordBlock record;
+  reg.getIn().connect(counter.getOut());
+  record.getIn().connect(reg.getOut());
+  a.addBlock(ba); a.addBlock(counter); a.addBlock(reg);
+  b.addBlock(bb); b.addBlock(record);
+  TimeDomainGroup g("g", 0.001, true, {0});
+  g.add(a); g.add(b);
+  g.addPipelineRegister(reg);
+  EXPECT_EQ(g.getStages().size(), 1u);
+  g.run();
+  EXPECT_TRUE(std::isnan(record.value));
+  for (int i = 2; i <= 5; i++) {
+    g.run();
+    EXPECT_EQ(record.value, i - 1);
+    EXPECT_EQ(reg.getOut().getSignal().getTimestamp(), static_cast<timestamp_t>(i - 1));
+  }
+  EXPECT_LT(std::max(ba.start, bb.start), std::min(ba.stop, bb.stop));
+}
+
+// Configuration errors are reported
+TEST(controlTimeDomainGroupTest, errors) {
+  TimeDomain a("a", 0.001, true), b("b", 0.001, true), slow("slow", 0.01, true);
+  TimeDomainGroup g("g", 0.001, true, {0});
+  EXPECT_THROW(g.add(slow), Fault);
+  g.add(a);
+  EXPECT_THROW(g.add(a), Fault);
+  g.add(b);
+  g.addDependency(a, b);
+  g.addDependency(b, a);
+  EXPECT_THROW(g.run(), Fault);
+}
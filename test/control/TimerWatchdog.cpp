@@ -0,0 +1,79 @@
+#include <eeros/control/TimerWatchdog.hpp>
+#include <eeros/safety/SafetySystem.hpp>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+using namespace eeros;
+using namespace eeros::control;
+
+namespace {
+
+class WatchdogProperties : public safety::SafetyProperties {
+ public:
+  WatchdogProperties() : seStall("stall"), slOn("on"), slOff("off") {
+    addLevel(slOff);
+    addLevel(slOn);
+    slOn.addEvent(seStall, slOff, safety::kPublicEvent);
+    setEntryLevel(slOn);
+  }
+  safety::SafetyEvent seStall;
+  safety::SafetyLevel slOn, slOff;
+};
+
+// waits until the watchdog fired, at most for 100 timeouts
+bool waitExpired(TimerWatchdog& w) {
+  for (int i = 0; i < 100 && w.getStatus(); i++) std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  return !w.getStatus();
+}
+
+}
+
+TEST(controlTimerWatchdogTest, pet) {
+  TimerWatchdog w(0.02);
+  w.arm();
+  for (int i = 0; i < 50; i++) {
+    w.run();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  EXPECT_TRUE(w.getStatus());
+  EXPECT_DOUBLE_EQ(w.getTimeout(), 0.02);
+}
+
+TEST(controlTimerWatchdogTest, stall) {
+  static std::stringstream out;
+  logger::Logger::setDefaultStreamLogger(out);
+  WatchdogProperties properties;
+  safety::SafetySystem ss(properties, 0.1);
+  ss.run();
+  TimerWatchdog w(0.02);
+  w.setName("wdt");
+  w.registerSafetyEvent(ss, properties.seStall);
+
+  // not armed, no timeout
+  std::this_thread::sleep_for(std::chrono::milliseconds(60));
+  EXPECT_TRUE(w.getStatus());
+
+  w.arm();
+  w.run();
+  auto start = std::chrono::steady_clock::now();
+  ASSERT_TRUE(waitExpired(w));
+  EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(19));
+  ss.run();
+  EXPECT_TRUE(ss.getCurrentLevel() == properties.slOff);
+  EXPECT_NE(out.str().find("timer watchdog 'wdt' timed out"), std::string::npos);
+
+  // running again does not clear the timeout, arming does
+  w.run();
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_FALSE(w.getStatus());
+  w.arm();
+  EXPECT_TRUE(w.getStatus());
+  EXPECT_TRUE(waitExpired(w));
+  w.disarm();
+  w.arm();
+  w.disarm();
+  std::this_thread::sleep_for(std::chrono::milliseconds(60));
+  EXPECT_TRUE(w.getStatus());
+}
@@ -128,3 +128,39 @@ TEST(controlTransitionSimpleTest, steady) {
   EXPECT_TRUE(Utils::compareApprox(t2.outBlock.getOut().getSignal().getValue(), 1.0, 1e-10));
 }
 
+
+TEST(controlTransitionBatchTest, batch) {
+  Transition<double, 16> t(0.25);
+  Constant<> c1(0), c2(0);
+  t.inBlock.getIn().connect(c1.getOut());
+  t.outBlock.getIn().connect(c2.getOut());
+  c2.getOut().getSignal().set(0, 25);
+  t.outBlock.run();
+  EXPECT_EQ(t.outBlock.getBatchLength(), 0);
+  EXPECT_TRUE(std::isnan(t.outBlock.getOut().getSignal().getValue()));
+  for (int i = 0; i < 4; i++) {
+    c1.getOut().getSignal().set(i, 10 * i);
+    t.inBlock.run();
+  }
+  t.outBlock.run();
+  ASSERT_EQ(t.outBlock.getBatchLength(), 4);
+  for (int i = 0; i < 4; i++) {
+    EXPECT_EQ(t.outBlock.getBatchValue(i), i);
+    EXPECT_EQ(t.outBlock.getBatchTimestamp(i), 10 * i);
+  }
+  EXPECT_EQ(t.outBlock.getOut().getSignal().getValue(), 2);
+  EXPECT_EQ(t.outBlock.getOut().getSignal().getTimestamp(), 20);
+  t.outBlock.run();	// nothing new, holds the last value
+  EXPECT_EQ(t.outBlock.getBatchLength(), 0);
+  EXPECT_EQ(t.outBlock.getOut().getSignal().getValue(), 2);
+  for (int i = 0; i < 20; i++) t.inBlock.run();
+  EXPECT_EQ(t.getOverruns(), 4);
+  t.outBlock.run();
+  EXPECT_EQ(t.outBlock.getBatchLength(), 16);
+}
+
+TEST(controlTransitionBatchTest, capacity) {
+  EXPECT_THROW((Transition<double, 8>(0.01)), eeros::Fault);
+  EXPECT_NO_THROW((Transition<double, 8>(0.125)));
+  EXPECT_NO_THROW((Transition<double, 8>(0.01, true)));
+}
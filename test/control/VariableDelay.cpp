@@ -0,0 +1,83 @@
+#include <eeros/control/VariableDelay.hpp>
+#include <eeros/control/Constant.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <eeros/core/Fault.hpp>
+#include <gtest/gtest.h>
+
+using namespace eeros;
+using namespace eeros::control;
+using namespace eeros::math;
+
+// Test buffer length and range of the delay
+TEST(controlVariableDelayTest, range) {
+  EXPECT_THROW(VariableDelay<> del(0.5, 1.0), eeros::Fault);
+  VariableDelay<> del(0.01, 0.001);
+  del.setName("delay");
+  EXPECT_DOUBLE_EQ(del.getMaxDelay(), 0.01);
+  EXPECT_DOUBLE_EQ(del.getDelay(), 0.01);
+  del.setDelay(0.003);
+  EXPECT_DOUBLE_EQ(del.getDelay(), 0.003);
+  try {
+    del.setDelay(0.011);
+    FAIL();
+  } catch(eeros::Fault const & err) {
+    EXPECT_EQ(err.what(), std::string("delay out of range in block 'delay'"));
+  }
+  EXPECT_THROW(del.setDelay(0.0005), eeros::Fault);
+  EXPECT_FALSE(del.hasDirectFeedthrough());
+}
+
+// Test integer delay
+TEST(controlVariableDelayTest, delay) {
+  VariableDelay<> del(0.003, 0.001);
+  Constant<> c;
+  del.getIn().connect(c.getOut());
+  for (int i = 0; i < 20; i++) {
+    c.getOut().getSignal().set(i, 1000 * (i + 1));
+    del.run();
+    if (i < 3) {
+      EXPECT_TRUE(std::isnan(del.getOut().getSignal().getValue()));
+    } else {
+      EXPECT_EQ(del.getOut().getSignal().getValue(), i - 3);
+      EXPECT_EQ(del.getOut().getSignal().getTimestamp(), 1000 * (i - 2));
+    }
+  }
+}
+
+// Test fractional delay and changing the delay at runtime
+TEST(controlVariableDelayTest, fractional) {
+  VariableDelay<> del(0.1, 0.01);
+  Constant<> c;
+  del.getIn().connect(c.getOut());
+  del.setDelay(0.025);
+  for (int i = 0; i < 30; i++) {
+    c.getOut().getSignal().set(2.0 * i, 10000 * i);
+    del.run();
+  }
+  EXPECT_DOUBLE_EQ(del.getOut().getSignal().getValue(), 2.0 * (29 - 2.5));
+  EXPECT_EQ(del.getOut().getSignal().getTimestamp(), 10000 * 29 - 25000);
+  del.setDelay(0.08);
+  c.getOut().getSignal().set(2.0 * 30, 10000 * 30);
+  del.run();
+  EXPECT_DOUBLE_EQ(del.getOut().getSignal().getValue(), 2.0 * (30 - 8));
+  del.reset();
+  del.run();
+  EXPECT_TRUE(std::isnan(del.getOut().getSignal().getValue()));
+}
+
+// Test many channels
+TEST(controlVariableDelayTest, channels) {
+  VariableDelay<Vector<7>> del(0.05, 0.001);
+  Constant<Vector<7>> c;
+  del.getIn().connect(c.getOut());
+  del.setDelay(0.0105);
+  for (int i = 0; i < 40; i++) {
+    Vector<7> v;
+    for (unsigned int j = 0; j < 7; j++) v(j) = i * (j + 1.0);
+    c.getOut().getSignal().setValue(v);
+    del.run();
+  }
+  for (unsigned int j = 0; j < 7; j++) {
+    EXPECT_DOUBLE_EQ(del.getOut().getSignal().getValue()(j), (39 - 10.5) * (j + 1.0));
+  }
+}
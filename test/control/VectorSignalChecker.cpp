@@ -0,0 +1,92 @@
+#include <eeros/control/VectorSignalChecker.hpp>
+#include <eeros/control/Constant.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <eeros/core/Fault.hpp>
+#include <eeros/safety/SafetySystem.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <sstream>
+
+using namespace eeros;
+using namespace eeros::control;
+using namespace eeros::math;
+
+namespace {
+
+class CheckerProperties : public safety::SafetyProperties {
+ public:
+  CheckerProperties() : seUp("se up"), seDown("se Down"), sl1("sl 1"), sl2("sl 2") {
+    addLevel(sl1);
+    addLevel(sl2);
+    sl1.addEvent(seUp, sl2, safety::kPublicEvent);
+    sl2.addEvent(seDown, sl1, safety::kPublicEvent);
+    setEntryLevel(sl1);
+  }
+  safety::SafetyEvent seUp, seDown;
+  safety::SafetyLevel sl1, sl2;
+};
+
+}
+
+TEST(controlVectorSignalCheckerTest, unconnected) {
+  VectorSignalChecker<Matrix<3,1>> s1(Matrix<3,1>(-1.0), Matrix<3,1>(1.0));
+  s1.setName("s1");
+  EXPECT_THROW(s1.run(), Fault);
+}
+
+TEST(controlVectorSignalCheckerTest, limits) {
+  static std::stringstream out;
+  logger::Logger::setDefaultStreamLogger(out);
+  VectorSignalChecker<Matrix<5,1>> s1({-1, -1, -1, -2, -2}, {1, 1, 1, 2, 2});
+  s1.setName("s1");
+  Constant<Matrix<5,1>> c1;
+  c1.getOut().getSignal().set({0, 0.5, 3, -3, 0}, 0);
+  s1.getIn().connect(c1.getOut());
+  s1.run(); // doesn't fire since no SE registered
+  EXPECT_EQ(s1.getViolation(), -1);
+  CheckerProperties properties;
+  safety::SafetySystem ss(properties, 0.1);
+  ss.run();
+  s1.registerSafetyEvent(ss, properties.seUp);
+  s1.run();
+  ss.run();
+  EXPECT_TRUE(ss.getCurrentLevel() == properties.sl2);
+  EXPECT_EQ(s1.getViolation(), 2);
+  EXPECT_NE(out.str().find("element 2"), std::string::npos);
+
+  // fires again only after a reset
+  ss.triggerEvent(properties.seDown);
+  ss.run();
+  c1.getOut().getSignal().set({0, 0, 0, 0, 2}, 0);
+  s1.run();
+  ss.run();
+  EXPECT_TRUE(ss.getCurrentLevel() == properties.sl1);
+  EXPECT_EQ(s1.getViolation(), 2);
+  s1.reset();
+  EXPECT_EQ(s1.getViolation(), -1);
+  s1.run();
+  ss.run();
+  EXPECT_TRUE(ss.getCurrentLevel() == properties.sl2);
+  EXPECT_EQ(s1.getViolation(), 4);
+
+  // within the limits
+  ss.triggerEvent(properties.seDown);
+  ss.run();
+  c1.getOut().getSignal().set({0.9, -0.9, 0, 1.9, -1.9}, 0);
+  s1.reset();
+  s1.run();
+  ss.run();
+  EXPECT_TRUE(ss.getCurrentLevel() == properties.sl1);
+
+  // not active in the current level
+  c1.getOut().getSignal().set({std::nan(""), 0, 0, 0, 0}, 0);
+  s1.setActiveLevel(properties.sl2);
+  s1.run();
+  ss.run();
+  EXPECT_TRUE(ss.getCurrentLevel() == properties.sl1);
+  s1.setActiveLevel(properties.sl1);
+  s1.run();
+  ss.run();
+  EXPECT_TRUE(ss.getCurrentLevel() == properties.sl2);
+  EXPECT_EQ(s1.getViolation(), 0);
+}
@@ -0,0 +1,66 @@
+#include <eeros/core/Arena.hpp>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+using namespace eeros;
+
+namespace {
+  struct Tracked {
+    Tracked(std::vector<int>& log, int id) : log(log), id(id) { }
+    ~Tracked() { log.push_back(id); }
+    std::vector<int>& log;
+    int id;
+  };
+}
+
+TEST(coreArenaTest, objectsAreContiguous) {
+  Arena arena;
+  EXPECT_EQ(arena.getCapacity(), 0);
+  auto& a = arena.create<double>(1.0);
+  auto& b = arena.create<double>(2.0);
+  EXPECT_EQ(&b, &a + 1);
+  EXPECT_EQ(arena.getUsed(), 2 * sizeof(double));
+  EXPECT_EQ(arena.getCapacity(), Arena::defaultChunkSize);
+}
+
+TEST(coreArenaTest, respectsAlignment) {
+  Arena arena;
+  arena.create<char>('x');
+  auto& d = arena.create<double>(1.0);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&d) % alignof(double), 0);
+  void* p = arena.allocate(1, 64);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % 64, 0);
+}
+
+TEST(coreArenaTest, destroysInReverseOrder) {
+  std::vector<int> log;
+  {
+    Arena arena;
+    arena.create<Tracked>(log, 1);
+    arena.create<Tracked>(log, 2);
+    arena.create<Tracked>(log, 3);
+    EXPECT_TRUE(log.empty());
+  }
+  EXPECT_EQ(log, (std::vector<int>{3, 2, 1}));
+}
+
+TEST(coreArenaTest, growsByChunks) {
+  Arena arena(256);
+  arena.createArray<char>(200);
+  arena.createArray<char>(200);
+  EXPECT_EQ(arena.getCapacity(), 512);
+  int* large = arena.createArray<int>(1000);
+  EXPECT_EQ(large[999], 0);
+  EXPECT_GE(arena.getCapacity(), 512 + 4000);
+}
+
+TEST(coreArenaTest, reserveKeepsObjectsInOneChunk) {
+  Arena arena(256);
+  arena.createArray<char>(200);
+  arena.reserve(1024);
+  EXPECT_EQ(arena.getCapacity(), 256 + 1024);
+  auto* a = arena.createArray<char>(500);
+  auto* b = arena.createArray<char>(500);
+  EXPECT_EQ(b, a + 500);
+}
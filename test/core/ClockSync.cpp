@@ -0,0 +1,35 @@
+#include <eeros/core/ClockSync.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+
+using namespace eeros;
+
+TEST(coreClockSyncTest, learnsDrift) {
+  constexpr int64_t period = 1000000;
+  ClockSync sync(period);
+  const double truePeriod = period * (1 + 50e-6);   // reference runs 50 ppm slow
+  for (int k = 0; k < 2000; k++) sync.update(std::llround(5000 + k * truePeriod));
+  EXPECT_NEAR(sync.getDrift(), 50e-6, 1e-6);
+  EXPECT_LE(std::abs(sync.getOffset()), 1);
+  EXPECT_NEAR(sync.predict(), 5000 + 2000 * truePeriod, 2);
+  EXPECT_EQ(sync.getResyncs(), 0);
+}
+
+TEST(coreClockSyncTest, toleratesJitter) {
+  constexpr int64_t period = 1000000;
+  ClockSync sync(period);
+  for (int k = 0; k < 2000; k++) sync.update(k * period + ((k % 2) ? 20000 : -20000));
+  EXPECT_NEAR(sync.getDrift(), 0, 1e-4);
+  EXPECT_EQ(sync.getResyncs(), 0);
+}
+
+TEST(coreClockSyncTest, resyncsAfterMissedCycle) {
+  constexpr int64_t period = 1000000;
+  ClockSync sync(period);
+  for (int k = 0; k < 100; k++) sync.update(k * period);
+  sync.update(101 * period);   // cycle 100 missed
+  EXPECT_EQ(sync.getResyncs(), 1);
+  EXPECT_EQ(sync.predict(), 102 * period);
+  sync.update(102 * period);
+  EXPECT_EQ(sync.getOffset(), 0);
+}
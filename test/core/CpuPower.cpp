@@ -0,0 +1,53 @@
+#include <eeros/core/CpuPower.hpp>
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+
+using namespace eeros;
+
+namespace {
+// fake sysfs tree with two cores
+struct FakeSysfs {
+  FakeSysfs() : root(std::filesystem::temp_directory_path() / "eeros_cpupower") {
+    std::filesystem::remove_all(root);
+    for (int cpu = 0; cpu < 2; cpu++) {
+      auto dir = root / ("cpu" + std::to_string(cpu)) / "cpufreq";
+      std::filesystem::create_directories(dir);
+      std::ofstream(dir / "scaling_governor") << "powersave\n";
+      std::ofstream(dir / "scaling_min_freq") << "800000\n";
+      std::ofstream(dir / "scaling_max_freq") << "3000000\n";
+    }
+    std::ofstream(root / "latency");
+  }
+  ~FakeSysfs() { std::filesystem::remove_all(root); }
+  std::filesystem::path root;
+};
+}
+
+// Governor and frequency are set on the given cores and restored on release
+TEST(coreCpuPowerTest, restore) {
+  FakeSysfs sysfs;
+  CpuPower power(sysfs.root.string(), (sysfs.root / "latency").string());
+  EXPECT_TRUE(power.setGovernor({1}, "performance"));
+  EXPECT_TRUE(power.setFrequency({1}, 2000000));
+  EXPECT_EQ(power.read(0, "scaling_governor"), "powersave");
+  EXPECT_EQ(power.read(1, "scaling_governor"), "performance");
+  EXPECT_EQ(power.read(1, "scaling_min_freq"), "2000000");
+  EXPECT_EQ(power.read(1, "scaling_max_freq"), "2000000");
+  power.release();
+  EXPECT_EQ(power.read(1, "scaling_governor"), "powersave");
+  EXPECT_EQ(power.read(1, "scaling_min_freq"), "800000");
+  EXPECT_EQ(power.read(1, "scaling_max_freq"), "3000000");
+}
+
+// The latency request is written as a binary 32 bit value, missing cores are reported
+TEST(coreCpuPowerTest, latency) {
+  FakeSysfs sysfs;
+  CpuPower power(sysfs.root.string(), (sysfs.root / "latency").string());
+  EXPECT_TRUE(power.requestLatency(10));
+  EXPECT_EQ(power.getLatency(), 10);
+  EXPECT_FALSE(power.setGovernor({5}, "performance"));
+  CpuPower missing(sysfs.root.string(), (sysfs.root / "none").string());
+  EXPECT_FALSE(missing.requestLatency(10));
+  EXPECT_EQ(missing.getLatency(), -1);
+}
@@ -0,0 +1,162 @@
+#include <eeros/core/Executor.hpp>
+#include <eeros/core/System.hpp>
+#include <eeros/logger/StreamLogWriter.hpp>
+#include <eeros/task/Lambda.hpp>
+#include <gtest/gtest.h>
+#include <set>
+#include <thread>
+#include <vector>
+#include <time.h>
+
+using namespace eeros;
+
+// Two executors with different base periods run their own periodics in lockstep
+TEST(coreExecutorTest, multipleInstances) {
+  logger::Logger::setDefaultStreamLogger(std::cout);
+  Executor a, b;
+  int runsA = 0, runsB = 0;
+  bool currentA = true, currentB = true;
+  task::Lambda fa([&]() { runsA++; currentA = currentA && &Executor::current() == &a; });
+  task::Lambda fb([&]() { runsB++; currentB = currentB && &Executor::current() == &b; });
+  task::Periodic pa("a", 0.002, fa, false);
+  task::Periodic pb("b", 0.003, fb, false);
+  a.setExecutorPeriod(0.001);
+  b.setExecutorPeriod(0.003);
+  a.add(pa);
+  b.add(pb);
+  for (auto e : {&a, &b}) {
+    e->setTimingMode(Executor::TimingMode::lockstep);
+    e->setHalUpdate(false);
+    e->setPriorityOffset(10);
+  }
+  std::thread ta([&]() { a.run(); });
+  std::thread tb([&]() { b.run(); });
+  EXPECT_TRUE(a.step(10));
+  EXPECT_TRUE(b.step(4));
+  a.shutdown();
+  EXPECT_TRUE(b.step(1));
+  b.shutdown();
+  ta.join();
+  tb.join();
+  EXPECT_EQ(runsA, 5);
+  EXPECT_EQ(runsB, 5);
+  EXPECT_TRUE(currentA);
+  EXPECT_TRUE(currentB);
+  EXPECT_EQ(&Executor::current(), &Executor::instance());
+}
+
+// An executor found unschedulable after calibration stops without stopping the others
+TEST(coreExecutorTest, enforceStopsOwnExecutorOnly) {
+  logger::Logger::setDefaultStreamLogger(std::cout);
+  Executor a, b;
+  task::Lambda fa([]() { });
+  task::Lambda fb([]() { });
+  task::Periodic pa("a", 0.002, fa, true);   // only realtime periodics are analyzed
+  task::Periodic pb("b", 0.002, fb, false);
+  pa.setWcet(0.01);   // longer than its period
+  a.setExecutorPeriod(0.001);
+  b.setExecutorPeriod(0.001);
+  a.add(pa);
+  b.add(pb);
+  a.setSchedulabilityCheck(Executor::SchedulabilityCheck::enforce, 5);   // lockstep does not calibrate
+  b.setTimingMode(Executor::TimingMode::lockstep);
+  for (auto e : {&a, &b}) {
+    e->setHalUpdate(false);
+    e->setPriorityOffset(10);
+  }
+  std::thread tb([&]() { b.run(); });
+  std::thread ta([&]() { a.run(); });
+  ta.join();
+  EXPECT_TRUE(b.step(3));
+  b.shutdown();
+  tb.join();
+}
+
+// A periodic with a phase offset is released that many base cycles later
+TEST(coreExecutorTest, phaseOffsets) {
+  logger::Logger::setDefaultStreamLogger(std::cout);
+  Executor e;
+  std::vector<uint64_t> releases[4];
+  std::vector<task::Lambda> f;
+  f.reserve(4);
+  for (int i = 0; i < 4; i++) f.emplace_back([&releases, i]() { releases[i].push_back(System::getTimeNs()); });
+  e.setExecutorPeriod(0.001);
+  for (int i = 0; i < 4; i++) {
+    task::Periodic p("p" + std::to_string(i), 0.004, f[i], false);
+    p.setPhase(i);
+    e.add(p);
+  }
+  e.setTimingMode(Executor::TimingMode::lockstep);
+  e.setHalUpdate(false);
+  e.setPriorityOffset(10);
+  std::thread t([&]() { e.run(); });
+  EXPECT_TRUE(e.step(8));
+  e.shutdown();
+  t.join();
+  // the simulated time of cycle n is n ms, phase 0 is released with every fourth cycle
+  EXPECT_EQ(releases[0], (std::vector<uint64_t>{4000000, 8000000}));
+  EXPECT_EQ(releases[1], (std::vector<uint64_t>{1000000, 5000000}));
+  EXPECT_EQ(releases[2], (std::vector<uint64_t>{2000000, 6000000}));
+  EXPECT_EQ(releases[3], (std::vector<uint64_t>{3000000, 7000000}));
+}
+
+// With phase distribution, periodics without a phase are released in different cycles
+TEST(coreExecutorTest, distributedPhases) {
+  logger::Logger::setDefaultStreamLogger(std::cout);
+  Executor e;
+  std::vector<uint64_t> releases;
+  task::Lambda f([&]() { releases.push_back(System::getTimeNs()); });
+  e.setExecutorPeriod(0.001);
+  for (int i = 0; i < 4; i++) {
+    task::Periodic p("p" + std::to_string(i), 0.004, f, false);
+    e.add(p);
+  }
+  e.setPhaseDistribution(true);
+  e.setTimingMode(Executor::TimingMode::lockstep);
+  e.setHalUpdate(false);
+  e.setPriorityOffset(10);
+  std::thread t([&]() { e.run(); });
+  EXPECT_TRUE(e.step(4));
+  e.shutdown();
+  t.join();
+  ASSERT_EQ(releases.size(), 4u);
+  EXPECT_EQ(std::set<uint64_t>(releases.begin(), releases.end()).size(), 4u);
+}
+
+static uint64_t clockNs(clockid_t id) {
+  struct timespec ts;
+  clock_gettime(id, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+// Periodics read the selected clock source, while the cycle time stays simulated in lockstep
+TEST(coreExecutorTest, clockSource) {
+  logger::Logger::setDefaultStreamLogger(std::cout);
+  struct Source { System::ClockSource source; clockid_t id; uint64_t tolerance; };
+  // the TSC is calibrated against CLOCK_MONOTONIC and may drift slightly
+  for (auto s : {Source{System::ClockSource::monotonic, CLOCK_MONOTONIC, 0},
+                 Source{System::ClockSource::monotonicRaw, CLOCK_MONOTONIC_RAW, 0},
+                 Source{System::ClockSource::tsc, CLOCK_MONOTONIC, 1000000}}) {
+    if (!System::setClockSource(s.source)) continue;   // the TSC is not available everywhere
+    EXPECT_EQ(System::getClockSource(), s.source);
+    Executor e;
+    uint64_t clock = 0, cycle = 0;
+    task::Lambda f([&]() { clock = System::getClockNs(); cycle = System::getTimeNs(); });
+    e.setExecutorPeriod(0.001);
+    task::Periodic p("p", 0.001, f, false);
+    e.add(p);
+    e.setTimingMode(Executor::TimingMode::lockstep);
+    e.setHalUpdate(false);
+    e.setPriorityOffset(10);
+    std::thread t([&]() { e.run(); });
+    uint64_t before = clockNs(s.id);
+    EXPECT_TRUE(e.step(3));
+    uint64_t after = clockNs(s.id);
+    e.shutdown();
+    t.join();
+    EXPECT_GE(clock + s.tolerance, before);
+    EXPECT_LE(clock, after + s.tolerance);
+    EXPECT_EQ(cycle, 3000000u);
+  }
+  System::setClockSource(System::ClockSource::monotonicRaw);
+}
@@ -0,0 +1,61 @@
+#include <eeros/core/ExternalClock.hpp>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+
+using namespace eeros;
+
+TEST(coreExternalClockTest, wakesOnUpdate) {
+  ExternalClock clock;
+  std::thread simulator([&clock]() {
+    for (uint64_t t = 1; t <= 5; t++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      clock.update(t * 1000);
+    }
+  });
+  EXPECT_TRUE(clock.waitForChange(0));
+  EXPECT_GE(clock.getTimeNs(), 1000);
+  EXPECT_TRUE(clock.waitUntil(5000));
+  EXPECT_EQ(clock.getTimeNs(), 5000);
+  simulator.join();
+  EXPECT_GE(clock.getLatency().getCount(), 1);
+}
+
+TEST(coreExternalClockTest, returnsImmediatelyWhenReached) {
+  ExternalClock clock;
+  clock.update(2000);
+  EXPECT_TRUE(clock.waitUntil(1000));
+  EXPECT_TRUE(clock.waitForChange(1000));
+  EXPECT_EQ(clock.getLatency().getCount(), 0);
+}
+
+TEST(coreExternalClockTest, detectsReset) {
+  ExternalClock clock;
+  clock.update(5000);
+  std::thread simulator([&clock]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    clock.update(0);
+  });
+  EXPECT_TRUE(clock.waitForChange(5000));
+  EXPECT_EQ(clock.getTimeNs(), 0);
+  simulator.join();
+}
+
+TEST(coreExternalClockTest, stopReleasesWaiter) {
+  ExternalClock clock;
+  std::thread stopper([&clock]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    clock.stop();
+  });
+  EXPECT_FALSE(clock.waitUntil(1000));
+  stopper.join();
+  EXPECT_FALSE(clock.waitForChange(0));
+}
+
+TEST(coreExternalClockTest, timesOut) {
+  ExternalClock clock;
+  EXPECT_FALSE(clock.waitForChange(0, 0.002));
+  clock.update(1000);
+  EXPECT_FALSE(clock.waitUntil(2000, 0.002));
+  EXPECT_TRUE(clock.waitUntil(1000, 0.002));
+}
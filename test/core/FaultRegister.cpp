@@ -0,0 +1,29 @@
+#include <eeros/core/Fault.hpp>
+#include <gtest/gtest.h>
+
+using namespace eeros;
+
+namespace {
+
+constexpr FaultCode testFault{100, "test fault"};
+
+}
+
+TEST(coreFaultRegisterTest, report) {
+  FaultRegister::clear();
+  EXPECT_EQ(FaultRegister::first(), nullptr);
+  EXPECT_NO_THROW(FaultRegister::rethrow());
+  FaultRegister::report(testFault);
+  FaultRegister::report(faults::clock);
+  EXPECT_EQ(FaultRegister::first(), &testFault);
+  EXPECT_EQ(FaultRegister::count(), 2);
+  try {
+    FaultRegister::rethrow();
+    FAIL();
+  } catch (Fault const& f) {
+    EXPECT_EQ(f.what(), std::string("test fault"));
+    EXPECT_EQ(f.getCode(), 100);
+  }
+  EXPECT_EQ(FaultRegister::first(), nullptr);
+  EXPECT_EQ(FaultRegister::count(), 0);
+}
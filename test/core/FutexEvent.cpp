@@ -0,0 +1,42 @@
+#include <eeros/core/FutexEvent.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace eeros;
+
+TEST(coreFutexEventTest, timesOutWithoutNotify) {
+  FutexEvent event;
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(event.wait(event.prepare(), 0.01));
+  EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(9));
+}
+
+TEST(coreFutexEventTest, notifyBeforeWaitIsNotLost) {
+  FutexEvent event;
+  uint32_t generation = event.prepare();
+  event.notify();
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(event.wait(generation, 1.0));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(100));
+}
+
+TEST(coreFutexEventTest, wakesAllWaiters) {
+  FutexEvent event;
+  std::atomic<int> started{0}, woken{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([&]() {
+      uint32_t generation = event.prepare();
+      started++;
+      if (event.wait(generation, 5.0)) woken++;
+    });
+  }
+  while (started < 4) std::this_thread::yield();
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  event.notify();
+  for (auto& t : threads) t.join();
+  EXPECT_EQ(woken, 4);
+}
@@ -0,0 +1,74 @@
+#include <eeros/core/FutexSemaphore.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace eeros;
+
+TEST(coreFutexSemaphoreTest, postBeforeWait) {
+  FutexSemaphore sem;
+  sem.post();
+  sem.post();
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(sem.wait(1.0));
+  EXPECT_TRUE(sem.wait(1.0));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(100));
+  EXPECT_FALSE(sem.wait(0.001));
+}
+
+TEST(coreFutexSemaphoreTest, initialCount) {
+  FutexSemaphore sem(1);
+  EXPECT_TRUE(sem.wait(0.001));
+  EXPECT_FALSE(sem.wait(0.001));
+}
+
+TEST(coreFutexSemaphoreTest, waitThenPost) {
+  FutexSemaphore sem(0, 0);
+  std::atomic<bool> started{false}, woken{false};
+  std::thread t([&]() {
+    started = true;
+    sem.wait();
+    woken = true;
+  });
+  while (!started) std::this_thread::yield();
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_FALSE(woken);
+  sem.post();
+  t.join();
+  EXPECT_TRUE(woken);
+}
+
+TEST(coreFutexSemaphoreTest, timedWaitExpires) {
+  FutexSemaphore sem;
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(sem.wait(0.01));
+  EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(9));
+  // a post after the expired wait is not lost
+  sem.post();
+  EXPECT_TRUE(sem.wait(1.0));
+}
+
+TEST(coreFutexSemaphoreTest, oneWaiterPerPost) {
+  FutexSemaphore sem;
+  constexpr int nofWaiters = 4;
+  std::atomic<int> started{0}, woken{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < nofWaiters; i++) {
+    threads.emplace_back([&]() {
+      started++;
+      if (sem.wait(5.0)) woken++;
+    });
+  }
+  while (started < nofWaiters) std::this_thread::yield();
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  for (int i = 0; i < nofWaiters - 1; i++) sem.post();
+  auto start = std::chrono::steady_clock::now();
+  while (woken < nofWaiters - 1 && std::chrono::steady_clock::now() - start < std::chrono::seconds(2)) std::this_thread::yield();
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_EQ(woken, nofWaiters - 1);
+  sem.post();
+  for (auto& t : threads) t.join();
+  EXPECT_EQ(woken, nofWaiters);
+}
@@ -0,0 +1,39 @@
+#include <eeros/core/Histogram.hpp>
+#include <gtest/gtest.h>
+
+using namespace eeros;
+
+TEST(coreHistogramTest, bucketBounds) {
+  for (uint64_t ns : {0ull, 1ull, 31ull, 32ull, 33ull, 1000ull, 123456ull, 1000000000ull}) {
+    int i = Histogram::bucketIndex(ns);
+    EXPECT_GE(Histogram::bucketUpperBound(i), ns);
+    if (i > 0) {
+      EXPECT_LT(Histogram::bucketUpperBound(i - 1), ns);
+    }
+  }
+  EXPECT_EQ(Histogram::bucketIndex(~0ull), Histogram::bucketCount - 1);
+}
+
+TEST(coreHistogramTest, percentiles) {
+  Histogram h;
+  for (int i = 1; i <= 1000; i++) h.add(i * 1e-6);
+  EXPECT_EQ(h.getCount(), 1000u);
+  auto s = h.snapshot();
+  EXPECT_EQ(s.count, 1000u);
+  EXPECT_NEAR(s.percentile(0.5), 500e-6, 500e-6 * 0.04);
+  EXPECT_NEAR(s.percentile(0.99), 990e-6, 990e-6 * 0.04);
+  EXPECT_NEAR(s.percentile(1.0), 1000e-6, 1000e-6 * 0.04);
+  h.reset();
+  EXPECT_EQ(h.snapshot().count, 0u);
+  EXPECT_EQ(h.snapshot().percentile(0.99), 0.0);
+}
+
+TEST(coreHistogramTest, negativeValues) {
+  Histogram h;
+  for (int i = 0; i < 90; i++) h.add(-10e-6);
+  for (int i = 0; i < 10; i++) h.add(20e-6);
+  auto s = h.snapshot();
+  EXPECT_LT(s.percentile(0.5), 0.0);
+  EXPECT_NEAR(s.percentile(0.5), -10e-6, 10e-6 * 0.04);
+  EXPECT_NEAR(s.percentile(0.99), 20e-6, 20e-6 * 0.04);
+}
@@ -0,0 +1,118 @@
+#include <eeros/core/SpscRingBuffer.hpp>
+#include <eeros/core/MpscRingBuffer.hpp>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace eeros;
+
+template < typename B >
+void fillAndDrain(B& rb) {
+  int v;
+  EXPECT_EQ(rb.size(), 4);
+  EXPECT_EQ(rb.length(), 0u);
+  EXPECT_FALSE(rb.pop(v));
+  for (int round = 0; round < 3; round++) { // wrap around several times
+    for (int i = 0; i < 4; i++) {
+      EXPECT_TRUE(rb.push(round * 10 + i));
+      EXPECT_EQ(rb.length(), static_cast<unsigned int>(i + 1));
+    }
+    EXPECT_FALSE(rb.push(99));
+    for (int i = 0; i < 4; i++) {
+      EXPECT_TRUE(rb.pop(v));
+      EXPECT_EQ(v, round * 10 + i);
+    }
+    EXPECT_FALSE(rb.pop(v));
+    EXPECT_EQ(rb.length(), 0u);
+  }
+}
+
+// Same behavior as RingBuffer in a single thread
+TEST(coreSpscRingBufferTest, singleThread) {
+  SpscRingBuffer<int, 4> rb;
+  fillAndDrain(rb);
+}
+
+// Items are filled and used in place, which keeps their memory
+TEST(coreSpscRingBufferTest, inPlace) {
+  SpscRingBuffer<std::vector<int>, 2> rb;
+  for (int round = 0; round < 3; round++) {
+    for (int i = 0; i < 2; i++) {
+      std::vector<int>* slot = rb.claim();
+      ASSERT_NE(slot, nullptr);
+      slot->assign(100, round);
+      rb.push();
+    }
+    EXPECT_EQ(rb.claim(), nullptr);
+    for (int i = 0; i < 2; i++) {
+      const std::vector<int>* item = rb.front();
+      ASSERT_NE(item, nullptr);
+      EXPECT_EQ(item->size(), 100);
+      EXPECT_EQ((*item)[0], round);
+      rb.pop();
+    }
+    EXPECT_EQ(rb.front(), nullptr);
+  }
+  EXPECT_GE(rb.claim()->capacity(), 100);
+}
+
+TEST(coreSpscRingBufferTest, initialSlots) {
+  SpscRingBuffer<std::vector<int>, 4> rb(std::vector<int>(100));
+  for (int i = 0; i < 4; i++) {
+    std::vector<int>* slot = rb.claim();
+    ASSERT_NE(slot, nullptr);
+    EXPECT_EQ(slot->size(), 100);
+    const int* data = slot->data();
+    slot->assign(80, i);
+    EXPECT_EQ(slot->data(), data);
+    rb.push();
+  }
+}
+
+TEST(coreMpscRingBufferTest, singleThread) {
+  MpscRingBuffer<int, 4> rb;
+  fillAndDrain(rb);
+}
+
+// All items arrive in order
+TEST(coreSpscRingBufferTest, twoThreads) {
+  SpscRingBuffer<int, 64> rb;
+  const int count = 100000;
+  std::thread producer([&]() {
+    for (int i = 0; i < count; i++) while (!rb.push(i)) std::this_thread::yield();
+  });
+  int v, expected = 0;
+  bool ordered = true;
+  while (expected < count) {
+    if (rb.pop(v)) ordered = ordered && (v == expected++);
+    else std::this_thread::yield();
+  }
+  producer.join();
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(rb.length(), 0u);
+}
+
+// All items arrive exactly once and in order per producer
+TEST(coreMpscRingBufferTest, fourProducers) {
+  MpscRingBuffer<int, 64> rb;
+  const int producers = 4, count = 25000;
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; p++) {
+    threads.emplace_back([&rb, p]() {
+      for (int i = 0; i < count; i++) while (!rb.push(p * count + i)) std::this_thread::yield();
+    });
+  }
+  std::vector<int> next(producers, 0);
+  bool ordered = true;
+  int v, received = 0;
+  while (received < producers * count) {
+    if (rb.pop(v)) {
+      int p = v / count;
+      ordered = ordered && (v % count == next[p]++);
+      received++;
+    } else std::this_thread::yield();
+  }
+  for (auto& t : threads) t.join();
+  EXPECT_TRUE(ordered);
+  for (int p = 0; p < producers; p++) EXPECT_EQ(next[p], count);
+}
@@ -0,0 +1,73 @@
+#include <eeros/core/ParameterSet.hpp>
+#include <gtest/gtest.h>
+#include <array>
+#include <atomic>
+#include <thread>
+
+using namespace eeros;
+
+namespace {
+  struct Wide {
+    std::array<double, 32> values{};
+  };
+}
+
+TEST(coreParameterSetTest, publishAndAcquire) {
+  ParameterSet<int> p(1);
+  EXPECT_EQ(p.acquire(), 1);
+  p.publish(2);
+  EXPECT_EQ(p.get(), 2);
+  EXPECT_EQ(p.acquire(), 2);
+  p.modify([](int& v) { v *= 3; });
+  EXPECT_EQ(p.acquire(), 6);
+}
+
+TEST(coreParameterSetTest, acquiredSetStaysValid) {
+  ParameterSet<int> p(1);
+  const int& v = p.acquire();
+  p.publish(2);
+  p.publish(3);
+  EXPECT_EQ(v, 1);
+  EXPECT_EQ(p.getRetired(), 2);
+}
+
+TEST(coreParameterSetTest, reclaimsAfterGracePeriod) {
+  ParameterSet<int> p(1);
+  p.acquire();
+  p.publish(2);
+  EXPECT_EQ(p.getRetired(), 1);
+  p.acquire();
+  p.publish(3);
+  EXPECT_EQ(p.getRetired(), 2);  // the first acquire may still have read set 1
+  p.acquire();
+  p.acquire();
+  p.publish(4);
+  EXPECT_EQ(p.getRetired(), 1);
+}
+
+TEST(coreParameterSetTest, readerNeverSeesTornSet) {
+  ParameterSet<Wide> p;
+  std::atomic<bool> done{false};
+  std::thread writer([&]() {
+    for (int i = 1; i <= 20000; i++) {
+      p.modify([i](Wide& w) { w.values.fill(i); });
+    }
+    done = true;
+  });
+  int torn = 0;
+  double last = 0;
+  bool monotonic = true;
+  while (!done) {
+    const Wide& w = p.acquire();
+    for (auto v : w.values) if (v != w.values[0]) torn++;
+    if (w.values[0] < last) monotonic = false;
+    last = w.values[0];
+  }
+  writer.join();
+  EXPECT_EQ(torn, 0);
+  EXPECT_TRUE(monotonic);
+  EXPECT_EQ(p.acquire().values[31], 20000);
+  p.acquire();
+  p.publish(Wide{});
+  EXPECT_EQ(p.getRetired(), 1);  // everything replaced while the reader was running is reclaimed
+}
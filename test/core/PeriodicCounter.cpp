@@ -0,0 +1,35 @@
+#include <eeros/core/PeriodicCounter.hpp>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <sys/mman.h>
+
+using namespace eeros;
+
+// Sleeping and touching new pages shows up as context switches and page faults
+TEST(corePeriodicCounterTest, osCounters) {
+  PeriodicCounter counter(0.001);
+  counter.setOsSampling(1);
+  const std::size_t size = 64 * 4096;
+  for (int i = 0; i < 5; i++) {
+    counter.tick();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(p, MAP_FAILED);
+    for (std::size_t b = 0; b < size; b += 4096) static_cast<volatile char*>(p)[b] = 1;
+    munmap(p, size);
+    counter.tock();
+  }
+  EXPECT_GT(counter.os.voluntarySwitches, 0u);
+  EXPECT_GE(counter.os.minorFaults, 64u);
+}
+
+// Without sampling the counters stay zero
+TEST(corePeriodicCounterTest, osCountersDisabled) {
+  PeriodicCounter counter(0.001);
+  counter.tick();
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  counter.tock();
+  EXPECT_EQ(counter.os.voluntarySwitches, 0u);
+  EXPECT_EQ(counter.os.minorFaults, 0u);
+}
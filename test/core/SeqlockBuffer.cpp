@@ -0,0 +1,59 @@
+#include <eeros/core/SeqlockBuffer.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace eeros;
+using namespace eeros::math;
+
+// Written data can be read and the sequence number changes
+TEST(coreSeqlockBufferTest, readWrite) {
+  SeqlockBuffer<Matrix<3,1,double>> b;
+  Matrix<3,1,double> v{1.0, 2.0, 3.0}, r;
+  uint32_t seq = b.getSequence();
+  EXPECT_FALSE(b.read(r));   // nothing written yet
+  b.write(v);
+  EXPECT_NE(b.getSequence(), seq);
+  EXPECT_EQ(b.getSequence() % 2, 0u);
+  EXPECT_TRUE(b.read(r));
+  EXPECT_EQ(r, v);
+}
+
+// Several readers never see a partially written payload
+TEST(coreSeqlockBufferTest, manyReaders) {
+  SeqlockBuffer<Matrix<64,1,int>> b;
+  std::atomic<bool> done{false};
+  std::atomic<int> errors{0};
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 3; r++) {
+    readers.emplace_back([&]() {
+      Matrix<64,1,int> v;
+      while (!done) {
+        if (!b.read(v)) continue;
+        for (int j = 1; j < 64; j++) if (v(j) != v(0)) errors++;
+      }
+    });
+  }
+  Matrix<64,1,int> m;
+  for (int i = 1; i <= 20000; i++) {
+    m.fill(i);
+    b.write(m);
+  }
+  done = true;
+  for (auto& t : readers) t.join();
+  EXPECT_EQ(errors, 0);
+}
+
+// Written data can still be read after the sequence number wrapped around
+TEST(coreSeqlockBufferTest, sequenceWrap) {
+  SeqlockBuffer<uint8_t> b;
+  uint8_t r = 0;
+  for (uint32_t i = 0; i < 0x80000000u; i++) b.write(static_cast<uint8_t>(i));
+  EXPECT_NE(b.getSequence(), 0u);
+  EXPECT_TRUE(b.read(r));
+  EXPECT_EQ(r, 0xff);
+  b.write(7);
+  EXPECT_TRUE(b.read(r));
+  EXPECT_EQ(r, 7);
+}
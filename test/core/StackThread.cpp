@@ -0,0 +1,60 @@
+#include <eeros/core/StackThread.hpp>
+#include <eeros/core/Executor.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <utility>
+
+using namespace eeros;
+
+namespace {
+  std::size_t currentStackSize() {
+    pthread_attr_t attr;
+    std::size_t size = 0;
+    if (pthread_getattr_np(pthread_self(), &attr) == 0) {
+      pthread_attr_getstacksize(&attr, &size);
+      pthread_attr_destroy(&attr);
+    }
+    return size;
+  }
+}
+
+TEST(coreStackThreadTest, runsWithGivenStackSize) {
+  constexpr std::size_t size = 1024 * 1024;
+  std::size_t actual = 0;
+  StackThread t(size, [&]() { actual = currentStackSize(); });
+  EXPECT_TRUE(t.joinable());
+  EXPECT_EQ(t.getStackSize(), size);
+  t.join();
+  EXPECT_FALSE(t.joinable());
+  EXPECT_GE(actual, size);
+}
+
+TEST(coreStackThreadTest, prefaultsWholeStack) {
+  constexpr std::size_t size = 512 * 1024;
+  std::atomic<bool> done{false};
+  StackThread t(size, [&]() {
+    Executor::prefault_stack(StackThread::usableStack(size));
+    done = true;
+  });
+  t.join();
+  EXPECT_TRUE(done);
+}
+
+TEST(coreStackThreadTest, usableStackLeavesReserve) {
+  EXPECT_EQ(StackThread::usableStack(1024 * 1024), 1024 * 1024 - 64 * 1024);
+  EXPECT_EQ(StackThread::usableStack(64 * 1024), 32 * 1024);
+}
+
+TEST(coreStackThreadTest, moveTransfersThread) {
+  std::atomic<int> runs{0};
+  StackThread a(0, [&]() { runs++; });
+  StackThread b(std::move(a));
+  EXPECT_FALSE(a.joinable());
+  EXPECT_TRUE(b.joinable());
+  b.join();
+  EXPECT_EQ(runs, 1);
+}
+
+TEST(coreStackThreadTest, reservesHeap) {
+  EXPECT_TRUE(Executor::reserve_heap(1024 * 1024));
+}
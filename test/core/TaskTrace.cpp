@@ -0,0 +1,68 @@
+#include <eeros/core/TaskTrace.hpp>
+#include <eeros/core/PeriodicCounter.hpp>
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using namespace eeros;
+
+namespace {
+
+std::string readFile(std::string file) {
+  std::ifstream in(file);
+  std::stringstream ss;
+  ss << in.rdbuf();
+  return ss.str();
+}
+
+int count(const std::string& text, const std::string& pattern) {
+  int n = 0;
+  for (auto pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) n++;
+  return n;
+}
+
+}
+
+TEST(coreTaskTraceTest, recordsSlicesOfAllThreads) {
+  const std::string file = "/tmp/eeros_test_trace.json";
+  {
+    TaskTrace trace(file);
+    ASSERT_TRUE(trace.isOpen());
+    PeriodicCounter c(0.001);
+    c.setTraceName("main");
+    for (int i = 0; i < 3; i++) {
+      c.tick();
+      TaskTrace::begin("td", "timedomain");
+      TaskTrace::end("td", "timedomain");
+      c.tock();
+    }
+    std::thread other([]() {
+      PeriodicCounter c(0.001);
+      c.setTraceName("other");
+      c.tick();
+      c.tock();
+    });
+    other.join();
+    EXPECT_EQ(trace.getDropped(), 0u);
+  }
+  std::string json = readFile(file);
+  EXPECT_EQ(json.rfind("{\"traceEvents\":[", 0), 0u);
+  EXPECT_NE(json.find("],\"displayTimeUnit\":\"ns\"}"), std::string::npos);
+  EXPECT_EQ(count(json, "\"name\":\"main\",\"cat\":\"task\",\"ph\":\"B\""), 3);
+  EXPECT_EQ(count(json, "\"name\":\"main\",\"cat\":\"task\",\"ph\":\"E\""), 3);
+  EXPECT_EQ(count(json, "\"name\":\"td\",\"cat\":\"timedomain\",\"ph\":\"B\""), 3);
+  EXPECT_EQ(count(json, "\"name\":\"other\",\"cat\":\"task\""), 2);
+  EXPECT_EQ(count(json, "\"name\":\"thread_name\""), 2);
+  EXPECT_EQ(count(json, "\"args\":{\"cpu\":"), 14);
+}
+
+TEST(coreTaskTraceTest, nothingRecordedWithoutTrace) {
+  PeriodicCounter c(0.001);
+  c.setTraceName("main");
+  c.tick();
+  c.tock();
+  const std::string file = "/tmp/eeros_test_trace_empty.json";
+  { TaskTrace trace(file); }
+  EXPECT_EQ(count(readFile(file), "\"ph\":\"B\""), 0);
+}
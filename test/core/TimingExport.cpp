@@ -0,0 +1,32 @@
+#include <eeros/core/TimingExport.hpp>
+#include <eeros/core/PeriodicCounter.hpp>
+#include <gtest/gtest.h>
+#include <cstring>
+
+using namespace eeros;
+
+TEST(coreTimingExportTest, writeAndRead) {
+  TimingExport e("/eeros_test_timing", 2);
+  ASSERT_TRUE(e.isValid());
+  EXPECT_EQ(e.getRecord(2, "out of range"), nullptr);
+  TimingRecord* r = e.getRecord(1, "task");
+  ASSERT_NE(r, nullptr);
+
+  PeriodicCounter c(0.001);
+  c.setExport(r);
+  for (int i = 0; i < 5; i++) {
+    c.tick();
+    c.tock();
+  }
+
+  TimingRegion* region = TimingExport::open("/eeros_test_timing");
+  ASSERT_NE(region, nullptr);
+  EXPECT_EQ(region->records, 2u);
+  TimingRecord copy;
+  ASSERT_TRUE(TimingExport::read(region->record[1], copy));
+  EXPECT_EQ(std::strcmp(copy.name, "task"), 0);
+  EXPECT_EQ(copy.count, 4u);
+  EXPECT_EQ(copy.sequence.load() % 2, 0u);
+  EXPECT_DOUBLE_EQ(copy.periodMax, c.period.max);
+  EXPECT_DOUBLE_EQ(copy.runMean, c.run.mean);
+}
@@ -0,0 +1,76 @@
+#include <eeros/core/TripleBuffer.hpp>
+#include <eeros/math/Matrix.hpp>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace eeros;
+using namespace eeros::math;
+
+// The reader gets the latest data and the new data flag
+TEST(coreTripleBufferTest, latestData) {
+  TripleBuffer<int> b;
+  bool newData;
+  EXPECT_EQ(b.read(newData), 0);
+  EXPECT_FALSE(newData);
+  b.write(1);
+  b.write(2);
+  EXPECT_EQ(b.read(newData), 2);
+  EXPECT_TRUE(newData);
+  EXPECT_EQ(b.read(newData), 2);
+  EXPECT_FALSE(newData);
+  b.writeBuffer() = 3;
+  b.publish();
+  EXPECT_EQ(b.read(newData), 3);
+  EXPECT_TRUE(newData);
+}
+
+// All slots start with the initial content
+TEST(coreTripleBufferTest, initialSlots) {
+  TripleBuffer<std::vector<uint8_t>> b(std::vector<uint8_t>(64, 7));
+  EXPECT_EQ(b.writeBuffer().size(), 64);
+  b.writeBuffer()[0] = 1;
+  b.publish();
+  EXPECT_EQ(b.writeBuffer().size(), 64);
+  EXPECT_EQ(b.read()[0], 1);
+  EXPECT_EQ(b.read().size(), 64);
+}
+
+// The view of the reader is not touched by the writer
+TEST(coreTripleBufferTest, stableView) {
+  TripleBuffer<Matrix<360,1,float>> b;
+  Matrix<360,1,float> m;
+  m.fill(1);
+  b.write(m);
+  const Matrix<360,1,float>& view = b.read();
+  for (int i = 2; i < 10; i++) {
+    m.fill(i);
+    b.write(m);
+  }
+  EXPECT_EQ(view(0), 1);
+  EXPECT_EQ(view(359), 1);
+  EXPECT_EQ(b.read()(0), 9);
+}
+
+// A reader never sees a partially written payload
+TEST(coreTripleBufferTest, twoThreads) {
+  TripleBuffer<Matrix<64,1,int>> b;
+  std::thread writer([&]() {
+    for (int i = 1; i <= 20000; i++) {
+      b.writeBuffer().fill(i);
+      b.publish();
+    }
+  });
+  bool consistent = true;
+  int last = 0;
+  while (last < 20000) {
+    bool newData;
+    const auto& v = b.read(newData);
+    if (!newData) continue; // a default constructed matrix is not initialized
+    for (int j = 1; j < 64; j++) consistent = consistent && (v(j) == v(0));
+    consistent = consistent && (v(0) >= last);
+    last = v(0);
+  }
+  writer.join();
+  EXPECT_TRUE(consistent);
+}
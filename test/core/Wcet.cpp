@@ -0,0 +1,71 @@
+#include <eeros/core/Wcet.hpp>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+using namespace eeros;
+
+namespace {
+  void spin(int n) {
+    volatile int x = 0;
+    for (int i = 0; i < n; i++) x = x + i;
+  }
+}
+
+TEST(coreWcetTest, sameNameSameProbe) {
+  auto a = Wcet::probe("block", "td/a");
+  EXPECT_EQ(Wcet::probe("block", "td/a"), a);
+  EXPECT_NE(Wcet::probe("level", "td/a"), a);
+  EXPECT_NE(Wcet::probe("block", "td/b"), a);
+}
+
+TEST(coreWcetTest, keepsLongestRun) {
+  auto p = Wcet::probe("block", "td/keepsLongestRun");
+  { Wcet::Scope s(p); spin(100000); }
+  uint64_t longRun = p->max.load();
+  for (int i = 0; i < 10; i++) { Wcet::Scope s(p); spin(10); }
+  EXPECT_EQ(p->runs.load(), 11u);
+  EXPECT_EQ(p->max.load(), longRun);
+  p->record(longRun + 1);
+  EXPECT_EQ(p->max.load(), longRun + 1);
+  Wcet::reset();
+  EXPECT_EQ(p->runs.load(), 0u);
+  EXPECT_EQ(p->max.load(), 0u);
+}
+
+TEST(coreWcetTest, nullProbeMeasuresNothing) {
+  Wcet::Scope s(nullptr);
+  SUCCEED();
+}
+
+TEST(coreWcetTest, cacheFlush) {
+  auto p = Wcet::probe("block", "td/cacheFlush");
+  Wcet::setCacheFlush(32 << 20);
+  { Wcet::Scope s(p); }
+  Wcet::setCacheFlush(1 << 20);   // a smaller buffer reuses the larger one
+  { Wcet::Scope s(p); }
+  Wcet::setCacheFlush(0);
+  { Wcet::Scope s(p); }
+  EXPECT_EQ(p->runs.load(), 3u);
+}
+
+TEST(coreWcetTest, reportListsProbesWhichRan) {
+  Wcet::reset();
+  auto ran = Wcet::probe("level", "emergency/onEntry");
+  Wcet::probe("level", "emergency/onExit");
+  ran->record(2000);
+  std::ostringstream os;
+  Wcet::report(os);
+  std::string report = os.str();
+  EXPECT_EQ(report.rfind("kind,name,runs,max ticks,max us\n", 0), 0u);
+  EXPECT_NE(report.find("level,emergency/onEntry,1,2000,"), std::string::npos);
+  EXPECT_EQ(report.find("emergency/onExit"), std::string::npos);
+}
+
+TEST(coreWcetTest, reportQuotesNames) {
+  Wcet::reset();
+  Wcet::probe("level", "emergency, not init/action")->record(10);
+  std::ostringstream os;
+  Wcet::report(os);
+  EXPECT_NE(os.str().find("level,\"emergency, not init/action\",1,10,"), std::string::npos);
+}
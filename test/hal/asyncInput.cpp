@@ -0,0 +1,63 @@
+#include <eeros/hal/AsyncInput.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace eeros;
+using namespace eeros::hal;
+
+namespace {
+
+class SlowInput : public ScalableInput<double> {
+ public:
+  SlowInput(std::string id) : ScalableInput<double>(id, nullptr, 2, 0, -100, 100) { }
+  double get() override {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    return toValue(++reads);
+  }
+  std::atomic<int> reads{0};
+};
+
+class SlowSwitch : public Input<bool> {
+ public:
+  SlowSwitch(std::string id) : Input<bool>(id, nullptr) { }
+  bool get() override {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    return ++reads > 2;
+  }
+  std::atomic<int> reads{0};
+};
+
+}
+
+TEST(halAsyncInputTest, readsInBackground) {
+  int count = AsyncPoller::instance().getCount();
+  {
+    auto slow = new SlowInput("slow");
+    AsyncScalableInput in(slow, 0.005);
+    EXPECT_EQ(AsyncPoller::instance().getCount(), count + 1);
+    EXPECT_EQ(in.getId(), "slow");
+    EXPECT_EQ(in.getScale(), 2);
+    EXPECT_EQ(in.get(), 0.5);
+
+    // get() returns the cached value without touching the device
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 100; i++) in.get();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(2));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_GT(slow->reads, 3);
+    EXPECT_GT(in.get(), 1.0);
+    EXPECT_LT(in.getAge(), 0.05);
+    EXPECT_LE(in.getTimestamp(), System::getTimeNs());
+  }
+  EXPECT_EQ(AsyncPoller::instance().getCount(), count);
+}
+
+TEST(halAsyncInputTest, logicInput) {
+  AsyncInput<bool> in(new SlowSwitch("switch"), 0.002);
+  EXPECT_FALSE(in.get());
+  for (int i = 0; i < 200 && !in.get(); i++) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  EXPECT_TRUE(in.get());
+}
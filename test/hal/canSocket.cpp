@@ -0,0 +1,74 @@
+#include <eeros/hal/CanSocket.hpp>
+#include <eeros/core/System.hpp>
+#include <gtest/gtest.h>
+#include <cstring>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace eeros;
+using namespace eeros::hal;
+
+namespace {
+
+void send(int fd, canid_t id, uint8_t value) {
+  can_frame f;
+  std::memset(&f, 0, sizeof(f));
+  f.can_id = id;
+  f.can_dlc = 1;
+  f.data[0] = value;
+  ASSERT_EQ(::write(fd, &f, sizeof(f)), (ssize_t)sizeof(f));
+}
+
+}
+
+TEST(halCanSocketTest, receivesBatch) {
+  int sv[2];
+  ASSERT_EQ(::socketpair(AF_UNIX, SOCK_DGRAM, 0, sv), 0);
+  CanSocket socket(sv[0]);
+  EXPECT_EQ(socket.receive(), 0);   // does not wait
+
+  uint64_t before = System::getTimeNs();
+  for (int i = 0; i < 3; i++) send(sv[1], 0x181 + i, i);
+  ASSERT_EQ(socket.receive(), 3);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(socket.getFrame(i).can_id, 0x181u + i);
+    EXPECT_EQ(socket.getFrame(i).data[0], i);
+    EXPECT_GE(socket.getTimestamp(i), before);
+  }
+  EXPECT_EQ(socket.receive(), 0);
+  ::close(sv[1]);
+}
+
+TEST(halCanSocketTest, skipsOtherDatagrams) {
+  int sv[2];
+  ASSERT_EQ(::socketpair(AF_UNIX, SOCK_DGRAM, 0, sv), 0);
+  CanSocket socket(sv[0]);
+  char junk[3] = {1, 2, 3};
+  ASSERT_EQ(::write(sv[1], junk, sizeof(junk)), 3);
+  send(sv[1], 0x201, 7);
+  ASSERT_EQ(socket.receive(), 1);
+  EXPECT_EQ(socket.getFrame(0).data[0], 7);
+  ::close(sv[1]);
+}
+
+TEST(halCanSocketTest, sendsQueuedFramesInOrder) {
+  int sv[2];
+  ASSERT_EQ(::socketpair(AF_UNIX, SOCK_DGRAM, 0, sv), 0);
+  CanSocket socket(sv[0]);
+  can_frame f;
+  std::memset(&f, 0, sizeof(f));
+  for (int i = 0; i < 3; i++) {
+    f.can_id = 0x201 + i;
+    EXPECT_TRUE(socket.queue(f));
+  }
+  EXPECT_EQ(socket.getQueued(), 3);
+  EXPECT_EQ(socket.flush(), 3);
+  EXPECT_EQ(socket.getQueued(), 0);
+  for (int i = 0; i < 3; i++) {
+    ASSERT_EQ(::read(sv[1], &f, sizeof(f)), (ssize_t)sizeof(f));
+    EXPECT_EQ(f.can_id, 0x201u + i);
+  }
+  for (int i = 0; i < CanSocket::capacity; i++) socket.queue(f);
+  EXPECT_FALSE(socket.queue(f));
+  ::close(sv[1]);
+}
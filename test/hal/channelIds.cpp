@@ -0,0 +1,72 @@
+#include <eeros/hal/HAL.hpp>
+#include <eeros/core/Fault.hpp>
+#include <gtest/gtest.h>
+
+using namespace eeros;
+using namespace eeros::hal;
+
+namespace {
+
+class InputStub : public Input<bool> {
+ public:
+  InputStub(std::string id) : Input<bool>(id, nullptr) { }
+  bool get() override { return true; }
+};
+
+class OutputStub : public Output<bool> {
+ public:
+  OutputStub(std::string id) : Output<bool>(id, nullptr) { }
+  bool get() override { return value; }
+  void set(bool value) override { this->value = value; }
+  bool value = false;
+};
+
+}
+
+TEST(halChannelIdsTest, lookupById) {
+  HAL& hal = HAL::instance();
+  hal.addInput(new InputStub("idIn0"));
+  hal.addOutput(new OutputStub("idOut0"));
+  
+  auto in = hal.getInputId<Input<bool>>("idIn0");
+  auto out = hal.getOutputId<Output<bool>>("idOut0");
+  EXPECT_TRUE(in);
+  EXPECT_TRUE(hal.get(in)->get());
+  hal.get(out)->set(true);
+  EXPECT_TRUE(hal.get(out)->get());
+  EXPECT_EQ(hal.get(hal.getInputId("idIn0")), hal.get(in));
+  
+  EXPECT_THROW(hal.get(ChannelId<InputInterface>()), Fault);
+  EXPECT_THROW(hal.getInputId("idMissing"), Fault);
+  EXPECT_THROW(hal.getInputId<ScalableInput<double>>("idIn0"), Fault);
+}
+
+TEST(halChannelIdsTest, unknownNameIsNotInserted) {
+  HAL& hal = HAL::instance();
+  EXPECT_THROW(hal.getInput("idMissing"), Fault);
+  EXPECT_THROW(hal.getInput("idMissing"), Fault);   // not reserved by the first attempt
+  EXPECT_THROW(hal.releaseInput("idMissing"), Fault);
+}
+
+TEST(halChannelIdsTest, frozen) {
+  HAL& hal = HAL::instance();
+  hal.addInput(new InputStub("idIn1"));
+  hal.addInput(new InputStub("idIn4"));
+  auto in = hal.getInputId("idIn1");
+  hal.addInput("idIn2", []() -> InputInterface* { return new InputStub("idIn2"); });
+  
+  hal.freeze();
+  EXPECT_TRUE(hal.isFrozen());
+  EXPECT_NE(hal.get(in), nullptr);
+  EXPECT_TRUE(hal.getInputId("idIn1"));
+  EXPECT_THROW(hal.getInputId("idIn4"), Fault);     // not resolved before
+  EXPECT_THROW(hal.getInputId("idIn2"), Fault);     // not created before
+  EXPECT_THROW(hal.getInput("idIn1"), Fault);
+  InputStub extra("idIn3");
+  EXPECT_THROW(hal.addInput(&extra), Fault);
+  hal.unfreeze();
+  
+  EXPECT_FALSE(hal.isFrozen());
+  EXPECT_NE(hal.getInput("idIn2"), nullptr);
+  hal.releaseInput("idIn2");
+}
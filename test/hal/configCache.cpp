@@ -0,0 +1,80 @@
+#include <eeros/hal/ConfigCache.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+using namespace eeros::hal;
+
+namespace {
+
+void writeFile(const std::string& file, const std::string& content) {
+  std::ofstream out(file, std::ios::trunc);
+  out << content;
+}
+
+}
+
+TEST(halConfigCacheTest, hash) {
+  const std::string file = "/tmp/eeros_test_config.json";
+  writeFile(file, "{ \"sim\": { } }");
+  uint64_t h1 = ConfigCache::hash(file);
+  EXPECT_NE(h1, 0u);
+  EXPECT_EQ(ConfigCache::hash(file), h1);
+  writeFile(file, "{ \"sim\": { \"x\": 1 } }");
+  EXPECT_NE(ConfigCache::hash(file), h1);
+  EXPECT_EQ(ConfigCache::hash("/tmp/eeros_test_no_such_config.json"), 0u);
+  std::remove(file.c_str());
+}
+
+TEST(halConfigCacheTest, saveAndLoad) {
+  const std::string file = "/tmp/eeros_test_config.cache";
+  std::vector<ChannelConfig> channels(2);
+  channels[0].kind = ChannelConfig::real;
+  channels[0].library = "libsimeeros.so";
+  channels[0].type = "AnalogIn";
+  channels[0].id = "enc1";
+  channels[0].devHandle = "sim";
+  channels[0].subDevice = 2;
+  channels[0].channel[0] = 3;
+  channels[0].scale = 0.5;
+  channels[0].offset = -1.25;
+  channels[0].rangeMin = -10;
+  channels[0].rangeMax = 10;
+  channels[0].unit = "rad";
+  channels[1].kind = ChannelConfig::logic;
+  channels[1].library = "libsimeeros.so";
+  channels[1].lazyBinding = true;
+  channels[1].type = "DigOut";
+  channels[1].id = "led";
+  channels[1].devHandle = "sim";
+  channels[1].inverted = true;
+  channels[1].additionalArguments = "a=1";
+  ASSERT_TRUE(ConfigCache::save(file, 42, channels));
+
+  std::vector<ChannelConfig> loaded;
+  EXPECT_FALSE(ConfigCache::load(file, 43, loaded));
+  EXPECT_TRUE(loaded.empty());
+  ASSERT_TRUE(ConfigCache::load(file, 42, loaded));
+  ASSERT_EQ(loaded.size(), 2u);
+  EXPECT_EQ(loaded[0].kind, ChannelConfig::real);
+  EXPECT_EQ(loaded[0].id, "enc1");
+  EXPECT_EQ(loaded[0].subDevice, 2u);
+  EXPECT_EQ(loaded[0].channel[0], 3u);
+  EXPECT_EQ(loaded[0].scale, 0.5);
+  EXPECT_EQ(loaded[0].offset, -1.25);
+  EXPECT_EQ(loaded[0].rangeMax, 10);
+  EXPECT_EQ(loaded[0].unit, "rad");
+  EXPECT_TRUE(std::isnan(loaded[0].safe));
+  EXPECT_EQ(loaded[1].kind, ChannelConfig::logic);
+  EXPECT_TRUE(loaded[1].lazyBinding);
+  EXPECT_TRUE(loaded[1].inverted);
+  EXPECT_EQ(loaded[1].additionalArguments, "a=1");
+
+  // a truncated cache is rejected
+  std::ifstream in(file, std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  writeFile(file, content.substr(0, content.size() - 5));
+  EXPECT_FALSE(ConfigCache::load(file, 42, loaded));
+  std::remove(file.c_str());
+}
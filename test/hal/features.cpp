@@ -0,0 +1,26 @@
+#include <eeros/hal/HAL.hpp>
+#include <gtest/gtest.h>
+#include <dlfcn.h>
+
+using namespace eeros;
+using namespace eeros::hal;
+
+namespace {
+
+class InputStub : public Input<bool> {
+ public:
+  InputStub() : Input<bool>("featureIn", RTLD_DEFAULT) { }
+  bool get() override { return false; }
+};
+
+}
+
+TEST(halFeaturesTest, handle) {
+  InputStub in;
+  HAL& hal = HAL::instance();
+  InputFeature<> none;
+  EXPECT_FALSE(none);
+  auto f = hal.getInputFeatureHandle<>(&in, "getpid");   // resolved only, never called
+  EXPECT_TRUE(f);
+  EXPECT_THROW(hal.getInputFeatureHandle<double>(&in, "noSuchFeatureFunction"), Fault);
+}
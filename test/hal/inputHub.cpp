@@ -0,0 +1,61 @@
+#include <eeros/hal/InputHub.hpp>
+#include <eeros/logger/Logger.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <fcntl.h>
+#include <iostream>
+#include <thread>
+#include <unistd.h>
+
+using namespace eeros::hal;
+using namespace eeros::logger;
+
+namespace {
+
+InputHub& hub() {
+  Logger::setDefaultStreamLogger(std::cout);   // the hub takes its logger when it is created
+  return InputHub::instance();
+}
+
+bool waitFor(const std::atomic<int>& value, int expected) {
+  for (int i = 0; i < 200 && value.load() != expected; i++) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  return value.load() == expected;
+}
+
+}
+
+TEST(halInputHubTest, callsHandlersOfReadableDescriptors) {
+  auto& hub = ::hub();
+  int a[2], b[2];
+  ASSERT_EQ(::pipe2(a, O_NONBLOCK), 0);
+  ASSERT_EQ(::pipe2(b, O_NONBLOCK), 0);
+  std::atomic<int> bytesA{0}, bytesB{0};
+  auto drain = [](int fd, std::atomic<int>& count) {
+    char buf[16];
+    ssize_t n;
+    while ((n = ::read(fd, buf, sizeof(buf))) > 0) count += n;
+  };
+  int before = hub.getCount();
+  ASSERT_TRUE(hub.add(a[0], [&]() { drain(a[0], bytesA); }));
+  ASSERT_TRUE(hub.add(b[0], [&]() { drain(b[0], bytesB); }));
+  EXPECT_EQ(hub.getCount(), before + 2);
+
+  ASSERT_EQ(::write(a[1], "abc", 3), 3);
+  ASSERT_EQ(::write(b[1], "x", 1), 1);
+  EXPECT_TRUE(waitFor(bytesA, 3));
+  EXPECT_TRUE(waitFor(bytesB, 1));
+
+  hub.remove(a[0]);
+  ASSERT_EQ(::write(a[1], "d", 1), 1);
+  ASSERT_EQ(::write(b[1], "yz", 2), 2);
+  EXPECT_TRUE(waitFor(bytesB, 3));
+  EXPECT_EQ(bytesA.load(), 3);   // not called after remove
+  hub.remove(b[0]);
+  EXPECT_EQ(hub.getCount(), before);
+  for (int fd : {a[0], a[1], b[0], b[1]}) ::close(fd);
+}
+
+TEST(halInputHubTest, rejectsInvalidDescriptor) {
+  EXPECT_FALSE(hub().add(-1, []() { }));
+}
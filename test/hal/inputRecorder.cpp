@@ -0,0 +1,93 @@
+#include <eeros/hal/HAL.hpp>
+#include <eeros/hal/InputRecorder.hpp>
+#include <eeros/control/PeripheralInput.hpp>
+#include <gtest/gtest.h>
+
+using namespace eeros;
+using namespace eeros::hal;
+
+namespace {
+
+class CountingInput : public ScalableInput<double> {
+ public:
+  CountingInput(std::string id) : ScalableInput<double>(id, nullptr, 1, 0, -100, 100) { }
+  double get() override { return value += 0.5; }
+  double value = 0;
+};
+
+class ToggleInput : public Input<bool> {
+ public:
+  ToggleInput(std::string id) : Input<bool>(id, nullptr) { }
+  bool get() override { return value = !value; }
+  bool value = false;
+};
+
+}
+
+TEST(halInputRecorderTest, writeAndRead) {
+  const std::string file = "/tmp/eeros_test_recording.eerec";
+  {
+    InputRecorder recorder(file);
+    ASSERT_TRUE(recorder.isOpen());
+    auto a = recorder.addChannel("a", false);
+    auto b = recorder.addChannel("b", true);
+    // more values than a frame and a ring buffer hold
+    for (int i = 0; i < 3000; i++) {
+      a->push(i * 0.25);
+      if (i % 2 == 0) b->push(i % 4 == 0);
+      if (i % 500 == 0) std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    EXPECT_EQ(recorder.getDropped(), 0u);
+  }
+  InputRecording recording(file);
+  ASSERT_TRUE(recording.isValid());
+  EXPECT_EQ(recording.getIds(), (std::vector<std::string>{"a", "b"}));
+  EXPECT_EQ(recording.getValues("c"), nullptr);
+  auto a = recording.getValues("a");
+  ASSERT_NE(a, nullptr);
+  ASSERT_EQ(a->size(), 3000u);
+  EXPECT_DOUBLE_EQ((*a)[1234], 1234 * 0.25);
+  auto b = recording.getValues("b");
+  ASSERT_NE(b, nullptr);
+  ASSERT_EQ(b->size(), 1500u);
+  EXPECT_EQ((*b)[0], 1.0);
+  EXPECT_EQ((*b)[1], 0.0);
+}
+
+TEST(halInputRecorderTest, invalidFile) {
+  InputRecording recording("/tmp/eeros_test_recording_missing.eerec");
+  EXPECT_FALSE(recording.isValid());
+}
+
+TEST(halInputRecorderTest, recordsPeripheralInputs) {
+  const std::string file = "/tmp/eeros_test_recording_hal.eerec";
+  HAL& hal = HAL::instance();
+  hal.addInput(new CountingInput("recordAnalogIn"));
+  hal.addInput(new ToggleInput("recordDigIn"));
+  ASSERT_TRUE(hal.recordInputs(file));
+  {
+    control::PeripheralInput<double> analog("recordAnalogIn");
+    control::PeripheralInput<bool> logic("recordDigIn");
+    for (int i = 0; i < 10; i++) {
+      analog.run();
+      logic.run();
+    }
+    EXPECT_DOUBLE_EQ(analog.getOut().getSignal().getValue(), 5.0);
+    hal.stopRecording();
+    EXPECT_EQ(hal.getInputRecorder(), nullptr);
+    hal.releaseInput("recordAnalogIn");
+    hal.releaseInput("recordDigIn");
+  }
+  InputRecording recording(file);
+  ASSERT_TRUE(recording.isValid());
+  auto analog = recording.getValues("recordAnalogIn");
+  ASSERT_NE(analog, nullptr);
+  ASSERT_EQ(analog->size(), 10u);
+  EXPECT_DOUBLE_EQ(analog->front(), 0.5);
+  EXPECT_DOUBLE_EQ(analog->back(), 5.0);
+  auto logic = recording.getValues("recordDigIn");
+  ASSERT_NE(logic, nullptr);
+  ASSERT_EQ(logic->size(), 10u);
+  EXPECT_EQ((*logic)[0], 1.0);
+  EXPECT_EQ((*logic)[1], 0.0);
+}
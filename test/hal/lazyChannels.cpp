@@ -0,0 +1,54 @@
+#include <eeros/hal/HAL.hpp>
+#include <eeros/core/Fault.hpp>
+#include <gtest/gtest.h>
+
+using namespace eeros;
+using namespace eeros::hal;
+
+namespace {
+
+class InputStub : public Input<bool> {
+ public:
+  InputStub(std::string id) : Input<bool>(id, nullptr) { }
+  bool get() override { return true; }
+};
+
+}
+
+TEST(halLazyChannelsTest, createdOnFirstClaim) {
+  HAL& hal = HAL::instance();
+  int created = 0;
+  hal.addInput("lazyIn0", [&created]() -> InputInterface* { created++; return new InputStub("lazyIn0"); });
+  EXPECT_EQ(created, 0);
+  
+  auto in = hal.getLogicInput("lazyIn0");
+  ASSERT_NE(in, nullptr);
+  EXPECT_TRUE(in->get());
+  EXPECT_EQ(created, 1);
+  hal.releaseInput("lazyIn0");
+  
+  EXPECT_EQ(hal.getLogicInput("lazyIn0"), in);
+  EXPECT_EQ(created, 1);
+  hal.releaseInput("lazyIn0");
+}
+
+TEST(halLazyChannelsTest, rejectsDuplicateId) {
+  HAL& hal = HAL::instance();
+  hal.addInput("lazyIn1", []() -> InputInterface* { return new InputStub("lazyIn1"); });
+  EXPECT_THROW(hal.addInput("lazyIn1", []() -> InputInterface* { return new InputStub("lazyIn1"); }), Fault);
+  InputStub duplicate("lazyIn1");
+  EXPECT_THROW(hal.addInput(&duplicate), Fault);
+}
+
+TEST(halLazyChannelsTest, staysPendingIfCreationFails) {
+  HAL& hal = HAL::instance();
+  bool fail = true;
+  hal.addInput("lazyIn2", [&fail]() -> InputInterface* {
+    if (fail) throw Fault("device not ready");
+    return new InputStub("lazyIn2");
+  });
+  EXPECT_THROW(hal.getInput("lazyIn2"), Fault);
+  fail = false;
+  EXPECT_NE(hal.getInput("lazyIn2"), nullptr);
+  hal.releaseInput("lazyIn2");
+}
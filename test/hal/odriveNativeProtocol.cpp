@@ -0,0 +1,75 @@
+#include <eeros/hal/ODriveNativeProtocol.hpp>
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+
+using namespace eeros::hal;
+
+namespace {
+
+std::vector<uint8_t> response(uint16_t seqNo, float value) {
+  uint8_t packet[6] = {static_cast<uint8_t>(seqNo & 0xFF), static_cast<uint8_t>((seqNo >> 8) | 0x80)};
+  std::memcpy(&packet[2], &value, sizeof(value));
+  std::vector<uint8_t> out;
+  ODriveNativeProtocol::frame(out, packet, sizeof(packet));
+  return out;
+}
+
+int feed(ODriveNativeProtocol& p, const std::vector<uint8_t>& data) {
+  int n = 0;
+  for (uint8_t b : data) if (p.parse(b)) n++;
+  return n;
+}
+
+}
+
+TEST(halODriveNativeProtocolTest, encodesRequest) {
+  ODriveNativeProtocol p(0x1234);
+  std::vector<uint8_t> out;
+  float value = 1.5;
+  uint16_t seq = p.request(out, 195, &value, sizeof(value), 0);
+  ASSERT_EQ(out.size(), 3u + 12 + 2);
+  EXPECT_EQ(out[0], 0xAA);
+  EXPECT_EQ(out[1], 12);
+  EXPECT_EQ(ODriveNativeProtocol::crc8(0x42, out.data(), 3), 0);
+  EXPECT_EQ(out[3] | (out[4] << 8), seq);
+  EXPECT_EQ(out[5] | (out[6] << 8), 195 | 0x8000);
+  EXPECT_EQ(out[7] | (out[8] << 8), 0);
+  EXPECT_EQ(std::memcmp(&out[9], &value, sizeof(value)), 0);
+  EXPECT_EQ(out[13] | (out[14] << 8), 0x1234);
+  EXPECT_EQ(ODriveNativeProtocol::crc16(0x1337, &out[3], 14), 0);
+  EXPECT_EQ(p.request(out, 249, nullptr, 0, 4), seq + 1);
+}
+
+TEST(halODriveNativeProtocolTest, parsesPipelinedResponses) {
+  ODriveNativeProtocol p;
+  std::vector<uint8_t> stream = response(7, 2.5);
+  std::vector<uint8_t> second = response(8, -1.0);
+  stream.insert(stream.end(), second.begin(), second.end());
+  std::vector<uint16_t> seqs;
+  std::vector<float> values;
+  for (uint8_t b : stream) {
+    if (p.parse(b)) {
+      float v;
+      ASSERT_EQ(p.getPayloadLength(), 4);
+      std::memcpy(&v, p.getPayload(), sizeof(v));
+      seqs.push_back(p.getSeqNo());
+      values.push_back(v);
+    }
+  }
+  EXPECT_EQ(seqs, (std::vector<uint16_t>{7, 8}));
+  EXPECT_EQ(values, (std::vector<float>{2.5, -1.0}));
+  EXPECT_EQ(p.getErrors(), 0u);
+}
+
+TEST(halODriveNativeProtocolTest, resynchronizesAfterCorruption) {
+  ODriveNativeProtocol p;
+  std::vector<uint8_t> bad = response(1, 1.0);
+  bad[5] ^= 0x01;
+  std::vector<uint8_t> noise = {0x00, 0xAA, 0xAA, 0x13};
+  EXPECT_EQ(feed(p, noise), 0);
+  EXPECT_EQ(feed(p, bad), 0);
+  EXPECT_EQ(feed(p, response(2, 3.0)), 1);
+  EXPECT_EQ(p.getSeqNo(), 2);
+  EXPECT_GE(p.getErrors(), 2u);
+}
@@ -0,0 +1,93 @@
+#include <eeros/hal/HAL.hpp>
+#include <gtest/gtest.h>
+
+using namespace eeros;
+using namespace eeros::hal;
+
+namespace {
+
+class BatchStub : public InputBatch {
+ public:
+  void update() override { updates++; image = ~image; }
+  int updates = 0;
+  unsigned int image = 0;
+};
+
+class BatchInputStub : public Input<bool> {
+ public:
+  BatchInputStub(std::string id, BatchStub& batch, unsigned int bit) : Input<bool>(id, nullptr), batch(batch), bit(bit) { }
+  bool get() override { return (batch.image >> bit) & 1; }
+  InputBatch* getBatch() override { return &batch; }
+  BatchStub& batch;
+  unsigned int bit;
+};
+
+class OutputBatchStub : public OutputBatch {
+ public:
+  void commit() override {
+    commits++;
+    if (staged != image) writes++;   // skips unchanged values
+    image = staged;
+  }
+  int commits = 0, writes = 0;
+  unsigned int staged = 0, image = 0;
+};
+
+class BatchOutputStub : public Output<bool> {
+ public:
+  BatchOutputStub(std::string id, OutputBatchStub& batch, unsigned int bit) : Output<bool>(id, nullptr), batch(batch), bit(bit) { }
+  bool get() override { return (batch.staged >> bit) & 1; }
+  void set(bool value) override { batch.staged = (batch.staged & ~(1u << bit)) | (value << bit); }
+  OutputBatch* getBatch() override { return &batch; }
+  OutputBatchStub& batch;
+  unsigned int bit;
+};
+
+}
+
+TEST(halProcessImageTest, updatesEachBatchOnce) {
+  static BatchStub batch;
+  HAL& hal = HAL::instance();
+  hal.addInput(new BatchInputStub("processImageIn0", batch, 0));
+  hal.addInput(new BatchInputStub("processImageIn1", batch, 1));
+  hal.updateInputs();
+  EXPECT_EQ(batch.updates, 0);   // inputs which are not claimed are not read
+
+  auto in0 = hal.getLogicInput("processImageIn0");
+  auto in1 = hal.getLogicInput("processImageIn1", false);
+  hal.updateInputs();
+  EXPECT_EQ(batch.updates, 1);
+  EXPECT_TRUE(in0->get());
+  EXPECT_TRUE(in1->get());
+
+  hal.releaseInput("processImageIn0");
+  hal.updateInputs();
+  EXPECT_EQ(batch.updates, 2);
+  EXPECT_FALSE(in1->get());
+
+  hal.releaseInput("processImageIn1");
+  hal.updateInputs();
+  EXPECT_EQ(batch.updates, 2);
+}
+
+TEST(halProcessImageTest, commitsEachBatchOnce) {
+  static OutputBatchStub batch;
+  HAL& hal = HAL::instance();
+  hal.addOutput(new BatchOutputStub("processImageOut0", batch, 0));
+  hal.addOutput(new BatchOutputStub("processImageOut1", batch, 1));
+  auto out0 = hal.getLogicOutput("processImageOut0");
+  auto out1 = hal.getLogicOutput("processImageOut1");
+  out0->set(true);
+  out1->set(true);
+  EXPECT_EQ(batch.image, 0u);   // staged only
+  hal.commitOutputs();
+  EXPECT_EQ(batch.commits, 1);
+  EXPECT_EQ(batch.image, 3u);
+  hal.commitOutputs();
+  EXPECT_EQ(batch.commits, 2);
+  EXPECT_EQ(batch.writes, 1);
+  hal.releaseOutput("processImageOut0");
+  hal.releaseOutput("processImageOut1");
+  hal.commitOutputs();
+  EXPECT_EQ(batch.commits, 2);
+}
@@ -0,0 +1,74 @@
+#include <eeros/hal/ScalableInput.hpp>
+#include <eeros/hal/ScalableOutput.hpp>
+#include <eeros/hal/ScaleTable.hpp>
+#include <cstdint>
+#include <gtest/gtest.h>
+
+using namespace eeros;
+using namespace eeros::hal;
+
+namespace {
+
+class ScalableInputStub : public ScalableInput<double> {
+ public:
+  ScalableInputStub(double scale, double offset) : ScalableInput<double>("in", nullptr, scale, offset, -10, 10) { }
+  double get() override { return toValue(raw); }
+  double raw = 0;
+};
+
+class ScalableOutputStub : public ScalableOutput<double> {
+ public:
+  ScalableOutputStub(double scale, double offset) : ScalableOutput<double>("out", nullptr, scale, offset, -10, 10) { }
+  double get() override { return 0; }
+  void set(double value) override { raw = toRaw(value); }
+  double raw = 0;
+};
+
+}
+
+TEST(halScalableTest, input) {
+  ScalableInputStub in(4, 2);
+  in.raw = 10;
+  EXPECT_DOUBLE_EQ(in.get(), 2);
+  in.setScale(0.5);
+  EXPECT_DOUBLE_EQ(in.get(), 16);
+  in.setOffset(-1);
+  EXPECT_DOUBLE_EQ(in.get(), 22);
+}
+
+TEST(halScalableTest, output) {
+  ScalableOutputStub out(4, 2);
+  out.set(2);
+  EXPECT_DOUBLE_EQ(out.raw, 10);
+  out.setOffset(0);
+  out.set(2);
+  EXPECT_DOUBLE_EQ(out.raw, 8);
+}
+
+TEST(halScalableTest, outputClamped) {
+  ScalableOutputStub out(4, 2);
+  out.set(5);
+  EXPECT_DOUBLE_EQ(out.raw, 10);
+  out.set(-5);
+  EXPECT_DOUBLE_EQ(out.raw, -10);
+  out.setMaxOut(100);
+  out.set(5);
+  EXPECT_DOUBLE_EQ(out.raw, 22);
+  out.setMinOut(100);   // no valid range, not clamped
+  out.set(-5);
+  EXPECT_DOUBLE_EQ(out.raw, -18);
+}
+
+TEST(halScalableTest, scaleTable) {
+  ScalableInputStub a(4, 2), b(0.5, -1);
+  ScaleTable<double> table;
+  table.add(a);
+  table.add(b);
+  ASSERT_EQ(table.size(), 2);
+  int16_t raw[] = {10, 10};
+  double values[2];
+  table.convert(raw, values);
+  a.raw = b.raw = 10;
+  EXPECT_DOUBLE_EQ(values[0], a.get());
+  EXPECT_DOUBLE_EQ(values[1], b.get());
+}
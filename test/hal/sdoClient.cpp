@@ -0,0 +1,128 @@
+#include <eeros/hal/SdoClient.hpp>
+#include <eeros/logger/Logger.hpp>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace eeros;
+using namespace eeros::hal;
+using namespace eeros::logger;
+
+namespace {
+
+bool readFrame(int fd, can_frame& f, int timeoutMs = 1000) {
+  pollfd p{fd, POLLIN, 0};
+  if (::poll(&p, 1, timeoutMs) != 1) return false;
+  return ::read(fd, &f, sizeof(f)) == (ssize_t)sizeof(f);
+}
+
+void respond(int fd, const can_frame& request, uint8_t command, uint32_t data) {
+  can_frame f = request;
+  f.can_id = 0x580 + (request.can_id - 0x600);
+  f.data[0] = command;
+  for (int i = 0; i < 4; i++) f.data[4 + i] = (data >> (8 * i)) & 0xFF;
+  ASSERT_EQ(::write(fd, &f, sizeof(f)), (ssize_t)sizeof(f));
+}
+
+}
+
+TEST(halSdoClientTest, expeditedUpload) {
+  int sv[2];
+  ASSERT_EQ(::socketpair(AF_UNIX, SOCK_DGRAM, 0, sv), 0);
+  SdoClient sdo(sv[0]);
+  auto result = sdo.upload(3, 0x6041, 0);
+  can_frame f;
+  ASSERT_TRUE(readFrame(sv[1], f));
+  EXPECT_EQ(f.can_id, 0x603u);
+  EXPECT_EQ(f.data[0], 0x40);
+  EXPECT_EQ(f.data[1], 0x41);
+  EXPECT_EQ(f.data[2], 0x60);
+  respond(sv[1], f, 0x4B, 0xAB1237);   // 2 bytes
+  ASSERT_EQ(result.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+  SdoResult r = result.get();
+  EXPECT_EQ(r.status, SdoResult::ok);
+  EXPECT_EQ(r.value, 0x1237u);
+  EXPECT_EQ(sdo.getPending(), 0);
+  ::close(sv[1]);
+}
+
+TEST(halSdoClientTest, downloadAndAbort) {
+  int sv[2];
+  ASSERT_EQ(::socketpair(AF_UNIX, SOCK_DGRAM, 0, sv), 0);
+  SdoClient sdo(sv[0]);
+  auto written = sdo.download(1, 0x6060, 0, 3, 1);
+  can_frame f;
+  ASSERT_TRUE(readFrame(sv[1], f));
+  EXPECT_EQ(f.can_id, 0x601u);
+  EXPECT_EQ(f.data[0], 0x2F);
+  EXPECT_EQ(f.data[4], 3);
+  respond(sv[1], f, 0x60, 0);
+  EXPECT_EQ(written.get().status, SdoResult::ok);
+
+  SdoResult aborted;
+  std::promise<void> called;
+  sdo.upload(1, 0x2000, 1, [&](const SdoResult& r) { aborted = r; called.set_value(); });
+  ASSERT_TRUE(readFrame(sv[1], f));
+  respond(sv[1], f, 0x80, 0x06020000);
+  ASSERT_EQ(called.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+  EXPECT_EQ(aborted.status, SdoResult::aborted);
+  EXPECT_EQ(aborted.abortCode, 0x06020000u);
+  ::close(sv[1]);
+}
+
+TEST(halSdoClientTest, oneTransferPerNode) {
+  int sv[2];
+  ASSERT_EQ(::socketpair(AF_UNIX, SOCK_DGRAM, 0, sv), 0);
+  SdoClient sdo(sv[0]);
+  auto first = sdo.upload(2, 0x1000, 0);
+  auto second = sdo.upload(2, 0x1001, 0);
+  can_frame f;
+  ASSERT_TRUE(readFrame(sv[1], f));
+  EXPECT_EQ(f.data[1], 0x00);
+  EXPECT_FALSE(readFrame(sv[1], f, 50));   // waits for the response of the first
+  EXPECT_EQ(sdo.getPending(), 2);
+  f.data[1] = 0x00;
+  respond(sv[1], f, 0x43, 7);
+  ASSERT_TRUE(readFrame(sv[1], f));
+  EXPECT_EQ(f.data[1], 0x01);
+  respond(sv[1], f, 0x43, 8);
+  EXPECT_EQ(first.get().value, 7u);
+  EXPECT_EQ(second.get().value, 8u);
+  ::close(sv[1]);
+}
+
+TEST(halSdoClientTest, pacedBySlots) {
+  int sv[2];
+  ASSERT_EQ(::socketpair(AF_UNIX, SOCK_DGRAM, 0, sv), 0);
+  SdoClient sdo(sv[0]);
+  sdo.setPaced(true);
+  auto a = sdo.upload(1, 0x1000, 0);
+  auto b = sdo.upload(2, 0x1000, 0);
+  can_frame f;
+  EXPECT_FALSE(readFrame(sv[1], f, 50));   // no slot yet
+  sdo.release();
+  ASSERT_TRUE(readFrame(sv[1], f));
+  EXPECT_EQ(f.can_id, 0x601u);
+  EXPECT_FALSE(readFrame(sv[1], f, 50));   // one frame per slot
+  sdo.release();
+  ASSERT_TRUE(readFrame(sv[1], f));
+  EXPECT_EQ(f.can_id, 0x602u);
+  ::close(sv[1]);
+}
+
+TEST(halSdoClientTest, timesOut) {
+  Logger::setDefaultStreamLogger(std::cout);   // the client warns about the timeout
+  int sv[2];
+  ASSERT_EQ(::socketpair(AF_UNIX, SOCK_DGRAM, 0, sv), 0);
+  SdoClient sdo(sv[0]);
+  sdo.setTimeout(0.02);
+  auto result = sdo.upload(5, 0x1000, 0);
+  ASSERT_EQ(result.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+  EXPECT_EQ(result.get().status, SdoResult::timeout);
+  EXPECT_EQ(sdo.getPending(), 0);
+  ::close(sv[1]);
+}
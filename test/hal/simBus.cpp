@@ -0,0 +1,76 @@
+#include <eeros/hal/HAL.hpp>
+#include <eeros/hal/ScalableInput.hpp>
+#include <eeros/hal/ScalableOutput.hpp>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+
+using namespace eeros;
+using namespace eeros::hal;
+
+namespace {
+
+// loads a device of the simulated field bus library with an analog and a logic loop back,
+// analog channels without a known unit would be dropped
+void loadDevice(const std::string& name, const std::string& model) {
+#ifdef EEROS_SIMBUS_LIBRARY
+  const std::string file = "/tmp/eeros_test_" + name + ".json";
+  std::ofstream out(file, std::ios::trunc);
+  out << "{ \"device0\": { \"library\": \"" EEROS_SIMBUS_LIBRARY "\", \"devHandle\": \"" << name << "; " << model << "\",\n"
+      << "  \"subdevice0\": { \"type\": \"AnalogOut\", \"channel0\": { \"signalId\": \"" << name << "AOut\", \"unit\": \"V\" } },\n"
+      << "  \"subdevice1\": { \"type\": \"AnalogIn\", \"channel0\": { \"signalId\": \"" << name << "AIn\", \"unit\": \"V\" } },\n"
+      << "  \"subdevice2\": { \"type\": \"DigOut\", \"channel0\": { \"signalId\": \"" << name << "DOut\" } },\n"
+      << "  \"subdevice3\": { \"type\": \"DigIn\", \"channel0\": { \"signalId\": \"" << name << "DIn\" } } } }\n";
+  out.close();
+  HAL::instance().readConfigFromFile(file);
+  std::remove(file.c_str());
+#endif
+}
+
+}
+
+// Each output is wired back to the input of the same channel
+TEST(halSimBusTest, roundTrip) {
+#ifndef EEROS_SIMBUS_LIBRARY
+  GTEST_SKIP() << "simulated field bus library not built";
+#endif
+  HAL& hal = HAL::instance();
+  loadDevice("simBusDirect", "batch=false");
+  auto aOut = hal.getScalableOutput("simBusDirectAOut");
+  auto aIn = hal.getScalableInput("simBusDirectAIn");
+  auto dOut = hal.getLogicOutput("simBusDirectDOut");
+  auto dIn = hal.getLogicInput("simBusDirectDIn");
+  aOut->set(2.5);
+  dOut->set(true);
+  EXPECT_EQ(aOut->get(), 2.5);
+  EXPECT_EQ(aIn->get(), 2.5);
+  EXPECT_TRUE(dIn->get());
+  aOut->set(-1.0);
+  dOut->set(false);
+  EXPECT_EQ(aIn->get(), -1.0);
+  EXPECT_FALSE(dIn->get());
+}
+
+// A batched device transfers its outputs with commitOutputs() and its inputs with updateInputs()
+TEST(halSimBusTest, batchRoundTrip) {
+#ifndef EEROS_SIMBUS_LIBRARY
+  GTEST_SKIP() << "simulated field bus library not built";
+#endif
+  HAL& hal = HAL::instance();
+  loadDevice("simBusBatch", "batch=true");
+  auto aOut = hal.getScalableOutput("simBusBatchAOut");
+  auto aIn = hal.getScalableInput("simBusBatchAIn");
+  auto dOut = hal.getLogicOutput("simBusBatchDOut");
+  auto dIn = hal.getLogicInput("simBusBatchDIn");
+  aOut->set(4.0);
+  dOut->set(true);
+  EXPECT_EQ(aOut->get(), 4.0);   // staged
+  hal.updateInputs();
+  EXPECT_EQ(aIn->get(), 0.0);    // not committed yet
+  EXPECT_FALSE(dIn->get());
+  hal.commitOutputs();
+  EXPECT_EQ(aIn->get(), 0.0);    // not read yet
+  hal.updateInputs();
+  EXPECT_EQ(aIn->get(), 4.0);
+  EXPECT_TRUE(dIn->get());
+}
@@ -0,0 +1,69 @@
+#include <eeros/logger/AsyncLogWriter.hpp>
+#include <eeros/logger/LogEntry.hpp>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace eeros::logger;
+
+namespace {
+
+int countLines(const std::string& s, const std::string& text) {
+  int n = 0;
+  for (auto pos = s.find(text); pos != std::string::npos; pos = s.find(text, pos + 1)) n++;
+  return n;
+}
+
+}
+
+TEST(loggerAsyncLogWriterTest, writesOnBackgroundThread) {
+  std::stringstream out;
+  auto w = std::make_shared<AsyncLogWriter>(out);
+  LogEntry(w, LogLevel::WARN, 'A') << "value " << 1.5;
+  LogEntry(w, LogLevel::TRACE) << "hidden";
+  w->flush();
+  std::string s = out.str();
+  EXPECT_NE(s.find("A \033[22;33mW:  value 1.5\033[0m\n"), std::string::npos);
+  EXPECT_EQ(s.find("hidden"), std::string::npos);
+  EXPECT_EQ(w->getDropped(), 0);
+}
+
+TEST(loggerAsyncLogWriterTest, keepsOrderPerThread) {
+  std::stringstream out;
+  {
+    auto w = std::make_shared<AsyncLogWriter>(out);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+      threads.emplace_back([w, t]() {
+        for (int i = 0; i < 10; i++) LogEntry(w, LogLevel::INFO) << "thread " << t << " message " << i;
+      });
+    }
+    for (auto& t : threads) t.join();
+  } // destructor writes all pending messages
+  std::string s = out.str();
+  for (int t = 0; t < 4; t++) {
+    std::string prefix = "thread " + std::to_string(t) + " message ";
+    for (int i = 1; i < 10; i++) {
+      EXPECT_LT(s.find(prefix + std::to_string(i - 1)), s.find(prefix + std::to_string(i)));
+    }
+  }
+}
+
+TEST(loggerAsyncLogWriterTest, countsDroppedMessages) {
+  std::stringstream out;
+  auto w = std::make_shared<AsyncLogWriter>(out);
+  constexpr int total = 4 * AsyncLogWriter::ringSize;
+  for (int i = 0; i < total; i++) LogEntry(w, LogLevel::INFO) << "burst";
+  w->flush();
+  EXPECT_EQ(countLines(out.str(), "burst") + w->getDropped(), total);
+}
+
+TEST(loggerAsyncLogWriterTest, truncatesLongMessages) {
+  std::stringstream out;
+  auto w = std::make_shared<AsyncLogWriter>(out);
+  LogEntry(w, LogLevel::INFO) << std::string(2 * AsyncLogWriter::maxLength, 'x');
+  w->flush();
+  EXPECT_EQ(countLines(out.str(), "x"), AsyncLogWriter::maxLength);
+}
@@ -0,0 +1,43 @@
+#include <eeros/logger/Logger.hpp>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+using namespace eeros::logger;
+
+namespace {
+
+enum class Mode { IDLE, RUNNING };
+
+}
+
+TEST(loggerDeferredTest, formatsArguments) {
+  std::stringstream s;
+  LogArg args[] = {LogArg(1.5), LogArg(-3), LogArg(7u), LogArg(true), LogArg('c'), LogArg(Mode::RUNNING)};
+  format(s, "d={} i={} u={} b={} c={} m={}", args, 6);
+  EXPECT_EQ(s.str(), "d=1.5 i=-3 u=7 b=1 c=c m=1");
+}
+
+TEST(loggerDeferredTest, streamLogger) {
+  static std::stringstream out;
+  Logger::setDefaultStreamLogger(out);
+  Logger log = Logger::getLogger();
+  log.deferred(LogLevel::WARN, "position {} of joint {}", 0.25, 3);
+  log.deferred(LogLevel::TRACE, "hidden {}", 1);
+  EXPECT_NE(out.str().find("W:  position 0.25 of joint 3"), std::string::npos);
+  EXPECT_EQ(out.str().find("hidden"), std::string::npos);
+  Logger::setDefaultStreamLogger(std::cout);
+}
+
+TEST(loggerDeferredTest, asyncLogger) {
+  static std::stringstream out;
+  Logger::setDefaultAsyncLogger(out);
+  {
+    Logger log = Logger::getLogger('D');
+    log.deferred(LogLevel::ERROR, "no arguments");
+    log.deferred(LogLevel::INFO, "velocity {} limit {}", 1.5, 2u);
+  }
+  Logger::setDefaultStreamLogger(std::cout); // destroys the async writer, which writes all messages
+  EXPECT_NE(out.str().find("D \033[22;31mE:  no arguments"), std::string::npos);
+  EXPECT_NE(out.str().find("I:  velocity 1.5 limit 2"), std::string::npos);
+}
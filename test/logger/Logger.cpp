@@ -0,0 +1,50 @@
+#include <eeros/logger/Logger.hpp>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+using namespace eeros::logger;
+
+namespace {
+
+int evaluated = 0;
+
+struct Counted { };
+
+std::ostream& operator<<(std::ostream& os, const Counted&) {
+  evaluated++;
+  return os << "counted";
+}
+
+}
+
+TEST(loggerLoggerTest, categoryLevels) {
+  static std::stringstream out;
+  Logger::setDefaultStreamLogger(out);
+  Logger a = Logger::getLogger('A');
+  Logger b = Logger::getLogger('B');
+  a.show(LogLevel::TRACE, 'A');
+  a.trace() << "trace A";
+  b.trace() << "trace B";
+  b.info() << "info B";
+  EXPECT_NE(out.str().find("trace A"), std::string::npos);
+  EXPECT_EQ(out.str().find("trace B"), std::string::npos);
+  EXPECT_NE(out.str().find("info B"), std::string::npos);
+  b.show(LogLevel::ERROR);  // all categories
+  a.warn() << "warn A";
+  EXPECT_EQ(out.str().find("warn A"), std::string::npos);
+  Logger::setDefaultStreamLogger(std::cout);
+}
+
+TEST(loggerLoggerTest, suppressedEntryDoesNotFormat) {
+  static std::stringstream out;
+  Logger::setDefaultStreamLogger(out);
+  Logger log = Logger::getLogger();
+  evaluated = 0;
+  log.trace() << Counted();
+  EXPECT_EQ(evaluated, 0);
+  log.info() << Counted();
+  EXPECT_EQ(evaluated, 1);
+  EXPECT_NE(out.str().find("counted"), std::string::npos);
+  Logger::setDefaultStreamLogger(std::cout);
+}
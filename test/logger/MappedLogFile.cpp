@@ -0,0 +1,55 @@
+#include <eeros/logger/MappedLogFile.hpp>
+#include <eeros/core/Fault.hpp>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace eeros::logger;
+
+namespace {
+
+std::string read(const std::string& path) {
+  std::ifstream f(path);
+  std::stringstream s;
+  s << f.rdbuf();
+  return s.str();
+}
+
+}
+
+TEST(loggerMappedLogFileTest, rotatesSegments) {
+  std::string path = "/tmp/eerosMappedLog";
+  std::string line(100, 'x');
+  line.back() = '\n';
+  int lines;
+  {
+    MappedLogFile file(path, 1, 3);   // one page per segment
+    lines = file.getSegmentSize() / line.size() + 1;
+    for (int i = 0; i < lines; i++) file.write(line.data(), line.size());
+    EXPECT_EQ(file.getDropped(), 0);
+  }
+  std::string s0 = read(path + ".0"), s1 = read(path + ".1");
+  EXPECT_EQ(s0.size(), (lines - 1) * line.size());   // no message is split, no padding is left
+  EXPECT_EQ(s1, line);
+  EXPECT_EQ(read(path + ".2"), "");
+  for (int i = 0; i < 3; i++) std::remove((path + '.' + std::to_string(i)).c_str());
+}
+
+TEST(loggerMappedLogFileTest, dropsWhenNextSegmentIsNotReady) {
+  std::string path = "/tmp/eerosMappedLogDrop";
+  std::string block(4096, 'y');
+  {
+    MappedLogFile file(path, 4096, 2);
+    file.write(block.data(), block.size());
+    file.write(block.data(), block.size());   // second segment, prepared in advance
+    file.write(block.data(), block.size());   // background thread did not prepare the next one yet
+    EXPECT_EQ(file.getDropped(), 1);
+  }
+  for (int i = 0; i < 2; i++) std::remove((path + '.' + std::to_string(i)).c_str());
+}
+
+TEST(loggerMappedLogFileTest, invalidSegments) {
+  EXPECT_THROW(MappedLogFile("/tmp/eerosMappedLogInvalid", 4096, 1), eeros::Fault);
+}
@@ -0,0 +1,110 @@
+#include <eeros/logger/SharedLogWriter.hpp>
+#include <eeros/logger/LogEntry.hpp>
+#include <eeros/core/Fault.hpp>
+#include <gtest/gtest.h>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace eeros::logger;
+
+namespace {
+
+const std::string name = "/eeros_log_test";
+
+std::vector<SharedLogRecord> pollAll(SharedLogRing& ring) {
+  std::vector<SharedLogRecord> records;
+  ring.poll([&](const SharedLogRecord& r) { records.push_back(r); }, std::chrono::nanoseconds(0));
+  return records;
+}
+
+}
+
+TEST(loggerSharedLogRingTest, mergesProcessesByTime) {
+  SharedLogRing::remove(name);
+  SharedLogRing ring(name, 4, 16);
+  {
+    auto w = std::make_shared<SharedLogWriter>(name, 4, 16);
+    LogEntry(w, LogLevel::WARN, 'A') << "first " << 1;
+    pid_t child = fork();
+    if (child == 0) {
+      SharedLogWriter c(name, 4, 16);
+      LogEntry(&c, LogLevel::INFO) << "second";
+      _exit(0);
+    }
+    ASSERT_GT(child, 0);
+    waitpid(child, nullptr, 0);
+    LogEntry(w, LogLevel::INFO) << "third";
+    LogEntry(w, LogLevel::TRACE) << "hidden";
+    EXPECT_EQ(w->getDropped(), 0);
+  }
+  auto records = pollAll(ring);
+  ASSERT_EQ(records.size(), 3);
+  EXPECT_EQ(std::string(records[0].text, records[0].length), "first 1");
+  EXPECT_EQ(records[0].level, static_cast<uint8_t>(LogLevel::WARN));
+  EXPECT_EQ(records[0].category, 'A');
+  EXPECT_EQ(std::string(records[1].text, records[1].length), "second");
+  EXPECT_NE(records[1].pid, getpid());
+  EXPECT_EQ(std::string(records[2].text, records[2].length), "third");
+  EXPECT_EQ(records[2].pid, getpid());
+  EXPECT_LE(records[0].time, records[1].time);
+  EXPECT_LE(records[1].time, records[2].time);
+  SharedLogRing::remove(name);
+}
+
+TEST(loggerSharedLogRingTest, holdsBackRecentRecords) {
+  SharedLogRing::remove(name);
+  SharedLogRing ring(name, 2, 8);
+  SharedLogWriter w(name, 2, 8);
+  LogEntry(&w, LogLevel::INFO) << "recent";
+  std::size_t n = ring.poll([](const SharedLogRecord&) { }, std::chrono::seconds(10));
+  EXPECT_EQ(n, 0);
+  EXPECT_EQ(pollAll(ring).size(), 1);
+  SharedLogRing::remove(name);
+}
+
+TEST(loggerSharedLogRingTest, countsDroppedRecords) {
+  SharedLogRing::remove(name);
+  SharedLogRing ring(name, 2, 8);
+  SharedLogWriter w(name, 2, 8);
+  for (int i = 0; i < 20; i++) LogEntry(&w, LogLevel::INFO) << "burst " << i;
+  EXPECT_EQ(w.getDropped(), 12);
+  EXPECT_EQ(ring.getDropped(), 12);
+  auto records = pollAll(ring);
+  ASSERT_EQ(records.size(), 8);
+  EXPECT_EQ(std::string(records[7].text, records[7].length), "burst 7");
+  SharedLogRing::remove(name);
+}
+
+TEST(loggerSharedLogRingTest, freesProducers) {
+  SharedLogRing::remove(name);
+  SharedLogRing ring(name, 2, 8);
+  SharedLogWriter w(name, 2, 8);
+  // threads release their producer when they end
+  for (int t = 0; t < 4; t++) std::thread([&w]() { LogEntry(&w, LogLevel::INFO) << "thread"; }).join();
+  EXPECT_EQ(w.getDropped(), 0);
+  // a process which ends without releasing its producers loses them on the next poll
+  pid_t child = fork();
+  if (child == 0) {
+    SharedLogRing r(name, 2, 8);
+    r.claim();
+    r.claim();
+    _exit(0);
+  }
+  waitpid(child, nullptr, 0);
+  std::thread([&w]() { LogEntry(&w, LogLevel::INFO) << "taken"; }).join();
+  EXPECT_EQ(w.getDropped(), 1);
+  EXPECT_EQ(pollAll(ring).size(), 4);
+  std::thread([&w]() { LogEntry(&w, LogLevel::INFO) << "freed"; }).join();
+  EXPECT_EQ(w.getDropped(), 1);
+  SharedLogRing::remove(name);
+}
+
+TEST(loggerSharedLogRingTest, checksLayout) {
+  SharedLogRing::remove(name);
+  SharedLogRing ring(name, 2, 8);
+  EXPECT_THROW(SharedLogRing(name, 4, 8), eeros::Fault);
+  SharedLogRing::remove(name);
+}
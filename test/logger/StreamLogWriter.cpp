@@ -0,0 +1,23 @@
+#include <eeros/logger/Logger.hpp>
+#include <gtest/gtest.h>
+#include <regex>
+#include <sstream>
+#include <string>
+
+using namespace eeros::logger;
+
+TEST(loggerStreamLogWriterTest, timestampPrefix) {
+  static std::stringstream out;
+  Logger::setDefaultStreamLogger(out);
+  Logger log = Logger::getLogger('S');
+  for (int i = 0; i < 3; i++) log.info() << "line " << i;
+  Logger::setDefaultStreamLogger(std::cout);
+  std::regex line("\\d{4}-\\d{2}-\\d{2} \\d{2}:\\d{2}:\\d{2}:\\d{3}  S \033\\[22;36mI:  line \\d\033\\[0m");
+  std::string s;
+  int n = 0;
+  while (std::getline(out, s)) {
+    EXPECT_TRUE(std::regex_match(s, line)) << s;
+    n++;
+  }
+  EXPECT_EQ(n, 3);
+}
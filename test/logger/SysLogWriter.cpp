@@ -0,0 +1,60 @@
+#include <eeros/logger/SysLogWriter.hpp>
+#include <eeros/logger/LogEntry.hpp>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace eeros::logger;
+
+namespace {
+
+// a datagram socket standing in for the syslog daemon
+struct Daemon {
+  Daemon(const std::string& path) : path(path) {
+    std::remove(path.c_str());
+    fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    path.copy(addr.sun_path, sizeof(addr.sun_path) - 1);
+    bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+  }
+  ~Daemon() {
+    close(fd);
+    std::remove(path.c_str());
+  }
+  std::string receive() {
+    char buf[1024];
+    ssize_t n = recv(fd, buf, sizeof(buf), MSG_DONTWAIT);
+    return n > 0 ? std::string(buf, n) : "";
+  }
+  std::string path;
+  int fd;
+};
+
+}
+
+TEST(loggerSysLogWriterTest, sendsFromBackgroundThread) {
+  Daemon daemon("/tmp/eerosSysLogTest");
+  {
+    auto w = std::make_shared<SysLogWriter>("eerosTest", daemon.path);
+    LogEntry(w, LogLevel::WARN, 'S') << "first " << 1;
+    LogEntry(w, LogLevel::ERROR) << "second";
+  } // destructor sends all queued messages
+  std::string first = daemon.receive(), second = daemon.receive();
+  EXPECT_EQ(first.rfind("<132>", 0), 0u) << first;  // LOG_LOCAL0 | LOG_WARNING
+  EXPECT_NE(first.find(" eerosTest[" + std::to_string(getpid()) + "]: S W:  first 1"), std::string::npos) << first;
+  EXPECT_EQ(second.rfind("<131>", 0), 0u) << second;
+  EXPECT_NE(second.find("E:  second"), std::string::npos) << second;
+}
+
+TEST(loggerSysLogWriterTest, dropsWithoutDaemon) {
+  auto w = std::make_shared<SysLogWriter>("eerosTest", "/tmp/eerosSysLogMissing");
+  LogEntry(w, LogLevel::WARN) << "lost";
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(w->getDropped(), 1);
+}
@@ -0,0 +1,132 @@
+#include <eeros/math/Fixed.hpp>
+#include <eeros/control/Constant.hpp>
+#include <eeros/control/Gain.hpp>
+#include <eeros/control/Sum.hpp>
+#include <eeros/control/Saturation.hpp>
+#include <eeros/control/I.hpp>
+#include <eeros/control/D.hpp>
+#include <eeros/control/ZTransferFunction.hpp>
+#include <eeros/control/filter/LowPassFilter.hpp>
+#include <eeros/hal/ScalableInput.hpp>
+#include <eeros/hal/ScalableOutput.hpp>
+#include <gtest/gtest.h>
+
+using namespace eeros;
+using namespace eeros::math;
+using namespace eeros::control;
+
+using Q3_12 = Fixed<12, int16_t>;
+
+namespace {
+
+class Adc : public hal::ScalableInput<double> {
+ public:
+  Adc() : hal::ScalableInput<double>("adc", nullptr, 2047.5, 2047.5, 0, 4095) { }
+  double get() override { return 0; }
+};
+
+class Dac : public hal::ScalableOutput<double> {
+ public:
+  Dac() : hal::ScalableOutput<double>("dac", nullptr, 2047.5, 2047.5, 0, 4095) { }
+  double get() override { return 0; }
+  void set(double) override { }
+};
+
+}
+
+TEST(mathFixedTest, conversion) {
+  EXPECT_EQ(Q15(0.5).raw(), 16384);
+  EXPECT_EQ(Q15(-1.0).raw(), -32768);
+  EXPECT_EQ(Q15(1.0).raw(), 32767);    // saturated
+  EXPECT_EQ(Q15(-3.0).raw(), -32768);
+  EXPECT_DOUBLE_EQ(Q31(0.25).toDouble(), 0.25);
+  EXPECT_DOUBLE_EQ(Q3_12(-2.5).toDouble(), -2.5);
+  EXPECT_EQ(Q15::fromRaw(1), std::numeric_limits<Q15>::epsilon());
+}
+
+TEST(mathFixedTest, saturatingArithmetic) {
+  Q15 a(0.75), b(0.5);
+  EXPECT_EQ(a + b, Q15::max());
+  EXPECT_EQ(-a - b, Q15::lowest());
+  EXPECT_EQ(-Q15::lowest(), Q15::max());
+  EXPECT_DOUBLE_EQ((a - b).toDouble(), 0.25);
+  EXPECT_DOUBLE_EQ((a * b).toDouble(), 0.375);
+  EXPECT_DOUBLE_EQ((b / a).toDouble(), Q15(2.0 / 3.0).toDouble());
+  EXPECT_EQ(a / b, Q15::max());
+  EXPECT_EQ(a / Q15(), Q15::max());
+  EXPECT_EQ(-a / Q15(), Q15::lowest());
+  Q31 c(0.999), d(-0.999);
+  EXPECT_NEAR((c * d).toDouble(), -0.998001, 1e-9);
+  EXPECT_EQ(Q3_12(7.0) * Q3_12(2.0), Q3_12::max());
+  EXPECT_DOUBLE_EQ((Q3_12(1.5) * 0.5).toDouble(), 0.75);
+}
+
+TEST(mathFixedTest, scaling) {
+  // 12 bit adc, 0 ... 4095 counts for -1 ... 1
+  Adc adc;
+  auto in = adc.getFixedScaling<Q15>();
+  for (int32_t counts : {0, 1, 1000, 2047, 2048, 4095}) {
+    EXPECT_NEAR(in.toValue(counts).toDouble(), adc.toValue(counts), 1.0 / 32768) << counts;
+  }
+  EXPECT_EQ(in.toValue(100000), Q15::max());
+  Dac dac;
+  auto out = dac.getFixedScaling<Q15>();
+  for (double v : {-1.0, -0.5, 0.0, 0.3, 0.99}) {
+    EXPECT_NEAR(out.toCounts(Q15(v)), dac.toRaw(v), 0.5 + 1e-9) << v;
+  }
+}
+
+TEST(mathFixedTest, blocks) {
+  Constant<Q3_12> c(1.5), c2(0.25);
+  Gain<Q3_12, Q3_12> g(Q3_12(2.0));
+  Sum<2, Q3_12> s;
+  Saturation<Q3_12> sat(Q3_12(2.5));
+  LowPassFilter<Q3_12> lp(0.5);
+  g.getIn().connect(c.getOut());
+  s.getIn(0).connect(g.getOut());
+  s.getIn(1).connect(c2.getOut());
+  s.negateInput(1);
+  sat.getIn().connect(s.getOut());
+  lp.getIn().connect(sat.getOut());
+  for (Block* b : std::vector<Block*>{&c, &c2, &g, &s, &sat, &lp}) b->run();
+  EXPECT_DOUBLE_EQ(g.getOut().getSignal().getValue().toDouble(), 3.0);
+  EXPECT_DOUBLE_EQ(s.getOut().getSignal().getValue().toDouble(), 2.75);
+  EXPECT_DOUBLE_EQ(sat.getOut().getSignal().getValue().toDouble(), 2.5);
+  EXPECT_DOUBLE_EQ(lp.getOut().getSignal().getValue().toDouble(), 2.5);
+  c.setValue(0.5);
+  for (Block* b : std::vector<Block*>{&c, &c2, &g, &s, &sat, &lp}) b->run();
+  EXPECT_DOUBLE_EQ(lp.getOut().getSignal().getValue().toDouble(), 1.625);
+
+  // first order low pass y = 0.5 * x + 0.5 * y-1 as transfer function
+  ZTransferFunction<1, Q3_12> tf({1, -0.5}, {0.5, 0});
+  Constant<Q3_12> one(1.0);
+  tf.getIn().connect(one.getOut());
+  one.run();
+  double expected = 0, prev = 0;
+  for (int i = 0; i < 5; i++) {
+    tf.run();
+    expected = 0.5 + 0.5 * prev;
+    prev = expected;
+  }
+  EXPECT_NEAR(tf.getOut().getSignal().getValue().toDouble(), expected, 1e-3);
+}
+
+TEST(mathFixedTest, integratorAndDifferentiator) {
+  Constant<Q3_12> c(1.0);
+  I<Q3_12> i;
+  D<Q3_12> d;
+  i.getIn().connect(c.getOut());
+  d.getIn().connect(i.getOut());
+  i.setInitCondition(Q3_12(0.0));
+  i.enable();
+  for (int k = 0; k < 3; k++) {
+    c.run();
+    i.run();
+    d.run();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  double integral = i.getOut().getSignal().getValue().toDouble();
+  EXPECT_GT(integral, 0.15);
+  EXPECT_LT(integral, 0.3);
+  EXPECT_NEAR(d.getOut().getSignal().getValue().toDouble(), 1.0, 0.1);
+}
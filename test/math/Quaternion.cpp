@@ -5,6 +5,8 @@
 using namespace eeros;
 using namespace eeros::math;
 
+template class eeros::math::QuaternionT<float>;
+
 TEST(mathQuaternion, init) {
   Quaternion q1;
   EXPECT_TRUE(Utils::compareApprox(1, q1.get().norm(), 0.001));
@@ -134,3 +136,79 @@ TEST(mathQuaternion, rot2) {
   q3 = q2 * q1.inv();
   EXPECT_TRUE(Utils::compareApprox(2*std::acos(q3.get()[0]), turnZ, 0.001));
 }
+
+TEST(mathQuaternion, rotate) {
+  Quaternion q(0.3, -0.2, 1.1);
+  Matrix<3, 1, double> v{0.5, -2.0, 1.5};
+  Matrix<3, 1, double> r1 = q.rotate(v);
+  Matrix<3, 1, double> r2 = q.getRot() * v;
+  for (int i = 0; i < 3; i++) EXPECT_NEAR(r1(i), r2(i), 1e-12);
+
+  constexpr int n = 7;
+  double x[n], y[n], z[n], xo[n], yo[n], zo[n];
+  for (int i = 0; i < n; i++) {
+    x[i] = i;
+    y[i] = 1.0 - i;
+    z[i] = 0.5 * i;
+  }
+  q.rotate(x, y, z, xo, yo, zo, n);
+  for (int i = 0; i < n; i++) {
+    Matrix<3, 1, double> r = q.rotate(Matrix<3, 1, double>{x[i], y[i], z[i]});
+    EXPECT_NEAR(xo[i], r(0), 1e-12);
+    EXPECT_NEAR(yo[i], r(1), 1e-12);
+    EXPECT_NEAR(zo[i], r(2), 1e-12);
+  }
+}
+
+TEST(mathQuaternion, interpolate) {
+  Quaternion a;
+  Quaternion b(0.0, 0.0, M_PI / 2);
+  Quaternion half = Quaternion::slerp(a, b, 0.5);
+  Quaternion expected(0.0, 0.0, M_PI / 4);
+  EXPECT_NEAR(std::abs(half.dot(expected)), 1.0, 1e-12);
+  EXPECT_NEAR(std::abs(Quaternion::nlerp(a, b, 0.5).dot(expected)), 1.0, 1e-12);
+  EXPECT_NEAR(std::abs(Quaternion::slerp(a, b, 0.0).dot(a)), 1.0, 1e-12);
+  EXPECT_NEAR(std::abs(Quaternion::slerp(a, b, 1.0).dot(b)), 1.0, 1e-12);
+  // shorter path, b and -b are the same rotation
+  Quaternion nb = b * -1.0;
+  EXPECT_NEAR(std::abs(Quaternion::slerp(a, nb, 0.5).dot(expected)), 1.0, 1e-12);
+
+  // bounded error, measured as rotation angle
+  Quaternion c(0.2, 0.1, 0.3);
+  for (double maxError : {1e-2, 1e-4, 1e-8}) {
+    for (double t = 0.0; t <= 1.0; t += 0.05) {
+      Quaternion exact = Quaternion::slerp(a, c, t);
+      Quaternion approx = Quaternion::slerp(a, c, t, maxError);
+      double angle = 2.0 * std::acos(std::min(1.0, std::abs(exact.dot(approx))));
+      EXPECT_LE(angle, maxError + 1e-7);
+    }
+  }
+}
+
+TEST(mathQuaternion, float) {
+  Quaternion q(0.3, -0.2, 1.1);
+  QuaternionF qf(0.3f, -0.2f, 1.1f);
+  EXPECT_NEAR(qf.w, q.w, 1e-6);
+  EXPECT_NEAR(qf.x, q.x, 1e-6);
+  EXPECT_NEAR(qf.y, q.y, 1e-6);
+  EXPECT_NEAR(qf.z, q.z, 1e-6);
+  constexpr int n = 11;
+  float x[n], y[n], z[n], xo[n], yo[n], zo[n];
+  for (int i = 0; i < n; i++) {
+    x[i] = i;
+    y[i] = 1.0f - i;
+    z[i] = 0.5f * i;
+  }
+  qf.rotate(x, y, z, xo, yo, zo, n);
+  for (int i = 0; i < n; i++) {
+    Matrix<3, 1, double> r = q.rotate(Matrix<3, 1, double>{x[i], y[i], z[i]});
+    EXPECT_NEAR(xo[i], r(0), 1e-5);
+    EXPECT_NEAR(yo[i], r(1), 1e-5);
+    EXPECT_NEAR(zo[i], r(2), 1e-5);
+  }
+  QuaternionF a;
+  QuaternionF b(0.0f, 0.0f, static_cast<float>(M_PI / 2));
+  QuaternionF expected(0.0f, 0.0f, static_cast<float>(M_PI / 4));
+  EXPECT_NEAR(std::abs(QuaternionF::slerp(a, b, 0.5f).dot(expected)), 1.0f, 1e-6);
+  EXPECT_NEAR(std::abs(QuaternionF::slerp(a, a, 0.5f).dot(a)), 1.0f, 1e-6);
+}
@@ -143,6 +143,34 @@ int main(int argc, char *argv[]) {
 	
 	/**************************************************/
 	
+	std::cout << "Test #" << testNo++ << ": frames of destroyed coordinate systems" << std::endl;
+	error = 0;
+	
+	uint32_t nofFrames = Frame::getNofFrames();
+	{
+		CoordinateSystem d("d");
+		Frame ad(a, d);
+		Frame da(d, a);
+		if(Frame::getFrame(d, a) != &da || Frame::getNofFrames() != nofFrames + 2) {
+			std::cout << "  -> Failure: getting the frame 'd -> a' failed" << std::endl;
+			error++;
+		}
+	}
+	CoordinateSystem e2("e");  // gets the index of 'd'
+	if(Frame::getFrame(a, e2) != nullptr || Frame::getFrame(e2, a) != nullptr || Frame::getNofFrames() != nofFrames) {
+		std::cout << "  -> Failure: frames of 'd' still registered" << std::endl;
+		error++;
+	}
+	if(CoordinateSystem::getCoordinateSystem("d") != nullptr || CoordinateSystem::getCoordinateSystem(e2.getIndex()) != &e2) {
+		std::cout << "  -> Failure: lookup of coordinate systems" << std::endl;
+		error++;
+	}
+	
+	errorSum += error;
+	std::cout << "  -> Test finished with " << error << " error(s)" << std::endl;
+	
+	/**************************************************/
+	
 	if(errorSum == 0) {
 		std::cout << "Frame test succeeded" << std::endl;
 	}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <eeros/math/Matrix.hpp>
+
+using namespace eeros::math;
+
+namespace {
+
+constexpr Matrix<3, 3> gain(1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0);
+constexpr auto eye3 = Matrix<3, 3>::createDiag(1.0);
+constexpr auto rotZ = Matrix<3, 3>::createRotZ(trig::pi / 6);
+
+constexpr Matrix<3, 3> createEye() {
+  Matrix<3, 3> m;
+  m.eye();
+  return m;
+}
+
+}
+
+TEST(mathMatrixConstexprTest, construction) {
+  static_assert(gain(0, 0) == 1.0 && gain(1, 0) == 2.0 && gain(0, 2) == 7.0);
+  static_assert(gain.get(2, 2) == 9.0);
+  static_assert(gain[5] == 6.0);
+  static_assert(Matrix<2, 2, int>(3)(1, 1) == 3);
+  static_assert(createEye() == eye3);
+  static_assert(eye3.isDiagonal() && eye3.trace() == 3.0);
+  static_assert(gain.transpose()(0, 2) == 3.0);
+  static_assert(gain.getCol(1)(2) == 6.0 && gain.getRow(1)(2) == 8.0);
+  static_assert(Matrix<3, 1>::crossProduct(Matrix<3, 1>::createVector3(1, 0, 0), Matrix<3, 1>::createVector3(0, 1, 0))(2) == 1.0);
+  EXPECT_EQ(gain(2, 1), 6.0);
+}
+
+TEST(mathMatrixConstexprTest, product) {
+  constexpr auto p = gain * eye3;
+  static_assert(p == gain);
+  constexpr auto q = gain * Matrix<3, 1>::createVector3(1, 1, 1);
+  static_assert(q(0) == 12.0 && q(1) == 15.0 && q(2) == 18.0);
+  Matrix<3, 3> g = gain;
+  EXPECT_EQ(g * eye3, p);
+}
+
+TEST(mathMatrixConstexprTest, rotation) {
+  static_assert(rotZ(2, 2) == 1.0 && rotZ(0, 1) == -rotZ(1, 0));
+  Matrix<3, 3> r;
+  r.rotz(trig::pi / 6);
+  for (unsigned int i = 0; i < 9; i++) EXPECT_NEAR(rotZ[i], r[i], 1e-15);
+  EXPECT_NEAR(rotZ(0, 0), std::sqrt(3.0) / 2, 1e-15);
+}
+
+TEST(mathMatrixConstexprTest, rotationTable) {
+  constexpr int n = 200;
+  constexpr auto table = [] {
+    std::array<Matrix<3, 3>, n> t;
+    for (int i = 0; i < n; i++) t[i] = Matrix<3, 3>::createRotX(-20 + i * 0.2);
+    return t;
+  }();
+  for (int i = 0; i < n; i++) {
+    double a = -20 + i * 0.2;
+    EXPECT_NEAR(table[i](1, 1), std::cos(a), 1e-14);
+    EXPECT_NEAR(table[i](2, 1), std::sin(a), 1e-14);
+  }
+}
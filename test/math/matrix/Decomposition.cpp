@@ -0,0 +1,120 @@
+#include <eeros/math/MatrixDecomposition.hpp>
+#include <gtest/gtest.h>
+
+using namespace eeros;
+using namespace eeros::math;
+
+template class eeros::math::LUDecomposition<5, float>;
+template class eeros::math::CholeskyDecomposition<5, float>;
+template class eeros::math::QRDecomposition<6, 4, float>;
+
+namespace {
+
+template <unsigned int M, unsigned int N>
+void expectNear(const Matrix<M, N>& a, const Matrix<M, N>& b, double tolerance = 1e-9) {
+  for (unsigned int i = 0; i < M * N; i++) EXPECT_NEAR(a(i), b(i), tolerance) << "element " << i;
+}
+
+// Symmetric positive definite matrix, similar to a covariance matrix
+Matrix<8, 8> spd() {
+  Matrix<8, 8> a;
+  for (unsigned int m = 0; m < 8; m++) {
+    for (unsigned int n = 0; n < 8; n++) a(m, n) = 1.0 / (1.0 + m + n);
+  }
+  for (unsigned int i = 0; i < 8; i++) a(i, i) += 1.0;
+  return a;
+}
+
+Matrix<5, 5> general() {
+  return Matrix<5, 5>{0.0, 2.0, 1.0, -1.0, 3.0,
+                      4.0, 1.0, 0.0, 2.0, -2.0,
+                      1.0, -3.0, 2.0, 0.5, 1.0,
+                      2.0, 0.0, -1.0, 3.0, 1.0,
+                      -1.0, 1.0, 4.0, 1.0, 0.0};
+}
+
+}
+
+TEST(mathMatrixDecomposition, det) {
+  // permutation with two row swaps
+  Matrix<4, 4> p{0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0};
+  EXPECT_DOUBLE_EQ(p.det(), 1.0);
+  Matrix<5, 5> a = general();
+  LUDecomposition<5> lu(a);
+  EXPECT_NEAR(a.det(), lu.det(), 1e-9);
+  Matrix<5, 5> t = a.transpose();
+  EXPECT_NEAR(t.det(), a.det(), 1e-9);
+  Matrix<4, 4, int> i{2, 0, 0, 0, 0, 3, 0, 0, 0, 0, 1, 4, 0, 0, 1, 1};
+  EXPECT_EQ(i.det(), -18);
+  Matrix<5, 5> s;
+  s.zero();
+  EXPECT_EQ(s.det(), 0.0);
+}
+
+TEST(mathMatrixDecomposition, lu) {
+  Matrix<5, 5> a = general();
+  LUDecomposition<5> lu(a);
+  ASSERT_FALSE(lu.isSingular());
+  expectNear(lu.getP() * a, lu.getL() * lu.getU());
+  Matrix<5, 2> b;
+  for (unsigned int i = 0; i < 10; i++) b(i) = i - 3.0;
+  Matrix<5, 2> x = lu.solve(b);
+  expectNear(a * x, b);
+  expectNear(a.solve(b), x);
+  Matrix<5, 5> eye;
+  eye.eye();
+  expectNear(a * lu.inverse(), eye);
+  expectNear(a * a.inverse(), eye);
+  expectNear(a * !a, eye);
+
+  Matrix<5, 5> s;
+  s.zero();
+  EXPECT_TRUE(LUDecomposition<5>(s).isSingular());
+  EXPECT_THROW(LUDecomposition<5>(s).solve(b), Fault);
+  EXPECT_THROW(s.solve(b), Fault);
+}
+
+TEST(mathMatrixDecomposition, cholesky) {
+  Matrix<8, 8> a = spd();
+  CholeskyDecomposition<8> chol(a);
+  ASSERT_TRUE(chol.isPositiveDefinite());
+  Matrix<8, 8> l = chol.getL();
+  EXPECT_TRUE(l.isLowerTriangular());
+  expectNear(l * l.transpose(), a);
+  Matrix<8, 1> b;
+  for (unsigned int i = 0; i < 8; i++) b(i) = 1.0 + i;
+  expectNear(a * chol.solve(b), b);
+  EXPECT_NEAR(chol.det(), LUDecomposition<8>(a).det(), 1e-12);
+
+  Matrix<8, 8> indefinite = a;
+  indefinite(3, 3) = -1.0;
+  CholeskyDecomposition<8> failed(indefinite);
+  EXPECT_FALSE(failed.isPositiveDefinite());
+  EXPECT_THROW(failed.solve(b), Fault);
+}
+
+TEST(mathMatrixDecomposition, qr) {
+  Matrix<5, 5> a = general();
+  QRDecomposition<5, 5> qr(a);
+  ASSERT_TRUE(qr.isFullRank());
+  Matrix<5, 5> q = qr.getQ(), r = qr.getR();
+  Matrix<5, 5> eye;
+  eye.eye();
+  expectNear(q.transpose() * q, eye);
+  EXPECT_TRUE(r.isUpperTriangular());
+  expectNear(q * r, a);
+  Matrix<5, 1> b{1.0, 2.0, 3.0, 4.0, 5.0};
+  expectNear(qr.solve(b), a.solve(b));
+
+  // least squares line fit y = c0 + c1 * t through points on the line y = 1 + 2 t
+  Matrix<6, 2> design;
+  Matrix<6, 1> y;
+  for (unsigned int i = 0; i < 6; i++) {
+    design(i, 0) = 1.0;
+    design(i, 1) = i;
+    y(i) = 1.0 + 2.0 * i;
+  }
+  QRDecomposition<6, 2> fit(design);
+  expectNear(fit.solve(y), Matrix<2, 1>{1.0, 2.0});
+  expectNear(fit.getQ() * fit.getR(), design);
+}
@@ -1,4 +1,5 @@
 #include <eeros/math/Matrix.hpp>
+#include <gtest/gtest.h>
 #include <iostream>
 
 #include "../../Utils.hpp"
@@ -19,6 +20,23 @@ void print(Matrix<M, N, T> &A, int indent = 1) {
   }
 }
 
+// The index is checked unless NDEBUG is defined
+TEST(mathMatrixElementAccess, boundsCheck) {
+  Matrix<3, 2, int> m;
+  m.fill(1);
+  m(2, 1) = 5;
+  EXPECT_EQ(m[5], 5);
+  EXPECT_EQ(m.transpose()(1, 2), 5);
+  EXPECT_EQ(checkedElementAccess, EEROS_MATRIX_BOUNDS_CHECK != 0);
+  if (!checkedElementAccess) GTEST_SKIP();
+  EXPECT_THROW(m(3, 0), MatrixIndexOutOfBoundException);
+  EXPECT_THROW(m(0, 2), MatrixIndexOutOfBoundException);
+  EXPECT_THROW(m[6], MatrixIndexOutOfBoundException);
+  EXPECT_THROW(m.get(3, 1), MatrixIndexOutOfBoundException);
+  Matrix<1, 1, int> s;
+  EXPECT_THROW(s(0, 1), MatrixIndexOutOfBoundException);
+}
+
 // int main(int argc, char *argv[]) {
 //   int error = 0, errorSum = 0;
 //   int testNo = 1;
@@ -0,0 +1,68 @@
+#include <eeros/math/Matrix.hpp>
+#include <eeros/math/tf/TF_Matrix.hpp>
+#include <gtest/gtest.h>
+
+using namespace eeros;
+using namespace eeros::math;
+
+// A chained state update gives the same result as step by step evaluation
+TEST(mathMatrixExpression, stateUpdate) {
+  Matrix<3, 3> A{0.9, 0.1, 0.0, 0.0, 0.8, 0.2, 0.1, 0.0, 0.7};
+  Matrix<3, 1> B{0.0, 0.5, 1.0};
+  Matrix<1, 3> C{1.0, 0.0, 0.0};
+  Matrix<3, 1> K{0.3, 0.2, 0.1};
+  Matrix<3, 1> x{1.0, -2.0, 0.5};
+  Matrix<1, 1> u(2.0), y(0.25);
+
+  Matrix<3, 1> Ax = A * x, Bu = B * u;
+  Matrix<1, 1> e = y - C * x;
+  Matrix<3, 1> expected;
+  for (unsigned int i = 0; i < 3; i++) expected(i) = Ax(i) + Bu(i) - K(i) * static_cast<double>(e);
+
+  Matrix<3, 1> next = A * x + B * u - K * (y - C * x);
+  for (unsigned int i = 0; i < 3; i++) EXPECT_DOUBLE_EQ(next(i), expected(i));
+  x = A * x + B * u - K * (y - C * x);
+  EXPECT_EQ(x, next);
+}
+
+// Scalar operations and elementwise operations of expressions
+TEST(mathMatrixExpression, elementwise) {
+  Matrix<2, 2> a{1.0, 2.0, 3.0, 4.0}, b{0.5, 0.5, 1.0, 2.0};
+  Matrix<2, 2> r = 2.0 * (a + b) - a / 2.0 + 1.0;
+  for (unsigned int i = 0; i < 4; i++) EXPECT_DOUBLE_EQ(r(i), 2.0 * (a(i) + b(i)) - a(i) / 2.0 + 1.0);
+  r = -(a - b) * 3.0;
+  for (unsigned int i = 0; i < 4; i++) EXPECT_DOUBLE_EQ(r(i), -(a(i) - b(i)) * 3.0);
+  r = 1.0 - a;
+  r += a - b;
+  for (unsigned int i = 0; i < 4; i++) EXPECT_DOUBLE_EQ(r(i), 1.0 - b(i));
+  EXPECT_TRUE(a + b == b + a);
+  EXPECT_FALSE(a + b != b + a);
+  EXPECT_DOUBLE_EQ((a - a).norm(), 0.0);
+  EXPECT_EQ((a + b)(1, 0), a(1, 0) + b(1, 0));
+}
+
+// The target may appear on the right hand side
+TEST(mathMatrixExpression, aliasing) {
+  Matrix<3, 1> x{1.0, 2.0, 3.0}, b{3.0, 3.0, 3.0};
+  x = b - x;
+  EXPECT_EQ(x, (Matrix<3, 1>{2.0, 1.0, 0.0}));
+  x = x + x * 2.0;
+  EXPECT_EQ(x, (Matrix<3, 1>{6.0, 3.0, 0.0}));
+}
+
+// Temporaries are held by the expression, matrices are referenced
+TEST(mathMatrixExpression, operands) {
+  Matrix<2, 1> a{1.0, 2.0};
+  auto e = a + Matrix<2, 1>{10.0, 20.0};
+  EXPECT_EQ(e(0), 11.0);
+  a(0) = 5.0;
+  EXPECT_EQ(e(0), 15.0);
+  if (checkedElementAccess) {
+    EXPECT_THROW(e(2), MatrixIndexOutOfBoundException);
+  }
+
+  tf::TF_Matrix t;
+  Matrix<4, 4> s = t + t;
+  EXPECT_EQ(s(0, 0), 2.0);
+  EXPECT_EQ(s(1, 0), 0.0);
+}
@@ -0,0 +1,167 @@
+#include <eeros/math/Matrix.hpp>
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+using namespace eeros;
+using namespace eeros::math;
+
+namespace {
+
+template <unsigned int M, unsigned int N, typename T>
+void fillSequence(Matrix<M, N, T>& m, T start) {
+  for (unsigned int i = 0; i < M * N; i++) m(i) = start + static_cast<T>(i % 7) - static_cast<T>(i % 3) * 2;
+}
+
+template <unsigned int M, unsigned int N, unsigned int K, typename T>
+void checkProduct() {
+  Matrix<M, N, T> a;
+  Matrix<N, K, T> b;
+  fillSequence(a, T(1));
+  fillSequence(b, T(-2));
+  Matrix<M, K, T> r = a * b;
+  for (unsigned int m = 0; m < M; m++) {
+    for (unsigned int k = 0; k < K; k++) {
+      T sum = 0;
+      for (unsigned int n = 0; n < N; n++) sum += a(m, n) * b(n, k);
+      EXPECT_EQ(r(m, k), sum) << "at (" << m << "," << k << ")";
+    }
+  }
+}
+
+}
+
+// Products of sizes which do not fit the vector width
+TEST(mathMatrixKernels, product) {
+  checkProduct<6, 6, 6, double>();
+  checkProduct<6, 6, 1, double>();
+  checkProduct<5, 3, 7, double>();
+  checkProduct<12, 12, 1, double>();
+  checkProduct<1, 4, 1, double>();
+  checkProduct<3, 3, 3, int>();
+}
+
+// Elementwise operations over all elements including the remainder
+TEST(mathMatrixKernels, elementwise) {
+  Matrix<7, 1, double> a, b;
+  fillSequence(a, 3.0);
+  fillSequence(b, 0.5);
+  Matrix<7, 1, double> sum = a + b;
+  Matrix<7, 1, double> diff = a - b;
+  Matrix<7, 1, double> prod = a.multiplyElementWise(b);
+  Matrix<7, 1, double> scaled = 2.0 * a;
+  Matrix<7, 1, double> quot = a / 4.0;
+  Matrix<7, 1, double> neg = -a;
+  for (unsigned int i = 0; i < 7; i++) {
+    EXPECT_EQ(sum(i), a(i) + b(i));
+    EXPECT_EQ(diff(i), a(i) - b(i));
+    EXPECT_EQ(prod(i), a(i) * b(i));
+    EXPECT_EQ(scaled(i), 2.0 * a(i));
+    EXPECT_EQ(quot(i), a(i) / 4.0);
+    EXPECT_EQ(neg(i), -a(i));
+  }
+  a += b;
+  EXPECT_EQ(a, sum);
+  a -= b;
+  a -= b;
+  EXPECT_EQ(a, diff);
+}
+
+// Limits of odd length vectors, NaN passes
+TEST(mathMatrixKernels, clamp) {
+  double a[7] = {-3, -1, 0, 1, 3, std::nan(""), 2};
+  double lo[7] = {-2, -2, -2, -2, -2, -2, 1};
+  double hi[7] = {2, 2, 2, 2, 2, 2, 1.5};
+  double r[7];
+  kernel::clamp(r, a, lo, hi, 7);
+  EXPECT_EQ(r[0], -2);
+  EXPECT_EQ(r[1], -1);
+  EXPECT_EQ(r[2], 0);
+  EXPECT_EQ(r[3], 1);
+  EXPECT_EQ(r[4], 2);
+  EXPECT_TRUE(std::isnan(r[5]));
+  EXPECT_EQ(r[6], 1.5);
+  int ai[3] = {-5, 0, 5}, loi[3] = {-1, -1, -1}, hii[3] = {1, 1, 1}, ri[3];
+  kernel::clamp(ri, ai, loi, hii, 3);
+  EXPECT_EQ(ri[0], -1);
+  EXPECT_EQ(ri[1], 0);
+  EXPECT_EQ(ri[2], 1);
+}
+
+TEST(mathMatrixKernels, limitRate) {
+  double a[5] = {10, -10, 0.05, 1, std::nan("")};
+  double p[5] = {0, 0, 0, 1, 0};
+  double f[5] = {-1, -2, -1, -1, -1};
+  double g[5] = {1, 2, 1, 1, 1};
+  double r[5];
+  kernel::limitRate(r, a, p, -1.0, 2.0, 0.1, 5);
+  EXPECT_DOUBLE_EQ(r[0], 0.2);
+  EXPECT_DOUBLE_EQ(r[1], -0.1);
+  EXPECT_DOUBLE_EQ(r[2], 0.05);
+  EXPECT_DOUBLE_EQ(r[3], 1);
+  EXPECT_TRUE(std::isnan(r[4]));
+  kernel::limitRate(r, a, p, static_cast<const double*>(f), static_cast<const double*>(g), 0.1, 5);
+  EXPECT_DOUBLE_EQ(r[0], 0.1);
+  EXPECT_DOUBLE_EQ(r[1], -0.2);
+  // previous value unknown, the input passes
+  p[0] = std::nan("");
+  kernel::limitRate(r, a, p, -1.0, 1.0, 0.1, 1);
+  EXPECT_EQ(r[0], 10);
+}
+
+TEST(mathMatrixKernels, integrate) {
+  double p[5] = {0, 1, 2, 3, 4};
+  double a[5] = {1, 1, 1, 1, 1};
+  double lo[5] = {-10, -10, -10, -10, -10};
+  double hi[5] = {10, 10, 10, 10, 4.75};
+  double r[5];
+  EXPECT_FALSE(kernel::integrate(r, p, a, 1.0, lo, hi, 5));
+  EXPECT_TRUE(kernel::integrate(r, p, a, 0.5, lo, hi, 5));
+  for (unsigned int i = 0; i < 5; i++) EXPECT_DOUBLE_EQ(r[i], p[i] + 0.5);
+}
+
+TEST(mathMatrixKernels, cubic) {
+  // c0 of all five elements, then c1, c2 and c3
+  double c[20] = {1, 2, 3, 4, 5,  0, 1, -1, 2, 0.5,  0, 0.5, 2, -1, 1,  1, 0, -0.5, 0.25, 3};
+  double r[20];
+  double t = 0.7;
+  kernel::cubic(r, c, t, 5);
+  for (unsigned int i = 0; i < 5; i++) {
+    double c0 = c[i], c1 = c[5 + i], c2 = c[10 + i], c3 = c[15 + i];
+    EXPECT_DOUBLE_EQ(r[i], c0 + c1 * t + c2 * t * t + c3 * t * t * t);
+    EXPECT_DOUBLE_EQ(r[5 + i], c1 + 2 * c2 * t + 3 * c3 * t * t);
+    EXPECT_DOUBLE_EQ(r[10 + i], 2 * c2 + 6 * c3 * t);
+    EXPECT_DOUBLE_EQ(r[15 + i], 6 * c3);
+  }
+}
+
+// The storage is aligned for vector loads
+TEST(mathMatrixKernels, alignment) {
+  Matrix<6, 6> m;
+  Matrix<2, 1> v;
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(m.data()) % 32, 0);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(v.data()) % 16, 0);
+}
+
+TEST(mathMatrixKernels, firstOutside) {
+  double lo[6] = {-1, -1, -1, -1, -1, -1};
+  double hi[6] = {1, 1, 1, 1, 1, 1};
+  double a[6] = {0, 0.5, -0.5, 0.99, -0.99, 0};
+  EXPECT_EQ(kernel::firstOutside(a, lo, hi, 6), 6u);
+  a[4] = -1;
+  a[5] = 2;
+  EXPECT_EQ(kernel::firstOutside(a, lo, hi, 6), 4u);
+  a[1] = std::nan("");
+  EXPECT_EQ(kernel::firstOutside(a, lo, hi, 6), 1u);
+}
+
+TEST(mathMatrixKernels, firstBeyondWithin) {
+  double lo[4] = {-1, -1, -1, -1};
+  double hi[4] = {1, 1, 1, 1};
+  double a[4] = {-1, 1, std::nan(""), 0};
+  EXPECT_EQ(kernel::firstBeyond(a, lo, hi, 4), 4u);
+  EXPECT_EQ(kernel::firstWithin(a, lo, hi, 4), 3u);
+  a[3] = 1.5;
+  EXPECT_EQ(kernel::firstBeyond(a, lo, hi, 4), 3u);
+  EXPECT_EQ(kernel::firstWithin(a, lo, hi, 4), 4u);
+}
@@ -0,0 +1,103 @@
+#include <eeros/math/MatrixBatch.hpp>
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace eeros::math;
+
+namespace {
+
+template < unsigned int K, unsigned int M, unsigned int N >
+MatrixBatch<K, M, N> randomBatch(std::mt19937& gen) {
+  std::uniform_real_distribution<double> dist(-1, 1);
+  MatrixBatch<K, M, N> b;
+  for (unsigned int k = 0; k < K; k++) {
+    for (unsigned int m = 0; m < M; m++) {
+      for (unsigned int n = 0; n < N; n++) b(k, m, n) = dist(gen);
+    }
+  }
+  return b;
+}
+
+template < unsigned int M, unsigned int N >
+void expectNear(const Matrix<M, N>& a, const Matrix<M, N>& b, double tolerance) {
+  for (unsigned int i = 0; i < M * N; i++) EXPECT_NEAR(a(i), b(i), tolerance);
+}
+
+}
+
+TEST(mathMatrixBatch, setGet) {
+  MatrixBatch<6, 3, 3> b;
+  auto r = Matrix<3, 3>::createRotZ(0.5);
+  b.set(4, r);
+  EXPECT_EQ(b.get(4), r);
+  EXPECT_EQ(b(4, 1, 0), r(1, 0));
+  EXPECT_EQ(b.lanes(1, 0)[4], r(1, 0));
+  Matrix<3, 3> zero;
+  zero.zero();
+  EXPECT_EQ(b.get(3), zero);
+  b.eye();
+  Matrix<3, 3> eye;
+  eye.eye();
+  EXPECT_EQ(b.get(5), eye);
+}
+
+TEST(mathMatrixBatch, multiply) {
+  std::mt19937 gen(1);
+  auto a = randomBatch<12, 3, 4>(gen);
+  auto b = randomBatch<12, 4, 2>(gen);
+  MatrixBatch<12, 3, 2> c = a * b;
+  for (unsigned int k = 0; k < 12; k++) expectNear(c.get(k), Matrix<3, 2>(a.get(k) * b.get(k)), 1e-14);
+
+  auto r = Matrix<3, 3>::createRotX(0.3);
+  Matrix<4, 4> t;
+  t.eye();
+  for (unsigned int i = 0; i < 3; i++) {
+    for (unsigned int j = 0; j < 3; j++) t(i, j) = r(i, j);
+  }
+  t(0, 3) = 1.5;
+  auto frames = randomBatch<7, 4, 4>(gen);
+  MatrixBatch<7, 4, 4> moved = frames * t;
+  for (unsigned int k = 0; k < 7; k++) expectNear(moved.get(k), Matrix<4, 4>(frames.get(k) * t), 1e-14);
+}
+
+TEST(mathMatrixBatch, transposeAndArithmetic) {
+  std::mt19937 gen(2);
+  auto a = randomBatch<6, 6, 3>(gen);
+  auto b = randomBatch<6, 6, 3>(gen);
+  MatrixBatch<6, 3, 6> at = a.transpose();
+  MatrixBatch<6, 6, 3> sum = a + b, diff = a - b, scaled = a * 2.0;
+  for (unsigned int k = 0; k < 6; k++) {
+    EXPECT_EQ(at.get(k), a.get(k).transpose());
+    EXPECT_EQ(sum.get(k), (Matrix<6, 3>(a.get(k) + b.get(k))));
+    EXPECT_EQ(diff.get(k), (Matrix<6, 3>(a.get(k) - b.get(k))));
+    EXPECT_EQ(scaled.get(k), (Matrix<6, 3>(a.get(k) * 2.0)));
+  }
+  EXPECT_TRUE(a.transpose().transpose() == a);
+  EXPECT_TRUE(sum != a);
+}
+
+TEST(mathMatrixBatch, inverse) {
+  std::mt19937 gen(3);
+  auto a = randomBatch<9, 6, 6>(gen);
+  // a permutation needs pivoting
+  Matrix<6, 6> p;
+  p.zero();
+  for (unsigned int i = 0; i < 6; i++) p((i + 1) % 6, i) = 1;
+  a.set(2, p);
+  MatrixBatch<9, 6, 6> inv;
+  EXPECT_TRUE(a.inverse(inv));
+  Matrix<6, 6> eye;
+  eye.eye();
+  for (unsigned int k = 0; k < 9; k++) expectNear(Matrix<6, 6>(a.get(k) * inv.get(k)), eye, 1e-10);
+
+  auto b = randomBatch<4, 3, 3>(gen);
+  Matrix<3, 3> singular{1.0, 2.0, 3.0, 2.0, 4.0, 6.0, 0.0, 1.0, 1.0};
+  b.set(1, singular);
+  MatrixBatch<4, 3, 3> binv;
+  EXPECT_FALSE(b.inverse(binv));
+  Matrix<3, 3> zero;
+  zero.zero();
+  EXPECT_EQ(binv.get(1), zero);
+  expectNear(binv.get(0), b.get(0).inverse(), 1e-10);
+  expectNear(binv.get(3), b.get(3).inverse(), 1e-10);
+}
@@ -32,3 +32,21 @@ TEST(mathMatrixOps, inv) {
   EXPECT_TRUE(Utils::compareApprox(0.2, m2(2,1), 0.001));
   EXPECT_TRUE(Utils::compareApprox(-0.8, m2(2,2), 0.001));
 }
+
+TEST(mathMatrixOps, invFloat) {
+  Matrix<2, 2, float> m1{1,2,3,4};
+  Matrix<2, 2, float> i1 = m1.inverse();
+  EXPECT_FLOAT_EQ(i1(0,0), -2);
+  EXPECT_FLOAT_EQ(i1(1,1), -0.5);
+  Matrix<5, 5, float> m2;
+  for (unsigned int m = 0; m < 5; m++) {
+    for (unsigned int n = 0; n < 5; n++) m2(m, n) = 1.0f / (1 + m + n) + (m == n ? 1.0f : 0.0f);
+  }
+  auto i2 = m2.inverse();
+  static_assert(std::is_same_v<decltype(i2), Matrix<5, 5, float>>, "the inverse of a float matrix is a float matrix");
+  Matrix<5, 5, float> e = m2 * i2;
+  for (unsigned int m = 0; m < 5; m++) {
+    for (unsigned int n = 0; n < 5; n++) EXPECT_NEAR(e(m, n), m == n ? 1.0f : 0.0f, 1e-5);
+  }
+  static_assert(std::is_same_v<decltype(Matrix<2, 2, int>().inverse()), Matrix<2, 2, double>>, "integer matrices are inverted in double");
+}
@@ -0,0 +1,107 @@
+#include <eeros/math/StructuredMatrix.hpp>
+#include <gtest/gtest.h>
+
+using namespace eeros;
+using namespace eeros::math;
+
+namespace {
+
+template < unsigned int N, unsigned int K >
+Matrix<N, K> sequence() {
+  Matrix<N, K> m;
+  for (unsigned int i = 0; i < N * K; i++) m(i) = 1.0 + static_cast<double>(i % 5) - static_cast<double>(i % 3) * 0.5;
+  return m;
+}
+
+template < typename S, unsigned int M, unsigned int N, unsigned int K >
+void expectProduct(const S& s, const Matrix<M, N>& dense, const Matrix<N, K>& x) {
+  Matrix<M, K> r = s * x;
+  Matrix<M, K> d = dense * x;
+  for (unsigned int i = 0; i < M * K; i++) EXPECT_DOUBLE_EQ(r(i), d(i)) << "at " << i;
+}
+
+}
+
+TEST(mathStructuredMatrix, diagonal) {
+  DiagonalMatrix<4> d(Matrix<4, 1>{1, -2, 3, 0.5});
+  Matrix<4, 4> dense = d.toMatrix();
+  EXPECT_DOUBLE_EQ(d(1, 1), -2);
+  EXPECT_DOUBLE_EQ(d(1, 2), 0);
+  EXPECT_DOUBLE_EQ(dense(3, 3), 0.5);
+  EXPECT_DOUBLE_EQ(dense(0, 3), 0);
+  expectProduct(d, dense, sequence<4, 1>());
+  expectProduct(d, dense, sequence<4, 3>());
+}
+
+TEST(mathStructuredMatrix, blockDiagonal) {
+  BlockDiagonalMatrix<2, 3> b{Matrix<2, 2>{1, 2, 3, 4}, Matrix<2, 2>{-1, 0.5, 2, 0}, Matrix<2, 2>{5, 6, 7, 8}};
+  Matrix<6, 6> dense = b.toMatrix();
+  EXPECT_DOUBLE_EQ(b(2, 2), -1);
+  EXPECT_DOUBLE_EQ(b(3, 2), 0.5);
+  EXPECT_DOUBLE_EQ(b(2, 4), 0);
+  EXPECT_DOUBLE_EQ(dense(5, 5), 8);
+  EXPECT_DOUBLE_EQ(dense(1, 2), 0);
+  EXPECT_EQ(b.getBlock(1), (Matrix<2, 2>{-1, 0.5, 2, 0}));
+  expectProduct(b, dense, sequence<6, 1>());
+  expectProduct(b, dense, sequence<6, 2>());
+  EXPECT_THROW((BlockDiagonalMatrix<2, 3>{Matrix<2, 2>{1, 2, 3, 4}}), Fault);
+}
+
+TEST(mathStructuredMatrix, sparse) {
+  Matrix<3, 4> dense;
+  dense.zero();
+  dense(0, 1) = 2;
+  dense(1, 0) = -1;
+  dense(1, 3) = 4;
+  dense(2, 2) = 0.5;
+  SparseMatrix<3, 4, 6> s(dense);
+  EXPECT_EQ(s.getNofNonZeros(), 4u);
+  EXPECT_DOUBLE_EQ(s(1, 3), 4);
+  EXPECT_DOUBLE_EQ(s(1, 2), 0);
+  EXPECT_EQ(s.toMatrix(), dense);
+  expectProduct(s, dense, sequence<4, 1>());
+  expectProduct(s, dense, sequence<4, 3>());
+
+  // elements in any order, explicit zeros are stored
+  SparseMatrix<3, 4, 6> e{{2, 2, 0.5}, {1, 3, 4}, {0, 1, 2}, {1, 0, -1}, {0, 3, 0}};
+  EXPECT_EQ(e.getNofNonZeros(), 5u);
+  EXPECT_EQ(e.toMatrix(), dense);
+
+  EXPECT_THROW((SparseMatrix<3, 4, 3>(dense)), Fault);
+  EXPECT_THROW((SparseMatrix<3, 4, 6>{{3, 0, 1}}), Fault);
+  EXPECT_THROW((SparseMatrix<3, 4, 6>{{0, 0, 1}, {0, 0, 2}}), Fault);
+}
+
+// operators work on the stored elements, missing elements of the right operand are 0
+TEST(mathStructuredMatrix, operators) {
+  DiagonalMatrix<3> a(1.0), b(2.0);
+  EXPECT_TRUE(a < b);
+  EXPECT_TRUE(a <= b);
+  EXPECT_FALSE(a > b);
+  a += b;
+  EXPECT_DOUBLE_EQ(a(2), 3);
+  EXPECT_TRUE(a >= b);
+  a -= b;
+  a -= b;
+  EXPECT_DOUBLE_EQ(a(0), -1);
+
+  BlockDiagonalMatrix<2, 2> c(1.0), d(0.5);
+  c -= d;
+  EXPECT_DOUBLE_EQ(c(1, 0), 0.5);
+  EXPECT_DOUBLE_EQ(c(0, 3), 0);
+  EXPECT_TRUE(c <= d);
+  EXPECT_FALSE(c < d);
+
+  SparseMatrix<2, 3> s{{0, 0, 1}, {1, 2, 2}};
+  SparseMatrix<2, 3> t{{0, 0, 2}, {1, 1, 7}, {1, 2, 3}};
+  EXPECT_TRUE(s < t);
+  EXPECT_FALSE(t < s);
+  s += t;
+  EXPECT_EQ(s.getNofNonZeros(), 2u);
+  EXPECT_DOUBLE_EQ(s(0, 0), 3);
+  EXPECT_DOUBLE_EQ(s(1, 1), 0);
+  EXPECT_DOUBLE_EQ(s(1, 2), 5);
+  s = 4;
+  EXPECT_DOUBLE_EQ(s(0, 0), 4);
+  EXPECT_DOUBLE_EQ(s(0, 1), 0);
+}
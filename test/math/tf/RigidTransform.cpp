@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <eeros/math/tf/TF_RigidTransform.hpp>
+#include <cmath>
+
+using namespace eeros::math;
+using namespace eeros::math::tf;
+
+namespace {
+
+TF_Matrix makeTF(double x, double y, double z, double roll, double pitch, double yaw) {
+  TF_Matrix tf;
+  tf.setTrans(Vector3(x, y, z));
+  tf.setRPY(roll, pitch, yaw);
+  return tf;
+}
+
+void expectNear(const Matrix<4, 4, double>& a, const Matrix<4, 4, double>& b) {
+  for (unsigned int i = 0; i < 16; i++) EXPECT_NEAR(a(i), b(i), 1e-12);
+}
+
+}
+
+TEST(TF_RigidTransformTest, composeEqualsMatrixProduct) {
+  TF_Matrix a = makeTF(1.0, 2.0, 3.0, 0.1, -0.2, 0.3);
+  TF_Matrix b = makeTF(-0.5, 0.4, 0.2, 0.7, 0.1, -1.2);
+  TF_RigidTransform c = TF_RigidTransform(a) * TF_RigidTransform(b);
+  expectNear(c.getTF().getMatrix(), a.getMatrix() * b.getMatrix());
+  Vector3 p(0.3, -0.1, 2.0);
+  Matrix<4, 1, double> ph{p(0), p(1), p(2), 1.0};
+  Matrix<4, 1, double> q = a.getMatrix() * ph;
+  Vector3 r = TF_RigidTransform(a) * p;
+  for (int i = 0; i < 3; i++) EXPECT_NEAR(r(i), q(i), 1e-12);
+}
+
+TEST(TF_RigidTransformTest, inverse) {
+  TF_Matrix a = makeTF(1.0, 2.0, 3.0, 0.1, -0.2, 0.3);
+  TF_RigidTransform r(a);
+  expectNear(r.inverse().getTF().getMatrix(), a.inverse());
+  expectNear((r * r.inverse()).getTF().getMatrix(), TF_Matrix().getMatrix());
+}
+
+TEST(TF_RigidTransformTest, isRigid) {
+  EXPECT_TRUE(TF_RigidTransform::isRigid(makeTF(1.0, 2.0, 3.0, 0.1, -0.2, 0.3)));
+  TF_Matrix scaled;
+  scaled(0, 0) = 2.0;
+  EXPECT_FALSE(TF_RigidTransform::isRigid(scaled));
+  TF_Matrix projective;
+  projective(3, 0) = 0.1;
+  EXPECT_FALSE(TF_RigidTransform::isRigid(projective));
+}
+
+TEST(TF_RigidTransformTest, orthonormalize) {
+  TF_RigidTransform step(makeTF(0.0, 0.0, 0.0, 0.001, 0.002, 0.003));
+  TF_RigidTransform r;
+  for (int i = 0; i < 10000; i++) r = step * r;
+  r.orthonormalize();
+  EXPECT_TRUE(TF_RigidTransform::isRigid(r.getTF().getMatrix(), 1e-14));
+}
+
+TEST(TF_RigidTransformTest, transformPoints) {
+  TF_RigidTransform r(makeTF(1.0, 2.0, 3.0, 0.1, -0.2, 0.3));
+  constexpr int n = 11;  // not a multiple of the vector width
+  double x[n], y[n], z[n], xo[n], yo[n], zo[n];
+  for (int i = 0; i < n; i++) {
+    x[i] = 0.1 * i;
+    y[i] = -0.3 * i + 1.0;
+    z[i] = std::sin(i);
+  }
+  r.transform(x, y, z, xo, yo, zo, n);
+  for (int i = 0; i < n; i++) {
+    Vector3 p = r * Vector3(x[i], y[i], z[i]);
+    EXPECT_NEAR(xo[i], p(0), 1e-12);
+    EXPECT_NEAR(yo[i], p(1), 1e-12);
+    EXPECT_NEAR(zo[i], p(2), 1e-12);
+  }
+  r.transform(x, y, z, x, y, z, n);  // in place
+  for (int i = 0; i < n; i++) {
+    EXPECT_NEAR(x[i], xo[i], 1e-12);
+    EXPECT_NEAR(z[i], zo[i], 1e-12);
+  }
+}
@@ -139,3 +139,43 @@ TEST(TF_TreeTest, init2) {
             std::string("[ [0.978031 0.20846 0 0]' [-0.20846 0.978031 0 0]' [0 "
             "0 1 0]' [0.06 -0.02 0.1 1]' ]"));
 }
+
+TEST(TF_TreeTest, cachedQueries) {
+  TF_Tree& tfTree = TF_Tree::instance();
+  tfTree.addTF("cacheBase", "global", Vector3(1.0, 0.0, 0.0));
+  tfTree.addTF("cacheA", "cacheBase", Vector3(0.0, 2.0, 0.0));
+  tfTree.addTF("cacheB", "cacheBase", Vector3(0.0, 0.0, 3.0));
+  int a = tfTree.getId("cacheA");
+  int b = tfTree.getId("cacheB");
+  TF_Matrix tf1 = tfTree.tfFrameToOrigin("cacheA", "cacheB");
+  EXPECT_EQ(tf1.getTrans(), Vector3(0.0, -2.0, 3.0));
+  EXPECT_EQ(tfTree.tfFrameToOrigin(a, b).getMatrix(), tf1.getMatrix());
+
+  // changes of the common parent do not change the result
+  tfTree.getTF("cacheBase").setTrans(Vector3(5.0, 5.0, 5.0));
+  EXPECT_EQ(tfTree.tfFrameToOrigin(a, b).getMatrix(), tf1.getMatrix());
+
+  // changes on the path are detected, also if written element by element
+  tfTree.getTF("cacheB")(2, 3) = 4.0;
+  EXPECT_EQ(tfTree.tfFrameToOrigin(a, b).getTrans(), Vector3(0.0, -2.0, 4.0));
+  tfTree.getTF("cacheA").setTrans(Vector3(0.0, 1.0, 0.0));
+  EXPECT_EQ(tfTree.tfFrameToOrigin(a, b).getTrans(), Vector3(0.0, -1.0, 4.0));
+  EXPECT_EQ(tfTree.tfFrameToOrigin(b, a).getTrans(), Vector3(0.0, 1.0, -4.0));
+  EXPECT_THROW(tfTree.tfFrameToOrigin(a, 1000), TF_NotFoundException);
+}
+
+TEST(TF_TreeTest, transformPoints) {
+  TF_Tree& tfTree = TF_Tree::instance();
+  tfTree.addTF("scanner", "global", Vector3(0.5, 0.0, 0.2), Vector3(0.0, 0.0, M_PI / 2));
+  int scanner = tfTree.getId("scanner");
+  double x[3] = {1.0, 2.0, 0.0}, y[3] = {0.0, 0.0, 1.0}, z[3] = {0.0, 0.0, 0.0};
+  double xo[3], yo[3], zo[3];
+  tfTree.transformPoints(tfTree.getId("global"), scanner, x, y, z, xo, yo, zo, 3);
+  EXPECT_NEAR(xo[0], 0.5, 1e-12);
+  EXPECT_NEAR(yo[0], 1.0, 1e-12);
+  EXPECT_NEAR(xo[1], 0.5, 1e-12);
+  EXPECT_NEAR(yo[1], 2.0, 1e-12);
+  EXPECT_NEAR(xo[2], -0.5, 1e-12);
+  EXPECT_NEAR(yo[2], 0.0, 1e-12);
+  EXPECT_NEAR(zo[2], 0.2, 1e-12);
+}
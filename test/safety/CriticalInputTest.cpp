@@ -4,10 +4,12 @@
 #include <eeros/control/PeripheralOutput.hpp>
 #include <eeros/control/PeripheralInput.hpp>
 #include <eeros/control/Constant.hpp>
+#include <eeros/core/Executor.hpp>
 #include <eeros/core/Fault.hpp>
 #include <eeros/hal/HAL.hpp>
 #include <gtest/gtest.h>
 #include <Utils.hpp>
+#include <thread>
 
 using namespace eeros;
 using namespace eeros::safety;
@@ -282,3 +284,220 @@ TEST(safetyCriticalTest, analogInputOffRange) {
   HAL::instance().releaseInput("aIn0");
   HAL::instance().releaseInput("aIn1");
 }
+
+namespace {
+
+class GroupInputStub : public hal::Input<double> {
+ public:
+  GroupInputStub(std::string id) : hal::Input<double>(id, nullptr) { }
+  double get() override { return value; }
+  double value = 0;
+};
+
+class SafetyPropertiesTestc4 : public SafetyProperties {
+ public:
+  SafetyPropertiesTestc4()
+      : se1("se1"), se2("se2"), sl1("1"), sl2("2"), in0("in0"), in1("in1"), in2("in2") {
+    addLevel(sl1);
+    addLevel(sl2);
+    sl1.addEvent(se1, sl2, kPublicEvent);
+    sl2.addEvent(se2, sl1, kPublicEvent);
+    criticalInputs = { &in0, &in1, &in2 };
+    std::array<hal::Input<double>*, 3> inputs = {&in0, &in1, &in2};
+    sl1.setInputActions({ range(inputs, {-1.0, -2.0, -3.0}, {1.0, 2.0, 3.0}, se1) });
+    sl2.setInputActions({ range(inputs, {-1.0, -2.0, -3.0}, {1.0, 2.0, 3.0}, se2, true) });
+    setEntryLevel(sl1);
+  }
+
+  SafetyEvent se1, se2;
+  SafetyLevel sl1, sl2;
+  GroupInputStub in0, in1, in2;
+};
+
+}
+
+// test a group of critical inputs checked by one input action
+TEST(safetyCriticalTest, inputGroup) {
+  std::cout.setstate(std::ios_base::badbit);
+  logger::Logger::setDefaultStreamLogger(std::cout);
+  SafetyPropertiesTestc4 sp;
+  SafetySystem ss(sp, 1);
+  ss.run();
+  ss.run();
+  EXPECT_TRUE(ss.getCurrentLevel() == sp.sl1);
+  sp.in2.value = 3.0;	// limits are inclusive
+  ss.run();
+  ss.run();
+  EXPECT_TRUE(ss.getCurrentLevel() == sp.sl1);
+  sp.in1.value = 2.5;
+  ss.run();
+  sp.in0.value = 5; sp.in1.value = 5; sp.in2.value = 5;	// none within
+  ss.run();
+  ss.run();
+  EXPECT_TRUE(ss.getCurrentLevel() == sp.sl2);
+  sp.in0.value = 0.5; sp.in1.value = 0; sp.in2.value = 0;
+  ss.run();
+  ss.run();
+  ss.run();
+  EXPECT_TRUE(ss.getCurrentLevel() == sp.sl1);
+}
+
+namespace {
+
+class BatchStub : public hal::OutputBatch {
+ public:
+  void commit() override { commits++; }
+  int commits = 0;
+};
+
+class BatchOutputStub : public hal::Output<bool> {
+ public:
+  BatchOutputStub(std::string id, BatchStub& batch) : hal::Output<bool>(id, nullptr), batch(batch) { }
+  bool get() override { return value; }
+  void set(bool v) override { value = v; writes++; }
+  hal::OutputBatch* getBatch() override { return &batch; }
+  bool value = false;
+  int writes = 0;
+  BatchStub& batch;
+};
+
+class SafetyPropertiesTestc5 : public SafetyProperties {
+ public:
+  SafetyPropertiesTestc5()
+      : se1("se1"), sl1("1"), sl2("2"), out0("out0", batch), out1("out1", batch) {
+    addLevel(sl1);
+    addLevel(sl2);
+    sl1.addEvent(se1, sl2, kPublicEvent);
+    criticalOutputs = { &out0, &out1 };
+    sl1.setOutputActions({ set(&out0, true), set(&out1, false) });
+    sl2.setOutputActions({ set(&out0, false), toggle(&out1) });
+    setEntryLevel(sl1);
+  }
+
+  SafetyEvent se1;
+  SafetyLevel sl1, sl2;
+  BatchStub batch;
+  BatchOutputStub out0, out1;
+};
+
+}
+
+// test output actions of one batch, unchanged values are not written
+TEST(safetyCriticalTest, outputBatch) {
+  std::cout.setstate(std::ios_base::badbit);
+  logger::Logger::setDefaultStreamLogger(std::cout);
+  SafetyPropertiesTestc5 sp;
+  SafetySystem ss(sp, 1);
+  ss.run();
+  EXPECT_TRUE(sp.out0.value);
+  EXPECT_EQ(sp.out0.writes, 1);
+  EXPECT_EQ(sp.out1.writes, 0);
+  EXPECT_EQ(sp.batch.commits, 1);
+  ss.run();
+  ss.run();
+  EXPECT_EQ(sp.out0.writes, 1);
+  EXPECT_EQ(sp.batch.commits, 3);
+  ss.triggerEvent(sp.se1);
+  ss.run();
+  EXPECT_FALSE(sp.out0.value);
+  EXPECT_EQ(sp.out0.writes, 2);
+  EXPECT_EQ(sp.out1.writes, 1);
+  ss.run();
+  EXPECT_TRUE(sp.out1.value);
+  EXPECT_EQ(sp.out1.writes, 2);
+  EXPECT_EQ(sp.batch.commits, 5);
+}
+
+namespace {
+
+class StubInput : public hal::Input<bool> {
+ public:
+  StubInput(std::string id) : hal::Input<bool>(id, nullptr) { }
+  bool get() override { reads++; return value; }
+  bool value = false;
+  int reads = 0;
+};
+
+class StubOutput : public hal::Output<bool> {
+ public:
+  StubOutput(std::string id) : hal::Output<bool>(id, nullptr) { }
+  bool get() override { return value; }
+  void set(bool v) override { value = v; }
+  bool value = false;
+};
+
+class FastPathProperties : public SafetyProperties {
+ public:
+  FastPathProperties() : seStop("stop"), seGo("go"), slStop("stop"), slRun("run"), estop("estop"), enable("enable"), light("light") {
+    addLevel(slStop);
+    addLevel(slRun);
+    slRun.addEvent(seStop, slStop, kPrivateEvent);
+    slStop.addEvent(seGo, slRun, kPublicEvent);
+    criticalInputs = { &estop };
+    criticalOutputs = { &enable };
+    slStop.setInputActions({ ignore(estop) });
+    slRun.setInputActions({ check(estop, false, seStop) });
+    slStop.setOutputActions({ set(&enable, false), set(&light, false) });
+    slRun.setOutputActions({ set(&enable, true), set(&light, true) });
+    setEntryLevel(slRun);
+  }
+
+  SafetyEvent seStop, seGo;
+  SafetyLevel slStop, slRun;
+  StubInput estop;
+  StubOutput enable, light;
+};
+
+}
+
+// On the fast path, critical inputs are checked apart from run() and the critical outputs follow at once
+TEST(safetyCriticalTest, fastPath) {
+  logger::Logger::setDefaultStreamLogger(std::cout);
+  FastPathProperties sp;
+  SafetySystem ss(sp, 0.01);
+  ss.run();
+  EXPECT_TRUE(ss.getCurrentLevel() == sp.slRun);
+  EXPECT_TRUE(sp.enable.value);
+  ss.setCriticalFastPath(true);
+  EXPECT_TRUE(ss.hasCriticalFastPath());
+  int reads = sp.estop.reads;
+  ss.run();
+  EXPECT_EQ(sp.estop.reads, reads);   // left to checkCriticalInputs()
+  EXPECT_FALSE(ss.checkCriticalInputs());
+  sp.estop.value = true;
+  EXPECT_TRUE(ss.checkCriticalInputs());
+  EXPECT_FALSE(sp.enable.value);      // critical output of the destination level
+  EXPECT_TRUE(sp.light.value);        // other outputs wait for the transition
+  EXPECT_TRUE(ss.getCurrentLevel() == sp.slRun);
+  ss.run();
+  EXPECT_TRUE(ss.getCurrentLevel() == sp.slStop);
+  EXPECT_FALSE(sp.enable.value);
+  EXPECT_FALSE(sp.light.value);
+}
+
+// The executor checks the critical inputs in every base cycle, also when the safety system runs slower
+TEST(safetyCriticalTest, executorBaseRate) {
+  logger::Logger::setDefaultStreamLogger(std::cout);
+  FastPathProperties sp;
+  SafetySystem ss(sp, 0.01);
+  Executor executor;
+  task::Periodic periodic("safety system", 0.01, ss, true);
+  executor.setExecutorPeriod(0.001);
+  executor.add(periodic);
+  executor.setTimingMode(Executor::TimingMode::lockstep);
+  executor.setHalUpdate(false);
+  std::thread t([&]() { executor.run(); });
+  EXPECT_TRUE(executor.step(10));
+  EXPECT_TRUE(ss.getCurrentLevel() == sp.slRun);
+  EXPECT_TRUE(sp.enable.value);
+  EXPECT_TRUE(ss.hasCriticalFastPath());
+  sp.estop.value = true;
+  EXPECT_TRUE(executor.step(1));
+  EXPECT_FALSE(sp.enable.value);
+  EXPECT_TRUE(ss.getCurrentLevel() == sp.slRun);
+  EXPECT_TRUE(executor.step(9));
+  EXPECT_TRUE(ss.getCurrentLevel() == sp.slStop);
+  executor.shutdown();
+  t.join();
+  EXPECT_FALSE(ss.hasCriticalFastPath());
+}
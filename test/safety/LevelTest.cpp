@@ -1,5 +1,7 @@
 #include <eeros/safety/SafetySystem.hpp>
 #include <eeros/core/Fault.hpp>
+#include <cstdio>
+#include <fstream>
 #include <gtest/gtest.h>
 
 using namespace eeros;
@@ -320,3 +322,91 @@ TEST(safetyLevelTest, trigger2) {
 }
 
 
+
+// Test event dispatch through the compiled transition table
+TEST(safetyLevelTest, compiledTransitions) {
+  SafetyPropertiesTest1 sp;
+  SafetyEvent unknown("unknown");
+  EXPECT_TRUE(sp.sl1.getDestLevelForEvent(sp.se2) == &sp.sl4);
+  EXPECT_TRUE(sp.verify());
+  EXPECT_TRUE(sp.sl1.getDestLevelForEvent(sp.se1) == &sp.sl2);
+  EXPECT_TRUE(sp.sl1.getDestLevelForEvent(sp.se2) == &sp.sl4);
+  EXPECT_TRUE(sp.sl1.getDestLevelForEvent(sp.se3) == nullptr);
+  EXPECT_TRUE(sp.sl4.getDestLevelForEvent(sp.se1) == &sp.sl2);
+  EXPECT_TRUE(sp.sl5.getDestLevelForEvent(sp.se3) == &sp.sl1);
+  EXPECT_TRUE(sp.sl5.getDestLevelForEvent(unknown) == nullptr);
+  sp.sl1.addEvent(sp.se3, sp.sl3, kPrivateEvent);
+  EXPECT_TRUE(sp.sl1.getDestLevelForEvent(sp.se3) == nullptr);	// private
+  EXPECT_TRUE(sp.sl1.getDestLevelForEvent(sp.se3, true) == &sp.sl3);
+  EXPECT_TRUE(sp.verify());
+  EXPECT_TRUE(sp.sl1.getDestLevelForEvent(sp.se3, true) == &sp.sl3);
+  EXPECT_TRUE(sp.sl1.getDestLevelForEvent(sp.se2) == &sp.sl4);
+}
+
+// Test deferred logging of triggered events
+TEST(safetyLevelTest, eventLog) {
+  static std::stringstream out;
+  logger::Logger::setDefaultStreamLogger(out);
+  {
+    SafetyPropertiesTest1 sp;
+    SafetySystem ss(sp, 1);
+    ss.run();
+    ss.triggerEvent(sp.se1);	// go sl2
+    ss.run();
+    ss.triggerEvent(sp.se2);	// no transition
+    EXPECT_EQ(ss.getLostEventRecords(), 0);
+  }	// the logger thread writes the remaining records when stopping
+  std::string log = out.str();
+  EXPECT_NE(log.find("triggering event 'se1' in level '1': transition to safety level: '2'"), std::string::npos);
+  EXPECT_NE(log.find("triggering event 'se2' in level '2': no transition for this event"), std::string::npos);
+  std::cout.setstate(std::ios_base::badbit);
+  logger::Logger::setDefaultStreamLogger(std::cout);
+}
+
+// Test the lateness event of the safety system
+TEST(safetyLevelTest, lateness) {
+  std::cout.setstate(std::ios_base::badbit);
+  logger::Logger::setDefaultStreamLogger(std::cout);
+  SafetyPropertiesTest1 sp;
+  SafetySystem ss(sp, 0.001);
+  ss.setLatenessEvent(sp.se2, 0.0015, 3);	// sl1 -> sl4
+  EXPECT_TRUE(ss.hasLatenessEvent());
+  auto monitor = ss.getTimingMonitor();
+  PeriodicCounter counter(0.001);
+  ss.run();
+  for (double period : {0.002, 0.002, 0.001, 0.002, 0.002}) {
+    counter.period.add(period);
+    monitor(counter, ss.log);
+  }
+  ss.run();
+  EXPECT_TRUE(ss.getCurrentLevel() == sp.sl1);
+  counter.period.add(0.002);
+  monitor(counter, ss.log);
+  ss.run();
+  EXPECT_TRUE(ss.getCurrentLevel() == sp.sl4);
+}
+
+// Test the audit ring of the safety system
+TEST(safetyLevelTest, audit) {
+  std::cout.setstate(std::ios_base::badbit);
+  logger::Logger::setDefaultStreamLogger(std::cout);
+  SafetyPropertiesTest1 sp;
+  SafetySystem ss(sp, 1);
+  sp.sl2.setEntryAction([](SafetyContext*) { });
+  ss.run();
+  ss.triggerEvent(sp.se1);	// go sl2
+  ss.run();
+  ss.triggerEvent(sp.se2);	// no transition
+  std::string path = "/tmp/eerosSafetyAudit.txt";
+  ASSERT_TRUE(ss.dumpAudit(path));
+  std::ifstream file(path);
+  std::vector<std::string> lines;
+  for (std::string line; std::getline(file, line);) lines.push_back(line.substr(line.find(' ') + 1));
+  std::remove(path.c_str());
+  ASSERT_EQ(lines.size(), 5);
+  EXPECT_EQ(lines[0], "transition '-' -> '1'");
+  EXPECT_EQ(lines[1], "event 'se1' in level '1' -> '2'");
+  EXPECT_EQ(lines[2], "transition '1' -> '2'");
+  EXPECT_EQ(lines[3], "onEntry '2'");
+  EXPECT_EQ(lines[4], "event 'se2' in level '2' -> '-'");
+}
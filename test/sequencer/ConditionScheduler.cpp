@@ -0,0 +1,66 @@
+#include <eeros/sequencer/ConditionScheduler.hpp>
+#include <eeros/sequencer/Monitor.hpp>
+#include <eeros/core/Fault.hpp>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+namespace conditionSchedulerTest {
+using namespace eeros::sequencer;
+
+class Counting : public Condition {
+ public:
+  bool validate() {count++; return value;}
+  int count = 0;
+  bool value = false;
+};
+
+class TestMonitor : public Monitor {
+ public:
+  TestMonitor(Condition& c) : Monitor("monitor", nullptr, c) { }
+  bool check() {return checkCondition();}
+};
+
+TEST(seqConditionSchedulerTest, validatesOncePerTick) {
+  Counting cond;
+  std::vector<std::unique_ptr<TestMonitor>> monitors;
+  for (int i = 0; i < 20; i++) monitors.push_back(std::make_unique<TestMonitor>(cond));
+  ConditionScheduler scheduler;
+  scheduler.add(cond);
+  scheduler.add(cond);
+  EXPECT_EQ(scheduler.size(), 1);
+  EXPECT_EQ(cond.count, 1);
+  for (auto& m : monitors) EXPECT_FALSE(m->check());
+  EXPECT_EQ(cond.count, 1);
+  cond.value = true;
+  scheduler.run();
+  EXPECT_EQ(cond.count, 2);
+  for (auto& m : monitors) EXPECT_TRUE(m->check());
+  EXPECT_EQ(cond.count, 2);
+  EXPECT_EQ(scheduler.getNofValidations(), 2);
+}
+
+TEST(seqConditionSchedulerTest, removedConditionIsValidatedDirectly) {
+  Counting cond;
+  TestMonitor m(cond);
+  {
+    ConditionScheduler scheduler;
+    scheduler.add(cond);
+    scheduler.remove(cond);
+    EXPECT_EQ(scheduler.size(), 0);
+    m.check();
+    EXPECT_EQ(cond.count, 2);
+    scheduler.add(cond);
+  }
+  m.check();  // the destroyed scheduler released the condition
+  EXPECT_EQ(cond.count, 4);
+}
+
+TEST(seqConditionSchedulerTest, conditionBelongsToOneScheduler) {
+  Counting cond;
+  ConditionScheduler s1, s2;
+  s1.add(cond);
+  EXPECT_THROW(s2.add(cond), eeros::Fault);
+}
+
+}
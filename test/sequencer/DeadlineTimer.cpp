@@ -0,0 +1,53 @@
+#include <eeros/sequencer/DeadlineTimer.hpp>
+#include <eeros/sequencer/ConditionTimeout.hpp>
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace deadlineTimerTest {
+using namespace eeros::sequencer;
+using Clock = DeadlineTimer::Clock;
+
+// Waits until the timer has sent more than n notifications
+static Clock::time_point waitForNotification(uint64_t n) {
+  auto& timer = DeadlineTimer::instance();
+  for (int i = 0; i < 1000 && timer.getNofNotifications() <= n; i++) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  return Clock::now();
+}
+
+TEST(seqDeadlineTimerTest, notifiesOnceAtDeadline) {
+  auto& timer = DeadlineTimer::instance();
+  uint64_t n = timer.getNofNotifications();
+  auto deadline = Clock::now() + std::chrono::milliseconds(30);
+  timer.schedule(deadline);
+  timer.schedule(deadline);
+  EXPECT_EQ(timer.size(), 1);
+  EXPECT_GE(waitForNotification(n), deadline);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(timer.getNofNotifications(), n + 1);
+  EXPECT_EQ(timer.size(), 0);
+}
+
+TEST(seqDeadlineTimerTest, earlierDeadlineIsServedFirst) {
+  auto& timer = DeadlineTimer::instance();
+  uint64_t n = timer.getNofNotifications();
+  timer.schedule(10.0);
+  auto start = Clock::now();
+  timer.schedule(0.02);
+  waitForNotification(n);
+  EXPECT_LT(Clock::now() - start, std::chrono::seconds(1));
+  EXPECT_EQ(timer.size(), 1);
+}
+
+TEST(seqDeadlineTimerTest, timeoutBecomesTrue) {
+  auto& timer = DeadlineTimer::instance();
+  ConditionTimeout timeout;
+  EXPECT_FALSE(timeout.validate());
+  timeout.setTimeoutTime(0.02);
+  uint64_t n = timer.getNofNotifications();
+  timeout.resetTimeout();
+  EXPECT_FALSE(timeout.validate());
+  waitForNotification(n);
+  EXPECT_TRUE(timeout.validate());
+}
+
+}
@@ -97,6 +97,8 @@ TEST(seqTest1, list) {
  
   EXPECT_EQ(sequencer.getSequenceById(0), &mainSeq);
   EXPECT_EQ(sequencer.getSequenceById(1), &mainSeq1);
+  EXPECT_EQ(sequencer.getSequenceById(2), nullptr);
+  EXPECT_EQ(sequencer.getSequenceById(-1), nullptr);
 }
 
 // Test waiting
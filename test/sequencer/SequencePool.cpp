@@ -0,0 +1,116 @@
+#include <eeros/logger/StreamLogWriter.hpp>
+#include <eeros/sequencer/Sequencer.hpp>
+#include <eeros/sequencer/Sequence.hpp>
+#include <eeros/sequencer/SequencePool.hpp>
+#include <eeros/sequencer/Wait.hpp>
+#include <eeros/core/Fault.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace seqPoolTest {
+using namespace eeros::sequencer;
+
+std::mutex mtx;
+std::set<std::thread::id> threads;
+
+class Child : public Sequence {
+ public:
+  Child(std::string name, BaseSequence* caller, int value) : Sequence(name, caller, false), w("wait", this), value(value) { }
+  int action() {
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      threads.insert(std::this_thread::get_id());
+    }
+    w(0.02);
+    return value;
+  }
+  Wait w;
+  int value;
+};
+
+class Parent : public Sequence {
+ public:
+  Parent(std::string name, Sequencer& seq, int n) : Sequence(name, seq) {
+    for (int i = 0; i < n; i++) children.push_back(std::make_unique<Child>("child " + std::to_string(i), this, i));
+  }
+  int action() {
+    for (auto& c : children) (*c)();
+    sum = 0;
+    for (auto& c : children) {
+      c->wait();
+      sum += c->getResult();
+    }
+    return sum;
+  }
+  std::vector<std::unique_ptr<Child>> children;
+  int sum = -1;
+};
+
+class Flag : public Condition {
+ public:
+  bool validate() {return set;}
+  std::atomic<bool> set{false};
+};
+
+class Waiting : public Sequence {
+ public:
+  Waiting(std::string name, Sequencer& seq) : Sequence(name, seq) {setPollingTime(10000);}
+  int action() {return 0;}
+  bool checkExitCondition() {return flag.validate();}
+  Flag flag;
+};
+
+class Throwing : public Sequence {
+ public:
+  Throwing(std::string name, Sequencer& seq) : Sequence(name, seq) { }
+  int action() {throw eeros::Fault("failed");}
+};
+
+TEST(seqPoolTest, runsManySequencesOnFewThreads) {
+  eeros::logger::Logger::setDefaultStreamLogger(std::cout);
+  auto& sequencer = Sequencer::instance();
+  sequencer.clearList();
+  sequencer.useThreadPool(2);
+  threads.clear();
+  Parent parent("parent", sequencer, 100);
+  auto start = std::chrono::steady_clock::now();
+  parent();
+  sequencer.wait();
+  EXPECT_EQ(parent.sum, 99 * 100 / 2);
+  EXPECT_LE(threads.size(), 2);
+  // the children wait concurrently
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+  sequencer.useThreadPool(0);
+}
+
+TEST(seqPoolTest, notifyWakesWaitingSequence) {
+  auto& sequencer = Sequencer::instance();
+  sequencer.clearList();
+  sequencer.useThreadPool(1);
+  Waiting seq("waiting", sequencer);
+  seq();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  auto start = std::chrono::steady_clock::now();
+  seq.flag.set = true;
+  Condition::notify();
+  seq.wait();
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+  sequencer.useThreadPool(0);
+}
+
+TEST(seqPoolTest, propagatesException) {
+  auto& sequencer = Sequencer::instance();
+  sequencer.clearList();
+  sequencer.useThreadPool(1);
+  Throwing seq("throwing", sequencer);
+  seq();
+  EXPECT_THROW(seq.wait(), eeros::Fault);
+  sequencer.useThreadPool(0);
+}
+
+}
@@ -0,0 +1,69 @@
+#include <eeros/sockets/ClientConnection.hpp>
+#include <eeros/sockets/ServerConnections.hpp>
+#include <eeros/sockets/SocketOptions.hpp>
+#include <eeros/logger/Logger.hpp>
+#include <gtest/gtest.h>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+using namespace eeros::sockets;
+using namespace eeros::logger;
+
+namespace {
+
+template < typename F >
+void pollUntil(ServerConnections& s, ClientConnection& c, F done, std::function<void(const uint8_t*)> onServer, 
+               std::function<void(const uint8_t*)> onClient) {
+  for (int i = 0; i < 200 && !done(); i++) {
+    s.poll(onServer);
+    c.poll(onClient);
+  }
+}
+
+}
+
+TEST(socketClientConnectionTest, exchangesFrames) {
+  Logger::setDefaultStreamLogger(std::cout);
+  ServerConnections s(0, 4, 0.002, 1.0);
+  ClientConnection c("127.0.0.1", s.getPort(), 4, 0.002, 1.0);
+  for (int i = 0; i < 100 && !c.connect(); i++) s.poll([](const uint8_t*) { });
+  ASSERT_TRUE(c.isConnected());
+  
+  std::string atServer, atClient;
+  auto onServer = [&](const uint8_t* f) { atServer.assign(reinterpret_cast<const char*>(f), 4); };
+  auto onClient = [&](const uint8_t* f) { atClient.assign(reinterpret_cast<const char*>(f), 4); };
+  EXPECT_TRUE(c.send("ping", 4));
+  pollUntil(s, c, [&]() { return !atServer.empty(); }, onServer, onClient);
+  EXPECT_EQ(atServer, "ping");
+  
+  s.broadcast("pong", 4);
+  pollUntil(s, c, [&]() { return !atClient.empty(); }, onServer, onClient);
+  EXPECT_EQ(atClient, "pong");
+}
+
+TEST(socketClientConnectionTest, wakeInterruptsPoll) {
+  Logger::setDefaultStreamLogger(std::cout);
+  ServerConnections s(0, 0, 10.0, 100.0);
+  ClientConnection c("127.0.0.1", s.getPort(), 0, 10.0, 100.0);
+  c.wake();
+  PollResult r = c.poll([](const uint8_t*) { });
+  EXPECT_TRUE(r.wakeup);
+  EXPECT_FALSE(r.tick);
+  s.wake();
+  r = s.poll([](const uint8_t*) { });
+  EXPECT_TRUE(r.wakeup);
+}
+
+TEST(socketClientConnectionTest, sendScheduleKeepsAlive) {
+  PollResult tick, wakeup;
+  tick.tick = true;
+  wakeup.wakeup = true;
+  SendSchedule periodic(false);
+  EXPECT_TRUE(periodic.due(tick));
+  EXPECT_FALSE(periodic.due(wakeup));
+  SendSchedule onUpdate(true);
+  EXPECT_TRUE(onUpdate.due(wakeup));
+  EXPECT_FALSE(onUpdate.due(tick));   // data was sent during the period
+  EXPECT_TRUE(onUpdate.due(tick));    // keepalive
+}
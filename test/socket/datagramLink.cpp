@@ -0,0 +1,118 @@
+#include <eeros/sockets/DatagramLink.hpp>
+#include <eeros/core/Fault.hpp>
+#include <eeros/logger/Logger.hpp>
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace eeros::sockets;
+using namespace eeros::logger;
+
+namespace {
+
+// sends hand made datagrams from one socket
+class Sender {
+ public:
+  Sender(uint16_t port) : fd(::socket(AF_INET, SOCK_DGRAM, 0)) {
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  }
+  ~Sender() { ::close(fd); }
+  void send(uint32_t sequence, const char* payload, std::size_t length) {
+    char buf[64];
+    DatagramLink::Header h{DatagramLink::magic, sequence, 1000 + sequence};
+    std::memcpy(buf, &h, sizeof(h));
+    std::memcpy(buf + sizeof(h), payload, length);
+    ::sendto(fd, buf, sizeof(h) + length, 0, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+  }
+ private:
+  int fd;
+  sockaddr_in addr{};
+};
+
+std::string pollFor(DatagramLink& link, int ticks) {
+  std::string received;
+  for (int i = 0; i < ticks; i++) link.poll([&](const uint8_t* p) { received.assign(reinterpret_cast<const char*>(p), 4); });
+  return received;
+}
+
+}
+
+TEST(socketDatagramLinkTest, exchangesDatagrams) {
+  Logger::setDefaultStreamLogger(std::cout);
+  DatagramLink server("", 0, 4, 0.002, 1.0);
+  DatagramLink client("127.0.0.1", server.getPort(), 4, 0.002, 1.0);
+  EXPECT_FALSE(server.isConnected());
+  client.send("abcd", 4);
+  EXPECT_EQ(pollFor(server, 5), "abcd");
+  EXPECT_TRUE(server.isConnected());
+
+  // the server replies to the client it received from last
+  server.send("efgh", 4);
+  EXPECT_EQ(pollFor(client, 5), "efgh");
+  auto s = client.getStatistics();
+  EXPECT_EQ(s.received, 1);
+  EXPECT_EQ(s.lost, 0);
+}
+
+TEST(socketDatagramLinkTest, keepsNewestAndCountsLosses) {
+  Logger::setDefaultStreamLogger(std::cout);
+  DatagramLink server("", 0, 4, 0.002, 1.0);
+  Sender sender(server.getPort());
+  sender.send(5, "five", 4);
+  EXPECT_EQ(pollFor(server, 5), "five");
+  sender.send(3, "old!", 4);
+  sender.send(8, "eigh", 4);
+  sender.send(9, "toolong", 7);
+  EXPECT_EQ(pollFor(server, 5), "eigh");
+  auto s = server.getStatistics();
+  EXPECT_EQ(s.received, 2);
+  EXPECT_EQ(s.reordered, 1);
+  EXPECT_EQ(s.lost, 2);
+  EXPECT_EQ(s.invalid, 1);
+  EXPECT_EQ(s.sequence, 8);
+  EXPECT_EQ(s.timestamp, 1008);
+}
+
+TEST(socketDatagramLinkTest, disconnectsAfterTimeout) {
+  Logger::setDefaultStreamLogger(std::cout);
+  DatagramLink server("", 0, 4, 0.002, 0.01);
+  Sender sender(server.getPort());
+  sender.send(100, "abcd", 4);
+  pollFor(server, 2);
+  EXPECT_TRUE(server.isConnected());
+  pollFor(server, 20);
+  EXPECT_FALSE(server.isConnected());
+  // a restarted peer starts with a low sequence number again
+  sender.send(0, "new!", 4);
+  EXPECT_EQ(pollFor(server, 5), "new!");
+}
+
+TEST(socketDatagramLinkTest, multicastReachesAllSubscribers) {
+  Logger::setDefaultStreamLogger(std::cout);
+  SocketOptions options;
+  options.multicastInterface = "127.0.0.1";
+  DatagramLink a("239.255.42.1", 9891, 4, 0.002, 1.0, options, true);
+  DatagramLink b("239.255.42.1", 9891, 4, 0.002, 1.0, options, true);
+  DatagramLink publisher("239.255.42.1", 9891, 0, 0.002, 1.0, options, true);
+  EXPECT_TRUE(publisher.isConnected());
+  publisher.send("abcd", 4);
+  EXPECT_EQ(pollFor(a, 3), "abcd");
+  EXPECT_EQ(pollFor(b, 3), "abcd");
+  a.send("efgh", 4);   // subscribers only receive
+  publisher.send("ijkl", 4);
+  EXPECT_EQ(pollFor(b, 3), "ijkl");
+  EXPECT_EQ(b.getStatistics().received, 2);
+  EXPECT_EQ(b.getStatistics().lost, 0);
+}
+
+TEST(socketDatagramLinkTest, multicastNeedsGroup) {
+  Logger::setDefaultStreamLogger(std::cout);
+  EXPECT_THROW(DatagramLink("127.0.0.1", 9892, 4, 0.002, 1.0, SocketOptions(), true), eeros::Fault);
+  EXPECT_THROW(DatagramLink("", 9892, 0, 0.002, 1.0, SocketOptions(), true), eeros::Fault);
+}
@@ -0,0 +1,126 @@
+#include <eeros/sockets/Message.hpp>
+#include <eeros/sockets/FrameAssembler.hpp>
+#include <eeros/core/Fault.hpp>
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+
+using namespace eeros;
+using namespace eeros::sockets;
+
+namespace {
+
+std::vector<uint8_t> message(const MessageSchema& schema, uint32_t sequence) {
+  std::vector<uint8_t> m(sizeof(MessageHeader) + schema.getPayloadSize(), 0);
+  Message::writeHeader(m.data(), schema, sequence, 1000 + sequence);
+  return m;
+}
+
+}
+
+TEST(socketMessageTest, schemaLayout) {
+  MessageSchema s;
+  EXPECT_EQ(s.add<double>("position", 3), 0);
+  EXPECT_EQ(s.add<int32_t>("mode"), 24);
+  EXPECT_EQ(s.add<bool>("enabled"), 28);
+  EXPECT_EQ(s.getPayloadSize(), 29);
+  ASSERT_NE(s.find("mode"), nullptr);
+  EXPECT_EQ(s.find("mode")->type, FieldType::int32);
+  EXPECT_EQ(s.find("speed"), nullptr);
+  EXPECT_THROW(s.add<float>("mode"), Fault);
+}
+
+TEST(socketMessageTest, schemaId) {
+  MessageSchema a, b, c, d;
+  a.add<double>("x"); a.add<int>("y");
+  b.add<double>("x"); b.add<int>("y");
+  c.add<int>("y"); c.add<double>("x");
+  d.add<double>("x"); d.add<float>("y");
+  EXPECT_EQ(a.getId(), b.getId());
+  EXPECT_NE(a.getId(), c.getId());
+  EXPECT_NE(a.getId(), d.getId());
+  EXPECT_NE(a.getId(), MessageSchema().getId());
+}
+
+TEST(socketMessageTest, header) {
+  MessageSchema s, other;
+  s.add<double>("x", 2);
+  other.add<float>("x", 4);
+  auto m = message(s, 7);
+  MessageHeader h = Message::readHeader(m.data());
+  EXPECT_EQ(h.sequence, 7);
+  EXPECT_EQ(h.timestamp, 1007);
+  EXPECT_EQ(Message::frameSize(m.data()), sizeof(MessageHeader) + 16);
+  EXPECT_TRUE(Message::matches(m.data(), s));
+  EXPECT_FALSE(Message::matches(m.data(), other));
+  m[0] = 0;
+  EXPECT_EQ(Message::frameSize(m.data()), 0);
+}
+
+// messages of different length are split correctly, even if received byte by byte
+TEST(socketMessageTest, variableFraming) {
+  MessageSchema small, large;
+  small.add<uint8_t>("a");
+  large.add<double>("b", 100);
+  std::vector<uint8_t> stream;
+  for (auto& m : {message(small, 1), message(large, 2), message(small, 3)}) stream.insert(stream.end(), m.begin(), m.end());
+  FrameAssembler f = Message::framing(small.getPayloadSize());
+  std::vector<uint32_t> sequences;
+  for (uint8_t byte : stream) {
+    std::size_t length;
+    uint8_t* to = f.next(length);
+    ASSERT_GE(length, 1);
+    *to = byte;
+    f.received(1);
+    while (f.pop() == FrameAssembler::State::complete) {
+      sequences.push_back(Message::readHeader(f.frame()).sequence);
+      EXPECT_EQ(f.getFrameSize(), Message::frameSize(f.frame()));
+    }
+  }
+  EXPECT_EQ(sequences, std::vector<uint32_t>({1, 2, 3}));
+}
+
+// all messages taken by one receive are returned without another receive
+TEST(socketMessageTest, batchedFraming) {
+  MessageSchema s;
+  s.add<double>("x", 4);
+  FrameAssembler f = Message::framing(s.getPayloadSize());
+  std::size_t length;
+  uint8_t* to = f.next(length);
+  std::size_t size = sizeof(MessageHeader) + s.getPayloadSize();
+  ASSERT_GE(length, 10 * size);
+  for (uint32_t i = 0; i < 10; i++) std::memcpy(to + i * size, message(s, i).data(), size);
+  f.received(10 * size + 3);   // and the beginning of the next message
+  for (uint32_t i = 0; i < 10; i++) {
+    ASSERT_EQ(f.pop(), FrameAssembler::State::complete);
+    EXPECT_EQ(Message::readHeader(f.frame()).sequence, i);
+  }
+  EXPECT_EQ(f.pop(), FrameAssembler::State::partial);
+  f.next(length);
+  EXPECT_EQ(f.pop(), FrameAssembler::State::partial);
+}
+
+TEST(socketMessageTest, invalidHeader) {
+  FrameAssembler f = Message::framing(8);
+  std::size_t length;
+  uint8_t* to = f.next(length);
+  ASSERT_GE(length, sizeof(MessageHeader));
+  std::memset(to, 0xff, sizeof(MessageHeader));
+  f.received(sizeof(MessageHeader));
+  EXPECT_EQ(f.pop(), FrameAssembler::State::invalid);
+}
+
+TEST(socketMessageTest, fixedFraming) {
+  FrameAssembler f(4);
+  std::size_t length;
+  std::memcpy(f.next(length), "ab", 2);
+  f.received(2);
+  EXPECT_EQ(f.pop(), FrameAssembler::State::partial);
+  std::memcpy(f.next(length), "cdefghi", 7);
+  f.received(7);
+  EXPECT_EQ(f.pop(), FrameAssembler::State::complete);
+  EXPECT_EQ(std::memcmp(f.frame(), "abcd", 4), 0);
+  EXPECT_EQ(f.pop(), FrameAssembler::State::complete);
+  EXPECT_EQ(std::memcmp(f.frame(), "efgh", 4), 0);
+  EXPECT_EQ(f.pop(), FrameAssembler::State::partial);
+}
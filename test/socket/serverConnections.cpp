@@ -0,0 +1,101 @@
+#include <eeros/sockets/ServerConnections.hpp>
+#include <eeros/logger/Logger.hpp>
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <cstring>
+#include <iostream>
+#include <netinet/in.h>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace eeros::sockets;
+using namespace eeros::logger;
+
+namespace {
+
+int connectTo(uint16_t port) {
+  int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+    ::close(fd);
+    return -1;
+  }
+  timeval tv{1, 0};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  return fd;
+}
+
+template < typename F >
+void pollUntil(ServerConnections& c, F done, std::function<void(const uint8_t*)> onFrame = [](const uint8_t*) { }) {
+  for (int i = 0; i < 200 && !done(); i++) c.poll(onFrame);
+}
+
+std::string receive(int fd, std::size_t length) {
+  std::string s(length, '\0');
+  std::size_t count = 0;
+  while (count < length) {
+    ssize_t n = ::recv(fd, &s[count], length - count, 0);
+    if (n <= 0) break;
+    count += n;
+  }
+  s.resize(count);
+  return s;
+}
+
+}
+
+TEST(socketServerConnectionsTest, servesSeveralClients) {
+  Logger::setDefaultStreamLogger(std::cout);
+  ServerConnections c(0, 4, 0.002, 1.0, 2);
+  int a = connectTo(c.getPort());
+  int b = connectTo(c.getPort());
+  ASSERT_GE(a, 0);
+  ASSERT_GE(b, 0);
+  pollUntil(c, [&]() { return c.getNofClients() == 2; });
+  ASSERT_EQ(c.getNofClients(), 2);
+
+  c.broadcast("abcd", 4);
+  EXPECT_EQ(receive(a, 4), "abcd");
+  EXPECT_EQ(receive(b, 4), "abcd");
+
+  // a frame sent in pieces is reassembled
+  std::string frame;
+  auto onFrame = [&](const uint8_t* data) { frame.assign(reinterpret_cast<const char*>(data), 4); };
+  ASSERT_EQ(::send(b, "wx", 2, 0), 2);
+  pollUntil(c, [&]() { return false; }, onFrame);  // some ticks without a complete frame
+  EXPECT_TRUE(frame.empty());
+  ASSERT_EQ(::send(b, "yz", 2, 0), 2);
+  pollUntil(c, [&]() { return !frame.empty(); }, onFrame);
+  EXPECT_EQ(frame, "wxyz");
+
+  // a third client is refused
+  int d = connectTo(c.getPort());
+  pollUntil(c, [&]() { return false; });
+  EXPECT_EQ(c.getNofClients(), 2);
+  char x;
+  EXPECT_EQ(::recv(d, &x, 1, 0), 0);
+
+  ::close(a);
+  pollUntil(c, [&]() { return c.getNofClients() == 1; });
+  EXPECT_EQ(c.getNofClients(), 1);
+  c.broadcast("efgh", 4);
+  EXPECT_EQ(receive(b, 4), "efgh");
+  ::close(b);
+  ::close(d);
+}
+
+TEST(socketServerConnectionsTest, dropsSilentClients) {
+  Logger::setDefaultStreamLogger(std::cout);
+  ServerConnections c(0, 8, 0.002, 0.02, 4);
+  int a = connectTo(c.getPort());
+  ASSERT_GE(a, 0);
+  pollUntil(c, [&]() { return c.getNofClients() == 1; });
+  ASSERT_EQ(c.getNofClients(), 1);
+  pollUntil(c, [&]() { return c.getNofClients() == 0; });
+  EXPECT_EQ(c.getNofClients(), 0);
+  ::close(a);
+}
@@ -0,0 +1,13 @@
+#include <eeros/task/Async.hpp>
+#include <gtest/gtest.h>
+
+using namespace eeros::task;
+
+// The calibrated budget is the maximum run time with a margin, limited to the period
+TEST(taskAsyncTest, calibratedBudget) {
+  EXPECT_DOUBLE_EQ(Async::calibratedBudget(0.002, 0.01), 0.002 * Async::budgetMargin);
+  EXPECT_DOUBLE_EQ(Async::calibratedBudget(0.002, 0.01), 0.003);
+  EXPECT_DOUBLE_EQ(Async::calibratedBudget(0.008, 0.01), 0.01);
+  EXPECT_DOUBLE_EQ(Async::calibratedBudget(0.02, 0.01), 0.01);
+  EXPECT_DOUBLE_EQ(Async::calibratedBudget(0, 0.01), 0);
+}
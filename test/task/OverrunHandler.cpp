@@ -0,0 +1,93 @@
+#include <eeros/task/OverrunHandler.hpp>
+#include <eeros/safety/SafetySystem.hpp>
+#include <gtest/gtest.h>
+
+using namespace eeros;
+using namespace eeros::task;
+using namespace eeros::safety;
+
+class OverrunSafetyProperties : public SafetyProperties {
+ public:
+  OverrunSafetyProperties() : overrun("overrun"), running("running"), stopped("stopped") {
+    addLevel(running);
+    addLevel(stopped);
+    running.addEvent(overrun, stopped, kPublicEvent);
+    setEntryLevel(running);
+  }
+
+  SafetyEvent overrun;
+  SafetyLevel running, stopped;
+};
+
+static constexpr int64_t period = 1000;
+
+// Missed cycles run back to back, a stall is counted once while the backlog is caught up
+TEST(taskOverrunHandlerTest, catchUp) {
+  PeriodicCounter counter;
+  OverrunHandler handler;
+  handler.reset();
+  EXPECT_EQ(handler.release(1000, 500, period, counter), 1000);
+  EXPECT_EQ(counter.overruns, 0);
+  // the run released at 0 takes 3.5 periods, the releases at 1000, 2000 and 3000 are missed
+  EXPECT_EQ(handler.release(1000, 3500, period, counter), 1000);
+  EXPECT_EQ(counter.overruns, 3);
+  EXPECT_EQ(handler.release(2000, 3600, period, counter), 2000);
+  EXPECT_EQ(handler.release(3000, 3700, period, counter), 3000);
+  EXPECT_EQ(counter.overruns, 3);
+  EXPECT_EQ(handler.release(4000, 3800, period, counter), 4000);
+  EXPECT_EQ(counter.overruns, 3);
+  // a new stall after the backlog is counted again
+  EXPECT_EQ(handler.release(5000, 5200, period, counter), 5000);
+  EXPECT_EQ(counter.overruns, 4);
+}
+
+// A stall which outlasts the backlog counts only the releases not counted yet
+TEST(taskOverrunHandlerTest, catchUpLongerStall) {
+  PeriodicCounter counter;
+  OverrunHandler handler;
+  handler.reset();
+  EXPECT_EQ(handler.release(1000, 2500, period, counter), 1000);
+  EXPECT_EQ(counter.overruns, 2);
+  // catching up the release at 1000 stalls until 4500
+  EXPECT_EQ(handler.release(2000, 4500, period, counter), 2000);
+  EXPECT_EQ(counter.overruns, 4);
+  // reset() forgets the counted releases
+  handler.reset();
+  EXPECT_EQ(handler.release(1000, 1500, period, counter), 1000);
+  EXPECT_EQ(counter.overruns, 5);
+}
+
+// Missed cycles are dropped, the next run is released on the grid
+TEST(taskOverrunHandlerTest, skip) {
+  PeriodicCounter counter;
+  OverrunHandler handler;
+  handler.setPolicy(OverrunPolicy::skip);
+  handler.reset();
+  EXPECT_EQ(handler.release(1000, 3500, period, counter), 4000);
+  EXPECT_EQ(counter.overruns, 3);
+  EXPECT_EQ(handler.release(5000, 4200, period, counter), 5000);
+  EXPECT_EQ(counter.overruns, 3);
+  EXPECT_EQ(handler.release(6000, 6000, period, counter), 7000);
+  EXPECT_EQ(counter.overruns, 4);
+}
+
+// Missed cycles are dropped and the safety event is triggered
+TEST(taskOverrunHandlerTest, safetyEvent) {
+  std::cout.setstate(std::ios_base::badbit);
+  logger::Logger::setDefaultStreamLogger(std::cout);
+  OverrunSafetyProperties sp;
+  SafetySystem ss(sp, 1);
+  PeriodicCounter counter;
+  OverrunHandler handler;
+  handler.setPolicy(OverrunPolicy::safetyEvent, &ss, &sp.overrun);
+  handler.reset();
+  ss.run();
+  EXPECT_TRUE(ss.getCurrentLevel() == sp.running);
+  EXPECT_EQ(handler.release(1000, 500, period, counter), 1000);
+  ss.run();
+  EXPECT_TRUE(ss.getCurrentLevel() == sp.running);
+  EXPECT_EQ(handler.release(1000, 3500, period, counter), 4000);
+  EXPECT_EQ(counter.overruns, 3);
+  ss.run();
+  EXPECT_TRUE(ss.getCurrentLevel() == sp.stopped);
+}
@@ -0,0 +1,45 @@
+#include <eeros/task/Schedulability.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+
+using namespace eeros::task;
+
+// Rate monotonic example with a utilization above the bound which still meets all periods
+TEST(taskSchedulabilityTest, responseTimes) {
+  Schedulability s;
+  s.add("t1", 0.003, 0.001, 3);
+  s.add("t2", 0.005, 0.0015, 2);
+  s.add("t3", 0.010, 0.002, 1);
+  EXPECT_TRUE(s.analyze());
+  auto& t = s.getTasks();
+  EXPECT_NEAR(t[0].responseTime, 0.001, 1e-9);
+  EXPECT_NEAR(t[1].responseTime, 0.0025, 1e-9);
+  EXPECT_NEAR(t[2].responseTime, 0.008, 1e-9);
+  ASSERT_EQ(s.getCores().size(), 1);
+  EXPECT_EQ(s.getCores()[0].core, Schedulability::anyCore);
+  EXPECT_NEAR(s.getCores()[0].utilization, 0.1 / 0.3 + 0.3 + 0.2, 1e-9);
+  EXPECT_NEAR(s.getCores()[0].bound, 3 * (std::pow(2.0, 1.0 / 3) - 1), 1e-9);
+}
+
+// The lowest priority periodic misses its period, the others are not affected
+TEST(taskSchedulabilityTest, notSchedulable) {
+  Schedulability s;
+  s.add("fast", 0.002, 0.001, 2);
+  s.add("slow", 0.005, 0.003, 1);
+  EXPECT_FALSE(s.analyze());
+  EXPECT_TRUE(s.getTasks()[0].schedulable);
+  EXPECT_FALSE(s.getTasks()[1].schedulable);
+  EXPECT_GT(s.getTasks()[1].responseTime, 0.005);
+}
+
+// Periodics pinned to different cores do not interfere
+TEST(taskSchedulabilityTest, cores) {
+  Schedulability s;
+  s.add("fast", 0.002, 0.001, 2, {1});
+  s.add("slow", 0.005, 0.003, 1, {2, 3});
+  EXPECT_TRUE(s.analyze());
+  EXPECT_NEAR(s.getTasks()[1].responseTime, 0.003, 1e-9);
+  ASSERT_EQ(s.getCores().size(), 2);
+  EXPECT_EQ(s.getCores()[0].core, 1);
+  EXPECT_EQ(s.getCores()[1].core, 2);
+}
@@ -0,0 +1,59 @@
+#include <eeros/logger/StreamLogWriter.hpp>
+#include <eeros/task/Timed.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <time.h>
+
+using namespace eeros;
+using namespace eeros::task;
+
+class SleepingTask : public Runnable {
+ public:
+  SleepingTask(int sleepMs = 0) : sleepMs(sleepMs) { }
+  void run() override {
+    if (sleepMs > 0) std::this_thread::sleep_for(std::chrono::milliseconds(sleepMs));
+    runs++;
+  }
+  int sleepMs;
+  std::atomic<int> runs{0};
+};
+
+static int64_t nowNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+// A period which is not a multiple of any base period is kept without drift
+TEST(taskTimedTest, period) {
+  logger::Logger::setDefaultStreamLogger(std::cout);
+  SleepingTask task;
+  Timed timed(task, 0.003);
+  EXPECT_TRUE(timed.waitReady(1));
+  EXPECT_EQ(task.runs, 0);
+  int64_t start = nowNs();
+  timed.start(start);
+  std::this_thread::sleep_for(std::chrono::milliseconds(150));
+  timed.stop();
+  timed.join();
+  int expected = static_cast<int>((nowNs() - start) / 3000000) + 1;
+  EXPECT_LE(task.runs, expected);
+  EXPECT_GE(task.runs, expected - 10);
+}
+
+// Runs longer than the period are counted as overruns, with skip the missed releases are dropped
+TEST(taskTimedTest, overrunSkip) {
+  logger::Logger::setDefaultStreamLogger(std::cout);
+  SleepingTask task(5);
+  Timed timed(task, 0.002);
+  timed.setOverrunPolicy(OverrunPolicy::skip);
+  EXPECT_TRUE(timed.waitReady(1));
+  timed.start(nowNs());
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  timed.stop();
+  timed.join();
+  EXPECT_GT(timed.counter.overruns, 0u);
+  EXPECT_LE(task.runs, 21);
+}
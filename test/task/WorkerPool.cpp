@@ -0,0 +1,63 @@
+#include <eeros/task/WorkerPool.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace eeros;
+using namespace eeros::task;
+
+class CountingTask : public Runnable {
+ public:
+  CountingTask(int sleepMs = 0) : sleepMs(sleepMs) { }
+  void run() override {
+    if (sleepMs > 0) std::this_thread::sleep_for(std::chrono::milliseconds(sleepMs));
+    runs++;
+  }
+  int sleepMs;
+  std::atomic<int> runs{0};
+};
+
+static bool waitFor(std::function<bool()> condition) {
+  auto end = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+  while (!condition()) {
+    if (std::chrono::steady_clock::now() > end) return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+// All submitted jobs are run
+TEST(taskWorkerPoolTest, runJobs) {
+  WorkerPool pool(2);
+  EXPECT_EQ(pool.getThreadCount(), 2);
+  CountingTask t[8];
+  for (auto& j : t) pool.submit(j);
+  for (auto& j : t) EXPECT_TRUE(waitFor([&]() { return j.runs == 1; }));
+}
+
+// Idle workers steal jobs queued behind a long running job
+TEST(taskWorkerPoolTest, stealing) {
+  WorkerPool pool(2);
+  CountingTask slow(200), fast;
+  pool.submit(slow); // first queue
+  pool.submit(fast); // second queue
+  pool.submit(fast); // first queue, behind the slow job
+  EXPECT_TRUE(waitFor([&]() { return fast.runs == 2; }));
+  EXPECT_EQ(slow.runs, 0);
+  EXPECT_TRUE(waitFor([&]() { return slow.runs == 1; }));
+}
+
+// A pooled task tracks its timing and skips runs while still busy
+TEST(taskWorkerPoolTest, pooledTask) {
+  WorkerPool pool(1);
+  CountingTask t(50);
+  PooledTask p(t, pool);
+  p.run();
+  p.run(); // still busy
+  EXPECT_TRUE(waitFor([&]() { return t.runs == 1 && p.counter.run.count == 1; }));
+  p.run();
+  EXPECT_TRUE(waitFor([&]() { return p.counter.run.count == 2; }));
+  EXPECT_EQ(t.runs, 2);
+  EXPECT_EQ(p.counter.overruns, 1u);
+}